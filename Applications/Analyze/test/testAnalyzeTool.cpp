@@ -28,18 +28,44 @@
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/OutputReporter.h>
+#include <OpenSim/Analyses/BodyKinematics.h>
+#include <OpenSim/Analyses/InverseDynamics.h>
+#include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Auxiliary/auxiliaryTestMuscleFunctions.h>
 
+#include <cstdio>
+
 using namespace OpenSim;
 using namespace std;
 
 void testTutorialOne();
 
+// Analyzing chunks of frames concurrently gives the serial results.
+void testParallelFrames();
+
+// Step the analyses of the model concurrently.
+void testConcurrentAnalyses();
+
+// Only the muscle quantities in the output list are recorded, and the moment
+// arms about coordinates a muscle does not span are zero.
+void testMuscleAnalysisOutputs();
+
+// Compare BodyKinematics to the kinematics of each body, with and without
+// accelerations.
+void testBodyKinematics();
+
 // Test different default activations are respected when activation
 // states are not provided.
 void testTugOfWar(const string& dataFileName, const double& defaultAct);
 
+// Streaming the states from their file gives the results of loading them.
+void testStreamStates();
+
+// A rerun with the same inputs gives the results stored in the result cache.
+void testResultCache();
+
 int main()
 {
     SimTK::Array_<std::string> failures;
@@ -49,6 +75,27 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testParallelFrames(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testParallelFrames");
+    }
+
+    try { testConcurrentAnalyses(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testConcurrentAnalyses");
+    }
+
+    try { testMuscleAnalysisOutputs(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMuscleAnalysisOutputs");
+    }
+
+    try { testBodyKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testBodyKinematics");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -70,6 +117,16 @@ int main()
         failures.push_back("testTugOfWar with activation state provided");
     }
 
+    try { testStreamStates(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testStreamStates");
+    }
+
+    try { testResultCache(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testResultCache");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -104,6 +161,174 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testParallelFrames() {
+    AnalyzeTool serial("PlotterTool.xml");
+    serial.setName("BothLegsSerial");
+    serial.run();
+
+    AnalyzeTool parallel("PlotterTool.xml");
+    parallel.setName("BothLegsParallel");
+    parallel.setNumThreads(4);
+    parallel.run();
+
+    Storage serialFiberLength("testPlotterTool/BothLegsSerial__FiberLength.sto");
+    Storage parallelFiberLength(
+        "testPlotterTool/BothLegsParallel__FiberLength.sto");
+    ASSERT(parallelFiberLength.getSize() == serialFiberLength.getSize(),
+        __FILE__, __LINE__, "testParallelFrames: number of rows differs");
+    CHECK_STORAGE_AGAINST_STANDARD(parallelFiberLength, serialFiberLength,
+        std::vector<double>(100, 1e-10), __FILE__, __LINE__,
+        "testParallelFrames failed");
+    Storage standardFiberLength("std_BothLegs_fiberLength.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(parallelFiberLength, standardFiberLength,
+        std::vector<double>(100, 0.0001), __FILE__, __LINE__,
+        "testParallelFrames failed against the standard");
+    cout << "testParallelFrames passed" << endl;
+}
+
+void testConcurrentAnalyses() {
+    const std::vector<std::string> suffixes{"__FiberLength", "_Kinematics_q",
+        "_BodyKinematics_pos_global", "_BodyKinematics_acc_global"};
+    for (int numThreads : {1, 4}) {
+        AnalyzeTool analyze("PlotterTool.xml");
+        analyze.setName("BothLegsThreads" + std::to_string(numThreads));
+        analyze.getAnalysisSet().adoptAndAppend(new Kinematics());
+        analyze.getAnalysisSet().adoptAndAppend(new BodyKinematics());
+        analyze.getModel().updAnalysisSet().setNumThreads(numThreads);
+        analyze.run();
+    }
+    for (const auto& suffix : suffixes) {
+        Storage serial("testPlotterTool/BothLegsThreads1" + suffix + ".sto");
+        Storage concurrent(
+            "testPlotterTool/BothLegsThreads4" + suffix + ".sto");
+        ASSERT(concurrent.getSize() == serial.getSize(), __FILE__, __LINE__,
+            "testConcurrentAnalyses: number of rows of " + suffix + " differs");
+        CHECK_STORAGE_AGAINST_STANDARD(concurrent, serial,
+            std::vector<double>(100, 1e-10), __FILE__, __LINE__,
+            "testConcurrentAnalyses failed for " + suffix);
+    }
+    cout << "testConcurrentAnalyses passed" << endl;
+}
+
+void testMuscleAnalysisOutputs() {
+    Model model("BothLegs.osim");
+    MuscleAnalysis* analysis = new MuscleAnalysis(&model);
+    Array<std::string> outputs("", 1);
+    outputs[0] = "TendonForce";
+    analysis->setOutputs(outputs);
+    analysis->setComputeMoments(true);
+    model.addAnalysis(analysis);
+
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (!coords[i].getLocked(s))
+            coords[i].setValue(s, 0.5*(coords[i].getRangeMin() +
+                                       coords[i].getRangeMax()), false);
+    }
+    model.assemble(s);
+    model.realizeVelocity(s);
+    analysis->begin(s);
+
+    ASSERT(analysis->getForceStorage() != nullptr, __FILE__, __LINE__,
+        "testMuscleAnalysisOutputs: TendonForce was not recorded");
+    ASSERT(analysis->getForceStorage()->getSize() == 1, __FILE__, __LINE__,
+        "testMuscleAnalysisOutputs: TendonForce was not recorded");
+    ASSERT(analysis->getFiberLengthStorage() == nullptr &&
+           analysis->getMusclePowerStorage() == nullptr, __FILE__, __LINE__,
+        "testMuscleAnalysisOutputs: unrequested quantities were recorded");
+
+    const auto& momentArmStores = analysis->getMomentArmStorageArray();
+    const Set<Muscle>& muscles = model.getMuscles();
+    ASSERT(momentArmStores.getSize() == coords.getSize());
+    int numZeros = 0;
+    for (int i = 0; i < momentArmStores.getSize(); ++i) {
+        const Coordinate& q = *momentArmStores[i]->q;
+        const Array<double>& momentArms =
+            momentArmStores[i]->momentArmStore->getStateVector(0)->getData();
+        for (int j = 0; j < muscles.getSize(); ++j) {
+            ASSERT_EQUAL<double>(muscles[j].computeMomentArm(s, q),
+                momentArms[j], 1e-8, __FILE__, __LINE__,
+                "testMuscleAnalysisOutputs: moment arm of " +
+                muscles[j].getName() + " about " + q.getName() + " differs");
+            if (momentArms[j] == 0) ++numZeros;
+        }
+    }
+    // Most muscles do not span most of the coordinates.
+    ASSERT(numZeros > muscles.getSize()*coords.getSize()/2, __FILE__, __LINE__,
+        "testMuscleAnalysisOutputs: expected a sparse moment arm matrix");
+    cout << "testMuscleAnalysisOutputs passed" << endl;
+}
+
+void testBodyKinematics() {
+    Model model("BothLegs.osim");
+    BodyKinematics* local = new BodyKinematics(&model);
+    local->setExpressResultsInLocalFrame(true);
+    model.addAnalysis(local);
+    BodyKinematics* noAccelerations = new BodyKinematics(&model);
+    noAccelerations->setName("BodyKinematicsNoAccelerations");
+    noAccelerations->setRecordAccelerations(false);
+    model.addAnalysis(noAccelerations);
+
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        if (coords[i].getLocked(s)) continue;
+        coords[i].setValue(s, 0.5*(coords[i].getRangeMin() +
+                                   coords[i].getRangeMax()), false);
+        coords[i].setSpeedValue(s, 0.1*(i + 1));
+    }
+    model.assemble(s);
+    local->begin(s);
+    noAccelerations->begin(s);
+
+    ASSERT(noAccelerations->getAccelerationStorage()->getSize() == 0,
+        __FILE__, __LINE__, "testBodyKinematics: accelerations were recorded");
+    const Array<double>& pos =
+        local->getPositionStorage()->getStateVector(0)->getData();
+    const Array<double>& vel =
+        local->getVelocityStorage()->getStateVector(0)->getData();
+    const Array<double>& acc =
+        local->getAccelerationStorage()->getStateVector(0)->getData();
+    const Array<double>& globalVel =
+        noAccelerations->getVelocityStorage()->getStateVector(0)->getData();
+
+    const Ground& ground = model.getGround();
+    const BodySet& bodies = model.getBodySet();
+    auto check = [](const SimTK::Vec3& expected, const Array<double>& row,
+                    int index, const std::string& what) {
+        for (int k = 0; k < 3; ++k)
+            ASSERT_EQUAL<double>(expected[k], row[index + k], 1e-10,
+                __FILE__, __LINE__, "testBodyKinematics: " + what + " differs");
+    };
+    for (int i = 0; i < bodies.getSize(); ++i) {
+        const Body& body = bodies[i];
+        const SimTK::Vec3& com = body.get_mass_center();
+        const SimTK::Vec3 v = body.findStationVelocityInGround(s, com);
+        const SimTK::Vec3 w = body.getVelocityInGround(s)[0];
+        check(body.findStationLocationInGround(s, com), pos, 6*i,
+              body.getName() + " position");
+        check(ground.expressVectorInAnotherFrame(s, v, body), vel, 6*i,
+              body.getName() + " velocity");
+        check(SimTK_RADIAN_TO_DEGREE*
+              ground.expressVectorInAnotherFrame(s, w, body), vel, 6*i + 3,
+              body.getName() + " angular velocity");
+        check(ground.expressVectorInAnotherFrame(s,
+                body.findStationAccelerationInGround(s, com), body), acc, 6*i,
+              body.getName() + " acceleration");
+        check(v, globalVel, 6*i, body.getName() + " velocity in ground");
+        check(SimTK_RADIAN_TO_DEGREE*w, globalVel, 6*i + 3,
+              body.getName() + " angular velocity in ground");
+    }
+    const int comIndex = 6*bodies.getSize();
+    check(model.calcMassCenterPosition(s), pos, comIndex, "center of mass");
+    check(model.calcMassCenterVelocity(s), globalVel, comIndex,
+          "velocity of the center of mass");
+    check(model.calcMassCenterAcceleration(s), acc, comIndex,
+          "acceleration of the center of mass");
+    cout << "testBodyKinematics passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
@@ -231,3 +456,67 @@ void testTugOfWar(const string& dataFileName, const double& defaultAct) {
             "Force trajectory has unexplained discontinuity.");
     }
 }
+
+void testStreamStates() {
+    const std::string statesFile =
+        "Tug_of_War_ConstantVelocity_RampActivation.sto";
+    AnalyzeTool loaded("Tug_of_War_Setup_Analyze.xml");
+    loaded.setName("TugOfWarLoaded");
+    loaded.setCoordinatesFileName("");
+    loaded.setStatesFileName(statesFile);
+    loaded.setFinalTime(0.5);
+    loaded.run();
+
+    // Blocks much smaller than the trial, and a final time within a block.
+    AnalyzeTool streamed("Tug_of_War_Setup_Analyze.xml");
+    streamed.setName("TugOfWarStreamed");
+    streamed.setCoordinatesFileName("");
+    streamed.setStatesFileName(statesFile);
+    streamed.setFinalTime(0.5);
+    streamed.setStreamBlockSize(7);
+    streamed.run();
+
+    Storage loadedForces(
+        "Analyze_Tug_of_War/TugOfWarLoaded_ForceReporter_forces.sto");
+    Storage streamedForces(
+        "Analyze_Tug_of_War/TugOfWarStreamed_ForceReporter_forces.sto");
+    ASSERT(streamedForces.getSize() == loadedForces.getSize(),
+        __FILE__, __LINE__, "testStreamStates: number of rows differs");
+    CHECK_STORAGE_AGAINST_STANDARD(streamedForces, loadedForces,
+        std::vector<double>(10, 1e-10), __FILE__, __LINE__,
+        "testStreamStates failed");
+
+    // Analyses that spline the states cannot be streamed.
+    AnalyzeTool splined("Tug_of_War_Setup_Analyze.xml");
+    splined.setCoordinatesFileName("");
+    splined.setStatesFileName(statesFile);
+    splined.setStreamBlockSize(7);
+    splined.getModel().addAnalysis(new InverseDynamics());
+    ASSERT_THROW(OpenSim::Exception, splined.run());
+    cout << "testStreamStates passed" << endl;
+}
+
+void testResultCache() {
+    const std::string fiberLengthFile =
+        "testPlotterTool/BothLegsCached__FiberLength.sto";
+    AnalyzeTool computed("PlotterTool.xml");
+    computed.setName("BothLegsCached");
+    computed.setResultCacheDirectory("testAnalyzeTool_cache");
+    computed.run();
+    Storage computedFiberLength(fiberLengthFile);
+    std::remove(fiberLengthFile.c_str());
+
+    // The same model, states and settings: the analyses' storages are filled
+    // from the cache, and printed as usual.
+    AnalyzeTool cached("PlotterTool.xml");
+    cached.setName("BothLegsCached");
+    cached.setResultCacheDirectory("testAnalyzeTool_cache");
+    cached.run();
+    Storage cachedFiberLength(fiberLengthFile);
+    ASSERT(cachedFiberLength.getSize() == computedFiberLength.getSize(),
+        __FILE__, __LINE__, "testResultCache: number of rows differs");
+    CHECK_STORAGE_AGAINST_STANDARD(cachedFiberLength, computedFiberLength,
+        std::vector<double>(100, 0), __FILE__, __LINE__,
+        "testResultCache failed");
+    cout << "testResultCache passed" << endl;
+}
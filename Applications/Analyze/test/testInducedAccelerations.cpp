@@ -151,6 +151,16 @@ void testDoublePendulumWithSolver()
         
         ASSERT_EQUAL(udot[0], udot_torq2[0], 1e-5, __FILE__, __LINE__, "Induced Accelerations of Torq2 for double pendulum q1 FAILED");
         ASSERT_EQUAL(udot[1], udot_torq2[1], 1e-5, __FILE__, __LINE__, "Induced Accelerations of Torq2 for double pendulum q2 FAILED");
+
+        // Solve for the contributors together; the actuators are solved for
+        // in one block solve.
+        const Matrix& udots = iaaSolver.solve(s,
+                std::vector<std::string>{"Torq1", "gravity", "Torq2"});
+        for(int k=0; k<2; ++k){
+            ASSERT_EQUAL(udot_torq1[k], udots(k, 0), 1e-9, __FILE__, __LINE__, "Induced Accelerations of Torq1 solved together FAILED");
+            ASSERT_EQUAL(udot_grav[k], udots(k, 1), 1e-9, __FILE__, __LINE__, "Induced Accelerations of gravity solved together FAILED");
+            ASSERT_EQUAL(udot_torq2[k], udots(k, 2), 1e-9, __FILE__, __LINE__, "Induced Accelerations of Torq2 solved together FAILED");
+        }
     }
     cout << "Induced Accelerations Solver on double pendulum passed\n" << endl;
     cout << "Solver computed " << nt << " frames in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
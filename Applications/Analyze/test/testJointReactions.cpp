@@ -46,6 +46,19 @@ int main()
             std::vector<double>(standard2.getSmallestNumberOfStates(), 1e-5), __FILE__, __LINE__,
             "DoublePendulum3D failed");
         cout << "DoublePendulum3D passed" << endl;
+
+        // Analyze the frames in chunks, concurrently.
+        AnalyzeTool analyze3("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze3.setName("DoublePendulum3DThreads");
+        analyze3.setNumThreads(4);
+        analyze3.run();
+        Storage result3("DoublePendulum3DThreads_JointReaction_ReactionLoads.sto");
+        ASSERT(result3.getSize() == result2.getSize(), __FILE__, __LINE__,
+            "DoublePendulum3D with threads: number of rows differs");
+        CHECK_STORAGE_AGAINST_STANDARD(result3, standard2,
+            std::vector<double>(standard2.getSmallestNumberOfStates(), 1e-5), __FILE__, __LINE__,
+            "DoublePendulum3D with threads failed");
+        cout << "DoublePendulum3D with threads passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
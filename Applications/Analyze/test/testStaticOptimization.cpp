@@ -144,6 +144,29 @@ void testArm26(const string& muscleModelClassName, double actTol, double forceTo
                                    __FILE__, __LINE__, 
                                    "Arm26 forces "+muscName+" failed.");
     cout << resultsDir <<": test Arm26 passed." << endl;
+
+    // Solve the frames in chunks, concurrently.
+    AnalyzeTool analyzeThreads("arm26_Setup_StaticOptimization.xml");
+    analyzeThreads.setResultsDir(resultsDir+"_threads");
+    analyzeThreads.setNumThreads(4);
+    analyzeThreads.run();
+
+    Storage activationsThreads(
+        resultsDir+"_threads/arm26_StaticOptimization_activation.sto");
+    Storage forcesThreads(
+        resultsDir+"_threads/arm26_StaticOptimization_force.sto");
+    ASSERT(activationsThreads.getSize() == activations1.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(activationsThreads, stdActivations1,
+                                   std::vector<double>(6, actTol),
+                                   __FILE__, __LINE__,
+                                   "Arm26 activations "+muscName+
+                                   " with threads failed");
+    CHECK_STORAGE_AGAINST_STANDARD(forcesThreads, stdForces1,
+                                   std::vector<double>(6, forceTol),
+                                   __FILE__, __LINE__,
+                                   "Arm26 forces "+muscName+
+                                   " with threads failed.");
+    cout << resultsDir <<": test Arm26 with threads passed." << endl;
   
     
     cout << "=============================================================\n" << endl;
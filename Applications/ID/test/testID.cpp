@@ -51,6 +51,16 @@ int main()
             std::vector<double>(23, 2.0), __FILE__, __LINE__,
             "testGait failed");
         cout << "testGait passed" << endl;
+
+        InverseDynamicsTool id3("subject01_Setup_InverseDynamics.xml");
+        id3.setNumThreads(4);
+        id3.setOutputGenForceFileName("subject01_InverseDynamics_threads.sto");
+        id3.run();
+        Storage result3("Results/subject01_InverseDynamics_threads.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result3, result2,
+            std::vector<double>(23, 1e-6), __FILE__, __LINE__,
+            "testGait with threads failed");
+        cout << "testGait with threads passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -23,12 +23,18 @@
 
 
 // INCLUDES
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/RunControl.h>
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IKTaskSet.h>
+#include <OpenSim/Tools/ToolJob.h>
+#include <OpenSim/Tools/ToolPipeline.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -62,6 +68,114 @@ int main()
             "testInverseKinematicsGait2354 GUI workflow failed");
         cout << "testInverseKinematicsGait2354 GUI workflow passed" << endl;
 
+        InverseKinematicsTool ik4("subject01_Setup_InverseKinematics.xml");
+        ik4.setNumThreads(4);
+        ik4.setOutputMotionFileName("subject01_walk1_ik_threads.mot");
+        ik4.setReportSolverStatistics(true);
+        ik4.run();
+        Storage result4(ik4.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(result4, standard,
+            std::vector<double>(24, 0.2), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 with threads failed");
+        cout << "testInverseKinematicsGait2354 with threads passed" << endl;
+
+        // One row of solver statistics per frame, written with the results.
+        const SolverStatistics& statistics = ik4.getSolverStatistics();
+        ASSERT(statistics.getNumFrames() == result4.getSize());
+        ASSERT(statistics.getNumFramesNotConverged() == 0);
+        ASSERT(statistics.getTotalWallTime() > 0);
+        const auto& iterations =
+                statistics.getTable().getDependentColumn("iterations");
+        const auto& evaluations = statistics.getTable().getDependentColumn(
+                "function_evaluations");
+        for (int i = 0; i < iterations.size(); ++i)
+            ASSERT(evaluations[i] >= iterations[i]);
+        Storage statisticsFile(ik4.getResultsDir() + "/" + ik4.getName() +
+                               "_ik_solver_statistics.sto");
+        ASSERT(statisticsFile.getSize() == statistics.getNumFrames());
+        cout << "testInverseKinematicsGait2354 solver statistics passed"
+             << endl;
+
+        // A second run with the same model, inputs and settings copies its
+        // results from the cache.
+        InverseKinematicsTool ik5("subject01_Setup_InverseKinematics.xml");
+        ik5.setOutputMotionFileName("subject01_walk1_ik_cached.mot");
+        ik5.setResultCacheDirectory("testIK_cache");
+        ik5.run();
+        Storage computed(ik5.getOutputMotionFileName());
+        std::remove(ik5.getOutputMotionFileName().c_str());
+        ik5.run();
+        Storage cached(ik5.getOutputMotionFileName());
+        ASSERT(cached.getSize() == computed.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(cached, computed,
+            std::vector<double>(24, 0), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 from the cache failed");
+        // Other settings are computed again.
+        ik5.setEndTime(ik5.getStartTime() + 0.1);
+        ik5.run();
+        ASSERT(Storage(ik5.getOutputMotionFileName()).getSize() <
+               computed.getSize());
+        cout << "testInverseKinematicsGait2354 result cache passed" << endl;
+
+        // A pipeline runs a stage again only when its inputs change.
+        InverseKinematicsTool ik6("subject01_Setup_InverseKinematics.xml");
+        ik6.setOutputMotionFileName("subject01_walk1_ik_pipeline.mot");
+        ik6.setEndTime(ik6.getStartTime() + 0.1);
+        ToolPipeline pipeline("testIK_pipeline");
+        pipeline.addStage("ik", ik6);
+        ASSERT_THROW(Exception, pipeline.addStage("ik", ik6));
+        ASSERT_THROW(Exception, pipeline.addStage("other", ik6, {"none"}));
+        ASSERT(pipeline.getInputFileNames("ik").size() == 2);
+        pipeline.run(true);
+        ASSERT(pipeline.run() == std::vector<std::string>{});
+        ASSERT(ik6.getOutputStorage().getSize() ==
+               Storage(ik6.getOutputMotionFileName()).getSize());
+        ik6.setEndTime(ik6.getStartTime() + 0.05);
+        ASSERT(pipeline.run() == std::vector<std::string>{"ik"});
+        ASSERT(pipeline.run(true) == std::vector<std::string>{"ik"});
+        cout << "testInverseKinematicsGait2354 pipeline passed" << endl;
+
+        // A job runs the tool in the background and reports its progress.
+        InverseKinematicsTool ik7("subject01_Setup_InverseKinematics.xml");
+        ik7.setOutputMotionFileName("subject01_walk1_ik_job.mot");
+        ik7.setEndTime(ik7.getStartTime() + 0.1);
+        std::atomic<int> numReports(0);
+        ToolJob job = ToolJob::runAsync(ik7, [&](double) { ++numReports; });
+        job.get();
+        ASSERT(job.getStatus() == ToolJob::Succeeded);
+        ASSERT(job.isDone() && job.getProgress() == 1);
+        ASSERT(numReports > 0);
+        ASSERT(ik7.getOutputStorage().getSize() ==
+               Storage(ik7.getOutputMotionFileName()).getSize());
+        // A cancelled job stops at its next frame, or never starts, and
+        // writes nothing.
+        ToolJob::setNumThreads(1);
+        InverseKinematicsTool ik8("subject01_Setup_InverseKinematics.xml");
+        ik8.setOutputMotionFileName("subject01_walk1_ik_cancelled.mot");
+        InverseKinematicsTool ik9(ik8);
+        std::remove(ik8.getOutputMotionFileName().c_str());
+        ToolJob running = ToolJob::runAsync(ik8);
+        ToolJob queued = ToolJob::runAsync(ik9);
+        queued.cancel();
+        ASSERT(queued.getStatus() == ToolJob::Cancelled);
+        running.cancel();
+        ASSERT_THROW(RunCancelled, running.get());
+        ASSERT(running.getStatus() == ToolJob::Cancelled);
+        ASSERT(!std::ifstream(ik8.getOutputMotionFileName()).good());
+        cout << "testInverseKinematicsGait2354 job passed" << endl;
+
+        // Relaxing the accuracy of smooth stretches keeps the solution
+        // within the tolerance of the standard.
+        InverseKinematicsTool ik10("subject01_Setup_InverseKinematics.xml");
+        ik10.setAdaptiveAccuracy(1e-3);
+        ik10.setOutputMotionFileName("subject01_walk1_ik_adaptive.mot");
+        ik10.run();
+        CHECK_STORAGE_AGAINST_STANDARD(ik10.getOutputStorage(), standard,
+            std::vector<double>(24, 0.2), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 with adaptive accuracy failed");
+        cout << "testInverseKinematicsGait2354 adaptive accuracy passed"
+             << endl;
+
         InverseKinematicsTool ik3("constraintTest_setup_ik.xml");
         ik3.run();
         cout << "testInverseKinematicsCosntraintTest passed" << endl;
@@ -23,6 +23,7 @@
 
 
 // INCLUDES
+#include <fstream>
 #include <string>
 #include <OpenSim/version.h>
 #include <OpenSim/Common/Storage.h>
@@ -30,6 +31,7 @@
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/ScaleTool.h>
+#include <OpenSim/Tools/BatchScaleTool.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Simulation/Model/MarkerSet.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
@@ -46,6 +48,8 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Tools/GenericModelMaker.h>
+#include <OpenSim/Tools/ModelPopulation.h>
+#include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 
 using namespace OpenSim;
 using std::cout; using std::endl;
@@ -53,6 +57,8 @@ using std::cout; using std::endl;
 void scaleGait2354();
 void scaleGait2354_GUI(bool useMarkerPlacement);
 void scaleModelWithLigament();
+void scaleBatch();
+void scalePopulation();
 bool compareStdScaleToComputed(const ScaleSet& std, const ScaleSet& comp);
 
 // Test scaling PhysicalOffsetFrames and models with atypical ownership trees.
@@ -67,6 +73,8 @@ int main()
         scaleGait2354();
         scaleGait2354_GUI(false);
         scaleModelWithLigament();
+        scaleBatch();
+        scalePopulation();
         scalePhysicalOffsetFrames();
         scaleJointsAndConstraints();
     }
@@ -112,8 +120,8 @@ void compareModelToStandard(const std::string&  resultFilename,
         OPENSIM_THROW_IF(!target->hasComponent(absPathStr), Exception,
             "Marker '" + absPathStr + "' not found in standard model.");
 
-        const Vec3& result_loc = mResult.get_location();
-        const Vec3& target_loc =
+        const SimTK::Vec3& result_loc = mResult.get_location();
+        const SimTK::Vec3& target_loc =
             target->getComponent<Marker>(absPathStr).get_location();
 
         cout << "  '" << absPathStr << "' - location: " << result_loc << endl;
@@ -146,9 +154,9 @@ void compareModelToStandard(const std::string&  resultFilename,
         cout << "  '" << absPathStr << "'" << endl;
         for (int i = 0; i < gpResult.getPathPointSet().getSize(); ++i)
         {
-            const Vec3& result_loc =
+            const SimTK::Vec3& result_loc =
                 gpResult.getPathPointSet()[i].getLocation(sResult);
-            const Vec3& target_loc =
+            const SimTK::Vec3& target_loc =
                 target->getComponent<GeometryPath>(absPathStr)
                 .getPathPointSet()[i].getLocation(sTarget);
 
@@ -316,6 +324,136 @@ void scaleModelWithLigament()
                            std_scaledModelFile, 1.0e-6);
 }
 
+void scaleBatch()
+{
+    // Remove old results if any
+    for (const auto& file : {"subject01_scaleSet_applied.xml",
+                             "subject01_simbody.osim",
+                             "toyLigamentModelScaled.osim"}) {
+        FILE* file2Remove = IO::OpenFile(file, "w");
+        fclose(file2Remove);
+    }
+
+    // Scale both subjects at once; each writes its outputs and log to its
+    // own files.
+    BatchScaleTool batch;
+    batch.addSubject("subject01_Setup_Scale.xml");
+    batch.addSubject("toyLigamentModel_Setup_Scale.xml");
+    batch.setNumThreads(2);
+    batch.setWriteLogFiles(true);
+    const auto& results = batch.run();
+    ASSERT(results.size() == 2);
+    for (const auto& result : results) {
+        cout << result.log << endl;
+        ASSERT(result.success, __FILE__, __LINE__, result.error);
+        ASSERT(!result.log.empty());
+    }
+    // The logs are not interleaved.
+    ASSERT(results[0].log.find("toyLigament") == std::string::npos);
+    ASSERT(results[1].log.find("subject01") == std::string::npos);
+    std::ifstream logFile(batch.getSubject(1).getName() + "_scale.log");
+    ASSERT(logFile.good());
+
+    const ScaleSet stdScaleSet("std_subject01_scaleSet_applied.xml");
+    const ScaleSet computedScaleSet("subject01_scaleSet_applied.xml");
+    ASSERT(compareStdScaleToComputed(stdScaleSet, computedScaleSet));
+    compareModelToStandard("subject01_simbody.osim",
+                           "std_subject01_simbody.osim", 1.0e-6);
+
+    Model comp("toyLigamentModelScaled.osim");
+    Model std("std_toyLigamentModelScaled.osim");
+    comp.setup();
+    std.setup();
+    ASSERT(std == comp, __FILE__, __LINE__,
+            "Standard model failed to match scaled.");
+}
+
+void scalePopulation()
+{
+    using SimTK::Vec3;
+    using SimTK::Inertia;
+    using SimTK::State;
+
+    // An arm with a rigid-tendon muscle from the ground to the arm.
+    Model generic;
+    generic.setName("arm");
+    auto* arm = new OpenSim::Body("arm", 2.0, Vec3(0, -0.25, 0), Inertia(0.1));
+    generic.addBody(arm);
+    auto* shoulder = new PinJoint("shoulder", generic.getGround(), Vec3(0),
+                                  Vec3(0), *arm, Vec3(0), Vec3(0));
+    generic.addJoint(shoulder);
+    auto* muscle = new Millard2012EquilibriumMuscle("muscle", 100, 0.1, 0.2,
+                                                     0.1);
+    muscle->set_ignore_tendon_compliance(true);
+    muscle->addNewPathPoint("origin", generic.updGround(), Vec3(0.05, 0, 0));
+    muscle->addNewPathPoint("insertion", *arm, Vec3(0.05, -0.3, 0));
+    generic.addForce(muscle);
+
+    ModelPopulation population(generic);
+    const double factors[] = {0.9, 1.0, 1.2};
+    for (int j = 0; j < 3; ++j) {
+        ScaleSet scaleSet;
+        auto* scale = new Scale();
+        scale->setSegmentName("arm");
+        scale->setScaleFactors(Vec3(factors[j]));
+        scale->setApply(true);
+        scaleSet.adoptAndAppend(scale);
+        population.addScaledSubject("subject" + std::to_string(j),
+                                    scaleSet);
+    }
+    ASSERT(population.getNumSubjects() == 3);
+    ASSERT(population.getNumMuscles() == 1);
+    const auto& params = population.getMuscleParameters(0);
+    ASSERT(params.optimalFiberLength[0] < params.optimalFiberLength[2]);
+
+    // A model with other components is not part of the population.
+    Model other(generic);
+    other.addMarker(new Marker("marker", other.getGround(), Vec3(0)));
+    ASSERT_THROW(Exception, population.addSubject("other", other));
+
+    // Swing the arm.
+    const Coordinate& coord = generic.getCoordinateSet()[0];
+    TimeSeriesTable coordinates;
+    coordinates.setColumnLabels({coord.getName(),
+                                 coord.getAbsolutePathString() + "/speed"});
+    const int numFrames = 10;
+    for (int f = 0; f < numFrames; ++f) {
+        const double t = 0.1*f;
+        coordinates.appendRow(t, SimTK::RowVector(SimTK::Vec2(
+            0.5*std::sin(2*SimTK::Pi*t),
+            SimTK::Pi*std::cos(2*SimTK::Pi*t))));
+    }
+    const auto kinematics = population.computePathKinematics(coordinates, 2);
+    SimTK::Matrix activations(3, numFrames);
+    for (int f = 0; f < numFrames; ++f)
+        for (int j = 0; j < 3; ++j) activations(j, f) = 0.1*(f % 5) + 0.2*j;
+    const SimTK::Matrix forces = population.calcRigidTendonForces(0,
+            kinematics.lengths[0], kinematics.lengtheningSpeeds[0],
+            activations);
+
+    // Each subject's own model gives the same results.
+    for (int j = 0; j < 3; ++j) {
+        std::unique_ptr<Model> model(population.getSubjectModel(j).clone());
+        State& s = model->initSystem();
+        const auto& subjectMuscle =
+            model->getComponent<Millard2012EquilibriumMuscle>("muscle");
+        const Coordinate& subjectCoord = model->getCoordinateSet()[0];
+        for (int f = 0; f < numFrames; ++f) {
+            const auto row = coordinates.getRowAtIndex(f);
+            subjectCoord.setValue(s, row[0], false);
+            subjectCoord.setSpeedValue(s, row[1]);
+            subjectMuscle.setActivation(s, activations(j, f));
+            model->realizeDynamics(s);
+            ASSERT_EQUAL(subjectMuscle.getLength(s),
+                         kinematics.lengths[0](j, f), 1e-12);
+            ASSERT_EQUAL(subjectMuscle.getLengtheningSpeed(s),
+                         kinematics.lengtheningSpeeds[0](j, f), 1e-12);
+            ASSERT_EQUAL(subjectMuscle.getTendonForce(s), forces(j, f),
+                         1e-9);
+        }
+    }
+}
+
 bool compareStdScaleToComputed(const ScaleSet& std, const ScaleSet& comp) {
     for (int i = 0; i < std.getSize(); ++i) {
         const Scale& scaleStd = std[i];
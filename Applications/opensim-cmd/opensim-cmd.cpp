@@ -22,6 +22,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "opensim-cmd_run-tool.h"
+#include "opensim-cmd_run-batch.h"
+#include "opensim-cmd_bench.h"
+#include "opensim-cmd_serve.h"
 #include "opensim-cmd_print-xml.h"
 #include "opensim-cmd_info.h"
 #include "opensim-cmd_update-file.h"
@@ -54,17 +57,23 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  run-batch    Run the tools of many XML setup files in a single process.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
+  bench        Measure the performance of OpenSim on reference models.
+  serve        Keep models loaded, and run requests read from the input.
 
   Pass -h or --help to any of these commands to learn how to use them.
 
 Examples:
   opensim-cmd run-tool InverseDynamics_Setup.xml
+  opensim-cmd run-batch --jobs=8 jobs.txt
   opensim-cmd print-xml cmc
   opensim-cmd info PathActuator
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
+  opensim-cmd bench --format=json arm26.osim
+  opensim-cmd serve --jobs=4
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so print-xml MyCustomTool
   opensim-cmd --library=libosimMyCustomForce.dylib info MyCustomForce
@@ -83,8 +92,11 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["run-batch"] = run_batch;
     commands["info"] = info;
     commands["update-file"] = update_file;
+    commands["bench"] = bench;
+    commands["serve"] = serve;
 
     // If no arguments are provided; just print the help text.
     // -------------------------------------------------------
@@ -0,0 +1,417 @@
+#ifndef OPENSIM_CMD_BENCH_H_
+#define OPENSIM_CMD_BENCH_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  opensim-cmd_bench.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+#include "opensim-cmd_run-tool.h"
+
+#include <OpenSim/OpenSim.h>
+#include <OpenSim/version.h>
+
+static const char HELP_BENCH[] =
+R"(Measure the performance of OpenSim on reference models and setup files.
+
+Usage:
+  opensim-cmd [options]... bench [--repeat=<n>] [--filter=<regex>] [--format=<fmt>] [--output=<file>] [--setup=<file>]... [<model-file>...]
+  opensim-cmd bench -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -r <n>, --repeat <n>   Number of times each benchmark is run. [default: 5]
+  -f <regex>, --filter <regex>  Only run the benchmarks whose names contain a
+                         match of this regular expression.
+  --format <fmt>         Format of the results: table, csv or json.
+                         [default: table]
+  -o <file>, --output <file>  Write the results to this file rather than to
+                         the console.
+  -s <file>, --setup <file>  Also time running the tool of this setup file
+                         (e.g., Static Optimization or CMC). Can be repeated.
+
+Description:
+  Each benchmark is named <group>/<benchmark>. The group of the benchmarks of
+  a model is the name of its file (without extension). For each model file:
+
+            load        Read the model file.
+            initSystem  Model::initSystem() on the model just read.
+            forward     Simulate 1 s from the default state, with the
+                        default integrator and controls.
+            ik          Inverse kinematics, from the default pose, of the
+                        locations of the model's markers in another pose
+                        (only for models with markers).
+            id          Inverse dynamics in 100 poses.
+            paths       Compute the length of every GeometryPath (including
+                        wrapping) in 100 poses (only for models with paths).
+            wrapping    As paths, for the paths with wrap objects only.
+
+  Benchmarks that do not depend on a model form the group `micro`:
+
+            curves      Evaluate each default muscle curve of
+                        Millard2012EquilibriumMuscle at 10000 points.
+
+  The group of the benchmark of a setup file is `tool`; it is named after
+  the setup file. Setup files run as with `opensim-cmd run-tool`, and write
+  their results as usual.
+
+  The poses are the same on every run, so results are comparable across
+  versions and machines. Times are wall-clock times, in seconds; the minimum,
+  median, mean and maximum over the repetitions are reported. What the
+  benchmarked code prints is discarded.
+
+  Models and setup files from OpenSim's tests (e.g., arm26.osim,
+  gait2354_simbody.osim, BothLegs22.osim) are good reference inputs.
+
+Examples:
+  opensim-cmd bench arm26.osim gait2354_simbody.osim
+  opensim-cmd bench --filter=forward --format=json -o results.json arm26.osim
+  opensim-cmd bench --setup=arm26_Setup_CMC.xml --repeat=1
+  opensim-cmd bench --filter=micro
+)";
+
+// The times of the runs of a benchmark, in seconds.
+struct BenchmarkResult {
+    std::string name;
+    std::vector<double> times;
+
+    double min() const { return *std::min_element(times.begin(), times.end()); }
+    double max() const { return *std::max_element(times.begin(), times.end()); }
+    double mean() const {
+        double sum = 0;
+        for (double t : times) sum += t;
+        return sum / times.size();
+    }
+    double median() const {
+        std::vector<double> sorted(times);
+        std::sort(sorted.begin(), sorted.end());
+        const std::size_t n = sorted.size();
+        return n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+};
+
+// Discards what is printed by the code being timed.
+class BenchNullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override
+    {   return n; }
+};
+
+// Runs the benchmarks, and keeps their results.
+class BenchRunner {
+public:
+    BenchRunner(int repeat, const std::string& filter)
+        : _repeat(repeat), _hasFilter(!filter.empty()) {
+        if (_hasFilter) _filter = std::regex(filter);
+    }
+
+    bool selected(const std::string& name) const {
+        return !_hasFilter || std::regex_search(name, _filter);
+    }
+
+    // Time `body` `repeat` times, calling `prepare` (untimed) before each.
+    void run(const std::string& name, const std::function<void()>& body,
+             const std::function<void()>& prepare = {}) {
+        if (!selected(name)) return;
+        std::cerr << "Running " << name << "..." << std::endl;
+        BenchmarkResult result;
+        result.name = name;
+        BenchNullBuffer nullBuffer;
+        for (int i = 0; i < _repeat; ++i) {
+            std::streambuf* coutBuffer = std::cout.rdbuf(&nullBuffer);
+            try {
+                if (prepare) prepare();
+                const auto start = std::chrono::steady_clock::now();
+                body();
+                result.times.push_back(std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start).count());
+            } catch (...) {
+                std::cout.rdbuf(coutBuffer);
+                throw;
+            }
+            std::cout.rdbuf(coutBuffer);
+        }
+        _results.push_back(result);
+    }
+
+    const std::vector<BenchmarkResult>& getResults() const { return _results; }
+    int getRepeat() const { return _repeat; }
+
+private:
+    int _repeat;
+    bool _hasFilter;
+    std::regex _filter;
+    std::vector<BenchmarkResult> _results;
+};
+
+// Put the model in a pose near its default pose; the same i gives the same
+// pose.
+void set_bench_pose(const OpenSim::Model& model, SimTK::State& s, int i) {
+    const auto& coordinates = model.getCoordinateSet();
+    for (int j = 0; j < coordinates.getSize(); ++j) {
+        const OpenSim::Coordinate& c = coordinates[j];
+        if (c.getLocked(s) || c.isConstrained(s)) continue;
+        double q = c.getDefaultValue() + 0.1 * std::sin(double(i + j));
+        q = std::max(c.getRangeMin(), std::min(c.getRangeMax(), q));
+        c.setValue(s, q, false);
+    }
+}
+
+std::string bench_file_stem(const std::string& fileName) {
+    std::string stem = OpenSim::IO::GetFileNameFromURI(fileName);
+    const auto dot = stem.rfind('.');
+    if (dot != std::string::npos && dot > 0) stem.erase(dot);
+    return stem;
+}
+
+void bench_model(BenchRunner& runner, const std::string& modelFile) {
+
+    using namespace OpenSim;
+
+    const std::string group = bench_file_stem(modelFile) + "/";
+
+    std::unique_ptr<Model> model;
+    runner.run(group + "load",
+            [&]() { model.reset(new Model(modelFile)); },
+            [&]() { model.reset(); });
+    runner.run(group + "initSystem",
+            [&]() { model->initSystem(); },
+            [&]() { model.reset(new Model(modelFile)); });
+
+    // The remaining benchmarks share one initialized model.
+    BenchNullBuffer nullBuffer;
+    std::streambuf* coutBuffer = std::cout.rdbuf(&nullBuffer);
+    try {
+        model.reset(new Model(modelFile));
+        model->initSystem();
+    } catch (...) {
+        std::cout.rdbuf(coutBuffer);
+        throw;
+    }
+    std::cout.rdbuf(coutBuffer);
+    const SimTK::State defaultState = model->getWorkingState();
+
+    runner.run(group + "forward", [&]() {
+        SimTK::State s = defaultState;
+        Manager manager(*model);
+        manager.initialize(s);
+        manager.integrate(s.getTime() + 1.0);
+    });
+
+    if (model->getMarkerSet().getSize() > 0 && runner.selected(group + "ik")) {
+        // The markers of the model in another pose are the observations.
+        SimTK::State s = defaultState;
+        set_bench_pose(*model, s, 1);
+        model->realizePosition(s);
+        const auto& markers = model->getMarkerSet();
+        std::vector<std::string> names;
+        SimTK::RowVector_<SimTK::Vec3> locations(markers.getSize());
+        for (int i = 0; i < markers.getSize(); ++i) {
+            names.push_back(markers[i].getName());
+            locations[i] = markers[i].getLocationInGround(s);
+        }
+        TimeSeriesTable_<SimTK::Vec3> table;
+        table.setColumnLabels(names);
+        table.appendRow(defaultState.getTime(), locations);
+        MarkersReference markersReference(table);
+        SimTK::Array_<CoordinateReference> coordinateReferences;
+        InverseKinematicsSolver ik(*model, markersReference,
+                                   coordinateReferences);
+        ik.setAccuracy(1e-5);
+        runner.run(group + "ik", [&]() {
+            SimTK::State guess = defaultState;
+            ik.assemble(guess);
+        });
+    }
+
+    runner.run(group + "id", [&]() {
+        InverseDynamicsSolver id(*model);
+        SimTK::State s = defaultState;
+        const SimTK::Vector udot(s.getNU(), 0.0);
+        for (int i = 0; i < 100; ++i) {
+            set_bench_pose(*model, s, i);
+            id.solve(s, udot);
+        }
+    });
+
+    std::vector<const GeometryPath*> paths;
+    std::vector<const GeometryPath*> wrappingPaths;
+    for (const auto& path : model->getComponentList<GeometryPath>()) {
+        paths.push_back(&path);
+        if (path.getWrapSet().getSize() > 0) wrappingPaths.push_back(&path);
+    }
+    auto computePaths = [&](const std::vector<const GeometryPath*>& which) {
+        SimTK::State s = defaultState;
+        double length = 0;
+        for (int i = 0; i < 100; ++i) {
+            set_bench_pose(*model, s, i);
+            model->realizePosition(s);
+            for (const auto* path : which) length += path->getLength(s);
+        }
+        return length;
+    };
+    if (!paths.empty())
+        runner.run(group + "paths", [&]() { computePaths(paths); });
+    if (!wrappingPaths.empty())
+        runner.run(group + "wrapping", [&]() { computePaths(wrappingPaths); });
+}
+
+void bench_micro(BenchRunner& runner) {
+
+    using namespace OpenSim;
+
+    const ActiveForceLengthCurve activeForceLength;
+    const ForceVelocityCurve forceVelocity;
+    const FiberForceLengthCurve fiberForceLength;
+    const TendonForceLengthCurve tendonForceLength;
+    runner.run("micro/curves", [&]() {
+        double sum = 0;
+        for (int i = 0; i < 10000; ++i) {
+            const double x = i / 10000.0;
+            sum += activeForceLength.calcValue(0.4 + 1.2 * x);
+            sum += forceVelocity.calcValue(2.0 * x - 1.0);
+            sum += fiberForceLength.calcValue(0.8 + 0.9 * x);
+            sum += tendonForceLength.calcValue(0.99 + 0.06 * x);
+        }
+        if (SimTK::isNaN(sum)) std::cout << "NaN" << std::endl;
+    });
+}
+
+void print_bench_results(std::ostream& out, const BenchRunner& runner,
+                         const std::string& format) {
+    const auto& results = runner.getResults();
+    if (format == "json") {
+        // Names are file names, so only quotes and backslashes are escaped.
+        auto quoted = [](const std::string& s) {
+            std::string q = "\"";
+            for (char c : s) {
+                if (c == '"' || c == '\\') q += '\\';
+                q += c;
+            }
+            return q + "\"";
+        };
+        out << std::setprecision(9);
+        out << "{\n  \"opensim_version\": "
+            << quoted(OpenSim::GetVersionAndDate()) << ",\n"
+            << "  \"repeat\": " << runner.getRepeat() << ",\n"
+            << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << (i ? "," : "") << "\n    {\"name\": " << quoted(r.name)
+                << ", \"min\": " << r.min() << ", \"median\": " << r.median()
+                << ", \"mean\": " << r.mean() << ", \"max\": " << r.max()
+                << ", \"times\": [";
+            for (std::size_t j = 0; j < r.times.size(); ++j)
+                out << (j ? ", " : "") << r.times[j];
+            out << "]}";
+        }
+        out << "\n  ]\n}" << std::endl;
+    } else if (format == "csv") {
+        out << std::setprecision(9);
+        out << "name,min,median,mean,max" << std::endl;
+        for (const auto& r : results) {
+            out << r.name << "," << r.min() << "," << r.median() << ","
+                << r.mean() << "," << r.max() << std::endl;
+        }
+    } else {
+        out << std::left << std::setw(32) << "Benchmark" << std::right
+            << std::setw(12) << "Min (s)" << std::setw(12) << "Median (s)"
+            << std::setw(12) << "Mean (s)" << std::setw(12) << "Max (s)"
+            << std::endl;
+        out << std::fixed << std::setprecision(6);
+        for (const auto& r : results) {
+            out << std::left << std::setw(32) << r.name << std::right
+                << std::setw(12) << r.min() << std::setw(12) << r.median()
+                << std::setw(12) << r.mean() << std::setw(12) << r.max()
+                << std::endl;
+        }
+    }
+}
+
+int bench(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_BENCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const int repeat = std::stoi(args["--repeat"].asString());
+    if (repeat < 1) {
+        throw Exception("The number of repetitions must be positive; got "
+                + args["--repeat"].asString() + ".");
+    }
+    const auto& format = args["--format"].asString();
+    if (format != "table" && format != "csv" && format != "json") {
+        throw Exception("Unrecognized format '" + format +
+                "'; expected table, csv or json.");
+    }
+
+    BenchRunner runner(repeat,
+            args["--filter"] ? args["--filter"].asString() : std::string());
+
+    bench_micro(runner);
+    if (args["<model-file>"]) {
+        for (const auto& modelFile : args["<model-file>"].asStringList())
+            bench_model(runner, modelFile);
+    }
+    if (args["--setup"]) {
+        for (const auto& setupFile : args["--setup"].asStringList()) {
+            runner.run("tool/" + bench_file_stem(setupFile), [&]() {
+                if (!run_tool_setup_file(setupFile)) {
+                    throw Exception("Running the tool of '" + setupFile +
+                            "' failed.");
+                }
+            });
+        }
+    }
+
+    if (runner.getResults().empty()) {
+        std::cout << "No benchmarks were run." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (args["--output"]) {
+        const auto& outputFile = args["--output"].asString();
+        std::ofstream out(outputFile);
+        if (!out) {
+            throw Exception("Could not open output file '" + outputFile +
+                    "'.");
+        }
+        print_bench_results(out, runner, format);
+    } else {
+        print_bench_results(std::cout, runner, format);
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_BENCH_H_
@@ -0,0 +1,241 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+#include "opensim-cmd_run-tool.h"
+
+#include <OpenSim/OpenSim.h>
+#include <OpenSim/Auxiliary/getRSS.h>
+
+static const char HELP_RUN_BATCH[] =
+R"(Run the tools of many XML setup files in a single process.
+
+Usage:
+  opensim-cmd [options]... run-batch [--jobs=<n>] [--log-dir=<dir>] [--trace=<file>] <manifest-file>
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -j <n>, --jobs <n>     Number of Scale jobs to run at once; 0 to use the
+                         number of hardware threads. [default: 0]
+  --log-dir <dir>        Write the log of each job to this directory, rather
+                         than next to its setup file.
+  --trace <file>         Write a trace of all the jobs, as for
+                         `opensim-cmd run-tool --trace`.
+
+Description:
+  The <manifest-file> lists one setup file per line (as accepted by
+  `opensim-cmd run-tool`). Relative paths are relative to the directory of the
+  manifest. Blank lines, and lines starting with #, are ignored.
+
+  The jobs run in this process, so that libraries (and plugins) are loaded
+  once. Scale jobs run concurrently (see BatchScaleTool), and subjects that
+  scale the same generic model read it once. The other tools change the
+  working directory while they run, so their jobs run one at a time. As for
+  `run-tool`, mesh files are not read.
+
+  What each job prints is written to its log file, named after its setup file
+  with the extension .log. When all jobs are done, a report lists the result
+  of each job, the time it took, and the peak memory (resident set size) of
+  this process when it finished.
+
+  The command fails if any job fails; the other jobs still run.
+
+Examples:
+  opensim-cmd run-batch jobs.txt
+  opensim-cmd run-batch --jobs=8 --log-dir=logs jobs.txt
+  opensim-cmd run-batch --trace=batch_trace.json jobs.txt
+  opensim-cmd -L ../plugins/libosimMyPlugin.so run-batch jobs.txt
+)";
+
+// A setup file listed in the manifest of `run-batch`, and how its job went.
+struct BatchJob {
+    std::string setupFile;
+    std::string logFile;
+    bool isScale = false;
+    bool success = false;
+    std::string error;
+    double runTime = 0;
+    std::size_t peakMemory = 0;
+};
+
+// Read the setup files listed in a manifest.
+std::vector<BatchJob> read_batch_manifest(const std::string& manifestFile) {
+
+    using namespace OpenSim;
+
+    std::ifstream manifest(manifestFile);
+    if (!manifest) {
+        throw Exception("Could not open manifest file '" + manifestFile +
+                "'.");
+    }
+    const std::string manifestDir = IO::getParentDirectory(manifestFile);
+
+    std::vector<BatchJob> jobs;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        const bool isAbsolute = line[0] == '/' || line[0] == '\\' ||
+                (line.size() > 1 && line[1] == ':');
+        BatchJob job;
+        job.setupFile = isAbsolute ? line : manifestDir + line;
+        jobs.push_back(job);
+    }
+    if (jobs.empty()) {
+        throw Exception("The manifest file '" + manifestFile +
+                "' does not list any setup files.");
+    }
+    return jobs;
+}
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    std::vector<BatchJob> jobs =
+            read_batch_manifest(args["<manifest-file>"].asString());
+    const int numThreads = std::stoi(args["--jobs"].asString());
+
+    // Name the log files.
+    std::string logDir;
+    if (args["--log-dir"]) {
+        logDir = args["--log-dir"].asString();
+        IO::makeDir(logDir);
+        if (logDir.back() != '/' && logDir.back() != '\\') logDir += '/';
+    }
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        BatchJob& job = jobs[i];
+        std::string name = job.setupFile;
+        const auto dot = name.rfind('.');
+        if (dot != std::string::npos && dot > name.find_last_of("/\\") + 1)
+            name.erase(dot);
+        // Prefix the job number, since setup files in different directories
+        // may have the same name.
+        job.logFile = logDir.empty() ? name + ".log" : logDir +
+                "job" + std::to_string(i + 1) + "_" +
+                IO::GetFileNameFromURI(name) + ".log";
+    }
+
+    // The tools do not draw their models.
+    Mesh::setMeshLoadingEnabled(false);
+
+    // Spans of concurrent Scale jobs are on their own threads in the trace.
+    if (args["--trace"]) Tracer::setEnabled(true);
+
+    // Scale jobs are scaled together; the others are run below.
+    BatchScaleTool scaleBatch;
+    scaleBatch.setNumThreads(numThreads);
+    std::vector<BatchJob*> scaleJobs;
+    for (auto& job : jobs) {
+        try {
+            std::unique_ptr<Object> obj(
+                    Object::makeObjectFromFile(job.setupFile));
+            if (!dynamic_cast<ScaleTool*>(obj.get())) continue;
+            job.isScale = true;
+            scaleBatch.addSubject(job.setupFile);
+            scaleJobs.push_back(&job);
+        } catch (const std::exception&) {
+            // Let the job report the error below.
+            job.isScale = false;
+        }
+    }
+    if (!scaleJobs.empty()) {
+        std::cout << "Scaling " << scaleJobs.size() << " subject(s)."
+                  << std::endl;
+        const auto& results = scaleBatch.run();
+        const std::size_t peakMemory = getPeakRSS();
+        for (std::size_t i = 0; i < scaleJobs.size(); ++i) {
+            BatchJob& job = *scaleJobs[i];
+            job.success = results[i].success;
+            job.error = results[i].error;
+            job.runTime = results[i].runTime;
+            job.peakMemory = peakMemory;
+            std::ofstream log(job.logFile);
+            log << results[i].log;
+            if (!job.error.empty()) log << job.error << std::endl;
+        }
+    }
+
+    for (auto& job : jobs) {
+        if (job.isScale) continue;
+        std::cout << "Running " << job.setupFile << "." << std::endl;
+        std::ofstream log(job.logFile);
+        std::streambuf* coutBuffer = std::cout.rdbuf(log.rdbuf());
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            job.success = run_tool_setup_file(job.setupFile);
+        } catch (const std::exception& e) {
+            job.error = e.what();
+            std::cout << job.error << std::endl;
+        }
+        job.runTime = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        std::cout.rdbuf(coutBuffer);
+        job.peakMemory = getPeakRSS();
+    }
+
+    if (args["--trace"]) {
+        Tracer::setEnabled(false);
+        Tracer::writeChromeTrace(args["--trace"].asString());
+    }
+
+    // Report.
+    int numFailed = 0;
+    std::cout << std::endl << std::left
+              << std::setw(6) << "Job" << std::setw(10) << "Result"
+              << std::setw(12) << "Time (s)" << std::setw(18)
+              << "Peak memory (MB)" << "Setup file" << std::endl;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        const BatchJob& job = jobs[i];
+        if (!job.success) ++numFailed;
+        std::cout << std::setw(6) << i + 1
+                  << std::setw(10) << (job.success ? "success" : "FAILED")
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << job.runTime << std::setw(18) << std::setprecision(1)
+                  << job.peakMemory / (1024.0 * 1024.0)
+                  << job.setupFile << std::endl;
+        if (!job.error.empty())
+            std::cout << "      " << job.error << std::endl;
+    }
+    std::cout << std::endl << "Ran " << jobs.size() << " job(s): "
+              << jobs.size() - numFailed << " succeeded, " << numFailed
+              << " failed." << std::endl;
+
+    if (numFailed == 0) return EXIT_SUCCESS;
+    else return EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
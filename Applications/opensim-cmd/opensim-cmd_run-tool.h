@@ -34,11 +34,12 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool [--trace=<file>] <setup-xml-file>
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
+  --trace <file>         Write a trace of the run (see Tracing below).
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -56,23 +57,30 @@ Description:
 
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
+  The tools do not draw the model, so the model's mesh (geometry) files are
+  not read.
+
+Tracing:
+  With --trace, the time spent reading and writing files, building models,
+  integrating, realizing, and solving each frame (IK), window (CMC) or
+  optimization (static optimization) is written to <file> in the Chrome trace
+  format. Open it in https://ui.perfetto.dev or chrome://tracing.
+
 Examples:
   opensim-cmd run-tool CMC_setup.xml
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
+  opensim-cmd run-tool --trace=ik_trace.json IK_setup.xml
 )";
 
-int run_tool(int argc, const char** argv) {
+// Run the tool defined by a setup file, and return whether it succeeded.
+// Throws if the file does not define a tool.
+bool run_tool_setup_file(const std::string& setupFile) {
 
     using namespace OpenSim;
 
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_RUN_TOOL, { argv + 1, argv + argc },
-            true); // show help if requested
-
     // Deserialize.
-    const auto& setupFile = args["<setup-xml-file>"].asString();
     auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
     if (obj == nullptr) {
         throw Exception( "A problem occurred when trying to load file '" +
@@ -102,28 +110,42 @@ int run_tool(int argc, const char** argv) {
                 "constructed properly." << std::endl;
             concreteTool.reset(tool->clone());
         }
-        const bool success = concreteTool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return concreteTool->run();
     } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
         // Tool.
         std::cout << "Preparing to run " << tool->getConcreteClassName() << "."
                   << std::endl;
-        const bool success = tool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return tool->run();
     } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
         // ScaleTool.
         std::cout << "Preparing to run " << scale->getConcreteClassName() << "."
                   << std::endl;
-        const bool success = scale->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return scale->run();
     } else {
         throw Exception("The provided file '" + setupFile + "' does not "
                 "define an OpenSim Tool. Did you intend to load a plugin?");
     }
-    return EXIT_FAILURE;
+    return false;
+}
+
+int run_tool(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_TOOL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const auto& setupFile = args["<setup-xml-file>"].asString();
+    Mesh::setMeshLoadingEnabled(false);
+    if (args["--trace"]) Tracer::setEnabled(true);
+    const bool success = run_tool_setup_file(setupFile);
+    if (args["--trace"]) {
+        Tracer::setEnabled(false);
+        Tracer::writeChromeTrace(args["--trace"].asString());
+    }
+    if (success) return EXIT_SUCCESS;
+    else return EXIT_FAILURE;
 }
 
 #endif // OPENSIM_CMD_RUN_TOOL_H_
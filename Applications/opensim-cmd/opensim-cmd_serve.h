@@ -0,0 +1,515 @@
+#ifndef OPENSIM_CMD_SERVE_H_
+#define OPENSIM_CMD_SERVE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  opensim-cmd_serve.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+#include "opensim-cmd_run-tool.h"
+
+#include <OpenSim/OpenSim.h>
+
+static const char HELP_SERVE[] =
+R"(Keep models loaded, and run requests read from the standard input.
+
+Usage:
+  opensim-cmd [options]... serve [--jobs=<n>] [--log=<file>]
+  opensim-cmd serve -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -j <n>, --jobs <n>     Number of requests to run at once; 0 to use the
+                         number of hardware threads. [default: 0]
+  --log <file>           Write what the models and tools print to this file,
+                         rather than to the standard error.
+
+Description:
+  A client starts `opensim-cmd serve` once, keeps its standard input and
+  output open, and sends many requests, so that neither the start-up of the
+  process nor the loading of models is paid for each request. Each request
+  is one line of the standard input:
+
+            <id> <request> [<arguments>...]
+
+  where <id> is chosen by the client (e.g., a number) to match responses to
+  requests. Arguments are separated by spaces; quote arguments that contain
+  spaces with ". The requests are:
+
+            load <name> <model-file>
+                        Load and initialize a model, and keep it as <name>.
+            unload <name>
+                        Forget a model.
+            models      List the loaded models (name and file).
+            names <name>
+                        List the coordinates and the muscles of a model, in
+                        the order used by `lengths` and `ik`.
+            lengths <name> <q>...
+                        The length of each muscle's path, with the model's
+                        coordinates set to <q> (one value per coordinate, in
+                        radians or meters).
+            ik <name> <marker-file> [<start-time> <end-time>]
+                        Inverse kinematics of the model's markers over the
+                        frames of <marker-file> (e.g., .trc); each frame is
+                        sent as it is solved.
+            run-tool <setup-file>
+                        Run a tool, as `opensim-cmd run-tool`.
+            stats       The number of requests of each kind, and their mean
+                        and maximum latency.
+            quit        Stop reading requests; the server exits when the
+                        requests already read are done. The end of the
+                        standard input has the same effect.
+
+  Requests run concurrently on a pool of --jobs threads, so responses may not
+  be in the order of the requests. Each request is answered by zero or more
+  data lines, then one final line:
+
+            <id> data <values>...
+            <id> ok <latency> [<values>...]
+            <id> error <latency> <message>
+
+  where <latency> is the time, in milliseconds, from reading the request to
+  answering it. Lines are written whole, and flushed.
+
+  A loaded model has one initialized copy for each request that uses it at
+  the same time; copies are made (once) the first time they are needed. Tools
+  change the working directory while they run, so `run-tool` requests run one
+  at a time. As for `run-tool`, mesh files are not read.
+
+Examples:
+  opensim-cmd serve
+  opensim-cmd serve --jobs=4 --log=server.log
+  opensim-cmd -L ../plugins/libosimMyPlugin.so serve
+
+  A session (> is a request, < a response):
+
+      > 1 load arm arm26.osim
+      < 1 ok 180.2 2 6
+      > 2 lengths arm 0.1 0.5
+      < 2 ok 0.9 0.1621 0.1423 0.1603 0.1587 0.2198 0.1212
+)";
+
+// A model kept by `serve`, with the initialized copies of it that requests
+// are not using.
+struct ServeModel {
+    std::string file;
+    std::unique_ptr<OpenSim::Model> model;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<OpenSim::Model>> idle;
+};
+
+// Lends an initialized copy of a ServeModel to one request.
+class ServeModelLease {
+public:
+    explicit ServeModelLease(std::shared_ptr<ServeModel> served)
+            : _served(std::move(served)) {
+        {
+            std::lock_guard<std::mutex> lock(_served->mutex);
+            if (!_served->idle.empty()) {
+                _model = std::move(_served->idle.back());
+                _served->idle.pop_back();
+                return;
+            }
+        }
+        _model.reset(_served->model->clone());
+        _model->initSystem();
+    }
+    ~ServeModelLease() {
+        std::lock_guard<std::mutex> lock(_served->mutex);
+        _served->idle.push_back(std::move(_model));
+    }
+    OpenSim::Model& model() { return *_model; }
+private:
+    std::shared_ptr<ServeModel> _served;
+    std::unique_ptr<OpenSim::Model> _model;
+};
+
+// A request read by `serve`.
+struct ServeRequest {
+    std::string id;
+    std::vector<std::string> args;
+    std::chrono::steady_clock::time_point received;
+};
+
+// Split a request line into arguments, separated by spaces; quoted
+// arguments may contain spaces.
+std::vector<std::string> split_serve_request(const std::string& line) {
+    std::vector<std::string> args;
+    std::string arg;
+    bool inArg = false, inQuotes = false;
+    for (char c : line) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            inArg = true;
+        } else if (!inQuotes && std::isspace(static_cast<unsigned char>(c))) {
+            if (inArg) args.push_back(arg);
+            arg.clear();
+            inArg = false;
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+    if (inArg) args.push_back(arg);
+    return args;
+}
+
+// Runs the requests of `serve` on a pool of threads.
+class Server {
+public:
+    Server(std::ostream& out, int numThreads) : _out(out) {
+        if (numThreads <= 0)
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 0; i < numThreads; ++i)
+            _workers.emplace_back(&Server::work, this);
+    }
+
+    // Queue a request line (other than quit).
+    void submit(const std::string& line) {
+        ServeRequest request;
+        request.received = std::chrono::steady_clock::now();
+        request.args = split_serve_request(line);
+        if (request.args.empty()) return;
+        request.id = request.args.front();
+        request.args.erase(request.args.begin());
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _queue.push_back(std::move(request));
+        }
+        _queueChanged.notify_one();
+    }
+
+    // Run the queued requests, then stop the threads.
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _done = true;
+        }
+        _queueChanged.notify_all();
+        for (auto& worker : _workers) worker.join();
+        _workers.clear();
+    }
+
+    // Answer with a final line.
+    void respond(const ServeRequest& request, bool success,
+            const std::string& values) {
+        const double latency = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - request.received).count();
+        const std::string kind =
+                request.args.empty() ? "" : request.args.front();
+        {
+            std::lock_guard<std::mutex> lock(_statsMutex);
+            Latencies& latencies = _latencies[kind];
+            ++latencies.count;
+            latencies.total += latency;
+            latencies.max = std::max(latencies.max, latency);
+        }
+        std::ostringstream line;
+        line << request.id << (success ? " ok " : " error ") << std::fixed
+             << std::setprecision(1) << latency;
+        if (!values.empty()) line << " " << values;
+        write(line.str());
+    }
+
+    // Answer with a data line.
+    void send(const ServeRequest& request, const std::string& values) {
+        write(request.id + " data " + values);
+    }
+
+private:
+    struct Latencies {
+        int count = 0;
+        double total = 0;
+        double max = 0;
+    };
+
+    void write(const std::string& line) {
+        std::lock_guard<std::mutex> lock(_outMutex);
+        _out << line << std::endl;
+    }
+
+    void work() {
+        while (true) {
+            ServeRequest request;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _queueChanged.wait(lock,
+                        [this] { return _done || !_queue.empty(); });
+                if (_queue.empty()) return;
+                request = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            try {
+                run(request);
+            } catch (const std::exception& e) {
+                std::string message = e.what();
+                std::replace(message.begin(), message.end(), '\n', ' ');
+                respond(request, false, message);
+            }
+        }
+    }
+
+    std::shared_ptr<ServeModel> findModel(const std::string& name) {
+        std::lock_guard<std::mutex> lock(_modelsMutex);
+        const auto it = _models.find(name);
+        if (it == _models.end())
+            throw OpenSim::Exception("No model named '" + name + "'.");
+        return it->second;
+    }
+
+    static void checkNumArgs(const ServeRequest& request, std::size_t min,
+            std::size_t max, const std::string& usage) {
+        if (request.args.size() < min || request.args.size() > max) {
+            throw OpenSim::Exception("Expected '" + request.args.front() +
+                    (usage.empty() ? "" : " " + usage) + "'.");
+        }
+    }
+
+    static std::string join(const std::vector<double>& values) {
+        std::ostringstream stream;
+        stream << std::setprecision(10);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            stream << (i ? " " : "") << values[i];
+        return stream.str();
+    }
+
+    void run(const ServeRequest& request) {
+        using namespace OpenSim;
+        const std::vector<std::string>& args = request.args;
+        if (args.empty())
+            throw Exception("Expected a request after '" + request.id + "'.");
+        const std::string& kind = args.front();
+
+        if (kind == "load") {
+            checkNumArgs(request, 3, 3, "<name> <model-file>");
+            auto served = std::make_shared<ServeModel>();
+            served->file = args[2];
+            {
+                // Models and tools print as they are read.
+                std::lock_guard<std::mutex> lock(_consoleMutex);
+                served->model.reset(new Model(served->file));
+            }
+            served->model->initSystem();
+            const Model& model = *served->model;
+            const int numMuscles = model.getMuscles().getSize();
+            const int numCoordinates = model.getNumCoordinates();
+            // Have a copy ready for the first request.
+            served->idle.emplace_back(served->model->clone());
+            served->idle.back()->initSystem();
+            {
+                std::lock_guard<std::mutex> lock(_modelsMutex);
+                _models[args[1]] = served;
+            }
+            respond(request, true, std::to_string(numCoordinates) + " " +
+                    std::to_string(numMuscles));
+
+        } else if (kind == "unload") {
+            checkNumArgs(request, 2, 2, "<name>");
+            std::lock_guard<std::mutex> lock(_modelsMutex);
+            if (_models.erase(args[1]) == 0)
+                throw Exception("No model named '" + args[1] + "'.");
+            respond(request, true, "");
+
+        } else if (kind == "models") {
+            checkNumArgs(request, 1, 1, "");
+            std::map<std::string, std::string> files;
+            {
+                std::lock_guard<std::mutex> lock(_modelsMutex);
+                for (const auto& served : _models)
+                    files[served.first] = served.second->file;
+            }
+            for (const auto& file : files)
+                send(request, file.first + " " + file.second);
+            respond(request, true, std::to_string(files.size()));
+
+        } else if (kind == "names") {
+            checkNumArgs(request, 2, 2, "<name>");
+            const Model& model = *findModel(args[1])->model;
+            std::string coordinates = "coordinates";
+            for (int i = 0; i < model.getNumCoordinates(); ++i)
+                coordinates += " " + model.getCoordinateSet()[i].getName();
+            std::string muscles = "muscles";
+            for (int i = 0; i < model.getMuscles().getSize(); ++i)
+                muscles += " " + model.getMuscles()[i].getName();
+            send(request, coordinates);
+            send(request, muscles);
+            respond(request, true, "");
+
+        } else if (kind == "lengths") {
+            if (args.size() < 2) checkNumArgs(request, 2, 2, "<name> <q>...");
+            ServeModelLease lease(findModel(args[1]));
+            Model& model = lease.model();
+            const CoordinateSet& coordinates = model.getCoordinateSet();
+            checkNumArgs(request, 2 + coordinates.getSize(),
+                    2 + coordinates.getSize(), "<name> <q>... (" +
+                    std::to_string(coordinates.getSize()) + " values)");
+            SimTK::State s = model.getWorkingState();
+            for (int i = 0; i < coordinates.getSize(); ++i)
+                coordinates[i].setValue(s, std::stod(args[2 + i]), false);
+            model.realizePosition(s);
+            std::vector<double> lengths;
+            for (int i = 0; i < model.getMuscles().getSize(); ++i)
+                lengths.push_back(model.getMuscles()[i].getLength(s));
+            respond(request, true, join(lengths));
+
+        } else if (kind == "ik") {
+            if (args.size() != 5)
+                checkNumArgs(request, 3, 3,
+                        "<name> <marker-file> [<start-time> <end-time>]");
+            ServeModelLease lease(findModel(args[1]));
+            Model& model = lease.model();
+            MarkersReference markersRef(args[2], model.getLengthUnits());
+            const auto& times = markersRef.getMarkerTable()
+                    .getIndependentColumn();
+            double startTime = times.front(), endTime = times.back();
+            if (args.size() == 5) {
+                startTime = std::stod(args[3]);
+                endTime = std::stod(args[4]);
+            }
+            SimTK::Array_<CoordinateReference> coordinateRefs;
+            InverseKinematicsSolver ikSolver(model, markersRef,
+                                             coordinateRefs);
+            const CoordinateSet& coordinates = model.getCoordinateSet();
+            SimTK::State s = model.getWorkingState();
+            int numFrames = 0;
+            std::vector<double> values(1 + coordinates.getSize());
+            for (double time : times) {
+                if (time < startTime || time > endTime) continue;
+                s.updTime() = time;
+                if (numFrames == 0) ikSolver.assemble(s);
+                else ikSolver.track(s);
+                values[0] = time;
+                for (int i = 0; i < coordinates.getSize(); ++i)
+                    values[1 + i] = coordinates[i].getValue(s);
+                send(request, join(values));
+                ++numFrames;
+            }
+            respond(request, true, std::to_string(numFrames));
+
+        } else if (kind == "run-tool") {
+            checkNumArgs(request, 2, 2, "<setup-file>");
+            std::lock_guard<std::mutex> lock(_consoleMutex);
+            const bool success = run_tool_setup_file(args[1]);
+            respond(request, success, success ? "" : "The tool failed.");
+
+        } else if (kind == "stats") {
+            checkNumArgs(request, 1, 1, "");
+            std::map<std::string, Latencies> latencies;
+            {
+                std::lock_guard<std::mutex> lock(_statsMutex);
+                latencies = _latencies;
+            }
+            for (const auto& kindLatencies : latencies) {
+                const Latencies& l = kindLatencies.second;
+                std::ostringstream values;
+                values << kindLatencies.first << " " << l.count << " "
+                       << std::fixed << std::setprecision(1)
+                       << l.total / l.count << " " << l.max;
+                send(request, values.str());
+            }
+            respond(request, true, std::to_string(latencies.size()));
+
+        } else {
+            throw Exception("'" + kind + "' is not a request of "
+                    "`opensim-cmd serve`.");
+        }
+    }
+
+    std::ostream& _out;
+    std::mutex _outMutex;
+    std::vector<std::thread> _workers;
+
+    std::mutex _queueMutex;
+    std::condition_variable _queueChanged;
+    std::deque<ServeRequest> _queue;
+    bool _done = false;
+
+    std::mutex _modelsMutex;
+    std::map<std::string, std::shared_ptr<ServeModel>> _models;
+
+    // Held while reading model files and running tools, which print and
+    // change the working directory.
+    std::mutex _consoleMutex;
+
+    std::mutex _statsMutex;
+    std::map<std::string, Latencies> _latencies;
+};
+
+int serve(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_SERVE, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const int numThreads = std::stoi(args["--jobs"].asString());
+
+    // The responses are the only output on the standard output; what the
+    // models and tools print goes to the log.
+    std::ofstream logFile;
+    if (args["--log"]) {
+        logFile.open(args["--log"].asString());
+        if (!logFile) {
+            throw Exception("Could not open log file '" +
+                    args["--log"].asString() + "'.");
+        }
+    }
+    std::ostream out(std::cout.rdbuf());
+    std::streambuf* coutBuffer = std::cout.rdbuf(
+            logFile.is_open() ? logFile.rdbuf() : std::cerr.rdbuf());
+
+    Mesh::setMeshLoadingEnabled(false);
+
+    Server server(out, numThreads);
+    std::string line;
+    std::string quitId;
+    while (std::getline(std::cin, line)) {
+        const auto words = split_serve_request(line);
+        if (words.size() >= 2 && words[1] == "quit") {
+            quitId = words[0];
+            break;
+        }
+        server.submit(line);
+    }
+    server.finish();
+    if (!quitId.empty()) out << quitId << " ok" << std::endl;
+
+    std::cout.rdbuf(coutBuffer);
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_SERVE_H_
@@ -46,10 +46,17 @@ Description:
   version number is generally not the same as the OpenSim software version
   number.
 
+  If <input-file> is an .osim file and <output-file> is the same file name
+  with the extension .osimb, the precompiled model file is written instead.
+  It holds data that is expensive to compute when loading the model (e.g.,
+  muscle curves). Any command or tool that loads the .osim file uses the
+  precompiled file automatically while it is newer than the .osim file.
+
 Examples:
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
   opensim-cmd update-file RRA_taskset_v3.3.xml RRA_taskset_updated.osim
   opensim-cmd update-file data_v3.3.sto data_updated.sto
+  opensim-cmd update-file lowerlimb.osim lowerlimb.osimb
 )";
 
 int update_file(int argc, const char** argv) {
@@ -71,6 +78,20 @@ int update_file(int argc, const char** argv) {
     }
     std::string extension = inputFile.substr(extSep);
 
+    // Precompiled model file.
+    if (extension == ".osim" && outputFile.size() >= 6 &&
+            outputFile.substr(outputFile.size() - 6) == ".osimb") {
+        if (outputFile != Model::getPrecompiledFileName(inputFile)) {
+            throw Exception("The precompiled model file for '" + inputFile +
+                    "' must be named '" +
+                    Model::getPrecompiledFileName(inputFile) + "'.");
+        }
+        std::cout << "Printing precompiled model file '" << outputFile
+                  << "'." << std::endl;
+        Model::writePrecompiledFile(inputFile);
+        return EXIT_SUCCESS;
+    }
+
     // .osim or .xml file.
     if (extension == ".osim" || extension == ".xml") {
         std::cout << "Loading input file '" << inputFile << "'." << std::endl;
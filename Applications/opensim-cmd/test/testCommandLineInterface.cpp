@@ -23,9 +23,11 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <regex>
+#include <sstream>
 // We do *not* include OpenSim headers, since we are only interacting with
 // OpenSim through its command-line interface. But we do use Simbody's testing
 // macros.
@@ -323,6 +325,165 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run the tools of many XML setup files");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            StartsWith("Arguments did not match expected patterns"));
+    testCommand("run-batch putes.txt", EXIT_FAILURE,
+            "Could not open manifest file 'putes.txt'.\n");
+    {
+        std::ofstream manifest("testrunbatch_empty.txt");
+        manifest << "# No jobs.\n\n";
+    }
+    testCommand("run-batch testrunbatch_empty.txt", EXIT_FAILURE,
+            "The manifest file 'testrunbatch_empty.txt' does not list any "
+            "setup files.\n");
+
+    // Jobs that fail do not stop the others, and are reported.
+    // ========================================================
+    testCommand("print-xml cmc testrunbatch_cmc_setup.xml", EXIT_SUCCESS,
+            "Printing 'testrunbatch_cmc_setup.xml'.\n");
+    testCommand("print-xml scale testrunbatch_scale_setup.xml", EXIT_SUCCESS,
+            "Printing 'testrunbatch_scale_setup.xml'.\n");
+    {
+        std::ofstream manifest("testrunbatch_manifest.txt");
+        manifest << "# Both of these fail, since the setups are empty.\n"
+                 << "testrunbatch_cmc_setup.xml\n"
+                 << "  testrunbatch_scale_setup.xml  \n";
+    }
+    testCommand("run-batch --jobs=2 testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(Scaling 1 subject\\(s\\).)" + RE_ANY +
+                       "(Running testrunbatch_cmc_setup.xml.)" + RE_ANY +
+                       "(1 +FAILED)" + RE_ANY + "(2 +FAILED)" + RE_ANY +
+                       "(Ran 2 job\\(s\\): 0 succeeded, 2 failed.)\n"));
+    // What the jobs printed is in their logs.
+    {
+        std::ifstream log("testrunbatch_cmc_setup.log");
+        std::stringstream contents;
+        contents << log.rdbuf();
+        if (contents.str().find("No model file was specified") ==
+                std::string::npos) {
+            throw std::runtime_error(
+                    "Expected the log of the CMC job to contain its error.");
+        }
+    }
+
+    // The trace option writes the spans of all the jobs.
+    // ===================================================
+    testCommand("run-batch --trace=testrunbatch_trace.json "
+                "testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY +
+                       "(Ran 2 job\\(s\\): 0 succeeded, 2 failed.)\n"));
+    {
+        std::ifstream trace("testrunbatch_trace.json");
+        std::stringstream contents;
+        contents << trace.rdbuf();
+        if (contents.str().find("\"traceEvents\":[") == std::string::npos ||
+                contents.str().find("\"name\":\"read XML\"") ==
+                std::string::npos) {
+            throw std::runtime_error(
+                    "Expected the trace to contain the reading of the "
+                    "setup files.");
+        }
+    }
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("run-batch");
+}
+
+void testBench() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Measure the performance of OpenSim");
+        testCommand("bench -h", EXIT_SUCCESS, output);
+        testCommand("bench -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("bench --repeat=0", EXIT_FAILURE,
+            "The number of repetitions must be positive; got 0.\n");
+    testCommand("bench --format=xml", EXIT_FAILURE,
+            "Unrecognized format 'xml'; expected table, csv or json.\n");
+    testCommand("bench --filter=putes", EXIT_FAILURE,
+            "No benchmarks were run.\n");
+
+    // Results.
+    // ========
+    // The micro benchmarks do not need a model.
+    testCommand("bench --filter=micro --repeat=2 --format=csv", EXIT_SUCCESS,
+            std::regex(RE_ANY + "(name,min,median,mean,max\n)" +
+                       "(micro/curves,[^\n]+\n)"));
+    testCommand("bench --filter=micro --repeat=1 --format=json "
+                "-o testbench_results.json", EXIT_SUCCESS,
+            std::regex("(Running micro/curves...)" + RE_ANY));
+    {
+        std::ifstream results("testbench_results.json");
+        std::stringstream contents;
+        contents << results.rdbuf();
+        if (!std::regex_search(contents.str(), std::regex(
+                "\"name\": \"micro/curves\", \"min\": "))) {
+            throw std::runtime_error(
+                    "Expected the JSON results to contain micro/curves.");
+        }
+    }
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("bench");
+}
+
+void testServe() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Keep models loaded, and run requests");
+        testCommand("serve -h", EXIT_SUCCESS, output);
+        testCommand("serve -help", EXIT_SUCCESS, output);
+    }
+
+    // Requests.
+    // =========
+    // With one thread, the requests are answered in order. The request after
+    // quit is not run.
+    {
+        std::ofstream requests("testserve_requests.txt");
+        requests << "1 models\n"
+                 << "2 lengths arm 0.1\n"
+                 << "\n"
+                 << "3 bleep\n"
+                 << "4 load arm \"putes putes.osim\"\n"
+                 << "5 stats\n"
+                 << "6 quit\n"
+                 << "7 models\n";
+    }
+    const std::string latency = "[0-9]+\\.[0-9]";
+    testCommand("serve --jobs=1 --log=testserve.log "
+                "< testserve_requests.txt", EXIT_SUCCESS,
+            std::regex("1 ok " + latency + " 0\n" +
+                       "2 error " + latency + " No model named 'arm'.\n" +
+                       "3 error " + latency + " 'bleep' is not a request of "
+                       "`opensim-cmd serve`.\n" +
+                       "4 error " + latency + " [^\n]+\n" +
+                       "5 data bleep 1 " + latency + " " + latency + "\n" +
+                       "5 data lengths 1 " + latency + " " + latency + "\n" +
+                       "5 data load 1 " + latency + " " + latency + "\n" +
+                       "5 data models 1 " + latency + " " + latency + "\n" +
+                       "5 ok " + latency + " 4\n" +
+                       "6 ok\n"));
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -462,6 +623,9 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
+        SimTK_SUBTEST(testBench);
+        SimTK_SUBTEST(testServe);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
@@ -69,10 +69,8 @@ for iLabel = 0 : nLabels - 1
             dataArray(iRow+1,3) = osimtable.getDependentColumnAtIndex(iLabel).get(iRow).get(2);
         end
     else
-        % If the data is double type
-        for iRow = 0 : nRows - 1
-            dataArray(iRow+1,1) = osimtable.getDependentColumnAtIndex(iLabel).getElt(iRow,0);
-        end
+        % If the data is double type, copy the column in a single call.
+        dataArray(:,1) = osimtable.getDependentColumnAtIndex(iLabel).getAsJavaArray();
     end
     
     % Get the osim table column label
@@ -91,10 +89,8 @@ end
 
 % Get the time
 time = NaN([nRows 1]);
-% read time data from table
-for iRow = 0 : nRows - 1
-    time(iRow+1,1) = osimtable.getIndependentColumn.get(iRow);
-end
+% read time data from table, in a single call
+time(:,1) = osimtable.getIndependentColumnAsVector().getAsJavaArray();
 % add time field to structure
 [structdata.time] = time;
 
@@ -198,6 +198,19 @@ using namespace SimTK;
   }
 %}
 
+// Bulk access to the independent column (e.g., the times) of a table; see
+// Vector.getAsJavaArray().
+%define DATATABLE_INDEPENDENT_COLUMN(ETY)
+%extend OpenSim::DataTable_<double, ETY> {
+    SimTK::Vector getIndependentColumnAsVector() const {
+        const std::vector<double>& column = $self->getIndependentColumn();
+        return SimTK::Vector(int(column.size()), column.data());
+    }
+}
+%enddef
+DATATABLE_INDEPENDENT_COLUMN(double)
+DATATABLE_INDEPENDENT_COLUMN(SimTK::Vec3)
+
 %import "java_simbody.i"
 
 %include <Bindings/common.i>
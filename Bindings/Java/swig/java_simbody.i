@@ -109,6 +109,16 @@ public:
 
          $self->updElt(0, i) = value;
      }
+
+     void copyToJavaArray(double values[], int size) const {
+         const int n = std::min(size, $self->nelt());
+         for (int i = 0; i < n; ++i) values[i] = $self->getElt(0, i);
+     }
+
+     void setFromJavaArray(double values[], int size) {
+         $self->resize(size);
+         for (int i = 0; i < size; ++i) $self->updElt(0, i) = values[i];
+     }
 }
 
 %extend SimTK::VectorBase<double> {
@@ -125,8 +135,78 @@ public:
 
          $self->updElt(i, 0) = value;
      }
+
+     void copyToJavaArray(double values[], int size) const {
+         const int n = std::min(size, $self->nelt());
+         for (int i = 0; i < n; ++i) values[i] = $self->getElt(i, 0);
+     }
+
+     void setFromJavaArray(double values[], int size) {
+         $self->resize(size);
+         for (int i = 0; i < size; ++i) $self->updElt(i, 0) = values[i];
+     }
 }
 
+%extend SimTK::MatrixBase<double> {
+     // Row by row.
+     void copyToJavaArray(double values[], int size) const {
+         const int nr = $self->nrow(), nc = $self->ncol();
+         if (size < nr * nc) return;
+         for (int i = 0; i < nr; ++i)
+             for (int j = 0; j < nc; ++j)
+                 values[i * nc + j] = $self->getElt(i, j);
+     }
+}
+
+// Bulk access: copy a whole vector or matrix to or from a Java (or MATLAB)
+// array in a single call, rather than one call per element.
+%javamethodmodifiers SimTK::RowVectorBase<double>::copyToJavaArray "private";
+%javamethodmodifiers SimTK::RowVectorBase<double>::setFromJavaArray "private";
+%javamethodmodifiers SimTK::VectorBase<double>::copyToJavaArray "private";
+%javamethodmodifiers SimTK::VectorBase<double>::setFromJavaArray "private";
+%javamethodmodifiers SimTK::MatrixBase<double>::copyToJavaArray "private";
+%typemap(javacode) SimTK::RowVectorBase<double> %{
+    /** The elements of this row vector, copied in a single call. */
+    public double[] getAsJavaArray() {
+        double[] values = new double[nelt()];
+        copyToJavaArray(values, values.length);
+        return values;
+    }
+
+    /** Resize this row vector to the length of the array, and copy its
+    elements in a single call. */
+    public void setFromJavaArray(double[] values) {
+        setFromJavaArray(values, values.length);
+    }
+%}
+%typemap(javacode) SimTK::VectorBase<double> %{
+    /** The elements of this vector, copied in a single call. */
+    public double[] getAsJavaArray() {
+        double[] values = new double[nelt()];
+        copyToJavaArray(values, values.length);
+        return values;
+    }
+
+    /** Resize this vector to the length of the array, and copy its elements
+    in a single call. */
+    public void setFromJavaArray(double[] values) {
+        setFromJavaArray(values, values.length);
+    }
+%}
+%typemap(javacode) SimTK::MatrixBase<double> %{
+    /** The elements of this matrix (one array per row), copied in a single
+    call. */
+    public double[][] getAsJavaArray() {
+        int nr = nrow(), nc = ncol();
+        double[] flat = new double[nr * nc];
+        copyToJavaArray(flat, flat.length);
+        double[][] values = new double[nr][nc];
+        for (int i = 0; i < nr; ++i)
+            System.arraycopy(flat, i * nc, values[i], 0, nc);
+        return values;
+    }
+%}
+
 %extend SimTK::RowVectorBase<SimTK::Vec3> {
      Vec3 get(int i) {
          if(i >= $self->nelt())
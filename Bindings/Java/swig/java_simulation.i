@@ -172,6 +172,55 @@ using namespace SimTK;
     void setDefaultControls(SimTK::Vector& newControls) {
         self->updDefaultControls() = newControls;
     }
+
+    // Bulk access: a whole frame in a single call (see also
+    // getStateVariableValues() and Vector.getAsJavaArray()).
+    SimTK::Vector getCoordinateValues(const SimTK::State& state) const {
+        const CoordinateSet& coordinates = self->getCoordinateSet();
+        SimTK::Vector values(coordinates.getSize());
+        for (int i = 0; i < coordinates.getSize(); ++i)
+            values[i] = coordinates[i].getValue(state);
+        return values;
+    }
+
+    SimTK::Vector getSpeedValues(const SimTK::State& state) const {
+        const CoordinateSet& coordinates = self->getCoordinateSet();
+        SimTK::Vector values(coordinates.getSize());
+        for (int i = 0; i < coordinates.getSize(); ++i)
+            values[i] = coordinates[i].getSpeedValue(state);
+        return values;
+    }
+
+    // The value of an Output of type double (e.g., "fiber_length" or
+    // "active_fiber_force") of each muscle, in the order of getMuscles().
+    SimTK::Vector getMuscleOutputValues(const SimTK::State& state,
+                                        const std::string& outputName) const {
+        const Set<Muscle>& muscles = self->getMuscles();
+        SimTK::Vector values(muscles.getSize());
+        for (int i = 0; i < muscles.getSize(); ++i) {
+            const auto* output = dynamic_cast<const Output<double>*>(
+                    &muscles[i].getOutput(outputName));
+            if (!output)
+                throw OpenSim::Exception("Output '" + outputName +
+                        "' of muscle '" + muscles[i].getName() +
+                        "' is not of type double.");
+            self->getSystem().realize(state, output->getDependsOnStage());
+            values[i] = output->getValue(state);
+        }
+        return values;
+    }
+}
+
+%extend OpenSim::StatesTrajectory {
+    // The value of a state variable (e.g., "knee/flexion/value") in every
+    // state of the trajectory, in a single call.
+    SimTK::Vector getStateVariableValues(const Model& model,
+                                         const std::string& path) const {
+        SimTK::Vector values(int(self->getSize()));
+        for (size_t i = 0; i < self->getSize(); ++i)
+            values[int(i)] = model.getStateVariableValue(self->get(i), path);
+        return values;
+    }
 }
 
 %typemap(javacode) OpenSim::PrescribedController %{
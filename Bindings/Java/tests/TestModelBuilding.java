@@ -55,6 +55,17 @@ class TestModelBuilding {
         arm.updCoordinateSet().get(1).setValue(state, 0.5*3.14);
         arm.equilibrateMuscles(state);
 
+        // Bulk access: a whole frame in a single call.
+        double[] q = arm.getCoordinateValues(state).getAsJavaArray();
+        assert q.length == 2 && Math.abs(q[1] - 0.5*3.14) < 1e-10;
+        assert arm.getSpeedValues(state).getAsJavaArray().length == 2;
+        double[] y = arm.getStateVariableValues(state).getAsJavaArray();
+        assert y.length == arm.getNumStateVariables();
+        double[] fiberLengths =
+            arm.getMuscleOutputValues(state, "fiber_length").getAsJavaArray();
+        assert fiberLengths.length == 1 &&
+               fiberLengths[0] == biceps.getFiberLength(state);
+
         // WrapObjects.
         WrapSphere sphere = new WrapSphere();
         arm.getGround().addWrapObject(sphere);
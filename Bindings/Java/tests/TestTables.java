@@ -769,6 +769,33 @@ class TestTables {
         }
     }
 
+    public static void test_bulk_access() {
+        Vector vec = new Vector();
+        vec.setFromJavaArray(new double[]{1, 2, 3});
+        assert vec.size() == 3 && vec.get(2) == 3;
+        double[] values = vec.getAsJavaArray();
+        assert values.length == 3 && values[0] == 1 && values[2] == 3;
+        RowVector row = new RowVector(2, 5);
+        assert row.getAsJavaArray()[1] == 5;
+
+        TimeSeriesTable table = new TimeSeriesTable();
+        StdVectorString labels = new StdVectorString();
+        labels.add("a"); labels.add("b");
+        table.setColumnLabels(labels);
+        for (int i = 0; i < 3; ++i) {
+            RowVector r = new RowVector();
+            r.setFromJavaArray(new double[]{i, 10 * i});
+            table.appendRow(0.1 * i, r);
+        }
+        double[][] matrix = table.getMatrix().getAsJavaArray();
+        assert matrix.length == 3 && matrix[0].length == 2;
+        assert matrix[2][0] == 2 && matrix[2][1] == 20;
+        double[] column = table.getDependentColumn("b").getAsJavaArray();
+        assert column.length == 3 && column[1] == 10;
+        double[] times = table.getIndependentColumnAsVector().getAsJavaArray();
+        assert times.length == 3 && times[2] == 0.1 * 2;
+    }
+
     public static void main(String[] args)  throws java.io.IOException {
         test_DataTable();
         test_DataTableVec3();
@@ -776,5 +803,6 @@ class TestTables {
         test_TimeSeriesTableVec3();
         test_FlattenWithIK();
         test_vector_rowvector();
+        test_bulk_access();
     }
 }
@@ -9,6 +9,7 @@
 #include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/ArrayPtrs.h>
+#include <OpenSim/Common/MemoryUsage.h>
 #include <OpenSim/Common/AbstractProperty.h>
 #include <OpenSim/Common/Property.h>
 #include <OpenSim/Common/PropertyGroup.h>
@@ -22,6 +23,7 @@
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Common/Units.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/CompressedFile.h>
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/SimmSpline.h>
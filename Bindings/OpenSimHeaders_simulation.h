@@ -42,6 +42,7 @@
 #include <OpenSim/Simulation/Model/Umberger2010MuscleMetabolicsProbe.h>
 
 #include <OpenSim/Simulation/Model/ModelVisualizer.h>
+#include <OpenSim/Simulation/Model/ModelRenderer.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Control/Control.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
@@ -106,6 +107,7 @@
 #include <OpenSim/Simulation/Model/ConditionalPathPoint.h>
 #include <OpenSim/Simulation/Model/MovingPathPoint.h>
 #include <OpenSim/Simulation/Model/PointForceDirection.h>
+#include <OpenSim/Simulation/Model/PolynomialPathSurrogate.h>
 #include <OpenSim/Simulation/Model/GeometryPath.h>
 #include <OpenSim/Simulation/Model/Ligament.h>
 
@@ -132,11 +134,13 @@
 #include <OpenSim/Simulation/Solver.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
 #include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Simulation/CoordinateReference.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 
 #include <OpenSim/Simulation/StatesTrajectory.h>
 #include <OpenSim/Simulation/StatesTrajectoryReporter.h>
+#include <OpenSim/Simulation/BatchModelEvaluator.h>
 
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
 #include <OpenSim/Actuators/MuscleFixedWidthPennationModel.h>
@@ -35,6 +35,7 @@
 #include <OpenSim/Tools/ScaleTool.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
+#include <OpenSim/Tools/ToolJob.h>
 
 #endif // OPENSIM_OPENSIM_HEADERS_TOOLS_H_
 
@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") actuators
+%module(package="opensim", directors="1", threads="1") actuators
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") common
+%module(package="opensim", directors="1", threads="1") common
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -70,6 +70,15 @@ using namespace SimTK;
 %rename(printToXML) OpenSim::XMLDocument::print();
 %rename(printToFile) OpenSim::Storage::print;
 
+// Release the GIL while reading and writing files.
+OPENSIM_RELEASE_GIL(OpenSim::Object::print);
+OPENSIM_RELEASE_GIL(OpenSim::Storage::Storage);
+OPENSIM_RELEASE_GIL(OpenSim::Storage::print);
+OPENSIM_RELEASE_GIL(OpenSim::FileAdapter::readFile);
+OPENSIM_RELEASE_GIL(OpenSim::FileAdapter::writeFile);
+OPENSIM_RELEASE_GIL(OpenSim::C3DFileAdapter::read);
+OPENSIM_RELEASE_GIL(OpenSim::C3DFileAdapter::readTables);
+
 
 // Memory management
 // =================
@@ -288,6 +297,236 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// NumPy views
+// ===========
+// numpy.asarray() on a DataTable (or TimeSeriesTable) returns a read-only
+// array that shares the memory of the table's matrix. The array is only valid
+// while no rows or columns are added to or removed from the table.
+%extend OpenSim::DataTable_<double, double> {
+    PyObject* _getArrayInterface() const {
+        const SimTK::MatrixView& matrix = $self->getMatrix();
+        const int nr = matrix.nrow(), nc = matrix.ncol();
+        if (nr == 0 || nc == 0)
+            return OpenSim_arrayInterface(nullptr, nr, nc, 1, 1, true, true);
+        const double* data = &matrix.getElt(0, 0);
+        const std::ptrdiff_t rowStride = nr > 1 ?
+                &matrix.getElt(1, 0) - data : 1;
+        const std::ptrdiff_t colStride = nc > 1 ?
+                &matrix.getElt(0, 1) - data : nr;
+        return OpenSim_arrayInterface(data, nr, nc, rowStride, colStride,
+                                      true, true);
+    }
+    PyObject* _getIndependentColumnArrayInterface() const {
+        const std::vector<double>& column = $self->getIndependentColumn();
+        return OpenSim_arrayInterface(column.data(),
+                Py_ssize_t(column.size()), 1, 1, 1, false, true);
+    }
+%pythoncode %{
+    __array_interface__ = property(_getArrayInterface)
+
+    def to_numpy(self):
+        """A read-only NumPy array (rows by columns) that shares the memory of
+        this table's matrix. Use numpy.array(table) for a copy."""
+        import numpy
+        return numpy.asarray(self)
+
+    def getIndependentColumnAsNumPy(self):
+        """A read-only NumPy array that shares the memory of this table's
+        independent column (e.g., the times of a TimeSeriesTable)."""
+        import numpy
+        return numpy.asarray(_ArrayView(self,
+                self._getIndependentColumnArrayInterface()))
+
+    def to_pandas(self):
+        """A pandas DataFrame with a copy of this table, indexed by the
+        independent column, with the column labels as its columns."""
+        import numpy, pandas
+        return pandas.DataFrame(numpy.array(self),
+                index=numpy.array(self.getIndependentColumnAsNumPy()),
+                columns=list(self.getColumnLabels()))
+%}
+}
+
+%extend OpenSim::Storage {
+%pythoncode %{
+    def to_numpy(self):
+        """A NumPy array (rows by columns, without the time column) with the
+        data of this Storage. The data is copied once, in C++, by
+        exportToTable()."""
+        return self.exportToTable().to_numpy()
+%}
+}
+
+%pythoncode %{
+class _ArrayView(object):
+    """Exposes an array interface, and keeps its owner alive."""
+    def __init__(self, owner, interface):
+        self._owner = owner
+        self.__array_interface__ = interface
+%}
+
+// Pickling and shared memory
+// ==========================
+// A TimeSeriesTable pickles as NumPy arrays of its times and values, its
+// column labels and its table metadata (as strings), so that it can be sent
+// to multiprocessing workers. To give many workers the same large table
+// without a copy per worker, share it with SharedTimeSeriesTable instead.
+%extend OpenSim::TimeSeriesTable_<double> {
+%pythoncode %{
+    def __reduce__(self):
+        import numpy
+        return (_timeSeriesTableFromArrays,
+                (numpy.array(self.getIndependentColumnAsNumPy()).ravel(),
+                 numpy.array(self), list(self.getColumnLabels()),
+                 _getTableMetaDataStrings(self)))
+%}
+}
+
+%pythoncode %{
+def _getTableMetaDataStrings(table):
+    return [(key, table.getTableMetaDataAsString(key))
+            for key in table.getTableMetaDataKeys()]
+
+
+def _timeSeriesTableFromArrays(times, values, labels, metadata):
+    import numpy
+    from opensim.simbody import Matrix
+    times = numpy.asarray(times, dtype=float).ravel()
+    values = numpy.asarray(values, dtype=float).reshape(len(times),
+                                                        len(labels))
+    matrix = Matrix(values.shape[0], values.shape[1])
+    if values.size:
+        numpy.asarray(matrix)[...] = values
+    table = TimeSeriesTable(times.tolist(), matrix, list(labels))
+    for key, value in metadata:
+        table.addTableMetaDataString(key, value)
+    return table
+
+
+def _attachSharedTimeSeriesTable(name, numRows, numColumns, labels,
+                                 metadata):
+    return SharedTimeSeriesTable._attach(name, numRows, numColumns, labels,
+                                         metadata)
+
+
+class SharedTimeSeriesTable(object):
+    """The times and values of a TimeSeriesTable in a block of shared memory
+    (see multiprocessing.shared_memory, Python 3.8 or later). Pickling a
+    SharedTimeSeriesTable, e.g., to pass it to the workers of a
+    multiprocessing.Pool, pickles only the name of the block, its shape, the
+    column labels and the table metadata; each worker maps the block
+    read-only instead of receiving a copy of the data::
+
+        shared = osim.SharedTimeSeriesTable(table)
+        with multiprocessing.Pool(32) as pool:
+            results = pool.map(work, [(shared, i) for i in range(32)])
+        shared.unlink()
+
+    A worker reads the data with to_numpy() and
+    getIndependentColumnAsNumPy(), which return read-only views of the shared
+    memory, or copies it into a TimeSeriesTable with to_table(). The process
+    that created the SharedTimeSeriesTable owns the block, which exists until
+    it calls unlink() (or leaves a `with` block on the SharedTimeSeriesTable);
+    the workers must not use it after that."""
+
+    def __init__(self, table):
+        import numpy
+        from multiprocessing import shared_memory
+        values = numpy.asarray(table)
+        numRows, numColumns = values.shape
+        # The times, then the values by row.
+        self._memory = shared_memory.SharedMemory(
+                create=True, size=max(1, 8 * numRows * (numColumns + 1)))
+        self._owner = True
+        self._setUp(numRows, numColumns, list(table.getColumnLabels()),
+                    _getTableMetaDataStrings(table), writeable=True)
+        self._times[...] = numpy.asarray(
+                table.getIndependentColumnAsNumPy()).ravel()
+        self._values[...] = values
+        self._times.flags.writeable = False
+        self._values.flags.writeable = False
+
+    @classmethod
+    def _attach(cls, name, numRows, numColumns, labels, metadata):
+        from multiprocessing import shared_memory
+        self = cls.__new__(cls)
+        try:
+            # Python 3.13 and later: leave the block to its owner.
+            self._memory = shared_memory.SharedMemory(name=name, track=False)
+        except TypeError:
+            self._memory = shared_memory.SharedMemory(name=name)
+        self._owner = False
+        self._setUp(numRows, numColumns, labels, metadata, writeable=False)
+        return self
+
+    def _setUp(self, numRows, numColumns, labels, metadata, writeable):
+        import numpy
+        self._labels = list(labels)
+        self._metadata = list(metadata)
+        self._times = numpy.ndarray((numRows,), dtype=numpy.float64,
+                                    buffer=self._memory.buf)
+        self._values = numpy.ndarray((numRows, numColumns),
+                                     dtype=numpy.float64,
+                                     buffer=self._memory.buf,
+                                     offset=8 * numRows)
+        self._times.flags.writeable = writeable
+        self._values.flags.writeable = writeable
+
+    def __reduce__(self):
+        return (_attachSharedTimeSeriesTable,
+                (self._memory.name, self.getNumRows(), self.getNumColumns(),
+                 self._labels, self._metadata))
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+        if self._owner:
+            self.unlink()
+
+    def getName(self):
+        """The name of the block of shared memory."""
+        return self._memory.name
+
+    def getNumRows(self):
+        return self._values.shape[0]
+
+    def getNumColumns(self):
+        return self._values.shape[1]
+
+    def getColumnLabels(self):
+        return list(self._labels)
+
+    def getTableMetaDataAsString(self, key):
+        return dict(self._metadata)[key]
+
+    def to_numpy(self):
+        """A read-only NumPy array (rows by columns) of the values, in the
+        shared memory."""
+        return self._values
+
+    def getIndependentColumnAsNumPy(self):
+        """A read-only NumPy array of the times, in the shared memory."""
+        return self._times
+
+    def to_table(self):
+        """A TimeSeriesTable with a copy of the data."""
+        return _timeSeriesTableFromArrays(self._times, self._values,
+                                          self._labels, self._metadata)
+
+    def close(self):
+        """Unmap the block from this process; the views of the data must not
+        be used afterwards."""
+        self._times = self._values = None
+        self._memory.close()
+
+    def unlink(self):
+        """Free the block (once every process has closed it). Only the owner
+        should call this."""
+        self._memory.unlink()
+%}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
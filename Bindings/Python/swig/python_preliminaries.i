@@ -18,6 +18,55 @@ own project.
 %include "typemaps.i"
 %include "std_string.i"
 
+%{
+#include <cstddef>
+// The NumPy array interface (version 3) of a block of doubles, whose element
+// (i, j) is at data[i*rowStride + j*colStride]. NumPy uses the memory in
+// place (numpy.asarray() does not copy it), and keeps a reference to the
+// object that exposed the interface.
+static PyObject* OpenSim_arrayInterface(const double* data,
+        Py_ssize_t nrow, Py_ssize_t ncol,
+        std::ptrdiff_t rowStride, std::ptrdiff_t colStride,
+        bool isMatrix, bool readOnly) {
+    static const double empty = 0;
+    const int one = 1;
+    const char* typestr =
+            *reinterpret_cast<const char*>(&one) ? "<f8" : ">f8";
+    // NumPy does not accept a null pointer, even for an empty array.
+    if (nrow == 0 || ncol == 0) { data = &empty; readOnly = true; }
+    PyObject* address = PyLong_FromVoidPtr(const_cast<double*>(data));
+    const Py_ssize_t eltSize = sizeof(double);
+    if (isMatrix) {
+        return Py_BuildValue("{s:(nn),s:s,s:(NO),s:(nn),s:i}",
+                "shape", nrow, ncol, "typestr", typestr,
+                "data", address, readOnly ? Py_True : Py_False,
+                "strides", Py_ssize_t(rowStride) * eltSize,
+                           Py_ssize_t(colStride) * eltSize,
+                "version", 3);
+    }
+    return Py_BuildValue("{s:(n),s:s,s:(NO),s:(n),s:i}",
+            "shape", nrow, "typestr", typestr,
+            "data", address, readOnly ? Py_True : Py_False,
+            "strides", Py_ssize_t(rowStride) * eltSize,
+            "version", 3);
+}
+%}
+
+// Threads
+// =======
+/*
+The modules are built with thread support (threads="1"), so that calls back
+into Python (directors, e.g., AnalysisWrapper) acquire the global interpreter
+lock (GIL). Other calls keep the GIL, except the long-running ones marked with
+OPENSIM_RELEASE_GIL, which release it while they run, so that other Python
+threads can run meanwhile. See "Using OpenSim from several threads" in the
+API guide for which objects may be used from several threads at once.
+*/
+%feature("nothreadallow");
+%define OPENSIM_RELEASE_GIL(NAME)
+%feature("nothreadallow", "0") NAME;
+%enddef
+
 /* If needed %extend will be used, these operators are not supported.*/
 %ignore *::operator[];
 %ignore *::operator=;
@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") simbody
+%module(package="opensim", directors="1", threads="1") simbody
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -120,6 +120,74 @@ These typemaps work, though.
     }
 };
 
+// NumPy views
+// ===========
+// numpy.asarray() on a Matrix, Vector or RowVector (or a view of one) returns
+// an array that shares its memory, rather than copying it element by element.
+// The array is only valid while the matrix is not resized.
+%extend SimTK::MatrixBase<double> {
+    PyObject* _getArrayInterface() {
+        const int nr = $self->nrow(), nc = $self->ncol();
+        if (nr == 0 || nc == 0)
+            return OpenSim_arrayInterface(nullptr, nr, nc, 1, 1, true, true);
+        const double* data = &$self->getElt(0, 0);
+        const std::ptrdiff_t rowStride = nr > 1 ?
+                &$self->getElt(1, 0) - data : 1;
+        const std::ptrdiff_t colStride = nc > 1 ?
+                &$self->getElt(0, 1) - data : nr;
+        SimTK_ERRCHK_ALWAYS(&$self->getElt(nr - 1, nc - 1) ==
+                data + (nr - 1) * rowStride + (nc - 1) * colStride,
+                "Matrix.__array_interface__",
+                "The storage of this matrix cannot be viewed by NumPy.");
+        return OpenSim_arrayInterface(data, nr, nc, rowStride, colStride,
+                                      true, false);
+    }
+%pythoncode %{
+    __array_interface__ = property(_getArrayInterface)
+
+    def to_numpy(self):
+        """A NumPy array that shares the memory of this matrix."""
+        import numpy
+        return numpy.asarray(self)
+%}
+};
+%extend SimTK::VectorBase<double> {
+    PyObject* _getArrayInterface() {
+        const int n = $self->size();
+        if (n == 0)
+            return OpenSim_arrayInterface(nullptr, 0, 1, 1, 1, false, true);
+        const double* data = &(*$self)[0];
+        const std::ptrdiff_t stride = n > 1 ? &(*$self)[1] - data : 1;
+        return OpenSim_arrayInterface(data, n, 1, stride, 1, false, false);
+    }
+%pythoncode %{
+    __array_interface__ = property(_getArrayInterface)
+
+    def to_numpy(self):
+        """A NumPy array that shares the memory of this vector."""
+        import numpy
+        return numpy.asarray(self)
+%}
+};
+%extend SimTK::RowVectorBase<double> {
+    PyObject* _getArrayInterface() {
+        const int n = $self->size();
+        if (n == 0)
+            return OpenSim_arrayInterface(nullptr, 0, 1, 1, 1, false, true);
+        const double* data = &(*$self)[0];
+        const std::ptrdiff_t stride = n > 1 ? &(*$self)[1] - data : 1;
+        return OpenSim_arrayInterface(data, n, 1, stride, 1, false, false);
+    }
+%pythoncode %{
+    __array_interface__ = property(_getArrayInterface)
+
+    def to_numpy(self):
+        """A NumPy array that shares the memory of this row vector."""
+        import numpy
+        return numpy.asarray(self)
+%}
+};
+
 %include <Bindings/preliminaries.i>
 %include <Bindings/simbody.i>
 
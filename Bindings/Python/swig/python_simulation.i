@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") simulation
+%module(package="opensim", directors="1", threads="1") simulation
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -49,6 +49,19 @@ using namespace SimTK;
 
 %rename(appendNative) OpenSim::ForceSet::append(Force* aForce);
 
+// Release the GIL while loading models, initializing them, simulating and
+// solving.
+OPENSIM_RELEASE_GIL(OpenSim::Model::Model);
+OPENSIM_RELEASE_GIL(OpenSim::Model::initSystem);
+OPENSIM_RELEASE_GIL(OpenSim::Model::initializeState);
+OPENSIM_RELEASE_GIL(OpenSim::Manager::integrate);
+OPENSIM_RELEASE_GIL(OpenSim::AssemblySolver::assemble);
+OPENSIM_RELEASE_GIL(OpenSim::AssemblySolver::track);
+OPENSIM_RELEASE_GIL(OpenSim::InverseDynamicsSolver::solve);
+OPENSIM_RELEASE_GIL(OpenSim::BatchModelEvaluator::evaluate);
+OPENSIM_RELEASE_GIL(OpenSim::ModelRenderer::renderToFiles);
+OPENSIM_RELEASE_GIL(OpenSim::ModelRenderer::renderTrialsToFiles);
+
 // Memory management
 // =================
 /*
@@ -167,6 +180,89 @@ SET_ADOPT_HELPER(Analysis);
 %}
 };
 
+%extend OpenSim::BatchModelEvaluator {
+%pythoncode %{
+    def evaluateNumPy(self, inputs):
+        """Evaluate the outputs at each row of a 2-D NumPy array of inputs
+        (one column per input), and return a NumPy array with a row per
+        sample and a column per output value (see getOutputLabels())::
+
+            evaluator = osim.BatchModelEvaluator(model)
+            evaluator.addOutput('/markerset/r_radius_styloid|location')
+            locations = evaluator.evaluateNumPy(numpy.zeros((1000, 2)))
+        """
+        import numpy
+        from opensim.simbody import Matrix
+        inputs = numpy.asarray(inputs, dtype=float)
+        if inputs.ndim == 1:
+            inputs = inputs.reshape(1, -1)
+        matrix = Matrix(inputs.shape[0], inputs.shape[1])
+        numpy.asarray(matrix)[...] = inputs
+        return numpy.array(self.evaluate(matrix))
+%}
+};
+
+// Pickling
+// ========
+// A Model pickles as the XML of its properties, with the precomputed curve
+// data of this process (see SmoothSegmentedFunction::writePrecomputedData()),
+// so that a multiprocessing worker that unpickles it neither reads the model
+// file nor refits the curves of its muscles. Files that the model names
+// (e.g., meshes) are found relative to the worker's working directory.
+%newobject OpenSim::Model::_fromPickleState;
+%extend OpenSim::Model {
+    PyObject* _getPickleState() const {
+        // Serialize a copy, since serializing may update the model's
+        // properties (e.g., the paths of its sockets' connectees).
+        std::unique_ptr<OpenSim::Model> copy($self->clone());
+        const std::string xml = copy->dump(true);
+        std::ostringstream curveStream(std::ios::binary);
+        OpenSim::SmoothSegmentedFunction::writePrecomputedData(curveStream);
+        const std::string curves = curveStream.str();
+        PyObject* xmlBytes =
+                PyBytes_FromStringAndSize(xml.data(), Py_ssize_t(xml.size()));
+        PyObject* curveBytes = PyBytes_FromStringAndSize(curves.data(),
+                Py_ssize_t(curves.size()));
+        PyObject* state = xmlBytes && curveBytes ?
+                PyTuple_Pack(2, xmlBytes, curveBytes) : nullptr;
+        Py_XDECREF(xmlBytes);
+        Py_XDECREF(curveBytes);
+        return state;
+    }
+    static OpenSim::Model* _fromPickleState(PyObject* xml, PyObject* curves) {
+        char* data = nullptr;
+        Py_ssize_t size = 0;
+        if (PyBytes_AsStringAndSize(curves, &data, &size) != 0) {
+            PyErr_Clear();
+            throw std::invalid_argument("Model: invalid pickled curve data.");
+        }
+        std::istringstream curveStream(std::string(data, size),
+                                       std::ios::binary);
+        OpenSim::SmoothSegmentedFunction::readPrecomputedData(curveStream);
+        if (PyBytes_AsStringAndSize(xml, &data, &size) != 0) {
+            PyErr_Clear();
+            throw std::invalid_argument("Model: invalid pickled XML.");
+        }
+        SimTK::Xml::Document document;
+        document.readFromString(std::string(data, size));
+        SimTK::Xml::Element element = document.getRootElement();
+        std::unique_ptr<OpenSim::Model> model(new OpenSim::Model());
+        model->updateFromXMLNode(element,
+                                 OpenSim::XMLDocument::getLatestVersion());
+        model->finalizeFromProperties();
+        return model.release();
+    }
+%pythoncode %{
+    def __reduce__(self):
+        return (_modelFromPickleState, self._getPickleState())
+%}
+};
+
+%pythoncode %{
+def _modelFromPickleState(xml, curves):
+    return Model._fromPickleState(xml, curves)
+%}
+
 // Pythonic operators
 // ==================
 // Allow indexing operator in python (e.g., states[i]).
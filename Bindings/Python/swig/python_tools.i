@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") tools
+%module(package="opensim", directors="1", threads="1") tools
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -48,6 +48,19 @@ using namespace SimTK;
 // ========
 // None.
 
+// Release the GIL while the tools run, and while the tools that load their
+// model on construction are constructed.
+OPENSIM_RELEASE_GIL(OpenSim::ScaleTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::InverseKinematicsTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::InverseDynamicsTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::AnalyzeTool::AnalyzeTool);
+OPENSIM_RELEASE_GIL(OpenSim::AnalyzeTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::ForwardTool::ForwardTool);
+OPENSIM_RELEASE_GIL(OpenSim::ForwardTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::CMCTool::CMCTool);
+OPENSIM_RELEASE_GIL(OpenSim::CMCTool::run);
+OPENSIM_RELEASE_GIL(OpenSim::RRATool::RRATool);
+OPENSIM_RELEASE_GIL(OpenSim::RRATool::run);
 
 %pythonappend OpenSim::ModelScaler::addScale %{
     aScale._markAdopted()
@@ -3,6 +3,13 @@ Test DataTable interface.
 """
 import os, unittest
 import opensim as osim
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+test_dir = os.path.join(os.path.dirname(os.path.abspath(osim.__file__)),
+                        'tests')
 
 class TestDataTable(unittest.TestCase):
     def test_clone(self):
@@ -565,3 +572,42 @@ class TestDataTable(unittest.TestCase):
                                                  '2_x', '2_y', '2_z')
         print(tableDouble)
         
+
+    @unittest.skipIf(np is None, 'NumPy is not installed.')
+    def test_numpy_views(self):
+        print()
+        print('Test NumPy views of Vector, RowVector and Matrix.')
+        vec = osim.Vector([1, 2, 3])
+        a = np.asarray(vec)
+        assert a.shape == (3,) and list(a) == [1, 2, 3]
+        # The array shares the memory of the vector.
+        a[1] = 20
+        assert vec[1] == 20
+        assert list(osim.RowVector([4, 5]).to_numpy()) == [4, 5]
+        mat = osim.Matrix(2, 3, 0.0)
+        m = np.asarray(mat)
+        assert m.shape == (2, 3) and m.sum() == 0
+        m[1, 2] = 7
+        assert mat.getElt(1, 2) == 7 and mat.getElt(0, 2) == 0
+        assert np.asarray(osim.Vector()).shape == (0,)
+
+        print('Test NumPy views of DataTable and Storage.')
+        table = osim.TimeSeriesTable()
+        table.setColumnLabels(('a', 'b'))
+        table.appendRow(0.1, osim.RowVector([1, 2]))
+        table.appendRow(0.2, osim.RowVector([3, 4]))
+        table.appendRow(0.3, osim.RowVector([5, 6]))
+        t = table.to_numpy()
+        assert t.shape == (3, 2)
+        assert (t == np.array([[1, 2], [3, 4], [5, 6]])).all()
+        # The view of a table is read-only.
+        assert not t.flags.writeable
+        times = table.getIndependentColumnAsNumPy()
+        assert list(times) == [0.1, 0.2, 0.3]
+        # The views keep the table alive.
+        del table
+        assert t[2, 1] == 6 and times[2] == 0.3
+
+        sto = osim.Storage(os.path.join(test_dir, 'storage.sto'))
+        s = sto.to_numpy()
+        assert s.shape == (sto.getSize(), sto.getColumnLabels().getSize() - 1)
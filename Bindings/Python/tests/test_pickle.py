@@ -0,0 +1,84 @@
+"""Pass models and tables to multiprocessing workers, by pickling and through
+shared memory.
+
+"""
+
+import multiprocessing
+import os
+import pickle
+import sys
+import unittest
+
+import opensim as osim
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+test_dir = os.path.join(os.path.dirname(os.path.abspath(osim.__file__)),
+                        'tests')
+
+# Silence warning messages if mesh (.vtp) files cannot be found.
+osim.Model.setDebugLevel(0)
+
+
+def make_table():
+    table = osim.TimeSeriesTable()
+    table.setColumnLabels(('a', 'b', 'c'))
+    for i in range(5):
+        table.appendRow(0.1 * i,
+                        osim.RowVector([10 * i, 10 * i + 1, 10 * i + 2]))
+    table.addTableMetaDataString('inDegrees', 'yes')
+    return table
+
+
+def column_sum(args):
+    shared, column = args
+    return float(shared.to_numpy()[:, column].sum())
+
+
+class TestPickle(unittest.TestCase):
+    def test_model(self):
+        model = osim.Model(os.path.join(test_dir, 'arm26.osim'))
+        copy = pickle.loads(pickle.dumps(model))
+        self.assertEqual(copy.getName(), model.getName())
+        self.assertEqual(copy.getNumCoordinates(), model.getNumCoordinates())
+        self.assertEqual(copy.getMuscles().getSize(),
+                         model.getMuscles().getSize())
+        self.assertEqual(copy.computeFingerprint(),
+                         model.computeFingerprint())
+        copy.initSystem()
+
+    @unittest.skipIf(np is None, 'NumPy is not available.')
+    def test_table(self):
+        table = make_table()
+        copy = pickle.loads(pickle.dumps(table))
+        self.assertEqual(list(copy.getColumnLabels()), ['a', 'b', 'c'])
+        self.assertTrue(np.array_equal(np.array(copy), np.array(table)))
+        self.assertTrue(np.array_equal(copy.getIndependentColumnAsNumPy(),
+                                       table.getIndependentColumnAsNumPy()))
+        self.assertEqual(copy.getTableMetaDataAsString('inDegrees'), 'yes')
+
+    @unittest.skipIf(np is None or sys.version_info < (3, 8),
+                     'Shared memory needs NumPy and Python 3.8.')
+    def test_shared_table(self):
+        table = make_table()
+        with osim.SharedTimeSeriesTable(table) as shared:
+            self.assertTrue(np.array_equal(shared.to_numpy(),
+                                           np.array(table)))
+            self.assertFalse(shared.to_numpy().flags.writeable)
+            copy = shared.to_table()
+            self.assertEqual(list(copy.getColumnLabels()), ['a', 'b', 'c'])
+            self.assertEqual(copy.getTableMetaDataAsString('inDegrees'),
+                             'yes')
+
+            # Workers map the same memory.
+            with multiprocessing.Pool(2) as pool:
+                sums = pool.map(column_sum, [(shared, j) for j in range(3)])
+            self.assertEqual(sums,
+                             [float(np.array(table)[:, j].sum())
+                              for j in range(3)])
+
+
+if __name__ == '__main__':
+    unittest.main()
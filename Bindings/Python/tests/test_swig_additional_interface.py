@@ -412,3 +412,30 @@ class TestSwigAddtlInterface(unittest.TestCase):
             assert k == names[j]
             assert k == v.getName()
             j += 1
+
+    def test_BatchModelEvaluator_evaluateNumPy(self):
+        try:
+            import numpy as np
+        except ImportError:
+            return
+        model = osim.Model(os.path.join(test_dir, "arm26.osim"))
+        state = model.initSystem()
+        evaluator = osim.BatchModelEvaluator(model)
+        evaluator.addOutput('/markerset/r_radius_styloid|location')
+        evaluator.addMomentArm('/forceset/BIClong',
+                               '/jointset/r_elbow/r_elbow_flex')
+        assert evaluator.getNumOutputColumns() == 4
+
+        # One column per coordinate (shoulder, elbow), one row per sample.
+        inputs = np.zeros((20, 2))
+        inputs[:, 1] = np.linspace(0, 2, 20)
+        results = evaluator.evaluateNumPy(inputs)
+        assert results.shape == (20, 4)
+
+        elbow = model.getCoordinateSet().get('r_elbow_flex')
+        marker = model.getMarkerSet().get('r_radius_styloid')
+        for i in [0, 7, 19]:
+            elbow.setValue(state, inputs[i, 1])
+            location = marker.getLocationInGround(state)
+            for k in range(3):
+                self.assertAlmostEqual(results[i, k], location.get(k))
@@ -0,0 +1,45 @@
+"""Run OpenSim calls that release the global interpreter lock (GIL) from
+several Python threads at once.
+
+"""
+
+import os
+import threading
+import unittest
+
+import opensim as osim
+
+test_dir = os.path.join(os.path.dirname(os.path.abspath(osim.__file__)),
+                        'tests')
+
+# Silence warning messages if mesh (.vtp) files cannot be found.
+osim.Model.setDebugLevel(0)
+
+
+def simulate(results, index):
+    # Each thread loads and simulates its own model.
+    model = osim.Model(os.path.join(test_dir, "arm26.osim"))
+    state = model.initSystem()
+    manager = osim.Manager(model)
+    state.setTime(0)
+    manager.initialize(state)
+    state = manager.integrate(0.05)
+    q = state.getQ()
+    results[index] = [q[i] for i in range(q.size())]
+
+
+class TestThreads(unittest.TestCase):
+    def test_concurrent_simulations(self):
+        expected = [None]
+        simulate(expected, 0)
+
+        numThreads = 3
+        results = [None] * numThreads
+        threads = [threading.Thread(target=simulate, args=(results, i))
+                   for i in range(numThreads)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for result in results:
+            assert result == expected[0]
@@ -1,6 +1,7 @@
 //osimActuators
 %include <OpenSim/Actuators/osimActuatorsDLL.h>
 %include <OpenSim/Actuators/CoordinateActuator.h>
+%include <OpenSim/Actuators/CoordinateActuatorGroup.h>
 %include <OpenSim/Actuators/PointActuator.h>
 %include <OpenSim/Actuators/TorqueActuator.h>
 %include <OpenSim/Actuators/BodyActuator.h>
@@ -14,6 +14,7 @@
 %include <OpenSim/Common/Exception.h>
 %include <OpenSim/Common/Array.h>
 %include <OpenSim/Common/ArrayPtrs.h>
+%include <OpenSim/Common/MemoryUsage.h>
 %include <OpenSim/Common/AbstractProperty.h>
 %include <OpenSim/Common/Property.h>
 %include <OpenSim/Common/PropertyGroup.h>
@@ -30,6 +31,7 @@
 %template(ArrayStorage) OpenSim::ArrayPtrs<OpenSim::Storage>;
 %include <OpenSim/Common/Units.h>
 %include <OpenSim/Common/IO.h>
+%include <OpenSim/Common/CompressedFile.h>
 %include <OpenSim/Common/Function.h>
 
 %template(SetFunctions) OpenSim::Set<OpenSim::Function>;
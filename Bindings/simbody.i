@@ -211,6 +211,7 @@ namespace SimTK {
 %template(SimTKArrayString) SimTK::Array_<std::string>;
 %template(SimTKArrayDouble) SimTK::Array_<double>;
 %template(SimTKArrayVec3) SimTK::Array_<SimTK::Vec3>;
+%template(SimTKArrayRotation) SimTK::Array_<SimTK::Rotation_<double>>;
 %template(SimTKArrayInt) SimTK::Array_<int>;
 }
 
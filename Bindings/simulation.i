@@ -108,6 +108,7 @@
 %include <OpenSim/Simulation/Model/ContactSphere.h>
 %include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
 %include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
+%include <OpenSim/Simulation/Model/SphereHalfSpaceContactForce.h>
 
 %include <OpenSim/Simulation/Model/Actuator.h>
 %template(SetActuators) OpenSim::Set<OpenSim::Actuator>;
@@ -163,6 +164,7 @@
 %include <OpenSim/Simulation/Model/Umberger2010MuscleMetabolicsProbe.h>
 %include <OpenSim/Simulation/Model/ModelVisualPreferences.h>
 %include <OpenSim/Simulation/Model/ModelVisualizer.h>
+%include <OpenSim/Simulation/Model/ModelRenderer.h>
 %copyctor OpenSim::Model;
 %include <OpenSim/Simulation/Model/Model.h>
 
@@ -178,6 +180,7 @@
 %include <OpenSim/Simulation/Model/PointForceDirection.h>
 %template(ArrayPointForceDirection) OpenSim::Array<OpenSim::PointForceDirection*>;
 
+%include <OpenSim/Simulation/Model/PolynomialPathSurrogate.h>
 %include <OpenSim/Simulation/Model/GeometryPath.h>
 %include <OpenSim/Simulation/Model/Ligament.h>
 %include <OpenSim/Simulation/Model/PathActuator.h>
@@ -197,11 +200,14 @@
 
 %template(ReferenceVec3) OpenSim::Reference_<SimTK::Vec3>;
 %template(ReferenceDouble) OpenSim::Reference_<double>;
+%template(ReferenceRotation) OpenSim::Reference_<SimTK::Rotation_<double>>;
 %template(SimTKArrayCoordinateReference) SimTK::Array_<OpenSim::CoordinateReference>;
 
 
 %include <OpenSim/Simulation/MarkersReference.h>
 %template(SetMarkerWeights) OpenSim::Set<MarkerWeight>;
+%include <OpenSim/Simulation/OrientationsReference.h>
+%template(SetOrientationWeights) OpenSim::Set<OrientationWeight>;
 %include <OpenSim/Simulation/CoordinateReference.h>
 %include <OpenSim/Simulation/AssemblySolver.h>
 %include <OpenSim/Simulation/InverseKinematicsSolver.h>
@@ -211,6 +217,7 @@
 %template(IteratorRangeStatesTrajectoryIterator)
     SimTK::IteratorRange<OpenSim::StatesTrajectory::const_iterator>;
 %include <OpenSim/Simulation/StatesTrajectoryReporter.h>
+%include <OpenSim/Simulation/BatchModelEvaluator.h>
 
 // Iterators.
 %template(FrameList) OpenSim::ComponentList<const OpenSim::Frame>;
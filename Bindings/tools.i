@@ -33,3 +33,4 @@
 %include <OpenSim/Tools/RRATool.h>
 %include <OpenSim/Tools/AnalyzeTool.h>
 %include <OpenSim/Tools/InverseKinematicsTool.h>
+%include <OpenSim/Tools/ToolJob.h>
@@ -30,9 +30,6 @@ using namespace std;
 //==============================================================================
 // CONSTRUCTION
 //==============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, and copy
-// assignment.
-
 // Default constructor.
 ActiveForceLengthCurve::ActiveForceLengthCurve()
 {
@@ -62,6 +59,31 @@ ActiveForceLengthCurve::ActiveForceLengthCurve(double minActiveNormFiberLength,
     ensureCurveUpToDate();
 }
 
+ActiveForceLengthCurve::ActiveForceLengthCurve(
+        const ActiveForceLengthCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+ActiveForceLengthCurve& ActiveForceLengthCurve::operator=(
+        const ActiveForceLengthCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void ActiveForceLengthCurve::copyData(const ActiveForceLengthCurve& source)
+{
+    m_curve = source.m_curve;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void ActiveForceLengthCurve::setNull()
 {
     setAuthors("Matthew Millard");
@@ -84,12 +106,32 @@ void ActiveForceLengthCurve::constructProperties()
 
 void ActiveForceLengthCurve::buildCurve()
 {
-    SimTK::Function* f = createSimTKFunction();
-    m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
-    delete f;
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+            getConcreteClassName(),
+            {get_min_norm_active_fiber_length(),
+             get_transition_norm_fiber_length(),
+             get_max_norm_active_fiber_length(),
+             get_minimum_value(),
+             get_shallow_ascending_slope()},
+            [this] { return createCurve(getConcreteClassName()); });
     setObjectIsUpToDateWithProperties();
 }
 
+SmoothSegmentedFunction* ActiveForceLengthCurve::createCurve(
+        const std::string& name) const
+{
+    return SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
+                                    get_min_norm_active_fiber_length(),
+                                    get_transition_norm_fiber_length(),
+                                    1.0,
+                                    get_max_norm_active_fiber_length(),
+                                    get_minimum_value(),
+                                    get_shallow_ascending_slope(),
+                                    1.0,
+                                    false,
+                                    name);
+}
+
 void ActiveForceLengthCurve::ensureCurveUpToDate()
 {
     if(!isObjectUpToDateWithProperties()) {
@@ -103,16 +145,7 @@ void ActiveForceLengthCurve::ensureCurveUpToDate()
 SimTK::Function* ActiveForceLengthCurve::createSimTKFunction() const
 {
     // Back the OpenSim::Function with this SimTK::Function.
-    return SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
-                                    get_min_norm_active_fiber_length(),
-                                    get_transition_norm_fiber_length(),
-                                    1.0,
-                                    get_max_norm_active_fiber_length(),
-                                    get_minimum_value(),
-                                    get_shallow_ascending_slope(),
-                                    1.0,
-                                    false,
-                                    getName());
+    return createCurve(getName());
 }
 
 //==============================================================================
@@ -155,7 +188,7 @@ double ActiveForceLengthCurve::calcValue(double normFiberLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberLength);
+    return m_curve->calcValue(normFiberLength);
 }
 
 double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
@@ -167,14 +200,14 @@ double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
         "ActiveForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberLength,order);
+    return m_curve->calcDerivative(normFiberLength,order);
 }
 
 double ActiveForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
 {
-    return m_curve.calcDerivative(derivComponents, x);
+    return m_curve->calcDerivative(derivComponents, x);
 }
 
 SimTK::Vec2 ActiveForceLengthCurve::getCurveDomain() const
@@ -182,7 +215,7 @@ SimTK::Vec2 ActiveForceLengthCurve::getCurveDomain() const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
 
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void ActiveForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -192,5 +225,19 @@ void ActiveForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     double xmin = min(0.0, get_min_norm_active_fiber_length());
     double xmax = max(2.0, get_max_norm_active_fiber_length());
 
-    m_curve.printMuscleCurveToCSVFile(path,xmin,xmax);
+    // Print a curve named after this curve, rather than the shared one.
+    std::unique_ptr<SmoothSegmentedFunction> curve{
+        createCurve(getName())};
+    curve->printMuscleCurveToCSVFile(path,xmin,xmax);
+}
+
+void ActiveForceLengthCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    // Copies of this curve share its SmoothSegmentedFunction.
+    if (m_curve) {
+        usage.addShared(MemoryUsage::Curves, m_curve.get(),
+                        m_curve->estimateMemoryUsage());
+    }
 }
@@ -28,6 +28,8 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/SmoothSegmentedFunction.h>
 
+#include <memory>
+
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
         #undef OSIMACTUATORS_API
@@ -135,6 +137,12 @@ public:
     default property values and assigns a default name. */
     ActiveForceLengthCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    ActiveForceLengthCurve(const ActiveForceLengthCurve& source);
+    ActiveForceLengthCurve& operator=(const ActiveForceLengthCurve& source);
+
     /** Constructs an active-force-length curve using the provided parameters
     and assigns a default name. */
     ActiveForceLengthCurve(double minActiveNormFiberLength,
@@ -207,7 +215,7 @@ public:
 
     /** Evaluates the active-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
 
     /** Calculates the derivative of the active-force-length multiplier with
@@ -279,13 +287,27 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const ActiveForceLengthCurve& source);
 
     // This function will take all of the current property values. If they have
     // changed since the last time the curve was built, the curve is rebuilt.
     // Curve construction costs ~20,500 flops.
+
     void buildCurve();
+    // Create the curve from the current property values, with the given
+    // name.
+    SmoothSegmentedFunction* createCurve(const std::string& name) const;
 
-    SmoothSegmentedFunction   m_curve;
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
+    // The curve is shared with all other curves of this type that have the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve()),
+    // including those of copies of this curve.
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
 };
 
 }
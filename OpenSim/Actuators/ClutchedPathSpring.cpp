@@ -110,6 +110,7 @@ void ClutchedPathSpring::setInitialStretch(double stretch0)
     // The spring force is dependent of stretch so only invalidate dynamics
     // if the stretch state changes
     addStateVariable("stretch");
+    _stretchSV = getStateVariableHandle("stretch");
 }
 
  void ClutchedPathSpring::extendInitStateFromProperties(SimTK::State& state) const
@@ -152,7 +153,7 @@ void ClutchedPathSpring::setInitialStretch(double stretch0)
 
 double ClutchedPathSpring::getStretch(const SimTK::State& s) const
 {
-    return getStateVariableValue(s, "stretch");
+    return getStateVariableValue(s, _stretchSV);
 }
 
 
@@ -173,8 +174,13 @@ double ClutchedPathSpring::computeActuation(const SimTK::State& s) const
 {
     // clamp or cap the control input to [0, 1]
     double control = SimTK::clamp(0.0, getControl(s), 1.0); 
-    double tension = control *
-                (getStiffness()*getStretch(s) *                 //elastic force
+    const double stretch = getStretch(s);
+    // a disengaged or slack spring has no tension, whatever its lengthening
+    // speed
+    double tension = 0;
+    if (control != 0 && stretch != 0)
+        tension = control *
+                (getStiffness()*stretch *                       //elastic force
                 (1+getDissipation()*getLengtheningSpeed(s)));   //dissipation 
     
     setActuation(s, tension);
@@ -188,7 +194,7 @@ void ClutchedPathSpring::
                     getLengtheningSpeed(s) : // clutch is engaged
                     -getStretch(s)/get_relaxation_time_constant();
 
-    setStateVariableDerivativeValue(s, "stretch", zdot);
+    setStateVariableDerivativeValue(s, _stretchSV, zdot);
 }
 
 SimTK::Vec3 ClutchedPathSpring::computePathColor(const SimTK::State& state) const 
@@ -148,6 +148,8 @@ private:
     void setNull();
     void constructProperties();
 
+    mutable StateVariableHandle _stretchSV;
+
 //=============================================================================
 };  // END of class ClutchedPathSpring
 
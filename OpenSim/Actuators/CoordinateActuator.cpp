@@ -63,6 +63,7 @@ void CoordinateActuator::constructProperties()
 {
     constructProperty_coordinate();
     constructProperty_optimal_force(1.0);
+    updProperty_optimal_force().setIsParameterOnly(true);
 }
 
 
@@ -203,6 +204,16 @@ void CoordinateActuator::computeForce( const SimTK::State& s,
     }
 }
 
+bool CoordinateActuator::
+addInForcesPerUnitActuation(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) const
+{
+    if(!_model || !isCoordinateValid()) return false;
+    applyGeneralizedForce(s, *_coord, 1.0, mobilityForces);
+    return true;
+}
+
 double CoordinateActuator::
 getSpeed( const SimTK::State& s) const
 {
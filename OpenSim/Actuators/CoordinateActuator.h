@@ -85,6 +85,11 @@ public:
     /** Get a pointer to the Coordinate to which this actuator refers. **/
     Coordinate* getCoordinate() const;
 
+    /** A unit generalized force on the coordinate. */
+    bool addInForcesPerUnitActuation(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -0,0 +1,170 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CoordinateActuatorGroup.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//==============================================================================
+// INCLUDES
+//==============================================================================
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/CoordinateSet.h>
+
+#include "CoordinateActuatorGroup.h"
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// CONSTRUCTOR
+//==============================================================================
+CoordinateActuatorGroup::CoordinateActuatorGroup()
+{
+    constructProperties();
+}
+
+void CoordinateActuatorGroup::constructProperties()
+{
+    constructProperty_coordinates();
+    constructProperty_optimal_forces();
+}
+
+void CoordinateActuatorGroup::addCoordinate(const string& coordinateName,
+                                            double optimalForce)
+{
+    append_coordinates(coordinateName);
+    append_optimal_forces(optimalForce);
+}
+
+//==============================================================================
+// MODEL COMPONENT INTERFACE
+//==============================================================================
+void CoordinateActuatorGroup::extendFinalizeFromProperties()
+{
+    Super::extendFinalizeFromProperties();
+
+    OPENSIM_THROW_IF_FRMOBJ(getProperty_optimal_forces().size() !=
+                            getProperty_coordinates().size(),
+        Exception,
+        "Expected one optimal force per coordinate, but there are " +
+        to_string(getProperty_coordinates().size()) + " coordinates and " +
+        to_string(getProperty_optimal_forces().size()) + " optimal forces.");
+}
+
+void CoordinateActuatorGroup::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    _coordinates.clear();
+    _coordinates.reserve(getNumCoordinates());
+    for (int i = 0; i < getNumCoordinates(); ++i) {
+        const string& coordName = get_coordinates(i);
+        OPENSIM_THROW_IF_FRMOBJ(!coordSet.contains(coordName), Exception,
+            "Invalid coordinate (" + coordName + ") specified.");
+        _coordinates.emplace_back(&coordSet.get(coordName));
+    }
+}
+
+void CoordinateActuatorGroup::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    // The mobility indices depend only on the topology of the System, but
+    // the first U index of a mobilized body is available from the State
+    // only once the Model stage is realized.
+    _mobilityIndicesCV = addCacheVariable("mobilityIndices",
+            SimTK::Array_<int>(), SimTK::Stage::Model);
+}
+
+const SimTK::Array_<int>& CoordinateActuatorGroup::getMobilityIndices(
+        const SimTK::State& s) const
+{
+    if (isCacheVariableValid(s, _mobilityIndicesCV))
+        return getCacheVariableValue(s, _mobilityIndicesCV);
+
+    const SimTK::SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    SimTK::Array_<int>& indices = updCacheVariableValue(s, _mobilityIndicesCV);
+    indices.resize(unsigned(_coordinates.size()));
+    for (size_t i = 0; i < _coordinates.size(); ++i) {
+        const Coordinate& coord = *_coordinates[i];
+        indices[unsigned(i)] = matter.getMobilizedBody(coord.getBodyIndex())
+                           .getFirstUIndex(s) + coord.getMobilizerQIndex();
+    }
+    markCacheVariableValid(s, _mobilityIndicesCV);
+    return indices;
+}
+
+//==============================================================================
+// COMPUTATIONS
+//==============================================================================
+void CoordinateActuatorGroup::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) const
+{
+    const SimTK::Array_<int>& indices = getMobilityIndices(s);
+    const SimTK::VectorView controls = getControls(s);
+    for (unsigned i = 0; i < indices.size(); ++i) {
+        mobilityForces[indices[i]] +=
+            controls[int(i)] * get_optimal_forces(int(i));
+    }
+}
+
+SimTK::Vector CoordinateActuatorGroup::getGeneralizedForces(
+        const SimTK::State& s) const
+{
+    const SimTK::VectorView controls = getControls(s);
+    SimTK::Vector forces(getNumCoordinates());
+    for (int i = 0; i < getNumCoordinates(); ++i)
+        forces[i] = controls[i] * get_optimal_forces(i);
+    return forces;
+}
+
+double CoordinateActuatorGroup::getPower(const SimTK::State& s) const
+{
+    const SimTK::Array_<int>& indices = getMobilityIndices(s);
+    const SimTK::Vector& u = s.getU();
+    const SimTK::VectorView controls = getControls(s);
+    double power = 0;
+    for (unsigned i = 0; i < indices.size(); ++i)
+        power += controls[int(i)] * get_optimal_forces(int(i)) * u[indices[i]];
+    return power;
+}
+
+//==============================================================================
+// REPORTING
+//==============================================================================
+Array<std::string> CoordinateActuatorGroup::getRecordLabels() const
+{
+    Array<std::string> labels("");
+    for (int i = 0; i < getNumCoordinates(); ++i)
+        labels.append(getName() + "_" + get_coordinates(i));
+    return labels;
+}
+
+Array<double> CoordinateActuatorGroup::getRecordValues(
+        const SimTK::State& s) const
+{
+    Array<double> values(0.0);
+    const SimTK::Vector forces = getGeneralizedForces(s);
+    for (int i = 0; i < forces.size(); ++i)
+        values.append(forces[i]);
+    return values;
+}
@@ -0,0 +1,132 @@
+#ifndef OPENSIM_COORDINATE_ACTUATOR_GROUP_H_
+#define OPENSIM_COORDINATE_ACTUATOR_GROUP_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  CoordinateActuatorGroup.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <OpenSim/Simulation/Model/Actuator.h>
+
+namespace OpenSim {
+
+class Coordinate;
+class Model;
+
+//==============================================================================
+//                        COORDINATE ACTUATOR GROUP
+//==============================================================================
+/**
+ * A group of actuators that each apply a generalized force in the direction of
+ * a generalized coordinate, as a CoordinateActuator does; the generalized force
+ * applied to coordinate i is the control i of the group times its optimal
+ * force i. This actuator has one control per coordinate.
+ *
+ * The group replaces a set of CoordinateActuators (e.g., the reserve or
+ * residual actuators of a model) with a single Force: the generalized forces
+ * are added to the mobility forces in one loop, through the mobility (system U)
+ * indices of the coordinates, which are looked up once per State rather than
+ * for every actuator and every evaluation.
+ *
+ * @code{.cpp}
+ * auto* reserves = new CoordinateActuatorGroup();
+ * reserves->addCoordinate("hip_flexion_r", 10.0);
+ * reserves->addCoordinate("knee_angle_r", 10.0);
+ * model.addForce(reserves);
+ * @endcode
+ */
+class OSIMACTUATORS_API CoordinateActuatorGroup : public Actuator {
+OpenSim_DECLARE_CONCRETE_OBJECT(CoordinateActuatorGroup, Actuator);
+public:
+//==============================================================================
+// PROPERTIES
+//==============================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(coordinates, std::string,
+        "Names of the generalized coordinates to which the actuators apply.");
+    OpenSim_DECLARE_LIST_PROPERTY(optimal_forces, double,
+        "The maximum generalized force produced by each actuator, in the "
+        "order of the coordinates.");
+
+//==============================================================================
+// PUBLIC METHODS
+//==============================================================================
+    CoordinateActuatorGroup();
+
+    // Uses default (compiler-generated) destructor, copy constructor, copy
+    // assignment operator.
+
+    /** Append an actuator for the named coordinate. Its control is the last
+    control of the group. */
+    void addCoordinate(const std::string& coordinateName,
+                       double optimalForce = 1.0);
+
+    /** The number of actuators (and of controls) of the group. */
+    int getNumCoordinates() const { return getProperty_coordinates().size(); }
+    const std::string& getCoordinateName(int i) const
+    {   return get_coordinates(i); }
+    double getOptimalForce(int i) const { return get_optimal_forces(i); }
+    void setOptimalForce(int i, double optimalForce)
+    {   set_optimal_forces(i, optimalForce); }
+
+    /** The generalized forces applied by the actuators (control times
+    optimal force), in the order of the coordinates. */
+    SimTK::Vector getGeneralizedForces(const SimTK::State& s) const;
+
+    //--------------------------------------------------------------------------
+    // Actuator interface
+    //--------------------------------------------------------------------------
+    int numControls() const override { return getNumCoordinates(); }
+    /** The sum of the generalized force times the coordinate's speed over
+    all of the actuators. */
+    double getPower(const SimTK::State& s) const override;
+
+    //--------------------------------------------------------------------------
+    // Force interface: reporting
+    //--------------------------------------------------------------------------
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+//==============================================================================
+// PRIVATE
+//==============================================================================
+private:
+    void constructProperties();
+
+    void computeForce(const SimTK::State& state,
+                      SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+                      SimTK::Vector& mobilityForces) const override;
+
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+    // The system U index of each coordinate's mobility, computed once the
+    // Model stage of the State has been realized.
+    const SimTK::Array_<int>& getMobilityIndices(const SimTK::State& s) const;
+
+    std::vector<SimTK::ReferencePtr<const Coordinate>> _coordinates;
+    mutable CacheVariable<SimTK::Array_<int>> _mobilityIndicesCV;
+//==============================================================================
+};  // END of class CoordinateActuatorGroup
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COORDINATE_ACTUATOR_GROUP_H_
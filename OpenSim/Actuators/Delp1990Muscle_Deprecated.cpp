@@ -236,6 +236,7 @@ void Delp1990Muscle_Deprecated::extendAddToSystem(SimTK::MultibodySystem& system
 {
     Super::extendAddToSystem(system);
     addStateVariable("fiber_velocity");
+    _fiberVelocitySV = getStateVariableHandle("fiber_velocity");
 }
 
 void Delp1990Muscle_Deprecated::setActiveForce( const SimTK::State& s, double force ) const {
@@ -348,7 +349,8 @@ bool Delp1990Muscle_Deprecated::setMass(double aMass)
 void Delp1990Muscle_Deprecated::computeStateVariableDerivatives(const SimTK::State &s) const
 {
     Super::computeStateVariableDerivatives(s);
-    setStateVariableDerivativeValue(s, "fiber_velocity", getFiberVelocityDeriv(s));
+    setStateVariableDerivativeValue(s, _fiberVelocitySV,
+                                    getFiberVelocityDeriv(s));
 }
 
 //_____________________________________________________________________________
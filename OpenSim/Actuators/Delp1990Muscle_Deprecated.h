@@ -158,6 +158,8 @@ private:
     double calcTendonForce(const SimTK::State& s, double aNormTendonLength) const;
     double calcFiberForce(double aActivation, double aNormFiberLength, double aNormFiberVelocity) const;
 
+    mutable StateVariableHandle _fiberVelocitySV;
+
 //=============================================================================
 };  // END of class Delp1990Muscle_Deprecated
 //=============================================================================
@@ -70,6 +70,36 @@ FiberCompressiveForceCosPennationCurve::
 }
 
 
+FiberCompressiveForceCosPennationCurve::FiberCompressiveForceCosPennationCurve(
+        const FiberCompressiveForceCosPennationCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+FiberCompressiveForceCosPennationCurve&
+FiberCompressiveForceCosPennationCurve::operator=(
+        const FiberCompressiveForceCosPennationCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void FiberCompressiveForceCosPennationCurve::copyData(
+        const FiberCompressiveForceCosPennationCurve& source)
+{
+    m_curve = source.m_curve;
+    m_stiffnessAtPerpendicularInUse = source.m_stiffnessAtPerpendicularInUse;
+    m_curvinessInUse = source.m_curvinessInUse;
+    m_isFittedCurveBeingUsed = source.m_isFittedCurveBeingUsed;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void FiberCompressiveForceCosPennationCurve::setNull()
 {    
 
@@ -291,3 +321,10 @@ void FiberCompressiveForceCosPennationCurve::
 
     m_curve.printMuscleCurveToCSVFile(path,xmin,xmax);
 }
+
+void FiberCompressiveForceCosPennationCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage.add(MemoryUsage::Curves, m_curve.estimateMemoryUsage());
+}
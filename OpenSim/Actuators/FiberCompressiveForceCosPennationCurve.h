@@ -92,6 +92,14 @@ public:
     and assigns it a default name **/
     FiberCompressiveForceCosPennationCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    FiberCompressiveForceCosPennationCurve(
+            const FiberCompressiveForceCosPennationCurve& source);
+    FiberCompressiveForceCosPennationCurve& operator=(
+            const FiberCompressiveForceCosPennationCurve& source);
+
    
     /**
      Constructs a C2 continuous compressive fiber force cos pennation curve. The
@@ -298,7 +306,7 @@ public:
     \endverbatim
 
     */
-    double calcValue(double cosPennationAngle) const;
+    double calcValue(double cosPennationAngle) const override;
 
 
     /** Implement the generic OpenSim::Function interface **/
@@ -426,6 +434,8 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const FiberCompressiveForceCosPennationCurve& source);
 
     /**
       This function will take all of the current property values, and if they
@@ -442,6 +452,11 @@ private:
 
 
 
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
     SmoothSegmentedFunction m_curve;
     double m_stiffnessAtPerpendicularInUse;
     double m_curvinessInUse;
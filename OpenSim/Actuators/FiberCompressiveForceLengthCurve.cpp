@@ -30,9 +30,6 @@ using namespace std;
 //=============================================================================
 // CONSTRUCTION
 //=============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, 
-// copy assignment.
-
 FiberCompressiveForceLengthCurve::
         FiberCompressiveForceLengthCurve()
 {
@@ -61,6 +58,35 @@ FiberCompressiveForceLengthCurve::FiberCompressiveForceLengthCurve
 }
 
 
+FiberCompressiveForceLengthCurve::FiberCompressiveForceLengthCurve(
+        const FiberCompressiveForceLengthCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+FiberCompressiveForceLengthCurve& FiberCompressiveForceLengthCurve::operator=(
+        const FiberCompressiveForceLengthCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void FiberCompressiveForceLengthCurve::copyData(
+        const FiberCompressiveForceLengthCurve& source)
+{
+    m_curve = source.m_curve;
+    m_stiffnessAtZeroLengthInUse = source.m_stiffnessAtZeroLengthInUse;
+    m_curvinessInUse = source.m_curvinessInUse;
+    m_isFittedCurveBeingUsed = source.m_isFittedCurveBeingUsed;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void FiberCompressiveForceLengthCurve::setNull()
 {
 
@@ -278,3 +304,10 @@ void FiberCompressiveForceLengthCurve::
 
     m_curve.printMuscleCurveToCSVFile(path,xmin,xmax);
 }
+
+void FiberCompressiveForceLengthCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage.add(MemoryUsage::Curves, m_curve.estimateMemoryUsage());
+}
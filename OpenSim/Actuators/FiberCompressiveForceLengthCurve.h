@@ -78,8 +78,13 @@ public:
     yet define a curve. **/
     FiberCompressiveForceLengthCurve();
 
-    // Uses default (compiler-generated) destructor, copy constructor, copy 
-    // assignment operator.
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    FiberCompressiveForceLengthCurve(
+            const FiberCompressiveForceLengthCurve& source);
+    FiberCompressiveForceLengthCurve& operator=(
+            const FiberCompressiveForceLengthCurve& source);
 
     /**
      Constructs a C2 continuous compressive fiber force length curve. This curve
@@ -233,7 +238,7 @@ public:
     \endverbatim
 
     */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
  
     /** Implement the generic OpenSim::Function interface **/
@@ -369,6 +374,8 @@ private:
     
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const FiberCompressiveForceLengthCurve& source);
 
     /**
         This function will take all of the current parameter values and use 
@@ -383,6 +390,11 @@ private:
     void buildCurve( bool computeIntegral = false );
     
 
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
     SmoothSegmentedFunction   m_curve;
     double m_stiffnessAtZeroLengthInUse;
     double m_curvinessInUse;
@@ -36,8 +36,6 @@ static int RefFiber_normPE_Idx = 4;
 //==============================================================================
 // CONSTRUCTION
 //==============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, and copy
-// assignment.
 FiberForceLengthCurve::FiberForceLengthCurve()
 {
     setNull();
@@ -65,6 +63,35 @@ FiberForceLengthCurve::FiberForceLengthCurve(double strainAtZeroForce,
     ensureCurveUpToDate();
 }
 
+FiberForceLengthCurve::FiberForceLengthCurve(
+        const FiberForceLengthCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+FiberForceLengthCurve& FiberForceLengthCurve::operator=(
+        const FiberForceLengthCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void FiberForceLengthCurve::copyData(const FiberForceLengthCurve& source)
+{
+    m_curve = source.m_curve;
+    m_stiffnessAtLowForceInUse = source.m_stiffnessAtLowForceInUse;
+    m_stiffnessAtOneNormForceInUse = source.m_stiffnessAtOneNormForceInUse;
+    m_curvinessInUse = source.m_curvinessInUse;
+    m_fittedCurveBeingUsed = source.m_fittedCurveBeingUsed;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void FiberForceLengthCurve::setNull()
 {
     setAuthors("Matthew Millard");
@@ -81,7 +108,24 @@ void FiberForceLengthCurve::constructProperties()
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
 {
-    SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+            getConcreteClassName(),
+            {get_strain_at_zero_force(),
+             get_strain_at_one_norm_force(),
+             m_stiffnessAtLowForceInUse,
+             m_stiffnessAtOneNormForceInUse,
+             m_curvinessInUse,
+             double(computeIntegral)},
+            [&] { return createCurve(computeIntegral,
+                                     getConcreteClassName()); });
+
+    setObjectIsUpToDateWithProperties();
+}
+
+SmoothSegmentedFunction* FiberForceLengthCurve::createCurve(
+        bool computeIntegral, const std::string& name) const
+{
+    return SmoothSegmentedFunctionFactory::
         createFiberForceLengthCurve(
             get_strain_at_zero_force(),
             get_strain_at_one_norm_force(),
@@ -89,12 +133,7 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
             m_stiffnessAtOneNormForceInUse,
             m_curvinessInUse,
             computeIntegral,
-            getName());
-
-    m_curve = *f;
-    delete f;
-
-    setObjectIsUpToDateWithProperties();
+            name);
 }
 
 void FiberForceLengthCurve::ensureCurveUpToDate()
@@ -165,14 +204,7 @@ void FiberForceLengthCurve::ensureCurveUpToDate()
 SimTK::Function* FiberForceLengthCurve::createSimTKFunction() const
 {
     // Back the OpenSim::Function with this SimTK::Function.
-    return SmoothSegmentedFunctionFactory::createFiberForceLengthCurve(
-                get_strain_at_zero_force(),
-                get_strain_at_one_norm_force(),
-                m_stiffnessAtLowForceInUse,
-                m_stiffnessAtOneNormForceInUse,
-                m_curvinessInUse,
-                false,
-                getName());
+    return createCurve(false, getName());
 }
 
 //==============================================================================
@@ -216,7 +248,7 @@ double FiberForceLengthCurve::calcValue(double normFiberLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberLength);
+    return m_curve->calcValue(normFiberLength);
 }
 
 double FiberForceLengthCurve::calcDerivative(double normFiberLength,
@@ -228,14 +260,14 @@ double FiberForceLengthCurve::calcDerivative(double normFiberLength,
         "FiberForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberLength,order);
+    return m_curve->calcDerivative(normFiberLength,order);
 }
 
 double FiberForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
 {
-    return m_curve.calcDerivative(derivComponents, x);
+    return m_curve->calcDerivative(derivComponents, x);
 }
 
 double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
@@ -243,20 +275,20 @@ double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
 
-    if(!m_curve.isIntegralAvailable()) {
+    if(!m_curve->isIntegralAvailable()) {
         FiberForceLengthCurve* mutableThis =
             const_cast<FiberForceLengthCurve*>(this);
         mutableThis->buildCurve(true);
     }
 
-    return m_curve.calcIntegral(normFiberLength);
+    return m_curve->calcIntegral(normFiberLength);
 }
 
 SimTK::Vec2 FiberForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void FiberForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -267,7 +299,10 @@ void FiberForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     xmin = xmin*0.9;
     double xmax = 1.0 + get_strain_at_one_norm_force()*1.1;
 
-    m_curve.printMuscleCurveToCSVFile(path, xmin, xmax);
+    // Print a curve named after this curve, rather than the shared one.
+    std::unique_ptr<SmoothSegmentedFunction> curve{
+        createCurve(true, getName())};
+    curve->printMuscleCurveToCSVFile(path, xmin, xmax);
 }
 
 //==============================================================================
@@ -448,3 +483,14 @@ SimTK::Vec5 FiberForceLengthCurve::calcReferencePassiveFiber(
 
     return properties;
 }
+
+void FiberForceLengthCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    // Copies of this curve share its SmoothSegmentedFunction.
+    if (m_curve) {
+        usage.addShared(MemoryUsage::Curves, m_curve.get(),
+                        m_curve->estimateMemoryUsage());
+    }
+}
@@ -28,6 +28,8 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/SmoothSegmentedFunction.h>
 
+#include <memory>
+
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
         #undef OSIMACTUATORS_API
@@ -180,6 +182,12 @@ public:
     default property values and assigns a default name. */
     FiberForceLengthCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    FiberForceLengthCurve(const FiberForceLengthCurve& source);
+    FiberForceLengthCurve& operator=(const FiberForceLengthCurve& source);
+
     /** Constructs a fiber-force-length curve using the provided parameters and
     assigns a default name. See class documentation for the meaning of these
     parameters, each of which corresponds to a property. */
@@ -277,7 +285,7 @@ public:
 
     /** Evaluates the fiber-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
     /** Calculates the derivative of the fiber-force-length multiplier with
     respect to the normalized fiber length.
@@ -359,11 +367,18 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const FiberForceLengthCurve& source);
 
     // This function will take all of the current property values. If they have
     // changed since the last time the curve was built, the curve is rebuilt.
     // Curve construction costs ~20,500 flops.
+
     void buildCurve(bool computeIntegral=false);
+    // Create the curve from the current property values, with the given
+    // name.
+    SmoothSegmentedFunction* createCurve(bool computeIntegral,
+                                         const std::string& name) const;
 
     // Calculates the properties of the passive force-length curve documented in
     // Thelen (2003). Specifically:
@@ -384,7 +399,15 @@ private:
     double calcCurvinessOfBestFit(double e0, double e1, double k0, double k1,
                                   double area, double relTol);
 
-    SmoothSegmentedFunction m_curve;
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
+    // The curve is shared with all other curves of this type that have the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve()),
+    // including those of copies of this curve.
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
     double m_stiffnessAtLowForceInUse;
     double m_stiffnessAtOneNormForceInUse;
     double m_curvinessInUse;
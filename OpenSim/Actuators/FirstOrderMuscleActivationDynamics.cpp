@@ -80,6 +80,7 @@ extendAddToSystem(SimTK::MultibodySystem& system) const
 {
     Super::extendAddToSystem(system);
     addStateVariable(STATE_NAME_ACTIVATION, SimTK::Stage::Dynamics);
+    _activationSV = getStateVariableHandle(STATE_NAME_ACTIVATION);
 }
 
 void FirstOrderMuscleActivationDynamics::
@@ -102,7 +103,7 @@ computeStateVariableDerivatives(const SimTK::State& s) const
      double adot = 
          calcActivationDerivative(getExcitation(s), getActivation(s));
 
-     setStateVariableDerivativeValue(s, STATE_NAME_ACTIVATION, adot);
+     setStateVariableDerivativeValue(s, _activationSV, adot);
 }
 
 //==============================================================================
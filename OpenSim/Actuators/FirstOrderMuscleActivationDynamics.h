@@ -171,6 +171,8 @@ private:
 
     static const std::string STATE_NAME_ACTIVATION;
 
+    mutable StateVariableHandle _activationSV;
+
 }; // end of class FirstOrderMuscleActivationDynamics
 }  // end of namespace OpenSim
 
@@ -30,8 +30,6 @@ using namespace std;
 //==============================================================================
 // CONSTRUCTION
 //==============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, copy
-// assignment operator.
 ForceVelocityCurve::ForceVelocityCurve()
 {
     setNull();
@@ -67,6 +65,31 @@ ForceVelocityCurve::ForceVelocityCurve(double concentricSlopeAtVmax,
     ensureCurveUpToDate();
 }
 
+ForceVelocityCurve::ForceVelocityCurve(
+        const ForceVelocityCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+ForceVelocityCurve& ForceVelocityCurve::operator=(
+        const ForceVelocityCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void ForceVelocityCurve::copyData(const ForceVelocityCurve& source)
+{
+    m_curve = source.m_curve;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void ForceVelocityCurve::setNull()
 {
     setAuthors("Matthew Millard");
@@ -86,9 +109,17 @@ void ForceVelocityCurve::constructProperties()
 
 void ForceVelocityCurve::buildCurve()
 {
-    SimTK::Function* f = createSimTKFunction();
-    m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
-    delete f;
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+            getConcreteClassName(),
+            {get_max_eccentric_velocity_force_multiplier(),
+             get_concentric_slope_at_vmax(),
+             get_concentric_slope_near_vmax(),
+             get_isometric_slope(),
+             get_eccentric_slope_at_vmax(),
+             get_eccentric_slope_near_vmax(),
+             get_concentric_curviness(),
+             get_eccentric_curviness()},
+            [this] { return createCurve(getConcreteClassName()); });
     setObjectIsUpToDateWithProperties();
 }
 
@@ -102,9 +133,9 @@ void ForceVelocityCurve::ensureCurveUpToDate()
 //==============================================================================
 // OpenSim::Function Interface
 //==============================================================================
-SimTK::Function* ForceVelocityCurve::createSimTKFunction() const
+SmoothSegmentedFunction* ForceVelocityCurve::createCurve(
+        const std::string& name) const
 {
-    // Back the OpenSim::Function with this SimTK::Function.
     return SmoothSegmentedFunctionFactory::createFiberForceVelocityCurve(
                 get_max_eccentric_velocity_force_multiplier(),
                 get_concentric_slope_at_vmax(),
@@ -115,7 +146,13 @@ SimTK::Function* ForceVelocityCurve::createSimTKFunction() const
                 get_concentric_curviness(),
                 get_eccentric_curviness(),
                 false,
-                getName());
+                name);
+}
+
+SimTK::Function* ForceVelocityCurve::createSimTKFunction() const
+{
+    // Back the OpenSim::Function with this SimTK::Function.
+    return createCurve(getName());
 }
 
 //==============================================================================
@@ -173,7 +210,7 @@ double ForceVelocityCurve::calcValue(double normFiberVelocity) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ForceVelocityCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberVelocity);
+    return m_curve->calcValue(normFiberVelocity);
 }
 
 double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
@@ -185,25 +222,39 @@ double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
         "ForceVelocityCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberVelocity,order);
+    return m_curve->calcDerivative(normFiberVelocity,order);
 }
 
 double ForceVelocityCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
 {
-    return m_curve.calcDerivative(derivComponents, x);
+    return m_curve->calcDerivative(derivComponents, x);
 }
 
 SimTK::Vec2 ForceVelocityCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ForceVelocityCurve: Curve is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void ForceVelocityCurve::printMuscleCurveToCSVFile(const std::string& path)
 {
     ensureCurveUpToDate();
-    m_curve.printMuscleCurveToCSVFile(path, -1.25, 1.25);
+    // Print a curve named after this curve, rather than the shared one.
+    std::unique_ptr<SmoothSegmentedFunction> curve{
+        createCurve(getName())};
+    curve->printMuscleCurveToCSVFile(path, -1.25, 1.25);
+}
+
+void ForceVelocityCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    // Copies of this curve share its SmoothSegmentedFunction.
+    if (m_curve) {
+        usage.addShared(MemoryUsage::Curves, m_curve.get(),
+                        m_curve->estimateMemoryUsage());
+    }
 }
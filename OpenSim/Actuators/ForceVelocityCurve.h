@@ -28,6 +28,8 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/SmoothSegmentedFunction.h>
 
+#include <memory>
+
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
         #undef OSIMACTUATORS_API
@@ -166,6 +168,12 @@ public:
     property values and assigns a default name. */
     ForceVelocityCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    ForceVelocityCurve(const ForceVelocityCurve& source);
+    ForceVelocityCurve& operator=(const ForceVelocityCurve& source);
+
     /** Constructs a force-velocity curve using the provided parameters and
     assigns a default name. */
     ForceVelocityCurve(double concentricSlopeAtVmax,
@@ -303,7 +311,7 @@ public:
 
     /** Evaluates the force-velocity curve at a normalized fiber velocity of
     'normFiberVelocity'. */
-    double calcValue(double normFiberVelocity) const;
+    double calcValue(double normFiberVelocity) const override;
 
     /** Calculates the derivative of the force-velocity multiplier with respect
     to the normalized fiber velocity.
@@ -374,12 +382,26 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const ForceVelocityCurve& source);
 
     // This function will take all of the current property values and build a
     // curve.
+
     void buildCurve();
+    // Create the curve from the current property values, with the given
+    // name.
+    SmoothSegmentedFunction* createCurve(const std::string& name) const;
 
-    SmoothSegmentedFunction m_curve;
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
+    // The curve is shared with all other curves of this type that have the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve()),
+    // including those of copies of this curve.
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
 };
 
 }
@@ -30,9 +30,6 @@ using namespace std;
 //==============================================================================
 // CONSTRUCTION
 //==============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, copy
-// assignment operator.
-
 ForceVelocityInverseCurve::ForceVelocityInverseCurve()
 {
     setNull();
@@ -68,6 +65,32 @@ ForceVelocityInverseCurve::ForceVelocityInverseCurve(
     ensureCurveUpToDate();
 }
 
+ForceVelocityInverseCurve::ForceVelocityInverseCurve(
+        const ForceVelocityInverseCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+ForceVelocityInverseCurve& ForceVelocityInverseCurve::operator=(
+        const ForceVelocityInverseCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void ForceVelocityInverseCurve::copyData(
+        const ForceVelocityInverseCurve& source)
+{
+    m_curve = source.m_curve;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void ForceVelocityInverseCurve::setNull()
 {
     setAuthors("Matthew Millard");
@@ -218,3 +241,10 @@ printMuscleCurveToCSVFile(const std::string& path)
 
     m_curve.printMuscleCurveToCSVFile(path, xmin, xmax);
 }
+
+void ForceVelocityInverseCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage.add(MemoryUsage::Curves, m_curve.estimateMemoryUsage());
+}
@@ -134,6 +134,14 @@ public:
     the default property values and assigns a default name. */
     ForceVelocityInverseCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    ForceVelocityInverseCurve(
+            const ForceVelocityInverseCurve& source);
+    ForceVelocityInverseCurve& operator=(
+            const ForceVelocityInverseCurve& source);
+
     /** Constructs an inverse force-velocity curve using the provided parameters
     and assigns a default name. */
     ForceVelocityInverseCurve(double concentricSlopeAtVmax,
@@ -271,7 +279,7 @@ public:
 
     /** Evaluates the inverse force-velocity curve at a force-velocity
     multiplier value of 'aForceVelocityMultiplier'. */
-    double calcValue(double aForceVelocityMultiplier) const;
+    double calcValue(double aForceVelocityMultiplier) const override;
 
     /** Calculates the derivative of the inverse force-velocity curve with
     respect to the force-velocity multiplier.
@@ -341,11 +349,19 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const ForceVelocityInverseCurve& source);
 
     // This function will take all of the current property values and build a
     // curve.
+
     void buildCurve();
 
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
     SmoothSegmentedFunction   m_curve;
 
 };
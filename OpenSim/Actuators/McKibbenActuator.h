@@ -89,6 +89,12 @@ public:
 
     /** Compute actuation for current state. **/
     double computeActuation(const SimTK::State& s) const override;
+    /** The force is computed from the pressure even when the actuation is
+    overridden, so it does not scale with the actuation. **/
+    bool addInForcesPerUnitActuation(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override
+    {   return false; }
 protected:
     /** how to display the McKibben
     VisibleObject _displayer; */
@@ -258,6 +258,10 @@ Millard2012AccelerationMuscle(const std::string &aName,  double aMaxIsometricFor
     addStateVariable(STATE_ACTIVATION_NAME);
     addStateVariable(STATE_FIBER_LENGTH_NAME);
     addStateVariable(STATE_FIBER_VELOCITY_NAME);
+
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
+    _fiberVelocitySV = getStateVariableHandle(STATE_FIBER_VELOCITY_NAME);
  }
 
 void Millard2012AccelerationMuscle::extendInitStateFromProperties(SimTK::State& s) const
@@ -290,9 +294,9 @@ void Millard2012AccelerationMuscle::
         vdot = getFiberAcceleration(s);
     }
 
-    setStateVariableDerivativeValue(s, STATE_ACTIVATION_NAME, adot);
-    setStateVariableDerivativeValue(s, STATE_FIBER_LENGTH_NAME, ldot);
-    setStateVariableDerivativeValue(s, STATE_FIBER_VELOCITY_NAME, vdot);
+    setStateVariableDerivativeValue(s, _activationSV, adot);
+    setStateVariableDerivativeValue(s, _fiberLengthSV, ldot);
+    setStateVariableDerivativeValue(s, _fiberVelocitySV, vdot);
 }
 
 //=============================================================================
@@ -364,7 +368,7 @@ void Millard2012AccelerationMuscle::
     setActivation(SimTK::State& s, double activation) const
 {
     setStateVariableValue(s, STATE_ACTIVATION_NAME, activation);    
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
     
 }
 
@@ -372,9 +376,9 @@ void Millard2012AccelerationMuscle::
     setFiberLength(SimTK::State& s, double fiberLength) const
 {
     setStateVariableValue(s, STATE_FIBER_LENGTH_NAME, fiberLength);
-    markCacheVariableInvalid(s,"lengthInfo");
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _lengthInfoCV);
+    markCacheVariableInvalid(s, _velInfoCV);
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
     
 }
 
@@ -382,8 +386,8 @@ void Millard2012AccelerationMuscle::
     setFiberVelocity(SimTK::State& s, double fiberVelocity) const
 {
     setStateVariableValue(s, STATE_FIBER_VELOCITY_NAME, fiberVelocity);
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _velInfoCV);
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
     
 }
 
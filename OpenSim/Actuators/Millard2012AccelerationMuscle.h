@@ -764,6 +764,10 @@ private:
     static const std::string STATE_FIBER_LENGTH_NAME;
     //The name used to access the fiber velocity state
     static const std::string STATE_FIBER_VELOCITY_NAME;
+    //Handles to the states, to set their derivatives
+    mutable StateVariableHandle _activationSV;
+    mutable StateVariableHandle _fiberLengthSV;
+    mutable StateVariableHandle _fiberVelocitySV;
 
     //A struct that holds all of the necessary quantities to compute
     //the fiber and tendon force, acceleration, and stiffness
@@ -91,6 +91,8 @@ void Millard2012EquilibriumMuscle::extendFinalizeFromProperties()
     // we remain sufficiently far from the numerical singularity at beta=0.
     use_fiber_damping = (getFiberDamping() >= MIN_NONZERO_DAMPING_COEFFICIENT);
 
+    m_isTendonRigid = get_ignore_tendon_compliance();
+
     // To initialize, we need to construct an *inverse* force-velocity curve
     // from the parameters of the force-velocity curve.
     double conSlopeAtVmax   = fvCurve.getConcentricSlopeAtVmax();
@@ -272,8 +274,7 @@ getActivationDerivative(const SimTK::State& s) const
     if (get_ignore_activation_dynamics())
         return 0.0;
 
-    return getActivationModel().calcDerivative(getActivation(s),
-                                               getExcitation(s));
+    return getActivationModel().getActivationDerivative(s);
 }
 
 double Millard2012EquilibriumMuscle::
@@ -334,8 +335,8 @@ setActivation(SimTK::State& s, double activation) const
         setStateVariableValue(s, STATE_ACTIVATION_NAME,
                               getActivationModel().clampActivation(activation));
     }
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _velInfoCV);
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
 }
 
 void Millard2012EquilibriumMuscle::setDefaultFiberLength(double fiberLength)
@@ -375,9 +376,9 @@ setFiberLength(SimTK::State& s, double fiberLength) const
     if (!get_ignore_tendon_compliance()) {
         setStateVariableValue(s, STATE_FIBER_LENGTH_NAME,
                               clampFiberLength(fiberLength));
-        markCacheVariableInvalid(s,"lengthInfo");
-        markCacheVariableInvalid(s,"velInfo");
-        markCacheVariableInvalid(s,"dynamicsInfo");
+        markCacheVariableInvalid(s, _lengthInfoCV);
+        markCacheVariableInvalid(s, _velInfoCV);
+        markCacheVariableInvalid(s, _dynamicsInfoCV);
     }
 }
 
@@ -395,9 +396,16 @@ computeActuation(const SimTK::State& s) const
 
 void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
+{
+    solveFiberEquilibrium(s, solveForVelocity, false);
+}
+
+int Millard2012EquilibriumMuscle::
+solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                      bool warmStart) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
-        return;
+        return 0;
     }
 
     // Elastic tendon initialization routine.
@@ -415,12 +423,14 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     double pathLength = getLength(s);
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
+    double fiberLengthGuess = warmStart
+        ? getStateVariableValue(s, STATE_FIBER_LENGTH_NAME) : SimTK::NaN;
 
     try {
         std::pair<StatusFromEstimateMuscleFiberState,
                   ValuesFromEstimateMuscleFiberState> result =
             estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                tol, maxIter, solveForVelocity, fiberLengthGuess);
 
         switch(result.first) {
 
@@ -448,6 +458,7 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
             OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
             break;
         }
+        return int(result.second["iterations"]);
 
     } catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate,
@@ -487,19 +498,18 @@ void Millard2012EquilibriumMuscle::calcMuscleLengthInfo(const SimTK::State& s,
     double tendonSlackLen = getTendonSlackLength();
 
     try {
+        if(m_isTendonRigid) {                               // rigid tendon
+            calcRigidTendonMuscleLengthInfo(s, mli);
+            return;
+        }
+
         // Get muscle-specific properties.
         const ActiveForceLengthCurve& falCurve = get_ActiveForceLengthCurve();
         const FiberForceLengthCurve&  fpeCurve = get_FiberForceLengthCurve();
         //const TendonForceLengthCurve& fseCurve = get_TendonForceLengthCurve();
 
-        if(get_ignore_tendon_compliance()) {                //rigid tendon
-            mli.fiberLength = clampFiberLength(
-                               getPennationModel().calcFiberLength(getLength(s),
-                               tendonSlackLen));
-        } else {                                            // elastic tendon
-            mli.fiberLength = clampFiberLength(
-                                getStateVariableValue(s, STATE_FIBER_LENGTH_NAME));
-        }
+        mli.fiberLength = clampFiberLength(
+                            getStateVariableValue(s, STATE_FIBER_LENGTH_NAME));
 
         mli.normFiberLength   = mli.fiberLength / optFiberLength;
         mli.pennationAngle    = getPennationModel().
@@ -508,7 +518,6 @@ void Millard2012EquilibriumMuscle::calcMuscleLengthInfo(const SimTK::State& s,
         mli.sinPennationAngle = sin(mli.pennationAngle);
         mli.fiberLengthAlongTendon = mli.fiberLength * mli.cosPennationAngle;
 
-        // Necessary even for the rigid tendon, as it might have gone slack.
         mli.tendonLength      = getPennationModel().
                                     calcTendonLength(mli.cosPennationAngle,
                                                      mli.fiberLength,
@@ -592,6 +601,11 @@ void Millard2012EquilibriumMuscle::
 calcFiberVelocityInfo(const SimTK::State& s, FiberVelocityInfo& fvi) const
 {
     try {
+        if(m_isTendonRigid) {                               // rigid tendon
+            calcRigidTendonFiberVelocityInfo(s, fvi);
+            return;
+        }
+
         // Get the quantities that we've already computed.
         const MuscleLengthInfo &mli = getMuscleLengthInfo(s);
 
@@ -608,24 +622,7 @@ calcFiberVelocityInfo(const SimTK::State& s, FiberVelocityInfo& fvi) const
         double fv    = SimTK::NaN;
 
         // Calculate fiber velocity.
-        if(get_ignore_tendon_compliance()) {
-
-            // Rigid tendon.
-
-            if(mli.tendonLength < getTendonSlackLength()
-                                  - SimTK::SignificantReal) {
-                // The tendon is buckling, so fiber velocity is zero.
-                dlce  = 0.0;
-                dlceN = 0.0;
-                fv    = 1.0;
-            } else {
-                dlce = getPennationModel().
-                         calcFiberVelocity(mli.cosPennationAngle, dlenMcl, 0.0);
-                dlceN = dlce/(optFibLen*getMaxContractionVelocity());
-                fv = get_ForceVelocityCurve().calcValue(dlceN);
-            }
-
-        } else if(!get_ignore_tendon_compliance() && !use_fiber_damping) {
+        if(!use_fiber_damping) {
 
             // Elastic tendon, no damping.
 
@@ -714,13 +711,10 @@ calcFiberVelocityInfo(const SimTK::State& s, FiberVelocityInfo& fvi) const
         double dlceAT = getPennationModel().calcFiberVelocityAlongTendon(
             mli.fiberLength, dlce, mli.sinPennationAngle, mli.cosPennationAngle,
             dphidt);
-        double dmcldt = getLengtheningSpeed(s);
-        double dtl = 0;
-
-        if(!get_ignore_tendon_compliance()) {
-            dtl = getPennationModel().calcTendonVelocity(mli.cosPennationAngle,
-                mli.sinPennationAngle, dphidt, mli.fiberLength, dlce, dmcldt);
-        }
+        double dmcldt = dlenMcl;
+        double dtl = getPennationModel().calcTendonVelocity(
+            mli.cosPennationAngle, mli.sinPennationAngle, dphidt,
+            mli.fiberLength, dlce, dmcldt);
 
         // Check to see whether the fiber state is clamped.
         double fiberStateClamped = 0.0;
@@ -764,6 +758,11 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
         // Get the quantities that we've already computed.
         const MuscleLengthInfo &mli = getMuscleLengthInfo(s);
         const FiberVelocityInfo &mvi = getFiberVelocityInfo(s);
+
+        if(m_isTendonRigid) {                               // rigid tendon
+            calcRigidTendonMuscleDynamicsInfo(s, mli, mvi, mdi);
+            return;
+        }
         double fiberStateClamped = mvi.userDefinedVelocityExtras[0];
 
         // Get the properties of this muscle.
@@ -815,19 +814,6 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
             p2Fm = fiberForceV[3];
             pFm  = p1Fm + p2Fm;
 
-            // Every configuration except the rigid tendon chooses a fiber
-            // velocity that ensures that the fiber does not generate a
-            // compressive force. Here, we must enforce that the fiber generates
-            // only tensile forces by saturating the damping force generated by
-            // the parallel element.
-            if(get_ignore_tendon_compliance()) {
-                if(fm < 0) {
-                    fm   = 0.0;
-                    p2Fm = -aFm - p1Fm;
-                    pFm  = p1Fm + p2Fm;
-                }
-            }
-
             fmAT = fm * mli.cosPennationAngle;
             dFm_dlce = calcFiberStiffness(fiso, a,
                                           mvi.fiberForceVelocityMultiplier,
@@ -840,27 +826,17 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
                 mli.sinPennationAngle, mli.cosPennationAngle, mli.fiberLength);
 
             // Compute the stiffness of the tendon.
-            if(!get_ignore_tendon_compliance()) {
-                dFt_dtl = fseCurve.calcDerivative(mli.normTendonLength,1)
-                          *(fiso/tendonSlackLen);
-
-                // Compute the stiffness of the whole musculotendon actuator.
-                if (abs(dFmAT_dlceAT*dFt_dtl) > 0.0
-                    && abs(dFmAT_dlceAT+dFt_dtl) > SimTK::SignificantReal) {
-                    Ke = (dFmAT_dlceAT*dFt_dtl)/(dFmAT_dlceAT+dFt_dtl);
-                }
-            } else {
-                dFt_dtl = SimTK::Infinity;
-                Ke = dFmAT_dlceAT;
+            dFt_dtl = fseCurve.calcDerivative(mli.normTendonLength,1)
+                      *(fiso/tendonSlackLen);
+
+            // Compute the stiffness of the whole musculotendon actuator.
+            if (abs(dFmAT_dlceAT*dFt_dtl) > 0.0
+                && abs(dFmAT_dlceAT+dFt_dtl) > SimTK::SignificantReal) {
+                Ke = (dFmAT_dlceAT*dFt_dtl)/(dFmAT_dlceAT+dFt_dtl);
             }
         }
 
-        double fse = 0.0;
-        if(!get_ignore_tendon_compliance()) {
-            fse = fseCurve.calcValue(mli.normTendonLength);
-        } else {
-            fse = fmAT/fiso;
-        }
+        double fse = fseCurve.calcValue(mli.normTendonLength);
 
         mdi.activation                = a;
         mdi.fiberForce                = fm;
@@ -926,9 +902,11 @@ extendAddToSystem(SimTK::MultibodySystem& system) const
 
     if(!get_ignore_activation_dynamics()) {
         addStateVariable(STATE_ACTIVATION_NAME);
+        _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
     }
     if(!get_ignore_tendon_compliance()) {
         addStateVariable(STATE_FIBER_LENGTH_NAME);
+        _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
     }
 }
 
@@ -968,7 +946,7 @@ void Millard2012EquilibriumMuscle::
         if (appliesForce(s) && !isActuationOverridden(s)) {
             adot =getActivationDerivative(s);
         }
-        setStateVariableDerivativeValue(s, STATE_ACTIVATION_NAME, adot);
+        setStateVariableDerivativeValue(s, _activationSV, adot);
     }
 
     // Fiber length is the next state (if it is a state at all)
@@ -978,10 +956,158 @@ void Millard2012EquilibriumMuscle::
         if (appliesForce(s) && !isActuationOverridden(s)) {
             ldot = getFiberVelocity(s);
         }
-        setStateVariableDerivativeValue(s, STATE_FIBER_LENGTH_NAME, ldot);
+        setStateVariableDerivativeValue(s, _fiberLengthSV, ldot);
     }
 }
 
+void Millard2012EquilibriumMuscle::
+computeStateDerivativeJacobian(const SimTK::State& s, SimTK::Matrix& dYdotdY,
+                               SimTK::Matrix& dYdotdU) const
+{
+    const Array<std::string> names = getStateVariableNames();
+    const int ia = names.findIndex(STATE_ACTIVATION_NAME);
+    const int il = names.findIndex(STATE_FIBER_LENGTH_NAME);
+
+    // The activation (clamped as by the activation model) used by the
+    // activation dynamics, if any, or in place of activation otherwise.
+    const MuscleFirstOrderActivationDynamicModel& actMdl =
+        getActivationModel();
+    const double aRaw = ia >= 0 ?
+        getStateVariableValue(s, STATE_ACTIVATION_NAME) : getControl(s);
+    const double a = actMdl.clampActivation(aRaw);
+    const double da_daRaw =
+        (aRaw > actMdl.get_minimum_activation() && aRaw < 1.0) ? 1.0 : 0.0;
+
+    if(ia >= 0) {
+        // adot = (u - a)/tau(a), as in
+        // MuscleFirstOrderActivationDynamicModel::calcDerivative().
+        const double u = getExcitation(s);
+        double tau, dtau_da;
+        if(u > a) {
+            tau = actMdl.get_activation_time_constant()*(0.5 + 1.5*a);
+            dtau_da = 1.5*actMdl.get_activation_time_constant();
+        } else {
+            tau = actMdl.get_deactivation_time_constant()/(0.5 + 1.5*a);
+            dtau_da = -1.5*tau/(0.5 + 1.5*a);
+        }
+        dYdotdY(ia, ia) = -(1.0 + (u - a)*dtau_da/tau)/tau * da_daRaw;
+        dYdotdU(ia, 0) = 1.0/tau;
+    }
+
+    if(il < 0) {
+        return;                                             // rigid tendon
+    }
+
+    const MuscleLengthInfo& mli = getMuscleLengthInfo(s);
+    const FiberVelocityInfo& fvi = getFiberVelocityInfo(s);
+    if(fvi.userDefinedVelocityExtras[0] > 0.5) {
+        return;         // the fiber is clamped, and its velocity set to zero
+    }
+
+    const double ofl    = getOptimalFiberLength();
+    const double tsl    = getTendonSlackLength();
+    const double lce    = mli.fiberLength;
+    const double cosphi = mli.cosPennationAngle;
+    const double sinphi = mli.sinPennationAngle;
+    const double fal    = mli.fiberActiveForceLengthMultiplier;
+    const double fpe    = mli.fiberPassiveForceLengthMultiplier;
+    const double fse    = get_TendonForceLengthCurve().
+                            calcValue(mli.normTendonLength);
+
+    // Partial derivatives of the length-dependent quantities with respect to
+    // fiber length (which has no effect while it is clamped to its minimum).
+    const double dlce_dlceState = getStateVariableValue(s,
+        STATE_FIBER_LENGTH_NAME) > getMinimumFiberLength() ? 1.0 : 0.0;
+    const double dfal_dlce = get_ActiveForceLengthCurve().
+                               calcDerivative(mli.normFiberLength, 1)/ofl;
+    const double dfpe_dlce = get_FiberForceLengthCurve().
+                               calcDerivative(mli.normFiberLength, 1)/ofl;
+    const double dfse_dlce = calc_DTendonForce_DFiberLength(
+        get_TendonForceLengthCurve().calcDerivative(mli.normTendonLength, 1)
+            /tsl, lce, sinphi, cosphi);
+    const double dcosphi_dlce = -sinphi*getPennationModel().
+                                  calc_DPennationAngle_DfiberLength(lce);
+
+    // Partial derivatives of the normalized fiber velocity.
+    double ddlceN_da   = 0;
+    double ddlceN_dlce = 0;
+    if(!use_fiber_damping) {
+        // dlceN = fvInv(fv), with fv = (fse/cosphi - fpe)/(a*fal).
+        const double fv = calcFv(a, fal, fpe, fse, cosphi);
+        const double dfvInv_dfv = fvInvCurve.calcDerivative(fv, 1);
+        const double dfv_da = -fv/a;
+        const double dfv_dlce =
+            ((dfse_dlce - fse*dcosphi_dlce/cosphi)/cosphi - dfpe_dlce)
+                /(a*fal) - fv*dfal_dlce/fal;
+        ddlceN_da   = dfvInv_dfv*dfv_da;
+        ddlceN_dlce = dfvInv_dfv*dfv_dlce;
+    } else {
+        // dlceN is the root of the equilibrium equation (per unit maximum
+        // isometric force)
+        //   R = (a*fal*fv(dlceN) + fpe + beta*dlceN)*cosphi - fse = 0,
+        // so its partial derivatives are those of R divided by -dR/ddlceN.
+        const double beta  = getFiberDamping();
+        const double dlceN = fvi.normFiberVelocity;
+        const double fv    = fvi.fiberForceVelocityMultiplier;
+        const double dfv_ddlceN = get_ForceVelocityCurve().
+                                    calcDerivative(dlceN, 1);
+        const double dR_ddlceN = (a*fal*dfv_ddlceN + beta)*cosphi;
+        const double dR_da     = fal*fv*cosphi;
+        const double dR_dlce   = (a*fv*dfal_dlce + dfpe_dlce)*cosphi
+                                 + (a*fal*fv + fpe + beta*dlceN)*dcosphi_dlce
+                                 - dfse_dlce;
+        ddlceN_da   = -dR_da/dR_ddlceN;
+        ddlceN_dlce = -dR_dlce/dR_ddlceN;
+    }
+
+    const double vmax = getMaxContractionVelocity()*ofl;
+    dYdotdY(il, il) = vmax*ddlceN_dlce*dlce_dlceState;
+    if(ia >= 0) {
+        dYdotdY(il, ia) = vmax*ddlceN_da*da_daRaw;
+    } else {
+        dYdotdU(il, 0) = vmax*ddlceN_da*da_daRaw;
+    }
+}
+
+void Millard2012EquilibriumMuscle::
+computeImplicitResiduals(const SimTK::State& s, const SimTK::Vector& yDotGuess,
+                         SimTK::Vector& residuals) const
+{
+    const bool isActive = appliesForce(s) && !isActuationOverridden(s);
+
+    double a = SimTK::NaN;
+    if(!get_ignore_activation_dynamics()) {
+        const int ia = getStateVariableSystemIndex(STATE_ACTIVATION_NAME);
+        a = getActivationModel().clampActivation(
+                getStateVariableValue(s, STATE_ACTIVATION_NAME));
+        residuals[ia] = yDotGuess[ia]
+                        - (isActive ? getActivationDerivative(s) : 0.0);
+    } else {
+        a = getActivationModel().clampActivation(getControl(s));
+    }
+
+    if(get_ignore_tendon_compliance()) {
+        return;                                             // rigid tendon
+    }
+
+    const int il = getStateVariableSystemIndex(STATE_FIBER_LENGTH_NAME);
+    const double dlceN = yDotGuess[il]
+                         /(getMaxContractionVelocity()*getOptimalFiberLength());
+    const MuscleLengthInfo& mli = getMuscleLengthInfo(s);
+    if(!isActive || isFiberStateClamped(mli.fiberLength, dlceN)) {
+        residuals[il] = dlceN;
+        return;
+    }
+
+    const double fv   = get_ForceVelocityCurve().calcValue(dlceN);
+    const double fse  = get_TendonForceLengthCurve().
+                          calcValue(mli.normTendonLength);
+    const double beta = use_fiber_damping ? getFiberDamping() : 0.0;
+    residuals[il] = (a*mli.fiberActiveForceLengthMultiplier*fv
+                     + mli.fiberPassiveForceLengthMultiplier + beta*dlceN)
+                    *mli.cosPennationAngle - fse;
+}
+
 //==============================================================================
 // PRIVATE METHODS
 //==============================================================================
@@ -1216,6 +1342,184 @@ double Millard2012EquilibriumMuscle::clampFiberLength(double lce) const
     return max(lce, getMinimumFiberLength());
 }
 
+void Millard2012EquilibriumMuscle::
+calcRigidTendonMuscleLengthInfo(const SimTK::State& s,
+                                MuscleLengthInfo& mli) const
+{
+    const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
+    const double optFiberLength = getOptimalFiberLength();
+    const double tendonSlackLen = getTendonSlackLength();
+    const double lmt = getLength(s);
+
+    mli.fiberLength = clampFiberLength(penMdl.calcFiberLength(lmt,
+                                                              tendonSlackLen));
+    mli.normFiberLength        = mli.fiberLength / optFiberLength;
+    mli.pennationAngle         = penMdl.calcPennationAngle(mli.fiberLength);
+    mli.cosPennationAngle      = cos(mli.pennationAngle);
+    mli.sinPennationAngle      = sin(mli.pennationAngle);
+    mli.fiberLengthAlongTendon = mli.fiberLength * mli.cosPennationAngle;
+
+    // Necessary even for the rigid tendon, as it might have gone slack.
+    mli.tendonLength     = lmt - mli.fiberLengthAlongTendon;
+    mli.normTendonLength = mli.tendonLength / tendonSlackLen;
+    mli.tendonStrain     = mli.normTendonLength - 1.0;
+
+    mli.fiberPassiveForceLengthMultiplier =
+        get_FiberForceLengthCurve().calcValue(mli.normFiberLength);
+    mli.fiberActiveForceLengthMultiplier =
+        get_ActiveForceLengthCurve().calcValue(mli.normFiberLength);
+}
+
+void Millard2012EquilibriumMuscle::
+calcRigidTendonFiberVelocityInfo(const SimTK::State& s,
+                                 FiberVelocityInfo& fvi) const
+{
+    const MuscleLengthInfo& mli = getMuscleLengthInfo(s);
+    const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
+    const double dmcldt = getLengtheningSpeed(s);
+
+    double dlce   = 0.0;
+    double dlceN  = 0.0;
+    double fv     = 1.0;
+    double dphidt = 0.0;
+    double dlceAT = 0.0;
+    double dtl    = 0.0;
+
+    // If the tendon is buckling, the fiber velocity is zero. Otherwise, the
+    // fiber takes up all of the lengthening of the path.
+    if(mli.tendonLength >= getTendonSlackLength() - SimTK::SignificantReal) {
+        dlce  = penMdl.calcFiberVelocity(mli.cosPennationAngle, dmcldt, 0.0);
+        dlceN = dlce/(getOptimalFiberLength()*getMaxContractionVelocity());
+        fv    = get_ForceVelocityCurve().calcValue(dlceN);
+        dphidt = penMdl.calcPennationAngularVelocity(tan(mli.pennationAngle),
+                                                     mli.fiberLength, dlce);
+        dlceAT = penMdl.calcFiberVelocityAlongTendon(mli.fiberLength, dlce,
+                    mli.sinPennationAngle, mli.cosPennationAngle, dphidt);
+    }
+
+    double fiberStateClamped = 0.0;
+    if(isFiberStateClamped(mli.fiberLength, dlce)) {
+        dlce   = 0.0;
+        dlceN  = 0.0;
+        dlceAT = 0.0;
+        dphidt = 0.0;
+        dtl    = dmcldt;
+        fv     = 1.0;
+        fiberStateClamped = 1.0;
+    }
+
+    fvi.fiberVelocity                = dlce;
+    fvi.normFiberVelocity            = dlceN;
+    fvi.fiberVelocityAlongTendon     = dlceAT;
+    fvi.pennationAngularVelocity     = dphidt;
+    fvi.tendonVelocity               = dtl;
+    fvi.normTendonVelocity           = dtl/getTendonSlackLength();
+    fvi.fiberForceVelocityMultiplier = fv;
+
+    fvi.userDefinedVelocityExtras.resize(1);
+    fvi.userDefinedVelocityExtras[0] = fiberStateClamped;
+
+    // The dynamics info depends only on the activation (or the control),
+    // which is available once the State is realized to Stage::Velocity.
+    if(s.getSystemStage() >= SimTK::Stage::Velocity && appliesForce(s)
+       && !isCacheVariableValid(s, _dynamicsInfoCV)) {
+        calcRigidTendonMuscleDynamicsInfo(s, mli, fvi,
+                                          updMuscleDynamicsInfo(s));
+        markCacheVariableValid(s, _dynamicsInfoCV);
+    }
+}
+
+void Millard2012EquilibriumMuscle::
+calcRigidTendonMuscleDynamicsInfo(const SimTK::State& s,
+                                  const MuscleLengthInfo& mli,
+                                  const FiberVelocityInfo& fvi,
+                                  MuscleDynamicsInfo& mdi) const
+{
+    const double fiso = getMaxIsometricForce();
+
+    double a = SimTK::NaN;
+    if(!get_ignore_activation_dynamics()) {
+        a = getActivationModel().clampActivation(
+                getStateVariableValue(s, STATE_ACTIVATION_NAME));
+    } else {
+        a = getActivationModel().clampActivation(getControl(s));
+    }
+
+    SimTK_ERRCHK_ALWAYS(mli.fiberLength > SimTK::SignificantReal,
+        "calcMuscleDynamicsInfo",
+        "The muscle fiber has a length of 0, causing a singularity");
+    SimTK_ERRCHK_ALWAYS(mli.cosPennationAngle > SimTK::SignificantReal,
+        "calcMuscleDynamicsInfo",
+        "Pennation angle is 90 degrees, causing a singularity");
+
+    double fm           = 0.0; //total fiber force
+    double aFm          = 0.0; //active fiber force
+    double p1Fm         = 0.0; //passive conservative fiber force
+    double p2Fm         = 0.0; //passive non-conservative fiber force
+    double fmAT         = 0.0;
+    double dFm_dlce     = 0.0;
+    double dFmAT_dlceAT = 0.0;
+    double dFt_dtl      = 0.0;
+
+    if(fvi.userDefinedVelocityExtras[0] < 0.5) { //fiber state is not clamped
+        const SimTK::Vec4 fiberForceV = calcFiberForce(fiso, a,
+                                         mli.fiberActiveForceLengthMultiplier,
+                                         fvi.fiberForceVelocityMultiplier,
+                                         mli.fiberPassiveForceLengthMultiplier,
+                                         fvi.normFiberVelocity);
+        fm   = fiberForceV[0];
+        aFm  = fiberForceV[1];
+        p1Fm = fiberForceV[2];
+        p2Fm = fiberForceV[3];
+
+        // The fiber velocity is dictated by the path, so the fiber must be
+        // kept from generating a compressive force by saturating the damping
+        // force generated by the parallel element.
+        if(fm < 0) {
+            fm   = 0.0;
+            p2Fm = -aFm - p1Fm;
+        }
+
+        fmAT = fm * mli.cosPennationAngle;
+        dFm_dlce = calcFiberStiffness(fiso, a,
+                                      fvi.fiberForceVelocityMultiplier,
+                                      mli.normFiberLength,
+                                      getOptimalFiberLength());
+        const double dFmAT_dlce =
+            calc_DFiberForceAT_DFiberLength(fm, dFm_dlce, mli.fiberLength,
+                                            mli.sinPennationAngle,
+                                            mli.cosPennationAngle);
+        dFmAT_dlceAT = calc_DFiberForceAT_DFiberLengthAT(dFmAT_dlce,
+            mli.sinPennationAngle, mli.cosPennationAngle, mli.fiberLength);
+        dFt_dtl = SimTK::Infinity;
+    }
+
+    // The tendon transmits the fiber force; the muscle is as stiff as the
+    // fiber.
+    mdi.activation                = a;
+    mdi.fiberForce                = fm;
+    mdi.fiberForceAlongTendon     = fmAT;
+    mdi.normFiberForce            = fm/fiso;
+    mdi.activeFiberForce          = aFm;
+    mdi.passiveFiberForce         = p1Fm + p2Fm;
+    mdi.tendonForce               = fmAT;
+    mdi.normTendonForce           = fmAT/fiso;
+    mdi.fiberStiffness            = dFm_dlce;
+    mdi.fiberStiffnessAlongTendon = dFmAT_dlceAT;
+    mdi.tendonStiffness           = dFt_dtl;
+    mdi.muscleStiffness           = dFmAT_dlceAT;
+
+    mdi.fiberActivePower  = -(aFm + p2Fm)*fvi.fiberVelocity;
+    mdi.fiberPassivePower = -p1Fm*fvi.fiberVelocity;
+    mdi.tendonPower       = -fmAT*fvi.tendonVelocity;
+    mdi.musclePower       = -fmAT*getLengtheningSpeed(s);
+
+    SimTK::Vector dynExtras = SimTK::Vector(2);
+    dynExtras[0] = p1Fm; //elastic
+    dynExtras[1] = p2Fm; //damping
+    mdi.userDefinedDynamicsExtras = dynExtras;
+}
+
 std::pair<Millard2012EquilibriumMuscle::StatusFromEstimateMuscleFiberState,
           Millard2012EquilibriumMuscle::ValuesFromEstimateMuscleFiberState>
 Millard2012EquilibriumMuscle::estimateMuscleFiberState(
@@ -1224,7 +1528,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double fiberLengthGuess) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1253,7 +1558,10 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-    double lce = clampFiberLength(getPennationModel().calcFiberLength(ml,tl));
+    double lce = clampFiberLength(
+        SimTK::isFinite(fiberLengthGuess) && fiberLengthGuess > 0
+            ? fiberLengthGuess
+            : getPennationModel().calcFiberLength(ml,tl));
 
     double phi = 0.0;
     double cosphi = 1.0;
@@ -535,6 +535,36 @@ protected:
     void  calcMusclePotentialEnergyInfo(const SimTK::State& s, 
             MusclePotentialEnergyInfo& mpei) const override;
 
+    /** Computes the static fiber equilibrium, as
+    computeInitialFiberEquilibrium() does, starting the Newton iterations from
+    the fiber length in the state if warmStart is true.
+        @returns The number of Newton iterations taken (0 for a rigid tendon).
+        @throws MuscleCannotEquilibrate */
+    int solveInitialFiberEquilibrium(SimTK::State& s,
+                                     bool warmStart) const override {
+        return solveFiberEquilibrium(s, false, warmStart);
+    }
+
+    /** Calculate the partial derivatives of the activation and fiber length
+    derivatives with respect to activation, fiber length and excitation
+    analytically, from the derivatives of the activation dynamics and of the
+    curves. */
+    void computeStateDerivativeJacobian(const SimTK::State& s,
+                                        SimTK::Matrix& dYdotdY,
+                                        SimTK::Matrix& dYdotdU) const override;
+
+    /** The residual of the fiber length is the error in the equilibrium
+    between the fiber and tendon forces (normalized by the maximum isometric
+    force) at the guessed fiber velocity, so the force-velocity curve need
+    not be inverted (nor, with damping, the equilibrium equation solved with
+    Newton's method). While the fiber is clamped at its minimum length (or
+    the muscle does not apply force), it is the guessed normalized fiber
+    velocity instead. The residual of activation is the guess of its
+    derivative minus its derivative. */
+    void computeImplicitResiduals(const SimTK::State& s,
+                                  const SimTK::Vector& yDotGuess,
+                                  SimTK::Vector& residuals) const override;
+
 //==============================================================================
 // MODELCOMPONENT INTERFACE REQUIREMENTS
 //==============================================================================
@@ -554,18 +584,34 @@ protected:
     void computeStateVariableDerivatives(const SimTK::State& s) const override;
 
 private:
+    // Computes the length, velocity and dynamics info of many muscles at once.
+    friend class Millard2012EquilibriumMuscleBatch;
+
     // The name used to access the activation state.
     static const std::string STATE_ACTIVATION_NAME;
     // The name used to access the fiber length state.
     static const std::string STATE_FIBER_LENGTH_NAME;
+    // Handles to the states, if they are states, to set their derivatives.
+    mutable StateVariableHandle _activationSV;
+    mutable StateVariableHandle _fiberLengthSV;
 
     // Indicates whether fiber damping is included in the model (false if
     // dampingCoefficient < 0.001).
     bool use_fiber_damping;
 
+    // Indicates whether the tendon is rigid (ignore_tendon_compliance), in
+    // which case the length, velocity and dynamics info are computed by the
+    // specialized calcRigidTendon*() methods below.
+    bool m_isTendonRigid;
+
     void setNull();
     void constructProperties();
 
+    // Implements computeFiberEquilibrium(); returns the number of Newton
+    // iterations taken.
+    int solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                              bool warmStart) const;
+
     // Rebuilds muscle model if any of its properties have changed.
     void extendFinalizeFromProperties() override;
 
@@ -734,6 +780,20 @@ private:
     // length.
     double clampFiberLength(double lce) const;
 
+    // Rigid tendon: the fiber kinematics follow from the path in closed form.
+    // calcRigidTendonFiberVelocityInfo() also computes and caches the
+    // MuscleDynamicsInfo (once the State is realized to Stage::Velocity), as
+    // it requires no additional inputs, so that computing the actuation of
+    // the muscle does not go through the cache again.
+    void calcRigidTendonMuscleLengthInfo(const SimTK::State& s,
+                                         MuscleLengthInfo& mli) const;
+    void calcRigidTendonFiberVelocityInfo(const SimTK::State& s,
+                                          FiberVelocityInfo& fvi) const;
+    void calcRigidTendonMuscleDynamicsInfo(const SimTK::State& s,
+                                           const MuscleLengthInfo& mli,
+                                           const FiberVelocityInfo& fvi,
+                                           MuscleDynamicsInfo& mdi) const;
+
     // Status flag returned by estimateMuscleFiberState().
     enum StatusFromEstimateMuscleFiberState {
         Success_Converged,
@@ -759,6 +819,9 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param fiberLengthGuess the fiber length to start the Newton iterations
+           from; if NaN, start from the fiber length at which the tendon is
+           just beyond its slack length
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +830,8 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double fiberLengthGuess=SimTK::NaN) const;
 
 };
 } //end of namespace OpenSim
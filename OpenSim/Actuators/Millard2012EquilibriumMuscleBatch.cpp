@@ -0,0 +1,508 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  Millard2012EquilibriumMuscleBatch.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "Millard2012EquilibriumMuscleBatch.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <thread>
+
+using namespace OpenSim;
+
+// Each of the compute*() methods below performs, for all muscles, the
+// computations of the corresponding Millard2012EquilibriumMuscle::calc*Info()
+// method, in the same order, so that the results are identical.
+
+Millard2012EquilibriumMuscleBatch::
+Millard2012EquilibriumMuscleBatch(const Model& model)
+{
+    for (const auto& muscle :
+            model.getComponentList<Millard2012EquilibriumMuscle>()) {
+        // Derived muscles may compute their info differently.
+        if (muscle.getConcreteClassName() ==
+                Millard2012EquilibriumMuscle::getClassName())
+            _muscles.push_back(&muscle);
+    }
+
+    const size_t n = _muscles.size();
+    for (const Millard2012EquilibriumMuscle* muscle : _muscles) {
+        const MuscleFixedWidthPennationModel& penMdl =
+            muscle->getPennationModel();
+        _maxIsometricForce.push_back(muscle->getMaxIsometricForce());
+        _optimalFiberLength.push_back(muscle->getOptimalFiberLength());
+        _tendonSlackLength.push_back(muscle->getTendonSlackLength());
+        _maxFiberVelocity.push_back(muscle->getOptimalFiberLength()
+                                    * muscle->getMaxContractionVelocity());
+        _minimumFiberLength.push_back(muscle->getMinimumFiberLength());
+        _parallelogramHeight.push_back(penMdl.getParallelogramHeight());
+        _pennationMinimumFiberLength.push_back(penMdl.getMinimumFiberLength());
+        _pennationMinimumFiberLengthAlongTendon.push_back(
+            penMdl.getMinimumFiberLengthAlongTendon());
+        _maximumSinPennation.push_back(
+            sin(penMdl.get_maximum_pennation_angle()));
+        _maximumPennationAngle.push_back(penMdl.get_maximum_pennation_angle());
+        _minimumActivation.push_back(muscle->getMinimumActivation());
+        _fiberDamping.push_back(muscle->getFiberDamping());
+        _isPennated.push_back(
+            penMdl.get_pennation_angle_at_optimal() > SimTK::Eps);
+        _isRigidTendon.push_back(muscle->get_ignore_tendon_compliance());
+        _isDamped.push_back(muscle->use_fiber_damping);
+    }
+
+    _isActive.resize(n);
+    _muscleLength.resize(n);
+    _muscleSpeed.resize(n);
+    _activation.resize(n);
+    _fiberLength.resize(n);
+    _normFiberLength.resize(n);
+    _pennationAngle.resize(n);
+    _cosPennation.resize(n);
+    _sinPennation.resize(n);
+    _tendonLength.resize(n);
+    _normTendonLength.resize(n);
+    _fpe.resize(n);
+    _fal.resize(n);
+    _fse.resize(n);
+    _fiberVelocity.resize(n);
+    _normFiberVelocity.resize(n);
+    _fiberVelocityAlongTendon.resize(n);
+    _pennationAngularVelocity.resize(n);
+    _tendonVelocity.resize(n);
+    _fv.resize(n);
+    _isClamped.resize(n);
+    _dynamicsInfo.resize(n);
+    _tendonForce.resize(n);
+}
+
+void Millard2012EquilibriumMuscleBatch::realize(const SimTK::State& s)
+{
+    OPENSIM_THROW_IF(s.getSystemStage() < SimTK::Stage::Velocity, Exception,
+        "Millard2012EquilibriumMuscleBatch::realize(): the State must be "
+        "realized to Stage::Velocity.");
+
+    const int n = getNumMuscles();
+    try {
+        // Gather the inputs.
+        for (_current = 0; _current < n; ++_current) {
+            const int i = _current;
+            const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+            _isActive[i] = muscle.appliesForce(s);
+            _tendonForce[i] = 0;
+            _fiberVelocity[i] = 0;
+            if (!_isActive[i]) continue;
+
+            _muscleLength[i] = muscle.getLength(s);
+            _muscleSpeed[i] = muscle.getLengtheningSpeed(s);
+            const double activation = muscle.get_ignore_activation_dynamics()
+                ? muscle.getControl(s)
+                : muscle.getStateVariableValue(s,
+                    Millard2012EquilibriumMuscle::STATE_ACTIVATION_NAME);
+            _activation[i] = SimTK::clamp(_minimumActivation[i], activation,
+                                          1.0);
+            _fiberLength[i] = _isRigidTendon[i] ? 0
+                : muscle.getStateVariableValue(s,
+                    Millard2012EquilibriumMuscle::STATE_FIBER_LENGTH_NAME);
+        }
+        _current = -1;
+
+        computeLengths();
+        computeVelocities();
+        computeDynamics();
+    } catch (const std::exception& x) {
+        std::string msg = "Exception caught in "
+                          "Millard2012EquilibriumMuscleBatch::realize";
+        if (_current >= 0) msg += " from " + _muscles[_current]->getName();
+        _current = -1;
+        throw Exception(msg + "\n" + x.what());
+    }
+
+    storeResults(s);
+}
+
+void Millard2012EquilibriumMuscleBatch::computeLengths()
+{
+    const int n = getNumMuscles();
+
+    // Fiber length and pennation (MuscleFixedWidthPennationModel).
+    for (int i = 0; i < n; ++i) {
+        if (!_isActive[i]) continue;
+        double lce = _fiberLength[i];
+        if (_isRigidTendon[i]) {
+            const double lceAT = _muscleLength[i] - _tendonSlackLength[i];
+            const double h = _parallelogramHeight[i];
+            lce = (lceAT >= _pennationMinimumFiberLengthAlongTendon[i])
+                  ? sqrt(h*h + lceAT*lceAT) : _pennationMinimumFiberLength[i];
+        }
+        lce = std::max(lce, _minimumFiberLength[i]);
+
+        double phi = 0;
+        if (_isPennated[i]) {
+            if (lce > _pennationMinimumFiberLength[i]) {
+                const double sinPhi = _parallelogramHeight[i]/lce;
+                phi = (sinPhi < _maximumSinPennation[i])
+                      ? asin(sinPhi) : _maximumPennationAngle[i];
+            } else {
+                phi = _maximumPennationAngle[i];
+            }
+        }
+        _fiberLength[i] = lce;
+        _pennationAngle[i] = phi;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        _normFiberLength[i] = _fiberLength[i] / _optimalFiberLength[i];
+        _cosPennation[i] = cos(_pennationAngle[i]);
+        _sinPennation[i] = sin(_pennationAngle[i]);
+        _tendonLength[i] = _muscleLength[i]
+                           - _fiberLength[i]*_cosPennation[i];
+        _normTendonLength[i] = _tendonLength[i] / _tendonSlackLength[i];
+    }
+
+    // Curves.
+    for (_current = 0; _current < n; ++_current) {
+        const int i = _current;
+        if (!_isActive[i]) continue;
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+        _fpe[i] = muscle.get_FiberForceLengthCurve().calcValue(
+                      _normFiberLength[i]);
+        _fal[i] = muscle.get_ActiveForceLengthCurve().calcValue(
+                      _normFiberLength[i]);
+        _fse[i] = _isRigidTendon[i] ? 0
+            : muscle.get_TendonForceLengthCurve().calcValue(
+                  _normTendonLength[i]);
+    }
+    _current = -1;
+}
+
+void Millard2012EquilibriumMuscleBatch::computeVelocities()
+{
+    const int n = getNumMuscles();
+
+    // Fiber velocity, from the equilibrium equations.
+    for (_current = 0; _current < n; ++_current) {
+        const int i = _current;
+        if (!_isActive[i]) continue;
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+        double dlce = SimTK::NaN;
+        double dlceN = SimTK::NaN;
+        double fv = SimTK::NaN;
+
+        if (_isRigidTendon[i]) {
+            if (_tendonLength[i] < _tendonSlackLength[i]
+                                   - SimTK::SignificantReal) {
+                // The tendon is buckling, so fiber velocity is zero.
+                dlce = 0.0;
+                dlceN = 0.0;
+                fv = 1.0;
+            } else {
+                dlce = _muscleSpeed[i]*_cosPennation[i];
+                dlceN = dlce/_maxFiberVelocity[i];
+                fv = muscle.get_ForceVelocityCurve().calcValue(dlceN);
+            }
+        } else if (!_isDamped[i]) {
+            SimTK_ERRCHK_ALWAYS(_cosPennation[i] > SimTK::SignificantReal,
+                "calcFiberVelocityInfo",
+                "%s: Pennation angle is 90 degrees, causing a singularity");
+            SimTK_ERRCHK_ALWAYS(_activation[i] > SimTK::SignificantReal,
+                "calcFiberVelocityInfo",
+                "%s: Activation is 0, causing a singularity");
+            SimTK_ERRCHK_ALWAYS(_fal[i] > SimTK::SignificantReal,
+                "calcFiberVelocityInfo",
+                "%s: Active-force-length factor is 0, causing a singularity");
+
+            fv = muscle.calcFv(_activation[i], _fal[i], _fpe[i], _fse[i],
+                               _cosPennation[i]);
+            dlceN = muscle.fvInvCurve.calcValue(fv);
+            dlce = dlceN*_maxFiberVelocity[i];
+        } else {
+            SimTK_ERRCHK_ALWAYS(_fiberDamping[i] > SimTK::SignificantReal,
+                "calcFiberVelocityInfo",
+                "Fiber damping coefficient must be greater than 0.");
+
+            SimTK::Vec3 fiberVelocityV = muscle.calcDampedNormFiberVelocity(
+                _maxIsometricForce[i], _activation[i], _fal[i], _fpe[i],
+                _fse[i], _fiberDamping[i], _cosPennation[i]);
+
+            if (fiberVelocityV[2] > 0.5) {
+                dlceN = fiberVelocityV[0];
+                dlce = dlceN*_maxFiberVelocity[i];
+                fv = muscle.get_ForceVelocityCurve().calcValue(dlceN);
+            } else {
+                throw (OpenSim::Exception(muscle.getName() +
+                       " Fiber velocity Newton method did not converge"));
+            }
+        }
+        _fiberVelocity[i] = dlce;
+        _normFiberVelocity[i] = dlceN;
+        _fv[i] = fv;
+    }
+    _current = -1;
+
+    // The other velocity-related quantities.
+    for (int i = 0; i < n; ++i) {
+        if (!_isActive[i]) continue;
+        const double lce = _fiberLength[i];
+        double dlce = _fiberVelocity[i];
+        const double sinPhi = _sinPennation[i];
+        const double cosPhi = _cosPennation[i];
+        double dphidt = _isPennated[i]
+                        ? -(dlce/lce) * tan(_pennationAngle[i]) : 0.0;
+        double dlceAT = dlce*cosPhi - lce*sinPhi*dphidt;
+        double dtl = _isRigidTendon[i] ? 0.0
+            : _muscleSpeed[i] - dlce*cosPhi + lce*sinPhi*dphidt;
+
+        const double minLce = _minimumFiberLength[i];
+        _isClamped[i] = (lce <= minLce && dlce <= 0) || lce < minLce;
+        if (_isClamped[i]) {
+            _fiberVelocity[i] = 0.0;
+            _normFiberVelocity[i] = 0.0;
+            dlceAT = 0.0;
+            dphidt = 0.0;
+            dtl = _muscleSpeed[i];
+            _fv[i] = 1.0;
+        }
+        _fiberVelocityAlongTendon[i] = dlceAT;
+        _pennationAngularVelocity[i] = dphidt;
+        _tendonVelocity[i] = dtl;
+    }
+}
+
+void Millard2012EquilibriumMuscleBatch::computeDynamics()
+{
+    const int n = getNumMuscles();
+
+    for (_current = 0; _current < n; ++_current) {
+        const int i = _current;
+        if (!_isActive[i]) continue;
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+        const double fiso = _maxIsometricForce[i];
+        const double a = _activation[i];
+        const double lce = _fiberLength[i];
+        const double sinPhi = _sinPennation[i];
+        const double cosPhi = _cosPennation[i];
+
+        SimTK_ERRCHK_ALWAYS(lce > SimTK::SignificantReal,
+            "calcMuscleDynamicsInfo",
+            "The muscle fiber has a length of 0, causing a singularity");
+        SimTK_ERRCHK_ALWAYS(cosPhi > SimTK::SignificantReal,
+            "calcMuscleDynamicsInfo",
+            "Pennation angle is 90 degrees, causing a singularity");
+
+        double fm           = 0.0; //total fiber force
+        double aFm          = 0.0; //active fiber force
+        double p1Fm         = 0.0; //passive conservative fiber force
+        double p2Fm         = 0.0; //passive non-conservative fiber force
+        double pFm          = 0.0; //total passive fiber force
+        double fmAT         = 0.0;
+        double dFm_dlce     = 0.0;
+        double dFmAT_dlceAT = 0.0;
+        double dFt_dtl      = 0.0;
+        double Ke           = 0.0;
+
+        if (!_isClamped[i]) {
+            const double beta = _fiberDamping[i];
+            aFm  = fiso * (a*_fal[i]*_fv[i]);
+            p1Fm = fiso * _fpe[i];
+            p2Fm = fiso * beta*_normFiberVelocity[i];
+            fm   = aFm + (p1Fm+p2Fm);
+            pFm  = p1Fm + p2Fm;
+
+            // The rigid-tendon fiber may only generate tensile forces.
+            if (_isRigidTendon[i] && fm < 0) {
+                fm   = 0.0;
+                p2Fm = -aFm - p1Fm;
+                pFm  = p1Fm + p2Fm;
+            }
+
+            fmAT = fm * cosPhi;
+            dFm_dlce = muscle.calcFiberStiffness(fiso, a, _fv[i],
+                           _normFiberLength[i], _optimalFiberLength[i]);
+            const double dFmAT_dlce = muscle.calc_DFiberForceAT_DFiberLength(
+                fm, dFm_dlce, lce, sinPhi, cosPhi);
+            dFmAT_dlceAT = muscle.calc_DFiberForceAT_DFiberLengthAT(
+                dFmAT_dlce, sinPhi, cosPhi, lce);
+
+            if (!_isRigidTendon[i]) {
+                dFt_dtl = muscle.get_TendonForceLengthCurve().calcDerivative(
+                              _normTendonLength[i], 1)
+                          *(fiso/_tendonSlackLength[i]);
+                if (std::abs(dFmAT_dlceAT*dFt_dtl) > 0.0
+                    && std::abs(dFmAT_dlceAT+dFt_dtl)
+                       > SimTK::SignificantReal) {
+                    Ke = (dFmAT_dlceAT*dFt_dtl)/(dFmAT_dlceAT+dFt_dtl);
+                }
+            } else {
+                dFt_dtl = SimTK::Infinity;
+                Ke = dFmAT_dlceAT;
+            }
+        }
+
+        const double fse = _isRigidTendon[i] ? fmAT/fiso : _fse[i];
+
+        DynamicsInfo& mdi = _dynamicsInfo[i];
+        mdi.activation                = a;
+        mdi.fiberForce                = fm;
+        mdi.fiberForceAlongTendon     = fmAT;
+        mdi.normFiberForce            = fm/fiso;
+        mdi.activeFiberForce          = aFm;
+        mdi.passiveFiberForce         = pFm;
+        mdi.tendonForce               = fse*fiso;
+        mdi.normTendonForce           = fse;
+        mdi.fiberStiffness            = dFm_dlce;
+        mdi.fiberStiffnessAlongTendon = dFmAT_dlceAT;
+        mdi.tendonStiffness           = dFt_dtl;
+        mdi.muscleStiffness           = Ke;
+
+        mdi.fiberActivePower  = -(aFm+p2Fm)*_fiberVelocity[i];
+        mdi.fiberPassivePower = -(p1Fm*_fiberVelocity[i]);
+        mdi.tendonPower       = -(fse*fiso*_tendonVelocity[i]);
+        mdi.musclePower       = -(mdi.tendonForce*_muscleSpeed[i]);
+
+        mdi.userDefinedDynamicsExtras.resize(2);
+        mdi.userDefinedDynamicsExtras[0] = p1Fm; //elastic
+        mdi.userDefinedDynamicsExtras[1] = p2Fm; //damping
+
+        _tendonForce[i] = mdi.tendonForce;
+    }
+    _current = -1;
+}
+
+void Millard2012EquilibriumMuscleBatch::
+storeResults(const SimTK::State& s) const
+{
+    const int n = getNumMuscles();
+    for (int i = 0; i < n; ++i) {
+        if (!_isActive[i]) continue;
+        const Millard2012EquilibriumMuscle& muscle = *_muscles[i];
+
+        Millard2012EquilibriumMuscle::MuscleLengthInfo& mli =
+            muscle.updMuscleLengthInfo(s);
+        mli.fiberLength            = _fiberLength[i];
+        mli.normFiberLength        = _normFiberLength[i];
+        mli.pennationAngle         = _pennationAngle[i];
+        mli.cosPennationAngle      = _cosPennation[i];
+        mli.sinPennationAngle      = _sinPennation[i];
+        mli.fiberLengthAlongTendon = _fiberLength[i]*_cosPennation[i];
+        mli.tendonLength           = _tendonLength[i];
+        mli.normTendonLength       = _normTendonLength[i];
+        mli.tendonStrain           = _normTendonLength[i] - 1.0;
+        mli.fiberPassiveForceLengthMultiplier = _fpe[i];
+        mli.fiberActiveForceLengthMultiplier  = _fal[i];
+        muscle.markCacheVariableValid(s, muscle._lengthInfoCV);
+
+        Millard2012EquilibriumMuscle::FiberVelocityInfo& fvi =
+            muscle.updFiberVelocityInfo(s);
+        fvi.fiberVelocity                = _fiberVelocity[i];
+        fvi.normFiberVelocity            = _normFiberVelocity[i];
+        fvi.fiberVelocityAlongTendon     = _fiberVelocityAlongTendon[i];
+        fvi.pennationAngularVelocity     = _pennationAngularVelocity[i];
+        fvi.tendonVelocity               = _tendonVelocity[i];
+        fvi.normTendonVelocity           = _tendonVelocity[i]
+                                           / _tendonSlackLength[i];
+        fvi.fiberForceVelocityMultiplier = _fv[i];
+        fvi.userDefinedVelocityExtras.resize(1);
+        fvi.userDefinedVelocityExtras[0] = _isClamped[i] ? 1.0 : 0.0;
+        muscle.markCacheVariableValid(s, muscle._velInfoCV);
+
+        muscle.updMuscleDynamicsInfo(s) = _dynamicsInfo[i];
+        muscle.markCacheVariableValid(s, muscle._dynamicsInfoCV);
+    }
+}
+
+Millard2012EquilibriumMuscleBatch::FiberForceSamples
+Millard2012EquilibriumMuscleBatch::calcFiberForceSamples(int i,
+        const std::vector<double>& activation,
+        const std::vector<double>& normFiberLength,
+        const std::vector<double>& normFiberVelocity,
+        int numThreads) const
+{
+    const int numSamples = int(activation.size());
+    OPENSIM_THROW_IF(normFiberLength.size() != activation.size() ||
+                     normFiberVelocity.size() != activation.size(), Exception,
+        "Millard2012EquilibriumMuscleBatch::calcFiberForceSamples(): "
+        "the arrays of samples must have the same size.");
+    const Millard2012EquilibriumMuscle& muscle = *_muscles.at(i);
+
+    FiberForceSamples out;
+    out.fiberForce.resize(numSamples);
+    out.fiberForceAlongTendon.resize(numSamples);
+    out.activeFiberForce.resize(numSamples);
+    out.passiveFiberForce.resize(numSamples);
+    out.pennationAngle.resize(numSamples);
+
+    // The computations of computeLengths(), computeVelocities() and
+    // computeDynamics(), with the fiber velocity given.
+    auto computeSamples = [&](int begin, int end) {
+        for (int k = begin; k < end; ++k) {
+            const double a = SimTK::clamp(_minimumActivation[i],
+                                          activation[k], 1.0);
+            const double lce = std::max(
+                normFiberLength[k]*_optimalFiberLength[i],
+                _minimumFiberLength[i]);
+            const double lceN = lce/_optimalFiberLength[i];
+            double phi = 0;
+            if (_isPennated[i]) {
+                if (lce > _pennationMinimumFiberLength[i]) {
+                    const double sinPhi = _parallelogramHeight[i]/lce;
+                    phi = (sinPhi < _maximumSinPennation[i])
+                          ? asin(sinPhi) : _maximumPennationAngle[i];
+                } else {
+                    phi = _maximumPennationAngle[i];
+                }
+            }
+            const double dlceN = normFiberVelocity[k];
+            const double fiso = _maxIsometricForce[i];
+            const double aFm = fiso * (a
+                * muscle.get_ActiveForceLengthCurve().calcValue(lceN)
+                * muscle.get_ForceVelocityCurve().calcValue(dlceN));
+            const double p1Fm = fiso *
+                muscle.get_FiberForceLengthCurve().calcValue(lceN);
+            double p2Fm = fiso * _fiberDamping[i]*dlceN;
+            double fm = aFm + (p1Fm+p2Fm);
+            if (_isRigidTendon[i] && fm < 0) {
+                fm = 0.0;
+                p2Fm = -aFm - p1Fm;
+            }
+            out.fiberForce[k] = fm;
+            out.fiberForceAlongTendon[k] = fm*cos(phi);
+            out.activeFiberForce[k] = aFm;
+            out.passiveFiberForce[k] = p1Fm + p2Fm;
+            out.pennationAngle[k] = phi;
+        }
+    };
+
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    // Threads are not worth starting for fewer than ~1000 samples each.
+    const int numBlocks = std::max(1, std::min(numThreads, numSamples/1000));
+    const int blockSize = (numSamples + numBlocks - 1)/numBlocks;
+    std::vector<std::thread> threads;
+    for (int b = 1; b < numBlocks; ++b) {
+        const int begin = std::min(numSamples, b*blockSize);
+        const int end = std::min(numSamples, begin + blockSize);
+        try {
+            threads.emplace_back(computeSamples, begin, end);
+        } catch (const std::system_error&) {
+            computeSamples(begin, end);
+        }
+    }
+    computeSamples(0, std::min(numSamples, blockSize));
+    for (auto& thread : threads) thread.join();
+    return out;
+}
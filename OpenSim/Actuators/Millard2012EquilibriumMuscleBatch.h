@@ -0,0 +1,173 @@
+#ifndef OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
+#define OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  Millard2012EquilibriumMuscleBatch.h                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Millard2012EquilibriumMuscleBatch computes the length, velocity and
+dynamics information (e.g., fiber and tendon forces, and the fiber velocity,
+which is the derivative of the fiber length state) of all of the
+Millard2012EquilibriumMuscles of a Model at once, and stores the results in
+the cache of each muscle, so that the muscles do not compute them again when
+the Model's forces and state derivatives are computed.
+
+The inputs of all of the muscles (path lengths and lengthening speeds,
+activations, fiber lengths) are gathered into contiguous arrays, one per
+quantity, together with the properties of the muscles, and each step of the
+computation is done for all muscles in a loop over these arrays, rather
+than muscle by muscle. The results are identical to those computed by the
+muscles themselves.
+
+@code{.cpp}
+SimTK::State& s = model.initSystem();
+Millard2012EquilibriumMuscleBatch batch(model);
+...
+model.realizeVelocity(s);
+batch.realize(s);
+model.realizeAcceleration(s); // Uses the forces computed by the batch.
+@endcode
+
+Only Millard2012EquilibriumMuscles themselves are included, not classes
+derived from them (which may compute these quantities differently). Create
+a new batch if the properties of the muscles, or the muscles in the Model,
+change. */
+class OSIMACTUATORS_API Millard2012EquilibriumMuscleBatch {
+public:
+    /** Gather the Millard2012EquilibriumMuscles of a Model whose System has
+    been created (e.g., with Model::initSystem()). */
+    explicit Millard2012EquilibriumMuscleBatch(const Model& model);
+
+    int getNumMuscles() const { return int(_muscles.size()); }
+    const Millard2012EquilibriumMuscle& getMuscle(int i) const
+    {   return *_muscles[i]; }
+
+    /** Compute and cache the MuscleLengthInfo, FiberVelocityInfo and
+    MuscleDynamicsInfo of each muscle that applies force. The State must be
+    realized to Stage::Velocity.
+    @throws Exception if the equilibrium equations of a muscle cannot be
+                      solved, as Millard2012EquilibriumMuscle would. */
+    void realize(const SimTK::State& s);
+
+    /** The tendon force and fiber velocity of each muscle, as of the last
+    call to realize(); 0 for muscles that do not apply force. */
+    const std::vector<double>& getTendonForces() const
+    {   return _tendonForce; }
+    const std::vector<double>& getFiberVelocities() const
+    {   return _fiberVelocity; }
+
+    /** The fiber forces and pennation angle of a muscle at many samples of
+    its activation, normalized fiber length and normalized fiber velocity. */
+    struct FiberForceSamples {
+        std::vector<double> fiberForce;
+        std::vector<double> fiberForceAlongTendon;
+        std::vector<double> activeFiberForce;
+        std::vector<double> passiveFiberForce;
+        std::vector<double> pennationAngle;
+    };
+
+    /** Compute the fiber forces of muscle i (see getMuscle()) for each
+    sample of its activation, normalized fiber length and normalized fiber
+    velocity, e.g., to train a surrogate of the muscle or to study a
+    population of muscles. Each sample is computed as the muscle computes its
+    MuscleDynamicsInfo for these values: the activation is clamped to
+    [minimum activation, 1], the fiber length is not allowed below the
+    minimum fiber length, and the fiber of a muscle with a rigid tendon does
+    not push. The samples are independent, and are shared among numThreads
+    threads (if not positive, the number of hardware threads).
+    @throws Exception if the arrays of samples differ in size. */
+    FiberForceSamples calcFiberForceSamples(int i,
+            const std::vector<double>& activation,
+            const std::vector<double>& normFiberLength,
+            const std::vector<double>& normFiberVelocity,
+            int numThreads = -1) const;
+
+private:
+    void computeLengths();
+    void computeVelocities();
+    void computeDynamics();
+    void storeResults(const SimTK::State& s) const;
+
+    std::vector<const Millard2012EquilibriumMuscle*> _muscles;
+
+    // Properties of the muscles.
+    std::vector<double> _maxIsometricForce;
+    std::vector<double> _optimalFiberLength;
+    std::vector<double> _tendonSlackLength;
+    std::vector<double> _maxFiberVelocity; // optimal length * max velocity
+    std::vector<double> _minimumFiberLength;
+    std::vector<double> _parallelogramHeight;
+    std::vector<double> _pennationMinimumFiberLength;
+    std::vector<double> _pennationMinimumFiberLengthAlongTendon;
+    std::vector<double> _maximumSinPennation;
+    std::vector<double> _maximumPennationAngle;
+    std::vector<double> _minimumActivation;
+    std::vector<double> _fiberDamping;
+    std::vector<char>   _isPennated;
+    std::vector<char>   _isRigidTendon;
+    std::vector<char>   _isDamped;
+
+    // Inputs, gathered from the State.
+    std::vector<char>   _isActive;
+    std::vector<double> _muscleLength;
+    std::vector<double> _muscleSpeed;
+    std::vector<double> _activation;
+
+    // Length info.
+    std::vector<double> _fiberLength;
+    std::vector<double> _normFiberLength;
+    std::vector<double> _pennationAngle;
+    std::vector<double> _cosPennation;
+    std::vector<double> _sinPennation;
+    std::vector<double> _tendonLength;
+    std::vector<double> _normTendonLength;
+    std::vector<double> _fpe;
+    std::vector<double> _fal;
+    std::vector<double> _fse;
+
+    // Velocity info.
+    std::vector<double> _fiberVelocity;
+    std::vector<double> _normFiberVelocity;
+    std::vector<double> _fiberVelocityAlongTendon;
+    std::vector<double> _pennationAngularVelocity;
+    std::vector<double> _tendonVelocity;
+    std::vector<double> _fv;
+    std::vector<char>   _isClamped;
+
+    // Dynamics info.
+    typedef Millard2012EquilibriumMuscle::MuscleDynamicsInfo DynamicsInfo;
+    std::vector<DynamicsInfo> _dynamicsInfo;
+    std::vector<double> _tendonForce;
+
+    // The muscle being computed, for error messages.
+    int _current = -1;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MILLARD2012_EQUILIBRIUM_MUSCLE_BATCH_H_
@@ -21,6 +21,10 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include "MuscleFirstOrderActivationDynamicModel.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace OpenSim;
@@ -86,6 +90,57 @@ calcDerivative(double activation, double excitation) const
     return (excitation - activation) / tau;
 }
 
+void MuscleFirstOrderActivationDynamicModel::
+calcDerivatives(int n, const double* activation, const double* excitation,
+                const double* minActivation, const double* tauActivation,
+                const double* tauDeactivation, double* derivative)
+{
+    for (int i = 0; i < n; ++i) {
+        const double a = std::min(std::max(activation[i], minActivation[i]),
+                                  1.0);
+        const double u = excitation[i];
+        const double f = 0.5 + 1.5*a;
+        const double tau = (u > a) ? tauActivation[i]*f
+                                   : tauDeactivation[i]/f;
+        derivative[i] = (u - a) / tau;
+    }
+}
+
+double MuscleFirstOrderActivationDynamicModel::
+getActivationDerivative(const SimTK::State& s) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(_batchIndex < 0, Exception,
+        "Expected the activation model of a Muscle with an activation state "
+        "variable.");
+    const MuscleFirstOrderActivationDynamicModel& batch = _batch.getRef();
+    const SimTK::Vector& controls = getModel().getControls(s);
+
+    // Below Dynamics, the derivatives could not be kept in the cache.
+    if (s.getSystemStage() < SimTK::Stage::Dynamics) {
+        return calcDerivative(
+                getStateVariableValue(s, batch._activationSVs[_batchIndex]),
+                controls[batch._controlIndices[_batchIndex]]);
+    }
+
+    if (!batch.isCacheVariableValid(s, batch._derivativesCV)) {
+        const int n = int(batch._activationSVs.size());
+        SimTK::Vector& adot =
+                batch.updCacheVariableValue(s, batch._derivativesCV);
+        adot.resize(n);
+        SimTK::Vector excitation(n);
+        for (int i = 0; i < n; ++i) {
+            adot[i] = getStateVariableValue(s, batch._activationSVs[i]);
+            excitation[i] = controls[batch._controlIndices[i]];
+        }
+        calcDerivatives(n, &adot[0], &excitation[0],
+                        batch._minActivations.data(),
+                        batch._tauActivations.data(),
+                        batch._tauDeactivations.data(), &adot[0]);
+        batch.markCacheVariableValid(s, batch._derivativesCV);
+    }
+    return batch.getCacheVariableValue(s, batch._derivativesCV)[_batchIndex];
+}
+
 //==============================================================================
 // COMPONENT INTERFACE
 //==============================================================================
@@ -109,3 +164,56 @@ void MuscleFirstOrderActivationDynamicModel::extendFinalizeFromProperties()
         1.0-SimTK::SignificantReal, "minimum_activation",
         errorLocation.c_str());
 }
+
+void MuscleFirstOrderActivationDynamicModel::
+extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+
+    // The first model in the Model (possibly this one) keeps the
+    // derivatives of all of them.
+    auto actMdls =
+            model.getComponentList<MuscleFirstOrderActivationDynamicModel>();
+    _batch.reset(&*actMdls.begin());
+    _batchIndex = -1;
+}
+
+void MuscleFirstOrderActivationDynamicModel::
+extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    if (_batch.get() == this) {
+        _derivativesCV = addCacheVariable("activation_derivatives",
+                SimTK::Vector(), SimTK::Stage::Dynamics);
+    }
+}
+
+void MuscleFirstOrderActivationDynamicModel::
+extendRealizeTopology(SimTK::State& state) const
+{
+    Super::extendRealizeTopology(state);
+    if (_batch.get() != this) return;
+
+    // The Muscles have added their state variables, and the Actuators have
+    // their control indices, once the System is built.
+    _controlIndices.clear();
+    _activationSVs.clear();
+    _minActivations.clear();
+    _tauActivations.clear();
+    _tauDeactivations.clear();
+    for (const auto& actMdl :
+            getModel().getComponentList<MuscleFirstOrderActivationDynamicModel>()) {
+        actMdl._batchIndex = -1;
+        const Muscle* muscle = actMdl.hasOwner() ?
+                dynamic_cast<const Muscle*>(&actMdl.getOwner()) : nullptr;
+        if (muscle == nullptr ||
+                muscle->getStateVariableNames().findIndex("activation") < 0)
+            continue;
+        actMdl._batchIndex = int(_activationSVs.size());
+        _controlIndices.push_back(muscle->getControlIndex());
+        _activationSVs.push_back(muscle->getStateVariableHandle("activation"));
+        _minActivations.push_back(actMdl.get_minimum_activation());
+        _tauActivations.push_back(actMdl.get_activation_time_constant());
+        _tauDeactivations.push_back(actMdl.get_deactivation_time_constant());
+    }
+}
@@ -25,6 +25,8 @@
 #include <OpenSim/Actuators/osimActuatorsDLL.h>
 #include <OpenSim/Simulation/Model/ModelComponent.h>
 
+#include <vector>
+
 namespace OpenSim {
 /** This is a muscle modeling utility class that computes the time derivative of
     activation using a first-order dynamic model. This activation model is a
@@ -111,14 +113,54 @@ public:
     /** Calculates the time derivative of activation. */
     double calcDerivative(double activation, double excitation) const;
 
+    /** Calculates the time derivatives of n activations at once, with the
+    parameters of each: derivative[i] is the derivative of activation[i]
+    given excitation[i], the same as calcDerivative() returns. The loop has
+    no branches other than selections between values, so that the compiler
+    can vectorize it. derivative may be the same array as activation. */
+    static void calcDerivatives(int n, const double* activation,
+                                const double* excitation,
+                                const double* minActivation,
+                                const double* tauActivation,
+                                const double* tauDeactivation,
+                                double* derivative);
+
+    /** Gets the time derivative of the activation of the Muscle that owns
+    this model (which must have an activation state variable), given its
+    excitation (its control). The derivatives of all the Muscles of the
+    Model that own a MuscleFirstOrderActivationDynamicModel are calculated
+    together, by calcDerivatives(), the first time one of them is needed at a
+    State realized to Stage::Dynamics; the excitations are read from the
+    Model's controls and the activations from the State, without calling the
+    Muscles. At a lower stage, the derivative is calculated on its own. */
+    double getActivationDerivative(const SimTK::State& s) const;
+
 protected:
     // Component interface.
     void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& state) const override;
 
 private:
     void setNull();
     void constructProperties();
 
+    // The model, among those of the Model's muscles, whose cache variable
+    // holds the derivatives of all of them (the first one in the Model).
+    SimTK::ReferencePtr<const MuscleFirstOrderActivationDynamicModel> _batch;
+    // This model's index in the batch, or -1 if its owner is not a Muscle
+    // with an activation state variable.
+    mutable int _batchIndex = -1;
+
+    // The batch (only in the first model): the control index, activation
+    // state variable and parameters of each Muscle, and its derivatives.
+    mutable std::vector<int> _controlIndices;
+    mutable std::vector<StateVariableHandle> _activationSVs;
+    mutable std::vector<double> _minActivations, _tauActivations,
+                                _tauDeactivations;
+    mutable CacheVariable<SimTK::Vector> _derivativesCV;
+
 };
 
 }
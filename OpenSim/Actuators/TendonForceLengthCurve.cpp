@@ -38,9 +38,6 @@ static int RefTendon_normPE_Idx    = 6;
 //==============================================================================
 // CONSTRUCTION, COPY CONSTRUCTION, ASSIGNMENT
 //==============================================================================
-// Uses default (compiler-generated) destructor, copy constructor, copy
-// assignment operator.
-
 TendonForceLengthCurve::TendonForceLengthCurve()
 {
     setNull();
@@ -74,6 +71,35 @@ TendonForceLengthCurve::TendonForceLengthCurve(double strainAtOneNormForce)
     ensureCurveUpToDate();
 }
 
+TendonForceLengthCurve::TendonForceLengthCurve(
+        const TendonForceLengthCurve& source) : Super(source)
+{
+    copyData(source);
+}
+
+TendonForceLengthCurve& TendonForceLengthCurve::operator=(
+        const TendonForceLengthCurve& source)
+{
+    if (&source != this) {
+        Super::operator=(source);
+        copyData(source);
+    }
+    return *this;
+}
+
+void TendonForceLengthCurve::copyData(const TendonForceLengthCurve& source)
+{
+    m_curve = source.m_curve;
+    m_normForceAtToeEndInUse = source.m_normForceAtToeEndInUse;
+    m_stiffnessAtOneNormForceInUse = source.m_stiffnessAtOneNormForceInUse;
+    m_curvinessInUse = source.m_curvinessInUse;
+    m_isFittedCurveBeingUsed = source.m_isFittedCurveBeingUsed;
+    if (source.isObjectUpToDateWithProperties())
+        setObjectIsUpToDateWithProperties();
+    else
+        clearObjectIsUpToDateWithProperties();
+}
+
 void TendonForceLengthCurve::setNull()
 {
     setAuthors("Matthew Millard and Ajay Seth");
@@ -92,16 +118,28 @@ void TendonForceLengthCurve::constructProperties()
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
 {
-    SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+            getConcreteClassName(),
+            {get_strain_at_one_norm_force(),
+             m_stiffnessAtOneNormForceInUse,
+             m_normForceAtToeEndInUse,
+             m_curvinessInUse,
+             double(computeIntegral)},
+            [&] { return createCurve(computeIntegral,
+                                     getConcreteClassName()); });
+    setObjectIsUpToDateWithProperties();
+}
+
+SmoothSegmentedFunction* TendonForceLengthCurve::createCurve(
+        bool computeIntegral, const std::string& name) const
+{
+    return SmoothSegmentedFunctionFactory::
         createTendonForceLengthCurve(get_strain_at_one_norm_force(),
                                      m_stiffnessAtOneNormForceInUse,
                                      m_normForceAtToeEndInUse,
                                      m_curvinessInUse,
                                      computeIntegral,
-                                     getName());
-    m_curve = *f;
-    delete f;
-    setObjectIsUpToDateWithProperties();
+                                     name);
 }
 
 void TendonForceLengthCurve::ensureCurveUpToDate()
@@ -204,13 +242,7 @@ void TendonForceLengthCurve::setOptionalProperties(
 SimTK::Function* TendonForceLengthCurve::createSimTKFunction() const
 {
     // Back the OpenSim::Function with this SimTK::Function.
-    return SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
-                get_strain_at_one_norm_force(),
-                m_stiffnessAtOneNormForceInUse,
-                m_normForceAtToeEndInUse,
-                m_curvinessInUse,
-                true,
-                getName());
+    return createCurve(true, getName());
 }
 
 //==============================================================================
@@ -220,7 +252,7 @@ double TendonForceLengthCurve::calcValue(double aNormLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
-    return m_curve.calcValue(aNormLength);
+    return m_curve->calcValue(aNormLength);
 }
 
 double TendonForceLengthCurve::calcDerivative(double aNormLength,
@@ -232,14 +264,14 @@ double TendonForceLengthCurve::calcDerivative(double aNormLength,
         "TendonForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(aNormLength,order);
+    return m_curve->calcDerivative(aNormLength,order);
 }
 
 double TendonForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
 {
-    return m_curve.calcDerivative(derivComponents, x);
+    return m_curve->calcDerivative(derivComponents, x);
 }
 
 double TendonForceLengthCurve::calcIntegral(double aNormLength) const
@@ -247,20 +279,20 @@ double TendonForceLengthCurve::calcIntegral(double aNormLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
 
-    if (!m_curve.isIntegralAvailable()) {
+    if (!m_curve->isIntegralAvailable()) {
         TendonForceLengthCurve* mutableThis =
             const_cast<TendonForceLengthCurve*>(this);
         mutableThis->buildCurve(true);
     }
 
-    return m_curve.calcIntegral(aNormLength);
+    return m_curve->calcIntegral(aNormLength);
 }
 
 SimTK::Vec2 TendonForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void TendonForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -270,7 +302,10 @@ void TendonForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     double xmin = 0.9;
     double xmax = 1.0+get_strain_at_one_norm_force()*1.1;
 
-    m_curve.printMuscleCurveToCSVFile(path, xmin, xmax);
+    // Print a curve named after this curve, rather than the shared one.
+    std::unique_ptr<SmoothSegmentedFunction> curve{
+        createCurve(true, getName())};
+    curve->printMuscleCurveToCSVFile(path, xmin, xmax);
 }
 
 //==============================================================================
@@ -321,3 +356,14 @@ calcReferenceTendon(double strainAtOneNormForce)
 
     return tdnProp;
 }
+
+void TendonForceLengthCurve::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    // Copies of this curve share its SmoothSegmentedFunction.
+    if (m_curve) {
+        usage.addShared(MemoryUsage::Curves, m_curve.get(),
+                        m_curve->estimateMemoryUsage());
+    }
+}
@@ -28,6 +28,8 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/SmoothSegmentedFunction.h>
 
+#include <memory>
+
 #ifdef SWIG
     #ifdef OSIMACTUATORS_API
         #undef OSIMACTUATORS_API
@@ -166,6 +168,12 @@ public:
     default property values and assigns a default name. */
     TendonForceLengthCurve();
 
+    /** Copying preserves the fitted curve: a copy of a curve that is up to
+    date with its properties is up to date as well, and shares the
+    spline data of the original instead of fitting the curve again. */
+    TendonForceLengthCurve(const TendonForceLengthCurve& source);
+    TendonForceLengthCurve& operator=(const TendonForceLengthCurve& source);
+
     /** Constructs a tendon-force-length curve using the provided parameters and
     assigns a default name. */
     TendonForceLengthCurve(double strainAtOneNormForce,
@@ -261,7 +269,7 @@ public:
 
     /** Evaluates the tendon-force-length curve at a normalized tendon length of
     'aNormLength'. */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
     /** Calculates the derivative of the tendon-force-length multiplier with
     respect to the normalized tendon length.
@@ -362,12 +370,27 @@ private:
 
     void setNull();
     void constructProperties();
+    // Copy the members that are not properties, including the curve.
+    void copyData(const TendonForceLengthCurve& source);
 
     // This function will take all of the current property values. If they have
     // changed since the last time the curve was built, the curve is rebuilt.
+
     void buildCurve(bool computeIntegral = false);
+    // Create the curve from the current property values, with the given
+    // name.
+    SmoothSegmentedFunction* createCurve(bool computeIntegral,
+                                         const std::string& name) const;
 
-    SmoothSegmentedFunction m_curve;
+protected:
+    // Add the splines of the curve.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+private:
+    // The curve is shared with all other curves of this type that have the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve()),
+    // including those of copies of this curve.
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
 
     double m_normForceAtToeEndInUse;
     double m_stiffnessAtOneNormForceInUse;
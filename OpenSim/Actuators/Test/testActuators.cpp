@@ -28,6 +28,8 @@
 //      2.  testClutchedPathSpring()
 //      3.  testMcKibbenActuator()
 //    4. testActuatorsCombination()
+//    5. testParameterOnlyProperties()
+//    6. testCoordinateActuatorGroup()
 //      
 //     Add tests here as Actuators are added to OpenSim
 //
@@ -55,6 +57,8 @@ void testBodyActuator();
 void testClutchedPathSpring();
 void testMcKibbenActuator();
 void testActuatorsCombination();
+void testParameterOnlyProperties();
+void testCoordinateActuatorGroup();
 
 
 int main()
@@ -81,6 +85,16 @@ int main()
     catch (const std::exception& e) {
         cout << e.what() << endl; failures.push_back("testActuatorsCombination");
     }
+    try { testParameterOnlyProperties(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParameterOnlyProperties");
+    }
+    try { testCoordinateActuatorGroup(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCoordinateActuatorGroup");
+    }
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -921,3 +935,135 @@ void testActuatorsCombination()
     std::cout << " ********** Test Actuator Combination time = ********** " <<
         1.e3*(std::clock() - startTime) / CLOCKS_PER_SEC << "ms\n" << endl;
 }
+
+// Changing a parameter-only property of an initialized model takes effect
+// without rebuilding the System.
+void testParameterOnlyProperties()
+{
+    using namespace SimTK;
+
+    Model model;
+    auto* body = new OpenSim::Body("body", 1.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *body, Vec3(0), Vec3(0));
+    slider->updCoordinate().setName("x");
+    model.addBody(body);
+    model.addJoint(slider);
+
+    auto* actuator = new CoordinateActuator("x");
+    actuator->setName("actuator");
+    actuator->setOptimalForce(10.0);
+    model.addForce(actuator);
+
+    auto* controller = new PrescribedController();
+    controller->addActuator(*actuator);
+    controller->prescribeControlForActuator("actuator", new Constant(0.5));
+    model.addController(controller);
+
+    State& state = model.initSystem();
+    const MultibodySystem& system = model.getMultibodySystem();
+    model.realizeDynamics(state);
+    ASSERT_EQUAL(5.0, actuator->getActuation(state), SimTK::Eps);
+
+    ASSERT(actuator->getProperty_optimal_force().isParameterOnly());
+    actuator->setParameterValue(state, "optimal_force", 20.0);
+    ASSERT(actuator->get_optimal_force() == 20.0);
+    // The System was not rebuilt, and the properties stay finalized.
+    ASSERT(&model.getMultibodySystem() == &system);
+    ASSERT(actuator->isObjectUpToDateWithProperties());
+    ASSERT(state.getSystemStage() < Stage::Instance);
+    model.realizeDynamics(state);
+    ASSERT_EQUAL(10.0, actuator->getActuation(state), SimTK::Eps);
+
+    // Topology-affecting properties must be changed the usual way.
+    ASSERT(!actuator->getProperty_appliesForce().isParameterOnly());
+    ASSERT_THROW(OpenSim::Exception,
+            actuator->setParameterValue(state, "appliesForce", false));
+
+    cout << "testParameterOnlyProperties passed." << endl;
+}
+
+void testCoordinateActuatorGroup()
+{
+    using namespace SimTK;
+
+    // A slider with a pendulum hanging from it.
+    auto buildModel = [](Model& model) {
+        auto* cart = new OpenSim::Body("cart", 2.0, Vec3(0), Inertia(1.0));
+        auto* pendulum = new OpenSim::Body("pendulum", 1.0, Vec3(0, -0.5, 0),
+                Inertia(0.1));
+        auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+                Vec3(0), *cart, Vec3(0), Vec3(0));
+        slider->updCoordinate().setName("x");
+        auto* pin = new PinJoint("pin", *cart, Vec3(0), Vec3(0),
+                *pendulum, Vec3(0), Vec3(0));
+        pin->updCoordinate().setName("theta");
+        model.addBody(cart);
+        model.addJoint(slider);
+        model.addBody(pendulum);
+        model.addJoint(pin);
+    };
+
+    // Individual CoordinateActuators.
+    Model separate;
+    buildModel(separate);
+    auto* actuatorX = new CoordinateActuator("x");
+    actuatorX->setName("actuator_x");
+    actuatorX->setOptimalForce(10.0);
+    separate.addForce(actuatorX);
+    auto* actuatorTheta = new CoordinateActuator("theta");
+    actuatorTheta->setName("actuator_theta");
+    actuatorTheta->setOptimalForce(3.0);
+    separate.addForce(actuatorTheta);
+
+    // The same actuators as a group, with the coordinates in the opposite
+    // order of the mobilities.
+    Model grouped;
+    buildModel(grouped);
+    auto* group = new CoordinateActuatorGroup();
+    group->setName("group");
+    group->addCoordinate("theta", 3.0);
+    group->addCoordinate("x", 10.0);
+    grouped.addForce(group);
+    ASSERT(group->numControls() == 2);
+
+    State& s1 = separate.initSystem();
+    State& s2 = grouped.initSystem();
+    for (State* s : {&s1, &s2}) {
+        s->updQ() = Vector(Vec2(0.1, 0.3));
+        s->updU() = Vector(Vec2(-0.4, 1.2));
+    }
+    separate.realizeVelocity(s1);
+    separate.setControls(s1, Vector(Vec2(0.7, -0.2)));
+    separate.realizeAcceleration(s1);
+    grouped.realizeVelocity(s2);
+    grouped.setControls(s2, Vector(Vec2(-0.2, 0.7)));
+    grouped.realizeAcceleration(s2);
+
+    ASSERT(s1.getUDot().norm() != 0.0);
+    SimTK_TEST_EQ_TOL(s1.getUDot(), s2.getUDot(), 1e-12);
+
+    const Vector forces = group->getGeneralizedForces(s2);
+    ASSERT_EQUAL(-0.6, forces[0], SimTK::Eps);
+    ASSERT_EQUAL(7.0, forces[1], SimTK::Eps);
+    ASSERT_EQUAL(actuatorX->getPower(s1) + actuatorTheta->getPower(s1),
+                 group->getPower(s2), 1e-12);
+
+    const Array<std::string> labels = group->getRecordLabels();
+    ASSERT(labels.getSize() == 2);
+    ASSERT(labels[0] == "group_theta");
+    ASSERT(group->getRecordValues(s2)[1] == forces[1]);
+
+    // Each coordinate must exist and have an optimal force.
+    Model invalid;
+    buildModel(invalid);
+    auto* badGroup = new CoordinateActuatorGroup();
+    badGroup->addCoordinate("not_a_coordinate");
+    invalid.addForce(badGroup);
+    ASSERT_THROW(OpenSim::Exception, invalid.initSystem());
+    badGroup->set_coordinates(0, "x");
+    badGroup->append_coordinates("theta");
+    ASSERT_THROW(OpenSim::Exception, invalid.initSystem());
+
+    cout << "testCoordinateActuatorGroup passed." << endl;
+}
@@ -334,6 +334,77 @@ int main(int argc, char* argv[])
                 "    the maximum difference in slope of %f\n"
                 ,minTol,taylorMult,maxDxDiff);
 
+        cout<<"*****************************************************"<<endl;
+        cout<<"TEST: Derivatives of a model's muscles calculated together"<<endl;
+        cout << endl;
+        {
+            Model model;
+            auto* block = new OpenSim::Body("block", 1.0, Vec3(0), Inertia(1));
+            auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+                    Vec3(0), *block, Vec3(0), Vec3(0));
+            model.addBody(block);
+            model.addJoint(slider);
+
+            std::vector<Muscle*> muscles;
+            muscles.push_back(
+                    new Millard2012EquilibriumMuscle("millard1", 100, 0.1, 0.2, 0));
+            muscles.push_back(new Thelen2003Muscle("thelen", 100, 0.1, 0.2, 0));
+            muscles.push_back(
+                    new Millard2012EquilibriumMuscle("millard2", 100, 0.1, 0.2, 0));
+            // Has no activation state variable.
+            auto* noActivation =
+                    new Millard2012EquilibriumMuscle("millard3", 100, 0.1, 0.2, 0);
+            noActivation->set_ignore_activation_dynamics(true);
+            muscles.push_back(noActivation);
+            auto* controller = new PrescribedController();
+            for (unsigned i = 0; i < muscles.size(); ++i) {
+                muscles[i]->addNewPathPoint("origin", model.updGround(), Vec3(0));
+                muscles[i]->addNewPathPoint("insertion", *block, Vec3(0.3,0,0));
+                model.addForce(muscles[i]);
+                controller->addActuator(*muscles[i]);
+                controller->prescribeControlForActuator(muscles[i]->getName(),
+                        new Constant(0.2 + 0.25*i));
+            }
+            model.addController(controller);
+
+            State& s = model.initSystem();
+            muscles[0]->setActivation(s, 0.5);
+            muscles[1]->setActivation(s, 0.3);
+            muscles[2]->setActivation(s, 0.9);
+
+            auto getActivationModel = [](const Muscle& muscle)
+                    -> const MuscleFirstOrderActivationDynamicModel& {
+                auto* thelen = dynamic_cast<const Thelen2003Muscle*>(&muscle);
+                if (thelen) return thelen->getActivationModel();
+                return dynamic_cast<const Millard2012EquilibriumMuscle&>(muscle)
+                        .getActivationModel();
+            };
+
+            // Together at Dynamics, and each on its own below.
+            for (int stage = 0; stage < 2; ++stage) {
+                if (stage == 0) model.realizeDynamics(s);
+                else model.realizeVelocity(s);
+                for (int i = 0; i < 3; ++i) {
+                    const auto& actMdl = getActivationModel(*muscles[i]);
+                    double expected = actMdl.calcDerivative(
+                            muscles[i]->getStateVariableValue(s, "activation"),
+                            muscles[i]->getExcitation(s));
+                    SimTK_TEST_EQ(actMdl.getActivationDerivative(s), expected);
+                }
+                SimTK_TEST_MUST_THROW_EXC(
+                        getActivationModel(*noActivation)
+                                .getActivationDerivative(s),
+                        OpenSim::Exception);
+            }
+            model.realizeDynamics(s);
+            SimTK_TEST_EQ(static_cast<Millard2012EquilibriumMuscle*>(
+                    muscles[0])->getActivationDerivative(s),
+                    getActivationModel(*muscles[0]).calcDerivative(
+                        muscles[0]->getActivation(s),
+                        muscles[0]->getExcitation(s)));
+        }
+        cout << "PASSED" << endl;
+
         cout<<"*****************************************************"<<endl;
         cout<<"TEST: Exceptions thrown correctly.                   "<<endl;           
         cout << endl;
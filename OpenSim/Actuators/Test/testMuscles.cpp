@@ -94,7 +94,14 @@ void simulateMuscle(const Muscle &aMuscle,
 void testRigidTendonMuscle();
 void testThelen2003Muscle_Deprecated();
 void testThelen2003Muscle();
+void testThelen2003MuscleEquilibria();
 void testMillard2012EquilibriumMuscle();
+void testMillard2012EquilibriumMuscleBatch();
+void testMillard2012RigidTendon();
+void testEquilibrateMusclesWarmStart();
+void testRealizedMuscleState();
+void testMuscleStateDerivativeJacobian();
+void testImplicitResiduals();
 void testMillard2012AccelerationMuscle();
 void testSchutte1993Muscle();
 void testDelp1990Muscle();
@@ -131,12 +138,53 @@ int main()
     catch (const Exception& e)
         { e.print(cout); failures.push_back("testThelen2003Muscle"); }
 
+    try { testThelen2003MuscleEquilibria();
+        cout << "Thelen2003Muscle equilibria Test passed" << endl; }
+    catch (const Exception& e)
+        { e.print(cout); failures.push_back("testThelen2003MuscleEquilibria"); }
+
     try { testMillard2012EquilibriumMuscle();
         cout << "Millard2012EquilibriumMuscle Test passed" << endl; 
     }catch (const Exception& e){ 
         e.print(cout);
         failures.push_back("testMillard2012EquilibriumMuscle");
     }
+    try { testMillard2012EquilibriumMuscleBatch();
+        cout << "Millard2012EquilibriumMuscleBatch Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testMillard2012EquilibriumMuscleBatch");
+    }
+    try { testMillard2012RigidTendon();
+        cout << "Millard2012EquilibriumMuscle rigid tendon Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testMillard2012RigidTendon");
+    }
+    try { testEquilibrateMusclesWarmStart();
+        cout << "Warm-started equilibrateMuscles Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testEquilibrateMusclesWarmStart");
+    }
+    try { testRealizedMuscleState();
+        cout << "RealizedMuscleState Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testRealizedMuscleState");
+    }
+    try { testMuscleStateDerivativeJacobian();
+        cout << "Muscle state derivative Jacobian Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testMuscleStateDerivativeJacobian");
+    }
+    try { testImplicitResiduals();
+        cout << "Implicit residuals Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cout);
+        failures.push_back("testImplicitResiduals");
+    }
     try { testMillard2012AccelerationMuscle();
         cout << "Millard2012AccelerationMuscle Test passed" << endl; 
     }catch (const Exception& e){ 
@@ -788,6 +836,60 @@ void testThelen2003Muscle()
 }
 
 
+void testThelen2003MuscleEquilibria()
+{
+    // Muscles with different pennation, and a disabled one, between the
+    // ground and a sliding block.
+    Model model;
+    auto block = new OpenSim::Body("block", 1.0, Vec3(0), SimTK::Inertia(1.0));
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+
+    std::vector<Thelen2003Muscle*> muscles;
+    for (int i = 0; i < 3; ++i) {
+        auto muscle = new Thelen2003Muscle("muscle" + std::to_string(i),
+                                           100.0 + 10*i, 0.1, 0.2, 0.1*i);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                                Vec3(0, 0.01*i, 0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        model.addForce(muscle);
+        muscles.push_back(muscle);
+    }
+    muscles[2]->set_appliesForce(false);
+
+    SimTK::State& s = model.initSystem();
+    for (const double speed : {-0.3, 0.0, 0.2}) {
+        slider->updCoordinate().setValue(s, 0.32);
+        slider->updCoordinate().setSpeedValue(s, speed);
+        for (auto* muscle : muscles) muscle->setActivation(s, 0.6);
+
+        // Each muscle equilibrated on its own.
+        SimTK::State expected = s;
+        for (auto* muscle : muscles)
+            if (muscle->appliesForce(expected))
+                muscle->computeInitialFiberEquilibrium(expected);
+        model.realizeDynamics(expected);
+
+        const std::vector<int> iterations =
+            Thelen2003Muscle::computeInitialFiberEquilibria(
+                model.getForceSet(), s);
+        ASSERT(iterations.size() == 3);
+        ASSERT(iterations[0] >= 0 && iterations[1] >= 0);
+        ASSERT(iterations[2] == -1);
+        model.realizeDynamics(s);
+        for (int i = 0; i < 2; ++i) {
+            const Thelen2003Muscle& m = *muscles[i];
+            ASSERT_EQUAL(m.getFiberLength(expected), m.getFiberLength(s),
+                         1e-12);
+            ASSERT_EQUAL(m.getTendonForce(expected), m.getTendonForce(s),
+                         1e-9);
+            ASSERT_EQUAL(m.getFiberVelocity(expected), m.getFiberVelocity(s),
+                         1e-12);
+        }
+    }
+}
+
 void testMillard2012EquilibriumMuscle()
 {
     Millard2012EquilibriumMuscle muscle("muscle",
@@ -851,6 +953,429 @@ void testMillard2012EquilibriumMuscle()
 
 }
 
+void testMillard2012EquilibriumMuscleBatch()
+{
+    // Muscles with elastic, damped and rigid tendons, and a disabled one,
+    // between the ground and a sliding block.
+    Model model;
+    auto block = new OpenSim::Body("block", 1.0, Vec3(0), SimTK::Inertia(1.0));
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+
+    std::vector<Millard2012EquilibriumMuscle*> muscles;
+    for (int i = 0; i < 4; ++i) {
+        auto muscle = new Millard2012EquilibriumMuscle(
+                "muscle" + std::to_string(i), 100.0 + 10*i, 0.1, 0.2,
+                0.1*i);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                                Vec3(0, 0.01*i, 0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        model.addForce(muscle);
+        muscles.push_back(muscle);
+    }
+    muscles[1]->setFiberDamping(0.1);
+    muscles[2]->set_ignore_tendon_compliance(true);
+    muscles[3]->set_appliesForce(false);
+
+    SimTK::State& s = model.initSystem();
+    Millard2012EquilibriumMuscleBatch batch(model);
+    ASSERT(batch.getNumMuscles() == 4);
+    ASSERT(&batch.getMuscle(2) == muscles[2]);
+
+    for (const double speed : {-0.3, 0.0, 0.2}) {
+        slider->updCoordinate().setValue(s, 0.32);
+        slider->updCoordinate().setSpeedValue(s, speed);
+        for (auto* muscle : muscles) muscle->setActivation(s, 0.6);
+        model.equilibrateMuscles(s);
+        model.realizeVelocity(s);
+
+        // The same quantities, as computed by the muscles.
+        SimTK::State expected = s;
+        model.realizeDynamics(expected);
+
+        batch.realize(s);
+        model.realizeDynamics(s);
+        for (int i = 0; i < 3; ++i) {
+            const Millard2012EquilibriumMuscle& m = *muscles[i];
+            ASSERT_EQUAL(m.getTendonForce(expected), m.getTendonForce(s),
+                         1e-12);
+            ASSERT_EQUAL(m.getTendonForce(expected), batch.getTendonForces()[i],
+                         1e-12);
+            ASSERT_EQUAL(m.getFiberVelocity(expected), m.getFiberVelocity(s),
+                         1e-12);
+            ASSERT_EQUAL(m.getFiberVelocity(expected),
+                         batch.getFiberVelocities()[i], 1e-12);
+            ASSERT_EQUAL(m.getFiberLength(expected), m.getFiberLength(s),
+                         1e-12);
+            ASSERT_EQUAL(m.getPennationAngle(expected),
+                         m.getPennationAngle(s), 1e-12);
+            ASSERT_EQUAL(m.getActiveFiberForce(expected),
+                         m.getActiveFiberForce(s), 1e-12);
+            ASSERT_EQUAL(m.getPassiveFiberForce(expected),
+                         m.getPassiveFiberForce(s), 1e-12);
+            ASSERT_EQUAL(m.getMuscleStiffness(expected),
+                         m.getMuscleStiffness(s), 1e-9);
+            ASSERT_EQUAL(m.getMusclePower(expected), m.getMusclePower(s),
+                         1e-12);
+        }
+        ASSERT(batch.getTendonForces()[3] == 0);
+
+        // The forces at samples of the muscles' own fiber states. An
+        // elastic tendon's fiber velocity comes from the inverse of the
+        // force-velocity curve, so the forces agree to its precision.
+        for (int i = 0; i < 3; ++i) {
+            const Millard2012EquilibriumMuscle& m = *muscles[i];
+            const int numSamples = 3000;
+            const auto samples = batch.calcFiberForceSamples(i,
+                std::vector<double>(numSamples, m.getActivation(expected)),
+                std::vector<double>(numSamples,
+                                    m.getNormalizedFiberLength(expected)),
+                std::vector<double>(numSamples,
+                                    m.getNormalizedFiberVelocity(expected)),
+                2);
+            ASSERT(samples.fiberForce.size() == numSamples);
+            for (const int k : {0, numSamples - 1}) {
+                ASSERT_EQUAL(m.getActiveFiberForce(expected),
+                             samples.activeFiberForce[k], 1e-6);
+                ASSERT_EQUAL(m.getPassiveFiberForce(expected),
+                             samples.passiveFiberForce[k], 1e-6);
+                ASSERT_EQUAL(m.getFiberForceAlongTendon(expected),
+                             samples.fiberForceAlongTendon[k], 1e-6);
+                ASSERT_EQUAL(m.getPennationAngle(expected),
+                             samples.pennationAngle[k], 1e-12);
+            }
+        }
+    }
+    ASSERT_THROW(OpenSim::Exception, batch.calcFiberForceSamples(0,
+            std::vector<double>(2, 0.5), std::vector<double>(2, 1.0),
+            std::vector<double>(1, 0.0)));
+
+    // The State must be realized to Stage::Velocity.
+    s.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+    ASSERT_THROW(OpenSim::Exception, batch.realize(s));
+}
+
+void testMillard2012RigidTendon()
+{
+    Model model;
+    auto block = new OpenSim::Body("block", 1.0, Vec3(0),
+                                   SimTK::Inertia(1.0));
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    const double optimalFiberLength = 0.1;
+    const double tendonSlackLength = 0.2;
+    const double optimalPennation = 0.1;
+    auto muscle = new Millard2012EquilibriumMuscle("muscle", 100.0,
+            optimalFiberLength, tendonSlackLength, optimalPennation);
+    muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+    muscle->addNewPathPoint("insertion", *block, Vec3(0));
+    muscle->set_ignore_tendon_compliance(true);
+    model.addForce(muscle);
+
+    SimTK::State& s = model.initSystem();
+    const double speed = -0.1;
+    slider->updCoordinate().setValue(s, 0.31);
+    slider->updCoordinate().setSpeedValue(s, speed);
+    muscle->setActivation(s, 0.6);
+    model.realizeVelocity(s);
+
+    // The fiber kinematics follow from the path.
+    const double h = optimalFiberLength*sin(optimalPennation);
+    const double lceAT = muscle->getLength(s) - tendonSlackLength;
+    const double lce = sqrt(h*h + lceAT*lceAT);
+    ASSERT_EQUAL(lce, muscle->getFiberLength(s), 1e-12);
+    ASSERT_EQUAL(lceAT/lce, muscle->getCosPennationAngle(s), 1e-12);
+    ASSERT_EQUAL(tendonSlackLength, muscle->getTendonLength(s), 1e-12);
+    ASSERT_EQUAL(muscle->getLengtheningSpeed(s)*lceAT/lce,
+                 muscle->getFiberVelocity(s), 1e-12);
+    ASSERT(muscle->getTendonVelocity(s) == 0);
+
+    // The tendon transmits the fiber force.
+    ASSERT_EQUAL(muscle->getFiberForce(s)*muscle->getCosPennationAngle(s),
+                 muscle->getTendonForce(s), 1e-10);
+    ASSERT(muscle->getTendonForce(s) > 0);
+    ASSERT(muscle->getMuscleStiffness(s) ==
+           muscle->getFiberStiffnessAlongTendon(s));
+
+    // A different activation changes the force.
+    const double tendonForce = muscle->getTendonForce(s);
+    muscle->setActivation(s, 0.3);
+    model.realizeDynamics(s);
+    ASSERT(muscle->getTendonForce(s) < tendonForce);
+    ASSERT_EQUAL(muscle->getActuation(s), muscle->getTendonForce(s), 1e-10);
+}
+
+void testEquilibrateMusclesWarmStart()
+{
+    Model model;
+    auto block = new OpenSim::Body("block", 1.0, Vec3(0), SimTK::Inertia(1.0));
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    const int numMuscles = 6;
+    for (int i = 0; i < numMuscles; ++i) {
+        auto muscle = new Millard2012EquilibriumMuscle(
+                "muscle" + std::to_string(i), 100.0 + 10*i, 0.1, 0.2,
+                0.05*i);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                                Vec3(0, 0.01*i, 0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        model.addForce(muscle);
+    }
+
+    SimTK::State& s = model.initSystem();
+    slider->updCoordinate().setValue(s, 0.32);
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        muscle.setActivation(s, 0.5);
+
+    auto getFiberLengths = [&](const SimTK::State& state) {
+        std::vector<double> lengths;
+        for (const auto& muscle : model.getComponentList<Muscle>())
+            lengths.push_back(muscle.getStateVariableValue(state,
+                                                           "fiber_length"));
+        return lengths;
+    };
+
+    // Without a warm start, the results do not depend on the number of
+    // threads.
+    SimTK::State expected = s;
+    model.equilibrateMuscles(expected);
+    SimTK::State cold = s;
+    const std::vector<int> coldIterations =
+            model.equilibrateMuscles(cold, false, 4);
+    ASSERT(int(coldIterations.size()) == numMuscles);
+    ASSERT(getFiberLengths(cold) == getFiberLengths(expected));
+    int coldTotal = 0;
+    for (const int iterations : coldIterations) {
+        ASSERT(iterations > 0);
+        coldTotal += iterations;
+    }
+
+    // An equilibrium is already converged.
+    const std::vector<int> converged = model.equilibrateMuscles(cold, true);
+    for (const int iterations : converged) ASSERT(iterations == 0);
+
+    // Re-equilibrating from a nearby equilibrium.
+    slider->updCoordinate().setValue(expected, 0.325);
+    SimTK::State warm = expected;
+    model.equilibrateMuscles(expected);
+    const std::vector<int> warmIterations =
+            model.equilibrateMuscles(warm, true, 3);
+    int warmTotal = 0;
+    for (const int iterations : warmIterations) warmTotal += iterations;
+    ASSERT(warmTotal < coldTotal);
+    const std::vector<double> warmLengths = getFiberLengths(warm);
+    const std::vector<double> expectedLengths = getFiberLengths(expected);
+    for (int i = 0; i < numMuscles; ++i)
+        ASSERT_EQUAL(expectedLengths[i], warmLengths[i], 1e-6);
+}
+
+void testRealizedMuscleState()
+{
+    Model model;
+    auto block = new OpenSim::Body("block", 1.0, Vec3(0), SimTK::Inertia(1.0));
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    auto muscle = new Millard2012EquilibriumMuscle("muscle", 100.0, 0.1, 0.2,
+                                                   0.1);
+    muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+    muscle->addNewPathPoint("insertion", *block, Vec3(0));
+    model.addForce(muscle);
+
+    SimTK::State& s = model.initSystem();
+    slider->updCoordinate().setValue(s, 0.32);
+    slider->updCoordinate().setSpeedValue(s, 0.1);
+    muscle->setActivation(s, 0.5);
+    model.equilibrateMuscles(s);
+
+    auto checkAgainstAccessors = [&]() {
+        model.realizeDynamics(s);
+        const Muscle::RealizedMuscleState& ms =
+                muscle->getRealizedMuscleState(s);
+        ASSERT(ms.fiberLength == muscle->getFiberLength(s));
+        ASSERT(ms.normalizedFiberLength ==
+               muscle->getNormalizedFiberLength(s));
+        ASSERT(ms.pennationAngle == muscle->getPennationAngle(s));
+        ASSERT(ms.tendonLength == muscle->getTendonLength(s));
+        ASSERT(ms.activeForceLengthMultiplier ==
+               muscle->getActiveForceLengthMultiplier(s));
+        ASSERT(ms.fiberVelocity == muscle->getFiberVelocity(s));
+        ASSERT(ms.forceVelocityMultiplier ==
+               muscle->getForceVelocityMultiplier(s));
+        ASSERT(ms.activation == muscle->getActivation(s));
+        ASSERT(ms.activeFiberForce == muscle->getActiveFiberForce(s));
+        ASSERT(ms.passiveFiberForceAlongTendon ==
+               muscle->getPassiveFiberForceAlongTendon(s));
+        ASSERT(ms.tendonForce == muscle->getTendonForce(s));
+        ASSERT(ms.muscleStiffness == muscle->getMuscleStiffness(s));
+        ASSERT(ms.musclePower == muscle->getMusclePower(s));
+        // The same entry is returned until the State changes.
+        ASSERT(&muscle->getRealizedMuscleState(s) == &ms);
+    };
+    checkAgainstAccessors();
+
+    // Changing the state updates the gathered values.
+    const double tendonForce = muscle->getRealizedMuscleState(s).tendonForce;
+    muscle->setFiberLength(s, 1.1*muscle->getFiberLength(s));
+    checkAgainstAccessors();
+    ASSERT(muscle->getRealizedMuscleState(s).tendonForce != tendonForce);
+    muscle->setActivation(s, 0.8);
+    checkAgainstAccessors();
+}
+
+void testMuscleStateDerivativeJacobian()
+{
+    // Elastic tendon without and with damping, and without activation
+    // dynamics (so that the fiber velocity depends on the excitation).
+    for (int variant = 0; variant < 3; ++variant) {
+        Model model;
+        auto block = new OpenSim::Body("block", 1.0, Vec3(0),
+                                       SimTK::Inertia(1.0));
+        auto slider = new SliderJoint("slider", model.getGround(), *block);
+        model.addBody(block);
+        model.addJoint(slider);
+        auto muscle = new Millard2012EquilibriumMuscle("muscle", 100.0, 0.1,
+                                                       0.2, 0.1);
+        muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        if (variant == 1) muscle->setFiberDamping(0.1);
+        if (variant == 2) muscle->set_ignore_activation_dynamics(true);
+        model.addForce(muscle);
+
+        SimTK::State& s = model.initSystem();
+        slider->updCoordinate().setValue(s, 0.32);
+        slider->updCoordinate().setSpeedValue(s, -0.1);
+        muscle->setActivation(s, 0.5);
+        model.equilibrateMuscles(s);
+        if (variant != 2) muscle->setExcitation(s, 0.7);
+        model.realizeVelocity(s);
+
+        const Muscle::StateDerivativeJacobian jac =
+                muscle->calcStateDerivativeJacobian(s);
+        const Array<std::string>& names = jac.stateVariableNames;
+        const int il = names.findIndex("fiber_length");
+        const int ia = names.findIndex("activation");
+        ASSERT(il >= 0 && (ia >= 0) == (variant != 2));
+        ASSERT(jac.dYdotdY.nrow() == names.size());
+        ASSERT(jac.dYdotdU.ncol() == 1);
+
+        // Central differences of the state derivatives.
+        auto calcDifference = [&](std::function<void(SimTK::State&, double)>
+                                      perturb, double value, int row) {
+            const double h = 1e-6;
+            SimTK::State sp = s;
+            perturb(sp, value + h);
+            const double plus = muscle->getStateVariableDerivativeValue(sp,
+                    names[row]);
+            perturb(sp, value - h);
+            const double minus = muscle->getStateVariableDerivativeValue(sp,
+                    names[row]);
+            return (plus - minus)/(2*h);
+        };
+        auto setFiberLength = [&](SimTK::State& sp, double value) {
+            muscle->setFiberLength(sp, value);
+        };
+        // Without activation dynamics, this sets the excitation.
+        auto setActivation = [&](SimTK::State& sp, double value) {
+            muscle->setActivation(sp, value);
+        };
+        auto setExcitation = [&](SimTK::State& sp, double value) {
+            muscle->setExcitation(sp, value);
+        };
+        auto checkEqual = [](double expected, double actual) {
+            ASSERT_EQUAL(expected, actual,
+                         1e-5*std::max(1.0, std::abs(expected)));
+        };
+
+        const double lce = muscle->getStateVariableValue(s, "fiber_length");
+        checkEqual(calcDifference(setFiberLength, lce, il),
+                   jac.dYdotdY(il, il));
+        if (ia >= 0) {
+            const double a = muscle->getStateVariableValue(s, "activation");
+            const double u = muscle->getExcitation(s);
+            checkEqual(calcDifference(setActivation, a, il),
+                       jac.dYdotdY(il, ia));
+            checkEqual(calcDifference(setActivation, a, ia),
+                       jac.dYdotdY(ia, ia));
+            ASSERT(jac.dYdotdY(ia, il) == 0);
+            checkEqual(calcDifference(setExcitation, u, ia),
+                       jac.dYdotdU(ia, 0));
+            ASSERT(jac.dYdotdU(il, 0) == 0);
+        } else {
+            checkEqual(calcDifference(setActivation, muscle->getControl(s),
+                                      il),
+                       jac.dYdotdU(il, 0));
+        }
+
+        // The blocks of the model's muscles, in System indices.
+        SimTK::Matrix dYdotdY, dYdotdU;
+        model.calcMuscleStateDerivativeJacobian(s, dYdotdY, dYdotdU);
+        ASSERT(dYdotdY.nrow() == s.getNY() && dYdotdY.ncol() == s.getNY());
+        ASSERT(dYdotdU.ncol() == model.getNumControls());
+        const int yl = jac.stateVariableSystemIndices[il];
+        ASSERT(dYdotdY(yl, yl) == jac.dYdotdY(il, il));
+        ASSERT(dYdotdU(yl, jac.controlIndex) == jac.dYdotdU(il, 0));
+        ASSERT(dYdotdY(0, 0) == 0);
+    }
+}
+
+void testImplicitResiduals()
+{
+    // Elastic tendon without and with damping.
+    for (int variant = 0; variant < 2; ++variant) {
+        Model model;
+        auto block = new OpenSim::Body("block", 1.0, Vec3(0),
+                                       SimTK::Inertia(1.0));
+        auto slider = new SliderJoint("slider", model.getGround(), *block);
+        model.addBody(block);
+        model.addJoint(slider);
+        auto muscle = new Millard2012EquilibriumMuscle("muscle", 100.0, 0.1,
+                                                       0.2, 0.1);
+        muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        if (variant == 1) muscle->setFiberDamping(0.1);
+        model.addForce(muscle);
+
+        SimTK::State& s = model.initSystem();
+        slider->updCoordinate().setValue(s, 0.32);
+        slider->updCoordinate().setSpeedValue(s, -0.1);
+        muscle->setActivation(s, 0.5);
+        model.equilibrateMuscles(s);
+        muscle->setExcitation(s, 0.7);
+        model.realizeAcceleration(s);
+
+        // The explicit state derivatives satisfy the implicit equations.
+        SimTK::Vector yDotGuess = s.getYDot();
+        SimTK::Vector residuals = model.calcImplicitResiduals(s, yDotGuess);
+        ASSERT(residuals.size() == s.getNY());
+        const Muscle::StateDerivativeJacobian jac =
+                muscle->calcStateDerivativeJacobian(s);
+        const int il = jac.stateVariableSystemIndices[
+                jac.stateVariableNames.findIndex("fiber_length")];
+        const int ia = jac.stateVariableSystemIndices[
+                jac.stateVariableNames.findIndex("activation")];
+        ASSERT(residuals[0] == 0);
+        ASSERT_EQUAL(0.0, residuals[1], 1e-8);
+        ASSERT_EQUAL(0.0, residuals[ia], 1e-10);
+        ASSERT_EQUAL(0.0, residuals[il], 1e-6);
+
+        // A different guess of the fiber velocity does not.
+        yDotGuess[il] += 0.05;
+        residuals = model.calcImplicitResiduals(s, yDotGuess);
+        ASSERT(std::abs(residuals[il]) > 1e-3);
+        ASSERT_EQUAL(0.0, residuals[ia], 1e-10);
+
+        // Nor does a different guess of the acceleration.
+        yDotGuess = s.getYDot();
+        yDotGuess[1] += 1.0;
+        residuals = model.calcImplicitResiduals(s, yDotGuess);
+        ASSERT_EQUAL(1.0, residuals[1], 1e-8); // mass of the block
+    }
+}
+
 void testMillard2012AccelerationMuscle()
 {
     Millard2012AccelerationMuscle muscle("muscle",
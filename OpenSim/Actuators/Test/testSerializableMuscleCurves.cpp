@@ -28,6 +28,7 @@
 #include <OpenSim/Actuators/FiberForceLengthCurve.h>
 #include <OpenSim/Actuators/FiberCompressiveForceLengthCurve.h>
 #include <OpenSim/Actuators/FiberCompressiveForceCosPennationCurve.h>
+#include <OpenSim/Common/SmoothSegmentedFunctionFactory.h>
 
 #include <SimTKsimbody.h>
 #include <ctime>
@@ -45,6 +46,7 @@ void testTendonForceLengthCurve();
 void testFiberForceLengthCurve();
 void testFiberCompressiveForceLengthCurve();
 void testFiberCompressiveForceCosPennationCurve();
+void testSharedCurves();
 
 int main(int argc, char* argv[])
 {
@@ -59,6 +61,7 @@ int main(int argc, char* argv[])
             testFiberForceLengthCurve();
             testFiberCompressiveForceLengthCurve();
             testFiberCompressiveForceCosPennationCurve();
+            testSharedCurves();
 
             cout << "================================================" << endl;
             cout << "                   Timing Tests                 " << endl;
@@ -183,6 +186,17 @@ void testActiveForceLengthCurve()
         ActiveForceLengthCurve falCurve2p5(falCurve2);
         SimTK_TEST(falCurve2==falCurve2p5);
 
+        cout <<"    e. copies keep the built curve" <<endl;
+        SimTK_TEST(falCurve2.isObjectUpToDateWithProperties());
+        SimTK_TEST(falCurve2p5.isObjectUpToDateWithProperties());
+        SimTK_TEST(falCurve2p5.calcValue(1.0) == falCurve2.calcValue(1.0));
+        SimTK_TEST(falCurve2p5.calcDerivative(0.9, 1) ==
+                   falCurve2.calcDerivative(0.9, 1));
+        ActiveForceLengthCurve falCurve2p6;
+        falCurve2p6 = falCurve2;
+        SimTK_TEST(falCurve2p6.isObjectUpToDateWithProperties());
+        SimTK_TEST(falCurve2p6.calcValue(1.0) == falCurve2.calcValue(1.0));
+
         cout << "*Passed: default construction, limited serialization" << endl;
         cout << "         assignment operator, copy constructor" << endl;
 
@@ -1227,3 +1241,46 @@ void testFiberCompressiveForceCosPennationCurve()
         cout <<"________________________________________________________"<<endl;
 
 }
+
+void testSharedCurves()
+{
+    cout << endl;
+    cout << endl;
+    cout <<"**************************************************"<<endl;
+    cout <<"TESTING SHARED CURVES"<<endl;
+
+    ActiveForceLengthCurve falCurve1(0.4, 0.75, 1.75, 0.8, 0.1);
+    falCurve1.setName("falCurve1");
+    falCurve1.calcValue(1.0);
+    const int numSharedCurves =
+        SmoothSegmentedFunctionFactory::getNumSharedCurves();
+
+    // Curves with the same parameters share a curve, whatever their names.
+    ActiveForceLengthCurve falCurve2(0.4, 0.75, 1.75, 0.8, 0.1);
+    falCurve2.setName("falCurve2");
+    SimTK_TEST(falCurve2.calcValue(0.9) == falCurve1.calcValue(0.9));
+    SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() ==
+               numSharedCurves);
+
+    // So do copies.
+    std::unique_ptr<ActiveForceLengthCurve> falCurve3(falCurve1.clone());
+    SimTK_TEST(falCurve3->calcDerivative(0.9, 1) ==
+               falCurve1.calcDerivative(0.9, 1));
+    SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() ==
+               numSharedCurves);
+
+    // A curve with different parameters gets its own curve.
+    falCurve2.setMinValue(0.2);
+    SimTK_TEST(falCurve2.calcValue(0.3) != falCurve1.calcValue(0.3));
+    SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() ==
+               numSharedCurves + 1);
+
+    // The integral of a curve is only computed if it is needed, so asking
+    // for it switches to another shared curve.
+    TendonForceLengthCurve fseCurve1(0.049, 28.1, 0.67, 0.5);
+    TendonForceLengthCurve fseCurve2(fseCurve1);
+    SimTK_TEST(fseCurve1.calcIntegral(1.04) == fseCurve2.calcIntegral(1.04));
+    SimTK_TEST(fseCurve1.calcValue(1.03) == fseCurve2.calcValue(1.03));
+
+    cout << "Passed: Testing shared curves" << endl;
+}
@@ -23,6 +23,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <exception>
 #include <fstream>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "Thelen2003Muscle.h"
@@ -34,6 +35,11 @@ using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
 
+namespace {
+// Newton iterations allowed when solving for the initial fiber equilibrium.
+const int MaxEquilibriumIterations = 20;  //Should this be user settable?
+}
+
 //=============================================================================
 // CONSTRUCTORS
 //=============================================================================
@@ -225,14 +231,15 @@ calcInextensibleTendonActiveFiberForce(SimTK::State& s,
     double muscleVelocity = getLengtheningSpeed(s);
     double tendonSlackLength = getTendonSlackLength();
     double tendonVelocity = 0.0; //Inextensible tendon;
+    const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
 
-    double fiberLength  = getPennationModel().calcFiberLength(muscleLength,
-                                            tendonSlackLength);
+    double fiberLength  = penMdl.calcFiberLength(muscleLength,
+                                                 tendonSlackLength);
         
-    if(fiberLength > getPennationModel().getMinimumFiberLength()) {
-        double phi = getPennationModel().calcPennationAngle(fiberLength);
+    if(fiberLength > penMdl.getMinimumFiberLength()) {
+        double phi = penMdl.calcPennationAngle(fiberLength);
         
-        double fiberVelocity = getPennationModel().calcFiberVelocity(
+        double fiberVelocity = penMdl.calcFiberVelocity(
                                     cos(phi),muscleVelocity,tendonVelocity);
 
         inextensibleTendonActiveFiberForce = 
@@ -250,11 +257,11 @@ double Thelen2003Muscle::
                                             double fiberVelocity) const
 {
     double activeFiberForce = 0;    
-    double clampedFiberLength = getPennationModel()
-                                .clampFiberLength(fiberLength);
+    const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
+    double clampedFiberLength = penMdl.clampFiberLength(fiberLength);
 
     //If the fiber is in a legal range, compute the force its generating
-    if(fiberLength > getPennationModel().getMinimumFiberLength())
+    if(fiberLength > penMdl.getMinimumFiberLength())
     {
         //Clamp activation to a legal range
         double clampedActivation = getActivationModel()
@@ -281,7 +288,7 @@ double Thelen2003Muscle::
         double fiso = getMaxIsometricForce();
 
         //Evaluate the pennation angle
-        double phi = getPennationModel().calcPennationAngle(fiberLength);
+        double phi = penMdl.calcPennationAngle(fiberLength);
 
         //Compute the active fiber force 
         activeFiberForce = fiso * clampedActivation * fal * fv * cos(phi);
@@ -311,46 +318,100 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
 {
     //Initial activation and fiber length from input State, s.
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity);
-    double activation = getActivation(s);
+    setInitialEquilibrium(s, solveInitialEquilibrium(s));
+}
 
-    //Tolerance, in Newtons, of the desired equilibrium
-    const double tol = max( 1e-8*getMaxIsometricForce(), 
-                            SimTK::SignificantReal * 10 );
+std::vector<int> Thelen2003Muscle::computeInitialFiberEquilibria(
+        const ForceSet& forces, SimTK::State& s)
+{
+    std::vector<const Thelen2003Muscle*> muscles;
+    for (int i = 0; i < forces.getSize(); ++i) {
+        const auto* muscle = dynamic_cast<const Thelen2003Muscle*>(&forces[i]);
+        if (muscle) muscles.push_back(muscle);
+    }
+    std::vector<int> iterations(muscles.size(), -1);
+    if (muscles.empty()) return iterations;
+    muscles[0]->getModel().getMultibodySystem().realize(s,
+                                                        SimTK::Stage::Velocity);
+
+    // Solve all the muscles before changing the State.
+    std::vector<InitialEquilibrium> equilibria(muscles.size());
+    std::vector<bool> solved(muscles.size(), false);
+    std::exception_ptr firstError;
+    for (size_t i = 0; i < muscles.size(); ++i) {
+        if (!muscles[i]->appliesForce(s)) continue;
+        try {
+            equilibria[i] = muscles[i]->solveInitialEquilibrium(s);
+            solved[i] = true;
+        }
+        catch (const std::exception&) {
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
 
-    int maxIter = 20;  //Should this be user settable?
+    for (size_t i = 0; i < muscles.size(); ++i) {
+        if (!solved[i]) continue;
+        try {
+            muscles[i]->setInitialEquilibrium(s, equilibria[i]);
+            iterations[i] = int(equilibria[i].result.second.at("iterations"));
+        }
+        catch (const std::exception&) {
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
+    if (firstError) std::rethrow_exception(firstError);
+    return iterations;
+}
 
-    std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState> result;
+Thelen2003Muscle::InitialEquilibrium
+Thelen2003Muscle::solveInitialEquilibrium(const SimTK::State& s) const
+{
+    InitialEquilibrium equilibrium;
+    equilibrium.activation = getActivation(s);
+
+    //Tolerance, in Newtons, of the desired equilibrium
+    equilibrium.tolerance = max( 1e-8*getMaxIsometricForce(),
+                                 SimTK::SignificantReal * 10 );
 
     try {
-         result = initMuscleState(s, activation, tol, maxIter);
+        equilibrium.result = initMuscleState(s, equilibrium.activation,
+                equilibrium.tolerance, MaxEquilibriumIterations);
     }
     catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, x.what());
     }
+    return equilibrium;
+}
 
-    switch(result.first) {
+void Thelen2003Muscle::setInitialEquilibrium(SimTK::State& s,
+        const InitialEquilibrium& equilibrium) const
+{
+    const ValuesFromInitMuscleState& values = equilibrium.result.second;
+
+    switch(equilibrium.result.first) {
 
     case StatusFromInitMuscleState::Success_Converged:
-        setActuation(s, result.second["tendon_force"]);
-        setFiberLength(s, result.second["fiber_length"]);
+        setActuation(s, values.at("tendon_force"));
+        setFiberLength(s, values.at("fiber_length"));
         break;
 
     case StatusFromInitMuscleState::Warning_FiberAtLowerBound:
         printf("\n\nThelen2003Muscle initialization:"
                " %s is at its minimum fiber length of %f\n",
-               getName().c_str(), result.second["fiber_length"]);
-        setActuation(s, result.second["tendon_force"]);
-        setFiberLength(s, result.second["fiber_length"]);
+               getName().c_str(), values.at("fiber_length"));
+        setActuation(s, values.at("tendon_force"));
+        setFiberLength(s, values.at("fiber_length"));
         break;
 
     case StatusFromInitMuscleState::Failure_MaxIterationsReached:
         // Report internal variables and throw exception.
         std::ostringstream ss;
-        ss << "\n  Solution error " << abs(result.second["solution_error"])
-           << " exceeds tolerance of " << tol << "\n"
-           << "  Newton iterations reached limit of " << maxIter << "\n"
-           << "  Activation is " << activation << "\n"
-           << "  Fiber length is " << result.second["fiber_length"] << "\n";
+        ss << "\n  Solution error " << abs(values.at("solution_error"))
+           << " exceeds tolerance of " << equilibrium.tolerance << "\n"
+           << "  Newton iterations reached limit of "
+           << MaxEquilibriumIterations << "\n"
+           << "  Activation is " << equilibrium.activation << "\n"
+           << "  Fiber length is " << values.at("fiber_length") << "\n";
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
         break;
     }
@@ -363,21 +424,21 @@ void Thelen2003Muscle::calcMuscleLengthInfo(const SimTK::State& s,
         double optFiberLength   = getOptimalFiberLength();
         double mclLength        = getLength(s);
         double tendonSlackLen   = getTendonSlackLength();
+        const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
 
         //Clamp the minimum fiber length to its minimum physical value.
-        mli.fiberLength  = getPennationModel().clampFiberLength(
+        mli.fiberLength  = penMdl.clampFiberLength(
                                 getStateVariableValue(s, STATE_FIBER_LENGTH_NAME));
 
         mli.normFiberLength = mli.fiberLength/optFiberLength;       
-        mli.pennationAngle  = getPennationModel()
-                              .calcPennationAngle(mli.fiberLength);
+        mli.pennationAngle  = penMdl.calcPennationAngle(mli.fiberLength);
 
         mli.cosPennationAngle = cos(mli.pennationAngle);
         mli.sinPennationAngle = sin(mli.pennationAngle);
 
         mli.fiberLengthAlongTendon = mli.fiberLength*mli.cosPennationAngle;
     
-        mli.tendonLength      = getPennationModel().calcTendonLength(
+        mli.tendonLength      = penMdl.calcTendonLength(
                                     mli.cosPennationAngle,
                                     mli.fiberLength,mclLength );
         mli.normTendonLength  = mli.tendonLength / tendonSlackLen;
@@ -441,7 +502,6 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
    
 
         double lce  = mli.fiberLength;   
-        double phi  = mli.pennationAngle;
         double cosphi=mli.cosPennationAngle;
         double sinphi = mli.sinPennationAngle;
 
@@ -488,12 +548,12 @@ void Thelen2003Muscle::calcFiberVelocityInfo(const SimTK::State& s,
         double fv     = afalfv/(a*fal);
         double dlceN  = calcdlceN(a,fal,afalfv);
         double dlce   = dlceN*getMaxContractionVelocity()*optFiberLen;
-        double tanPhi = tan(phi);
-        double dphidt = getPennationModel().calcPennationAngularVelocity(
-                                            tanPhi,lce,dlce);
-        double dlceAT = getPennationModel().calcFiberVelocityAlongTendon(
+        double tanPhi = sinphi/cosphi;
+        const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
+        double dphidt = penMdl.calcPennationAngularVelocity(tanPhi,lce,dlce);
+        double dlceAT = penMdl.calcFiberVelocityAlongTendon(
                             lce, dlce, sinphi, cosphi, dphidt);
-        double dtl    = getPennationModel().calcTendonVelocity(
+        double dtl    = penMdl.calcTendonVelocity(
                             cosphi, sinphi, dphidt, lce, dlce, dmcldt);
     
     
@@ -684,10 +744,7 @@ bool Thelen2003Muscle::
 /** Get the rate change of activation */
 double Thelen2003Muscle::calcActivationRate(const SimTK::State& s) const 
 {    
-    double excitation = getExcitation(s);
-    double activation = getActivation(s);
-    double dadt = getActivationModel().calcDerivative(activation,excitation);
-    return dadt;
+    return getActivationModel().getActivationDerivative(s);
 }  
 
 
@@ -713,17 +770,21 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
     const double vol = ofl * sin(ophi);
     const double fiso= getMaxIsometricForce();
     const double vmax = getMaxContractionVelocity();
+    const MuscleFixedWidthPennationModel& penMdl = getPennationModel();
+    const double minLce = penMdl.getMinimumFiberLength();
 
     //Shorter version of normalized muscle multipliers
     double fse = 0; //Normalized tendon (series element) force
     double fal = 0; //Normalized active force length multiplier
     double fpe = 0; //Normalized parallel element force
     double fv  = 0; //Normalized force-velocity multiplier
+    double dfal_d_lceN = 0; //Derivatives of fal and fpe, found with them
+    double dfpe_d_lceN = 0;
 
     //*******************************
     //Position level
     double tl  = getTendonSlackLength()*1.01;
-    double lce = getPennationModel().calcFiberLength(ml, tl);
+    double lce = penMdl.calcFiberLength(ml, tl);
     
     double phi    = 0.0; 
     double cosphi = 1.0; 
@@ -764,18 +825,19 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
     // Helper functions
     //Update position level quantities, only if they won't go singular
     auto positionFunc = [&] {
-        phi = getPennationModel().calcPennationAngle(lce);
+        phi = penMdl.calcPennationAngle(lce);
         cosphi = cos(phi);
         tl = ml - lce*cosphi;
         lceN = lce / ofl;
         tlN = tl / tsl;
     };
 
-    // Functional to update the force multipliers 
+    // Functional to update the force multipliers (and the derivatives of
+    // the fiber's, used by partialsFunc at the same fiber length)
     auto multipliersFunc = [&] {
         fse = calcfse(tlN);
-        fal = calcfal(lceN);
-        fpe = calcfpe(lceN);
+        calcfalAndDerivative(lceN, fal, dfal_d_lceN);
+        calcfpeAndDerivative(lceN, fpe, dfpe_d_lceN);
     };
 
     // Functional to compute the equilibrium force error
@@ -788,7 +850,8 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
 
     // Functional to compute the partial derivative of muscle force w.r.t. lce
     auto partialsFunc = [&] {
-        dFm_dlce = calcDFmDlce(lce, ma, fv, fiso, ofl);
+        // As calcDFmDlce(lce, ma, fv, fiso, ofl).
+        dFm_dlce = ((ma*fv)*dfal_d_lceN + dfpe_d_lceN)*fiso*(1/ofl);
         dFmAT_dlce = calcDFmATDlce(lce, phi, cosphi, Fm, dFm_dlce, vol);
         dFmAT_dlceAT = dFmAT_dlce*cosphi;
 
@@ -821,7 +884,7 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         //negative stiffness of the fiber (which could happen in this
         // model) is equal to the positive stiffness of the tendon.
         if (abs(dFmAT_dlceAT + dFt_d_tl) > SimTK::SignificantReal
-            && tl > getTendonSlackLength()) {
+            && tl > tsl) {
 
             //Ke = (dFmAT_dlceAT*dFt_d_tl) / (dFmAT_dlceAT + dFt_d_tl);
             // resultant stiffness = k1/(k1+k2)
@@ -832,7 +895,7 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         }
 
         // Update fiber velocity
-        dlce = getPennationModel().calcFiberVelocity(cosphi, dml, dtl);
+        dlce = penMdl.calcFiberVelocity(cosphi, dml, dtl);
         dlceN = dlce / (vmax*ofl);
         // Update the force-velocity multiplier
         fv = calcfvInv(ma, fal, dlceN, aSolTolerance, 100);
@@ -888,8 +951,8 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
                 h = 0;
             }
 
-            if (lce < getMinimumFiberLength()) {
-                lce = getMinimumFiberLength();
+            if (lce < minLce) {
+                lce = minLce;
             }
 
             // Update the muscles's position level quantities (lengths, angles)
@@ -935,12 +998,12 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
     }
 
     // Fiber length is at or exceeds its lower bound.
-    if (lce <= getMinimumFiberLength()) {
+    if (lce <= minLce) {
 
-        lce = getMinimumFiberLength();
-        phi = getPennationModel().calcPennationAngle(lce);
+        lce = minLce;
+        phi = penMdl.calcPennationAngle(lce);
         cosphi = cos(phi);
-        tl  = getPennationModel().calcTendonLength(cosphi,lce,ml);
+        tl  = penMdl.calcTendonLength(cosphi,lce,ml);
         lceN = lce/ofl;
         tlN  = tl/tsl;
         fse = calcfse(tlN);
@@ -1406,6 +1469,13 @@ double Thelen2003Muscle::calcfal(const double lceN) const{
     double fal = exp(-x/kShapeActive);
     return fal;
 }
+void Thelen2003Muscle::calcfalAndDerivative(double lceN, double& fal,
+                                            double& dfal_d_lceN) const {
+    double kShapeActive = get_KshapeActive();
+    double t1 = lceN - 1.;
+    fal = exp(-t1*t1/kShapeActive);
+    dfal_d_lceN = -2.*t1/kShapeActive*fal;
+}
 double Thelen2003Muscle::calcDfalDlceN(const double lceN) const {
     double kShapeActive = get_KshapeActive();   
     double t1 = lceN - 0.10e1;
@@ -1449,6 +1519,21 @@ double Thelen2003Muscle::calcDfpeDlceN(const double lceN) const {
     return dfpe_d_lceN;
 }
 
+void Thelen2003Muscle::calcfpeAndDerivative(double lceN, double& fpe,
+                                            double& dfpe_d_lceN) const {
+    fpe = 0;
+    dfpe_d_lceN = 0;
+    double e0 = get_FmaxMuscleStrain();
+    double kpe = get_KshapePassive();
+
+    if(lceN > 1.0){
+        double t5 = exp(kpe * (lceN - 0.10e1) / e0);
+        double t7 = exp(kpe) - 0.10e1;
+        fpe = (t5 - 0.10e1) / t7;
+        dfpe_d_lceN = kpe / e0 * t5 / t7;
+    }
+}
+
 double Thelen2003Muscle::calcfpefisoPE(double lceN) const
 {
     double fmaxMuscleStrain = get_FmaxMuscleStrain();
@@ -1491,76 +1576,53 @@ double Thelen2003Muscle::calcfpefisoPE(double lceN) const
 //=============================================================================
 
 double Thelen2003Muscle::calcdlceN(double act,double fal,double actFalFv) const
+{
+    double dlceN, dlcedFm;
+    calcdlceNAndDerivative(act, fal, actFalFv, dlceN, dlcedFm);
+    return dlceN;
+}
+
+void Thelen2003Muscle::calcdlceNAndDerivative(double aAct, double aFal,
+        double aFalFv, double& dlceN, double& dlcedFm) const
 {
     //The variable names have all been switched to closely match 
     //with the notation in Thelen 2003.
-    double dlceN = 0.0;      //contractile element velocity    
     double af   = get_Af();
 
-    double a    = act;
-    double afl  = a*fal; //afl = a*fl
-    double Fm   = actFalFv;     //Fm = a*fl*fv    
+    double a    = aAct;
+    double afl  = a*aFal;   //afl = a*fl
+    double Fm   = aFalFv;   //Fm = a*fl*fv    
     double flen = get_Flen();
-    // double Fmlen_afl = flen*afl;
-
-    double dlcedFm = 0.0; //partial derivative of contractile element
-                          // velocity w.r.t. Fm
-
-    double b = 0;
-    double db= 0;
+    double va   = 0.25 + 0.75*a;
 
     double Fm_asyC = 0;           //Concentric contraction asymptote
-    double Fm_asyE = afl*flen;    
-                                //Eccentric contraction asymptote
+    double Fm_asyE = afl*flen;    //Eccentric contraction asymptote
     double asyE_thresh = get_fv_linear_extrap_threshold();
 
-    //If fv is in the appropriate region, use 
-    //Thelen 2003 Eqns 6 & 7 to compute dlceN
-    if (Fm > Fm_asyC && Fm < Fm_asyE*asyE_thresh){
-
-        if( Fm <= afl ){        //Muscle is concentrically contracting
-            b = afl + Fm/af;
-            db= 1/af;
-        }else{                    //Muscle is eccentrically contracting
-            b = ((2+2/af)*(afl*flen-Fm))/(flen-1); 
-            db= ((2+2/af)*(-1))/(flen-1); 
-        }
-
-        dlceN = (0.25 + 0.75*a)*(Fm-afl)/b; 
-        //Scaling by VMAX is left out, and is post multiplied outside 
-        //of the function
-
-
-    }else{  //Linear extrapolation
-            double Fm0 = 0.0; //Last Fm value from the Thelen curve
-
-            //Compute d and db/dFm from Eqn 7. of Thelen2003
-            //for the last
-            if(Fm <= Fm_asyC){ //Concentrically contracting
-                Fm0 = Fm_asyC;
-                b = afl + Fm0/af;
-                db= 1/af;               
-            }else{             //Eccentrically contracting
-                Fm0 = asyE_thresh*Fm_asyE;
-                b = ((2+2/af)*(afl*flen-Fm0))/(flen-1); 
-                db= ((2+2/af)*(-1))/(flen-1); 
-            }
-
-            //Compute the last dlceN value that falls in the region where
-            //Thelen 2003 Eqn. 6 is valid
-            double dlce0 = (0.25 + 0.75*a)*(Fm0-afl)/b;
-
-            //Compute the dlceN/dfm of Eqn. 6 of Thelen 2003 at the last
-            //valid point
-            dlcedFm = (0.25 + 0.75*a)*(1)/b 
-                    - ((0.25 + 0.75*a)*(Fm0-afl)/(b*b))*db;
+    //If fv is in the appropriate region, use Thelen 2003 Eqns 6 & 7 to
+    //compute dlceN; otherwise, extrapolate linearly from the last Fm0 value
+    //of the Thelen curve.
+    const bool onCurve = Fm > Fm_asyC && Fm < Fm_asyE*asyE_thresh;
+    const bool concentric = onCurve ? Fm <= afl : Fm <= Fm_asyC;
+    double Fm0 = Fm;
+    if (!onCurve)
+        Fm0 = concentric ? Fm_asyC : asyE_thresh*Fm_asyE;
+
+    //Compute b and db/dFm from Eqn 7. of Thelen2003
+    double b, db;
+    if (concentric) {       //Muscle is concentrically contracting
+        b = afl + Fm0/af;
+        db= 1/af;
+    } else {                //Muscle is eccentrically contracting
+        b = ((2+2/af)*(afl*flen-Fm0))/(flen-1); 
+        db= ((2+2/af)*(-1))/(flen-1); 
+    }
 
-            //Linearly extrapolate Eqn. 6 from Thelen 2003 to compute
-            //the new value for dlceN/dFm
-            dlceN = dlce0 + dlcedFm*(Fm-Fm0);            
-        }
-            
-        return dlceN;
+    //Eqn. 6 of Thelen 2003 and its derivative w.r.t. Fm at Fm0. Scaling by
+    //VMAX is left out, and is post multiplied outside of the function.
+    double dlce0 = va*(Fm0-afl)/b;
+    dlcedFm = va/b - (dlce0/b)*db;
+    dlceN = onCurve ? dlce0 : dlce0 + dlcedFm*(Fm-Fm0);
 }
 
 double Thelen2003Muscle::
@@ -1577,67 +1639,9 @@ double Thelen2003Muscle::
 double Thelen2003Muscle::calcDdlceDaFalFv(double aAct, 
                                           double aFal, double aFalFv) const
 {
-    //The variable names have all been switched to closely match with 
-    //the notation in Thelen 2003.
-    // double dlceN = 0.0;      //contractile element velocity    
-    double af   = get_Af();
-
-    double a    = aAct;
-    double afl  = aAct*aFal;  //afl = a*fl
-    double Fm   = aFalFv;    //Fm = a*fl*fv    
-    double flen = get_Flen();
-    // double Fmlen_afl = flen*aAct*aFal;
-
-    double dlcedFm = 0.0; //partial derivative of contractile element 
-                          //velocity w.r.t. Fm
-
-    double b = 0;
-    double db= 0;
-
-    double Fm_asyC = 0;           //Concentric contraction asymptote
-    double Fm_asyE = aAct*aFal*flen;    
-                                //Eccentric contraction asymptote
-    double asyE_thresh = get_fv_linear_extrap_threshold();
-
-    //If fv is in the appropriate region, use 
-    //Thelen 2003 Eqns 6 & 7 to compute dlceN
-    if (Fm > Fm_asyC && Fm < Fm_asyE*asyE_thresh){
-
-        if( Fm <= afl ){        //Muscle is concentrically contracting
-            b = afl + Fm/af;
-            db= 1/af;
-        }else{                    //Muscle is eccentrically contracting
-            b = ((2+2/af)*(afl*flen-Fm))/(flen-1); 
-            db= ((2+2/af)*(-1))/(flen-1); 
-        }
-
-        //This variable may have future use outside this function
-        dlcedFm = (0.25 + 0.75*a)*(1)/b - ((0.25 + 0.75*a)*(Fm-afl)/(b*b))*db;            
-
-    }else{  //Linear extrapolation
-            double Fm0 = 0.0; //Last Fm value from the Thelen curve
-
-            //Compute d and db/dFm from Eqn 7. of Thelen2003
-            //for the last
-            if(Fm <= Fm_asyC){ //Concentrically contracting
-                Fm0 = Fm_asyC;
-                b = afl + Fm0/af;
-                db= 1/af;               
-            }else{             //Eccentrically contracting
-                Fm0 = asyE_thresh*Fm_asyE;
-                b = ((2+2/af)*(afl*flen-Fm0))/(flen-1); 
-                db= ((2+2/af)*(-1))/(flen-1); 
-            }
-
-            
-            //Compute the dlceN/dfm of Eqn. 6 of Thelen 2003 at the last
-            //valid point
-            dlcedFm = (0.25 + 0.75*a)*(1)/b 
-                - ((0.25 + 0.75*a)*(Fm0-afl)/(b*b))*db;
-          
-        }
-            
-        return dlcedFm;
+    double dlceN, dlcedFm;
+    calcdlceNAndDerivative(aAct, aFal, aFalFv, dlceN, dlcedFm);
+    return dlcedFm;
 }
 
 // Compute the force-velocity multiplier by inverting Thelen 2003' f-v
@@ -1661,9 +1665,8 @@ double Thelen2003Muscle::
 
     while(abs(ferr) >= tolerance && iter < maxIterations)
     {
-        dlceN1 = calcdlceN(aAct,aFal, aFalFv);
+        calcdlceNAndDerivative(aAct, aFal, aFalFv, dlceN1, dlceN1_d_Fm);
         ferr   = dlceN1-dlceN;
-        dlceN1_d_Fm = calcDdlceDaFalFv(aAct,aFal,aFalFv);
 
 
         if(abs(dlceN1_d_Fm) > SimTK::SignificantReal){
@@ -38,8 +38,12 @@
     #endif
 #endif
 
+#include <vector>
+
 namespace OpenSim {
 
+class ForceSet;
+
 //==============================================================================
 //                               Thelen2003Muscle
 //==============================================================================
@@ -227,6 +231,21 @@ public:
         @throws MuscleCannotEquilibrate
     */
     void computeInitialFiberEquilibrium(SimTK::State& s) const override;
+
+    /** Compute the initial fiber equilibrium of each Thelen2003Muscle in
+        forces that applies force, as computeInitialFiberEquilibrium() does.
+        All the muscles are solved against the same (unchanged) State before
+        any of their fiber lengths is set, so that the cache of the State is
+        invalidated once rather than for each muscle.
+
+        @returns the number of Newton iterations taken by each
+                 Thelen2003Muscle of forces, in order; -1 for muscles that do
+                 not apply force.
+        @throws MuscleCannotEquilibrate for the first muscle that could not be
+                equilibrated, after the others have been.
+    */
+    static std::vector<int> computeInitialFiberEquilibria(
+            const ForceSet& forces, SimTK::State& s);
        
     ///@cond DEPRECATED
     /*  Once the ignore_tendon_compliance flag is implemented correctly get rid 
@@ -329,6 +348,20 @@ private:
                         const double aSolTolerance,
                         const int aMaxIterations) const;
 
+    // The initial equilibrium of the muscle in a State, as solved by
+    // initMuscleState() in solveInitialEquilibrium().
+    struct InitialEquilibrium {
+        double activation;
+        double tolerance;
+        std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState> result;
+    };
+    // s must be realized to Velocity. @throws MuscleCannotEquilibrate
+    InitialEquilibrium solveInitialEquilibrium(const SimTK::State& s) const;
+    // Set the fiber length and actuation of the solved equilibrium in s.
+    // @throws MuscleCannotEquilibrate if the solver did not converge.
+    void setInitialEquilibrium(SimTK::State& s,
+                               const InitialEquilibrium& equilibrium) const;
+
     double calcFm(double ma, double fal, double fv, 
                  double fpe, double fiso) const;
 
@@ -356,10 +389,15 @@ private:
     //Active force length functions
     double calcfal( double lceN) const;
     double calcDfalDlceN( double lceN) const;
+    // The multiplier and its derivative, sharing one exponential.
+    void calcfalAndDerivative(double lceN, double& fal,
+                              double& dfal_d_lceN) const;
 
     //Parallel element functions    
     double calcfpe(double lceN) const;
     double calcDfpeDlceN(double lceN) const;
+    void calcfpeAndDerivative(double lceN, double& fpe,
+                              double& dfpe_d_lceN) const;
     double calcfpefisoPE(double lceN) const;    
 
     //Force velocity functions      
@@ -370,6 +408,10 @@ private:
                             double tolerance, int maxIterations) const;
     double calcDdlceDaFalFv(double aAct, double fal, 
                             double aFalFv) const;
+    // calcdlceN() and calcDdlceDaFalFv() together, with one evaluation of
+    // the branches of the force-velocity curve.
+    void calcdlceNAndDerivative(double aAct, double aFal, double aFalFv,
+                                double& dlceN, double& ddlceN_dFm) const;
 
     //Returns true if the fiber state is currently clamped to prevent the 
     //fiber from attaining a length that is too short.
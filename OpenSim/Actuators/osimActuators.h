@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "CoordinateActuator.h"
+#include "CoordinateActuatorGroup.h"
 #include "PointActuator.h"
 #include "TorqueActuator.h"
 #include "BodyActuator.h"
@@ -37,6 +38,7 @@
 #include "Thelen2003Muscle.h"
 #include "RigidTendonMuscle.h"
 #include "Millard2012EquilibriumMuscle.h"
+#include "Millard2012EquilibriumMuscleBatch.h"
 #include "Millard2012AccelerationMuscle.h"
 
 #include "McKibbenActuator.h"
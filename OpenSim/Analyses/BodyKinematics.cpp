@@ -59,7 +59,8 @@ BodyKinematics::~BodyKinematics()
 BodyKinematics::BodyKinematics(Model *aModel, bool aInDegrees) :
     Analysis(aModel),
     _bodies(_bodiesProp.getValueStrArray()),
-    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool())
+    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool()),
+    _recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
      setNull();
 
@@ -81,7 +82,8 @@ BodyKinematics::BodyKinematics(Model *aModel, bool aInDegrees) :
 BodyKinematics::BodyKinematics(const std::string &aFileName):
     Analysis(aFileName, false),
     _bodies(_bodiesProp.getValueStrArray()),
-    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool())
+    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool()),
+    _recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
     setNull();
 
@@ -99,7 +101,8 @@ BodyKinematics::BodyKinematics(const std::string &aFileName):
 BodyKinematics::BodyKinematics(const BodyKinematics &aBodyKinematics):
     Analysis(aBodyKinematics),
     _bodies(_bodiesProp.getValueStrArray()),
-    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool())
+    _expressInLocalFrame(_expressInLocalFrameProp.getValueBool()),
+    _recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
     setNull();
     // COPY TYPE AND NAME
@@ -125,6 +128,7 @@ operator=(const BodyKinematics &aBodyKinematics)
     Analysis::operator=(aBodyKinematics);
     _bodies = aBodyKinematics._bodies;
     _expressInLocalFrame = aBodyKinematics._expressInLocalFrame;
+    _recordAccelerations = aBodyKinematics._recordAccelerations;
     return(*this);
 }
 
@@ -169,6 +173,14 @@ setupProperties()
         "This flag is set to false by default.");
     _expressInLocalFrameProp.setValue(false);
     _propertySet.append(&_expressInLocalFrameProp);
+
+    _recordAccelerationsProp.setName("record_accelerations");
+    _recordAccelerationsProp.setComment("Flag (true or false) indicating whether"
+        " to record accelerations. If false, only positions and velocities are"
+        " recorded, and the states need not be realized to accelerations. "
+        "This flag is set to true by default.");
+    _recordAccelerationsProp.setValue(true);
+    _propertySet.append(&_recordAccelerationsProp);
 }
 
 //=============================================================================
@@ -287,6 +299,8 @@ updateBodiesToRecord()
     if(!_model) {
         _bodyIndices.setSize(0);
         _kin.setSize(0);
+        _vKin.setSize(0);
+        _aKin.setSize(0);
         return;
     }
 
@@ -310,6 +324,8 @@ updateBodiesToRecord()
         _bodyIndices.append(index);
     }
     _kin.setSize(6*_bodyIndices.getSize()+(_recordCenterOfMass?3:0));
+    _vKin.setSize(_kin.getSize());
+    _aKin.setSize(_kin.getSize());
 
     if(_kin.getSize()==0) cout << "WARNING: BodyKinematics analysis has no bodies to record kinematics for" << endl;
 }
@@ -436,154 +452,91 @@ getExpressResultsInLocalFrame()
 int BodyKinematics::
 record(const SimTK::State& s)
 {
+    // Realize to Acceleration first if we'll ask for Accelerations
+    _model->getMultibodySystem().realize(s, _recordAccelerations ?
+            SimTK::Stage::Acceleration : SimTK::Stage::Velocity);
 
-    // Realize to Acceleration first since we'll ask for Accelerations 
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
-    // VARIABLES
-    SimTK::Vec3 vec,angVec;
-    double Mass = 0.0;
-
-    // GROUND BODY
-    const Ground &ground = _model->getGround();
-
-    // POSITION
-    BodySet& bs = _model->updBodySet();
+    // The kinematics of all bodies are read from the MobilizedBodies of the
+    // realized State, in one pass, into the rows of positions, velocities
+    // and accelerations.
+    SimTK::Vec3 pos, vel, acc;
+    const BodySet& bs = _model->getBodySet();
+    const double toDegrees = getInDegrees() ? SimTK_RADIAN_TO_DEGREE : 1.0;
 
     for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
+        const Body& body = bs.get(_bodyIndices[i]);
+        const SimTK::MobilizedBody& mobod = body.getMobilizedBody();
+        const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
         const SimTK::Vec3& com = body.get_mass_center();
-        // GET POSITIONS AND EULER ANGLES
-        vec = body.findStationLocationInGround(s, com);
-        angVec = body.getTransformInGround(s).R().convertRotationToBodyFixedXYZ();
-
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I=6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-    }
-
-    if(_recordCenterOfMass) {
-        double rP[3] = { 0.0, 0.0, 0.0 };
-        for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationLocationInGround(s, com);
-            // ADD TO WHOLE BODY MASS
-            Mass += body.get_mass();
-            rP[0] += body.get_mass() * vec[0];
-            rP[1] += body.get_mass() * vec[1];
-            rP[2] += body.get_mass() * vec[2];
-        }
-
-        //COMPUTE COM OF WHOLE BODY AND ADD TO ARRAY
-        rP[0] /= Mass;
-        rP[1] /= Mass;
-        rP[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rP,3*sizeof(double));
-    }
-    
-    _pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
-
-    // VELOCITY
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
-        // GET VELOCITIES AND ANGULAR VELOCITIES
-        vec = body.findStationVelocityInGround(s, com);
-        angVec = body.getVelocityInGround(s)[0];
-        if (_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
-        }
-
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-    }
 
-    if(_recordCenterOfMass) {
-        double rV[3] = { 0.0, 0.0, 0.0 };
-        for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationVelocityInGround(s, com);
-            rV[0] += body.get_mass() * vec[0];
-            rV[1] += body.get_mass() * vec[1];
-            rV[2] += body.get_mass() * vec[2];
+        // Positions and Euler angles are always in ground.
+        SimTK::Vec3 angles = toDegrees*R_GB.convertRotationToBodyFixedXYZ();
+        SimTK::Vec3 angVel = mobod.getBodyAngularVelocity(s);
+        SimTK::Vec3 angAcc;
+        if(_recordAccelerations) {
+            mobod.findStationLocationVelocityAndAccelerationInGround(s, com,
+                    pos, vel, acc);
+            angAcc = mobod.getBodyAngularAcceleration(s);
         }
+        else
+            mobod.findStationLocationAndVelocityInGround(s, com, pos, vel);
 
-        //COMPUTE VELOCITY OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rV[0] /= Mass;
-        rV[1] /= Mass;
-        rV[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rV,3*sizeof(double));
-    }
-
-    _vStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
-
-    // ACCELERATIONS
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
-
-        // GET ACCELERATIONS AND ANGULAR ACCELERATIONS
-        vec = body.findStationAccelerationInGround(s, com);
-        angVec = body.getAccelerationInGround(s)[0];
         if(_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
+            vel = ~R_GB*vel;
+            angVel = ~R_GB*angVel;
+            if(_recordAccelerations) {
+                acc = ~R_GB*acc;
+                angAcc = ~R_GB*angAcc;
+            }
         }
 
-        // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
-
-        // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+        // FILL KINEMATICS ARRAYS
+        int I=6*i;
+        memcpy(&_kin[I],&pos[0],3*sizeof(double));
+        memcpy(&_kin[I+3],&angles[0],3*sizeof(double));
+        angVel *= toDegrees;
+        memcpy(&_vKin[I],&vel[0],3*sizeof(double));
+        memcpy(&_vKin[I+3],&angVel[0],3*sizeof(double));
+        if(_recordAccelerations) {
+            angAcc *= toDegrees;
+            memcpy(&_aKin[I],&acc[0],3*sizeof(double));
+            memcpy(&_aKin[I+3],&angAcc[0],3*sizeof(double));
+        }
     }
 
     if(_recordCenterOfMass) {
-        double rA[3] = { 0.0, 0.0, 0.0 };
+        // COMPUTE KINEMATICS OF COM OF WHOLE BODY AND ADD TO ARRAYS
+        double Mass = 0.0;
+        SimTK::Vec3 rP(0), rV(0), rA(0);
         for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationAccelerationInGround(s, com);
-            rA[0] += body.get_mass() * vec[0];
-            rA[1] += body.get_mass() * vec[1];
-            rA[2] += body.get_mass() * vec[2];
+            const Body& body = bs.get(i);
+            const SimTK::MobilizedBody& mobod = body.getMobilizedBody();
+            const double mass = body.get_mass();
+            if(_recordAccelerations) {
+                mobod.findStationLocationVelocityAndAccelerationInGround(s,
+                        body.get_mass_center(), pos, vel, acc);
+                rA += mass*acc;
+            }
+            else
+                mobod.findStationLocationAndVelocityInGround(s,
+                        body.get_mass_center(), pos, vel);
+            Mass += mass;
+            rP += mass*pos;
+            rV += mass*vel;
         }
-
-        //COMPUTE ACCELERATION OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rA[0] /= Mass;
-        rA[1] /= Mass;
-        rA[2] /= Mass;
+        rP /= Mass;
+        rV /= Mass;
+        rA /= Mass;
         int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rA,3*sizeof(double));
+        memcpy(&_kin[I],&rP[0],3*sizeof(double));
+        memcpy(&_vKin[I],&rV[0],3*sizeof(double));
+        memcpy(&_aKin[I],&rA[0],3*sizeof(double));
     }
 
-    _aStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
+    _pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
+    _vStore->append(s.getTime(),_vKin.getSize(),&_vKin[0]);
+    if(_recordAccelerations)
+        _aStore->append(s.getTime(),_aKin.getSize(),&_aKin[0]);
 
     //printf("BodyKinematics:\taT:\t%.16f\trA[1]:\t%.16f\n",s.getTime(),rA[1]);
     return(0);
@@ -670,6 +623,21 @@ end(const SimTK::State&s )
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Get the storages of the results. The list is rebuilt on each call, since
+ * the storages are reallocated when the model is set.
+ */
+ArrayPtrs<Storage>& BodyKinematics::
+getStorageList()
+{
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
+    return _storageList;
+}
 
 
 
@@ -701,7 +669,8 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     else suffix = "_global";
 
     // ACCELERATIONS
-    Storage::printResult(_aStore,aBaseName+"_"+getName()+"_acc"+suffix,aDir,aDT,aExtension);
+    if(_recordAccelerations)
+        Storage::printResult(_aStore,aBaseName+"_"+getName()+"_acc"+suffix,aDir,aDT,aExtension);
 
     // VELOCITIES
     Storage::printResult(_vStore,aBaseName+"_"+getName()+"_vel"+suffix,aDir,aDT,aExtension);
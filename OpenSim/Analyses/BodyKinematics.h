@@ -63,9 +63,17 @@ protected:
     PropertyBool _expressInLocalFrameProp;
     bool &_expressInLocalFrame;
 
+    /** Flag indicating whether or not to record accelerations. If not, the
+    State need only be realized to Stage::Velocity. */
+    PropertyBool _recordAccelerationsProp;
+    bool &_recordAccelerations;
+
     Array<int> _bodyIndices;
     bool _recordCenterOfMass;
+    // The rows of positions, velocities and accelerations being recorded.
     Array<double> _kin;
+    Array<double> _vKin;
+    Array<double> _aKin;
 
     Storage *_pStore;
     Storage *_vStore;
@@ -107,6 +115,11 @@ public:
     Storage* getPositionStorage();
     void setExpressResultsInLocalFrame(bool aTrueFalse);
     bool getExpressResultsInLocalFrame();
+    /** Whether to record accelerations (default: true). If false, the
+    acceleration storage stays empty and is not printed. */
+    void setRecordAccelerations(bool aTrueFalse)
+    {   _recordAccelerations = aTrueFalse; }
+    bool getRecordAccelerations() const { return _recordAccelerations; }
 
     void setRecordCenterOfMass(bool aTrueFalse) {_recordCenterOfMass = aTrueFalse;}
     void setBodiesToRecord(Array<std::string> &listOfBodies) {_bodies = listOfBodies;}
@@ -122,6 +135,11 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** Each frame is recorded independently of the others. */
+    bool isFrameIndependent() const override { return true; }
+    bool canStepConcurrently() const override { return true; }
+    /** The storages of the results. */
+    ArrayPtrs<Storage>& getStorageList() override;
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -51,6 +51,7 @@ ForceReporter::~ForceReporter()
 ForceReporter::ForceReporter(Model *aModel) :   
     Analysis(aModel),
     _includeConstraintForces(_includeConstraintForcesProp.getValueBool()),
+    _useCachedForces(_useCachedForcesProp.getValueBool()),
     _forceStore(1000,"ModelForces")
 {
     // NULL
@@ -75,6 +76,7 @@ ForceReporter::ForceReporter(Model *aModel) :
 ForceReporter::ForceReporter(const std::string &aFileName): 
     Analysis(aFileName, false),
     _includeConstraintForces(_includeConstraintForcesProp.getValueBool()),
+    _useCachedForces(_useCachedForcesProp.getValueBool()),
     _forceStore(1000,"ModelForces")
 {
     setNull();
@@ -98,6 +100,7 @@ ForceReporter::ForceReporter(const std::string &aFileName):
 ForceReporter::ForceReporter(const ForceReporter &aForceReporter):
     Analysis(aForceReporter),
     _includeConstraintForces(_includeConstraintForcesProp.getValueBool()),
+    _useCachedForces(_useCachedForcesProp.getValueBool()),
     _forceStore(aForceReporter._forceStore)
 {
     setNull();
@@ -123,6 +126,14 @@ void ForceReporter::setNull()
     _includeConstraintForcesProp.setName("include_constraint_forces");
     _includeConstraintForcesProp.setValue(false);
     _propertySet.append( &_includeConstraintForcesProp );
+
+    _useCachedForcesProp.setComment("Flag (true or false) indicating whether "
+        "to read the forces cached when the model is realized to Dynamics "
+        "into a preallocated row, rather than collecting an array of values "
+        "from each force at every step.");
+    _useCachedForcesProp.setName("use_cached_forces");
+    _useCachedForcesProp.setValue(true);
+    _propertySet.append( &_useCachedForcesProp );
 }
 
 
@@ -139,6 +150,13 @@ ForceReporter& ForceReporter::operator=(const ForceReporter &aForceReporter)
     allocateStorage();
 
     _includeConstraintForces = aForceReporter._includeConstraintForces;
+    _useCachedForces = aForceReporter._useCachedForces;
+
+    // The recorded forces belong to the model of aForceReporter; they are
+    // found again by begin().
+    _recordedForces.clear();
+    _recordedConstraints.clear();
+    _numRecordValues.clear();
 
     return (*this);
 }
@@ -207,6 +225,9 @@ void ForceReporter::constructColumnLabels(const SimTK::State& s)
         // ASSIGN
         Array<string> columnLabels;
         columnLabels.append("time");
+        _recordedForces.clear();
+        _recordedConstraints.clear();
+        _numRecordValues.clear();
         
         auto forces = _model->getComponentList<Force>();
 
@@ -217,6 +238,8 @@ void ForceReporter::constructColumnLabels(const SimTK::State& s)
             Array<string> forceLabels = force.getRecordLabels();
             // If prescribed force we need to record point, 
             columnLabels.append(forceLabels);
+            _recordedForces.push_back(&force);
+            _numRecordValues.push_back(forceLabels.getSize());
         }
 
         if(_includeConstraintForces){
@@ -228,9 +251,12 @@ void ForceReporter::constructColumnLabels(const SimTK::State& s)
                 Array<string> forceLabels = c.getRecordLabels();
                 // If prescribed force we need to record point, 
                 columnLabels.append(forceLabels);
+                _recordedConstraints.push_back(&c);
+                _numRecordValues.push_back(forceLabels.getSize());
             }
         }
         _forceStore.setColumnLabels(columnLabels);
+        _forceValues.setSize(columnLabels.getSize() - 1);
     }
 }
 
@@ -261,6 +287,31 @@ int ForceReporter::record(const SimTK::State& s)
     // MAKE SURE ALL ForceReporter QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Dynamics );
 
+    if (_useCachedForces) {
+        // Fill the row preallocated by begin(), in the order of its labels.
+        int column = 0;
+        int next = 0;
+        for (const Force* force : _recordedForces) {
+            const int n = _numRecordValues[next++];
+            if (force->appliesForce(s))
+                force->copyRecordValues(s, &_forceValues[column]);
+            else
+                for (int i = 0; i < n; ++i) _forceValues[column + i] = 0;
+            column += n;
+        }
+        for (const Constraint* constraint : _recordedConstraints) {
+            const int n = _numRecordValues[next++];
+            Array<double> values(0.0, n);
+            if (constraint->isEnforced(s))
+                values = constraint->getRecordValues(s);
+            for (int i = 0; i < n; ++i) _forceValues[column + i] = values[i];
+            column += n;
+        }
+        _forceStore.append(s.getTime(), _forceValues.getSize(),
+                           _forceValues.get());
+        return(0);
+    }
+
     StateVector nextRow(s.getTime());
 
     // Model Forces
@@ -30,6 +30,8 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 #ifdef SWIG
     #ifdef OSIMANALYSES_API
         #undef OSIMANALYSES_API
@@ -40,6 +42,9 @@
 //=============================================================================
 namespace OpenSim { 
 
+class Constraint;
+class Force;
+
 /**
  * A class for recording the Forces applied to a model
  * during a simulation.
@@ -61,9 +66,24 @@ protected:
     PropertyBool _includeConstraintForcesProp;
     bool &_includeConstraintForces;
 
+    /** Read the values of the forces cached when the model is realized to
+    Dynamics into a row preallocated by begin(), rather than collecting an
+    Array of values from each force at every step? */
+    PropertyBool _useCachedForcesProp;
+    bool &_useCachedForces;
+
     /** Force storage. */
     Storage _forceStore;
 
+private:
+    /** The forces and constraints recorded, and the number of values of
+    each, as found by begin(). */
+    std::vector<const Force*> _recordedForces;
+    std::vector<const Constraint*> _recordedConstraints;
+    std::vector<int> _numRecordValues;
+    /** The row of values recorded at each step. */
+    Array<double> _forceValues;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -114,10 +134,17 @@ public:
     // ANALYSIS
     //--------------------------------------------------------------------------
     void includeConstraintForces(bool flag) {_includeConstraintForces = flag;}
+    /** Whether to read the forces cached when the model is realized to
+    Dynamics into a preallocated row (default: true). A force that is
+    disabled after begin() is then recorded as zeros, rather than dropped
+    from the row. */
+    void setUseCachedForces(bool flag) {_useCachedForces = flag;}
+    bool getUseCachedForces() const {return _useCachedForces;}
 
     int begin(const SimTK::State& s ) override;
     int step(const SimTK::State& s, int setNumber ) override;
     int end(const SimTK::State& s ) override;
+    bool canStepConcurrently() const override { return true; }
 
 protected:
     virtual int
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
 #include "InducedAccelerations.h"
+#include "InducedAccelerationsSolver.h"
 
 using namespace OpenSim;
 using namespace std;
@@ -537,9 +538,75 @@ int InducedAccelerations::record(const SimTK::State& s)
     // DO NOT recreate the system, will lose location of constraint
     _model->initStateWithoutRecreatingSystem(s_analysis);
 
+    // The contributors that are actuators, whose induced accelerations are
+    // solved for together, unless the constraint reactions are reported
+    // (which requires realizing the model for each actuator).
+    std::vector<const ScalarActuator*> actuators;
+    std::vector<int> actuatorIndex(_contributors.getSize(), -1);
+    if(!_reportConstraintReactions){
+        for(int c=0; c<_contributors.getSize(); c++){
+            if(_contributors[c] == "total" || _contributors[c] == "gravity" ||
+               _contributors[c] == "velocity") continue;
+            int ai = _model->getActuators().getIndex(_contributors[c]);
+            if(ai<0) continue;
+            const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(
+                    &_model->getActuators().get(ai));
+            if(act){
+                actuatorIndex[c] = int(actuators.size());
+                actuators.push_back(act);
+            }
+        }
+    }
+    SimTK::State s_actuators;
+    SimTK::Matrix actuatorUDots;
+    std::vector<bool> computed;
+
     // Cycle through the force contributors to the system acceleration
     for(int c=0; c< _contributors.getSize(); c++){          
         //cout << "Solving for contributor: " << _contributors[c] << endl;
+        const int j = actuatorIndex[c];
+        if(j == 0){
+            // Set up the state as for each actuator below, but with no
+            // actuator applying force, once any "total" contributor has
+            // updated the constraints.
+            s_actuators = s_analysis;
+            _model->getMultibodySystem().realize(s_actuators, SimTK::Stage::Dynamics);
+            _model->updForceSubsystem().setForceIsDisabled(s_actuators, _model->getGravityForce().getForceIndex(), true);
+            for(int f=0; f<_model->getActuators().getSize(); f++){
+                _model->updActuators().get(f).setAppliesForce(s_actuators,
+                                                              false);
+            }
+            s_actuators.setTime(aT);
+            s_actuators.setQ(Q);
+            s_actuators.setU(SimTK::Vector(nu,0.0));
+            s_actuators.setZ(s.getZ());
+
+            // The actuation of each actuator when it alone applies force.
+            SimTK::State s_actuated = s_actuators;
+            for(const ScalarActuator* act : actuators){
+                act->setAppliesForce(s_actuated, true);
+                act->overrideActuation(s_actuated, false);
+            }
+            _model->getMultibodySystem().realize(s_actuated, SimTK::Stage::Dynamics);
+            SimTK::Vector actuations(int(actuators.size()));
+            for(int k=0; k<int(actuators.size()); k++){
+                const bool muscle =
+                        dynamic_cast<const Muscle*>(actuators[k]) != nullptr;
+                actuations[k] = (muscle && _computePotentialsOnly) ? 1.0 :
+                        actuators[k]->getActuation(s_actuated);
+            }
+
+            _model->getMultibodySystem().realize(s_actuators, SimTK::Stage::Model);
+            _model->getMultibodySystem().realize(s_actuators, SimTK::Stage::Acceleration);
+            InducedAccelerationsSolver::calcInducedAccelerationsOfActuators(
+                    *_model, s_actuators, actuators, actuations,
+                    actuatorUDots, computed);
+        }
+        if(j >= 0 && computed[j]){
+            appendInducedAccelerations(s_actuators, actuatorUDots(j));
+            continue;
+        }
+
         // Need to be at the dynamics stage to disable a force
         _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
         
@@ -792,6 +859,57 @@ int InducedAccelerations::record(const SimTK::State& s)
     return(0);
 }
 
+void InducedAccelerations::appendInducedAccelerations(const SimTK::State& s,
+        const SimTK::Vector& udot)
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+    matter.calcBodyAccelerationFromUDot(s, udot, A_GB);
+
+    // The speeds are zero, so a station's acceleration has no centripetal
+    // term.
+    for(int i=0;i<_coordSet.getSize();i++) {
+        const Coordinate& coord = _coordSet.get(i);
+        const SimTK::MobilizedBody& mobod =
+                matter.getMobilizedBody(coord.getBodyIndex());
+        double acc = udot[mobod.getFirstUIndex(s) + coord.getMobilizerQIndex()];
+
+        if(getInDegrees()) 
+            acc *= SimTK_RADIAN_TO_DEGREE;  
+        _coordIndAccs[i]->append(1, &acc);
+    }
+
+    for(int i=0;i<_bodySet.getSize();i++) {
+        const Body &body = _bodySet.get(i);
+        const SimTK::SpatialVec& A = A_GB[body.getMobilizedBodyIndex()];
+        const SimTK::Vec3 com_G = body.getTransformInGround(s).R()*
+                                  body.get_mass_center();
+        SimTK::Vec3 vec = A[1] + A[0] % com_G;
+        SimTK::Vec3 angVec = A[0];
+
+        if(getInDegrees()) 
+            angVec *= SimTK_RADIAN_TO_DEGREE;   
+
+        _bodyIndAccs[i]->append(3, &vec[0]);
+        _bodyIndAccs[i]->append(3, &angVec[0]);
+    }
+
+    if(_includeCOM){
+        SimTK::Vec3 vec(0);
+        double mass = 0;
+        for(SimTK::MobilizedBodyIndex b(1); b<matter.getNumBodies(); ++b) {
+            const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(b);
+            const double m = mobod.getBodyMass(s);
+            const SimTK::Vec3 com_G = mobod.getBodyRotation(s)*
+                                      mobod.getBodyMassCenterStation(s);
+            vec += m*(A_GB[b][1] + A_GB[b][0] % com_G);
+            mass += m;
+        }
+        if(mass > 0) vec /= mass;
+        _comIndAccs.append(3, &vec[0]);
+    }
+}
+
 /**
  * This method is called at the beginning of an analysis so that any
  * necessary initializations may be performed.
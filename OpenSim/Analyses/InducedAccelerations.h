@@ -208,6 +208,11 @@ public:
 protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s);
+    /** Append the accelerations of the coordinates, bodies and center of mass
+        for the generalized accelerations (udot) of a contributor, at a state
+        with zero generalized speeds, to the work arrays. */
+    void appendInducedAccelerations(const SimTK::State& s,
+                                    const SimTK::Vector& udot);
     void constructDescription();
     void assembleContributors();
     Array<std::string> constructColumnLabelsForCoordinate();
@@ -27,6 +27,9 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
 #include "InducedAccelerationsSolver.h"
+#include <simmath/LinearAlgebra.h>
+
+#include <algorithm>
 
 using namespace OpenSim;
 using namespace std;
@@ -70,31 +73,9 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
                 SimTK::Vector_<SimTK::SpatialVec>* constraintReactions)
 {
     int nu = _modelCopy.getNumSpeeds();
-    double aT = s.getTime();
-
-    SimTK::State& s_solver = _modelCopy.updWorkingState();
-
-    //_modelCopy.initStateWithoutRecreatingSystem(s_solver);
-    // Just need to set current time and kinematics to determine state of constraints
-    s_solver.setTime(aT);
-    s_solver.updQ()=s.getQ();
-    s_solver.updU()=s.getU();
-
-    // Check the external forces and determine if contact constraints should be applied at this time
-    // and turn constraint on if it should be.
-    Array<bool> constraintOn = applyContactConstraintAccordingToExternalForces(s_solver);
-
-    // Hang on to a state that has the right flags for contact constraints turned on/off
-    _modelCopy.setPropertiesFromState(s_solver);
-    // Use this state for the remainder of this step (record)
-    s_solver = _modelCopy.getMultibodySystem().realizeTopology();
-    // DO NOT recreate the system, will lose location of constraint
-    _modelCopy.initStateWithoutRecreatingSystem(s_solver);
 
-    //cout << "Solving for contributor: " << _contributors[c] << endl;
-    // Need to be at the dynamics stage to disable a force
-    s_solver.setTime(aT);
-    _modelCopy.getMultibodySystem().realize(s_solver, SimTK::Stage::Dynamics);
+    Array<bool> constraintOn;
+    SimTK::State& s_solver = setUpConstrainedState(s, constraintOn);
         
     if(forceName == "total"){
         // Set gravity ON
@@ -254,6 +235,182 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
     return s_solver.getUDot();
 }
 
+SimTK::State& InducedAccelerationsSolver::
+    setUpConstrainedState(const SimTK::State& s, Array<bool>& constraintOn)
+{
+    double aT = s.getTime();
+
+    SimTK::State& s_solver = _modelCopy.updWorkingState();
+
+    //_modelCopy.initStateWithoutRecreatingSystem(s_solver);
+    // Just need to set current time and kinematics to determine state of constraints
+    s_solver.setTime(aT);
+    s_solver.updQ()=s.getQ();
+    s_solver.updU()=s.getU();
+
+    // Check the external forces and determine if contact constraints should be applied at this time
+    // and turn constraint on if it should be.
+    constraintOn = applyContactConstraintAccordingToExternalForces(s_solver);
+
+    // Hang on to a state that has the right flags for contact constraints turned on/off
+    _modelCopy.setPropertiesFromState(s_solver);
+    // Use this state for the remainder of this step (record)
+    s_solver = _modelCopy.getMultibodySystem().realizeTopology();
+    // DO NOT recreate the system, will lose location of constraint
+    _modelCopy.initStateWithoutRecreatingSystem(s_solver);
+
+    // Need to be at the dynamics stage to disable a force
+    s_solver.setTime(aT);
+    _modelCopy.getMultibodySystem().realize(s_solver, SimTK::Stage::Dynamics);
+    return s_solver;
+}
+
+
+/* Solve for the induced accelerations of several contributors, solving for
+   the actuators that provide their forces per unit actuation together. */
+const SimTK::Matrix& InducedAccelerationsSolver::solve(const SimTK::State& s,
+                const std::vector<std::string>& forceNames,
+                bool computeActuatorPotentialOnly)
+{
+    const int nc = int(forceNames.size());
+    _inducedUDots.resize(s.getNU(), nc);
+
+    // The contributors that are actuators.
+    std::vector<const ScalarActuator*> actuators;
+    std::vector<int> actuatorColumns;
+    for(int c=0; c<nc; c++){
+        const string& name = forceNames[c];
+        if(name == "total" || name == "gravity" || name == "velocity")
+            continue;
+        int ai = _modelCopy.getForceSet().getIndex(name);
+        if(ai < 0) continue;
+        const ScalarActuator* actuator =
+            dynamic_cast<const ScalarActuator*>(&_modelCopy.getForceSet()[ai]);
+        if(actuator){
+            actuators.push_back(actuator);
+            actuatorColumns.push_back(c);
+        }
+    }
+
+    SimTK::Matrix udots;
+    std::vector<bool> computed(actuators.size(), false);
+    for(int c=0; c<nc; c++){
+        const int j = int(std::find(actuatorColumns.begin(),
+                                    actuatorColumns.end(), c)
+                          - actuatorColumns.begin());
+        // Solve for the actuators at the first of them, once any preceding
+        // "total" contributor has updated the constraints.
+        if(j == 0 && !actuatorColumns.empty()){
+            // Set up the constrained system with no actuator applying force,
+            // as for each actuator contributor.
+            Array<bool> constraintOn;
+            SimTK::State& s_solver = setUpConstrainedState(s, constraintOn);
+            _modelCopy.updForceSubsystem().setForceIsDisabled(s_solver,
+                _modelCopy.getGravityForce().getForceIndex(), true);
+            for(int f=0; f<_modelCopy.getActuators().getSize(); f++){
+                _modelCopy.updActuators().get(f).setAppliesForce(s_solver,
+                                                                 false);
+            }
+            s_solver.setU(SimTK::Vector(s_solver.getNU(), 0.0));
+            s_solver.updZ() = s.getZ();
+
+            // The actuations, with each actuator applying force.
+            SimTK::Vector actuations(int(actuators.size()), 1.0);
+            if(!computeActuatorPotentialOnly){
+                SimTK::State s_actuated = s_solver;
+                for(const ScalarActuator* actuator : actuators)
+                    actuator->setAppliesForce(s_actuated, true);
+                _modelCopy.getMultibodySystem().realize(s_actuated,
+                                                        SimTK::Stage::Dynamics);
+                for(int k=0; k<int(actuators.size()); k++)
+                    actuations[k] = actuators[k]->getActuation(s_actuated);
+            }
+
+            _modelCopy.getMultibodySystem().realize(s_solver,
+                                                    SimTK::Stage::Model);
+            _modelCopy.getMultibodySystem().realize(s_solver,
+                                                    SimTK::Stage::Acceleration);
+            calcInducedAccelerationsOfActuators(_modelCopy, s_solver,
+                actuators, actuations, udots, computed);
+        }
+        if(j < int(actuatorColumns.size()) && computed[j]){
+            _inducedUDots(c) = udots(j);
+        } else {
+            _inducedUDots(c) = solve(s, forceNames[c],
+                                     computeActuatorPotentialOnly);
+        }
+    }
+    return _inducedUDots;
+}
+
+bool InducedAccelerationsSolver::solveConstrainedSystem(
+        const SimTK::SimbodyMatterSubsystem& matter, const SimTK::State& s,
+        const SimTK::Matrix& generalizedForces, SimTK::Matrix& udots)
+{
+    // With constraints, the multipliers follow from the Schur complement
+    // G M^-1 ~G, so that udot = M^-1 f - M^-1 ~G (G M^-1 ~G)^-1 G M^-1 f.
+    try {
+        SimTK::Matrix M;
+        matter.calcM(s, M);
+        SimTK::FactorLU luM(M);
+        if(luM.isSingular()) return false;
+        luM.solve(generalizedForces, udots);
+        if(s.getNMultipliers() == 0) return true;
+
+        SimTK::Matrix G, MInvGT;
+        matter.calcG(s, G);
+        luM.solve(SimTK::Matrix(~G), MInvGT);
+        SimTK::FactorLU luS(G*MInvGT);
+        if(luS.isSingular()) return false;
+        SimTK::Matrix multipliers;
+        luS.solve(G*udots, multipliers);
+        udots -= MInvGT*multipliers;
+    } catch (const SimTK::Exception::Base&) {
+        return false;
+    }
+    return true;
+}
+
+bool InducedAccelerationsSolver::calcInducedAccelerationsOfActuators(
+        const Model& model, const SimTK::State& s,
+        const std::vector<const ScalarActuator*>& actuators,
+        const SimTK::Vector& actuations,
+        SimTK::Matrix& udots, std::vector<bool>& computed)
+{
+    const int na = int(actuators.size());
+    const int nu = s.getNU();
+    computed.assign(na, false);
+
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    SimTK::Vector mobilityForces(nu), generalizedForces(nu);
+    SimTK::Matrix forces(nu, na, 0.0);
+    bool any = false;
+    for(int j=0; j<na; j++){
+        bodyForces.setToZero();
+        mobilityForces.setToZero();
+        if(!actuators[j]->addInForcesPerUnitActuation(s, bodyForces,
+                                                      mobilityForces))
+            continue;
+        matter.multiplyBySystemJacobianTranspose(s, bodyForces,
+                                                 generalizedForces);
+        generalizedForces += mobilityForces;
+        forces(j) = actuations[j]*generalizedForces;
+        computed[j] = any = true;
+    }
+    if(!any || !solveConstrainedSystem(matter, s, forces, udots)){
+        computed.assign(na, false);
+        return false;
+    }
+
+    // The accelerations are linear in the forces, so each actuator adds its
+    // own to those of the remaining forces.
+    for(int j=0; j<na; j++){
+        if(computed[j]) udots(j) += s.getUDot();
+    }
+    return true;
+}
+
 const SimTK::State& InducedAccelerationsSolver::
     getSolvedState(const SimTK::State& s) const
 {
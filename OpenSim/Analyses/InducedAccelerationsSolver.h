@@ -30,11 +30,14 @@
 // Header to define analysis (DLL) interface
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 namespace OpenSim { 
 
 class Model;
 class Constraint;
 class Force;
+class ScalarActuator;
 
 //=============================================================================
 //=============================================================================
@@ -164,6 +167,55 @@ public:
                 bool computeActuatorPotentialOnly=false,
                 SimTK::Vector_<SimTK::SpatialVec>* constraintReactions=0);
 
+    /** Solve for the induced (generalized) accelerations (udot) of several
+        model force contributors at the same state. Column c of the result is
+        the udot that solve(state, forceNames[c],
+        computeActuatorPotentialOnly) would return. The constrained system is
+        set up and its mass matrix factored once, and the contributions of
+        all the actuators that provide their forces per unit actuation (see
+        ScalarActuator::addInForcesPerUnitActuation()) are solved for
+        together, as the right-hand sides of one block solve; the remaining
+        contributors are solved for one at a time. The convenience
+        acceleration accessors below do not apply to this solve.
+        @param[in]  state       current State of the model
+        @param[in]  forceNames  names of the model Force contributors, as
+                                for solve(state, forceName)
+        @param[in]  computeActuatorPotentialOnly  as for
+                                solve(state, forceName)
+        @return     A const reference to the Matrix of the induced
+                    generalized accelerations, one column per contributor.
+    */
+    const SimTK::Matrix& solve(const SimTK::State& state,
+                const std::vector<std::string>& forceNames,
+                bool computeActuatorPotentialOnly=false);
+
+    /** Solve for the generalized accelerations (udot) caused by each column
+        of the given generalized forces, with the constraints that are
+        enforced at the given state (realized to at least Stage::Position),
+        and without the velocity-dependent terms: the mass matrix (and, with
+        constraints, G M^-1 ~G) is factored once and all the columns are
+        solved for together.
+        @return false if the system cannot be factored, e.g., because the
+                constraints are redundant. */
+    static bool solveConstrainedSystem(
+        const SimTK::SimbodyMatterSubsystem& matter, const SimTK::State& s,
+        const SimTK::Matrix& generalizedForces, SimTK::Matrix& udots);
+
+    /** Compute the induced accelerations (udot) of each of the given
+        actuators with the given actuations, at a state realized to
+        Stage::Acceleration in which the actuators do not apply force (so
+        that its udot is that of the remaining forces). Column j is the
+        state's udot plus the udot caused by actuator j, found with
+        solveConstrainedSystem(). The column of an actuator that does not
+        provide its forces per unit actuation is not computed (computed[j] is
+        false), nor is any column if the system cannot be factored.
+        @return whether any column was computed. */
+    static bool calcInducedAccelerationsOfActuators(const Model& model,
+        const SimTK::State& s,
+        const std::vector<const ScalarActuator*>& actuators,
+        const SimTK::Vector& actuations,
+        SimTK::Matrix& udots, std::vector<bool>& computed);
+
 
 //----------------------------------------------------------------------------
 /** Convenience coordinate, body, or center of mass acceleration access after
@@ -188,11 +240,19 @@ protected:
 
     Array<bool> applyContactConstraintAccordingToExternalForces(SimTK::State &s);
 
+    /** Set the solver's state to the time and kinematics of the given state,
+        with the contact constraints that apply at that time (whether each
+        is on is returned in constraintOn), and realize it to
+        Stage::Dynamics. */
+    SimTK::State& setUpConstrainedState(const SimTK::State& s,
+                                        Array<bool>& constraintOn);
+
 private:
     double _forceThreshold;
     Set<Force> _forcesToReplace;
     Set<Constraint> _replacementConstraints; 
     Model _modelCopy;
+    SimTK::Matrix _inducedUDots;
 
 //=============================================================================
 }; // END of class InducedAccelerationsSolver
@@ -123,6 +123,8 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** The accelerations are computed from splines of the states. */
+    bool usesStatesStore() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
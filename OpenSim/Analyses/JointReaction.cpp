@@ -274,6 +274,7 @@ void JointReaction::setupReactionList()
     /* setup the JointReactionKey and, for valid joint names, determine and set the 
     *  reactionIndex, onBodyIndex, and inFrameIndex of each JointReactionKey */
     _reactionList.setSize(0);
+    _expressedInFrames.clear();
     int index = -1;
     for (int i = 0; i < _jointNames.getSize(); ++i) {
         JointReactionKey currentKey;
@@ -303,6 +304,13 @@ void JointReaction::setupReactionList()
                 expressedIn = (i < _inFrame.size()) ? _inFrame[i] : _inFrame[0];
             }
             currentKey.expressedInFrame = &_model->getComponent<Frame>(expressedIn);
+            // joints expressed in the same frame share its transform
+            auto frameIt = std::find(_expressedInFrames.begin(),
+                _expressedInFrames.end(), currentKey.expressedInFrame);
+            currentKey.expressedInFrameIndex =
+                int(frameIt - _expressedInFrames.begin());
+            if (frameIt == _expressedInFrames.end())
+                _expressedInFrames.push_back(currentKey.expressedInFrame);
 
             _reactionList.append(currentKey);
         }
@@ -534,51 +542,61 @@ record(const SimTK::State& s)
             }
         }
     }
-    // VARIABLES
-    const Ground& ground = _model->getGround();
-
     _model->realizeAcceleration(s_analysis);
 
+    /* compute the reactions at all mobilizers at once, rather than once per
+    *  joint, and the transforms of the requested frames in ground*/
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    matter.calcMobilizerReactionForces(s_analysis, _mobilizerReactions);
+    _expressedInFrameTransforms.resize(_expressedInFrames.size());
+    for (size_t k = 0; k < _expressedInFrames.size(); ++k) {
+        _expressedInFrameTransforms[k] =
+            _expressedInFrames[k]->getTransformInGround(s_analysis);
+    }
+
     /* retrieved desired joint reactions, convert to desired bodies, and convert
     *  to desired reference frames*/
     int numOutputJoints = _reactionList.getSize();
     Vector_<Vec3> forcesVec(numOutputJoints), momentsVec(numOutputJoints), pointsVec(numOutputJoints);
     for(int i=0; i<numOutputJoints; i++) {
-        JointReactionKey currentKey = _reactionList[i];
+        const JointReactionKey& currentKey = _reactionList[i];
         const Joint& joint = *currentKey.joint;
-        const Frame& expressedInBody = *currentKey.expressedInFrame;
-        SpatialVec jointReaction;
-        Vec3 pointOfApplication;
-        
+        const Transform& X_GE =
+            _expressedInFrameTransforms[currentKey.expressedInFrameIndex];
+
+        // the reaction on the body at its mobilizer frame M, as returned by
+        // Joint::calcReactionOnChildExpressedInGround()
+        const SimTK::MobilizedBody& mobod = joint.getChildFrame().getMobilizedBody();
+        SpatialVec jointReaction = _mobilizerReactions[mobod.getMobilizedBodyIndex()];
+        Vec3 pointInGround;
+
         // check if the load requested is on the parent or child
         if(!currentKey.isAppliedOnChild){
-            jointReaction = joint.calcReactionOnParentExpressedInGround(s_analysis);
-
-            // find the point of application in immediate parent frame, then
-            // transform to the base frame of the parent (expressedInBody)
-            Vec3 parentLocationInGlobal = joint.getParentFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication = 
-                ground.findStationLocationInAnotherFrame(s_analysis, parentLocationInGlobal, expressedInBody);
+            // shift the reaction from M to the parent's mobilizer frame F and
+            // negate it, as Joint::calcReactionOnParentExpressedInGround()
+            // does
+            const Vec3 p_GM = mobod.getBodyTransform(s_analysis)
+                * mobod.getOutboardFrame(s_analysis).p();
+            const Vec3 p_GF =
+                mobod.getParentMobilizedBody().getBodyTransform(s_analysis)
+                * mobod.getInboardFrame(s_analysis).p();
+            jointReaction = SpatialVec(
+                -(jointReaction[0] + (p_GM - p_GF) % jointReaction[1]),
+                -jointReaction[1]);
+
+            // the point of application is the origin of the parent frame
+            pointInGround = joint.getParentFrame().getTransformInGround(s_analysis).p();
         }
         else{
-            jointReaction = joint.calcReactionOnChildExpressedInGround(s_analysis);
-
-            // find the point of application in immediate child frame, then
-            // transform to the base frame of the child (expressedInBody)
-            Vec3 childLocationInGlobal = joint.getChildFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication =
-                ground.findStationLocationInAnotherFrame(s_analysis, childLocationInGlobal, expressedInBody);
+            // the point of application is the origin of the child frame
+            pointInGround = joint.getChildFrame().getTransformInGround(s_analysis).p();
         }
 
-        // transform SpatialVec of reaction forces and moments to the
-        // requested base frame (expressedInBody)
-        Vec3 force = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[1], expressedInBody);
-        Vec3 moment = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[0], expressedInBody);
-
-        /* place results in the truncated loads vectors*/
-        forcesVec[i] = force;
-        momentsVec[i] = moment;
-        pointsVec[i] = pointOfApplication;
+        // express the reaction forces, moments and point of application in
+        // the requested frame (expressedInFrame)
+        forcesVec[i] = ~X_GE.R() * jointReaction[1];
+        momentsVec[i] = ~X_GE.R() * jointReaction[0];
+        pointsVec[i] = ~X_GE * pointInGround;
     }
 
     /* fill out row construction array*/
@@ -662,6 +680,18 @@ end(const SimTK::State&s)
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Get the storages of the results. The list is rebuilt on each call.
+ */
+ArrayPtrs<Storage>& JointReaction::
+getStorageList()
+{
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+    _storageList.append(&_storeReactionLoads);
+    return _storageList;
+}
 
 
 
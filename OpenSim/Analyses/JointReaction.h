@@ -32,6 +32,8 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 
 //=============================================================================
 //=============================================================================
@@ -79,6 +81,8 @@ private:
         const Frame* appliedOnBody;
         /* The reference Frame in which the force should be expressed. */
         const Frame* expressedInFrame;
+        /* Index of expressedInFrame in _expressedInFrames. */
+        int expressedInFrameIndex;
     };
 
 protected:
@@ -135,6 +139,15 @@ protected:
     *   desired joints, onBody, and inFrame to be output*/
     Array<JointReactionKey> _reactionList;
 
+    /** The distinct frames in which the reaction loads are expressed.*/
+    std::vector<const Frame*> _expressedInFrames;
+
+    /** Internal work arrays for holding the mobilizer reactions of all
+    *   bodies in the model and the transforms of _expressedInFrames in ground,
+    *   each computed once per recorded frame.*/
+    SimTK::Vector_<SimTK::SpatialVec> _mobilizerReactions;
+    std::vector<SimTK::Transform> _expressedInFrameTransforms;
+
     bool _useForceStorage;
 
 //=============================================================================
@@ -190,6 +203,17 @@ public:
         step( const SimTK::State& s, int setNumber ) override;
     int
         end( const SimTK::State& s ) override;
+    /** Each frame is recorded independently of the others. */
+    bool isFrameIndependent() const override { return true; }
+    bool canStepConcurrently() const override { return true; }
+    /** The forces file, if assigned. */
+    std::vector<std::string> getInputFileNames() const override {
+        if (_forcesFileName == "" || _forcesFileName == "Unassigned")
+            return {};
+        return {_forcesFileName};
+    }
+    /** The storages of the results. */
+    ArrayPtrs<Storage>& getStorageList() override;
 
 
     //-------------------------------------------------------------------------
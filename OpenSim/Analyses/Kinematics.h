@@ -106,6 +106,9 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** Each frame is recorded independently of the others. */
+    bool isFrameIndependent() const override { return true; }
+    bool canStepConcurrently() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
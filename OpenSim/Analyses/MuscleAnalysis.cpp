@@ -28,8 +28,16 @@
 //=============================================================================
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/ConditionalPathPoint.h>
+#include <OpenSim/Simulation/Model/MovingPathPoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/CoordinateCouplerConstraint.h>
+#include <OpenSim/Simulation/Wrap/PathWrap.h>
+#include <OpenSim/Simulation/Wrap/WrapObject.h>
 #include "MuscleAnalysis.h"
 
+#include <map>
+#include <set>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -142,6 +150,8 @@ void MuscleAnalysis::setNull()
     _coordinateListProp.getValueStrArray().setSize(1);
     _coordinateListProp.getValueStrArray().updElt(0) = "all";
     _computeMoments = true;
+    _outputListProp.getValueStrArray().setSize(1);
+    _outputListProp.getValueStrArray().updElt(0) = "all";
 }
 //_____________________________________________________________________________
 /**
@@ -165,6 +175,13 @@ void MuscleAnalysis::setupProperties()
     _computeMomentsProp.setName("compute_moments");
     _propertySet.append( &_computeMomentsProp );
 
+    _outputListProp.setComment("List of muscle quantities to compute, by the "
+        "names of their storages (e.g., FiberLength TendonForce). Use 'all' to "
+        "compute all of them. Moment arms and moments are controlled by "
+        "compute_moments.");
+    _outputListProp.setName("output_list");
+    _propertySet.append( &_outputListProp );
+
 }
 //-----------------------------------------------------------------------------
 // DESCRIPTION
@@ -205,6 +222,7 @@ void MuscleAnalysis::allocateStorageObjects()
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    _spansCoordinate.clear();
 
     // FOR MOMENT ARMS AND MOMENTS
     if(_computeMoments) {
@@ -262,82 +280,52 @@ void MuscleAnalysis::allocateStorageObjects()
         }
     }
 
-    // EVERYTHING ELSE
-    //_storageList.setMemoryOwner(false);
-    _pennationAngleStore = new Storage(1000,"PennationAngle");
-    _pennationAngleStore->setDescription(getDescription());
-    _storageList.append(_pennationAngleStore );
-
-    _lengthStore = new Storage(1000,"Length");
-    _lengthStore->setDescription(getDescription());
-    _storageList.append(_lengthStore );
-
-    _fiberLengthStore = new Storage(1000,"FiberLength");
-    _fiberLengthStore->setDescription(getDescription());
-    _storageList.append(_fiberLengthStore );
-
-    _normalizedFiberLengthStore = new Storage(1000,"NormalizedFiberLength");
-    _normalizedFiberLengthStore->setDescription(getDescription());
-    _storageList.append(_normalizedFiberLengthStore );
-
-    _tendonLengthStore = new Storage(1000,"TendonLength");
-    _tendonLengthStore->setDescription(getDescription());
-    _storageList.append(_tendonLengthStore );
-
-    _fiberVelocityStore = new Storage(1000,"FiberVelocity");
-    _fiberVelocityStore->setDescription(getDescription());
-    _storageList.append(_fiberVelocityStore );
-
-    _normFiberVelocityStore = new Storage(1000,"NormFiberVelocity");
-    _normFiberVelocityStore->setDescription(getDescription());
-    _storageList.append(_normFiberVelocityStore );
-
-    _pennationAngularVelocityStore = new Storage(1000,
-        "PennationAngularVelocity");
-    _pennationAngularVelocityStore->setDescription(getDescription());
-    _storageList.append(_pennationAngularVelocityStore );
-
-    _forceStore = new Storage(1000,"TendonForce");
-    _forceStore->setDescription(getDescription());
-    _storageList.append(_forceStore );
-
-    _fiberForceStore = new Storage(1000,"FiberForce");
-    _fiberForceStore->setDescription(getDescription());
-    _storageList.append(_fiberForceStore );
-
-    _activeFiberForceStore = new Storage(1000,"ActiveFiberForce");
-    _activeFiberForceStore->setDescription(getDescription());
-    _storageList.append(_activeFiberForceStore );
-
-    _passiveFiberForceStore = new Storage(1000,"PassiveFiberForce");
-    _passiveFiberForceStore->setDescription(getDescription());
-    _storageList.append(_passiveFiberForceStore );
-
-    _activeFiberForceAlongTendonStore = new Storage(1000,
-        "ActiveFiberForceAlongTendon");
-    _activeFiberForceAlongTendonStore->setDescription(getDescription());
-    _storageList.append(_activeFiberForceAlongTendonStore );
-
-    _passiveFiberForceAlongTendonStore = new Storage(1000,
-        "PassiveFiberForceAlongTendon");
-    _passiveFiberForceAlongTendonStore->setDescription(getDescription());
-    _storageList.append(_passiveFiberForceAlongTendonStore );
-
-    _fiberActivePowerStore = new Storage(1000,"FiberActivePower");
-    _fiberActivePowerStore->setDescription(getDescription());
-    _storageList.append(_fiberActivePowerStore );
-
-    _fiberPassivePowerStore = new Storage(1000,"FiberPassivePower");
-    _fiberPassivePowerStore->setDescription(getDescription());
-    _storageList.append(_fiberPassivePowerStore );
-
-    _tendonPowerStore = new Storage(1000,"TendonPower");
-    _tendonPowerStore->setDescription(getDescription());
-    _storageList.append(_tendonPowerStore );
-
-    _musclePowerStore = new Storage(1000,"MuscleActuatorPower");
-    _musclePowerStore->setDescription(getDescription());
-    _storageList.append(_musclePowerStore );
+    // EVERYTHING ELSE, IF IT IS IN THE OUTPUT LIST
+    const Array<string>& outputList = _outputListProp.getValueStrArray();
+    const bool allOutputs = outputList.getSize() == 0 ||
+        IO::Lowercase(outputList[0]) == "all";
+    Array<string> allocatedNames;
+    auto allocateStorage = [&](const string& name) -> Storage* {
+        allocatedNames.append(name);
+        if(!allOutputs && outputList.findIndex(name) < 0) return NULL;
+        Storage* store = new Storage(1000,name);
+        store->setDescription(getDescription());
+        _storageList.append(store);
+        return store;
+    };
+    _pennationAngleStore = allocateStorage("PennationAngle");
+    _lengthStore = allocateStorage("Length");
+    _fiberLengthStore = allocateStorage("FiberLength");
+    _normalizedFiberLengthStore = allocateStorage("NormalizedFiberLength");
+    _tendonLengthStore = allocateStorage("TendonLength");
+
+    _fiberVelocityStore = allocateStorage("FiberVelocity");
+    _normFiberVelocityStore = allocateStorage("NormFiberVelocity");
+    _pennationAngularVelocityStore =
+        allocateStorage("PennationAngularVelocity");
+
+    _forceStore = allocateStorage("TendonForce");
+    _fiberForceStore = allocateStorage("FiberForce");
+    _activeFiberForceStore = allocateStorage("ActiveFiberForce");
+    _passiveFiberForceStore = allocateStorage("PassiveFiberForce");
+    _activeFiberForceAlongTendonStore =
+        allocateStorage("ActiveFiberForceAlongTendon");
+    _passiveFiberForceAlongTendonStore =
+        allocateStorage("PassiveFiberForceAlongTendon");
+
+    _fiberActivePowerStore = allocateStorage("FiberActivePower");
+    _fiberPassivePowerStore = allocateStorage("FiberPassivePower");
+    _tendonPowerStore = allocateStorage("TendonPower");
+    _musclePowerStore = allocateStorage("MuscleActuatorPower");
+
+    if(!allOutputs) {
+        for(int i=0; i<outputList.getSize(); ++i) {
+            if(allocatedNames.findIndex(outputList[i]) < 0) {
+                cout << "MuscleAnalysis: WARNING - output ";
+                cout << outputList[i] << " is not a muscle quantity." << endl;
+            }
+        }
+    }
 
     // POPULATE MUSCLE LIST FOR "all"
     ForceSet& fSet = _model->updForceSet();
@@ -411,6 +399,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
     _coordinateListProp = aAnalysis._coordinateListProp;
     _computeMomentsProp = aAnalysis._computeMomentsProp;
     _computeMoments = _computeMomentsProp.getValueBool();
+    _outputListProp = aAnalysis._outputListProp;
     allocateStorageObjects();
 
     return (*this);
@@ -461,6 +450,20 @@ setCoordinates(OpenSim::Array<std::string>& aCoordinates)
         _coordinateListProp.getValueStrArray().updElt(i) = aCoordinates[i];
     }
 }
+//_____________________________________________________________________________
+/**
+ * Set the list of muscle quantities to compute.
+ *
+ * @param aOutputs Array of the names of the storages to compute.
+ */
+void MuscleAnalysis::setOutputs(OpenSim::Array<std::string>& aOutputs)
+{
+    int size = aOutputs.getSize();
+    _outputListProp.getValueStrArray().setSize(size);
+    for(int i=0; i<size; i++){
+        _outputListProp.getValueStrArray().updElt(i) = aOutputs[i];
+    }
+}
 //-----------------------------------------------------------------------------
 // STORAGE CAPACITY
 //-----------------------------------------------------------------------------
@@ -489,6 +492,107 @@ setStorageCapacityIncrements(int aIncrement)
 // ANALYSIS
 //=============================================================================
 //_____________________________________________________________________________
+/**
+ * Determine which coordinates the path of each active muscle spans, from the
+ * topology of the model and of the path.
+ *
+ * A coordinate changes the length of a path only if it moves some, but not
+ * all, of the bodies to which the path's points and wrap objects are
+ * attached (i.e., its mobilizer is an ancestor of some but not all of them),
+ * or if a path point depends on it directly (moving and conditional path
+ * points). A coordinate also moves the coordinates that depend on it through
+ * CoordinateCouplerConstraints; any other enforced constraint can couple
+ * coordinates arbitrarily, in which case every path spans every coordinate.
+ */
+void MuscleAnalysis::computeSpannedCoordinates()
+{
+    const int nm = _muscleArray.getSize();
+    const int nq = _momentArmStorageArray.getSize();
+    _spansCoordinate.assign(nm, std::vector<bool>(nq, true));
+
+    const CoordinateSet& qSet = _model->getCoordinateSet();
+    std::map<const Coordinate*, std::vector<const Coordinate*>> dependents;
+    const ConstraintSet& constraints = _model->getConstraintSet();
+    for(int k=0; k<constraints.getSize(); ++k) {
+        if(!constraints[k].get_isEnforced()) continue;
+        const CoordinateCouplerConstraint* coupler =
+            dynamic_cast<const CoordinateCouplerConstraint*>(&constraints[k]);
+        if(!coupler) return;
+        const Coordinate& dependent =
+            qSet.get(coupler->getDependentCoordinateName());
+        const Array<string> independents =
+            coupler->getIndependentCoordinateNames();
+        for(int n=0; n<independents.getSize(); ++n)
+            dependents[&qSet.get(independents[n])].push_back(&dependent);
+    }
+
+    // The coordinates moved by each coordinate, including itself.
+    std::vector<std::set<const Coordinate*>> moved(nq);
+    for(int i=0; i<nq; ++i) {
+        std::vector<const Coordinate*> toVisit(1, _momentArmStorageArray[i]->q);
+        while(!toVisit.empty()) {
+            const Coordinate* q = toVisit.back();
+            toVisit.pop_back();
+            if(!moved[i].insert(q).second) continue;
+            auto it = dependents.find(q);
+            if(it != dependents.end())
+                toVisit.insert(toVisit.end(),
+                               it->second.begin(), it->second.end());
+        }
+    }
+
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    for(int j=0; j<nm; ++j) {
+        const GeometryPath& path = _muscleArray[j]->getGeometryPath();
+        std::set<int> bodies;
+        std::set<const Coordinate*> pointCoordinates;
+        const PathPointSet& points = path.getPathPointSet();
+        for(int p=0; p<points.getSize(); ++p) {
+            const AbstractPathPoint& point = points[p];
+            bodies.insert(point.getParentFrame().getMobilizedBodyIndex());
+            if(const MovingPathPoint* mpp =
+                    dynamic_cast<const MovingPathPoint*>(&point)) {
+                if(mpp->hasXCoordinate())
+                    pointCoordinates.insert(&mpp->getXCoordinate());
+                if(mpp->hasYCoordinate())
+                    pointCoordinates.insert(&mpp->getYCoordinate());
+                if(mpp->hasZCoordinate())
+                    pointCoordinates.insert(&mpp->getZCoordinate());
+            }
+            else if(const ConditionalPathPoint* cpp =
+                    dynamic_cast<const ConditionalPathPoint*>(&point)) {
+                if(cpp->hasCoordinate())
+                    pointCoordinates.insert(&cpp->getCoordinate());
+            }
+        }
+        const PathWrapSet& wraps = path.getWrapSet();
+        for(int w=0; w<wraps.getSize(); ++w) {
+            if(const WrapObject* wrapObject = wraps[w].getWrapObject())
+                bodies.insert(wrapObject->getFrame().getMobilizedBodyIndex());
+        }
+
+        // The number of the path's bodies that each mobilizer moves.
+        std::map<int, int> numMoved;
+        for(int b : bodies) {
+            for(SimTK::MobilizedBodyIndex m(b); m != SimTK::GroundIndex;
+                    m = matter.getMobilizedBody(m).getParentMobilizedBody()
+                              .getMobilizedBodyIndex())
+                ++numMoved[m];
+        }
+
+        for(int i=0; i<nq; ++i) {
+            bool spans = false;
+            for(const Coordinate* q : moved[i]) {
+                auto it = numMoved.find(q->getBodyIndex());
+                spans = pointCoordinates.count(q) ||
+                    (it != numMoved.end() && it->second < int(bodies.size()));
+                if(spans) break;
+            }
+            _spansCoordinate[j][i] = spans;
+        }
+    }
+}
+//_____________________________________________________________________________
 /**
  * Record the MuscleAnalysis quantities.
  */
@@ -525,21 +629,32 @@ int MuscleAnalysis::record(const SimTK::State& s)
     Array<double> fibActivePower(nan,nm), fibPassivePower(nan,nm),
                   tendonPower(nan,nm), muscPower(nan,nm);
 
-    double sysMass = _model->getMatterSubsystem().calcSystemMass(s);
-    bool hasMass = sysMass > SimTK::Eps;
+    // Only compute the quantities that are recorded. Forces are also needed
+    // for the moments.
+    const bool recordLengths = _pennationAngleStore || _lengthStore ||
+        _fiberLengthStore || _normalizedFiberLengthStore || _tendonLengthStore;
+    const bool recordForces = _computeMoments || _forceStore ||
+        _fiberForceStore || _activeFiberForceStore || _passiveFiberForceStore ||
+        _activeFiberForceAlongTendonStore || _passiveFiberForceAlongTendonStore;
+    const bool recordDynamics = _fiberVelocityStore ||
+        _normFiberVelocityStore || _pennationAngularVelocityStore ||
+        _fiberActivePowerStore || _fiberPassivePowerStore ||
+        _tendonPowerStore || _musclePowerStore;
 
     // Just warn once per instant
     bool lengthWarning = false;
     bool forceWarning = false;
     bool dynamicsWarning = false;
 
-    for(int i=0; i<nm; ++i) {
+    for(int i=0; i<nm && (recordLengths || recordForces); ++i) {
         try{
-            len[i] = _muscleArray[i]->getLength(s);
-            tlen[i] = _muscleArray[i]->getTendonLength(s);
-            fiblen[i] = _muscleArray[i]->getFiberLength(s);
-            normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
-            penang[i] = _muscleArray[i]->getPennationAngle(s);
+            if(recordLengths){
+                len[i] = _muscleArray[i]->getLength(s);
+                tlen[i] = _muscleArray[i]->getTendonLength(s);
+                fiblen[i] = _muscleArray[i]->getFiberLength(s);
+                normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
+                penang[i] = _muscleArray[i]->getPennationAngle(s);
+            }
         }
         catch (const std::exception& e) {
             if(!lengthWarning){
@@ -551,16 +666,19 @@ int MuscleAnalysis::record(const SimTK::State& s)
             continue;
         }
 
+        if(!recordForces) continue;
         try{
             // Compute muscle forces that are dependent on Positions, Velocities
             // so that later quantities are valid and setForce is called
             _muscleArray[i]->computeActuation(s);
             force[i] = _muscleArray[i]->getActuation(s);
-            fibforce[i] = _muscleArray[i]->getFiberForce(s);
-            actfibforce[i] = _muscleArray[i]->getActiveFiberForce(s);
-            passfibforce[i] = _muscleArray[i]->getPassiveFiberForce(s);
-            actfibforcealongten[i] = _muscleArray[i]->getActiveFiberForceAlongTendon(s);
-            passfibforcealongten[i] = _muscleArray[i]->getPassiveFiberForceAlongTendon(s);
+            const Muscle::RealizedMuscleState& ms =
+                _muscleArray[i]->getRealizedMuscleState(s);
+            fibforce[i] = ms.fiberForce;
+            actfibforce[i] = ms.activeFiberForce;
+            passfibforce[i] = ms.passiveFiberForce;
+            actfibforcealongten[i] = ms.activeFiberForceAlongTendon;
+            passfibforcealongten[i] = ms.passiveFiberForceAlongTendon;
         }
         catch (const std::exception& e) {
             if(!forceWarning){
@@ -574,21 +692,25 @@ int MuscleAnalysis::record(const SimTK::State& s)
     }
 
     // Cannot compute system dynamics without mass
+    bool hasMass = recordDynamics &&
+        _model->getMatterSubsystem().calcSystemMass(s) > SimTK::Eps;
     if(hasMass){
         // state derivatives (activation rate and fiber velocity) evaluated at dynamics
         _model->getMultibodySystem().realize(s,SimTK::Stage::Dynamics);
 
         for(int i=0; i<nm; ++i) {
             try{
+                const Muscle::RealizedMuscleState& ms =
+                    _muscleArray[i]->getRealizedMuscleState(s);
                 //Velocities
-                fibVel[i] = _muscleArray[i]->getFiberVelocity(s);
-                normFibVel[i] =  _muscleArray[i]->getNormalizedFiberVelocity(s);
-                penAngVel[i] =  _muscleArray[i]->getPennationAngularVelocity(s);
+                fibVel[i] = ms.fiberVelocity;
+                normFibVel[i] = ms.normalizedFiberVelocity;
+                penAngVel[i] = ms.pennationAngularVelocity;
                 //Powers
-                fibActivePower[i] = _muscleArray[i]->getFiberActivePower(s);
-                fibPassivePower[i] = _muscleArray[i]->getFiberPassivePower(s);
-                tendonPower[i] = _muscleArray[i]->getTendonPower(s);
-                muscPower[i] = _muscleArray[i]->getMusclePower(s);
+                fibActivePower[i] = ms.fiberActivePower;
+                fibPassivePower[i] = ms.fiberPassivePower;
+                tendonPower[i] = ms.tendonPower;
+                muscPower[i] = ms.musclePower;
             }
             catch (const std::exception& e) {
                 if(!dynamicsWarning){
@@ -601,7 +723,7 @@ int MuscleAnalysis::record(const SimTK::State& s)
             }
         }
     }
-    else {
+    else if(recordDynamics) {
         if(!dynamicsWarning){
             cout << "WARNING- MuscleAnalysis::record() unable to evaluate ";
             cout << "muscle dynamics at time " << s.getTime() << " because ";
@@ -611,34 +733,30 @@ int MuscleAnalysis::record(const SimTK::State& s)
     }
 
     // APPEND TO STORAGE
-    _pennationAngleStore->append(tReal,penang.getSize(),&penang[0]);
-    _lengthStore->append(tReal,len.getSize(),&len[0]);
-    _fiberLengthStore->append(tReal,fiblen.getSize(),&fiblen[0]);
-    _normalizedFiberLengthStore
-        ->append(tReal,normfiblen.getSize(),&normfiblen[0]);
-    _tendonLengthStore->append(tReal,tlen.getSize(),&tlen[0]);
-
-    _fiberVelocityStore->append(tReal,fibVel.getSize(),&fibVel[0]);
-    _normFiberVelocityStore->append(tReal,normFibVel.getSize(),&normFibVel[0]);
-    _pennationAngularVelocityStore
-        ->append(tReal,penAngVel.getSize(),&penAngVel[0]);
-
-    _forceStore->append(tReal,force.getSize(),&force[0]);
-    _fiberForceStore->append(tReal,fibforce.getSize(),&fibforce[0]);
-    _activeFiberForceStore->append(tReal,actfibforce.getSize(),&actfibforce[0]);
-    _passiveFiberForceStore
-        ->append(tReal,passfibforce.getSize(),&passfibforce[0]);
-    _activeFiberForceAlongTendonStore
-        ->append(tReal,actfibforcealongten.getSize(),&actfibforcealongten[0]);
-    _passiveFiberForceAlongTendonStore
-        ->append(tReal,passfibforcealongten.getSize(),&passfibforcealongten[0]);
-
-    _fiberActivePowerStore
-        ->append(tReal,fibActivePower.getSize(),&fibActivePower[0]);
-    _fiberPassivePowerStore
-        ->append(tReal,fibPassivePower.getSize(),&fibPassivePower[0]);
-    _tendonPowerStore->append(tReal,tendonPower.getSize(),&tendonPower[0]);
-    _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
+    auto append = [tReal](Storage* store, const Array<double>& values) {
+        if(store) store->append(tReal,values.getSize(),&values[0]);
+    };
+    append(_pennationAngleStore,penang);
+    append(_lengthStore,len);
+    append(_fiberLengthStore,fiblen);
+    append(_normalizedFiberLengthStore,normfiblen);
+    append(_tendonLengthStore,tlen);
+
+    append(_fiberVelocityStore,fibVel);
+    append(_normFiberVelocityStore,normFibVel);
+    append(_pennationAngularVelocityStore,penAngVel);
+
+    append(_forceStore,force);
+    append(_fiberForceStore,fibforce);
+    append(_activeFiberForceStore,actfibforce);
+    append(_passiveFiberForceStore,passfibforce);
+    append(_activeFiberForceAlongTendonStore,actfibforcealongten);
+    append(_passiveFiberForceAlongTendonStore,passfibforcealongten);
+
+    append(_fiberActivePowerStore,fibActivePower);
+    append(_fiberPassivePowerStore,fibPassivePower);
+    append(_tendonPowerStore,tendonPower);
+    append(_musclePowerStore,muscPower);
 
     if (_computeMoments){
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
@@ -647,6 +765,38 @@ int MuscleAnalysis::record(const SimTK::State& s)
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        if (int(_spansCoordinate.size()) != nm) computeSpannedCoordinates();
+
+        // Solve for the moment arms of all of the muscles about all of the
+        // coordinates at once; muscles whose path has a polynomial surrogate
+        // compute their moment arms analytically.
+        std::vector<const GeometryPath*> paths;
+        std::vector<int> pathIndices(nm, -1);
+        for (int j = 0; j < nm; j++) {
+            const GeometryPath& path = _muscleArray[j]->getGeometryPath();
+            if (!path.hasPolynomialSurrogate()) {
+                pathIndices[j] = int(paths.size());
+                paths.push_back(&path);
+            }
+        }
+        // Only the coordinates spanned by at least one of these paths are
+        // solved for.
+        std::vector<const Coordinate*> coords;
+        std::vector<int> coordIndices(nq, -1);
+        for (int i = 0; i < nq; i++) {
+            for (int j = 0; j < nm; j++) {
+                if (pathIndices[j] >= 0 && _spansCoordinate[j][i]) {
+                    coordIndices[i] = int(coords.size());
+                    coords.push_back(_momentArmStorageArray[i]->q);
+                    break;
+                }
+            }
+        }
+        SimTK::Matrix momentArms;
+        if (!paths.empty() && !coords.empty())
+            momentArms = MomentArmSolver(*_model).solveAll(s, paths, coords);
+
         for(int i=0; i<nq; i++) {
 
             q = _momentArmStorageArray[i]->q;
@@ -655,10 +805,14 @@ int MuscleAnalysis::record(const SimTK::State& s)
            
             // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                if (!_spansCoordinate[j][i])
+                    ma[j] = 0.0;
+                else
+                    ma[j] = pathIndices[j] < 0 ?
+                        _muscleArray[j]->computeMomentArm(s,*q) :
+                        momentArms(pathIndices[j], coordIndices[i]);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
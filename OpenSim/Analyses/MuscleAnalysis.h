@@ -32,6 +32,8 @@
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include "osimAnalysesDLL.h"
 
+#include <vector>
+
 
 #ifdef SWIG
     #ifdef OSIMANALYSES_API
@@ -87,6 +89,9 @@ private:
     /** Compute moments and moment arms. */
     PropertyBool _computeMomentsProp;
 
+    /** List of the muscle quantities (by storage name) to compute. */
+    PropertyStrArray _outputListProp;
+
     /** Pennation angle storage. */
     Storage *_pennationAngleStore;
     /** Muscle-tendon length storage. */
@@ -141,6 +146,11 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Whether the path of each active muscle spans each coordinate of
+    _momentArmStorageArray; moment arms about the coordinates a muscle does
+    not span are zero, and are not computed. */
+    std::vector<std::vector<bool>> _spansCoordinate;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -155,6 +165,7 @@ private:
     void setupProperties();
     void constructDescription();
     void constructColumnLabels();
+    void computeSpannedCoordinates();
 
 public:
     //--------------------------------------------------------------------------
@@ -169,6 +180,9 @@ public:
     void setModel(Model& aModel) override;
     void setStorageCapacityIncrements(int aIncrement);
 
+    // The storages of quantities that are not in the output list (see
+    // setOutputs()) are not allocated, and their getters return NULL.
+
     Storage* getPennationAngleStorage() const { 
         return _pennationAngleStore; }
     Storage* getMuscleTendonLengthStorage() const { 
@@ -211,6 +225,12 @@ public:
 
     void setMuscles(Array<std::string>& aMuscles);
     void setCoordinates(Array<std::string>& aCoordinates);
+    /** %Set the muscle quantities to compute, by the names of their storages
+    (e.g., "FiberLength", "TendonForce", "MuscleActuatorPower"); "all"
+    computes all of them. Moment arms and moments are controlled by
+    setComputeMoments() instead. Takes effect when the storages are next
+    allocated (e.g., by begin()). */
+    void setOutputs(Array<std::string>& aOutputs);
 
     void setComputeMoments(bool aTrueFalse) {
         _computeMoments = aTrueFalse;
@@ -230,6 +250,9 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end( const SimTK::State& s ) override;
+    /** Each frame is recorded independently of the others. */
+    bool isFrameIndependent() const override { return true; }
+    bool canStepConcurrently() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -66,7 +66,8 @@ _relativeToBody(NULL),
 _bodyName(_bodyNameProp.getValueStr()),
 _point(_pointProp.getValueDblVec()),
 _pointName(_pointNameProp.getValueStr()),
-_relativeToBodyName(_relativeToBodyNameProp.getValueStr())
+_relativeToBodyName(_relativeToBodyNameProp.getValueStr()),
+_recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
     // NULL
     setNull();
@@ -102,7 +103,8 @@ _relativeToBody(NULL),
 _bodyName(_bodyNameProp.getValueStr()),
 _point(_pointProp.getValueDblVec()),
 _pointName(_pointNameProp.getValueStr()),
-_relativeToBodyName(_relativeToBodyNameProp.getValueStr())
+_relativeToBodyName(_relativeToBodyNameProp.getValueStr()),
+_recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
     setNull();
 
@@ -132,7 +134,8 @@ _relativeToBody(aPointKinematics._relativeToBody),
 _bodyName(_bodyNameProp.getValueStr()),
 _point(_pointProp.getValueDblVec()),
 _pointName(_pointNameProp.getValueStr()),
-_relativeToBodyName(_relativeToBodyNameProp.getValueStr())
+_relativeToBodyName(_relativeToBodyNameProp.getValueStr()),
+_recordAccelerations(_recordAccelerationsProp.getValueBool())
 {
     setNull();
 
@@ -176,6 +179,13 @@ setNull()
     _pointProp.setName("point");
     _pointProp.setValue(zero3);
     _propertySet.append( &_pointProp );
+
+    _recordAccelerationsProp.setName("record_accelerations");
+    _recordAccelerationsProp.setComment("Flag (true or false) indicating whether"
+        " to record the acceleration of the point, in addition to its position"
+        " and velocity.");
+    _recordAccelerationsProp.setValue(true);
+    _propertySet.append( &_recordAccelerationsProp );
 }
 
 
@@ -202,6 +212,7 @@ operator=(const PointKinematics &aPointKinematics)
     _pointName = aPointKinematics._pointName;
     _bodyName = aPointKinematics._bodyName;
     _relativeToBodyName = aPointKinematics._relativeToBodyName;
+    _recordAccelerations = aPointKinematics._recordAccelerations;
 
     // STORAGE
     deleteStorage();
@@ -512,35 +523,35 @@ int PointKinematics::
 record(const SimTK::State& s)
 {
     // VARIABLES
-    SimTK::Vec3 vec;
+    SimTK::Vec3 pos, vel, acc(0);
 
     const double& time = s.getTime();
-    Ground ground = _model->getGround();
+    _model->getMultibodySystem().realize(s, _recordAccelerations ?
+            SimTK::Stage::Acceleration : SimTK::Stage::Velocity);
+
+    // The point's kinematics are all read from its MobilizedBody at once.
+    const SimTK::MobilizedBody& mobod = _body->getMobilizedBody();
+    const SimTK::Vec3 station = _body->findTransformInBaseFrame()*_point;
+    if(_recordAccelerations)
+        mobod.findStationLocationVelocityAndAccelerationInGround(s, station,
+                pos, vel, acc);
+    else
+        mobod.findStationLocationAndVelocityInGround(s, station, pos, vel);
 
-    // POSITION
-    vec = _body->findStationLocationInGround(s, _point);
     if(_relativeToBody){
-        vec = ground.findStationLocationInAnotherFrame(s, vec, *_relativeToBody);
+        const SimTK::Transform& X_GR = _relativeToBody->getTransformInGround(s);
+        pos = ~X_GR*pos;
+        vel = ~X_GR.R()*vel;
+        acc = ~X_GR.R()*acc;
     }
 
-    _pStore->append(time, vec);
-
+    // POSITION
+    _pStore->append(time, pos);
     // VELOCITY
-    vec = _body->findStationVelocityInGround(s, _point);
-    if(_relativeToBody){
-        vec = ground.expressVectorInAnotherFrame(s, vec, *_relativeToBody);
-    }
-
-    _vStore->append(time, vec);
-
+    _vStore->append(time, vel);
     // ACCELERATIONS
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
-    vec = _body->findStationAccelerationInGround(s, _point);
-    if(_relativeToBody){
-        vec = ground.expressVectorInAnotherFrame(s, vec, *_relativeToBody);
-    }
-
-    _aStore->append(time, vec);
+    if(_recordAccelerations)
+        _aStore->append(time, acc);
 
     return(0);
 }
@@ -624,6 +635,21 @@ end( const SimTK::State& s)
     cout<<"PointKinematics.end: Finalizing analysis "<<getName()<<".\n";
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Get the storages of the results. The list is rebuilt on each call, since
+ * the storages are reallocated when the model is set.
+ */
+ArrayPtrs<Storage>& PointKinematics::
+getStorageList()
+{
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
+    return _storageList;
+}
 
 
 
@@ -651,7 +677,8 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
                  const string &aExtension)
 {
     // ACCELERATIONS
-    Storage::printResult(_aStore,aBaseName+"_"+getName()+"_"+getPointName()+"_acc",aDir,aDT,aExtension);
+    if(_recordAccelerations)
+        Storage::printResult(_aStore,aBaseName+"_"+getName()+"_"+getPointName()+"_acc",aDir,aDT,aExtension);
 
     // VELOCITIES
     Storage::printResult(_vStore,aBaseName+"_"+getName()+"_"+getPointName()+"_vel",aDir,aDT,aExtension);
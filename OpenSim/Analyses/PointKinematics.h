@@ -35,6 +35,7 @@
     #endif
 #endif
 
+#include <OpenSim/Common/PropertyBool.h>
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 
@@ -76,12 +77,14 @@ protected:
     PropertyDblVec3 _pointProp;
     PropertyStr _pointNameProp;
     PropertyStr _relativeToBodyNameProp;
+    PropertyBool _recordAccelerationsProp;
 
     // References
     std::string &_bodyName;
     SimTK::Vec3 &_point;
     std::string &_pointName;
     std::string &_relativeToBodyName;
+    bool &_recordAccelerations;
 
     double *_kin;
     Storage *_pStore;
@@ -131,6 +134,13 @@ public:
     // POINT NAME
     void setPointName(const std::string &aName);
     const std::string &getPointName();
+    // ACCELERATIONS
+    /** Whether to record accelerations (default: true). If false, the
+    acceleration storage stays empty and is not printed, and the State need
+    only be realized to Stage::Velocity. */
+    void setRecordAccelerations(bool aTrueFalse)
+    {   _recordAccelerations = aTrueFalse; }
+    bool getRecordAccelerations() const { return _recordAccelerations; }
     // MODEL
     void setModel(Model& aModel) override;
     
@@ -147,6 +157,11 @@ public:
     int begin(const SimTK::State& s) override;
     int step(const SimTK::State& s, int setNumber) override;
     int end(const SimTK::State& s) override;
+    /** Each frame is recorded independently of the others. */
+    bool isFrameIndependent() const override { return true; }
+    bool canStepConcurrently() const override { return true; }
+    /** The storages of the results. */
+    ArrayPtrs<Storage>& getStorageList() override;
 protected:
     virtual int
         record(const SimTK::State& s );
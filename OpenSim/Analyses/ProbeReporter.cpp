@@ -235,25 +235,15 @@ int ProbeReporter::record(const SimTK::State& s)
     // MAKE SURE ALL ProbeReporter QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Report );
 
-    StateVector nextRow(s.getTime());
-
-    // NUMBER OF Probes
+    // Get the values of all enabled probes, after the probe operations, in
+    // one row.
     const ProbeSet& probes = _model->getProbeSet();
-    int nP = probes.getSize();
-
-    for(int i=0 ; i<nP ; i++) {
-        Probe& nextProbe = (Probe&)probes[i];
-
-        if (nextProbe.isEnabled())
-        {
-            // Get probe values after the probe operation
-            SimTK::Vector values = nextProbe.getProbeOutputs(s);
-            for (int i=0; i<values.size(); i++)
-                nextRow.getData().append(values(i));
-        }
-    }
+    _probeValues.setSize(probes.getNumProbeOutputs());
+    if (_probeValues.getSize() > 0)
+        probes.calcProbeOutputs(s, &_probeValues[0]);
 
-    _probeStore.append(nextRow);
+    _probeStore.append(s.getTime(), _probeValues.getSize(),
+                       _probeValues.get());
 
     return 0;
 }
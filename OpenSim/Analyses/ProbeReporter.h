@@ -90,6 +90,8 @@ protected:
 
     /** Probe storage. */
     Storage _probeStore;
+    /** The row of probe values being recorded. */
+    Array<double> _probeValues;
 
 //=============================================================================
 // METHODS
@@ -26,6 +26,8 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/SolverStatistics.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
@@ -61,12 +63,13 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
 
     if(aModel) setModel(*aModel);
-    else allocateStorage();
+    allocateStorage();
 }
 // Copy constructor and virtual copy 
 //_____________________________________________________________________________
@@ -82,12 +85,16 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool()),
     _modelWorkingCopy(NULL)
 {
     setNull();
     // COPY TYPE AND NAME
     *this = aStaticOptimization;
     _forceReporter = nullptr;
+    // The copy makes its own working copy of the model when it begins.
+    _modelWorkingCopy = NULL;
+    allocateStorage();
 }
 
 //=============================================================================
@@ -114,6 +121,7 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _reportSolverStatistics=aStaticOptimization._reportSolverStatistics;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -131,6 +139,8 @@ void StaticOptimization::setNull()
     // OTHER VARIABLES
     _useModelForceSet = true;
     _activationStorage = NULL;
+    _forceStorage = NULL;
+    _solverStatisticsStorage = NULL;
     _ownsForceSet = false;
     _forceSet = NULL;
     _activationExponent=2;
@@ -138,6 +148,7 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _reportSolverStatistics = false;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +184,12 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _reportSolverStatisticsProp.setComment(
+        "If true, the wall time, iterations, function evaluations and "
+        "convergence of each frame are written to a solver_statistics file.");
+    _reportSolverStatisticsProp.setName("report_solver_statistics");
+    _propertySet.append(&_reportSolverStatisticsProp);
 }
 
 //=============================================================================
@@ -217,6 +234,20 @@ allocateStorage()
     _activationStorage = new Storage(1000,"Static Optimization");
     _activationStorage->setDescription(getDescription());
     _activationStorage->setColumnLabels(getColumnLabels());
+    _forceStorage = new Storage(1000,"ModelForces");
+    _solverStatisticsStorage = new Storage(1000,"SolverStatistics");
+    Array<string> labels;
+    labels.append("time");
+    for(const auto& label : SolverStatistics::getColumnLabels())
+        labels.append(label);
+    _solverStatisticsStorage->setColumnLabels(labels);
+
+    // The forces are copied from the ForceReporter as they are recorded.
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+    _storageList.append(_activationStorage);
+    _storageList.append(_forceStorage);
+    _storageList.append(_solverStatisticsStorage);
 
 }
 
@@ -232,6 +263,9 @@ void StaticOptimization::
 deleteStorage()
 {
     delete _activationStorage; _activationStorage = NULL;
+    delete _forceStorage; _forceStorage = NULL;
+    delete _solverStatisticsStorage; _solverStatisticsStorage = NULL;
+    _storageList.setSize(0);
 }
 
 //=============================================================================
@@ -272,10 +306,7 @@ getActivationStorage()
 Storage* StaticOptimization::
 getForceStorage()
 {
-    if (_forceReporter)
-        return(&_forceReporter->updForceStorage());
-    else
-        return nullptr;
+    return(_forceStorage);
 }
 
 //-----------------------------------------------------------------------------
@@ -375,9 +406,15 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    // Warm start from the solution of the previous frame (zeros at the
+    // first frame), within this frame's bounds.
+    for(int j=0;j<na;j++) {
+        if(SimTK::isNaN(_parameters[j])) _parameters[j] = 0;
+        _parameters[j] = SimTK::clamp(lowerBounds[j], _parameters[j], upperBounds[j]);
+    }
 
     // Static optimization
+    const SolverStatistics::Timer timer;
     _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
     target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
 
@@ -388,9 +425,20 @@ record(const SimTK::State& s)
     //QueryPerformanceFrequency(&frequency);
     //QueryPerformanceCounter(&start);
 
+    OPENSIM_TRACE_SPAN("so", "optimize");
+
+    // With an activation exponent of 2 the problem is a quadratic program,
+    // solved directly unless no feasible solution is found.
+    bool solved = target.solveQuadraticProgram(_parameters, lowerBounds,
+                                               upperBounds, _activeBounds);
+    if(!solved) _activeBounds.clear();
+    const bool quadratic = solved;
+
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        target.resetNumEvaluations();
+        if(!solved) optimizer->optimize(_parameters);
+        solved = true;
     }
     catch (const SimTK::Exception::Base& ex) {
         cout << ex.getMessage() << endl;
@@ -473,6 +521,30 @@ record(const SimTK::State& s)
     //double duration = (double)(stop.QuadPart-start.QuadPart)/(double)frequency.QuadPart;
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
+    if(_reportSolverStatistics) {
+        // If the optimizer failed, the evaluations include that of the
+        // constraints reported above.
+        const double wallTime = timer.getElapsedTime();
+        const int iterations = quadratic ?
+            target.getNumQuadraticProgramIterations() :
+            target.getNumGradientEvaluations();
+        const int evaluations = target.getNumEvaluations();
+        StateVector* last = _solverStatisticsStorage->getLastStateVector();
+        if(last && last->getTime() >= sWorkingCopy.getTime()) {
+            // The frame was already solved (e.g., by begin()).
+            Array<double>& data = last->getData();
+            data[0] += wallTime;
+            data[1] += iterations;
+            data[2] += evaluations;
+            if(!solved) data[3] = 0;
+        } else {
+            double statistics[4] = { wallTime, double(iterations),
+                                      double(evaluations), solved ? 1. : 0. };
+            _solverStatisticsStorage->append(sWorkingCopy.getTime(), 4,
+                                             statistics);
+        }
+    }
+
     target.printPerformance(sWorkingCopy, &_parameters[0]);
 
     //update defaults for use in the next step
@@ -492,6 +564,11 @@ record(const SimTK::State& s)
 
     _forceReporter->step(sWorkingCopy, 1);
 
+    // Copy the forces recorded for this frame.
+    const Storage& reported = _forceReporter->getForceStorage();
+    for(int i=_forceStorage->getSize(); i<reported.getSize(); i++)
+        _forceStorage->append(*reported.getStateVector(i));
+
     return 0;
 }
 //_____________________________________________________________________________
@@ -582,6 +659,7 @@ int StaticOptimization::begin(const SimTK::State& s )
 
         _parameters.resize(_modelWorkingCopy->getNumControls());
         _parameters = 0;
+        _activeBounds.clear();
     }
 
     _statesSplineSet=GCVSplineSet(5,_statesStore);
@@ -595,7 +673,9 @@ int StaticOptimization::begin(const SimTK::State& s )
 
     // RESET STORAGE
     _activationStorage->reset(s.getTime());
+    _solverStatisticsStorage->reset(s.getTime());
     _forceReporter->updForceStorage().reset(s.getTime());
+    *_forceStorage = _forceReporter->getForceStorage();
 
     // RECORD
     int status = 0;
@@ -693,5 +773,10 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     std::string path = (aDir=="") ? "." : aDir;
     std::string name = path + "/" + aBaseName+"_"+getName()+"_controls.xml";
     cs.print(name);
+
+    if(_reportSolverStatistics) {
+        Storage::printResult(_solverStatisticsStorage,
+            aBaseName+"_"+getName()+"_solver_statistics",aDir,-1,aExtension);
+    }
     return(0);
 }
@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -76,13 +77,21 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyBool _reportSolverStatisticsProp;
+    bool &_reportSolverStatistics;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
+    // The cost of each frame (see SolverStatistics), if reported.
+    Storage *_solverStatisticsStorage;
     GCVSplineSet _statesSplineSet;
 
     Array<int> _accelerationIndices;
 
     SimTK::Vector _parameters;
+    // The bounds active in the last frame's solution, when it was solved as a
+    // quadratic program (see StaticOptimizationTarget::solveQuadraticProgram()).
+    std::vector<int> _activeBounds;
 
     bool _ownsForceSet;
     ForceSet* _forceSet;
@@ -135,6 +144,18 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** Whether to record the wall time, iterations, function evaluations and
+    convergence of each frame, printed by printResults() to
+    `<base name>_<name>_solver_statistics.sto` (default: false). Iterations
+    are those of the quadratic program's active-set method or, if the
+    general optimizer was used, its gradient evaluations. */
+    void setReportSolverStatistics(bool report)
+    {   _reportSolverStatistics = report; }
+    bool getReportSolverStatistics() const { return _reportSolverStatistics; }
+    /** The statistics recorded so far, with the columns of
+    SolverStatistics. */
+    TimeSeriesTable getSolverStatistics() const
+    {   return _solverStatisticsStorage->exportToTable(); }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
@@ -144,6 +165,12 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** The solution of each frame does not depend on the frames before;
+    only the optimizer's initial guess, which is the solution of the previous
+    frame, does. The activations and forces are both in getStorageList(). */
+    bool isFrameIndependent() const override { return true; }
+    /** The accelerations are computed from splines of the states. */
+    bool usesStatesStore() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -30,7 +30,9 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimulationUtilities.h>
 #include "StaticOptimizationTarget.h"
+#include <simmath/LinearAlgebra.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -127,7 +129,23 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
+    // The columns of actuators that provide their forces per unit actuation
+    // are computed directly; the others by realizing the accelerations with
+    // each actuator in turn at its optimal force.
+    std::vector<const ScalarActuator*> actuators;
+    for(int i=0;i<fSet.getSize();i++) {
+        const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&fSet.get(i));
+        if(act) actuators.push_back(act);
+    }
+    Matrix accelPerActuation;
+    std::vector<bool> computed;
+    calcAccelerationsPerUnitActuation(*_model, s, actuators, accelPerActuation, computed);
     for(int p=0; p<np; p++) {
+        if(computed[p]) {
+            for(int c=0; c<nc; c++)
+                _constraintMatrix(c,p) = -_optimalForce[p]*accelPerActuation(_accelerationIndices[c],p);
+            continue;
+        }
         pVector[p] = 1;
         computeConstraintVector(s, pVector, cVector);
         for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
@@ -138,6 +156,86 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Solve the quadratic program: minimize p'p subject to A p + c = 0 (the
+ * linear constraint matrix and vector) and l <= p <= u. For a given active
+ * set, the parameters at their bounds are fixed and the free parameters are
+ * the least-norm solution of A_F p_F = -(c + A_X p_X), i.e., p_F = A_F' y
+ * with (A_F A_F') y = -(c + A_X p_X). A bound is then released if its
+ * multiplier, p_i - a_i'y, has the wrong sign, and a free parameter that
+ * violates a bound is fixed at it, until the active set does not change.
+ */
+bool StaticOptimizationTarget::
+solveQuadraticProgram(Vector& parameters, const Vector& lowerBounds,
+        const Vector& upperBounds, std::vector<int>& activeBounds) const
+{
+    const int np = getNumParameters();
+    const int nc = getNumConstraints();
+    _numQuadraticProgramIterations = 0;
+    if(_activationExponent != 2.0) return false;
+    // The linear constraint matrix, built by prepareToOptimize().
+    if(_constraintMatrix.nrow() != nc || _constraintMatrix.ncol() != np)
+        return false;
+    const double tol = 1.0e-10;
+    if(int(activeBounds.size()) != np) activeBounds.assign(np, 0);
+
+    Vector p(np), r(nc), y(nc);
+    Matrix normal(nc, nc);
+    SimTK::FactorLU factorization;
+    const int maxIterations = 2*np + 10;
+    for(int iter=0; iter<maxIterations; iter++) {
+        _numQuadraticProgramIterations = iter + 1;
+        // Fix the parameters at their active bounds.
+        r = 0;
+        r -= _constraintVector;
+        for(int i=0; i<np; i++) {
+            if(activeBounds[i] == 0) continue;
+            p[i] = activeBounds[i] < 0 ? lowerBounds[i] : upperBounds[i];
+            r -= _constraintMatrix(i) * p[i];
+        }
+
+        // The least-norm solution for the free parameters.
+        normal.setToZero();
+        for(int i=0; i<np; i++) {
+            if(activeBounds[i] != 0) continue;
+            const SimTK::VectorView a = _constraintMatrix(i);
+            for(int j=0; j<nc; j++)
+                for(int k=0; k<=j; k++) normal(j,k) += a[j]*a[k];
+        }
+        for(int j=0; j<nc; j++)
+            for(int k=0; k<j; k++) normal(k,j) = normal(j,k);
+        factorization.factor(normal);
+        if(factorization.isSingular()) return false;
+        factorization.solve(r, y);
+
+        bool changed = false;
+        for(int i=0; i<np; i++) {
+            const double ay = ~_constraintMatrix(i) * y;
+            const int before = activeBounds[i];
+            if(before == 0) {
+                p[i] = ay;
+                if(p[i] < lowerBounds[i] - tol) activeBounds[i] = -1;
+                else if(p[i] > upperBounds[i] + tol) activeBounds[i] = 1;
+            } else {
+                // The multiplier of the bound.
+                const double multiplier = p[i] - ay;
+                if((activeBounds[i] < 0 && multiplier < -tol) ||
+                   (activeBounds[i] > 0 && multiplier > tol))
+                    activeBounds[i] = 0;
+            }
+            changed = changed || activeBounds[i] != before;
+        }
+        if(changed) continue;
+
+        // The constraints may not be satisfiable within the bounds.
+        const Vector residual = _constraintMatrix * p + _constraintVector;
+        if(!residual.isFinite() || residual.normInf() > 1.0e-6) return false;
+        parameters = p;
+        return true;
+    }
+    return false;
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -460,6 +558,7 @@ CentralDifferences(const StaticOptimizationTarget *aTarget,
 int StaticOptimizationTarget::
 objectiveFunc(const Vector &parameters, const bool new_parameters, Real &performance) const
 {
+    ++_numObjectiveEvaluations;
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
     //LARGE_INTEGER frequency;
@@ -496,6 +595,7 @@ objectiveFunc(const Vector &parameters, const bool new_parameters, Real &perform
 int StaticOptimizationTarget::
 gradientFunc(const Vector &parameters, const bool new_parameters, Vector &gradient) const
 {
+    ++_numGradientEvaluations;
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
     //LARGE_INTEGER frequency;
@@ -536,6 +636,7 @@ gradientFunc(const Vector &parameters, const bool new_parameters, Vector &gradie
 int StaticOptimizationTarget::
 constraintFunc(const SimTK::Vector &parameters, const bool new_parameters, SimTK::Vector &constraints) const
 {
+    ++_numConstraintEvaluations;
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
     //LARGE_INTEGER frequency;
@@ -623,6 +724,7 @@ computeConstraintVector(SimTK::State& s, const Vector &parameters,Vector &constr
 int StaticOptimizationTarget::
 constraintJacobian(const SimTK::Vector &parameters, const bool new_parameters, SimTK::Matrix &jac) const
 {
+    ++_numConstraintJacobianEvaluations;
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
     //LARGE_INTEGER frequency;
@@ -655,6 +757,11 @@ constraintJacobian(const SimTK::Vector &parameters, const bool new_parameters, S
 // ACCELERATION
 //=============================================================================
 //
+//______________________________________________________________________________
+/**
+ * Compute the generalized accelerations of the unconstrained coordinates
+ * given the parameters.
+ */
 void StaticOptimizationTarget::
 computeAcceleration(SimTK::State& s, const SimTK::Vector &parameters,SimTK::Vector &rAccel) const
 {
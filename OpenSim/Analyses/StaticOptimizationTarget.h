@@ -31,6 +31,8 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <simmath/Optimizer.h>
 
+#include <vector>
+
 //=============================================================================
 //=============================================================================
 namespace OpenSim { 
@@ -64,6 +66,8 @@ private:
     
     SimTK::Matrix _constraintMatrix;
     SimTK::Vector _constraintVector;
+    /** Active-set iterations of the last solveQuadraticProgram(). */
+    mutable int _numQuadraticProgramIterations = 0;
 
     const Storage *_statesStore;
     GCVSplineSet _statesSplineSet;
@@ -112,6 +116,25 @@ public:
         double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
 
     bool prepareToOptimize(SimTK::State& s, double *x);
+    /** Solve the problem directly when it is a quadratic program, i.e., the
+    activation exponent is 2: minimize the sum of the squared parameters
+    subject to the (linear) acceleration constraints and the parameter bounds,
+    with a primal-dual active-set method. activeBounds holds, for each
+    parameter, -1 if it is at its lower bound, 1 if at its upper bound, and 0
+    otherwise; it is the initial guess of the active set (e.g., that of the
+    previous frame, which is usually the active set of this frame too) and is
+    updated with the active set of the solution. Must be called after
+    prepareToOptimize().
+    @returns false, leaving parameters unchanged, if the problem is not
+    quadratic, or no feasible solution was found (e.g., the model is too
+    weak); the general optimizer should then be used. */
+    bool solveQuadraticProgram(SimTK::Vector& parameters,
+        const SimTK::Vector& lowerBounds, const SimTK::Vector& upperBounds,
+        std::vector<int>& activeBounds) const;
+    /** The number of active-set iterations of the last call to
+    solveQuadraticProgram() (0 if it returned before iterating). */
+    int getNumQuadraticProgramIterations() const
+    {   return _numQuadraticProgramIterations; }
 
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
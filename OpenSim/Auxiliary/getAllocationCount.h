@@ -0,0 +1,103 @@
+#ifndef TESTING_GETALLOCATIONCOUNT_H_
+#define TESTING_GETALLOCATIONCOUNT_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  getAllocationCount.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/*
+ * Counts the heap allocations made through the global operator new, by
+ * replacing it (and operator delete). Include this header in exactly one
+ * source file of a test program.
+ *
+ * With shared libraries, the replacement also counts the allocations made in
+ * the libraries on platforms where the executable's operator new is used by
+ * the libraries (e.g., Linux and macOS), but not on Windows, where each DLL
+ * uses the operator new of its runtime library; use
+ * isAllocationCountingComplete() to find out.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace OpenSimTesting {
+    inline std::atomic<size_t>& allocationCount() {
+        static std::atomic<size_t> count{0};
+        return count;
+    }
+}
+
+/**
+ * Returns the number of calls to the global operator new (and new[]) so far.
+ */
+inline size_t getAllocationCount() {
+    return OpenSimTesting::allocationCount().load();
+}
+
+/**
+ * Returns whether the allocations made in the OpenSim (and Simbody) libraries
+ * are counted by getAllocationCount().
+ */
+inline bool isAllocationCountingComplete() {
+#if defined(_WIN32)
+    return false;
+#else
+    return true;
+#endif
+}
+
+void* operator new(std::size_t size) {
+    ++OpenSimTesting::allocationCount();
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++OpenSimTesting::allocationCount();
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+#endif // TESTING_GETALLOCATIONCOUNT_H_
@@ -40,7 +40,7 @@
  * memory use) measured in bytes, or zero if the value cannot be
  * determined on this OS.
  */
-size_t getPeakRSS( )
+inline size_t getPeakRSS( )
 {
 #if defined(_WIN32)
     /* Windows -------------------------------------------------- */
@@ -86,7 +86,7 @@ size_t getPeakRSS( )
  * Returns the current resident set size (physical memory use) measured
  * in bytes, or zero if the value cannot be determined on this OS.
  */
-size_t getCurrentRSS( )
+inline size_t getCurrentRSS( )
 {
 #if defined(_WIN32)
     /* Windows -------------------------------------------------- */
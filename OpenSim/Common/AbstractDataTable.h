@@ -33,6 +33,7 @@ provide an in-memory container for data access and manipulation.              */
 #include "OpenSim/Common/ValueArrayDictionary.h"
 
 #include <ostream>
+#include <unordered_map>
 
 namespace OpenSim {
 
@@ -397,6 +398,7 @@ public:
             labels.upd().push_back(SimTK::Value<std::string>(*it));
         _dependentsMetaData.removeValueArrayForKey("labels");
         _dependentsMetaData.setValueArrayForKey("labels", labels);
+        updateColumnIndices();
 
         validateDependentsMetaData();
     }
@@ -444,7 +446,9 @@ public:
     void setColumnLabel(const size_t columnIndex,
                         const std::string& columnLabel);
 
-    /** Get index of a column label.                                          
+    /** Get index of a column label. The labels are hashed, so this takes
+    constant time regardless of the number of columns. If several columns
+    have the label, the index of the first is returned.
 
     \throw NoColumnLabels If table has no column labels.
     \throw KeyNotFound If columnLabel is not found to be label for any column.*/
@@ -481,6 +485,14 @@ protected:
     TableMetaData       _tableMetaData;
     DependentsMetaData  _dependentsMetaData;
     IndependentMetaData _independentMetaData;
+
+private:
+    /** Rebuild the index of column labels from the dependents metadata.
+    Called whenever the "labels" of the dependents metadata change.           */
+    void updateColumnIndices();
+
+    // Index of the first column with each label.
+    std::unordered_map<std::string, size_t> _columnIndices;
 }; // AbstractDataTable
 
 } // namespace OpenSim
@@ -66,6 +66,7 @@ void AbstractProperty::setNull()
     _name           = "";
     _comment        = "";
     _valueIsDefault = false;
+    _isParameterOnly = false;
     _minListSize    = 0;
     _maxListSize    = std::numeric_limits<int>::max();
 }
@@ -92,15 +93,26 @@ void AbstractProperty::readFromXMLParentElement(Xml::Element& parent,
 {
     // If this property has a real name (that is, doesn't use the object type
     // tag as a name), look for the first element whose tag is
-    // that name and read it if found. That is, we're looking for
+    // that name. That is, we're looking for
     //      <propName> ... </propName>
+    Xml::Element propElt;
     if (!isUnnamedProperty()) {
-        Xml::element_iterator propElt = parent.element_begin(getName());
-        if (propElt != parent.element_end()) {
-            readFromXMLElement(*propElt, versionNumber);
-            setValueIsDefault(false);
-            return;
-        }
+        Xml::element_iterator iter = parent.element_begin(getName());
+        if (iter != parent.element_end())
+            propElt = *iter;
+    }
+    readFromXMLParentElement(parent, propElt, versionNumber);
+}
+
+void AbstractProperty::readFromXMLParentElement(Xml::Element& parent,
+                                                Xml::Element& propElt,
+                                                int           versionNumber)
+{
+    // Read the element whose tag is this property's name, if found.
+    if (!isUnnamedProperty() && propElt.isValid()) {
+        readFromXMLElement(propElt, versionNumber);
+        setValueIsDefault(false);
+        return;
     }
 
     // Didn't find a property element by its name (or it didn't have one).
@@ -104,6 +104,12 @@ public:
     // TODO: replace this with something more reasonable
     virtual std::string toString() const = 0;
 
+    /** An estimate of the bytes of memory held by this property's name,
+    comment and values, not counting the contents of the objects held by an
+    object property (see Object::estimateMemoryUsage()). **/
+    virtual size_t estimateMemoryUsage() const
+    {   return _name.capacity() + _comment.capacity(); }
+
     /** This returns a string representation of this property's value type 
     which will be the same as T::getClassName() for Object-derived types T, and
     some reasonably nice name for simple types, including at least "bool",
@@ -235,6 +241,15 @@ public:
     void readFromXMLParentElement(SimTK::Xml::Element& parent,
                                   int                  versionNumber);
 
+    /** Same as above, given the first immediate child element of the parent
+    whose tag is this property's name, or an invalid element if there is none
+    (ignored if this property is unnamed). This lets an Object find the
+    elements of all of its properties in one pass over the parent's
+    elements. **/
+    void readFromXMLParentElement(SimTK::Xml::Element& parent,
+                                  SimTK::Xml::Element& propertyElement,
+                                  int                  versionNumber);
+
     /** Given an XML parent element, append a single child element representing
     the serialized form of this property. **/
     void writeToXMLParentElement(SimTK::Xml::Element& parent) const;
@@ -252,6 +267,16 @@ public:
     serializing. **/
     void setValueIsDefault(bool isDefault) { _valueIsDefault = isDefault; }
 
+    /** %Set flag indicating whether this property is "parameter-only", that
+    is, whether its owner reads its value only while computing results (and
+    not while building the System, e.g., to choose which state variables,
+    cache entries or Simbody elements to create). A parameter-only property
+    can be changed on a Model whose System has already been built, using
+    Component::setParameterValue(). Properties are topology-affecting (not
+    parameter-only) by default. **/
+    void setIsParameterOnly(bool isParameterOnly)
+    {   _isParameterOnly = isParameterOnly; }
+
     /** Get the property name. **/
     const std::string& getName() const { return _name; }
     /** Get the comment associated with this property. **/
@@ -261,6 +286,10 @@ public:
     out). **/
     bool getValueIsDefault() const { return _valueIsDefault; }
 
+    /** Get the flag indicating whether this property is parameter-only; see
+    setIsParameterOnly(). **/
+    bool isParameterOnly() const { return _isParameterOnly; }
+
     /** Get the minimum number of values allowed in this property's value
     list. Will be zero for optional properties, zero for list properties 
     (unless explicitly changed), and one for one-value properties. **/
@@ -385,6 +414,7 @@ private:
     std::string _name;
     std::string _comment;
     bool        _valueIsDefault;    // current value is just the default
+    bool        _isParameterOnly;   // can change without a new System
 
     int         _minListSize;       // minimum # values for property
     int         _maxListSize;       // maximum # value for property
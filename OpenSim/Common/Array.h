@@ -29,6 +29,8 @@
 
 
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include "osimCommonDLL.h"
 #include "Exception.h"
 
@@ -38,6 +40,21 @@ static const int Array_CAPMIN = 1;
 //=============================================================================
 namespace OpenSim { 
 
+#ifndef SWIG
+/** Storage for the elements of a short Array within the Array object itself.
+Used for numbers and pointers only, so that no elements of other types are
+constructed needlessly. */
+template<class T, int N> struct ArrayInlineStorage {
+    T values[N];
+    T* data() { return values; }
+    const T* data() const { return values; }
+};
+template<class T> struct ArrayInlineStorage<T, 0> {
+    T* data() { return NULL; }
+    const T* data() const { return NULL; }
+};
+#endif
+
 /**
  * A class for storing an array of values of type T.  The capacity of the class
  * grows as needed.  To use this template for a class of type T, class T should
@@ -45,6 +62,12 @@ namespace OpenSim {
  * assignment operator (=), equality operator (==), and less than
  * operator (<).
  *
+ * The capacity doubles when it is exceeded (see setCapacityIncrement()), and
+ * arrays of numbers or pointers whose capacity is at most
+ * Array::InlineCapacity (e.g., 3-vectors, whose capacity is 4) keep their
+ * elements within the Array object, without allocating memory. Arrays can be
+ * moved (e.g., returned from functions) without copying their elements.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -67,6 +90,16 @@ protected:
     /** Array of values. */
     T *_array;
 
+public:
+#ifndef SWIG
+    /** The largest capacity for which the elements are stored within the
+    Array object itself: 4 for numbers and pointers, 0 for other types. */
+    static constexpr int InlineCapacity = std::is_scalar<T>::value ? 4 : 0;
+private:
+    /** Elements of arrays with a capacity of at most InlineCapacity. */
+    ArrayInlineStorage<T, InlineCapacity> _inline;
+#endif
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -83,7 +116,7 @@ public:
  */
 virtual ~Array()
 {
-    if(_array!=NULL) { delete[] _array;  _array = NULL; }
+    release(_array);  _array = NULL;
 }
 //_____________________________________________________________________________
 /**
@@ -126,6 +159,21 @@ Array(const Array<T> &aArray)
     setNull();
     *this = aArray;
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move constructor. The elements of aArray are taken over without being
+ * copied, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ */
+Array(Array<T> &&aArray) :
+    _defaultValue(aArray._defaultValue)
+{
+    setNull();
+    takeElements(aArray);
+}
+#endif
 
 private:
 //_____________________________________________________________________________
@@ -140,6 +188,45 @@ void setNull()
     _array = NULL;
 }
 
+//_____________________________________________________________________________
+/**
+ * Take over the elements (and the size, capacity and capacity increment)
+ * of another array, which is left empty. This array must be empty (see
+ * setNull()). Elements stored within aArray are moved; others are not
+ * touched.
+ */
+void takeElements(Array<T> &aArray)
+{
+    _size = aArray._size;
+    _capacity = aArray._capacity;
+    _capacityIncrement = aArray._capacityIncrement;
+    if(aArray._array!=NULL && aArray._array==aArray._inline.data()) {
+        _array = _inline.data();
+        for(int i=0;i<_capacity;i++) _array[i] = std::move(aArray._array[i]);
+    } else {
+        _array = aArray._array;
+    }
+    aArray.setNull();
+}
+//_____________________________________________________________________________
+/**
+ * Get memory for the specified number of elements: the storage within this
+ * array if it is large enough, otherwise a new allocation.
+ */
+T* allocate(int aCapacity)
+{
+    if(aCapacity<=InlineCapacity) return(_inline.data());
+    return(new T[aCapacity]);
+}
+//_____________________________________________________________________________
+/**
+ * Free memory obtained from allocate().
+ */
+void release(T *aArray)
+{
+    if(aArray!=NULL && aArray!=_inline.data()) delete[] aArray;
+}
+
 
 //=============================================================================
 // OPERATORS
@@ -194,18 +281,39 @@ T& operator[](int aIndex) const
  */
 Array<T>& operator=(const Array<T> &aArray)
 {
+    if(&aArray==this) return(*this);
     _size = aArray._size;
     _capacity = aArray._capacity;
     _capacityIncrement = aArray._capacityIncrement;
     _defaultValue = aArray._defaultValue;
 
     // ARRAY
-    if(_array!=NULL) delete[] _array;
-    _array = new T[_capacity];
+    release(_array);
+    _array = allocate(_capacity);
     for(int i=0;i<_capacity;i++) _array[i] = aArray._array[i];
 
     return(*this);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move-assign a specified array to this array. The elements of aArray are
+ * taken over without being copied, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ * @return Reference to this array.
+ */
+Array<T>& operator=(Array<T> &&aArray)
+{
+    if(&aArray==this) return(*this);
+    _defaultValue = aArray._defaultValue;
+    release(_array);
+    setNull();
+    takeElements(aArray);
+
+    return(*this);
+}
+#endif
 
 //-----------------------------------------------------------------------------
 // EQUALITY (==)
@@ -339,8 +447,10 @@ bool ensureCapacity(int aCapacity)
     if(_capacity>=aCapacity) return(true);
 
     // ALLOCATE THE NEW ARRAY
+    // (the same storage, if the elements are stored within this array and
+    // still fit)
     int i;
-    T *newArray = new T[aCapacity];
+    T *newArray = allocate(aCapacity);
     if(newArray==NULL) {
         std::cout << "Array.ensureCapacity: ERR- failed to increase capacity.\n";
         return(false);
@@ -348,9 +458,12 @@ bool ensureCapacity(int aCapacity)
 
     // COPY CURRENT ARRAY
     if(_array!=NULL) {
-        for(i=0;i<_size;i++) newArray[i] = _array[i];
+        if(newArray!=_array) {
+            for(i=0;i<_size;i++) newArray[i] = std::move(_array[i]);
+            release(_array);
+        }
         for(i=_size;i<aCapacity;i++) newArray[i] = _defaultValue;
-        delete []_array;  _array=NULL;
+        _array=NULL;
     } else {
         for(i=0;i<aCapacity;i++) newArray[i] = _defaultValue;
     }
@@ -378,21 +491,25 @@ void trim()
     if(newCapacity<Array_CAPMIN) newCapacity = Array_CAPMIN;
 
     // ALLOCATE TEMPORARY ARRAY
+    // (or use the storage within this array)
     int i;
-    T *array = new T[newCapacity];
+    T *array = allocate(newCapacity);
     if(array==NULL) {
         std::cout << "Array.trim: ERR- unable to allocate temporary array.\n";
         return;
     }
 
-    // COPY CURRENT ARRAY
-    for(i=0;i<_size;i++) array[i] = _array[i];
+    if(array!=_array) {
+        // COPY CURRENT ARRAY
+        for(i=0;i<_size;i++) array[i] = std::move(_array[i]);
+        for(i=_size;i<newCapacity;i++) array[i] = _defaultValue;
 
-    // DELETE OLD ARRAY
-    delete[] _array;
+        // DELETE OLD ARRAY
+        release(_array);
 
-    // REASSIGN ARRAY POINTER
-    _array = array;
+        // REASSIGN ARRAY POINTER
+        _array = array;
+    }
 
     // SET CORRECT CAPACITY
     _capacity = newCapacity;
@@ -518,6 +635,34 @@ int append(const T &aValue)
 
     return(_size);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Append a value onto the array, moving it rather than copying it.
+ *
+ * @param aValue Value to be appended.
+ * @return New size of the array, or, equivalently, the index to the new
+ * first empty element of the array.
+ */
+int append(T &&aValue)
+{
+    // ENSURE CAPACITY
+    if((_size+1)>=_capacity) {
+        int newCapacity;
+        bool success;
+        success = computeNewCapacity(_size+1,newCapacity);
+        if(!success) return(_size);
+        success = ensureCapacity(newCapacity);
+        if(!success) return(_size);
+    }
+
+    // SET
+    _array[_size] = std::move(aValue);
+    _size++;
+
+    return(_size);
+}
+#endif
 //_____________________________________________________________________________
 /**
  * Append an array of values.
@@ -78,6 +78,8 @@ protected:
     int _capacityIncrement;
     /** Array of pointers to objects of type T. */
     T **_array;
+    /** Incremented whenever objects are added, removed or replaced. */
+    int _version;
 
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
@@ -148,6 +150,7 @@ void setNull()
     _capacityIncrement = -1;
     _capacity = 0;
     _array = NULL;
+    _version = 0;
 }
 
 public:
@@ -170,6 +173,7 @@ void clearAndDestroy()
     }
 
     _size = 0;
+    _version++;
 }
 
 
@@ -213,6 +217,7 @@ ArrayPtrs<T>& operator=(const ArrayPtrs<T> &aArray)
 
     // TAKE OWNERSHIP OF MEMORY
     _memoryOwner = true;
+    _version++;
 
     return(*this);
 }
@@ -528,6 +533,7 @@ bool setSize(int aSize)
             }
         }
         _size = aSize;
+        _version++;
     }
 
     return(true);
@@ -542,6 +548,17 @@ int getSize() const
 {
     return(_size);
 }
+//_____________________________________________________________________________
+/**
+ * Get the version of the contents of the array, which changes whenever
+ * objects are added, removed or replaced (but not when an object itself
+ * changes). Indices of the objects (e.g., by name) can use it to tell whether
+ * they are out of date.
+ */
+int getVersion() const
+{
+    return(_version);
+}
 
 /** Alternate name for getSize(). **/
 int size() const {return getSize();}
@@ -638,6 +655,7 @@ bool append(T *aObject)
     // SET
     _array[_size] = aObject;
     _size++;
+    _version++;
 
     return(true);
 }
@@ -718,6 +736,7 @@ bool insert(int aIndex,T *aObject)
     // SET
     _array[aIndex] = aObject;
     _size++;
+    _version++;
 
     return(true);
 }
@@ -758,6 +777,7 @@ bool remove(int aIndex)
         _array[i] = _array[i+1];
     }
     _array[_size] = NULL;
+    _version++;
 
     return(true);
 }
@@ -814,6 +834,7 @@ bool set(int aIndex,T *aObject)
     // SET
     if(getMemoryOwner() && (_array[aIndex]!=NULL)) delete _array[aIndex];
     _array[aIndex] = aObject;
+    _version++;
 
     return(true);
 }
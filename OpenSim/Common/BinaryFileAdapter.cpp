@@ -0,0 +1,88 @@
+#include "BinaryFileAdapter.h"
+#include "STOFileAdapter.h"
+
+namespace OpenSim {
+
+namespace {
+    template<typename T>
+    std::shared_ptr<DataAdapter>
+    createIfTableOf(const AbstractDataTable& table) {
+        if(dynamic_cast<const TimeSeriesTable_<T>*>(&table))
+            return std::make_shared<BinaryFileAdapter_<T>>();
+        return {};
+    }
+} // namespace
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForReading(const std::string& fileName) {
+    using namespace SimTK;
+
+    // The DataType is stored in the same place for all types.
+    const auto value = BinaryFileAdapter_<double>::readDataTypeName(fileName);
+    if(value == "double")
+        return std::make_shared<BinaryFileAdapter_<double>>();
+    else if(value == "Vec2")
+        return std::make_shared<BinaryFileAdapter_<Vec2>>();
+    else if(value == "Vec3")
+        return std::make_shared<BinaryFileAdapter_<Vec3>>();
+    else if(value == "Vec4")
+        return std::make_shared<BinaryFileAdapter_<Vec4>>();
+    else if(value == "Vec5")
+        return std::make_shared<BinaryFileAdapter_<Vec5>>();
+    else if(value == "Vec6")
+        return std::make_shared<BinaryFileAdapter_<Vec6>>();
+    else if(value == "Vec7")
+        return std::make_shared<BinaryFileAdapter_<Vec7>>();
+    else if(value == "Vec8")
+        return std::make_shared<BinaryFileAdapter_<Vec8>>();
+    else if(value == "Vec9")
+        return std::make_shared<BinaryFileAdapter_<Vec9>>();
+    else if(value == "Vec10")
+        return std::make_shared<BinaryFileAdapter_<Vec<10>>>();
+    else if(value == "Vec11")
+        return std::make_shared<BinaryFileAdapter_<Vec<11>>>();
+    else if(value == "Vec12")
+        return std::make_shared<BinaryFileAdapter_<Vec<12>>>();
+    else if(value == "UnitVec3")
+        return std::make_shared<BinaryFileAdapter_<UnitVec3>>();
+    else if(value == "Quaternion")
+        return std::make_shared<BinaryFileAdapter_<Quaternion>>();
+    else if(value == "SpatialVec")
+        return std::make_shared<BinaryFileAdapter_<SpatialVec>>();
+
+    OPENSIM_THROW(STODataTypeNotSupported,
+                  value);
+}
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForWriting(const DataAdapter::InputTables& absTables) {
+    using namespace SimTK;
+
+    OPENSIM_THROW_IF(absTables.find("table") == absTables.end(),
+                     KeyMissing,
+                     "table");
+    const auto& table = *absTables.at("table");
+
+    std::shared_ptr<DataAdapter> adapter{};
+    if((adapter = createIfTableOf<double>(table)) ||
+       (adapter = createIfTableOf<Vec2>(table)) ||
+       (adapter = createIfTableOf<Vec3>(table)) ||
+       (adapter = createIfTableOf<Vec4>(table)) ||
+       (adapter = createIfTableOf<Vec5>(table)) ||
+       (adapter = createIfTableOf<Vec6>(table)) ||
+       (adapter = createIfTableOf<Vec7>(table)) ||
+       (adapter = createIfTableOf<Vec8>(table)) ||
+       (adapter = createIfTableOf<Vec9>(table)) ||
+       (adapter = createIfTableOf<Vec<10>>(table)) ||
+       (adapter = createIfTableOf<Vec<11>>(table)) ||
+       (adapter = createIfTableOf<Vec<12>>(table)) ||
+       (adapter = createIfTableOf<UnitVec3>(table)) ||
+       (adapter = createIfTableOf<Quaternion>(table)) ||
+       (adapter = createIfTableOf<SpatialVec>(table)))
+        return adapter;
+
+    OPENSIM_THROW(STODataTypeNotSupported,
+                  "<unknown>");
+}
+
+}
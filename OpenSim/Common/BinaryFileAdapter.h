@@ -0,0 +1,511 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BinaryFileAdapter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_BINARY_FILE_ADAPTER_H_
+#define OPENSIM_BINARY_FILE_ADAPTER_H_
+
+#include "DelimFileAdapter.h"
+#include "IO.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace OpenSim {
+
+class InvalidBinaryFile : public IOError {
+public:
+    InvalidBinaryFile(const std::string& file,
+                      size_t line,
+                      const std::string& func,
+                      const std::string& filename,
+                      const std::string& message) :
+        IOError(file, line, func) {
+        std::string msg = "File '" + filename + "' is not a valid binary ";
+        msg += "time series file: " + message;
+
+        addMessage(msg);
+    }
+};
+
+/** BinaryFileAdapter_ is a FileAdapter that reads and writes a
+TimeSeriesTable_<T> to a binary file (extension ".bsto"), which is much
+faster to write and read than the text formats (STO, MOT, CSV, TRC) for large
+tables (e.g., the results of analyses of models with many muscles). The file
+stores the data column by column:
+\code
+magic number, version, DataType, number of scalars per element
+bytes per scalar (version 2 only)
+number of rows, number of columns
+number of table metadata entries, (key, value) pairs
+column labels
+independent (time) column
+column 0, column 1, ...
+\endcode
+Numbers are stored in the byte order of the machine that wrote the file, and
+strings as their length followed by their characters. The values are stored
+as doubles (version 1) or, to halve the size of large files, as floats
+(version 2, see write() and IO::SetBinarySinglePrecision()); they are read
+as doubles either way. Times are always stored as doubles. Like STOFileAdapter_,
+only the table metadata whose values are strings are stored. Because the
+columns are stored separately, read() can read some of the columns and a range
+of times without reading the rest of the file.
+
+The data types supported are those of STOFileAdapter_. FileAdapter::readFile()
+and FileAdapter::writeFile() use this adapter for files with the extension
+".bsto", and Storage::print() and Storage's constructor do as well.          */
+template<typename T>
+class BinaryFileAdapter_ : public FileAdapter {
+    static_assert(std::is_same<T, double           >::value ||
+                  is_SimTK_Vec<T                   >::value ||
+                  std::is_same<T, SimTK::UnitVec3  >::value ||
+                  std::is_same<T, SimTK::Quaternion>::value ||
+                  std::is_same<T, SimTK::SpatialVec>::value,
+                  "Template argument T must be one of the following types : "
+                  "double, SimTK::Vec2 to SimTK::Vec9, SimTK::Vec<10> to "
+                  "SimTK::Vec<12>, SimTK::UnitVec, SimTK::Quaternion, "
+                  "SimTK::SpatialVec");
+public:
+    BinaryFileAdapter_()                                     = default;
+    BinaryFileAdapter_(const BinaryFileAdapter_&)            = default;
+    BinaryFileAdapter_(BinaryFileAdapter_&&)                 = default;
+    BinaryFileAdapter_& operator=(const BinaryFileAdapter_&) = default;
+    BinaryFileAdapter_& operator=(BinaryFileAdapter_&&)      = default;
+    ~BinaryFileAdapter_()                                    = default;
+
+    BinaryFileAdapter_* clone() const override;
+
+    /** Read a binary file. If columnLabels is not empty, only the columns
+    with these labels are read, in this order. Only the rows with times in
+    [startTime, endTime] are read.
+
+    \throws KeyMissing If a label in columnLabels is not in the file.      */
+    static
+    TimeSeriesTable_<T> read(const std::string& fileName,
+            const std::vector<std::string>& columnLabels = {},
+            double startTime = -std::numeric_limits<double>::infinity(),
+            double endTime = std::numeric_limits<double>::infinity());
+
+    /** Write a binary file, in single precision if
+    IO::GetBinarySinglePrecision() is true.                                 */
+    static
+    void write(const TimeSeriesTable_<T>& table, const std::string& fileName);
+    /** Write a binary file, storing the values as floats (with about 7
+    significant digits) if singlePrecision is true.                         */
+    static
+    void write(const TimeSeriesTable_<T>& table, const std::string& fileName,
+               bool singlePrecision);
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString() { return "table"; }
+
+    /** Read the DataType of a binary file (e.g., "double" or "Vec3"), so
+    that the file can be read by a BinaryFileAdapter_ of the right type. */
+    static std::string readDataTypeName(const std::string& fileName);
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    static constexpr std::uint32_t _magicNumber{0x5442534F}; // "OSBT"
+    // Version 1 files store doubles; version 2 files also store the size of
+    // their scalars (floats or doubles).
+    static constexpr std::uint32_t _versionNumber{2};
+    static constexpr int _numScalars = int(sizeof(T) / sizeof(double));
+    static_assert(sizeof(T) == _numScalars * sizeof(double),
+                  "Elements must consist only of doubles.");
+
+    /** The layout of a file, read from its header.                           */
+    struct Layout {
+        std::uint64_t numRows{};
+        std::uint64_t scalarBytes{sizeof(double)};
+        std::vector<std::string> labels{};
+        // Position of the independent column; the dependent columns follow.
+        std::streamoff timesStart{};
+    };
+
+    static void writeTable(const TimeSeriesTable_<T>& table,
+                           const std::string& fileName,
+                           bool singlePrecision);
+    static std::shared_ptr<TimeSeriesTable_<T>> readTable(
+            const std::string& fileName,
+            const std::vector<std::string>& columnLabels,
+            double startTime, double endTime);
+    static Layout readHeader(std::istream& in, const std::string& fileName,
+                    typename TimeSeriesTable_<T>::TableMetaData* metadata);
+
+    static void writeValue(std::ostream& out, std::uint64_t value);
+    static void writeString(std::ostream& out, const std::string& str);
+    static std::uint64_t readValue(std::istream& in,
+                                   const std::string& fileName);
+    static std::string readString(std::istream& in,
+                                  const std::string& fileName);
+};
+
+template<typename T>
+BinaryFileAdapter_<T>*
+BinaryFileAdapter_<T>::clone() const {
+    return new BinaryFileAdapter_{*this};
+}
+
+template<typename T>
+TimeSeriesTable_<T>
+BinaryFileAdapter_<T>::read(const std::string& fileName,
+                            const std::vector<std::string>& columnLabels,
+                            double startTime, double endTime) {
+    return *readTable(fileName, columnLabels, startTime, endTime);
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::write(const TimeSeriesTable_<T>& table,
+                             const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(tableString(), &table);
+    BinaryFileAdapter_{}.extendWrite(tables, fileName);
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::write(const TimeSeriesTable_<T>& table,
+                             const std::string& fileName,
+                             bool singlePrecision) {
+    writeTable(table, fileName, singlePrecision);
+}
+
+template<typename T>
+std::string
+BinaryFileAdapter_<T>::readDataTypeName(const std::string& fileName) {
+    std::ifstream in{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!in.good(),
+                     FileDoesNotExist,
+                     fileName);
+    OPENSIM_THROW_IF(readValue(in, fileName) != _magicNumber,
+                     InvalidBinaryFile,
+                     fileName,
+                     "unrecognized magic number or byte order.");
+    readValue(in, fileName); // version
+    return readString(in, fileName);
+}
+
+template<typename T>
+typename BinaryFileAdapter_<T>::OutputTables
+BinaryFileAdapter_<T>::extendRead(const std::string& fileName) const {
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(),
+        readTable(fileName, {}, -std::numeric_limits<double>::infinity(),
+                  std::numeric_limits<double>::infinity()));
+    return output_tables;
+}
+
+template<typename T>
+std::shared_ptr<TimeSeriesTable_<T>>
+BinaryFileAdapter_<T>::readTable(const std::string& fileName,
+                                 const std::vector<std::string>& columnLabels,
+                                 double startTime, double endTime) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    std::ifstream in{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!in.good(),
+                     FileDoesNotExist,
+                     fileName);
+    OPENSIM_THROW_IF(in.peek() == std::ifstream::traits_type::eof(),
+                     FileIsEmpty,
+                     fileName);
+
+    typename TimeSeriesTable_<T>::TableMetaData metadata{};
+    const Layout layout = readHeader(in, fileName, &metadata);
+
+    // Find the columns to read.
+    std::vector<size_t> columns{};
+    if(columnLabels.empty()) {
+        for(size_t c = 0; c < layout.labels.size(); ++c)
+            columns.push_back(c);
+    } else {
+        for(const auto& label : columnLabels) {
+            const auto it = std::find(layout.labels.begin(),
+                                      layout.labels.end(), label);
+            OPENSIM_THROW_IF(it == layout.labels.end(),
+                             KeyMissing,
+                             label);
+            columns.push_back(size_t(it - layout.labels.begin()));
+        }
+    }
+
+    // Find the rows to read from the (increasing) times.
+    std::vector<double> times(layout.numRows);
+    if(!times.empty())
+        in.read(reinterpret_cast<char*>(times.data()),
+                times.size() * sizeof(double));
+    OPENSIM_THROW_IF(!in,
+                     InvalidBinaryFile,
+                     fileName,
+                     "file is truncated.");
+    const auto first = std::lower_bound(times.begin(), times.end(),
+                                        startTime);
+    const auto last = std::upper_bound(first, times.end(), endTime);
+    const size_t rowBegin = size_t(first - times.begin());
+    const size_t numRows = size_t(last - first);
+
+    // Read the selected part of each selected column.
+    const bool singlePrecision = layout.scalarBytes == sizeof(float);
+    const size_t elementBytes = layout.scalarBytes * _numScalars;
+    const std::streamoff columnBytes =
+        std::streamoff(layout.numRows * elementBytes);
+    const std::streamoff dataStart =
+        layout.timesStart + std::streamoff(layout.numRows * sizeof(double));
+    SimTK::Matrix_<T> data{int(numRows), int(columns.size())};
+    std::vector<T> column(numRows);
+    std::vector<float> floats(singlePrecision ? numRows * _numScalars : 0);
+    std::vector<std::string> labels{};
+    for(size_t c = 0; c < columns.size(); ++c) {
+        labels.push_back(layout.labels[columns[c]]);
+        if(numRows == 0)
+            continue;
+        in.seekg(dataStart + std::streamoff(columns[c]) * columnBytes +
+                 std::streamoff(rowBegin * elementBytes));
+        if(singlePrecision) {
+            in.read(reinterpret_cast<char*>(floats.data()),
+                    floats.size() * sizeof(float));
+            double* scalars = reinterpret_cast<double*>(column.data());
+            for(size_t i = 0; i < floats.size(); ++i)
+                scalars[i] = floats[i];
+        } else {
+            in.read(reinterpret_cast<char*>(column.data()),
+                    numRows * sizeof(T));
+        }
+        OPENSIM_THROW_IF(!in,
+                         InvalidBinaryFile,
+                         fileName,
+                         "file is truncated.");
+        for(size_t r = 0; r < numRows; ++r)
+            data(int(r), int(c)) = column[r];
+    }
+
+    auto table = std::make_shared<TimeSeriesTable_<T>>(
+            std::vector<double>(first, last), data, labels);
+    table->updTableMetaData() = metadata;
+    return table;
+}
+
+template<typename T>
+typename BinaryFileAdapter_<T>::Layout
+BinaryFileAdapter_<T>::readHeader(std::istream& in,
+        const std::string& fileName,
+        typename TimeSeriesTable_<T>::TableMetaData* metadata) {
+    OPENSIM_THROW_IF(readValue(in, fileName) != _magicNumber,
+                     InvalidBinaryFile,
+                     fileName,
+                     "unrecognized magic number or byte order.");
+    const auto version = readValue(in, fileName);
+    OPENSIM_THROW_IF(version > _versionNumber,
+                     InvalidBinaryFile,
+                     fileName,
+                     "unsupported version " + std::to_string(version) + ".");
+    const auto dataType = readString(in, fileName);
+    OPENSIM_THROW_IF(dataType != DelimFileAdapter<T>::dataTypeName(),
+                     DataTypeMismatch,
+                     DelimFileAdapter<T>::dataTypeName(),
+                     dataType);
+    OPENSIM_THROW_IF(readValue(in, fileName) != _numScalars,
+                     InvalidBinaryFile,
+                     fileName,
+                     "unexpected number of scalars per element.");
+
+    Layout layout{};
+    if(version >= 2) {
+        layout.scalarBytes = readValue(in, fileName);
+        OPENSIM_THROW_IF(layout.scalarBytes != sizeof(float) &&
+                         layout.scalarBytes != sizeof(double),
+                         InvalidBinaryFile,
+                         fileName,
+                         "unsupported size of scalars.");
+    }
+    layout.numRows = readValue(in, fileName);
+    const auto numColumns = readValue(in, fileName);
+
+    const auto numMetaData = readValue(in, fileName);
+    for(std::uint64_t i = 0; i < numMetaData; ++i) {
+        const auto key = readString(in, fileName);
+        const auto value = readString(in, fileName);
+        if(metadata)
+            metadata->setValueForKey(key, value);
+    }
+
+    for(std::uint64_t c = 0; c < numColumns; ++c)
+        layout.labels.push_back(readString(in, fileName));
+
+    layout.timesStart = in.tellg();
+    return layout;
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::extendWrite(const InputTables& absTables,
+                                   const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(),
+                     NoTableFound);
+
+    const TimeSeriesTable_<T>* table{};
+    try {
+        auto abs_table = absTables.at(tableString());
+        table = dynamic_cast<const TimeSeriesTable_<T>*>(abs_table);
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      tableString());
+    }
+    OPENSIM_THROW_IF(table == nullptr,
+                     IncorrectTableType);
+
+    writeTable(*table, fileName, IO::GetBinarySinglePrecision());
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::writeTable(const TimeSeriesTable_<T>& table,
+                                  const std::string& fileName,
+                                  bool singlePrecision) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    std::ofstream out{fileName, std::ios::binary};
+
+    writeValue(out, _magicNumber);
+    // Files of doubles are written as version 1, which older versions of
+    // OpenSim can read.
+    writeValue(out, singlePrecision ? _versionNumber : 1);
+    writeString(out, DelimFileAdapter<T>::dataTypeName());
+    writeValue(out, _numScalars);
+    if(singlePrecision)
+        writeValue(out, sizeof(float));
+    const size_t numRows = table.getNumRows();
+    const size_t numColumns = table.getNumColumns();
+    writeValue(out, numRows);
+    writeValue(out, numColumns);
+
+    // Only metadata with string values, as in STO files.
+    std::vector<std::pair<std::string, std::string>> metadata{};
+    for(const auto& key : table.getTableMetaDataKeys()) {
+        try {
+            metadata.emplace_back(key,
+                table.template getTableMetaData<std::string>(key));
+        } catch(const InvalidTemplateArgument&) {}
+    }
+    writeValue(out, metadata.size());
+    for(const auto& keyValue : metadata) {
+        writeString(out, keyValue.first);
+        writeString(out, keyValue.second);
+    }
+
+    for(const auto& label : table.getColumnLabels())
+        writeString(out, label);
+
+    const auto& times = table.getIndependentColumn();
+    if(numRows > 0)
+        out.write(reinterpret_cast<const char*>(times.data()),
+                  numRows * sizeof(double));
+
+    const auto& matrix = table.getMatrix();
+    std::vector<T> column(numRows);
+    std::vector<float> floats(singlePrecision ? numRows * _numScalars : 0);
+    for(size_t c = 0; c < numColumns; ++c) {
+        if(numRows == 0)
+            break;
+        for(size_t r = 0; r < numRows; ++r)
+            column[r] = matrix(int(r), int(c));
+        if(singlePrecision) {
+            const double* scalars =
+                reinterpret_cast<const double*>(column.data());
+            for(size_t i = 0; i < floats.size(); ++i)
+                floats[i] = float(scalars[i]);
+            out.write(reinterpret_cast<const char*>(floats.data()),
+                      floats.size() * sizeof(float));
+        } else {
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      numRows * sizeof(T));
+        }
+    }
+
+    OPENSIM_THROW_IF(!out,
+                     IOError,
+                     "Could not write to file '" + fileName + "'.");
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::writeValue(std::ostream& out, std::uint64_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::writeString(std::ostream& out,
+                                   const std::string& str) {
+    writeValue(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+template<typename T>
+std::uint64_t
+BinaryFileAdapter_<T>::readValue(std::istream& in,
+                                 const std::string& fileName) {
+    std::uint64_t value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    OPENSIM_THROW_IF(!in,
+                     InvalidBinaryFile,
+                     fileName,
+                     "file is truncated.");
+    return value;
+}
+
+template<typename T>
+std::string
+BinaryFileAdapter_<T>::readString(std::istream& in,
+                                  const std::string& fileName) {
+    const auto size = readValue(in, fileName);
+    std::string str(size_t(size), '\0');
+    if(size > 0)
+        in.read(&str[0], size);
+    OPENSIM_THROW_IF(!in,
+                     InvalidBinaryFile,
+                     fileName,
+                     "file is truncated.");
+    return str;
+}
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForReading(const std::string& fileName);
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForWriting(const DataAdapter::InputTables& tables);
+
+typedef BinaryFileAdapter_<double> BinaryFileAdapter;
+typedef BinaryFileAdapter_<SimTK::Vec3> BinaryFileAdapterVec3;
+
+}
+
+#endif // OPENSIM_BINARY_FILE_ADAPTER_H_
@@ -5,6 +5,12 @@
 #include "btkForcePlatformsExtractor.h"
 #include "btkGroundReactionWrenchFilter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
 namespace {
 
 // Function to convert Eigen matrix to SimTK matrix. This can become a lambda
@@ -62,6 +68,66 @@ C3DFileAdapter::write(const C3DFileAdapter::Tables& tables,
     throw Exception{"Writing C3D not supported yet."};
 }
 
+C3DFileAdapter::Tables
+C3DFileAdapter::readTables(const std::string& fileName) const {
+    auto abstables = extendRead(fileName);
+    Tables tables{};
+    for(const auto& name : {_markers, _forces}) {
+        auto table = abstables.find(name);
+        if(table != abstables.end())
+            tables.emplace(name,
+                std::static_pointer_cast<TimeSeriesTableVec3>(table->second));
+    }
+    return tables;
+}
+
+std::vector<C3DFileAdapter::Tables>
+C3DFileAdapter::readTables(const std::vector<std::string>& fileNames) const {
+    std::vector<Tables> results(fileNames.size());
+    std::vector<std::string> errors(fileNames.size());
+
+    // Each file is converted on the thread that reads it.
+    C3DFileAdapter adapter{*this};
+    adapter.setNumThreads(1);
+    std::atomic<std::size_t> next{0};
+    auto readAll = [&]() {
+        for(std::size_t i = next++; i < fileNames.size(); i = next++) {
+            try {
+                results[i] = adapter.readTables(fileNames[i]);
+            } catch(const std::exception& e) {
+                errors[i] = e.what();
+            } catch(...) {
+                errors[i] = "unknown error";
+            }
+        }
+    };
+
+    int numThreads = _numThreads;
+    if(numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1,
+            std::min(numThreads, static_cast<int>(fileNames.size())));
+    std::vector<std::thread> threads{};
+    for(int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(readAll);
+        } catch(const std::system_error&) {
+            // Could not start a thread; the others read its files.
+            break;
+        }
+    }
+    readAll();
+    for(auto& thread : threads)
+        thread.join();
+
+    std::string message{};
+    for(std::size_t i = 0; i < fileNames.size(); ++i)
+        if(!errors[i].empty())
+            message += "\n  " + fileNames[i] + ": " + errors[i];
+    OPENSIM_THROW_IF(!message.empty(), Exception,
+                     "Could not read C3D file(s):" + message);
+    return results;
+}
+
 C3DFileAdapter::OutputTables
 C3DFileAdapter::extendRead(const std::string& fileName) const {
     auto reader = btk::AcquisitionFileReader::New();
@@ -81,19 +147,34 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             et->GetDescription() });
     }
 
-    OutputTables tables{};
-
-    auto marker_pts = btk::PointCollection::New();
+    // The markers and the forces are converted by separate functions, which
+    // only read the acquisition, so that they can run concurrently.
+    auto readMarkers = [&]() -> std::shared_ptr<TimeSeriesTableVec3> {
+        auto marker_pts = btk::PointCollection::New();
 
-    for(auto it = acquisition->BeginPoint();
-        it != acquisition->EndPoint();
-        ++it) {
-        auto pt = *it;
-        if(pt->GetType() == btk::Point::Marker)
-               marker_pts->InsertItem(pt);
-    }
+        if(_markerNames.empty()) {
+            for(auto it = acquisition->BeginPoint();
+                it != acquisition->EndPoint();
+                ++it) {
+                auto pt = *it;
+                if(pt->GetType() == btk::Point::Marker)
+                       marker_pts->InsertItem(pt);
+            }
+        } else {
+            for(const auto& name : _markerNames) {
+                auto it = acquisition->BeginPoint();
+                for(; it != acquisition->EndPoint(); ++it)
+                    if((*it)->GetType() == btk::Point::Marker &&
+                       (*it)->GetLabel() == name)
+                        break;
+                OPENSIM_THROW_IF(it == acquisition->EndPoint(), Exception,
+                                 "Marker '" + name + "' not found in '" +
+                                 fileName + "'.");
+                marker_pts->InsertItem(*it);
+            }
+        }
 
-    if(marker_pts->GetItemNumber() != 0) {
+        if(marker_pts->GetItemNumber() == 0) return nullptr;
 
         int marker_nrow = marker_pts->GetFrontItem()->GetFrameNumber();
         int marker_ncol = marker_pts->GetItemNumber();
@@ -106,90 +187,100 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             marker_labels.push_back(SimTK::Value<std::string>((*it)->GetLabel()));
         }
 
-        double time_step{1.0 / acquisition->GetPointFrequency()};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{marker_pts->GetItemNumber()};
-            int m{0};
-            for(auto it = marker_pts->Begin();  it != marker_pts->End(); ++it) {
-                auto pt = *it;
-                row[m++] = SimTK::Vec3{pt->GetValues().coeff(f, 0),
-                                       pt->GetValues().coeff(f, 1),
-                                       pt->GetValues().coeff(f, 2)};
-            }
+        // Copy one marker (column) at a time, from its frames (rows).
+        int m{0};
+        for(auto it = marker_pts->Begin(); it != marker_pts->End(); ++it) {
+            const auto& values = (*it)->GetValues();
+            for(int f = 0; f < marker_nrow; ++f)
+                marker_matrix(f, m) = SimTK::Vec3{values.coeff(f, 0),
+                                                  values.coeff(f, 1),
+                                                  values.coeff(f, 2)};
+            ++m;
+        }
 
-            marker_matrix.updRow(f) = row;
+        double time_step{1.0 / acquisition->GetPointFrequency()};
+        for(int f = 0; f < marker_nrow; ++f)
             marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
 
         // Create the data
-        auto& marker_table = *new 
-            TimeSeriesTableVec3(marker_times, marker_matrix, marker_labels);
+        auto marker_table = std::make_shared<TimeSeriesTableVec3>(
+                marker_times, marker_matrix, marker_labels);
 
-        marker_table.
+        marker_table->
             updTableMetaData().
             setValueForKey("DataRate",
                 std::to_string(acquisition->GetPointFrequency()));
 
-        marker_table.
+        marker_table->
             updTableMetaData().
             setValueForKey("Units",
                 acquisition->GetPointUnit());
 
-        marker_table.updTableMetaData().setValueForKey("events", event_table);
-
-        tables.emplace(_markers,
-            std::shared_ptr<TimeSeriesTableVec3>(&marker_table));
-    }
-
-    // This is probably the right way to get the raw forces data from force 
-    // platforms. Extract the collection of force platforms.
-    auto force_platforms_extractor = btk::ForcePlatformsExtractor::New();
-    force_platforms_extractor->SetInput(acquisition);
-    auto force_platform_collection = force_platforms_extractor->GetOutput();
-    force_platforms_extractor->Update();
-
-    std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
-    std::vector<SimTK::Matrix_<double>> fpCorners{};
-    std::vector<SimTK::Matrix_<double>> fpOrigins{};
-    std::vector<unsigned>               fpTypes{};
-    auto    fp_force_pts = btk::PointCollection::New();
-    auto   fp_moment_pts = btk::PointCollection::New();
-    auto fp_position_pts = btk::PointCollection::New();
-    for(auto platform = force_platform_collection->Begin(); 
-        platform != force_platform_collection->End(); 
-        ++platform) {
-        const auto& calMatrix = (*platform)->GetCalMatrix();
-        const auto& corners   = (*platform)->GetCorners();
-        const auto& origins   = (*platform)->GetOrigin();
-        fpCalMatrices.push_back(convertToSimtkMatrix(calMatrix));
-        fpCorners.push_back(convertToSimtkMatrix(corners));
-        fpOrigins.push_back(convertToSimtkMatrix(origins));
-        fpTypes.push_back(static_cast<unsigned>((*platform)->GetType()));
-
-        // Get ground reaction wrenches for the force platform.
-        auto ground_reaction_wrench_filter = 
-            btk::GroundReactionWrenchFilter::New();
-        ground_reaction_wrench_filter->SetInput(*platform);
-        auto wrench_collection = ground_reaction_wrench_filter->GetOutput();
-        ground_reaction_wrench_filter->Update();
-        
-        for(auto wrench = wrench_collection->Begin();
-            wrench != wrench_collection->End(); 
-            ++wrench) {
-            // Forces time series.
-            fp_force_pts->InsertItem((*wrench)->GetForce());
-            // Moment time series.
-            fp_moment_pts->InsertItem((*wrench)->GetMoment());
-            // Position time series.
-            fp_position_pts->InsertItem((*wrench)->GetPosition());
+        marker_table->updTableMetaData().setValueForKey("events", event_table);
+
+        return marker_table;
+    };
+
+    auto readForces = [&]() -> std::shared_ptr<TimeSeriesTableVec3> {
+        // This is probably the right way to get the raw forces data from
+        // force platforms. Extract the collection of force platforms.
+        auto force_platforms_extractor = btk::ForcePlatformsExtractor::New();
+        force_platforms_extractor->SetInput(acquisition);
+        auto force_platform_collection =
+            force_platforms_extractor->GetOutput();
+        force_platforms_extractor->Update();
+
+        std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
+        std::vector<SimTK::Matrix_<double>> fpCorners{};
+        std::vector<SimTK::Matrix_<double>> fpOrigins{};
+        std::vector<unsigned>               fpTypes{};
+        std::vector<int>                    fpNumbers{};
+        auto    fp_force_pts = btk::PointCollection::New();
+        auto   fp_moment_pts = btk::PointCollection::New();
+        auto fp_position_pts = btk::PointCollection::New();
+        int number{0};
+        for(auto platform = force_platform_collection->Begin(); 
+            platform != force_platform_collection->End(); 
+            ++platform) {
+            ++number;
+            if(!_forcePlatforms.empty() &&
+               std::find(_forcePlatforms.begin(), _forcePlatforms.end(),
+                         number) == _forcePlatforms.end())
+                continue;
+
+            const auto& calMatrix = (*platform)->GetCalMatrix();
+            const auto& corners   = (*platform)->GetCorners();
+            const auto& origins   = (*platform)->GetOrigin();
+            fpCalMatrices.push_back(convertToSimtkMatrix(calMatrix));
+            fpCorners.push_back(convertToSimtkMatrix(corners));
+            fpOrigins.push_back(convertToSimtkMatrix(origins));
+            fpTypes.push_back(static_cast<unsigned>((*platform)->GetType()));
+
+            // Get ground reaction wrenches for the force platform.
+            auto ground_reaction_wrench_filter = 
+                btk::GroundReactionWrenchFilter::New();
+            ground_reaction_wrench_filter->SetInput(*platform);
+            auto wrench_collection = ground_reaction_wrench_filter->GetOutput();
+            ground_reaction_wrench_filter->Update();
+            
+            for(auto wrench = wrench_collection->Begin();
+                wrench != wrench_collection->End(); 
+                ++wrench) {
+                // Forces time series.
+                fp_force_pts->InsertItem((*wrench)->GetForce());
+                // Moment time series.
+                fp_moment_pts->InsertItem((*wrench)->GetMoment());
+                // Position time series.
+                fp_position_pts->InsertItem((*wrench)->GetPosition());
+                fpNumbers.push_back(number);
+            }
         }
-    }
 
-    if(fp_force_pts->GetItemNumber() != 0) {
+        if(fp_force_pts->GetItemNumber() == 0) return nullptr;
 
         std::vector<std::string> labels{};
         ValueArray<std::string> units{};
-        for(int fp = 1; fp <= fp_force_pts->GetItemNumber(); ++fp) {
+        for(int fp : fpNumbers) {
             auto fp_str = std::to_string(fp);
 
             labels.push_back(SimTK::Value<std::string>("f" + fp_str));
@@ -213,73 +304,103 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         std::vector<double> force_times(nf);
         SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
 
-        double time_step{1.0 / acquisition->GetAnalogFrequency()};
+        // Copy one column at a time: force, point and moment of each
+        // platform.
+        auto copyColumn = [&](const btk::Point::Pointer& pt, int col) {
+            const auto& values = pt->GetValues();
+            for(int f = 0; f < nf; ++f)
+                force_matrix(f, col) = SimTK::Vec3{values.coeff(f, 0),
+                                                   values.coeff(f, 1),
+                                                   values.coeff(f, 2)};
+        };
+        int col{0};
+        for(auto fit = fp_force_pts->Begin(),
+            mit =     fp_moment_pts->Begin(),
+            pit =   fp_position_pts->Begin();
+            fit != fp_force_pts->End();
+            ++fit, 
+            ++mit,
+            ++pit) {
+            copyColumn(*fit, col++);
+            copyColumn(*pit, col++);
+            copyColumn(*mit, col++);
+        }
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3> 
-                row{fp_force_pts->GetItemNumber() * 3};
-            int col{0};
-            for(auto fit = fp_force_pts->Begin(),
-                mit =     fp_moment_pts->Begin(),
-                pit =   fp_position_pts->Begin();
-                fit != fp_force_pts->End();
-                ++fit, 
-                ++mit,
-                ++pit) {
-                row[col] = SimTK::Vec3{(*fit)->GetValues().coeff(f, 0),
-                                       (*fit)->GetValues().coeff(f, 1),
-                                       (*fit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*pit)->GetValues().coeff(f, 0),
-                                       (*pit)->GetValues().coeff(f, 1),
-                                       (*pit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*mit)->GetValues().coeff(f, 0),
-                                       (*mit)->GetValues().coeff(f, 1),
-                                       (*mit)->GetValues().coeff(f, 2)};
-                ++col;
-            }
-            force_matrix.updRow(f) = row;
+        double time_step{1.0 / acquisition->GetAnalogFrequency()};
+        for(int f = 0; f < nf;  ++f)
             force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
 
-        auto&  force_table = 
-            *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
+        auto force_table = std::make_shared<TimeSeriesTableVec3>(
+                force_times, force_matrix, labels);
 
         TimeSeriesTableVec3::DependentsMetaData force_dep_metadata
-            = force_table.getDependentsMetaData();
+            = force_table->getDependentsMetaData();
 
         // add units to the dependent meta data
         force_dep_metadata.setValueArrayForKey("units", units);
-        force_table.setDependentsMetaData(force_dep_metadata);
+        force_table->setDependentsMetaData(force_dep_metadata);
 
-        force_table.
+        force_table->
             updTableMetaData().
             setValueForKey("CalibrationMatrices", std::move(fpCalMatrices));
 
-        force_table.
+        force_table->
             updTableMetaData().
             setValueForKey("Corners", std::move(fpCorners));
 
-        force_table.
+        force_table->
             updTableMetaData().
             setValueForKey("Origins", std::move(fpOrigins));
 
-        force_table.
+        force_table->
             updTableMetaData().
             setValueForKey("Types", std::move(fpTypes));
 
-        force_table.
+        force_table->
             updTableMetaData().
             setValueForKey("DataRate",
                 std::to_string(acquisition->GetAnalogFrequency()));
 
-        tables.emplace(_forces,
-            std::shared_ptr<TimeSeriesTableVec3>(&force_table));
-
-        force_table.updTableMetaData().setValueForKey("events", event_table);
+        force_table->updTableMetaData().setValueForKey("events", event_table);
+
+        return force_table;
+    };
+
+    std::shared_ptr<TimeSeriesTableVec3> marker_table{};
+    std::shared_ptr<TimeSeriesTableVec3> force_table{};
+    if(_readMarkers && _readForces && _numThreads != 1) {
+        // Convert the forces on another thread, if one can be started.
+        std::exception_ptr forces_error{};
+        auto convertForces = [&]() {
+            try {
+                force_table = readForces();
+            } catch(...) {
+                forces_error = std::current_exception();
+            }
+        };
+        std::thread forces_thread{};
+        try {
+            forces_thread = std::thread{convertForces};
+        } catch(const std::system_error&) {
+            convertForces();
+        }
+        std::exception_ptr markers_error{};
+        try {
+            marker_table = readMarkers();
+        } catch(...) {
+            markers_error = std::current_exception();
+        }
+        if(forces_thread.joinable()) forces_thread.join();
+        if(markers_error) std::rethrow_exception(markers_error);
+        if(forces_error) std::rethrow_exception(forces_error);
+    } else {
+        if(_readMarkers) marker_table = readMarkers();
+        if(_readForces) force_table = readForces();
     }
 
+    OutputTables tables{};
+    if(marker_table) tables.emplace(_markers, marker_table);
+    if(force_table) tables.emplace(_forces, force_table);
     return tables;
 }
 
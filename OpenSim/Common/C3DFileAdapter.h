@@ -32,6 +32,24 @@ template<typename> class shrik;
 
 namespace OpenSim {
 
+/** Read C3D files (with BTK) into tables of markers and of force-platform
+data.
+
+What is converted can be narrowed, e.g., for pipelines that ingest many
+trials and need only part of each: see setReadMarkers(), setReadForces(),
+setMarkerNames() and setForcePlatforms(). BTK always loads the whole file,
+but the force-platform wrenches (computed from the analog channels) are only
+computed for the platforms read, and only the markers read are copied. The
+markers and the forces of a file can be converted concurrently, and many
+files can be read concurrently with readTables(); see setNumThreads().
+
+@code
+C3DFileAdapter adapter;
+adapter.setReadForces(false);
+adapter.setMarkerNames({"LASI", "RASI", "LPSI", "RPSI"});
+adapter.setNumThreads(8);
+auto trials = adapter.readTables(fileNames);
+@endcode */
 class OSIMCOMMON_API C3DFileAdapter : public FileAdapter {
 public:
     typedef std::vector<Event>                         EventTable; 
@@ -57,6 +75,46 @@ public:
     static
     void write(const Tables& markerTable, const std::string& fileName);
 
+    /** Read the markers table (default: true). */
+    void setReadMarkers(bool readMarkers) { _readMarkers = readMarkers; }
+    bool getReadMarkers() const { return _readMarkers; }
+    /** Read the forces table (default: true). */
+    void setReadForces(bool readForces) { _readForces = readForces; }
+    bool getReadForces() const { return _readForces; }
+    /** Names of the markers to read, in the order of the columns of the
+    markers table (default: empty, all markers in the order of the file).
+    Reading a file that lacks one of these markers throws an Exception. */
+    void setMarkerNames(const std::vector<std::string>& names)
+    {   _markerNames = names; }
+    const std::vector<std::string>& getMarkerNames() const
+    {   return _markerNames; }
+    /** Numbers (starting at 1, in the order of the file) of the force
+    platforms to read (default: empty, all platforms). The columns of a
+    platform keep the labels of its number, e.g., *f2*, *p2* and *m2*.
+    Platforms that are not in a file are ignored. */
+    void setForcePlatforms(const std::vector<int>& numbers)
+    {   _forcePlatforms = numbers; }
+    const std::vector<int>& getForcePlatforms() const
+    {   return _forcePlatforms; }
+    /** Number of threads used to read files concurrently by
+    readTables(const std::vector<std::string>&), or to convert the markers
+    and the forces of a single file concurrently (default: 1); if not
+    positive, the number of hardware threads is used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Read a C3D file as read() does, but only the data selected with this
+    adapter's settings. A table that is not read, or for which the file has
+    no data, is not in the returned Tables. */
+    Tables readTables(const std::string& fileName) const;
+    /** Read many C3D files concurrently (see setNumThreads()), each as
+    readTables(const std::string&) does. The tables are returned in the
+    order of the file names.
+    @throws Exception After all files are read, listing the files that
+            could not be read, if any. */
+    std::vector<Tables> readTables(
+            const std::vector<std::string>& fileNames) const;
+
     static const std::string _markers;
     static const std::string _forces;
 
@@ -69,6 +127,12 @@ protected:
 private:
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
+    bool _readMarkers = true;
+    bool _readForces = true;
+    std::vector<std::string> _markerNames;
+    std::vector<int> _forcePlatforms;
+    int _numThreads = 1;
+
 };
 
 } // namespace OpenSim
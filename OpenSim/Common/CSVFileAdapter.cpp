@@ -26,4 +26,10 @@ CSVFileAdapter::write(const TimeSeriesTable& table,
     CSVFileAdapter{}.extendWrite(tables, fileName);
 }
 
+void 
+CSVFileAdapter::write(const TimeSeriesTableView& view, 
+                        const std::string& fileName) {
+    CSVFileAdapter{}.writeTable(view, fileName);
+}
+
 }
@@ -47,6 +47,12 @@ public:
     /** Write a CSV file.                                                     */
     static
     void write(const TimeSeriesTable& table, const std::string& fileName);
+
+#ifndef SWIG
+    /** Write the rows and columns of a view of a table to a CSV file.        */
+    static
+    void write(const TimeSeriesTableView& view, const std::string& fileName);
+#endif
 };
 
 }
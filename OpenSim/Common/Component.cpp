@@ -26,6 +26,7 @@
 #include "Component.h"
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
+#include <atomic>
 #include <unordered_map>
 #include <set>
 
@@ -78,29 +79,65 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeTopology);
+        _Component.extendRealizeTopology(s);
+    }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeModel);
+        _Component.extendRealizeModel(s);
+    }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeInstance);
+        _Component.extendRealizeInstance(s);
+    }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeTime);
+        _Component.extendRealizeTime(s);
+    }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizePosition);
+        _Component.extendRealizePosition(s);
+    }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeVelocity);
+        _Component.extendRealizeVelocity(s);
+    }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeDynamics);
+        _Component.extendRealizeDynamics(s);
+    }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeAcceleration);
+        _Component.extendRealizeAcceleration(s);
+    }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {
+        ComponentProfiler::Scope scope(_Component,
+                                       ComponentProfiler::RealizeReport);
+        _Component.extendRealizeReport(s);
+    }
 
 private:
     const Component& _Component;
@@ -410,6 +447,9 @@ void Component::baseAddToSystem(SimTK::MultibodySystem& system) const
     // making realize() calls, and add it to the system's default subsystem. 
     ComponentMeasure<double> mcMeasure(system.updDefaultSubsystem(), *this);
     mutableThis->_simTKcomponentIndex = mcMeasure.getSubsystemMeasureIndex();
+
+    if (!_profilerTimings)
+        _profilerTimings.reset(new ComponentProfiler::Timings());
 }
 
 void Component::componentsAddToSystem(SimTK::MultibodySystem& system) const
@@ -460,6 +500,13 @@ void Component::setPropertiesFromState(const SimTK::State& state)
     componentsSetPropertiesFromState(state);
 }
 
+void Component::parameterChanged(SimTK::State& state,
+                                 const AbstractProperty& prop)
+{
+    extendParameterChanged(prop);
+    state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+}
+
 void Component::componentsSetPropertiesFromState(const SimTK::State& state)
 {
     for (unsigned int i = 0; i<_memberSubcomponents.size(); ++i)
@@ -551,13 +598,14 @@ void Component::addStateVariable(Component::StateVariable*  stateVariable) const
     _namedStateVariableInfo[stateVariableName] =
         StateVariableInfo(stateVariable, order);
 
-    const AddedStateVariable* asv =
-        dynamic_cast<const Component::AddedStateVariable *>(stateVariable);
+    AddedStateVariable* asv =
+        dynamic_cast<Component::AddedStateVariable *>(stateVariable);
     // Now automatically add a cache variable to hold the derivative
     // to enable a similar interface for setting and getting the derivatives
     // based on the creator specified state name
     if(asv){
-        addCacheVariable(stateVariableName+"_deriv", 0.0, Stage::Dynamics);
+        asv->derivative = addCacheVariable(stateVariableName+"_deriv", 0.0,
+                                           Stage::Dynamics);
     }
 
 }
@@ -581,6 +629,22 @@ void Component::addDiscreteVariable(const std::string&  discreteVariableName,
         DiscreteVariableInfo(invalidatesStage);
 }
 
+std::vector<std::string> Component::getDiscreteVariableNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& it : _namedDiscreteVariableInfo)
+        names.push_back(it.first);
+    return names;
+}
+
+std::vector<std::string> Component::getModelingOptionNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& it : _namedModelingOptionInfo)
+        names.push_back(it.first);
+    return names;
+}
+
 // Get the value of a ModelingOption flag for this Component.
 int Component::
 getModelingOption(const SimTK::State& s, const std::string& name) const
@@ -905,6 +969,82 @@ void Component::
     throw Exception(msg.str(),__FILE__,__LINE__);
 }
 
+Component::StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const StateVariable* rsv = traverseToStateVariable(name);
+    if (!rsv) {
+        std::stringstream msg;
+        msg << "Component::getStateVariableHandle: ERR- state named '" << name
+            << "' not found in " << getName() << " of type "
+            << getConcreteClassName() << ".\n";
+        throw Exception(msg.str(),__FILE__,__LINE__);
+    }
+
+    StateVariableHandle handle;
+    handle._name = name;
+    handle._stateVariable.reset(rsv);
+    handle._system.reset(&getSystem());
+    return handle;
+}
+
+const Component::StateVariable& Component::
+    getStateVariable(const StateVariableHandle& handle) const
+{
+    if (!handle.isValid() || handle._system.empty() ||
+            !getSystem().isSameSystem(handle._system.getRef())) {
+        std::stringstream msg;
+        msg << "Component::getStateVariable: ERR- handle to state '"
+            << handle.getName() << "' is not valid for the System of "
+            << getName() << " of type " << getConcreteClassName()
+            << ". Call getStateVariableHandle() after initSystem().\n";
+        throw Exception(msg.str(),__FILE__,__LINE__);
+    }
+    return handle._stateVariable.getRef();
+}
+
+double Component::
+    getStateVariableValue(const SimTK::State& s,
+                          const StateVariableHandle& handle) const
+{
+    return getStateVariable(handle).getValue(s);
+}
+
+void Component::
+    setStateVariableValue(SimTK::State& s, const StateVariableHandle& handle,
+                          double value) const
+{
+    getStateVariable(handle).setValue(s, value);
+}
+
+void Component::
+    getStateVariableValues(const SimTK::State& state,
+                           const std::vector<StateVariableHandle>& handles,
+                           SimTK::Vector& values) const
+{
+    const int n = static_cast<int>(handles.size());
+    if (values.size() != n) values.resize(n);
+    for (int i = 0; i < n; ++i) {
+        values[i] = getStateVariable(handles[i]).getValue(state);
+    }
+}
+
+void Component::
+    setStateVariableValues(SimTK::State& state,
+                           const std::vector<StateVariableHandle>& handles,
+                           const SimTK::Vector& values) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(values.size() != static_cast<int>(handles.size()),
+        Exception, "Expected " + std::to_string(handles.size()) +
+        " values but got " + std::to_string(values.size()) + ".");
+    for (int i = 0; i < values.size(); ++i) {
+        getStateVariable(handles[i]).setValue(state, values[i]);
+    }
+}
+
 bool Component::isAllStatesVariablesListValid() const
 {
     int nsv = getNumStateVariables();
@@ -1012,6 +1152,42 @@ void Component::
     }
 }
 
+void Component::
+    setStateVariableDerivativeValue(const State& state,
+                                    const StateVariableHandle& handle,
+                                    double value) const
+{
+    getStateVariable(handle).setDerivative(state, value);
+}
+
+double Component::
+    getStateVariableDerivativeValue(const SimTK::State& state,
+                                    const StateVariableHandle& handle) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    computeStateVariableDerivatives(state);
+    return getStateVariable(handle).getDerivative(state);
+}
+
+void Component::holdStateVariableDerivative(const std::string& name,
+                                            double deriv) const
+{
+    const auto it = _namedStateVariableInfo.find(name);
+    OPENSIM_THROW_IF_FRMOBJ(it == _namedStateVariableInfo.end() ||
+        !dynamic_cast<const AddedStateVariable*>(
+                it->second.stateVariable.get()), Exception,
+        "Cannot hold the derivative of '" + name + "': it is not a state "
+        "variable added by this Component.");
+    _heldStateVariableDerivatives[name] = deriv;
+}
+
+void Component::releaseStateVariableDerivatives() const
+{
+    _heldStateVariableDerivatives.clear();
+}
+
 // Get the value of a discrete variable allocated by this Component by name.
 double Component::
 getDiscreteVariableValue(const SimTK::State& s, const std::string& name) const
@@ -1074,10 +1250,9 @@ bool Component::constructOutputForStateVariable(const std::string& name)
 // helper method to specify the order of subcomponents.
 void Component::setNextSubcomponentInSystem(const Component& sub) const
 {
-    auto it =
-        std::find(_orderedSubcomponents.begin(), _orderedSubcomponents.end(),
-            SimTK::ReferencePtr<const Component>(&sub));
-    if (it == _orderedSubcomponents.end()) {
+    // Model orders all of its components, so look them up by hash rather
+    // than searching the list.
+    if (_orderedSubcomponentSet.insert(&sub).second) {
         _orderedSubcomponents.push_back(SimTK::ReferencePtr<const Component>(&sub));
     }
 }
@@ -1149,6 +1324,8 @@ void Component::markPropertiesAsSubcomponents()
     // or the properties have been modified. In the latter case
     // we must make sure that pointers to old properties are cleared
     _propertySubcomponents.clear();
+    _propertySubcomponentSet.clear();
+    clearSubcomponentCaches();
 
     // Now mark properties that are Components as subcomponents
     //loop over all its properties
@@ -1196,18 +1373,15 @@ void Component::markAsPropertySubcomponent(const Component* component)
 {
     // Only add if the component is not already a part of this Component
     SimTK::ReferencePtr<Component> compRef(const_cast<Component*>(component));
-    auto it =
-        std::find(_propertySubcomponents.begin(), _propertySubcomponents.end(), compRef);
-    if ( it == _propertySubcomponents.end() ){
+    if (_propertySubcomponentSet.insert(component).second) {
         // Must reconstruct the reference pointer in place in order
         // to invoke move constructor from SimTK::Array::push_back 
         // otherwise it will copy and reset the Component pointer to null.
         _propertySubcomponents.push_back(
             SimTK::ReferencePtr<Component>(const_cast<Component*>(component)));
+        clearSubcomponentCaches();
     }
     else{
-        auto compPath = component->getAbsolutePathString();
-        auto foundPath = it->get()->getAbsolutePathString();
         OPENSIM_THROW( ComponentAlreadyPartOfOwnershipTree,
                        component->getName(), getName());
     }
@@ -1223,21 +1397,61 @@ void Component::adoptSubcomponent(Component* subcomponent)
         ComponentAlreadyPartOfOwnershipTree,
         subcomponent->getName(), this->getName());
 
-    //get the top-level component
-    const Component* top = this;
-    while (top->hasOwner())
-        top = &top->getOwner();
-
-    // cycle through all components from the top level component
-    // down to verify the component is not already in the tree
-    for (auto& comp : top->getComponentList<Component>()) {
-        OPENSIM_THROW_IF(subcomponent->hasOwner(),
-            ComponentAlreadyPartOfOwnershipTree,
-            subcomponent->getName(), comp.getName());
-    }
+    // A component in any tree has an owner, so the check above suffices;
+    // walking the whole tree here made adopting n components O(n^2).
 
     subcomponent->setOwner(*this);
     _adoptedSubcomponents.push_back(SimTK::ClonePtr<Component>(subcomponent));
+    clearSubcomponentCaches();
+}
+
+namespace {
+    // Starts at 1 so that it differs from a reset (0) cache version.
+    std::atomic<unsigned long long> subcomponentTreeVersion(1);
+}
+
+void Component::clearSubcomponentCaches() const
+{
+    _subcomponentsByName.clear();
+    ++subcomponentTreeVersion;
+}
+
+unsigned long long Component::getSubcomponentTreeVersion()
+{
+    return subcomponentTreeVersion.load();
+}
+
+const Component* Component::
+    findImmediateSubcomponent(const std::string& name) const
+{
+    if (getNumImmediateSubcomponents() == 0)
+        return nullptr;
+
+    auto& byName = _subcomponentsByName;
+    if (byName.empty()) {
+        // Preserve the precedence of the traversal order (members, then
+        // properties, then adopted subcomponents) for duplicate names.
+        for (auto& compRef : _memberSubcomponents)
+            byName.emplace(compRef->getName(), compRef.get());
+        for (auto& compRef : _propertySubcomponents)
+            byName.emplace(compRef->getName(), compRef.get());
+        for (auto& compRef : _adoptedSubcomponents)
+            byName.emplace(compRef->getName(), compRef.get());
+    }
+
+    auto it = byName.find(name);
+    // A subcomponent may have been renamed since the hash was built.
+    if (it != byName.end() && it->second->getName() == name)
+        return it->second;
+
+    for (const auto& compRef : getImmediateSubcomponents()) {
+        if (compRef->getName() == name) {
+            // The hash is stale; rebuild it on the next lookup.
+            byName.clear();
+            return compRef.get();
+        }
+    }
+    return nullptr;
 }
 
 std::vector<SimTK::ReferencePtr<const Component>> 
@@ -1259,6 +1473,17 @@ std::vector<SimTK::ReferencePtr<const Component>>
     return mySubcomponents;
 }
 
+MemoryUsage Component::estimateMemoryUsage() const
+{
+    // Property subcomponents are counted with the properties.
+    MemoryUsage usage = Super::estimateMemoryUsage();
+    for (const auto& member : _memberSubcomponents)
+        usage += member->estimateMemoryUsage();
+    for (const auto& adopted : _adoptedSubcomponents)
+        usage += adopted->estimateMemoryUsage();
+    return usage;
+}
+
 
 size_t Component::getNumMemberSubcomponents() const
 {
@@ -1341,7 +1566,7 @@ getCacheVariableIndex(const std::string& name) const
     std::map<std::string, CacheInfo>::const_iterator it;
     it = _namedCacheVariableInfo.find(name);
 
-    return it->second.index;
+    return *it->second.index;
 }
 
 Array<std::string> Component::
@@ -1426,7 +1651,7 @@ void Component::extendRealizeTopology(SimTK::State& s) const
         for (it = (mutableThis->_namedCacheVariableInfo).begin(); 
              it != _namedCacheVariableInfo.end(); ++it){
             CacheInfo& ci = it->second;
-            ci.index = subSys.allocateLazyCacheEntry
+            *ci.index = subSys.allocateLazyCacheEntry
                (s, ci.dependsOnStage, ci.prototype->clone());
         }
     }
@@ -1444,8 +1669,14 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
     if(getNumStateVariablesAddedByComponent() > 0) {
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
-        // evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+        // evaluate and set component state derivative values (in cache),
+        // unless all of them are held
+        const auto& held = _heldStateVariableDerivatives;
+        if (int(held.size()) < getNumStateVariablesAddedByComponent()) {
+            ComponentProfiler::Scope scope(*this,
+                    ComponentProfiler::ComputeStateVariableDerivatives);
+            computeStateVariableDerivatives(s);
+        }
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
@@ -1455,11 +1686,13 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
             const StateVariable& sv = *it->second.stateVariable;
             const AddedStateVariable* asv = 
                 dynamic_cast<const AddedStateVariable*>(&sv);
-            if(asv)
+            if(asv) {
                 // set corresponding system derivative value from
-                // cached value
+                // held or cached value
+                const auto h = held.find(it->first);
                 subSys.updZDot(s)[ZIndex(asv->getVarIndex())] =
-                    asv->getDerivative(s);
+                    h != held.end() ? h->second : asv->getDerivative(s);
+            }
         }
     }
 }
@@ -1527,13 +1760,13 @@ void Component::AddedStateVariable::setValue(SimTK::State& state, double value)
 double Component::AddedStateVariable::
     getDerivative(const SimTK::State& state) const
 {
-    return getOwner().getCacheVariableValue<double>(state, getName()+"_deriv");
+    return getOwner().getCacheVariableValue(state, derivative);
 }
 
 void Component::AddedStateVariable::
     setDerivative(const SimTK::State& state, double deriv) const
 {
-    return getOwner().setCacheVariableValue<double>(state, getName()+"_deriv", deriv);
+    return getOwner().setCacheVariableValue(state, derivative, deriv);
 }
 
 
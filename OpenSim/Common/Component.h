@@ -49,7 +49,12 @@
 #include "OpenSim/Common/Array.h"
 #include "ComponentList.h"
 #include "ComponentPath.h"
+#include "ComponentProfiler.h"
 #include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "simbody/internal/MultibodySystem.h"
 
@@ -229,6 +234,69 @@ public:
     }
 };
 
+//==============================================================================
+//                            CACHE VARIABLE HANDLE
+//==============================================================================
+/**
+ * A typed handle to a cache variable allocated by a Component. The handle is
+ * returned by Component::addCacheVariable() (typically called from within
+ * extendAddToSystem()) and can be stored by the Component (as a mutable
+ * member) to access the cache variable without a name lookup. Once the
+ * System's Topology has been realized, the handle refers directly to the
+ * SimTK::CacheEntryIndex of the cache variable, so that accessing the cache
+ * variable through the handle is O(1) and does not construct or compare any
+ * strings.
+ *
+ * @code
+ * // in the class declaration
+ * mutable CacheVariable<double> _lengthCV;
+ * // in extendAddToSystem()
+ * _lengthCV = addCacheVariable("length", 0.0, SimTK::Stage::Position);
+ * // anywhere after initSystem()
+ * if (!isCacheVariableValid(s, _lengthCV)) {
+ *     setCacheVariableValue(s, _lengthCV, computeLength(s));
+ * }
+ * const double& length = getCacheVariableValue(s, _lengthCV);
+ * @endcode
+ *
+ * A default-constructed handle does not refer to any cache variable. The
+ * handle is invalidated when the Component's System resources are cleared
+ * (e.g., by finalizeFromProperties()), after which it must be obtained again
+ * from addCacheVariable().
+ */
+template <typename T>
+class CacheVariable {
+public:
+    CacheVariable() = default;
+
+    /** The name of the cache variable given to addCacheVariable(). */
+    const std::string& getName() const { return _name; }
+
+    /** Whether or not this handle refers to a cache variable whose entry has
+    been allocated in the State (i.e., after the System's Topology has been
+    realized). */
+    bool isValid() const { return _index && _index->isValid(); }
+
+#ifndef SWIG
+    /** The SimTK::CacheEntryIndex of the cache variable. This is invalid
+    until the System's Topology has been realized. */
+    SimTK::CacheEntryIndex getIndex() const
+    {   return _index ? *_index : SimTK::CacheEntryIndex(); }
+#endif
+
+private:
+    friend class Component;
+    CacheVariable(const std::string& name,
+                  std::shared_ptr<const SimTK::CacheEntryIndex> index)
+    :   _name(name), _index(std::move(index)) {}
+
+    std::string _name;
+    // Shared with the Component's bookkeeping of the cache variable so that
+    // the index is visible to the handle once it is allocated in
+    // extendRealizeTopology().
+    std::shared_ptr<const SimTK::CacheEntryIndex> _index;
+};
+
 //==============================================================================
 //                            OPENSIM COMPONENT
 //==============================================================================
@@ -472,6 +540,37 @@ public:
     /** %Set Component's properties given a state. */
     void setPropertiesFromState(const SimTK::State& state);
 
+    /** %Set the value of a parameter-only property of this Component (see
+    AbstractProperty::isParameterOnly()) without invalidating the
+    Component's finalized properties or the System it has already added
+    itself to. Use this to change, e.g., a Muscle's max_isometric_force
+    between evaluations in an optimization: a full finalizeFromProperties()
+    and initSystem() is not needed. The cache entries of the provided
+    \a state at Stage::Instance and above are invalidated, since they may
+    depend on the new value; other States of the same System must be
+    invalidated by the caller (e.g., with
+    SimTK::State::invalidateAllCacheAtOrAbove(SimTK::Stage::Instance)).
+    Changing a topology-affecting property this way is an error; use the
+    property's set_<name>() method, then finalizeFromProperties() and
+    initSystem().
+
+    @throws Exception if the property is not parameter-only.
+    @see extendParameterChanged() */
+    template <typename T>
+    void setParameterValue(SimTK::State& state, const std::string& name,
+                           const T& value) {
+        const bool wasUpToDate = isObjectUpToDateWithProperties();
+        AbstractProperty& prop = updPropertyByName(name);
+        if (wasUpToDate) setObjectIsUpToDateWithProperties();
+        OPENSIM_THROW_IF_FRMOBJ(!prop.isParameterOnly(), Exception,
+                "Property '" + name + "' is not parameter-only; set it with "
+                "set_" + name + "(), then call finalizeFromProperties() and "
+                "initSystem().");
+        Property<T>::updAs(prop).setValue(value);
+        prop.setValueIsDefault(false);
+        parameterChanged(state, prop);
+    }
+
     // End of Component Structural Interface (public non-virtual).
     ///@} 
 
@@ -594,8 +693,7 @@ public:
     ComponentList<const T> getComponentList() const {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
-        return ComponentList<const T>(*this);
+        return ComponentList<const T>(*this, getSubcomponentsOfType<T>());
     }
     
     /** Similar to getComponentList(), except the resulting list allows one to
@@ -617,27 +715,20 @@ public:
     ComponentList<T> updComponentList() {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
+        auto flattened = getSubcomponentsOfType<T>();
         clearObjectIsUpToDateWithProperties();
-        return ComponentList<T>(*this);
+        return ComponentList<T>(*this, std::move(flattened));
     }
 
     /**
-     * Uses getComponentList<T>() to count the number of underlying
-     * subcomponents of the specified type.
+     * Count the number of underlying subcomponents of the specified type
+     * (i.e., the number of components in getComponentList<T>()).
      *
      * @tparam T A subclass of Component (e.g., Body, Muscle).
      */
     template <typename T = Component>
     unsigned countNumComponents() const {
-        unsigned count = 0u;
-        const auto compList = getComponentList<T>();
-        auto it = compList.begin();
-        while (it != compList.end()) {
-            ++count;
-            ++it;
-        }
-        return count;
+        return static_cast<unsigned>(getSubcomponentsOfType<T>()->size());
     }
 
     /** Class that permits iterating over components/subcomponents (but does
@@ -1165,6 +1256,39 @@ public:
 
 
 
+protected:
+    class StateVariable;
+
+public:
+#ifndef SWIG // StateVariable is protected.
+    /** A handle to a state variable of this Component or of one of its
+    subcomponents, obtained from getStateVariableHandle(). The handle resolves
+    the (path) name of the state variable once, so that subsequent access in
+    getStateVariableValue(), setStateVariableValue(), and
+    getStateVariableValues() reads or writes the state variable's slot
+    directly, without parsing the name or traversing the component tree.
+    A handle to a state variable added by a Component can also be used to set
+    its derivative in computeStateVariableDerivatives(); a Component typically
+    obtains handles to its own state variables in extendAddToSystem(), right
+    after adding them.
+    A handle is only valid for the System it was obtained from; it must be
+    obtained again after the System is rebuilt (e.g., by initSystem()). */
+    class StateVariableHandle {
+    public:
+        StateVariableHandle() = default;
+        /** The name of the state variable (relative to the Component that
+        provided the handle). */
+        const std::string& getName() const { return _name; }
+        /** Whether or not this handle refers to a state variable. */
+        bool isValid() const { return !_stateVariable.empty(); }
+    private:
+        friend class Component;
+        std::string _name;
+        SimTK::ReferencePtr<const StateVariable> _stateVariable;
+        SimTK::ReferencePtr<const SimTK::System> _system;
+    };
+#endif
+
     /** @name Component State Access methods
         Get and set modeling option, input and output values, state variable, 
         discrete and/or cache variables in the State.
@@ -1265,6 +1389,71 @@ public:
      */
     void setStateVariableValue(SimTK::State& state, const std::string& name, double value) const;
 
+#ifndef SWIG // StateVariableHandle is not wrapped.
+    /**
+     * Resolve the name of a state variable of this Component or of its
+     * subcomponents to a handle, which can be used to get or set the value of
+     * the state variable without a (path) name lookup. The handle is valid
+     * until the System is rebuilt.
+     *
+     * @param name   the name (or path) of the state variable, as accepted by
+     *               getStateVariableValue()
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if the state variable could not be found
+     */
+    StateVariableHandle
+        getStateVariableHandle(const std::string& name) const;
+
+    /**
+     * Get the value of a state variable given its handle.
+     *
+     * @param state   the State for which to get the value
+     * @param handle  a handle from getStateVariableHandle()
+     * @throws Exception if the handle is not valid for the current System
+     */
+    double getStateVariableValue(const SimTK::State& state,
+                                 const StateVariableHandle& handle) const;
+
+    /**
+     * %Set the value of a state variable given its handle.
+     *
+     * @param state   the State for which to set the value
+     * @param handle  a handle from getStateVariableHandle()
+     * @param value   the value to set
+     * @throws Exception if the handle is not valid for the current System
+     */
+    void setStateVariableValue(SimTK::State& state,
+                               const StateVariableHandle& handle,
+                               double value) const;
+
+    /**
+     * Get the values of the state variables referred to by a list of handles.
+     *
+     * @param state    the State for which to get the values
+     * @param handles  handles from getStateVariableHandle()
+     * @param values   resized (if necessary) to the number of handles and
+     *                 filled with the values, in the order of the handles
+     * @throws Exception if any handle is not valid for the current System
+     */
+    void getStateVariableValues(const SimTK::State& state,
+            const std::vector<StateVariableHandle>& handles,
+            SimTK::Vector& values) const;
+
+    /**
+     * %Set the values of the state variables referred to by a list of
+     * handles.
+     *
+     * @param state    the State for which to set the values
+     * @param handles  handles from getStateVariableHandle()
+     * @param values   values, in the order of the handles
+     * @throws Exception if any handle is not valid for the current System
+     */
+    void setStateVariableValues(SimTK::State& state,
+            const std::vector<StateVariableHandle>& handles,
+            const SimTK::Vector& values) const;
+#endif
+
 
     /**
      * Get all values of the state variables allocated by this Component.
@@ -1309,6 +1498,41 @@ public:
     double getStateVariableDerivativeValue(const SimTK::State& state, 
         const std::string& name) const;
 
+#ifndef SWIG // StateVariableHandle is not wrapped.
+    /**
+     * Get the value of a state variable derivative computed by this
+     * Component, given the state variable's handle.
+     *
+     * @param state   the State for which to get the derivative value
+     * @param handle  a handle from getStateVariableHandle()
+     * @throws Exception if the handle is not valid for the current System
+     */
+    double getStateVariableDerivativeValue(const SimTK::State& state,
+        const StateVariableHandle& handle) const;
+#endif
+
+    /**
+     * Use the given value as the derivative of a state variable added by
+     * this Component, rather than computing it, whenever the Acceleration
+     * stage is realized, until releaseStateVariableDerivatives() is called;
+     * the Manager's multirate integration uses this to advance slow state
+     * variables with a larger step (see Manager::setMultirateMacroStep()).
+     * The value is used for every State of this Component's System. If the
+     * derivatives of all of the state variables added by this Component are
+     * held, computeStateVariableDerivatives() is not called when the
+     * Acceleration stage is realized.
+     *
+     * @param name    the name of a state variable added by this Component
+     *                (not a Coordinate's value or speed)
+     * @param deriv   the derivative value to use
+     * @throws Exception if this Component added no such state variable
+     */
+    void holdStateVariableDerivative(const std::string& name,
+                                     double deriv) const;
+    /** Compute the derivatives held by holdStateVariableDerivative() again,
+    from the next realization of the Acceleration stage. */
+    void releaseStateVariableDerivatives() const;
+
     /**
      * Get the value of a discrete variable allocated by this Component by name.
      *
@@ -1333,6 +1557,18 @@ public:
     void setDiscreteVariableValue(SimTK::State& state, const std::string& name,
                                   double value) const;
 
+    /**
+     * Get the names of the discrete variables allocated by this Component
+     * (not by its subcomponents), as accepted by getDiscreteVariableValue().
+     */
+    std::vector<std::string> getDiscreteVariableNames() const;
+
+    /**
+     * Get the names of the modeling options allocated by this Component
+     * (not by its subcomponents), as accepted by getModelingOption().
+     */
+    std::vector<std::string> getModelingOptionNames() const;
+
     /**
      * Get the value of a cache variable allocated by this Component by name.
      *
@@ -1352,7 +1588,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             return SimTK::Value<T>::downcast(
                 getDefaultSubsystem().getCacheEntry(state, ceIndex)).get();
         } else {
@@ -1385,7 +1621,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             return SimTK::Value<T>::downcast(
                 getDefaultSubsystem().updCacheEntry(state, ceIndex)).upd();
         }
@@ -1421,7 +1657,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             getDefaultSubsystem().markCacheValueRealized(state, ceIndex);
         }
         else{
@@ -1461,7 +1697,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             getDefaultSubsystem().markCacheValueNotRealized(state, ceIndex);
         }
         else{
@@ -1494,7 +1730,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             return getDefaultSubsystem().isCacheValueRealized(state, ceIndex);
         }
         else{
@@ -1528,7 +1764,7 @@ public:
         it = _namedCacheVariableInfo.find(name);
 
         if(it != _namedCacheVariableInfo.end()) {
-            SimTK::CacheEntryIndex ceIndex = it->second.index;
+            SimTK::CacheEntryIndex ceIndex = *it->second.index;
             SimTK::Value<T>::downcast(
                 getDefaultSubsystem().updCacheEntry( state, ceIndex)).upd() 
                 = value;
@@ -1542,6 +1778,68 @@ public:
             throw Exception(msg.str(),__FILE__,__LINE__);
         }   
     }
+    /** @name Cache variable access through handles
+    These overloads provide O(1) access to a cache variable through the
+    CacheVariable handle returned by addCacheVariable(); they have the same
+    semantics as the corresponding name-based methods above, but do not
+    perform a name lookup. The handle must have been obtained from this
+    Component. */
+    //@{
+    /** Get the value of a cache variable through its handle. */
+    template<typename T> const T&
+    getCacheVariableValue(const SimTK::State& state,
+                          const CacheVariable<T>& cv) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().getCacheEntry(
+                state, getCacheVariableIndex(cv))).get();
+    }
+    /** Obtain a writable cache variable value through its handle. Do not
+    forget to mark the cache value as valid after updating. */
+    template<typename T> T&
+    updCacheVariableValue(const SimTK::State& state,
+                          const CacheVariable<T>& cv) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().updCacheEntry(
+                state, getCacheVariableIndex(cv))).upd();
+    }
+    /** Mark the value of a cache variable as valid through its handle. */
+    template<typename T> void
+    markCacheVariableValid(const SimTK::State& state,
+                           const CacheVariable<T>& cv) const
+    {
+        getDefaultSubsystem().markCacheValueRealized(state,
+                getCacheVariableIndex(cv));
+    }
+    /** Mark the value of a cache variable as invalid through its handle. */
+    template<typename T> void
+    markCacheVariableInvalid(const SimTK::State& state,
+                             const CacheVariable<T>& cv) const
+    {
+        getDefaultSubsystem().markCacheValueNotRealized(state,
+                getCacheVariableIndex(cv));
+    }
+    /** Whether or not the value of a cache variable is valid, through its
+    handle. */
+    template<typename T> bool
+    isCacheVariableValid(const SimTK::State& state,
+                         const CacheVariable<T>& cv) const
+    {
+        return getDefaultSubsystem().isCacheValueRealized(state,
+                getCacheVariableIndex(cv));
+    }
+    /** %Set the value of a cache variable through its handle, which also
+    marks the cache variable as valid. */
+    template<typename T> void
+    setCacheVariableValue(const SimTK::State& state,
+                          const CacheVariable<T>& cv, const T& value) const
+    {
+        const SimTK::CacheEntryIndex ceIndex = getCacheVariableIndex(cv);
+        SimTK::Value<T>::downcast(
+            getDefaultSubsystem().updCacheEntry(state, ceIndex)).upd() = value;
+        getDefaultSubsystem().markCacheValueRealized(state, ceIndex);
+    }
+    //@}
+
     // End of Model Component State Accessors.
     //@} 
 
@@ -1615,10 +1913,12 @@ public:
     /// @}
 
 protected:
-    class StateVariable;
     //template <class T> friend class ComponentSet;
     // Give the ComponentMeasure access to the realize() methods.
     template <class T> friend class ComponentMeasure;
+    // Give the ComponentProfiler access to the Timings of each Component.
+    friend class ComponentProfiler;
+    friend class ComponentProfiler::Scope;
 
 #ifndef SWIG
     /// @class MemberSubcomponentIndex
@@ -1633,6 +1933,7 @@ protected:
         component->setName(name);
         component->setOwner(*this);
         _memberSubcomponents.push_back(SimTK::ClonePtr<Component>(component));
+        clearSubcomponentCaches();
         return MemberSubcomponentIndex(_memberSubcomponents.size()-1);
     }
     template<class C = Component>
@@ -1680,6 +1981,12 @@ protected:
     std::vector<SimTK::ReferencePtr<const Component>>
         getImmediateSubcomponents() const;
 
+    /** Estimate the memory held by this Component and all of its
+    subcomponents (see Object::estimateMemoryUsage()), including those that
+    are data members of, or were adopted by, a Component. Call this on a
+    subcomponent for the memory of its subtree. */
+    MemoryUsage estimateMemoryUsage() const override;
+
     /** @name  Component Extension Interface
     The interface ensures that deserialization, resolution of inter-connections,
     and handling of dependencies are performed systematically and prior to 
@@ -1910,6 +2217,28 @@ protected:
     @see extendInitStateFromProperties() **/
     virtual void extendSetPropertiesFromState(const SimTK::State& state) {};
 
+    /** Update any data this component derived from the value of a
+    parameter-only property (see AbstractProperty::isParameterOnly()) after
+    the property was changed by setParameterValue(). This is only needed if
+    the component copies the property's value into a member variable (e.g.,
+    in extendFinalizeFromProperties() or extendConnectToModel()); components
+    that read the property each time they use it need not override this.
+
+    If you override this method, be sure to invoke the base class method
+    first, using code like this:
+    @code
+    void MyComponent::extendParameterChanged(const AbstractProperty& prop) {
+        Super::extendParameterChanged(prop); // invoke parent class method
+        if (prop.getName() == "stiffness") _stiffness = get_stiffness();
+    }
+    @endcode
+
+    @param      property
+        The parameter-only property, which already has its new value.
+
+    @see setParameterValue() **/
+    virtual void extendParameterChanged(const AbstractProperty& property) {};
+
     /** If a model component has allocated any continuous state variables
     using the addStateVariable() method, then %computeStateVariableDerivatives()
     must be implemented to provide time derivatives for those states.
@@ -1935,6 +2264,20 @@ protected:
     }
     @endcode
 
+    Setting the derivative by name looks the name up every time the
+    derivatives are computed (i.e., at every stage of the integrator); a
+    Component whose derivatives are computed often should instead keep a
+    handle to each of its state variables, obtained in extendAddToSystem():
+    @code
+    // in the class declaration
+    mutable StateVariableHandle _activationSV;
+    // in extendAddToSystem(), after Super::extendAddToSystem(system)
+    addStateVariable("activation");
+    _activationSV = getStateVariableHandle("activation");
+    // in computeStateVariableDerivatives()
+    setStateVariableDerivativeValue(state, _activationSV, deriv);
+    @endcode
+
     For subclasses, it is highly recommended that you first call
     Super::computeStateVariableDerivatives(state) to preserve the derivative
     computation of the parent class and to only specify the derivatives of the state
@@ -1956,6 +2299,23 @@ protected:
     void setStateVariableDerivativeValue(const SimTK::State& state, 
                             const std::string& name, double deriv) const;
 
+#ifndef SWIG // StateVariableHandle is not wrapped.
+    /**
+     * %Set the derivative of a state variable, given its handle, when
+     * computed inside of this Component's computeStateVariableDerivatives()
+     * method. Unlike setting it by name, this does not look up the state
+     * variable or its derivative's cache variable.
+     *
+     * @param state   the State for which to set the value
+     * @param handle  a handle from getStateVariableHandle() to a state
+     *                variable added with addStateVariable()
+     * @param deriv   the derivative value to set
+     * @throws Exception if the handle is not valid for the current System
+     */
+    void setStateVariableDerivativeValue(const SimTK::State& state,
+            const StateVariableHandle& handle, double deriv) const;
+#endif
+
 
     // End of Component Extension Interface (protected virtuals).
     ///@} 
@@ -2118,16 +2478,19 @@ protected:
     @param[in]      dependsOnStage      
         This is the highest computational stage on which this cache entry's
         value computation depends. State changes at this level or lower will
-        invalidate the cache entry. **/ 
-    template <class T> void 
+        invalidate the cache entry.
+    @return A CacheVariable handle that can be kept by the Component to access
+        the cache variable without a name lookup. **/ 
+    template <class T> CacheVariable<T>
     addCacheVariable(const std::string&     cacheVariableName,
                      const T&               variablePrototype, 
                      SimTK::Stage           dependsOnStage) const
     {
         // Note, cache index is invalid until the actual allocation occurs 
         // during realizeTopology.
-        _namedCacheVariableInfo[cacheVariableName] = 
+        CacheInfo& ci = _namedCacheVariableInfo[cacheVariableName] = 
             CacheInfo(new SimTK::Value<T>(variablePrototype), dependsOnStage);
+        return CacheVariable<T>(cacheVariableName, ci.index);
     }
 
     
@@ -2165,6 +2528,26 @@ protected:
     const SimTK::CacheEntryIndex 
     getCacheVariableIndex(const std::string& name) const;
 
+    /** Get the index of a Component's cache variable in the Subsystem from
+        its handle, without a name lookup.
+        @throws ComponentHasNoSystem if this Component has not been added to a
+                System (i.e., if initSystem has not been called) */
+    template <typename T>
+    SimTK::CacheEntryIndex
+    getCacheVariableIndex(const CacheVariable<T>& cv) const
+    {
+        OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+        if (!cv.isValid()) {
+            std::stringstream msg;
+            msg << "Component::getCacheVariableIndex: ERR- cache variable '"
+                << cv.getName() << "' has not been allocated.\n "
+                << "for component '"<< getName() << "' of type "
+                << getConcreteClassName();
+            throw Exception(msg.str(),__FILE__,__LINE__);
+        }
+        return *cv._index;
+    }
+
     // End of System Creation and Access Methods.
     //@} 
 
@@ -2289,21 +2672,19 @@ protected:
     {
         const Component* current = this;
         ComponentPath pathToFind(path);
-        std::string pathNameToFind = pathToFind.getComponentName();
-        size_t numPathLevels = pathToFind.getNumPathLevels();
+        const std::string pathNameToFind = pathToFind.getComponentName();
+        const size_t numPathLevels = pathToFind.getNumPathLevels();
         size_t ind = 0;
-        ComponentPath currentSubpath;
-        ComponentPath upPath("..");
-        ComponentPath curCompPath(".");
+        std::string currentSubpath;
 
         while (ind < numPathLevels && current) {
-            currentSubpath = ComponentPath(pathToFind.getSubcomponentNameAtLevel(ind));
-            ComponentPath currentPathName(current->getName());
+            currentSubpath = pathToFind.getSubcomponentNameAtLevel(ind);
 
-            if (currentSubpath == upPath && current->hasOwner())
+            if (currentSubpath == ".." && current->hasOwner())
                 current = &current->getOwner();
-            // if currentPathName matches currentSubpath traversing the path
-            else if (currentPathName == currentSubpath) {
+            // if the current component's name matches currentSubpath we are
+            // already at this level of the path
+            else if (current->getName() == currentSubpath) {
                 ind++;
                 continue;
             }
@@ -2311,36 +2692,14 @@ protected:
             // comp
             // if currentSubpath is '.' we are in the right owner, and loop
             // again so that currentSubpath is the name of the component we want
-            else if (!currentSubpath.toString().empty() && currentSubpath != curCompPath) {
-                if (current->getNumImmediateSubcomponents() == 0) {
-                    current = nullptr;
-                    continue;
-                }
-                auto compsList = current->getComponentList<Component>();
+            else if (!currentSubpath.empty() && currentSubpath != ".") {
                 // descend to next component in the path otherwise not found
-                ComponentPath currentAbsPathPlusSubpath = current->getAbsolutePath();
-                currentAbsPathPlusSubpath.pushBack(currentSubpath.toString());
-                for (const Component& comp : compsList) {
-                    ComponentPath compAbsPath = comp.getAbsolutePath();
-                    std::string compName = comp.getName();
-                    // Check if we're in the right component
-                    if (compAbsPath == currentAbsPathPlusSubpath) {
-                        // In the right component and has matching name
-                        // update current to this comp
-                        current = &comp;
-                        if (compName == pathNameToFind) {
-                            // now verify type
-                            const C* compC = dynamic_cast<const C*>(&comp);
-                            if (compC)
-                                return  compC;
-                            else // keep traversing this list
-                                continue;
-                        } 
-                        // get out of this list and start going down the new current
-                        break;
-                    }
-                    // No match in this component
-                    current = nullptr;
+                current = current->findImmediateSubcomponent(currentSubpath);
+                if (current && currentSubpath == pathNameToFind) {
+                    // now verify type
+                    const C* compC = dynamic_cast<const C*>(current);
+                    if (compC)
+                        return compC;
                 }
             }
             ind++;
@@ -2352,6 +2711,54 @@ protected:
         return nullptr;
     }
 
+    /** Get the subcomponents (immediate and otherwise, excluding this
+    Component) of type T in tree pre-order traversal order. The list is
+    computed on first request for a given type and cached until the
+    subcomponents of this Component (or of any of its subcomponents) change.
+    */
+    template <typename T>
+    std::shared_ptr<const std::vector<const Component*>>
+    getSubcomponentsOfType() const {
+        typedef typename std::remove_const<T>::type NonConstT;
+        // Subcomponents might have been added anywhere in the tree (possibly
+        // before owners were assigned), so any change invalidates the lists.
+        const unsigned long long treeVersion = getSubcomponentTreeVersion();
+        if (_subcomponentsByTypeVersion != treeVersion) {
+            _subcomponentsByType.clear();
+            _subcomponentsByTypeVersion = treeVersion;
+        }
+        auto& flattened = _subcomponentsByType[std::type_index(typeid(NonConstT))];
+        if (!flattened) {
+            initComponentTreeTraversal(*this);
+            auto comps = std::make_shared<std::vector<const Component*>>();
+            for (const NonConstT& comp : ComponentList<const NonConstT>(*this))
+                comps->push_back(&comp);
+            flattened = std::move(comps);
+        }
+        return flattened;
+    }
+
+    /** Let this Component update its data derived from the parameter-only
+    property that setParameterValue() changed, and invalidate the cache
+    entries of the state that may depend on it. */
+    void parameterChanged(SimTK::State& state, const AbstractProperty& prop);
+
+    /** Clear the cache of subcomponents by name of this Component and
+    invalidate the caches of subcomponents by type of all Components. This
+    must be invoked whenever the lists of subcomponents of this Component
+    change. */
+    void clearSubcomponentCaches() const;
+
+    /** A counter that is incremented whenever the subcomponents of any
+    Component change. */
+    static unsigned long long getSubcomponentTreeVersion();
+
+    /** Find the immediate subcomponent (member, property, or adopted) with
+    the given name. Returns nullptr if there is no such subcomponent. The
+    lookup uses a hash of the immediate subcomponents by name, which is
+    (re)built lazily whenever the list of subcomponents changes. */
+    const Component* findImmediateSubcomponent(const std::string& name) const;
+
 public:
 #ifndef SWIG // StateVariable is protected.
     /**
@@ -2475,7 +2882,8 @@ protected:
         return constructOutput<T>(name, outputFunc, dependsOn);
     }
     /** This variant handles component member functions that return the
-     * output value by const reference (const T&). 
+     * output value by const reference (const T&). The Output's getValue()
+     * then returns this reference without copying the value.
      * @warning ONLY use this with member functions that fetch quantities that
      * are stored within the passed-in SimTK::State. The function cannot return
      * local variables. */
@@ -2489,11 +2897,11 @@ protected:
         // This lambda takes a pointer to a component, downcasts it to the
         // appropriate derived type, then calls the member function of the
         // derived type. Thank you, klshrinidhi!
-        auto outputFunc = [memFunc] (const Component* comp,
-                const SimTK::State& s, const std::string&, T& result) -> void {
-            result = std::mem_fn(memFunc)(dynamic_cast<const CompType*>(comp), s);
+        auto outputRefFunc = [memFunc] (const Component* comp,
+                const SimTK::State& s, const std::string&) -> const T& {
+            return std::mem_fn(memFunc)(dynamic_cast<const CompType*>(comp), s);
         };
-        return constructOutput<T>(name, outputFunc, dependsOn);
+        return constructOutputByReference<T>(name, outputRefFunc, dependsOn);
     }
     /** Construct an output that can have multiple channels. You add Channels
     to this Output in extendFinalizeFromProperties() using
@@ -2521,6 +2929,27 @@ protected:
         };
         return constructOutput<T>(name, outputFunc, dependsOn, true);
     }
+    /** This variant handles list outputs whose member function returns the
+     * value of a channel by const reference (const T&). The same warning as
+     * for the single-value variant applies: the returned reference must be to
+     * a quantity stored within the passed-in SimTK::State. */
+    template <typename T, typename CompType>
+    bool constructListOutput(const std::string& name,
+             const T& (CompType::*const memFunc)(const SimTK::State&,
+                                          const std::string& channel) const,
+            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+        static_assert(std::is_base_of<Component, CompType>::value,
+            "Template parameter 'CompType' must be derived from Component.");
+
+        auto outputRefFunc = [memFunc] (const Component* comp,
+                const SimTK::State& s, const std::string& channel)
+                -> const T& {
+            return std::mem_fn(memFunc)(
+                    dynamic_cast<const CompType*>(comp), s, channel);
+        };
+        return constructOutputByReference<T>(name, outputRefFunc, dependsOn,
+                                             true);
+    }
 #endif
 
     /** Construct an Output for a StateVariable. While this method is a
@@ -2628,6 +3057,32 @@ private:
         return true;
     }
 
+    /** Used internally to construct outputs whose function provides the
+     value by const reference, so that the Output's getValue() need not copy
+     the value. The same caveats as for constructOutput() above apply. */
+    template <typename T>
+    bool constructOutputByReference(const std::string& name,
+            const typename Output<T>::ReferenceFunction& outputRefFunction,
+            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration,
+            bool isList = false) {
+
+        OPENSIM_THROW_IF(_outputsTable.count(name), Exception,
+            getConcreteClassName() + " already has an output named '"
+            + name + "'.");
+
+        // Clients that fill their own storage (e.g., OutputBatch) use the
+        // copying form of the function.
+        auto outputFunc = [outputRefFunction] (const Component* comp,
+                const SimTK::State& s, const std::string& channel, T& result)
+                -> void {
+            result = outputRefFunction(comp, s, channel);
+        };
+        _outputsTable[name].reset(new Output<T>(name, outputFunc, dependsOn,
+                                                isList, outputRefFunction));
+        return true;
+    }
+
+protected:
     // Get the number of continuous states that the Component added to the 
     // underlying computational system. It includes the number of built-in states  
     // exposed by this component. It represents the number of state variables  
@@ -2636,6 +3091,8 @@ private:
     {   return (int)_namedStateVariableInfo.size(); }
     Array<std::string> getStateVariablesNamesAddedByComponent() const;
 
+private:
+
     const SimTK::DefaultSystemSubsystem& getDefaultSubsystem() const
         {   return getSystem().getDefaultSubsystem(); }
     SimTK::DefaultSystemSubsystem& updDefaultSubsystem() const
@@ -2745,6 +3202,7 @@ protected:
     /// form the ordered list using setNextSubcomponentInSystem() above.
     void resetSubcomponentOrder() {
         _orderedSubcomponents.clear();
+        _orderedSubcomponentSet.clear();
     }
 
     /// Handle a change in XML syntax for Sockets.
@@ -2784,11 +3242,40 @@ private:
     // list of subcomponents that are contained in this Component's properties
     SimTK::ResetOnCopy<SimTK::Array_<SimTK::ReferencePtr<Component>>>
         _propertySubcomponents;
+    // The same subcomponents, hashed, to reject duplicates without searching.
+    SimTK::ResetOnCopy<std::unordered_set<const Component*>>
+        _propertySubcomponentSet;
     // Keep fixed list of data member Components upon construction
     SimTK::Array_<SimTK::ClonePtr<Component> > _memberSubcomponents;
     // Hold onto adopted components
     SimTK::Array_<SimTK::ClonePtr<Component> > _adoptedSubcomponents;
 
+    // Immediate subcomponents (of all three kinds above) hashed by name, for
+    // fast path traversal. Built lazily by findImmediateSubcomponent() and
+    // cleared whenever any of the lists of subcomponents change.
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::string,
+                                                  const Component*>>
+        _subcomponentsByName;
+
+    // Flattened lists of subcomponents by (requested) type, for fast
+    // iteration with getComponentList<T>(). See getSubcomponentsOfType().
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::type_index,
+            std::shared_ptr<const std::vector<const Component*>>>>
+        _subcomponentsByType;
+    // Value of getSubcomponentTreeVersion() when _subcomponentsByType was
+    // filled; 0 (never a valid version) after copying.
+    mutable SimTK::ResetOnCopy<unsigned long long> _subcomponentsByTypeVersion;
+
+    // Derivatives of added state variables held by
+    // holdStateVariableDerivative(), by name.
+    mutable SimTK::ResetOnCopy<std::map<std::string, double>>
+        _heldStateVariableDerivatives;
+
+    // Call counts and times of this Component's operations, collected while
+    // the ComponentProfiler is enabled. Allocated in baseAddToSystem().
+    mutable SimTK::ResetOnCopy<std::shared_ptr<ComponentProfiler::Timings>>
+        _profilerTimings;
+
     // A flat list of subcomponents (immediate and otherwise) under this
     // Component. This list must be populated prior to addToSystem(), and is
     // used strictly to specify the order in which addToSystem() is invoked
@@ -2802,6 +3289,9 @@ private:
     // If the Component does not reset the list, it is by default the ownership
     // tree order of its subcomponents.
     mutable std::vector<SimTK::ReferencePtr<const Component> > _orderedSubcomponents;
+    // The same subcomponents, hashed, so that ordering n of them is O(n).
+    mutable SimTK::ResetOnCopy<std::unordered_set<const Component*>>
+        _orderedSubcomponentSet;
 
     // Structure to hold modeling option information. Modeling options are
     // integers 0..maxOptionValue. At run time we keep them in a Simbody
@@ -2841,6 +3331,10 @@ private:
         void setDerivative(const SimTK::State& state, double deriv) const override;
 
         private: // DATA
+        friend class Component;
+        // The cache variable that holds the derivative, so that it is
+        // accessed without looking up its name.
+        CacheVariable<double> derivative;
         // Changes in state variables trigger recalculation of appropriate cache 
         // variables by automatically invalidating the realization stage specified
         // upon allocation of the state variable.
@@ -2888,15 +3382,29 @@ private:
 
     // Structure to hold related info about cache variables 
     struct CacheInfo {
-        CacheInfo() {}
+        CacheInfo() : index(std::make_shared<SimTK::CacheEntryIndex>()) {}
         CacheInfo(SimTK::AbstractValue* proto,
                   SimTK::Stage          dependsOn)
-        :   prototype(proto), dependsOnStage(dependsOn) {}
+        :   prototype(proto), dependsOnStage(dependsOn),
+            index(std::make_shared<SimTK::CacheEntryIndex>()) {}
+        // A copy gets its own index so that CacheVariable handles of the
+        // original are not affected by allocations made for the copy.
+        CacheInfo(const CacheInfo& ci)
+        :   prototype(ci.prototype), dependsOnStage(ci.dependsOnStage),
+            index(std::make_shared<SimTK::CacheEntryIndex>(*ci.index)) {}
+        CacheInfo& operator=(const CacheInfo& ci) {
+            if (this != &ci) {
+                prototype = ci.prototype;
+                dependsOnStage = ci.dependsOnStage;
+                index = std::make_shared<SimTK::CacheEntryIndex>(*ci.index);
+            }
+            return *this;
+        }
         // Model
         SimTK::ClonePtr<SimTK::AbstractValue>   prototype;
         SimTK::Stage                            dependsOnStage;
-        // System
-        SimTK::CacheEntryIndex                  index;
+        // System; shared with the CacheVariable handles of this variable.
+        std::shared_ptr<SimTK::CacheEntryIndex> index;
     };
 
     // Map names of modeling options for the Component to their underlying
@@ -2926,6 +3434,13 @@ private:
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
 
+#ifndef SWIG
+    // Get the state variable a handle refers to, checking that the handle
+    // was obtained for the current System.
+    const StateVariable& getStateVariable(
+            const StateVariableHandle& handle) const;
+#endif
+
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> > 
                                                             _allStateVariables;
@@ -2944,6 +3459,13 @@ template <typename T>
 ComponentListIterator<T>& ComponentListIterator<T>::operator++() {
     if (_node==nullptr)
         return *this;
+    if (_flattened) {
+        ++_flattenedIndex;
+        _node = _flattenedIndex < _flattened->size() ?
+                (*_flattened)[_flattenedIndex] : nullptr;
+        advanceToNextValidComponent();
+        return *this;
+    }
     // If _node has children then successor is first child
     // move _node to point to it
     if (_node->_memberSubcomponents.size() > 0) {
@@ -2968,6 +3490,16 @@ ComponentListIterator<T>& ComponentListIterator<T>::operator++() {
 /// Internal method to advance iterator to next valid component.
 template <typename T>
 void ComponentListIterator<T>::advanceToNextValidComponent() {
+    // The flattened list only contains components of type T under _root, so
+    // only the filter needs to be applied.
+    if (_flattened) {
+        while (_node != nullptr && !_filter.isMatch(*_node)) {
+            ++_flattenedIndex;
+            _node = _flattenedIndex < _flattened->size() ?
+                    (*_flattened)[_flattenedIndex] : nullptr;
+        }
+        return;
+    }
     // Advance _node to next valid (of type T) if needed
     // Similar logic to operator++ but applies _filter->isMatch()
     while (_node != nullptr && (dynamic_cast<const T*>(_node) == nullptr || 
@@ -3161,6 +3693,20 @@ void Input<T>::findAndConnect(const Component& root) {
     }
 }
 
+inline void ComponentProfiler::count(const Component& component,
+                                     Operation operation) {
+    if (ComponentProfiler::isEnabled() && component._profilerTimings)
+        component._profilerTimings->add(operation, 0);
+}
+
+inline ComponentProfiler::Scope::Scope(const Component& component,
+                                      Operation operation)
+:   _operation(operation) {
+    if (ComponentProfiler::isEnabled() && component._profilerTimings) {
+        _timings = component._profilerTimings.get();
+        _start = std::chrono::steady_clock::now();
+    }
+}
 
 } // end of namespace OpenSim
 
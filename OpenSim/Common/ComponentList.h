@@ -26,8 +26,10 @@
 
 // INCLUDES
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 #include "SimTKcommon/basics.h"
 
 namespace OpenSim {
@@ -107,6 +109,11 @@ visited followed by all its immediate subcomponents (recursively).
     Component::initComponentTreeTraversal(), which is called just before
     getting a ComponentList from a Component, either via
     Component::getComponentList() or Component::updComponentList().
+    Component caches the result of the traversal as a flat list of the
+    subcomponents of each requested type T, so that a ComponentList obtained
+    from Component::getComponentList() or Component::updComponentList()
+    iterates through a contiguous array of components of type T (applying the
+    filter, if any) without traversing the tree or casting each node.
 */
 template <typename T>
 class ComponentList {
@@ -153,17 +160,17 @@ public:
     to the ComponentList constructor. If T is non-const, then this iterator
     allows you to modify the elements of this list. */
     iterator begin() {
-        return iterator(&_root, _filter.getRef());
+        return makeBegin<iterator>();
     }
     /** Same as cbegin(). */
     const_iterator begin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return makeBegin<const_iterator>();
     }
     /** Similar to begin(), except it does not permit
     modifying the elements of the list, even if T is non-const (e.g., 
     ComponentList<Body>). */
     const_iterator cbegin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return makeBegin<const_iterator>();
     }
     /** Use this method to check if you have reached the end of the list.
     This points past the end of the list, *not* to the last item in the
@@ -185,8 +192,27 @@ public:
           _filter = filter;
     }
 private:
+    friend class Component;
+    /** @internal Constructor used by Component to iterate over its cached,
+    flattened list of subcomponents of type T. */
+    ComponentList(const Component& root,
+            std::shared_ptr<const std::vector<const Component*>> flattened) :
+        _root(root), _flattened(std::move(flattened)) {
+        setDefaultFilter();
+    }
+    // Create an iterator at the first (matching) component.
+    template <typename IterT>
+    IterT makeBegin() const {
+        if (_flattened) return IterT(*_flattened, _filter.getRef());
+        return IterT(&_root, _filter.getRef());
+    }
+
     const Component& _root; // root of subtree to be iterated over
     SimTK::ClonePtr<ComponentFilter> _filter; // filter to choose components 
+    // Subcomponents of type T in tree pre-order, if provided by the root.
+    // Shared with the root's cache so that the list remains valid even if
+    // the root's cache is cleared during iteration.
+    std::shared_ptr<const std::vector<const Component*>> _flattened;
     // Internal method to setFilter to ComponentFilterMatchAll if no user specified
     // filter is provided.
     void setDefaultFilter() { setFilter(ComponentFilterMatchAll()); }
@@ -328,7 +354,9 @@ public:
         typename std::enable_if<std::is_convertible<FromT*, T*>::value>::type* = 0) :
         _node(source._node),
         _root(source._root),
-        _filter(source._filter)
+        _filter(source._filter),
+        _flattened(source._flattened),
+        _flattenedIndex(source._flattenedIndex)
     {/*No need to advanceToNextValid; was done when source was constructed.*/}
     
     /** @internal ComponentListIterator<const T> needs access to the members
@@ -353,6 +381,10 @@ private:
     /** Optional filter to further select Components under _root, defaults to
     Filter by type. */
     const ComponentFilter& _filter;
+    // If not null, the flattened list of components of type T (in tree
+    // pre-order) being iterated over, and the index of _node in that list.
+    const std::vector<const Component*>* _flattened = nullptr;
+    size_t _flattenedIndex = 0;
     
     /** Constructor that takes a Component and ComponentFilter.
      The iterator contains a const ref to filter and doesn't take ownership
@@ -365,6 +397,16 @@ private:
         _filter(filter) {
         advanceToNextValidComponent(); // in case node is not a match.
     }
+
+    /** Constructor that iterates over a flattened list of components of type
+    T, all of which are under the root. */
+    ComponentListIterator(const std::vector<const Component*>& flattened,
+                          const ComponentFilter& filter) :
+        _node(flattened.empty() ? nullptr : flattened[0]),
+        _filter(filter),
+        _flattened(&flattened) {
+        advanceToNextValidComponent(); // in case node is not a match.
+    }
 }; // end of ComponentListIterator
 } // end of namespace OpenSim
 
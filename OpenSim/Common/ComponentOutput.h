@@ -43,6 +43,7 @@
 namespace OpenSim {
 
 class Component;
+template <typename T> class OutputBatch;
 
 /** One of the values of an Output. */
 class AbstractChannel {
@@ -172,6 +173,13 @@ public:
     
     /// The container type that holds onto all of Channels in an Output.
     typedef std::map<std::string, Channel> ChannelMap;
+
+    /// The type of a function that provides the value of a channel by const
+    /// reference (e.g., to a value held in the State's cache).
+    typedef std::function<const T& (const Component* comp,
+                                    const SimTK::State&,
+                                    const std::string& channel)>
+        ReferenceFunction;
     
     //default construct output function pointer and result container
     Output() {}
@@ -181,15 +189,21 @@ public:
     @param name             The name of the output.
     @param outputFunction   The output function to be invoked (returns Output T)
     @param dependsOnStage   Stage at which Output can be evaluated.
-    @param isList           Can this Output have more than one channel? */
+    @param isList           Can this Output have more than one channel?
+    @param outputReferenceFunction (optional) Provides the same value as
+                            outputFunction, but by const reference. If
+                            provided, getValue() returns this reference
+                            rather than a copy of the value. */
     explicit Output(const std::string& name,
         const std::function<void (const Component* comp,
                                  const SimTK::State&,
                                  const std::string& channel, T&)>& outputFunction,
         const SimTK::Stage&     dependsOnStage,
-        bool                    isList) :
+        bool                    isList,
+        const ReferenceFunction& outputReferenceFunction = nullptr) :
             AbstractOutput(name, dependsOnStage, isList),
-            _outputFcn(outputFunction) {
+            _outputFcn(outputFunction),
+            _outputRefFcn(outputReferenceFunction) {
         if (!isList) {
             // We want just one channel with an empty name.
             _channels[""] = Channel(this, "");
@@ -200,7 +214,8 @@ public:
     /** Custom copy constructor is for setting the Channel's pointer
      * back to this Output. */
     Output(const Output& source) : AbstractOutput(source),
-            _outputFcn(source._outputFcn), _channels(source._channels) {
+            _outputFcn(source._outputFcn), _outputRefFcn(source._outputRefFcn),
+            _channels(source._channels) {
         for (auto& it : _channels) {
             it.second._output.reset(this);
         }
@@ -212,6 +227,7 @@ public:
         if (&source == this) return *this;
         AbstractOutput::operator=(source);
         _outputFcn = source._outputFcn;
+        _outputRefFcn = source._outputRefFcn;
         _channels = source._channels;
         for (auto& it : _channels) {
             it.second._output.reset(this);
@@ -272,7 +288,10 @@ public:
     //--------------------------------------------------------------------------
     /** Return the Value of this output if the state is appropriately realized   
         to a stage at or beyond the dependsOnStage, otherwise expect an
-        Exception. */
+        Exception. If the output's function returns its value by const
+        reference (see isValueByReference()), this is that reference and no
+        copy is made; otherwise, the reference is to a copy held by this
+        Output, which is overwritten by the next call. */
     const T& getValue(const SimTK::State& state) const {
         if (isListOutput()) {
             throw Exception("Cannot get value for list Output. "
@@ -284,9 +303,15 @@ public:
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
+        if (_outputRefFcn) return _outputRefFcn(_owner.get(), state, "");
         _outputFcn(_owner.get(), state, "", _result);
         return _result;
     }
+
+    /** Does getValue() (and the getValue() of this Output's channels) return
+    a reference to the value computed by the component (e.g., stored in the
+    State's cache), rather than to a copy of it? */
+    bool isValueByReference() const { return bool(_outputRefFcn); }
     
     std::string getTypeName() const override {
         return OpenSim::Object_GetClassName<T>::name();
@@ -318,10 +343,14 @@ private:
                         const SimTK::State&,
                         const std::string& channel,
                         T& result)> _outputFcn { nullptr };
+    ReferenceFunction _outputRefFcn { nullptr };
     // TODO consider using indices, and having a parallel data structure
     // for names.
     std::map<std::string, Channel> _channels;
 
+    // To invoke the output function directly.
+    friend class OutputBatch<T>;
+
 //=============================================================================
 };  // END class Output
 
@@ -332,7 +361,12 @@ public:
     Channel() = default;
     Channel(const Output<T>* output, const std::string& channelName)
      : _output(output), _channelName(channelName) {}
+    /** The value of this channel. See Output::getValue() for the lifetime
+    of the returned reference. */
     const T& getValue(const SimTK::State& state) const {
+        if (_output->_outputRefFcn)
+            return _output->_outputRefFcn(_output->_owner.get(), state,
+                                          _channelName);
         // Must cache, since we're returning a reference.
         _output->_outputFcn(_output->_owner.get(), state, _channelName, _result);
         return _result;
@@ -362,6 +396,8 @@ private:
     friend Output<T>::Output(const Output&);
     friend Output<T>& Output<T>::operator=(const Output&);
 #endif
+    // To evaluate the channel's value in place.
+    friend class OutputBatch<T>;
 };
 
 // TODO consider using std::reference_wrapper<T> as type for _output_##oname,
@@ -0,0 +1,113 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ComponentProfiler.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+#include "Component.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+using namespace OpenSim;
+
+std::atomic<bool> ComponentProfiler::_enabled(false);
+
+const char* ComponentProfiler::getOperationName(Operation operation)
+{
+    switch (operation) {
+    case RealizeTopology:       return "realizeTopology";
+    case RealizeModel:          return "realizeModel";
+    case RealizeInstance:       return "realizeInstance";
+    case RealizeTime:           return "realizeTime";
+    case RealizePosition:       return "realizePosition";
+    case RealizeVelocity:       return "realizeVelocity";
+    case RealizeDynamics:       return "realizeDynamics";
+    case RealizeAcceleration:   return "realizeAcceleration";
+    case RealizeReport:         return "realizeReport";
+    case ComputeStateVariableDerivatives:
+        return "computeStateVariableDerivatives";
+    case ComputeForce:          return "computeForce";
+    case ComputePath:           return "computePath";
+    case WrapLine:              return "wrapLine";
+    case CullWrapPathSegment:   return "cullWrapPathSegment";
+    default:                    return "unknown";
+    }
+}
+
+std::vector<std::pair<const Component*, ComponentProfiler::Timings*>>
+ComponentProfiler::collectTimings(const Component& root)
+{
+    std::vector<std::pair<const Component*, Timings*>> timings;
+    if (root._profilerTimings)
+        timings.emplace_back(&root, root._profilerTimings.get());
+    for (const Component& comp : root.getComponentList()) {
+        if (comp._profilerTimings)
+            timings.emplace_back(&comp, comp._profilerTimings.get());
+    }
+    return timings;
+}
+
+std::vector<ComponentProfiler::Record>
+ComponentProfiler::getSummary(const Component& root)
+{
+    std::vector<Record> records;
+    for (const auto& it : collectTimings(root)) {
+        for (int i = 0; i < NumOperations; ++i) {
+            const Operation op = Operation(i);
+            if (it.second->getCount(op) == 0) continue;
+            records.push_back({it.first->getAbsolutePathString(), op,
+                               it.second->getCount(op),
+                               it.second->getNanoseconds(op)});
+        }
+    }
+    std::stable_sort(records.begin(), records.end(),
+            [](const Record& a, const Record& b) {
+                return a.nanoseconds > b.nanoseconds;
+            });
+    return records;
+}
+
+void ComponentProfiler::printSummary(const Component& root,
+                                     std::ostream& out, int maxRows)
+{
+    const auto records = getSummary(root);
+    out << std::setw(12) << "time (ms)" << std::setw(12) << "count" << "  "
+        << std::left << std::setw(32) << "operation" << "component"
+        << std::right << "\n";
+    int row = 0;
+    for (const auto& record : records) {
+        if (maxRows > 0 && row++ >= maxRows) break;
+        out << std::fixed << std::setprecision(3) << std::setw(12)
+            << 1e-6 * double(record.nanoseconds)
+            << std::setw(12) << record.count << "  "
+            << std::left << std::setw(32)
+            << getOperationName(record.operation)
+            << record.componentPath << std::right << "\n";
+    }
+    out.unsetf(std::ios::floatfield);
+    out.flush();
+}
+
+void ComponentProfiler::reset(const Component& root)
+{
+    for (const auto& it : collectTimings(root)) it.second->reset();
+}
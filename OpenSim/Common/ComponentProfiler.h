@@ -0,0 +1,174 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ComponentProfiler.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/** The ComponentProfiler measures how often, and for how long, each
+Component in a tree realizes each Stage, computes its state variable
+derivatives, computes its force (Force), recomputes its path
+(GeometryPath), or computes the wrapping of a path segment (PathWrap). It
+also counts the path segments whose wrapping was skipped because they are
+far from the wrap object (PathWrap, cullWrapPathSegment, with no time). Use it to find the few components that make a model slow:
+
+@code{.cpp}
+model.initSystem();
+ComponentProfiler::setEnabled(true);
+manager.integrate(finalTime);
+ComponentProfiler::setEnabled(false);
+ComponentProfiler::printSummary(model, std::cout, 10);
+@endcode
+
+Profiling is disabled by default; when disabled, the only cost is a check of
+a flag in each of the operations above. The times of an operation include
+the times of operations it invokes (e.g., a muscle's force includes the time
+to compute its path, if the path was not yet computed), and are wall-clock
+times summed over all threads. Each Component only collects timings after
+it has been added to a System. */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** The operations that are timed. */
+    enum Operation {
+        RealizeTopology,
+        RealizeModel,
+        RealizeInstance,
+        RealizeTime,
+        RealizePosition,
+        RealizeVelocity,
+        RealizeDynamics,
+        RealizeAcceleration,
+        RealizeReport,
+        ComputeStateVariableDerivatives,
+        ComputeForce,
+        ComputePath,
+        WrapLine,
+        CullWrapPathSegment,
+        NumOperations
+    };
+
+    /** The name of an operation (e.g., "realizePosition"). */
+    static const char* getOperationName(Operation operation);
+
+    /** Count one occurrence of an operation that is not timed. Does
+    nothing if profiling is disabled. Defined in Component.h. */
+    static void count(const Component& component, Operation operation);
+
+    /** Turn profiling on or off for all Components. */
+    static void setEnabled(bool enabled) { _enabled.store(enabled); }
+    static bool isEnabled()
+    {   return _enabled.load(std::memory_order_relaxed); }
+
+    /** The timings of one operation of one Component. */
+    struct Record {
+        std::string componentPath;
+        Operation operation;
+        unsigned long long count;
+        unsigned long long nanoseconds;
+    };
+
+    /** The timings of every operation that the provided Component or any of
+    its subcomponents performed at least once, sorted by decreasing
+    cumulative time. */
+    static std::vector<Record> getSummary(const Component& root);
+
+    /** Print the getSummary() of the provided Component as a table with the
+    columns "time (ms)", "count", "operation" and "component". Only the first
+    maxRows are printed, if maxRows is positive. */
+    static void printSummary(const Component& root, std::ostream& out,
+                             int maxRows = -1);
+
+    /** Forget the timings collected so far by the provided Component and
+    its subcomponents. */
+    static void reset(const Component& root);
+
+    /** The call count and cumulative time of each operation of a single
+    Component. Each Component owns one of these once it is added to a
+    System. */
+    class Timings {
+    public:
+        Timings() { reset(); }
+        void add(Operation operation, unsigned long long nanoseconds) {
+            _count[operation].fetch_add(1, std::memory_order_relaxed);
+            _nanoseconds[operation].fetch_add(nanoseconds,
+                                              std::memory_order_relaxed);
+        }
+        unsigned long long getCount(Operation operation) const
+        {   return _count[operation].load(); }
+        unsigned long long getNanoseconds(Operation operation) const
+        {   return _nanoseconds[operation].load(); }
+        void reset() {
+            for (int i = 0; i < NumOperations; ++i) {
+                _count[i].store(0);
+                _nanoseconds[i].store(0);
+            }
+        }
+    private:
+        std::atomic<unsigned long long> _count[NumOperations];
+        std::atomic<unsigned long long> _nanoseconds[NumOperations];
+    };
+
+    /** Time one operation of a Component, from construction to destruction
+    of the Scope. Does nothing if profiling is disabled when the Scope is
+    constructed. */
+    class Scope {
+    public:
+        Scope(const Component& component, Operation operation);
+        ~Scope() {
+            if (_timings) {
+                _timings->add(_operation, std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - _start).count());
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Timings* _timings = nullptr;
+        Operation _operation;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+private:
+    // The Timings of the provided Component and its subcomponents, for
+    // those that have been added to a System.
+    static std::vector<std::pair<const Component*, Timings*>>
+    collectTimings(const Component& root);
+
+    static std::atomic<bool> _enabled;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
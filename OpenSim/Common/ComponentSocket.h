@@ -679,6 +679,11 @@ public:
     Output<T>'s getValue() with minimal overhead. Specify the index of the 
     Channel whose value is desired.                                           */
     const T& getValue(const SimTK::State &state, unsigned index) const {
+        // Inputs are read on every step (e.g., by reporters and controllers),
+        // so a connected channel is read without looking up the
+        // connectee_name property, which only the checks below need.
+        if (index < _connectees.size())
+            return _connectees[index]->getValue(state);
         OPENSIM_THROW_IF(!isConnected(), InputNotConnected, getName());
         using SimTK::isIndexInRange;
         SimTK_INDEXCHECK(index, getNumConnectees(),
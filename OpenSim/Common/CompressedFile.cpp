@@ -0,0 +1,227 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  CompressedFile.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompressedFile.h"
+#include "Exception.h"
+#include "IO.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace OpenSim;
+
+namespace {
+
+const std::string compressionExtension{".gz"};
+
+#ifdef WITH_ZLIB
+
+// Size of the blocks of text compressed separately.
+const std::size_t blockSize = 1 << 20;
+
+// A stream buffer that collects the text written in blocks, compresses full
+// blocks (concurrently, several at a time) as gzip members, and writes them to
+// a file in order.
+class GzipStreamBuf : public std::streambuf {
+public:
+    GzipStreamBuf(const std::string& fileName, bool append) :
+            _file(fileName, std::ios::binary |
+                  (append ? std::ios::app : std::ios::trunc)) {
+        int numThreads = IO::GetNumWriterThreads();
+        if(numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+        _buffer.resize(blockSize * std::max(1, numThreads));
+        setp(&_buffer[0], &_buffer[0] + _buffer.size());
+    }
+    ~GzipStreamBuf() { sync(); }
+
+    bool isOpen() const { return _file.is_open(); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if(!compressPending()) return traits_type::eof();
+        if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+    int sync() override {
+        if(!compressPending()) return -1;
+        _file.flush();
+        return _file ? 0 : -1;
+    }
+
+private:
+    static bool compress(const char* data, std::size_t size,
+                         std::string& out) {
+        z_stream stream{};
+        // 15 + 16: the largest window, with a gzip header and trailer.
+        if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16,
+                        8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return false;
+        out.resize(deflateBound(&stream, static_cast<uLong>(size)));
+        stream.next_in =
+                reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        stream.avail_in = static_cast<uInt>(size);
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        const bool done = deflate(&stream, Z_FINISH) == Z_STREAM_END;
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return done;
+    }
+
+    // Compress the text written since the last call, one block per thread,
+    // and write the blocks to the file.
+    bool compressPending() {
+        const std::size_t size = pptr() - pbase();
+        const std::size_t numBlocks = (size + blockSize - 1) / blockSize;
+        std::vector<std::string> blocks(numBlocks);
+        std::vector<char> compressed(numBlocks, 0);
+        auto compressBlock = [&](std::size_t b) {
+            const std::size_t begin = b * blockSize;
+            compressed[b] = compress(pbase() + begin,
+                    std::min(blockSize, size - begin), blocks[b]);
+        };
+        std::vector<std::thread> threads;
+        std::size_t b = 1;
+        for(; b < numBlocks; ++b) {
+            try {
+                threads.emplace_back(compressBlock, b);
+            } catch(const std::system_error&) {
+                // Could not start a thread; compress the rest here.
+                break;
+            }
+        }
+        if(numBlocks > 0) compressBlock(0);
+        for(std::size_t rest = b; rest < numBlocks; ++rest)
+            compressBlock(rest);
+        for(auto& thread : threads) thread.join();
+
+        setp(&_buffer[0], &_buffer[0] + _buffer.size());
+        for(std::size_t i = 0; i < numBlocks; ++i) {
+            if(!compressed[i]) return false;
+            _file.write(blocks[i].data(), blocks[i].size());
+        }
+        return static_cast<bool>(_file);
+    }
+
+    std::ofstream _file;
+    std::vector<char> _buffer;
+};
+
+class GzipOutputStream : public std::ostream {
+public:
+    GzipOutputStream(const std::string& fileName, bool append) :
+            std::ostream(nullptr), _buffer(fileName, append) {
+        rdbuf(&_buffer);
+        if(!_buffer.isOpen()) setstate(std::ios::failbit);
+    }
+private:
+    GzipStreamBuf _buffer;
+};
+
+#endif // WITH_ZLIB
+
+} // anonymous namespace
+
+bool
+CompressedFile::isSupported() {
+#ifdef WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+CompressedFile::isCompressedFileName(const std::string& fileName) {
+    const auto& ext = compressionExtension;
+    if(fileName.size() <= ext.size()) return false;
+    return std::equal(ext.begin(), ext.end(),
+                      fileName.end() - ext.size(),
+                      [](char a, char b) {
+                          return a == std::tolower(
+                                  static_cast<unsigned char>(b));
+                      });
+}
+
+std::string
+CompressedFile::removeCompressionExtension(const std::string& fileName) {
+    if(!isCompressedFileName(fileName)) return fileName;
+    return fileName.substr(0, fileName.size() - compressionExtension.size());
+}
+
+std::unique_ptr<std::istream>
+CompressedFile::openForReading(const std::string& fileName) {
+    if(!isCompressedFileName(fileName))
+        return std::unique_ptr<std::istream>(new std::ifstream(fileName));
+#ifdef WITH_ZLIB
+    std::unique_ptr<std::istringstream> stream(new std::istringstream);
+    gzFile file = gzopen(fileName.c_str(), "rb");
+    if(!file) {
+        stream->setstate(std::ios::failbit);
+        return std::move(stream);
+    }
+    gzbuffer(file, 1 << 17);
+    std::string text;
+    std::vector<char> chunk(1 << 20);
+    int n = 0;
+    while((n = gzread(file, chunk.data(),
+                      static_cast<unsigned>(chunk.size()))) > 0)
+        text.append(chunk.data(), n);
+    int error = Z_OK;
+    const std::string message = n < 0 ? gzerror(file, &error) : "";
+    gzclose(file);
+    OPENSIM_THROW_IF(n < 0, Exception,
+                     "Could not decompress '" + fileName + "': " + message);
+    stream->str(text);
+    return std::move(stream);
+#else
+    OPENSIM_THROW(Exception, "Cannot read compressed file '" + fileName +
+                  "': OpenSim was built without zlib (WITH_ZLIB).");
+#endif
+}
+
+std::unique_ptr<std::ostream>
+CompressedFile::openForWriting(const std::string& fileName, bool append) {
+    if(!isCompressedFileName(fileName))
+        return std::unique_ptr<std::ostream>(new std::ofstream(fileName,
+                append ? std::ios::app : std::ios::trunc));
+#ifdef WITH_ZLIB
+    return std::unique_ptr<std::ostream>(
+            new GzipOutputStream(fileName, append));
+#else
+    OPENSIM_THROW(Exception, "Cannot write compressed file '" + fileName +
+                  "': OpenSim was built without zlib (WITH_ZLIB).");
+#endif
+}
@@ -0,0 +1,78 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  CompressedFile.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_COMPRESSED_FILE_H_
+#define OPENSIM_COMPRESSED_FILE_H_
+
+#include "osimCommonDLL.h"
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace OpenSim {
+
+/** Read and write files compressed with gzip, whose names end in ".gz"
+(e.g., "results.sto.gz"), as if they were not compressed. Storage and the
+text file adapters (STOFileAdapter, CSVFileAdapter, TRCFileAdapter) use this
+class, so that, e.g., `Storage("subject01_ik.mot.gz")` and
+`STOFileAdapter::write(table, "forces.sto.gz")` read and write compressed
+files, and FileAdapter::readFile() chooses the adapter from the extension
+before ".gz".
+
+Compressed files are written in blocks of 1 MB (of text), each compressed as
+a complete gzip member, so that blocks can be compressed concurrently (see
+IO::SetNumWriterThreads()); gzip, zlib and other tools read the members of a
+file as one stream. Compressed files are read whole into memory.
+
+Compression requires OpenSim to be built with zlib (the CMake option
+WITH_ZLIB); otherwise, reading or writing a compressed file throws an
+Exception.                                                                    */
+class OSIMCOMMON_API CompressedFile {
+public:
+    /** Whether OpenSim was built with support for compressed files.         */
+    static bool isSupported();
+    /** Whether a file name ends in ".gz" (in any case).                      */
+    static bool isCompressedFileName(const std::string& fileName);
+    /** The file name without its compression extension, if it has one.      */
+    static std::string
+    removeCompressionExtension(const std::string& fileName);
+
+#ifndef SWIG
+    /** Open a file for reading: compressed files are decompressed, and other
+    files are opened as std::ifstream. If the file cannot be opened, the
+    stream returned is not good().
+    @throws Exception If a compressed file cannot be decompressed.           */
+    static std::unique_ptr<std::istream>
+    openForReading(const std::string& fileName);
+    /** Open a file for writing, or for appending to it: what is written to a
+    compressed file is compressed. Check the stream after flushing it to
+    detect errors; what remains is written when the stream is destroyed, but
+    errors are not reported then. If the file cannot be opened, the stream
+    returned is not good().                                                   */
+    static std::unique_ptr<std::ostream>
+    openForWriting(const std::string& fileName, bool append = false);
+#endif
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPRESSED_FILE_H_
@@ -89,6 +89,10 @@ public:
     {
         return _value;
     }
+    double calcValue(double xUnused) const override
+    {
+        return _value;
+    }
     const double getValue() const { return _value; }
     SimTK::Function* createSimTKFunction() const override;
 //=============================================================================
@@ -222,13 +222,23 @@ public:
         // This calls validateDependentsMetadata, so no need for explicit call.
         setColumnLabels(thisLabels);
 
-        for(unsigned r = 0; r < that.getNumRows(); ++r) {
-            const auto& thatInd = that.getIndependentColumn().at(r);
-            const auto& thatRow = that.getRowAtIndex(r);
-            std::vector<ETY> thisRow{};
-            for(unsigned c = 0; c < that.getNumColumns(); ++c)
-                splitElementAndPushBack(thisRow, thatRow[c]);
-            appendRow(thatInd, thisRow);
+        // Fill the matrix at once, column by column (the order in which it
+        // is stored), rather than appending rows.
+        _indData.assign(that.getIndependentColumn().begin(),
+                        that.getIndependentColumn().end());
+        const auto& thatMatrix = that.getMatrix();
+        const int numRows{thatMatrix.nrow()};
+        const int numComponents{
+            static_cast<int>(that.numComponentsPerElement())};
+        _depData.resize(numRows, thatMatrix.ncol() * numComponents);
+        std::vector<double> components{};
+        for(int c = 0; c < thatMatrix.ncol(); ++c) {
+            for(int r = 0; r < numRows; ++r) {
+                components.clear();
+                splitElementAndPushBack(components, thatMatrix(r, c));
+                for(int i = 0; i < numComponents; ++i)
+                    _depData(r, c * numComponents + i) = components[i];
+            }
         }
     }
 
@@ -374,18 +384,22 @@ public:
         }
         setColumnLabels(thisLabels);
 
-        // Form rows for this table from that table.
-        for(unsigned r = 0; r < that.getNumRows(); ++r) {
-            const auto& thatInd = that.getIndependentColumn().at(r);
-            auto thatRow = that.getRowAtIndex(r).getAsRowVector();
-            std::vector<ETY> thisRow{};
-            for(unsigned c = 0;
-                c < that.getNumColumns();
-                c += numComponentsPerElement()) {
-                thisRow.push_back(makeElement(thatRow.begin() + c,
-                                              thatRow.end()));
+        // Fill the matrix at once, column by column (the order in which it
+        // is stored), rather than appending rows.
+        _indData.assign(that.getIndependentColumn().begin(),
+                        that.getIndependentColumn().end());
+        const auto& thatMatrix = that.getMatrix();
+        const int numRows{thatMatrix.nrow()};
+        const int numComponents{static_cast<int>(numComponentsPerElement())};
+        _depData.resize(numRows, thatMatrix.ncol() / numComponents);
+        std::vector<double> components(numComponents);
+        for(int c = 0; c < _depData.ncol(); ++c) {
+            for(int r = 0; r < numRows; ++r) {
+                for(int i = 0; i < numComponents; ++i)
+                    components[i] = thatMatrix(r, c * numComponents + i);
+                _depData(r, c) = makeElement(components.begin(),
+                                             components.end());
             }
-            appendRow(thatInd, thisRow);
         }
     }
 
@@ -646,8 +660,6 @@ public:
     void appendRow(const ETX& indRow, const RowVectorView& depRow) {
         validateRow(_indData.size(), indRow, depRow);
 
-        _indData.push_back(indRow);
-
         if(_depData.nrow() == 0 || _depData.ncol() == 0) {
             try {
                 auto& labels = 
@@ -660,12 +672,36 @@ public:
             } catch(KeyNotFound&) {
                 // No "labels". So no operation.
             }
+            _indData.push_back(indRow);
             _depData.resize(1, depRow.size());
+            _depData.updRow(0) = depRow;
+            return;
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+
+        OPENSIM_THROW_IF(depRow.ncol() != _depData.ncol(),
+                         IncorrectNumColumns,
+                         static_cast<size_t>(_depData.ncol()),
+                         static_cast<size_t>(depRow.ncol()));
+
+        // Resizing the matrix for every row would make appending N rows cost
+        // O(N^2), so rows are collected in a buffer that grows geometrically,
+        // and added to the matrix all at once when it is next accessed.
+        _indData.push_back(indRow);
+        for(int c = 0; c < depRow.ncol(); ++c)
+            _appendedRows.push_back(depRow[c]);
+        ++_numAppendedRows;
+    }
+
+    /** Reserve memory for a total of numRows rows, so that appending rows
+    until the table has that many rows does not reallocate.                  */
+    void reserveRows(size_t numRows) {
+        _indData.reserve(numRows);
+        size_t numColumns = static_cast<size_t>(_depData.ncol());
+        if(numColumns == 0 && hasColumnLabels())
+            numColumns = getColumnLabels().size();
+        if(numRows > getNumRows())
+            _appendedRows.reserve(_appendedRows.size() +
+                                  (numRows - getNumRows()) * numColumns);
     }
 
     /** Get row at index.                                                     
@@ -678,7 +714,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.row(static_cast<int>(index));
+        return depData().row(static_cast<int>(index));
     }
 
     /** Get row corresponding to the given entry in the independent column. This
@@ -694,7 +730,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.row((int)std::distance(_indData.cbegin(), iter));
+        return depData().row((int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Update row at index.                                                  
@@ -707,7 +743,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.updRow((int)index);
+        return updDepData().updRow((int)index);
     }
 
     /** Update row corresponding to the given entry in the independent column.
@@ -723,7 +759,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
+        return updDepData().updRow((int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Set row at index. Equivalent to
@@ -783,6 +819,7 @@ public:
     \throws EmptyTable If the table is empty.
     \throws RowIndexOutOfRange If the index is out of range.                  */
     void removeRowAtIndex(size_t index) {
+        flushAppendedRows();
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
                          RowIndexOutOfRange, 
@@ -933,6 +970,7 @@ public:
                           rows.                                               */
     void appendColumn(const std::string& columnLabel,
                       const VectorView& depCol) {
+        flushAppendedRows();
         OPENSIM_THROW_IF(getNumRows() == 0,
                          InvalidCall,
                          "DataTable must have one or more rows before we can "
@@ -951,7 +989,10 @@ public:
         appendColumnLabel(columnLabel);
     }
 
-    /** Get dependent column at index.
+    /** Get dependent column at index. The dependent data are stored column
+    by column, so this does not copy the column and its elements are
+    contiguous in memory: `&column[0]` can be passed to functions that take
+    an array.
 
     \throws EmptyTable If the table is empty.
     \throws ColumnIndexOutOfRange If index is out of range for number of columns
@@ -960,17 +1001,19 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(depData().ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return depData().col(static_cast<int>(index));
     }
 
-    /** Get dependent Column which has the given column label.                
+    /** Get dependent Column which has the given column label. As with
+    getDependentColumnAtIndex(), the elements of the column are contiguous
+    in memory.
 
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return depData().col(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** Update dependent column at index.
@@ -982,9 +1025,9 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(updDepData().ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return updDepData().updCol(static_cast<int>(index));
     }
 
     /** Update dependent Column which has the given column label.
@@ -992,7 +1035,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return updDepData().updCol(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** %Set value of the independent column at index.
@@ -1008,7 +1051,7 @@ public:
                          rowIndex, 0, 
                          static_cast<unsigned>(_indData.size() - 1));
 
-        validateRow(rowIndex, value, _depData.row((int)rowIndex));
+        validateRow(rowIndex, value, depData().row((int)rowIndex));
         _indData[rowIndex] = value;
     }
 
@@ -1021,7 +1064,7 @@ public:
 
     /** Get a read-only view to the underlying matrix.                        */
     const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+        return depData().getAsMatrixView();
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1036,6 +1079,7 @@ public:
                               size_t columnStart,
                               size_t numRows,
                               size_t numColumns) const {
+        flushAppendedRows();
         OPENSIM_THROW_IF(numRows == 0 || numColumns == 0,
                          InvalidArgument,
                          "Either numRows or numColumns is zero.");
@@ -1065,7 +1109,7 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
-        return _depData.updAsMatrixView();
+        return updDepData().updAsMatrixView();
     }
 
     /** Get a writable view of a block of the underlying matrix.
@@ -1080,6 +1124,7 @@ public:
                               size_t columnStart,
                               size_t numRows,
                               size_t numColumns) {
+        flushAppendedRows();
         OPENSIM_THROW_IF(numRows == 0 || numColumns == 0,
                          InvalidArgument,
                          "Either numRows or numColumns is zero.");
@@ -1452,7 +1497,7 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _depData.nrow() + _numAppendedRows;
     }
 
     /** Get number of columns.                                                */
@@ -1534,8 +1579,41 @@ protected:
         return M * N;
     }
 
+    // The matrix including all rows appended so far.
+    const SimTK::Matrix_<ETY>& depData() const {
+        flushAppendedRows();
+        return _depData;
+    }
+    SimTK::Matrix_<ETY>& updDepData() {
+        flushAppendedRows();
+        return _depData;
+    }
+
+    // Add the rows collected by appendRow() to the matrix.
+    void flushAppendedRows() const {
+        if(_numAppendedRows == 0)
+            return;
+        const int numRows{_depData.nrow()};
+        const int numColumns{_depData.ncol()};
+        _depData.resizeKeep(numRows + static_cast<int>(_numAppendedRows),
+                            numColumns);
+        for(size_t r = 0; r < _numAppendedRows; ++r)
+            for(int c = 0; c < numColumns; ++c)
+                _depData(numRows + static_cast<int>(r), c) =
+                    _appendedRows[r * numColumns + c];
+        // Release the memory of the buffer, which is as large as the rows.
+        std::vector<ETY>().swap(_appendedRows);
+        _numAppendedRows = 0;
+    }
+
     std::vector<ETX>    _indData;
-    SimTK::Matrix_<ETY> _depData;
+    // Rows of the dependent data that have been appended but not yet added to
+    // _depData; see appendRow(). The first row is always added to _depData
+    // (so that it has the right number of columns). Both are mutable so
+    // that const accessors can add the rows first.
+    mutable SimTK::Matrix_<ETY> _depData;
+    mutable std::vector<ETY>    _appendedRows;
+    mutable size_t              _numAppendedRows{0};
 };  // DataTable_
 
 
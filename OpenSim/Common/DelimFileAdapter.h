@@ -24,8 +24,11 @@
 
 #include "SimTKcommon.h"
 
+#include "CompressedFile.h"
 #include "FileAdapter.h"
+#include "IO.h"
 #include "TimeSeriesTable.h"
+#include "Tracer.h"
 
 #include <string>
 #include <fstream>
@@ -127,6 +130,41 @@ protected:
     inline SimTK::RowVector_<T> 
     readElems(const std::vector<std::string>& tokens) const;
 
+    /** Read one element of type T (template parameter) from a token of a
+    DataLines.                                                                */
+    inline void readElem(const Token& token, T& elem) const;
+
+    /** Write the rows and columns of a view of a table (see
+    TimeSeriesTableView_) to a file; this implements extendWrite(), for a
+    view of the whole table.                                                  */
+    void writeTable(const TimeSeriesTableView_<T>& view,
+                    const std::string& filename) const;
+
+    /** Write the header of a file (the metadata, the DataType and version,
+    then the line of column labels, starting with "time") to a stream.        */
+    void writeHeader(std::ostream& stream,
+                     const AbstractDataTable::TableMetaData& metadata,
+                     const std::vector<std::string>& labels) const;
+
+    /** Write a row (the time, then the elements) to a stream.               */
+    void writeRow(std::ostream& stream,
+                  double time,
+                  const SimTK::RowVectorBase<T>& row) const;
+
+    /** Append the text of a row, as written by writeRow(), to a string. The
+    rows of a table are formatted into strings (concurrently, see
+    IO::SetNumWriterThreads()) and written in large pieces.                   */
+    void appendRow(std::string& text,
+                   double time,
+                   const SimTK::RowVectorBase<T>& row) const;
+
+    /** Append the text of a row, as appendRow() does, with only the elements
+    at the given indices (in the given order).                                */
+    void appendRow(std::string& text,
+                   double time,
+                   const SimTK::RowVectorBase<T>& row,
+                   const std::vector<size_t>& columns) const;
+
     /** Write an element of type T (template parameter) to stream with the
     specified precision.                                                      */
     inline void writeElem(std::ostream& stream, 
@@ -160,17 +198,29 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
-    /** Following overloads implement writeElem().                            */
-    inline void writeElem_impl(std::ostream& stream,
-                               const double& elem,
-                               const unsigned& prec) const;
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::SpatialVec& elem,
-                               const unsigned& prec) const;
+    /** Following overloads implement readElem().                             */
+    inline void readElem_impl(const Token& token, double& elem) const;
+    template<typename U>
+    inline void readElem_impl(const Token& token, U& elem) const;
+
+    /** Following overloads append an element, formatted with the given
+    printf-style format for one double, to a string; they implement
+    writeElem() and appendRow().                                              */
+    inline void appendElem_impl(std::string& text,
+                                const double& elem,
+                                const char* format) const;
+    inline void appendElem_impl(std::string& text,
+                                const SimTK::SpatialVec& elem,
+                                const char* format) const;
     template<int M>
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::Vec<M>& elem,
-                               const unsigned& prec) const;
+    inline void appendElem_impl(std::string& text,
+                                const SimTK::Vec<M>& elem,
+                                const char* format) const;
+
+    /** The printf-style format, for one double, of the elements written:
+    as many significant digits as an ostream with precision
+    digits10 + 1 writes.                                                      */
+    static const char* elemFormat() { return "%.16g"; }
       
     /** Trim string -- remove specified leading and trailing characters from 
     string. Trims out whitespace by default.                                  */
@@ -301,8 +351,11 @@ typename DelimFileAdapter<T>::OutputTables
 DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
+    OPENSIM_TRACE_SPAN("io", "read table", fileName);
 
-    std::ifstream in_stream{fileName};
+    // Compressed files (e.g., .sto.gz) are decompressed.
+    auto stream = CompressedFile::openForReading(fileName);
+    std::istream& in_stream = *stream;
     OPENSIM_THROW_IF(!in_stream.good(),
                      FileDoesNotExist,
                      fileName);
@@ -390,29 +443,39 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     dep_metadata.setValueArrayForKey("labels", value_array);
     table->setDependentsMetaData(dep_metadata);
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
-    auto row = nextLine();
-    while(!row.empty()) {
-        ++line_num;
-
-        // Time is column 0.
-        double time = std::stod(row.front());
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
-
-        OPENSIM_THROW_IF(row_vector.size() != column_labels.size(),
-                         RowLengthMismatch,
-                         fileName,
-                         line_num,
-                         column_labels.size(),
-                         static_cast<size_t>(row_vector.size()));
-
-        // Column 1 is time.
-        table->appendRow(time, std::move(row_vector));
-
-        row = nextLine();
+    // Read all the rows at once, then parse them (in parallel, if there are
+    // many) directly into the time column container and the data container.
+    const DataLines lines{in_stream, _delimitersRead, line_num + 1};
+    const size_t num_rows{lines.getNumLines()};
+    const int num_cols{static_cast<int>(column_labels.size())};
+    std::vector<double> times(num_rows);
+    SimTK::Matrix_<T> data{static_cast<int>(num_rows), num_cols};
+    parseRowsInParallel(num_rows, [&](size_t begin, size_t end) {
+        std::vector<Token> row{};
+        for(size_t r = begin; r < end; ++r) {
+            lines.tokenize(r, row);
+
+            OPENSIM_THROW_IF(row.size() - 1 != column_labels.size(),
+                             RowLengthMismatch,
+                             fileName,
+                             lines.getLineNumber(r),
+                             column_labels.size(),
+                             row.size() - 1);
+
+            // Time is column 0.
+            times[r] = parseDouble(row.front());
+            for(int c = 0; c < num_cols; ++c)
+                readElem(row[c + 1], data.updElt(static_cast<int>(r), c));
+        }
+    });
+
+    if(num_rows > 0) {
+        // Construct the table from all the rows at once rather than
+        // appending the rows one at a time.
+        auto full_table = std::make_shared<TimeSeriesTable_<T>>(
+                times, data, column_labels);
+        full_table->updTableMetaData() = table->getTableMetaData();
+        table = full_table;
     }
 
     OutputTables output_tables{};
@@ -427,6 +490,26 @@ DelimFileAdapter<T>::readElems(const std::vector<std::string>& tokens) const {
     return readElems_impl(tokens, T{});
 }
 
+template<typename T>
+void
+DelimFileAdapter<T>::readElem(const Token& token, T& elem) const {
+    readElem_impl(token, elem);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::readElem_impl(const Token& token, double& elem) const {
+    elem = parseDouble(token);
+}
+
+template<typename T>
+template<typename U>
+void
+DelimFileAdapter<T>::readElem_impl(const Token& token, U& elem) const {
+    // Elements with components are rare enough to go through readElems().
+    elem = readElems({std::string{token.first, token.second}})[0];
+}
+
 template<typename T>
 SimTK::RowVector_<double>
 DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
@@ -523,6 +606,7 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
                                  const std::string& fileName) const {
     OPENSIM_THROW_IF(absTables.empty(),
                      NoTableFound);
+    OPENSIM_TRACE_SPAN("io", "write table", fileName);
 
     const TimeSeriesTable_<T>* table{};
     try {
@@ -531,31 +615,67 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
     } catch(std::out_of_range&) {
         OPENSIM_THROW(KeyMissing,
                       tableString());
-    } catch(std::bad_cast&) {
-        OPENSIM_THROW(IncorrectTableType);
     }
+    OPENSIM_THROW_IF(table == nullptr,
+                     IncorrectTableType);
+
+    writeTable(TimeSeriesTableView_<T>{*table}, fileName);
+}
 
+template<typename T>
+void
+DelimFileAdapter<T>::writeTable(const TimeSeriesTableView_<T>& view,
+                                const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ofstream out_stream{fileName};
+    // Compressed files (e.g., .sto.gz) are compressed as they are written.
+    auto stream = CompressedFile::openForWriting(fileName);
+    std::ostream& out_stream = *stream;
+
+    const auto& table = view.getTable();
+    writeHeader(out_stream, table.getTableMetaData(), view.getColumnLabels());
+
+    // Data rows, formatted in blocks (concurrently, if requested). The rows
+    // appended to the table are added to its matrix here, rather than by the
+    // threads.
+    const auto& matrix = table.getMatrix();
+    const auto& times = table.getIndependentColumn();
+    std::vector<size_t> columns{};
+    for(size_t col = 0; col < view.getNumColumns(); ++col)
+        columns.push_back(view.getColumnIndexInTable(col));
+    IO::WriteRows(static_cast<int>(view.getNumRows()),
+        [&](int row, std::string& text) {
+            const size_t tableRow{view.getRowIndexInTable(row)};
+            appendRow(text, times[tableRow],
+                      matrix.row(static_cast<int>(tableRow)), columns);
+        },
+        [&](const std::string& text) {
+            out_stream.write(text.data(), text.size());
+            return static_cast<bool>(out_stream);
+        });
+    OPENSIM_THROW_IF(!out_stream.flush(), Exception,
+                     "Could not write file '" + fileName + "'.");
+}
 
+template<typename T>
+void
+DelimFileAdapter<T>::writeHeader(std::ostream& out_stream,
+                        const AbstractDataTable::TableMetaData& metadata,
+                        const std::vector<std::string>& labels) const {
     // First line of the stream is the header.
-    if (table->getTableMetaData().hasKey("header")) {
-        out_stream << table->
-                      getTableMetaData().
+    if (metadata.hasKey("header")) {
+        out_stream << metadata.
                       getValueForKey("header").
                       template getValue<std::string>() << "\n";
     }
-    // Write rest of the key-value pairs and end the header.
-    for(const auto& key : table->getTableMetaDataKeys()) {
-        try {
-            if(key != "header")
-                out_stream << key << "=" 
-                           << table->
-                              template getTableMetaData<std::string>(key) 
-                           << "\n";
-        } catch(const InvalidTemplateArgument&) {}
+    // Write rest of the key-value pairs (those with string values) and end
+    // the header.
+    for(const auto& key : metadata.getKeys()) {
+        const auto* value = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metadata.getValueForKey(key));
+        if(key != "header" && value)
+            out_stream << key << "=" << value->get() << "\n";
     }
     // Write name of the data-type -- vec3, vec6, etc.
     out_stream << _dataTypeString << "=" << dataTypeName() << "\n";
@@ -565,27 +685,46 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     // Line containing column labels.
     out_stream << _timeColumnLabel;
-    for(unsigned col = 0; col < table->getNumColumns(); ++col)
-        out_stream << _delimiterWrite
-                   << table->
-                      getDependentsMetaData().
-                      getValueArrayForKey("labels")[col].
-                      template getValue<std::string>();
+    for(const auto& label : labels)
+        out_stream << _delimiterWrite << label;
     out_stream << "\n";
+}
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << std::setprecision(prec)
-                   << table->getIndependentColumn()[row];
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << _delimiterWrite;
-            writeElem(out_stream, elt, prec);
-        }
-        out_stream << "\n";
+template<typename T>
+void
+DelimFileAdapter<T>::writeRow(std::ostream& out_stream,
+                              double time,
+                              const SimTK::RowVectorBase<T>& row) const {
+    std::string text{};
+    appendRow(text, time, row);
+    out_stream << text;
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::appendRow(std::string& text,
+                               double time,
+                               const SimTK::RowVectorBase<T>& row) const {
+    IO::AppendDouble(text, elemFormat(), time);
+    for(int col = 0; col < row.size(); ++col) {
+        text += _delimiterWrite;
+        appendElem_impl(text, row[col], elemFormat());
+    }
+    text += '\n';
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::appendRow(std::string& text,
+                               double time,
+                               const SimTK::RowVectorBase<T>& row,
+                               const std::vector<size_t>& columns) const {
+    IO::AppendDouble(text, elemFormat(), time);
+    for(const size_t col : columns) {
+        text += _delimiterWrite;
+        appendElem_impl(text, row[static_cast<int>(col)], elemFormat());
     }
+    text += '\n';
 }
 
 template<typename T>
@@ -593,39 +732,44 @@ void
 DelimFileAdapter<T>::writeElem(std::ostream& stream,
                                const T& elem,
                                const unsigned& prec) const {
-    writeElem_impl(stream, elem, prec);
+    const std::string format = "%." + std::to_string(prec) + "g";
+    std::string text{};
+    appendElem_impl(text, elem, format.c_str());
+    stream << text;
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const double& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem;
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const double& elem,
+                                     const char* format) const {
+    IO::AppendDouble(text, format, elem);
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::SpatialVec& elem,
-                                    const unsigned& prec) const {
-    stream                    << std::setprecision(prec) << elem[0][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][2]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][2];
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const SimTK::SpatialVec& elem,
+                                     const char* format) const {
+    for(int i = 0; i < 2; ++i)
+        for(int j = 0; j < 3; ++j) {
+            if(i + j > 0)
+                text += _compDelimWrite;
+            IO::AppendDouble(text, format, elem[i][j]);
+        }
 }
 
 template<typename T>
 template<int M>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::Vec<M>& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem[0];
-    for(auto i = 1u; i < M; ++i)
-        stream << _compDelimWrite << std::setprecision(prec) << elem[i];
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const SimTK::Vec<M>& elem,
+                                     const char* format) const {
+    IO::AppendDouble(text, format, elem[0]);
+    for(auto i = 1u; i < M; ++i) {
+        text += _compDelimWrite;
+        IO::AppendDouble(text, format, elem[i]);
+    }
 }
 
 } // namespace OpenSim
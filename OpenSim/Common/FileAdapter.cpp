@@ -1,4 +1,16 @@
 #include "FileAdapter.h"
+#include "CompressedFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
 
 namespace OpenSim {
 
@@ -8,12 +20,22 @@ createSTOFileAdapterForReading(const std::string&);
 std::shared_ptr<DataAdapter>
 createSTOFileAdapterForWriting(const DataAdapter::InputTables&);
 
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForReading(const std::string&);
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForWriting(const DataAdapter::InputTables&);
+
 FileAdapter::OutputTables
 FileAdapter::readFile(const std::string& fileName) {
-    auto extension = findExtension(fileName);
+    // Compressed files are read by the adapter of the inner extension.
+    auto extension = findExtension(
+            CompressedFile::removeCompressionExtension(fileName));
     std::shared_ptr<DataAdapter> dataAdapter{};
     if(extension == "sto")
         dataAdapter = createSTOFileAdapterForReading(fileName);
+    else if(extension == "bsto")
+        dataAdapter = createBinaryFileAdapterForReading(fileName);
     else 
         dataAdapter = createAdapter(extension);
     auto& fileAdapter = static_cast<FileAdapter&>(*dataAdapter);
@@ -23,10 +45,13 @@ FileAdapter::readFile(const std::string& fileName) {
 void 
 FileAdapter::writeFile(const InputTables& tables, 
                        const std::string& fileName) {
-    auto extension = findExtension(fileName);
+    auto extension = findExtension(
+            CompressedFile::removeCompressionExtension(fileName));
     std::shared_ptr<DataAdapter> dataAdapter{};
     if(extension == "sto")
         dataAdapter = createSTOFileAdapterForWriting(tables);
+    else if(extension == "bsto")
+        dataAdapter = createBinaryFileAdapterForWriting(tables);
     else
         dataAdapter = createAdapter(extension);
     auto& fileAdapter = static_cast<FileAdapter&>(*dataAdapter);
@@ -93,4 +118,125 @@ FileAdapter::getNextLine(std::istream& stream,
     return {};
 }
 
+FileAdapter::DataLines::DataLines(std::istream& stream,
+                                  const std::string& delims,
+                                  size_t firstLineNum) {
+    std::fill(std::begin(_isDelim), std::end(_isDelim), false);
+    for(const char c : delims)
+        _isDelim[static_cast<unsigned char>(c)] = true;
+    _isDelim[static_cast<unsigned char>('\r')] = true;
+
+    // Read everything at once rather than line by line.
+    if(stream) {
+        const auto start = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        const auto end = stream.tellg();
+        if(start != std::streampos(-1) && end != std::streampos(-1)) {
+            stream.seekg(start);
+            _buffer.resize(static_cast<size_t>(end - start));
+            stream.read(&_buffer[0], _buffer.size());
+            // In text mode, fewer characters may be read than the size.
+            _buffer.resize(static_cast<size_t>(stream.gcount()));
+        } else {
+            stream.clear();
+            std::ostringstream contents{};
+            contents << stream.rdbuf();
+            _buffer = contents.str();
+        }
+    }
+
+    size_t lineNum{firstLineNum};
+    size_t begin{0};
+    while(begin < _buffer.size()) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(&_buffer[begin], '\n', _buffer.size() - begin));
+        const size_t end = newline ? size_t(newline - _buffer.data())
+                                   : _buffer.size();
+        for(size_t i = begin; i < end; ++i) {
+            if(!isDelim(_buffer[i])) {
+                _lines.push_back({begin, end, lineNum});
+                break;
+            }
+        }
+        begin = end + 1;
+        ++lineNum;
+    }
+}
+
+void
+FileAdapter::DataLines::tokenize(size_t index,
+                                 std::vector<Token>& tokens) const {
+    tokens.clear();
+    const char* c = _buffer.data() + _lines[index].begin;
+    const char* end = _buffer.data() + _lines[index].end;
+    while(c < end) {
+        while(c < end && isDelim(*c))
+            ++c;
+        if(c == end)
+            break;
+        const char* tokenStart = c;
+        while(c < end && !isDelim(*c))
+            ++c;
+        tokens.emplace_back(tokenStart, c);
+    }
+}
+
+double
+FileAdapter::parseDouble(const Token& token) {
+    // The token is followed by a delimiter, a newline or the terminating null
+    // character of the buffer, none of which are part of a number, so strtod
+    // stops at (or before) the end of the token.
+    char* parsedEnd{};
+    errno = 0;
+    const double value = std::strtod(token.first, &parsedEnd);
+    if(parsedEnd == token.first)
+        throw std::invalid_argument{"Could not parse '" +
+                                    std::string{token.first, token.second} +
+                                    "' as a number."};
+    if(errno == ERANGE)
+        throw std::out_of_range{"Number '" +
+                                std::string{token.first, token.second} +
+                                "' is out of range."};
+    return value;
+}
+
+void
+FileAdapter::parseRowsInParallel(size_t numRows,
+                const std::function<void(size_t, size_t)>& parseRows) {
+    // Threads are only worth starting for large files.
+    const size_t minRowsPerBlock{4096};
+    size_t numBlocks = std::min<size_t>(std::thread::hardware_concurrency(),
+                                        numRows / minRowsPerBlock);
+    if(numBlocks <= 1) {
+        parseRows(0, numRows);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(numBlocks);
+    auto parseBlock = [&](size_t block) {
+        try {
+            parseRows(numRows * block / numBlocks,
+                      numRows * (block + 1) / numBlocks);
+        } catch(...) {
+            errors[block] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads{};
+    for(size_t block = 1; block < numBlocks; ++block) {
+        try {
+            threads.emplace_back(parseBlock, block);
+        } catch(const std::system_error&) {
+            // Could not start a thread; parse this block here instead.
+            parseBlock(block);
+        }
+    }
+    parseBlock(0);
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& error : errors)
+        if(error)
+            std::rethrow_exception(error);
+}
+
 } // namespace OpenSim
@@ -28,6 +28,9 @@
 */
 #include "DataAdapter.h"
 
+#include <functional>
+#include <iosfwd>
+#include <utility>
 #include <vector>
 
 namespace OpenSim {
@@ -213,6 +216,62 @@ protected:
     the given delimiters.                                                     */
     std::vector<std::string> getNextLine(std::istream& stream,
                                          const std::string& delims) const;
+
+    /** A token of a line held by DataLines: the characters in
+    [first, second).                                                          */
+    typedef std::pair<const char*, const char*> Token;
+
+    /** The remaining lines of a stream (typically the rows of data after the
+    header of a file), read into memory all at once. The lines can then be
+    split into tokens in place, without copying each line and token into its
+    own string, and from multiple threads. As with getNextLine(), the lines
+    that contain only delimiters are skipped, and a '\r' is treated as a
+    delimiter so that files with CRLF line endings are handled.               */
+    class OSIMCOMMON_API DataLines {
+    public:
+        /** Read the rest of the stream. The first line read has line number
+        firstLineNum in the file.                                             */
+        DataLines(std::istream& stream,
+                  const std::string& delims,
+                  size_t firstLineNum);
+
+        /** Number of (non-empty) lines.                                      */
+        size_t getNumLines() const { return _lines.size(); }
+
+        /** Line number (in the file) of the line at the given index.         */
+        size_t getLineNumber(size_t index) const
+        {   return _lines[index].lineNum; }
+
+        /** Split the line at the given index into tokens using the
+        delimiters. The tokens point into this object.                        */
+        void tokenize(size_t index, std::vector<Token>& tokens) const;
+
+    private:
+        struct Line {
+            size_t begin;
+            size_t end;
+            size_t lineNum;
+        };
+        bool isDelim(char c) const
+        {   return _isDelim[static_cast<unsigned char>(c)]; }
+
+        std::string       _buffer;
+        std::vector<Line> _lines;
+        bool              _isDelim[256];
+    };
+
+    /** Parse a token as a double. Like std::stod(), throws
+    std::invalid_argument if the token does not start with a number and
+    std::out_of_range if the number is out of range.                         */
+    static double parseDouble(const Token& token);
+
+    /** Call parseRows(begin, end) on consecutive blocks of rows that together
+    cover rows [0, numRows). If there are many rows, the blocks are parsed
+    in parallel, so parseRows must only touch the given rows of its output.
+    If parseRows throws for any block, the exception of the first such block
+    is rethrown.                                                              */
+    static void parseRowsInParallel(size_t numRows,
+                const std::function<void(size_t, size_t)>& parseRows);
 };
 
 } // OpenSim namespace
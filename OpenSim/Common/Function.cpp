@@ -166,6 +166,13 @@ double Function::calcValue(const Vector& x) const
     return _function->calcValue(x);
 }
 
+double Function::calcValue(double x) const
+{
+    thread_local Vector workX(1);
+    workX[0] = x;
+    return calcValue(workX);
+}
+
 double Function::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
     if (_function == NULL)
@@ -102,6 +102,15 @@ public:
      *          its size must equal the value returned by getArgumentSize().
      */
     virtual double calcValue(const SimTK::Vector& x) const;
+    /**
+     * Calculate the value of this function of one argument at x, as
+     * calcValue(const SimTK::Vector&) would, without a Vector for the
+     * argument; this is the cheaper call for scalar curves evaluated often
+     * (e.g., the force-length curves of ligaments). The default copies x into
+     * a Vector kept for each thread; functions that can be evaluated directly
+     * at a scalar override it.
+     */
+    virtual double calcValue(double x) const;
     /**
      * Calculate a partial derivative of this function at a particular point.  Which derivative to take is specified
      * by listing the input components with which to take it.  For example, if derivComponents=={0}, that indicates
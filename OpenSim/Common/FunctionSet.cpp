@@ -114,10 +114,7 @@ evaluate(int aIndex,int aDerivOrder,double aX) const
     if (aDerivOrder==0)
         return (func.calcValue(arg));
 
-    std::vector<int> derivComponents;
-    for(int i=0; i<aDerivOrder; i++)
-        derivComponents.push_back(0);
-
+    const std::vector<int> derivComponents(aDerivOrder, 0);
     return( func.calcDerivative(derivComponents, arg) );
 }
 
@@ -140,17 +137,68 @@ evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
     int size = getSize();
     rValues.setSize(size);
 
+    const SimTK::Vector arg(1,aX);
+    const std::vector<int> derivComponents(aDerivOrder>0 ? aDerivOrder : 0,0);
     int i;
     for(i=0;i<size;i++) {
         Function& func = get(i);
         if (aDerivOrder==0)
-            rValues[i] = func.calcValue(SimTK::Vector(1,aX));
-        else {
-            std::vector<int> derivComponents;
-            for(int j=0; j<aDerivOrder; j++)
-                derivComponents.push_back(0);
-            rValues[i] = func.calcDerivative(derivComponents, SimTK::Vector(1,aX));
-
-        }
+            rValues[i] = func.calcValue(arg);
+        else
+            rValues[i] = func.calcDerivative(derivComponents, arg);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions in the function set, or their derivatives of
+ * one order, at one value of the independent variable.
+ *
+ * @param aX Value of the x independent variable.
+ * @param aDerivOrder Order of the derivative to evaluate (0 for the value).
+ * @param rValues Vector containing the values of the functions.
+ */
+void FunctionSet::
+evaluateAll(double aX,int aDerivOrder,SimTK::Vector &rValues) const
+{
+    const int size = getSize();
+    if(rValues.size()!=size) rValues.resize(size);
+
+    const SimTK::Vector arg(1,aX);
+    const std::vector<int> derivComponents(aDerivOrder>0 ? aDerivOrder : 0,0);
+    for(int i=0;i<size;i++) {
+        const Function& func = get(i);
+        rValues[i] = aDerivOrder==0 ? func.calcValue(arg) :
+                     func.calcDerivative(derivComponents,arg);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions in the function set and their first and second
+ * derivatives at one value of the independent variable.
+ *
+ * @param aX Value of the x independent variable.
+ * @param rValues Vector containing the values of the functions.
+ * @param rFirstDerivatives Vector containing their first derivatives.
+ * @param rSecondDerivatives Vector containing their second derivatives.
+ */
+void FunctionSet::
+evaluateAll(double aX,SimTK::Vector &rValues,
+            SimTK::Vector &rFirstDerivatives,
+            SimTK::Vector &rSecondDerivatives) const
+{
+    const int size = getSize();
+    if(rValues.size()!=size) rValues.resize(size);
+    if(rFirstDerivatives.size()!=size) rFirstDerivatives.resize(size);
+    if(rSecondDerivatives.size()!=size) rSecondDerivatives.resize(size);
+
+    const SimTK::Vector arg(1,aX);
+    const std::vector<int> first(1,0), second(2,0);
+    for(int i=0;i<size;i++) {
+        const Function& func = get(i);
+        rValues[i] = func.calcValue(arg);
+        rFirstDerivatives[i] = func.calcDerivative(first,arg);
+        rSecondDerivatives[i] = func.calcDerivative(second,arg);
     }
 }
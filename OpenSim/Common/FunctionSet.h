@@ -75,6 +75,19 @@ public:
     virtual void
         evaluate(Array<double> &rValues,int aDerivOrder,
         double aX=0.0) const;
+    /** Evaluate all the functions (or their derivatives of order
+    aDerivOrder) at aX, setting rValues[i] to the value for function i.
+    rValues is resized to getSize() if needed. This is faster than calling
+    evaluate() for each function: the argument and derivative workspaces are
+    set up once for all functions. */
+    void evaluateAll(double aX,int aDerivOrder,SimTK::Vector &rValues) const;
+    /** Evaluate all the functions and their first and second derivatives at
+    aX in one pass over the functions (see evaluateAll() above). Evaluating
+    the three at once lets each function reuse the lookups it made for the
+    value (e.g., a spline's knot interval) for its derivatives. */
+    void evaluateAll(double aX,SimTK::Vector &rValues,
+        SimTK::Vector &rFirstDerivatives,
+        SimTK::Vector &rSecondDerivatives) const;
 
 //=============================================================================
 };  // END class FunctionSet
@@ -402,6 +402,16 @@ getHalfOrder() const
     return(_halfOrder);
 }
 
+//-----------------------------------------------------------------------------
+// ERROR VARIANCE
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+double GCVSpline::
+getErrorVariance() const
+{
+    return(_errorVariance);
+}
+
 //-----------------------------------------------------------------------------
 // NUMBER OF DATA POINTS (N)
 //-----------------------------------------------------------------------------
@@ -600,3 +610,31 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
     return spline;
 }
 
+
+//=============================================================================
+// FITTING
+//=============================================================================
+//_____________________________________________________________________________
+void GCVSpline::fit() const
+{
+    if (_function == NULL)
+        _function = createSimTKFunction();
+}
+//_____________________________________________________________________________
+void GCVSpline::setFitCoefficients(const Array<double>& aCoefficients)
+{
+    OPENSIM_THROW_IF_FRMOBJ(aCoefficients.getSize() != _x.getSize(),
+            Exception, "Expected " + std::to_string(_x.getSize()) +
+            " coefficients but got " +
+            std::to_string(aCoefficients.getSize()) + ".");
+
+    resetFunction();
+    Vector x(_x.getSize());
+    Vector coefficients(_x.getSize());
+    for (int i = 0; i < x.size(); ++i) {
+        x[i] = _x[i];
+        coefficients[i] = aCoefficients[i];
+    }
+    _coefficients = aCoefficients;
+    _function = new SimTK::Spline(_halfOrder*2-1, x, coefficients);
+}
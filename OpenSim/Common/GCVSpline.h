@@ -176,6 +176,12 @@ public:
      * @return Half order of spline: 1 = linear, 2 = cubic, 3 = quintic, 4 = heptic.
      */
     int getHalfOrder() const;
+    /**
+     * Get the error variance that the spline is fit with.
+     *
+     * @return Error variance; negative if it is estimated by the fit.
+     */
+    double getErrorVariance() const;
     /**
      * Get size or number of independent data points (or number of coefficients)
      * used to construct the spline.
@@ -230,6 +236,27 @@ public:
     virtual int addPoint(double aX, double aY);
     SimTK::Function* createSimTKFunction() const override;
 
+    //--------------------------------------------------------------------------
+    // FITTING
+    //--------------------------------------------------------------------------
+    /**
+     * Fit the spline to its data now, rather than when it is first
+     * evaluated, and keep the fit for evaluating the spline.  The
+     * coefficients of the fit are then available from getCoefficients().
+     * Fitting different splines concurrently is safe.
+     */
+    void fit() const;
+    /**
+     * Evaluate the spline with the provided coefficients instead of fitting
+     * it, e.g., with the coefficients of an earlier fit of the same data
+     * with the same degree and error variance.  The spline is fit again if
+     * its data are changed afterwards.
+     *
+     * @param aCoefficients One coefficient for each data point.
+     * @throws Exception if the number of coefficients is not getSize().
+     */
+    void setFitCoefficients(const Array<double>& aCoefficients);
+
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
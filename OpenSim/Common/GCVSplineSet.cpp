@@ -25,9 +25,123 @@
 #include "GCVSpline.h"
 #include "Storage.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
 
 using namespace OpenSim;
 
+namespace {
+    std::atomic<int> numThreadsForFitting{0};
+    std::mutex cacheDirectoryMutex;
+    std::string cacheDirectory;
+
+    // Identifies (and is the version of the layout of) a cache file, which
+    // holds the number of coefficients followed by the coefficients.
+    const char cacheFileMagic[8] = {'O','S','I','M','G','C','V','1'};
+
+    // The 64-bit FNV-1a hash of the data and fit parameters of a spline.
+    std::uint64_t hashSpline(const GCVSpline& spline) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto add = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes =
+                    static_cast<const unsigned char*>(data);
+            for(size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+        const int degree = spline.getDegree();
+        const double errorVariance = spline.getErrorVariance();
+        const int n = spline.getSize();
+        add(&degree, sizeof(degree));
+        add(&errorVariance, sizeof(errorVariance));
+        add(&n, sizeof(n));
+        if(n > 0) {
+            add(spline.getXValues(), n * sizeof(double));
+            add(spline.getYValues(), n * sizeof(double));
+        }
+        return hash;
+    }
+
+    std::string cacheFileName(const std::string& directory,
+                              const GCVSpline& spline) {
+        char name[40];
+        sprintf(name, "gcvspline_%016llx.bin",
+                (unsigned long long)hashSpline(spline));
+        return directory + "/" + name;
+    }
+
+    // Use the coefficients stored in the cache file of the spline, if the
+    // file exists and is valid.
+    bool readCachedFit(const std::string& fileName, GCVSpline& spline) {
+        std::ifstream in(fileName, std::ios::binary);
+        if(!in) return false;
+        char magic[sizeof(cacheFileMagic)];
+        std::int64_t n = -1;
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(&n), sizeof(n));
+        if(!in || !std::equal(magic, magic + sizeof(magic), cacheFileMagic)
+               || n != spline.getSize())
+            return false;
+        Array<double> coefficients(0.0, (int)n);
+        if(n > 0)
+            in.read(reinterpret_cast<char*>(&coefficients[0]),
+                    n * sizeof(double));
+        if(!in) return false;
+        spline.setFitCoefficients(coefficients);
+        return true;
+    }
+
+    // Store the coefficients of a fit spline. The file is written under a
+    // temporary name and then renamed, so that concurrent runs sharing the
+    // cache never read a partially written file.
+    void writeCachedFit(const std::string& fileName,
+                        const GCVSpline& spline) {
+        const Array<double>& coefficients = spline.getCoefficients();
+        const std::int64_t n = coefficients.getSize();
+        std::ostringstream tmpName;
+        tmpName << fileName << ".tmp" << std::this_thread::get_id();
+        {
+            std::ofstream out(tmpName.str(), std::ios::binary);
+            out.write(cacheFileMagic, sizeof(cacheFileMagic));
+            out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+            if(n > 0)
+                out.write(reinterpret_cast<const char*>(&coefficients[0]),
+                          n * sizeof(double));
+            if(!out) {
+                out.close();
+                std::remove(tmpName.str().c_str());
+                return;
+            }
+        }
+        if(std::rename(tmpName.str().c_str(), fileName.c_str()) != 0)
+            std::remove(tmpName.str().c_str());
+    }
+
+    void fitSpline(GCVSpline& spline, const std::string& directory) {
+        // Splines without data (too few points were given) are left alone.
+        if(spline.getSize() == 0) return;
+        if(directory.empty()) {
+            spline.fit();
+            return;
+        }
+        const std::string fileName = cacheFileName(directory, spline);
+        if(readCachedFit(fileName, spline)) return;
+        spline.fit();
+        writeCachedFit(fileName, spline);
+    }
+} // namespace
+
 GCVSplineSet::~GCVSplineSet() {
     // No operation;
 }
@@ -68,6 +182,7 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines(0);
 }
 
 void GCVSplineSet::setNull() {
@@ -81,18 +196,47 @@ void GCVSplineSet::construct(int aDegree,
 
     // DESCRIPTION
     setDescription(aStore->getDescription());
+    const int begin = getSize();
 
     // GET COLUMN NAMES
     const Array<std::string> &labels = aStore->getColumnLabels();
     char tmp[32];
     std::string name;
 
-    // LOOP THROUGH THE STATES
+    // STATES THAT ALL STATEVECTORS HAVE
+    // Their data are transposed into a (column-major) matrix in one pass
+    // over the storage, so that the data of each state are contiguous,
+    // rather than visiting every StateVector again for each state.
+    const int nRows = aStore->getSize();
+    const int nCommon = nRows>0 ? aStore->getSmallestNumberOfStates() : 0;
+    GCVSpline *spline;
+    if(nCommon>0) {
+        std::vector<double> commonTimes(nRows);
+        SimTK::Matrix commonData(nRows,nCommon);
+        for(int r=0;r<nRows;r++) {
+            const StateVector *vec = aStore->getStateVector(r);
+            const Array<double> &values = vec->getData();
+            commonTimes[r] = vec->getTime();
+            for(int c=0;c<nCommon;c++) commonData(r,c) = values[c];
+        }
+        for(int i=0;i<nCommon;i++) {
+            if(i+1 < labels.getSize()) {
+                name = labels[i+1];
+            } else {
+                sprintf(tmp,"data_%d",i);
+                name = tmp;
+            }
+            spline = new GCVSpline(aDegree,nRows,commonTimes.data(),
+                                   &commonData(0,i),name,aErrorVariance);
+            adoptAndAppend(spline);
+        }
+    }
+
+    // LOOP THROUGH THE REMAINING STATES
     int nTime=1,nData=1;
     double *times=NULL,*data=NULL;
-    GCVSpline *spline;
     //printf("GCVSplineSet.construct:  constructing splines...\n");
-    for(int i=0;nData>0;i++) {
+    for(int i=nCommon;nData>0;i++) {
 
         // GET TIMES AND DATA
         nTime = aStore->getTimeColumn(times,i);
@@ -119,8 +263,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -130,6 +272,75 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT THE SPLINES
+    fitSplines(begin);
+}
+
+void GCVSplineSet::fitSplines(int aBegin) const {
+    const int nSplines = getSize() - aBegin;
+    if(nSplines<=0) return;
+    const std::string directory = getCacheDirectory();
+
+    // Threads are only worth starting if there are many points to fit.
+    const size_t minPointsPerBlock = 10000;
+    size_t nPoints = 0;
+    for(int i=aBegin;i<getSize();i++) nPoints += getGCVSpline(i)->getSize();
+    int numThreads = getNumThreadsForFitting();
+    if(numThreads<=0) numThreads = std::thread::hardware_concurrency();
+    int numBlocks = std::min(numThreads,nSplines);
+    numBlocks = (int)std::min<size_t>(numBlocks,nPoints/minPointsPerBlock);
+    if(numBlocks<1) numBlocks = 1;
+
+    std::vector<std::exception_ptr> errors(numBlocks);
+    auto fitBlock = [&](int block) {
+        try {
+            const int first = aBegin + nSplines*block/numBlocks;
+            const int last = aBegin + nSplines*(block+1)/numBlocks;
+            for(int i=first;i<last;i++)
+                fitSpline(*getGCVSpline(i),directory);
+        } catch(...) {
+            errors[block] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int block=1;block<numBlocks;block++) {
+        try {
+            threads.emplace_back(fitBlock,block);
+        } catch(const std::system_error&) {
+            // Could not start a thread; fit this block here instead.
+            fitBlock(block);
+        }
+    }
+    fitBlock(0);
+    for(auto &thread : threads) thread.join();
+
+    for(const auto &error : errors)
+        if(error) std::rethrow_exception(error);
+}
+
+void GCVSplineSet::setNumThreadsForFitting(int aNumThreads) {
+    numThreadsForFitting.store(std::max(aNumThreads,0));
+}
+
+int GCVSplineSet::getNumThreadsForFitting() {
+    return numThreadsForFitting.load();
+}
+
+void GCVSplineSet::setCacheDirectory(const std::string& aDirectory) {
+    std::lock_guard<std::mutex> lock(cacheDirectoryMutex);
+    cacheDirectory = aDirectory;
+}
+
+std::string GCVSplineSet::getCacheDirectory() {
+    std::lock_guard<std::mutex> lock(cacheDirectoryMutex);
+    return cacheDirectory;
+}
+
+std::string GCVSplineSet::getCacheFileName(const GCVSpline& aSpline) {
+    const std::string directory = getCacheDirectory();
+    if(directory.empty()) return "";
+    return cacheFileName(directory,aSpline);
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -109,6 +109,40 @@ public:
                  double errorVariance                   = 0.0);
     virtual ~GCVSplineSet();
 
+    //--------------------------------------------------------------------------
+    // FITTING
+    //--------------------------------------------------------------------------
+    /**
+     * %Set the number of threads used to fit the splines of the sets that are
+     * constructed from a Storage or a TimeSeriesTable.  The splines of a set
+     * are fit concurrently only if the set has many data points in total.
+     *
+     * @param aNumThreads Maximum number of threads; 0 (the default) uses one
+     * thread per hardware thread, and 1 fits the splines one after another.
+     */
+    static void setNumThreadsForFitting(int aNumThreads);
+    static int getNumThreadsForFitting();
+    /**
+     * %Set a directory in which the coefficients of the splines fit by
+     * the constructors are cached, so that fitting the same data with the
+     * same degree and error variance again (e.g., in a later run) reads the
+     * coefficients rather than fitting the spline.  Each fit is stored in a
+     * file named after a hash of its data and parameters; the directory
+     * must exist, and files that cannot be read or written are ignored.
+     *
+     * @param aDirectory Cache directory; empty (the default) disables the
+     * cache.
+     */
+    static void setCacheDirectory(const std::string& aDirectory);
+    static std::string getCacheDirectory();
+    /**
+     * Get the file in the cache directory that holds (or would hold) the
+     * fit of a spline.
+     *
+     * @return Path of the file; empty if the cache is disabled.
+     */
+    static std::string getCacheFileName(const GCVSpline& aSpline);
+
 private:
     /**
      * Set all member variables to NULL values.
@@ -125,6 +159,13 @@ private:
      */
     void construct(int aDegree,const Storage *aStore,double aErrorVariance);
 
+    /**
+     * Fit the splines from index aBegin to the end of the set, in parallel
+     * if there are many data points, using the cache directory if one is
+     * set.
+     */
+    void fitSplines(int aBegin) const;
+
 public:
     /**
      * Get the function at a specified index.
@@ -31,6 +31,12 @@
 #include <math.h>
 #include <string>
 #include <climits>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "IO.h"
 #if defined(__linux__) || defined(__APPLE__)
@@ -63,6 +69,8 @@ int IO::_Pad = 8;
 int IO::_Precision = 8;
 char IO::_DoubleFormat[] = "%16.8lf";
 bool IO::_PrintOfflineDocuments = true;
+int IO::_NumWriterThreads = 1;
+bool IO::_BinarySinglePrecision = false;
 
 
 //=============================================================================
@@ -297,6 +305,119 @@ ConstructDoubleOutputFormat()
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Append a double, formatted with a printf-style format for one double, to a
+ * string. Unlike fprintf() to a FILE, this does not lock a stream, so rows
+ * can be formatted on several threads.
+ */
+void IO::
+AppendDouble(std::string& rBuffer,const char* aFormat,double aValue)
+{
+    char text[64];
+    int n = snprintf(text,sizeof(text),aFormat,aValue);
+    if(n<0) return;
+    if(n<(int)sizeof(text)) {
+        rBuffer.append(text,n);
+        return;
+    }
+    // Very large numbers in fixed format.
+    const std::string::size_type size = rBuffer.size();
+    rBuffer.resize(size+n+1);
+    snprintf(&rBuffer[size],n+1,aFormat,aValue);
+    rBuffer.resize(size+n);
+}
+
+//=============================================================================
+// DATA FILE WRITING
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Set the number of threads that format the rows of data files.
+ */
+void IO::
+SetNumWriterThreads(int aNumThreads)
+{
+    _NumWriterThreads = aNumThreads;
+}
+//_____________________________________________________________________________
+/**
+ * Get the number of threads that format the rows of data files.
+ */
+int IO::
+GetNumWriterThreads()
+{
+    return(_NumWriterThreads);
+}
+//_____________________________________________________________________________
+/**
+ * Set whether binary data files store their values as floats.
+ */
+void IO::
+SetBinarySinglePrecision(bool aSinglePrecision)
+{
+    _BinarySinglePrecision = aSinglePrecision;
+}
+//_____________________________________________________________________________
+/**
+ * Get whether binary data files store their values as floats.
+ */
+bool IO::
+GetBinarySinglePrecision()
+{
+    return(_BinarySinglePrecision);
+}
+//_____________________________________________________________________________
+/**
+ * Format rows in blocks, each block on one thread, and write the blocks in
+ * order. Each block is written with one call to aWrite().
+ */
+bool IO::
+WriteRows(int aNumRows,
+          const std::function<void(int, std::string&)>& aFormatRow,
+          const std::function<bool(const std::string&)>& aWrite)
+{
+    const int blockSize = 64;
+    const int numBlocks = (aNumRows+blockSize-1)/blockSize;
+    int numThreads = _NumWriterThreads;
+    if(numThreads<=0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1,std::min(numThreads,numBlocks));
+
+    std::vector<std::string> blocks(numThreads);
+    std::vector<std::exception_ptr> errors(numThreads);
+    for(int first=0;first<aNumRows;first+=numThreads*blockSize) {
+        auto formatBlock = [&](int b) {
+            try {
+                blocks[b].clear();
+                const int begin = first + b*blockSize;
+                const int end = std::min(begin+blockSize,aNumRows);
+                for(int r=begin;r<end;r++) aFormatRow(r,blocks[b]);
+            } catch(...) {
+                errors[b] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        int b=1;
+        for(;b<numThreads;b++) {
+            try {
+                threads.emplace_back(formatBlock,b);
+            } catch(const std::system_error&) {
+                // Could not start a thread; format the rest here.
+                break;
+            }
+        }
+        formatBlock(0);
+        for(int rest=b;rest<numThreads;rest++) formatBlock(rest);
+        for(auto& thread : threads) thread.join();
+
+        for(int i=0;i<numThreads;i++) {
+            if(errors[i]) std::rethrow_exception(errors[i]);
+            if(!blocks[i].empty() && !aWrite(blocks[i])) return(false);
+        }
+    }
+    return(true);
+}
+
 //=============================================================================
 // Object printing
 //=============================================================================
@@ -493,6 +614,12 @@ chDir(const string &aDirName)
     return _chdir(aDirName.c_str());
 #endif
 
+}
+std::recursive_mutex& IO::
+getWorkingDirectoryMutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
 }
 //_____________________________________________________________________________
 /**
@@ -31,6 +31,9 @@
 // INCLUDES
 #include "osimCommonDLL.h"
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
 
 // DEFINES
 const int IO_STRLEN = 2048;
@@ -64,6 +67,10 @@ private:
     static char _DoubleFormat[256];
     /** Whether offline documents should also be printed when Object::print is called. */
     static bool _PrintOfflineDocuments;
+    /** Number of threads that format the rows of data files. */
+    static int _NumWriterThreads;
+    /** Whether binary data files store their values as floats. */
+    static bool _BinarySinglePrecision;
 
 
 //=============================================================================
@@ -84,9 +91,41 @@ public:
     static int GetPrecision();
     static const char*
         GetDoubleOutputFormat();
+#ifndef SWIG
+    /** Append a double, formatted with a printf-style format for one double
+    (e.g., GetDoubleOutputFormat()), to a string. */
+    static void AppendDouble(std::string& rBuffer, const char* aFormat,
+                             double aValue);
+#endif
 private:
     static void ConstructDoubleOutputFormat();
 
+public:
+    // DATA FILE WRITING
+    /** Number of threads that format blocks of rows at once when writing
+    data files (Storage::print() and the writers of DelimFileAdapter, e.g.,
+    STOFileAdapter); if not positive, the number of hardware threads is used.
+    The default, 1, formats the rows on the writing thread. The files
+    written do not depend on the number of threads. */
+    static void SetNumWriterThreads(int aNumThreads);
+    static int GetNumWriterThreads();
+    /** Whether binary data files (".bsto", see BinaryFileAdapter_) written
+    by Storage::print() and FileAdapter::writeFile() store their values in
+    single precision (float, about 7 significant digits), which halves their
+    size (default: false). Times are always stored in double precision. */
+    static void SetBinarySinglePrecision(bool aSinglePrecision);
+    static bool GetBinarySinglePrecision();
+#ifndef SWIG
+    /** Write rows of text: aFormatRow(i, text) appends the text of row i to
+    text, and aWrite(text) writes the text of consecutive rows, in order,
+    returning false if it fails. Blocks of rows are formatted concurrently,
+    see SetNumWriterThreads(), and written in large pieces.
+    @returns false if aWrite() failed. */
+    static bool WriteRows(int aNumRows,
+            const std::function<void(int, std::string&)>& aFormatRow,
+            const std::function<bool(const std::string&)>& aWrite);
+#endif
+
 public:
     // Object printing
     static void SetPrintOfflineDocuments(bool aTrueFalse);
@@ -105,6 +144,12 @@ public:
     static int makeDir(const std::string &aDirName);
     static int chDir(const std::string &aDirName);
     static std::string getCwd();
+#ifndef SWIG
+    /** Held while an Object is read from or printed to a file, which changes
+    the working directory until it is done, so that threads that read or
+    print Objects do not change it under each other. */
+    static std::recursive_mutex& getWorkingDirectoryMutex();
+#endif
     static std::string getParentDirectory(const std::string& fileName);
     static std::string GetFileNameFromURI(const std::string& aURI);
     static std::string formatText(const std::string& aComment,const std::string& leadingWhitespace,int width,const std::string& endlineTokenToInsert="\n");
@@ -20,6 +20,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include "LogManager.h"
+#include <chrono>
 #include <fstream>
 
 using namespace OpenSim;
@@ -29,6 +30,7 @@ LogBuffer LogManager::out;
 LogBuffer LogManager::err;
 std::ostream LogManager::cout(std::cout.rdbuf()); // This cout writes to the actual standard out
 std::ostream LogManager::cerr(std::cerr.rdbuf()); // This cerr writes to the actual standard error
+std::atomic<int> LogManager::_level(static_cast<int>(LogManager::Level::Info));
 
 // Initialize a static log manager to force the constructor to be called
 LogManager logManager;
@@ -57,12 +59,13 @@ void StreamLogCallback::log(const std::string &str)
 //=============================================================================
 // LogBuffer
 //=============================================================================
-LogBuffer::LogBuffer()
+LogBuffer::LogBuffer() : _queueHead(0), _queueTail(0), _stopThread(false)
 {
 }
 
 LogBuffer::~LogBuffer()
 {
+    setAsynchronous(false);
     for(int i = 0; i < _logCallbacks.size(); i++) {
         delete _logCallbacks[i];
     }
@@ -72,6 +75,7 @@ LogBuffer::~LogBuffer()
 bool LogBuffer::
 addLogCallback(LogCallback *aLogCallback)
 {
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
     if(_logCallbacks.findIndex(aLogCallback) >= 0) return false;
     _logCallbacks.append(aLogCallback); 
     return true;
@@ -80,6 +84,9 @@ addLogCallback(LogCallback *aLogCallback)
 bool LogBuffer::
 removeLogCallback(LogCallback *aLogCallback)
 {
+    // Pass the queued messages to the callback before removing it.
+    flushQueue();
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
     int index = _logCallbacks.findIndex(aLogCallback);
     if(index < 0) return false;
     _logCallbacks.remove(index); 
@@ -89,13 +96,80 @@ removeLogCallback(LogCallback *aLogCallback)
 int LogBuffer::
 sync()
 {
-    // Pass current string to all log callbacks
-    for(int i=0; i<_logCallbacks.getSize(); i++) _logCallbacks[i]->log(str());
+    if(isAsynchronous()) {
+        // Wait for a free slot, then hand the string to the background
+        // thread.
+        const unsigned long long head = _queueHead.load();
+        while(head - _queueTail.load(std::memory_order_acquire) >= QueueSize)
+            std::this_thread::yield();
+        _queue[head % QueueSize] = str();
+        _queueHead.store(head + 1, std::memory_order_release);
+        _wake.notify_one();
+    } else {
+        // Pass current string to all log callbacks
+        passToCallbacks(str());
+    }
     // Reset current buffer contents
     str("");
     return std::stringbuf::sync();
 }
 
+void LogBuffer::
+passToCallbacks(const std::string& aStr)
+{
+    if(aStr.empty()) return;
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
+    for(int i=0; i<_logCallbacks.getSize(); i++) _logCallbacks[i]->log(aStr);
+}
+
+void LogBuffer::
+drainQueue()
+{
+    while(true) {
+        // Read the flag first, so that the messages queued before the flag
+        // was set are passed on before stopping.
+        const bool stop = _stopThread.load();
+        unsigned long long tail = _queueTail.load();
+        while(tail != _queueHead.load(std::memory_order_acquire)) {
+            std::string message;
+            message.swap(_queue[tail % QueueSize]);
+            _queueTail.store(++tail, std::memory_order_release);
+            passToCallbacks(message);
+        }
+        if(stop) return;
+        // The writer does not lock the mutex when notifying, so a wake-up
+        // can be missed; the timeout bounds the resulting delay.
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+void LogBuffer::
+setAsynchronous(bool asynchronous)
+{
+    if(asynchronous == isAsynchronous()) return;
+    if(asynchronous) {
+        _stopThread.store(false);
+        _thread = std::thread(&LogBuffer::drainQueue, this);
+    } else {
+        // The thread empties the queue before it stops.
+        _stopThread.store(true);
+        _wake.notify_one();
+        _thread.join();
+    }
+}
+
+void LogBuffer::
+flushQueue()
+{
+    if(!isAsynchronous()) return;
+    const unsigned long long head = _queueHead.load();
+    while(_queueTail.load(std::memory_order_acquire) < head) {
+        _wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
 //=============================================================================
 // LogManager
 //=============================================================================
@@ -119,6 +193,9 @@ LogManager::~LogManager()
 {
     std::cout << std::flush;
     std::cerr << std::flush;
+    // The callbacks write to LogManager::cout and cerr, which are destroyed
+    // before out and err.
+    setAsynchronous(false);
 }
 
 LogManager *LogManager::getInstance()
@@ -135,3 +212,17 @@ LogBuffer *LogManager::getErrBuffer()
 {
     return &err;
 }
+
+void LogManager::setAsynchronous(bool asynchronous)
+{
+    out.setAsynchronous(asynchronous);
+    err.setAsynchronous(asynchronous);
+}
+
+void LogManager::flush()
+{
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    out.flushQueue();
+    err.flushQueue();
+}
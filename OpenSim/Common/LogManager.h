@@ -25,8 +25,12 @@
 #include "osimCommonDLL.h"
 #include "Array.h"
 #include "LogCallback.h"
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace OpenSim {
 
@@ -55,10 +59,37 @@ public:
     bool addLogCallback(LogCallback *aLogCallback);
     bool removeLogCallback(LogCallback *aLogCallback);
 
+    /** When asynchronous, each flushed message is put in a lock-free ring
+    buffer and passed to the callbacks by a background thread, so that
+    writing to a slow terminal or file does not stall the writer. Only one
+    thread at a time may write to a LogBuffer (as for any std::stringbuf). If
+    the ring buffer is full, the writer waits for the background thread. */
+    void setAsynchronous(bool asynchronous);
+    bool isAsynchronous() const { return _thread.joinable(); }
+
+    /** Wait until all messages queued so far have been passed to the
+    callbacks. Does nothing if the buffer is not asynchronous. */
+    void flushQueue();
+
 private:
     Array<LogCallback*> _logCallbacks;
+    std::mutex _logCallbacksMutex;
 
     int sync() override;
+    void passToCallbacks(const std::string& str);
+    void drainQueue();
+
+    // Single-producer, single-consumer ring buffer of messages: the writer
+    // fills slot _queueHead % QueueSize, the background thread empties slot
+    // _queueTail % QueueSize.
+    static const unsigned QueueSize = 1024;
+    std::string _queue[QueueSize];
+    std::atomic<unsigned long long> _queueHead;
+    std::atomic<unsigned long long> _queueTail;
+    std::atomic<bool> _stopThread;
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    std::thread _thread;
 };
 /// @endcond
 
@@ -75,13 +106,46 @@ public:
     static std::ostream cout;
     static std::ostream cerr;
 
+    /** The severity of a message, from most to least severe. Messages less
+    severe than getLevel() should not be written; see shouldLog(). */
+    enum class Level { Off = 0, Error = 1, Warn = 2, Info = 3, Debug = 4 };
+
     LogManager();
     ~LogManager();
 
     static LogManager *getInstance();
 
+    /** %Set the least severe level of messages that are written (Info by
+    default). Use Level::Warn to suppress progress messages, e.g., the
+    per-frame messages of tools. */
+    static void setLevel(Level level)
+    {   _level.store(static_cast<int>(level)); }
+    static Level getLevel() { return static_cast<Level>(_level.load()); }
+
+    /** Whether messages of the given level should be written. This is cheap
+    enough to check before composing a message in a loop:
+    @code
+    if (LogManager::shouldLog(LogManager::Level::Info))
+        std::cout << "Frame " << i << std::endl;
+    @endcode */
+    static bool shouldLog(Level level) {
+        return static_cast<int>(level) <=
+               _level.load(std::memory_order_relaxed);
+    }
+
+    /** Make both out and err asynchronous; see LogBuffer::setAsynchronous().
+    */
+    static void setAsynchronous(bool asynchronous);
+
+    /** Flush std::cout and std::cerr, and wait until their messages have
+    been passed to the callbacks. */
+    static void flush();
+
     LogBuffer *getOutBuffer();
     LogBuffer *getErrBuffer();
+
+private:
+    static std::atomic<int> _level;
 };
 /// @endcond
 }
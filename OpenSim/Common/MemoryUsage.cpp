@@ -0,0 +1,85 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  MemoryUsage.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MemoryUsage.h"
+#include <OpenSim/Auxiliary/getRSS.h>
+
+#include <sstream>
+
+using namespace OpenSim;
+
+size_t MemoryUsage::get(Category category) const
+{
+    size_t bytes = _bytes[category];
+    for (const auto& block : _sharedBlocks)
+        if (block.second.first == category) bytes += block.second.second;
+    return bytes;
+}
+
+size_t MemoryUsage::getTotal() const
+{
+    size_t bytes = 0;
+    for (int i = 0; i < NumCategories; ++i) bytes += get(Category(i));
+    return bytes;
+}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other)
+{
+    for (int i = 0; i < NumCategories; ++i) _bytes[i] += other._bytes[i];
+    _sharedBlocks.insert(other._sharedBlocks.begin(),
+                         other._sharedBlocks.end());
+    return *this;
+}
+
+std::string MemoryUsage::getCategoryName(Category category)
+{
+    switch (category) {
+    case Properties: return "properties";
+    case Curves:     return "curves";
+    case Meshes:     return "meshes";
+    case Storages:   return "storages";
+    case States:     return "states";
+    case Paths:      return "paths";
+    default:         return "unknown";
+    }
+}
+
+std::string MemoryUsage::toString() const
+{
+    std::ostringstream out;
+    for (int i = 0; i < NumCategories; ++i) {
+        out << getCategoryName(Category(i)) << ": " << get(Category(i))
+            << " bytes\n";
+    }
+    out << "total: " << getTotal() << " bytes\n";
+    return out.str();
+}
+
+size_t MemoryUsage::getCurrentProcessMemory()
+{
+    return getCurrentRSS();
+}
+
+size_t MemoryUsage::getPeakProcessMemory()
+{
+    return getPeakRSS();
+}
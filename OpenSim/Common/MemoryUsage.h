@@ -0,0 +1,92 @@
+#ifndef OPENSIM_MEMORY_USAGE_H_
+#define OPENSIM_MEMORY_USAGE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  MemoryUsage.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace OpenSim {
+
+/** An estimate of the bytes of memory held by an object (see
+Object::estimateMemoryUsage()), by category. The estimate counts the data the
+objects hold (property values, curve splines and tables, meshes, the rows of
+storages, the variables of states, path buffers), not the fixed size of the
+objects themselves nor the overhead of the allocator, so it is a lower bound;
+compare it with getCurrentProcessMemory() to see how much of a process's
+memory a model accounts for.
+
+A block of memory shared between objects (e.g., a mesh shared by the copies
+of a Mesh) is added with addShared(), and counted once however many objects
+add it. */
+class OSIMCOMMON_API MemoryUsage {
+public:
+    enum Category {
+        Properties, ///< Values of properties.
+        Curves,     ///< Splines and tables of curves.
+        Meshes,     ///< Loaded mesh files.
+        Storages,   ///< Rows of Storages (e.g., the results of analyses).
+        States,     ///< Variables of states kept by a Model.
+        Paths,      ///< Buffers of paths and their surrogates.
+        NumCategories
+    };
+
+    void add(Category category, size_t bytes) { _bytes[category] += bytes; }
+
+    /** Add a block of memory that may be shared between objects; the block,
+    identified by its address, is counted once. */
+    void addShared(Category category, const void* block, size_t bytes)
+    {   _sharedBlocks.insert({block, {category, bytes}}); }
+
+    /** Bytes in the category. */
+    size_t get(Category category) const;
+    /** Bytes in all categories. */
+    size_t getTotal() const;
+
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    /** E.g., "properties". */
+    static std::string getCategoryName(Category category);
+
+    /** One line per category with the number of bytes, and the total. */
+    std::string toString() const;
+
+    /** The resident set size of this process (physical memory in use), in
+    bytes; 0 if it cannot be determined on this platform. */
+    static size_t getCurrentProcessMemory();
+    /** The largest resident set size of this process so far, in bytes; 0 if
+    it cannot be determined on this platform. */
+    static size_t getPeakProcessMemory();
+
+private:
+    size_t _bytes[NumCategories]{};
+    std::map<const void*, std::pair<Category, size_t>> _sharedBlocks;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MEMORY_USAGE_H_
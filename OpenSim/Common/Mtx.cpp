@@ -26,7 +26,10 @@
  */
 
 #include "Mtx.h"
+#include <SimTKlapack.h>
 #include <string.h> // for memcpy in Linux
+#include <algorithm>
+#include <vector>
 
 
 //=============================================================================
@@ -44,6 +47,35 @@ double** Mtx::_P2Space = NULL;
 double*  Mtx::_WSpace = NULL;
 static const double eps = std::numeric_limits<double>::epsilon();
 
+namespace {
+// Products of at least this many multiply-adds, and inverses of matrices of
+// at least this many rows, are computed by Lapack; for smaller matrices (the
+// 3x3 and 4x4 matrices of the wrapping code), the overhead of the call
+// outweighs Lapack's faster kernels.
+const double LapackMinMultiplyAdds = 16*16*16;
+const int LapackMinInvertSize = 16;
+
+// Scratch space for a result, on the stack when it is small. Unlike the
+// shared workspace of Mtx, it may be used by several threads at once.
+class Scratch {
+public:
+    explicit Scratch(int aN) : _data(_stack) {
+        if(aN>MaxStackSize) {
+            _heap.resize(aN);
+            _data = _heap.data();
+        }
+    }
+    Scratch(const Scratch&) = delete;
+    Scratch& operator=(const Scratch&) = delete;
+    double* get() { return _data; }
+private:
+    static const int MaxStackSize = 64;
+    double _stack[MaxStackSize];
+    std::vector<double> _heap;
+    double* _data;
+};
+}
+
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -361,34 +393,35 @@ Multiply(int aNR1,int aNCR,int aNC2,const double *aM1,const double *aM2,
     if(aNCR<=0) return(-1);
     if(aNC2<=0) return(-1);
 
-    // ENSURE WORKSPACE CAPACITY
-    EnsureWorkSpaceCapacity(aNR1*aNC2);
+    // SCRATCH SPACE FOR THE RESULT, SINCE rM MAY OVERLAP aM1 OR aM2
+    Scratch m(aNR1*aNC2);
 
-    // SET POINTER INTO WORKSPACE
-    double *m = _WSpace;
+    // MULTIPLY WITH LAPACK
+    // The matrices are row-major and Lapack's are column-major, so compute
+    // the transpose of the product, aM2' * aM1'.
+    if(double(aNR1)*aNCR*aNC2 >= LapackMinMultiplyAdds) {
+        dgemm_('N','N',aNC2,aNR1,aNCR,1.0,aM2,aNC2,aM1,aNCR,
+               0.0,m.get(),aNC2,1,1);
 
     // MULTIPLY
-    const double *ij1=NULL,*ij2=NULL;
-    double result,*ij=NULL;
-    int r1,cr,c2;
-    for(r1=0,ij=m;r1<aNR1;r1++) {
-
-        for(c2=0;c2<aNC2;c2++,ij++) {
-
-            // SET POINTERS TO BEGINNING OF ROW OF aM1 AND COLUMN OF aM2
-            ij1 = aM1 + r1*aNCR;
-            ij2 = aM2 + c2;
-
-            // MULTIPLY ROW OF aM1 AND COLUMN OF aM2
-            for(result=0.0,cr=0;cr<aNCR;cr++,ij1++,ij2+=aNC2) {
-                result += (*ij1) * (*ij2);
+    // Add the rows of aM2, scaled by a row of aM1, into a row of the result;
+    // the inner loop runs over contiguous memory, so that it vectorizes, and
+    // each element is summed in the same order as a dot product would.
+    } else {
+        double *ij = m.get();
+        for(int r1=0;r1<aNR1;r1++,ij+=aNC2) {
+            const double *r1j = aM1 + r1*aNCR;
+            for(int c2=0;c2<aNC2;c2++) ij[c2] = 0.0;
+            for(int cr=0;cr<aNCR;cr++) {
+                const double a = r1j[cr];
+                const double *crj = aM2 + cr*aNC2;
+                for(int c2=0;c2<aNC2;c2++) ij[c2] += a*crj[c2];
             }
-            *ij = result;
         }
     }
 
     // COPY RESULTS INTO rM
-    memcpy(rM,m,aNR1*aNC2*sizeof(double));
+    memcpy(rM,m.get(),aNR1*aNC2*sizeof(double));
 
     return(0);
 }
@@ -401,9 +434,23 @@ Multiply(int aNR1,int aNCR,int aNC2,const double *aM1,const double *aM2,
  * Otherwise, 0 is returned.
  *
  * It is permissible for aM to overlap in memory with aMInv.
+ *
+ * Small matrices are inverted by InvertByElimination(), and larger ones by
+ * InvertWithLapack().
  */
 int Mtx::
 Invert(int aN,const double *aM,double *rMInv)
+{
+    if(aN>=LapackMinInvertSize) return InvertWithLapack(aN,aM,rMInv);
+    return InvertByElimination(aN,aM,rMInv);
+}
+//_____________________________________________________________________________
+/**
+ * Compute the inverse of a matrix by Gauss-Jordan elimination, with the
+ * same arguments and return values as Invert().
+ */
+int Mtx::
+InvertByElimination(int aN,const double *aM,double *rMInv)
 {
     if(aN<=0) return(-1);
     if(aM==NULL) return(-1);
@@ -413,13 +460,19 @@ Invert(int aN,const double *aM,double *rMInv)
     double *M,**Mp,**Mr,**Ip,**Ir,*Mrj,*Irj,*Mij,*Iij,d;
     int r,i,j,n;
 
-    // ENSURE WORKSPACE CAPACITY
-    EnsureWorkSpaceCapacity(aN*aN);
-    EnsurePointerSpaceCapacity(aN);
+    // ROW POINTERS, ON THE STACK FOR SMALL MATRICES
+    double *rowsOnStack[2*LapackMinInvertSize];
+    std::vector<double*> rowsOnHeap;
+    double **rows = rowsOnStack;
+    if(aN>LapackMinInvertSize) {
+        rowsOnHeap.resize(2*aN);
+        rows = rowsOnHeap.data();
+    }
 
     // INITIALIZE M (A COPY OF aM)
+    Scratch copy(aN*aN);
     n = aN*aN*sizeof(double);
-    M = _WSpace;
+    M = copy.get();
     memcpy(M,aM,n);
 
     // INITIALIZE rMInv TO THE IDENTITY MATRIX
@@ -427,10 +480,10 @@ Invert(int aN,const double *aM,double *rMInv)
     for(r=0,Irj=rMInv,n=aN+1;r<aN;r++,Irj+=n)  *Irj=1.0;
 
     // INITIALIZE ROW POINTERS
-    Mp = _P1Space;      // POINTER TO BEGINNING OF POINTER1 SPACE
-    Mr = _P1Space;      // ROW POINTERS INTO M
-    Ip  = _P2Space;     // POINTER TO BEGINNING OF POINTER2 SPACE
-    Ir = _P2Space;      // ROW POINTERS INTO aMInv
+    Mp = rows;          // POINTER TO BEGINNING OF ROW POINTERS INTO M
+    Mr = rows;          // ROW POINTERS INTO M
+    Ip  = rows + aN;    // POINTER TO BEGINNING OF ROW POINTERS INTO aMInv
+    Ir = rows + aN;     // ROW POINTERS INTO aMInv
     for(r=0;r<aN;r++,Mr++,Ir++) {
         i = r*aN;
         *Mr = M + i;
@@ -484,6 +537,39 @@ Invert(int aN,const double *aM,double *rMInv)
     return(0);
 }
 //_____________________________________________________________________________
+/**
+ * Compute the inverse of a matrix by its LU factorization (Lapack's dgetrf
+ * and dgetri), with the same arguments and return values as Invert(). As
+ * in InvertByElimination(), the matrix is taken to be singular if a pivot
+ * is smaller than machine precision.
+ */
+int Mtx::
+InvertWithLapack(int aN,const double *aM,double *rMInv)
+{
+    if(aN<=0) return(-1);
+    if(aM==NULL) return(-1);
+    if(rMInv==NULL) return(-1);
+
+    // The inverse of the transpose is the transpose of the inverse, so
+    // Lapack can invert the row-major matrix as if it were column-major.
+    std::vector<double> inverse(aM,aM+aN*aN);
+    std::vector<int> pivots(aN);
+    int info = 0;
+    dgetrf_(aN,aN,inverse.data(),aN,pivots.data(),info);
+    if(info!=0) return(-2);
+    for(int i=0;i<aN;i++) if(std::fabs(inverse[i*aN+i]) < eps) return(-2);
+
+    double workSize = 0;
+    dgetri_(aN,inverse.data(),aN,pivots.data(),&workSize,-1,info);
+    std::vector<double> work(std::max(aN,int(workSize)));
+    dgetri_(aN,inverse.data(),aN,pivots.data(),work.data(),int(work.size()),
+            info);
+    if(info!=0) return(-2);
+
+    memcpy(rMInv,inverse.data(),aN*aN*sizeof(double));
+    return(0);
+}
+//_____________________________________________________________________________
 /**
  * Transpose a matrix.
  *
@@ -500,21 +586,22 @@ Transpose(int aNR,const int aNC,const double *aM,double *rMT)
     if(aM==NULL) return(-1);
     if(rMT==NULL) return(-1);
 
-    // ENSURE WORKSPACE CAPACITY
+    // SCRATCH SPACE FOR THE RESULT, SINCE rMT MAY OVERLAP aM
     int n = aNR*aNC;
-    EnsureWorkSpaceCapacity(n);
-
-    // SET UP COUNTERS AND POINTERS
-    int r,c;
-    const double *Mrc;
-    double *Mcr;
-    double *MT = _WSpace;
+    Scratch scratch(n);
+    double *MT = scratch.get();
 
     // TRANSPOSE
-    for(r=0,Mrc=aM;r<aNR;r++) {
-        Mcr = MT + r;
-        for(c=0;c<aNC;c++,Mcr+=aNR,Mrc++) {
-            *Mcr = *(Mrc);
+    // In blocks, so that the rows read and the rows written stay in cache.
+    const int block = 16;
+    for(int r0=0;r0<aNR;r0+=block) {
+        const int r1 = std::min(r0+block,aNR);
+        for(int c0=0;c0<aNC;c0+=block) {
+            const int c1 = std::min(c0+block,aNC);
+            for(int r=r0;r<r1;r++) {
+                const double *Mrc = aM + r*aNC;
+                for(int c=c0;c<c1;c++) MT[c*aNR+r] = Mrc[c];
+            }
         }
     }
 
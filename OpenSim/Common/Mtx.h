@@ -180,6 +180,8 @@ public:
     static int Multiply(int aNR1,int aNCR,int aNC2,const double *aM1,
         const double *aM2,double *aM);
     static int Invert(int aN,const double *aM,double *aMInv);
+    static int InvertByElimination(int aN,const double *aM,double *aMInv);
+    static int InvertWithLapack(int aN,const double *aM,double *aMInv);
     static int Transpose(int aNR,int aNC,const double *aM,double *aMT);
     static void Print(int aNR,int aNC,const double *aM,int aPrecision=8);
 
@@ -36,7 +36,9 @@
 #include "Property_Deprecated.h"
 #include "PropertyTransform.h"
 #include "IO.h"
+#include "Tracer.h"
 
+#include <atomic>
 #include <fstream>
 
 using namespace OpenSim;
@@ -87,6 +89,8 @@ Object::Object()
  */
 Object::Object(const string &aFileName, bool aUpdateFromXMLNode)
 {
+    OPENSIM_TRACE_SPAN("io", "read XML", aFileName);
+
     // INITIALIZATION
     setNull();
 
@@ -114,6 +118,8 @@ Object::Object(const string &aFileName, bool aUpdateFromXMLNode)
     // relative to that directory. Make sure we switch back properly in case
     // of an exception.
     if (aUpdateFromXMLNode) {
+        std::lock_guard<std::recursive_mutex> lock(
+                IO::getWorkingDirectoryMutex());
         const string saveWorkingDirectory = IO::getCwd();
         const string directoryOfXMLFile = IO::getParentDirectory(aFileName);
         IO::chDir(directoryOfXMLFile);
@@ -166,6 +172,9 @@ Object::Object(const string &aFileName, bool aUpdateFromXMLNode)
 Object::Object(const Object &aObject)
 {
     setNull();
+    // A new object cannot be in a Set yet, so its name is not counted as a
+    // change (see getNameGeneration()).
+    _name = aObject._name;
 
     // Use copy assignment operator to copy simple data members and the
     // property table; XML document is not copied and the new object is
@@ -190,10 +199,23 @@ Object::Object(SimTK::Xml::Element& aNode)
  * @return Reference to this object.
  * @see updateXMLNode()
  */
+namespace {
+// See Object::getNameGeneration().
+std::atomic<unsigned long long> nameGeneration(0);
+}
+
+unsigned long long Object::getNameGeneration()
+{
+    return nameGeneration.load(std::memory_order_acquire);
+}
+
 Object& Object::operator=(const Object& source)
 {
     if (&source != this) {
-        _name           = source._name;
+        if (_name != source._name) {
+            _name = source._name;
+            nameGeneration.fetch_add(1, std::memory_order_release);
+        }
         _description    = source._description;
         _authors        = source._authors;
         _references     = source._references;
@@ -283,7 +305,9 @@ operator<(const Object& other) const
 void Object::
 setName(const string &aName)
 {
+    if (aName == _name) return;
     _name = aName;
+    nameGeneration.fetch_add(1, std::memory_order_release);
 }
 //_____________________________________________________________________________
 /**
@@ -773,9 +797,26 @@ try {
     updateDefaultObjectsFromXMLNode(); // May need to pass in aNode
 
     // LOOP THROUGH PROPERTIES
-    for(int i=0; i < _propertyTable.getNumProperties(); ++i) {
+    // The properties are being modified (this object may have been copied
+    // from an up-to-date default object).
+    _objectIsUpToDate = false;
+    // Find the element of each named property in one pass over the
+    // elements, rather than searching the elements for each property (which
+    // is quadratic in the number of properties). As when searching, the
+    // first element with a property's name is the one read.
+    const int numProperties = _propertyTable.getNumProperties();
+    std::vector<SimTK::Xml::Element> propElements(numProperties);
+    for (auto iter = aNode.element_begin(); iter != aNode.element_end();
+            ++iter) {
+        const int ix = _propertyTable.findPropertyIndex(iter->getElementTag());
+        if (ix >= 0 && !propElements[ix].isValid() &&
+                !_propertyTable.getAbstractPropertyByIndex(ix)
+                    .isUnnamedProperty())
+            propElements[ix] = *iter;
+    }
+    for(int i=0; i < numProperties; ++i) {
         AbstractProperty& prop = _propertyTable.updAbstractPropertyByIndex(i);
-        prop.readFromXMLParentElement(aNode, versionNumber);
+        prop.readFromXMLParentElement(aNode, propElements[i], versionNumber);
     }
 
     // LOOP THROUGH DEPRECATED PROPERTIES
@@ -1322,7 +1363,10 @@ setAllPropertiesUseDefault(bool aUseDefault)
 bool Object::
 print(const string &aFileName) const
 {
+    OPENSIM_TRACE_SPAN("io", "write XML", aFileName);
+
     // Temporarily change current directory so that inlined files are written to correct relative directory
+    std::lock_guard<std::recursive_mutex> lock(IO::getWorkingDirectoryMutex());
     std::string savedCwd = IO::getCwd();
     IO::chDir(IO::getParentDirectory(aFileName));
     try {
@@ -1525,6 +1569,8 @@ makeObjectFromFile(const std::string &aFileName)
         Object* newObject = newInstanceOfType(rootName);
         if(!newObject) throw Exception("Unrecognized XML element '"+rootName+"' and root of file '"+aFileName+"'",__FILE__,__LINE__);
         // Here file is deemed legit, chdir to where the file lives here and restore at the end so offline objects are handled properly
+        std::lock_guard<std::recursive_mutex> lock(
+                IO::getWorkingDirectoryMutex());
         const string saveWorkingDirectory = IO::getCwd();
         const string directoryOfXMLFile = IO::getParentDirectory(aFileName);
         IO::chDir(directoryOfXMLFile);
@@ -1564,6 +1610,7 @@ void Object::updateFromXMLDocument()
     assert(_document!= 0);
     
     SimTK::Xml::Element e = _document->getRootDataElement(); 
+    std::lock_guard<std::recursive_mutex> lock(IO::getWorkingDirectoryMutex());
     const string saveWorkingDirectory = IO::getCwd();
     string parentFileName = _document->getFileName();
     const string directoryOfXMLFile = IO::getParentDirectory(parentFileName);
@@ -1572,6 +1619,20 @@ void Object::updateFromXMLDocument()
     IO::chDir(saveWorkingDirectory);
 }
 
+MemoryUsage Object::estimateMemoryUsage() const
+{
+    MemoryUsage usage;
+    for (int i = 0; i < getNumProperties(); ++i) {
+        const AbstractProperty& property = getPropertyByIndex(i);
+        usage.add(MemoryUsage::Properties, property.estimateMemoryUsage());
+        if (!property.isObjectProperty()) continue;
+        for (int j = 0; j < property.size(); ++j)
+            usage += property.getValueAsObject(j).estimateMemoryUsage();
+    }
+    extendEstimateMemoryUsage(usage);
+    return usage;
+}
+
 std::string Object::dump(bool dumpName) {
     SimTK::String outString;
     XMLDocument doc;
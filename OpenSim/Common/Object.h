@@ -36,6 +36,7 @@
 // INCLUDES
 
 #include "osimCommonDLL.h"
+#include "MemoryUsage.h"
 #include "PropertySet.h"
 #include "PropertyTable.h"
 #include "Property.h"
@@ -584,6 +585,13 @@ public:
     /** dump the XML representation of this %Object into an std::string and return it.
     Mainly intended for debugging and for use by the XML browser in the GUI. **/
     std::string dump(bool dumpName=false); 
+
+    /** Estimate the memory held by this %Object: the values of its
+    properties and, recursively, the objects they hold (including
+    subcomponents), plus what each object adds in
+    extendEstimateMemoryUsage() (e.g., curve splines, loaded meshes, the rows
+    of a Storage). See MemoryUsage. **/
+    virtual MemoryUsage estimateMemoryUsage() const;
     /**@}**/
     //--------------------------------------------------------------------------
     // ADVANCED/OBSCURE/QUESTIONABLE/BUGGY
@@ -688,6 +696,11 @@ protected:
     is no provision for version numbering. **/
     explicit Object(SimTK::Xml::Element& aElement);
 
+    /** Override to add the memory held by data members of this %Object that
+    are not properties to usage (see estimateMemoryUsage()). Call the
+    superclass's method first. **/
+    virtual void extendEstimateMemoryUsage(MemoryUsage& usage) const {}
+
 
     /** Define a new single-value property of known type T, with the given 
     \a name, associated \a comment, and initial \a value. The name must be
@@ -805,6 +818,11 @@ protected:
     this and derived classes. */
     PropertySet _propertySet;
 
+    /** The number of times the name of any Object has changed (by setName()
+    or by assignment). Containers that index objects by name (see
+    Set::getIndex()) use it to tell whether their index may be stale. */
+    static unsigned long long getNameGeneration();
+
 private:
     // Array holding a default value for each of the registered object types. 
     // Each object type only appears once in this array. Renamed types usually
@@ -32,6 +32,12 @@
 #include <stdio.h>
 #include "OptimizationTarget.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
 //=============================================================================
 // EXPORTED STATIC CONSTANTS
 //=============================================================================
@@ -156,6 +162,89 @@ printPerformance(double *x)
     std::cout << "performance = " << p << std::endl;
 }
 
+//=============================================================================
+// CONCURRENT FINITE DIFFERENCES
+//=============================================================================
+std::vector<const OptimizationTarget*> OptimizationTarget::
+getDifferenceTargets() const
+{
+    std::vector<const OptimizationTarget*> targets(1, this);
+    int numThreads = _numDifferenceThreads;
+    if(numThreads<=0) numThreads = std::thread::hardware_concurrency();
+
+    // Make the missing copies here, on the calling thread.
+    while(int(_threadCopies.size())<numThreads-1) {
+        std::unique_ptr<OptimizationTarget> copy(createThreadCopy());
+        if(!copy) break;
+        _threadCopies.push_back(std::move(copy));
+    }
+    for(int t=0;t<numThreads-1 && t<int(_threadCopies.size());t++) {
+        prepareThreadCopy(*_threadCopies[t]);
+        targets.push_back(_threadCopies[t].get());
+    }
+    return(targets);
+}
+
+template <typename Evaluate>
+int OptimizationTarget::
+evaluateParameters(int aNumParameters,Evaluate evaluate) const
+{
+    const std::vector<const OptimizationTarget*> targets =
+            getDifferenceTargets();
+    const int numThreads = std::min(int(targets.size()),aNumParameters);
+    if(numThreads<=1) {
+        int status = -1;
+        for(int i=0;i<aNumParameters;i++) {
+            status = evaluate(*this,i);
+            if(status<0) return(status);
+        }
+        return(status);
+    }
+
+    // Parameters are handed out one at a time, so that a thread whose
+    // evaluations are quick takes more of them.
+    std::vector<int> statuses(aNumParameters,0);
+    std::vector<std::exception_ptr> errors(numThreads);
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    auto evaluateAll = [&](int t) {
+        try {
+            for(int i=next++;i<aNumParameters && !failed;i=next++) {
+                statuses[i] = evaluate(*targets[t],i);
+                if(statuses[i]<0) failed = true;
+            }
+        } catch(...) {
+            errors[t] = std::current_exception();
+            failed = true;
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int t=1;t<numThreads;t++) {
+        try {
+            threads.emplace_back(evaluateAll,t);
+        } catch(const std::system_error&) {
+            // Could not start a thread; the others evaluate its parameters.
+            break;
+        }
+    }
+    evaluateAll(0);
+    for(auto& thread : threads) thread.join();
+
+    // Count the evaluations of the copies as evaluations of this target.
+    for(int t=1;t<numThreads;t++) {
+        const OptimizationTarget& copy = *targets[t];
+        _numObjectiveEvaluations += copy._numObjectiveEvaluations;
+        _numConstraintEvaluations += copy._numConstraintEvaluations;
+        copy._numObjectiveEvaluations = copy._numConstraintEvaluations = 0;
+    }
+
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+    for(int i=0;i<aNumParameters;i++)
+        if(statuses[i]<0) return(statuses[i]);
+    return(statuses[aNumParameters-1]);
+}
+
 //=============================================================================
 // STATIC DERIVATIVES
 //=============================================================================
@@ -180,34 +269,29 @@ CentralDifferencesConstraint(const OptimizationTarget *aTarget,
     // INITIALIZE CONTROLS
     int nx = aTarget->getNumParameters(); if(nx<=0) return(-1);
     int nc = aTarget->getNumConstraints(); if(nc<=0) return(-1);
-    Vector xp=x;
-    Vector cf(nc),cb(nc);
-
-    // INITIALIZE STATUS
-    int status = -1;
 
-    // LOOP OVER CONTROLS
-    for(int i=0;i<nx;i++) {
+    // LOOP OVER CONTROLS (possibly concurrently; each column is written by
+    // one thread)
+    return aTarget->evaluateParameters(nx,
+            [&](const OptimizationTarget& target,int i) {
+        Vector xp=x;
+        Vector cf(nc),cb(nc);
 
         // PERTURB FORWARD
         xp[i] = x[i] + dx[i];
-        status = aTarget->constraintFunc(xp,true,cf);
+        int status = target.constraintFunc(xp,true,cf);
         if(status<0) return(status);
 
         // PERTURB BACKWARD
         xp[i] = x[i] - dx[i];
-        status = aTarget->constraintFunc(xp,true,cb);
+        status = target.constraintFunc(xp,true,cb);
         if(status<0) return(status);
 
         // DERIVATIVES OF CONSTRAINTS
         double rdx = 0.5 / dx[i];
         for(int j=0;j<nc;j++) jacobian(j,i) = rdx*(cf[j]-cb[j]);
-
-        // RESTORE CONTROLS
-        xp[i] = x[i];
-    }
-
-    return(status);
+        return(status);
+    });
 }
 //_____________________________________________________________________________
 /**
@@ -229,36 +313,30 @@ CentralDifferences(const OptimizationTarget *aTarget,
 
     // CONTROLS
     int nx = aTarget->getNumParameters();  if(nx<=0) return(-1);
-    Vector xp=x;
-
-    // PERFORMANCE
-    double pf,pb;
 
-    // INITIALIZE STATUS
-    int status = -1;
+    // LOOP OVER CONTROLS (possibly concurrently)
+    return aTarget->evaluateParameters(nx,
+            [&](const OptimizationTarget& target,int i) {
+        Vector xp=x;
 
-    // LOOP OVER CONTROLS
-    for(int i=0;i<nx;i++) {
+        // PERFORMANCE
+        double pf,pb;
 
         // PERTURB FORWARD
         xp[i] = x[i] + dx[i];
-        status = aTarget->objectiveFunc(xp,true,pf);
+        int status = target.objectiveFunc(xp,true,pf);
         if(status<0) return(status);
 
         // PERTURB BACKWARD
         xp[i] = x[i] - dx[i];
-        status = aTarget->objectiveFunc(xp,true,pb);
+        status = target.objectiveFunc(xp,true,pb);
         if(status<0) return(status);
 
         // DERIVATIVES OF PERFORMANCE
         double rdx = 0.5 / dx[i];
         dpdx[i] = rdx*(pf-pb);
-
-        // RESTORE CONTROLS
-        xp[i] = x[i];
-    }
-
-    return(status);
+        return(status);
+    });
 }
 
 //_____________________________________________________________________________
@@ -287,25 +365,25 @@ ForwardDifferences(const OptimizationTarget *aTarget,
     int status = -1;
 
     // PERFORMANCE
-    double pf,pb;
+    double pb;
     
     // current objective function value
     status = aTarget->objectiveFunc(xp,true,pb);
     if(status<0) return(status);
 
-    // LOOP OVER CONTROLS
-    for(int i=0;i<nx;i++) {
+    // LOOP OVER CONTROLS (possibly concurrently)
+    return aTarget->evaluateParameters(nx,
+            [&](const OptimizationTarget& target,int i) {
+        Vector xpi=x;
+        double pf;
+
         // PERTURB FORWARD
-        xp[i] = x[i] + dx[i];
-        status = aTarget->objectiveFunc(xp,true,pf);
-        if(status<0) return(status);
+        xpi[i] = x[i] + dx[i];
+        int statusi = target.objectiveFunc(xpi,true,pf);
+        if(statusi<0) return(statusi);
 
         // DERIVATIVES OF PERFORMANCE
         dpdx[i] = (pf-pb)/dx[i];
-
-        // RESTORE CONTROLS
-        xp[i] = x[i];
-    }
-
-    return(status);
+        return(statusi);
+    });
 }
@@ -35,6 +35,9 @@
 #include "Array.h"
 #include <simmath/Optimizer.h>
 
+#include <memory>
+#include <vector>
+
 
 namespace OpenSim { 
 
@@ -45,6 +48,16 @@ namespace OpenSim {
  * systems.  If a class represents a redundant system for which one would
  * like to find a set of optimal controls, the class should inherit from
  * this class and implement the virtual functions defined here.
+ *
+ * The finite-difference derivatives (CentralDifferences(),
+ * CentralDifferencesConstraint() and ForwardDifferences()) perturb one
+ * parameter at a time, and each perturbation is a full evaluation of the
+ * objective or constraints. They can evaluate the perturbations of
+ * different parameters concurrently (see setNumDifferenceThreads()) if the
+ * target can make copies of itself that are evaluated independently, e.g.,
+ * each with its own copy of the model: see createThreadCopy() and
+ * prepareThreadCopy().
+ *
  * @author Frank C. Anderson
  */
 class OSIMCOMMON_API OptimizationTarget : public SimTK::OptimizerSystem
@@ -58,6 +71,19 @@ public:
 protected:
     /** Perturbation size for computing numerical derivatives. */
     Array<double> _dx;
+    /** Evaluations since the last resetNumEvaluations(), counted by the
+    derived classes' objectiveFunc(), gradientFunc(), constraintFunc() and
+    constraintJacobian(). */
+    mutable int _numObjectiveEvaluations = 0;
+    mutable int _numGradientEvaluations = 0;
+    mutable int _numConstraintEvaluations = 0;
+    mutable int _numConstraintJacobianEvaluations = 0;
+private:
+    /** Number of threads that evaluate finite differences. */
+    int _numDifferenceThreads = 1;
+    /** Copies of this target used by the threads of finite differences. */
+    mutable SimTK::ResetOnCopy<
+            std::vector<std::unique_ptr<OptimizationTarget>>> _threadCopies;
 
 //=============================================================================
 // METHODS
@@ -72,6 +98,48 @@ public:
     double getDX(int aIndex);
     double* getDXArray();
 
+    // EVALUATION COUNTS
+    /** Number of evaluations of the objective, its gradient, the constraints
+    and their Jacobian since construction or the last call to
+    resetNumEvaluations(). Each gradient evaluation is usually one iteration
+    of a gradient-based optimizer. */
+    int getNumObjectiveEvaluations() const
+    {   return _numObjectiveEvaluations; }
+    int getNumGradientEvaluations() const { return _numGradientEvaluations; }
+    int getNumConstraintEvaluations() const
+    {   return _numConstraintEvaluations; }
+    int getNumConstraintJacobianEvaluations() const
+    {   return _numConstraintJacobianEvaluations; }
+    /** The sum of the four counts above. */
+    int getNumEvaluations() const {
+        return _numObjectiveEvaluations + _numGradientEvaluations +
+               _numConstraintEvaluations + _numConstraintJacobianEvaluations;
+    }
+    void resetNumEvaluations() {
+        _numObjectiveEvaluations = _numGradientEvaluations =
+        _numConstraintEvaluations = _numConstraintJacobianEvaluations = 0;
+    }
+
+    // CONCURRENT FINITE DIFFERENCES
+    /** Number of threads that evaluate the perturbations of the parameters
+    in finite differences (default: 1, one perturbation at a time); if not
+    positive, the number of hardware threads is used. Only targets that
+    implement createThreadCopy() use more than one thread. */
+    void setNumDifferenceThreads(int aNumThreads)
+    {   _numDifferenceThreads = aNumThreads; }
+    int getNumDifferenceThreads() const { return _numDifferenceThreads; }
+    /** Make a copy of this target that can be evaluated on another thread
+    while this target is evaluated, e.g., with its own copy of the model.
+    The copies are made on the calling thread, the first time finite
+    differences use more than one thread, and are kept for later
+    evaluations. The default returns nullptr: this target cannot be
+    copied, and its finite differences are evaluated one at a time. */
+    virtual OptimizationTarget* createThreadCopy() const { return nullptr; }
+    /** Update a copy made by createThreadCopy() with whatever its
+    evaluations depend on besides the parameters (e.g., the current state
+    or time), before each finite-difference evaluation that uses it. */
+    virtual void prepareThreadCopy(OptimizationTarget& aCopy) const {}
+
     // UTILITY
     void validatePerturbationSize(double &aSize);
 
@@ -88,6 +156,16 @@ public:
         ForwardDifferences(const OptimizationTarget *aTarget,
         double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
 
+private:
+    // The targets that evaluate finite differences: this target, and the
+    // copies of it to evaluate concurrently, prepared for evaluation.
+    std::vector<const OptimizationTarget*> getDifferenceTargets() const;
+    // Call evaluate(target, i) for each parameter i, where target is one of
+    // getDifferenceTargets() and is used by one thread at a time. Returns
+    // the first negative status, or the last status.
+    template <typename Evaluate>
+    int evaluateParameters(int aNumParameters, Evaluate evaluate) const;
+
 };
 
 }; //namespace
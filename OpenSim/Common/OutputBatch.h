@@ -0,0 +1,174 @@
+#ifndef OPENSIM_OUTPUT_BATCH_H_
+#define OPENSIM_OUTPUT_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  OutputBatch.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "ComponentOutput.h"
+
+#include "SimTKcommon/internal/BigMatrix.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenSim {
+
+/** An OutputBatch evaluates a fixed set of Output channels (all of the same
+value type T) in a single call, writing their values into a contiguous
+SimTK::Vector_<T> or SimTK::RowVector_<T>. This is intended for clients that
+read many outputs at every time step (e.g., reporters).
+
+Compared to calling Output<T>::Channel::getValue() for each channel, a batch
+- evaluates the channels in order of their dependency stage (and grouped by
+  owning Component), so that channels that need lower stages, and channels
+  from the same Component, are computed together,
+- evaluates a channel that was added more than once only once, and
+- writes each value directly into the result instead of into an
+  intermediate copy held by the channel.
+
+The values are placed in the order in which the channels were added,
+regardless of the order in which they are evaluated.
+
+The batch holds pointers to the channels, so it must be rebuilt if the
+Components owning those channels are destroyed or copied (e.g., after
+reconnecting the Inputs from which the channels were obtained).
+
+@code{.cpp}
+OutputBatch<double> batch;
+for (const auto& chan : input.getChannels()) batch.addChannel(*chan);
+SimTK::RowVector values;
+batch.getValues(state, values);
+@endcode */
+template <typename T>
+class OutputBatch {
+public:
+    /// The type of the channels evaluated by this batch.
+    typedef typename Output<T>::Channel Channel;
+
+    OutputBatch() = default;
+
+    /** Remove all channels from this batch. */
+    void clear() {
+        _channels.clear();
+        _order.clear();
+        _duplicates.clear();
+        _dependsOnStage = SimTK::Stage::Empty;
+        _isSorted = true;
+    }
+
+    /** Append a channel to this batch. Its value will be at index
+    getNumChannels() - 1 (before the channel was added) of the values. */
+    void addChannel(const Channel& channel) {
+        _channels.push_back(&channel);
+        const SimTK::Stage& stage = channel.getOutput().getDependsOnStage();
+        if (stage > _dependsOnStage) _dependsOnStage = stage;
+        _isSorted = false;
+    }
+
+    /** Append all channels of the provided Output to this batch, in the order
+    of Output<T>::getChannels(). */
+    void addOutput(const Output<T>& output) {
+        for (const auto& it : output.getChannels()) addChannel(it.second);
+    }
+
+    /** The number of channels (including duplicates) in this batch. */
+    int getNumChannels() const { return int(_channels.size()); }
+
+    /** Get the channel whose value is at the given index of the values. */
+    const Channel& getChannel(int index) const {
+        OPENSIM_THROW_IF(index < 0 || index >= getNumChannels(),
+                IndexOutOfRange, size_t(index), 0,
+                _channels.empty() ? 0 : _channels.size() - 1);
+        return *_channels[index];
+    }
+
+    /** The latest stage that any channel in this batch depends on; the state
+    should be realized to (at least) this stage before evaluating the batch.
+    Like Output<T>::Channel::getValue(), getValues() does not check this, so
+    that a caller (e.g., a reporter) can check it once, if at all. */
+    const SimTK::Stage& getDependsOnStage() const { return _dependsOnStage; }
+
+    /** Evaluate all channels of this batch. The values are resized to
+    getNumChannels() if necessary. */
+    void getValues(const SimTK::State& state,
+                   SimTK::RowVector_<T>& values) const {
+        values.resize(getNumChannels());
+        evaluate(state, values);
+    }
+
+    /** @copydoc getValues(const SimTK::State&, SimTK::RowVector_<T>&) const */
+    void getValues(const SimTK::State& state,
+                   SimTK::Vector_<T>& values) const {
+        values.resize(getNumChannels());
+        evaluate(state, values);
+    }
+
+private:
+    // Compute the evaluation order, and find the duplicate channels.
+    void sort() const {
+        _order.clear();
+        _duplicates.clear();
+        std::unordered_map<const Channel*, int> firstIndex;
+        for (int i = 0; i < getNumChannels(); ++i) {
+            const auto inserted = firstIndex.emplace(_channels[i], i);
+            if (inserted.second) _order.push_back(i);
+            else _duplicates.emplace_back(i, inserted.first->second);
+        }
+        std::stable_sort(_order.begin(), _order.end(),
+                [this](int a, int b) {
+                    const auto& outA = _channels[a]->getOutput();
+                    const auto& outB = _channels[b]->getOutput();
+                    if (outA.getDependsOnStage() != outB.getDependsOnStage())
+                        return outA.getDependsOnStage() <
+                               outB.getDependsOnStage();
+                    return &outA.getOwner() < &outB.getOwner();
+                });
+        _isSorted = true;
+    }
+
+    template <typename VectorType>
+    void evaluate(const SimTK::State& state, VectorType& values) const {
+        if (!_isSorted) sort();
+        for (const int index : _order) {
+            const Channel& chan = *_channels[index];
+            const Output<T>& output = chan.getOutput();
+            output._outputFcn(output._owner.get(), state, chan._channelName,
+                              values[index]);
+        }
+        for (const auto& dup : _duplicates)
+            values[dup.first] = values[dup.second];
+    }
+
+    std::vector<const Channel*> _channels;
+    SimTK::Stage _dependsOnStage = SimTK::Stage::Empty;
+
+    // Indices into _channels, in the order in which to evaluate them.
+    mutable std::vector<int> _order;
+    // (index, index of the first occurrence) of channels added more than once.
+    mutable std::vector<std::pair<int, int>> _duplicates;
+    mutable bool _isSorted = true;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_OUTPUT_BATCH_H_
@@ -0,0 +1,50 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  Parallelism.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Parallelism.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace OpenSim;
+
+std::atomic<bool> Parallelism::_deterministic(false);
+std::atomic<int> Parallelism::_numDeterministicBlocks(8);
+
+void Parallelism::setNumDeterministicBlocks(int numBlocks)
+{
+    if (numBlocks < 1)
+        throw Exception("Parallelism::setNumDeterministicBlocks() the number "
+                "of blocks must be positive, but is " +
+                std::to_string(numBlocks) + ".", __FILE__, __LINE__);
+    _numDeterministicBlocks.store(numBlocks);
+}
+
+int Parallelism::getNumBlocks(int numItems, int numThreads,
+                              int minItemsPerBlock)
+{
+    const int maxBlocks = isDeterministic() ? getNumDeterministicBlocks()
+                                            : numThreads;
+    return std::max(1, std::min(maxBlocks,
+                                numItems/std::max(1, minItemsPerBlock)));
+}
@@ -0,0 +1,107 @@
+#ifndef OPENSIM_PARALLELISM_H_
+#define OPENSIM_PARALLELISM_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  Parallelism.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <atomic>
+
+namespace OpenSim {
+
+/** Settings that apply to all of OpenSim's parallel computations.
+
+Most parallel computations divide independent work (frames, columns, files,
+members of an ensemble) among threads, and their results do not depend on
+the number of threads. A few divide work whose results do depend on how it
+is divided:
+- the forces computed concurrently (see Model::setNumForceThreads()) are
+  summed per block, and the blocks' sums are then added together;
+- InverseKinematicsTool::setNumThreads() solves chunks of frames, the first
+  frame of each chunk assembled and the others tracked from the previous
+  frame;
+- AnalyzeTool::setNumThreads() analyzes chunks of frames, and analyses such
+  as StaticOptimization start each frame from the solution of the previous
+  frame of the chunk.
+
+These computations normally divide the work into one block per thread, so
+that their results differ, by round-off or by the solver's tolerance, when
+run with different numbers of threads. In deterministic mode, they divide
+the work into a fixed number of blocks (see setNumDeterministicBlocks())
+regardless of the number of threads, and combine the blocks in order, so
+that the results are bitwise reproducible for any number of threads,
+including 1 (given the same build, inputs and settings).
+
+@code{.cpp}
+Parallelism::setDeterministic(true);
+@endcode
+
+Deterministic mode costs throughput:
+- At most getNumDeterministicBlocks() threads work at once, however many are
+  requested, and blocks of unequal cost are not rebalanced.
+- The work is divided into blocks even with one thread, e.g., a Model with
+  getNumForceThreads() 1 still accumulates its concurrent forces in one
+  array per block (an extra sum of the body forces per block for each force
+  evaluation), and the tools assemble (rather than track) the first frame
+  of each chunk.
+The extra sums cost one pass over the body and mobility forces per block
+for each force evaluation, which is small next to the forces of a model with
+muscles; the extra assemblies cost one assembly per chunk, which is small for
+trials of more than a few hundred frames. The cap on threads is the larger
+cost on machines with more cores than blocks; raise the number of blocks to
+match the largest machine the results must be reproduced on. */
+class OSIMCOMMON_API Parallelism {
+public:
+    /** Turn deterministic mode on or off, for all threads (default: off).
+    The setting takes effect for the forces of a Model at its next call to
+    initSystem(), and for the tools at their next run. */
+    static void setDeterministic(bool deterministic)
+    {   _deterministic.store(deterministic); }
+    static bool isDeterministic() { return _deterministic.load(); }
+
+    /** The number of blocks into which deterministic mode divides work
+    (default: 8). This is also the largest number of threads that work at
+    once in deterministic mode, and results are reproducible only between
+    runs with the same number of blocks.
+    @throws Exception If numBlocks is not positive. */
+    static void setNumDeterministicBlocks(int numBlocks);
+    static int getNumDeterministicBlocks()
+    {   return _numDeterministicBlocks.load(); }
+
+    /** The number of blocks into which to divide numItems items whose
+    result depends on the division, for numThreads threads (already resolved
+    to a positive number), with at least minItemsPerBlock items in each
+    block: min(numThreads, numItems/minItemsPerBlock), or, in deterministic
+    mode, min(getNumDeterministicBlocks(), numItems/minItemsPerBlock); at
+    least 1. */
+    static int getNumBlocks(int numItems, int numThreads,
+                            int minItemsPerBlock = 1);
+
+private:
+    static std::atomic<bool> _deterministic;
+    static std::atomic<int> _numDeterministicBlocks;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_PARALLELISM_H_
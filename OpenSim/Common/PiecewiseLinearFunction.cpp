@@ -425,9 +425,13 @@ void PiecewiseLinearFunction::calcCoefficients()
 }
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double PiecewiseLinearFunction::calcValue(double aX) const
 {
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0])
         return _y[0] + (aX - _x[0]) * _b[0];
@@ -443,23 +447,59 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
     else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
         return _y[n-1];
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
+    const int k = findInterval(aX);
 
     return _y[k] + (aX - _x[k]) * _b[k];
 }
 
+void PiecewiseLinearFunction::calcValues(
+        const std::vector<const PiecewiseLinearFunction*>& functions,
+        double aX, double* rValues)
+{
+    if (functions.empty())
+        return;
+    const PiecewiseLinearFunction& first = *functions[0];
+    const int n = first._x.getSize();
+    const int numFunctions = (int)functions.size();
+
+    // The same cases as calcValue(), decided once for all of the functions.
+    if (aX < first._x[0]) {
+        for (int i = 0; i < numFunctions; i++) {
+            const PiecewiseLinearFunction& f = *functions[i];
+            rValues[i] = f._y[0] + (aX - f._x[0]) * f._b[0];
+        }
+    } else if (aX > first._x[n-1]) {
+        for (int i = 0; i < numFunctions; i++) {
+            const PiecewiseLinearFunction& f = *functions[i];
+            rValues[i] = f._y[n-1] + (aX - f._x[n-1]) * f._b[n-1];
+        }
+    } else if (EQUAL_WITHIN_ERROR(aX, first._x[0])) {
+        for (int i = 0; i < numFunctions; i++)
+            rValues[i] = functions[i]->_y[0];
+    } else if (EQUAL_WITHIN_ERROR(aX, first._x[n-1])) {
+        for (int i = 0; i < numFunctions; i++)
+            rValues[i] = functions[i]->_y[n-1];
+    } else {
+        const int k = first.findInterval(aX);
+        for (int i = 0; i < numFunctions; i++) {
+            const PiecewiseLinearFunction& f = *functions[i];
+            rValues[i] = f._y[k] + (aX - f._x[k]) * f._b[k];
+        }
+    }
+}
+
+bool PiecewiseLinearFunction::hasSameX(
+        const PiecewiseLinearFunction& aFunction) const
+{
+    const int n = _x.getSize();
+    if (aFunction._x.getSize() != n)
+        return false;
+    for (int i = 0; i < n; i++)
+        if (_x[i] != aFunction._x[i])
+            return false;
+    return true;
+}
+
 double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
     if (derivComponents.size() == 0)
@@ -486,6 +526,29 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         return _b[n-1];
     }
 
+    const int k = findInterval(aX);
+
+    return _b[k];
+}
+
+//_____________________________________________________________________________
+/**
+ * Find the interval [x_k, x_k+1] of the points that contains an abscissa,
+ * which must be within the range of the points. As in SimmSpline, the
+ * interval found last, or one of its neighbors, is checked before doing a
+ * binary search.
+ */
+int PiecewiseLinearFunction::findInterval(double aX) const
+{
+    const int n = _x.getSize();
+    const int hint = _lastInterval.load(std::memory_order_relaxed);
+    for (int k : {hint, hint + 1, hint - 1}) {
+        if (k >= 0 && k < n - 1 && _x[k] <= aX && aX <= _x[k+1]) {
+            if (k != hint) _lastInterval.store(k, std::memory_order_relaxed);
+            return k;
+        }
+    }
+
     // Do a binary search to find which two points the abscissa is between.
     int k, i = 0;
     int j = n;
@@ -499,8 +562,8 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         else
             break;
     }
-
-    return _b[k];
+    _lastInterval.store(k, std::memory_order_relaxed);
+    return k;
 }
 
 int PiecewiseLinearFunction::getArgumentSize() const
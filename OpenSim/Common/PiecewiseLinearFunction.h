@@ -26,7 +26,9 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <string>
+#include <vector>
 #include "Array.h"
 #include "PropertyDblArray.h"
 #include "Function.h"
@@ -64,6 +66,8 @@ protected:
 
 private:
     Array<double> _b;
+    // The interval of the last evaluation; see findInterval().
+    mutable std::atomic<int> _lastInterval{0};
 
 //=============================================================================
 // METHODS
@@ -115,7 +119,17 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
+    double calcValue(double aX) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    /** Evaluate, at the same abscissa, functions that all have the same X
+    values as the first one (see hasSameX()), finding the interval that
+    contains the abscissa only once. rValues[i] is set to what
+    functions[i]->calcValue() would return. */
+    static void calcValues(
+            const std::vector<const PiecewiseLinearFunction*>& functions,
+            double aX, double* rValues);
+    /** Whether this function has exactly the same X values as another. */
+    bool hasSameX(const PiecewiseLinearFunction& aFunction) const;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -124,6 +138,7 @@ public:
 
 private:
    void calcCoefficients();
+   int findInterval(double aX) const;
 
 //=============================================================================
 };  // END class PiecewiseLinearFunction
@@ -694,6 +694,16 @@ Property<T>::getTypeName() const {
 // Hide SimpleProperty and ObjectProperty from Doxygen; users don't need
 // to know about these.
 /** @cond **/
+// Bytes that a simple value holds outside of itself; see
+// SimpleProperty::estimateMemoryUsage().
+template <class T> inline size_t estimateHeapMemoryUsage(const T&)
+{   return 0; }
+inline size_t estimateHeapMemoryUsage(const std::string& value)
+{   return value.capacity(); }
+template <class E>
+inline size_t estimateHeapMemoryUsage(const SimTK::Vector_<E>& value)
+{   return size_t(value.size()) * sizeof(E); }
+
 //==============================================================================
 //                             SIMPLE PROPERTY
 //==============================================================================
@@ -737,6 +747,13 @@ public:
 
     bool isUnnamedProperty() const override final {return false;}
     bool isObjectProperty() const override final {return false;}
+
+    size_t estimateMemoryUsage() const override final {
+        size_t bytes = AbstractProperty::estimateMemoryUsage() +
+                       size_t(values.capacity()) * sizeof(T);
+        for (const T& value : values) bytes += estimateHeapMemoryUsage(value);
+        return bytes;
+    }
     bool isAcceptableObjectTag(const std::string&) const override final 
     {   return false; }
 
@@ -1003,6 +1020,12 @@ public:
     bool isUnnamedProperty() const override final {return isUnnamed;}
     bool isObjectProperty() const override final {return true;}
 
+    size_t estimateMemoryUsage() const override final {
+        return AbstractProperty::estimateMemoryUsage() +
+               objectClassName.capacity() +
+               size_t(objects.capacity()) * sizeof(SimTK::ClonePtr<T>);
+    }
+
     int getNumValues() const override final {return objects.size();}
     void clearValues() override final {objects.clear();}
 
@@ -28,6 +28,7 @@
 #include "Property.h"
 
 #include <map>
+#include <unordered_map>
 
 namespace OpenSim {
 
@@ -173,7 +174,9 @@ private:
     // The properties, in the order they were added.
     SimTK::Array_<AbstractProperty*>    properties;
     // A mapping from property name to its index in the properties array.
-    std::map<std::string, int>          propertyIndex;
+    // Properties are looked up by name for every element read from XML, so
+    // the names are hashed.
+    std::unordered_map<std::string, int> propertyIndex;
 
 //==============================================================================
 };  // END of class PropertyTable
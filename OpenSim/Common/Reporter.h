@@ -24,7 +24,10 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/OutputBatch.h>
+#include <OpenSim/Common/STOFileWriter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Common/TrajectoryCompressor.h>
 
 namespace OpenSim {
 
@@ -180,10 +183,16 @@ class TableReporter_ : public Reporter<InputT> {
 OpenSim_DECLARE_CONCRETE_OBJECT_T(TableReporter_, InputT, Reporter<InputT>);
 public:
     TableReporter_() = default;
-    virtual ~TableReporter_() = default;
+    virtual ~TableReporter_() {
+        // Write the last row held back by the compression to the file.
+        if (_fileSink.writer) finishCompression();
+    }
 
     /** Retrieve the report as a TimeSeriesTable.                             */
     const TimeSeriesTable_<ValueT>& getTable() const {
+        finishCompression();
+        if (!_compact.times.empty())
+            const_cast<Self*>(this)->convertCompactRows();
         return _outputTable;
     }
 
@@ -200,35 +209,109 @@ public:
         if (!columnLabels.empty()) {
             _outputTable.setColumnLabels(columnLabels);
         }
+        _compact = CompactRows{};
+        _compressor.clear();
+    }
+
+    /** Keep the report in single precision (as floats, with about 7
+    significant digits), which halves the memory it takes in long
+    simulations; times are kept in double precision. The rows are converted
+    to ValueT when getTable() is called, and are kept in the table (in
+    double precision) from then on, so call getTable() once, at the end,
+    e.g., to write the report to a binary file in single precision (see
+    BinaryFileAdapter_::write()). This clears the report. Only reporters
+    whose inputs are of type ValueT, and whose values consist of doubles
+    (e.g., TableReporter and TableReporterVec3), support single precision.
+    @throws Exception If this reporter does not support single precision. */
+    void setSinglePrecision(bool singlePrecision) {
+        OPENSIM_THROW_IF_FRMOBJ(singlePrecision && !SupportsSinglePrecision,
+            Exception, "This reporter's values cannot be kept in single "
+            "precision.");
+        clearTable();
+        _singlePrecision = singlePrecision;
+    }
+    bool getSinglePrecision() const { return _singlePrecision; }
+
+    /** Keep only the rows that linear interpolation between the rows kept
+    does not reproduce within the given tolerance, in every value (see
+    TrajectoryCompressor); the first and last rows are always kept. A
+    smooth report then takes a fraction of the rows, in the table, in
+    single precision, or in the output file, and readers that interpolate
+    linearly between rows (e.g., Storage::getDataAtTime()) see it within
+    the tolerance. A row is known to be kept only when a later row is
+    reported, so the last row reported is added when getTable() or
+    closeOutputFile() is called. A tolerance of 0 (the default) turns the
+    compression off. This clears the report. Only the reporters that
+    support single precision (see setSinglePrecision()) support
+    compression.
+    @throws Exception If the tolerance is negative, or if this reporter
+    does not support compression.                                         */
+    void setCompressionTolerance(double tolerance) {
+        OPENSIM_THROW_IF_FRMOBJ(tolerance > 0 && !SupportsSinglePrecision,
+            Exception, "This reporter's values cannot be compressed.");
+        _compressor = TrajectoryCompressor(tolerance);
+        clearTable();
+    }
+    double getCompressionTolerance() const {
+        return _compressor.getTolerance();
+    }
+
+    /** Write the report to an STO file as it is produced (see
+    STOFileWriter_), instead of keeping it in the table; use this to keep
+    memory use flat in long simulations. The file is opened (and its header
+    written) at the next report; rows are written in chunks of chunkSize rows,
+    by a background thread if flushInBackground is true. While the file is
+    open, getTable() contains only the column labels. A copy of this reporter
+    does not write to the file.                                           */
+    void setOutputFile(const std::string& fileName, int chunkSize = 1000,
+                       bool flushInBackground = false) {
+        closeOutputFile();
+        _fileSink.fileName = fileName;
+        _fileSink.chunkSize = chunkSize;
+        _fileSink.flushInBackground = flushInBackground;
+    }
+
+    /** Write all rows reported so far to the output file set with
+    setOutputFile(), without closing it.                                      */
+    void flushOutputFile() {
+        if (_fileSink.writer) _fileSink.writer->flush();
+    }
+
+    /** Write all rows reported so far to the output file set with
+    setOutputFile() and close it. Later reports are kept in the table again.
+    This is also done when this reporter is destroyed.                        */
+    void closeOutputFile() {
+        if (_fileSink.writer) {
+            finishCompression();
+            _fileSink.writer->close();
+        }
+        _fileSink.writer.reset();
+        _fileSink.fileName.clear();
     }
 
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
-        SimTK::RowVector_<ValueT> result;
-        result.resize(int(input.getNumConnectees()));
-
-        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
-              const auto& chan = input.getChannel(idx);
-              const auto& value = chan.getValue(state);
-              result[idx] = value;
-        }
-        try {
-            const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
-        } catch(const InvalidTimestamp& exception) {
-            OPENSIM_THROW(Exception,
-                          "Attempting to update reporter with rows having "
-                          "invalid timestamps. Hint: If running simulation in "
-                          "a loop, use clearTable() to clear table at the end "
-                          "of each loop.\n\n" + std::string{exception.what()});
+        if (_outputBatch.getNumChannels() != int(input.getNumConnectees()))
+            updateOutputBatch();
+        _outputBatch.getValues(state, _row);
+        if (_compressor.getTolerance() > 0 && _row.size() > 0) {
+            _compressor.append(state.getTime(),
+                    reinterpret_cast<const double*>(&_row[0]),
+                    _row.size() * NumScalars,
+                    [this](double time, const double* values) {
+                        storeKeptRow(time, values);
+                    });
+            return;
         }
+        storeRow(state.getTime(), _row);
     }
 
     void extendConnect(Component& root) override {
         Super::extendConnect(root);
 
         const auto& input = this->template getInput<InputT>("inputs");
+        updateOutputBatch();
 
         std::vector<std::string> labels;
         for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
@@ -246,11 +329,147 @@ protected:
     }
 
 private:
+    static constexpr bool SupportsSinglePrecision =
+            std::is_same<InputT, ValueT>::value &&
+            (std::is_same<ValueT, double>::value ||
+             is_SimTK_Vec<ValueT>::value ||
+             std::is_same<ValueT, SimTK::SpatialVec>::value);
+    static constexpr int NumScalars = int(sizeof(ValueT) / sizeof(double));
+
+    // Write the row to the output file, or append it to the single-precision
+    // rows or to the table.
+    template <typename RowType>
+    void storeRow(double time, const RowType& row) const {
+        if (writeToOutputFile(time, row)) return;
+        if (_singlePrecision) {
+            appendCompactRow(time, row);
+            return;
+        }
+        try {
+            const_cast<Self*>(this)->_outputTable.appendRow(time, row);
+        } catch(const InvalidTimestamp& exception) {
+            OPENSIM_THROW(Exception,
+                          "Attempting to update reporter with rows having "
+                          "invalid timestamps. Hint: If running simulation in "
+                          "a loop, use clearTable() to clear table at the end "
+                          "of each loop.\n\n" + std::string{exception.what()});
+        }
+    }
+
+    // Store a row kept by the compressor, given as the scalars of its
+    // values.
+    void storeKeptRow(double time, const double* values) const {
+        _keptRow.resize(_row.size());
+        for (int c = 0; c < _keptRow.size(); ++c) {
+            double* scalars = reinterpret_cast<double*>(&_keptRow[c]);
+            for (int k = 0; k < NumScalars; ++k) scalars[k] = *values++;
+        }
+        storeRow(time, _keptRow);
+    }
+
+    // Store the last row reported, if the compressor has held it back.
+    void finishCompression() const {
+        _compressor.finish([this](double time, const double* values) {
+            storeKeptRow(time, values);
+        });
+    }
+
+    // Append the row to the single-precision rows.
+    template <typename RowType>
+    void appendCompactRow(double time, const RowType& row) const {
+        const double lastTime = !_compact.times.empty()
+            ? _compact.times.back()
+            : _outputTable.getNumRows() > 0
+                ? _outputTable.getIndependentColumn().back()
+                : -SimTK::Infinity;
+        OPENSIM_THROW_IF(time <= lastTime, Exception,
+                         "Attempting to update reporter with rows having "
+                         "invalid timestamps. Hint: If running simulation in "
+                         "a loop, use clearTable() to clear table at the end "
+                         "of each loop.");
+        _compact.numColumns = row.size();
+        _compact.times.push_back(time);
+        for (int c = 0; c < row.size(); ++c) {
+            const double* scalars = reinterpret_cast<const double*>(&row[c]);
+            for (int k = 0; k < NumScalars; ++k)
+                _compact.values.push_back(float(scalars[k]));
+        }
+    }
+
+    // Move the single-precision rows into the table.
+    void convertCompactRows() {
+        SimTK::RowVector_<ValueT> row(_compact.numColumns);
+        const float* value = _compact.values.data();
+        for (double time : _compact.times) {
+            for (int c = 0; c < row.size(); ++c) {
+                double* scalars = reinterpret_cast<double*>(&row[c]);
+                for (int k = 0; k < NumScalars; ++k) scalars[k] = *value++;
+            }
+            _outputTable.appendRow(time, row);
+        }
+        _compact = CompactRows{};
+    }
+
+    // If an output file was set, append the row to it (opening it first if
+    // necessary) and return true.
+    template <typename RowType>
+    bool writeToOutputFile(double time, const RowType& row) const {
+        FileSink& sink = _fileSink;
+        if (sink.fileName.empty()) return false;
+        if (!sink.writer) {
+            std::vector<std::string> labels;
+            if (_outputTable.hasColumnLabels())
+                labels = _outputTable.getColumnLabels();
+            sink.writer.reset(new STOFileWriter_<ValueT>(sink.fileName,
+                    labels, sink.chunkSize, sink.flushInBackground));
+        }
+        sink.writer->appendRow(time, row);
+        return true;
+    }
+
+    // Collect the channels connected to the "inputs" Input so that they can
+    // be evaluated in one call.
+    void updateOutputBatch() const {
+        const auto& input = this->template getInput<InputT>("inputs");
+        _outputBatch.clear();
+        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx)
+            _outputBatch.addChannel(input.getChannel(idx));
+    }
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+
+    // The report in single precision, if setSinglePrecision(): the rows not
+    // yet converted into _outputTable.
+    struct CompactRows {
+        std::vector<double> times;
+        std::vector<float> values;
+        int numColumns = 0;
+    };
+    mutable CompactRows _compact;
+    bool _singlePrecision = false;
+
+    // The channels to report; they belong to the connectees, so the batch is
+    // not copied.
+    mutable SimTK::ResetOnCopy<OutputBatch<InputT>> _outputBatch;
+    // The row into which the channels are evaluated.
+    mutable SimTK::RowVector_<InputT> _row;
+
+    // The compression of the report, if setCompressionTolerance(), and the
+    // row into which the rows it keeps are copied.
+    mutable TrajectoryCompressor _compressor;
+    mutable SimTK::RowVector_<ValueT> _keptRow;
+
+    // The file to which the report is written, if any; see setOutputFile().
+    struct FileSink {
+        std::string fileName;
+        int chunkSize = 1000;
+        bool flushInBackground = false;
+        std::shared_ptr<STOFileWriter_<ValueT>> writer;
+    };
+    mutable SimTK::ResetOnCopy<FileSink> _fileSink;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -344,7 +563,7 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
     const auto& input = getInput<SimTK::Vector>("inputs");
     const SimTK::Vector& result = input.getValue(state, 0);
     
-    if (_outputTable.getNumRows() == 0) {
+    if (_outputTable.getNumRows() == 0 && !_fileSink.writer) {
         std::vector<std::string> labels;
         const std::string& base = input.getLabel(0);
         for (int ix = 0; ix < result.size(); ++ix) {
@@ -353,8 +572,12 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
         const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
     }
 
-    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
-                                                    (~result).getAsRowVector());
+    if (writeToOutputFile(state.getTime(), (~result).getAsRowVectorView()))
+        return;
+
+    // Append a view of the value to avoid copying it into a temporary row.
+    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
+            (~result).getAsRowVectorView());
 }
 
 /** @name Commonly used concrete TableReporters */
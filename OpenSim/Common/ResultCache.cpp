@@ -0,0 +1,143 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ResultCache.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ResultCache.h"
+#include "Exception.h"
+#include "IO.h"
+#include "Storage.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+// Copy the file named from to the file named to, replacing it.
+void copyFile(const std::string& from, const std::string& to)
+{
+    std::ifstream in(from, std::ios::binary);
+    OPENSIM_THROW_IF(!in.good(), Exception,
+        "ResultCache: could not open file '" + from + "'.");
+    std::ofstream out(to, std::ios::binary | std::ios::trunc);
+    OPENSIM_THROW_IF(!out.good(), Exception,
+        "ResultCache: could not open file '" + to + "' for writing.");
+    // An empty file leaves the stream in a failed state.
+    if (in.peek() != std::ifstream::traits_type::eof()) out << in.rdbuf();
+    OPENSIM_THROW_IF(!out.good(), Exception,
+        "ResultCache: could not copy file '" + from + "' to '" + to + "'.");
+}
+}
+
+//=============================================================================
+// KEY
+//=============================================================================
+void ResultCache::Key::addBytes(const char* data, size_t size)
+{
+    const std::uint64_t prime = 1099511628211ULL;
+    for (size_t i = 0; i < size; ++i) {
+        const auto byte = std::uint64_t(static_cast<unsigned char>(data[i]));
+        _hashes[0] = (_hashes[0] ^ byte) * prime;
+        _hashes[1] = (_hashes[1] ^ byte) * prime;
+    }
+}
+
+ResultCache::Key& ResultCache::Key::add(const std::string& data)
+{
+    const std::string size = std::to_string(data.size()) + ":";
+    addBytes(size.data(), size.size());
+    addBytes(data.data(), data.size());
+    return *this;
+}
+
+ResultCache::Key& ResultCache::Key::addFile(const std::string& fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in.good(), Exception,
+        "ResultCache: could not open file '" + fileName + "'.");
+    std::string contents;
+    char buffer[65536];
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+        contents.append(buffer, size_t(in.gcount()));
+    OPENSIM_THROW_IF(in.bad(), Exception,
+        "ResultCache: could not read file '" + fileName + "'.");
+    return add(contents);
+}
+
+ResultCache::Key& ResultCache::Key::addStorage(const Storage& storage)
+{
+    const Array<std::string>& labels = storage.getColumnLabels();
+    for (int i = 0; i < labels.getSize(); ++i) add(labels[i]);
+    std::string values;
+    for (int i = 0; i < storage.getSize(); ++i) {
+        const StateVector& row = *storage.getStateVector(i);
+        const double time = row.getTime();
+        values.append(reinterpret_cast<const char*>(&time), sizeof(time));
+        const Array<double>& data = row.getData();
+        if (data.getSize() > 0)
+            values.append(reinterpret_cast<const char*>(&data[0]),
+                          data.getSize()*sizeof(double));
+    }
+    return add(values);
+}
+
+std::string ResultCache::Key::toString() const
+{
+    char digits[33];
+    std::snprintf(digits, sizeof(digits), "%016llx%016llx",
+                  static_cast<unsigned long long>(_hashes[0]),
+                  static_cast<unsigned long long>(_hashes[1]));
+    return digits;
+}
+
+//=============================================================================
+// CACHE
+//=============================================================================
+std::string ResultCache::getFileName(const std::string& key,
+                                     const std::string& suffix) const
+{
+    return _directory + "/" + key + suffix;
+}
+
+bool ResultCache::restore(const std::string& key,
+                          const std::vector<std::string>& fileNames) const
+{
+    std::ifstream complete(getFileName(key, ".complete"));
+    size_t numFiles = 0;
+    if (!(complete >> numFiles) || numFiles != fileNames.size()) return false;
+    for (size_t i = 0; i < numFiles; ++i)
+        copyFile(getFileName(key, "_" + std::to_string(i)), fileNames[i]);
+    return true;
+}
+
+void ResultCache::store(const std::string& key,
+                        const std::vector<std::string>& fileNames) const
+{
+    IO::makeDir(_directory);
+    const std::string completeFileName = getFileName(key, ".complete");
+    std::remove(completeFileName.c_str());
+    for (size_t i = 0; i < fileNames.size(); ++i)
+        copyFile(fileNames[i], getFileName(key, "_" + std::to_string(i)));
+    std::ofstream complete(completeFileName);
+    complete << fileNames.size() << std::endl;
+    OPENSIM_THROW_IF(!complete.good(), Exception,
+        "ResultCache: could not write file '" + completeFileName + "'.");
+}
@@ -0,0 +1,108 @@
+#ifndef OPENSIM_RESULT_CACHE_H_
+#define OPENSIM_RESULT_CACHE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ResultCache.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Storage;
+
+/** A directory of the output files of earlier runs of a computation, each
+set of files stored under a key that hashes all of the computation's inputs
+(see Key). A tool that finds its key in the cache copies the stored files to
+its outputs instead of recomputing them.
+
+@code{.cpp}
+ResultCache::Key key;
+key.add(model.computeFingerprint());
+key.addFile("markers.trc");
+ResultCache cache{"cache"};
+if (!cache.restore(key.toString(), {"ik.mot"})) {
+    // ... compute and write ik.mot ...
+    cache.store(key.toString(), {"ik.mot"});
+}
+@endcode
+
+The cache holds, for each key, the files `<key>_<i>` and, written last,
+`<key>.complete`, so that an entry interrupted while being stored is not
+found. Nothing is ever removed from the cache; delete the directory (or any
+of its entries) to reclaim the space. */
+class OSIMCOMMON_API ResultCache {
+public:
+    /** A 128-bit hash of a sequence of strings and file contents (two 64-bit
+    FNV-1a hashes with different offsets). Each string is hashed with its
+    length, so that the sequences ("ab", "c") and ("a", "bc") differ. */
+    class OSIMCOMMON_API Key {
+    public:
+        Key& add(const std::string& data);
+        /** Add the contents of the file (its bytes, not its name).
+        @throws Exception If the file cannot be read. */
+        Key& addFile(const std::string& fileName);
+        /** Add the column labels, times and values of the storage (its
+        data, not its name). */
+        Key& addStorage(const Storage& storage);
+        /** 32 hexadecimal digits. */
+        std::string toString() const;
+    private:
+        void addBytes(const char* data, size_t size);
+        std::uint64_t _hashes[2]{14695981039346656037ULL,
+                                 0x6c62272e07bb0142ULL};
+    };
+
+    /** The directory is created, if needed, when the first entry is stored.
+    A relative directory is relative to the working directory at the time of
+    each call. */
+    explicit ResultCache(const std::string& directory) :
+            _directory(directory) {}
+
+    const std::string& getDirectory() const { return _directory; }
+
+    /** If the cache holds an entry for key with as many files as fileNames,
+    copy its files to fileNames, in order, and return true; otherwise, return
+    false and leave the files alone.
+    @throws Exception If a file of the entry cannot be copied. */
+    bool restore(const std::string& key,
+                 const std::vector<std::string>& fileNames) const;
+
+    /** Copy the files to the entry for key, replacing any entry already
+    stored for key.
+    @throws Exception If a file cannot be copied. */
+    void store(const std::string& key,
+               const std::vector<std::string>& fileNames) const;
+
+private:
+    std::string getFileName(const std::string& key,
+                            const std::string& suffix) const;
+
+    std::string _directory;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_RESULT_CACHE_H_
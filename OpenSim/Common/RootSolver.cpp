@@ -29,6 +29,7 @@
 // INCLUDES
 #include <float.h>
 #include <math.h>
+#include <vector>
 #include "RootSolver.h"
 
 
@@ -71,6 +72,7 @@ void RootSolver::
 setNull()
 {
     _function = NULL;
+    _numEvaluations = 0;
 }
 
 
@@ -87,137 +89,129 @@ Array<double> RootSolver::
 solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol)
 {
-    int i;
+    int N = _function->getNX();
+    Array<double> fa(0.0,N),fb(0.0,N);
+    _function->evaluate(s,ax,fa);
+    _function->evaluate(s,bx,fb);
+    Array<double> roots = solve(s,ax,bx,fa,fb,tol);
+    _numEvaluations += 2;
+    return roots;
+}
+//_____________________________________________________________________________
+/**
+ * Solve for the roots, given the values of the function at the bounds.
+ *
+ * 
+ */
+Array<double> RootSolver::
+solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol)
+{
     int N = _function->getNX();
 
-    Array<double> a(0.0,N),b(0.0,N),c(0.0,N);
-    Array<double> fa(0.0,N),fb(0.0,N),fc(0.0,N);
-    Array<double> prev_step(0.0,N);
-    Array<double> tol_act(0.0,N);
-    Array<double> p(0.0,N);
-    Array<double> q(0.0,N);
-    Array<double> new_step(0.0,N);
-
-    bool finished = false;
-    Array<int>   converged(0,N);
-
+    // The bracket of each lane: b is the best approximation of the root, a
+    // the previous one, and c is on the other side of the root from b.
+    Array<double> a(ax), b(bx), c(ax);
+    Array<double> fa(fax), fb(fbx), fc(fax);
 
-    // INITIALIZATIONS
-    a = ax;
-    b = bx;
-    _function->evaluate(s,a,fa);
-    _function->evaluate(s,b,fb);
-    c = a;
-    fc = fa;
+    // The lanes that have not converged yet, in ascending order.
+    std::vector<int> active(N);
+    for(int i=0;i<N;i++) active[i] = i;
+    int numActive = N;
 
+    _numEvaluations = 0;
+    _numIterations = Array<int>(0,N);
 
     // ITERATION LOOP
-    int iter;
-    for(iter=0;!finished;iter++) {
+    while(true) {
 
         // ABSCISSAE MANIPULATION LOOP
-        for(i=0;i<N;i++) {
+        int numRemaining = 0;
+        for(int k=0;k<numActive;k++) {
+            const int i = active[k];
 
-            // Continue?
-            // If a function is already converged no need to do any manipulation.
-            if(converged[i]) continue;
-   
             // Make c on opposite side of b.
             // (was down at very bottom)
-             if( (fb[i]>0.0 && fc[i]>0.0) || (fb[i]<0.0 && fc[i]<0.0) ) {
+            if( (fb[i]>0.0 && fc[i]>0.0) || (fb[i]<0.0 && fc[i]<0.0) ) {
                 c[i] = a[i];
                 fc[i] = fa[i];
-             }
+            }
 
             // Record previous step
-            prev_step[i] = b[i] - a[i];
+            const double prev_step = b[i] - a[i];
 
             // Swap data for b to be the best approximation.
             if( fabs(fc[i]) < fabs(fb[i]) ) {
                 a[i] = b[i];  b[i] = c[i];  c[i] = a[i];
                 fa[i]= fb[i]; fb[i]= fc[i]; fc[i]= fa[i];
             }
-            tol_act[i] = 2.0*DBL_EPSILON*fabs(b[i]) + 0.5*tol[i];
-            new_step[i] = 0.5 * (c[i]-b[i]);
+            const double tol_act = 2.0*DBL_EPSILON*fabs(b[i]) + 0.5*tol[i];
+            double new_step = 0.5 * (c[i]-b[i]);
 
             // Converged?
-            // Original convergence test:
-            if(fabs(new_step[i])<=tol_act[i] || fb[i]==(double)0.0 ) {
-                converged[i] = iter;
-                continue;
-            }
+            // The lane keeps its root and drops out of the active lanes.
+            if(fabs(new_step)<=tol_act || fb[i]==(double)0.0 ) continue;
 
             // Interpolate if prev_step was large enough and in true direction
-            if( fabs(prev_step[i])>=tol_act[i] && fabs(fa[i])>fabs(fb[i]) ) {
-                double t1,cb,t2;
+            if( fabs(prev_step)>=tol_act && fabs(fa[i])>fabs(fb[i]) ) {
+                double t1,cb,t2,p,q;
                 cb = c[i]-b[i];
 
                 // Only two distinct roots, must use linear interpolation.
                 if(a[i]==c[i]) {
                     t1 = fb[i]/fa[i];
-                    p[i] = cb*t1;
-                    q[i] = 1.0 - t1;
+                    p = cb*t1;
+                    q = 1.0 - t1;
 
                 // Quadratic interpolation
                 } else {
-                    q[i] = fa[i]/fc[i];  t1 = fb[i]/fc[i];  t2 = fb[i]/fa[i];
-                    p[i] = t2 * ( cb*q[i]*(q[i]-t1) - (b[i]-a[i])*(t1-1.0) );
-                    q[i] = (q[i]-1.0) * (t1-1.0) * (t2-1.0);
+                    q = fa[i]/fc[i];  t1 = fb[i]/fc[i];  t2 = fb[i]/fa[i];
+                    p = t2 * ( cb*q*(q-t1) - (b[i]-a[i])*(t1-1.0) );
+                    q = (q-1.0) * (t1-1.0) * (t2-1.0);
                 }
 
                 // Change sign of q or p?
-                if( p[i]>(double)0.0 ) {
-                    q[i] = -q[i];
+                if( p>(double)0.0 ) {
+                    q = -q;
                 } else {
-                    p[i] = -p[i];
+                    p = -p;
                 }
 
                 // If the interpolate is bad, use bisection.
-                if( p[i]<(0.75*cb*q[i] - 0.5*fabs(tol_act[i]*q[i])) && p[i]<fabs(0.5*prev_step[i]*q[i]) )
-                    new_step[i] = p[i]/q[i];
+                if( p<(0.75*cb*q - 0.5*fabs(tol_act*q)) && p<fabs(0.5*prev_step*q) )
+                    new_step = p/q;
             }
 
             // Adjust step to be not less than tolerance.
-            if( fabs(new_step[i]) < tol_act[i] ) {
-                if( new_step[i] > (double)0.0 ) {
-                    new_step[i] = tol_act[i];
+            if( fabs(new_step) < tol_act ) {
+                if( new_step > (double)0.0 ) {
+                    new_step = tol_act;
                 }
                 else {
-                    new_step[i] = -tol_act[i];
+                    new_step = -tol_act;
                 }
             }
 
             // Save previous approximation.
             a[i] = b[i];  fa[i] = fb[i];
 
+            b[i] += new_step;
+            _numIterations[i]++;
+            active[numRemaining++] = i;
 
-            b[i] += new_step[i];
-             
         } // END ABSCISSAE LOOP
-     
+        numActive = numRemaining;
+
+        // FINISHED?
+        if(numActive==0) break;
 
         // NEW FUNCTION EVALUATION
+        // The function evaluates all the lanes; those that have converged
+        // are at their roots, so their values do not change.
         _function->evaluate(s, b,fb);
-
-
-        // FINISHED?
-        for(i=0;i<N;i++) {
-            finished = true;
-            if(!converged[i]) {
-                finished = false;
-                break;
-            }
-        }
+        _numEvaluations++;
     }
 
-    // PRINT
-    //cout<<"\n\nRootSolver:  found solution in "<<iter<<" iterations.\n";
-    //cout<<"converged array:\n";
-    //cout<<converged<<endl<<endl;
-    //cout<<"roots:\n";
-    //cout<<b<<endl<<endl;
-    //cout<<"errors:\n";
-    //cout<<fb<<endl;
-    
     return(b);
 }
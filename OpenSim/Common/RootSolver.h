@@ -58,6 +58,11 @@ namespace OpenSim {
  * To construct an instance of this class, the user must provide an
  * instance of a VectorFunctionUncoupledNxN.
  *
+ * Each equation (lane) is solved with Brent's method. All the lanes step
+ * together, one evaluation of the vector function per iteration; a lane that
+ * has converged keeps its root and is no longer stepped, and the solve ends
+ * as soon as every lane has converged.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -69,6 +74,8 @@ class OSIMCOMMON_API RootSolver
 private:
     
     VectorFunctionUncoupledNxN *_function;
+    int _numEvaluations;
+    Array<int> _numIterations;
 
 
 //=============================================================================
@@ -89,6 +96,19 @@ private:
 public:
     Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol);
+    /** Solve for the roots given the values of the function at the bounds
+    ax and bx, e.g., because they were already evaluated by the caller, so
+    that the function is not evaluated at the bounds again. */
+    Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol);
+
+    /** The number of evaluations of the vector function during the last
+    solve, including those at the bounds. */
+    int getNumEvaluations() const { return _numEvaluations; }
+    /** The number of iterations each equation took to converge during the
+    last solve. */
+    const Array<int>& getNumIterations() const { return _numIterations; }
 
 //=============================================================================
 };  // END class RootSolver
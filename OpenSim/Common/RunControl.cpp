@@ -0,0 +1,60 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  RunControl.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "RunControl.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+void RunControl::checkCancelled() const
+{
+    OPENSIM_THROW_IF(isCancelled(), RunCancelled, "The run was cancelled.");
+}
+
+void RunControl::setNumSteps(long long numSteps)
+{
+    _numSteps.store(numSteps);
+    _numStepsDone.store(0);
+    setProgress(0);
+}
+
+void RunControl::step()
+{
+    checkCancelled();
+    const long long done = ++_numStepsDone;
+    const long long numSteps = _numSteps.load();
+    if (numSteps > 0) setProgress(std::min(1.0, double(done)/numSteps));
+}
+
+void RunControl::setProgress(double progress)
+{
+    _progress.store(progress);
+    std::lock_guard<std::mutex> lock(_callbackMutex);
+    if (_callback) _callback(progress);
+}
+
+void RunControl::setProgressCallback(ProgressCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_callbackMutex);
+    _callback = std::move(callback);
+}
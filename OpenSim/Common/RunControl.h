@@ -0,0 +1,104 @@
+#ifndef OPENSIM_RUN_CONTROL_H_
+#define OPENSIM_RUN_CONTROL_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  RunControl.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "Exception.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace OpenSim {
+
+/** Thrown by RunControl::step() and RunControl::checkCancelled() once the
+run has been cancelled. */
+class RunCancelled : public Exception {
+public:
+    using Exception::Exception;
+};
+
+/** Lets one thread follow the progress of a long run (of a tool, or of an
+integration) on another thread, and cancel it.
+
+The run reports its progress, either as steps (e.g., frames) done out of a
+known number (see setNumSteps() and step()) or as a fraction (see
+setProgress()), and checks for cancellation between steps; step() and
+checkCancelled() throw RunCancelled once cancel() has been called. Any thread
+may call cancel(), isCancelled() and getProgress() at any time; the steps of
+a run divided among threads may be reported by all of them.
+
+@code{.cpp}
+RunControl control;
+control.setProgressCallback([](double progress) {
+    std::cout << int(100*progress) << "%" << std::endl; });
+ikTool.setRunControl(&control);
+std::thread run([&]() { ikTool.run(); });
+// ...
+control.cancel(); // run() throws RunCancelled at its next frame.
+@endcode
+
+The RunControl must outlive the run. */
+class OSIMCOMMON_API RunControl {
+public:
+    typedef std::function<void(double)> ProgressCallback;
+
+    RunControl() = default;
+    RunControl(const RunControl&) = delete;
+    RunControl& operator=(const RunControl&) = delete;
+
+    /** Ask the run to stop at its next step. Cancelling cannot be undone. */
+    void cancel() { _cancelled.store(true); }
+    bool isCancelled() const { return _cancelled.load(); }
+    /** @throws RunCancelled If the run has been cancelled. */
+    void checkCancelled() const;
+
+    /** The run is about to take numSteps steps; the progress is reset to 0.
+    */
+    void setNumSteps(long long numSteps);
+    /** One step is done: the progress advances, and the progress callback
+    is called.
+    @throws RunCancelled If the run has been cancelled. */
+    void step();
+    /** Set the progress (between 0 and 1) directly, e.g., from the time
+    reached by an integration, and call the progress callback. */
+    void setProgress(double progress);
+    /** The fraction of the run done, between 0 and 1. */
+    double getProgress() const { return _progress.load(); }
+
+    /** Called with the progress whenever it changes, on the thread that
+    reported it; calls are never concurrent. The callback must not throw. */
+    void setProgressCallback(ProgressCallback callback);
+
+private:
+    std::atomic<bool> _cancelled{false};
+    std::atomic<long long> _numSteps{0};
+    std::atomic<long long> _numStepsDone{0};
+    std::atomic<double> _progress{0};
+    std::mutex _callbackMutex;
+    ProgressCallback _callback;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_RUN_CONTROL_H_
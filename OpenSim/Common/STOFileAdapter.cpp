@@ -1,10 +1,12 @@
 #include "STOFileAdapter.h"
+#include "CompressedFile.h"
 
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter> 
 createSTOFileAdapterForReading(const std::string& fileName) {
-    std::ifstream file{fileName};
+    auto stream = CompressedFile::openForReading(fileName);
+    std::istream& file = *stream;
 
     std::regex keyvalue{R"((.*)=(.*))"};
     std::string line{};
@@ -122,6 +122,13 @@ public:
     /** Write a STO file.                                                     */
     static
     void write(const TimeSeriesTable_<T>& table, const std::string& fileName);
+
+#ifndef SWIG
+    /** Write the rows and columns of a view of a table to a STO file.        */
+    static
+    void write(const TimeSeriesTableView_<T>& view,
+               const std::string& fileName);
+#endif
 };
 
 template<typename T>
@@ -156,6 +163,13 @@ STOFileAdapter_<T>::write(const TimeSeriesTable_<T>& table,
     STOFileAdapter_{}.extendWrite(tables, fileName);
 }
 
+template<typename T>
+void 
+STOFileAdapter_<T>::write(const TimeSeriesTableView_<T>& view, 
+                         const std::string& fileName) {
+    STOFileAdapter_{}.writeTable(view, fileName);
+}
+
 std::shared_ptr<DataAdapter> 
 createSTOFileAdapterForReading(const std::string& fileName);
 
@@ -0,0 +1,178 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  STOFileReader.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "STOFileReader.h"
+#include "CompressedFile.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+// Remove the whitespace (including a '\r' of a CRLF line ending) at the ends
+// of a line.
+std::string trim(const std::string& line)
+{
+    const auto first = line.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    const auto last = line.find_last_not_of(" \t\r\n");
+    return line.substr(first, last - first + 1);
+}
+}
+
+STOFileReader::STOFileReader(const std::string& fileName, int blockSize,
+                             bool prefetch) :
+        _fileName(fileName),
+        _in(CompressedFile::openForReading(fileName)),
+        _blockSize(size_t(std::max(blockSize, 1)))
+{
+    OPENSIM_THROW_IF(!_in->good(), Exception,
+        "STOFileReader: could not open file '" + fileName + "'.");
+
+    // The header ends with "endheader", and is followed by the labels.
+    std::string line;
+    bool endOfHeader = false;
+    while (std::getline(*_in, line)) {
+        ++_lineNumber;
+        line = trim(line);
+        if (line == "endheader") {
+            endOfHeader = true;
+            break;
+        }
+        if (line == "inDegrees=yes") _inDegrees = true;
+    }
+    OPENSIM_THROW_IF(!endOfHeader, Exception,
+        "STOFileReader: the header of file '" + fileName + "' does not end "
+        "with 'endheader'.");
+    while (std::getline(*_in, line)) {
+        ++_lineNumber;
+        line = trim(line);
+        if (!line.empty()) break;
+    }
+    // The labels are tab-delimited, but may contain spaces.
+    std::istringstream labels(line);
+    std::string label;
+    bool first = true;
+    while (std::getline(labels, label, '\t')) {
+        label = trim(label);
+        if (label.empty()) continue;
+        if (first) first = false; // time
+        else _columnLabels.push_back(label);
+    }
+    OPENSIM_THROW_IF(first, Exception,
+        "STOFileReader: file '" + fileName + "' has no column labels.");
+
+    if (prefetch) _thread = std::thread(&STOFileReader::runPrefetcher, this);
+}
+
+STOFileReader::~STOFileReader()
+{
+    if (_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+}
+
+bool STOFileReader::readBlock(Block& block)
+{
+    if (!_thread.joinable()) {
+        readRows(block);
+        return block.getNumRows() > 0;
+    }
+    std::unique_lock<std::mutex> lock{_mutex};
+    _condition.wait(lock, [this] { return _hasPending; });
+    if (_error) std::rethrow_exception(_error);
+    std::swap(block, _pending);
+    // The end of the file is reported to every later call too.
+    if (block.getNumRows() > 0) {
+        _hasPending = false;
+        _condition.notify_all();
+    }
+    return block.getNumRows() > 0;
+}
+
+void STOFileReader::readRows(Block& block)
+{
+    const size_t numColumns = getNumColumns();
+    block.times.clear();
+    block.values.clear();
+    block.times.reserve(_blockSize);
+    block.values.reserve(_blockSize*numColumns);
+    std::string line;
+    while (block.times.size() < _blockSize && std::getline(*_in, line)) {
+        ++_lineNumber;
+        const char* p = line.c_str();
+        char* end = nullptr;
+        const double time = std::strtod(p, &end);
+        if (end == p) {
+            // A blank line.
+            OPENSIM_THROW_IF(!trim(line).empty(), Exception,
+                "STOFileReader: line " + std::to_string(_lineNumber) +
+                " of file '" + _fileName + "' is not a row of numbers.");
+            continue;
+        }
+        block.times.push_back(time);
+        for (size_t c = 0; c < numColumns; ++c) {
+            p = end;
+            const double value = std::strtod(p, &end);
+            OPENSIM_THROW_IF(end == p, Exception,
+                "STOFileReader: line " + std::to_string(_lineNumber) +
+                " of file '" + _fileName + "' has " + std::to_string(c) +
+                " values; expected " + std::to_string(numColumns) + ".");
+            block.values.push_back(value);
+        }
+    }
+    OPENSIM_THROW_IF(_in->bad(), Exception,
+        "STOFileReader: could not read file '" + _fileName + "'.");
+}
+
+void STOFileReader::runPrefetcher()
+{
+    Block block;
+    while (true) {
+        try {
+            readRows(block);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _error = std::current_exception();
+            _hasPending = true;
+            _condition.notify_all();
+            return;
+        }
+        std::unique_lock<std::mutex> lock{_mutex};
+        // Wait until the previous block has been taken.
+        _condition.wait(lock, [this] { return !_hasPending || _stop; });
+        if (_stop) return;
+        std::swap(_pending, block);
+        _hasPending = true;
+        _condition.notify_all();
+        if (_pending.getNumRows() == 0) return;
+    }
+}
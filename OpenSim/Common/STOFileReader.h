@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  STOFileReader.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STO_FILE_READER_H_
+#define OPENSIM_STO_FILE_READER_H_
+
+#include "osimCommonDLL.h"
+
+#include <condition_variable>
+#include <exception>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+/** STOFileReader reads the rows of a time series of numbers from an STO (or
+MOT) file in blocks of a fixed number of rows, rather than reading the whole
+file into memory as STOFileAdapter_ and Storage do; it is the counterpart of
+STOFileWriter_. Memory use is bounded by the block size no matter how long
+the file is.
+
+If prefetch is true, the next block is read and parsed by a background
+thread while the caller processes the current one (at most one block waits
+to be taken), so that the time spent reading overlaps the processing.
+
+@code{.cpp}
+STOFileReader reader{"states.sto", 500};
+STOFileReader::Block block;
+while (reader.readBlock(block)) {
+    for (size_t r = 0; r < block.getNumRows(); ++r)
+        process(block.times[r], block.getRow(r));
+}
+@endcode
+
+Compressed files (see CompressedFile) are decompressed into memory whole
+when the reader is constructed. */
+class OSIMCOMMON_API STOFileReader {
+public:
+    /** Rows of the file: their times, and their values, row by row. */
+    struct Block {
+        std::vector<double> times;
+        std::vector<double> values;
+        size_t getNumRows() const { return times.size(); }
+        /** The values of row r (getNumColumns() of them). */
+        const double* getRow(size_t r) const {
+            return values.data() + r*(values.size()/times.size());
+        }
+    };
+
+    /** Open the file and read its header.
+    @throws Exception If the file cannot be opened, or its header does not
+                      end with "endheader" followed by the column labels. */
+    STOFileReader(const std::string& fileName, int blockSize = 1000,
+                  bool prefetch = true);
+    ~STOFileReader();
+
+    STOFileReader(const STOFileReader&)            = delete;
+    STOFileReader& operator=(const STOFileReader&) = delete;
+
+    /** Replace the contents of block with the next rows of the file (at
+    most the block size); return false, with block empty, once all rows
+    have been read.
+    @throws Exception If a row does not have one value per column, or the
+                      file cannot be read. */
+    bool readBlock(Block& block);
+
+    /** The labels of the columns, not including time. */
+    const std::vector<std::string>& getColumnLabels() const
+    {   return _columnLabels; }
+    size_t getNumColumns() const { return _columnLabels.size(); }
+    /** Whether the header says that angles are in degrees ("inDegrees=yes").
+    */
+    bool isInDegrees() const { return _inDegrees; }
+    const std::string& getFileName() const { return _fileName; }
+
+private:
+    // Read the next rows from the file, on the calling thread.
+    void readRows(Block& block);
+    void runPrefetcher();
+
+    std::string _fileName;
+    std::unique_ptr<std::istream> _in;
+    size_t _blockSize;
+    std::vector<std::string> _columnLabels;
+    bool _inDegrees{false};
+    // The line number of the next line of the file, for error messages.
+    size_t _lineNumber{0};
+
+    // Prefetching.
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    Block _pending;
+    bool _hasPending{false};
+    bool _stop{false};
+    std::exception_ptr _error;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STO_FILE_READER_H_
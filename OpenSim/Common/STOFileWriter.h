@@ -0,0 +1,299 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  STOFileWriter.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STO_FILE_WRITER_H_
+#define OPENSIM_STO_FILE_WRITER_H_
+
+#include "STOFileAdapter.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace OpenSim {
+
+/** STOFileWriter_ writes the rows of a time series to an STO file as they
+are produced (e.g., during a simulation), rather than keeping them all in
+memory and writing them at the end as STOFileAdapter_ does. The file can be
+read with STOFileAdapter_ or Storage.
+
+The rows are buffered in chunks of a fixed number of rows; each full chunk is
+written to (and flushed to) the file, so memory use is bounded no matter how
+many rows are appended, and only the rows of the chunks not yet written are
+lost if the program crashes. If flushInBackground is true, full chunks are
+written by a background thread while the next chunk fills (at most one chunk
+waits to be written, so memory use is still bounded).
+
+@code{.cpp}
+STOFileWriter writer{"states.sto", labels};
+for (...) writer.appendRow(time, row);
+writer.close();
+@endcode */
+template<typename T>
+class STOFileWriter_ : private STOFileAdapter_<T> {
+public:
+    /** Open the file and write its header (the string values of metadata,
+    as with STOFileAdapter_, and the column labels). */
+    STOFileWriter_(const std::string& fileName,
+                   const std::vector<std::string>& columnLabels,
+                   int chunkSize = 1000,
+                   bool flushInBackground = false,
+                   const AbstractDataTable::TableMetaData& metadata = {});
+
+    STOFileWriter_(const STOFileWriter_&)            = delete;
+    STOFileWriter_& operator=(const STOFileWriter_&) = delete;
+
+    /** Calls close(); errors are ignored. Call close() to find out about
+    errors. */
+    ~STOFileWriter_() {
+        try { close(); } catch(...) {}
+    }
+
+    /** Append a row. The time must be greater than that of the previous row.
+
+    \throws IncorrectNumColumns If the row does not have one element per
+                                column label.
+    \throws TimestampLessThanEqualToPrevious If the time is not greater than
+                                             that of the previous row.     */
+    void appendRow(double time, const SimTK::RowVectorBase<T>& row);
+
+    /** Write all rows appended so far to the file (waiting for the
+    background thread, if any) and flush the file.                        */
+    void flush();
+
+    /** flush() and close the file. Rows can no longer be appended.          */
+    void close();
+
+    /** Whether close() has not been called yet.                              */
+    bool isOpen() const { return _out.is_open(); }
+
+    /** The number of rows appended so far.                                   */
+    size_t getNumRows() const { return _numRows; }
+
+    /** The time of the last row appended, or -Infinity if there is none.    */
+    double getLastTime() const { return _lastTime; }
+
+    const std::string& getFileName() const { return _fileName; }
+    size_t getNumColumns() const { return _numColumns; }
+
+private:
+    struct Chunk {
+        std::vector<double> times;
+        std::vector<T> values;
+    };
+
+    // Write the rows of a chunk to the file and empty the chunk.
+    void writeChunk(Chunk& chunk);
+    // Hand the current chunk to the background thread (or write it now).
+    void writeCurrentChunk();
+    // Wait until the background thread has written the pending chunk, and
+    // rethrow any error it encountered.
+    void waitForPendingChunk(std::unique_lock<std::mutex>& lock);
+    void runBackgroundWriter();
+
+    std::string   _fileName;
+    std::ofstream _out;
+    size_t        _numColumns;
+    size_t        _chunkSize;
+    size_t        _numRows{0};
+    double        _lastTime{-SimTK::Infinity};
+
+    Chunk _current;
+    // The row being written; only used by the thread that writes chunks.
+    SimTK::RowVector_<T> _row;
+
+    // Background writing.
+    std::thread             _thread;
+    std::mutex              _mutex;
+    std::condition_variable _condition;
+    Chunk                   _pending;
+    bool                    _hasPending{false};
+    bool                    _stop{false};
+    std::exception_ptr      _error;
+};
+
+template<typename T>
+STOFileWriter_<T>::STOFileWriter_(const std::string& fileName,
+        const std::vector<std::string>& columnLabels,
+        int chunkSize,
+        bool flushInBackground,
+        const AbstractDataTable::TableMetaData& metadata) :
+        _fileName(fileName),
+        _numColumns(columnLabels.size()),
+        _chunkSize(size_t(std::max(chunkSize, 1))) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    _out.open(fileName);
+    OPENSIM_THROW_IF(!_out.good(),
+                     IOError,
+                     "Could not open file '" + fileName + "' for writing.");
+    this->writeHeader(_out, metadata, columnLabels);
+    _out.flush();
+
+    _current.times.reserve(_chunkSize);
+    _current.values.reserve(_chunkSize * _numColumns);
+    if(flushInBackground)
+        _thread = std::thread(&STOFileWriter_::runBackgroundWriter, this);
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::appendRow(double time, const SimTK::RowVectorBase<T>& row) {
+    OPENSIM_THROW_IF(!isOpen(),
+                     IOError,
+                     "File '" + _fileName + "' is closed.");
+    OPENSIM_THROW_IF(size_t(row.size()) != _numColumns,
+                     IncorrectNumColumns,
+                     _numColumns,
+                     size_t(row.size()));
+    OPENSIM_THROW_IF(time <= _lastTime,
+                     TimestampLessThanEqualToPrevious,
+                     _numRows, time, _lastTime);
+
+    _current.times.push_back(time);
+    for(int col = 0; col < row.size(); ++col)
+        _current.values.push_back(row[col]);
+    _lastTime = time;
+    ++_numRows;
+
+    if(_current.times.size() >= _chunkSize)
+        writeCurrentChunk();
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::flush() {
+    if(!isOpen())
+        return;
+    writeCurrentChunk();
+    if(_thread.joinable()) {
+        std::unique_lock<std::mutex> lock{_mutex};
+        waitForPendingChunk(lock);
+    }
+    _out.flush();
+    OPENSIM_THROW_IF(!_out,
+                     IOError,
+                     "Could not write to file '" + _fileName + "'.");
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::close() {
+    if(!isOpen())
+        return;
+    std::exception_ptr error{};
+    try {
+        flush();
+    } catch(...) {
+        error = std::current_exception();
+    }
+    if(_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+    _out.close();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::writeChunk(Chunk& chunk) {
+    _row.resize(int(_numColumns));
+    std::string text{};
+    for(size_t r = 0; r < chunk.times.size(); ++r) {
+        for(size_t col = 0; col < _numColumns; ++col)
+            _row[int(col)] = chunk.values[r * _numColumns + col];
+        this->appendRow(text, chunk.times[r], _row);
+    }
+    _out << text;
+    _out.flush();
+    chunk.times.clear();
+    chunk.values.clear();
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::writeCurrentChunk() {
+    if(_current.times.empty())
+        return;
+    if(!_thread.joinable()) {
+        writeChunk(_current);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        waitForPendingChunk(lock);
+        std::swap(_current, _pending);
+        _hasPending = true;
+    }
+    _condition.notify_all();
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::waitForPendingChunk(std::unique_lock<std::mutex>& lock) {
+    _condition.wait(lock, [this] { return !_hasPending; });
+    if(_error) {
+        std::exception_ptr error{};
+        std::swap(error, _error);
+        std::rethrow_exception(error);
+    }
+}
+
+template<typename T>
+void
+STOFileWriter_<T>::runBackgroundWriter() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    while(true) {
+        _condition.wait(lock, [this] { return _hasPending || _stop; });
+        if(!_hasPending)
+            return;
+        // The pending chunk is not touched by the appending thread until
+        // _hasPending is false, so it can be written without the lock.
+        lock.unlock();
+        try {
+            writeChunk(_pending);
+            OPENSIM_THROW_IF(!_out,
+                             IOError,
+                             "Could not write to file '" + _fileName + "'.");
+        } catch(...) {
+            lock.lock();
+            _error = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        _hasPending = false;
+        _condition.notify_all();
+    }
+}
+
+typedef STOFileWriter_<double> STOFileWriter;
+typedef STOFileWriter_<SimTK::Vec3> STOFileWriterVec3;
+
+}
+
+#endif // OPENSIM_STO_FILE_WRITER_H_
@@ -788,6 +788,12 @@ double SegmentedQuinticBezierToolkit::clampU(double u){
 double SegmentedQuinticBezierToolkit::calcU(double ax, const SimTK::Vector& bezierPtsX, 
                                  const SimTK::Spline& splineUX, double tol, 
                                  int maxIter)
+{
+    return calcU(ax, bezierPtsX, splineUX.calcValue(ax), tol, maxIter);
+}
+
+double SegmentedQuinticBezierToolkit::calcU(double ax, const SimTK::Vector& bezierPtsX, 
+                                 double uGuess, double tol, int maxIter)
 {
     //Check to make sure that ax is in the curve domain
     double minX = 1e100;
@@ -804,8 +810,7 @@ double SegmentedQuinticBezierToolkit::calcU(double ax, const SimTK::Vector& bezi
         "Error: input ax was not in the domain of the Bezier curve specified \n"
         "by the control points in bezierPtsX.");
 
-    double u = splineUX.calcValue(ax);
-    u = clampU(u);
+    double u = clampU(uGuess);
     double f = 0;
 
 
@@ -907,6 +912,24 @@ int SegmentedQuinticBezierToolkit::calcIndex(double x,
     return idx;
 }
 
+int SegmentedQuinticBezierToolkit::calcIndex(double x, 
+                                             const SimTK::Array_<SimTK::Vector>& bezierPtsX,
+                                             int hintIndex)
+{
+    int n = bezierPtsX.size();
+    //Check the hinted set and its neighbors, in which a slowly varying x
+    //will almost always be, before scanning all of the sets
+    for(int i = hintIndex; i <= hintIndex+1; i++){
+        if(i >= 0 && i < n && x >= bezierPtsX[i](0) && x < bezierPtsX[i](5))
+            return i;
+    }
+    if(hintIndex-1 >= 0 && hintIndex-1 < n
+        && x >= bezierPtsX[hintIndex-1](0) && x < bezierPtsX[hintIndex-1](5))
+        return hintIndex-1;
+
+    return calcIndex(x, bezierPtsX);
+}
+
 
 
 /*
@@ -195,6 +195,30 @@ class OSIMCOMMON_API SegmentedQuinticBezierToolkit
         static double calcU(double ax, const SimTK::Vector& bezierPtsX, 
             const SimTK::Spline& splineUX, double tol, int maxIter);
 
+        /**
+        The same as the calcU() above, except that the Newton iteration starts
+        from uGuess rather than from the splined approximation of u(x). When
+        the curve was last inverted at a nearby x (e.g., at the previous time
+        step of an integration), starting from the u found then usually
+        converges in one or two Newton steps.
+
+        @param uGuess   The initial guess for u, which is clamped to [0,1]
+        */
+        static double calcU(double ax, const SimTK::Vector& bezierPtsX, 
+            double uGuess, double tol, int maxIter);
+
+        /**
+        Where a curve set was last inverted: the index of its Bezier curve and
+        the value of u. A caller that evaluates a curve at a slowly varying x
+        can keep one of these, and pass it to calcIndex() and calcU(), to avoid
+        scanning the curve sets and to start the Newton iteration near the
+        solution. An index of -1 means that there is no hint yet.
+        */
+        struct InversionHint {
+            int index = -1;
+            double u = 0;
+        };
+
 
 
         /**
@@ -251,6 +275,14 @@ class OSIMCOMMON_API SegmentedQuinticBezierToolkit
         
         static int calcIndex(double x, const SimTK::Array_<SimTK::Vector>& bezierPtsX);
 
+        /**
+        The same as calcIndex(), except that the curve set hintIndex, and then
+        its neighbors, are checked before scanning all of the sets. If
+        hintIndex is out of range (e.g., -1), this is the same as calcIndex().
+        */
+        static int calcIndex(double x, const SimTK::Array_<SimTK::Vector>& bezierPtsX,
+                             int hintIndex);
+
 
         
         
@@ -28,7 +28,11 @@
  */
 
 // INCLUDES
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "osimCommonDLL.h"
 #include "Object.h"
 #include "ArrayPtrs.h"
@@ -66,6 +70,22 @@ PropertyObjArray<ObjectGroup> _propObjectGroups;
 ArrayPtrs<T> &_objects;
 ArrayPtrs<ObjectGroup> &_objectGroups;
 
+private:
+// The indices of the objects with each name, for getIndex(). An index is
+// never modified once built, so lookups on several threads can share it.
+struct NameIndex {
+    int version;                        // _objects.getVersion() when built.
+    unsigned long long nameGeneration;  // getNameGeneration() when built.
+    std::unordered_map<std::string, std::vector<int>> indices;
+};
+mutable std::shared_ptr<const NameIndex> _nameIndex;
+// The version and name generation seen by the last lookup that found the
+// index out of date.
+mutable std::atomic<int> _staleVersion;
+mutable std::atomic<unsigned long long> _staleNameGeneration;
+/** Sets with fewer objects are searched rather than indexed. */
+static const int MinSizeToIndex = 8;
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -139,6 +159,8 @@ setNull()
     setupProperties();
     _objects.setSize(0);
     _objectGroups.setSize(0);
+    _staleVersion = -1;
+    _staleNameGeneration = 0;
 }
 //_____________________________________________________________________________
 /**
@@ -439,7 +461,42 @@ virtual int getIndex(const T *aObject,int aStartIndex=0) const
  */
 virtual int getIndex(const std::string &aName,int aStartIndex=0) const
 {
-    return( _objects.getIndex(aName,aStartIndex) );
+    const int size = _objects.getSize();
+    if(size<MinSizeToIndex) return( _objects.getIndex(aName,aStartIndex) );
+
+    // Objects are indexed by name, and indexed again whenever the set or the
+    // name of any object has changed. Sets are often changed in bursts
+    // (e.g., while a model is built), so the objects are searched instead
+    // until two lookups in a row see the set and the names unchanged.
+    std::shared_ptr<const NameIndex> index = std::atomic_load(&_nameIndex);
+    const int version = _objects.getVersion();
+    const unsigned long long nameGeneration = getNameGeneration();
+    if(!index || index->version!=version ||
+            index->nameGeneration!=nameGeneration) {
+        const bool sameVersion = _staleVersion.exchange(version)==version;
+        const bool sameNames =
+            _staleNameGeneration.exchange(nameGeneration)==nameGeneration;
+        if(!sameVersion || !sameNames)
+            return( _objects.getIndex(aName,aStartIndex) );
+        std::shared_ptr<NameIndex> newIndex(new NameIndex());
+        newIndex->version = version;
+        newIndex->nameGeneration = nameGeneration;
+        newIndex->indices.reserve(size);
+        for(int i=0;i<size;i++) {
+            if(_objects[i]!=NULL)
+                newIndex->indices[_objects[i]->getName()].push_back(i);
+        }
+        index = newIndex;
+        std::atomic_store(&_nameIndex, index);
+    }
+
+    const auto found = index->indices.find(aName);
+    if(found==index->indices.end()) return(-1);
+    // The first object with the name at or following aStartIndex, if any.
+    const std::vector<int>& indices = found->second;
+    if(aStartIndex<0 || aStartIndex>=size) aStartIndex = 0;
+    for(int i : indices) if(i>=aStartIndex) return(i);
+    return(indices.front());
 }
 //_____________________________________________________________________________
 /**
@@ -668,12 +725,17 @@ virtual T& get(int aIndex) const
  */
 T& get(const std::string &aName)
 {
-    return( *_objects.get(aName) );
+    const int index = getIndex(aName);
+    // ArrayPtrs::get() throws if there is no such object.
+    if(index==-1) return( *_objects.get(aName) );
+    return( *_objects[index] );
 }
 #ifndef SWIG
 const T& get(const std::string &aName) const
 {
-    return( *_objects.get(aName) );
+    const int index = getIndex(aName);
+    if(index==-1) return( *_objects.get(aName) );
+    return( *_objects[index] );
 }
 #endif
 //_____________________________________________________________________________
@@ -685,7 +747,7 @@ const T& get(const std::string &aName) const
  */
 bool contains(const std::string &aName) const
 {
-    return( _objects.getIndex(aName) != -1 );
+    return( getIndex(aName) != -1 );
 }//_____________________________________________________________________________
 /**
  * Get names of objects in the set.
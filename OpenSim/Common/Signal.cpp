@@ -28,6 +28,8 @@
 
 // INCLUDES
 #include <math.h>
+#include <algorithm>
+#include <vector>
 #include "Signal.h"
 #include "Array.h"
 #include "SimTKcommon/Constants.h"
@@ -142,6 +144,40 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
 // IIR
 //-----------------------------------------------------------------------------
 //_____________________________________________________________________________
+/**
+ * Apply the 3rd order IIR filter with coefficients a and b, once, to n
+ * signals of N samples each, stored sample by sample (sample i of signal j
+ * is x[i*n+j]).  The first three samples of each signal are copied.  The
+ * innermost loop is over the signals, so that it can be vectorized.
+ */
+static void
+ApplyIIR(const double a[4],const double b[4],int N,size_t n,
+         const double *x,double *y)
+{
+    for(size_t k=0;k<4*n;k++) y[k] = x[k];
+    for(int i=3;i<N;i++) {
+        const double *x0 = x+i*n, *x1 = x0-n, *x2 = x1-n, *x3 = x2-n;
+        double *y0 = y+i*n;
+        const double *y1 = y0-n, *y2 = y1-n, *y3 = y2-n;
+        for(size_t j=0;j<n;j++) {
+            y0[j] = a[0]*x0[j] + a[1]*x1[j] +  a[2]*x2[j] +  a[3]*x3[j]
+                               - b[1]*y1[j] - b[2]*y2[j] - b[3]*y3[j];
+        }
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Reverse the order of the samples of n signals of N samples each, stored
+ * sample by sample.
+ */
+static void
+ReverseSamples(int N,size_t n,const double *x,double *y)
+{
+    for(int i=0,j=N-1;i<N;i++,j--) {
+        for(size_t k=0;k<n;k++) y[i*n+k] = x[j*n+k];
+    }
+}
+//_____________________________________________________________________________
 /**
  * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER
  *
@@ -159,14 +195,38 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
 int Signal::
 LowpassIIR(double T,double fc,int N,double *sig,double *sigf)
 {
-int i,j;
+    return(LowpassIIR(T,fc,N,1,sig,sigf));
+}
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER OF SEVERAL SIGNALS
+ *
+ * Filters numSignals signals sampled at the same times at once.  The
+ * signals are stored sample by sample: sample i of signal j is
+ * sig[i*numSignals+j] (as are the rows of a Storage).  Each filtered signal
+ * is the same as that computed by filtering the signal alone, but filtering
+ * many signals at once is faster.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal.
+ *  @param numSignals Number of signals.
+ *  @param sig The sampled signals (N*numSignals values).
+ *  @param sigf The filtered signals (N*numSignals values).
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int numSignals,const double *sig,
+           double *sigf)
+{
 double fs/*,ws*/,wc,wa,wa2,wa3;
 double a[4],b[4],denom;
-double *sigr;
 
     // ERROR CHECK
     if(T==0) return(-1);
-    if(N==0) return(-1);
+    if(N<4) return(-1);
+    if(numSignals<=0) return(-1);
     if(sig==NULL) return(-1);
     if(sigf==NULL) return(-1);
 
@@ -199,43 +259,14 @@ double *sigr;
     b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
     b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
 
-    // ALLOCATE MEMORY FOR sigr[]
-    sigr = new double[N];
-    if(sigr==NULL) {
-        printf("\nSignal.lowpassIIR: ERROR- Not enough memory.\n");
-        return(-1);
-    }
-
-    // FILTER THE DATA
-    // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sig[i];
-
-    // IMPLEMENT THE FORMULA
-    for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sig[i] + a[1]*sig[i-1] +  a[2]*sig[i-2] +  a[3]*sig[i-3]
-                            - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
-    }
-
-    // REVERSE THE FILTERED ARRAY
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
-
-    // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sigr[i];
-
-    // IMPLEMENT THE FORMULA AGAIN
-    for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sigr[i] + a[1]*sigr[i-1] +  a[2]*sigr[i-2] +  a[3]*sigr[i-3]
-                             - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
-    }
-
-    // REVERSE THE FILTERED ARRAY AGAIN
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
-
-    // ASSIGN sigf TO sigr
-    for (i=0;i<N;i++)  sigf[i] = sigr[i];
-
-    // CLEANUP
-    if(sigr!=NULL)  delete[] sigr;
+    // FILTER FORWARD, THEN BACKWARD
+    const size_t n = static_cast<size_t>(numSignals);
+    std::vector<double> sigr(static_cast<size_t>(N)*n);
+    ApplyIIR(a,b,N,n,sig,sigf);
+    ReverseSamples(N,n,sigf,sigr.data());
+    ApplyIIR(a,b,N,n,sigr.data(),sigf);
+    ReverseSamples(N,n,sigf,sigr.data());
+    std::copy(sigr.begin(),sigr.end(),sigf);
 
   return(0);
 }
@@ -279,18 +310,23 @@ LowpassFIR(int M,double T,double f,int N,double *sig,double *sigf)
     // CALCULATE THE ANGULAR CUTOFF FREQUENCY
     w = 2.0*SimTK_PI*f;
 
+    // COMPUTE THE FILTER COEFFICIENTS
+    // They are the same for every data point, so they are computed once.
+    std::vector<double> coefs(2*M+1);
+    double sum_coef = 0.0;
+    for(k=-M;k<=M;k++) {
+        x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
+        coefs[M+k] = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
+        sum_coef = sum_coef + coefs[M+k];
+    }
+
     // FILTER THE DATA
-    double sum_coef,coef;
     for(n=0;n<N;n++) {
-        sum_coef = 0.0;
-        sigf[n] = 0.0;
-        for(k=-M;k<=M;k++) {   
-            x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
-            coef = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
-            sigf[n] = sigf[n] + coef*s[M+n-k]; 
-            sum_coef = sum_coef + coef;
+        double sum = 0.0;
+        for(k=-M;k<=M;k++) {
+            sum = sum + coefs[M+k]*s[M+n-k];
         }
-        sigf[n] = sigf[n] / sum_coef; // normalize for unity gain at DC
+        sigf[n] = sum / sum_coef; // normalize for unity gain at DC
     }
 
     // Filter check derived from http://www.dspguide.com/CH16.PDF
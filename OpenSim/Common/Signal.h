@@ -65,6 +65,10 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,const double *aSignals,
+        double *rFilteredSignals);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
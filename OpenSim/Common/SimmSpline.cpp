@@ -509,6 +509,11 @@ int SimmSpline::addPoint(double aX, double aY)
 }
 
 double SimmSpline::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double SimmSpline::calcValue(double aX) const
 {
     // NOT A NUMBER
     if(!_y.getSize()) return(SimTK::NaN);
@@ -516,11 +521,10 @@ double SimmSpline::calcValue(const Vector& x) const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
-    double aX = x[0];
 
    /* Check if the abscissa is out of range of the function. If it is,
     * then use the slope of the function at the appropriate end point to
@@ -546,30 +550,7 @@ double SimmSpline::calcValue(const Vector& x) const
    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
        return _y[n-1];
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+    k = findInterval(aX);
 
    dx = aX - _x[k];
    return _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
@@ -583,7 +564,7 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
@@ -636,30 +617,7 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
          return 2.0*_c[n-1];
    }
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+    k = findInterval(aX);
 
    dx = aX - _x[k];
 
@@ -670,6 +628,70 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
       return (2.0*_c[k] + 6.0*dx*_d[k]);
 }
 
+SimTK::Vec3 SimmSpline::calcValueAndDerivatives(double aX) const
+{
+    // NOT A NUMBER
+    if(!_y.getSize() || !_b.getSize() || !_c.getSize() || !_d.getSize())
+        return SimTK::Vec3(SimTK::NaN);
+
+    const int n = _x.getSize();
+
+    // Extrapolate linearly out of range, as calcValue() does.
+    if (aX < _x[0])
+        return SimTK::Vec3(_y[0] + (aX - _x[0])*_b[0], _b[0], 0);
+    else if (aX > _x[n-1])
+        return SimTK::Vec3(_y[n-1] + (aX - _x[n-1])*_b[n-1], _b[n-1], 0);
+
+    if (EQUAL_WITHIN_ERROR(aX,_x[0]))
+        return SimTK::Vec3(_y[0], _b[0], 2.0*_c[0]);
+    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
+        return SimTK::Vec3(_y[n-1], _b[n-1], 2.0*_c[n-1]);
+
+    const int k = findInterval(aX);
+    const double dx = aX - _x[k];
+    return SimTK::Vec3(_y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k])),
+                       _b[k] + dx*(2.0*_c[k] + 3.0*dx*_d[k]),
+                       2.0*_c[k] + 6.0*dx*_d[k]);
+}
+
+//_____________________________________________________________________________
+/**
+ * Find the interval [x_k, x_k+1] of the knots that contains an abscissa,
+ * which must be within the range of the knots. The interval found last, or
+ * one of its neighbors, is checked first, since the arguments of consecutive
+ * evaluations are usually close; otherwise a binary search is done. The
+ * interval found last is only a hint, which is checked on every use, so the
+ * spline can be evaluated concurrently.
+ */
+int SimmSpline::findInterval(double aX) const
+{
+    const int n = _x.getSize();
+    if (n < 3) return 0;
+
+    const int hint = _lastInterval.load(std::memory_order_relaxed);
+    for (int k : {hint, hint + 1, hint - 1}) {
+        if (k >= 0 && k < n - 1 && _x[k] <= aX && aX <= _x[k+1]) {
+            if (k != hint) _lastInterval.store(k, std::memory_order_relaxed);
+            return k;
+        }
+    }
+
+    /* Do a binary search to find which two points the abscissa is between. */
+    int i = 0, j = n, k;
+    while (1)
+    {
+        k = (i+j)/2;
+        if (aX < _x[k])
+            j = k;
+        else if (aX > _x[k+1])
+            i = k;
+        else
+            break;
+    }
+    _lastInterval.store(k, std::memory_order_relaxed);
+    return k;
+}
+
 int SimmSpline::getArgumentSize() const
 {
     return 1;
@@ -26,6 +26,7 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <atomic>
 #include <string>
 #include "Array.h"
 #include "PropertyDblArray.h"
@@ -68,6 +69,8 @@ private:
     Array<double> _b;
     Array<double> _c;
     Array<double> _d;
+    // The interval of the last evaluation; see findInterval().
+    mutable std::atomic<int> _lastInterval{0};
 
 //=============================================================================
 // METHODS
@@ -119,6 +122,11 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
+    double calcValue(double aX) const override;
+    /** The value and the first and second derivatives of the spline at aX,
+    found together (with a single search for the interval of aX); each is as
+    calcValue() and calcDerivative() would return. */
+    SimTK::Vec3 calcValueAndDerivatives(double aX) const;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
@@ -128,6 +136,7 @@ public:
 
 private:
     void calcCoefficients();
+    int findInterval(double aX) const;
 //=============================================================================
 };  // END class SimmSpline
 
@@ -24,7 +24,15 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
 #include "simmath/internal/SplineFitter.h"
 
 //=============================================================================
@@ -39,6 +47,94 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+
+namespace {
+    // The splines fit by the SmoothSegmentedFunction constructor, keyed by
+    // the arguments of the constructor (see makePrecomputedKey()).
+    struct PrecomputedSplines {
+        SimTK::Array_<SimTK::Spline> splineUX;
+        bool hasIntegral = false;
+        SimTK::Spline splineYintX;
+    };
+
+    std::mutex precomputedMutex;
+    std::map<std::string, PrecomputedSplines> precomputedSplines;
+
+    // Start over if a process constructs an unusually large number of
+    // distinct curves (e.g., while optimizing curve parameters).
+    const std::size_t MAX_PRECOMPUTED_CURVES = 10000;
+
+    // Whether (and with which tolerance) new curves are tabulated.
+    std::atomic<bool> tabulateByDefault{false};
+    std::atomic<double> defaultTabulationTolerance{1e-9};
+
+    // The most grid intervals a tabulated Bezier section may need.
+    const int MAX_TABULATED_INTERVALS = 8192;
+
+    // "SSFP" followed by the version of the binary layout.
+    const std::uint32_t PRECOMPUTED_MAGIC = 0x53534650;
+    const std::uint32_t PRECOMPUTED_VERSION = 1;
+
+    void appendBytes(std::string& key, const void* data, std::size_t size) {
+        key.append(static_cast<const char*>(data), size);
+    }
+
+    void appendMatrix(std::string& key, const SimTK::Matrix& m) {
+        const int dims[2] = {m.nrow(), m.ncol()};
+        appendBytes(key, dims, sizeof(dims));
+        for (int j = 0; j < m.ncol(); ++j)
+            for (int i = 0; i < m.nrow(); ++i) {
+                const double value = m(i, j);
+                appendBytes(key, &value, sizeof(value));
+            }
+    }
+
+    std::string makePrecomputedKey(const SimTK::Matrix& mX,
+            const SimTK::Matrix& mY, const double (&ends)[6],
+            bool computeIntegral, bool intx0x1, const std::string& name) {
+        std::string key;
+        appendMatrix(key, mX);
+        appendMatrix(key, mY);
+        appendBytes(key, ends, sizeof(ends));
+        const char flags[2] = {char(computeIntegral), char(intx0x1)};
+        appendBytes(key, flags, sizeof(flags));
+        key.append(name);
+        return key;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return bool(in);
+    }
+
+    void writeSpline(std::ostream& out, const SimTK::Spline& spline) {
+        const SimTK::Vector& x = spline.getControlPointLocations();
+        const SimTK::Vector& y = spline.getControlPointValues();
+        writeValue(out, std::int32_t(spline.getSplineDegree()));
+        writeValue(out, std::int32_t(x.size()));
+        for (int i = 0; i < x.size(); ++i) writeValue(out, x[i]);
+        for (int i = 0; i < y.size(); ++i) writeValue(out, y[i]);
+    }
+
+    // The spline is rebuilt by interpolating its control points, which
+    // reproduces the (unsmoothed) spline fit by the constructor.
+    bool readSpline(std::istream& in, SimTK::Spline& spline) {
+        std::int32_t degree, size;
+        if (!readValue(in, degree) || !readValue(in, size) || size < 0)
+            return false;
+        SimTK::Vector x(size), y(size);
+        for (int i = 0; i < size; ++i) if (!readValue(in, x[i])) return false;
+        for (int i = 0; i < size; ++i) if (!readValue(in, y[i])) return false;
+        spline = SimTK::Spline(degree, x, y);
+        return true;
+    }
+}
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -90,6 +186,15 @@ static int NUM_SAMPLE_PTS = 100;
 
         N.B. These costs are dependent on SegmentedQuinticBezierToolkit
 */
+struct SmoothSegmentedFunction::IntegralSpline {
+    // The key of the precomputed splines of the curve, which are updated
+    // once the integral is computed.
+    std::string key;
+    std::mutex mutex;
+    std::atomic<bool> isComputed{false};
+    SimTK::Spline spline;
+};
+
 SmoothSegmentedFunction::
   SmoothSegmentedFunction(const SimTK::Matrix& mX, const SimTK::Matrix& mY,  
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
@@ -101,58 +206,56 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
 
     _numBezierSections = mX.ncol();
 
-    //////////////////////////////////////////////////
-    //Generate the set of splines that approximate u(x)
-    //////////////////////////////////////////////////
-    SimTK::Vector u(NUM_SAMPLE_PTS); //Used for the approximate inverse
-    SimTK::Vector x(NUM_SAMPLE_PTS); //Used for the approximate inverse
-
-    //Used to generate the set of knot points of the integral of y(x)    
-   SimTK::Vector xALL(NUM_SAMPLE_PTS*_numBezierSections-(_numBezierSections-1));
-    _arraySplineUX.resize(_numBezierSections);
-    int xidx = 0;
-
-    for(int s=0; s < _numBezierSections; s++){
-        //Sample the local set for u and x
-        for(int i=0;i<NUM_SAMPLE_PTS;i++){
-            u(i) = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
-            x(i) = SegmentedQuinticBezierToolkit::
-                calcQuinticBezierCurveVal(u(i),mX(s));            
-            if(_numBezierSections > 1){
-                //Skip the last point of a set that has another set of points
-                //after it. Why? The last point and the starting point of the
-                //next set are identical in value.
-                if(i<(NUM_SAMPLE_PTS-1) || s == (_numBezierSections-1)){
-                    xALL(xidx) = x(i);
-                    xidx++;
-                }
-            }else{
-                xALL(xidx) = x(i);                
-                xidx++;
+    const double ends[6] = {x0, x1, y0, y1, dydx0, dydx1};
+    const std::string key = makePrecomputedKey(mX, mY, ends,
+            computeIntegral, intx0x1, name);
+    if(_computeIntegral){
+        _integral = std::make_shared<IntegralSpline>();
+        _integral->key = key;
+    }
+    bool isPrecomputed = false;
+    {
+        std::lock_guard<std::mutex> lock(precomputedMutex);
+        const auto it = precomputedSplines.find(key);
+        if (it != precomputedSplines.end()) {
+            _arraySplineUX = it->second.splineUX;
+            if (_integral && it->second.hasIntegral) {
+                _integral->spline = it->second.splineYintX;
+                _integral->isComputed.store(true);
             }
+            isPrecomputed = true;
         }
-        //Create the array of approximate inverses for u(x)    
-        _arraySplineUX[s] = SimTK::SplineFitter<Real>::
-            fitForSmoothingParameter(3,x,u,0).getSpline();
     }
 
-    if(_computeIntegral){
+    if(!isPrecomputed){
         //////////////////////////////////////////////////
-        //Compute the integral of y(x) and spline the result    
+        //Generate the set of splines that approximate u(x)
         //////////////////////////////////////////////////
+        SimTK::Vector u(NUM_SAMPLE_PTS); //Used for the approximate inverse
+        SimTK::Vector x(NUM_SAMPLE_PTS); //Used for the approximate inverse
 
-        SimTK::Matrix yInt =  SegmentedQuinticBezierToolkit::
-            calcNumIntBezierYfcnX(xALL,0,INTTOL, UTOL, MAXITER,mX, mY,
-            _arraySplineUX,_intx0x1,_name);
+        _arraySplineUX.resize(_numBezierSections);
 
-        //not correct
-        //if(_intx0x1==false){
-        //    yInt = yInt*-1;
-        //    yInt = yInt - yInt(yInt.nelt()-1);
-        //}
+        for(int s=0; s < _numBezierSections; s++){
+            //Sample the local set for u and x
+            for(int i=0;i<NUM_SAMPLE_PTS;i++){
+                u(i) = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
+                x(i) = SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveVal(u(i),mX(s));            
+            }
+            //Create the array of approximate inverses for u(x)    
+            _arraySplineUX[s] = SimTK::SplineFitter<Real>::
+                fitForSmoothingParameter(3,x,u,0).getSpline();
+        }
 
-        _splineYintX = SimTK::SplineFitter<Real>::
-                fitForSmoothingParameter(3,yInt(0),yInt(1),0).getSpline();
+        // The integral, if any, is computed when it is first needed (see
+        // getIntegralSpline()), since most curves are never integrated.
+        std::lock_guard<std::mutex> lock(precomputedMutex);
+        if (precomputedSplines.size() >= MAX_PRECOMPUTED_CURVES)
+            precomputedSplines.clear();
+        PrecomputedSplines& data = precomputedSplines[key];
+        data.splineUX = _arraySplineUX;
+        data.hasIntegral = false;
     }
     
     _mXVec.resize(_numBezierSections);
@@ -161,6 +264,9 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
         _mXVec[s] = mX(s); 
         _mYVec[s] = mY(s); 
     }
+
+    if(tabulateByDefault.load())
+        enableTabulatedEvaluation(defaultTabulationTolerance.load());
 }
 
  SmoothSegmentedFunction::SmoothSegmentedFunction():
@@ -171,11 +277,237 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
         _mYVec.resize(0);
-        _splineYintX = SimTK::Spline();
         _numBezierSections = (int)SimTK::NaN;
        
  }
 
+//=============================================================================
+// TABULATED EVALUATION
+//=============================================================================
+bool SmoothSegmentedFunction::enableTabulatedEvaluation(double tolerance)
+{
+    disableTabulatedEvaluation();
+    if(!(tolerance > 0) || _numBezierSections <= 0) return false;
+
+    std::vector<TabulatedSection> sections(_numBezierSections);
+    for(int s=0; s < _numBezierSections; s++){
+        // The interpolation error shrinks with the sixth power of the grid
+        // spacing, so few refinements are needed.
+        int numIntervals = 16;
+        while(tabulateSection(s, numIntervals, sections[s]) > tolerance){
+            if(numIntervals >= MAX_TABULATED_INTERVALS) return false;
+            numIntervals *= 2;
+        }
+    }
+    _tabulatedSections.swap(sections);
+    return true;
+}
+
+void SmoothSegmentedFunction::disableTabulatedEvaluation()
+{
+    std::vector<TabulatedSection>().swap(_tabulatedSections);
+}
+
+int SmoothSegmentedFunction::getNumTabulatedIntervals() const
+{
+    int numIntervals = 0;
+    for(const auto& section : _tabulatedSections)
+        numIntervals += section.numIntervals;
+    return numIntervals;
+}
+
+size_t SmoothSegmentedFunction::estimateMemoryUsage() const
+{
+    size_t bytes = 0;
+    for (const auto& x : _mXVec) bytes += size_t(x.size()) * sizeof(double);
+    for (const auto& y : _mYVec) bytes += size_t(y.size()) * sizeof(double);
+    const auto splineBytes = [](const SimTK::Spline& spline) {
+        return 3 * size_t(spline.getControlPointLocations().size()) *
+               sizeof(double);
+    };
+    for (const auto& spline : _arraySplineUX) bytes += splineBytes(spline);
+    if (_integral && _integral->isComputed)
+        bytes += splineBytes(_integral->spline);
+    for (const auto& section : _tabulatedSections)
+        bytes += section.coefficients.capacity() * sizeof(double);
+    return bytes;
+}
+
+void SmoothSegmentedFunction::setTabulatedEvaluationByDefault(bool enabled,
+                                                              double tolerance)
+{
+    defaultTabulationTolerance.store(tolerance);
+    tabulateByDefault.store(enabled);
+}
+
+bool SmoothSegmentedFunction::isTabulatedEvaluationEnabledByDefault()
+{
+    return tabulateByDefault.load();
+}
+
+double SmoothSegmentedFunction::tabulateSection(int s, int numIntervals,
+                                                TabulatedSection& section) const
+{
+    const SimTK::Vector& xPts = _mXVec[s];
+    const SimTK::Vector& yPts = _mYVec[s];
+    section.xBegin = xPts(0);
+    section.xEnd = xPts(5);
+    section.numIntervals = numIntervals;
+    const double h = (section.xEnd - section.xBegin)/numIntervals;
+    section.invH = h > 0 ? 1/h : 0;
+
+    // The exact value and first two derivatives of the curve at x.
+    auto calcExact = [&](double x, SimTK::Vec3& d) {
+        double u = SegmentedQuinticBezierToolkit::
+                calcU(x, xPts, _arraySplineUX[s], UTOL, MAXITER);
+        d[0] = SegmentedQuinticBezierToolkit::calcQuinticBezierCurveVal(u, yPts);
+        d[1] = SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u, xPts, yPts, 1);
+        d[2] = SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u, xPts, yPts, 2);
+    };
+
+    // Derivatives with respect to t are those with respect to x times h.
+    section.coefficients.resize(6*numIntervals);
+    SimTK::Vec3 d0, d1;
+    calcExact(section.xBegin, d0);
+    for(int k=0; k < numIntervals; k++){
+        calcExact(k+1 == numIntervals ? section.xEnd
+                                      : section.xBegin + (k+1)*h, d1);
+        const double a = d0[0], b = d0[1]*h, c = d0[2]*h*h;
+        const double r0 = d1[0] - (a + b + c/2);
+        const double r1 = d1[1]*h - (b + c);
+        const double r2 = d1[2]*h*h - c;
+        double* coef = &section.coefficients[6*k];
+        coef[0] = a;
+        coef[1] = b;
+        coef[2] = c/2;
+        coef[3] = 10*r0 - 4*r1 + r2/2;
+        coef[4] = -15*r0 + 7*r1 - r2;
+        coef[5] = 6*r0 - 3*r1 + r2/2;
+        d0 = d1;
+    }
+
+    // Check the table between the grid points.
+    double maxError = 0;
+    SimTK::Vec3 exact;
+    for(int k=0; k < numIntervals; k++){
+        for(double t : {0.25, 0.5, 0.75}){
+            const double x = section.xBegin + (k+t)*h;
+            calcExact(x, exact);
+            const double* coef = &section.coefficients[6*k];
+            const double y = coef[0] + t*(coef[1] + t*(coef[2]
+                           + t*(coef[3] + t*(coef[4] + t*coef[5]))));
+            const double dydt = coef[1] + t*(2*coef[2] + t*(3*coef[3]
+                              + t*(4*coef[4] + t*5*coef[5])));
+            maxError = std::max(maxError, std::abs(y - exact[0]));
+            maxError = std::max(maxError,
+                                std::abs(dydt*section.invH - exact[1]));
+        }
+    }
+    return SimTK::isNaN(maxError) ? SimTK::Infinity : maxError;
+}
+
+double SmoothSegmentedFunction::calcTabulated(double x, int order) const
+{
+    // The sections are ordered by x; there are at most a handful of them.
+    std::size_t s = 0;
+    while(s+1 < _tabulatedSections.size() && x > _tabulatedSections[s].xEnd)
+        ++s;
+    const TabulatedSection& section = _tabulatedSections[s];
+
+    const double position = (x - section.xBegin)*section.invH;
+    int k = int(position);
+    if(k < 0) k = 0;
+    if(k >= section.numIntervals) k = section.numIntervals - 1;
+    const double t = position - k;
+    const double* c = &section.coefficients[6*k];
+
+    switch(order){
+        case 0:
+            return c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+        case 1:
+            return (c[1] + t*(2*c[2] + t*(3*c[3] + t*(4*c[4] + t*5*c[5]))))
+                   *section.invH;
+        default:
+            return (2*c[2] + t*(6*c[3] + t*(12*c[4] + t*20*c[5])))
+                   *section.invH*section.invH;
+    }
+}
+
+//=============================================================================
+// PRECOMPUTED SPLINE DATA
+//=============================================================================
+void SmoothSegmentedFunction::writePrecomputedData(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock(precomputedMutex);
+    // The magic number also identifies the byte order of the writer.
+    writeValue(out, PRECOMPUTED_MAGIC);
+    writeValue(out, PRECOMPUTED_VERSION);
+    writeValue(out, std::uint32_t(sizeof(double)));
+    writeValue(out, std::uint64_t(precomputedSplines.size()));
+    for (const auto& it : precomputedSplines) {
+        writeValue(out, std::uint64_t(it.first.size()));
+        out.write(it.first.data(), it.first.size());
+        writeValue(out, std::int32_t(it.second.splineUX.size()));
+        for (const auto& spline : it.second.splineUX)
+            writeSpline(out, spline);
+        writeValue(out, char(it.second.hasIntegral));
+        if (it.second.hasIntegral) writeSpline(out, it.second.splineYintX);
+    }
+}
+
+bool SmoothSegmentedFunction::readPrecomputedData(std::istream& in)
+{
+    std::uint32_t magic, version, doubleSize;
+    std::uint64_t numCurves;
+    if (!readValue(in, magic) || magic != PRECOMPUTED_MAGIC ||
+            !readValue(in, version) || version != PRECOMPUTED_VERSION ||
+            !readValue(in, doubleSize) || doubleSize != sizeof(double) ||
+            !readValue(in, numCurves))
+        return false;
+
+    // Only use the data if all of it could be read.
+    std::map<std::string, PrecomputedSplines> curves;
+    for (std::uint64_t c = 0; c < numCurves; ++c) {
+        std::uint64_t keySize;
+        if (!readValue(in, keySize)) return false;
+        std::string key(keySize, '\0');
+        if (!in.read(&key[0], keySize)) return false;
+
+        PrecomputedSplines data;
+        std::int32_t numSplines;
+        if (!readValue(in, numSplines) || numSplines < 0) return false;
+        data.splineUX.resize(numSplines);
+        for (auto& spline : data.splineUX)
+            if (!readSpline(in, spline)) return false;
+        char hasIntegral;
+        if (!readValue(in, hasIntegral)) return false;
+        data.hasIntegral = hasIntegral != 0;
+        if (data.hasIntegral && !readSpline(in, data.splineYintX))
+            return false;
+        curves[key] = data;
+    }
+
+    std::lock_guard<std::mutex> lock(precomputedMutex);
+    if (precomputedSplines.size() + curves.size() > MAX_PRECOMPUTED_CURVES)
+        precomputedSplines.clear();
+    for (auto& it : curves) precomputedSplines[it.first] = it.second;
+    return true;
+}
+
+void SmoothSegmentedFunction::clearPrecomputedData()
+{
+    std::lock_guard<std::mutex> lock(precomputedMutex);
+    precomputedSplines.clear();
+}
+
+int SmoothSegmentedFunction::getNumPrecomputedCurves()
+{
+    std::lock_guard<std::mutex> lock(precomputedMutex);
+    return int(precomputedSplines.size());
+}
+
  /*Detailed Computational Costs
  ________________________________________________________________________
     If x is in the Bezier Curve
@@ -200,7 +532,10 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_tabulatedSections.empty())
+    {
+        yVal = calcTabulated(x,0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -218,6 +553,35 @@ double SmoothSegmentedFunction::calcValue(double x) const
     return yVal;
 }
 
+double SmoothSegmentedFunction::calcValue(double x,
+        SegmentedQuinticBezierToolkit::InversionHint& hint) const
+{
+    if(x >= _x0 && x <= _x1 && _tabulatedSections.empty()){
+        int idx = 0;
+        double u = calcU(x, idx, hint);
+        return SegmentedQuinticBezierToolkit::
+                 calcQuinticBezierCurveVal(u,_mYVec[idx]);
+    }
+    return calcValue(x);
+}
+
+double SmoothSegmentedFunction::calcU(double x, int& idx,
+        SegmentedQuinticBezierToolkit::InversionHint& hint) const
+{
+    idx = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec,hint.index);
+    double u = 0;
+    if(idx == hint.index){
+        u = SegmentedQuinticBezierToolkit::
+                calcU(x,_mXVec[idx], hint.u, UTOL,MAXITER);
+    }else{
+        u = SegmentedQuinticBezierToolkit::
+                calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
+    }
+    hint.index = idx;
+    hint.u = u;
+    return u;
+}
+
 double SmoothSegmentedFunction::calcValue(const SimTK::Vector& ax) const
 {
     
@@ -269,7 +633,10 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(order <= 2 && x >= _x0 && x <= _x1 &&
+               !_tabulatedSections.empty()){
+                yVal = calcTabulated(x,order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -296,6 +663,21 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+double SmoothSegmentedFunction::calcDerivative(double x, int order,
+        SegmentedQuinticBezierToolkit::InversionHint& hint) const
+{
+    if(order == 0) return calcValue(x, hint);
+    const bool isTabulated = order <= 2 && !_tabulatedSections.empty();
+    if(x >= _x0 && x <= _x1 && !isTabulated){
+        int idx = 0;
+        double u = calcU(x, idx, hint);
+        return SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], 
+                    _mYVec[idx], order);
+    }
+    return calcDerivative(x, order);
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
@@ -351,15 +733,17 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
         "%s: This curve was not constructed with its integral because"
         "computeIntegral was false",_name.c_str());
 
+    const SimTK::Spline& splineYintX = getIntegralSpline();
+
     double yVal = 0;    
     if(x >= _x0 && x <= _x1){
-        yVal = _splineYintX.calcValue(SimTK::Vector(1,x));
+        yVal = splineYintX.calcValue(SimTK::Vector(1,x));
     }else{
         //LINEAR EXTRAPOLATION         
         if(x < _x0){
             SimTK::Vector tmp(1);
             tmp(0) = _x0;
-            double ic = _splineYintX.calcValue(tmp);
+            double ic = splineYintX.calcValue(tmp);
             if(_intx0x1){//Integrating left to right
                 yVal = _y0*(x-_x0) 
                     + _dydx0*(x-_x0)*(x-_x0)*0.5 
@@ -372,7 +756,7 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
         }else{
             SimTK::Vector tmp(1);
             tmp(0) = _x1;
-            double ic = _splineYintX.calcValue(tmp);
+            double ic = splineYintX.calcValue(tmp);
             if(_intx0x1){
                 yVal = _y1*(x-_x1) 
                     + _dydx1*(x-_x1)*(x-_x1)*0.5 
@@ -398,6 +782,114 @@ bool SmoothSegmentedFunction::isIntegralComputedLeftToRight() const
     return _intx0x1;
 }
 
+void SmoothSegmentedFunction::computeIntegralNow() const
+{
+    if(_computeIntegral) getIntegralSpline();
+}
+
+bool SmoothSegmentedFunction::isIntegralComputed() const
+{
+    return _integral && _integral->isComputed.load();
+}
+
+void SmoothSegmentedFunction::computeIntegrals(
+        const std::vector<const SmoothSegmentedFunction*>& curves,
+        int numThreads)
+{
+    std::vector<const SmoothSegmentedFunction*> pending;
+    for(const SmoothSegmentedFunction* curve : curves)
+        if(curve && curve->isIntegralAvailable()
+                 && !curve->isIntegralComputed())
+            pending.push_back(curve);
+    const int numCurves = int(pending.size());
+    if(numCurves == 0) return;
+
+    if(numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, numCurves));
+
+    std::vector<std::exception_ptr> errors(numBlocks);
+    auto computeBlock = [&](int block) {
+        try {
+            const int first = numCurves*block/numBlocks;
+            const int last = numCurves*(block+1)/numBlocks;
+            for(int i=first; i<last; i++) pending[i]->computeIntegralNow();
+        } catch(...) {
+            errors[block] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int block=1; block<numBlocks; block++) {
+        try {
+            threads.emplace_back(computeBlock, block);
+        } catch(const std::system_error&) {
+            // Could not start a thread; compute this block here instead.
+            computeBlock(block);
+        }
+    }
+    computeBlock(0);
+    for(auto& thread : threads) thread.join();
+
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+}
+
+const SimTK::Spline& SmoothSegmentedFunction::getIntegralSpline() const
+{
+    IntegralSpline& integral = *_integral;
+    if(!integral.isComputed.load(std::memory_order_acquire)){
+        std::lock_guard<std::mutex> lock(integral.mutex);
+        if(!integral.isComputed.load(std::memory_order_relaxed)){
+            integral.spline = fitIntegralSpline();
+            integral.isComputed.store(true, std::memory_order_release);
+
+            // Keep the integral with the precomputed splines of this curve,
+            // so that identical curves constructed later do not refit it.
+            std::lock_guard<std::mutex> precomputedLock(precomputedMutex);
+            const auto it = precomputedSplines.find(integral.key);
+            if (it != precomputedSplines.end()) {
+                it->second.hasIntegral = true;
+                it->second.splineYintX = integral.spline;
+            }
+        }
+    }
+    return integral.spline;
+}
+
+SimTK::Spline SmoothSegmentedFunction::fitIntegralSpline() const
+{
+    const int numControlPoints = _mXVec[0].size();
+    SimTK::Matrix mX(numControlPoints, _numBezierSections);
+    SimTK::Matrix mY(numControlPoints, _numBezierSections);
+
+    //Used to generate the set of knot points of the integral of y(x)    
+    SimTK::Vector xALL(
+        NUM_SAMPLE_PTS*_numBezierSections-(_numBezierSections-1));
+    int xidx = 0;
+
+    for(int s=0; s < _numBezierSections; s++){
+        mX(s) = _mXVec[s];
+        mY(s) = _mYVec[s];
+        for(int i=0;i<NUM_SAMPLE_PTS;i++){
+            //Skip the last point of a set that has another set of points
+            //after it. Why? The last point and the starting point of the
+            //next set are identical in value.
+            if(i<(NUM_SAMPLE_PTS-1) || s == (_numBezierSections-1)){
+                const double u = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
+                xALL(xidx) = SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveVal(u,mX(s));
+                xidx++;
+            }
+        }
+    }
+
+    SimTK::Matrix yInt =  SegmentedQuinticBezierToolkit::
+        calcNumIntBezierYfcnX(xALL,0,INTTOL, UTOL, MAXITER,mX, mY,
+        _arraySplineUX,_intx0x1,_name);
+
+    return SimTK::SplineFitter<Real>::
+            fitForSmoothingParameter(3,yInt(0),yInt(1),0).getSpline();
+}
+
 int SmoothSegmentedFunction::getArgumentSize() const
 {
     return 1;
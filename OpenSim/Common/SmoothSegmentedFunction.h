@@ -25,6 +25,9 @@
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
 
+#include <memory>
+#include <vector>
+
 namespace OpenSim { 
 
     /**
@@ -122,6 +125,22 @@ namespace OpenSim {
        */
        double calcDerivative(double x, int order) const;       
 
+#ifndef SWIG
+       /**The same as calcValue(double) and calcDerivative(double, int),
+       except that the Bezier curve and parameter u found for the previous x
+       are used as the starting point for inverting x(u), and are updated.
+       Evaluating a curve at a slowly varying x (e.g., the fiber length of a
+       muscle during an integration) with a hint that is kept by the caller
+       usually takes one or two Newton iterations rather than several, and
+       avoids scanning the Bezier curves for the one that contains x. The
+       results are the same as without the hint, to within the tolerance of
+       the inversion. A hint must not be shared by threads.*/
+       double calcValue(double x,
+               SegmentedQuinticBezierToolkit::InversionHint& hint) const;
+       double calcDerivative(double x, int order,
+               SegmentedQuinticBezierToolkit::InversionHint& hint) const;
+#endif
+
 #ifndef SWIG
        /// Allow the more general calcDerivative from the base class to be used.
        // This helps avoid the -Woverloaded-virtual warning with Clang.
@@ -142,11 +161,11 @@ namespace OpenSim {
        @return the value of the functions integral evaluated at x
 
        The integral is approximate, though its errors are small.
-       The integral is computed by numerically integrating the function when
-       the constructor for this class is called (if computeIntegral is true) and 
-       then splining the result, thus the regions between the knot points may
-       have some error in them. A very fine mesh of points is used to create the
-       spline so the errors will be small
+       The integral is computed by numerically integrating the function the
+       first time it is needed (if computeIntegral is true; see also
+       computeIntegralNow()) and then splining the result, thus the regions
+       between the knot points may have some error in them. A very fine mesh of
+       points is used to create the spline so the errors will be small
 
        <B>Computational Costs</B>
        \verbatim
@@ -158,13 +177,37 @@ namespace OpenSim {
        double calcIntegral(double x) const;
        
        /**
-        Returns a bool that indicates if the integral curve has been computed.
+        Returns a bool that indicates if the integral curve can be evaluated.
 
         @return true if the integral of this function is available, false if
-                it has not been computed.
+                the curve was constructed without it.
        */
        bool isIntegralAvailable() const;
 
+       /**
+       Compute the integral of this curve now, rather than the first time
+       calcIntegral() is called. Copies of this curve share the computed
+       integral. This does nothing if the integral is not available or
+       already computed, and is safe to call from multiple threads.
+       */
+       void computeIntegralNow() const;
+
+       /** Returns true if the integral is available and already computed. */
+       bool isIntegralComputed() const;
+
+#ifndef SWIG
+       /**
+       Call computeIntegralNow() on each of the provided curves, using up to
+       numThreads threads (the number of hardware threads if numThreads is 0
+       or negative). This is useful when loading a model whose curves are
+       known to need their integrals (e.g., to compute muscle energy), since
+       the integrals of different curves are independent.
+       */
+       static void computeIntegrals(
+               const std::vector<const SmoothSegmentedFunction*>& curves,
+               int numThreads = 0);
+#endif
+
        /**
        Returns a bool that indicates if the integral computed is computed left
        to right, or right to left.
@@ -306,12 +349,92 @@ namespace OpenSim {
                                             double domainMax) const;
        ///@endcond
 
+       /** @name Precomputed spline data
+       Fitting the splines that approximate u(x), and computing the integral
+       of the curve, is by far the most expensive part of constructing a
+       SmoothSegmentedFunction. These splines are therefore kept, keyed by the
+       complete definition of the curve (Bezier control points, end points,
+       integral flags and name), so that each distinct curve is fit only once
+       per process. The data can also be written to and read from a binary
+       stream, which is how a precompiled model file (see
+       Model::writePrecompiledFile()) avoids refitting the curves of a model.*/
+       /// @{
+
+       /** Write the precomputed splines of all curves constructed (or read)
+       so far in this process to a binary stream. */
+       static void writePrecomputedData(std::ostream& out);
+
+       /** Read precomputed splines written by writePrecomputedData() and make
+       them available to curves constructed afterwards. Returns false (and
+       reads no data) if the stream was not written by this version of
+       writePrecomputedData() on a machine with the same binary layout. */
+       static bool readPrecomputedData(std::istream& in);
+
+       /** Forget all precomputed splines. Curves that already exist are not
+       affected. */
+       static void clearPrecomputedData();
+
+       /** The number of distinct curves whose splines are precomputed. */
+       static int getNumPrecomputedCurves();
+       /// @}
+
+       /** @name Tabulated evaluation
+       By default, evaluating the curve within its domain finds the Bezier
+       parameter u of x with Newton iterations. If tabulated evaluation is
+       enabled, calcValue() and the first and second derivatives from
+       calcDerivative() instead evaluate a piecewise quintic Hermite
+       interpolant of the curve, tabulated on a uniform grid in each Bezier
+       section. This takes a constant number of operations and no iterations.
+       The interpolant matches the value and the first two derivatives of the
+       curve at the grid points, so it is C2 continuous wherever the curve
+       is. The grid is refined until the errors in the value and in the first
+       derivative, checked between all grid points, are within the requested
+       tolerance. Higher derivatives, the integral, and the linear
+       extrapolation outside the domain are always evaluated exactly.*/
+       /// @{
+
+       /** Tabulate this curve, and use the table for evaluation.
+       @param tolerance Bound on the error in the value and first derivative
+                        of the curve.
+       @returns false (and leaves tabulated evaluation disabled) if the
+                tolerance could not be met with at most 8192 grid intervals
+                per Bezier section. */
+       bool enableTabulatedEvaluation(double tolerance = 1e-9);
+
+       /** Evaluate this curve exactly again, and free its table. */
+       void disableTabulatedEvaluation();
+
+       bool isTabulatedEvaluationEnabled() const
+       {   return !_tabulatedSections.empty(); }
+
+       /** The total number of grid intervals of the table; 0 if tabulated
+       evaluation is disabled. */
+       int getNumTabulatedIntervals() const;
+
+       /** An estimate of the bytes held by this curve: its Bezier control
+       points, the knots, values and coefficients of its splines (and of its
+       integral, once computed), and its table. The splines are shared with
+       the copies of this curve and with the precomputed data (see
+       writePrecomputedData()), but are counted here for each curve. */
+       size_t estimateMemoryUsage() const;
+
+       /** Whether curves created by SmoothSegmentedFunctionFactory from now on
+       (e.g., when a muscle builds its curves) enable tabulated evaluation with
+       the provided tolerance. This is off by default. */
+       static void setTabulatedEvaluationByDefault(bool enabled,
+                                                   double tolerance = 1e-9);
+       static bool isTabulatedEvaluationEnabledByDefault();
+       /// @}
+
     private:
        
         /**Array of spline fit functions X(u) for each Bezier elbow*/
         SimTK::Array_<SimTK::Spline> _arraySplineUX;        
-        /**Spline fit of the integral of the curve y(x)*/
-        SimTK::Spline _splineYintX;
+        /**Spline fit of the integral of the curve y(x), which is only
+        computed when it is first needed, and is shared by copies of this
+        curve. Null if the curve has no integral.*/
+        struct IntegralSpline;
+        std::shared_ptr<IntegralSpline> _integral;
         
         /**Bezier X1,...,Xn control point locations. Control points are 
         stored in 6x1 vectors in the order above*/
@@ -344,6 +467,37 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**The piecewise quintic Hermite table of one Bezier section: the
+        coefficients c0..c5 of the polynomial in t = (x-xBegin)/h - k on each
+        interval k*/
+        struct TabulatedSection {
+            double xBegin;
+            double xEnd;
+            double invH;
+            int numIntervals;
+            std::vector<double> coefficients;
+        };
+        /**The tables of the Bezier sections; empty unless tabulated
+        evaluation is enabled*/
+        std::vector<TabulatedSection> _tabulatedSections;
+
+        /**Find the Bezier curve idx and parameter u of x (within the
+        domain), starting from the hint, which is updated*/
+        double calcU(double x, int& idx,
+                SegmentedQuinticBezierToolkit::InversionHint& hint) const;
+
+        /**The spline of the integral, which is computed if necessary*/
+        const SimTK::Spline& getIntegralSpline() const;
+        /**Numerically integrate the curve and spline the result*/
+        SimTK::Spline fitIntegralSpline() const;
+
+        /**Evaluate the table at x (within the domain) for order 0, 1 or 2*/
+        double calcTabulated(double x, int order) const;
+        /**Tabulate section s with numIntervals intervals, and return the
+        largest error in the value or first derivative between grid points*/
+        double tabulateSection(int s, int numIntervals,
+                               TabulatedSection& section) const;
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
@@ -387,8 +541,9 @@ namespace OpenSim {
                          as x0.
 
        @param computeIntegral  If this is true, the integral is numerically
-                               calculated and splined. If false, this integral
-                               is not computed, and a call to .calcIntegral will
+                               calculated and splined the first time it is
+                               needed. If false, this integral is not
+                               computed, and a call to .calcIntegral will
                                throw an exception
 
        @param intx0x1       If this is true, the integral of the curve will be
@@ -400,8 +555,8 @@ namespace OpenSim {
        @param name          The name of the data this SmoothSegmentedFunction 
 
        <B>Computational Costs</B>
-       Generating the integral curve is not cheap, and so should only be used 
-       when if it will be evaluated during a simulation. 
+       Generating the integral curve is not cheap, and so it is deferred until
+       the integral is first evaluated (or computeIntegralNow() is called).
        \verbatim     
         Computational Cost Per Bezier Section:
             Without Integral :   4,100 flops
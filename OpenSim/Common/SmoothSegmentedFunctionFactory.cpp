@@ -25,6 +25,9 @@
 //=============================================================================
 
 #include "SmoothSegmentedFunctionFactory.h"
+
+#include <map>
+#include <mutex>
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -32,6 +35,25 @@ using namespace SimTK;
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+    // The curves handed out by getSharedCurve(), keyed by their type and
+    // parameters. Only weak references are kept, so that curves no longer
+    // used by anyone are freed.
+    std::mutex sharedCurvesMutex;
+    std::map<std::string, std::weak_ptr<const SmoothSegmentedFunction>>
+        sharedCurves;
+
+    std::string makeSharedCurveKey(const std::string& curveType,
+                                   const std::vector<double>& parameters) {
+        std::string key = curveType;
+        key.push_back('\0');
+        if (!parameters.empty())
+            key.append(reinterpret_cast<const char*>(parameters.data()),
+                       parameters.size()*sizeof(double));
+        return key;
+    }
+}
+
 
 //static int NUM_SAMPLE_PTS = 100; //The number of knot points to use to sample
                                 //each Bezier corner section
@@ -699,3 +721,45 @@ SmoothSegmentedFunction* SmoothSegmentedFunctionFactory::
 }
 
 
+
+//=============================================================================
+// SHARED CURVES
+//=============================================================================
+std::shared_ptr<const SmoothSegmentedFunction> SmoothSegmentedFunctionFactory::
+    getSharedCurve(const std::string& curveType,
+                   const std::vector<double>& parameters,
+                   const std::function<SmoothSegmentedFunction*()>& createCurve)
+{
+    const std::string key = makeSharedCurveKey(curveType, parameters);
+    {
+        std::lock_guard<std::mutex> lock(sharedCurvesMutex);
+        auto it = sharedCurves.find(key);
+        if (it != sharedCurves.end()) {
+            if (auto curve = it->second.lock()) return curve;
+        }
+    }
+
+    // Building a curve is expensive, so it is done without holding the lock;
+    // if another thread built the same curve meanwhile, its curve is used.
+    std::shared_ptr<const SmoothSegmentedFunction> curve(createCurve());
+
+    std::lock_guard<std::mutex> lock(sharedCurvesMutex);
+    auto& shared = sharedCurves[key];
+    if (auto existing = shared.lock()) return existing;
+    shared = curve;
+    // Forget the curves that are no longer in use.
+    for (auto it = sharedCurves.begin(); it != sharedCurves.end();) {
+        if (it->second.expired()) it = sharedCurves.erase(it);
+        else ++it;
+    }
+    return curve;
+}
+
+int SmoothSegmentedFunctionFactory::getNumSharedCurves()
+{
+    std::lock_guard<std::mutex> lock(sharedCurvesMutex);
+    int numCurves = 0;
+    for (const auto& it : sharedCurves)
+        if (!it.second.expired()) ++numCurves;
+    return numCurves;
+}
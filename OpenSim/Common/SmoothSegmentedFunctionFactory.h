@@ -25,6 +25,11 @@
 #include "osimCommonDLL.h"
 #include "SmoothSegmentedFunction.h"
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace OpenSim {
 
 /**
@@ -768,7 +773,33 @@ class OSIMCOMMON_API SmoothSegmentedFunctionFactory
                                         bool computeIntegral, 
                                         const std::string& curveName);
 
-        
+        /**
+        Get a curve that is shared, process-wide, by all callers asking for the
+        same type of curve with the same parameters, rather than building a
+        separate copy of the curve (and its integral) for each of them. This
+        is how the muscle curves (e.g., ActiveForceLengthCurve) share the
+        SmoothSegmentedFunctions of muscles, and of copies of models, that
+        have identical curve parameters. It is safe to call from multiple
+        threads.
+
+        @param curveType   Identifies how the curve is created, e.g., the name
+                           of the class that creates it.
+        @param parameters  All of the values the curve is created from.
+        @param createCurve Creates the curve with new, if no curve of this type
+                           with these parameters is in use. The name given
+                           to the curve should not identify any single user.
+        @return The curve, which must not be modified. It is deleted when its
+                last user releases it.
+        */
+#ifndef SWIG
+        static std::shared_ptr<const SmoothSegmentedFunction> getSharedCurve(
+            const std::string& curveType,
+            const std::vector<double>& parameters,
+            const std::function<SmoothSegmentedFunction*()>& createCurve);
+#endif
+
+        /** The number of distinct shared curves that are currently in use. */
+        static int getNumSharedCurves();
 
     private:
         /**
@@ -0,0 +1,85 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  SolverStatistics.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SolverStatistics.h"
+#include "STOFileAdapter.h"
+
+using namespace OpenSim;
+
+namespace {
+enum Column { WallTime, Iterations, FunctionEvaluations, Converged };
+}
+
+SolverStatistics::SolverStatistics()
+{
+    clear();
+}
+
+void SolverStatistics::append(double time, double wallTime, int iterations,
+                              int functionEvaluations, bool converged)
+{
+    const size_t numRows = _table.getNumRows();
+    if (numRows > 0 && time <= _table.getIndependentColumn().back()) {
+        auto row = _table.updRowAtIndex(numRows - 1);
+        row[WallTime] += wallTime;
+        row[Iterations] += iterations;
+        row[FunctionEvaluations] += functionEvaluations;
+        if (!converged) row[Converged] = 0;
+        return;
+    }
+    SimTK::RowVector row(4);
+    row[WallTime] = wallTime;
+    row[Iterations] = iterations;
+    row[FunctionEvaluations] = functionEvaluations;
+    row[Converged] = converged ? 1 : 0;
+    _table.appendRow(time, row);
+}
+
+std::vector<std::string> SolverStatistics::getColumnLabels()
+{
+    return {"wall_time", "iterations", "function_evaluations", "converged"};
+}
+
+void SolverStatistics::clear()
+{
+    _table = TimeSeriesTable();
+    _table.setColumnLabels(getColumnLabels());
+}
+
+double SolverStatistics::getTotalWallTime() const
+{
+    return _table.getNumRows() > 0 ?
+            SimTK::sum(_table.getDependentColumnAtIndex(WallTime)) : 0;
+}
+
+int SolverStatistics::getNumFramesNotConverged() const
+{
+    int numNotConverged = 0;
+    for (size_t i = 0; i < _table.getNumRows(); ++i)
+        if (_table.getRowAtIndex(i)[Converged] == 0) ++numNotConverged;
+    return numNotConverged;
+}
+
+void SolverStatistics::print(const std::string& fileName) const
+{
+    STOFileAdapter_<double>::write(_table, fileName);
+}
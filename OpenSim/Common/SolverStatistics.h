@@ -0,0 +1,104 @@
+#ifndef OPENSIM_SOLVER_STATISTICS_H_
+#define OPENSIM_SOLVER_STATISTICS_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  SolverStatistics.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "TimeSeriesTable.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** The cost of each frame solved by a tool (e.g., InverseKinematicsTool,
+InverseDynamicsTool, StaticOptimization, CMCTool), as a TimeSeriesTable
+with one row per frame and the columns:
+
+- `wall_time`: wall-clock time spent solving the frame, in seconds;
+- `iterations`: iterations of the solver (0 for a direct solution);
+- `function_evaluations`: evaluations of the solver's objective, constraints
+  and their derivatives;
+- `converged`: 1 if the solver converged, 0 otherwise.
+
+A frame appended at (or before) the time of the last frame, e.g., a repeated
+solve of the initial time, is added to the last frame: its times, iterations
+and evaluations are summed, and it converged only if both solves did.
+
+@code{.cpp}
+SolverStatistics statistics;
+for (...) {
+    SolverStatistics::Timer timer;
+    solver.track(s);
+    statistics.append(s.getTime(), timer.getElapsedTime(),
+                      solver.getNumIterationsInLastSolve(), ...);
+}
+statistics.print("trial_solver_statistics.sto");
+@endcode */
+class OSIMCOMMON_API SolverStatistics {
+public:
+    SolverStatistics();
+
+    /** Measures wall-clock time from its construction. */
+    class Timer {
+    public:
+        Timer() : _start(std::chrono::steady_clock::now()) {}
+        /** Seconds elapsed since construction. */
+        double getElapsedTime() const {
+            return std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - _start).count();
+        }
+    private:
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /** Record the solution of the frame at the given time. */
+    void append(double time, double wallTime, int iterations,
+                int functionEvaluations, bool converged);
+
+    /** The labels of the columns described above, for tools that report
+    the same quantities in a Storage. */
+    static std::vector<std::string> getColumnLabels();
+
+    /** Remove all frames. */
+    void clear();
+
+    int getNumFrames() const { return int(_table.getNumRows()); }
+    /** Sum of the wall times of all frames, in seconds. */
+    double getTotalWallTime() const;
+    /** Number of frames that did not converge. */
+    int getNumFramesNotConverged() const;
+
+    /** The table of frames, with the columns described above. */
+    const TimeSeriesTable& getTable() const { return _table; }
+
+    /** Write the table to a .sto file. */
+    void print(const std::string& fileName) const;
+
+private:
+    TimeSeriesTable _table;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_SOLVER_STATISTICS_H_
@@ -28,6 +28,12 @@
 
 // INCLUDES
 #include <iostream>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "IO.h"
 #include "Signal.h"
 #include "Storage.h"
@@ -37,7 +43,11 @@
 #include "GCVSpline.h"
 #include "StateVector.h"
 #include "STOFileAdapter.h"
+#include "BinaryFileAdapter.h"
+#include "CompressedFile.h"
 #include "TimeSeriesTable.h"
+#include "Tracer.h"
+#include "TrajectoryCompressor.h"
 
 using namespace OpenSim;
 using namespace std;
@@ -50,13 +60,92 @@ void convertTableToStorage(const TimeSeriesTable& table, Storage& sto) {
         labels[i + 1] = table.getColumnLabel(i);
     }
     sto.setColumnLabels(labels);
+    // Copy each row straight from the table's matrix into the Storage.
     const auto& times = table.getIndependentColumn();
-    for (unsigned i_time = 0; i_time < table.getNumRows(); ++i_time) {
-        auto rowView = table.getRowAtIndex(i_time);
-        sto.append(times[i_time], SimTK::Vector(rowView.transpose()));
+    const auto& matrix = table.getMatrix();
+    const int numColumns = (int)table.getNumColumns();
+    std::vector<double> row(numColumns);
+    for (int i_time = 0; i_time < (int)table.getNumRows(); ++i_time) {
+        for (int j = 0; j < numColumns; ++j)
+            row[j] = matrix(i_time, j);
+        sto.append(times[i_time], numColumns, row.data());
     }
 }            
 
+// The file that Storage::print() writes rows to. Rows are formatted in blocks
+// and written with write(). A compressed file (e.g., .sto.gz) is written
+// through a compressing stream; its header, which is written with fprintf()
+// to header(), goes through a temporary file first.
+class StorageOutput {
+public:
+    StorageOutput(const std::string& fileName,const std::string& mode) {
+        if(!CompressedFile::isCompressedFileName(fileName)) {
+            _fp = IO::OpenFile(fileName,mode);
+            return;
+        }
+        _stream = CompressedFile::openForWriting(fileName,mode=="a");
+        if(!*_stream) {
+            cout << "Storage: failed to open " << fileName << endl;
+            return;
+        }
+        _fp = tmpfile();
+    }
+    ~StorageOutput() { if(_fp!=NULL) fclose(_fp); }
+    bool isOpen() const { return _fp!=NULL; }
+    FILE* header() { return _fp; }
+    bool write(const std::string& text) {
+        if(_stream) {
+            copyHeader();
+            _stream->write(text.data(),text.size());
+            return static_cast<bool>(*_stream);
+        }
+        return fwrite(text.data(),1,text.size(),_fp)==text.size();
+    }
+    bool close() {
+        bool ok = true;
+        if(_stream) {
+            copyHeader();
+            ok = static_cast<bool>(_stream->flush());
+        }
+        if(_fp!=NULL) { ok = fclose(_fp)==0 && ok; _fp = NULL; }
+        return ok;
+    }
+private:
+    // Move what was written to the temporary file to the compressed stream.
+    void copyHeader() {
+        if(_fp==NULL) return;
+        rewind(_fp);
+        char buffer[4096];
+        size_t n;
+        while((n = fread(buffer,1,sizeof(buffer),_fp))>0)
+            _stream->write(buffer,n);
+        fclose(_fp);
+        _fp = NULL;
+    }
+    FILE* _fp = NULL;
+    std::unique_ptr<std::ostream> _stream;
+};
+
+// Append a row, as StateVector::print() writes it, to text.
+static void appendStateVector(std::string& text,const char* format,
+                              const StateVector& vec) {
+    IO::AppendDouble(text,format,vec.getTime());
+    const Array<double>& data = vec.getData();
+    for(int j=0;j<data.getSize();j++) {
+        text += '\t';
+        IO::AppendDouble(text,format,data[j]);
+    }
+    text += '\n';
+}
+
+// Whether a file is written or read through the BinaryFileAdapter.
+static bool isBinaryFileName(const std::string& fileName) {
+    const std::string extension{".bsto"};
+    return fileName.size() > extension.size() &&
+           fileName.compare(fileName.size() - extension.size(),
+                            extension.size(), extension) == 0;
+}
+
 
 //============================================================================
 // DEFINES
@@ -123,9 +212,33 @@ Storage::Storage(int aCapacity,const string &aName) :
     setName(aName);
 }
 //_____________________________________________________________________________
+/**
+ * Construct a Storage from the rows of a TimeSeriesTable.
+ */
+Storage::Storage(const TimeSeriesTable& table) :
+    Storage(std::max(1, (int)table.getNumRows()))
+{
+    copyFromTable(table);
+}
+//_____________________________________________________________________________
+/**
+ * Copy the rows, name and degrees flag of a table.
+ */
+void Storage::copyFromTable(const TimeSeriesTable& table)
+{
+    convertTableToStorage(table, *this);
+    const auto& metadata = table.getTableMetaData();
+    if(metadata.hasKey("header"))
+        setName(table.getTableMetaData<std::string>("header"));
+    if(metadata.hasKey("inDegrees"))
+        setInDegrees(table.getTableMetaData<std::string>("inDegrees") == "yes");
+}
+//_____________________________________________________________________________
 /**
  * Construct an Storage instance from file.
- * This constructor is far from bullet proof.
+ * This constructor is far from bullet proof. Files with the extension ".bsto"
+ * are read as binary files (see BinaryFileAdapter_), and files with the
+ * extension ".gz" (e.g., ".mot.gz") are decompressed (see CompressedFile).
  *
  * @param aFileName Name of the file from which the Storage is to be
  * constructed.
@@ -134,18 +247,38 @@ Storage::Storage(const string &aFileName, bool readHeadersOnly) :
     StorageInterface(aFileName),
     _storage(StateVector())
 {
+    OPENSIM_TRACE_SPAN("io", "read storage", aFileName);
+
     // SET NULL STATES
     setNull();
 
+    // BINARY FILES
+    if(isBinaryFileName(aFileName)) {
+        OPENSIM_THROW_IF(readHeadersOnly, Exception,
+                "Cannot read headers only of a binary file.");
+        TimeSeriesTable table = BinaryFileAdapter::read(aFileName);
+        copyFromTable(table);
+        return;
+    }
+
     // OPEN FILE
-    std::unique_ptr<ifstream> fp{IO::OpenInputFile(aFileName)};
+    // Compressed files (e.g., .mot.gz) are decompressed.
+    std::unique_ptr<istream> fp;
+    if(CompressedFile::isCompressedFileName(aFileName)) {
+        fp = CompressedFile::openForReading(aFileName);
+        if(!*fp) fp.reset();
+    } else {
+        fp.reset(IO::OpenInputFile(aFileName));
+    }
     if(fp==NULL) throw Exception("Storage: ERROR- failed to open file " + aFileName, __FILE__,__LINE__);
+    const string uncompressedName =
+            CompressedFile::removeCompressionExtension(aFileName);
 
     int nr=0,nc=0;
     if (!parseHeaders(*fp, nr, nc)) throw Exception("Storage: ERROR- failed to parse headers of file " + aFileName, __FILE__,__LINE__);
     cout << "Storage: file=" << aFileName << " (nr=" << nr << " nc=" << nc << ")" << endl;
     // Motion files from SIMM are in degrees
-    if (_fileVersion < 1 && (0 == aFileName.compare (aFileName.length() - 4, 4, ".mot"))) _inDegrees = true;
+    if (_fileVersion < 1 && (0 == uncompressedName.compare (uncompressedName.length() - 4, 4, ".mot"))) _inDegrees = true;
     if (_fileVersion < 1) cout << ".. assuming rotations in " << (_inDegrees?"Degrees.":"Radians.") << endl;
     if(_fileVersion > 1) {
         OPENSIM_THROW_IF(readHeadersOnly, Exception, 
@@ -217,7 +350,7 @@ Storage::Storage(const string &aFileName, bool readHeadersOnly) :
     // to account for different assumptions between SIMM.mot OpenSim.sto
 
     //MM if this is a SIMM Motion file, post process it as one. Else don't touch the data
-    size_t found = aFileName.find(".mot");
+    size_t found = uncompressedName.find(".mot");
     if(indexTime == -1 && found!=string::npos){
         postProcessSIMMMotion();
     }
@@ -300,6 +433,7 @@ Storage(const Storage &aStorage,int aStateIndex,int aN,
         for(int i=0;i<aN && aStateIndex+1+i<originalNumCol;i++) 
             _columnLabels.append(aStorage.getColumnLabels()[aStateIndex+1+i]);
     }
+    indexColumnLabels();
 }
 
 
@@ -444,7 +578,7 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
     // This uses the `do while(false)` idiom to run common code if one of a
     // number of conditions succeeds (much like what a goto would be used for).
     do {
-        thisColumnIndex = _columnLabels.findIndex(aColumnName);
+        thisColumnIndex = findColumnLabel(aColumnName);
         if (thisColumnIndex != -1) break;
 
         // Assume column labels follow pre-v4.0 state variable labeling.
@@ -455,7 +589,7 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
         std::string prefix = aColumnName.substr(0, back);
         std::string shortName = aColumnName.substr(back + 1,
                                                    aColumnName.length() - back);
-        thisColumnIndex = _columnLabels.findIndex(shortName);
+        thisColumnIndex = findColumnLabel(shortName);
         if (thisColumnIndex != -1) break;
 
         // If that didn't work, specifically check for coordinate state names
@@ -465,14 +599,14 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
             // pre-v4.0 did not have "/value" so remove it if here
             back = prefix.rfind("/");
             shortName = prefix.substr(back + 1, prefix.length());
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
         else if (shortName == "speed") {
             // replace "/speed" (the v4.0 labeling for speeds) with "_u"
             back = prefix.rfind("/");
             shortName =
                     prefix.substr(back + 1, prefix.length() - back) + "_u";
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
         else if (back < aColumnName.length()) {
             // try replacing the '/' with '.' in the last segment
@@ -481,7 +615,7 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
             back = shortName.rfind("/");
             shortName = shortName.substr(back + 1,
                                          shortName.length() - back);
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
         if (thisColumnIndex != -1) break;
 
@@ -519,6 +653,7 @@ void Storage::
 parseColumnLabels(const char *aLabels)
 {
     _columnLabels.setSize(0);
+    _columnLabelIndex.clear();
 
     // HANDLE NULL POINTER
     if(aLabels==NULL) return;
@@ -549,6 +684,7 @@ parseColumnLabels(const char *aLabels)
     }
 
     delete[] labelsCopy;
+    indexColumnLabels();
 }
 
 //_____________________________________________________________________________
@@ -559,6 +695,7 @@ void Storage::
 setColumnLabels(const Array<std::string> &aColumnLabels)
 {
     _columnLabels = aColumnLabels;
+    indexColumnLabels();
 }
 
 //_____________________________________________________________________________
@@ -573,6 +710,45 @@ getColumnLabels() const
     return(_columnLabels);
 }
 
+void Storage::extendEstimateMemoryUsage(MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    size_t bytes = size_t(_storage.getCapacity()) * sizeof(StateVector);
+    for (int i = 0; i < _storage.getSize(); ++i) {
+        bytes += size_t(_storage[i].getData().getCapacity()) *
+                 sizeof(double);
+    }
+    bytes += size_t(_columnLabels.getCapacity()) * sizeof(std::string);
+    for (int i = 0; i < _columnLabels.getSize(); ++i)
+        bytes += _columnLabels[i].capacity();
+    usage.add(MemoryUsage::Storages, bytes);
+}
+
+//_____________________________________________________________________________
+/**
+ * Index the column labels by label, so that columns can be found by label in
+ * constant time. Models and storages with hundreds of states (e.g., in
+ * Model::formStateStorage()) would otherwise search the labels once per
+ * state.
+ */
+void Storage::
+indexColumnLabels()
+{
+    _columnLabelIndex.clear();
+    _columnLabelIndex.reserve(_columnLabels.getSize());
+    // emplace() keeps the first of duplicated labels, as findIndex() does.
+    for(int i=0;i<_columnLabels.getSize();i++)
+        _columnLabelIndex.emplace(_columnLabels[i], i);
+}
+
+int Storage::
+findColumnLabel(const std::string& aLabel) const
+{
+    const auto it = _columnLabelIndex.find(aLabel);
+    if(it==_columnLabelIndex.end()) return -1;
+    return it->second;
+}
+
 //-----------------------------------------------------------------------------
 // STEP INTERVAL
 //-----------------------------------------------------------------------------
@@ -1305,16 +1481,29 @@ TimeSeriesTable Storage::exportToTable() const {
     // in TimeSeriesTable and column label is optional.
     table.setColumnLabels(_columnLabels.get() + 1, 
                           _columnLabels.get() + _columnLabels.getSize());
-
-    for(int i = 0; i < _storage.getSize(); ++i) {
+    const int numRows = _storage.getSize();
+    if(numRows == 0)
+        return table;
+
+    // Copy the data straight into a matrix (rather than appending the rows
+    // one at a time), and build the table from it.
+    const std::vector<std::string> labels(_columnLabels.get() + 1,
+                           _columnLabels.get() + _columnLabels.getSize());
+    const int numColumns = (int)labels.size();
+    std::vector<double> times(numRows);
+    SimTK::Matrix data(numRows, numColumns);
+    for(int i = 0; i < numRows; ++i) {
         const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
-        // Exclude the first column. It is 'time'. Time is a separate column in
-        // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
+        OPENSIM_THROW_IF(row.getSize() != numColumns,
+                         IncorrectNumColumns,
+                         (size_t)numColumns, (size_t)row.getSize());
+        times[i] = getStateVector(i)->getTime();
+        for(int j = 0; j < numColumns; ++j)
+            data(i, j) = row[j];
     }
-
-    return table;
+    TimeSeriesTable filled{times, data, labels};
+    filled.updTableMetaData() = table.getTableMetaData();
+    return filled;
 }
 
 
@@ -1388,6 +1577,32 @@ crop(const double newStartTime, const double newFinalTime)
     _storage.setSize(numRowsToKeep);
 }
 
+//_____________________________________________________________________________
+/**
+ * Remove the rows that linear interpolation between the kept rows reproduces
+ * within a tolerance.
+ */
+void Storage::
+compress(double tolerance)
+{
+    TrajectoryCompressor compressor(tolerance);
+    // The rows are kept in order, so they are moved up as they are kept.
+    int numKept = 0;
+    int index = 0;
+    auto keep = [&](double time, const double*) {
+        while (_storage[index].getTime() != time) ++index;
+        if (index != numKept) _storage[numKept] = _storage[index];
+        ++numKept;
+    };
+    for (int i = 0; i < _storage.getSize(); ++i) {
+        StateVector& row = _storage[i];
+        compressor.append(row.getTime(), row.getData().get(),
+                          row.getSize(), keep);
+    }
+    compressor.finish(keep);
+    _storage.setSize(numKept);
+}
+
 //=============================================================================
 // STORAGE
 //=============================================================================
@@ -1543,6 +1758,29 @@ scaleTime(double aValue)
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Apply op(data, values, n) to the data of each row and the first n values
+ * of aStorage at the time of the row, linearly interpolated, where n is the
+ * smaller of the numbers of states. The values are interpolated into one
+ * buffer (the times of the rows increase, so aStorage is searched from the
+ * row found last), and op works on the contiguous data of the row.
+ */
+template <typename Op>
+static void
+combineRows(Array<StateVector>& rows,const Storage& aStorage,Op op)
+{
+    std::vector<double> values;
+    for(int i=0;i<rows.getSize();i++) {
+        StateVector& row = rows[i];
+        if(row.getSize()<=0) continue;
+        values.resize(row.getSize());
+        int n = aStorage.getDataAtTime(row.getTime(),row.getSize(),
+                                       values.data());
+        op(row.getData().get(),values.data(),n);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // ADD
 //-----------------------------------------------------------------------------
@@ -1618,26 +1856,10 @@ add(Storage *aStorage)
 {
     if(aStorage==NULL) return;
 
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // ADD
-        _storage[i].add(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineRows(_storage, *aStorage,
+        [](double* data, const double* values, int n) {
+            for(int k=0;k<n;k++) data[k] += values[k];
+        });
 }
 
 //-----------------------------------------------------------------------------
@@ -1700,26 +1922,10 @@ subtract(Storage *aStorage)
 {
     if(aStorage==NULL) return;
 
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // SUBTRACT
-        _storage[i].subtract(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineRows(_storage, *aStorage,
+        [](double* data, const double* values, int n) {
+            for(int k=0;k<n;k++) data[k] -= values[k];
+        });
 }
 
 //-----------------------------------------------------------------------------
@@ -1783,26 +1989,10 @@ multiply(Storage *aStorage)
 {
     if(aStorage==NULL) return;
 
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(int i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // MULTIPLY
-        _storage[i].multiply(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    combineRows(_storage, *aStorage,
+        [](double* data, const double* values, int n) {
+            for(int k=0;k<n;k++) data[k] *= values[k];
+        });
 }
 //_____________________________________________________________________________
 /**
@@ -1879,27 +2069,12 @@ divide(Storage *aStorage)
 {
     if(aStorage==NULL) return;
 
-    int i;
-    int n,N=0,nN;
-    double t,*Y=NULL;
-    for(i=0;i<_storage.getSize();i++) {
-
-        // GET INFO ON THIS STORAGE INSTANCE
-        n = getStateVector(i)->getSize();
-        t = getStateVector(i)->getTime();
-
-        // GET DATA FROM ARGUMENT
-        N = aStorage->getDataAtTime(t,N,&Y);
-
-        // SET SIZE TO SMALLER
-        nN = (n<N) ? n : N;
-
-        // DIVIDE
-        _storage[i].divide(SimTK::Vector_<double>(nN, Y));
-    }
-
-    // CLEANUP
-    if(Y!=NULL) delete[] Y;
+    // As StateVector::divide(), set the states divided by zero to NaN.
+    combineRows(_storage, *aStorage,
+        [](double* data, const double* values, int n) {
+            for(int k=0;k<n;k++)
+                data[k] = (values[k]==0.0) ? SimTK::NaN : data[k]/values[k];
+        });
 }
 
 //=============================================================================
@@ -2309,6 +2484,81 @@ pad(int aPadSize)
     delete[] vecs;
 }
 
+//_____________________________________________________________________________
+/**
+ * Replace the first aNumColumns columns of a storage by their filtered
+ * values.  aFilter is given a block of n columns as an array of
+ * aStorage.getSize() rows of n values (no time), and sets the filtered
+ * values of the block, in the same layout, in its last argument.  The
+ * blocks are filtered in parallel if the storage is large.
+ */
+static void
+filterColumns(Storage &aStorage,int aNumColumns,
+        const std::function<void(int,const double*,double*)> &aFilter)
+{
+    const int nRows = aStorage.getSize();
+    if(nRows<=0 || aNumColumns<=0) return;
+
+    // Threads are only worth starting for large storages.
+    const int minColumnsPerBlock = 8;
+    const size_t minValuesPerBlock = 65536;
+    int numBlocks = std::min<int>(std::thread::hardware_concurrency(),
+                                  aNumColumns/minColumnsPerBlock);
+    numBlocks = (int)std::min<size_t>(numBlocks,
+            (size_t)nRows*aNumColumns/minValuesPerBlock);
+    if(numBlocks<1) numBlocks = 1;
+
+    std::vector<std::exception_ptr> errors(numBlocks);
+    auto filterBlock = [&](int block) {
+        try {
+            const int first = aNumColumns*block/numBlocks;
+            const int n = aNumColumns*(block+1)/numBlocks - first;
+            std::vector<double> data((size_t)nRows*n), filtered(data.size());
+            for(int i=0;i<nRows;i++) {
+                const Array<double> &y = aStorage.getStateVector(i)->getData();
+                for(int j=0;j<n;j++) data[(size_t)i*n+j] = y[first+j];
+            }
+            aFilter(n,data.data(),filtered.data());
+            for(int i=0;i<nRows;i++) {
+                Array<double> &y = aStorage.getStateVector(i)->getData();
+                for(int j=0;j<n;j++) y[first+j] = filtered[(size_t)i*n+j];
+            }
+        } catch(...) {
+            errors[block] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int block=1;block<numBlocks;block++) {
+        try {
+            threads.emplace_back(filterBlock,block);
+        } catch(const std::system_error&) {
+            // Could not start a thread; filter this block here instead.
+            filterBlock(block);
+        }
+    }
+    filterBlock(0);
+    for(auto &thread : threads) thread.join();
+
+    for(const auto &error : errors)
+        if(error) std::rethrow_exception(error);
+}
+//_____________________________________________________________________________
+/**
+ * Filter the columns of an array of nRows rows of n values, as filterColumns()
+ * gives them, one at a time with aFilter(N, signal, filteredSignal).
+ */
+static void
+filterEachColumn(int nRows,int n,const double *aData,double *rFiltered,
+        const std::function<void(int,double*,double*)> &aFilter)
+{
+    std::vector<double> signal(nRows), filt(nRows,0.0);
+    for(int j=0;j<n;j++) {
+        for(int i=0;i<nRows;i++) signal[i] = aData[(size_t)i*n+j];
+        aFilter(nRows,signal.data(),filt.data());
+        for(int i=0;i<nRows;i++) rFiltered[(size_t)i*n+j] = filt[i];
+    }
+}
+
 void Storage::
 smoothSpline(int aOrder,double aCutoffFrequency)
 {
@@ -2332,21 +2582,20 @@ smoothSpline(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER THE COLUMNS
     double *times=NULL;
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
     getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
+    filterColumns(*this,nc,[&](int n,const double *data,double *filtered) {
+        filterEachColumn(size,n,data,filtered,
+                [&](int N,double *signal,double *filt) {
+            Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,N,times,
+                                 signal,filt);
+        });
+    });
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 void Storage::
@@ -2372,18 +2621,11 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER THE COLUMNS, SEVERAL AT ONCE
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    filterColumns(*this,nc,[&](int n,const double *data,double *filtered) {
+        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,n,data,filtered);
+    });
 }
 
 void Storage::
@@ -2409,18 +2651,14 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER THE COLUMNS
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    filterColumns(*this,nc,[&](int n,const double *data,double *filtered) {
+        filterEachColumn(size,n,data,filtered,
+                [&](int N,double *signal,double *filt) {
+            Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,N,signal,filt);
+        });
+    });
 }
 
 
@@ -2428,14 +2666,32 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
 // UTILITY
 //=============================================================================
 //_____________________________________________________________________________
+/**
+ * Find the index of the first of the statevectors in [aBegin, aEnd) whose
+ * time is greater than aT, or aEnd if there is none.  The times of the
+ * statevectors are assumed to be nondecreasing.
+ */
+static int
+findFirstIndexAfterTime(const Array<StateVector> &aStorage,
+                        int aBegin,int aEnd,double aT)
+{
+    while(aBegin<aEnd) {
+        int mid = aBegin + (aEnd-aBegin)/2;
+        if(aT<aStorage[mid].getTime()) aEnd = mid;
+        else aBegin = mid+1;
+    }
+    return(aBegin);
+}
+//_____________________________________________________________________________
 /**
  * Find the index of the storage element that occurred immediately before
  * or at time aT ( aT <= getTime(index) ).
  *
  * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * is made for aI: if aT is at or shortly after the time of state aI (as
+ * with the increasing times of an integration), the index is found in
+ * constant time.  Otherwise, the states after aI (or, if aI corresponds to
+ * a state which occurred later than aT, the states before aI) are bisected.
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2446,15 +2702,21 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    const int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
 
     // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
     int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    if(aT<_storage[aI].getTime()) {
+        i = findFirstIndexAfterTime(_storage,0,aI,aT);
+    } else {
+        // Check the next few states before bisecting the rest.
+        const int nNear = (n-aI>8) ? aI+8 : n;
+        for(i=aI+1;i<nNear;i++) {
+            if(aT<_storage[i].getTime()) break;
+        }
+        if(i==nNear) i = findFirstIndexAfterTime(_storage,nNear,n,aT);
     }
     _lastI = i-1;
     if(_lastI<0) _lastI=0;
@@ -2465,8 +2727,8 @@ findIndex(int aI,double aT) const
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The stored states are bisected, so this takes logarithmic time; use
+ * findIndex(aI,aT) with a good guess for aI for constant time.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2476,10 +2738,7 @@ int Storage::
 findIndex(double aT) const
 {
     if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
+    int i = findFirstIndexAfterTime(_storage,0,_storage.getSize(),aT);
     _lastI = i-1;
     if(_lastI<0) _lastI=0;
     return(_lastI);
@@ -2651,6 +2910,11 @@ setOutputFileName(const std::string& aFileName)
  * The total number of characters written is returned.  If an error occurred,
  * a negative number is returned.
  *
+ * If aFileName has the extension ".bsto" and aMode is "w", the storage is
+ * written as a binary file (see BinaryFileAdapter_) instead. If aFileName
+ * has the extension ".gz" (e.g., ".sto.gz"), the file is compressed (see
+ * CompressedFile).
+ *
  * @param aFileName Name of file to which to save.
  * @param aMode Writing mode: "w" means write and "a" means append.  The 
  * default is "w".
@@ -2660,9 +2924,19 @@ setOutputFileName(const std::string& aFileName)
 bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
+    OPENSIM_TRACE_SPAN("io", "write storage", aFileName);
+
+    // BINARY FILES are written through the BinaryFileAdapter.
+    if(isBinaryFileName(aFileName) && aMode == "w") {
+        BinaryFileAdapter::write(exportToTable(), aFileName);
+        return(true);
+    }
+
     // OPEN THE FILE
-    FILE *fp = IO::OpenFile(aFileName,aMode);
-    if(fp==NULL) return(false);
+    // Compressed files (e.g., .sto.gz) are compressed as they are written.
+    StorageOutput out(aFileName,aMode);
+    if(!out.isOpen()) return(false);
+    FILE *fp = out.header();
 
     // WRITE THE HEADER
     int n=0,nTotal=0;
@@ -2703,18 +2977,21 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 //std::cout << aFileName << endl;
 
     // VECTORS
-    for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(false);
-        }
-        nTotal += n;        
+    // The rows are formatted as StateVector::print() does, in blocks that
+    // can be formatted concurrently (see IO::SetNumWriterThreads()).
+    const std::string format = IO::GetDoubleOutputFormat();
+    auto formatRow = [&](int i,std::string& text) {
+        appendStateVector(text,format.c_str(),_storage[i]);
+    };
+    auto write = [&](const std::string& text) {
+        nTotal += (int)text.size();
+        return(out.write(text));
+    };
+    if(!IO::WriteRows(_storage.getSize(),formatRow,write) || !out.close()) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        return(false);
     }
 
-    // CLOSE
-    fclose(fp);
-
     return(nTotal!=0);
 }
 //_____________________________________________________________________________
@@ -2734,13 +3011,17 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 int Storage::
 print(const string &aFileName,double aDT,const string &aMode) const
 {
+    OPENSIM_TRACE_SPAN("io", "write storage", aFileName);
+
     // CHECK FOR VALID DT
     if(aDT<=0) return(0);
 
     if (_fp!= NULL) fclose(_fp);
     // OPEN THE FILE
-    FILE *fp = IO::OpenFile(aFileName,aMode);
-    if(fp==NULL) return(-1);
+    // Compressed files (e.g., .sto.gz) are compressed as they are written.
+    StorageOutput out(aFileName,aMode);
+    if(!out.isOpen()) return(-1);
+    FILE *fp = out.header();
 
     // HOW MANY TIME STEPS?
     double ti = getFirstTime();
@@ -2788,24 +3069,30 @@ print(const string &aFileName,double aDT,const string &aMode) const
     int i,ny=0;
     double t,*y=NULL;
     StateVector vec;
-    for(t=ti,i=0;i<nr;i++,t=ti+aDT*(double)i) {
+    const std::string format = IO::GetDoubleOutputFormat();
+    std::string text;
+    bool ok = true;
+    for(t=ti,i=0;i<nr && ok;i++,t=ti+aDT*(double)i) {
 
         // INTERPOLATE THE STATES
         ny = getDataAtTime(t,ny,&y);
         vec.setStates(t, SimTK::Vector_<double>(ny, y));
 
-        // PRINT
-        n = vec.print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(n);
+        // PRINT (in pieces of about 1 MB)
+        appendStateVector(text,format.c_str(),vec);
+        if(text.size()>((size_t)1<<20) || i==nr-1) {
+            nTotal += (int)text.size();
+            ok = out.write(text);
+            text.clear();
         }
-        nTotal += n;        
     }
 
     // CLEANUP
-    fclose(fp);
     if(y!=NULL) { delete[] y;  y=NULL; }
+    if(!out.close() || !ok) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        return(-1);
+    }
 
     return(nTotal);
 }
@@ -3065,7 +3352,7 @@ bool Storage::isSimmReservedToken(const std::string& aToken)
  *
  * @returns true on success (meaningful values of rNumRows, rNumColumns)
  */
-bool Storage::parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns)
+bool Storage::parseHeaders(std::istream& aStream, int& rNumRows, int& rNumColumns)
 {
     bool done=false;
     bool firstLine=true;
@@ -3163,6 +3450,7 @@ exchangeTimeColumnWith(int aColumnIndex)
     string swap = _columnLabels.get(0);
     _columnLabels.set(aColumnIndex+1, swap);
     _columnLabels.set(0, "time");
+    indexColumnLabels();
 
 }
 //_____________________________________________________________________________
@@ -3202,7 +3490,8 @@ void Storage::postProcessSIMMMotion()
                         StateVector vec = _storage.get(0);
                         vec.getData().append(0.0);
                         _columnLabels.append("time");
-                        exchangeTimeColumnWith(_columnLabels.findIndex("time"));
+                        indexColumnLabels();
+                        exchangeTimeColumnWith(findColumnLabel("time"));
                     }
                     else
                         throw (Exception("File has no data"));
@@ -3210,11 +3499,12 @@ void Storage::postProcessSIMMMotion()
                 else {  // time  column from range, size
                     double timeStep = (end - start)/(_storage.getSize()-1);
                     _columnLabels.append("time");
+                    indexColumnLabels();
                     for(int i=0; i<_storage.getSize(); i++){
                         Array<double>& data=_storage.updElt(i).getData();
                         data.append(i*timeStep);
                     }
-                    int timeColumnIndex=_columnLabels.findIndex("time");
+                    int timeColumnIndex=findColumnLabel("time");
                     exchangeTimeColumnWith(timeColumnIndex-1);
                 }
             }
@@ -3234,8 +3524,8 @@ void Storage::postProcessSIMMMotion()
 double Storage::compareColumn(Storage& aOtherStorage, const std::string& aColumnName, double startTime, double endTime)
 {
     //Subtract one since, the data does not include the time column anymore.
-    int thisColumnIndex=_columnLabels.findIndex(aColumnName)-1;
-    int otherColumnIndex = aOtherStorage._columnLabels.findIndex(aColumnName)-1;
+    int thisColumnIndex=findColumnLabel(aColumnName)-1;
+    int otherColumnIndex = aOtherStorage.findColumnLabel(aColumnName)-1;
 
     double theDiff = SimTK::NaN;
 
@@ -3360,10 +3650,6 @@ bool Storage::makeStorageLabelsUnique() {
 }
 
 bool Storage::storageLabelsAreUnique() const {
-    const auto& lbls = getColumnLabels();
-    for(int i = 0; i < lbls.getSize(); i++) {
-        const bool isUnique = (lbls.findIndex(lbls[i]) == i);
-        if (!isUnique) return false;
-    }
-    return true;
+    // Duplicated labels share an entry of the index.
+    return int(_columnLabelIndex.size()) == _columnLabels.getSize();
 }
@@ -32,6 +32,8 @@
 #include "StorageInterface.h"
 #include "TimeSeriesTable.h"
 
+#include <unordered_map>
+
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
 //=============================================================================
@@ -82,6 +84,8 @@ protected:
     std::string _headerToken;
     /** Column labels. */
     Array<std::string> _columnLabels;
+    /** Index of the first column with each label; see indexColumnLabels(). */
+    std::unordered_map<std::string, int> _columnLabelIndex;
     /** Step interval at which states in a simulation are stored. See
     store(). */
     int _stepInterval;
@@ -118,6 +122,10 @@ public:
     preserved. Use STOFileAdapter and TimeSeriesTable instead, if possible. */
     Storage(const std::string &aFileName, bool readHeadersOnly=false) SWIG_DECLARE_EXCEPTION;
     Storage(const Storage &aStorage,bool aCopyData=true);
+    /** Copy the rows of a TimeSeriesTable. The name and whether angles are
+    in degrees are taken from the table's "header" and "inDegrees"
+    metadata, if present. */
+    explicit Storage(const TimeSeriesTable& table);
     Storage(const Storage &aStorage,int aStateIndex,int aN,
         const char *aDelimiter="\t");
     virtual ~Storage();
@@ -136,6 +144,9 @@ public:
     //--------------------------------------------------------------------------    
     static const int& getLatestVersion() { return LatestVersion; };
     const int& getFileVersion() const { return _fileVersion; };
+protected:
+    // Add the rows and column labels to the Storages category.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
 private:
     //--------------------------------------------------------------------------
     // CONSTRUCTION METHODS
@@ -143,11 +154,16 @@ private:
     void allocateCapacity();
     void setNull();
     void copyData(const Storage &aStorage);
+    void copyFromTable(const TimeSeriesTable& table);
     void parseColumnLabels(const char *aLabels);
-    bool parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns);
+    bool parseHeaders(std::istream& aStream, int& rNumRows, int& rNumColumns);
     bool isSimmReservedToken(const std::string& aToken);
     void postProcessSIMMMotion();
     void exchangeTimeColumnWith(int aColumnIndex);
+    // Rebuild _columnLabelIndex; called whenever _columnLabels changes.
+    void indexColumnLabels();
+    // The index of the first column with the given label, or -1.
+    int findColumnLabel(const std::string& aLabel) const;
 public:
 
     //--------------------------------------------------------------------------
@@ -248,6 +264,12 @@ public:
     int reset(double aTime);
     void purge() { _storage.setSize(0); };  // Similar to reset but doesn't try to keep history
     void crop(const double newStartTime, const double newFinalTime);
+    /** Remove the rows that linear interpolation between the remaining rows
+    reproduces within the given tolerance, in every column (see
+    TrajectoryCompressor); the first and last rows are kept. getDataAtTime()
+    then returns the data within the tolerance. The times must increase and
+    all rows must have the same number of columns. */
+    void compress(double tolerance);
     //--------------------------------------------------------------------------
     // STORAGE
     //--------------------------------------------------------------------------
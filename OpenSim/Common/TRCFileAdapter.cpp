@@ -1,4 +1,7 @@
 #include "TRCFileAdapter.h"
+#include "CompressedFile.h"
+#include "IO.h"
+#include "Tracer.h"
 #include <fstream>
 #include <iomanip>
 
@@ -39,12 +42,21 @@ TRCFileAdapter::write(const TimeSeriesTableVec3& table,
     TRCFileAdapter{}.extendWrite(tables, fileName);
 }
 
+void 
+TRCFileAdapter::write(const TimeSeriesTableViewVec3& view, 
+                      const std::string& fileName) {
+    TRCFileAdapter{}.writeTable(view, fileName);
+}
+
 TRCFileAdapter::OutputTables
 TRCFileAdapter::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
+    OPENSIM_TRACE_SPAN("io", "read table", fileName);
 
-    std::ifstream in_stream{fileName};
+    // Compressed files (e.g., .trc.gz) are decompressed.
+    auto stream = CompressedFile::openForReading(fileName);
+    std::istream& in_stream = *stream;
     OPENSIM_THROW_IF(!in_stream.good(),
                      FileDoesNotExist,
                      fileName);
@@ -146,33 +158,43 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
         }
     }
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
-    std::size_t line_num{_dataStartsAtLine - 1};
-    auto row = nextLine();
-    while(!row.empty()) {
-        ++line_num;
-        size_t expected{column_labels.size() * 3 + 2};
-        OPENSIM_THROW_IF(row.size() != expected,
-                         RowLengthMismatch,
-                         fileName,
-                         line_num,
-                         expected,
-                         row.size());
-
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected)};
-        int ind{0};
-        for(std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3)
-            row_vector[ind++] = SimTK::Vec3{std::stod(row.at(c)),
-                                            std::stod(row.at(c+1)),
-                                            std::stod(row.at(c+2))};
-
-        // Column 1 is time.
-        table->appendRow(std::stod(row.at(1)), std::move(row_vector));
-
-        row = nextLine();
+    // Read all the rows at once, then parse them (in parallel, if there are
+    // many) directly into the time column container and the data container.
+    const DataLines lines{in_stream, _delimitersRead, _dataStartsAtLine};
+    const std::size_t num_rows{lines.getNumLines()};
+    const std::size_t expected{column_labels.size() * 3 + 2};
+    std::vector<double> times(num_rows);
+    SimTK::Matrix_<SimTK::Vec3> data{static_cast<int>(num_rows),
+                                     static_cast<int>(num_markers_expected)};
+    parseRowsInParallel(num_rows, [&](std::size_t begin, std::size_t end) {
+        std::vector<Token> row{};
+        for(std::size_t r = begin; r < end; ++r) {
+            lines.tokenize(r, row);
+            OPENSIM_THROW_IF(row.size() != expected,
+                             RowLengthMismatch,
+                             fileName,
+                             lines.getLineNumber(r),
+                             expected,
+                             row.size());
+
+            // Column 1 is time. Columns 2 till the end are data.
+            times[r] = parseDouble(row[1]);
+            int ind{0};
+            for(std::size_t c = 2; c < expected; c += 3)
+                data(static_cast<int>(r), ind++) =
+                    SimTK::Vec3{parseDouble(row[c]),
+                                parseDouble(row[c + 1]),
+                                parseDouble(row[c + 2])};
+        }
+    });
+
+    if(num_rows > 0) {
+        // Construct the table from all the rows at once rather than
+        // appending the rows one at a time.
+        auto full_table = std::make_shared<TimeSeriesTableVec3>(
+                times, data, column_labels);
+        full_table->updTableMetaData() = table->getTableMetaData();
+        table = full_table;
     }
 
     // Set the column labels of the table.
@@ -194,6 +216,7 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
                             const std::string& fileName) const {
     OPENSIM_THROW_IF(absTables.empty(),
                      NoTableFound);
+    OPENSIM_TRACE_SPAN("io", "write table", fileName);
 
     const TimeSeriesTableVec3* table{};
     try {
@@ -202,14 +225,28 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     } catch(std::out_of_range) {
         OPENSIM_THROW(KeyMissing,
                       _markers);
-    } catch(std::bad_cast&) {
-        OPENSIM_THROW(IncorrectTableType);
     }
+    OPENSIM_THROW_IF(table == nullptr,
+                     IncorrectTableType);
 
+    writeTable(TimeSeriesTableViewVec3{*table}, fileName);
+}
+
+void
+TRCFileAdapter::writeTable(const TimeSeriesTableViewVec3& view,
+                           const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ofstream out_stream{fileName};
+    const TimeSeriesTableVec3* table = &view.getTable();
+    // The numbers of frames and markers in the metadata are those of the
+    // whole table.
+    const bool isWholeTable = view.getNumRows() == table->getNumRows() &&
+                              view.getNumColumns() == table->getNumColumns();
+
+    // Compressed files (e.g., .trc.gz) are compressed as they are written.
+    auto stream = CompressedFile::openForWriting(fileName);
+    std::ostream& out_stream = *stream;
 
     // First line of the stream is the header.
     try {
@@ -248,24 +285,24 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     } catch(KeyNotFound&) {
         out_stream << datarate << _delimiterWrite;
     }
-    try {
+    if(isWholeTable &&
+       table->getTableMetaData().hasKey(_metadataKeys[2]))
         out_stream << table->
                       getTableMetaData().
                       getValueForKey(_metadataKeys[2]).
                       getValue<std::string>()
                    << _delimiterWrite;
-    } catch(KeyNotFound&) {
-        out_stream << table->getNumRows() << _delimiterWrite;
-    }
-    try {
+    else
+        out_stream << view.getNumRows() << _delimiterWrite;
+    if(isWholeTable &&
+       table->getTableMetaData().hasKey(_metadataKeys[3]))
         out_stream << table->
                       getTableMetaData().
                       getValueForKey(_metadataKeys[3]).
                       getValue<std::string>()
                    << _delimiterWrite;
-    } catch(KeyNotFound&) {
-        out_stream << table->getNumColumns() << _delimiterWrite;
-    }
+    else
+        out_stream << view.getNumColumns() << _delimiterWrite;
     try {
         out_stream << table->
                       getTableMetaData().
@@ -307,17 +344,14 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     // Line containing column labels.
     out_stream << _frameNumColumnLabel << _delimiterWrite
                << _timeColumnLabel     << _delimiterWrite;
-    for(unsigned col = 0; col < table->getNumColumns(); ++col)
-        out_stream << table->
-                      getDependentsMetaData().
-                      getValueArrayForKey("labels")[col].
-                      getValue<std::string>()
+    for(unsigned col = 0; col < view.getNumColumns(); ++col)
+        out_stream << view.getColumnLabel(col)
                    << _delimiterWrite << _delimiterWrite << _delimiterWrite;
     out_stream << "\n";
 
     // Line containing xyz component labels for each marker.
     out_stream << _delimiterWrite << _delimiterWrite;
-    for(unsigned col = 1; col <= table->getNumColumns(); ++col)
+    for(unsigned col = 1; col <= view.getNumColumns(); ++col)
         for(auto& letter : {_xLabel, _yLabel, _zLabel})
             out_stream << (letter + std::to_string(col)) << _delimiterWrite;
     out_stream << "\n";
@@ -325,22 +359,39 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     // Empty line.
     out_stream << "\n";
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << row + 1                           << _delimiterWrite
-                   << std::setprecision(prec) 
-                   << table->getIndependentColumn()[row] << _delimiterWrite;
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << std::setprecision(prec) 
-                       << elt[0] << _delimiterWrite
-                       << elt[1] << _delimiterWrite
-                       << elt[2] << _delimiterWrite;
-        }
-        out_stream << "\n";
-    }
+    // Data rows, formatted in blocks (concurrently, if requested; see
+    // IO::SetNumWriterThreads()) with digits10 + 1 significant digits.
+    // The rows appended to the table are added to its matrix here, rather
+    // than by the threads.
+    const char* format = "%.16g";
+    const auto& matrix = table->getMatrix();
+    const auto& times = table->getIndependentColumn();
+    std::vector<int> columns{};
+    for(size_t col = 0; col < view.getNumColumns(); ++col)
+        columns.push_back(static_cast<int>(view.getColumnIndexInTable(col)));
+    IO::WriteRows(static_cast<int>(view.getNumRows()),
+        [&](int row, std::string& text) {
+            const size_t tableRow{view.getRowIndexInTable(row)};
+            text += std::to_string(row + 1);
+            text += _delimiterWrite;
+            IO::AppendDouble(text, format, times[tableRow]);
+            text += _delimiterWrite;
+            const auto& row_r = matrix.row(static_cast<int>(tableRow));
+            for(const int col : columns) {
+                const auto& elt = row_r[col];
+                for(int i = 0; i < 3; ++i) {
+                    IO::AppendDouble(text, format, elt[i]);
+                    text += _delimiterWrite;
+                }
+            }
+            text += '\n';
+        },
+        [&](const std::string& text) {
+            out_stream.write(text.data(), text.size());
+            return static_cast<bool>(out_stream);
+        });
+    OPENSIM_THROW_IF(!out_stream.flush(), Exception,
+                     "Could not write file '" + fileName + "'.");
 }
 
 }
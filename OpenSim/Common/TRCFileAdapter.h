@@ -130,6 +130,15 @@ public:
     static
     void write(const TimeSeriesTableVec3& table, const std::string& filename);
 
+#ifndef SWIG
+    /** Write the rows and columns of a view of a table to a TRC file. The
+    number of frames and markers written are those of the view, rather than
+    those in the metadata of the table.                                       */
+    static
+    void write(const TimeSeriesTableViewVec3& view,
+               const std::string& filename);
+#endif
+
     /** Key used for table associative array returned/accepted by write/read. */
     static const std::string              _markers;
 
@@ -140,6 +149,11 @@ protected:
     /** Implementation of the write functionality.                            */
     void extendWrite(const InputTables& tables, 
                      const std::string& filename) const override;
+
+    /** Write the rows and columns of a view of a table; this implements
+    extendWrite(), for a view of the whole table.                             */
+    void writeTable(const TimeSeriesTableViewVec3& view,
+                    const std::string& filename) const;
     
 private:
     /** Delimiter used for writing.                                           */
@@ -27,6 +27,8 @@
 #include "TimeSeriesTable.h"
 #include "Component.h"
 
+#include <unordered_map>
+
 namespace OpenSim {
 
 /** Component representing a source of data from a TimeSeriesTable_.
@@ -81,6 +83,16 @@ public:
         constructProperties();
     }
 
+#ifndef SWIG
+    /** Construct the TableSource_ by giving it a view of a TimeSeriesTable_
+    (e.g., a few channels of a recording); only the data in the view are
+    copied.                                                                   */
+    explicit TableSource_(const TimeSeriesTableView_<ET>& view) :
+        _table{view.toTable()} {
+        constructProperties();
+    }
+#endif
+
     /** Construct the TableSource_ from a file.
 
     \param filename Name of the file.
@@ -122,6 +134,19 @@ public:
         set_tablename("");
     }
 
+#ifndef SWIG
+    /** Replace the existing TimeSeriesTable_ with (a copy of the data in) a
+    view of a table. The properties 'filename' and 'tablename' are reset to
+    empty strings as a result of this operation.
+
+    \throws KeyNotFound If table provided does not have column labels.       */
+    void setTable(const TimeSeriesTableView_<ET>& view) {
+        setTable_impl(view.toTable());
+        set_filename("");
+        set_tablename("");
+    }
+#endif
+
     /** Replace the TimeSeriesTable_ that this TableSource_ currently holds. 
     Property 'filename' is reset to the value provided. Property 'tablename' is
     reset to the empty string as a result of this operation.
@@ -156,17 +181,20 @@ public:
     /// @}
 
 protected:
-    void setTable_impl(const Table& table) {
-        _table = table;
+    void setTable_impl(Table table) {
+        _table = std::move(table);
         auto& columnOutput = updOutput("column");
         columnOutput.clearChannels();
         for(const auto& columnLabel : _table.getColumnLabels())
             columnOutput.addChannel(columnLabel);
+        updateColumnIndices();
     }
 
     /** Retrieve value of a column at a given time(implicit in the State 
     provided). Linear interpolation is performed if the TimeSeriesTable_ does
-    not contain an entry for the time mentioned by the state.
+    not contain an entry for the time mentioned by the state. The returned
+    reference is to an element of the row held in the State's cache (see
+    getRowAtTime()), so no copy is made.
 
     \throws EmptyTable If the TimeSeriesTable_ this TableSource_ holds is 
                        currently empty.
@@ -174,56 +202,37 @@ protected:
                            than the smallest timestamp or greater than the 
                            largest timestamp in the TimeSeriesTable_.
     \throws KeyNotFound If TimeSeriesTable_ does not have column-labels.      */
-    ET getColumnAtTime(const SimTK::State& state, 
-                       const std::string& columnLabel) const {
-        OPENSIM_THROW_IF(_table.getNumRows() == 0, EmptyTable);
-        const auto& timeCol = _table.getIndependentColumn();
-        const auto time = state.getTime();
-        OPENSIM_THROW_IF(time < timeCol.front() ||
-                         time > timeCol.back(),
-                         TimeOutOfRange, 
-                         time, timeCol.front(), timeCol.back());
-
-        const auto colInd = 
-            static_cast<int>(_table.getColumnIndex(columnLabel));
-        auto lb = std::lower_bound(timeCol.begin(), timeCol.end(), time);
-        if(lb == timeCol.begin())
-            return _table.getMatrix().getElt(0, colInd);
-        else if(lb == timeCol.end())
-            return _table.
-                   getMatrix().
-                   getElt(static_cast<int>(timeCol.size() - 1), colInd);
-        else if(*lb == time)
-            return _table.
-                   getMatrix().
-                   getElt(static_cast<int>(lb - timeCol.begin()), colInd);
-        else {
-            auto prevTime = *(lb - 1);
-            auto nextTime = *lb;
-            auto prevElt = _table.
-                           getMatrix().
-                           getElt(static_cast<int>(lb - 1 - timeCol.begin()),
-                                  colInd);
-            auto nextElt = _table.
-                           getMatrix().
-                           getElt(static_cast<int>(lb - timeCol.begin()), 
-                                  colInd);
-            auto elt = ((time - prevTime) / (nextTime - prevTime)) * 
-                       (nextElt - prevElt) + prevElt;
-            return elt;
-        }
+    const ET& getColumnAtTime(const SimTK::State& state, 
+                              const std::string& columnLabel) const {
+        const auto& row = getRowAtTime(state);
+        const auto it = _columnIndices.find(columnLabel);
+        if (it != _columnIndices.end())
+            return row[it->second];
+        // Throws if the table does not have the column.
+        return row[static_cast<int>(_table.getColumnIndex(columnLabel))];
     }
 
     /** Retrieve a row of the TimeSeriesTable_ at a given time (specified by the
     state). Linear interpolation is performed if the TimeSeriesTable_ does not
-    have an entry for the time mentioned by the state.
+    have an entry for the time mentioned by the state. Once the State is
+    realized to Stage::Model, the row is computed at most once per time (it is
+    held in the State's cache) and the returned reference is to that cache
+    entry. Otherwise, the reference is to storage held by this TableSource_,
+    which is overwritten by the next call.
 
     \throws EmptyTable If the TimeSeriesTable_ this TableSource_ holds is 
                        currently empty.
     \throws TimeOutOfRange If the time specified by the State is either less 
                            than the smallest timestamp or greater than the 
                            largest timestamp in the TimeSeriesTable_.         */
-    Vector getRowAtTime(const SimTK::State& state) const {
+    const Vector& getRowAtTime(const SimTK::State& state) const {
+        // A cache entry that depends on Stage::Time can only be marked valid
+        // once the State is realized to Stage::Model.
+        const bool useCache = hasSystem() && _rowCV.isValid() &&
+                state.getSystemStage() >= SimTK::Stage::Model;
+        if (useCache && isCacheVariableValid(state, _rowCV))
+            return getCacheVariableValue(state, _rowCV);
+
         OPENSIM_THROW_IF(_table.getNumRows() == 0, EmptyTable);
         const auto& timeCol = _table.getIndependentColumn();
         const auto time = state.getTime();
@@ -232,22 +241,31 @@ protected:
                          TimeOutOfRange, 
                          time, timeCol.front(), timeCol.back());
 
-        auto lb = std::lower_bound(timeCol.begin(), timeCol.end(), time);
-        if(lb == timeCol.begin())
-            return _table.getRowAtIndex(0).getAsVector();
-        else if(lb == timeCol.end())
-            return _table.getRowAtIndex(timeCol.size() - 1).getAsVector();
-        else if(*lb == time)
-            return _table.getRowAtIndex(lb - timeCol.begin()).getAsVector();
-        else {
+        // Write into the cache entry in place, to avoid allocating.
+        Vector& row = useCache ? updCacheVariableValue(state, _rowCV) : _row;
+        const int numColumns = static_cast<int>(_table.getNumColumns());
+        if (row.size() != numColumns) row.resize(numColumns);
+
+        // Successive calls are usually for nearby, increasing times.
+        _rowIndexHint = _table.getRowIndexAtOrAfterTime(time, _rowIndexHint);
+        auto lb = timeCol.begin() + _rowIndexHint;
+        if(lb == timeCol.end())
+            --lb;
+        if(lb == timeCol.begin() || *lb == time) {
+            const auto tableRow = _table.getRowAtIndex(lb - timeCol.begin());
+            for (int i = 0; i < numColumns; ++i)
+                row[i] = tableRow[i];
+        } else {
             auto prevTime = *(lb - 1);
             auto nextTime = *lb;
-            auto prevRow = _table.getRowAtIndex(lb - 1 - timeCol.begin());
-            auto nextRow = _table.getRowAtIndex(lb - timeCol.begin());
-            auto row = ((time - prevTime) / (nextTime - prevTime)) * 
-                       (nextRow - prevRow) + prevRow;
-            return row.getAsVector();
+            const auto prevRow = _table.getRowAtIndex(lb - 1 - timeCol.begin());
+            const auto nextRow = _table.getRowAtIndex(lb - timeCol.begin());
+            const auto weight = (time - prevTime) / (nextTime - prevTime);
+            for (int i = 0; i < numColumns; ++i)
+                row[i] = weight * (nextRow[i] - prevRow[i]) + prevRow[i];
         }
+        if (useCache) markCacheVariableValid(state, _rowCV);
+        return row;
     }
 
 private:
@@ -266,9 +284,33 @@ private:
         auto& columnOutput = updOutput("column");
         for(const auto& columnLabel : _table.getColumnLabels())
             columnOutput.addChannel(columnLabel);
+        updateColumnIndices();
+    }
+
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override {
+        Super::extendAddToSystem(system);
+        _rowCV = addCacheVariable("all_columns",
+                Vector(static_cast<int>(_table.getNumColumns())),
+                SimTK::Stage::Time);
+    }
+
+    void updateColumnIndices() {
+        _columnIndices.clear();
+        if (!_table.hasColumnLabels()) return;
+        const auto& labels = _table.getColumnLabels();
+        for (size_t i = 0; i < labels.size(); ++i)
+            _columnIndices.emplace(labels[i], static_cast<int>(i));
     }
 
     Table _table;
+    // Column label -> index, so that each 'column' channel is found quickly.
+    std::unordered_map<std::string, int> _columnIndices;
+    // The interpolated row at the State's time.
+    mutable CacheVariable<Vector> _rowCV;
+    // Used instead of the cache entry if the State is not yet realized.
+    mutable Vector _row;
+    // The row index found by the previous call to getRowAtTime().
+    mutable size_t _rowIndexHint{0};
 }; // class TableSource_
 
 
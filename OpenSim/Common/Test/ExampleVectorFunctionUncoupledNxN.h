@@ -140,6 +140,10 @@ public:
     void calcValue(const Array<double> &aX,Array<double> &rY) override {
         calcValue(&aX[0],&rY[0], aX.getSize());
     }
+    void evaluate(const SimTK::State& s, const Array<double> &aX,
+                  Array<double> &rF) override {
+        calcValue(aX, rF);
+    }
     void calcDerivative(const Array<double> &aX,Array<double> &rY,
         const Array<int> &aDerivWRT) override {
             std::cout<<"\nExampleVectorFunctionUncoupledNxN.evalute(x,y,derivWRT): not implemented.\n";
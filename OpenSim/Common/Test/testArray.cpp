@@ -0,0 +1,115 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testArray.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Array.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <string>
+
+using namespace OpenSim;
+using namespace std;
+
+// Arrays of numbers keep short arrays within the Array object, and switch to
+// (and back from) allocated memory as they grow (and are trimmed).
+void testInlineStorage()
+{
+    static_assert(Array<double>::InlineCapacity == 4, "");
+    static_assert(Array<std::string>::InlineCapacity == 0, "");
+
+    Array<double> a(-1.0, 3);
+    ASSERT(a.getSize() == 3 && a.getCapacity() == 4);
+    a[0] = 1; a[1] = 2; a[2] = 3;
+    a.append(4);
+    a.append(5);
+    ASSERT(a.getSize() == 5 && a.getCapacity() >= 6);
+    for (int i = 0; i < 5; ++i) ASSERT(a[i] == i + 1);
+    // Elements added by growing the size have the default value.
+    a.setSize(7);
+    ASSERT(a[5] == -1 && a[6] == -1);
+
+    a.setSize(2);
+    a.trim();
+    ASSERT(a.getCapacity() == 3);
+    ASSERT(a[0] == 1 && a[1] == 2);
+    a.setSize(3);
+    ASSERT(a[2] == -1);
+
+    // Copies of short and long arrays are independent.
+    Array<double> b(a);
+    b[0] = 10;
+    ASSERT(a[0] == 1 && b[0] == 10 && b.getSize() == 3);
+    Array<double> c(0.0, 20);
+    c[19] = 19;
+    b = c;
+    ASSERT(b.getSize() == 20 && b[19] == 19);
+    b = a;
+    ASSERT(b.getSize() == 3 && b[0] == 1);
+    Array<double>& self = b;
+    b = self;
+    ASSERT(b.getSize() == 3 && b[2] == -1);
+}
+
+void testMove()
+{
+    // A short array, whose elements are moved one by one.
+    Array<double> a(0.0, 2);
+    a[0] = 1; a[1] = 2;
+    Array<double> b(std::move(a));
+    ASSERT(a.getSize() == 0);
+    ASSERT(b.getSize() == 2 && b[0] == 1 && b[1] == 2);
+    b.append(3);
+    ASSERT(b[2] == 3);
+
+    // A long array, whose memory is taken over.
+    Array<double> c(0.0, 100);
+    c[99] = 99;
+    const double* elements = &c[0];
+    Array<double> d;
+    d = std::move(c);
+    ASSERT(c.getSize() == 0);
+    ASSERT(d.getSize() == 100 && &d[0] == elements && d[99] == 99);
+
+    // Other types are never stored within the Array object.
+    Array<std::string> s("", 2);
+    s[1] = "moved";
+    const std::string* strings = &s[0];
+    Array<std::string> t(std::move(s));
+    ASSERT(&t[0] == strings && t[1] == "moved");
+
+    // An emptied array can be used again.
+    a.append(5);
+    ASSERT(a.getSize() == 1 && a[0] == 5);
+}
+
+int main()
+{
+    try {
+        testInlineStorage();
+        testMove();
+    } catch (const std::exception& e) {
+        cout << "testArray FAILED: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
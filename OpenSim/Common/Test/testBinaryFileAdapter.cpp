@@ -0,0 +1,150 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testBinaryFileAdapter.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/Storage.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace OpenSim;
+
+void testRoundTrip() {
+    const std::string binFile{"testBinaryFileAdapter.bsto"};
+    const auto table = STOFileAdapter::read("std_subject01_walk1_ik.mot");
+    BinaryFileAdapter::write(table, binFile);
+
+    const auto copy = BinaryFileAdapter::read(binFile);
+    SimTK_TEST(copy.getColumnLabels() == table.getColumnLabels());
+    SimTK_TEST(copy.getIndependentColumn() == table.getIndependentColumn());
+    SimTK_TEST_EQ(copy.getMatrix(), table.getMatrix());
+    SimTK_TEST(copy.getTableMetaData<std::string>("header") ==
+               table.getTableMetaData<std::string>("header"));
+
+    // Through FileAdapter::readFile().
+    auto tables = FileAdapter::readFile(binFile);
+    SimTK_TEST(tables.at("table")->getNumRows() == table.getNumRows());
+
+    // Only some of the columns and times.
+    const auto& times = table.getIndependentColumn();
+    const auto& labels = table.getColumnLabels();
+    const size_t first{10}, last{20};
+    const auto part = BinaryFileAdapter::read(binFile,
+            {labels[3], labels[1]}, times[first], times[last]);
+    SimTK_TEST(part.getNumRows() == last - first + 1);
+    SimTK_TEST(part.getColumnLabels() ==
+               std::vector<std::string>({labels[3], labels[1]}));
+    SimTK_TEST(part.getIndependentColumn().front() == times[first]);
+    for(size_t r = 0; r < part.getNumRows(); ++r) {
+        SimTK_TEST(part.getMatrix()(int(r), 0) ==
+                   table.getMatrix()(int(first + r), 3));
+        SimTK_TEST(part.getMatrix()(int(r), 1) ==
+                   table.getMatrix()(int(first + r), 1));
+    }
+    SimTK_TEST_MUST_THROW_EXC(
+            BinaryFileAdapter::read(binFile, {"not_a_column"}), KeyMissing);
+    std::remove(binFile.c_str());
+}
+
+void testVec3() {
+    const std::string binFile{"testBinaryFileAdapter_vec3.bsto"};
+    TimeSeriesTableVec3 table{};
+    table.setColumnLabels({"a", "b"});
+    for(int i = 0; i < 5; ++i)
+        table.appendRow(0.1 * i, {SimTK::Vec3(i, 2 * i, 3 * i),
+                                  SimTK::Vec3(-i, -2 * i, -3 * i)});
+    DataAdapter::InputTables inputTables{};
+    inputTables.emplace(std::string{"table"}, &table);
+    FileAdapter::writeFile(inputTables, binFile);
+
+    const auto copy = BinaryFileAdapterVec3::read(binFile);
+    SimTK_TEST(copy.getNumRows() == 5);
+    SimTK_TEST_EQ(copy.getRowAtIndex(4)[1], SimTK::Vec3(-4, -8, -12));
+    SimTK_TEST_MUST_THROW_EXC(BinaryFileAdapter::read(binFile),
+                              DataTypeMismatch);
+    std::remove(binFile.c_str());
+}
+
+void testStorage() {
+    const std::string binFile{"testBinaryFileAdapter_storage.bsto"};
+    Storage sto{"std_subject01_walk1_ik.mot"};
+    SimTK_TEST(sto.print(binFile));
+    Storage copy{binFile};
+    SimTK_TEST(copy.getSize() == sto.getSize());
+    SimTK_TEST(copy.getColumnLabels() == sto.getColumnLabels());
+    SimTK_TEST(copy.isInDegrees() == sto.isInDegrees());
+    double value{}, valueCopy{};
+    sto.getStateVector(7)->getDataValue(2, value);
+    copy.getStateVector(7)->getDataValue(2, valueCopy);
+    SimTK_TEST(value == valueCopy);
+    std::remove(binFile.c_str());
+}
+
+void testSinglePrecision() {
+    const std::string doubleFile{"testBinaryFileAdapter_double.bsto"};
+    const std::string floatFile{"testBinaryFileAdapter_float.bsto"};
+    const auto table = STOFileAdapter::read("std_subject01_walk1_ik.mot");
+    BinaryFileAdapter::write(table, doubleFile);
+    BinaryFileAdapter::write(table, floatFile, true);
+
+    // The values take half the space, and are read as doubles.
+    const auto size = [](const std::string& fileName) {
+        std::ifstream file{fileName, std::ios::binary | std::ios::ate};
+        return double(file.tellg());
+    };
+    const double valueBytes = 8.0 * table.getNumRows() * table.getNumColumns();
+    SimTK_TEST_EQ_TOL(size(doubleFile) - size(floatFile), valueBytes / 2,
+                      64);
+    const auto copy = BinaryFileAdapter::read(floatFile);
+    SimTK_TEST(copy.getIndependentColumn() == table.getIndependentColumn());
+    for(int r = 0; r < int(table.getNumRows()); ++r)
+        for(int c = 0; c < int(table.getNumColumns()); ++c)
+            SimTK_TEST(copy.getMatrix()(r, c) ==
+                       double(float(table.getMatrix()(r, c))));
+    const auto part = BinaryFileAdapter::read(floatFile,
+            {table.getColumnLabels()[2]}, table.getIndependentColumn()[5]);
+    SimTK_TEST(part.getMatrix()(0, 0) == copy.getMatrix()(5, 2));
+
+    // FileAdapter::writeFile() (like Storage::print()) follows the global
+    // setting.
+    TimeSeriesTableVec3 vec3Table{};
+    vec3Table.setColumnLabels({"a"});
+    vec3Table.appendRow(0.0, {SimTK::Vec3(0.1, 0.2, 0.3)});
+    IO::SetBinarySinglePrecision(true);
+    DataAdapter::InputTables inputTables{};
+    inputTables.emplace(std::string{"table"}, &vec3Table);
+    FileAdapter::writeFile(inputTables, floatFile);
+    IO::SetBinarySinglePrecision(false);
+    SimTK_TEST(BinaryFileAdapterVec3::read(floatFile).getRowAtIndex(0)[0] ==
+               SimTK::Vec3(double(0.1f), double(0.2f), double(0.3f)));
+    std::remove(doubleFile.c_str());
+    std::remove(floatFile.c_str());
+}
+
+int main() {
+    SimTK_START_TEST("testBinaryFileAdapter");
+        SimTK_SUBTEST(testRoundTrip);
+        SimTK_SUBTEST(testVec3);
+        SimTK_SUBTEST(testStorage);
+        SimTK_SUBTEST(testSinglePrecision);
+    SimTK_END_TEST();
+}
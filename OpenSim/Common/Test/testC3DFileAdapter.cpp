@@ -102,6 +102,66 @@ void test(const std::string filename) {
     }
 }
 
+// Reading part of a file, and many files at once, gives the same data as
+// reading everything.
+void testSelection(const std::vector<std::string>& filenames) {
+    using namespace OpenSim;
+
+    const auto tables = C3DFileAdapter::read(filenames[0]);
+    const auto& all_markers = *tables.at("markers");
+    const auto& all_forces = *tables.at("forces");
+
+    C3DFileAdapter adapter{};
+    adapter.setReadForces(false);
+    const auto& labels = all_markers.getColumnLabels();
+    adapter.setMarkerNames({labels[2], labels[0]});
+    auto markers_only = adapter.readTables(filenames[0]);
+    ASSERT(markers_only.count("forces") == 0);
+    const auto& markers = *markers_only.at("markers");
+    ASSERT(markers.getColumnLabels() ==
+           std::vector<std::string>({labels[2], labels[0]}));
+    for(int r = 0; r < markers.getNumRows(); ++r) {
+        ASSERT(markers.getMatrix()(r, 0) == all_markers.getMatrix()(r, 2));
+        ASSERT(markers.getMatrix()(r, 1) == all_markers.getMatrix()(r, 0));
+    }
+    adapter.setMarkerNames({"not_a_marker"});
+    ASSERT_THROW(OpenSim::Exception, adapter.readTables(filenames[0]));
+
+    adapter.setMarkerNames({});
+    adapter.setReadMarkers(false);
+    adapter.setReadForces(true);
+    adapter.setForcePlatforms({2});
+    auto forces_only = adapter.readTables(filenames[0]);
+    ASSERT(forces_only.count("markers") == 0);
+    const auto& forces = *forces_only.at("forces");
+    ASSERT(forces.getColumnLabels() ==
+           std::vector<std::string>({"f2", "p2", "m2"}));
+    for(const std::string label : {"f2", "p2", "m2"}) {
+        const auto column = forces.getDependentColumn(label);
+        const auto expected = all_forces.getDependentColumn(label);
+        for(int r = 0; r < column.size(); ++r)
+            ASSERT(column[r] == expected[r]);
+    }
+
+    // Markers and forces converted concurrently, and files read
+    // concurrently.
+    C3DFileAdapter concurrent{};
+    concurrent.setNumThreads(2);
+    const auto both = concurrent.readTables(filenames[0]);
+    compare_tables(*both.at("markers"), all_markers);
+    compare_tables(*both.at("forces"), all_forces);
+    std::vector<std::string> batch{filenames[0], filenames[1], filenames[0]};
+    const auto trials = concurrent.readTables(batch);
+    ASSERT(trials.size() == 3);
+    for(std::size_t i = 0; i < batch.size(); ++i) {
+        const auto expected = C3DFileAdapter::read(batch[i]);
+        compare_tables(*trials[i].at("markers"), *expected.at("markers"));
+        compare_tables(*trials[i].at("forces"), *expected.at("forces"));
+    }
+    batch.push_back("not_a_file.c3d");
+    ASSERT_THROW(OpenSim::Exception, concurrent.readTables(batch));
+}
+
 int main() {
     std::vector<std::string> filenames{};
     filenames.push_back("walking2.c3d");
@@ -111,6 +171,7 @@ int main() {
         std::cout << "Test reading '" + filename + "'." << std::endl;
         test(filename);
     }
+    testSelection(filenames);
 
     return 0;
 }
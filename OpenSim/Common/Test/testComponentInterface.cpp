@@ -1001,10 +1001,18 @@ void testComponentPathNames()
     Bar* bar2 = new Bar();
     bar2->setName("Bar2");
 
+    ASSERT(top.countNumComponents<TheWorld>() == 5);
+    ASSERT(top.countNumComponents<Foo>() == 0);
+
     A->add(foo1);
     A->add(foo2);
     A->add(bar2);
 
+    // Cached lists of components reflect subcomponents added to descendants.
+    ASSERT(top.countNumComponents<Foo>() == 2);
+    ASSERT(A->countNumComponents<Foo>() == 2);
+    ASSERT(B->countNumComponents<Foo>() == 0);
+
     TheWorld* F = A->clone();
     F->setName("F");
     top.add(F);
@@ -1012,6 +1020,27 @@ void testComponentPathNames()
     top.printSubcomponentInfo();
     top.printOutputInfo();
 
+    ASSERT(top.countNumComponents<Foo>() == 4);
+    {
+        // Iteration order (tree pre-order) and filters are preserved.
+        std::vector<std::string> names;
+        for (const auto& foo : top.getComponentList<Foo>())
+            names.push_back(foo.getAbsolutePathString());
+        ASSERT(names.size() == 4);
+        ASSERT(names[0] == "/Top/A/Foo1" && names[1] == "/Top/A/Foo2");
+        ASSERT(names[2] == "/Top/F/Foo1" && names[3] == "/Top/F/Foo2");
+
+        ComponentFilterAbsolutePathNameContainsString onlyF("/F/");
+        auto fooList = top.getComponentList<Foo>();
+        fooList.setFilter(onlyF);
+        int numInF = 0;
+        for (const auto& foo : fooList) {
+            ASSERT(foo.getAbsolutePathString().find("/Top/F/") == 0);
+            ++numInF;
+        }
+        ASSERT(numInF == 2);
+    }
+
     std::string fFoo1AbsPath = 
         F->getComponent<Foo>("Foo1").getAbsolutePathString();
     std::string aBar2AbsPath = 
@@ -1045,6 +1074,17 @@ void testComponentPathNames()
     top.printSubcomponentInfo();
     top.printOutputInfo();
     top.connect();
+
+    // Lookups remain correct if a subcomponent is renamed after its path
+    // was resolved.
+    ASSERT(&top.getComponent<Foo>("/Top/F/Foo2") ==
+           &F->getComponent<Foo>("Foo2"));
+    F->updComponent<Foo>("Foo2").setName("Foo2renamed");
+    ASSERT(top.hasComponent<Foo>("/Top/F/Foo2renamed"));
+    ASSERT(!top.hasComponent("/Top/F/Foo2"));
+    F->updComponent<Foo>("Foo2renamed").setName("Foo2");
+    ASSERT(top.hasComponent<Foo>("/Top/F/Foo2"));
+    ASSERT(!top.hasComponent<Bar>("/Top/F/Foo2"));
 }
 
 void testGetStateVariableValue() {
@@ -1080,6 +1120,98 @@ void testGetStateVariableValue() {
     SimTK_TEST_MUST_THROW_EXC(
             top.getStateVariableValue(s, "typo/b/subState"),
             OpenSim::Exception);
+
+    // Access through handles resolved once.
+    auto hA = top.getStateVariableHandle("a/subState");
+    auto hB = a->getStateVariableHandle("b/subState");
+    SimTK_TEST(hA.isValid());
+    SimTK_TEST(top.getStateVariableValue(s, hA) == 20);
+    SimTK_TEST(a->getStateVariableValue(s, hB) == 30);
+    top.setStateVariableValue(s, hA, 25);
+    SimTK_TEST(top.getStateVariableValue(s, "a/subState") == 25);
+
+    std::vector<Component::StateVariableHandle> handles{
+        top.getStateVariableHandle("a/b/subState"),
+        top.getStateVariableHandle("internalSub/subState"),
+        hA};
+    SimTK::Vector values;
+    top.getStateVariableValues(s, handles, values);
+    SimTK_TEST(values.size() == 3);
+    SimTK_TEST(values[0] == 30 && values[1] == 10 && values[2] == 25);
+    values[2] = 20;
+    top.setStateVariableValues(s, handles, values);
+    SimTK_TEST(s.getY()[1] == 20);
+
+    // Derivatives through handles.
+    s.updTime() = 0.5;
+    system.realize(s, Stage::Dynamics);
+    SimTK_TEST_EQ(a->getStateVariableDerivativeValue(s, hB), exp(-1.0));
+    SimTK_TEST_EQ(a->getStateVariableDerivativeValue(s, hB),
+                  a->getStateVariableDerivativeValue(s, "b/subState"));
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableDerivativeValue(s,
+            Component::StateVariableHandle()), OpenSim::Exception);
+
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            top.getStateVariableValue(s, Component::StateVariableHandle()),
+            OpenSim::Exception);
+}
+
+// Component that accesses its cache variable through a handle.
+class CacheHolder : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(CacheHolder, Component);
+public:
+    double getSquaredTime(const SimTK::State& s) const {
+        if (!isCacheVariableValid(s, _squaredTimeCV)) {
+            ++numEvaluations;
+            setCacheVariableValue(s, _squaredTimeCV,
+                                  s.getTime() * s.getTime());
+        }
+        return getCacheVariableValue(s, _squaredTimeCV);
+    }
+    mutable int numEvaluations = 0;
+private:
+    void extendAddToSystem(MultibodySystem& system) const override {
+        Super::extendAddToSystem(system);
+        _squaredTimeCV = addCacheVariable("squaredTime", 0.0, Stage::Time);
+    }
+    mutable CacheVariable<double> _squaredTimeCV;
+};
+
+void testCacheVariableHandles() {
+    TheWorld top;
+    top.setName("top");
+    CacheHolder* holder = new CacheHolder();
+    holder->setName("holder");
+    top.add(holder);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+    system.realize(s, Stage::Time);
+
+    s.setTime(2.0);
+    system.realize(s, Stage::Time);
+    SimTK_TEST(holder->getSquaredTime(s) == 4.0);
+    SimTK_TEST(holder->getSquaredTime(s) == 4.0);
+    SimTK_TEST(holder->numEvaluations == 1);
+
+    // The handle and the name refer to the same cache entry.
+    SimTK_TEST(holder->isCacheVariableValid(s, "squaredTime"));
+    SimTK_TEST(holder->getCacheVariableValue<double>(s, "squaredTime") == 4.0);
+
+    // Changing time invalidates the cache variable.
+    s.setTime(3.0);
+    system.realize(s, Stage::Time);
+    SimTK_TEST(holder->getSquaredTime(s) == 9.0);
+    SimTK_TEST(holder->numEvaluations == 2);
+
+    // A default-constructed handle does not refer to any cache variable.
+    CacheVariable<double> unallocated;
+    SimTK_TEST(!unallocated.isValid());
+    SimTK_TEST_MUST_THROW_EXC(holder->getCacheVariableValue(s, unallocated),
+                              OpenSim::Exception);
 }
 
 void testInputOutputConnections()
@@ -1636,6 +1768,31 @@ void testTableSource() {
 
     std::cout << "Report: " << std::endl;
     std::cout << report << std::endl;
+
+    // The outputs of TableSource refer to the row in the State's cache rather
+    // than returning copies.
+    {
+        const auto& allColumns = dynamic_cast<const Output<Vector>&>(
+                tableSource->getOutput("all_columns"));
+        const auto& column = dynamic_cast<const Output<double>&>(
+                tableSource->getOutput("column"));
+        SimTK_TEST(allColumns.isValueByReference());
+        SimTK_TEST(column.isValueByReference());
+
+        s.setTime(0.6);
+        system.realize(s, Stage::Time);
+        const Vector& rowValue = allColumns.getValue(s);
+        SimTK_TEST(&allColumns.getValue(s) == &rowValue);
+        SimTK_TEST_EQ(rowValue, Vector(4, 2.4));
+        const auto& chan2 = column.getChannels().at("2");
+        SimTK_TEST(&chan2.getValue(s) == &rowValue[2]);
+
+        // A new time invalidates the row.
+        s.setTime(0.25);
+        system.realize(s, Stage::Time);
+        SimTK_TEST_EQ(allColumns.getValue(s), Vector(4, 1.0));
+        SimTK_TEST_EQ(chan2.getValue(s), 1.0);
+    }
 }
 
 void testTableReporter() {
@@ -1688,6 +1845,50 @@ void testTableReporter() {
     }
 }
 
+void testOutputBatch() {
+    TheWorld world;
+    Foo* foo = new Foo();
+    foo->setName("foo");
+    world.add(foo);
+
+    MultibodySystem system;
+    world.buildUpSystem(system);
+    SimTK::State s = system.realizeTopology();
+    s.setTime(0.5);
+
+    const auto& output1 = dynamic_cast<const Output<double>&>(
+            foo->getOutput("Output1"));
+    const auto& output3 = dynamic_cast<const Output<double>&>(
+            foo->getOutput("Output3"));
+
+    OutputBatch<double> batch;
+    batch.addOutput(output3);
+    batch.addChannel(output1.getChannels().at(""));
+    batch.addOutput(output3);
+    SimTK_TEST(batch.getNumChannels() == 3);
+    SimTK_TEST(batch.getDependsOnStage() == SimTK::Stage::Time);
+    SimTK_TEST(&batch.getChannel(1).getOutput() == &output1);
+    SimTK_TEST_MUST_THROW_EXC(batch.getChannel(3), IndexOutOfRange);
+
+    system.realize(s, SimTK::Stage::Time);
+    SimTK::RowVector row;
+    batch.getValues(s, row);
+    SimTK_TEST(row.size() == 3);
+    // Values are in the order in which the channels were added.
+    SimTK_TEST(row[0] == output3.getValue(s));
+    SimTK_TEST(row[1] == output1.getValue(s));
+    SimTK_TEST(row[2] == row[0]);
+
+    SimTK::Vector values;
+    batch.getValues(s, values);
+    SimTK_TEST_EQ(values, ~row);
+
+    batch.clear();
+    SimTK_TEST(batch.getNumChannels() == 0);
+    batch.getValues(s, values);
+    SimTK_TEST(values.size() == 0);
+}
+
 const std::string dataFileNameForInputConnecteeSerialization =
         "testComponentInterface_testInputConnecteeSerialization_data.sto";
 
@@ -2106,6 +2307,7 @@ int main() {
         SimTK_SUBTEST(testListSockets);
         SimTK_SUBTEST(testComponentPathNames);
         SimTK_SUBTEST(testGetStateVariableValue);
+        SimTK_SUBTEST(testCacheVariableHandles);
         SimTK_SUBTEST(testInputOutputConnections);
         SimTK_SUBTEST(testInputConnecteeNames);
         SimTK_SUBTEST(testExceptionsForConnecteeTypeMismatch);
@@ -2114,6 +2316,7 @@ int main() {
         SimTK_SUBTEST(testExceptionsOutputNameExistsAlready);
         SimTK_SUBTEST(testTableSource);
         SimTK_SUBTEST(testTableReporter);
+        SimTK_SUBTEST(testOutputBatch);
         SimTK_SUBTEST(testAliasesAndLabels);
     
         writeTimeSeriesTableForInputConnecteeSerialization();
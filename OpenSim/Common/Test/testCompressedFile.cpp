@@ -0,0 +1,112 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testCompressedFile.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Adapters.h>
+#include <OpenSim/Common/CompressedFile.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace OpenSim;
+using namespace std;
+
+string readText(istream& stream)
+{
+    stringstream text;
+    text << stream.rdbuf();
+    return text.str();
+}
+
+void testFileNames()
+{
+    ASSERT(CompressedFile::isCompressedFileName("results.sto.gz"));
+    ASSERT(CompressedFile::isCompressedFileName("RESULTS.MOT.GZ"));
+    ASSERT(!CompressedFile::isCompressedFileName("results.sto"));
+    ASSERT(!CompressedFile::isCompressedFileName(".gz"));
+    ASSERT(CompressedFile::removeCompressionExtension("a/b.trc.gz") ==
+           "a/b.trc");
+    ASSERT(CompressedFile::removeCompressionExtension("b.trc") == "b.trc");
+}
+
+// Tables and storages written compressed read back as if they were not.
+void testReadWrite()
+{
+    // Large enough for several blocks, compressed concurrently.
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c"});
+    for (int i = 0; i < 40000; ++i)
+        table.appendRow(0.001*i, {sin(0.01*i), 1.0/(i + 1), double(i)});
+    IO::SetNumWriterThreads(4);
+    STOFileAdapter::write(table, "testCompressedFile.sto.gz");
+    IO::SetNumWriterThreads(1);
+    STOFileAdapter::write(table, "testCompressedFile.sto");
+
+    // The decompressed file is the uncompressed file.
+    ifstream plain("testCompressedFile.sto");
+    const string text = readText(plain);
+    auto decompressed =
+            CompressedFile::openForReading("testCompressedFile.sto.gz");
+    ASSERT(readText(*decompressed) == text);
+    ifstream compressed("testCompressedFile.sto.gz", ios::binary);
+    ASSERT(readText(compressed).size() < text.size() / 2);
+
+    auto reread = STOFileAdapter::read("testCompressedFile.sto.gz");
+    ASSERT(reread.getNumRows() == table.getNumRows());
+    ASSERT(reread.getMatrix()(12345, 1) == table.getMatrix()(12345, 1));
+    auto tables = FileAdapter::readFile("testCompressedFile.sto.gz");
+    ASSERT(tables.at("table")->getNumRows() == table.getNumRows());
+
+    Storage storage("std_subject01_walk1_ik.mot");
+    storage.print("testCompressedFile.mot.gz");
+    storage.print("testCompressedFile.mot");
+    Storage compressedStorage("testCompressedFile.mot.gz");
+    ASSERT(compressedStorage.getSize() == storage.getSize());
+    ASSERT(compressedStorage.isInDegrees() == storage.isInDegrees());
+    ifstream plainStorage("testCompressedFile.mot");
+    ASSERT(readText(plainStorage) == readText(
+            *CompressedFile::openForReading("testCompressedFile.mot.gz")));
+
+    ASSERT(!CompressedFile::openForReading("missing.sto.gz")->good());
+}
+
+int main()
+{
+    try {
+        testFileNames();
+        if (CompressedFile::isSupported()) {
+            testReadWrite();
+        } else {
+            ASSERT_THROW(OpenSim::Exception,
+                    CompressedFile::openForReading("results.sto.gz"));
+        }
+    } catch (const std::exception& e) {
+        cout << "testCompressedFile FAILED: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -141,6 +141,33 @@ int main() {
     ASSERT(table.hasColumn(2));
     ASSERT(!table.hasColumn(100));
 
+    // The index of labels follows the dependents metadata.
+    ASSERT(table.getColumnIndex("5") == 4);
+    ASSERT(!table.hasColumn("0"));
+    table.setColumnLabel(4, "five");
+    ASSERT(table.hasColumn("five") && !table.hasColumn("5"));
+    ASSERT(table.getColumnIndex("five") == 4);
+    SimTK_TEST_MUST_THROW_EXC(table.getColumnIndex("5"), KeyNotFound);
+    {
+        TimeSeriesTable copy{table};
+        copy.setColumnLabels({"a", "b", "a", "d", "e"});
+        ASSERT(copy.getColumnIndex("a") == 0);
+        ASSERT(copy.getColumnIndex("e") == 4);
+        ASSERT(table.getColumnIndex("five") == 4);
+        ASSERT(!table.hasColumn("a"));
+        copy.removeDependentsMetaDataForKey("labels");
+        ASSERT(!copy.hasColumnLabels());
+        copy.setDependentsMetaData(table.getDependentsMetaData());
+        ASSERT(copy.getColumnIndex("five") == 4);
+
+        TimeSeriesTable columns{};
+        columns.setColumnLabels({"x"});
+        columns.appendRow(0, RowVector(1, 1.0));
+        columns.appendColumn("y", columns.getDependentColumnAtIndex(0));
+        ASSERT(columns.getColumnIndex("y") == 1);
+    }
+    table.setColumnLabel(4, "5");
+
     // Print out the DataTable to console.
     std::cout << table << std::endl;
     std::cout << table.toString({}, {"1", "4"});
@@ -701,5 +728,229 @@ int main() {
         std::cout << tableSVec << std::endl;
     }
 
+    {
+        std::cout << "Test appending many rows, with reads in between."
+                  << std::endl;
+        TimeSeriesTable table{};
+        table.setColumnLabels({"c0", "c1"});
+        table.reserveRows(1000);
+        for(int r = 0; r < 2000; ++r) {
+            table.appendRow(0.01 * r, {double(r), -double(r)});
+            ASSERT(table.getNumRows() == size_t(r + 1));
+            if(r % 300 == 0) {
+                // Reading and writing sees all rows appended so far.
+                ASSERT(table.getRowAtIndex(r)[1] == -r);
+                ASSERT(table.getMatrix().nrow() == r + 1);
+                table.updMatrix()(r, 0) = 10 * r;
+            }
+        }
+        ASSERT(table.getMatrix().nrow() == 2000);
+        ASSERT(table.getDependentColumn("c1")[1999] == -1999);
+        ASSERT(table.getRowAtIndex(600)[0] == 6000);
+        ASSERT(table.getRowAtIndex(601)[0] == 601);
+        ASSERT(table.getIndependentColumn()[1999] == 0.01 * 1999);
+        ASSERT_THROW(IncorrectNumColumns,
+                     table.appendRow(100, {1.0, 2.0, 3.0}));
+        ASSERT(table.getNumRows() == 2000);
+        ASSERT_THROW(TimestampLessThanEqualToPrevious,
+                     table.appendRow(1, {1.0, 2.0}));
+        ASSERT(table.getNumRows() == 2000);
+        TimeSeriesTable tableCopy{table};
+        table.appendRow(100, {1.0, 2.0});
+        ASSERT(tableCopy.getNumRows() == 2000);
+        ASSERT(table.getRowAtIndex(2000)[1] == 2.0);
+
+        std::cout << "Test that dependent columns are contiguous."
+                  << std::endl;
+        const auto column = table.getDependentColumn("c1");
+        ASSERT(column.size() == 2001);
+        ASSERT(&column[2000] - &column[0] == 2000);
+        ASSERT(column[5] == -5);
+    }
+
+    {
+        std::cout << "Test finding the row index for a time." << std::endl;
+        TimeSeriesTable uniform{}, nonuniform{};
+        for(int r = 0; r < 100; ++r) {
+            uniform.appendRow(0.01 * r, {double(r)});
+            nonuniform.appendRow(0.01 * r * r, {double(r)});
+        }
+        for(const auto* table : {&uniform, &nonuniform}) {
+            const auto& times = table->getIndependentColumn();
+            size_t hint{0};
+            for(int i = -10; i < 1100; ++i) {
+                const double time = times.back() * i / 1000.0;
+                const size_t expected = std::distance(times.begin(),
+                        std::lower_bound(times.begin(), times.end(), time));
+                ASSERT(table->getRowIndexAtOrAfterTime(time) == expected);
+                ASSERT(table->getRowIndexAtOrAfterTime(time, 57) == expected);
+                hint = table->getRowIndexAtOrAfterTime(time, hint);
+                ASSERT(hint == expected);
+            }
+            for(size_t r = 0; r < times.size(); ++r) {
+                ASSERT(table->getRowIndexAtOrAfterTime(times[r]) == r);
+                ASSERT(table->getNearestRowIndexForTime(times[r]) == r);
+            }
+        }
+        ASSERT(nonuniform.getNearestRowIndexForTime(0.015) == 1);
+        ASSERT(nonuniform.getNearestRowIndexForTime(0.026) == 2);
+        ASSERT(uniform.getNearestRowIndexForTime(5, false) == 99);
+        ASSERT(TimeSeriesTable{}.getRowIndexAtOrAfterTime(1) == 0);
+    }
+
+    {
+        std::cout << "Test flattening and packing many rows." << std::endl;
+        TimeSeriesTableVec3 table{};
+        table.setColumnLabels({"m0", "m1", "m2"});
+        for(int r = 0; r < 500; ++r)
+            table.appendRow(0.01 * r, {Vec3(r, -r, 0.5 * r), Vec3(1, 2, r),
+                                       Vec3(SimTK::NaN, r, 3)});
+        // Rows still to be added to the matrix are flattened too.
+        const TimeSeriesTable flat{table.flatten({"_x", "_y", "_z"})};
+        ASSERT(flat.getNumRows() == 500 && flat.getNumColumns() == 9);
+        ASSERT(flat.getColumnLabel(7) == "m2_y");
+        ASSERT(flat.getIndependentColumn() == table.getIndependentColumn());
+        const TimeSeriesTableVec3 packed{flat.pack<Vec3>()};
+        ASSERT(packed.getColumnLabels() == table.getColumnLabels());
+        for(int r : {0, 1, 250, 499}) {
+            ASSERT(flat.getRowAtIndex(r)[2] == 0.5 * r);
+            ASSERT(flat.getRowAtIndex(r)[5] == r);
+            ASSERT(SimTK::isNaN(flat.getRowAtIndex(r)[6]));
+            for(int c = 0; c < 2; ++c)
+                ASSERT(packed.getRowAtIndex(r)[c] ==
+                       table.getRowAtIndex(r)[c]);
+        }
+        ASSERT(packed.getRowAtIndex(499)[2][1] == 499);
+        DataTable unsorted{};
+        unsorted.setColumnLabels({"a"});
+        unsorted.appendRow(1, {0.0});
+        unsorted.appendRow(0, {0.0});
+        ASSERT_THROW(TimeColumnNotIncreasing,
+                     TimeSeriesTable(std::move(unsorted)));
+    }
+
+    {
+        std::cout << "Test views of a time range and columns." << std::endl;
+        TimeSeriesTableVec3 table{};
+        table.setColumnLabels({"a", "b", "c", "d"});
+        table.addTableMetaData("Units", std::string{"mm"});
+        for(int r = 0; r < 10; ++r)
+            table.appendRow(0.1 * r, {Vec3(r, 0, 0), Vec3(r, 1, 0),
+                                      Vec3(r, 2, 0), Vec3(r, 3, 0)});
+
+        TimeSeriesTableViewVec3 whole{table};
+        ASSERT(whole.getNumRows() == 10 && whole.getNumColumns() == 4);
+        ASSERT(whole.getColumnLabels() == table.getColumnLabels());
+
+        // Times need not be in the table; the range is inclusive.
+        TimeSeriesTableViewVec3 view{table, 0.25, 0.75, {"d", "b"}};
+        ASSERT(view.getNumRows() == 5 && view.getNumColumns() == 2);
+        ASSERT(view.getRowIndexInTable(0) == 3);
+        ASSERT(view.getColumnIndexInTable(0) == 3);
+        ASSERT(view.getTimeAtIndex(4) == table.getIndependentColumn()[7]);
+        ASSERT(view.getColumnLabels() ==
+               std::vector<std::string>({"d", "b"}));
+        ASSERT(&view.getElementAtIndex(1, 1) == &table.getMatrix()(4, 1));
+        ASSERT(view.getRowAtIndex(2)[0] == Vec3(5, 3, 0));
+        ASSERT_THROW(RowIndexOutOfRange, view.getRowAtIndex(5));
+        ASSERT_THROW(ColumnIndexOutOfRange, view.getElementAtIndex(0, 2));
+        ASSERT(TimeSeriesTableViewVec3(table, 5, 6).getNumRows() == 0);
+        ASSERT_THROW(InvalidTimeRange,
+                     TimeSeriesTableViewVec3(table, 0.5, 0.4));
+        ASSERT_THROW(KeyNotFound,
+                     TimeSeriesTableViewVec3(table, {"a", "e"}));
+
+        // Copies of the data in the view.
+        const auto copy = view.toTable();
+        ASSERT(copy.getNumRows() == 5 && copy.getNumColumns() == 2);
+        ASSERT(copy.getColumnLabels() == view.getColumnLabels());
+        ASSERT(copy.getTableMetaData<std::string>("Units") == "mm");
+        ASSERT(copy.getIndependentColumn()[0] == table.getIndependentColumn()[3]);
+        ASSERT(copy.getRowAtIndex(4)[1] == Vec3(7, 1, 0));
+        const auto flat = view.flatten({".x", ".y", ".z"});
+        ASSERT(flat.getNumRows() == 5 && flat.getNumColumns() == 6);
+        ASSERT(flat.getColumnLabel(4) == "b.y");
+        ASSERT(flat.getRowAtIndex(0)[3] == 3);
+        ASSERT(flat.getRowAtIndex(0)[1] == 3);
+        ASSERT(view.flatten().getColumnLabel(0) == "d_1");
+        const auto wholeCopy = whole.toTable();
+        ASSERT(wholeCopy.getMatrix().nrow() == 10);
+        ASSERT(wholeCopy.getRowAtIndex(9)[3] == Vec3(9, 3, 0));
+
+        // A view sees the rows appended to the table after it was made.
+        table.appendRow(1.0, {Vec3(10), Vec3(10), Vec3(10), Vec3(10)});
+        ASSERT(view.getRowAtIndex(0)[1] == Vec3(3, 1, 0));
+        ASSERT(whole.getNumRows() == 10);
+    }
+
+    {
+        std::cout << "Test arithmetic and integration of tables." << std::endl;
+        TimeSeriesTable table{};
+        table.setColumnLabels({"a", "b", "c"});
+        TimeSeriesTable weights{};
+        weights.setColumnLabels({"w"});
+        for(int r = 0; r < 100; ++r) {
+            const double t = 0.01 * r;
+            table.appendRow(t, {t, 2 * t, 3.});
+            weights.appendRow(t, {1 + t});
+        }
+
+        // Tables broadcast across columns; rows broadcast across rows.
+        TimeSeriesTable result{table};
+        result.add(table);
+        result.subtract(RowVector{3, 1.0});
+        result.multiply(weights);
+        result.divide(RowVector{3, 2.0});
+        for(int r = 0; r < 100; r += 9) {
+            for(int c = 0; c < 3; ++c) {
+                const double value = table.getMatrix()(r, c);
+                const double weight = weights.getMatrix()(r, 0);
+                ASSERT_EQUAL((2 * value - 1) * weight / 2,
+                             result.getMatrix()(r, c), 1e-14);
+            }
+        }
+        TimeSeriesTable_<Vec3> vectors{};
+        vectors.setColumnLabels({"p", "q"});
+        for(int r = 0; r < 100; ++r)
+            vectors.appendRow(0.01 * r, {Vec3(r), Vec3(1, 2, 3)});
+        vectors.multiply(weights);
+        vectors.add(RowVector_<Vec3>{2, Vec3(1)});
+        ASSERT_EQUAL(Vec3(50 * 1.5 + 1), vectors.getRowAtIndex(50)[0], 1e-13);
+        ASSERT_EQUAL(Vec3(1.5 + 1, 3 + 1, 4.5 + 1),
+                     vectors.getRowAtIndex(50)[1], 1e-13);
+
+        ASSERT_THROW(IncorrectNumColumns, result.add(RowVector{2, 1.0}));
+        TimeSeriesTable shorter{table};
+        shorter.removeRowAtIndex(99);
+        ASSERT_THROW(IncorrectNumRows, result.add(shorter));
+        TimeSeriesTable twoColumns{}, shifted{};
+        twoColumns.setColumnLabels({"a", "b"});
+        shifted.setColumnLabels({"w"});
+        for(int r = 0; r < 100; ++r) {
+            twoColumns.appendRow(0.01 * r, {1., 1.});
+            shifted.appendRow(0.01 * r + 0.001, {1.});
+        }
+        ASSERT_THROW(IncorrectNumColumns, result.add(twoColumns));
+        ASSERT_THROW(InvalidTable, result.multiply(shifted));
+
+        // The trapezoidal rule is exact for linear columns.
+        const auto integral = table.integrate();
+        ASSERT(integral.getColumnLabels() == table.getColumnLabels());
+        ASSERT(integral.getIndependentColumn() ==
+               table.getIndependentColumn());
+        ASSERT(integral.getMatrix()(0, 1) == 0);
+        for(int r = 0; r < 100; r += 11) {
+            const double t = table.getIndependentColumn()[r];
+            ASSERT_EQUAL(t * t / 2, integral.getMatrix()(r, 0), 1e-14);
+            ASSERT_EQUAL(t * t, integral.getMatrix()(r, 1), 1e-14);
+            ASSERT_EQUAL(3 * t, integral.getMatrix()(r, 2), 1e-14);
+        }
+
+        // The average of the rows in a time range, inclusive.
+        const auto average = table.averageRow(0.095, 0.305);
+        ASSERT_EQUAL(0.2, average[0], 1e-14);
+        ASSERT_EQUAL(3., average[2], 1e-14);
+    }
+
     return 0;
 }
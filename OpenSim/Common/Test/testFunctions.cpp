@@ -24,9 +24,14 @@
 #include <OpenSim/Common/Sine.h>
 #include <OpenSim/Common/SignalGenerator.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/SimmSpline.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/LinearFunction.h>
 
 #include "ComponentsForTesting.h"
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace SimTK;
 
@@ -74,9 +79,61 @@ void testSignalGenerator() {
     }
 }
 
+void testIntervalLookup() {
+    // Evaluating at arguments that move a little, jump, or go backwards (so
+    // that the interval found last is reused, or is not) gives the values of
+    // a fresh copy of the function, which does a binary search.
+    const int n = 10;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.1 * i * i;
+        y[i] = std::sin(x[i]);
+    }
+    SimmSpline spline(n, x, y);
+    PiecewiseLinearFunction linear(n, x, y);
+
+    std::vector<double> args;
+    for (int i = 0; i <= 200; ++i) args.push_back(0.05 * i - 0.5);
+    for (int i = 200; i >= 0; --i) args.push_back(0.05 * i - 0.5);
+    for (const double arg : {7.9, 0.05, 8.1, 0.0, 3.6, 3.6, 0.4, 8.0})
+        args.push_back(arg);
+
+    const std::vector<int> first{0}, second{0, 0};
+    for (const double arg : args) {
+        const Vector xv(1, arg);
+        SimmSpline freshSpline(spline);
+        PiecewiseLinearFunction freshLinear(linear);
+        SimTK_TEST_EQ(spline.calcValue(xv), freshSpline.calcValue(xv));
+        SimTK_TEST_EQ(spline.calcDerivative(first, xv),
+                      freshSpline.calcDerivative(first, xv));
+        SimTK_TEST_EQ(spline.calcDerivative(second, xv),
+                      freshSpline.calcDerivative(second, xv));
+        SimTK_TEST_EQ(linear.calcValue(xv), freshLinear.calcValue(xv));
+        // Evaluating at a scalar gives the same values.
+        SimTK_TEST_EQ(spline.calcValue(arg), freshSpline.calcValue(xv));
+        SimTK_TEST_EQ(linear.calcValue(arg), freshLinear.calcValue(xv));
+        // The slope is discontinuous at the points.
+        if (std::find(x, x + n, arg) == x + n) {
+            SimTK_TEST_EQ(linear.calcDerivative(first, xv),
+                          freshLinear.calcDerivative(first, xv));
+        }
+    }
+}
+
+void testScalarArgument() {
+    // A function without its own scalar evaluation gives the values of
+    // calcValue() with a Vector.
+    const LinearFunction line(2.0, -1.0);
+    const OpenSim::Function& f = line;
+    for (const double arg : {-1.5, 0.0, 0.25, 3.0})
+        SimTK_TEST_EQ(f.calcValue(arg), f.calcValue(Vector(1, arg)));
+}
+
 int main() {
 
     SimTK_START_TEST("testSignalGenerator");
         SimTK_SUBTEST(testSignalGenerator);
+        SimTK_SUBTEST(testIntervalLookup);
+        SimTK_SUBTEST(testScalarArgument);
     SimTK_END_TEST();
 }
@@ -22,8 +22,12 @@
 
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
+#include <cstdio>
+#include <fstream>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -82,6 +86,111 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // The splines of a Storage match those of the equivalent table.
+        Storage storage;
+        Array<std::string> labels("", 4);
+        labels[0] = "time";
+        labels[1] = "a"; labels[2] = "b"; labels[3] = "c";
+        storage.setColumnLabels(labels);
+        for (int i = 0; i < size; ++i) {
+            double row[3] = {y[i], 2 * y[i], x[i] * x[i]};
+            storage.append(x[i], 3, row);
+        }
+        GCVSplineSet storageSplines(5, &storage);
+        GCVSplineSet tableSplines(storage.exportToTable());
+        ASSERT(storageSplines.getSize() == 3);
+        ASSERT(tableSplines.getSize() == 3);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT(storageSplines.get(j).getName() == labels[j + 1]);
+            for (int i = 0; i < (2*size-1); ++i) {
+                t[0] = dt / 2 * i;
+                ASSERT_EQUAL(tableSplines.get(j).calcValue(t),
+                    storageSplines.get(j).calcValue(t),
+                    SimTK::Eps, __FILE__, __LINE__,
+                    "GCVSplineSet from a Storage differs from that of a "
+                    "table.");
+            }
+        }
+        cout << "GCVSplineSet of a Storage matches that of a table." << endl;
+
+        // Evaluating all splines at once matches evaluating them one by one.
+        SimTK::Vector values, firstDerivs, secondDerivs, derivs;
+        for (int i = 0; i < size; i += 7) {
+            storageSplines.evaluateAll(x[i], values, firstDerivs,
+                                       secondDerivs);
+            storageSplines.evaluateAll(x[i], 1, derivs);
+            ASSERT(values.size() == 3 && derivs.size() == 3);
+            for (int j = 0; j < 3; ++j) {
+                ASSERT(values[j] == storageSplines.evaluate(j, 0, x[i]));
+                ASSERT(firstDerivs[j] == storageSplines.evaluate(j, 1, x[i]));
+                ASSERT(secondDerivs[j] ==
+                       storageSplines.evaluate(j, 2, x[i]));
+                ASSERT(derivs[j] == firstDerivs[j]);
+            }
+        }
+        cout << "GCVSplineSet::evaluateAll() matches evaluate()." << endl;
+
+        // Fitting many splines in parallel gives the same fits as fitting
+        // them one after another.
+        Storage large;
+        Array<std::string> largeLabels("time", 1);
+        const int nLargeColumns = 40, nLargeRows = 2000;
+        for (int j = 0; j < nLargeColumns; ++j)
+            largeLabels.append("q" + std::to_string(j));
+        large.setColumnLabels(largeLabels);
+        std::vector<double> largeRow(nLargeColumns);
+        for (int i = 0; i < nLargeRows; ++i) {
+            const double time = 0.001 * i;
+            for (int j = 0; j < nLargeColumns; ++j)
+                largeRow[j] = sin(omega * (j + 1) * time) + 0.01 * (i % 7);
+            large.append(time, nLargeColumns, largeRow.data());
+        }
+        GCVSplineSet::setNumThreadsForFitting(1);
+        GCVSplineSet serialSplines(5, &large, 1e-4);
+        GCVSplineSet::setNumThreadsForFitting(4);
+        GCVSplineSet parallelSplines(5, &large, 1e-4);
+        GCVSplineSet::setNumThreadsForFitting(0);
+        ASSERT(parallelSplines.getSize() == nLargeColumns);
+        for (int j = 0; j < nLargeColumns; ++j) {
+            const Array<double>& serial =
+                serialSplines.getGCVSpline(j)->getCoefficients();
+            const Array<double>& parallel =
+                parallelSplines.getGCVSpline(j)->getCoefficients();
+            ASSERT(serial.getSize() == nLargeRows);
+            ASSERT(serial == parallel);
+        }
+        cout << "GCVSplineSet fits splines in parallel." << endl;
+
+        // Fits are read from the cache when the same data are fit again.
+        GCVSplineSet::setCacheDirectory(".");
+        GCVSplineSet firstRun(5, &storage);
+        std::vector<std::string> cacheFiles;
+        for (int j = 0; j < firstRun.getSize(); ++j) {
+            cacheFiles.push_back(
+                GCVSplineSet::getCacheFileName(*firstRun.getGCVSpline(j)));
+            ASSERT(std::ifstream(cacheFiles.back()).good());
+        }
+        GCVSplineSet secondRun(5, &storage);
+        GCVSplineSet::setCacheDirectory("");
+        ASSERT(GCVSplineSet::getCacheFileName(*firstRun.getGCVSpline(0))
+               .empty());
+        for (int j = 0; j < secondRun.getSize(); ++j) {
+            ASSERT(secondRun.getGCVSpline(j)->getCoefficients() ==
+                   storageSplines.getGCVSpline(j)->getCoefficients());
+            for (int i = 0; i < (2*size-1); ++i) {
+                t[0] = dt / 2 * i;
+                ASSERT_EQUAL(storageSplines.get(j).calcValue(t),
+                    secondRun.get(j).calcValue(t),
+                    SimTK::Eps, __FILE__, __LINE__,
+                    "GCVSpline read from the cache differs from its fit.");
+            }
+        }
+        for (const auto& cacheFile : cacheFiles)
+            std::remove(cacheFile.c_str());
+        ASSERT_THROW(Exception,
+                     spline2.setFitCoefficients(Array<double>(0.0, 3)));
+        cout << "GCVSplineSet caches fits." << endl;
     }
     catch(const Exception& e) {
         e.print(cerr);
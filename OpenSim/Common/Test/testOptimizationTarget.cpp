@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testOptimizationTarget.cpp              *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/OptimizationTarget.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <cmath>
+
+using namespace OpenSim;
+using namespace std;
+using SimTK::Vector;
+
+// f(x) = sum_i w*x_i^3, with the constraints c_j(x) = w*x_j*x_{j+1}; w is a
+// weight that copies get from the original in prepareThreadCopy().
+class CubicTarget : public OptimizationTarget {
+public:
+    explicit CubicTarget(int nx, bool copyable) :
+            OptimizationTarget(nx), _copyable(copyable) {
+        setNumEqualityConstraints(nx - 1);
+        _dx.setSize(nx);
+        for (int i = 0; i < nx; ++i) _dx[i] = 1e-4;
+    }
+    int objectiveFunc(const Vector& x, bool, double& f) const override {
+        ++_numObjectiveEvaluations;
+        f = 0;
+        for (int i = 0; i < x.size(); ++i) f += weight*std::pow(x[i], 3);
+        return 0;
+    }
+    int constraintFunc(const Vector& x, bool, Vector& c) const override {
+        ++_numConstraintEvaluations;
+        for (int j = 0; j < c.size(); ++j) c[j] = weight*x[j]*x[j+1];
+        return 0;
+    }
+    int gradientFunc(const Vector& x, bool, Vector& g) const override {
+        return CentralDifferences(this, &_dx[0], x, g);
+    }
+    int constraintJacobian(const Vector& x, bool,
+                           SimTK::Matrix& J) const override {
+        return CentralDifferencesConstraint(this, &_dx[0], x, J);
+    }
+    OptimizationTarget* createThreadCopy() const override {
+        if (!_copyable) return nullptr;
+        return new CubicTarget(getNumParameters(), true);
+    }
+    void prepareThreadCopy(OptimizationTarget& copy) const override {
+        static_cast<CubicTarget&>(copy).weight = weight;
+    }
+    double weight = 1;
+private:
+    bool _copyable;
+};
+
+void testConcurrentDifferences()
+{
+    const int nx = 23;
+    Vector x(nx);
+    for (int i = 0; i < nx; ++i) x[i] = 0.1*i - 1;
+
+    // Serial results.
+    CubicTarget serial(nx, true);
+    serial.weight = 2;
+    Vector g0(nx), gf0(nx);
+    SimTK::Matrix J0(nx - 1, nx);
+    serial.gradientFunc(x, true, g0);
+    serial.constraintJacobian(x, true, J0);
+    OptimizationTarget::ForwardDifferences(&serial, serial.getDXArray(), x,
+                                           gf0);
+    ASSERT(serial.getNumObjectiveEvaluations() == 2*nx + 1 + nx);
+    ASSERT(serial.getNumConstraintEvaluations() == 2*nx);
+    for (int i = 0; i < nx; ++i) ASSERT_EQUAL(6*x[i]*x[i], g0[i], 1e-6);
+
+    // Targets that can be copied evaluate concurrently, with the same
+    // results and the same number of evaluations.
+    for (int numThreads : {2, 4, 0}) {
+        CubicTarget target(nx, true);
+        target.weight = 2;
+        target.setNumDifferenceThreads(numThreads);
+        Vector g(nx), gf(nx);
+        SimTK::Matrix J(nx - 1, nx);
+        target.gradientFunc(x, true, g);
+        target.constraintJacobian(x, true, J);
+        OptimizationTarget::ForwardDifferences(&target, target.getDXArray(), x,
+                                               gf);
+        for (int i = 0; i < nx; ++i) {
+            ASSERT(g[i] == g0[i] && gf[i] == gf0[i]);
+            for (int j = 0; j < nx - 1; ++j) ASSERT(J(j, i) == J0(j, i));
+        }
+        ASSERT(target.getNumObjectiveEvaluations() == 2*nx + 1 + nx);
+        ASSERT(target.getNumConstraintEvaluations() == 2*nx);
+
+        // The copies are prepared again for each evaluation.
+        target.weight = 3;
+        target.gradientFunc(x, true, g);
+        for (int i = 0; i < nx; ++i) ASSERT_EQUAL(9*x[i]*x[i], g[i], 1e-6);
+    }
+
+    // Other targets are evaluated serially.
+    CubicTarget single(nx, false);
+    single.weight = 2;
+    single.setNumDifferenceThreads(4);
+    Vector g(nx);
+    single.gradientFunc(x, true, g);
+    for (int i = 0; i < nx; ++i) ASSERT(g[i] == g0[i]);
+}
+
+int main()
+{
+    try {
+        testConcurrentDifferences();
+    } catch (const std::exception& e) {
+        cout << "testOptimizationTarget FAILED: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
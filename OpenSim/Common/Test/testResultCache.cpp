@@ -0,0 +1,115 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  testResultCache.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/ResultCache.h>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+void writeFile(const std::string& fileName, const std::string& contents)
+{
+    std::ofstream(fileName, std::ios::binary) << contents;
+}
+
+std::string readFile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+}
+
+void testKey()
+{
+    const std::string key = ResultCache::Key().add("ab").add("c").toString();
+    SimTK_TEST(key.size() == 32);
+    SimTK_TEST(key == ResultCache::Key().add("ab").add("c").toString());
+    // Strings are hashed with their lengths.
+    SimTK_TEST(key != ResultCache::Key().add("a").add("bc").toString());
+
+    // Files are hashed by their contents.
+    writeFile("testResultCache_a.txt", "ab");
+    writeFile("testResultCache_b.txt", "ab");
+    SimTK_TEST(ResultCache::Key().addFile("testResultCache_a.txt").toString()
+            == ResultCache::Key().addFile("testResultCache_b.txt").toString());
+    SimTK_TEST(ResultCache::Key().addFile("testResultCache_a.txt").toString()
+            == ResultCache::Key().add("ab").toString());
+    SimTK_TEST_MUST_THROW_EXC(
+            ResultCache::Key().addFile("testResultCache_missing.txt"),
+            Exception);
+
+    // Storages are hashed by their labels and data.
+    Storage storage;
+    Array<std::string> labels("time", 2);
+    labels[1] = "x";
+    storage.setColumnLabels(labels);
+    const double x = 1.5;
+    storage.append(0.1, 1, &x);
+    Storage renamed(storage);
+    renamed.setName("renamed");
+    const std::string storageKey =
+            ResultCache::Key().addStorage(storage).toString();
+    SimTK_TEST(storageKey == ResultCache::Key().addStorage(renamed).toString());
+    renamed.append(0.2, 1, &x);
+    SimTK_TEST(storageKey != ResultCache::Key().addStorage(renamed).toString());
+}
+
+void testStoreAndRestore()
+{
+    const ResultCache cache("testResultCache_cache");
+    const std::string key = ResultCache::Key().add("inputs").toString();
+    writeFile("testResultCache_out1.txt", "first");
+    writeFile("testResultCache_out2.txt", "");
+    const std::vector<std::string> outputs{"testResultCache_out1.txt",
+                                           "testResultCache_out2.txt"};
+    const std::string otherKey = ResultCache::Key().add("other").toString();
+    SimTK_TEST(!cache.restore(otherKey, outputs));
+    cache.store(key, outputs);
+
+    writeFile("testResultCache_out1.txt", "changed");
+    writeFile("testResultCache_out2.txt", "changed");
+    SimTK_TEST(cache.restore(key, outputs));
+    SimTK_TEST(readFile("testResultCache_out1.txt") == "first");
+    SimTK_TEST(readFile("testResultCache_out2.txt") == "");
+
+    // An entry is found only with as many files as it holds.
+    SimTK_TEST(!cache.restore(key, {"testResultCache_out1.txt"}));
+    SimTK_TEST_MUST_THROW_EXC(
+            cache.store(otherKey, {"testResultCache_missing.txt"}),
+            Exception);
+    SimTK_TEST(!cache.restore(otherKey, {"testResultCache_out1.txt"}));
+}
+
+int main()
+{
+    SimTK_START_TEST("testResultCache");
+        SimTK_SUBTEST(testKey);
+        SimTK_SUBTEST(testStoreAndRestore);
+    SimTK_END_TEST();
+}
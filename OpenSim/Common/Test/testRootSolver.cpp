@@ -20,6 +20,7 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <math.h>
@@ -40,6 +41,7 @@
 #include <OpenSim/Common/RootSolver.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "ExampleVectorFunctionUncoupledNxN.h"
+#include "SimTKcommon.h"
 
 using namespace OpenSim;
 using namespace std;
@@ -62,13 +64,41 @@ int main()
         Array<double> a(-1.0,N), b(1.0,N), tol(1.0e-6,N);
         Array<double> roots(0.0,N);
         RootSolver solver(&function);
-        //roots = solver.solve(a,b,tol);  NOTE: JACKM need to pass in state or change CMC 
+        // The function does not depend on the state.
+        SimTK::State s;
+        roots = solver.solve(s,a,b,tol);
         cout<<endl<<endl<<"-------------"<<endl;
         cout<<"roots:\n";
         cout<<roots<<endl<<endl;
         for (int i=0; i <= 100; i++){
-            //ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
+            ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
         }
+
+        // One evaluation per iteration of the slowest lane, and two at the
+        // bounds. The root of the last lane is its upper bound, so that lane
+        // takes no iterations.
+        const Array<int>& iterations = solver.getNumIterations();
+        ASSERT(iterations.getSize() == N);
+        ASSERT(iterations[N-1] == 0);
+        int maxIterations = 0, maxOtherIterations = 0;
+        for (int i = 0; i < N; i++) {
+            maxIterations = std::max(maxIterations, iterations[i]);
+            if (i > 0)
+                maxOtherIterations = std::max(maxOtherIterations,
+                                              iterations[i]);
+        }
+        ASSERT(solver.getNumEvaluations() == maxIterations + 2);
+
+        // Likewise for a lane whose lower bound is its root, given the
+        // values at the bounds.
+        Array<double> fa(0.0,N), fb(0.0,N);
+        function.evaluate(s, a, fa);
+        function.evaluate(s, b, fb);
+        a[0] = 0.0; fa[0] = 0.0;
+        roots = solver.solve(s,a,b,fa,fb,tol);
+        ASSERT_EQUAL(0.0, roots[0], 1e-6);
+        ASSERT(solver.getNumIterations()[0] == 0);
+        ASSERT(solver.getNumEvaluations() == maxOtherIterations);
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -21,10 +21,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/STOFileReader.h"
 
 #include <unordered_set>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <cstdio>
+#include <cmath>
 
 std::string getNextToken(std::istream& stream, 
                          const std::string& delims) {
@@ -192,6 +196,184 @@ void testReadingWriting() {
     std::remove(fileB.c_str());
 }
 
+void testReadingLargeFile() {
+    using namespace OpenSim;
+
+    // Enough rows for the rows to be parsed in parallel, with blank lines
+    // and CRLF line endings mixed in.
+    const std::string filename{"testSTOFileAdapter_large.sto"};
+    const int numRows{20000};
+    {
+        std::ofstream file{filename};
+        file << "large\nversion=1\nnRows=" << numRows
+             << "\nnColumns=3\ninDegrees=no\nendheader\n"
+             << "time\ta\tb\n";
+        for(int i = 0; i < numRows; ++i) {
+            file << 0.001 * i << "\t" << i << "\t" << -0.5 * i
+                 << (i % 2 ? "\r\n" : "\n");
+            if(i % 1000 == 0) file << "\t\n";
+        }
+    }
+    auto table = STOFileAdapter::read(filename);
+    SimTK_TEST(table.getNumRows() == size_t(numRows));
+    SimTK_TEST(table.getNumColumns() == 2);
+    SimTK_TEST(table.getColumnLabels() ==
+               std::vector<std::string>({"a", "b"}));
+    SimTK_TEST(table.getTableMetaData().getValueForKey("header").
+                   getValue<std::string>() == "large");
+    for(int i = 0; i < numRows; i += 997) {
+        SimTK_TEST_EQ(table.getIndependentColumn()[i], 0.001 * i);
+        SimTK_TEST_EQ(table.getMatrix()(i, 0), double(i));
+        SimTK_TEST_EQ(table.getMatrix()(i, 1), -0.5 * i);
+    }
+
+    // A row with too few columns is reported with its line number.
+    {
+        std::ofstream file{filename, std::ios::app};
+        file << "100\t1\n";
+    }
+    try {
+        STOFileAdapter::read(filename);
+        SimTK_TEST(false);
+    } catch(const RowLengthMismatch& e) {
+        // 7 lines of header and 20 blank lines precede the rows.
+        SimTK_TEST(std::string{e.what()}.find("line " +
+                std::to_string(7 + 20 + numRows + 1) + ".") !=
+                std::string::npos);
+    }
+    std::remove(filename.c_str());
+}
+
+std::string readText(const std::string& filename) {
+    std::ifstream file{filename};
+    std::stringstream text{};
+    text << file.rdbuf();
+    return text.str();
+}
+
+// The rows are written as an ostream with precision digits10 + 1 writes them,
+// whether they are formatted on one thread or on several.
+void testWritingConcurrently() {
+    using namespace OpenSim;
+
+    TimeSeriesTableVec3 table{};
+    table.setColumnLabels({"a", "b"});
+    const int numRows{1000};
+    for(int i = 0; i < numRows; ++i) {
+        const double x = std::sin(0.1 * i);
+        table.appendRow(0.001 * i, {SimTK::Vec3{x, -1e-7 * i, 1e12 * x},
+                                    SimTK::Vec3{SimTK::NaN, 1.0 / 3, i}});
+    }
+    std::string serial{"testSTOFileAdapter_serial.sto"};
+    std::string concurrent{"testSTOFileAdapter_concurrent.sto"};
+    STOFileAdapterVec3::write(table, serial);
+    IO::SetNumWriterThreads(4);
+    STOFileAdapterVec3::write(table, concurrent);
+    IO::SetNumWriterThreads(1);
+    const auto text = readText(serial);
+    SimTK_TEST(text == readText(concurrent));
+
+    std::ostringstream expected{};
+    expected << std::setprecision(16);
+    for(int i : {0, 577, numRows - 1}) {
+        const auto& row = table.getRowAtIndex(i);
+        expected.str("");
+        expected << "\n" << table.getIndependentColumn()[i];
+        for(int col = 0; col < 2; ++col) {
+            expected << "\t" << row[col][0];
+            for(int j = 1; j < 3; ++j) expected << "," << row[col][j];
+        }
+        expected << "\n";
+        SimTK_TEST(text.find(expected.str()) != std::string::npos);
+    }
+    std::remove(serial.c_str());
+    std::remove(concurrent.c_str());
+}
+
+void testReadingInBlocks() {
+    using namespace OpenSim;
+
+    TimeSeriesTable table{};
+    table.setColumnLabels({"a", "b c", "d"});
+    table.updTableMetaData().setValueForKey("inDegrees",
+                                            std::string{"yes"});
+    const int numRows{10};
+    for(int i = 0; i < numRows; ++i)
+        table.appendRow(0.01 * i, {std::sin(0.1 * i), SimTK::NaN, 1e-9 * i});
+    std::string fileName{"testSTOFileAdapter_blocks.sto"};
+    STOFileAdapter::write(table, fileName);
+
+    for(bool prefetch : {false, true}) {
+        STOFileReader reader{fileName, 3, prefetch};
+        SimTK_TEST(reader.getColumnLabels() ==
+                   std::vector<std::string>({"a", "b c", "d"}));
+        SimTK_TEST(reader.isInDegrees());
+        STOFileReader::Block block;
+        int row{0};
+        int numBlocks{0};
+        while(reader.readBlock(block)) {
+            SimTK_TEST(block.getNumRows() == (numBlocks < 3 ? 3u : 1u));
+            ++numBlocks;
+            for(size_t r = 0; r < block.getNumRows(); ++r, ++row) {
+                const auto& expected = table.getRowAtIndex(row);
+                SimTK_TEST(block.times[r] ==
+                           table.getIndependentColumn()[row]);
+                SimTK_TEST_EQ(block.getRow(r)[0], expected[0]);
+                SimTK_TEST(SimTK::isNaN(block.getRow(r)[1]));
+                SimTK_TEST_EQ(block.getRow(r)[2], expected[2]);
+            }
+        }
+        SimTK_TEST(row == numRows && numBlocks == 4);
+        // The end of the file is reported again.
+        SimTK_TEST(!reader.readBlock(block) && block.getNumRows() == 0);
+    }
+
+    // A row with too few values.
+    {
+        std::ofstream file{fileName, std::ios::app};
+        file << "0.5\t1\n";
+    }
+    STOFileReader reader{fileName, 100};
+    STOFileReader::Block block;
+    SimTK_TEST_MUST_THROW_EXC(reader.readBlock(block), Exception);
+    std::remove(fileName.c_str());
+}
+
+void testWritingView() {
+    using namespace OpenSim;
+
+    TimeSeriesTable table{};
+    table.setColumnLabels({"a", "b", "c"});
+    table.addTableMetaData("inDegrees", std::string{"no"});
+    for(int i = 0; i < 100; ++i)
+        table.appendRow(0.01 * i, {1.0 * i, 2.0 * i, 3.0 * i});
+
+    // Writing a view writes the same file as writing a copy of its data.
+    TimeSeriesTableView view{table, 0.2, 0.5, {"c", "a"}};
+    std::string viewFile{"testSTOFileAdapter_view.sto"};
+    std::string copyFile{"testSTOFileAdapter_view_copy.sto"};
+    STOFileAdapter::write(view, viewFile);
+    STOFileAdapter::write(view.toTable(), copyFile);
+    SimTK_TEST(readText(viewFile) == readText(copyFile));
+
+    const auto read = STOFileAdapter::read(viewFile);
+    SimTK_TEST(read.getNumRows() == view.getNumRows());
+    SimTK_TEST(read.getColumnLabels() == view.getColumnLabels());
+    SimTK_TEST(read.getTableMetaData<std::string>("inDegrees") == "no");
+    for(size_t r = 0; r < view.getNumRows(); ++r) {
+        SimTK_TEST_EQ(read.getIndependentColumn()[r], view.getTimeAtIndex(r));
+        SimTK_TEST(read.getRowAtIndex(r)[0] == view.getElementAtIndex(r, 0));
+        SimTK_TEST(read.getRowAtIndex(r)[1] == view.getElementAtIndex(r, 1));
+    }
+
+    // Views of whole tables are written as the tables are.
+    STOFileAdapter::write(table, copyFile);
+    STOFileAdapter::write(TimeSeriesTableView{table}, viewFile);
+    SimTK_TEST(readText(viewFile) == readText(copyFile));
+    std::remove(viewFile.c_str());
+    std::remove(copyFile.c_str());
+}
+
 int main() {
     using namespace OpenSim;
 
@@ -281,6 +463,18 @@ int main() {
     SimTK_TEST(outputTables["table"]->getNumRows() == 2);
     SimTK_TEST(outputTables["table"]->getNumColumns() == 2);
 
+    std::cout << "Testing reading a large file" << std::endl;
+    testReadingLargeFile();
+
+    std::cout << "Testing writing rows concurrently" << std::endl;
+    testWritingConcurrently();
+
+    std::cout << "Testing writing views of tables" << std::endl;
+    testWritingView();
+
+    std::cout << "Testing reading in blocks" << std::endl;
+    testReadingInBlocks();
+
     std::cout << "\nAll tests passed!" << std::endl;
 
     return 0;
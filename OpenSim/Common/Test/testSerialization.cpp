@@ -229,6 +229,42 @@ int main()
         ASSERT(loc == 1);
         int notFound = objWithListProp.getProperty_list_SerializableObject().findIndexForName("Third");
         ASSERT(notFound == -1);
+
+        // Name lookup in a set, which indexes its objects by name, follows
+        // appends, removals and renames.
+        ObjSet bigSet;
+        for (int i = 0; i < 100; ++i) {
+            SerializableObject obj;
+            obj.setName("obj" + std::to_string(i % 50));
+            bigSet.cloneAndAppend(obj);
+        }
+        for (int pass = 0; pass < 2; ++pass) {
+            ASSERT(bigSet.getIndex("obj7") == 7);
+            ASSERT(bigSet.getIndex("obj7", 8) == 57);
+            ASSERT(bigSet.getIndex("obj7", 60) == 7);
+            ASSERT(!bigSet.contains("obj50"));
+            ASSERT(&bigSet.get("obj49") == &bigSet.get(49));
+        }
+        bigSet.get(3).setName("renamed");
+        for (int pass = 0; pass < 2; ++pass) {
+            ASSERT(bigSet.getIndex("renamed") == 3);
+            ASSERT(bigSet.getIndex("obj3") == 53);
+        }
+        bigSet.remove(0);
+        for (int pass = 0; pass < 2; ++pass) {
+            ASSERT(bigSet.getIndex("renamed") == 2);
+            ASSERT(bigSet.getIndex("obj0") == 49);
+        }
+        SerializableObject last;
+        last.setName("last");
+        bigSet.cloneAndAppend(last);
+        for (int pass = 0; pass < 2; ++pass)
+            ASSERT(bigSet.getIndex("last") == 99);
+        ObjSet setCopy(bigSet);
+        setCopy.get(98).setName("renamedCopy");
+        ASSERT(setCopy.getIndex("renamedCopy") == 98);
+        ASSERT(bigSet.getIndex("renamedCopy") == -1);
+        SimTK_TEST_MUST_THROW(bigSet.get("missing"));
     }
     catch(const std::exception& e) {
         cerr << "EXCEPTION: " << e.what() << endl;
@@ -42,6 +42,7 @@
 #include <SimTKsimbody.h>
 #include <ctime>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <stdio.h>
 
@@ -1132,6 +1133,169 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+void testPrecomputedData()
+{
+    cout << "   TEST: Precomputed spline data " << endl;
+    const double e0 = 0.04;
+    auto original = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                e0, 1.5/e0, 1.0/3.0, 0.5, true, "test_precomputed")};
+    SimTK_TEST(SmoothSegmentedFunction::getNumPrecomputedCurves() > 0);
+
+    std::stringstream data(std::ios::in | std::ios::out | std::ios::binary);
+    SmoothSegmentedFunction::writePrecomputedData(data);
+    SmoothSegmentedFunction::clearPrecomputedData();
+    SimTK_TEST(SmoothSegmentedFunction::getNumPrecomputedCurves() == 0);
+
+    // Data that was not written by writePrecomputedData() is rejected.
+    std::stringstream bad("not precomputed data");
+    SimTK_TEST(!SmoothSegmentedFunction::readPrecomputedData(bad));
+    SimTK_TEST(SmoothSegmentedFunction::getNumPrecomputedCurves() == 0);
+
+    SimTK_TEST(SmoothSegmentedFunction::readPrecomputedData(data));
+    SimTK_TEST(SmoothSegmentedFunction::getNumPrecomputedCurves() > 0);
+
+    // A curve built from the precomputed splines matches the original.
+    auto loaded = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                e0, 1.5/e0, 1.0/3.0, 0.5, true, "test_precomputed")};
+    for (double x = 1.0 - e0; x <= 1.0 + 2*e0; x += e0/10) {
+        SimTK_TEST_EQ_TOL(loaded->calcValue(x), original->calcValue(x),
+                          1e-9);
+        SimTK_TEST_EQ_TOL(loaded->calcDerivative(x, 1),
+                          original->calcDerivative(x, 1), 1e-9);
+        SimTK_TEST_EQ_TOL(loaded->calcIntegral(x), original->calcIntegral(x),
+                          1e-9);
+    }
+    cout << "    passed" << endl;
+}
+
+void testTabulatedEvaluation()
+{
+    cout << "   TEST: Tabulated evaluation " << endl;
+    const double tol = 1e-9;
+    auto curve = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
+                0.4, 0.75, 1, 1.6, 0.05, 0.75, 0.75, false,
+                "test_tabulated")};
+    const SmoothSegmentedFunction exact(*curve);
+    SimTK_TEST(!curve->isTabulatedEvaluationEnabled());
+    SimTK_TEST(curve->enableTabulatedEvaluation(tol));
+    SimTK_TEST(curve->isTabulatedEvaluationEnabled());
+    SimTK_TEST(curve->getNumTabulatedIntervals() > 0);
+
+    // The table is within the tolerance, inside and outside of the domain
+    // (the second derivative is only close, not within the tolerance).
+    for (double x = 0.3; x <= 1.7; x += 0.0007) {
+        SimTK_TEST_EQ_TOL(curve->calcValue(x), exact.calcValue(x), tol);
+        SimTK_TEST_EQ_TOL(curve->calcDerivative(x, 1),
+                          exact.calcDerivative(x, 1), tol);
+        SimTK_TEST_EQ_TOL(curve->calcDerivative(x, 2),
+                          exact.calcDerivative(x, 2), 1e-3);
+        SimTK_TEST(curve->calcDerivative(x, 3) == exact.calcDerivative(x, 3));
+    }
+
+    // Copies keep the table; disabling restores exact evaluation.
+    const SmoothSegmentedFunction copy(*curve);
+    SimTK_TEST(copy.isTabulatedEvaluationEnabled());
+    curve->disableTabulatedEvaluation();
+    SimTK_TEST(curve->getNumTabulatedIntervals() == 0);
+    SimTK_TEST(curve->calcValue(0.9) == exact.calcValue(0.9));
+
+    // New curves are tabulated if that is the default.
+    SimTK_TEST(
+        !SmoothSegmentedFunction::isTabulatedEvaluationEnabledByDefault());
+    SmoothSegmentedFunction::setTabulatedEvaluationByDefault(true, tol);
+    auto tabulated = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
+                0.4, 0.75, 1, 1.6, 0.05, 0.75, 0.75, false,
+                "test_tabulated")};
+    SmoothSegmentedFunction::setTabulatedEvaluationByDefault(false);
+    SimTK_TEST(tabulated->isTabulatedEvaluationEnabled());
+    SimTK_TEST_EQ_TOL(tabulated->calcValue(0.9), exact.calcValue(0.9), tol);
+    cout << "    passed" << endl;
+}
+
+void testLazyIntegral()
+{
+    cout << "   TEST: Lazy integral " << endl;
+    auto curve = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                0.04, 42.8, 0.67, 0.5, true, "test_lazy_integral")};
+    SimTK_TEST(curve->isIntegralAvailable());
+    SimTK_TEST(!curve->isIntegralComputed());
+
+    // Copies share the integral once it is computed.
+    const SmoothSegmentedFunction copy(*curve);
+    const double integral = curve->calcIntegral(1.03);
+    SimTK_TEST(curve->isIntegralComputed());
+    SimTK_TEST(copy.isIntegralComputed());
+    SimTK_TEST(copy.calcIntegral(1.03) == integral);
+
+    // An identical curve reuses the precomputed integral.
+    auto same = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                0.04, 42.8, 0.67, 0.5, true, "test_lazy_integral")};
+    SimTK_TEST(same->isIntegralComputed());
+
+    // Integrals computed in parallel match those computed serially.
+    std::vector<std::unique_ptr<SmoothSegmentedFunction>> curves;
+    std::vector<const SmoothSegmentedFunction*> pointers;
+    for (int i = 0; i < 6; ++i) {
+        curves.emplace_back(
+            SmoothSegmentedFunctionFactory::createFiberForceLengthCurve(
+                0.0, 0.6 + 0.02*i, 0.2, 2.0/(0.6 + 0.02*i), 0.75, true,
+                "test_lazy_integral_" + std::to_string(i)));
+        pointers.push_back(curves.back().get());
+    }
+    pointers.push_back(nullptr);
+    SmoothSegmentedFunction::computeIntegrals(pointers, 3);
+    for (int i = 0; i < 6; ++i) {
+        SimTK_TEST(curves[i]->isIntegralComputed());
+        auto serial = std::unique_ptr<SmoothSegmentedFunction>{
+            SmoothSegmentedFunctionFactory::createFiberForceLengthCurve(
+                0.0, 0.6 + 0.02*i, 0.2, 2.0/(0.6 + 0.02*i), 0.75, true,
+                "test_lazy_integral_serial")};
+        SimTK_TEST_EQ(curves[i]->calcIntegral(1.3),
+                      serial->calcIntegral(1.3));
+    }
+
+    // Curves without an integral are skipped.
+    auto noIntegral = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createFiberForceLengthCurve(
+                0.0, 0.6, 0.2, 2.0/0.6, 0.75, false, "test_lazy_integral")};
+    SmoothSegmentedFunction::computeIntegrals({noIntegral.get()});
+    SimTK_TEST(!noIntegral->isIntegralComputed());
+    cout << "    passed" << endl;
+}
+
+void testInversionHint()
+{
+    cout << "   TEST: Inversion hint " << endl;
+    auto curve = std::unique_ptr<SmoothSegmentedFunction>{
+        SmoothSegmentedFunctionFactory::createFiberActiveForceLengthCurve(
+                0.4, 0.75, 1, 1.6, 0.05, 0.75, 0.75, false,
+                "test_inversion_hint")};
+
+    // Sweep slowly through all of the Bezier curves (and beyond the domain),
+    // and then jump around.
+    SegmentedQuinticBezierToolkit::InversionHint hint;
+    SimTK_TEST(hint.index == -1);
+    std::vector<double> xs;
+    for (double x = 0.3; x <= 1.7; x += 0.0013) xs.push_back(x);
+    for (double x : {1.5, 0.45, 1.0, 0.41, 1.59}) xs.push_back(x);
+    for (double x : xs) {
+        SimTK_TEST_EQ_TOL(curve->calcValue(x, hint), curve->calcValue(x),
+                          1e-12);
+        for (int order = 1; order <= 3; ++order) {
+            SimTK_TEST_EQ_TOL(curve->calcDerivative(x, order, hint),
+                              curve->calcDerivative(x, order), 1e-10);
+        }
+    }
+    SimTK_TEST(hint.index >= 0);
+    cout << "    passed" << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1907,6 +2071,11 @@ int main(int argc, char* argv[])
                 fiberfalCurve.printMuscleCurveToCSVFile("C:/aBadPath",0,2.0));
             //fiberfalCurve.printMuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
             cout << "    passed"<<endl;
+
+        testPrecomputedData();
+        testTabulatedEvaluation();
+        testLazyIntegral();
+        testInversionHint();
         SimTK_END_TEST();
 
     }
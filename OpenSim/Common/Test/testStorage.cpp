@@ -21,6 +21,9 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <sstream>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
@@ -64,6 +67,33 @@ int main() {
     
         ASSERT(st->getStateIndex("v2")==1);
 
+        // Columns are found by (hashed) label, including the labels of
+        // storages generated by versions before 4.0.
+        Storage labeled;
+        Array<std::string> labels;
+        labels.append("time");
+        for(i=0; i<1000; i++) labels.append("c" + std::to_string(i));
+        labels.append("knee_angle");
+        labels.append("knee_angle_u");
+        labels.append("soleus.activation");
+        labels.append("c7");
+        labeled.setColumnLabels(labels);
+        ASSERT(labeled.getStateIndex("c0")==0);
+        ASSERT(labeled.getStateIndex("c999")==999);
+        ASSERT(labeled.getStateIndex("c7")==7); // the first of duplicates
+        ASSERT(labeled.getStateIndex("/jointset/knee/knee_angle/value")==1000);
+        ASSERT(labeled.getStateIndex("/jointset/knee/knee_angle/speed")==1001);
+        ASSERT(labeled.getStateIndex("/forceset/soleus/activation")==1002);
+        ASSERT(labeled.getStateIndex("c1000")==-1);
+        ASSERT(!labeled.storageLabelsAreUnique());
+        ASSERT(!labeled.makeStorageLabelsUnique());
+        ASSERT(labeled.storageLabelsAreUnique());
+        ASSERT(labeled.getStateIndex("1_c7")==1003);
+        labels.setSize(3);
+        labeled.setColumnLabels(labels);
+        ASSERT(labeled.getStateIndex("c1")==1);
+        ASSERT(labeled.getStateIndex("c999")==-1);
+
         Storage st2("testDiff.sto");
         // Test Comparison
         double diff = st->compareColumn(st2, stdLabels[1], 0.);
@@ -78,6 +108,153 @@ int main() {
         Storage stVersion2("testStorage_version2.sto");
         // Compare with st.
         SimTK_TEST_EQ(table.getMatrix(), stVersion2.exportToTable().getMatrix());
+
+        // Rows survive the storage growing (its elements are moved, not
+        // copied, when it grows).
+        Storage grown(1);
+        for(i=0; i<5000; i++) {
+            double row[3] = {double(i), -double(i), 0.5*i};
+            grown.append(0.001*i, 3, row);
+        }
+        ASSERT(grown.getSize()==5000);
+        for(i=0; i<grown.getSize(); i+=499) {
+            const StateVector& row = (*grown.getStateVector(i));
+            ASSERT(row.getTime()==0.001*i);
+            ASSERT(row.getSize()==3);
+            ASSERT(row.getData()[1]==-i);
+            ASSERT(row.getData()[2]==0.5*i);
+        }
+        Array<double> moved(std::move(col));
+        ASSERT(moved.getSize()==2 && moved[1]==40.0);
+        ASSERT(col.getSize()==0);
+        col = std::move(moved);
+        ASSERT(col.getSize()==2 && col[0]==20.);
+        col.append(60.);
+        ASSERT(col.getSize()==3 && col[2]==60.);
+
+        // findIndex() with and without a guess agrees with a linear search.
+        for(int k=-5; k<5100; k+=7) {
+            const double t = 0.001*k + 0.0002;
+            int expected = 0;
+            while(expected+1<grown.getSize() &&
+                  grown.getStateVector(expected+1)->getTime()<=t)
+                ++expected;
+            ASSERT(grown.findIndex(t)==expected);
+            for(int guess : {0, expected, expected-1, expected+3, 2500, 4999})
+                ASSERT(grown.findIndex(guess, t)==expected);
+        }
+        ASSERT(grown.findIndex(-1.)==0);
+        ASSERT(grown.findIndex(1000, 100.)==4999);
+        double interpolated[3];
+        grown.getDataAtTime(1.2345, 3, interpolated);
+        ASSERT_EQUAL(-1234.5, interpolated[1], 1e-9);
+
+        // Compressing keeps only the first and last rows of linear data, and
+        // otherwise reproduces the data within the tolerance by linear
+        // interpolation.
+        Storage line(grown);
+        line.compress(1e-9);
+        ASSERT(line.getSize()==2);
+        ASSERT(line.getLastTime()==grown.getLastTime());
+        Storage smooth(1);
+        for(i=0; i<2000; i++) {
+            const double t = 0.001*i;
+            double row[2] = {sin(3*t), t*t*t};
+            smooth.append(t, 2, row);
+        }
+        Storage compressed(smooth);
+        compressed.compress(1e-4);
+        ASSERT(compressed.getSize() < smooth.getSize()/4);
+        ASSERT(compressed.getFirstTime()==smooth.getFirstTime());
+        ASSERT(compressed.getLastTime()==smooth.getLastTime());
+        for(i=0; i<smooth.getSize(); i++) {
+            const StateVector& row = (*smooth.getStateVector(i));
+            compressed.getDataAtTime(row.getTime(), 2, interpolated);
+            ASSERT_EQUAL(row.getData()[0], interpolated[0], 1.0001e-4);
+            ASSERT_EQUAL(row.getData()[1], interpolated[1], 1.0001e-4);
+        }
+        ASSERT_THROW(Exception, compressed.compress(-1.));
+
+        // Combining storages uses the values of the other storage linearly
+        // interpolated at the times of the rows, for the columns they share.
+        Storage coarse(1);
+        for(i=0; i<300; i++) {
+            const double t = 0.007*i;
+            double row[3] = {2+cos(t), 1+t, 2.};
+            coarse.append(t, 3, row);
+        }
+        Storage sum(smooth), difference(smooth), product(smooth),
+                quotient(smooth);
+        sum.add(&coarse);
+        difference.subtract(&coarse);
+        product.multiply(&coarse);
+        quotient.divide(&coarse);
+        double other[3];
+        for(i=0; i<smooth.getSize(); i+=37) {
+            const StateVector& row = (*smooth.getStateVector(i));
+            ASSERT(coarse.getDataAtTime(row.getTime(), 3, other)==3);
+            for(int j=0; j<2; j++) {
+                const double y = row.getData()[j];
+                ASSERT_EQUAL(y+other[j],
+                    sum.getStateVector(i)->getData()[j], 1e-15);
+                ASSERT_EQUAL(y-other[j],
+                    difference.getStateVector(i)->getData()[j], 1e-15);
+                ASSERT_EQUAL(y*other[j],
+                    product.getStateVector(i)->getData()[j], 1e-15);
+                ASSERT_EQUAL(y/other[j],
+                    quotient.getStateVector(i)->getData()[j], 1e-12);
+            }
+            ASSERT(sum.getStateVector(i)->getSize()==2);
+        }
+
+        // Filtering the columns of a storage (in blocks, in parallel) gives
+        // the same results as filtering each column alone.
+        // The time step is exact in binary, so the storage is not resampled.
+        const int nFilterRows = 4000, nFilterColumns = 40;
+        const double dt = 1./1024;
+        Storage noisy(nFilterRows);
+        std::vector<double> values(nFilterColumns);
+        for(i=0; i<nFilterRows; i++) {
+            for(int j=0; j<nFilterColumns; j++)
+                values[j] = sin(0.01*i*(j+1)) + 0.1*((i*7919+j*104729)%13);
+            noisy.append(dt*i, nFilterColumns, values.data());
+        }
+        Storage iir(noisy), fir(noisy);
+        iir.lowpassIIR(20.);
+        fir.lowpassFIR(30, 20.);
+        Array<double> signal, iirExpected(0., nFilterRows),
+                      firExpected(0., nFilterRows), iirColumn, firColumn;
+        for(int j=0; j<nFilterColumns; j+=3) {
+            noisy.getDataColumn(j, signal);
+            Signal::LowpassIIR(dt, 20., nFilterRows, &signal[0],
+                               &iirExpected[0]);
+            Signal::LowpassFIR(30, dt, 20., nFilterRows, &signal[0],
+                               &firExpected[0]);
+            iir.getDataColumn(j, iirColumn);
+            fir.getDataColumn(j, firColumn);
+            ASSERT(iirColumn == iirExpected);
+            ASSERT(firColumn == firExpected);
+        }
+
+        // Printing (with the rows formatted in blocks, in parallel) writes
+        // the rows as StateVector::print() does.
+        noisy.print("testStorage_serial.sto");
+        IO::SetNumWriterThreads(4);
+        noisy.print("testStorage_concurrent.sto");
+        IO::SetNumWriterThreads(1);
+        std::stringstream serialText, concurrentText;
+        serialText << ifstream("testStorage_serial.sto").rdbuf();
+        concurrentText << ifstream("testStorage_concurrent.sto").rdbuf();
+        ASSERT(serialText.str() == concurrentText.str());
+        FILE* rowFile = fopen("testStorage_row.txt", "w");
+        noisy.getStateVector(1234)->print(rowFile);
+        fclose(rowFile);
+        std::stringstream rowText;
+        rowText << ifstream("testStorage_row.txt").rdbuf();
+        ASSERT(serialText.str().find("\n" + rowText.str()) !=
+               std::string::npos);
+        Storage reread("testStorage_concurrent.sto");
+        ASSERT(reread.getSize() == nFilterRows);
     }
     catch (const Exception& e) {
         e.print(cerr);
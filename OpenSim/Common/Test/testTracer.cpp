@@ -0,0 +1,101 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  testTracer.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Tracer.h"
+#include "OpenSim/Common/Storage.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace OpenSim;
+
+void testDisabled() {
+    Tracer::clear();
+    Tracer::setEnabled(false);
+    {
+        OPENSIM_TRACE_SPAN("test", "not recorded");
+    }
+    Storage sto{"test.sto"};
+    SimTK_TEST(Tracer::getNumSpans() == 0);
+}
+
+void testChromeTrace() {
+    Tracer::clear();
+    Tracer::setEnabled(true);
+    {
+        OPENSIM_TRACE_SPAN("test", "outer");
+        const std::string detail{"a \"quoted\" detail"};
+        OPENSIM_TRACE_SPAN("test", "inner", detail);
+    }
+    std::thread([] { OPENSIM_TRACE_SPAN("test", "other thread"); }).join();
+    Storage sto{"test.sto"};
+    Tracer::setEnabled(false);
+
+    SimTK_TEST(Tracer::getNumSpans() >= 4);
+    std::ostringstream out;
+    Tracer::writeChromeTrace(out);
+    const std::string trace = out.str();
+    SimTK_TEST(trace.find("\"traceEvents\":[") != std::string::npos);
+    SimTK_TEST(trace.find("\"name\":\"outer\"") != std::string::npos);
+    SimTK_TEST(trace.find("\"ph\":\"X\"") != std::string::npos);
+    SimTK_TEST(trace.find("a \\\"quoted\\\" detail") != std::string::npos);
+    SimTK_TEST(trace.find("\"tid\":2") != std::string::npos);
+    SimTK_TEST(trace.find("\"detail\":\"test.sto\"") != std::string::npos);
+
+    Tracer::clear();
+    SimTK_TEST(Tracer::getNumSpans() == 0);
+    SimTK_TEST_MUST_THROW_EXC(
+            Tracer::writeChromeTrace("no_such_directory/trace.json"),
+            Exception);
+}
+
+void testSpanTotals() {
+    Tracer::clear();
+    Tracer::setEnabled(true);
+    for (int i = 0; i < 3; ++i) {
+        OPENSIM_TRACE_SPAN("test", "repeated");
+    }
+    std::thread([] { OPENSIM_TRACE_SPAN("test", "repeated"); }).join();
+    {
+        OPENSIM_TRACE_SPAN("test", "once");
+    }
+    Tracer::setEnabled(false);
+
+    const auto totals = Tracer::getSpanTotals();
+    SimTK_TEST(totals.size() == 2);
+    SimTK_TEST(totals[0].category == "test");
+    SimTK_TEST(totals[0].name == "repeated");
+    SimTK_TEST(totals[0].count == 4);
+    SimTK_TEST(totals[0].seconds >= 0);
+    SimTK_TEST(totals[1].name == "once");
+    SimTK_TEST(totals[1].count == 1);
+    Tracer::clear();
+    SimTK_TEST(Tracer::getSpanTotals().empty());
+}
+
+int main() {
+    SimTK_START_TEST("testTracer");
+        SimTK_SUBTEST(testDisabled);
+        SimTK_SUBTEST(testChromeTrace);
+        SimTK_SUBTEST(testSpanTotals);
+    SimTK_END_TEST();
+}
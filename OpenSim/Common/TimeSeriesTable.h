@@ -127,6 +127,8 @@ public:
     }
 };
 
+template<typename ETY> class TimeSeriesTableView_;
+
 /** TimeSeriesTable_ is a DataTable_ where the independent column is time of 
 type double. The time column is enforced to be strictly increasing.           */
 template<typename ETY = SimTK::Real>
@@ -184,15 +186,130 @@ public:
                          increasing.                                          */
     TimeSeriesTable_(const DataTable_<double, ETY>& datatable) : 
         DataTable_<double, ETY>(datatable) {
+        validateTimeColumn();
+    }
+
+#ifndef SWIG
+    /** Construct a TimeSeriesTable_ from a DataTable_ that is no longer
+    needed (e.g., the result of flatten() or pack()), taking over its data
+    rather than copying them.
+
+    \throws InvalidTable If the input table's independent column is not strictly
+                         increasing.                                          */
+    TimeSeriesTable_(DataTable_<double, ETY>&& datatable) : 
+        DataTable_<double, ETY>(std::move(datatable)) {
+        validateTimeColumn();
+    }
+#endif
+
+#ifndef SWIG
+    /** Construct a TimeSeriesTable_ from the rows and columns of a view of
+    another table (see TimeSeriesTableView_::toTable()). Only the data in the
+    view are copied. The table metadata and the metadata of the independent
+    column are those of the other table; see
+    TimeSeriesTableView_::getDependentsMetaData() for the metadata of the
+    dependent columns.                                                        */
+    explicit TimeSeriesTable_(const TimeSeriesTableView_<ETY>& view) {
         using DT = DataTable_<double, ETY>;
+        const auto& table = view.getTable();
+        DT::_tableMetaData = table.getTableMetaData();
+        DT::_independentMetaData = table.getIndependentMetaData();
+        if(table.hasColumnLabels())
+            DT::setDependentsMetaData(view.getDependentsMetaData());
+
+        const int numRows{static_cast<int>(view.getNumRows())};
+        const int numColumns{static_cast<int>(view.getNumColumns())};
+        DT::_indData.reserve(numRows);
+        for(int r = 0; r < numRows; ++r)
+            DT::_indData.push_back(view.getTimeAtIndex(r));
+        // The matrix is stored column by column.
+        DT::_depData.resize(numRows, numColumns);
+        if(numRows == 0)
+            return;
+        const auto& matrix = table.getMatrix();
+        const int tableRow{static_cast<int>(view.getRowIndexInTable(0))};
+        for(int c = 0; c < numColumns; ++c) {
+            const int tableColumn{
+                static_cast<int>(view.getColumnIndexInTable(c))};
+            for(int r = 0; r < numRows; ++r)
+                DT::_depData(r, c) = matrix(tableRow + r, tableColumn);
+        }
+    }
 
-        OPENSIM_THROW_IF(!std::is_sorted(DT::_indData.cbegin(), 
-                                         DT::_indData.cend()) ||
-                         std::adjacent_find(DT::_indData.cbegin(), 
-                                            DT::_indData.cend()) != 
-                         DT::_indData.cend(),
-                         TimeColumnNotIncreasing);
+    /** Construct a TimeSeriesTable_<double> by flattening the rows and
+    columns of a view of a table of another type (see
+    TimeSeriesTableView_::flatten()), as DataTable_::flatten() flattens a
+    whole table. Only the data in the view are copied.
+
+    \param view View of the table to flatten.
+    \param suffixes Suffixes of the column labels of the components of each
+                    column; if empty, "_1", "_2", etc. are used.
+
+    	hrows InvalidArgument If 'suffixes' is not empty and does not contain
+                            as many elements as the number of components per
+                            element of the other table.                       */
+    template<typename ThatETY>
+    TimeSeriesTable_(const TimeSeriesTableView_<ThatETY>& view,
+                     const std::vector<std::string>& suffixes) {
+        static_assert(std::is_same<ETY, double>::value,
+                      "This constructor can only be used to construct "
+                      "TimeSeriesTable_<double>.");
+        static_assert(!std::is_same<ThatETY, double>::value,
+                      "This constructor cannot be used to flatten a view of a "
+                      "TimeSeriesTable_<double>. Use toTable() instead.");
+        using DT = DataTable_<double, ETY>;
+        const auto& table = view.getTable();
+        const unsigned numComponents{table.numComponentsPerElement()};
+        OPENSIM_THROW_IF(!suffixes.empty() && suffixes.size() != numComponents,
+                         InvalidArgument,
+                         "'suffixes' must contain same number of elements as "
+                         "number of components per element of the table.");
+        DT::_tableMetaData = table.getTableMetaData();
+        DT::_independentMetaData = table.getIndependentMetaData();
+
+        // As DataTable_::flatten(), replicate the dependents metadata of
+        // std::string type for each component and drop the rest.
+        const auto viewMetaData = view.getDependentsMetaData();
+        for(const auto& key : viewMetaData.getKeys()) {
+            if(key == "labels")
+                continue;
+            const auto* values = dynamic_cast<const ValueArray<std::string>*>(
+                    &viewMetaData.getValueArrayForKey(key));
+            if(!values)
+                continue;
+            ValueArray<std::string> newValues{};
+            for(const auto& value : values->get())
+                for(unsigned i = 0; i < numComponents; ++i)
+                    newValues.upd().push_back(value);
+            DT::_dependentsMetaData.setValueArrayForKey(key, newValues);
+        }
+        std::vector<std::string> labels{};
+        for(const auto& label : view.getColumnLabels()) {
+            if(suffixes.empty()) {
+                for(unsigned i = 1; i <= numComponents; ++i)
+                    labels.push_back(label + "_" + std::to_string(i));
+            } else {
+                for(const auto& suffix : suffixes)
+                    labels.push_back(label + suffix);
+            }
+        }
+        DT::setColumnLabels(labels);
+
+        const int numRows{static_cast<int>(view.getNumRows())};
+        DT::_indData.reserve(numRows);
+        DT::_depData.resize(numRows, static_cast<int>(labels.size()));
+        std::vector<double> row{};
+        for(int r = 0; r < numRows; ++r) {
+            DT::_indData.push_back(view.getTimeAtIndex(r));
+            row.clear();
+            for(size_t c = 0; c < view.getNumColumns(); ++c)
+                DT::splitElementAndPushBack(row,
+                                            view.getElementAtIndex(r, c));
+            for(int c = 0; c < static_cast<int>(row.size()); ++c)
+                DT::_depData(r, c) = row[c];
+        }
     }
+#endif
 
     /** Construct TimeSeriesTable_ from a file.
 
@@ -275,15 +392,62 @@ public:
             TimeOutOfRange,
             time, timeCol.front(), timeCol.back());
 
-        auto iter = std::lower_bound(timeCol.begin(), timeCol.end(), time);
-        if (iter == timeCol.end())
+        const size_t index = getRowIndexAtOrAfterTime(time);
+        if (index == timeCol.size())
             return timeCol.size() - 1;
-        if (iter == timeCol.begin())
+        if (index == 0)
             return 0;
-        if ((*iter - time) <= (time - *std::prev(iter)))
-            return std::distance(timeCol.begin(), iter);
+        if ((timeCol[index] - time) <= (time - timeCol[index - 1]))
+            return index;
         else
-            return std::distance(timeCol.begin(), std::prev(iter));
+            return index - 1;
+    }
+
+    /** Get the index of the first row whose time is greater than or equal to
+    the given value (as std::lower_bound() on the time column would), or
+    getNumRows() if there is no such row.
+
+    This takes constant time if the time column is uniformly sampled (the
+    index is computed from the first and last times and then checked) or if
+    the row at, or just after, the hint is the one sought (e.g., when the
+    hint is the index returned for the previous, smaller time). Otherwise,
+    the time column is searched in logarithmic time.
+
+    \param time Value to search for.
+    \param hint Index of a row that is likely to be the one sought.         */
+    size_t getRowIndexAtOrAfterTime(const double time,
+                                    const size_t hint = 0) const {
+        using DT = DataTable_<double, ETY>;
+        const auto& timeCol = DT::getIndependentColumn();
+        const size_t numRows = timeCol.size();
+        if (numRows == 0 || time <= timeCol.front())
+            return 0;
+        if (time > timeCol.back())
+            return numRows;
+
+        // Here, the index sought is in [1, numRows - 1].
+        const auto isIndexSought = [&](const size_t index) {
+            return index > 0 && index < numRows &&
+                   timeCol[index - 1] < time && time <= timeCol[index];
+        };
+        if (isIndexSought(hint))
+            return hint;
+        if (isIndexSought(hint + 1))
+            return hint + 1;
+
+        // The index sought if the time column is uniformly sampled.
+        const double position = (time - timeCol.front()) /
+                                (timeCol.back() - timeCol.front()) *
+                                static_cast<double>(numRows - 1);
+        if (position >= 0 && position < static_cast<double>(numRows)) {
+            const size_t guess = static_cast<size_t>(std::ceil(position));
+            for (const size_t index : {guess, guess - 1, guess + 1})
+                if (isIndexSought(index))
+                    return index;
+        }
+
+        return std::distance(timeCol.begin(),
+                std::lower_bound(timeCol.begin(), timeCol.end(), time));
     }
 
     /** Get row whose time column is nearest/closest to the given value. 
@@ -357,22 +521,186 @@ public:
                          TimeOutOfRange,
                          endTime, timeCol.front(), timeCol.back());
 
+        // The rows in the range, summed a column at a time (the columns are
+        // contiguous).
+        const size_t beginRow = getRowIndexAtOrAfterTime(beginTime);
+        size_t endRow = getRowIndexAtOrAfterTime(endTime, beginRow);
+        while(endRow < timeCol.size() && timeCol[endRow] <= endTime)
+            ++endRow;
         std::vector<double> comps(DT::numComponentsPerElement(), 0);
         RowVector row{static_cast<int>(DT::getNumColumns()),
                       DT::makeElement(comps.begin(), comps.end())};
-        unsigned numRowsInRange{};
-        for(unsigned r = 0; r < DT::getNumRows(); ++r) {
-            if(timeCol[r] >= beginTime && timeCol[r] <= endTime) {
-                row += DT::getRowAtIndex(r);
-                ++numRowsInRange;
-            }
+        const auto& matrix = DT::getMatrix();
+        for(int c = 0; c < matrix.ncol(); ++c) {
+            const auto column = matrix.col(c);
+            for(size_t r = beginRow; r < endRow; ++r)
+                row[c] += column[static_cast<int>(r)];
         }
+        unsigned numRowsInRange = static_cast<unsigned>(endRow - beginRow);
         row /= numRowsInRange;
 
         return row;
     }
 
+    /// @name Arithmetic
+    /// The following functions combine the table, element by element, with
+    /// another table or with a row. As in NumPy, a row is broadcast to every
+    /// row of the table, and a table with one column is broadcast to every
+    /// column; otherwise, the other table must have as many columns as this
+    /// one. The other table must have the same times as this one. The data
+    /// are traversed a column at a time, as they are stored.
+    /// @{
+
+    /** Add another table to this one.
+
+    	hrows IncorrectNumRows If the other table has a different number of
+                             rows.
+    	hrows IncorrectNumColumns If the other table has neither one column nor
+                                as many as this table.
+    	hrows InvalidTable If the other table has different times.             */
+    void add(const TimeSeriesTable_& other) {
+        transformElements(other, [](ETY& element, const ETY& value) {
+            element += value;
+        });
+    }
+    /** Subtract another table from this one; see add(). */
+    void subtract(const TimeSeriesTable_& other) {
+        transformElements(other, [](ETY& element, const ETY& value) {
+            element -= value;
+        });
+    }
+    /** Multiply the elements of this table by those of a table of scalars;
+    see add(). */
+    void multiply(const TimeSeriesTable_<double>& factors) {
+        transformElements(factors, [](ETY& element, double factor) {
+            element *= factor;
+        });
+    }
+    /** Divide the elements of this table by those of a table of scalars;
+    see add(). */
+    void divide(const TimeSeriesTable_<double>& divisors) {
+        transformElements(divisors, [](ETY& element, double divisor) {
+            element /= divisor;
+        });
+    }
+
+    /** Add a row to every row of this table.
+
+    	hrows IncorrectNumColumns If the row is not as long as a row of this
+                                table.                                      */
+    void add(const RowVector& row) {
+        transformElements(row, [](ETY& element, const ETY& value) {
+            element += value;
+        });
+    }
+    /** Subtract a row from every row of this table; see add(). */
+    void subtract(const RowVector& row) {
+        transformElements(row, [](ETY& element, const ETY& value) {
+            element -= value;
+        });
+    }
+    /** Multiply every row of this table, element by element, by a row of
+    scalars; see add(). */
+    void multiply(const SimTK::RowVector_<double>& factors) {
+        transformElements(factors, [](ETY& element, double factor) {
+            element *= factor;
+        });
+    }
+    /** Divide every row of this table, element by element, by a row of
+    scalars; see add(). */
+    void divide(const SimTK::RowVector_<double>& divisors) {
+        transformElements(divisors, [](ETY& element, double divisor) {
+            element /= divisor;
+        });
+    }
+
+    /** Compute the running integral of each column over time, with the
+    trapezoidal rule: row r of the returned table, which has the times, labels
+    and metadata of this table, holds the integrals from the first time to
+    the time of row r (so the first row is zero).                           */
+    TimeSeriesTable_ integrate() const {
+        using DT = DataTable_<double, ETY>;
+        TimeSeriesTable_ integral{*this};
+        const auto& timeCol = DT::getIndependentColumn();
+        std::vector<double> comps(DT::numComponentsPerElement(), 0);
+        const ETY zero = DT::makeElement(comps.begin(), comps.end());
+        const auto& matrix = DT::getMatrix();
+        auto& integralMatrix = integral.updMatrix();
+        for(int c = 0; c < matrix.ncol(); ++c) {
+            const auto column = matrix.col(c);
+            auto integralColumn = integralMatrix.updCol(c);
+            ETY sum = zero;
+            if(matrix.nrow() > 0) integralColumn[0] = zero;
+            for(int r = 1; r < matrix.nrow(); ++r) {
+                sum += (column[r - 1] + column[r]) *
+                       (0.5 * (timeCol[r] - timeCol[r - 1]));
+                integralColumn[r] = sum;
+            }
+        }
+        return integral;
+    }
+    /// @}
+
 protected:
+    // Apply op(element, value) to each element of this table, with the
+    // corresponding element of the other table as the value.
+    template<typename OtherETY, typename Op>
+    void transformElements(const TimeSeriesTable_<OtherETY>& other, Op op) {
+        using DT = DataTable_<double, ETY>;
+        OPENSIM_THROW_IF(other.getNumRows() != DT::getNumRows(),
+                         IncorrectNumRows,
+                         DT::getNumRows(), other.getNumRows());
+        OPENSIM_THROW_IF(other.getNumColumns() != 1 &&
+                         other.getNumColumns() != DT::getNumColumns(),
+                         IncorrectNumColumns,
+                         DT::getNumColumns(), other.getNumColumns());
+        OPENSIM_THROW_IF(other.getIndependentColumn() !=
+                         DT::getIndependentColumn(),
+                         InvalidTable,
+                         "The tables have different times.");
+        const auto& otherMatrix = other.getMatrix();
+        auto& matrix = DT::updMatrix();
+        for(int c = 0; c < matrix.ncol(); ++c) {
+            auto column = matrix.updCol(c);
+            const auto otherColumn =
+                otherMatrix.col(otherMatrix.ncol() == 1 ? 0 : c);
+            for(int r = 0; r < matrix.nrow(); ++r)
+                op(column[r], otherColumn[r]);
+        }
+    }
+
+    // Apply op(element, value) to each element of this table, with the
+    // element of the row in the same column as the value.
+    template<typename OtherETY, typename Op>
+    void transformElements(const SimTK::RowVector_<OtherETY>& row, Op op) {
+        using DT = DataTable_<double, ETY>;
+        OPENSIM_THROW_IF(static_cast<size_t>(row.size()) !=
+                         DT::getNumColumns(),
+                         IncorrectNumColumns,
+                         DT::getNumColumns(), static_cast<size_t>(row.size()));
+        auto& matrix = DT::updMatrix();
+        for(int c = 0; c < matrix.ncol(); ++c) {
+            auto column = matrix.updCol(c);
+            const OtherETY& value = row[c];
+            for(int r = 0; r < matrix.nrow(); ++r)
+                op(column[r], value);
+        }
+    }
+
+    /** Check that the time column is strictly increasing.
+
+    \throws InvalidTable If the time column is not strictly increasing.     */
+    void validateTimeColumn() const {
+        using DT = DataTable_<double, ETY>;
+
+        OPENSIM_THROW_IF(!std::is_sorted(DT::_indData.cbegin(), 
+                                         DT::_indData.cend()) ||
+                         std::adjacent_find(DT::_indData.cbegin(), 
+                                            DT::_indData.cend()) != 
+                         DT::_indData.cend(),
+                         TimeColumnNotIncreasing);
+    }
+
     /** Validate the given row. 
 
     \throws InvalidRow If the timestamp for the row breaks strictly increasing
@@ -404,6 +732,251 @@ typedef TimeSeriesTable_<SimTK::Real> TimeSeriesTable;
 
 /** See TimeSeriesTable_ for details on the interface.                        */
 typedef TimeSeriesTable_<SimTK::Vec3> TimeSeriesTableVec3;
+
+#ifndef SWIG
+/** TimeSeriesTableView_ is a read-only view of a range of the rows (a time
+window) and a selection of the columns of a TimeSeriesTable_. The view refers
+to the table rather than copying its data, so selecting, e.g., the trial
+period of a long recording, or a few markers to track, costs the same
+regardless of the size of the table.
+
+The view is accepted, in place of a table, by the writers of the file adapters
+(e.g., STOFileAdapter_::write(), which write only the data in the view), and
+by MarkersReference and TableSource_ (which keep a copy of only the data in
+the view). Use toTable() or flatten() to copy the data in the view to a new
+table.
+
+The table must outlive the view. Rows may be appended to the table while the
+view is in use, but rows and columns must not be removed.
+
+\code
+TimeSeriesTableVec3 markers{"walk.trc"};
+// The markers on the feet, from 1 to 2.5 seconds.
+TimeSeriesTableViewVec3 view{markers, 1.0, 2.5,
+                             {"R.Heel", "R.Toe", "L.Heel", "L.Toe"}};
+TRCFileAdapter::write(view, "feet.trc");
+\endcode                                                                    */
+template<typename ETY = SimTK::Real>
+class TimeSeriesTableView_ {
+public:
+    typedef TimeSeriesTable_<ETY>  Table;
+    typedef SimTK::RowVector_<ETY> RowVector;
+
+    /** View all the rows and columns of a table.                             */
+    explicit TimeSeriesTableView_(const Table& table) :
+        TimeSeriesTableView_{&table} {
+        _columns.reserve(table.getNumColumns());
+        for(size_t c = 0; c < table.getNumColumns(); ++c)
+            _columns.push_back(c);
+    }
+
+    /** View the rows of a table whose times are in the range
+    [beginTime, endTime] (which need not be times in the table), and all the
+    columns.
+
+    \throws InvalidTimeRange If endTime is less than beginTime.              */
+    TimeSeriesTableView_(const Table& table,
+                         double beginTime, double endTime) :
+        TimeSeriesTableView_{table} {
+        selectTimeRange(beginTime, endTime);
+    }
+
+    /** View all the rows of a table, and the columns with the given labels,
+    in the given order.
+
+    \throws NoColumnLabels If the table has no column labels.
+    \throws KeyNotFound If the table has no column with one of the labels.  */
+    TimeSeriesTableView_(const Table& table,
+                         const std::vector<std::string>& columnLabels) :
+        TimeSeriesTableView_{&table} {
+        selectColumns(columnLabels);
+    }
+
+    /** View the rows of a table whose times are in the range
+    [beginTime, endTime], and the columns with the given labels, in the given
+    order.
+
+    \throws InvalidTimeRange If endTime is less than beginTime.
+    \throws NoColumnLabels If the table has no column labels.
+    \throws KeyNotFound If the table has no column with one of the labels.  */
+    TimeSeriesTableView_(const Table& table,
+                         double beginTime, double endTime,
+                         const std::vector<std::string>& columnLabels) :
+        TimeSeriesTableView_{&table} {
+        selectTimeRange(beginTime, endTime);
+        selectColumns(columnLabels);
+    }
+
+    /** Get the table this view refers to.                                    */
+    const Table& getTable() const {
+        return *_table;
+    }
+
+    /** Get number of rows in the view.                                       */
+    size_t getNumRows() const {
+        return _endRow - _beginRow;
+    }
+
+    /** Get number of (dependent) columns in the view.                        */
+    size_t getNumColumns() const {
+        return _columns.size();
+    }
+
+    /** Get the index, in the table, of a row of the view.
+
+    \throws RowIndexOutOfRange If rowIndex is out of range.                  */
+    size_t getRowIndexInTable(size_t rowIndex) const {
+        OPENSIM_THROW_IF(rowIndex >= getNumRows(),
+                         RowIndexOutOfRange, rowIndex, 0, getNumRows() - 1);
+        return _beginRow + rowIndex;
+    }
+
+    /** Get the index, in the table, of a column of the view.
+
+    \throws ColumnIndexOutOfRange If columnIndex is out of range.            */
+    size_t getColumnIndexInTable(size_t columnIndex) const {
+        OPENSIM_THROW_IF(columnIndex >= getNumColumns(),
+                         ColumnIndexOutOfRange,
+                         columnIndex, 0, getNumColumns() - 1);
+        return _columns[columnIndex];
+    }
+
+    /** Get the time of a row of the view.
+
+    \throws RowIndexOutOfRange If rowIndex is out of range.                  */
+    double getTimeAtIndex(size_t rowIndex) const {
+        return _table->getIndependentColumn()[getRowIndexInTable(rowIndex)];
+    }
+
+    /** Get an element of the view, without copying it.
+
+    \throws RowIndexOutOfRange If rowIndex is out of range.
+    \throws ColumnIndexOutOfRange If columnIndex is out of range.            */
+    const ETY& getElementAtIndex(size_t rowIndex, size_t columnIndex) const {
+        return _table->getMatrix()(
+                static_cast<int>(getRowIndexInTable(rowIndex)),
+                static_cast<int>(getColumnIndexInTable(columnIndex)));
+    }
+
+    /** Get (a copy of) the elements of a row of the view.
+
+    \throws RowIndexOutOfRange If rowIndex is out of range.                  */
+    RowVector getRowAtIndex(size_t rowIndex) const {
+        const auto& tableRow = _table->getRowAtIndex(
+                getRowIndexInTable(rowIndex));
+        RowVector row(static_cast<int>(getNumColumns()));
+        for(size_t c = 0; c < getNumColumns(); ++c)
+            row[static_cast<int>(c)] = tableRow[static_cast<int>(_columns[c])];
+        return row;
+    }
+
+    /** Get the labels of the columns of the view.
+
+    \throws NoColumnLabels If the table has no column labels.                */
+    std::vector<std::string> getColumnLabels() const {
+        std::vector<std::string> labels{};
+        labels.reserve(getNumColumns());
+        for(size_t c = 0; c < getNumColumns(); ++c)
+            labels.push_back(getColumnLabel(c));
+        return labels;
+    }
+
+    /** Get the label of a column of the view.
+
+    \throws NoColumnLabels If the table has no column labels.
+    \throws ColumnIndexOutOfRange If columnIndex is out of range.            */
+    const std::string& getColumnLabel(size_t columnIndex) const {
+        return _table->getColumnLabel(getColumnIndexInTable(columnIndex));
+    }
+
+    /** Get the metadata of the dependent columns of the view: the entries of
+    the table's metadata (of std::string type, such as the labels) for the
+    columns of the view. The metadata of other types are included only if
+    the view has all the columns of the table, in order, since their type is
+    needed to select entries.                                                 */
+    AbstractDataTable::DependentsMetaData getDependentsMetaData() const {
+        const auto& tableMetaData = _table->getDependentsMetaData();
+        if(hasAllColumns())
+            return tableMetaData;
+
+        AbstractDataTable::DependentsMetaData metaData{};
+        for(const auto& key : tableMetaData.getKeys()) {
+            const auto* values = dynamic_cast<const ValueArray<std::string>*>(
+                    &tableMetaData.getValueArrayForKey(key));
+            if(!values)
+                continue;
+            ValueArray<std::string> viewValues{};
+            for(const size_t c : _columns)
+                viewValues.upd().push_back(values->get().at(c));
+            metaData.setValueArrayForKey(key, viewValues);
+        }
+        return metaData;
+    }
+
+    /** Copy the data in the view to a new table.                            */
+    Table toTable() const {
+        return Table{*this};
+    }
+
+    /** Flatten the columns of the view to create a TimeSeriesTable_<double>,
+    copying only the data in the view; see DataTable_::flatten().            */
+    TimeSeriesTable_<double> flatten() const {
+        return TimeSeriesTable_<double>{*this, {}};
+    }
+
+    /** Flatten the columns of the view to create a TimeSeriesTable_<double>,
+    with the given suffixes for the column labels of the components; see
+    DataTable_::flatten().                                                    */
+    TimeSeriesTable_<double>
+    flatten(const std::vector<std::string>& suffixes) const {
+        return TimeSeriesTable_<double>{*this, suffixes};
+    }
+
+private:
+    // All the rows of the table, and no columns.
+    explicit TimeSeriesTableView_(const Table* table) :
+        _table{table}, _beginRow{0}, _endRow{table->getNumRows()} {}
+
+    void selectTimeRange(double beginTime, double endTime) {
+        OPENSIM_THROW_IF(endTime < beginTime,
+                         InvalidTimeRange, beginTime, endTime);
+        const auto& times = _table->getIndependentColumn();
+        _beginRow = _table->getRowIndexAtOrAfterTime(beginTime);
+        _endRow = _table->getRowIndexAtOrAfterTime(endTime, _beginRow);
+        if(_endRow < times.size() && times[_endRow] == endTime)
+            ++_endRow;
+    }
+
+    void selectColumns(const std::vector<std::string>& columnLabels) {
+        _columns.clear();
+        _columns.reserve(columnLabels.size());
+        for(const auto& label : columnLabels)
+            _columns.push_back(_table->getColumnIndex(label));
+    }
+
+    bool hasAllColumns() const {
+        if(_columns.size() != _table->getNumColumns())
+            return false;
+        for(size_t c = 0; c < _columns.size(); ++c)
+            if(_columns[c] != c)
+                return false;
+        return true;
+    }
+
+    const Table*        _table;
+    // The rows of the view are the rows [_beginRow, _endRow) of the table.
+    size_t              _beginRow;
+    size_t              _endRow;
+    // Indices, in the table, of the columns of the view.
+    std::vector<size_t> _columns;
+}; // TimeSeriesTableView_
+
+/** See TimeSeriesTableView_ for details on the interface.                    */
+typedef TimeSeriesTableView_<SimTK::Real> TimeSeriesTableView;
+
+/** See TimeSeriesTableView_ for details on the interface.                    */
+typedef TimeSeriesTableView_<SimTK::Vec3> TimeSeriesTableViewVec3;
+#endif
 } // namespace OpenSim
 
 #endif // OPENSIM_TIME_SERIES_DATA_TABLE_H_
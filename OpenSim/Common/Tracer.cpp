@@ -0,0 +1,178 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  Tracer.cpp                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Tracer.h"
+#include "Exception.h"
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+using namespace OpenSim;
+
+std::atomic<bool> Tracer::_enabled(false);
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct SpanRecord {
+    const char* category;
+    const char* name;
+    std::string detail;
+    int thread;
+    long long start; // microseconds since the epoch below
+    long long duration;
+};
+
+// The spans are appended under a mutex; they are only recorded while
+// tracing is enabled, so this does not cost anything otherwise.
+std::mutex spansMutex;
+std::vector<SpanRecord> spans;
+
+// Times are relative to the first use of the Tracer.
+const Clock::time_point& epoch()
+{
+    static const Clock::time_point start = Clock::now();
+    return start;
+}
+
+// Threads are numbered in the order in which they record their first span.
+int threadNumber()
+{
+    static std::atomic<int> numThreads(0);
+    thread_local const int number = ++numThreads;
+    return number;
+}
+
+long long microseconds(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            duration).count();
+}
+
+void writeJSONString(std::ostream& out, const std::string& str)
+{
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (const char c : str) {
+        switch (c) {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+            else
+                out << c;
+        }
+    }
+    out << '"';
+}
+}
+
+void Tracer::Span::begin(const char* category, const char* name,
+                         const std::string* detail)
+{
+    epoch();
+    _category = category;
+    _name = name;
+    if (detail) _detail = *detail;
+    _start = Clock::now();
+}
+
+void Tracer::Span::end()
+{
+    const auto stop = Clock::now();
+    SpanRecord record{_category, _name, std::move(_detail), threadNumber(),
+                      microseconds(_start - epoch()),
+                      microseconds(stop - _start)};
+    std::lock_guard<std::mutex> lock(spansMutex);
+    spans.push_back(std::move(record));
+}
+
+int Tracer::getNumSpans()
+{
+    std::lock_guard<std::mutex> lock(spansMutex);
+    return int(spans.size());
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(spansMutex);
+    spans.clear();
+}
+
+std::vector<Tracer::SpanTotal> Tracer::getSpanTotals()
+{
+    std::lock_guard<std::mutex> lock(spansMutex);
+    std::vector<SpanTotal> totals;
+    std::map<std::pair<std::string, std::string>, std::size_t> indices;
+    for (const SpanRecord& span : spans) {
+        const auto key = std::make_pair(std::string(span.category),
+                                        std::string(span.name));
+        const auto it = indices.find(key);
+        if (it == indices.end()) {
+            indices[key] = totals.size();
+            totals.push_back({key.first, key.second, 0, 0});
+        }
+        SpanTotal& total = totals[indices[key]];
+        ++total.count;
+        total.seconds += 1e-6*span.duration;
+    }
+    return totals;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock(spansMutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        const SpanRecord& span = spans[i];
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        writeJSONString(out, span.name);
+        out << ",\"cat\":";
+        writeJSONString(out, span.category);
+        out << ",\"ph\":\"X\",\"ts\":" << span.start
+            << ",\"dur\":" << span.duration
+            << ",\"pid\":1,\"tid\":" << span.thread;
+        if (!span.detail.empty()) {
+            out << ",\"args\":{\"detail\":";
+            writeJSONString(out, span.detail);
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+    out.flush();
+}
+
+void Tracer::writeChromeTrace(const std::string& fileName)
+{
+    std::ofstream out(fileName);
+    OPENSIM_THROW_IF(!out, Exception,
+            "Tracer: could not open '" + fileName + "' for writing.");
+    writeChromeTrace(out);
+}
@@ -0,0 +1,137 @@
+#ifndef OPENSIM_TRACER_H_
+#define OPENSIM_TRACER_H_
+/* -------------------------------------------------------------------------- *
+ *                            OpenSim:  Tracer.h                              *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** The Tracer records the spans of time spent in the phases of a pipeline
+(reading and writing files, finalizing and initializing models, integrating,
+realizing, solving the frames of the tools) on each thread, and writes them
+in the Chrome trace event format, which can be viewed in Perfetto
+(https://ui.perfetto.dev) or chrome://tracing:
+
+@code{.cpp}
+Tracer::setEnabled(true);
+InverseKinematicsTool ik("setup_ik.xml");
+ik.run();
+Tracer::setEnabled(false);
+Tracer::writeChromeTrace("ik_trace.json");
+@endcode
+
+Where the ComponentProfiler shows which components are slow, the Tracer shows
+when, and in which phase, the time of a whole run goes. A span is recorded
+with OPENSIM_TRACE_SPAN, which is only a check of a flag when tracing is
+disabled (the default), and nothing at all if OpenSim is built with
+OPENSIM_DISABLE_TRACING defined (see the CMake option
+OPENSIM_WITH_TRACING). */
+class OSIMCOMMON_API Tracer {
+public:
+    /** Turn tracing on or off for all threads. Spans that are open when
+    tracing is turned off are still recorded when they close. */
+    static void setEnabled(bool enabled) { _enabled.store(enabled); }
+    static bool isEnabled()
+    {   return _enabled.load(std::memory_order_relaxed); }
+
+    /** The number of spans recorded since the last clear(). */
+    static int getNumSpans();
+    /** Forget the spans recorded so far. */
+    static void clear();
+
+    /** The number and the total duration of the spans of one category and
+    name. */
+    struct SpanTotal {
+        std::string category;
+        std::string name;
+        int count;
+        double seconds;
+    };
+    /** The totals of the spans recorded since the last clear(), by category
+    and name, in the order of the first span of each. Comparing the mean
+    duration of a span across runs on different numbers of threads shows
+    where the threads contend (e.g., for a lock or memory bandwidth). */
+    static std::vector<SpanTotal> getSpanTotals();
+
+    /** Write the spans recorded so far as a Chrome trace (JSON) with one
+    complete event per span. Times are in microseconds since the first use
+    of the Tracer. */
+    static void writeChromeTrace(std::ostream& out);
+    /** Write the Chrome trace to a file.
+    @throws Exception If the file cannot be written. */
+    static void writeChromeTrace(const std::string& fileName);
+
+    /** Record the time from construction to destruction as a span of the
+    given category and name. The category and name must outlive the Span,
+    e.g., be string literals; a detail (e.g., the name of a file) is
+    copied, and only if tracing is enabled. */
+    class OSIMCOMMON_API Span {
+    public:
+        Span(const char* category, const char* name) {
+            if (isEnabled()) begin(category, name, nullptr);
+        }
+        Span(const char* category, const char* name,
+             const std::string& detail) {
+            if (isEnabled()) begin(category, name, &detail);
+        }
+        ~Span() { if (_name) end(); }
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    private:
+        void begin(const char* category, const char* name,
+                   const std::string* detail);
+        void end();
+        const char* _category = nullptr;
+        const char* _name = nullptr;
+        std::string _detail;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+} // end of namespace OpenSim
+
+#define OPENSIM_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENSIM_TRACE_CONCAT(a, b) OPENSIM_TRACE_CONCAT_IMPL(a, b)
+
+/** Trace the rest of the enclosing scope as a span of the given category and
+name, optionally with a detail (see Tracer::Span). Expands to nothing if
+OPENSIM_DISABLE_TRACING is defined. */
+#ifndef OPENSIM_DISABLE_TRACING
+#define OPENSIM_TRACE_SPAN(...) \
+    OpenSim::Tracer::Span OPENSIM_TRACE_CONCAT(opensimTraceSpan, __LINE__)( \
+            __VA_ARGS__)
+#else
+#define OPENSIM_TRACE_SPAN(...) do {} while (false)
+#endif
+
+#endif // OPENSIM_TRACER_H_
@@ -0,0 +1,114 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TrajectoryCompressor.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TrajectoryCompressor.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+using namespace OpenSim;
+
+namespace {
+const double Infinity = std::numeric_limits<double>::infinity();
+}
+
+TrajectoryCompressor::TrajectoryCompressor(double tolerance) :
+        _tolerance(tolerance) {
+    OPENSIM_THROW_IF(!(tolerance >= 0), Exception,
+                     "Expected a tolerance of zero or more, but got " +
+                     std::to_string(tolerance) + ".");
+}
+
+void TrajectoryCompressor::clear() {
+    *this = TrajectoryCompressor(_tolerance);
+}
+
+bool TrajectoryCompressor::offer(double time, const double* values,
+                                 int numValues) {
+    if (_numAppended > 0) {
+        const double lastTime = _hasPending ? _pendingTime : _keptTime;
+        OPENSIM_THROW_IF(!(time > lastTime), Exception,
+                         "Expected increasing times, but time " +
+                         std::to_string(time) + " follows " +
+                         std::to_string(lastTime) + ".");
+        OPENSIM_THROW_IF(numValues != int(_kept.size()), Exception,
+                         "Expected " + std::to_string(_kept.size()) +
+                         " values, but got " + std::to_string(numValues) +
+                         ".");
+    }
+    ++_numAppended;
+
+    // The first sample is kept.
+    if (_numAppended == 1) {
+        _keptTime = time;
+        _kept.assign(values, values + numValues);
+        _pending.resize(numValues);
+        _minSlope.assign(numValues, -Infinity);
+        _maxSlope.assign(numValues, Infinity);
+        ++_numKept;
+        return true;
+    }
+
+    // The pending sample is dropped if the line from the last kept sample
+    // to this one passes within the tolerance of it and of the samples
+    // dropped before it; otherwise, it is kept.
+    bool dropPending = true;
+    if (_hasPending) {
+        const double pendingStep = _pendingTime - _keptTime;
+        const double step = time - _keptTime;
+        for (int i = 0; i < numValues && dropPending; ++i) {
+            const double minSlope = std::max(_minSlope[i],
+                    (_pending[i] - _tolerance - _kept[i])/pendingStep);
+            const double maxSlope = std::min(_maxSlope[i],
+                    (_pending[i] + _tolerance - _kept[i])/pendingStep);
+            const double slope = (values[i] - _kept[i])/step;
+            dropPending = minSlope <= slope && slope <= maxSlope;
+        }
+        if (dropPending) {
+            for (int i = 0; i < numValues; ++i) {
+                _minSlope[i] = std::max(_minSlope[i],
+                        (_pending[i] - _tolerance - _kept[i])/pendingStep);
+                _maxSlope[i] = std::min(_maxSlope[i],
+                        (_pending[i] + _tolerance - _kept[i])/pendingStep);
+            }
+        }
+    }
+
+    const bool kept = !dropPending && keepPending();
+    _hasPending = true;
+    _pendingTime = time;
+    std::copy(values, values + numValues, _pending.begin());
+    return kept;
+}
+
+bool TrajectoryCompressor::keepPending() {
+    if (!_hasPending) return false;
+    _hasPending = false;
+    _keptTime = _pendingTime;
+    _kept.swap(_pending);
+    std::fill(_minSlope.begin(), _minSlope.end(), -Infinity);
+    std::fill(_maxSlope.begin(), _maxSlope.end(), Infinity);
+    ++_numKept;
+    return true;
+}
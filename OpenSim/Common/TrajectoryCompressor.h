@@ -0,0 +1,115 @@
+#ifndef OPENSIM_TRAJECTORY_COMPRESSOR_H_
+#define OPENSIM_TRAJECTORY_COMPRESSOR_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  TrajectoryCompressor.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include "osimCommonDLL.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+/** Drops the samples of a trajectory (values sampled at increasing times)
+that linear interpolation between the samples it keeps reproduces within a
+tolerance. Every value of a dropped sample differs by at most the tolerance
+from the linear interpolation, at its time, of the kept samples before and
+after it; the kept samples keep their original times and values, and the
+first and last samples are always kept. A reader that interpolates linearly
+between samples (e.g., Storage::getDataAtTime()) therefore sees the
+trajectory within the tolerance without knowing that it was compressed.
+
+Smooth, slowly changing values, as most reported outputs are, are
+represented by few samples. The samples are examined as they are appended,
+in time linear in their number (each sample is compared with the range of
+slopes that the samples dropped since the last kept sample allow), so that
+a reporter can compress a trajectory while it is reported:
+
+@code{.cpp}
+TrajectoryCompressor compressor(1e-4);
+auto keep = [&](double t, const double* v) { storage.append(t, n, v); };
+for (...) compressor.append(time, values, n, keep);
+compressor.finish(keep);
+@endcode */
+class OSIMCOMMON_API TrajectoryCompressor {
+public:
+    /** With a tolerance of zero, only the samples that are exactly on the
+    line between their neighbors are dropped.
+    @throws Exception if the tolerance is negative. */
+    explicit TrajectoryCompressor(double tolerance = 0);
+
+    double getTolerance() const { return _tolerance; }
+
+    /** Append the next sample, with numValues values (as many as the
+    previous samples) at a time later than that of the previous sample. The
+    samples found to be kept are passed, in order, to keep(time, values). A
+    sample is known to be kept only when a later sample is appended or
+    finish() is called, so keep() is called, if at all, for the previous
+    sample (or, for the first sample, for this one). The values passed to
+    keep() are valid during the call only.
+    @throws Exception if the time is not later than the previous time, or
+    if numValues differs from that of the previous samples. */
+    template <typename Keep>
+    void append(double time, const double* values, int numValues, Keep keep) {
+        if (offer(time, values, numValues))
+            keep(_keptTime, _kept.data());
+    }
+
+    /** Keep the last sample appended, if it has not been kept, passing it
+    to keep(time, values). Samples may still be appended afterwards. */
+    template <typename Keep>
+    void finish(Keep keep) {
+        if (keepPending()) keep(_keptTime, _kept.data());
+    }
+
+    /** Forget all samples. */
+    void clear();
+
+    /** The number of samples appended, and the number kept so far. */
+    int getNumAppended() const { return _numAppended; }
+    int getNumKept() const { return _numKept; }
+
+private:
+    // Add the sample; return true if a sample was kept, which is then in
+    // _keptTime and _kept.
+    bool offer(double time, const double* values, int numValues);
+    // Keep the pending sample, if any; return true if there was one.
+    bool keepPending();
+
+    double _tolerance;
+    int _numAppended = 0;
+    int _numKept = 0;
+    // The last sample kept, from which the line to a later sample starts.
+    double _keptTime = 0;
+    std::vector<double> _kept;
+    // The last sample appended, if it has not been kept.
+    bool _hasPending = false;
+    double _pendingTime = 0;
+    std::vector<double> _pending;
+    // For each value, the range of slopes of a line from the last kept
+    // sample that passes within the tolerance of the samples dropped since.
+    std::vector<double> _minSlope, _maxSlope;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TRAJECTORY_COMPRESSOR_H_
@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "MemoryUsage.h"
 #include "Object.h"
 #include "RegisterTypes_osimCommon.h"
 #include "FunctionSet.h"
@@ -30,6 +31,7 @@
 #include "ScaleSet.h"
 #include "GCVSpline.h"
 #include "IO.h"
+#include "CompressedFile.h"
 
 #include "Scale.h"
 #include "SimmSpline.h"
@@ -62,4 +64,11 @@
 
 #include "ModelDisplayHints.h"
 
+#include "SolverStatistics.h"
+#include "Tracer.h"
+#include "Parallelism.h"
+#include "ResultCache.h"
+#include "RunControl.h"
+#include "STOFileReader.h"
+
 #endif // OPENSIM_OSIMCOMMON_H_
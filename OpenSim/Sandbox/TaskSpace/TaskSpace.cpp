@@ -172,67 +172,34 @@ Vector TaskSpace::Inertia::multiplyByLambda(const State& s, const Vec3& a) const
 }
 
 //==============================================================================
-// InertiaInverse
+// MassMatrixInverseJacobianTranspose
 //==============================================================================
-void TaskSpace::InertiaInverse::updateCache(const State& s, Matrix& cache) const
+void TaskSpace::MassMatrixInverseJacobianTranspose::updateCache(const State& s,
+    Matrix& cache) const
 {
-    const SimbodyMatterSubsystem& matter = m_tspace->getMatterSubsystem();
-
-    const JacobianTranspose& JT = m_tspace->JT();
-    // TODO const Matrix& JT = m_tspace.JT().value();
-    const Matrix& J = m_tspace->J().getValue(s);
-    /* TODO
-    // TODO cache the result.
-
-    unsigned int nst = m_tspace.getNumScalarTasks();
-    unsigned int nu = m_tspace.getState().getNU();
+    const Matrix& JT = m_tspace->JT().getValue(s);
 
-    Matrix J = m_tspace.getJacobian().value();
-
-    Matrix MInvJt(nu, nst);
-
-    for (unsigned int j = 0; j < nst; ++j)
-    {
-        matter.multiplyByMInv(m_tspace.getState(), J.transpose()(j), MInvJt(j));
-    }
-
-    updCacheValue() = J * MInvJt;
-    */
-
-    unsigned int nt = m_tspace->getNumTasks();
     unsigned int nst = m_tspace->getNumScalarTasks();
     unsigned int nu = s.getNU();
 
-    Matrix& inertiaInverse = cache;
-    inertiaInverse.resize(nst, nst);
-
-    // Create temporary variables.
-    Vector Jtcol(nu);
-    Vector MInvJtcol(nu);
-    Vector_<Vec3> JMInvJt_j(nt);
-
-    // f_GP is used to pluck out one column at a time of Jt. Exactly one
-    // element at a time of f_GP will be 1, the rest are 0.
-    Vector f_GP(nst, Real(0));
+    Matrix& MInvJT = cache;
+    MInvJT.resize(nu, nst);
 
+    Vector MInvJTcol(nu);
     for (unsigned int j = 0; j < nst; ++j)
     {
-        f_GP[j] = 1;
-        Jtcol = JT.multiplyByJT(s, f_GP);
-        f_GP[j] = 0;
-
-        matter.multiplyByMInv(s, Jtcol, MInvJtcol);
+        m_tspace->getMatterSubsystem().multiplyByMInv(s, JT(j), MInvJTcol);
+        MInvJT(j) = MInvJTcol;
+    }
+}
 
-        // TODO replace with operator.
-        inertiaInverse(j) = J * MInvJtcol;
-        /* TODO
-        matter.multiplyByStationJacobian(m_tspace.getState(),
-                m_tspace.getMobilizedBodyIndices(), m_tspace.getStations(),
-                MInvJtcol, JMInvJt_j);
 
-        inertiaInverse(j) = JMInvJt_j;
-        */
-    }
+//==============================================================================
+// InertiaInverse
+//==============================================================================
+void TaskSpace::InertiaInverse::updateCache(const State& s, Matrix& cache) const
+{
+    cache = m_tspace->J().getValue(s) * m_tspace->MInvJT().getValue(s);
 }
 
 const TaskSpace::Inertia& TaskSpace::InertiaInverse::inverse() const
@@ -248,23 +215,7 @@ void TaskSpace::DynamicallyConsistentJacobianInverse::updateCache(const State& s
     Matrix& cache)
     const
 {
-    const JacobianTranspose& JT = m_tspace->getJacobianTranspose();
-    const Inertia& Lambda = m_tspace->getInertia();
-
-    // TODO inefficient?
-    Matrix JtLambda = JT.multiplyByJT(s, Lambda);
-
-    unsigned int nst = m_tspace->getNumScalarTasks();
-    unsigned int nu = s.getNU();
-
-    Matrix& Jbar = cache;
-    Jbar.resize(nu, nst);
-
-    for (unsigned int j = 0; j < nst; ++j)
-    {
-        m_tspace->getMatterSubsystem().multiplyByMInv(s,
-                JtLambda(j), Jbar(j));
-    }
+    cache = m_tspace->MInvJT().getValue(s) * m_tspace->Lambda().getValue(s);
 }
 
 const TaskSpace::DynamicallyConsistentJacobianInverseTranspose&
@@ -276,15 +227,9 @@ TaskSpace::DynamicallyConsistentJacobianInverse::transpose() const
 Vector TaskSpace::DynamicallyConsistentJacobianInverse::multiplyByJBar(
     const State& s, const Vector& vec) const
 {
-    const JacobianTranspose& JT = m_tspace->getJacobianTranspose();
-    const Inertia& Lambda = m_tspace->getInertia();
-
-    // TODO where is this even used? TODO test this.
-
-    Vector JBarvec;
-    m_tspace->getMatterSubsystem().multiplyByMInv(s,
-            JT.multiplyByJT(s, Lambda.multiplyByLambda(s, vec)), JBarvec);
-    return  JBarvec;
+    // Reuse A^{-1} J^T rather than solving the mass matrix again.
+    return m_tspace->MInvJT().getValue(s) *
+        m_tspace->Lambda().multiplyByLambda(s, vec);
 }
 
 Matrix TaskSpace::DynamicallyConsistentJacobianInverse::multiplyByJBar(
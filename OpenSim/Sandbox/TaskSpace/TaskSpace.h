@@ -83,6 +83,8 @@ public: \
     *  - \f$ p \f$ (nst x 1): task-space gravity forces.
     *  - \f$ \mu \f$ (nst x 1): task-space inertial forces.
     *  - \f$ J \f$ (nst x nu): task Jacobian.
+    *  - \f$ A^{-1} J^T \f$ (nu x nst): shared by \f$ \Lambda \f$ and
+    *    \f$ \bar{J} \f$, so that the mass matrix is solved once per state.
     *  - \f$ \bar{J} \f$ (nu x nst): dynamically consistent generalized inverse of the Jacobian.
     *  - \f$ N \f$ (nu x nu): nullspace projection matrix.
     *
@@ -219,6 +221,8 @@ public: \
             m_jacobian.setTaskSpace(this);
             addComponent(&m_jacobianTranspose);
             m_jacobianTranspose.setTaskSpace(this);
+            addComponent(&m_massMatrixInverseJacobianTranspose);
+            m_massMatrixInverseJacobianTranspose.setTaskSpace(this);
             addComponent(&m_inertia);
             m_inertia.setTaskSpace(this);
             addComponent(&m_inertiaInverse);
@@ -404,6 +408,30 @@ public: \
             void updateCache(const State& s, Matrix& cache) const override;
         };
 
+        /** The mass matrix solved with the transpose of the Jacobian;
+        * \f$ A^{-1} J^T \f$ (nu x nst).
+        *
+        * This is computed once per state, with one mass matrix solve per
+        * scalar task, and is used to compute both the Inertia matrix and the
+        * DynamicallyConsistentJacobianInverse.
+        */
+        class MassMatrixInverseJacobianTranspose :
+            public TaskSpaceQuantity<Matrix>
+        {
+            OpenSim_DECLARE_CONCRETE_OBJECT(MassMatrixInverseJacobianTranspose,
+                TaskSpaceQuantity<Matrix>);
+        public:
+
+            MassMatrixInverseJacobianTranspose()
+                : TaskSpaceQuantity<Matrix>("massMatrixInverseJacobianTranspose")
+            {
+            }
+
+        private:
+
+            void updateCache(const State& s, Matrix& cache) const override;
+        };
+
         /** Task-space inertia matrix; \f$ \Lambda = (J A^{-1} J^T)^{-1} \f$
         * (nst x nst).
         */
@@ -615,6 +643,7 @@ public: \
         /// @{
         TASKSPACEQUANTITY_MEMBERS(Jacobian, jacobian, J);
         TASKSPACEQUANTITY_MEMBERS(JacobianTranspose, jacobianTranspose, JT);
+        TASKSPACEQUANTITY_MEMBERS(MassMatrixInverseJacobianTranspose, massMatrixInverseJacobianTranspose, MInvJT);
         TASKSPACEQUANTITY_MEMBERS(Inertia, inertia, Lambda);
         TASKSPACEQUANTITY_MEMBERS(InertiaInverse, inertiaInverse, LambdaInv);
         TASKSPACEQUANTITY_MEMBERS(DynamicallyConsistentJacobianInverse, jacobianInverse, JBar);
@@ -48,6 +48,17 @@ AssemblySolver::AssemblySolver
     // default accuracy
     _accuracy = 1e-4;
 
+    _predictionOrder = 0;
+    _numIterationsInLastSolve = 0;
+    _numFunctionEvaluationsInLastSolve = 0;
+
+    _loosestAccuracy = 0;
+    _goalTolerance = 0.05;
+    _accuracyInAssembler = _accuracyOfNextTrack = _accuracyInLastSolve =
+        _accuracy;
+    _refinedInLastSolve = false;
+    _lastGoal = _lastStep = SimTK::NaN;
+
     // Get model coordinates
     const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
 
@@ -71,9 +82,41 @@ AssemblySolver::AssemblySolver
     }
 }
 
+void AssemblySolver::setTrackingPredictionOrder(int order)
+{
+    OPENSIM_THROW_IF(order < 0 || order > 2, Exception,
+        "AssemblySolver::setTrackingPredictionOrder() expected 0, 1 or 2 "
+        "but got " + std::to_string(order) + ".");
+    _predictionOrder = order;
+}
+
+void AssemblySolver::setAdaptiveAccuracy(double loosestAccuracy,
+                                         double goalTolerance)
+{
+    OPENSIM_THROW_IF(loosestAccuracy < 0 || goalTolerance < 0, Exception,
+        "AssemblySolver::setAdaptiveAccuracy() expected a non-negative "
+        "accuracy and tolerance but got " + std::to_string(loosestAccuracy) +
+        " and " + std::to_string(goalTolerance) + ".");
+    _loosestAccuracy = loosestAccuracy;
+    _goalTolerance = goalTolerance;
+    _accuracyOfNextTrack = _accuracy;
+}
+
+void AssemblySolver::setAssemblerAccuracy(double accuracy)
+{
+    if (accuracy == _accuracyInAssembler) return;
+    // Setting the accuracy uninitializes the Assembler; reinitialize it
+    // from its internal state, which holds the last solution.
+    const SimTK::State internalState = _assembler->getInternalState();
+    _assembler->setAccuracy(accuracy);
+    _assembler->initialize(internalState);
+    _accuracyInAssembler = accuracy;
+}
+
 void AssemblySolver::setAccuracy(double accuracy)
 {
     _accuracy = accuracy;
+    _accuracyInAssembler = _accuracyOfNextTrack = accuracy;
     // Changing the accuracy invalidates the existing SimTK::Assembler
     _assembler.reset();
 }
@@ -87,6 +130,7 @@ void AssemblySolver::setupGoals(SimTK::State &s)
     // wipe-out the previous SimTK::Assembler
     _assembler.reset(new SimTK::Assembler(getModel().getMultibodySystem()));
     _assembler->setAccuracy(_accuracy);
+    _accuracyInAssembler = _accuracy;
 
     // Define weights on constraints. Note can be specified SimTK::Infinity to strictly enforce constraint
     // otherwise the weighted constraint error becomes a goal.
@@ -94,13 +138,19 @@ void AssemblySolver::setupGoals(SimTK::State &s)
 
     // clear any old coordinate goals
     _coordinateAssemblyConditions.clear();
+    _coordinateAssemblyConditionIndices.clear();
+    _lockedInAssembler.clear();
 
     // Get model coordinates
     const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
 
     // Restrict solution to set range of any of the coordinates that are clamped
+    _lockedAtSetup.resize(modelCoordSet.getSize());
+    _clampedAtSetup.resize(modelCoordSet.getSize());
     for(int i=0; i<modelCoordSet.getSize(); ++i){
         const Coordinate& coord = modelCoordSet[i];
+        _lockedAtSetup[i] = coord.getLocked(s);
+        _clampedAtSetup[i] = coord.getClamped(s);
         if(coord.getClamped(s)){
             _assembler->restrictQ(coord.getBodyIndex(), 
                 MobilizerQIndex(coord.getMobilizerQIndex()),
@@ -121,6 +171,7 @@ void AssemblySolver::setupGoals(SimTK::State &s)
                 _assembler->lockQ(coord.getBodyIndex(), SimTK::MobilizerQIndex(coord.getMobilizerQIndex()));
                 //No longer need the lock on
                 coord.setLocked(s, false);
+                _lockedInAssembler.push_back(&coord);
                 
                 //Get rid of the corresponding reference too
                 _coordinateReferencesp.erase(p);
@@ -133,7 +184,9 @@ void AssemblySolver::setupGoals(SimTK::State &s)
                 // keep a handle to the goal so we can update
                 _coordinateAssemblyConditions.push_back(coordGoal);
                 // Add coordinate matching goal to the ik objective
-                _assembler->adoptAssemblyGoal(coordGoal, coordRef->getWeight(s));
+                _coordinateAssemblyConditionIndices.push_back(
+                    _assembler->adoptAssemblyGoal(coordGoal,
+                                                  coordRef->getWeight(s)));
             }
         }
     }
@@ -155,7 +208,7 @@ void AssemblySolver::updateCoordinateReference(const std::string &coordName, dou
     for(p = _coordinateReferencesp.begin(); 
         p != _coordinateReferencesp.end(); p++) {
         if(p->getName() == coordName){
-            p->setValueFunction(*new Constant(value));
+            p->setValueFunction(Constant(value));
             p->setWeight(weight);
             return;
         }
@@ -176,6 +229,20 @@ void AssemblySolver::updateGoals(const SimTK::State &s)
     }
 }
 
+/* Internal method to update the weights of the goals from their references,
+        based on the passed in state. */
+void AssemblySolver::updateGoalWeights(const SimTK::State &s)
+{
+    unsigned int nqrefs = _coordinateReferencesp.size();
+    for(unsigned int i=0; i<nqrefs; i++){
+        const double weight = _coordinateReferencesp[i].getWeight(s);
+        const SimTK::AssemblyConditionIndex cx =
+            _coordinateAssemblyConditionIndices[i];
+        if (_assembler->getAssemblyConditionWeight(cx) != weight)
+            _assembler->setAssemblyConditionWeight(cx, weight);
+    }
+}
+
 //______________________________________________________________________________
 /*
  * Assemble the model such that it satisfies configuration goals and constraints
@@ -204,11 +271,74 @@ void AssemblySolver::assemble(SimTK::State &state)
     cout << "Model numQs: " << _assembler->getInternalState().getNQ() 
         << " Assembler num freeQs: " << _assembler->getNumFreeQs() << endl;
     */
+    solveAssembly(state, s);
+}
+
+void AssemblySolver::reassemble(SimTK::State &state)
+{
+    // The goals and the Assembler can be reused only if they were set up
+    // for the same locked and clamped coordinates and constraint weight.
+    bool canReuse = _assembler &&
+        _assembler->getSystemConstraintsWeight() == _constraintWeight;
+    const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
+    canReuse = canReuse && int(_lockedAtSetup.size()) == modelCoordSet.getSize();
+    for(int i=0; canReuse && i<modelCoordSet.getSize(); ++i){
+        canReuse = modelCoordSet[i].getLocked(state) == _lockedAtSetup[i] &&
+                   modelCoordSet[i].getClamped(state) == _clampedAtSetup[i];
+    }
+    if(!canReuse){
+        assemble(state);
+        return;
+    }
+
+    // Work on a copy of the state, as assemble() does, in which the
+    // coordinates that the Assembler locks are unlocked (see setupGoals()).
+    SimTK::State s = state;
+    for(const Coordinate* coord : _lockedInAssembler)
+        coord->setLocked(s, false);
+
+    updateGoals(s);
+    updateGoalWeights(s);
+
+    // Start the Assembler's internal state from the given state; the goals
+    // are kept. The last track() may have left it at a relaxed accuracy.
+    if (_accuracyInAssembler != _accuracy) {
+        _assembler->setAccuracy(_accuracy);
+        _accuracyInAssembler = _accuracy;
+    }
+    _assembler->initialize(s);
+
+    solveAssembly(state, s);
+}
+
+int AssemblySolver::countFunctionEvaluations() const
+{
+    return _assembler->getNumGoalEvals() + _assembler->getNumErrorEvals() +
+           _assembler->getNumGoalGradientEvals() +
+           _assembler->getNumErrorJacobianEvals();
+}
+
+void AssemblySolver::solveAssembly(SimTK::State& state, SimTK::State& s)
+{
     try{
         // Now do the assembly and return the updated state.
+        const int numSteps = _assembler->getNumAssemblySteps();
+        const int numEvals = countFunctionEvaluations();
         _assembler->assemble();
+        _numIterationsInLastSolve =
+            _assembler->getNumAssemblySteps() - numSteps;
+        _numFunctionEvaluationsInLastSolve =
+            countFunctionEvaluations() - numEvals;
         // Update the q's in the state passed in
         _assembler->updateFromInternalState(s);
+
+        // Start the history of solutions from which track() extrapolates.
+        _solutionTimes.assign(1, state.getTime());
+        _solutionFreeQs.assign(1, _assembler->getFreeQsFromInternalState());
+        _accuracyInLastSolve = _accuracyOfNextTrack = _accuracy;
+        _refinedInLastSolve = false;
+        _lastGoal = _assembler->calcCurrentGoal();
+        _lastStep = SimTK::NaN;
         state.updQ() = s.getQ();
         state.updU() = s.getU();
 
@@ -252,6 +382,8 @@ void AssemblySolver::track(SimTK::State &s)
     // and their type (constrained vs. weighted)
 
     if(_assembler && _assembler->isInitialized()){
+        const bool adaptive = _loosestAccuracy > _accuracy;
+        setAssemblerAccuracy(adaptive ? _accuracyOfNextTrack : _accuracy);
         updateGoals(s);
     }
     else{
@@ -268,12 +400,92 @@ void AssemblySolver::track(SimTK::State &s)
         << " Assembler num freeQs: " << _assembler->getNumFreeQs() << endl;
     */
 
+    // Extrapolate the initial guess from as many of the most recent
+    // solutions as the prediction order calls for (Lagrange interpolation).
+    const int numPoints = std::min(_predictionOrder + 1,
+                                   int(_solutionTimes.size()));
+    const int first = int(_solutionTimes.size()) - numPoints;
+    bool predicted = false;
+    if (numPoints > 1 && s.getTime() != _solutionTimes.back()) {
+        SimTK::Vector guess(_solutionFreeQs.back().size(), 0.0);
+        for (int i = first; i < first + numPoints; ++i) {
+            double weight = 1.0;
+            for (int j = first; j < first + numPoints; ++j) {
+                if (j != i)
+                    weight *= (s.getTime() - _solutionTimes[j]) /
+                              (_solutionTimes[i] - _solutionTimes[j]);
+            }
+            guess += weight*_solutionFreeQs[i];
+        }
+        if (guess.isFinite()) {
+            _assembler->setInternalStateFromFreeQs(guess);
+            predicted = true;
+        }
+    }
+    if (refineTrackingGuess(s.getTime())) predicted = true;
+
     try{
         // Now do the assembly and return the updated state.
-        _assembler->track(s.getTime());
+        const int numSteps = _assembler->getNumAssemblySteps();
+        const int numEvals = countFunctionEvaluations();
+        try {
+            _assembler->track(s.getTime());
+        }
+        catch (const std::exception&) {
+            if (!predicted) throw;
+            // Retry from the previous solution.
+            _assembler->setInternalStateFromFreeQs(_solutionFreeQs.back());
+            _assembler->track(s.getTime());
+        }
+        _numIterationsInLastSolve =
+            _assembler->getNumAssemblySteps() - numSteps;
+        _numFunctionEvaluationsInLastSolve =
+            countFunctionEvaluations() - numEvals;
+        _accuracyInLastSolve = _accuracyInAssembler;
+        _refinedInLastSolve = false;
+
+        // Adapt the accuracy of the next frame; see setAdaptiveAccuracy().
+        if (_loosestAccuracy > _accuracy) {
+            double goal = _assembler->calcCurrentGoal();
+            const bool goalGrew = goal >
+                (1 + _goalTolerance)*_lastGoal + SimTK::SignificantReal;
+            if (goalGrew && _accuracyInLastSolve > _accuracy) {
+                // Solve the frame again, from its relaxed solution, at the
+                // accuracy set.
+                setAssemblerAccuracy(_accuracy);
+                updateGoals(s);
+                const int numRefineSteps = _assembler->getNumAssemblySteps();
+                const int numRefineEvals = countFunctionEvaluations();
+                _assembler->track(s.getTime());
+                _numIterationsInLastSolve +=
+                    _assembler->getNumAssemblySteps() - numRefineSteps;
+                _numFunctionEvaluationsInLastSolve +=
+                    countFunctionEvaluations() - numRefineEvals;
+                _accuracyInLastSolve = _accuracy;
+                _refinedInLastSolve = true;
+                goal = _assembler->calcCurrentGoal();
+            }
+            const double step = (_assembler->getFreeQsFromInternalState() -
+                                 _solutionFreeQs.back()).normInf();
+            // Comparisons with the NaN step after assemble() are false.
+            if (!goalGrew && step <= 1.5*_lastStep)
+                _accuracyOfNextTrack =
+                    std::min(_loosestAccuracy, 10*_accuracyInLastSolve);
+            else
+                _accuracyOfNextTrack = _accuracy;
+            _lastGoal = goal;
+            _lastStep = step;
+        }
 
         // update the state from the result of the assembler 
         _assembler->updateFromInternalState(s);
+
+        if (int(_solutionTimes.size()) > 2) {
+            _solutionTimes.erase(_solutionTimes.begin());
+            _solutionFreeQs.erase(_solutionFreeQs.begin());
+        }
+        _solutionTimes.push_back(s.getTime());
+        _solutionFreeQs.push_back(_assembler->getFreeQsFromInternalState());
         
         /* TODO: Useful to include through debug message/log in the future
         printf("Tracking: t= %f (acc=%g tol=%g normerr=%g, maxerr=%g, cost=%g)\n", 
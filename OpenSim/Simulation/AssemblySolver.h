@@ -27,6 +27,8 @@
 #include "OpenSim/Simulation/CoordinateReference.h"
 #include "simbody/internal/Assembler.h"
 
+#include <vector>
+
 namespace SimTK { 
 class QValue;
 class State;
@@ -34,6 +36,7 @@ class State;
 
 namespace OpenSim {
 
+class Coordinate;
 class Model;
 
 //=============================================================================
@@ -115,6 +118,64 @@ public:
         find a nearby solution due to a small change in the desired value.*/
     virtual void track(SimTK::State &s);
 
+    /** Assemble a model configuration, like assemble(), but reuse the
+        SimTK::Assembler and goals set up by the last call to assemble(): only
+        the goals' target values and weights are updated from their
+        references. This is much cheaper than assemble() when the same model
+        is assembled repeatedly (e.g., to a series of trials) from initial
+        states that need not be close to one another. assemble() is called
+        instead if there is no Assembler yet, or if the coordinates that are
+        locked or clamped, or the constraint weight, have changed since. The
+        model's System must not have been rebuilt since the last assemble().*/
+    void reassemble(SimTK::State &s);
+
+    /** %Set the order of the polynomial through the most recent solutions
+        that track() extrapolates to the new time for its initial guess:
+        0 (the default) starts from the previous solution, 1 extrapolates
+        linearly from the last two solutions, and 2 quadratically from the
+        last three. A good guess saves assembler iterations when the motion
+        changes much between frames. Until enough solutions are available
+        since the last assemble(), a lower order is used. If the assembler
+        fails from the extrapolated guess, track() retries from the previous
+        solution. */
+    void setTrackingPredictionOrder(int order);
+    int getTrackingPredictionOrder() const { return _predictionOrder; }
+
+    /** Let track() adapt its accuracy from frame to frame, between the
+        accuracy set by setAccuracy() and loosestAccuracy: while the goal
+        (e.g., the weighted squared marker errors) of the solutions does not
+        grow by more than the fraction goalTolerance from frame to frame, and
+        the change of the solution from frame to frame does not grow by more
+        than half, the accuracy is relaxed tenfold per frame, down to
+        loosestAccuracy, saving assembler iterations on smooth stretches of
+        a motion; otherwise the next frame is solved at the accuracy set.
+        A frame solved at a relaxed accuracy whose goal grew by more than
+        goalTolerance is solved again, from its relaxed solution, at the
+        accuracy set; this bounds the error that relaxing adds to a frame.
+        Changing the Assembler's accuracy reinitializes it, which costs about
+        as much as an iteration. A loosestAccuracy of 0 (the default), or
+        one no looser than the accuracy set, disables the adaptation. */
+    void setAdaptiveAccuracy(double loosestAccuracy,
+                             double goalTolerance = 0.05);
+    double getLoosestAccuracy() const { return _loosestAccuracy; }
+
+    /** The accuracy at which the last call to assemble() or track() was
+        solved, which, with adaptive accuracy (see setAdaptiveAccuracy()),
+        can be looser than the accuracy set. */
+    double getAccuracyInLastSolve() const { return _accuracyInLastSolve; }
+    /** Whether the last call to track() solved its frame again at the
+        accuracy set, after solving it at a relaxed accuracy (see
+        setAdaptiveAccuracy()); its iterations include both solves. */
+    bool getRefinedInLastSolve() const { return _refinedInLastSolve; }
+
+    /** The number of iterations (assembly steps) the assembler took in the
+        last call to assemble() or track(). */
+    int getNumIterationsInLastSolve() const { return _numIterationsInLastSolve; }
+    /** The number of evaluations of the goal, the errors and their
+        derivatives in the last call to assemble() or track(). */
+    int getNumFunctionEvaluationsInLastSolve() const
+    {   return _numFunctionEvaluationsInLastSolve; }
+
     /** Read access to the underlying SimTK::Assembler. */
     const SimTK::Assembler& getAssembler() const;
 
@@ -128,11 +189,31 @@ protected:
         weights that define the goals, based on the passed in state. This method
         is called at the end of setupGoals() and beginning of track()*/
     virtual void updateGoals(const SimTK::State &s);
+    /** Internal method to update the weights of the goals from their
+        references, based on the passed in state. This method is called by
+        reassemble(), after updateGoals(), before the Assembler is
+        reinitialized. */
+    virtual void updateGoalWeights(const SimTK::State &s);
+    /** Called by track(), once the goals are updated and the initial guess
+        is extrapolated (see setTrackingPredictionOrder()), to let subclasses
+        move the Assembler's internal state closer to the solution at the
+        given time before the Assembler tracks it. Return whether the
+        internal state was changed; the default does nothing. */
+    virtual bool refineTrackingGuess(double time) { return false; }
 
     /** Write access to the underlying SimTK::Assembler. */
     SimTK::Assembler& updAssembler();
 
 private:
+    // Assemble from the Assembler's initialized internal state and update
+    // the state with the solution; s is the working copy of the state.
+    void solveAssembly(SimTK::State& state, SimTK::State& s);
+    // The Assembler's evaluations of the goal, the errors and their
+    // derivatives so far.
+    int countFunctionEvaluations() const;
+    // Change the accuracy of the initialized Assembler, keeping its
+    // internal state, if it differs.
+    void setAssemblerAccuracy(double accuracy);
 
     // The assembly solution accuracy
     double _accuracy;
@@ -147,6 +228,35 @@ private:
     SimTK::ResetOnCopy< std::unique_ptr<SimTK::Assembler>> _assembler;
 
     SimTK::Array_<SimTK::QValue*> _coordinateAssemblyConditions;
+    SimTK::Array_<SimTK::AssemblyConditionIndex> _coordinateAssemblyConditionIndices;
+
+    // Which coordinates were locked and clamped when the goals were set up,
+    // and the locked coordinates whose references were replaced by locking
+    // their q in the Assembler.
+    std::vector<bool> _lockedAtSetup;
+    std::vector<bool> _clampedAtSetup;
+    std::vector<const Coordinate*> _lockedInAssembler;
+
+    // Order of the extrapolation of track()'s initial guess.
+    int _predictionOrder;
+    // Times and free qs of the most recent solutions, oldest first.
+    std::vector<double> _solutionTimes;
+    std::vector<SimTK::Vector> _solutionFreeQs;
+    int _numIterationsInLastSolve;
+    int _numFunctionEvaluationsInLastSolve;
+
+    // Adaptive accuracy of track(); see setAdaptiveAccuracy().
+    double _loosestAccuracy;
+    double _goalTolerance;
+    // The accuracy of the Assembler, and that of the next track().
+    double _accuracyInAssembler;
+    double _accuracyOfNextTrack;
+    double _accuracyInLastSolve;
+    bool _refinedInLastSolve;
+    // The goal of the last solution, and the change of the free qs from
+    // the solution before it (NaN after assemble()).
+    double _lastGoal;
+    double _lastStep;
 //=============================================================================
 };  // END of class AssemblySolver
 //=============================================================================
@@ -0,0 +1,273 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  BatchModelEvaluator.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BatchModelEvaluator.h"
+#include "Model/Model.h"
+#include "Model/PathActuator.h"
+
+#include <system_error>
+#include <thread>
+
+using namespace std;
+
+namespace OpenSim {
+
+// A copy of the model, and the state reused for the samples of one block.
+struct BatchModelEvaluator::Worker {
+    unique_ptr<Model> model;
+    SimTK::State state;
+};
+
+namespace {
+// Split "<component path>|<output name>" into its two parts.
+void splitOutputPath(const string& outputPath, string& componentPath,
+                     string& outputName)
+{
+    const auto bar = outputPath.rfind('|');
+    if (bar == string::npos) {
+        throw Exception("BatchModelEvaluator: expected an output path of the "
+                "form '<component path>|<output name>', but got '" +
+                outputPath + "'.", __FILE__, __LINE__);
+    }
+    componentPath = outputPath.substr(0, bar);
+    outputName = outputPath.substr(bar + 1);
+}
+
+const AbstractOutput& findOutput(const Model& model, const string& outputPath)
+{
+    string componentPath, outputName;
+    splitOutputPath(outputPath, componentPath, outputName);
+    const Component& component =
+            componentPath.empty() || componentPath == "/" ?
+            static_cast<const Component&>(model) :
+            model.getComponent(componentPath);
+    return component.getOutput(outputName);
+}
+} // anonymous namespace
+
+BatchModelEvaluator::BatchModelEvaluator(const Model& model) : _model(model)
+{
+    vector<string> inputs;
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i)
+        inputs.push_back(coords[i].getAbsolutePathString() + "/value");
+    setInputs(inputs);
+}
+
+BatchModelEvaluator::~BatchModelEvaluator() = default;
+
+void BatchModelEvaluator::setInputs(
+        const vector<string>& stateVariablePaths)
+{
+    // Throws if a state variable is not in the model.
+    for (const auto& path : stateVariablePaths)
+        _model->getStateVariableHandle(path);
+    _inputs = stateVariablePaths;
+}
+
+void BatchModelEvaluator::addOutput(const string& outputPath)
+{
+    const AbstractOutput& output = findOutput(*_model, outputPath);
+    OutputSpec spec;
+    spec.path = outputPath;
+    if (dynamic_cast<const Output<SimTK::Vec3>*>(&output))
+        spec.numColumns = 3;
+    else if (!dynamic_cast<const Output<double>*>(&output)) {
+        throw Exception("BatchModelEvaluator: output '" + outputPath +
+                "' is of type " + output.getTypeName() + "; only outputs of "
+                "type double and Vec3 can be evaluated.", __FILE__, __LINE__);
+    }
+    _outputs.push_back(spec);
+    if (output.getDependsOnStage() > _requiredStage)
+        _requiredStage = output.getDependsOnStage();
+}
+
+void BatchModelEvaluator::addMomentArm(const string& actuatorPath,
+                                       const string& coordinatePath)
+{
+    // Throws if either component is not in the model.
+    _model->getComponent<PathActuator>(actuatorPath);
+    _model->getComponent<Coordinate>(coordinatePath);
+    OutputSpec spec;
+    spec.path = actuatorPath;
+    spec.coordinatePath = coordinatePath;
+    _outputs.push_back(spec);
+    if (_requiredStage < SimTK::Stage::Position)
+        _requiredStage = SimTK::Stage::Position;
+}
+
+void BatchModelEvaluator::clearOutputs()
+{
+    _outputs.clear();
+    _requiredStage = SimTK::Stage::Time;
+}
+
+int BatchModelEvaluator::getNumOutputColumns() const
+{
+    int numColumns = 0;
+    for (const auto& spec : _outputs) numColumns += spec.numColumns;
+    return numColumns;
+}
+
+vector<string> BatchModelEvaluator::getOutputLabels() const
+{
+    vector<string> labels;
+    for (const auto& spec : _outputs) {
+        if (!spec.coordinatePath.empty()) {
+            labels.push_back(spec.path + "|moment_arm:" +
+                    _model->getComponent<Coordinate>(spec.coordinatePath)
+                            .getName());
+        }
+        else if (spec.numColumns == 1)
+            labels.push_back(spec.path);
+        else {
+            for (int k = 1; k <= spec.numColumns; ++k)
+                labels.push_back(spec.path + "_" + to_string(k));
+        }
+    }
+    return labels;
+}
+
+void BatchModelEvaluator::makeWorkers(int numWorkers)
+{
+    // Copies are initialized here, on the calling thread, so that building
+    // the Systems does not need to be thread-safe.
+    while (int(_workers.size()) < numWorkers) {
+        unique_ptr<Worker> worker(new Worker);
+        worker->model.reset(_model->clone());
+        worker->model->setUseVisualizer(false);
+        worker->state = worker->model->initSystem();
+        _workers.push_back(std::move(worker));
+    }
+}
+
+SimTK::Matrix BatchModelEvaluator::evaluate(const SimTK::Matrix& inputs)
+{
+    const int numInputs = getNumInputs();
+    if (inputs.ncol() != numInputs) {
+        throw Exception("BatchModelEvaluator: expected inputs with " +
+                to_string(numInputs) + " columns, but got " +
+                to_string(inputs.ncol()) + ".", __FILE__, __LINE__);
+    }
+    const int numSamples = inputs.nrow();
+    SimTK::Matrix results(numSamples, getNumOutputColumns());
+    if (numSamples == 0) return results;
+
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, numSamples));
+    makeWorkers(numBlocks);
+
+    // The state variables that are not inputs keep the values they have in
+    // the working state of the model, as of this call.
+    const SimTK::State& workingState = _model->getWorkingState();
+    const SimTK::Vector baseValues =
+            _model->getStateVariableValues(workingState);
+    // The message of the error encountered by each block, if any.
+    vector<string> errors(numBlocks);
+
+    auto evaluateBlock = [&](int block) {
+        Worker& worker = *_workers[block];
+        Model& m = *worker.model;
+        SimTK::State& s = worker.state;
+        const int begin = numSamples*block/numBlocks;
+        const int end = numSamples*(block+1)/numBlocks;
+        try {
+            s.setTime(workingState.getTime());
+            m.setStateVariableValues(s, baseValues);
+
+            // Resolve the inputs and outputs by path in this copy, so that
+            // no name lookups are done per sample.
+            vector<Component::StateVariableHandle> handles;
+            for (const auto& path : _inputs)
+                handles.push_back(m.getStateVariableHandle(path));
+            vector<const AbstractOutput*> outputs;
+            vector<const PathActuator*> actuators;
+            vector<Coordinate*> coordinates;
+            for (const auto& spec : _outputs) {
+                if (spec.coordinatePath.empty()) {
+                    outputs.push_back(&findOutput(m, spec.path));
+                    actuators.push_back(nullptr);
+                    coordinates.push_back(nullptr);
+                }
+                else {
+                    outputs.push_back(nullptr);
+                    actuators.push_back(
+                            &m.getComponent<PathActuator>(spec.path));
+                    coordinates.push_back(
+                            &m.updComponent<Coordinate>(spec.coordinatePath));
+                }
+            }
+
+            SimTK::Vector values(numInputs);
+            for (int i = begin; i < end; ++i) {
+                for (int j = 0; j < numInputs; ++j) values[j] = inputs(i, j);
+                m.setStateVariableValues(s, handles, values);
+                m.getMultibodySystem().realize(s, _requiredStage);
+
+                int col = 0;
+                for (int k = 0; k < int(_outputs.size()); ++k) {
+                    if (actuators[k]) {
+                        results(i, col++) =
+                                actuators[k]->computeMomentArm(s,
+                                        *coordinates[k]);
+                    }
+                    else if (_outputs[k].numColumns == 3) {
+                        const SimTK::Vec3& v = static_cast<
+                                const Output<SimTK::Vec3>*>(outputs[k])
+                                ->getValue(s);
+                        for (int d = 0; d < 3; ++d) results(i, col++) = v[d];
+                    }
+                    else {
+                        results(i, col++) = static_cast<
+                                const Output<double>*>(outputs[k])
+                                ->getValue(s);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            errors[block] = e.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int block = 1; block < numBlocks; ++block) {
+        try {
+            threads.emplace_back(evaluateBlock, block);
+        } catch (const std::system_error&) {
+            // Could not start a thread; evaluate this block here instead.
+            evaluateBlock(block);
+        }
+    }
+    evaluateBlock(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("BatchModelEvaluator::evaluate() " + errorMsg,
+                            __FILE__, __LINE__);
+    }
+    return results;
+}
+
+} // end of namespace OpenSim
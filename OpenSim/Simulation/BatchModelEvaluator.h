@@ -0,0 +1,160 @@
+#ifndef OPENSIM_BATCH_MODEL_EVALUATOR_H_
+#define OPENSIM_BATCH_MODEL_EVALUATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  BatchModelEvaluator.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon/internal/BigMatrix.h>
+#include <SimTKcommon/internal/ReferencePtr.h>
+#include <SimTKcommon/internal/Stage.h>
+#include <SimTKcommon/internal/State.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Evaluate outputs of a model at many states at once, e.g., to sample a
+ * model's marker locations or moment arms over a grid of coordinate values,
+ * or to evaluate a model for every row of an array produced elsewhere.
+ *
+ * Each row of the inputs matrix holds the values of the input state variables
+ * (see setInputs()) of one sample; the other state variables keep their
+ * values in the model's working state. Each row of the result holds the
+ * values of the requested outputs (see addOutput() and addMomentArm()) at
+ * that sample. Samples are realized only to the highest Stage the requested
+ * outputs depend on (e.g., Position for marker locations), so nothing is
+ * computed that the outputs do not need.
+ *
+ * Samples are split into contiguous blocks evaluated concurrently; each block
+ * is evaluated on its own copy of the model, reusing one SimTK::State for all
+ * of its samples. The copies are made by the first call to evaluate(), on the
+ * calling thread, and are reused by later calls.
+ *
+ * @code
+ * BatchModelEvaluator evaluator(model);
+ * evaluator.setInputs({"/jointset/r_shoulder/r_shoulder_elev/value",
+ *                      "/jointset/r_elbow/r_elbow_flex/value"});
+ * evaluator.addOutput("/markerset/r_radius_styloid|location");
+ * evaluator.addMomentArm("/forceset/BIClong",
+ *                        "/jointset/r_elbow/r_elbow_flex");
+ * SimTK::Matrix samples(1000, 2);
+ * // ... fill in the samples ...
+ * SimTK::Matrix results = evaluator.evaluate(samples); // 1000 x 4
+ * @endcode
+ *
+ * In Python, evaluateNumPy() takes and returns NumPy arrays.
+ */
+class OSIMSIMULATION_API BatchModelEvaluator
+{
+public:
+    /** The model must have been initialized (see Model::initSystem()); its
+    working state provides the values of the state variables that are not
+    inputs. The model is not modified, and must outlive this evaluator. The
+    inputs are the values of the model's coordinates, in the order of its
+    CoordinateSet, until setInputs() is called. */
+    explicit BatchModelEvaluator(const Model& model);
+    ~BatchModelEvaluator();
+
+    BatchModelEvaluator(const BatchModelEvaluator&) = delete;
+    void operator=(const BatchModelEvaluator&) = delete;
+
+    /** %Set the state variables whose values are the columns of the inputs
+    matrix, by path (as accepted by Component::getStateVariableValue()), e.g.,
+    "/jointset/r_elbow/r_elbow_flex/value",
+    "/jointset/r_elbow/r_elbow_flex/speed", or "/forceset/BIClong/activation".
+    @throws Exception If a state variable is not in the model. */
+    void setInputs(const std::vector<std::string>& stateVariablePaths);
+    const std::vector<std::string>& getInputs() const { return _inputs; }
+    int getNumInputs() const { return int(_inputs.size()); }
+
+    /** Add an Output to evaluate, by its path, "<component path>|<output
+    name>" (e.g., "/markerset/r_radius_styloid|location"). Outputs of type
+    double take one column of the result, and outputs of type SimTK::Vec3
+    take three.
+    @throws Exception If the output is not in the model, or is of another
+            type. */
+    void addOutput(const std::string& outputPath);
+    /** Add the moment arm of a PathActuator (e.g., a Muscle) about a
+    Coordinate, both by path, which takes one column of the result.
+    @throws Exception If either component is not in the model. */
+    void addMomentArm(const std::string& actuatorPath,
+                      const std::string& coordinatePath);
+    /** Remove all outputs and moment arms. */
+    void clearOutputs();
+
+    /** The number of columns of the result of evaluate(). */
+    int getNumOutputColumns() const;
+    /** A label for each column of the result of evaluate(): the output path,
+    with a suffix "_1", "_2" or "_3" for the elements of a SimTK::Vec3 (as for
+    TimeSeriesTable_::flatten()), or "<actuator path>|moment_arm:<coordinate
+    name>" for a moment arm. */
+    std::vector<std::string> getOutputLabels() const;
+    /** The Stage each sample is realized to: the highest Stage the outputs
+    depend on (Position for moment arms). */
+    SimTK::Stage getRequiredStage() const { return _requiredStage; }
+
+    /** Number of blocks of samples evaluated at once; if not positive (the
+    default), the number of hardware threads is used. Each block uses its own
+    copy of the model. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Evaluate the outputs at each sample (row) of the inputs, and return a
+    matrix with a row per sample and a column per output value (see
+    getOutputLabels()).
+    @throws Exception If the inputs do not have getNumInputs() columns, or
+            an output cannot be evaluated at a sample. */
+    SimTK::Matrix evaluate(const SimTK::Matrix& inputs);
+
+private:
+    // An output or moment arm, by path, so it can be found in each copy of
+    // the model.
+    struct OutputSpec {
+        std::string path;
+        // The coordinate of a moment arm; empty for an Output.
+        std::string coordinatePath;
+        int numColumns = 1;
+    };
+    struct Worker;
+
+    void makeWorkers(int numWorkers);
+
+    SimTK::ReferencePtr<const Model> _model;
+    std::vector<std::string> _inputs;
+    std::vector<OutputSpec> _outputs;
+    SimTK::Stage _requiredStage = SimTK::Stage::Time;
+    int _numThreads = -1;
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+};  // END of class BatchModelEvaluator
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_BATCH_MODEL_EVALUATOR_H_
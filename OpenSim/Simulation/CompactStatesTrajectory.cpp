@@ -0,0 +1,371 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  CompactStatesTrajectory.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompactStatesTrajectory.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <cstring>
+#include <iterator>
+
+using namespace OpenSim;
+
+namespace {
+// The file starts with this number ("OSTC") and the version of the format,
+// followed by the number of Q, U and Z and the keyframe interval (all
+// int32), and then the States, each as its time (a double) followed by its
+// encoded Y.
+const std::uint32_t FileMagic = 0x4354534F;
+const std::uint32_t FileVersion = 1;
+
+std::uint64_t toBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Each value is stored as the XOR of its bits with those of the previous
+// State's value (or, in a keyframe, as its bits), 7 bits per byte from the
+// least significant, with the high bit of a byte set if more bytes follow.
+// Values that have not changed take one byte; the sign, exponent and high
+// mantissa bits of values that changed little cancel out.
+void encodeY(const SimTK::Vector& y, bool keyframe,
+             std::vector<std::uint64_t>& lastBits,
+             std::vector<unsigned char>& out) {
+    for (int i = 0; i < y.size(); ++i) {
+        const std::uint64_t bits = toBits(y[i]);
+        std::uint64_t delta = keyframe ? bits : bits ^ lastBits[i];
+        lastBits[i] = bits;
+        while (delta >= 0x80) {
+            out.push_back(static_cast<unsigned char>(delta | 0x80));
+            delta >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(delta));
+    }
+}
+
+// Decode the Y encoded at p, updating bits and advancing p past it. Returns
+// false if the encoding ends before end does.
+bool decodeY(const unsigned char*& p, const unsigned char* end,
+             bool keyframe, std::vector<std::uint64_t>& bits) {
+    for (auto& value : bits) {
+        std::uint64_t delta = 0;
+        int shift = 0;
+        while (true) {
+            if (p == end || shift >= 64) return false;
+            const unsigned char byte = *p++;
+            delta |= std::uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+        value = keyframe ? delta : value ^ delta;
+    }
+    return true;
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(const unsigned char*& p, const unsigned char* end, T& value) {
+    if (end - p < std::ptrdiff_t(sizeof(T))) return false;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+void writeHeader(std::ostream& out, const SimTK::State& state) {
+    writeValue(out, FileMagic);
+    writeValue(out, FileVersion);
+    writeValue(out, std::int32_t(state.getNQ()));
+    writeValue(out, std::int32_t(state.getNU()));
+    writeValue(out, std::int32_t(state.getNZ()));
+    writeValue(out,
+               std::int32_t(CompactStatesTrajectory::KeyframeInterval));
+}
+
+bool isConsistentWith(const SimTK::State& state, int nq, int nu, int nz) {
+    return state.getNQ() == nq && state.getNU() == nu && state.getNZ() == nz;
+}
+} // anonymous namespace
+
+//=============================================================================
+// COMPACT STATES TRAJECTORY
+//=============================================================================
+CompactStatesTrajectory::CompactStatesTrajectory(
+        const StatesTrajectory& states) {
+    m_times.reserve(states.getSize());
+    for (const auto& state : states) append(state);
+}
+
+const SimTK::State& CompactStatesTrajectory::getTemplateState() const {
+    OPENSIM_THROW_IF(m_template.empty(), Exception,
+        "CompactStatesTrajectory::getTemplateState(): the trajectory is "
+        "empty.");
+    return m_template[0];
+}
+
+void CompactStatesTrajectory::clear() {
+    m_template.clear();
+    m_times.clear();
+    m_data.clear();
+    m_keyframeOffsets.clear();
+    m_lastBits.clear();
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (m_template.empty()) {
+        m_template.push_back(state);
+        m_lastBits.assign(state.getNY(), 0);
+    } else {
+        SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
+                "CompactStatesTrajectory", "append",
+                "New state's time (%f) must be equal to or greater than the "
+                "time for the last state in the trajectory (%f).",
+                state.getTime(), m_times.back());
+        const SimTK::State& t = m_template[0];
+        OPENSIM_THROW_IF(
+            !isConsistentWith(state, t.getNQ(), t.getNU(), t.getNZ()),
+            StatesTrajectory::InconsistentState, state.getTime());
+    }
+
+    const bool keyframe = m_times.size() % KeyframeInterval == 0;
+    if (keyframe) m_keyframeOffsets.push_back(m_data.size());
+    encodeY(state.getY(), keyframe, m_lastBits, m_data);
+    m_times.push_back(state.getTime());
+}
+
+size_t CompactStatesTrajectory::decode(size_t index,
+        std::vector<std::uint64_t>& bits) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+                     getSize() - 1);
+    bits.assign(getNY(), 0);
+    const size_t keyframe = index / KeyframeInterval;
+    const unsigned char* p = m_data.data() + m_keyframeOffsets[keyframe];
+    const unsigned char* end = m_data.data() + m_data.size();
+    for (size_t i = keyframe*KeyframeInterval; i <= index; ++i)
+        decodeY(p, end, i % KeyframeInterval == 0, bits);
+    return size_t(p - m_data.data());
+}
+
+void CompactStatesTrajectory::getY(size_t index, SimTK::Vector& y) const {
+    std::vector<std::uint64_t> bits;
+    decode(index, bits);
+    y.resize(int(bits.size()));
+    for (int i = 0; i < y.size(); ++i) y[i] = fromBits(bits[i]);
+}
+
+SimTK::State CompactStatesTrajectory::getState(size_t index) const {
+    SimTK::Vector y;
+    getY(index, y);
+    SimTK::State state = m_template[0];
+    state.setTime(m_times[index]);
+    state.updY() = y;
+    return state;
+}
+
+StatesTrajectory CompactStatesTrajectory::toStatesTrajectory() const {
+    StatesTrajectory states;
+    for (const auto& state : *this) states.append(state);
+    return states;
+}
+
+void CompactStatesTrajectory::write(const std::string& fileName) const {
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    OPENSIM_THROW_IF(!out, Exception,
+        "CompactStatesTrajectory::write(): could not open '" + fileName +
+        "'.");
+    if (m_template.empty()) {
+        // Without a template, the sizes are unknown; write an empty header.
+        writeValue(out, FileMagic);
+        writeValue(out, FileVersion);
+        for (int i = 0; i < 4; ++i) writeValue(out, std::int32_t(0));
+        return;
+    }
+    writeHeader(out, m_template[0]);
+
+    // The States are interleaved with their times, so find where each one's
+    // encoding ends.
+    std::vector<std::uint64_t> bits(getNY());
+    const unsigned char* begin = m_data.data();
+    const unsigned char* end = begin + m_data.size();
+    const unsigned char* p = begin;
+    for (size_t i = 0; i < getSize(); ++i) {
+        const unsigned char* frame = p;
+        decodeY(p, end, i % KeyframeInterval == 0, bits);
+        writeValue(out, m_times[i]);
+        out.write(reinterpret_cast<const char*>(frame), p - frame);
+    }
+    OPENSIM_THROW_IF(!out, Exception,
+        "CompactStatesTrajectory::write(): could not write '" + fileName +
+        "'.");
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromFile(
+        const Model& model, const std::string& fileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in, Exception,
+        "CompactStatesTrajectory::createFromFile(): could not open '" +
+        fileName + "'.");
+    const std::vector<unsigned char> contents(
+            (std::istreambuf_iterator<char>(in)),
+            std::istreambuf_iterator<char>());
+    const unsigned char* p = contents.data();
+    const unsigned char* end = p + contents.size();
+
+    std::uint32_t magic = 0, version = 0;
+    std::int32_t nq = 0, nu = 0, nz = 0, keyframeInterval = 0;
+    const bool hasHeader = readValue(p, end, magic) &&
+            readValue(p, end, version) && readValue(p, end, nq) &&
+            readValue(p, end, nu) && readValue(p, end, nz) &&
+            readValue(p, end, keyframeInterval);
+    OPENSIM_THROW_IF(!hasHeader || magic != FileMagic, Exception,
+        "CompactStatesTrajectory::createFromFile(): '" + fileName +
+        "' is not a compact states file.");
+    OPENSIM_THROW_IF(version != FileVersion ||
+            keyframeInterval != KeyframeInterval, Exception,
+        "CompactStatesTrajectory::createFromFile(): '" + fileName +
+        "' was written by an unsupported version.");
+
+    CompactStatesTrajectory states;
+    if (p == end) return states;
+
+    const SimTK::State& workingState = model.getWorkingState();
+    OPENSIM_THROW_IF(!isConsistentWith(workingState, nq, nu, nz), Exception,
+        "CompactStatesTrajectory::createFromFile(): the states in '" +
+        fileName + "' do not match the state variables of model '" +
+        model.getName() + "'.");
+    states.m_template.push_back(workingState);
+    states.m_lastBits.assign(nq + nu + nz, 0);
+
+    while (p != end) {
+        const bool keyframe =
+                states.m_times.size() % KeyframeInterval == 0;
+        std::vector<std::uint64_t> bits = states.m_lastBits;
+        double time;
+        if (!readValue(p, end, time)) break;
+        const unsigned char* frame = p;
+        // A State that was only partly written is dropped.
+        if (!decodeY(p, end, keyframe, bits)) break;
+        if (keyframe) states.m_keyframeOffsets.push_back(states.m_data.size());
+        states.m_data.insert(states.m_data.end(), frame, p);
+        states.m_times.push_back(time);
+        states.m_lastBits.swap(bits);
+    }
+    return states;
+}
+
+//=============================================================================
+// ITERATOR
+//=============================================================================
+CompactStatesTrajectory::const_iterator::const_iterator(
+        const CompactStatesTrajectory& trajectory, size_t index) :
+        m_trajectory(&trajectory), m_index(index) {
+    if (m_index < trajectory.getSize())
+        m_offset = trajectory.decode(m_index, m_bits);
+}
+
+const SimTK::State&
+CompactStatesTrajectory::const_iterator::operator*() const {
+    if (!m_stateIsCurrent) {
+        if (!m_hasState) {
+            m_state = m_trajectory->m_template[0];
+            m_hasState = true;
+        }
+        m_state.setTime(m_trajectory->m_times[m_index]);
+        SimTK::Vector& y = m_state.updY();
+        for (int i = 0; i < y.size(); ++i) y[i] = fromBits(m_bits[i]);
+        m_stateIsCurrent = true;
+    }
+    return m_state;
+}
+
+CompactStatesTrajectory::const_iterator&
+CompactStatesTrajectory::const_iterator::operator++() {
+    ++m_index;
+    m_stateIsCurrent = false;
+    if (m_index < m_trajectory->getSize()) {
+        const auto& data = m_trajectory->m_data;
+        const unsigned char* p = data.data() + m_offset;
+        decodeY(p, data.data() + data.size(),
+                m_index % KeyframeInterval == 0, m_bits);
+        m_offset = size_t(p - data.data());
+    }
+    return *this;
+}
+
+//=============================================================================
+// FILE WRITER
+//=============================================================================
+CompactStatesFileWriter::CompactStatesFileWriter(const std::string& fileName)
+        : m_out(fileName, std::ios::binary | std::ios::trunc),
+          m_fileName(fileName) {
+    OPENSIM_THROW_IF(!m_out, Exception,
+        "CompactStatesFileWriter: could not open '" + fileName + "'.");
+}
+
+CompactStatesFileWriter::~CompactStatesFileWriter() {
+    try { close(); }
+    catch (const std::exception&) {}
+}
+
+void CompactStatesFileWriter::append(const SimTK::State& state) {
+    if (m_numStates == 0) {
+        writeHeader(m_out, state);
+        m_nq = state.getNQ();
+        m_nu = state.getNU();
+        m_nz = state.getNZ();
+        m_lastBits.assign(state.getNY(), 0);
+    } else {
+        OPENSIM_THROW_IF(!isConsistentWith(state, m_nq, m_nu, m_nz),
+            StatesTrajectory::InconsistentState, state.getTime());
+    }
+    m_buffer.clear();
+    encodeY(state.getY(),
+            m_numStates % CompactStatesTrajectory::KeyframeInterval == 0,
+            m_lastBits, m_buffer);
+    writeValue(m_out, state.getTime());
+    m_out.write(reinterpret_cast<const char*>(m_buffer.data()),
+                m_buffer.size());
+    ++m_numStates;
+}
+
+void CompactStatesFileWriter::flush() {
+    if (!m_out.is_open()) return;
+    m_out.flush();
+    OPENSIM_THROW_IF(!m_out, Exception,
+        "CompactStatesFileWriter: could not write '" + m_fileName + "'.");
+}
+
+void CompactStatesFileWriter::close() {
+    if (!m_out.is_open()) return;
+    flush();
+    m_out.close();
+}
@@ -0,0 +1,219 @@
+#ifndef OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+#define OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StatesTrajectory.h"
+#include <SimTKcommon/internal/State.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** A sequence of SimTK::State%s stored compactly, for trajectories too long
+ * to keep as a StatesTrajectory (each SimTK::State of which holds its own
+ * copy of the topology and the cache). Only the first appended State is kept
+ * whole, as a template; every State holds only its time and its continuous
+ * state variables (Y, i.e., Q, U and Z). The Y of each State is stored as the
+ * bitwise difference (XOR) from the previous State, in a variable-length
+ * encoding, so state variables that change slowly or not at all take a byte
+ * or two instead of eight. The encoding is lossless, and every 64th State
+ * is stored in full so that any State can be decoded quickly.
+ *
+ * Full SimTK::State%s are rebuilt on demand, from a copy of the template
+ * with the stored time and Y, by getState() or while iterating:
+ * @code{.cpp}
+ * CompactStatesTrajectory states(reporter.getStates());
+ * for (const SimTK::State& state : states) {
+ *     model.realizePosition(state);
+ *     // ...
+ * }
+ * @endcode
+ * An iterator rebuilds its State in place, so iterating through the
+ * trajectory allocates a single State. The rebuilt States take their
+ * discrete variables (and modeling options) from the template, so this class
+ * is suited to trajectories in which only the continuous state variables
+ * change, as in a simulation without events.
+ *
+ * Trajectories can be written to, and read from, a binary file with the same
+ * encoding; see write(), createFromFile() and CompactStatesFileWriter. */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory. */
+    CompactStatesTrajectory() = default;
+    /** Create a compact copy of the states of a StatesTrajectory. */
+    explicit CompactStatesTrajectory(const StatesTrajectory& states);
+
+    /** The number of SimTK::State%s in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+    /** The time of the state at the given index. */
+    double getTime(size_t index) const { return m_times.at(index); }
+    /** The continuous state variables (Y) of the state at the given index.
+     * @throws IndexOutOfRange If the index is not less than getSize(). */
+    void getY(size_t index, SimTK::Vector& y) const;
+    /** Rebuild the full SimTK::State at the given index; prefer iterating
+     * if many States are needed.
+     * @throws IndexOutOfRange If the index is not less than getSize(). */
+    SimTK::State getState(size_t index) const;
+    /** The State from which the others are rebuilt, i.e., a copy of the
+     * first State appended. */
+    const SimTK::State& getTemplateState() const;
+
+    /** The number of bytes used by the encoded state variables. */
+    size_t getNumEncodedBytes() const { return m_data.size(); }
+
+    /// @name Modify the contents of the trajectory
+    /// @{
+    /** Clear all the states in the trajectory, including the template. */
+    void clear();
+    /** Append the time and Y of a State. The first State appended becomes the
+     * template.
+     * @throws StatesTrajectory::InconsistentState If the State does not have
+     *         as many Q, U and Z as the template. */
+    void append(const SimTK::State& state);
+    /// @}
+
+    /** Rebuild all States into a StatesTrajectory. */
+    StatesTrajectory toStatesTrajectory() const;
+
+    /// @name Files
+    /// @{
+    /** Write the trajectory to a binary file that can be read with
+     * createFromFile(). */
+    void write(const std::string& fileName) const;
+    /** Read a trajectory written by write() or by a CompactStatesFileWriter.
+     * The file does not contain the template, so it is taken from the
+     * model's working State (see Model::initSystem(), which must have been
+     * called). A trailing state that was only partly written (e.g., because
+     * the writing process crashed) is ignored.
+     * @throws Exception If the file cannot be read, or its states do not
+     *         have as many Q, U and Z as the model's. */
+    static CompactStatesTrajectory createFromFile(const Model& model,
+                                                  const std::string& fileName);
+    /// @}
+
+    /** Iterator that rebuilds each State in place as it advances; a
+     * reference to the State it points to is invalidated when it is
+     * incremented. */
+    class OSIMSIMULATION_API const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef SimTK::State value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SimTK::State* pointer;
+        typedef const SimTK::State& reference;
+
+        const_iterator() = default;
+        const SimTK::State& operator*() const;
+        const SimTK::State* operator->() const { return &operator*(); }
+        const_iterator& operator++();
+        const_iterator operator++(int)
+        {   const_iterator copy(*this); ++*this; return copy; }
+        bool operator==(const const_iterator& other) const
+        {   return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const
+        {   return m_index != other.m_index; }
+    private:
+        friend class CompactStatesTrajectory;
+        const_iterator(const CompactStatesTrajectory& trajectory,
+                       size_t index);
+        const CompactStatesTrajectory* m_trajectory = nullptr;
+        size_t m_index = 0;
+        // The bits of the current State's Y, and where the next State's
+        // encoding begins.
+        std::vector<std::uint64_t> m_bits;
+        size_t m_offset = 0;
+        // The rebuilt State, once there is one, and whether it holds the
+        // current State.
+        mutable SimTK::State m_state;
+        mutable bool m_hasState = false;
+        mutable bool m_stateIsCurrent = false;
+    };
+
+    /** Iterator pointing to the first State. */
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    /** Iterator pointing past the last State. */
+    const_iterator end() const { return const_iterator(*this, getSize()); }
+
+    /** The number of States between States that are stored in full. */
+    static const int KeyframeInterval = 64;
+
+private:
+    // Decode the Y of the State at the given index into bits, and return the
+    // offset in m_data of the next State.
+    size_t decode(size_t index, std::vector<std::uint64_t>& bits) const;
+    int getNY() const { return m_template.empty() ? 0 : m_template[0].getNY(); }
+
+    std::vector<SimTK::State> m_template; // Empty, or the template State.
+    std::vector<double> m_times;
+    std::vector<unsigned char> m_data;
+    // The offset in m_data of each keyframe.
+    std::vector<size_t> m_keyframeOffsets;
+    // The bits of the last State's Y, from which the next is encoded.
+    std::vector<std::uint64_t> m_lastBits;
+};
+
+/** Write SimTK::State%s to a file in the format of
+ * CompactStatesTrajectory::write() as they are produced, so that a long
+ * simulation's states need not be kept in memory; see
+ * StatesTrajectoryReporter::setOutputFile(). Each State is written to the
+ * file's buffer when it is appended; the file is flushed by flush() and
+ * closed by close() or the destructor. */
+class OSIMSIMULATION_API CompactStatesFileWriter {
+public:
+    /** Open (and truncate) the file. The header is written with the first
+     * State.
+     * @throws Exception If the file cannot be opened. */
+    explicit CompactStatesFileWriter(const std::string& fileName);
+    ~CompactStatesFileWriter();
+
+    CompactStatesFileWriter(const CompactStatesFileWriter&) = delete;
+    void operator=(const CompactStatesFileWriter&) = delete;
+
+    /** Append the time and Y of a State.
+     * @throws StatesTrajectory::InconsistentState If the State does not have
+     *         as many Q, U and Z as the first State. */
+    void append(const SimTK::State& state);
+    /** The number of States appended. */
+    size_t getNumStates() const { return m_numStates; }
+    void flush();
+    void close();
+
+private:
+    std::ofstream m_out;
+    std::string m_fileName;
+    int m_nq = 0, m_nu = 0, m_nz = 0;
+    size_t m_numStates = 0;
+    std::vector<std::uint64_t> m_lastBits;
+    std::vector<unsigned char> m_buffer;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPACT_STATES_TRAJECTORY_H_
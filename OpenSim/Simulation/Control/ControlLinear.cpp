@@ -74,6 +74,7 @@ void ControlLinear::
 setNull()
 {
     setupProperties();
+    _xCursor = _minCursor = _maxCursor = -1;
 }
 //_____________________________________________________________________________
 void ControlLinear::
@@ -416,8 +417,39 @@ setControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,double aValue)
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Find the last node at or before a time, or -1 if the time precedes the
+ * first node, as ArrayPtrs::searchBinary() does.
+ *
+ * Controls are evaluated mostly at nearby, increasing times during an
+ * integration, so the node found by the last call for the same curve
+ * (rCursor), and the node after it, are tried before searching. A time
+ * equal to a node's is always searched for, so that the node chosen among
+ * nodes with the same time is the one searchBinary() chooses.
+ */
+int ControlLinear::
+findNode(const ArrayPtrs<ControlLinearNode> &aNodes,double aT,int &rCursor)
+{
+    int size = aNodes.getSize();
+    for(int i=rCursor;i<=rCursor+1;i++) {
+        if(i<-1 || i>=size) continue;
+        if((i<0 || aNodes[i]->getTime()<aT) &&
+                (i+1>=size || aT<aNodes[i+1]->getTime())) {
+            rCursor = i;
+            return(i);
+        }
+    }
+    // A node of its own rather than _searchNode, so that concurrent
+    // evaluations do not share it.
+    ControlLinearNode searchNode(aT);
+    rCursor = aNodes.searchBinary(searchNode);
+    return(rCursor);
+}
+
 double ControlLinear::
-getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
+getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,
+                std::atomic<int> &rCursor)
 {
     // CHECK SIZE
     int size = aNodes.getSize();
@@ -425,8 +457,9 @@ getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
     if(size<=0) return(SimTK::NaN);
 
     // GET NODE
-    _searchNode.setTime(aT);
-    int i = aNodes.searchBinary(_searchNode);
+    int cursor = rCursor.load(std::memory_order_relaxed);
+    int i = findNode(aNodes,aT,cursor);
+    rCursor.store(cursor, std::memory_order_relaxed);
 
     // BEFORE FIRST
     double value;
@@ -525,7 +558,7 @@ setControlValue(double aT,double aX)
 double ControlLinear::
 getControlValue(double aT)
 {
-    return getControlValue(_xNodes,aT);
+    return getControlValue(_xNodes,aT,_xCursor);
 }
 //_____________________________________________________________________________
 double ControlLinear::
@@ -556,7 +589,7 @@ getControlValueMin(double aT)
     if(_minNodes.getSize()==0)
         return _defaultMin;
     else
-        return getControlValue(_minNodes,aT);
+        return getControlValue(_minNodes,aT,_minCursor);
 }
 //_____________________________________________________________________________
 double ControlLinear::
@@ -588,7 +621,7 @@ getControlValueMax(double aT)
     if(_minNodes.getSize()==0)
         return _defaultMax;
     else
-        return getControlValue(_maxNodes,aT);
+        return getControlValue(_maxNodes,aT,_maxCursor);
 }
 //_____________________________________________________________________________
 double ControlLinear::
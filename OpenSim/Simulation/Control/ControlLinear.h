@@ -35,6 +35,8 @@
 #include "Control.h"
 #include "ControlLinearNode.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //=============================================================================
@@ -84,12 +86,20 @@ protected:
     double &_kv;
 
 
-    /** Utility node for speeding up searches for control values in
-    getControlValue() and elsewhere.  Without this node, a control node would
+    /** Utility node for speeding up searches for nodes when the control is
+    modified (getControlValue() uses a node of its own).  Without this node, a control node would
     need to be constructed, but this is too expensive.  It is better to construct
     a node up front, and then just alter the time. */
     ControlLinearNode _searchNode;
 
+    /** Index of the node at or before the time of the last evaluation of
+    each curve (see findNode()), or -1 if that time preceded the first node.
+    Only a hint, so that controls may be evaluated from several threads at
+    once. */
+    std::atomic<int> _xCursor;
+    std::atomic<int> _minCursor;
+    std::atomic<int> _maxCursor;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -383,7 +393,10 @@ public:
 
 private:
     void setControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,double aX);
-    double getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT);
+    double getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,
+                           std::atomic<int> &rCursor);
+    int findNode(const ArrayPtrs<ControlLinearNode> &aNodes,double aT,
+                 int &rCursor);
     double extrapolateBefore(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
     double extrapolateAfter(ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
 
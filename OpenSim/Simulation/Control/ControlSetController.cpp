@@ -91,7 +91,8 @@ void ControlSetController::setNull()
 
     _model = NULL;
     _controlSet = NULL;
-
+    _indexedControlSet = NULL;
+    _indexedNumControls = 0;
 
 }
 //_____________________________________________________________________________
@@ -162,26 +163,59 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
 {
     SimTK_ASSERT( _controlSet , "ControlSetController::computeControls controlSet is NULL");
 
-    std::string actName = "";
-    int index = -1;
-
     int na = getActuatorSet().getSize();
+    // The control set was changed after the model was initialized; find
+    // the controls for this call only.
+    std::vector<int> newIndices;
+    const std::vector<int>* indices = &_controlIndices;
+    if(_indexedControlSet != _controlSet ||
+            _indexedNumControls != _controlSet->getSize() ||
+            (int)_controlIndices.size() != na) {
+        newIndices = findControlIndices();
+        indices = &newIndices;
+    }
 
+    // Each ControlLinear remembers the interval of its last evaluation, so
+    // evaluating the controls at successive times takes no searching.
+    double t = s.getTime();
+    SimTK::Vector actControls(1);
     for(int i=0; i< na; ++i){
-        actName = getActuatorSet()[i].getName();
-        index = _controlSet->getIndex(actName);
-        if(index < 0){
-            actName = actName + ".excitation";
-            index = _controlSet->getIndex(actName);
-        }
-
+        int index = (*indices)[i];
         if(index >= 0){
-            SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(s.getTime()));
+            actControls[0] = _controlSet->get(index).getControlValue(t);
             getActuatorSet()[i].addInControls(actControls, controls);
         }
     }
 }
 
+// find the control of each actuator, named after the actuator with or
+// without an ".excitation" suffix
+std::vector<int> ControlSetController::findControlIndices() const
+{
+    int na = getActuatorSet().getSize();
+    std::vector<int> indices(na, -1);
+    for(int i=0; i< na; ++i){
+        const std::string& actName = getActuatorSet()[i].getName();
+        int index = _controlSet->getIndex(actName);
+        if(index < 0)
+            index = _controlSet->getIndex(actName + ".excitation");
+        indices[i] = index;
+    }
+    return indices;
+}
+
+void ControlSetController::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+    _controlIndices.clear();
+    _indexedControlSet = _controlSet;
+    _indexedNumControls = 0;
+    if (_controlSet) {
+        _controlIndices = findControlIndices();
+        _indexedNumControls = _controlSet->getSize();
+    }
+}
+
 double ControlSetController::getFirstTime() const {
     Array<int> controlList;
    SimTK_ASSERT( _controlSet , "ControlSetController::getFirstTime controlSet is NULL");
@@ -260,6 +294,7 @@ void ControlSetController::extendFinalizeFromProperties()
     if (loadedControlSet) {
         // Now set the current control set from what was loaded
         _controlSet = loadedControlSet;
+        _indexedControlSet = NULL;
         setEnabled(true);
     }
 
@@ -57,6 +57,16 @@ protected:
     PropertyStr _controlsFileNameProp;
     std::string &_controlsFileName;
 
+private:
+    /** Index in _controlSet of the control of each actuator of this
+    controller, or -1 if it has none, so computeControls() need not look
+    controls up by name every step. Built when the controller is connected
+    to its model; computeControls() does not modify it, so that it can be
+    called from several threads at once. */
+    std::vector<int> _controlIndices;
+    const ControlSet* _indexedControlSet;
+    int _indexedNumControls;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -83,7 +93,8 @@ public:
     const ControlSet *getControlSet() {return _controlSet;} 
     ControlSet *updControlSet() {return _controlSet;}
 
-    void setControlSet(ControlSet *aControlSet) {_controlSet = aControlSet;}
+    void setControlSet(ControlSet *aControlSet)
+    {   _controlSet = aControlSet; _indexedControlSet = NULL; }
 
 
     
@@ -92,6 +103,8 @@ private:
     // and not even by subclasses of this class.
 
     void setNull();
+    // Index in _controlSet of the control of each actuator, or -1.
+    std::vector<int> findControlIndices() const;
 
 protected:
 
@@ -110,6 +123,7 @@ protected:
 
     /// read in ControlSet and update Controller's actuator list
     void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -36,6 +36,22 @@
 using namespace OpenSim;
 using namespace std;
 
+// The periodic event at which a controller with an update rate computes its
+// controls.
+class Controller::UpdateHandler : public SimTK::PeriodicEventHandler {
+public:
+    UpdateHandler(const Controller& controller, double interval) :
+        SimTK::PeriodicEventHandler(interval), _controller(&controller) {}
+
+    void handleEvent(SimTK::State& s, SimTK::Real accuracy,
+                     bool& shouldTerminate) const override {
+        _controller->updateHeldControls(s);
+    }
+
+private:
+    SimTK::ReferencePtr<const Controller> _controller;
+};
+
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -63,6 +79,7 @@ void Controller::constructProperties()
     setAuthors("Ajay Seth, Frank Anderson, Chand John, Samuel Hamner");
     constructProperty_enabled(true);
     constructProperty_actuator_list();
+    constructProperty_update_rate(0.0);
 
     // Set is only a reference list, not ownership
     _actuatorSet.setMemoryOwner(false);
@@ -120,6 +137,16 @@ void Controller::setEnabled(bool aTrueFalse)
     upd_enabled() = aTrueFalse;
 }
 
+double Controller::getUpdateRate() const
+{
+    return get_update_rate();
+}
+
+void Controller::setUpdateRate(double rate)
+{
+    set_update_rate(rate);
+}
+
 // for any post XML deserialization initialization
 void Controller::extendConnectToModel(Model& model)
 {
@@ -168,6 +195,50 @@ void Controller::extendConnectToModel(Model& model)
 void Controller::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
     Super::extendAddToSystem(system);
+
+    OPENSIM_THROW_IF_FRMOBJ(!(get_update_rate() >= 0), Exception,
+        "Expected update_rate to be zero or more, but got " +
+        std::to_string(get_update_rate()) + ".");
+
+    _heldControlsIndex.invalidate();
+    if (get_update_rate() > 0) {
+        // The held controls are empty until the first update. Updating them
+        // must invalidate the model's controls, which depend on velocity.
+        SimTK::Measure_<SimTK::Vector>::Variable heldControls(
+            system.updDefaultSubsystem(), SimTK::Stage::Velocity,
+            SimTK::Vector());
+        _heldControlsIndex = heldControls.getSubsystemMeasureIndex();
+        system.addEventHandler(
+            new UpdateHandler(*this, 1.0/get_update_rate()));
+    }
+}
+
+void Controller::computeOrHoldControls(const SimTK::State& s,
+                                       SimTK::Vector& controls) const
+{
+    if (_heldControlsIndex.isValid()) {
+        const SimTK::Vector& held =
+            SimTK::Measure_<SimTK::Vector>::Variable::getAs(
+                getSystem().getDefaultSubsystem().getMeasure(
+                    _heldControlsIndex)).getValue(s);
+        if (held.size() == controls.size()) {
+            controls += held;
+            return;
+        }
+    }
+    computeControls(s, controls);
+}
+
+void Controller::updateHeldControls(SimTK::State& s) const
+{
+    // Compute this controller's contribution alone, from zero controls,
+    // since controllers add their controls into the model's.
+    getSystem().realize(s, SimTK::Stage::Velocity);
+    SimTK::Vector controls(getModel().getNumControls(), 0.0);
+    computeControls(s, controls);
+    SimTK::Measure_<SimTK::Vector>::Variable::getAs(
+        getSystem().getDefaultSubsystem().getMeasure(_heldControlsIndex))
+        .setValue(s, controls);
 }
 
 // makes a request for which actuators a controller will control
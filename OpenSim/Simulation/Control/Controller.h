@@ -44,6 +44,13 @@ class Actuator;
  * The defining method of a Controller is its computeControls() method.
  * @see computeControls()
  *
+ * By default, the controls are computed whenever the model's controls are
+ * needed, i.e., at every stage of the integrator, including those of
+ * rejected steps. A controller that, like a real (digital) controller,
+ * only needs to update its controls periodically can be given an
+ * update_rate: its controls are then computed at a periodic event and held
+ * (in a discrete variable of the State) until the next update.
+ *
  * @note Controllers currently do not use the Socket mechanism to locate 
  * and connect to the Actuators that Controllers depend on. As a result,
  * for now, Controllers do not support controlling multiple actuators with 
@@ -71,6 +78,11 @@ public:
         "The keyword ALL indicates the controller will control all the "
         "actuators in the model" );
 
+    OpenSim_DECLARE_PROPERTY(update_rate, double,
+        "Rate (Hz) at which the controls are computed and then held until the "
+        "next update (sample-and-hold). Zero (default) computes the controls "
+        "whenever they are needed.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -98,6 +110,19 @@ public:
      */
     void setEnabled(bool enableFlag);
 
+    /** Get the rate (Hz) at which the controls are updated, or 0 if they
+     * are computed whenever they are needed. */
+    double getUpdateRate() const;
+
+    /** %Set the rate (Hz) at which the controls are computed and held until
+     * the next update; 0 (the default) computes them whenever they are
+     * needed. Takes effect when the System is built (e.g., by initSystem()).
+     * Before the first update (at time 0, or the first multiple of the
+     * update interval after the start of a simulation), the controls are
+     * computed whenever they are needed.
+     */
+    void setUpdateRate(double rate);
+
     /** replace the current set of actuators with the provided set */
     void setActuators(const Set<Actuator>& actuators );
     /** add to the current set of actuators */
@@ -117,6 +142,17 @@ public:
     virtual void computeControls(const SimTK::State& s,
                                  SimTK::Vector &controls) const = 0;
 
+    /** Add this controller's controls into the model's controls: those
+     * computed now by computeControls() or, if the controller has an update
+     * rate, those computed at the last update. The Model calls this for
+     * each enabled controller.
+     *
+     * @param s         system state
+     * @param controls  writable model controls (all actuators)
+     */
+    void computeOrHoldControls(const SimTK::State& s,
+                               SimTK::Vector &controls) const;
+
     int getNumControls() const {return _numControls;}
 
 protected:
@@ -146,6 +182,13 @@ private:
     // construct and initialize properties
     void constructProperties();
 
+    // Computes the controls at every update and holds them in the State.
+    class UpdateHandler;
+    void updateHeldControls(SimTK::State& s) const;
+    // The discrete variable holding the controls of the last update, if the
+    // controller has an update rate.
+    mutable SimTK::MeasureIndex _heldControlsIndex;
+
     //friend class ControlSet;
     friend class ControllerSet;
 
@@ -28,6 +28,7 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/PiecewiseConstantFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
 
@@ -154,21 +155,108 @@ void PrescribedController::extendConnectToModel(Model& model)
             }// if found in functions, it has already been prescribed
         }// end looping through columns
     }// if no controls storage specified, do nothing
+
+    groupControlFunctions();
+}
+
+void PrescribedController::groupControlFunctions()
+{
+    _functionGroups.clear();
+    const int na = getActuatorSet().getSize();
+    const FunctionSet& funcs = get_ControlFunctions();
+    _isGrouped.assign(na, false);
+    if (funcs.getSize() < na) return;
+
+    for (int i = 0; i < na; ++i) {
+        // Subclasses may evaluate differently, so only exact matches.
+        if (funcs[i].getConcreteClassName() !=
+                PiecewiseLinearFunction::getClassName()) continue;
+        const auto& func = static_cast<const PiecewiseLinearFunction&>(funcs[i]);
+        if (func.getSize() < 2) continue;
+        FunctionGroup* group = nullptr;
+        for (auto& candidate : _functionGroups) {
+            if (candidate.functions[0]->hasSameX(func)) {
+                group = &candidate;
+                break;
+            }
+        }
+        if (!group) {
+            _functionGroups.push_back(FunctionGroup());
+            group = &_functionGroups.back();
+        }
+        group->actuators.push_back(i);
+        group->functions.push_back(&func);
+    }
+
+    // A function alone gains nothing from being evaluated as a group.
+    for (auto it = _functionGroups.begin(); it != _functionGroups.end(); ) {
+        if (it->functions.size() < 2) it = _functionGroups.erase(it);
+        else {
+            for (int a : it->actuators) _isGrouped[a] = true;
+            ++it;
+        }
+    }
 }
 
 
 // compute the control value for an actuator
 void PrescribedController::computeControls(const SimTK::State& s, SimTK::Vector& controls) const
 {
-    SimTK::Vector actControls(1, 0.0);
-    SimTK::Vector time(1, s.getTime());
+    // The argument of the control functions, which then holds the control
+    // of each actuator; kept in the cache to avoid allocating it every time.
+    SimTK::Vector& arg = updCacheVariableValue(s, _argumentCV);
+    const int na = getActuatorSet().getSize();
+    const FunctionSet& funcs = get_ControlFunctions();
 
-    for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = get_ControlFunctions()[i].calcValue(time);
-        getActuatorSet()[i].addInControls(actControls, controls);
+    // The groups are only used if their functions are still those of the
+    // actuators (e.g., this controller was not copied, nor its functions
+    // replaced, since it was connected to the model).
+    bool useGroups = !_functionGroups.empty() && (int)_isGrouped.size() == na;
+    for (int g = 0; useGroups && g < (int)_functionGroups.size(); ++g) {
+        const FunctionGroup& group = _functionGroups[g];
+        for (int j = 0; j < (int)group.actuators.size(); ++j) {
+            const int a = group.actuators[j];
+            if (a >= funcs.getSize() ||
+                    &funcs[a] != (const Function*)group.functions[j]) {
+                useGroups = false;
+                break;
+            }
+        }
+    }
+
+    if (useGroups) {
+        SimTK::Vector& values = updCacheVariableValue(s, _valuesCV);
+        values.resize(na);
+        for (const FunctionGroup& group : _functionGroups) {
+            PiecewiseLinearFunction::calcValues(group.functions, s.getTime(),
+                                                &values[0]);
+            for (int j = 0; j < (int)group.actuators.size(); ++j) {
+                arg[0] = values[j];
+                getActuatorSet()[group.actuators[j]].addInControls(arg,
+                                                                   controls);
+            }
+        }
+    }
+
+    for(int i=0; i<na; i++){
+        if (useGroups && _isGrouped[i]) continue;
+        arg[0] = s.getTime();
+        arg[0] = funcs[i].calcValue(arg);
+        getActuatorSet()[i].addInControls(arg, controls);
     }  
 }
 
+void PrescribedController::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    _argumentCV = addCacheVariable("argument", SimTK::Vector(1, 0.0),
+                                   SimTK::Stage::Topology);
+    _valuesCV = addCacheVariable("values",
+            SimTK::Vector(getActuatorSet().getSize(), 0.0),
+            SimTK::Stage::Topology);
+}
+
 
 //=============================================================================
 // GET AND SET
@@ -27,11 +27,13 @@
 
 #include "Controller.h"
 #include <OpenSim/Common/FunctionSet.h>
+#include <vector>
 
 
 namespace OpenSim { 
 
 class Function;
+class PiecewiseLinearFunction;
 
 //=============================================================================
 //=============================================================================
@@ -119,6 +121,7 @@ public:
 protected:
     /** Model component interface */
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 private:
     // construct and initialize properties
     void constructProperties();
@@ -130,6 +133,26 @@ private:
     // This method sets all member variables to default (e.g., NULL) values.
     void setNull();
 
+    // Find the control functions that computeControls() can evaluate
+    // together.
+    void groupControlFunctions();
+
+    // Scratch space for computeControls().
+    mutable CacheVariable<SimTK::Vector> _argumentCV;
+    mutable CacheVariable<SimTK::Vector> _valuesCV;
+
+    // Control functions that are PiecewiseLinearFunctions with the same X
+    // values (e.g., read from the same controls file), and the indices of
+    // their actuators. Each group is evaluated with
+    // PiecewiseLinearFunction::calcValues().
+    struct FunctionGroup {
+        std::vector<int> actuators;
+        std::vector<const PiecewiseLinearFunction*> functions;
+    };
+    std::vector<FunctionGroup> _functionGroups;
+    // Whether the function of each actuator belongs to a group.
+    std::vector<bool> _isGrouped;
+
 //=============================================================================
 };  // END of class PrescribedController
 
@@ -88,12 +88,25 @@ const SimTK::Array_<std::string>& CoordinateReference::getNames() const
 }
 
 
+namespace {
+// The argument of the value Function at the state's time. This is a
+// per-thread scratch Vector, so that evaluating a reference does not allocate
+// a Vector every time.
+const SimTK::Vector& timeArgument(const SimTK::State& s)
+{
+    thread_local SimTK::Vector t(1);
+    t[0] = s.getTime();
+    return t;
+}
+const std::vector<int> firstDerivative(1, 0);
+const std::vector<int> secondDerivative(2, 0);
+} // anonymous namespace
+
 /** get the values of the CoordinateReference */
 void CoordinateReference::getValues(const SimTK::State &s, SimTK::Array_<double> &values) const
 {
-    SimTK::Vector t(1, s.getTime());
     values.resize(getNumRefs());
-    values[0] = _coordinateValueFunction->calcValue(t);
+    values[0] = _coordinateValueFunction->calcValue(timeArgument(s));
 }
 
 
@@ -108,24 +121,21 @@ void CoordinateReference::getWeights(const SimTK::State &s, SimTK::Array_<double
 /** get the value of the CoordinateReference */
 double CoordinateReference::getValue(const SimTK::State &s) const
 {
-    SimTK::Vector t(1, s.getTime());
-    return _coordinateValueFunction->calcValue(t);
+    return _coordinateValueFunction->calcValue(timeArgument(s));
 }
 
 /** get the speed value of the CoordinateReference */
 double CoordinateReference::getSpeedValue(const SimTK::State &s) const
 {
-    SimTK::Vector t(1, s.getTime());
-    std::vector<int> order(1, 0);
-    return _coordinateValueFunction->calcDerivative(order, t);
+    return _coordinateValueFunction->calcDerivative(firstDerivative,
+                                                    timeArgument(s));
 }
 
 /** get the acceleration value of the CoordinateReference */
 double CoordinateReference::getAccelerationValue(const SimTK::State &s) const
 {
-    SimTK::Vector t(1, s.getTime());
-    std::vector<int> order(2, 0);
-    return _coordinateValueFunction->calcDerivative(order, t);
+    return _coordinateValueFunction->calcDerivative(secondDerivative,
+                                                    timeArgument(s));
 }
 
 /** get the weight of the CoordinateReference */
@@ -24,6 +24,10 @@
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/SolverStatistics.h>
+
+#include <memory>
+#include <thread>
 
 using namespace std;
 using namespace SimTK;
@@ -113,11 +117,7 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &u = s.updU();
     Vector &udot = s.updUDot();
 
-    for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
-    }
+    Qs.evaluateAll(time, q, u, udot);
 
     // Perform general inverse dynamics
     return solve(s, udot);
@@ -132,11 +132,78 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
 
     //Preallocate if not done already
     genForceTrajectory.resize(nt, Vector(nq));
+    _frameWallTimes.assign(nt, 0.0);
     
     AnalysisSet& analysisSet = const_cast<AnalysisSet&>(getModel().getAnalysisSet());
-    //fill in results for each time
-    for(int i=0; i<nt; i++){ 
-        genForceTrajectory[i] = solve(s, Qs, times[i]);
+
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, nt));
+
+    if (numBlocks == 1) {
+        //fill in results for each time
+        for(int i=0; i<nt; i++){ 
+            const SolverStatistics::Timer timer;
+            genForceTrajectory[i] = solve(s, Qs, times[i]);
+            _frameWallTimes[i] = timer.getElapsedTime();
+            analysisSet.step(s, i);
+        }
+        return;
+    }
+
+    // Each block of times is solved on its own copy of the model. The copies
+    // are initialized here, rather than on the threads, so that building the
+    // Systems does not need to be thread-safe. The copies have the same
+    // topology as the model, so the given state is valid for each of them.
+    std::vector<std::unique_ptr<Model>> models(numBlocks);
+    std::vector<SimTK::State> states(numBlocks);
+    for (int b = 0; b < numBlocks; ++b) {
+        models[b].reset(getModel().clone());
+        models[b]->setUseVisualizer(false);
+        models[b]->initSystem();
+        states[b] = s;
+    }
+
+    // The message of the error encountered by each block, if any.
+    std::vector<std::string> errors(numBlocks);
+    auto solveBlock = [&](int b) {
+        try {
+            InverseDynamicsSolver solver(*models[b]);
+            const int begin = nt*b/numBlocks;
+            const int end = nt*(b+1)/numBlocks;
+            for (int i = begin; i < end; ++i) {
+                const SolverStatistics::Timer timer;
+                genForceTrajectory[i] = solver.solve(states[b], Qs, times[i]);
+                _frameWallTimes[i] = timer.getElapsedTime();
+            }
+        }
+        catch (const std::exception& e) {
+            errors[b] = e.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int b = 1; b < numBlocks; ++b) {
+        try {
+            threads.emplace_back(solveBlock, b);
+        } catch (const std::system_error&) {
+            // Could not start a thread; solve this block here instead.
+            solveBlock(b);
+        }
+    }
+    solveBlock(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("InverseDynamicsSolver::solve() " + errorMsg,
+                            __FILE__, __LINE__);
+    }
+
+    // Step the analyses in order, and leave s at the last time, as the
+    // serial solve does.
+    for (int i = 0; i < nt; ++i) {
+        s.updTime() = times[i];
+        Qs.evaluateAll(times[i], s.updQ(), s.updU(), s.updUDot());
         analysisSet.step(s, i);
     }
 }
@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class FunctionSet;
@@ -94,11 +96,31 @@ public:
     virtual SimTK::Vector solve(SimTK::State& s, const FunctionSet& Qs, double time);
 #ifndef SWIG
     /** Same as above but for a given time series populate an Array (trajectory) of
-        generalized-coordinate forces (Vector) */
+        generalized-coordinate forces (Vector). The times are distributed
+        over getNumThreads() threads; see setNumThreads(). */
     virtual void solve(SimTK::State& s, const FunctionSet& Qs, 
                  const SimTK::Array_<double>&  times,
                  SimTK::Array_<SimTK::Vector>& genForceTrajectory);
 #endif
+
+    /** Number of threads over which the trajectory solve() distributes the
+        times, in contiguous blocks (default: 1). If not positive, the number
+        of hardware threads is used. Each thread solves its block on its own
+        copy of the model, from a copy of the given state, so the state's
+        discrete variables (e.g., forces disabled in it) apply to every
+        frame. The model's analyses are then stepped serially, in order. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** The wall-clock time, in seconds, spent solving each time of the last
+        trajectory solve(). Times solved in parallel report the time of their
+        own thread. */
+    const std::vector<double>& getFrameWallTimes() const
+    {   return _frameWallTimes; }
+
+private:
+    int _numThreads = 1;
+    std::vector<double> _frameWallTimes;
 //=============================================================================
 };  // END of class InverseDynamicsSolver
 //=============================================================================
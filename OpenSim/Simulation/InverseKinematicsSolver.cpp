@@ -23,16 +23,47 @@
 
 #include "InverseKinematicsSolver.h"
 #include "MarkersReference.h"
+#include "OrientationsReference.h"
 #include "Model/Model.h"
 #include "Model/MarkerSet.h"
 
 #include "simbody/internal/AssemblyCondition_Markers.h"
+#include "simbody/internal/AssemblyCondition_OrientationSensors.h"
+
+#include <algorithm>
 
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+// The frame of the model whose path, or else whose name, is the given name.
+const PhysicalFrame* findOrientationSensorFrame(const Model& model,
+                                                const std::string& name)
+{
+    if (model.hasComponent<PhysicalFrame>(name))
+        return &model.getComponent<PhysicalFrame>(name);
+    for (const PhysicalFrame& frame : model.getComponentList<PhysicalFrame>())
+        if (frame.getName() == name) return &frame;
+    return nullptr;
+}
+
+// The mobilities (u indices) of the bodies from a body to ground.
+std::vector<int> findMobilitiesToGround(const SimTK::State& s,
+                                        const SimTK::MobilizedBody& body)
+{
+    std::vector<int> mobilities;
+    for (const SimTK::MobilizedBody* mobod = &body; !mobod->isGround();
+            mobod = &mobod->getParentMobilizedBody()) {
+        const int first = mobod->getFirstUIndex(s);
+        for (int k = 0; k < mobod->getNumU(s); ++k)
+            mobilities.push_back(first + k);
+    }
+    return mobilities;
+}
+}
+
 //______________________________________________________________________________
 /*
  * An implementation of the InverseKinematicsSolver 
@@ -45,7 +76,26 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model &model, MarkersRefe
                             _markersReference(markersReference) 
 {
     setAuthors("Ajay Seth");
+    checkMarkers();
+}
+
+InverseKinematicsSolver::InverseKinematicsSolver(const Model &model,
+        MarkersReference &markersReference,
+        OrientationsReference &orientationsReference,
+        SimTK::Array_<CoordinateReference> &coordinateReferences,
+        double constraintWeight) :
+    AssemblySolver(model, coordinateReferences, constraintWeight),
+    _markersReference(markersReference),
+    _orientationsReference(&orientationsReference)
+{
+    setAuthors("Ajay Seth");
+    // The markers are optional when orientations are matched.
+    if (_markersReference.getNumRefs() > 0) checkMarkers();
+    checkOrientations();
+}
 
+void InverseKinematicsSolver::checkMarkers() const
+{
     // Do some consistency checking for markers
     const MarkerSet &modelMarkerSet = getModel().getMarkerSet();
 
@@ -77,6 +127,18 @@ InverseKinematicsSolver::InverseKinematicsSolver(const Model &model, MarkersRefe
 
 }
 
+void InverseKinematicsSolver::checkOrientations() const
+{
+    const SimTK::Array_<std::string>& names =
+            _orientationsReference->getNames();
+    int cnt = 0;
+    for (const std::string& name : names)
+        if (findOrientationSensorFrame(getModel(), name)) ++cnt;
+    OPENSIM_THROW_IF(cnt < 1, Exception,
+        "InverseKinematicsSolver: Orientation data does not correspond to "
+        "any model frames.");
+}
+
 int InverseKinematicsSolver::getNumMarkersInUse() const
 {
     return _markerAssemblyCondition->getNumMarkers();
@@ -205,6 +267,96 @@ std::string InverseKinematicsSolver::getMarkerNameForIndex(int markerIndex) cons
 }
 
 
+int InverseKinematicsSolver::getNumOrientationSensorsInUse() const
+{
+    return _orientationAssemblyCondition.empty() ? 0
+            : _orientationAssemblyCondition->getNumOSensors();
+}
+
+/* Update an orientation sensor's weight by name. */
+void InverseKinematicsSolver::updateOrientationWeight(
+        const std::string &orientationName, double value)
+{
+    OPENSIM_THROW_IF(_orientationsReference.empty(), Exception,
+        "InverseKinematicsSolver::updateOrientationWeight: no orientations "
+        "reference.");
+    const Array_<std::string> &names = _orientationsReference->getNames();
+    const auto p = std::find(names.begin(), names.end(), orientationName);
+    updateOrientationWeight(int(std::distance(names.begin(), p)), value);
+}
+
+/* Update an orientation sensor's weight by its index in the reference. */
+void InverseKinematicsSolver::updateOrientationWeight(int orientationIndex,
+                                                      double value)
+{
+    OPENSIM_THROW_IF(_orientationsReference.empty() || orientationIndex < 0
+        || orientationIndex >= _orientationsReference->getNumRefs(),
+        Exception,
+        "InverseKinematicsSolver::updateOrientationWeight: invalid "
+        "orientationIndex.");
+    const std::string& name =
+            _orientationsReference->getNames()[orientationIndex];
+    Set<OrientationWeight>& weights =
+            _orientationsReference->updOrientationWeightSet();
+    const int wix = weights.getIndex(name);
+    if (wix >= 0) weights[wix].setWeight(value);
+    else weights.cloneAndAppend(OrientationWeight(name, value));
+    // Frames that are not in the model have no goal.
+    if (!_orientationAssemblyCondition.empty()) {
+        const SimTK::OrientationSensors::OSensorIx ox =
+                _orientationAssemblyCondition->getOSensorIx(name);
+        if (ox.isValid())
+            _orientationAssemblyCondition->changeOSensorWeight(ox, value);
+    }
+}
+
+/* Update all orientation sensors' weights, in the order of the reference. */
+void InverseKinematicsSolver::updateOrientationWeights(
+        const SimTK::Array_<double> &weights)
+{
+    OPENSIM_THROW_IF(_orientationsReference.empty() ||
+        int(weights.size()) != _orientationsReference->getNumRefs(),
+        Exception,
+        "InverseKinematicsSolver::updateOrientationWeights: invalid size of "
+        "weights.");
+    for (unsigned int i = 0; i < weights.size(); ++i)
+        updateOrientationWeight(int(i), weights[i]);
+}
+
+/* Compute and return the orientations of all sensors' frames in ground. */
+void InverseKinematicsSolver::computeCurrentSensorOrientations(
+        SimTK::Array_<SimTK::Rotation> &orientations)
+{
+    const int n = getNumOrientationSensorsInUse();
+    orientations.resize(n);
+    for (int i = 0; i < n; ++i)
+        orientations[i] = _orientationAssemblyCondition->
+            findCurrentOSensorOrientation(SimTK::OrientationSensors::OSensorIx(i));
+}
+
+/* Compute and return the angles between the sensors' frames and their
+   observations. */
+void InverseKinematicsSolver::computeCurrentOrientationErrors(
+        SimTK::Array_<double> &errors)
+{
+    const int n = getNumOrientationSensorsInUse();
+    errors.resize(n);
+    for (int i = 0; i < n; ++i)
+        errors[i] = _orientationAssemblyCondition->
+            findCurrentOSensorError(SimTK::OrientationSensors::OSensorIx(i));
+}
+
+std::string InverseKinematicsSolver::getOrientationSensorNameForIndex(
+        int orientationIndex) const
+{
+    OPENSIM_THROW_IF(orientationIndex < 0 ||
+        orientationIndex >= getNumOrientationSensorsInUse(), Exception,
+        "InverseKinematicsSolver::getOrientationSensorNameForIndex: invalid "
+        "orientationIndex.");
+    return _orientationAssemblyCondition->getOSensorName(
+            SimTK::OrientationSensors::OSensorIx(orientationIndex));
+}
+
 /* Internal method to convert the MarkerReferences into additional goals of the 
     of the base assembly solver, that is going to do the assembly.  */
 void InverseKinematicsSolver::setupGoals(SimTK::State &s)
@@ -248,6 +400,50 @@ void InverseKinematicsSolver::setupGoals(SimTK::State &s)
     // and we can use an array of just the data for updating
     _markerAssemblyCondition->defineObservationOrder(markerNames);
 
+    // Find the mobilities each marker depends on, for refineTrackingGuess().
+    const SimTK::SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const int nmk = _markerAssemblyCondition->getNumMarkers();
+    _markerMobilities.resize(nmk);
+    for (int m = 0; m < nmk; ++m) {
+        _markerMobilities[m] = findMobilitiesToGround(s, matter.getMobilizedBody(
+            _markerAssemblyCondition->getMarkerBody(SimTK::Markers::MarkerIx(m))));
+    }
+
+    // Setup orientation goals, as the marker goals: the frames of the model
+    // that correspond to the reference's orientations form one condition.
+    _orientationAssemblyCondition.clear();
+    _orientationMobilities.clear();
+    if (!_orientationsReference.empty()) {
+        std::unique_ptr<SimTK::OrientationSensors> sensorsOwner(
+                new SimTK::OrientationSensors());
+        _orientationAssemblyCondition.reset(sensorsOwner.get());
+        const SimTK::Array_<std::string>& orientationNames =
+                _orientationsReference->getNames();
+        SimTK::Array_<double> orientationWeights;
+        _orientationsReference->getWeights(s, orientationWeights);
+        for (unsigned int i = 0; i < orientationNames.size(); ++i) {
+            const PhysicalFrame* frame =
+                    findOrientationSensorFrame(getModel(), orientationNames[i]);
+            if (!frame) continue;
+            _orientationAssemblyCondition->addOSensor(orientationNames[i],
+                    frame->getMobilizedBodyIndex(),
+                    frame->findTransformInBaseFrame().R(),
+                    orientationWeights[i]);
+            _orientationMobilities.push_back(
+                    findMobilitiesToGround(s, frame->getMobilizedBody()));
+        }
+        updAssembler().adoptAssemblyGoal(sensorsOwner.release());
+        _orientationAssemblyCondition->defineObservationOrder(orientationNames);
+    }
+
+    _stepState = s;
+    const int nu = s.getNU();
+    _stationJacobian.resize(nu);
+    _normalMatrix.resize(nu, nu);
+    _gradient.resize(nu);
+    _du.resize(nu);
+    _dq.resize(s.getNQ());
+
     updateGoals(s);
 }
 
@@ -261,6 +457,167 @@ void InverseKinematicsSolver::updateGoals(const SimTK::State &s)
     // specify the (initial) observations to be matched
     _markersReference.getValues(s, _markerValues);
     _markerAssemblyCondition->moveAllObservations(_markerValues);
+
+    if (!_orientationAssemblyCondition.empty()) {
+        _orientationsReference->getValues(s, _orientationValues);
+        _orientationAssemblyCondition->moveAllObservations(_orientationValues);
+    }
+}
+
+void InverseKinematicsSolver::updateGoalWeights(const SimTK::State &s)
+{
+    AssemblySolver::updateGoalWeights(s);
+
+    const SimTK::Array_<SimTK::String>& markerNames =
+            _markersReference.getNames();
+    SimTK::Array_<double> markerWeights;
+    _markersReference.getWeights(s, markerWeights);
+    for (unsigned int i = 0; i < markerNames.size(); ++i) {
+        // Markers that are not in the model have no goal.
+        const SimTK::Markers::MarkerIx mx =
+                _markerAssemblyCondition->getMarkerIx(markerNames[i]);
+        if (mx.isValid() &&
+                _markerAssemblyCondition->getMarkerWeight(mx) != markerWeights[i])
+            _markerAssemblyCondition->changeMarkerWeight(mx, markerWeights[i]);
+    }
+
+    if (_orientationAssemblyCondition.empty()) return;
+    const SimTK::Array_<std::string>& orientationNames =
+            _orientationsReference->getNames();
+    SimTK::Array_<double> orientationWeights;
+    _orientationsReference->getWeights(s, orientationWeights);
+    for (unsigned int i = 0; i < orientationNames.size(); ++i) {
+        const SimTK::OrientationSensors::OSensorIx ox =
+                _orientationAssemblyCondition->getOSensorIx(orientationNames[i]);
+        if (ox.isValid() && _orientationAssemblyCondition->getOSensorWeight(ox)
+                != orientationWeights[i])
+            _orientationAssemblyCondition->changeOSensorWeight(ox,
+                    orientationWeights[i]);
+    }
+}
+
+/* Take Gauss-Newton steps on the weighted marker and coordinate errors from
+   the Assembler's internal state, and make the result its new internal state.
+   The steps are taken in the mobilities (u) and mapped to q with N, so that
+   they also apply to mobilizers whose q are not their u (e.g., quaternions).*/
+bool InverseKinematicsSolver::refineTrackingGuess(double time)
+{
+    if (!_useMarkerJacobianSteps ||
+            (_markerMobilities.empty() && _orientationMobilities.empty()))
+        return false;
+
+    SimTK::Assembler& assembler = updAssembler();
+    const SimTK::SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const SimTK::Markers& markers = *_markerAssemblyCondition;
+    const SimTK::Array_<CoordinateReference>& coordRefs =
+            getCoordinateReferences();
+    SimTK::State& s = _stepState;
+    s.updTime() = time;
+    s.updQ() = assembler.getInternalState().getQ();
+    const int nu = s.getNU();
+
+    // A few steps suffice for a good guess; the Assembler does the rest.
+    const int maxSteps = 3;
+    for (int step = 0; step < maxSteps; ++step) {
+        getModel().getMultibodySystem().realize(s, SimTK::Stage::Position);
+        _normalMatrix.setToZero();
+        _gradient.setToZero();
+
+        for (int m = 0; m < int(_markerMobilities.size()); ++m) {
+            const SimTK::Markers::MarkerIx mx(m);
+            const double weight = markers.getMarkerWeight(mx);
+            const SimTK::Markers::ObservationIx ox =
+                    markers.getObservationIxForMarker(mx);
+            if (weight == 0 || !ox.isValid()) continue;
+            const SimTK::Vec3& observed = markers.getObservation(ox);
+            if (!observed.isFinite()) continue;
+
+            const SimTK::MobilizedBodyIndex mbx = markers.getMarkerBody(mx);
+            const SimTK::Vec3& station = markers.getMarkerStation(mx);
+            const SimTK::Vec3 error = matter.getMobilizedBody(mbx)
+                    .findStationLocationInGround(s, station) - observed;
+            matter.calcStationJacobian(s, mbx, station, _stationJacobian);
+
+            // Only the columns of the mobilities between the marker's body
+            // and ground are nonzero.
+            const std::vector<int>& mobilities = _markerMobilities[m];
+            for (int a : mobilities) {
+                _gradient[a] += weight*dot(_stationJacobian[a], error);
+                for (int b : mobilities)
+                    _normalMatrix(a, b) += weight*
+                        dot(_stationJacobian[a], _stationJacobian[b]);
+            }
+        }
+
+        // Orientation goals. The error is the rotation vector from the
+        // observed to the model orientation of the sensor's frame, in
+        // ground; its Jacobian is that of the frame's angular velocity.
+        for (int o = 0; o < int(_orientationMobilities.size()); ++o) {
+            const SimTK::OrientationSensors& sensors =
+                    *_orientationAssemblyCondition;
+            const SimTK::OrientationSensors::OSensorIx ox(o);
+            const double weight = sensors.getOSensorWeight(ox);
+            const SimTK::OrientationSensors::ObservationIx obx =
+                    sensors.getObservationIxForOSensor(ox);
+            if (weight == 0 || !obx.isValid()) continue;
+            const SimTK::Rotation& observed = sensors.getObservation(obx);
+            if (!observed.asMat33().isFinite()) continue;
+
+            const SimTK::MobilizedBodyIndex mbx =
+                    sensors.getOSensorMobilizedBodyIndex(ox);
+            const SimTK::Rotation R_GS = matter.getMobilizedBody(mbx)
+                    .getBodyRotation(s)*sensors.getOSensorStation(ox);
+            const SimTK::Vec4 angleAxis =
+                    (R_GS*~observed).convertRotationToAngleAxis();
+            const SimTK::Vec3 error = angleAxis[0]*
+                    SimTK::Vec3(angleAxis[1], angleAxis[2], angleAxis[3]);
+            matter.calcFrameJacobian(s, mbx, SimTK::Vec3(0), _frameJacobian);
+
+            const std::vector<int>& mobilities = _orientationMobilities[o];
+            for (int a : mobilities) {
+                _gradient[a] += weight*dot(_frameJacobian[a][0], error);
+                for (int b : mobilities)
+                    _normalMatrix(a, b) += weight*
+                        dot(_frameJacobian[a][0], _frameJacobian[b][0]);
+            }
+        }
+
+        // Coordinate goals, on coordinates whose q are their u.
+        const CoordinateSet& coordSet = getModel().getCoordinateSet();
+        for (const CoordinateReference& ref : coordRefs) {
+            const Coordinate& coord = coordSet.get(ref.getName());
+            const SimTK::MobilizedBody& mobod =
+                    matter.getMobilizedBody(coord.getBodyIndex());
+            if (mobod.getNumQ(s) != mobod.getNumU(s)) continue;
+            const int u = mobod.getFirstUIndex(s) + coord.getMobilizerQIndex();
+            const double weight = ref.getWeight(s);
+            _gradient[u] += weight*(coord.getValue(s) - ref.getValue(s));
+            _normalMatrix(u, u) += weight;
+        }
+
+        // Damp the step, and hold still the mobilities no goal depends on.
+        for (int a = 0; a < nu; ++a) {
+            double& diag = _normalMatrix(a, a);
+            diag = diag > 0 ? diag*(1 + 1e-8) : 1.0;
+        }
+
+        _normalFactorization.factor(_normalMatrix);
+        _normalFactorization.solve(-_gradient, _du);
+        if (!_du.isFinite()) return false;
+        matter.multiplyByN(s, false, _du, _dq);
+        s.updQ() += _dq;
+
+        if (max(abs(_du)) < assembler.getAccuracyInUse()) break;
+    }
+
+    // Locked coordinates are not free, so they keep their values.
+    const int nfq = assembler.getNumFreeQs();
+    _freeQs.resize(nfq);
+    for (int i = 0; i < nfq; ++i)
+        _freeQs[i] = s.getQ()[assembler.getQIndexOfFreeQ(
+                SimTK::Assembler::FreeQIndex(i))];
+    assembler.setInternalStateFromFreeQs(_freeQs);
+    return true;
 }
 
 } // end of namespace OpenSim
@@ -24,14 +24,19 @@
  * -------------------------------------------------------------------------- */
 
 #include "AssemblySolver.h"
+#include "simmath/LinearAlgebra.h"
+
+#include <vector>
 
 namespace SimTK {
 class Markers;
+class OrientationSensors;
 }
 
 namespace OpenSim {
 
 class MarkersReference;
+class OrientationsReference;
 
 //=============================================================================
 //=============================================================================
@@ -47,13 +52,15 @@ class MarkersReference;
  * The InverseKinematicsSolver objective:
  * \f[
  *   min: J = sum(Wm_i*(m_i-md_i)^T*(m_i-md_i)) + sum(Wq_j*(q_j-qd_j)^2) +
- *            [Wc*sum(c_{err})^2]
+ *            sum(Wo_k*theta_k^2) + [Wc*sum(c_{err})^2]
  * \f]
  * where m_i and md_i are the model and desired marker locations (Vec3); q_j
- * and qd_j are model and desired joint coordinates. Wm_i and Wq_j are the
- * marker and coordinate weightings, respectively, and Wc is the weighting on
- * constraint errors. When Wc == Infinity, the second term is not included,
- * but instead q is subject to the constraint equations:
+ * and qd_j are model and desired joint coordinates; theta_k is the angle
+ * between the model and desired orientations of frame k (e.g., of an IMU),
+ * if an OrientationsReference is given. Wm_i, Wq_j and Wo_k are the marker,
+ * coordinate and orientation weightings, respectively, and Wc is the
+ * weighting on constraint errors. When Wc == Infinity, the last term is not
+ * included, but instead q is subject to the constraint equations:
  *      \f[ c_{err} = G(q)-Go = 0 \f]
  *
  * When the model (and the number of goals) is guaranteed not to change and
@@ -79,6 +86,18 @@ public:
     InverseKinematicsSolver(const Model &model, MarkersReference &markersReference,
                             SimTK::Array_<CoordinateReference> &coordinateReferences,
                             double constraintWeight = SimTK::Infinity);
+
+    /** Also match the orientations of the model's frames to those of an
+        OrientationsReference (e.g., of IMUs). Each of its columns is
+        associated with the PhysicalFrame whose path, or else whose name, is
+        the column's label; columns with no such frame are ignored, but at
+        least one must have a frame. The markers reference may be empty
+        (e.g., a default MarkersReference) to solve from orientations only. */
+    InverseKinematicsSolver(const Model &model,
+                            MarkersReference &markersReference,
+                            OrientationsReference &orientationsReference,
+                            SimTK::Array_<CoordinateReference> &coordinateReferences,
+                            double constraintWeight = SimTK::Infinity);
     
     /* Assemble a model configuration that meets the InverseKinematics conditions  
         (desired values and constraints) starting from an initial state that  
@@ -151,6 +170,52 @@ public:
         solver. */
     std::string getMarkerNameForIndex(int markerIndex) const;
 
+    /** Return the number of orientation sensors (frames whose orientations
+        are matched) used to solve for model coordinates: the columns of the
+        OrientationsReference that have a frame in the model, or 0 if there
+        is no OrientationsReference. This number is guaranteed not to change
+        after assemble() is called. */
+    int getNumOrientationSensorsInUse() const;
+
+    /** Change the weighting of an orientation sensor, given its name. Takes
+        effect when assemble() or track() is called next. */
+    void updateOrientationWeight(const std::string &orientationName,
+                                 double value);
+    /** Change the weighting of an orientation sensor, given its index in the
+        OrientationsReference. */
+    void updateOrientationWeight(int orientationIndex, double value);
+    /** Change the weighting of all orientation sensors, in the order of the
+        OrientationsReference. */
+    void updateOrientationWeights(const SimTK::Array_<double> &weights);
+
+    /** Compute and return the orientations of all orientation sensors'
+        frames in ground, in the order of getOrientationSensorNameForIndex(). */
+    void computeCurrentSensorOrientations(
+            SimTK::Array_<SimTK::Rotation> &orientations);
+    /** Compute and return the angles (in radians) between the orientations
+        of all orientation sensors' frames and their observations. */
+    void computeCurrentOrientationErrors(SimTK::Array_<double> &errors);
+    /** Return the name of the orientation sensor at an index in the lists
+        returned by computeCurrentSensorOrientations() and
+        computeCurrentOrientationErrors(). */
+    std::string getOrientationSensorNameForIndex(int orientationIndex) const;
+
+    /** Whether track() first takes Gauss-Newton steps toward the solution,
+        and passes the result to the SimTK::Assembler as its initial guess
+        (default: false). Each step solves the normal equations of the
+        weighted marker, orientation and coordinate errors. They are built
+        from the Jacobians of the markers' stations and of the angular
+        velocities of the orientation sensors' frames, accumulated only over
+        the mobilities between each marker's or sensor's body and ground.
+        Constraints and
+        the bounds of clamped coordinates are left to the Assembler, which
+        refines the guess to the requested accuracy. This saves
+        optimizer iterations on models with many markers, each of which
+        depends on only a few coordinates. */
+    void setUseMarkerJacobianSteps(bool useSteps)
+    {   _useMarkerJacobianSteps = useSteps; }
+    bool getUseMarkerJacobianSteps() const { return _useMarkerJacobianSteps; }
+
 protected:
     /** Internal method to convert the CoordinateReferences into goals of the 
         assembly solver. Subclasses can override to include other goals  
@@ -160,10 +225,24 @@ protected:
     /** Internal method to update the time, reference values and/or their 
         weights that define the goals, based on the provided state. */
     void updateGoals(const SimTK::State &s) override;
+    /** Internal method to update the weights of the coordinate and marker
+        goals from their references, for reassemble(). */
+    void updateGoalWeights(const SimTK::State &s) override;
+    /** Take Gauss-Newton steps from the Assembler's internal state if
+        getUseMarkerJacobianSteps() is true. */
+    bool refineTrackingGuess(double time) override;
 
 private:
+    // Check that some of the markers of the reference are in the model.
+    void checkMarkers() const;
+    // Check that some of the frames of the orientations reference are in the
+    // model.
+    void checkOrientations() const;
+
     // The marker reference values and weightings
     MarkersReference &_markersReference;
+    // The orientation reference values and weightings, if any.
+    SimTK::ReferencePtr<OrientationsReference> _orientationsReference;
 
     // Non-accessible cache of the marker values to be matched at a given state
     SimTK::Array_<SimTK::Vec3> _markerValues;
@@ -172,6 +251,26 @@ private:
     // and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::Markers> _markerAssemblyCondition;
 
+    // Non-accessible cache of the orientations to be matched, and the
+    // assembly condition that matches them (managed by the Assembler), if
+    // there is an OrientationsReference.
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+    SimTK::ReferencePtr<SimTK::OrientationSensors> _orientationAssemblyCondition;
+
+    bool _useMarkerJacobianSteps = false;
+    // The mobilities (u indices) each marker's location depends on, i.e.,
+    // those of the bodies from the marker's body to ground.
+    std::vector<std::vector<int>> _markerMobilities;
+    // The mobilities each orientation sensor's orientation depends on.
+    std::vector<std::vector<int>> _orientationMobilities;
+    // Workspace for the Gauss-Newton steps, sized once per assemble().
+    SimTK::State _stepState;
+    SimTK::RowVector_<SimTK::Vec3> _stationJacobian;
+    SimTK::RowVector_<SimTK::SpatialVec> _frameJacobian;
+    SimTK::Matrix _normalMatrix;
+    SimTK::Vector _gradient, _du, _dq, _freeQs;
+    SimTK::FactorLU _normalFactorization;
+
 //=============================================================================
 };  // END of class InverseKinematicsSolver
 //=============================================================================
@@ -0,0 +1,192 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  EnsembleManager.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleManager.h"
+#include "Manager.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/BinaryFileAdapter.h>
+#include "simmath/RungeKuttaMersonIntegrator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using namespace std;
+using namespace OpenSim;
+
+EnsembleManager::EnsembleManager(const Model& model) : _model(&model) {}
+
+int EnsembleManager::addMember(const Member& member)
+{
+    _members.push_back(member);
+    return int(_members.size()) - 1;
+}
+
+namespace {
+// A member's parameter-only property and the value it had before the
+// member's override, to be restored once the member has been integrated.
+struct OverriddenParameter {
+    Component* component;
+    std::string propertyName;
+    double originalValue;
+};
+}
+
+std::vector<TimeSeriesTable> EnsembleManager::integrate(double initialTime,
+                                                        double finalTime)
+{
+    std::vector<TimeSeriesTable> results(getNumMembers());
+    std::vector<int> memberIndices(getNumMembers());
+    for (int m = 0; m < getNumMembers(); ++m) memberIndices[m] = m;
+    integrateMembers(initialTime, finalTime, memberIndices,
+            [&](int m, const TimeSeriesTable& states) { results[m] = states; });
+    return results;
+}
+
+int EnsembleManager::integrateShare(double initialTime, double finalTime,
+        const std::string& outputDir, int processIndex, int numProcesses)
+{
+    if (numProcesses < 1 || processIndex < 0 || processIndex >= numProcesses)
+        throw Exception("EnsembleManager::integrateShare() process index " +
+                std::to_string(processIndex) + " is not in [0, " +
+                std::to_string(numProcesses) + ").", __FILE__, __LINE__);
+
+    std::vector<int> memberIndices;
+    for (int m = processIndex; m < getNumMembers(); m += numProcesses) {
+        if (!std::ifstream(getMemberFileName(outputDir, m)).good())
+            memberIndices.push_back(m);
+    }
+    std::atomic<int> numWritten(0);
+    integrateMembers(initialTime, finalTime, memberIndices,
+            [&](int m, const TimeSeriesTable& states) {
+        const std::string fileName = getMemberFileName(outputDir, m);
+        const std::string partialFileName = fileName + ".partial";
+        BinaryFileAdapter::write(states, partialFileName);
+        if (std::rename(partialFileName.c_str(), fileName.c_str()) != 0) {
+            std::remove(partialFileName.c_str());
+            throw Exception("Could not write '" + fileName + "'.",
+                            __FILE__, __LINE__);
+        }
+        ++numWritten;
+    });
+    return numWritten;
+}
+
+std::string EnsembleManager::getMemberFileName(const std::string& outputDir,
+                                               int index)
+{
+    std::string number = std::to_string(index);
+    if (number.size() < 6) number.insert(0, 6 - number.size(), '0');
+    std::string fileName = outputDir;
+    if (!fileName.empty() && fileName.back() != '/' && fileName.back() != '\\')
+        fileName += '/';
+    return fileName + "member_" + number + ".bsto";
+}
+
+void EnsembleManager::integrateMembers(double initialTime, double finalTime,
+        const std::vector<int>& memberIndices,
+        const std::function<void(int, const TimeSeriesTable&)>& handleResult)
+{
+    const int numMembers = int(memberIndices.size());
+    // The message of the error encountered by each member, if any.
+    std::vector<string> errors(numMembers);
+    _failures.clear();
+    if (numMembers == 0) return;
+
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, numMembers));
+
+    // Each thread integrates on its own copy of the model. The copies are
+    // initialized here, rather than on the threads, so that building the
+    // Systems does not need to be thread-safe.
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    std::vector<SimTK::State> defaultStates(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        models[t].reset(_model->clone());
+        models[t]->setUseVisualizer(false);
+        defaultStates[t] = models[t]->initSystem();
+    }
+
+    // Members are handed out one at a time, so that a thread that finishes
+    // its member early takes the next one instead of idling.
+    std::atomic<int> nextMember(0);
+    auto integrateMembers = [&](int t) {
+        Model& model = *models[t];
+        for (int i = nextMember++; i < numMembers; i = nextMember++) {
+            const int m = memberIndices[i];
+            const Member& member = _members[m];
+            SimTK::State s = defaultStates[t];
+            std::vector<OverriddenParameter> overridden;
+            try {
+                for (const auto& param : member.parameters) {
+                    Component& comp =
+                        model.updComponent<Component>(param.componentPath);
+                    const double original = Property<double>::getAs(
+                        comp.getPropertyByName(param.propertyName)).getValue();
+                    comp.setParameterValue(s, param.propertyName, param.value);
+                    overridden.push_back({&comp, param.propertyName, original});
+                }
+                for (const auto& sv : member.stateVariableValues)
+                    model.setStateVariableValue(s, sv.first, sv.second);
+                s.setTime(initialTime);
+                if (_equilibrateMuscles) model.equilibrateMuscles(s);
+
+                SimTK::RungeKuttaMersonIntegrator integrator(
+                        model.getMultibodySystem());
+                integrator.setAccuracy(_accuracy);
+                Manager manager(model, integrator);
+                manager.initialize(s);
+                manager.integrate(finalTime);
+                handleResult(m, manager.getStatesTable());
+            }
+            catch (const std::exception& e) {
+                errors[i] = e.what();
+            }
+
+            // Undo the overrides, in reverse, for the thread's next member.
+            SimTK::State scratch = defaultStates[t];
+            for (auto it = overridden.rbegin(); it != overridden.rend(); ++it)
+                it->component->setParameterValue(scratch, it->propertyName,
+                                                 it->originalValue);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(integrateMembers, t);
+        } catch (const std::system_error&) {
+            // Could not start a thread; the remaining threads take its
+            // members.
+            break;
+        }
+    }
+    integrateMembers(0);
+    for (auto& thread : threads) thread.join();
+
+    for (int i = 0; i < numMembers; ++i) {
+        if (!errors[i].empty()) _failures[memberIndices[i]] = errors[i];
+    }
+}
@@ -0,0 +1,190 @@
+#ifndef OPENSIM_ENSEMBLE_MANAGER_H_
+#define OPENSIM_ENSEMBLE_MANAGER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  EnsembleManager.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/TimeSeriesTable.h"
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon/internal/ReferencePtr.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Integrate an ensemble of simulations of the same model, e.g., a Monte Carlo
+ * study over initial states, muscle parameters or controller gains. Each
+ * member of the ensemble is the model's default state with some state
+ * variables and some parameter-only properties (see
+ * Component::setParameterValue()) overridden.
+ *
+ * The members are integrated concurrently. Each thread owns a copy of the
+ * model, initialized once, and repeatedly takes the next member that has not
+ * been started, so threads that draw short simulations take more of them.
+ * A member's parameter overrides are undone once it has been integrated, so
+ * they do not leak into the next member integrated by the same thread.
+ *
+ * @code
+ * EnsembleManager ensemble(model);
+ * for (double gain : gains) {
+ *     EnsembleManager::Member member;
+ *     member.parameters.push_back({"/forceset/soleus_r",
+ *                                  "max_isometric_force", gain*4000});
+ *     member.stateVariableValues["/jointset/ankle_r/ankle_angle_r/value"] = 0.1;
+ *     ensemble.addMember(member);
+ * }
+ * std::vector<TimeSeriesTable> states = ensemble.integrate(0, 1.0);
+ * for (const auto& failure : ensemble.getFailures())
+ *     std::cout << failure.first << ": " << failure.second << std::endl;
+ * @endcode
+ *
+ * An ensemble too large for one machine can be spread over the processes of
+ * a cluster job (e.g., the ranks of an MPI job, or the tasks of an array job),
+ * each of which loads the model (a precompiled model file, see
+ * Model::writePrecompiledFile(), makes this fast), adds the same members, and
+ * calls integrateShare() with its own process index:
+ * @code
+ * const int rank = std::stoi(std::getenv("SLURM_PROCID"));
+ * const int numRanks = std::stoi(std::getenv("SLURM_NTASKS"));
+ * ensemble.integrateShare(0, 1.0, "results", rank, numRanks);
+ * @endcode
+ */
+class OSIMSIMULATION_API EnsembleManager
+{
+public:
+    /** A value for a parameter-only property of a component of the model. */
+    struct ParameterOverride {
+        /** Path of the component (e.g., "/forceset/soleus_r"). */
+        std::string componentPath;
+        /** Name of a parameter-only property of type double. */
+        std::string propertyName;
+        double value;
+    };
+
+    /** The overrides of the model's default state and parameters that define
+    one member of the ensemble. */
+    struct Member {
+        /** Initial values of state variables, keyed by path (as accepted by
+        Component::setStateVariableValue()). */
+        std::map<std::string, double> stateVariableValues;
+        /** Parameter-only properties to change for this member. Overriding a
+        topology-affecting property makes the member fail. */
+        std::vector<ParameterOverride> parameters;
+    };
+
+    /** The model is copied once per thread when integrate() is called; it
+    is not modified and need not be initialized, but must outlive this
+    EnsembleManager. */
+    explicit EnsembleManager(const Model& model);
+
+    EnsembleManager(const EnsembleManager&) = delete;
+    void operator=(const EnsembleManager&) = delete;
+
+    /** Append a member to the ensemble and return its index. */
+    int addMember(const Member& member);
+    int getNumMembers() const { return int(_members.size()); }
+    const Member& getMember(int index) const { return _members.at(index); }
+    void clearMembers() { _members.clear(); }
+
+    /** Number of threads (and model copies) used by integrate(); if not
+    positive (the default), the number of hardware threads is used. No more
+    threads than members are used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Accuracy of the SimTK::RungeKuttaMersonIntegrator used for each
+    member (default: 1e-3, the integrator's default). */
+    void setIntegratorAccuracy(double accuracy) { _accuracy = accuracy; }
+    double getIntegratorAccuracy() const { return _accuracy; }
+
+    /** Whether to equilibrate the muscles of each member (with
+    Model::equilibrateMuscles()) after applying its overrides (default:
+    false). */
+    void setEquilibrateMuscles(bool equilibrate)
+    {   _equilibrateMuscles = equilibrate; }
+    bool getEquilibrateMuscles() const { return _equilibrateMuscles; }
+
+    /** Integrate every member from initialTime to finalTime. The returned
+    tables, one per member in the order the members were added, hold the
+    states recorded by each member's Manager (see
+    Manager::getStatesTable()). The table of a member that failed is empty,
+    and the failure is reported by getFailures(). */
+    std::vector<TimeSeriesTable> integrate(double initialTime,
+                                           double finalTime);
+
+    /** Integrate the share of the members that belongs to one of several
+    processes, and write the states of each member to the file
+    getMemberFileName(outputDir, index), in the binary columnar format (see
+    BinaryFileAdapter). Member m belongs to process m % numProcesses; the
+    members of a process are shared among its threads as by integrate().
+
+    Members whose file already exists are skipped, so that a job that was
+    interrupted, or some of whose members failed, can be submitted again to
+    integrate only the remaining members. Each file is written under a
+    temporary name and renamed once complete, so that a partial file is never
+    taken for a result. A member that fails writes no file, and is reported
+    by getFailures().
+    @returns the number of members integrated (and written) by this call.
+    @throws Exception If processIndex is not in [0, numProcesses). */
+    int integrateShare(double initialTime, double finalTime,
+                       const std::string& outputDir,
+                       int processIndex, int numProcesses);
+
+    /** The file to which integrateShare() writes the states of a member:
+    `<outputDir>/member_<index>.bsto`, with the index padded to 6 digits. */
+    static std::string getMemberFileName(const std::string& outputDir,
+                                         int index);
+
+    /** The error message of each member that failed in the last call to
+    integrate(), keyed by the member's index. */
+    const std::map<int, std::string>& getFailures() const
+    {   return _failures; }
+
+private:
+    // Integrate the given members, and pass the states of each member that
+    // succeeds to handleResult (on the thread that integrated it). Members
+    // that fail, or for which handleResult throws, are recorded in _failures.
+    void integrateMembers(double initialTime, double finalTime,
+            const std::vector<int>& memberIndices,
+            const std::function<void(int, const TimeSeriesTable&)>&
+                handleResult);
+
+    SimTK::ReferencePtr<const Model> _model;
+    std::vector<Member> _members;
+    int _numThreads = -1;
+    double _accuracy = 1e-3;
+    bool _equilibrateMuscles = false;
+    std::map<int, std::string> _failures;
+
+};  // END of class EnsembleManager
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLE_MANAGER_H_
@@ -30,7 +30,19 @@
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
-
+#include <OpenSim/Common/RunControl.h>
+#include <OpenSim/Common/Tracer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -40,9 +52,98 @@ using namespace std;
 // STATICS
 //=============================================================================
 std::string Manager::_displayName = "Simulator";
+//=============================================================================
+// BACKGROUND RECORDER
+//=============================================================================
+// Records copies of States, in order, on a background thread. The copies are
+// held in a ring buffer of fixed size so that their memory is reused.
+class Manager::BackgroundRecorder {
+public:
+    BackgroundRecorder(Manager& manager, int bufferSize)
+        : _manager(manager), _slots(std::max(1, bufferSize)) {
+        _thread = std::thread(&BackgroundRecorder::run, this);
+    }
+    ~BackgroundRecorder() {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    // Copy the State into the buffer, waiting for a free slot if needed.
+    void push(const SimTK::State& s, int step) {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this] { return _count < _slots.size(); });
+        auto& slot = _slots[(_head + _count) % _slots.size()];
+        // The slot is not touched by the background thread until it is
+        // counted, so the copy is made without holding the lock.
+        lock.unlock();
+        slot.first = s;
+        slot.second = step;
+        lock.lock();
+        ++_count;
+        _condition.notify_all();
+    }
+
+    // Wait until all pushed States have been recorded; throw the first error
+    // encountered while recording them, if any.
+    void drain() {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this] { return _count == 0; });
+        if (!_error.empty()) {
+            std::string msg;
+            msg.swap(_error);
+            throw Exception("Manager: recording in the background failed: "
+                            + msg, __FILE__, __LINE__);
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while (true) {
+            _condition.wait(lock, [this] { return _count > 0 || _stop; });
+            if (_count == 0) return;
+            const auto& slot = _slots[_head];
+            const bool failed = !_error.empty();
+            lock.unlock();
+            std::string error;
+            // After a failure, the remaining States are discarded so that
+            // integrate() does not wait on a full buffer.
+            if (!failed) {
+                try { _manager.recordNow(slot.first, slot.second); }
+                catch (const std::exception& e) { error = e.what(); }
+            }
+            lock.lock();
+            if (!error.empty()) _error = error;
+            _head = (_head + 1) % _slots.size();
+            --_count;
+            _condition.notify_all();
+        }
+    }
+
+    Manager& _manager;
+    std::vector<std::pair<SimTK::State, int>> _slots;
+    size_t _head = 0;
+    size_t _count = 0;
+    bool _stop = false;
+    std::string _error;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
+Manager::~Manager()
+{
+    // Stop recording before the storage and analyses are destroyed.
+    _backgroundRecorder.reset();
+    if (_checkpointThread.joinable()) _checkpointThread.join();
+}
 
 
 //=============================================================================
@@ -112,6 +213,15 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _statesFileChunkSize = 1000;
+    _statesFileInBackground = false;
+    _recordInBackground = false;
+    _recordBufferSize = 64;
+    _checkpointInterval = 0;
+    _reportInterval = 0;
+    _macroStep = 0;
+    _integratorProbeDuration = 0;
+    _nextCheckpointTime = SimTK::NaN;
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -572,6 +682,171 @@ TimeSeriesTable Manager::getStatesTable() const {
     return getStateStorage().exportToTable();
 }
 
+void Manager::setStatesFile(const std::string& fileName, int chunkSize,
+                            bool flushInBackground)
+{
+    if (_statesFileWriter) _statesFileWriter->close();
+    _statesFileWriter.reset();
+    _statesFileName = fileName;
+    _statesFileChunkSize = chunkSize;
+    _statesFileInBackground = flushInBackground;
+}
+
+void Manager::setRecordInBackground(bool recordInBackground, int bufferSize)
+{
+    // A recorder with the old settings is stopped; it has already recorded
+    // every State, since integrate() waits for it.
+    _backgroundRecorder.reset();
+    _recordInBackground = recordInBackground;
+    _recordBufferSize = bufferSize;
+}
+
+void Manager::setReportInterval(double interval)
+{
+    OPENSIM_THROW_IF(!SimTK::isFinite(interval), Exception,
+        "Manager::setReportInterval(): the interval must be finite.");
+    _reportInterval = interval;
+}
+
+void Manager::setMultirateMacroStep(double macroStep)
+{
+    OPENSIM_THROW_IF(!SimTK::isFinite(macroStep), Exception,
+        "Manager::setMultirateMacroStep(): the step must be finite.");
+    _macroStep = macroStep;
+}
+
+void Manager::addSlowStateVariable(const std::string& path)
+{
+    OPENSIM_THROW_IF(!_model, Exception,
+        "Manager::addSlowStateVariable(): the Manager has no model.");
+    const ComponentPath svPath(path);
+    const Component& component = svPath.getParentPath().toString().empty()
+        ? *_model
+        : _model->getComponent(svPath.getParentPath().toString());
+    // Check that the component can hold the derivative.
+    component.holdStateVariableDerivative(svPath.getComponentName(), 0);
+    component.releaseStateVariableDerivatives();
+    _slowStateVariables.emplace_back(
+            SimTK::ReferencePtr<const Component>(&component),
+            svPath.getComponentName());
+}
+
+void Manager::addSlowComponent(const Component& component)
+{
+    const Array<std::string> names = component.getStateVariableNames();
+    for (int i = 0; i < names.size(); ++i) {
+        // Those of subcomponents are named by their relative paths.
+        if (names[i].find('/') != std::string::npos) continue;
+        component.holdStateVariableDerivative(names[i], 0);
+        component.releaseStateVariableDerivatives();
+        _slowStateVariables.emplace_back(
+                SimTK::ReferencePtr<const Component>(&component), names[i]);
+    }
+}
+
+void Manager::setAutoSelectIntegrator(double probeDuration)
+{
+    OPENSIM_THROW_IF(!SimTK::isFinite(probeDuration), Exception,
+        "Manager::setAutoSelectIntegrator(): the duration must be finite.");
+    _integratorProbeDuration = probeDuration;
+}
+
+namespace {
+// Statistics of the integration of the first interval of a simulation.
+struct IntegratorProbe {
+    std::string method;
+    bool succeeded = false;
+    int numStepsTaken = 0;
+    int numStepsRejected = 0;
+    int numRealizations = 0;
+};
+
+IntegratorProbe probeIntegrator(const SimTK::System& system,
+        SimTK::Integrator& integ, const SimTK::State& s, double finalTime)
+{
+    IntegratorProbe probe;
+    probe.method = integ.getMethodName();
+    try {
+        SimTK::TimeStepper timeStepper(system, integ);
+        timeStepper.initialize(s);
+        while (integ.getTime() < finalTime && !integ.isSimulationOver())
+            timeStepper.stepTo(finalTime);
+        probe.succeeded = integ.getTime() >= finalTime;
+    } catch (const std::exception&) {
+        // The candidate cannot integrate this model.
+    }
+    probe.numStepsTaken = integ.getNumStepsTaken();
+    probe.numStepsRejected =
+            integ.getNumStepsAttempted() - integ.getNumStepsTaken();
+    probe.numRealizations = integ.getNumRealizations();
+    return probe;
+}
+}
+
+void Manager::selectIntegrator(const SimTK::State& s)
+{
+    OPENSIM_TRACE_SPAN("simulation", "selectIntegrator");
+    OPENSIM_THROW_IF(!_defaultInteg || _integ.get() != _defaultInteg.get(),
+        Exception, "Manager::initialize(): the integrator can only be "
+        "selected automatically by a Manager constructed with a model only.");
+    const SimTK::MultibodySystem& system = _model->getMultibodySystem();
+    const double finalTime = s.getTime() + _integratorProbeDuration;
+
+    std::vector<std::unique_ptr<SimTK::Integrator>> candidates;
+    candidates.push_back(std::move(_defaultInteg));
+    std::vector<IntegratorProbe> probes;
+    probes.push_back(probeIntegrator(system, *candidates[0], s, finalTime));
+    const double accuracy = candidates[0]->getAccuracyInUse();
+    const double constraintTolerance =
+            candidates[0]->getConstraintToleranceInUse();
+
+    candidates.emplace_back(new SimTK::SemiExplicitEuler2Integrator(system));
+    candidates.emplace_back(new SimTK::CPodesIntegrator(system,
+            SimTK::CPodes::BDF, SimTK::CPodes::Newton));
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        candidates[i]->setAccuracy(accuracy);
+        candidates[i]->setConstraintTolerance(constraintTolerance);
+        probes.push_back(probeIntegrator(system, *candidates[i], s,
+                                         finalTime));
+    }
+
+    // The cheapest candidate that succeeded, or the default one.
+    size_t best = 0;
+    for (size_t i = 1; i < probes.size(); ++i) {
+        if (probes[i].succeeded && (!probes[best].succeeded ||
+                probes[i].numRealizations < probes[best].numRealizations))
+            best = i;
+    }
+
+    std::ostringstream report;
+    report << "Integrator selection over [" << s.getTime() << ", "
+           << finalTime << "] s (accuracy " << accuracy << "):\n";
+    for (const auto& probe : probes) {
+        report << "  " << probe.method << ": ";
+        if (probe.succeeded) {
+            report << probe.numStepsTaken << " steps, "
+                   << probe.numStepsRejected << " rejected, "
+                   << probe.numRealizations << " evaluations\n";
+        } else {
+            report << "failed\n";
+        }
+    }
+    const IntegratorProbe& explicitProbe = probes[0];
+    const int attempted =
+            explicitProbe.numStepsTaken + explicitProbe.numStepsRejected;
+    report << "Selected " << probes[best].method;
+    if (attempted > 0) {
+        report << "; " << (100*explicitProbe.numStepsRejected)/attempted
+               << "% of the explicit steps were rejected";
+    }
+    report << ".";
+    _integratorSelectionReport = report.str();
+    cout << _integratorSelectionReport << endl;
+
+    _defaultInteg = std::move(candidates[best]);
+    _integ = *_defaultInteg;
+}
+
 //_____________________________________________________________________________
 /**
  * Get whether there is a storage buffer for the integration states.
@@ -585,9 +860,21 @@ hasStateStorage() const
 //-----------------------------------------------------------------------------
 // INTEGRATION
 //-----------------------------------------------------------------------------
+namespace {
+// Releases the derivatives of the slow state variables held for multirate
+// integration when integrate() returns or throws.
+struct SlowDerivativesRelease {
+    const std::vector<std::pair<SimTK::ReferencePtr<const Component>,
+                                std::string>>& slow;
+    ~SlowDerivativesRelease() {
+        for (const auto& sv : slow) sv.first->releaseStateVariableDerivatives();
+    }
+};
+}
 
 const SimTK::State& Manager::integrate(double finalTime)
 {
+    OPENSIM_TRACE_SPAN("simulation", "integrate");
     int step = 1; // for AnalysisSet::step()
 
     if (_timeStepper == nullptr) {
@@ -600,6 +887,8 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     // Set the final time on the integrator so it can signal EndOfSimulation
     _integ->setFinalTime(finalTime);
+    // A later stepRealTime() must clear it again.
+    _realTime.started = false;
 
     // CLEAR ANY INTERRUPT
     // Halts must arrive during an integration.
@@ -635,9 +924,22 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     auto status = SimTK::Integrator::InvalidSuccessfulStepStatus;
 
+    // With a report interval, the integrator takes its natural steps and the
+    // States at the report times are interpolated from its dense output.
+    const bool interpolateReports = !fixedStep && _reportInterval > 0;
     if (!fixedStep) {
-        _integ->setReturnEveryInternalStep(true);
+        _integ->setReturnEveryInternalStep(!interpolateReports);
+    }
+    // With multirate integration, steps end exactly at the macro steps,
+    // where the held derivatives change.
+    const bool multirate = _macroStep > 0 && !_slowStateVariables.empty();
+    if (multirate) {
+        _integ->setAllowInterpolation(false);
+    } else if (interpolateReports) {
+        _integ->setAllowInterpolation(true);
     }
+    SlowDerivativesRelease releaseSlowDerivatives{_slowStateVariables};
+    double nextMacroTime = -SimTK::Infinity;
 
     _model->realizeVelocity(s);
     initializeStorageAndAnalyses(s);
@@ -652,6 +954,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     if (time >= stepToTime) {
         // No integration can be performed.
+        finishRecording();
         return getState();
     }
 
@@ -667,13 +970,36 @@ const SimTK::State& Manager::integrate(double finalTime)
             _integ->setFixedStepSize(fixedStepSize);
             stepToTime = time + fixedStepSize;
         }
+        else if (interpolateReports) {
+            // The next multiple of the interval, computed from its index so
+            // that round-off does not accumulate over long integrations.
+            const double next = (std::floor(time/_reportInterval + 1e-9) + 1)
+                                * _reportInterval;
+            stepToTime = std::min(next, finalTime);
+        }
+        if (multirate) {
+            if (time >= nextMacroTime) {
+                holdSlowDerivatives();
+                nextMacroTime = (std::floor(time/_macroStep + 1e-9) + 1)
+                                * _macroStep;
+            }
+            stepToTime = std::min(stepToTime, nextMacroTime);
+        }
 
-        status = _timeStepper->stepTo(stepToTime);
+        {
+            OPENSIM_TRACE_SPAN("simulation", "step");
+            status = _timeStepper->stepTo(stepToTime);
+        }
 
         if ( (status == SimTK::Integrator::TimeHasAdvanced) ||
-             (status == SimTK::Integrator::ReachedScheduledEvent) ) {
+             (status == SimTK::Integrator::ReachedScheduledEvent) ||
+             (status == SimTK::Integrator::ReachedReportTime) ) {
             const SimTK::State& s = _integ->getState();
             record(s, step);
+            // Reporters with a report_time_interval of 0 record here, so
+            // they receive the same uniformly spaced samples.
+            if (interpolateReports) _model->realizeReport(s);
+            checkpointIfDue(s);
             step++;
         }
         // Check if simulation has terminated for some reason
@@ -683,10 +1009,16 @@ const SimTK::State& Manager::integrate(double finalTime)
             cout << "Integration failed due to the following reason: "
                 << _integ->getTerminationReasonString(_integ->getTerminationReason())
                 << endl;
+            finishRecording();
             return getState();
         }
 
         time = _integ->getState().getTime();
+        if (_runControl) {
+            _runControl->setProgress(
+                    (time - initialTime)/(finalTime - initialTime));
+            if (_runControl->isCancelled()) halt();
+        }
         // CHECK FOR INTERRUPT
         if (checkHalt()) break;
     }
@@ -699,6 +1031,25 @@ const SimTK::State& Manager::integrate(double finalTime)
     return getState();
 }
 
+void Manager::holdSlowDerivatives()
+{
+    // The derivatives at the current State, computed rather than held.
+    for (const auto& sv : _slowStateVariables)
+        sv.first->releaseStateVariableDerivatives();
+    SimTK::State s = _integ->getState();
+    _model->realizeAcceleration(s);
+    for (const auto& sv : _slowStateVariables) {
+        sv.first->holdStateVariableDerivative(sv.second,
+                sv.first->getStateVariableDerivativeValue(s, sv.second));
+    }
+
+    // The integrator's derivatives are out of date, and its next step starts
+    // a new interval of smooth dynamics.
+    _integ->updAdvancedState().invalidateAllCacheAtOrAbove(
+            SimTK::Stage::Acceleration);
+    _integ->reinitialize(SimTK::Stage::Acceleration, false);
+}
+
 const SimTK::State& Manager::getState() const
 {
     return _timeStepper->getState();
@@ -760,6 +1111,7 @@ void Manager::initialize(const SimTK::State& s)
     }
 
     else {
+        if (_integratorProbeDuration > 0) selectIntegrator(s);
         _timeStepper.reset(
             new SimTK::TimeStepper(_model->getMultibodySystem(), *_integ));
         _timeStepper->initialize(s);
@@ -768,6 +1120,25 @@ void Manager::initialize(const SimTK::State& s)
 }
 
 void Manager::record(const SimTK::State& s, const int& step)
+{
+    if (!_recordInBackground) {
+        recordNow(s, step);
+        return;
+    }
+    if (!_backgroundRecorder)
+        _backgroundRecorder.reset(
+                new BackgroundRecorder(*this, _recordBufferSize));
+    _backgroundRecorder->push(s, step);
+    // The end of an integration is only reported once it has been recorded.
+    if (step < 0) _backgroundRecorder->drain();
+}
+
+void Manager::finishRecording()
+{
+    if (_backgroundRecorder) _backgroundRecorder->drain();
+}
+
+void Manager::recordNow(const SimTK::State& s, const int& step)
 {
     // ANALYSES 
     if (_performAnalyses) {
@@ -779,7 +1150,26 @@ void Manager::record(const SimTK::State& s, const int& step)
         else
             analysisSet.step(s, step);
     }
-    if (_writeToStorage) {
+    if (_writeToStorage && !_statesFileName.empty()) {
+        if (!_statesFileWriter) {
+            const Array<std::string> names = _model->getStateVariableNames();
+            _statesFileWriter.reset(new STOFileWriter(_statesFileName,
+                    std::vector<std::string>(names.get(),
+                                             names.get() + names.getSize()),
+                    _statesFileChunkSize, _statesFileInBackground));
+        }
+        // A time is recorded again when integrate() is called repeatedly.
+        if (s.getTime() > _statesFileWriter->getLastTime()) {
+            const SimTK::Vector stateValues =
+                    _model->getStateVariableValues(s);
+            _statesFileWriter->appendRow(s.getTime(),
+                                         (~stateValues).getAsRowVectorView());
+        }
+        if (step < 0) _statesFileWriter->flush();
+        if (_model->isControlled())
+            _controllerSet->storeControls(s,
+                (step < 0) ? int(_statesFileWriter->getNumRows()) : step);
+    } else if (_writeToStorage) {
         SimTK::Vector stateValues = _model->getStateVariableValues(s);
         StateVector vec;
         vec.setStates(s.getTime(), stateValues);
@@ -790,6 +1180,420 @@ void Manager::record(const SimTK::State& s, const int& step)
     }
 }
 
+//=============================================================================
+// REAL-TIME STEPPING
+//=============================================================================
+void Manager::setRealTimeDeadline(double deadline, OverrunPolicy policy,
+                                  int latencyWindow)
+{
+    OPENSIM_THROW_IF(!(deadline > 0) || latencyWindow < 1, Exception,
+        "Manager::setRealTimeDeadline(): the deadline and latency window "
+        "must be positive.");
+    _realTime.deadline = deadline;
+    _realTime.policy = int(policy);
+    _realTime.latencies.assign(latencyWindow, 0.0);
+    resetRealTimeStatistics();
+}
+
+const SimTK::State& Manager::stepRealTime(double stepSize)
+{
+    const auto start = std::chrono::steady_clock::now();
+    if (_timeStepper == nullptr) {
+        throw Exception("Manager::stepRealTime(): Manager has not been "
+            "initialized. Call Manager::initialize() first.");
+    }
+    RealTimeLoop& rt = _realTime;
+
+    if (!rt.started) {
+        // The loop has no final time, and only the State at the end of
+        // each step is returned.
+        _integ->setFinalTime(SimTK::Infinity);
+        _integ->setReturnEveryInternalStep(false);
+        if (rt.latencies.empty()) rt.latencies.assign(10000, 0.0);
+        if (_performAnalyses) _model->updAnalysisSet().begin(getState());
+        rt.started = true;
+    }
+
+    const double targetTime = getState().getTime() + stepSize;
+    while (getState().getTime() < targetTime) {
+        {
+            OPENSIM_TRACE_SPAN("simulation", "step");
+            _timeStepper->stepTo(targetTime);
+        }
+        if (_integ->isSimulationOver()) {
+            throw Exception("Manager::stepRealTime(): integration failed: " +
+                _integ->getTerminationReasonString(
+                    _integ->getTerminationReason()));
+        }
+    }
+    const SimTK::State& s = getState();
+
+    if (_performAnalyses && !rt.skipAnalyses) {
+        _model->realizeVelocity(s);
+        _model->updAnalysisSet().step(s, int(rt.numSteps + 1));
+    }
+    rt.skipAnalyses = false;
+
+    const double latency = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    if (!rt.latencies.empty())
+        rt.latencies[rt.numSteps % rt.latencies.size()] = latency;
+    ++rt.numSteps;
+    rt.maxLatency = std::max(rt.maxLatency, latency);
+
+    const auto policy = OverrunPolicy(rt.policy);
+    if (latency > rt.deadline) {
+        ++rt.numDeadlineMisses;
+        if (policy == OverrunPolicy::SkipAnalyses) {
+            rt.skipAnalyses = true;
+        }
+        else if (policy == OverrunPolicy::ReduceAccuracy) {
+            if (SimTK::isNaN(rt.nominalAccuracy))
+                rt.nominalAccuracy = _integ->getAccuracyInUse();
+            const double accuracy = _integ->getAccuracyInUse();
+            if (accuracy < 0.1) {
+                _integ->setAccuracy(std::min(2*accuracy, 0.1));
+                // The integrator only takes up a new accuracy when it is
+                // (re)initialized.
+                _integ->reinitialize(SimTK::Stage::Position, false);
+            }
+        }
+    }
+    else if (policy == OverrunPolicy::ReduceAccuracy &&
+             latency < rt.deadline/2 && !SimTK::isNaN(rt.nominalAccuracy) &&
+             _integ->getAccuracyInUse() > rt.nominalAccuracy) {
+        _integ->setAccuracy(std::max(_integ->getAccuracyInUse()/2,
+                                     rt.nominalAccuracy));
+        _integ->reinitialize(SimTK::Stage::Position, false);
+    }
+    return s;
+}
+
+Manager::RealTimeStatistics Manager::getRealTimeStatistics() const
+{
+    const RealTimeLoop& rt = _realTime;
+    RealTimeStatistics stats;
+    stats.numSteps = rt.numSteps;
+    stats.numDeadlineMisses = rt.numDeadlineMisses;
+    stats.maxLatency = rt.maxLatency;
+
+    const size_t numKept = size_t(std::min<long long>(rt.numSteps,
+                                                      rt.latencies.size()));
+    if (numKept > 0) {
+        std::vector<double> latencies(rt.latencies.begin(),
+                                      rt.latencies.begin() + numKept);
+        auto percentile = [&](double fraction) {
+            auto nth = latencies.begin() +
+                       size_t(std::ceil(fraction*numKept)) - 1;
+            std::nth_element(latencies.begin(), nth, latencies.end());
+            return *nth;
+        };
+        stats.medianLatency = percentile(0.5);
+        stats.p99Latency = percentile(0.99);
+    }
+    return stats;
+}
+
+void Manager::resetRealTimeStatistics()
+{
+    _realTime.numSteps = 0;
+    _realTime.numDeadlineMisses = 0;
+    _realTime.maxLatency = 0;
+}
+
+//=============================================================================
+// CHECKPOINTS
+//=============================================================================
+namespace {
+// The values written to a checkpoint file. They are copied out of the
+// Manager, Model and State so that the file can be written by another thread.
+struct Checkpoint {
+    double time;
+    SimTK::Vector q, u, z;
+    // Keyed by the absolute path of the component and the variable's name.
+    std::vector<std::pair<std::string, double>> discreteVariables;
+    std::vector<std::pair<std::string, int>> modelingOptions;
+    double predictedStepSize;
+    std::uint64_t numRecordedStates;
+    // The recorded states, if kept in the state Storage, row by row: the
+    // time followed by the state variable values.
+    std::uint64_t rowSize;
+    std::vector<double> recordedStates;
+};
+
+constexpr std::uint32_t checkpointMagicNumber{0x4B43534F}; // "OSCK"
+constexpr std::uint32_t checkpointVersionNumber{1};
+
+template <typename T>
+void writeCheckpointValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+void writeCheckpointString(std::ostream& out, const std::string& str) {
+    writeCheckpointValue(out, std::uint64_t(str.size()));
+    out.write(str.data(), str.size());
+}
+void writeCheckpointVector(std::ostream& out, const SimTK::Vector& v) {
+    writeCheckpointValue(out, std::uint64_t(v.size()));
+    for (int i = 0; i < v.size(); ++i) writeCheckpointValue(out, v[i]);
+}
+
+template <typename T>
+T readCheckpointValue(std::istream& in, const std::string& fileName) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    OPENSIM_THROW_IF(!in, Exception,
+            "Manager: checkpoint file '" + fileName + "' is truncated.");
+    return value;
+}
+std::string readCheckpointString(std::istream& in,
+                                 const std::string& fileName) {
+    std::string str(readCheckpointValue<std::uint64_t>(in, fileName), '\0');
+    in.read(&str[0], str.size());
+    OPENSIM_THROW_IF(!in, Exception,
+            "Manager: checkpoint file '" + fileName + "' is truncated.");
+    return str;
+}
+SimTK::Vector readCheckpointVector(std::istream& in,
+                                   const std::string& fileName) {
+    SimTK::Vector v(int(readCheckpointValue<std::uint64_t>(in, fileName)));
+    for (int i = 0; i < v.size(); ++i)
+        v[i] = readCheckpointValue<double>(in, fileName);
+    return v;
+}
+
+// The model and its components, which own the discrete variables and
+// modeling options in a checkpoint.
+std::vector<const Component*> getCheckpointComponents(const Model& model) {
+    std::vector<const Component*> components{&model};
+    for (const Component& comp : model.getComponentList())
+        components.push_back(&comp);
+    return components;
+}
+
+// Write to a temporary file first, so that a crash while writing does not
+// destroy the previous checkpoint.
+void writeCheckpoint(const Checkpoint& c, const std::string& fileName) {
+    const std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream out(tmpFileName, std::ios::binary | std::ios::trunc);
+        OPENSIM_THROW_IF(!out, Exception,
+                "Manager: could not open checkpoint file '" + tmpFileName +
+                "' for writing.");
+        writeCheckpointValue(out, checkpointMagicNumber);
+        writeCheckpointValue(out, checkpointVersionNumber);
+        writeCheckpointValue(out, c.time);
+        writeCheckpointVector(out, c.q);
+        writeCheckpointVector(out, c.u);
+        writeCheckpointVector(out, c.z);
+        writeCheckpointValue(out, std::uint64_t(c.discreteVariables.size()));
+        for (const auto& dv : c.discreteVariables) {
+            writeCheckpointString(out, dv.first);
+            writeCheckpointValue(out, dv.second);
+        }
+        writeCheckpointValue(out, std::uint64_t(c.modelingOptions.size()));
+        for (const auto& mo : c.modelingOptions) {
+            writeCheckpointString(out, mo.first);
+            writeCheckpointValue(out, std::int64_t(mo.second));
+        }
+        writeCheckpointValue(out, c.predictedStepSize);
+        writeCheckpointValue(out, c.numRecordedStates);
+        writeCheckpointValue(out, c.rowSize);
+        writeCheckpointValue(out, std::uint64_t(c.recordedStates.size()));
+        out.write(reinterpret_cast<const char*>(c.recordedStates.data()),
+                  c.recordedStates.size()*sizeof(double));
+        OPENSIM_THROW_IF(!out, Exception,
+                "Manager: could not write checkpoint file '" + tmpFileName +
+                "'.");
+    }
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows.
+    std::remove(fileName.c_str());
+#endif
+    OPENSIM_THROW_IF(std::rename(tmpFileName.c_str(), fileName.c_str()) != 0,
+            Exception, "Manager: could not replace checkpoint file '" +
+            fileName + "'.");
+}
+
+Checkpoint makeCheckpoint(const Model& model, const SimTK::State& s,
+        const SimTK::Integrator& integ, const Storage* stateStore,
+        std::uint64_t numRecordedStates)
+{
+    Checkpoint c;
+    c.time = s.getTime();
+    c.q = s.getQ();
+    c.u = s.getU();
+    c.z = s.getZ();
+    for (const Component* comp : getCheckpointComponents(model)) {
+        const std::string path = comp->getAbsolutePathString() + "/";
+        for (const auto& name : comp->getDiscreteVariableNames())
+            c.discreteVariables.emplace_back(path + name,
+                    comp->getDiscreteVariableValue(s, name));
+        for (const auto& name : comp->getModelingOptionNames())
+            c.modelingOptions.emplace_back(path + name,
+                    comp->getModelingOption(s, name));
+    }
+    // The predicted step size is only available once a step was taken.
+    c.predictedStepSize = integ.getNumStepsTaken() > 0 ?
+            integ.getPredictedNextStepSize() : SimTK::NaN;
+    c.numRecordedStates = numRecordedStates;
+    c.rowSize = 0;
+    if (stateStore) {
+        c.rowSize = 1 + s.getNY();
+        c.recordedStates.reserve(c.rowSize*stateStore->getSize());
+        for (int i = 0; i < stateStore->getSize(); ++i) {
+            const StateVector& row = *stateStore->getStateVector(i);
+            OPENSIM_THROW_IF(std::uint64_t(row.getSize()) + 1 != c.rowSize,
+                    Exception, "Manager: the state Storage does not hold the "
+                    "model's state variables and cannot be checkpointed.");
+            c.recordedStates.push_back(row.getTime());
+            for (int j = 0; j < row.getSize(); ++j)
+                c.recordedStates.push_back(row.getData()[j]);
+        }
+    }
+    return c;
+}
+} // anonymous namespace
+
+void Manager::checkpoint(const std::string& fileName)
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+            "Manager::checkpoint(): Manager has not been initialized.");
+    // The recorded states must be complete, and an earlier checkpoint
+    // written, before this one is made.
+    finishRecording();
+    if (_checkpointThread.joinable()) _checkpointThread.join();
+
+    const bool keepsStorage = _statesFileName.empty() && hasStateStorage();
+    const std::uint64_t numRecorded = keepsStorage ? getStateStorage().getSize()
+            : (_statesFileWriter ? _statesFileWriter->getNumRows() : 0);
+    if (_statesFileWriter) _statesFileWriter->flush();
+    writeCheckpoint(makeCheckpoint(*_model, _integ->getState(), *_integ,
+                        keepsStorage ? &getStateStorage() : nullptr,
+                        numRecorded),
+                    fileName);
+}
+
+void Manager::restoreFromCheckpoint(const std::string& fileName)
+{
+    OPENSIM_THROW_IF(_timeStepper != nullptr, Exception,
+            "Manager::restoreFromCheckpoint(): Manager has already been "
+            "initialized.");
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in, Exception,
+            "Manager: could not open checkpoint file '" + fileName + "'.");
+    OPENSIM_THROW_IF(readCheckpointValue<std::uint32_t>(in, fileName) !=
+                     checkpointMagicNumber, Exception,
+            "Manager: '" + fileName + "' is not a checkpoint file.");
+    OPENSIM_THROW_IF(readCheckpointValue<std::uint32_t>(in, fileName) !=
+                     checkpointVersionNumber, Exception,
+            "Manager: checkpoint file '" + fileName + "' has an unsupported "
+            "version.");
+
+    SimTK::State s = _model->getWorkingState();
+    s.setTime(readCheckpointValue<double>(in, fileName));
+    const SimTK::Vector q = readCheckpointVector(in, fileName);
+    const SimTK::Vector u = readCheckpointVector(in, fileName);
+    const SimTK::Vector z = readCheckpointVector(in, fileName);
+    OPENSIM_THROW_IF(q.size() != s.getNQ() || u.size() != s.getNU() ||
+                     z.size() != s.getNZ(), Exception,
+            "Manager: checkpoint file '" + fileName + "' does not match the "
+            "state variables of model '" + _model->getName() + "'.");
+    s.updQ() = q;
+    s.updU() = u;
+    s.updZ() = z;
+
+    std::map<std::string, const Component*> components;
+    for (const Component* comp : getCheckpointComponents(*_model))
+        components[comp->getAbsolutePathString()] = comp;
+    auto findOwner = [&](const std::string& key, std::string& name) {
+        const auto slash = key.rfind('/');
+        const auto it = components.find(key.substr(0, slash));
+        OPENSIM_THROW_IF(it == components.end(), Exception,
+                "Manager: component of '" + key + "' in checkpoint file '" +
+                fileName + "' not found in model '" + _model->getName() +
+                "'.");
+        name = key.substr(slash + 1);
+        return it->second;
+    };
+    std::string name;
+    const auto numDiscrete = readCheckpointValue<std::uint64_t>(in, fileName);
+    for (std::uint64_t i = 0; i < numDiscrete; ++i) {
+        const std::string key = readCheckpointString(in, fileName);
+        const double value = readCheckpointValue<double>(in, fileName);
+        findOwner(key, name)->setDiscreteVariableValue(s, name, value);
+    }
+    const auto numOptions = readCheckpointValue<std::uint64_t>(in, fileName);
+    for (std::uint64_t i = 0; i < numOptions; ++i) {
+        const std::string key = readCheckpointString(in, fileName);
+        const auto flag = readCheckpointValue<std::int64_t>(in, fileName);
+        findOwner(key, name)->setModelingOption(s, name, int(flag));
+    }
+
+    const double predictedStepSize = readCheckpointValue<double>(in, fileName);
+    readCheckpointValue<std::uint64_t>(in, fileName); // numRecordedStates
+    const auto rowSize = readCheckpointValue<std::uint64_t>(in, fileName);
+    const auto numValues = readCheckpointValue<std::uint64_t>(in, fileName);
+    std::vector<double> recordedStates(numValues);
+    in.read(reinterpret_cast<char*>(recordedStates.data()),
+            numValues*sizeof(double));
+    OPENSIM_THROW_IF(!in, Exception,
+            "Manager: checkpoint file '" + fileName + "' is truncated.");
+    if (rowSize > 0 && hasStateStorage()) {
+        OPENSIM_THROW_IF(rowSize != std::uint64_t(1 + s.getNY()), Exception,
+                "Manager: checkpoint file '" + fileName + "' does not match "
+                "the state variables of model '" + _model->getName() + "'.");
+        for (std::uint64_t k = 0; k + rowSize <= numValues; k += rowSize) {
+            SimTK::Vector values(int(rowSize - 1), &recordedStates[k + 1]);
+            StateVector vec;
+            vec.setStates(recordedStates[k], values);
+            getStateStorage().append(vec);
+        }
+    }
+
+    initialize(s);
+    if (SimTK::isFinite(predictedStepSize) && predictedStepSize > 0)
+        _integ->setInitialStepSize(predictedStepSize);
+}
+
+void Manager::setCheckpointInterval(double interval,
+                                    const std::string& fileName)
+{
+    _checkpointInterval = interval;
+    _checkpointFileName = fileName;
+    _nextCheckpointTime = SimTK::NaN;
+}
+
+void Manager::checkpointIfDue(const SimTK::State& s)
+{
+    if (_checkpointInterval <= 0 || _checkpointFileName.empty()) return;
+    // The first checkpoint is due one interval after the first State.
+    if (SimTK::isNaN(_nextCheckpointTime)) {
+        _nextCheckpointTime = s.getTime() + _checkpointInterval;
+        return;
+    }
+    if (s.getTime() < _nextCheckpointTime) return;
+    _nextCheckpointTime = s.getTime() + _checkpointInterval;
+
+    // Only the copying happens here; the integration waits for the previous
+    // checkpoint only if it is still being written.
+    finishRecording();
+    const bool keepsStorage = _statesFileName.empty() && hasStateStorage();
+    const std::uint64_t numRecorded = keepsStorage ? getStateStorage().getSize()
+            : (_statesFileWriter ? _statesFileWriter->getNumRows() : 0);
+    auto c = std::make_shared<Checkpoint>(makeCheckpoint(*_model, s, *_integ,
+            keepsStorage ? &getStateStorage() : nullptr, numRecorded));
+    if (_checkpointThread.joinable()) _checkpointThread.join();
+    const std::string fileName = _checkpointFileName;
+    _checkpointThread = std::thread([c, fileName] {
+        try {
+            writeCheckpoint(*c, fileName);
+        } catch (const std::exception& e) {
+            cout << "Manager: WARN- checkpoint at time " << c->time
+                 << " was not written: " << e.what() << endl;
+        }
+    });
+}
+
 //=============================================================================
 // INTERRUPT
 //=============================================================================
@@ -31,9 +31,13 @@
 // INCLUDES
 #include <OpenSim/Common/Array.h>
 #include "OpenSim/Common/TimeSeriesTable.h"
+#include "OpenSim/Common/STOFileWriter.h"
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <SimTKcommon/internal/ReferencePtr.h>
 
+#include <atomic>
+#include <thread>
+
 namespace SimTK {
 class Integrator;
 class State;
@@ -44,6 +48,7 @@ class TimeStepper;
 namespace OpenSim { 
 
 class Model;
+class RunControl;
 class Storage;
 class ControllerSet;
 
@@ -94,8 +99,62 @@ private:
     /** Storage for the states. */
     std::unique_ptr<Storage> _stateStore;
 
-    /** Flag for signaling a desired halt. */
-    bool _halt;
+    /** File to which the states are written instead, if any; see
+    setStatesFile(). */
+    std::string _statesFileName;
+    int _statesFileChunkSize;
+    bool _statesFileInBackground;
+    std::unique_ptr<STOFileWriter> _statesFileWriter;
+
+    /** Whether states are recorded, and analyses stepped, by a background
+    thread; see setRecordInBackground(). */
+    bool _recordInBackground;
+    int _recordBufferSize;
+    class BackgroundRecorder;
+    std::unique_ptr<BackgroundRecorder> _backgroundRecorder;
+
+    /** Periodic checkpoints; see setCheckpointInterval(). The checkpoint
+    being written, if any, is written by _checkpointThread. */
+    std::string _checkpointFileName;
+    double _checkpointInterval;
+    double _nextCheckpointTime;
+    std::thread _checkpointThread;
+
+    /** Time between the States recorded by integrate(), which are then
+    interpolated rather than taken at each step; see setReportInterval(). */
+    double _reportInterval;
+
+    /** Multirate integration; see setMultirateMacroStep(). Each slow state
+    variable is held by the component that added it, under its name. */
+    double _macroStep;
+    std::vector<std::pair<SimTK::ReferencePtr<const Component>, std::string>>
+        _slowStateVariables;
+
+    /** Automatic selection of the integrator; see setAutoSelectIntegrator().
+    */
+    double _integratorProbeDuration;
+    std::string _integratorSelectionReport;
+
+    /** Settings and statistics of stepRealTime(). The latencies of the
+    latest steps are kept in a ring buffer. */
+    struct RealTimeLoop {
+        double deadline = SimTK::Infinity;
+        int policy = 0; // An OverrunPolicy.
+        std::vector<double> latencies;
+        long long numSteps = 0;
+        long long numDeadlineMisses = 0;
+        double maxLatency = 0;
+        bool started = false;
+        bool skipAnalyses = false;
+        double nominalAccuracy = SimTK::NaN;
+    };
+    RealTimeLoop _realTime;
+
+    /** Flag for signaling a desired halt; set by halt(), possibly from
+    another thread. */
+    std::atomic<bool> _halt;
+    /** Follows the progress of integrate(); see setRunControl(). */
+    SimTK::ReferencePtr<RunControl> _runControl;
 
     /** Flag to indicate whether or not specified integration time steps
     should be used.  The specified integration time steps are held in _tVec.
@@ -155,6 +214,8 @@ public:
     Manager(const Manager&) = delete;
     void operator=(const Manager&) = delete;
 
+    ~Manager();
+
 private:
     void setNull();
     bool constructStorage();
@@ -285,13 +346,244 @@ public:
     Storage& getStateStorage() const;
     TimeSeriesTable getStatesTable() const;
 
+    /** Write the states to an STO file as the integration proceeds, instead
+    of appending them to the state Storage (which then stays empty); use this
+    to keep memory use flat in long simulations. The states are written in
+    chunks of chunkSize rows (see STOFileWriter_), by a background thread if
+    flushInBackground is true. All states recorded so far are written at the
+    end of each call to integrate(), and the file is closed when this Manager
+    is destroyed. Pass an empty fileName to store the states in the Storage
+    again. */
+    void setStatesFile(const std::string& fileName, int chunkSize = 1000,
+                       bool flushInBackground = false);
+
+    /** Record the states, and step the model's Analyses, on a background
+    thread, so that integrate() is limited only by the dynamics. Each time a
+    State would be recorded, integrate() copies it into a ring buffer of
+    bufferSize States (waiting if the buffer is full), and the background
+    thread records the copies in order. integrate() returns once all of its
+    States have been recorded, so the state Storage (or states file), the
+    stored controls and the Analyses are complete as before; an exception
+    thrown while recording is rethrown by integrate().
+
+    In this mode, each Analysis receives a copy of the integrator's State,
+    realized to the stage the integrator left it at (at least
+    Stage::Velocity). The Analysis may realize its copy further (e.g., to
+    Stage::Acceleration), but it must not modify the Model or its
+    components, nor read data that the integration keeps outside of the
+    State (e.g., the integrator, or members of a Controller), since the
+    integration proceeds concurrently. Analyses that do not follow this
+    contract must be recorded in the foreground (the default). */
+    void setRecordInBackground(bool recordInBackground, int bufferSize = 64);
+    bool getRecordInBackground() const { return _recordInBackground; }
+
+    /** Record the states, step the Analyses and realize the model's
+    Reporters to Stage::Report at the multiples of interval (and at the end
+    of each integration) only, instead of after every step of the
+    integrator. The integrator still chooses its own step sizes; the States
+    at the report times are interpolated from its dense output (see
+    SimTK::Integrator::setAllowInterpolation()), so uniformly sampled
+    results cost no extra evaluations of the dynamics. Reporters whose
+    report_time_interval is 0 (e.g., TableReporter_ and
+    StatesTrajectoryReporter) then record the same uniform samples. Pass a
+    non-positive interval (the default) to record every step again. This
+    has no effect with constant or specified time steps (see
+    setUseConstantDT() and setUseSpecifiedDT()), which already determine
+    the recorded times.
+
+    Interpolated States are as accurate as the integrator's error control,
+    but an event that changes the State discontinuously is seen only at the
+    first report time after it. */
+    void setReportInterval(double interval);
+    double getReportInterval() const { return _reportInterval; }
+
+   //--------------------------------------------------------------------------
+   //  MULTIRATE INTEGRATION
+   //--------------------------------------------------------------------------
+    /** Advance the slow state variables (see addSlowStateVariable()), e.g.,
+    muscle activations and controller states, with macro steps of the given
+    size, while the integrator sub-steps the other (fast) states, e.g., of
+    contact and tendon dynamics, as its error control requires. Pass a
+    non-positive step (the default) to integrate all states together again.
+
+    At the start of each macro step (multiples of the step, in time), the
+    derivatives of the slow state variables are computed, and then held
+    (see Component::holdStateVariableDerivative()) until the next macro
+    step: each slow state variable advances linearly (an explicit Euler
+    step), so the fast states see it interpolated across the macro step.
+    The slow state variables then neither limit the integrator's steps nor,
+    for a component all of whose state variables are slow, cost a
+    computation of their derivatives at each evaluation of the dynamics.
+    The integrator's steps end at each macro step (rather than being
+    interpolated; see setReportInterval()), where it is restarted.
+
+    The macro step must be small next to the time constants of the slow
+    state variables (e.g., a few milliseconds for muscle activation
+    dynamics), since the Euler step is only first-order accurate. */
+    void setMultirateMacroStep(double macroStep);
+    double getMultirateMacroStep() const { return _macroStep; }
+    /** Advance a state variable, given by its path (e.g.,
+    "/forceset/soleus_r/activation"), with the macro step. It must be a
+    state variable added by a component (not a Coordinate's value or
+    speed). */
+    void addSlowStateVariable(const std::string& path);
+    /** Advance all of the state variables that a component adds (but not
+    those of its subcomponents) with the macro step. */
+    void addSlowComponent(const Component& component);
+    void clearSlowStateVariables() { _slowStateVariables.clear(); }
+
+   //--------------------------------------------------------------------------
+   //  INTEGRATOR SELECTION
+   //--------------------------------------------------------------------------
+    /** Choose the integrator automatically when the Manager is initialized,
+    by integrating the first probeDuration seconds of the simulation with
+    each candidate and keeping the one that evaluated the dynamics (realized
+    the model) the fewest times. The candidates are the Manager's own
+    Runge-Kutta-Merson integrator (explicit), a
+    SimTK::SemiExplicitEuler2Integrator and a SimTK::CPodesIntegrator (BDF
+    with Newton iterations, for stiff dynamics, e.g., stiff contact or
+    tendons); the others use the accuracy and constraint tolerance of the
+    first. A candidate that fails to reach the end of the probe is not
+    chosen. Pass a non-positive duration (the default) to keep the
+    Runge-Kutta-Merson integrator.
+
+    Only the Manager's own integrator can be replaced, so this requires the
+    model-only constructor (and no call to setIntegrator()). The probes
+    integrate copies of the initial State, but they do realize the model's
+    components, so components that keep data outside of the State (e.g.,
+    some Controllers) see the probes' evaluations too. The probe of an
+    explicit integrator also detects stiffness: a large fraction of
+    rejected steps (see getIntegratorSelectionReport()) means that its step
+    size is limited by stability rather than accuracy.
+    @see getIntegrator() for the chosen integrator and its statistics. */
+    void setAutoSelectIntegrator(double probeDuration);
+    double getAutoSelectIntegrator() const
+    {   return _integratorProbeDuration; }
+    /** The statistics of each candidate's probe (steps taken and rejected,
+    and evaluations of the dynamics) and the choice, after initialize();
+    empty if the integrator was not selected automatically. */
+    const std::string& getIntegratorSelectionReport() const
+    {   return _integratorSelectionReport; }
+
+   //--------------------------------------------------------------------------
+   //  CHECKPOINTS
+   //--------------------------------------------------------------------------
+    /** Write a checkpoint of the integration to a binary file, from which a
+    new Manager can continue with restoreFromCheckpoint(), e.g., after the
+    process running a long simulation has died. The checkpoint holds the
+    current State's time, continuous state variables (Y) and the discrete
+    variables and modeling options of the model's components, the step size
+    the integrator predicted for its next step, and the states recorded so
+    far: the rows of the state Storage or, if setStatesFile() is used, only
+    their number (the file itself is flushed). The file is replaced
+    atomically, so a crash while writing leaves the previous checkpoint.
+    @throws Exception if this Manager has not been initialized. */
+    void checkpoint(const std::string& fileName);
+
+    /** Initialize this Manager from a checkpoint written by checkpoint() or
+    setCheckpointInterval() for the same model; call this instead of
+    initialize(). The State to integrate from is a copy of the model's
+    working State (see Model::initSystem()) with the values from the
+    checkpoint; discrete variables that Simbody allocates itself (e.g., the
+    locks of Coordinates and the enabled flags of Forces) keep their values
+    in the working State. The states stored in the checkpoint are put back
+    into the state Storage, so integrate() continues to record after them.
+    @throws Exception if the file is not a checkpoint of this model. */
+    void restoreFromCheckpoint(const std::string& fileName);
+
+    /** Write a checkpoint (see checkpoint()) to fileName during integrate()
+    each time the simulated time has advanced by interval since the last
+    one. The values are copied when the checkpoint is due, and written by a
+    background thread while the integration proceeds. Pass a non-positive
+    interval to stop writing checkpoints. */
+    void setCheckpointInterval(double interval, const std::string& fileName);
+
+   //--------------------------------------------------------------------------
+   //  REAL-TIME STEPPING
+   //--------------------------------------------------------------------------
+    /** What stepRealTime() does after a step that missed its deadline. */
+    enum class OverrunPolicy {
+        /** Nothing; the misses are only counted. */
+        Continue,
+        /** Do not step the Analyses in the next step. */
+        SkipAnalyses,
+        /** Halve the integrator's accuracy (i.e., double its tolerance, up
+        to 0.1) for the next steps; the accuracy is restored, one factor of
+        two per step, after steps that take less than half the deadline. */
+        ReduceAccuracy
+    };
+
+    /** Wall-clock latency of the calls to stepRealTime(), in seconds. */
+    struct RealTimeStatistics {
+        /** Number of steps taken since the statistics were reset. */
+        long long numSteps = 0;
+        /** Number of those steps that took longer than the deadline. */
+        long long numDeadlineMisses = 0;
+        /** Median and 99th percentile of the latency of the most recent
+        steps (see setRealTimeDeadline()). */
+        double medianLatency = 0;
+        double p99Latency = 0;
+        /** Longest latency of any step. */
+        double maxLatency = 0;
+    };
+
+    /** %Set the wall-clock time within which each call to stepRealTime()
+    should return, e.g., 0.002 s to keep up with a 500 Hz controller, and
+    what to do when a step takes longer. The latencies of the latest
+    latencyWindow steps are kept, in a buffer allocated here, for the
+    percentiles of getRealTimeStatistics(). This also resets the
+    statistics. */
+    void setRealTimeDeadline(double deadline,
+                             OverrunPolicy policy = OverrunPolicy::Continue,
+                             int latencyWindow = 10000);
+
+    /** Advance the integration by stepSize (in simulated time) for a
+    hardware-in-the-loop or streaming loop, and return the integrator's
+    State, which is updated in place. Unlike integrate(), this neither
+    records the states nor writes any files, and it does not allocate
+    memory once the first step has been taken; the integrator takes as many
+    internal steps as it needs to reach the new time. The Analyses are
+    stepped (see setPerformAnalyses()) unless the OverrunPolicy skips them;
+    note that many Analyses allocate when they record. The wall-clock time
+    of each call is measured against the deadline set with
+    setRealTimeDeadline(), if any. Inputs (e.g., the controls set by a
+    Controller from sensor data) may be updated between calls, as long as
+    they are not part of the State. You must call initialize() first.
+
+    @code
+    Manager manager(model, integrator);
+    manager.initialize(state);
+    manager.setRealTimeDeadline(0.002,
+                                Manager::OverrunPolicy::SkipAnalyses);
+    while (streaming) {
+        readSensors();
+        const SimTK::State& s = manager.stepRealTime(0.002);
+        sendCommands(s);
+    }
+    std::cout << manager.getRealTimeStatistics().p99Latency << std::endl;
+    @endcode */
+    const SimTK::State& stepRealTime(double stepSize);
+
+    /** Latency statistics of the steps taken with stepRealTime(). */
+    RealTimeStatistics getRealTimeStatistics() const;
+    /** Forget the latencies and deadline misses recorded so far. */
+    void resetRealTimeStatistics();
+
    //--------------------------------------------------------------------------
    //  INTERRUPT
    //--------------------------------------------------------------------------
+   /** Stop integrate() at the end of its current step; it returns the State
+   reached. May be called from another thread than the one integrating. */
    void halt();
    void clearHalt();
    bool checkHalt();
 
+   /** Report the progress of integrate() (the fraction of its time interval
+   integrated) to the given RunControl after each step, and halt() once the
+   RunControl is cancelled. The RunControl must outlive the integrations;
+   pass nullptr to stop reporting. */
+   void setRunControl(RunControl* control) { _runControl.reset(control); }
+
 private:
 
     // Handles common tasks of some of the other constructors.
@@ -303,7 +595,22 @@ private:
 
     // Helper to record state and analysis values at integration steps.
     // step = 0 is the beginning, step = -1 used to denote the end/final step
+    // The State is recorded by recordNow(), here or on the background thread.
     void record(const SimTK::State& s, const int& step);
+    void recordNow(const SimTK::State& s, const int& step);
+    // Wait until the background thread, if any, has recorded all States.
+    void finishRecording();
+
+    // Write a periodic checkpoint if one is due at the time of the State.
+    void checkpointIfDue(const SimTK::State& s);
+
+    // Compute and hold the derivatives of the slow state variables at the
+    // integrator's current State; see setMultirateMacroStep().
+    void holdSlowDerivatives();
+
+    // Probe the candidate integrators from the initial State and replace
+    // the default integrator with the cheapest; see setAutoSelectIntegrator().
+    void selectIntegrator(const SimTK::State& s);
 
 //=============================================================================
 };  // END of class Manager
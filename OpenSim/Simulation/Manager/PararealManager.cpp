@@ -0,0 +1,197 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  PararealManager.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PararealManager.h"
+#include "Manager.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include "simmath/RungeKuttaMersonIntegrator.h"
+#include "simmath/TimeStepper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
+using namespace std;
+using namespace OpenSim;
+
+PararealManager::PararealManager(const Model& model) : _model(&model) {}
+
+void PararealManager::setNumWindows(int numWindows)
+{
+    OPENSIM_THROW_IF(numWindows < 1, Exception,
+                     "Expected at least one window, but got " +
+                     std::to_string(numWindows) + ".");
+    _numWindows = numWindows;
+}
+
+void PararealManager::integrate(const SimTK::State& initialState,
+                                double finalTime)
+{
+    const double initialTime = initialState.getTime();
+    OPENSIM_THROW_IF(!(finalTime > initialTime), Exception,
+                     "Expected a final time after the initial time " +
+                     std::to_string(initialTime) + ", but got " +
+                     std::to_string(finalTime) + ".");
+    const int numWindows = _numWindows;
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, numWindows));
+
+    // Each thread integrates on its own copy of the model. The copies are
+    // initialized here, rather than on the threads, so that building the
+    // Systems does not need to be thread-safe.
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    std::vector<SimTK::State> defaultStates(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        models[t].reset(_model->clone());
+        models[t]->setUseVisualizer(false);
+        defaultStates[t] = models[t]->initSystem();
+    }
+    OPENSIM_THROW_IF(initialState.getNY() != defaultStates[0].getNY(),
+                     Exception,
+                     "Expected a State with " +
+                     std::to_string(defaultStates[0].getNY()) +
+                     " continuous state variables, but got " +
+                     std::to_string(initialState.getNY()) + ".");
+
+    std::vector<double> times(numWindows + 1);
+    for (int n = 0; n < numWindows; ++n)
+        times[n] = initialTime + (finalTime - initialTime)*n/numWindows;
+    times[numWindows] = finalTime;
+
+    // The coarse integrations, and the projections of the corrected states
+    // onto the constraints, are sequential and use the first model copy.
+    const SimTK::MultibodySystem& system = models[0]->getMultibodySystem();
+    auto coarse = [&](const SimTK::Vector& y, int n) {
+        SimTK::State s = defaultStates[0];
+        s.updY() = y;
+        s.setTime(times[n]);
+        SimTK::RungeKuttaMersonIntegrator integrator(system);
+        integrator.setAccuracy(_coarseAccuracy);
+        SimTK::TimeStepper timeStepper(system, integrator);
+        timeStepper.initialize(s);
+        timeStepper.stepTo(times[n + 1]);
+        return SimTK::Vector(timeStepper.getState().getY());
+    };
+    auto project = [&](const SimTK::Vector& y, int n) {
+        SimTK::State s = defaultStates[0];
+        s.updY() = y;
+        s.setTime(times[n]);
+        system.realize(s, SimTK::Stage::Position);
+        system.projectQ(s, 1e-10);
+        system.realize(s, SimTK::Stage::Velocity);
+        system.projectU(s, 1e-10);
+        return SimTK::Vector(s.getY());
+    };
+
+    // U[n] is the predicted state at the start of window n (and U[N] that
+    // at the final time), G[n] the coarse integration of window n from
+    // U[n], and F[n] its fine integration.
+    std::vector<SimTK::Vector> U(numWindows + 1), G(numWindows),
+                               F(numWindows);
+    U[0] = initialState.getY();
+    for (int n = 0; n < numWindows; ++n) {
+        G[n] = coarse(U[n], n);
+        U[n + 1] = project(G[n], n + 1);
+    }
+
+    std::vector<std::unique_ptr<Storage>> windowStores(numWindows);
+    std::vector<std::exception_ptr> errors(numWindows);
+    // U[0] through U[exact] are as accurate as a serial fine integration.
+    int exact = 0;
+    _numIterations = 0;
+    _converged = false;
+    while (true) {
+        // Windows are handed out one at a time, so that a thread that
+        // finishes its window early takes the next one instead of idling.
+        std::atomic<int> nextWindow(exact);
+        auto integrateWindows = [&](int t) {
+            Model& model = *models[t];
+            for (int n = nextWindow++; n < numWindows; n = nextWindow++) {
+                try {
+                    SimTK::State s = defaultStates[t];
+                    s.updY() = U[n];
+                    s.setTime(times[n]);
+                    SimTK::RungeKuttaMersonIntegrator integrator(
+                            model.getMultibodySystem());
+                    integrator.setAccuracy(_fineAccuracy);
+                    Manager manager(model, integrator);
+                    manager.setPerformAnalyses(false);
+                    manager.initialize(s);
+                    F[n] = manager.integrate(times[n + 1]).getY();
+                    windowStores[n].reset(
+                            new Storage(manager.getStateStorage()));
+                }
+                catch (...) {
+                    errors[n] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int t = 1; t < numThreads; ++t) {
+            try {
+                threads.emplace_back(integrateWindows, t);
+            } catch (const std::system_error&) {
+                // Could not start a thread; the remaining threads take its
+                // windows.
+                break;
+            }
+        }
+        integrateWindows(0);
+        for (auto& thread : threads) thread.join();
+        for (int n = exact; n < numWindows; ++n)
+            if (errors[n]) std::rethrow_exception(errors[n]);
+        ++_numIterations;
+
+        // Correct the predictions in order, since each correction needs the
+        // coarse integration from the corrected state before it. Window
+        // `exact` started from an exact state, which has not changed since
+        // its coarse integration, so its fine integration is exact.
+        double maxChange = 0;
+        for (int n = exact; n < numWindows; ++n) {
+            SimTK::Vector coarseEnd = n == exact ? G[n] : coarse(U[n], n);
+            SimTK::Vector corrected =
+                    project(coarseEnd + F[n] - G[n], n + 1);
+            maxChange = std::max(maxChange, (corrected - U[n + 1]).normInf());
+            G[n] = coarseEnd;
+            U[n + 1] = corrected;
+        }
+        ++exact;
+
+        if (maxChange <= _tolerance || exact == numWindows) {
+            _converged = true;
+            break;
+        }
+        if (_maxIterations > 0 && _numIterations >= _maxIterations) break;
+    }
+
+    // Join the windows' states; the first State of a window is the last of
+    // the window before it (within the tolerance), and is dropped.
+    _stateStore = *windowStores[0];
+    for (int n = 1; n < numWindows; ++n) {
+        const Storage& window = *windowStores[n];
+        for (int i = 1; i < window.getSize(); ++i)
+            _stateStore.append(*window.getStateVector(i), false);
+    }
+}
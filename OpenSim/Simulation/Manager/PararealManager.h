@@ -0,0 +1,170 @@
+#ifndef OPENSIM_PARAREAL_MANAGER_H_
+#define OPENSIM_PARAREAL_MANAGER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  PararealManager.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon/internal/ReferencePtr.h>
+
+namespace SimTK {
+class State;
+}
+
+namespace OpenSim {
+
+class Model;
+
+//=============================================================================
+//=============================================================================
+/**
+ * (Experimental) Integrate one long simulation with several threads, by
+ * splitting its time interval into windows that are integrated concurrently
+ * (the parareal algorithm).
+ *
+ * Time stepping is sequential: a window can be integrated accurately only
+ * once the state at its start is known. Parareal predicts the states at the
+ * start of every window with a cheap, inaccurate "coarse" integration over
+ * the whole interval, integrates every window accurately (the "fine"
+ * integrations) from the predicted states, all at once, and then corrects
+ * the predictions:
+ *
+ *     U[n+1] = G(U[n]) + F(U_old[n]) - G(U_old[n])
+ *
+ * where F and G are the fine and coarse integrations over window n, and
+ * U_old are the previous predictions. The fine integrations and the
+ * corrections are repeated until no prediction changes by more than the
+ * tolerance. After k iterations, the first k windows are exact (as accurate
+ * as a serial fine integration), so that the method never takes more than
+ * one iteration per window; it pays off only if it converges in far fewer
+ * iterations than there are windows, i.e., if the coarse integration is
+ * good enough, and the simulation is long enough (e.g., minutes of
+ * simulated time), for the fine integrations on many cores to amortize the
+ * repeated work.
+ *
+ * The coarse integration uses the same model as the fine integrations, with
+ * a much looser integrator accuracy (and therefore larger steps). Each
+ * thread owns a copy of the model, initialized once, as for
+ * EnsembleManager.
+ *
+ * @code
+ * PararealManager parareal(model);
+ * parareal.setNumWindows(64);
+ * parareal.setFineAccuracy(1e-6);
+ * parareal.integrate(state, 300.0);
+ * parareal.getStateStorage().print("states.sto");
+ * @endcode
+ *
+ * Limitations:
+ *  - Only the continuous state variables (q, u and z) are passed from one
+ *    window to the next. Discrete state variables (e.g., the controls held
+ *    by a Controller with an update rate) start every window from their
+ *    default values, and events that change them are only handled within a
+ *    window.
+ *  - Analyses are not run; the states recorded by the fine integrations are
+ *    available from getStateStorage() and can be analyzed afterwards (e.g.,
+ *    with AnalyzeTool).
+ */
+class OSIMSIMULATION_API PararealManager
+{
+public:
+    /** The model is copied once per thread when integrate() is called; it
+    is not modified and need not be initialized, but must outlive this
+    PararealManager. */
+    explicit PararealManager(const Model& model);
+
+    PararealManager(const PararealManager&) = delete;
+    void operator=(const PararealManager&) = delete;
+
+    /** Number of windows of equal duration into which the time interval is
+    split (default: 16). Use at least as many windows as threads. */
+    void setNumWindows(int numWindows);
+    int getNumWindows() const { return _numWindows; }
+
+    /** Number of threads (and model copies) used for the fine
+    integrations; if not positive (the default), the number of hardware
+    threads is used. No more threads than windows are used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Accuracy of the SimTK::RungeKuttaMersonIntegrator used for the fine
+    integrations (default: 1e-5). */
+    void setFineAccuracy(double accuracy) { _fineAccuracy = accuracy; }
+    double getFineAccuracy() const { return _fineAccuracy; }
+
+    /** Accuracy of the SimTK::RungeKuttaMersonIntegrator used for the
+    coarse integrations (default: 1e-2). */
+    void setCoarseAccuracy(double accuracy) { _coarseAccuracy = accuracy; }
+    double getCoarseAccuracy() const { return _coarseAccuracy; }
+
+    /** The iterations stop once no continuous state variable at the start
+    of a window changes by more than this tolerance (default: 1e-6). */
+    void setTolerance(double tolerance) { _tolerance = tolerance; }
+    double getTolerance() const { return _tolerance; }
+
+    /** The iterations stop after this many fine integrations of the
+    windows, even if they have not converged (default: 0, for no limit
+    other than the number of windows). */
+    void setMaxIterations(int maxIterations)
+    {   _maxIterations = maxIterations; }
+    int getMaxIterations() const { return _maxIterations; }
+
+    /** Integrate from the time and continuous state variables of the given
+    State, which must be a State of the model, to finalTime. The last
+    window ends at finalTime exactly.
+    @throws Exception If finalTime is not after the initial time, or if the
+    State does not belong to the model. */
+    void integrate(const SimTK::State& initialState, double finalTime);
+
+    /** The number of fine integrations of the windows done by the last call
+    to integrate(). */
+    int getNumIterations() const { return _numIterations; }
+    /** Whether the last call to integrate() converged within the
+    tolerance, rather than stopping at the maximum number of iterations. */
+    bool getConverged() const { return _converged; }
+
+    /** The states recorded by the fine integrations of the windows in the
+    last iteration of the last call to integrate(), from the initial to the
+    final time. */
+    const Storage& getStateStorage() const { return _stateStore; }
+    TimeSeriesTable getStatesTable() const
+    {   return _stateStore.exportToTable(); }
+
+private:
+    SimTK::ReferencePtr<const Model> _model;
+    int _numWindows = 16;
+    int _numThreads = -1;
+    double _fineAccuracy = 1e-5;
+    double _coarseAccuracy = 1e-2;
+    double _tolerance = 1e-6;
+    int _maxIterations = 0;
+
+    int _numIterations = 0;
+    bool _converged = false;
+    Storage _stateStore;
+
+};  // END of class PararealManager
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_PARAREAL_MANAGER_H_
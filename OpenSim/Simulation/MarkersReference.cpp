@@ -53,6 +53,17 @@ MarkersReference(const TimeSeriesTable_<SimTK::Vec3>& markerTable,
     populateFromMarkerData(markerTable, units.getAbbreviation());
 }
 
+MarkersReference::
+MarkersReference(const TimeSeriesTableView_<SimTK::Vec3>& markerData,
+                 const Set<MarkerWeight>* markerWeightSet,
+                 Units units) :
+    MarkersReference() {
+    _markerTable = markerData.toTable();
+    if(markerWeightSet != nullptr)
+        upd_marker_weights() = *markerWeightSet;
+    populateFromMarkerData(_markerTable, units.getAbbreviation());
+}
+
 void MarkersReference::loadMarkersFile(const std::string markerFile,
                                        Units modelUnits) {
     auto fileExt = FileAdapter::findExtension(markerFile);
@@ -137,11 +148,14 @@ const SimTK::Array_<std::string>& MarkersReference::getNames() const {
 
 void MarkersReference::getValues(const SimTK::State& s,
                                   SimTK::Array_<Vec3>& values) const {
-    double time = s.getTime();
-    const auto rowView = _markerTable.getNearestRow(time);
-    values.clear();
-    for(int i = 0; i < rowView.ncol(); ++i)
-        values.push_back(rowView[i]);
+    // The row index is found in constant time for uniformly sampled data.
+    // The elements are read from the table's matrix directly, since a row
+    // view, like a cleared and refilled Array, would be allocated per call.
+    const int row = int(_markerTable.getNearestRowIndexForTime(s.getTime()));
+    const auto& matrix = _markerTable.getMatrix();
+    values.resize(unsigned(matrix.ncol()));
+    for(int i = 0; i < matrix.ncol(); ++i)
+        values[i] = matrix.getElt(row, i);
 }
 
 // void
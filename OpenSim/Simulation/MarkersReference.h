@@ -118,6 +118,15 @@ public:
                      const Set<MarkerWeight>* markerWeightSet = nullptr,
                      Units units = Units(Units::Meters));
 
+#ifndef SWIG
+    /** Form a Reference from a view of a TimeSeriesTable (e.g., a time range
+    of a trial, or a subset of its markers), as from a table. Only the data
+    in the view are copied.                                                   */
+    MarkersReference(const TimeSeriesTableView_<SimTK::Vec3>& markerData,
+                     const Set<MarkerWeight>* markerWeightSet = nullptr,
+                     Units units = Units(Units::Meters));
+#endif
+
     virtual ~MarkersReference() {}
 
     /** load the marker data for this MarkersReference from markerFile  */
@@ -395,7 +395,7 @@ loadModel(const string &aToolSetupFileName, ForceSet *rOriginalForceSet )
     Model *model = 0;
 
     try {
-        model = new Model(_modelFile);
+        model = Model::createFromFile(_modelFile);
         model->finalizeFromProperties();
         if (rOriginalForceSet!=NULL)
             *rOriginalForceSet = model->getForceSet();
@@ -87,6 +87,9 @@ void ActivationFiberLengthMuscle::constructProperties()
     // also wipe out the muscle path, which we do not want to 
     // reevaluate over and over.
     addStateVariable(STATE_FIBER_LENGTH_NAME);//, SimTK::Stage::Velocity);
+
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
  }
 
  void ActivationFiberLengthMuscle::extendInitStateFromProperties( SimTK::State& s) const
@@ -139,8 +142,8 @@ void ActivationFiberLengthMuscle::
         ldot = getFiberVelocity(s);
     }
 
-    setStateVariableDerivativeValue(s, STATE_ACTIVATION_NAME, adot);
-    setStateVariableDerivativeValue(s, STATE_FIBER_LENGTH_NAME, ldot);
+    setStateVariableDerivativeValue(s, _activationSV, adot);
+    setStateVariableDerivativeValue(s, _fiberLengthSV, ldot);
 }
 //==============================================================================
 // GET
@@ -161,9 +164,9 @@ void ActivationFiberLengthMuscle::setFiberLength(SimTK::State& s, double fiberLe
     // fiber length as a Dynamics stage dependent state variable.
     // In order to force the recalculation of the length cache we have to 
     // invalidate the length info whenever fiber length is set.
-    markCacheVariableInvalid(s,"lengthInfo");
-    markCacheVariableInvalid(s,"velInfo");
-    markCacheVariableInvalid(s,"dynamicsInfo");
+    markCacheVariableInvalid(s, _lengthInfoCV);
+    markCacheVariableInvalid(s, _velInfoCV);
+    markCacheVariableInvalid(s, _dynamicsInfoCV);
 }
 
 double ActivationFiberLengthMuscle::getActivationRate(const SimTK::State& s) const
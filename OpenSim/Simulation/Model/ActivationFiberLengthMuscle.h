@@ -134,6 +134,9 @@ protected:
 private:
     void constructProperties();
 
+    mutable StateVariableHandle _activationSV;
+    mutable StateVariableHandle _fiberLengthSV;
+
 //==============================================================================
 };  // END of class ActivationFiberLengthMuscle
 //==============================================================================
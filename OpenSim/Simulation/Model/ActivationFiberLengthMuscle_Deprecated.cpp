@@ -96,6 +96,8 @@ void ActivationFiberLengthMuscle_Deprecated::constructProperties()
 
     addStateVariable(STATE_ACTIVATION_NAME);
     addStateVariable(STATE_FIBER_LENGTH_NAME);
+    _activationSV = getStateVariableHandle(STATE_ACTIVATION_NAME);
+    _fiberLengthSV = getStateVariableHandle(STATE_FIBER_LENGTH_NAME);
 
     // Cache the computed active and passive muscle force
     // note the total muscle force is the tendon force and is already a cached variable of the actuator
@@ -176,8 +178,8 @@ void ActivationFiberLengthMuscle_Deprecated::
         ldot = getFiberVelocity(s);
     }
 
-    setStateVariableDerivativeValue(s, STATE_ACTIVATION_NAME, adot);
-    setStateVariableDerivativeValue(s, STATE_FIBER_LENGTH_NAME, ldot);
+    setStateVariableDerivativeValue(s, _activationSV, adot);
+    setStateVariableDerivativeValue(s, _fiberLengthSV, ldot);
 }
 
 //==============================================================================
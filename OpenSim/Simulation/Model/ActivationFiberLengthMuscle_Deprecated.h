@@ -181,6 +181,9 @@ protected:
 private:
     void setNull();
     void constructProperties();
+
+    mutable StateVariableHandle _activationSV;
+    mutable StateVariableHandle _fiberLengthSV;
 //==============================================================================
 };  // END of class ActivationFiberLengthMuscle_Deprecated
 //==============================================================================
@@ -33,6 +33,12 @@ using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
 
+namespace {
+    // Name of the modeling option and discrete variable of ScalarActuator,
+    // constructed once rather than for every lookup.
+    const std::string overrideActuationName("override_actuation");
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -92,13 +98,17 @@ const VectorView_<Real> Actuator::getControls( const SimTK::State& s ) const
     return  controlsCache(_controlIndex, numControls());
 }
 
+// The methods below index the controls directly, rather than through a
+// VectorView, which would be allocated on the heap for every call.
+
 void Actuator::getControls(const Vector& modelControls, Vector& actuatorControls) const
 {
     SimTK_ASSERT(modelControls.size() == _model->getNumControls(), 
         "Actuator::getControls, input modelControls size does not match model.getNumControls().\n");
     SimTK_ASSERT(actuatorControls.size() == numControls(), 
         "Actuator::getControls, output actuatorControls incompatible with actuator's numControls().\n");
-    actuatorControls = modelControls(_controlIndex, numControls());
+    for (int i = 0; i < numControls(); ++i)
+        actuatorControls[i] = modelControls[_controlIndex + i];
 }
 
 void Actuator::setControls(const Vector& actuatorControls, Vector& modelControls) const
@@ -109,7 +119,8 @@ void Actuator::setControls(const Vector& actuatorControls, Vector& modelControls
     SimTK_ASSERT(modelControls.size() == _model->getNumControls(), 
     "Actuator::setControls, output modelControls size does not match model.getNumControls()\n");
 
-    modelControls(_controlIndex, numControls()) = actuatorControls;
+    for (int i = 0; i < numControls(); ++i)
+        modelControls[_controlIndex + i] = actuatorControls[i];
 }
 
 void Actuator::addInControls(const Vector& actuatorControls, Vector& modelControls) const
@@ -120,7 +131,8 @@ void Actuator::addInControls(const Vector& actuatorControls, Vector& modelContro
     SimTK_ASSERT(modelControls.size() == _model->getNumControls(), 
     "Actuator::addInControls, output modelControls size does not match model.getNumControls().\n");
 
-    modelControls(_controlIndex, numControls()) += actuatorControls;
+    for (int i = 0; i < numControls(); ++i)
+        modelControls[_controlIndex + i] += actuatorControls[i];
 }
 
 
@@ -174,19 +186,19 @@ void ScalarActuator::extendAddToSystem(SimTK::MultibodySystem& system) const
     Super::extendAddToSystem(system);
     // Add modeling flag to compute actuation with dynamic or by-pass with 
     // override actuation provided
-    addModelingOption("override_actuation", 1);
+    addModelingOption(overrideActuationName, 1);
 
     // Cache the computed actuation and speed of the scalar valued actuator
-    addCacheVariable<double>("actuation", 0.0, Stage::Velocity);
-    addCacheVariable<double>("speed", 0.0, Stage::Velocity);
+    _actuationCV = addCacheVariable<double>("actuation", 0.0, Stage::Velocity);
+    _speedCV = addCacheVariable<double>("speed", 0.0, Stage::Velocity);
 
     // Discrete state variable is the override actuation value if in override mode
-    addDiscreteVariable("override_actuation", Stage::Time);
+    addDiscreteVariable(overrideActuationName, Stage::Time);
 }
 
 double ScalarActuator::getControl(const SimTK::State& s) const
 {
-    return getControls(s)[0];
+    return _model->getControls(s)[_controlIndex];
 }
 
 double ScalarActuator::getStress(const SimTK::State& s) const
@@ -202,44 +214,44 @@ double ScalarActuator::getOptimalForce() const
 double ScalarActuator::getActuation(const State &s) const
 {
     if (appliesForce(s))
-        return getCacheVariableValue<double>(s, "actuation");
+        return getCacheVariableValue(s, _actuationCV);
     else
         return 0.0;
 }
 
 void ScalarActuator::setActuation(const State& s, double aActuation) const
 {
-    setCacheVariableValue<double>(s, "actuation", aActuation);
+    setCacheVariableValue(s, _actuationCV, aActuation);
 }
 
 double ScalarActuator::getSpeed(const State& s) const
 {
-    return getCacheVariableValue<double>(s, "speed");
+    return getCacheVariableValue(s, _speedCV);
 }
 
 void ScalarActuator::setSpeed(const State &s, double speed) const
 {
-    setCacheVariableValue<double>(s, "speed", speed);
+    setCacheVariableValue(s, _speedCV, speed);
 }
 
 void ScalarActuator::overrideActuation(SimTK::State& s, bool flag) const
 {
-    setModelingOption(s, "override_actuation", int(flag));
+    setModelingOption(s, overrideActuationName, int(flag));
 }
 
 bool ScalarActuator::isActuationOverridden(const SimTK::State& s) const
 {
-    return (getModelingOption(s, "override_actuation") > 0);
+    return (getModelingOption(s, overrideActuationName) > 0);
 }
        
 void ScalarActuator::setOverrideActuation(SimTK::State& s, double actuation) const
 {
-    setDiscreteVariableValue(s, "override_actuation", actuation);;
+    setDiscreteVariableValue(s, overrideActuationName, actuation);
 }
 
 double ScalarActuator::getOverrideActuation(const SimTK::State& s) const
 {
-    return getDiscreteVariableValue(s, "override_actuation");
+    return getDiscreteVariableValue(s, overrideActuationName);
 }
 double ScalarActuator::computeOverrideActuation(const SimTK::State& s) const
 {
@@ -89,6 +89,10 @@ public:
 
     //Model building
     virtual int numControls() const = 0;
+    /** The index of this Actuator's first control in the Model's controls
+    (see Model::getControls()), or -1 before the Model's System is
+    created. */
+    int getControlIndex() const { return _controlIndex; }
 
     /** Actuator default controls are zero */
     virtual const SimTK::Vector getDefaultControls() { return SimTK::Vector(numControls(), 0.0); } 
@@ -213,6 +217,22 @@ public:
     */
     double getOverrideActuation(const SimTK::State& s) const;
 
+    /**
+    * Add in the body and generalized forces this actuator applies per unit of
+    * (overridden) actuation at the given state, which must be realized to
+    * Stage::Position. The forces an actuator applies are linear in its
+    * actuation when it is overridden, so this lets analyses (e.g., static
+    * optimization) compute the effect of each actuator directly, rather than
+    * by realizing the model with the actuation perturbed.
+    *
+    * @returns false, without adding any forces, if the actuator does not
+    * provide its forces this way (the default).
+    */
+    virtual bool addInForcesPerUnitActuation(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const
+    {   return false; }
+
 
 protected:
 
@@ -245,10 +265,20 @@ protected:
         values.append(getActuation(state));
         return values;
     }
+#ifndef SWIG
+    /** Copy the actuation cached when the system was realized to Dynamics. */
+    void copyRecordValues(const SimTK::State& state,
+                          double* values) const override {
+        values[0] = getActuation(state);
+    }
+#endif
 
 private:
     void constructProperties();
 
+    mutable CacheVariable<double> _actuationCV;
+    mutable CacheVariable<double> _speedCV;
+
 //=============================================================================
 };  // END of class ScalarActuator
 //=============================================================================
@@ -287,6 +287,19 @@ setModel(Model& aModel)
 
 }
 //_____________________________________________________________________________
+/**
+ * get the model being analyzed.
+ */
+
+const Model& Analysis::
+getModel() const
+{
+    if (_model == NULL)
+        throw Exception("Analysis::getModel(): no model has been set for "
+                        "analysis " + getName() + ".", __FILE__, __LINE__);
+    return *_model;
+}
+//_____________________________________________________________________________
 /**
  * set pointer to states storage to be analyzed.
  */
@@ -347,6 +360,16 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     return(0);
 }
 
+void Analysis::extendEstimateMemoryUsage(MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    // getStorageList() does not modify the analysis, but is not const.
+    ArrayPtrs<Storage>& storages =
+            const_cast<Analysis*>(this)->getStorageList();
+    for (int i = 0; i < storages.getSize(); ++i)
+        if (storages[i]) usage += storages[i]->estimateMemoryUsage();
+}
+
 ArrayPtrs<Storage>& Analysis::getStorageList()
 {
     return _storageList;
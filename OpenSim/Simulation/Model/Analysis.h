@@ -37,6 +37,8 @@
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/Storage.h>
 
+#include <vector>
+
 namespace SimTK {
 class State;
 }
@@ -157,6 +159,11 @@ public:
      * @param aModel
      */
     virtual void setModel(Model& aModel);
+    /**
+     * The model being analyzed.
+     * @throws Exception If no model has been set.
+     */
+    const Model& getModel() const;
     // STATES STORAGE
     /**
      * set states storage for analysis.
@@ -209,6 +216,46 @@ public:
     int getStorageInterval() const;
 #endif
     virtual ArrayPtrs<Storage>& getStorageList();
+    /**
+     * Whether the results this analysis records for a frame (State) are
+     * independent of the frames it has seen before, i.e., it keeps no state
+     * across frames, and all of its results are in getStorageList(). The
+     * AnalyzeTool can then analyze chunks of frames concurrently, each with a
+     * copy of this analysis, and concatenate the copies' storages. Analyses
+     * that keep state across frames (e.g., that integrate or difference
+     * their results) must keep the default, false.
+     */
+    virtual bool isFrameIndependent() const { return false; }
+    /**
+     * Whether step() can run concurrently with the step() of other
+     * analyses, on another thread. Such an analysis only reads the Model and
+     * the State (which AnalysisSet::step() realizes to Stage::Acceleration
+     * first, and of which each thread has its own copy), and only modifies
+     * itself, e.g., by appending to its own storages. Analyses that modify
+     * the Model, or share data with other analyses, must keep the default,
+     * false.
+     */
+    virtual bool canStepConcurrently() const { return false; }
+    /**
+     * Whether this analysis reads the whole states Storage given to
+     * setStatesStore() (e.g., to spline the speeds), rather than only the
+     * State of each frame. The AnalyzeTool then cannot stream the states
+     * from their file (see AnalyzeTool::setStreamBlockSize()).
+     */
+    virtual bool usesStatesStore() const { return false; }
+
+protected:
+    // Add the storages in getStorageList().
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+public:
+    /**
+     * The files, other than the model and the states, that this analysis
+     * reads its inputs from (e.g., a forces file). The AnalyzeTool hashes
+     * their contents into the key of its result cache (see
+     * AnalyzeTool::setResultCacheDirectory()), so an analysis that reads
+     * files must list them.
+     */
+    virtual std::vector<std::string> getInputFileNames() const { return {}; }
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
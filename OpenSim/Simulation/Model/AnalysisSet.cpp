@@ -30,6 +30,11 @@
 // INCLUDES
 //=============================================================================
 #include "AnalysisSet.h"
+#include "Model.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 
 
 using namespace OpenSim;
@@ -91,6 +96,7 @@ AnalysisSet::AnalysisSet(const AnalysisSet &aSet) :
     _enable(_enableProp.getValueBool())
 {
     setNull();
+    _numThreads = aSet._numThreads;
 }
 
 
@@ -105,6 +111,7 @@ void AnalysisSet::
 setNull()
 {
     _enable = true;
+    _numThreads = 1;
 }
 void AnalysisSet::
 setupProperties() {
@@ -120,6 +127,7 @@ operator=(const  AnalysisSet &aSet)
      Set<Analysis>::operator=(aSet);
  
      _enable = aSet._enable;
+     setNumThreads(aSet._numThreads);
      return(*this);
 }
 //=============================================================================
@@ -184,6 +192,13 @@ getOn() const
     return on;
 }
 
+void AnalysisSet::
+setNumThreads(int numThreads)
+{
+    if (numThreads != _numThreads) _executor.reset();
+    _numThreads = numThreads;
+}
+
 
 //=============================================================================
 // CALLBACKS
@@ -212,14 +227,92 @@ void AnalysisSet::begin(const SimTK::State& s )
  *
  * @param s Current state 
  */
+namespace {
+// Steps analyses concurrently. Each block takes the next analysis that has
+// not been stepped until there are none left, so a block that draws a quick
+// analysis takes more of them.
+class StepTask : public SimTK::ParallelExecutor::Task {
+public:
+    StepTask(const SimTK::State& s, int stepNumber,
+             const std::vector<Analysis*>& analyses) :
+        _state(s), _stepNumber(stepNumber), _analyses(analyses),
+        _next(0), _errors(analyses.size()) {}
+
+    void execute(int block) override {
+        const int numAnalyses = int(_analyses.size());
+        int i = _next++;
+        if (i >= numAnalyses) return;
+        // Computing a lazily evaluated cache entry (e.g., the transform of a
+        // Frame) writes to the State, so each block steps its analyses with
+        // its own copy. The copy keeps the realized cache.
+        SimTK::State s = _state;
+        for (; i < numAnalyses; i = _next++) {
+            try {
+                _analyses[i]->step(s, _stepNumber);
+            } catch (...) {
+                _errors[i] = std::current_exception();
+            }
+        }
+    }
+
+    // Rethrow the error of the first analysis (in order) that failed, if any.
+    void rethrow() const {
+        for (const auto& error : _errors)
+            if (error) std::rethrow_exception(error);
+    }
+
+private:
+    const SimTK::State& _state;
+    const int _stepNumber;
+    const std::vector<Analysis*>& _analyses;
+    std::atomic<int> _next;
+    std::vector<std::exception_ptr> _errors;
+};
+}
+
 void AnalysisSet::
 step( const SimTK::State& s, int stepNumber )
 {
-    int i;
-    for(i=0;i<getSize();i++) {
+    // Analyses stepped from a worker thread (e.g., of another parallel
+    // computation) all step on that thread.
+    if (_numThreads == 1 || SimTK::ParallelExecutor::isWorkerThread()) {
+        for(int i=0;i<getSize();i++) {
+            Analysis& analysis = get(i);
+            if (analysis.getOn()) analysis.step(s, stepNumber);
+        }
+        return;
+    }
+
+    // The other analyses step first, since they may modify the Model or the
+    // State's cache.
+    std::vector<Analysis*> concurrent;
+    for(int i=0;i<getSize();i++) {
         Analysis& analysis = get(i);
-        if (analysis.getOn()) analysis.step(s, stepNumber);
+        if (!analysis.getOn()) continue;
+        if (analysis.canStepConcurrently()) concurrent.push_back(&analysis);
+        else analysis.step(s, stepNumber);
+    }
+    if (concurrent.size() < 2) {
+        for (Analysis* analysis : concurrent) analysis->step(s, stepNumber);
+        return;
     }
+
+    // Realize the State once, here, rather than once per copy. The
+    // accelerations of a system without mass cannot be computed.
+    const Model& model = concurrent[0]->getModel();
+    if (model.getMatterSubsystem().calcSystemMass(s) > SimTK::Eps)
+        model.getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
+    else
+        model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+
+    const int numThreads = _numThreads > 0 ? _numThreads
+                            : SimTK::ParallelExecutor::getNumProcessors();
+    const int numBlocks = std::min(numThreads, int(concurrent.size()));
+    if (!_executor)
+        _executor.reset(new SimTK::ParallelExecutor(std::max(numThreads, 1)));
+    StepTask task(s, stepNumber, concurrent);
+    _executor->execute(task, numBlocks);
+    task.rethrow();
 }
 //_____________________________________________________________________________
 /**
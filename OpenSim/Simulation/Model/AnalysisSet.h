@@ -29,10 +29,15 @@
 
 
 // INCLUDES
+#include <memory>
 #include <string>
 #include <OpenSim/Common/Set.h>
 #include "Analysis.h"
 
+namespace SimTK {
+class ParallelExecutor;
+}
+
 
 //=============================================================================
 //=============================================================================
@@ -65,6 +70,11 @@ protected:
     // testing for memory free error
     OpenSim::PropertyBool _enableProp;
     bool &_enable;
+
+private:
+    int _numThreads;
+    // Runs the analyses that step concurrently; created when first needed.
+    std::unique_ptr<SimTK::ParallelExecutor> _executor;
 //
 //=============================================================================
 // METHODS
@@ -92,6 +102,14 @@ public:
     void setOn(bool aTrueFalse);
     void setOn(const Array<bool> &aOn);
     Array<bool> getOn() const;
+    /** Number of threads on which step() runs the analyses that can step
+    concurrently (see Analysis::canStepConcurrently()); if not positive, the
+    number of processors is used. With the default, 1, all analyses step in
+    order on the calling thread. Otherwise, the other analyses step first, in
+    order, then the state is realized to Stage::Acceleration and the analyses
+    that can step concurrently are handed out to the threads. */
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return _numThreads; }
 
     //--------------------------------------------------------------------------
     // CALLBACKS
@@ -138,6 +138,41 @@ void Bhargava2004MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    updateMuscleParameterArrays();
+}
+
+//_____________________________________________________________________________
+/**
+ * Gather the muscle pointers and the parameters of the metabolic muscles
+ * into contiguous arrays for computeProbeInputs().
+ */
+void Bhargava2004MuscleMetabolicsProbe::updateMuscleParameterArrays()
+{
+    const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mms =
+        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
+    const int nM = mms.getSize();
+    _muscles.resize(nM);
+    _muscleMass.resize(nM);
+    _ratioSlowTwitchFibers.resize(nM);
+    _activationConstantSlowTwitch.resize(nM);
+    _activationConstantFastTwitch.resize(nM);
+    _maintenanceConstantSlowTwitch.resize(nM);
+    _maintenanceConstantFastTwitch.resize(nM);
+    for (int i=0; i<nM; ++i) {
+        const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm =
+            mms[i];
+        _muscles[i] = mm.getMuscle();
+        _muscleMass[i] = mm.getMuscleMass();
+        _ratioSlowTwitchFibers[i] = mm.get_ratio_slow_twitch_fibers();
+        _activationConstantSlowTwitch[i] =
+            mm.get_activation_constant_slow_twitch();
+        _activationConstantFastTwitch[i] =
+            mm.get_activation_constant_fast_twitch();
+        _maintenanceConstantSlowTwitch[i] =
+            mm.get_maintenance_constant_slow_twitch();
+        _maintenanceConstantFastTwitch[i] =
+            mm.get_maintenance_constant_fast_twitch();
+    }
 }
 
 
@@ -271,40 +306,51 @@ computeProbeInputs(const State& s) const
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
 
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
-    const int nM = 
-        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
-        .getSize();
+    // The properties of the probe, which are the same for all muscles.
+    const double effortScaling = get_muscle_effort_scaling_factor();
+    const bool forbidNegativePower = get_forbid_negative_total_power();
+    const bool activationRateOn = get_activation_rate_on();
+    const bool maintenanceRateOn = get_maintenance_rate_on();
+    const bool shorteningRateOn = get_shortening_rate_on();
+    const bool mechanicalWorkRateOn = get_mechanical_work_rate_on();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+    const bool useForceDependentShortening =
+        get_use_force_dependent_shortening_prop_constant();
+    const bool enforceMinimumHeatRate =
+        get_enforce_minimum_heat_rate_per_muscle();
+    const bool reportTotalOnly = get_report_total_metabolics_only();
+    const Function& fiberLengthDependenceCurve =
+        get_normalized_fiber_length_dependence_on_maintenance_rate();
+    Vector tmp(1);
+
+    // Loop through the muscles, in the order of the
+    // MetabolicMuscleParameterSet.
+    const int nM = int(_muscles.size());
     for (int i=0; i<nM; i++)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];   
-        const Muscle* m = mm.getMuscle();
+        const Muscle* m = _muscles[i];
+        const double muscleMass = _muscleMass[i];
+        const Muscle::RealizedMuscleState& ms = m->getRealizedMuscleState(s);
 
         // Get important muscle values at the current time state
         const double max_isometric_force = m->getMaxIsometricForce();
         //const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
-        const double fiber_force_passive = m->getPassiveFiberForce(s);
-        const double fiber_force_active = get_muscle_effort_scaling_factor()
-                                          * m->getActiveFiberForce(s);
+        const double activation = effortScaling * ms.activation;
+        const double excitation = effortScaling * m->getControl(s);
+        const double fiber_force_passive = ms.passiveFiberForce;
+        const double fiber_force_active = effortScaling * ms.activeFiberForce;
         const double fiber_force_total = fiber_force_active     // Scaled.
                                          + fiber_force_passive;
-        const double fiber_length_normalized = m->getNormalizedFiberLength(s);
-        const double fiber_velocity = m->getFiberVelocity(s);
+        const double fiber_length_normalized = ms.normalizedFiberLength;
+        const double fiber_velocity = ms.fiberVelocity;
         //const double fiber_velocity_normalized = m->getNormalizedFiberVelocity(s);
-        const double slow_twitch_excitation = mm.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
-        const double fast_twitch_excitation = (1 - mm.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
+        const double slow_twitch_excitation = _ratioSlowTwitchFibers[i] * sin(Pi/2 * excitation);
+        const double fast_twitch_excitation = (1 - _ratioSlowTwitchFibers[i]) * (1 - cos(Pi/2 * excitation));
         double alpha, fiber_length_dependence;
 
         // Get the unnormalized total active force, F_iso that 'would' be developed at the current activation
         // and fiber length under isometric conditions (i.e. Vm=0)
-        const double F_iso = activation * m->getActiveForceLengthMultiplier(s) * max_isometric_force;
+        const double F_iso = activation * ms.activeForceLengthMultiplier * max_isometric_force;
 
         // Warnings
         if (fiber_length_normalized < 0)
@@ -316,26 +362,26 @@ computeProbeInputs(const State& s) const
 
         // ACTIVATION HEAT RATE for muscle i (W)
         // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_activation_rate_on())
+        if (forbidNegativePower || activationRateOn)
         {
             const double decay_function_value = 1.0;    // This value is set to 1.0, as used by Anderson & Pandy (1999), however, in
                                                         // Bhargava et al., (2004) they assume a function here. We will ignore this
                                                         // function and use 1.0 for now.
-            Adot = mm.getMuscleMass() * decay_function_value * 
-                ( (mm.get_activation_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_activation_constant_fast_twitch() * fast_twitch_excitation) );
+            Adot = muscleMass * decay_function_value * 
+                ( (_activationConstantSlowTwitch[i] * slow_twitch_excitation) + (_activationConstantFastTwitch[i] * fast_twitch_excitation) );
         }
 
 
 
         // MAINTENANCE HEAT RATE for muscle i (W)
         // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_maintenance_rate_on())
+        if (forbidNegativePower || maintenanceRateOn)
         {
-            Vector tmp(1, fiber_length_normalized);
-            fiber_length_dependence = get_normalized_fiber_length_dependence_on_maintenance_rate().calcValue(tmp);
+            tmp[0] = fiber_length_normalized;
+            fiber_length_dependence = fiberLengthDependenceCurve.calcValue(tmp);
             
-            Mdot = mm.getMuscleMass() * fiber_length_dependence * 
-                ( (mm.get_maintenance_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_maintenance_constant_fast_twitch() * fast_twitch_excitation) );
+            Mdot = muscleMass * fiber_length_dependence * 
+                ( (_maintenanceConstantSlowTwitch[i] * slow_twitch_excitation) + (_maintenanceConstantFastTwitch[i] * fast_twitch_excitation) );
         }
 
 
@@ -343,9 +389,9 @@ computeProbeInputs(const State& s) const
         // SHORTENING HEAT RATE for muscle i (W)
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
         // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
+        if (forbidNegativePower || shorteningRateOn)
         {
-            if (get_use_force_dependent_shortening_prop_constant())
+            if (useForceDependentShortening)
             {
                 if (fiber_velocity <= 0)    // concentric contraction, Vm<0
                     alpha = (0.16 * F_iso) + (0.18 * fiber_force_total);
@@ -367,9 +413,9 @@ computeProbeInputs(const State& s) const
         // MECHANICAL WORK RATE for the contractile element of muscle i (W).
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
         // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
+        if (forbidNegativePower || mechanicalWorkRateOn)
         {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
+            if (includeNegativeWork || fiber_velocity <= 0)
                 Wdot = -fiber_force_active*fiber_velocity;
             else
                 Wdot = 0;
@@ -390,7 +436,7 @@ computeProbeInputs(const State& s) const
 
         // If necessary, increase the shortening heat rate so that the total
         // power is non-negative.
-        if (get_forbid_negative_total_power()) {
+        if (forbidNegativePower) {
             const double Edot_W_beforeClamp = Adot + Mdot + Sdot + Wdot;
             if (Edot_W_beforeClamp < 0)
                 Sdot -= Edot_W_beforeClamp;
@@ -402,15 +448,15 @@ computeProbeInputs(const State& s) const
         // -----------------------------------------------------------------------
         double totalHeatRate = Adot + Mdot + Sdot;      // (W)
 
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 * mm.getMuscleMass()
-            && get_activation_rate_on() 
-            && get_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
+        if(enforceMinimumHeatRate && totalHeatRate < 1.0 * muscleMass
+            && activationRateOn 
+            && maintenanceRateOn 
+            && shorteningRateOn) {
                 //cout << "WARNING: " << getName() 
                 //    << "  (t = " << s.getTime() 
                 //    << "), the muscle '" << mm.getName() 
                 //    << "' has a net metabolic energy rate of less than 1.0 W/kg." << endl; 
-                totalHeatRate = 1.0 * mm.getMuscleMass();           // not allowed to fall below 1.0 W.kg-1
+                totalHeatRate = 1.0 * muscleMass;           // not allowed to fall below 1.0 W.kg-1
         }
 
 
@@ -418,23 +464,22 @@ computeProbeInputs(const State& s) const
         // ------------------------------------------
         double Edot = 0;
 
-        if (get_activation_rate_on() && get_maintenance_rate_on()
-            && get_shortening_rate_on())
+        if (activationRateOn && maintenanceRateOn && shorteningRateOn)
         {
             Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
         } else {
-            if (get_activation_rate_on())
+            if (activationRateOn)
                 Edot += Adot;
-            if (get_maintenance_rate_on())
+            if (maintenanceRateOn)
                 Edot += Mdot;
-            if (get_shortening_rate_on())
+            if (shorteningRateOn)
                 Edot += Sdot;
         }
-        if (get_mechanical_work_rate_on())
+        if (mechanicalWorkRateOn)
             Edot += Wdot;
 
         EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
+        if (!reportTotalOnly) {
             // Metabolic power storage for muscle i
             EdotOutput(i+2) = Edot;  
         }  
@@ -442,12 +487,12 @@ computeProbeInputs(const State& s) const
 
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
-        cout << "ratio_slow_twitch_fibers = " << mm.get_ratio_slow_twitch_fibers() << endl;
-        cout << "activation_constant_slow_twitch = " << mm.get_activation_constant_slow_twitch() << endl;
-        cout << "activation_constant_fast_twitch = " << mm.get_activation_constant_fast_twitch() << endl;
-        cout << "maintenance_constant_slow_twitch = " << mm.get_maintenance_constant_slow_twitch() << endl;
-        cout << "maintenance_constant_fast_twitch = " << mm.get_maintenance_constant_fast_twitch() << endl;
+        cout << "muscle_mass = " << muscleMass << endl;
+        cout << "ratio_slow_twitch_fibers = " << _ratioSlowTwitchFibers[i] << endl;
+        cout << "activation_constant_slow_twitch = " << _activationConstantSlowTwitch[i] << endl;
+        cout << "activation_constant_fast_twitch = " << _activationConstantFastTwitch[i] << endl;
+        cout << "maintenance_constant_slow_twitch = " << _maintenanceConstantSlowTwitch[i] << endl;
+        cout << "maintenance_constant_fast_twitch = " << _maintenanceConstantFastTwitch[i] << endl;
         cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
         cout << "max_isometric_force = " << max_isometric_force << endl;
         cout << "activation = " << activation << endl;
@@ -617,6 +662,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     }
     upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
         .remove(k);
+    updateMuscleParameterArrays();
 }
 
 
@@ -634,6 +680,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     mm->set_use_provided_muscle_mass(true);
     mm->set_provided_muscle_mass(providedMass);
     mm->setMuscleMass();      // actual mass used.
+    updateMuscleParameterArrays();
 }
 
 
@@ -650,6 +697,7 @@ void Bhargava2004MuscleMetabolicsProbe::
 
     mm->set_use_provided_muscle_mass(false);
     mm->setMuscleMass();       // actual mass used.
+    updateMuscleParameterArrays();
 }
 
 
@@ -696,6 +744,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     setRatioSlowTwitchFibers(const std::string& muscleName, const double& ratio) 
 { 
     updMetabolicParameters(muscleName)->set_ratio_slow_twitch_fibers(ratio);
+    updateMuscleParameterArrays();
 }
 
 
@@ -762,6 +811,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     setActivationConstantSlowTwitch(const std::string& muscleName, const double& c) 
 { 
     updMetabolicParameters(muscleName)->set_activation_constant_slow_twitch(c); 
+    updateMuscleParameterArrays();
 }
 
 
@@ -784,6 +834,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     setActivationConstantFastTwitch(const std::string& muscleName, const double& c) 
 { 
     updMetabolicParameters(muscleName)->set_activation_constant_fast_twitch(c); 
+    updateMuscleParameterArrays();
 }
 
 
@@ -806,6 +857,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     setMaintenanceConstantSlowTwitch(const std::string& muscleName, const double& c) 
 { 
     updMetabolicParameters(muscleName)->set_maintenance_constant_slow_twitch(c); 
+    updateMuscleParameterArrays();
 }
 
 
@@ -828,6 +880,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     setMaintenanceConstantFastTwitch(const std::string& muscleName, const double& c) 
 { 
     updMetabolicParameters(muscleName)->set_maintenance_constant_fast_twitch(c);
+    updateMuscleParameterArrays();
 }
 
 
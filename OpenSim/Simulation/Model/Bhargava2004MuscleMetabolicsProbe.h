@@ -444,6 +444,17 @@ private:
     //--------------------------------------------------------------------------
     MuscleMap _muscleMap;
 
+    // The muscles and the parameters used by computeProbeInputs(), in the
+    // order of the MetabolicMuscleParameterSet, so that they are not looked
+    // up for every evaluation. Updated by extendConnectToModel() and by the
+    // methods above that change these parameters.
+    std::vector<const Muscle*> _muscles;
+    std::vector<double> _muscleMass;
+    std::vector<double> _ratioSlowTwitchFibers;
+    std::vector<double> _activationConstantSlowTwitch;
+    std::vector<double> _activationConstantFastTwitch;
+    std::vector<double> _maintenanceConstantSlowTwitch;
+    std::vector<double> _maintenanceConstantFastTwitch;
 
     //--------------------------------------------------------------------------
     // ModelComponent Interface
@@ -455,6 +466,9 @@ private:
     void setNull();
     void constructProperties();
 
+    // Gather the muscles and parameters into the arrays above.
+    void updateMuscleParameterArrays();
+
 
     //--------------------------------------------------------------------------
     // MetabolicMuscleParameter Private Interface
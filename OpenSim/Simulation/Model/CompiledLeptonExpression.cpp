@@ -0,0 +1,207 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  CompiledLeptonExpression.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompiledLeptonExpression.h"
+#include <OpenSim/Common/Exception.h>
+#include <lepton/Operation.h>
+#include <lepton/Parser.h>
+#include <lepton/ParsedExpression.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace OpenSim;
+
+CompiledLeptonExpression::CompiledLeptonExpression(
+        const std::string& expression,
+        const std::vector<std::string>& variableNames) :
+        _expression(new Lepton::CompiledExpression(
+                Lepton::Parser::parse(expression).optimize()
+                .createCompiledExpression())),
+        _variableNames(variableNames) {
+    for (const auto& name : _expression->getVariables()) {
+        OPENSIM_THROW_IF(std::find(variableNames.begin(), variableNames.end(),
+                                   name) == variableNames.end(),
+                         Exception,
+                         "Expression '" + expression + "' uses unknown "
+                         "variable '" + name + "'.");
+    }
+    bindSlots();
+}
+
+CompiledLeptonExpression::CompiledLeptonExpression(
+        const CompiledLeptonExpression& other) :
+        _variableNames(other._variableNames) {
+    if (other._expression)
+        _expression.reset(new Lepton::CompiledExpression(*other._expression));
+    bindSlots();
+}
+
+CompiledLeptonExpression& CompiledLeptonExpression::operator=(
+        const CompiledLeptonExpression& other) {
+    if (this != &other) {
+        _expression.reset(other._expression ?
+                new Lepton::CompiledExpression(*other._expression) : nullptr);
+        _variableNames = other._variableNames;
+        bindSlots();
+    }
+    return *this;
+}
+
+void CompiledLeptonExpression::bindSlots() {
+    _slots.assign(_variableNames.size(), nullptr);
+    if (!_expression) return;
+    const auto& used = _expression->getVariables();
+    for (size_t i = 0; i < _variableNames.size(); ++i) {
+        if (used.count(_variableNames[i]))
+            _slots[i] = &_expression->getVariableReference(_variableNames[i]);
+    }
+}
+
+void CompiledLeptonExpression::evaluate(int numPoints,
+        const double* const* values, double* results) const {
+    if (!_expression) {
+        std::fill(results, results + std::max(numPoints, 0), 0.0);
+        return;
+    }
+    std::map<std::string, const double*> variableValues;
+    for (size_t i = 0; i < _slots.size(); ++i)
+        if (_slots[i]) variableValues[_variableNames[i]] = values[i];
+    _expression->evaluateBatch(numPoints, variableValues, results);
+}
+
+//=============================================================================
+// FUSED LEPTON EXPRESSION
+//=============================================================================
+FusedLeptonExpression::FusedLeptonExpression(
+        const std::vector<std::string>& expressions,
+        const std::vector<std::string>& variableNames) :
+        _workspace(variableNames.size(), 0.0),
+        _numVariables(int(variableNames.size())) {
+    std::vector<std::pair<Lepton::ExpressionTreeNode, int>> compiled;
+    for (const auto& expression : expressions) {
+        const Lepton::ParsedExpression parsed =
+                Lepton::Parser::parse(expression).optimize();
+        try {
+            _outputs.push_back(
+                    compile(parsed.getRootNode(), variableNames, compiled));
+        } catch (const Exception& e) {
+            OPENSIM_THROW(Exception, "Expression '" + expression + "' " +
+                          e.getMessage());
+        }
+    }
+}
+
+int FusedLeptonExpression::compile(const Lepton::ExpressionTreeNode& node,
+        const std::vector<std::string>& variableNames,
+        std::vector<std::pair<Lepton::ExpressionTreeNode, int>>& compiled) {
+    for (const auto& done : compiled)
+        if (done.first == node) return done.second;
+
+    const Lepton::Operation& op = node.getOperation();
+    if (op.getId() == Lepton::Operation::VARIABLE) {
+        const auto it = std::find(variableNames.begin(), variableNames.end(),
+                                  op.getName());
+        OPENSIM_THROW_IF(it == variableNames.end(), Exception,
+                         "uses unknown variable '" + op.getName() + "'.");
+        return int(it - variableNames.begin());
+    }
+
+    std::vector<int> arguments;
+    for (const auto& child : node.getChildren())
+        arguments.push_back(compile(child, variableNames, compiled));
+
+    const int target = int(_workspace.size());
+    if (op.getId() == Lepton::Operation::CONSTANT) {
+        _workspace.push_back(
+            static_cast<const Lepton::Operation::Constant&>(op).getValue());
+    } else {
+        _workspace.push_back(0.0);
+        Step step;
+        step.operation.reset(op.clone());
+        step.id = op.getId();
+        step.constant = 0;
+        if (step.id == Lepton::Operation::ADD_CONSTANT)
+            step.constant = static_cast<const Lepton::Operation::AddConstant&>(
+                    op).getValue();
+        else if (step.id == Lepton::Operation::MULTIPLY_CONSTANT)
+            step.constant =
+                static_cast<const Lepton::Operation::MultiplyConstant&>(
+                    op).getValue();
+        step.target = target;
+        step.arguments = arguments;
+        _maxArguments = std::max(_maxArguments, int(arguments.size()));
+        _steps.push_back(std::move(step));
+    }
+    compiled.emplace_back(node, target);
+    return target;
+}
+
+void FusedLeptonExpression::evaluate(const double* values,
+                                     double* results) const {
+    // Small programs (the usual case) need no allocation.
+    const int MaxStackValues = 128;
+    double stackWorkspace[MaxStackValues], stackArguments[8];
+    std::vector<double> heapWorkspace, heapArguments;
+    double* w = stackWorkspace;
+    if (_workspace.size() > MaxStackValues) {
+        heapWorkspace.resize(_workspace.size());
+        w = heapWorkspace.data();
+    }
+    double* args = stackArguments;
+    if (_maxArguments > 8) {
+        heapArguments.resize(_maxArguments);
+        args = heapArguments.data();
+    }
+    std::copy(values, values + _numVariables, w);
+    std::copy(_workspace.begin() + _numVariables, _workspace.end(),
+              w + _numVariables);
+
+    static const std::map<std::string, double> noVariables;
+    for (const Step& step : _steps) {
+        const std::vector<int>& a = step.arguments;
+        double& result = w[step.target];
+        switch (step.id) {
+        case Lepton::Operation::ADD:      result = w[a[0]] + w[a[1]]; break;
+        case Lepton::Operation::SUBTRACT: result = w[a[0]] - w[a[1]]; break;
+        case Lepton::Operation::MULTIPLY: result = w[a[0]] * w[a[1]]; break;
+        case Lepton::Operation::DIVIDE:   result = w[a[0]] / w[a[1]]; break;
+        case Lepton::Operation::NEGATE:   result = -w[a[0]]; break;
+        case Lepton::Operation::SQUARE:   result = w[a[0]] * w[a[0]]; break;
+        case Lepton::Operation::CUBE:
+            result = w[a[0]] * w[a[0]] * w[a[0]]; break;
+        case Lepton::Operation::RECIPROCAL: result = 1.0 / w[a[0]]; break;
+        case Lepton::Operation::SIN:      result = std::sin(w[a[0]]); break;
+        case Lepton::Operation::COS:      result = std::cos(w[a[0]]); break;
+        case Lepton::Operation::ADD_CONSTANT:
+            result = w[a[0]] + step.constant; break;
+        case Lepton::Operation::MULTIPLY_CONSTANT:
+            result = w[a[0]] * step.constant; break;
+        default:
+            for (size_t i = 0; i < a.size(); ++i) args[i] = w[a[i]];
+            result = step.operation->evaluate(args, noVariables);
+        }
+    }
+    for (size_t k = 0; k < _outputs.size(); ++k)
+        results[k] = w[_outputs[k]];
+}
@@ -0,0 +1,164 @@
+#ifndef OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+#define OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  CompiledLeptonExpression.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Simulation/osimSimulationDLL.h"
+#include <lepton/CompiledExpression.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** (For internal use by expression-based components.) A Lepton expression
+compiled with Lepton::CompiledExpression, whose variables are bound once to
+slots indexed by position, so that evaluating the expression neither looks up
+variables by name nor interprets the expression's bytecode. The slots are
+rebound when the expression is copied.
+
+@code{.cpp}
+CompiledLeptonExpression force("-10*q-qdot", {"q", "qdot"});
+const double values[] = {q, qdot};
+double f = force.evaluate(values);
+@endcode
+
+Like Lepton::CompiledExpression, an expression must not be evaluated by two
+threads at the same time. */
+class OSIMSIMULATION_API CompiledLeptonExpression {
+public:
+    CompiledLeptonExpression() = default;
+    /** Parse, optimize and compile an expression.
+    @param expression The expression (see Lepton::Parser).
+    @param variableNames The variables the expression may use, in the order
+                         of the values given to evaluate().
+    @throws Lepton::Exception if the expression cannot be parsed.
+    @throws Exception if the expression uses a variable that is not in
+                      variableNames. */
+    CompiledLeptonExpression(const std::string& expression,
+                             const std::vector<std::string>& variableNames);
+
+    CompiledLeptonExpression(const CompiledLeptonExpression& other);
+    CompiledLeptonExpression& operator=(const CompiledLeptonExpression& other);
+
+    /** Evaluate the expression with the values of its variables, one for each
+    of the variableNames given to the constructor. A default-constructed
+    expression evaluates to 0. */
+    double evaluate(const double* values) const {
+        if (!_expression) return 0;
+        for (size_t i = 0; i < _slots.size(); ++i)
+            if (_slots[i]) *_slots[i] = values[i];
+        return _expression->evaluate();
+    }
+
+    /** Evaluate the expression at numPoints points in one call (see
+    Lepton::CompiledExpression::evaluateBatch()). values[i] points to the
+    numPoints values of the i'th of the variableNames given to the
+    constructor (it may be null if the expression does not use that
+    variable), and the numPoints results are stored in results. */
+    void evaluate(int numPoints, const double* const* values,
+                  double* results) const;
+
+private:
+    // Point each slot to the location of its variable in _expression, or to
+    // nullptr if the expression does not use the variable.
+    void bindSlots();
+
+    // Held by pointer since assigning to a Lepton::CompiledExpression that
+    // was already compiled leaks its operations.
+    std::unique_ptr<Lepton::CompiledExpression> _expression;
+    std::vector<std::string> _variableNames;
+    std::vector<double*> _slots;
+};
+
+/** (For internal use by expression-based components.) Several Lepton
+expressions of the same variables compiled into one program that evaluates
+all of them in a single pass. Subexpressions that appear in more than one
+of the expressions (e.g., the sine of a variable) are computed once, and
+constants are computed when the program is compiled.
+
+@code{.cpp}
+FusedLeptonExpression forces({"-k*sin(q)", "-k*sin(q)*cos(q)"}, {"q"});
+const double values[] = {q};
+double results[2];
+forces.evaluate(values, results);
+@endcode
+
+Unlike CompiledLeptonExpression, the program keeps its intermediate values
+on the stack of evaluate(), so a program may be evaluated by several
+threads at the same time. */
+class OSIMSIMULATION_API FusedLeptonExpression {
+public:
+    FusedLeptonExpression() = default;
+    /** Parse, optimize and compile the expressions.
+    @param expressions The expressions (see Lepton::Parser), in the order of
+                       the results of evaluate().
+    @param variableNames The variables the expressions may use, in the order
+                         of the values given to evaluate().
+    @throws Lepton::Exception if an expression cannot be parsed.
+    @throws Exception if an expression uses a variable that is not in
+                      variableNames. */
+    FusedLeptonExpression(const std::vector<std::string>& expressions,
+                          const std::vector<std::string>& variableNames);
+
+    /** The number of expressions, and of results of evaluate(). */
+    int getNumOutputs() const { return int(_outputs.size()); }
+    /** The number of operations evaluated by evaluate(), for all the
+    expressions together. */
+    int getNumOperations() const { return int(_steps.size()); }
+
+    /** Evaluate all the expressions with the values of their variables, one
+    for each of the variableNames given to the constructor, and store the
+    value of each expression in results. */
+    void evaluate(const double* values, double* results) const;
+
+private:
+    // One operation of the program: the operation's arguments are in the
+    // workspace at the given indices, and its value goes to target.
+    struct Step {
+        std::shared_ptr<const Lepton::Operation> operation;
+        int id;
+        double constant; // of ADD_CONSTANT and MULTIPLY_CONSTANT
+        int target;
+        std::vector<int> arguments;
+    };
+
+    // The workspace index of the value of node, compiling it (and those of
+    // its children) if no identical node has been compiled yet.
+    int compile(const Lepton::ExpressionTreeNode& node,
+                const std::vector<std::string>& variableNames,
+                std::vector<std::pair<Lepton::ExpressionTreeNode, int>>&
+                    compiled);
+
+    // The variables are at the start of the workspace, followed by the
+    // values of the operations and of the constants, which are stored here.
+    std::vector<double> _workspace;
+    int _numVariables = 0;
+    int _maxArguments = 0;
+    std::vector<Step> _steps;
+    std::vector<int> _outputs;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
@@ -26,8 +26,45 @@
 #include "ContactMesh.h"
 #include "Model.h"
 
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
 namespace OpenSim {
 
+struct ContactMesh::LoadedMesh {
+    explicit LoadedMesh(const SimTK::PolygonalMesh& mesh) :
+        geometry(mesh), decoration(mesh) {}
+    SimTK::ContactGeometry::TriangleMesh geometry;
+    SimTK::DecorativeMesh decoration;
+};
+
+namespace {
+    // Meshes loaded from files, by the path of the file and the size and
+    // hash of its contents, so that a file that is changed is loaded again.
+    // The meshes are owned by the ContactMeshes that use them, and are
+    // forgotten once there are none.
+    std::mutex loadedMeshesMutex;
+    std::map<std::string, std::weak_ptr<const void>> loadedMeshes;
+
+    bool isAbsolutePath(const std::string& path) {
+        return (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+               (path.size() > 1 && path[1] == ':');
+    }
+
+    // The 64-bit FNV-1a hash of the contents of a file.
+    std::uint64_t hashContents(const std::string& contents) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : contents) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
 ContactMesh::ContactMesh() 
 {
     setNull();
@@ -49,10 +86,7 @@ ContactMesh::ContactMesh(const std::string& filename,
         if (file.fail())
             throw Exception("Error loading mesh file: "+filename+". The file should exist in same folder with model.\n Model loading is aborted.");
         file.close();
-        SimTK::PolygonalMesh mesh;
-        mesh.loadFile(filename);
-        _geometry.reset(new SimTK::ContactGeometry::TriangleMesh(mesh));
-        _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
+        _mesh = findOrLoadMesh(filename);
     }
 }
 
@@ -77,8 +111,7 @@ void ContactMesh::constructProperties()
 }
 
 void ContactMesh::extendFinalizeFromProperties() {
-    _geometry.reset();
-    _decorativeGeometry.reset();
+    _mesh.reset();
 }
 
 const std::string& ContactMesh::getFilename() const
@@ -89,14 +122,46 @@ const std::string& ContactMesh::getFilename() const
 void ContactMesh::setFilename(const std::string& filename)
 {
     set_filename(filename);
-    _geometry.reset();
-    _decorativeGeometry.reset();
+    _mesh.reset();
 }
 
-SimTK::ContactGeometry::TriangleMesh* ContactMesh::
-    loadMesh(const std::string& filename) const
+std::shared_ptr<const ContactMesh::LoadedMesh> ContactMesh::
+    findOrLoadMesh(const std::string& filename)
 {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string& bytes = contents.str();
+    const std::string key =
+            (isAbsolutePath(filename) ? "" : IO::getCwd() + "/") + filename +
+            "|" + std::to_string(bytes.size()) +
+            "|" + std::to_string(hashContents(bytes));
+    {
+        std::lock_guard<std::mutex> lock(loadedMeshesMutex);
+        auto it = loadedMeshes.find(key);
+        if (it != loadedMeshes.end()) {
+            if (auto mesh = it->second.lock())
+                return std::static_pointer_cast<const LoadedMesh>(mesh);
+        }
+    }
+
+    // Load outside of the lock, so that other files can be loaded meanwhile.
     SimTK::PolygonalMesh mesh;
+    mesh.loadFile(filename);
+    auto loaded = std::make_shared<const LoadedMesh>(mesh);
+
+    std::lock_guard<std::mutex> lock(loadedMeshesMutex);
+    for (auto it = loadedMeshes.begin(); it != loadedMeshes.end(); ) {
+        if (it->second.expired()) it = loadedMeshes.erase(it);
+        else ++it;
+    }
+    loadedMeshes[key] = loaded;
+    return loaded;
+}
+
+std::shared_ptr<const ContactMesh::LoadedMesh> ContactMesh::
+    loadMesh(const std::string& filename) const
+{
     std::ifstream file;
     assert (_model);
     const std::string& savedCwd = IO::getCwd();
@@ -116,17 +181,22 @@ SimTK::ContactGeometry::TriangleMesh* ContactMesh::
                 "Loading is aborted.");
     }
     file.close();
-    mesh.loadFile(filename);
+    std::shared_ptr<const LoadedMesh> mesh;
+    try {
+        mesh = findOrLoadMesh(filename);
+    } catch (...) {
+        if (restoreDirectory) IO::chDir(savedCwd);
+        throw;
+    }
     if (restoreDirectory) IO::chDir(savedCwd);
-    _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
-    return new SimTK::ContactGeometry::TriangleMesh(mesh);
+    return mesh;
 }
 
 SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry() const
 {
-    if (!_geometry)
-        _geometry.reset(loadMesh(get_filename()));
-    return *_geometry;
+    if (!_mesh)
+        _mesh = loadMesh(get_filename());
+    return _mesh->geometry;
 }
 
 //=============================================================================
@@ -141,7 +211,7 @@ void ContactMesh::generateDecorations(bool fixed, const ModelDisplayHints& hints
     if (fixed) { return; }
 
     // Guard against the case where the Force was disabled or mesh failed to load.
-    if (_decorativeGeometry == nullptr) return;
+    if (_mesh == nullptr) return;
     if (!hints.get_show_contact_geometry()) return;
     // B: base Frame (Body or Ground)
     // F: PhysicalFrame that this ContactGeometry is connected to
@@ -151,7 +221,7 @@ void ContactMesh::generateDecorations(bool fixed, const ModelDisplayHints& hints
     const auto& X_BF = getFrame().findTransformInBaseFrame();
     const auto& X_FP = getTransform();
     const auto X_BP = X_BF * X_FP;
-    geometry.push_back(SimTK::DecorativeMesh(*_decorativeGeometry)
+    geometry.push_back(SimTK::DecorativeMesh(_mesh->decoration)
         .setTransform(X_BP)
         .setRepresentation(get_Appearance().get_representation())
         .setBodyId(getFrame().getMobilizedBodyIndex())
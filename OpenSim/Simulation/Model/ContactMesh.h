@@ -32,6 +32,12 @@ namespace OpenSim {
 /**
  * This class represents a polygonal mesh for use in contact modeling.
  *
+ * Loading a mesh, and building the tree of bounding volumes that Simbody
+ * uses to find contacts with it, can take much longer than simulating with
+ * it. Loaded meshes are therefore shared by all ContactMeshes (in any model,
+ * including copies of a model) that load the same file, as long as the file
+ * is not changed.
+ *
  * @author Peter Eastman
  */
 class OSIMSIMULATION_API ContactMesh : public ContactGeometry {
@@ -104,17 +110,22 @@ private:
     void constructProperties();
     void extendFinalizeFromProperties() override;
 
-    /** Load the mesh from a file.
+    /** A mesh loaded from a file, as contact and as decorative geometry. */
+    struct LoadedMesh;
+
+    /** Load the mesh from a file, relative to the directory of the model
+    file, if there is one.
     @param filename   string containing the file to be loaded
-    @return SimTK::ContactGeometry::TriangleMesh* heap allocated Contact mesh */
-    SimTK::ContactGeometry::TriangleMesh* loadMesh(const std::string& filename) const;
+    @return the mesh, shared with other ContactMeshes that loaded the file */
+    std::shared_ptr<const LoadedMesh> loadMesh(const std::string& filename) const;
+    /** Get the mesh already loaded from a file (relative to the current
+    directory), or load it if it has not been or the file has changed. */
+    static std::shared_ptr<const LoadedMesh> findOrLoadMesh(
+            const std::string& filename);
 //=============================================================================
 // DATA
 //=============================================================================
-    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::ContactGeometry::TriangleMesh>>
-        _geometry;
-    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMesh>>
-        _decorativeGeometry;
+    mutable std::shared_ptr<const LoadedMesh> _mesh;
 
 //=============================================================================
 };  // END of class ContactMesh
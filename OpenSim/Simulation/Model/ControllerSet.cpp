@@ -180,6 +180,12 @@ void ControllerSet::setDesiredStates( Storage* yStore)
    }
 }
 
+void ControllerSet::setUpdateRate(double rate)
+{
+    for (int i = 0; i < getSize(); ++i)
+        get(i).setUpdateRate(rate);
+}
+
 void ControllerSet::printInfo() const 
 {
     std::cout << " Number of controllers = " << getSize() << std::endl;
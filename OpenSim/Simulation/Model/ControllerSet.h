@@ -79,6 +79,10 @@ public:
 
     void setDesiredStates( Storage* yStore); 
 
+    /** %Set the update rate (Hz) of all the controllers in the set; see
+    Controller::setUpdateRate(). */
+    void setUpdateRate(double rate);
+
     // Controller interface
     virtual void computeControls(const SimTK::State& s, SimTK::Vector &controls) const; 
 
@@ -238,6 +238,7 @@ void CoordinateLimitForce::extendAddToSystem(SimTK::MultibodySystem& system) con
 
     if(isComputingDissipationEnergy()){
         addStateVariable("dissipatedEnergy");
+        _dissipatedEnergySV = getStateVariableHandle("dissipatedEnergy");
     }
 }
 
@@ -339,7 +340,7 @@ void CoordinateLimitForce::
     computeStateVariableDerivatives(const SimTK::State& s) const
 {
     if (appliesForce(s) && isComputingDissipationEnergy()){
-        setStateVariableDerivativeValue(s, "dissipatedEnergy", 
+        setStateVariableDerivativeValue(s, _dissipatedEnergySV,
             getPowerDissipation(s));
     }
 }
@@ -236,6 +236,8 @@ private:
     SimTK::ResetOnCopy<std::unique_ptr<SimTK::Function::Step> > _upStep;
     SimTK::ResetOnCopy<std::unique_ptr<SimTK::Function::Step> > _loStep;
 
+    mutable StateVariableHandle _dissipatedEnergySV;
+
     // Scaling for coordinate values in m or degrees (rotational) 
     double _w;
 
@@ -33,6 +33,14 @@ using namespace SimTK;
 using namespace OpenSim;
 
 
+// The variables of the stiffness expressions, in the order of the
+// components of the deflection.
+static const std::vector<std::string>& deflectionVariableNames() {
+    static const std::vector<std::string> names{
+        "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z"};
+    return names;
+}
+
 // string formatting helper utility
 
 template <typename T>
@@ -178,7 +186,8 @@ void ExpressionBasedBushingForce::setMxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MxProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -188,7 +197,8 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MyProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -197,7 +207,8 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MzProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -206,7 +217,8 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FxProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -215,7 +227,8 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FyProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -224,7 +237,18 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FzProg = CompiledLeptonExpression(expression, deflectionVariableNames());
+    compileStiffnessProgram();
+}
+
+/* Compile the six expressions into one program, which evaluates the
+   subexpressions they share once. */
+void ExpressionBasedBushingForce::compileStiffnessProgram()
+{
+    _stiffnessProg = FusedLeptonExpression(
+            {get_Mx_expression(), get_My_expression(), get_Mz_expression(),
+             get_Fx_expression(), get_Fy_expression(), get_Fz_expression()},
+            deflectionVariableNames());
 }
 //=============================================================================
 // COMPUTATION
@@ -239,23 +263,40 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
+    // The deflections are ordered as deflectionVariableNames(), and the
+    // results as fk.
+    _stiffnessProg.evaluate(&dq[0], &fk[0]);
 
+    return -fk;
+}
 
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+/* Calculate the bushing force contribution due to its stiffness at many
+   deflections. */
+SimTK::Vector_<SimTK::Vec6> ExpressionBasedBushingForce::
+    calcStiffnessForces(const SimTK::Vector_<SimTK::Vec6>& deflections) const
+{
+    const int n = deflections.size();
+    SimTK::Vector_<SimTK::Vec6> fk(n);
+    if (n == 0) return fk;
+
+    // Each expression takes the deflection components as separate arrays,
+    // ordered as deflectionVariableNames().
+    std::vector<double> components(6*size_t(n)), values(n);
+    const double* deflectionVars[6];
+    for (int j = 0; j < 6; ++j) {
+        for (int i = 0; i < n; ++i)
+            components[j*size_t(n) + i] = deflections[i][j];
+        deflectionVars[j] = &components[j*size_t(n)];
+    }
 
-    return -fk;
+    const CompiledLeptonExpression* progs[6] =
+        {&MxProg, &MyProg, &MzProg, &FxProg, &FyProg, &FzProg};
+    for (int j = 0; j < 6; ++j) {
+        progs[j]->evaluate(n, deflectionVars, &values[0]);
+        for (int i = 0; i < n; ++i)
+            fk[i][j] = -values[i];
+    }
+    return fk;
 }
 
 /* Calculate the bushing force contribution due to its damping. */
@@ -27,6 +27,7 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include "CompiledLeptonExpression.h"
 
 namespace OpenSim {
 
@@ -190,6 +191,14 @@ public:
         on frame2 from frame1 in the basis of the deflection (dq). */
     SimTK::Vec6 calcStiffnessForce(const SimTK::State& state) const;
 
+    /** Calculate the stiffness force (as calcStiffnessForce()) for many
+        deflections at once (e.g., for sweeps over sampled states), without a
+        State. Each deflection (dq) is (theta_x, theta_y, theta_z, delta_x,
+        delta_y, delta_z). The expressions must have been set, e.g., by
+        connecting the bushing to a model. */
+    SimTK::Vector_<SimTK::Vec6> calcStiffnessForces(
+            const SimTK::Vector_<SimTK::Vec6>& deflections) const;
+
     /** Calculate the bushing force contribution due to its damping. This is a
         function of the deflection rate between the bushing frames. It is the 
         force on frame2 from frame1 in the basis of the deflection rate (dqdot).*/
@@ -237,11 +246,14 @@ private:
 
     void setNull();
     void constructProperties();
+    void compileStiffnessProgram();
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions for efficiently evaluating the stiffness forces
+    CompiledLeptonExpression MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // all six expressions together, for calcStiffnessForce()
+    FusedLeptonExpression _stiffnessProg;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
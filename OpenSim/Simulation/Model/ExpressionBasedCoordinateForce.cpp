@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedCoordinateForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -97,7 +95,7 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression = CompiledLeptonExpression(expression, {"q", "qdot"});
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,16 +133,29 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {_coord->getValue(s),
+                                _coord->getSpeedValue(s)};
+    double forceMag = _forceExpression.evaluate(forceVars);
     setCacheVariableValue<double>(s, "force_magnitude", forceMag);
     return forceMag;
 }
 
+// Compute the force at many coordinate values and speeds
+SimTK::Vector ExpressionBasedCoordinateForce::calcExpressionForces(
+        const SimTK::Vector& q, const SimTK::Vector& qdot) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(q.size() != qdot.size(), Exception,
+            "Expected as many speeds (" + std::to_string(qdot.size()) +
+            ") as coordinate values (" + std::to_string(q.size()) + ").");
+    // Contiguous copies, in case the vectors are strided views.
+    const SimTK::Vector qValues(q), qdotValues(qdot);
+    SimTK::Vector forces(q.size());
+    if (forces.size() == 0) return forces;
+    const double* forceVars[] = {&qValues[0], &qdotValues[0]};
+    _forceExpression.evaluate(forces.size(), forceVars, &forces[0]);
+    return forces;
+}
+
 // get the force magnitude that has already been computed
 const double& ExpressionBasedCoordinateForce::
     getForceMagnitude(const SimTK::State& s)
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledLeptonExpression.h"
 
 namespace OpenSim {
 
@@ -100,6 +100,15 @@ public:
     /** Force calculation operator. **/
     double calcExpressionForce( const SimTK::State& s) const;
 
+    /** Evaluate the expression at many coordinate values and speeds at once
+    (e.g., for sweeps over sampled states), without a State. The expression
+    must have been set up by connecting the force to a model.
+    @param q     Coordinate values.
+    @param qdot  Coordinate speeds, one for each value in q.
+    @return The force for each pair of q and qdot. */
+    SimTK::Vector calcExpressionForces(const SimTK::Vector& q,
+                                       const SimTK::Vector& qdot) const;
+
 //==============================================================================
 // Reporting
 //==============================================================================
@@ -126,8 +135,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force
+    CompiledLeptonExpression _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
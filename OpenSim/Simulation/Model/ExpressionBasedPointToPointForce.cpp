@@ -26,8 +26,6 @@
 //=============================================================================
 #include "ExpressionBasedPointToPointForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -130,7 +128,7 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression = CompiledLeptonExpression(expression, {"d", "ddot"});
 }
 
 //=============================================================================
@@ -180,11 +178,8 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
-
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double forceVars[] = {d, ddot};
+    double forceMag = _forceExpression.evaluate(forceVars);
     setCacheVariableValue<double>(s, "force_magnitude", forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -193,6 +188,22 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     bodyForces[_b2->getMobilizedBodyIndex()] -=  SpatialVec(s2_G % f1_G, f1_G);
 }
 
+// Compute the force magnitude at many distances and rates
+SimTK::Vector ExpressionBasedPointToPointForce::calcForceMagnitudes(
+        const SimTK::Vector& d, const SimTK::Vector& ddot) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(d.size() != ddot.size(), Exception,
+            "Expected as many rates (" + std::to_string(ddot.size()) +
+            ") as distances (" + std::to_string(d.size()) + ").");
+    // Contiguous copies, in case the vectors are strided views.
+    const SimTK::Vector dValues(d), ddotValues(ddot);
+    SimTK::Vector forces(d.size());
+    if (forces.size() == 0) return forces;
+    const double* forceVars[] = {&dValues[0], &ddotValues[0]};
+    _forceExpression.evaluate(forces.size(), forceVars, &forces[0]);
+    return forces;
+}
+
 // get the force magnitude that has already been computed
 const double& ExpressionBasedPointToPointForce::
     getForceMagnitude(const SimTK::State& s)
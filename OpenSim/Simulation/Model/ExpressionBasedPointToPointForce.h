@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledLeptonExpression.h"
 
 namespace SimTK {
 class MobilizedBody;
@@ -134,6 +134,15 @@ public:
     */
     const double& getForceMagnitude(const SimTK::State& state);
 
+    /** Evaluate the expression at many distances and rates at once (e.g., for
+    sweeps over sampled states), without a State. The expression must have
+    been set up by connecting the force to a model.
+    @param d     Distances between the points.
+    @param ddot  Rates of change of the distance, one for each value in d.
+    @return The force magnitude for each pair of d and ddot. */
+    SimTK::Vector calcForceMagnitudes(const SimTK::Vector& d,
+                                      const SimTK::Vector& ddot) const;
+
 
     //--------------------------------------------------------------------------
     // COMPUTATION
@@ -169,8 +178,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force
+    CompiledLeptonExpression _forceExpression;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
@@ -33,6 +33,11 @@
 
 #include "ExternalForce.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
 //==============================================================================
 // USING
 //==============================================================================
@@ -247,65 +252,154 @@ void ExternalForce::extendConnectToModel(Model& model)
     }
 
     // clear out functions from previous data source
-    _forceFunctions.clearAndDestroy();
-    _pointFunctions.clearAndDestroy();
-    _torqueFunctions.clearAndDestroy();
+    _forceFunctions.clear();
+    _pointFunctions.clear();
+    _torqueFunctions.clear();
 
     // Create functions now that we should have good data remaining
     if(_appliesForce){
-        for(int i=0; i<3; ++i){
-            switch(nt) {
-                case 1 :
-                    _forceFunctions.append(new Constant(force[i][0]));
-                    break;
-                case 2 :
-                    _forceFunctions.append(new PiecewiseLinearFunction(force[i].getSize(), &time[0], &(force[i][0])) );
-                    break;
-                case 3 :
-                    _forceFunctions.append(new PiecewiseLinearFunction(force[i].getSize(), &time[0], &(force[i][0])) );
-                    break;
-                default:
-                    _forceFunctions.append(new GCVSpline( 3, force[i].getSize(), &time[0], &(force[i][0])) );
-            }   
-        }
+        for(int i=0; i<3; ++i)
+            _forceFunctions.push_back(createFunction(time, force[i]));
 
         if(_specifiesPoint){
-            for(int i=0; i<3; ++i){
-                switch(nt) {
-                case 1:
-                    _pointFunctions.append(new Constant(point[i][0]));
-                    break;
-                case 2:
-                    _pointFunctions.append(new PiecewiseLinearFunction(point[i].getSize(), &time[0], &(point[i][0])) );
-                    break;
-                case 3:
-                    _pointFunctions.append(new PiecewiseLinearFunction(point[i].getSize(), &time[0], &(point[i][0])) );
-                    break;
-                default:
-                    _pointFunctions.append(new GCVSpline( 3, point[i].getSize(), &time[0], &(point[i][0])) );
-                }
-            }
+            for(int i=0; i<3; ++i)
+                _pointFunctions.push_back(createFunction(time, point[i]));
         }
     }
     if(_appliesTorque){
-        for(int i=0; i<3; ++i){
-            switch(nt) {
-                case 1:
-                    _torqueFunctions.append(new Constant(torque[i][0]));
-                    break;
-                case 2:
-                    _torqueFunctions.append(new PiecewiseLinearFunction(torque[i].getSize(), &time[0], &(torque[i][0])) );
-                    break;
-                case 3:
-                    _torqueFunctions.append(new PiecewiseLinearFunction(torque[i].getSize(), &time[0], &(torque[i][0])) );
-                    break;
-                default:
-                    _torqueFunctions.append(new GCVSpline( 3, torque[i].getSize(), &time[0], &(torque[i][0])) );
+        for(int i=0; i<3; ++i)
+            _torqueFunctions.push_back(createFunction(time, torque[i]));
+    }
+}
+
+void ExternalForce::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    _timeCV = addCacheVariable("time", SimTK::Vector(1, 0.0),
+                               SimTK::Stage::Topology);
+}
+
+//-----------------------------------------------------------------------------
+// FUNCTIONS OF THE DATA
+//-----------------------------------------------------------------------------
+namespace {
+    // Functions fit to data, by a hash of the data. The functions are owned
+    // by the ExternalForces that use them, and are forgotten once there are
+    // none.
+    std::mutex fittedFunctionsMutex;
+    std::unordered_map<std::uint64_t,
+                       std::vector<std::weak_ptr<const Function>>>
+        fittedFunctions;
+
+    // The 64-bit FNV-1a hash of the data.
+    std::uint64_t hashData(const Array<double>& time,
+                           const Array<double>& values) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto add = [&hash](const Array<double>& data) {
+            const int n = data.getSize();
+            const unsigned char* bytes =
+                    reinterpret_cast<const unsigned char*>(&n);
+            for (size_t i = 0; i < sizeof(n); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+            if (n == 0) return;
+            bytes = reinterpret_cast<const unsigned char*>(&data[0]);
+            for (size_t i = 0; i < size_t(n)*sizeof(double); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
             }
+        };
+        add(time);
+        add(values);
+        return hash;
+    }
+
+    // Whether a function was created by ExternalForce::createFunction() from
+    // the data.
+    bool isFitTo(const Function& function, const Array<double>& time,
+                 const Array<double>& values) {
+        const int n = time.getSize();
+        if (values.getSize() != n) return false;
+        if (n == 1) {
+            const auto* constant = dynamic_cast<const Constant*>(&function);
+            return constant && constant->getValue() == values[0];
         }
+        const double* x = nullptr;
+        const double* y = nullptr;
+        if (n <= 3) {
+            const auto* linear =
+                    dynamic_cast<const PiecewiseLinearFunction*>(&function);
+            if (!linear || linear->getSize() != n) return false;
+            x = linear->getXValues();
+            y = linear->getYValues();
+        } else {
+            const auto* spline = dynamic_cast<const GCVSpline*>(&function);
+            if (!spline || spline->getSize() != n) return false;
+            x = spline->getXValues();
+            y = spline->getYValues();
+        }
+        return std::equal(x, x + n, &time[0]) &&
+               std::equal(y, y + n, &values[0]);
     }
 }
 
+std::shared_ptr<const Function> ExternalForce::createFunction(
+        const Array<double>& time, const Array<double>& values)
+{
+    const std::uint64_t hash = hashData(time, values);
+    {
+        std::lock_guard<std::mutex> lock(fittedFunctionsMutex);
+        auto it = fittedFunctions.find(hash);
+        if (it != fittedFunctions.end()) {
+            for (const auto& weak : it->second) {
+                std::shared_ptr<const Function> function = weak.lock();
+                if (function && isFitTo(*function, time, values))
+                    return function;
+            }
+        }
+    }
+
+    // Fit outside of the lock, so that other data can be fit meanwhile.
+    const int nt = time.getSize();
+    std::shared_ptr<const Function> function;
+    if (nt == 1)
+        function.reset(new Constant(values[0]));
+    else if (nt <= 3)
+        function.reset(new PiecewiseLinearFunction(nt, &time[0], &values[0]));
+    else {
+        auto* spline = new GCVSpline(3, nt, &time[0], &values[0]);
+        function.reset(spline);
+        // Fit now, so that the spline is not modified once it is shared.
+        spline->fit();
+    }
+
+    std::lock_guard<std::mutex> lock(fittedFunctionsMutex);
+    auto& candidates = fittedFunctions[hash];
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+            [](const std::weak_ptr<const Function>& weak)
+            {   return weak.expired(); }), candidates.end());
+    candidates.push_back(function);
+    // Forget the data of functions no longer in use.
+    for (auto it = fittedFunctions.begin(); it != fittedFunctions.end(); ) {
+        bool inUse = false;
+        for (const auto& weak : it->second) inUse = inUse || !weak.expired();
+        if (inUse) ++it;
+        else it = fittedFunctions.erase(it);
+    }
+    return function;
+}
+
+Vec3 ExternalForce::calcValues(const Functions& functions,
+                               const SimTK::Vector& time)
+{
+    if (functions.size() != 3)
+        return Vec3(0);
+    return Vec3(functions[0]->calcValue(time),
+                functions[1]->calcValue(time),
+                functions[2]->calcValue(time));
+}
+
 
 
 //-----------------------------------------------------------------------------
@@ -317,16 +411,17 @@ void ExternalForce::computeForce(const SimTK::State& state,
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const
 {
-    double time = state.getTime();
+    SimTK::Vector& time = updCacheVariableValue(state, _timeCV);
+    time[0] = state.getTime();
 
     assert(_appliedToBody!=nullptr);
 
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
+        Vec3 force = calcValues(_forceFunctions, time);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
         Vec3 point(0); // Default is body origin.
         if (_specifiesPoint) {
-            point = getPointAtTime(time);
+            point = calcValues(_pointFunctions, time);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -334,7 +429,7 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
+        Vec3 torque = calcValues(_torqueFunctions, time);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
@@ -345,47 +440,17 @@ void ExternalForce::computeForce(const SimTK::State& state,
  */
 Vec3 ExternalForce::getForceAtTime(double aTime) const  
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* forceX=NULL;
-    const Function* forceY=NULL;
-    const Function* forceZ=NULL;
-    if (_forceFunctions.size()==3){
-        forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
-    }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
-    return force;
+    return calcValues(_forceFunctions, SimTK::Vector(1, aTime));
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* pointX=NULL;
-    const Function* pointY=NULL;
-    const Function* pointZ=NULL;
-    if (_pointFunctions.size()==3){
-        pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
-    }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
-    return point;
+    return calcValues(_pointFunctions, SimTK::Vector(1, aTime));
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* torqueX=NULL;
-    const Function* torqueY=NULL;
-    const Function* torqueZ=NULL;
-    if (_torqueFunctions.size()==3){
-        torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
-    }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
-    return torque;
+    return calcValues(_torqueFunctions, SimTK::Vector(1, aTime));
 }
 
 
@@ -24,6 +24,8 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
+#include <memory>
+#include <vector>
 
 namespace OpenSim {
 
@@ -50,6 +52,10 @@ class Function;
  * An ExternalForce must apply at least a force or a torque and therefore both 
  * identifiers cannot be empty. 
  *
+ * The functions of time fit to the data (e.g., GCVSpline%s) are shared by all
+ * ExternalForces, and copies of them, that use the same columns of data, so
+ * that data shared by several forces or model copies is only fit once.
+ *
  * @author Ajay Seth
  */
 class OSIMSIMULATION_API ExternalForce : public Force {
@@ -211,6 +217,7 @@ protected:
 
     /**  ModelComponent interface */ 
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
     /**
      * Compute the force.
@@ -223,6 +230,14 @@ private:
     void setNull();
     void constructProperties();
 
+    typedef std::vector<std::shared_ptr<const Function>> Functions;
+    // The function of time fit to the (time, values) data, shared with any
+    // other ExternalForce that fit the same data.
+    static std::shared_ptr<const Function> createFunction(
+            const Array<double>& time, const Array<double>& values);
+    static SimTK::Vec3 calcValues(const Functions& functions,
+                                  const SimTK::Vector& time);
+
 
 //==============================================================================
 // DATA
@@ -248,9 +263,13 @@ private:
     bool _appliesTorque;
 
     /** force data as a function of time used internally */
-    ArrayPtrs<Function> _forceFunctions;
-    ArrayPtrs<Function> _torqueFunctions;
-    ArrayPtrs<Function> _pointFunctions;
+    Functions _forceFunctions;
+    Functions _torqueFunctions;
+    Functions _pointFunctions;
+
+    /** The argument of the functions, kept in the cache to avoid allocating
+    it every time the force is computed. */
+    mutable CacheVariable<SimTK::Vector> _timeCV;
 
     friend class ExternalLoads;
 //==============================================================================
@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Common/IO.h>
 
+#include <thread>
+
 using namespace std;
 using namespace OpenSim;
 using SimTK::Vec3;
@@ -132,6 +134,8 @@ void ExternalLoads::copyData(const ExternalLoads &aAbsExternalLoads)
     _dataFileName = aAbsExternalLoads._dataFileName;
     _externalLoadsModelKinematicsFileName = aAbsExternalLoads._externalLoadsModelKinematicsFileName;
     _lowpassCutoffFrequencyForLoadKinematics = aAbsExternalLoads._lowpassCutoffFrequencyForLoadKinematics;
+    _dataFileStorage = aAbsExternalLoads._dataFileStorage;
+    _dataFileStorageName = aAbsExternalLoads._dataFileStorageName;
 }
 
 //_____________________________________________________________________________
@@ -186,18 +190,40 @@ ExternalLoads& ExternalLoads::operator=(const ExternalLoads &otherExternalLoads)
     return(*this);
 }
 
+std::vector<std::string> ExternalLoads::getInputFileNames(
+        const std::string& externalLoadsFileName) const
+{
+    const std::string directory =
+            IO::getParentDirectory(externalLoadsFileName);
+    auto resolve = [&directory](std::string fileName) {
+        IO::TrimWhitespace(fileName);
+        const bool absolute = !fileName.empty() && (fileName[0] == '/' ||
+                fileName[0] == '\\' ||
+                (fileName.size() > 1 && fileName[1] == ':'));
+        return absolute ? fileName : directory + fileName;
+    };
+    std::vector<std::string> fileNames{externalLoadsFileName};
+    fileNames.push_back(resolve(_dataFileName));
+    std::string kinematicsFileName = _externalLoadsModelKinematicsFileName;
+    IO::TrimWhitespace(kinematicsFileName);
+    if (kinematicsFileName != "" && kinematicsFileName != "Unassigned")
+        fileNames.push_back(resolve(kinematicsFileName));
+    return fileNames;
+}
+
 void ExternalLoads::invokeConnectToModel(Model& aModel)
 {
-    Storage *forceData = new Storage(_dataFileName);
+    // The file is only read again if another file is named.
+    if (!_dataFileStorage || _dataFileStorageName != _dataFileName) {
+        _dataFileStorage = std::make_shared<const Storage>(_dataFileName);
+        _dataFileStorageName = _dataFileName;
+    }
 
     for(int i=0; i<getSize(); ++i)
-        get(i).setDataSource(*forceData);
+        get(i).setDataSource(*_dataFileStorage);
 
     // BASE CLASS
     Super::invokeConnectToModel(aModel);
-
-    // add loaded storage into list of storages for later garbage collection
-    _storages.append(forceData);
 }
 
 //-----------------------------------------------------------------------------
@@ -220,36 +246,53 @@ void ExternalLoads::invokeConnectToModel(Model& aModel)
  */
 void ExternalLoads::transformPointsExpressedInGroundToAppliedBodies(const Storage &kinematics, double startTime, double endTime)
 {
+    std::vector<const ExternalForce*> forces;
+    for(int i=0; i<getSize(); i++)
+        forces.push_back(&get(i));
+    std::vector<ExternalForce*> transformed =
+        transformPointsToAppliedBodies(forces, kinematics, startTime, endTime);
     for(int i=0; i<getSize(); i++){
-        ExternalForce *transformedExf = transformPointExpressedInGroundToAppliedBody(get(i), kinematics, startTime, endTime);
-        if(transformedExf){
+        if(transformed[i]){
             // replace the force
-            set(i, transformedExf);
+            set(i, transformed[i]);
         }
     }
 }
 
 ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(const ExternalForce &exForce, const Storage &kinematics, double startTime, double endTime)
+{
+    return transformPointsToAppliedBodies({&exForce}, kinematics, startTime,
+                                          endTime)[0];
+}
+
+std::vector<ExternalForce*> ExternalLoads::transformPointsToAppliedBodies(
+        const std::vector<const ExternalForce*>& exForces,
+        const Storage &kinematics, double startTime, double endTime)
 {
     if(!hasModel() || !getModel().isValidSystem()) // no model and no system underneath, cannot proceed
         throw Exception("ExternalLoads::transformPointExpressedInGroundToAppliedBody() requires a model with a valid system."); 
 
-    if(!exForce._specifiesPoint){ // The external force does not apply a force to a point
-        cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' does not specify a point of application." << endl;
-        return NULL;
-    }
-
-    if (exForce.getPointExpressedInBodyName() != getModel().getGround().getName()){
-        cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' is not expressed in ground and will not be transformed." << endl;
-        return NULL;
-    }
+    std::vector<ExternalForce*> transformed(exForces.size(), nullptr);
 
-    if (exForce.getAppliedToBodyName() == getModel().getGround().getName()){
-        cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' is applied to a point on ground and will not be transformed." << endl;
-        return NULL;
+    // The forces whose points are transformed.
+    std::vector<int> toTransform;
+    for(size_t f=0; f<exForces.size(); ++f){
+        const ExternalForce& exForce = *exForces[f];
+        if(!exForce._specifiesPoint){ // The external force does not apply a force to a point
+            cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' does not specify a point of application." << endl;
+        }
+        else if (exForce.getPointExpressedInBodyName() != getModel().getGround().getName()){
+            cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' is not expressed in ground and will not be transformed." << endl;
+        }
+        else if (exForce.getAppliedToBodyName() == getModel().getGround().getName()){
+            cout << "ExternalLoads: WARNING ExternalForce '"<< exForce.getName() <<"' is applied to a point on ground and will not be transformed." << endl;
+        }
+        else
+            toTransform.push_back((int)f);
     }
+    if (toTransform.empty()) return transformed;
 
-    int nq = getModel().getNumCoordinates();
+    const int nq = getModel().getNumCoordinates();
     int nt = kinematics.getSize();
 
     int startIndex=0;
@@ -271,109 +314,169 @@ ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(const
     else{
         cout << "ExternalLoads: WARNING specified load kinematics contains no coordinate values. " 
             << "Point of force application cannot be transformed." << endl;
-        return NULL;
+        return transformed;
     }
 
     nt = lastIndex-startIndex+1;
-
-    // Construct a new storage to contain the re-expressed point data for the 
-    // new external force.
-    Storage *newDataSource = new Storage(nt);
-    Array<string> labels;
-    labels.append("time");
-
-    const string &forceIdentifier = exForce.getForceIdentifier();
-    const string &pointIdentifier = exForce.getPointIdentifier();
-    const string &torqueIdentifier = exForce.getTorqueIdentifier();
-
-    labels.append(forceIdentifier + ".x");
-    labels.append(forceIdentifier + ".y");
-    labels.append(forceIdentifier + ".z");
-    labels.append(pointIdentifier + ".x");
-    labels.append(pointIdentifier + ".y");
-    labels.append(pointIdentifier + ".z");
-    if(exForce._appliesTorque){
-        labels.append(torqueIdentifier + ".x");
-        labels.append(torqueIdentifier + ".y");
-        labels.append(torqueIdentifier + ".z");
+    const int nf = (int)toTransform.size();
+
+    // Evaluate the points of all forces (expressed in ground; check made
+    // above) here, since the functions fit to the data are not evaluated
+    // concurrently.
+    std::vector<double> times(nt);
+    std::vector<Vec3> points(nt*nf);
+    for(int k=0; k<nt; ++k) {
+        kinematics.getTime(startIndex+k, times[k]);
+        for(int f=0; f<nf; ++f)
+            points[k*nf + f] = exForces[toTransform[f]]->getPointAtTime(times[k]);
     }
 
-    newDataSource->setColumnLabels(labels);
-    int ncols = labels.getSize()-1; // time treated separately when appended to storage
-
-    SimTK::Vector datarow(ncols, SimTK::NaN);
-
-    double time = 0;
-    Array<double> Q(0.0,nq);
+    // get from (ground) and to (applied) bodies 
+    const Ground& ground = getModel().getGround();
+    std::vector<const Body*> appliedToBodies(nf);
+    for(int f=0; f<nf; ++f)
+        appliedToBodies[f] = &getModel().getBodySet().get(
+                exForces[toTransform[f]]->getAppliedToBodyName());
 
-    Vec3 pGround(SimTK::NaN);
-    Vec3 pAppliedBody(SimTK::NaN);
-    Vec3 force(SimTK::NaN); 
-    Vec3 torque(SimTK::NaN);
-    
     // Checked that we had a model with a valid system, so get its working state
     SimTK::State& s = updModel().updWorkingState();
+    const CoordinateSet& coords = getModel().getCoordinateSet();
+
+    // Posing the model with constraints assembles it, which is not done
+    // concurrently; otherwise, the frames are transformed on several copies
+    // of the working state.
+    bool constrained = getModel().getConstraintSet().getSize() > 0;
+    for (int j = 0; j < nq; j++)
+        constrained = constrained || coords[j].isConstrained(s);
+    const int numBlocks = constrained ? 1 :
+        std::max(1, std::min((int)std::thread::hardware_concurrency(),
+                             nt/100));
+
+    // Re-express the points of all forces, frame by frame, in their applied
+    // bodies (in place).
+    auto transformFrames = [&](SimTK::State& state, int begin, int end) {
+        Array<double> Q(0.0,nq);
+        for(int k=begin; k<end; ++k) {
+            // transform data on an instant-by-instant basis
+            kinematics.getData(startIndex+k, nq, &Q[0]);
+
+            // Set the coordinates values in the state in order to position the model according to specified kinematics
+            for (int j = 0; j < nq; j++)
+                coords[j].setValue(state, Q[j], constrained && j==nq-1);
+            if (!constrained)
+                getModel().getMultibodySystem().realize(state,
+                                                        SimTK::Stage::Position);
+
+            for(int f=0; f<nf; ++f) {
+                Vec3& p = points[k*nf + f];
+                p = ground.findStationLocationInAnotherFrame(state, p,
+                                                            *appliedToBodies[f]);
+            }
+        }
+    };
+
+    if (numBlocks == 1)
+        transformFrames(s, 0, nt);
+    else {
+        // The message of the error encountered by each block, if any.
+        std::vector<std::string> errors(numBlocks);
+        std::vector<SimTK::State> states(numBlocks, s);
+        auto transformBlock = [&](int b) {
+            try {
+                transformFrames(states[b], nt*b/numBlocks,
+                                nt*(b+1)/numBlocks);
+            }
+            catch (const std::exception& e) {
+                errors[b] = e.what();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int b = 1; b < numBlocks; ++b) {
+            try {
+                threads.emplace_back(transformBlock, b);
+            } catch (const std::system_error&) {
+                // Could not start a thread; transform this block here instead.
+                transformBlock(b);
+            }
+        }
+        transformBlock(0);
+        for (auto& thread : threads) thread.join();
+
+        for (const auto& errorMsg : errors) {
+            if (!errorMsg.empty())
+                throw Exception("ExternalLoads::"
+                    "transformPointsExpressedInGroundToAppliedBodies() " +
+                    errorMsg, __FILE__, __LINE__);
+        }
+        // Leave the working state at the last frame, as the serial loop does.
+        s = states[numBlocks-1];
+    }
 
-    // get from (ground) and to (applied) bodies 
-    const Ground& ground = getModel().getGround();
-    const Body& appliedToBody = getModel().getBodySet().get(exForce.getAppliedToBodyName());
-
-    /*std::map<int, int>      coordinatesToColumns;
-    // create a map entry for each coordinate 0 to nq-1, the contents of which would be -1 if not found in the file otherwise Q index
-    for (int qi=0; qi < nq; qi++) coordinatesToColumns[qi] = -1;
-    const Array<string>& kinLabels = kinematics.getColumnLabels();
-
-    for (int qj = 0; qj < nq; qj++) {
-        Coordinate& coord = _model->getCoordinateSet().get(qj);
-        int idx = kinLabels.findIndex(coord.getName());
-        if (idx!= -1) coordinatesToColumns[qj] = idx-1; // Since time is not accounted for
-    }*/
-    for(int i=startIndex; i<=lastIndex; ++i) {
-        // transform data on an instant-by-instant basis
-        kinematics.getTime(i, time);
-        kinematics.getData(i, nq, &Q[0]);
-
-        // Set the coordinates values in the state in order to position the model according to specified kinematics
-        for (int j = 0; j < nq; j++) {
-            Coordinate& coord = getModel().getCoordinateSet().get(j);
-            coord.setValue(s, Q[j], j==nq-1);
-            /*if (coordinatesToColumns[j]!=-1)
-                coord.setValue(s, Q[coordinatesToColumns[j]], j==nq-1);*/
+    // Construct a new storage to contain the re-expressed point data for each
+    // new external force.
+    for(int f=0; f<nf; ++f) {
+        const ExternalForce& exForce = *exForces[toTransform[f]];
+        Storage *newDataSource = new Storage(nt);
+        Array<string> labels;
+        labels.append("time");
+
+        const string &forceIdentifier = exForce.getForceIdentifier();
+        const string &pointIdentifier = exForce.getPointIdentifier();
+        const string &torqueIdentifier = exForce.getTorqueIdentifier();
+
+        labels.append(forceIdentifier + ".x");
+        labels.append(forceIdentifier + ".y");
+        labels.append(forceIdentifier + ".z");
+        labels.append(pointIdentifier + ".x");
+        labels.append(pointIdentifier + ".y");
+        labels.append(pointIdentifier + ".z");
+        if(exForce._appliesTorque){
+            labels.append(torqueIdentifier + ".x");
+            labels.append(torqueIdentifier + ".y");
+            labels.append(torqueIdentifier + ".z");
         }
 
-        // get force data
-        force = exForce.getForceAtTime(time);
-        if(exForce._appliesTorque)
-            torque = exForce.getTorqueAtTime(time);
-        
-        // get the untransformed point expressed in ground in the ExternalForce specified in  ground (check made above)
-        pGround = exForce.getPointAtTime(time);
-        pAppliedBody = ground.findStationLocationInAnotherFrame(s, pGround, appliedToBody);
-
-        // populate the force data for this instant in time
-        for(int j =0; j<3; ++j){
-            datarow[j] = force[j];
-            datarow[j+3] = pAppliedBody[j];
+        newDataSource->setColumnLabels(labels);
+        int ncols = labels.getSize()-1; // time treated separately when appended to storage
+
+        SimTK::Vector datarow(ncols, SimTK::NaN);
+        Vec3 force(SimTK::NaN); 
+        Vec3 torque(SimTK::NaN);
+
+        for(int k=0; k<nt; ++k) {
+            // get force data
+            force = exForce.getForceAtTime(times[k]);
             if(exForce._appliesTorque)
-                datarow[j+6] = torque[j];
+                torque = exForce.getTorqueAtTime(times[k]);
+            const Vec3& pAppliedBody = points[k*nf + f];
+
+            // populate the force data for this instant in time
+            for(int j =0; j<3; ++j){
+                datarow[j] = force[j];
+                datarow[j+3] = pAppliedBody[j];
+                if(exForce._appliesTorque)
+                    datarow[j+6] = torque[j];
+            }
+
+            newDataSource->append(times[k], datarow); 
         }
 
-        newDataSource->append(time, datarow); 
-    }
+        // assign a name to the new data source
+        newDataSource->setName(exForce.getDataSourceName() + "_transformedP");
 
-    // assign a name to the new data source
-    newDataSource->setName(exForce.getDataSourceName() + "_transformedP");
+        ExternalForce *exF_transformedPoint = exForce.clone();
+        exF_transformedPoint->setName(exForce.getName()+"_transformedP");
+        exF_transformedPoint->setPointExpressedInBodyName(exForce.getAppliedToBodyName());
+        exF_transformedPoint->setDataSource(*newDataSource);
 
-    ExternalForce *exF_transformedPoint = exForce.clone();
-    exF_transformedPoint->setName(exForce.getName()+"_transformedP");
-    exF_transformedPoint->setPointExpressedInBodyName(exForce.getAppliedToBodyName());
-    exF_transformedPoint->setDataSource(*newDataSource);
+        _storages.append(newDataSource);
 
-    _storages.append(newDataSource);
+        newDataSource->print("NewDataSource_TransformedP.sto");
 
-    newDataSource->print("NewDataSource_TransformedP.sto");
+        transformed[toTransform[f]] = exF_transformedPoint;
+    }
 
-    return exF_transformedPoint;
+    return transformed;
 }
 
 //-----------------------------------------------------------------------------
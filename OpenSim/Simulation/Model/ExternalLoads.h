@@ -30,6 +30,8 @@
 #include "OpenSim/Common/PropertyStr.h"
 #include "OpenSim/Common/PropertyDbl.h"
 
+#include <vector>
+
 namespace OpenSim {
 
 class Model;
@@ -85,6 +87,10 @@ private:
        then build new storages to be assigned to the individual ExternalForces
        with the transformed point data. Hang-on to them so we can delete them. */
     ArrayPtrs<Storage> _storages;
+    /* The data file, read once and shared by copies of this ExternalLoads
+       (e.g., in copies of the model), and the name of the file read. */
+    std::shared_ptr<const Storage> _dataFileStorage;
+    std::string _dataFileStorageName;
 
 //=============================================================================
 // METHODS
@@ -113,6 +119,14 @@ public:
 
     const std::string &getExternalLoadsModelKinematicsFileName() const { return _externalLoadsModelKinematicsFileName; }
     void setExternalLoadsModelKinematicsFileName(const std::string &aFileName) { _externalLoadsModelKinematicsFileName = aFileName; }
+    /** The files whose contents these loads were read from, read from the
+    file externalLoadsFileName: that file, the data file and, if assigned,
+    the load kinematics file. A relative path named in the file is resolved
+    against the file's directory, as it is when the loads are read. Tools
+    hash these files' contents for their ResultCache keys. */
+    std::vector<std::string> getInputFileNames(
+            const std::string& externalLoadsFileName) const;
+
     double getLowpassCutoffFrequencyForLoadKinematics() const { return _lowpassCutoffFrequencyForLoadKinematics; }
     void setLowpassCutoffFrequencyForLoadKinematics(double aLowpassCutoffFrequency) { _lowpassCutoffFrequencyForLoadKinematics = aLowpassCutoffFrequency; }
 
@@ -122,6 +136,12 @@ public:
 private:
     void setNull();
     void setupSerializedMembers();
+    // Transform the points of several forces in one pass over the kinematics.
+    // Forces that are not transformed (see
+    // transformPointsExpressedInGroundToAppliedBodies()) are null.
+    std::vector<ExternalForce*> transformPointsToAppliedBodies(
+            const std::vector<const ExternalForce*>& exForces,
+            const Storage &kinematics, double startTime, double endTime);
     std::string createIdentifier(OpenSim::Array<std::string>&oldFunctionNames, const Array<std::string>& labels);
 
     //--------------------------------------------------------------------------
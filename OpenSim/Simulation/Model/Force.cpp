@@ -89,7 +89,9 @@ void Force::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
     Super::extendAddToSystem(system);
 
-    ForceAdapter* adapter = new ForceAdapter(*this);
+    const bool computedInParallel =
+        _model->getComputesForcesInBlocks() && shouldBeParallelized();
+    ForceAdapter* adapter = new ForceAdapter(*this, computedInParallel);
     SimTK::Force::Custom force(_model->updForceSubsystem(), adapter);
 
      // Beyond the const Component get the index so we can access the SimTK::Force later
@@ -65,12 +65,14 @@ public:
 //=============================================================================
 
     /**
-    * Tell SimBody to parallelize this force. Should be 
-    * set to true for any forces that will take time to 
-    * complete their calcForce method. Note that all forces
-    * that set this flag to false will be put in series on a
-    * thread that is running in parallel with other forces
-    * that marked this flag as true.
+    * Whether computeForce() may run concurrently with that of other Forces
+    * that return true, for the same State. If so, and
+    * Model::setNumForceThreads() is not 1, the force is computed on one of
+    * several threads by the Model's ParallelForceAdapter; otherwise it is
+    * computed serially, as usual. Return true only if computeForce() does
+    * not modify anything shared with other Forces (other than the cache
+    * entries of this Force in the State and the force arrays it is given).
+    * The default is false.
     */
     virtual bool shouldBeParallelized() const
     {
@@ -99,6 +101,22 @@ public:
     getRecordValues(const SimTK::State& state) const {
         return OpenSim::Array<double>();
     };
+#ifndef SWIG
+    /**
+     * Write the values of getRecordValues() (getRecordLabels().getSize() of
+     * them) to the given array, e.g., into a row preallocated by a reporter.
+     * The default copies getRecordValues(); forces whose values are cached
+     * when the system is realized to Dynamics override this to copy them
+     * without allocating an Array. A Force that overrides getRecordValues()
+     * of a base class that overrides this must override it too.
+     */
+    virtual void copyRecordValues(const SimTK::State& state,
+                                  double* values) const {
+        const OpenSim::Array<double> recordValues = getRecordValues(state);
+        for (int i = 0; i < recordValues.getSize(); ++i)
+            values[i] = recordValues[i];
+    }
+#endif
 
 
     /** Return a flag indicating whether the Force is applied along a Path. If
@@ -229,6 +247,7 @@ private:
     void constructProperties();
 
     friend class ForceAdapter;
+    friend class ParallelForceAdapter;
 
 //=============================================================================
 };  // END of class Force
@@ -25,6 +25,12 @@
 // INCLUDES
 //=============================================================================
 #include "ForceAdapter.h"
+#include "GeometryPath.h"
+#include "Model.h"
+#include <OpenSim/Common/Parallelism.h>
+
+#include <algorithm>
+#include <exception>
 
 //=============================================================================
 // STATICS
@@ -35,7 +41,8 @@ using SimTK::Vec3;
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
-ForceAdapter::ForceAdapter(const Force& force) : _force(&force)
+ForceAdapter::ForceAdapter(const Force& force, bool computedInParallel) :
+    _force(&force), _computedInParallel(computedInParallel)
 {
 }
 
@@ -46,6 +53,8 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
+    if (_computedInParallel) return;
+    ComponentProfiler::Scope scope(*_force, ComponentProfiler::ComputeForce);
     _force->computeForce(state, bodyForces, mobilityForces);
 }
 
@@ -55,5 +64,180 @@ SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
 }
 
 bool ForceAdapter::shouldBeParallelized() const {
-    return _force->shouldBeParallelized(); 
+    return false;
+}
+
+//=============================================================================
+// PARALLEL FORCE ADAPTER
+//=============================================================================
+// Computes the forces of one block in the arrays of that block.
+class ParallelForceAdapter::ForceTask : public SimTK::ParallelExecutor::Task {
+public:
+    ForceTask(const SimTK::State& state,
+              const std::vector<const Force*>& forces, int numBlocks,
+              SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+              SimTK::Vector& mobilityForces) :
+        _state(state), _forces(forces), _numBlocks(numBlocks),
+        _bodyForces(numBlocks), _mobilityForces(numBlocks),
+        _errors(numBlocks)
+    {
+        // The first block adds its forces to the system's arrays directly.
+        _bodyForcesOf.push_back(&bodyForces);
+        _mobilityForcesOf.push_back(&mobilityForces);
+        for (int b = 1; b < numBlocks; ++b) {
+            _bodyForces[b].resize(bodyForces.size());
+            _bodyForces[b].setToZero();
+            _mobilityForces[b].resize(mobilityForces.size());
+            _mobilityForces[b].setToZero();
+            _bodyForcesOf.push_back(&_bodyForces[b]);
+            _mobilityForcesOf.push_back(&_mobilityForces[b]);
+        }
+    }
+
+    void execute(int block) override {
+        const int numForces = int(_forces.size());
+        try {
+            for (int i = numForces*block/_numBlocks;
+                    i < numForces*(block+1)/_numBlocks; ++i) {
+                ComponentProfiler::Scope scope(*_forces[i],
+                                               ComponentProfiler::ComputeForce);
+                _forces[i]->computeForce(_state, *_bodyForcesOf[block],
+                                         *_mobilityForcesOf[block]);
+            }
+        } catch (...) {
+            _errors[block] = std::current_exception();
+        }
+    }
+
+    // Add the forces of the other blocks, in order, to those of the first,
+    // and rethrow the error of the first block that failed, if any.
+    void reduce() {
+        for (const auto& error : _errors)
+            if (error) std::rethrow_exception(error);
+        for (int b = 1; b < _numBlocks; ++b) {
+            *_bodyForcesOf[0] += _bodyForces[b];
+            *_mobilityForcesOf[0] += _mobilityForces[b];
+        }
+    }
+
+private:
+    const SimTK::State& _state;
+    const std::vector<const Force*>& _forces;
+    const int _numBlocks;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>> _bodyForces;
+    std::vector<SimTK::Vector> _mobilityForces;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>*> _bodyForcesOf;
+    std::vector<SimTK::Vector*> _mobilityForcesOf;
+    std::vector<std::exception_ptr> _errors;
+};
+
+ParallelForceAdapter::ParallelForceAdapter(const Model& model,
+                                           int numThreads) :
+    _model(&model),
+    _numThreads(numThreads > 0 ? numThreads
+                               : SimTK::ParallelExecutor::getNumProcessors()),
+    _executor(new SimTK::ParallelExecutor(std::max(_numThreads, 1)))
+{
+}
+
+// Computes the paths of one block.
+class ParallelForceAdapter::PathTask : public SimTK::ParallelExecutor::Task {
+public:
+    PathTask(const SimTK::State& state,
+             const std::vector<const GeometryPath*>& paths, int numBlocks) :
+        _state(state), _paths(paths), _numBlocks(numBlocks),
+        _errors(numBlocks) {}
+
+    void execute(int block) override {
+        const int numPaths = int(_paths.size());
+        try {
+            for (int i = numPaths*block/_numBlocks;
+                    i < numPaths*(block+1)/_numBlocks; ++i)
+                _paths[i]->getLength(_state);
+        } catch (...) {
+            _errors[block] = std::current_exception();
+        }
+    }
+
+    // Rethrow the error of the first block that failed, if any.
+    void rethrow() const {
+        for (const auto& error : _errors)
+            if (error) std::rethrow_exception(error);
+    }
+
+private:
+    const SimTK::State& _state;
+    const std::vector<const GeometryPath*>& _paths;
+    const int _numBlocks;
+    std::vector<std::exception_ptr> _errors;
+};
+
+void ParallelForceAdapter::realizeTopology(SimTK::State& state) const
+{
+    _forces.clear();
+    for (const auto& force : _model->getComponentList<Force>())
+        if (force.shouldBeParallelized()) _forces.push_back(&force);
+
+    // The paths of these forces can be computed concurrently, since computing
+    // them concurrently is part of computing the forces concurrently.
+    _paths.clear();
+    _pathForces.clear();
+    if (!_model->getPrecomputePaths()) return;
+    for (const auto& path : _model->getComponentList<GeometryPath>()) {
+        if (!path.hasOwner()) continue;
+        const auto* force = dynamic_cast<const Force*>(&path.getOwner());
+        if (force && force->shouldBeParallelized()) {
+            _paths.push_back(&path);
+            _pathForces.push_back(force);
+        }
+    }
+}
+
+void ParallelForceAdapter::realizePosition(const SimTK::State& state) const
+{
+    if (_paths.empty()) return;
+    std::vector<const GeometryPath*> paths;
+    paths.reserve(_paths.size());
+    for (size_t i = 0; i < _paths.size(); ++i)
+        if (_pathForces[i]->appliesForce(state)) paths.push_back(_paths[i]);
+    if (paths.empty()) return;
+
+    const int numBlocks = SimTK::ParallelExecutor::isWorkerThread() ? 1 :
+        std::max(1, std::min(_numThreads, int(paths.size())));
+    PathTask task(state, paths, numBlocks);
+    if (numBlocks == 1)
+        task.execute(0);
+    else
+        _executor->execute(task, numBlocks);
+    task.rethrow();
+}
+
+void ParallelForceAdapter::calcForce(const SimTK::State& state,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector_<SimTK::Vec3>& particleForces,
+    SimTK::Vector& mobilityForces) const
+{
+    // Compute the controls, which are shared by all actuators, and check
+    // which forces are enabled, before computing forces concurrently.
+    if (_model->getNumControls() > 0) _model->getControls(state);
+    std::vector<const Force*> forces;
+    forces.reserve(_forces.size());
+    for (const Force* force : _forces)
+        if (force->appliesForce(state)) forces.push_back(force);
+    if (forces.empty()) return;
+
+    // Forces computed from a worker thread (e.g., of another parallel
+    // computation) are computed on that thread, in one block unless the
+    // blocks must not depend on the threads.
+    const bool onWorkerThread = SimTK::ParallelExecutor::isWorkerThread();
+    const int numBlocks =
+        onWorkerThread && !Parallelism::isDeterministic() ? 1 :
+        Parallelism::getNumBlocks(int(forces.size()), _numThreads);
+    ForceTask task(state, forces, numBlocks, bodyForces, mobilityForces);
+    if (numBlocks == 1 || onWorkerThread || _numThreads == 1) {
+        for (int block = 0; block < numBlocks; ++block) task.execute(block);
+    } else {
+        _executor->execute(task, numBlocks);
+    }
+    task.reduce();
 }
\ No newline at end of file
@@ -30,8 +30,14 @@
 
 #include <SimTKsimbody.h>
 
+#include <memory>
+#include <vector>
+
 namespace OpenSim {
 
+class Model;
+class GeometryPath;
+
 //=============================================================================
 //=============================================================================
 /**
@@ -46,13 +52,15 @@ class OSIMSIMULATION_API ForceAdapter : public SimTK::Force::Custom::Implementat
 //=============================================================================
 private:
     const Force* _force;
+    // The force is computed by the Model's ParallelForceAdapter instead.
+    bool _computedInParallel;
 
 //=============================================================================
 // METHODS
 //=============================================================================
 public:
     // CONSTRUCTION AND DESTRUCTION
-    ForceAdapter(const Force& force);
+    ForceAdapter(const Force& force, bool computedInParallel = false);
 
     // CALC FORCES (Called by Simbody)
     void calcForce(const SimTK::State& state,
@@ -62,13 +70,84 @@ public:
     // CALC POTENTIAL ENERGY (Called by Simbody)
     SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override;   
 
-    // SIMBODY PARALLELISM FLAG 
-    bool shouldBeParallelized() const;
+    // SIMBODY PARALLELISM FLAG: always false; forces are computed in
+    // parallel by a ParallelForceAdapter, if at all.
+    bool shouldBeParallelized() const override;
 
     // No need to override realize() methods; we don't provide that service
     // to OpenSim Force elements.
 };
 
+//=============================================================================
+//=============================================================================
+/**
+ * A single SimTK::Force that computes, on several threads, the forces of a
+ * Model that can be computed concurrently with one another (those whose
+ * Force::shouldBeParallelized() is true). The Model creates one when
+ * Model::getComputesForcesInBlocks() (e.g., Model::setNumForceThreads() is
+ * not 1), and the ForceAdapters of these forces then leave the computation
+ * to it.
+ *
+ * The forces are divided into as many contiguous blocks (in the order of
+ * the Model's component list) as there are threads. Each block accumulates
+ * its forces in its own body and mobility force arrays, which are added to
+ * the system's arrays in the order of the blocks, so the result does not
+ * depend on the scheduling of the threads. The result may differ from that
+ * of the serial computation, or of a different number of threads, by
+ * round-off, since the forces are summed in a different order; in
+ * deterministic mode (see Parallelism), the number of blocks does not depend
+ * on the number of threads, so neither does the result.
+ *
+ * If Model::setPrecomputePaths() is set, the adapter also computes, when the
+ * Position stage is realized, the GeometryPaths (path points, including
+ * conditional and moving points, wrapping and length) of these forces, on
+ * as many threads, so that the paths are available to any computation that
+ * follows (e.g., the computation of the forces, or of analyses).
+ */
+class OSIMSIMULATION_API ParallelForceAdapter
+        : public SimTK::Force::Custom::Implementation
+{
+public:
+    ParallelForceAdapter(const Model& model, int numThreads);
+
+    void calcForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector_<SimTK::Vec3>& particleForces,
+        SimTK::Vector& mobilityForces) const override;
+
+    // The potential energy of each force is computed by its ForceAdapter.
+    SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override
+    {   return 0; }
+
+    // Gathers the forces to compute (and their paths), once all forces have
+    // been added to the System.
+    void realizeTopology(SimTK::State& state) const override;
+
+    // Computes the paths of the enabled forces, if the Model precomputes
+    // paths. The matter subsystem has realized Position already.
+    void realizePosition(const SimTK::State& state) const override;
+
+    int getNumThreads() const { return _numThreads; }
+    /** The forces computed by this adapter, as of realizeTopology(). */
+    const std::vector<const Force*>& getForces() const { return _forces; }
+    /** The paths of these forces that are computed when realizing Position,
+    as of realizeTopology(); empty unless the Model precomputes paths. */
+    const std::vector<const GeometryPath*>& getPaths() const
+    {   return _paths; }
+
+private:
+    class ForceTask;
+    class PathTask;
+
+    const Model* _model;
+    int _numThreads;
+    mutable std::vector<const Force*> _forces;
+    // The paths and the Force that owns each of them.
+    mutable std::vector<const GeometryPath*> _paths;
+    mutable std::vector<const Force*> _pathForces;
+    std::unique_ptr<SimTK::ParallelExecutor> _executor;
+};
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_FORCE_ADAPTER_H_
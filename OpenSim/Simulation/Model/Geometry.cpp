@@ -25,6 +25,9 @@
 // INCLUDES
 //=============================================================================
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
 #include "Frame.h"
 #include "Geometry.h"
 #include "Model.h"
@@ -33,6 +36,35 @@
 //=============================================================================
 using namespace std;
 using namespace OpenSim;
+
+namespace {
+    // The mesh files loaded by Mesh components, by absolute file name, with
+    // the modification time of the file when it was loaded. Meshes of any
+    // model whose files resolve to the same file share its mesh.
+    struct CachedMeshFile {
+        time_t modificationTime;
+        std::shared_ptr<SimTK::DecorativeMeshFile> mesh;
+    };
+    std::mutex meshCacheMutex;
+    bool meshLoadingEnabled = true;
+    std::map<string, CachedMeshFile> meshCache;
+
+    // Held while the polygons of a shared mesh are read, or the mesh is
+    // copied, since the mesh reads its file the first time it is used.
+    std::mutex meshLoadMutex;
+    // The meshes whose polygons have been read, for estimateMemoryUsage();
+    // an address reused by another mesh does not match its weak pointer.
+    // Guarded by meshLoadMutex.
+    std::map<const SimTK::DecorativeMeshFile*,
+             std::weak_ptr<SimTK::DecorativeMeshFile>> loadedMeshes;
+
+    bool getModificationTime(const string& fileName, time_t& time) {
+        struct stat info;
+        if (stat(fileName.c_str(), &info) != 0) return false;
+        time = info.st_mtime;
+        return true;
+    }
+}
 using namespace SimTK;
 
 OpenSim_DEFINE_SOCKET_FD(frame, Geometry);
@@ -216,6 +248,14 @@ void FrameGeometry::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::Decor
 void Mesh::extendFinalizeFromProperties() {
 
     if (!isObjectUpToDateWithProperties()) {
+        // A copy of a Mesh starts with the original's cached mesh; it is
+        // kept below only if it is still for the same file.
+        std::shared_ptr<SimTK::DecorativeMeshFile> previousMesh;
+        previousMesh.swap(cachedMesh);
+
+        // Nothing is looked for or read if mesh loading is disabled.
+        if (!getMeshLoadingEnabled()) return;
+
         const Component* rootModel = nullptr;
         if (!hasOwner()) {
             std::cout << "Mesh " << get_mesh_file() << " not connected to model..ignoring" << std::endl;
@@ -289,20 +329,82 @@ void Mesh::extendFinalizeFromProperties() {
             return;
         }
 
-        cachedMesh.reset(new DecorativeMeshFile(attempts.back().c_str()));
+        // Use the mesh of the file loaded before, by this Mesh or any other,
+        // unless the file has been modified since.
+        const string& meshFile = attempts.back();
+        time_t modificationTime = 0;
+        getModificationTime(meshFile, modificationTime);
+        std::lock_guard<std::mutex> lock(meshCacheMutex);
+        auto it = meshCache.find(meshFile);
+        if (it != meshCache.end() &&
+                it->second.modificationTime == modificationTime) {
+            cachedMesh = it->second.mesh;
+            return;
+        }
+        if (previousMesh && previousMesh->getMeshFile() == meshFile &&
+                it == meshCache.end()) {
+            cachedMesh = previousMesh;
+        } else {
+            cachedMesh.reset(new DecorativeMeshFile(meshFile.c_str()));
+        }
+        CachedMeshFile& cached = meshCache[meshFile];
+        cached.modificationTime = modificationTime;
+        cached.mesh = cachedMesh;
     }
 }
 
+void Mesh::setMeshLoadingEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    meshLoadingEnabled = enabled;
+}
+
+bool Mesh::getMeshLoadingEnabled()
+{
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    return meshLoadingEnabled;
+}
+
+void Mesh::clearMeshCache()
+{
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    meshCache.clear();
+}
+
+int Mesh::getMeshCacheSize()
+{
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    return int(meshCache.size());
+}
+
+
+void Mesh::extendEstimateMemoryUsage(MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    if (!cachedMesh) return;
+    std::lock_guard<std::mutex> lock(meshLoadMutex);
+    // A mesh that has not been drawn has not read its file.
+    auto it = loadedMeshes.find(cachedMesh.get());
+    if (it == loadedMeshes.end() || it->second.lock() != cachedMesh) return;
+    const SimTK::PolygonalMesh& mesh = cachedMesh->getMesh();
+    size_t bytes = size_t(mesh.getNumVertices()) * sizeof(SimTK::Vec3);
+    for (int face = 0; face < mesh.getNumFaces(); ++face) {
+        bytes += size_t(mesh.getNumVerticesForFace(face) + 1) * sizeof(int);
+    }
+    usage.addShared(MemoryUsage::Meshes, cachedMesh.get(), bytes);
+}
 
 void Mesh::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const
 {
     if (cachedMesh.get() != nullptr) {
+        std::lock_guard<std::mutex> lock(meshLoadMutex);
         try {
             // Force the loading of the mesh to see if it has bad contents
             // (e.g., binary vtp).
             // We do not want to do this in extendFinalizeFromProperties b/c
             // it's expensive to repeatedly load meshes.
             cachedMesh->getMesh();
+            loadedMeshes[cachedMesh.get()] = cachedMesh;
         } catch (const std::exception& e) {
             std::cout << "Visualizer couldn't open "
                 << get_mesh_file() << " because:\n"
@@ -311,7 +413,10 @@ void Mesh::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeom
             cachedMesh.reset();
             return;
         }
-        cachedMesh->setScaleFactors(get_scale_factors());
-        decoGeoms.push_back(*cachedMesh);
+        // The cached mesh may be shared with copies of this Mesh, so do not
+        // modify it.
+        SimTK::DecorativeMeshFile deco(*cachedMesh);
+        deco.setScaleFactors(get_scale_factors());
+        decoGeoms.push_back(deco);
     }
 }
@@ -579,6 +579,12 @@ protected:
 /**
 * A class to represent Mesh geometry that comes from a file.
 * Supported file formats .vtp, .stl, .obj but will grow over time
+*
+* Each mesh file is loaded once per process: the Mesh%es of all models (and
+* their copies) whose files resolve to the same file share its mesh, as long
+* as the file has not been modified since it was loaded. Mesh loading can be
+* disabled for programs that do not visualize models; see
+* setMeshLoadingEnabled().
 */
 class OSIMSIMULATION_API Mesh : public Geometry
 {
@@ -610,9 +616,23 @@ public:
     {
         return get_mesh_file();
     };
+
+    /** Enable or disable loading of mesh files by the Mesh%es finalized
+    afterwards (enabled by default). With loading disabled, Mesh%es neither
+    look for nor read their files, and are not drawn; use this in programs
+    that do not visualize models. */
+    static void setMeshLoadingEnabled(bool enabled);
+    static bool getMeshLoadingEnabled();
+    /** Discard the meshes kept by the process-wide mesh cache. Mesh%es that
+    use a discarded mesh keep it until they are finalized again. */
+    static void clearMeshCache();
+    /** The number of mesh files held by the mesh cache. */
+    static int getMeshCacheSize();
 protected:
     // ModelComponent interface.
     void extendFinalizeFromProperties() override;
+    // Add the polygons of the mesh, once they have been read.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
 
 protected:
     /// Method to map Mesh to Array of SimTK::DecorativeGeometry.
@@ -621,8 +641,10 @@ protected:
 private:
     // We cache the DecorativeMeshFile if we successfully
     // load the mesh from file so we don't try loading from disk every frame.
+    // Copies of this Mesh share the cached mesh (and therefore its polygons,
+    // once loaded) as long as their mesh file resolves to the same file.
     // This is mutable since it is not part of the public interface.
-    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::DecorativeMeshFile>> cachedMesh;
+    mutable std::shared_ptr<SimTK::DecorativeMeshFile> cachedMesh;
 };
 
 /**
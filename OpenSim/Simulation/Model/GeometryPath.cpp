@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "Model.h"
 
+#include <mutex>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -39,6 +41,11 @@ using namespace OpenSim;
 using namespace SimTK;
 using SimTK::Vec3;
 
+namespace {
+// Guards the creation of the moment-arm solvers of all paths.
+std::mutex maSolverMutex;
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -68,6 +75,19 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // (i.e., the set of currently active points is numbered
     // 1, 2, 3, ...).
     namePathPoints(0);
+
+    _surrogateCoordinates.clear();
+    if (hasPolynomialSurrogate()) {
+        const PolynomialPathSurrogate& surrogate = get_polynomial_surrogate();
+        const CoordinateSet& coordSet = aModel.getCoordinateSet();
+        for (int j = 0; j < surrogate.getNumCoordinates(); ++j) {
+            const std::string& name = surrogate.get_coordinates(j);
+            OPENSIM_THROW_IF_FRMOBJ(!coordSet.contains(name), Exception,
+                "Coordinate '" + name + "' of the polynomial surrogate was "
+                "not found in the model.");
+            _surrogateCoordinates.emplace_back(&coordSet.get(name));
+        }
+    }
 }
 
 //_____________________________________________________________________________
@@ -81,23 +101,47 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // Allocate cache entries to save the current length and speed(=d/dt length)
     // of the path in the cache. Length depends only on q's so will be valid
     // after Position stage, speed requires u's also so valid at Velocity stage.
-    addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
-    addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
+    _lengthCV = addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
+    _speedCV = addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
     // Cache the set of points currently defining this path.
     Array<AbstractPathPoint *> pathPrototype;
-    addCacheVariable<Array<AbstractPathPoint *> >
+    _currentPathCV = addCacheVariable<Array<AbstractPathPoint *> >
         ("current_path", pathPrototype, SimTK::Stage::Position);
 
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
-    addCacheVariable<SimTK::Vec3>("color", get_Appearance().get_color(), 
-                                  SimTK::Stage::Topology);
+    _colorCV = addCacheVariable<SimTK::Vec3>("color",
+            get_Appearance().get_color(), SimTK::Stage::Topology);
+
+    // Scratch space, never marked valid.
+    _jacobianBodyForcesCV = addCacheVariable("jacobian_body_forces",
+            SimTK::Vector_<SimTK::SpatialVec>(), SimTK::Stage::Topology);
+    _jacobianMobilityForcesCV = addCacheVariable("jacobian_mobility_forces",
+            SimTK::Vector(), SimTK::Stage::Topology);
+    _decorationsCV = addCacheVariable("decorations",
+            SimTK::Array_<SimTK::DecorativeGeometry>(),
+            SimTK::Stage::Topology);
+
+    if (hasPolynomialSurrogate()) {
+        const int n = get_polynomial_surrogate().getNumCoordinates();
+        _surrogateLengthCV = addCacheVariable<double>("surrogate_length", 0.0,
+                SimTK::Stage::Position);
+        _surrogateGradientCV = addCacheVariable("surrogate_gradient",
+                SimTK::Vector(n, 0.0), SimTK::Stage::Position);
+        // Scratch space, never marked valid.
+        _surrogateQCV = addCacheVariable("surrogate_q",
+                SimTK::Vector(n, 0.0), SimTK::Stage::Topology);
+        _surrogateWorkspaceCV = addCacheVariable("surrogate_workspace",
+                SimTK::Vector(n*(get_polynomial_surrogate().get_order() + 1),
+                              0.0),
+                SimTK::Stage::Topology);
+    }
 }
 
  void GeometryPath::extendInitStateFromProperties(SimTK::State& s) const
 {
     Super::extendInitStateFromProperties(s);
-    markCacheVariableValid(s, "color"); // it is OK at its default value
+    markCacheVariableValid(s, _colorCV); // it is OK at its default value
 }
 
 //------------------------------------------------------------------------------
@@ -126,12 +170,46 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
 
     assert(pathPoints.size() > 1);
 
-    const AbstractPathPoint* lastPoint = pathPoints[0];
+    // The decorations drawn with this State before are reused, updating only
+    // their positions and colors, as long as the path has the same points
+    // and wrapping points; the rest are made anew.
+    Array_<DecorativeGeometry>& decorations =
+        updCacheVariableValue(state, _decorationsCV);
+    unsigned numDrawn = 0;
+    const Vec3 color = getColor(state);
     MobilizedBodyIndex mbix(0);
+    auto drawPoint = [&](const Vec3& pos) {
+        if (numDrawn < decorations.size() &&
+                DecorativeSphere::isInstanceOf(decorations[numDrawn])) {
+            DecorativeSphere::updDowncast(decorations[numDrawn])
+                .setTransform(pos).setColor(color);
+        } else {
+            decorations.resize(numDrawn);
+            DefaultGeometry::drawPathPoint(mbix, pos, color, decorations);
+        }
+        ++numDrawn;
+    };
+    // Line segments will be in ground frame
+    auto drawSegment = [&](const Vec3& from, const Vec3& to, int index) {
+        if (numDrawn < decorations.size() &&
+                DecorativeLine::isInstanceOf(decorations[numDrawn])) {
+            DecorativeLine::updDowncast(decorations[numDrawn])
+                .setPoint1(from).setPoint2(to).setColor(color)
+                .setIndexOnBody(index);
+        } else {
+            decorations.resize(numDrawn);
+            decorations.push_back(DecorativeLine(from, to)
+                .setLineThickness(4)
+                .setColor(color).setBodyId(0).setIndexOnBody(index));
+        }
+        ++numDrawn;
+    };
+
+    const AbstractPathPoint* lastPoint = pathPoints[0];
 
     Vec3 lastPos = lastPoint->getLocationInGround(state);
     if (hints.get_show_path_points())
-        DefaultGeometry::drawPathPoint(mbix, lastPos, getColor(state), appendToThis);
+        drawPoint(lastPos);
 
     Vec3 pos;
 
@@ -151,38 +229,42 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
                 // transform the surface point into the Ground reference frame
                 pos = X_BG*surfacePoints[j];
                 if (hints.get_show_path_points())
-                    DefaultGeometry::drawPathPoint(mbix, pos, getColor(state),
-                        appendToThis);
-                // Line segments will be in ground frame
-                appendToThis.push_back(DecorativeLine(lastPos, pos)
-                    .setLineThickness(4)
-                    .setColor(getColor(state)).setBodyId(0).setIndexOnBody(j));
+                    drawPoint(pos);
+                drawSegment(lastPos, pos, j);
                 lastPos = pos;
             }
         } 
         else { // otherwise a regular PathPoint so just draw its location
             pos = point->getLocationInGround(state);
             if (hints.get_show_path_points())
-                DefaultGeometry::drawPathPoint(mbix, pos, getColor(state),
-                    appendToThis);
-            // Line segments will be in ground frame
-            appendToThis.push_back(DecorativeLine(lastPos, pos)
-                .setLineThickness(4)
-                .setColor(getColor(state)).setBodyId(0).setIndexOnBody(i));
+                drawPoint(pos);
+            drawSegment(lastPos, pos, i);
             lastPos = pos;
         }
     }
+
+    for (unsigned i = 0; i < numDrawn; ++i)
+        appendToThis.push_back(decorations[i]);
 }
 
 //_____________________________________________________________________________
 /*
  * Connect properties to local pointers.
  */
+void GeometryPath::extendEstimateMemoryUsage(MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage.add(MemoryUsage::Paths, _surrogateCoordinates.capacity() *
+            sizeof(SimTK::ReferencePtr<const Coordinate>));
+}
+
 void GeometryPath::constructProperties()
 {
     constructProperty_PathPointSet(PathPointSet());
 
     constructProperty_PathWrapSet(PathWrapSet());
+
+    constructProperty_polynomial_surrogate();
     
     Vec3 defaultColor = SimTK::Gray;
     Appearance appearance;
@@ -221,15 +303,28 @@ const OpenSim::Array <AbstractPathPoint*> & GeometryPath::
 getCurrentPath(const SimTK::State& s)  const
 {
     computePath(s);   // compute checks if path needs to be recomputed
-    return getCacheVariableValue< Array<AbstractPathPoint*> >(s, "current_path");
+    return getCacheVariableValue(s, _currentPathCV);
 }
 
 // get the path as PointForceDirections directions 
 // CAUTION: the return points are heap allocated; you must delete them yourself! 
-// (TODO: that is really lame)
 void GeometryPath::
 getPointForceDirections(const SimTK::State& s, 
                         OpenSim::Array<PointForceDirection*> *rPFDs) const
+{
+    std::vector<PointForceDirection> pfds;
+    getPointForceDirections(s, pfds);
+
+    rPFDs->ensureCapacity(rPFDs->getSize() + int(pfds.size()));
+    for (const auto& pfd : pfds)
+        rPFDs->append(new PointForceDirection(pfd));
+}
+
+// get the path as PointForceDirections directions, in a vector whose storage
+// is reused
+void GeometryPath::
+getPointForceDirections(const SimTK::State& s,
+                        std::vector<PointForceDirection>& pfds) const
 {
     int i;
     AbstractPathPoint* start;
@@ -239,13 +334,13 @@ getPointForceDirections(const SimTK::State& s,
     const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
 
     int np = currentPath.getSize();
-    rPFDs->ensureCapacity(np);
-    
+    // clear() keeps the capacity of the vector.
+    pfds.clear();
+    pfds.reserve(np);
+
     for (i = 0; i < np; i++) {
-        PointForceDirection *pfd = 
-            new PointForceDirection(currentPath[i]->getLocation(s), 
-                                    currentPath[i]->getParentFrame(), Vec3(0));
-        rPFDs->append(pfd);
+        pfds.emplace_back(currentPath[i]->getLocation(s), 
+                          currentPath[i]->getParentFrame(), Vec3(0));
     }
 
     for (i = 0; i < np-1; i++) {
@@ -282,8 +377,8 @@ getPointForceDirections(const SimTK::State& s,
             }
 
             // Get resultant direction at each point 
-            rPFDs->get(i)->addToDirection(direction);
-            rPFDs->get(i+1)->addToDirection(-direction);
+            pfds[i].addToDirection(direction);
+            pfds[i+1].addToDirection(-direction);
         }
     }
 }
@@ -294,6 +389,31 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     const double& tension, 
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
     SimTK::Vector& mobilityForces) const
+{
+    if (!hasPolynomialSurrogate()) {
+        addInGeometricEquivalentForces(s, tension, bodyForces, mobilityForces);
+        return;
+    }
+
+    // The generalized force on each coordinate is the tension times the
+    // moment arm, the negative of the derivative of the length.
+    computeSurrogate(s);
+    const SimTK::Vector& gradient =
+        getCacheVariableValue(s, _surrogateGradientCV);
+    const SimTK::SimbodyMatterSubsystem& matter =
+                                        getModel().getMatterSubsystem();
+    for (size_t j = 0; j < _surrogateCoordinates.size(); ++j) {
+        const Coordinate& coord = *_surrogateCoordinates[j];
+        matter.getMobilizedBody(coord.getBodyIndex()).applyOneMobilityForce(s,
+            coord.getMobilizerQIndex(), -tension*gradient[int(j)],
+            mobilityForces);
+    }
+}
+
+void GeometryPath::addInGeometricEquivalentForces(const SimTK::State& s,
+    double tension,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector& mobilityForces) const
 {
     AbstractPathPoint* start = NULL;
     AbstractPathPoint* end = NULL;
@@ -437,24 +557,33 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
  * @return Total length of the path.
  */
 double GeometryPath::getLength( const SimTK::State& s) const
+{
+    if (hasPolynomialSurrogate()) {
+        computeSurrogate(s);
+        return getCacheVariableValue(s, _surrogateLengthCV);
+    }
+    return calcGeometricLength(s);
+}
+
+double GeometryPath::calcGeometricLength(const SimTK::State& s) const
 {
     computePath(s);  // compute checks if path needs to be recomputed
-    return( getCacheVariableValue<double>(s, "length") );
+    return( getCacheVariableValue(s, _lengthCV) );
 }
 
 void GeometryPath::setLength( const SimTK::State& s, double length ) const
 {
-    setCacheVariableValue<double>(s, "length", length); 
+    setCacheVariableValue(s, _lengthCV, length); 
 }
 
 void GeometryPath::setColor(const SimTK::State& s, const SimTK::Vec3& color) const
 {
-    setCacheVariableValue<SimTK::Vec3>(s, "color", color);
+    setCacheVariableValue(s, _colorCV, color);
 }
 
 Vec3 GeometryPath::getColor(const SimTK::State& s) const
 {
-    return getCacheVariableValue<SimTK::Vec3>(s, "color");
+    return getCacheVariableValue(s, _colorCV);
 }
 
 //_____________________________________________________________________________
@@ -466,11 +595,11 @@ Vec3 GeometryPath::getColor(const SimTK::State& s) const
 double GeometryPath::getLengtheningSpeed( const SimTK::State& s) const
 {
     computeLengtheningSpeed(s);
-    return getCacheVariableValue<double>(s, "speed");
+    return getCacheVariableValue(s, _speedCV);
 }
 void GeometryPath::setLengtheningSpeed( const SimTK::State& s, double speed ) const
 {
-    setCacheVariableValue<double>(s, "speed", speed);    
+    setCacheVariableValue(s, _speedCV, speed);    
 }
 
 void GeometryPath::setPreScaleLength( const SimTK::State& s, double length ) {
@@ -800,27 +929,49 @@ void GeometryPath::computePath(const SimTK::State& s) const
 {
     //const SimTK::Stage& sg = s.getSystemStage();
     
-    if (isCacheVariableValid(s, "current_path"))  {
+    if (isCacheVariableValid(s, _currentPathCV))  {
         return;
     }
 
-    // Clear the current path.
+    ComponentProfiler::Scope scope(*this, ComponentProfiler::ComputePath);
+
+    // The path computed last with this State (the cache entry keeps its
+    // value when it is invalidated). Drop its wrap points, which are found
+    // anew below.
     Array<AbstractPathPoint*>& currentPath = 
-        updCacheVariableValue<Array<AbstractPathPoint*> >(s, "current_path");
-    currentPath.setSize(0);
+        updCacheVariableValue(s, _currentPathCV);
+    int numKept = 0;
+    for (int j = 0; j < currentPath.getSize(); j++) {
+        if (currentPath[j]->getWrapObject() == nullptr)
+            currentPath[numKept++] = currentPath[j];
+    }
+    currentPath.setSize(numKept);
 
-    // Add the active fixed and moving via points to the path.
+    // Update the active fixed and moving via points of the path. Usually the
+    // same points are active as last time, and the path is left as it is;
+    // otherwise, it is rebuilt from the first point that differs. Only
+    // ConditionalPathPoints need to be checked for being active.
+    int k = 0;
     for (int i = 0; i < get_PathPointSet().getSize(); i++) {
-        if (get_PathPointSet()[i].isActive(s))
-            currentPath.append(&get_PathPointSet()[i]); // <--- !!!!BAD
+        AbstractPathPoint* point = &get_PathPointSet()[i];
+        if (!_pathPointsAlwaysActive && !point->isActive(s))
+            continue;
+        if (k < currentPath.getSize() && currentPath[k] == point) {
+            ++k;
+            continue;
+        }
+        currentPath.setSize(k);
+        currentPath.append(point);
+        ++k;
     }
+    currentPath.setSize(k);
   
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
     applyWrapObjects(s, currentPath);
     calcLengthAfterPathComputation(s, currentPath);
 
-    markCacheVariableValid(s, "current_path");
+    markCacheVariableValid(s, _currentPathCV);
 }
 
 //_____________________________________________________________________________
@@ -829,9 +980,22 @@ void GeometryPath::computePath(const SimTK::State& s) const
  */
 void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
 {
-    if (isCacheVariableValid(s, "speed"))
+    if (isCacheVariableValid(s, _speedCV))
         return;
 
+    if (hasPolynomialSurrogate()) {
+        computeSurrogate(s);
+        const SimTK::Vector& gradient =
+            getCacheVariableValue(s, _surrogateGradientCV);
+        double speed = 0.0;
+        for (size_t j = 0; j < _surrogateCoordinates.size(); ++j) {
+            speed += gradient[int(j)] *
+                     _surrogateCoordinates[j]->getSpeedValue(s);
+        }
+        setLengtheningSpeed(s, speed);
+        return;
+    }
+
     const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
 
     double speed = 0.0;
@@ -853,6 +1017,16 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
     if (get_PathWrapSet().getSize() < 1)
         return;
 
+    // Inactive wrap objects add no points to the path (it holds none of
+    // their wrap points on entry).
+    bool anyActive = false;
+    for (int i = 0; i < get_PathWrapSet().getSize() && !anyActive; i++) {
+        const WrapObject* wo = get_PathWrapSet().get(i).getWrapObject();
+        anyActive = wo != nullptr && wo->get_active();
+    }
+    if (!anyActive)
+        return;
+
     WrapResult best_wrap;
     Array<int> result, order;
 
@@ -974,7 +1148,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             best_wrap = wr;
                             // Store the best wrap in the pathWrap for possible 
                             // use next time.
-                            ws.setPreviousWrap(wr);
+                            ws.setPreviousWrap(s, wr);
                             break;
                         }  else if (result[i] == WrapObject::wrapped) {
                             // "wrapped" means the path segment was wrapped over
@@ -988,7 +1162,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                                 best_wrap = wr;
                                 // Store the best wrap in the pathWrap for 
                                 // possible use next time
-                                ws.setPreviousWrap(wr);
+                                ws.setPreviousWrap(s, wr);
                                 min_length_change = path_length_change;
                             } else {
                                 // The wrap was not shorter than the current 
@@ -1006,7 +1180,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                 ws.updWrapPoint2().getWrapPath().setSize(0);
 
                 if (best_wrap.wrap_pts.getSize() == 0) {
-                    ws.resetPreviousWrap();
+                    ws.resetPreviousWrap(s);
                     ws.updWrapPoint2().getWrapPath().setSize(0);
                 } else {
                     // If wrapping did occur, copy wrap info into the PathStruct.
@@ -1134,10 +1308,204 @@ calcLengthAfterPathComputation(const SimTK::State& s,
 double GeometryPath::
 computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
 {
+    if (hasPolynomialSurrogate()) {
+        for (size_t j = 0; j < _surrogateCoordinates.size(); ++j) {
+            if (_surrogateCoordinates[j].get() == &aCoord) {
+                computeSurrogate(s);
+                return -getCacheVariableValue(s,
+                                              _surrogateGradientCV)[int(j)];
+            }
+        }
+        return 0.0;
+    }
+
+    return getMomentArmSolver().solve(s, aCoord,  *this);
+}
+
+const MomentArmSolver& GeometryPath::getMomentArmSolver() const
+{
+    // The solver is made by the first call (from any thread) that needs it;
+    // the solver itself may be used by several threads at once.
+    std::lock_guard<std::mutex> lock(maSolverMutex);
     if (!_maSolver)
         const_cast<Self*>(this)->_maSolver.reset(new MomentArmSolver(*_model));
+    return *_maSolver;
+}
+
+void GeometryPath::computeLengthJacobian(const SimTK::State& s,
+                                         SimTK::Vector& dLdu) const
+{
+    const SimTK::SimbodyMatterSubsystem& matter =
+                                        getModel().getMatterSubsystem();
+
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces =
+        updCacheVariableValue(s, _jacobianBodyForcesCV);
+    if (bodyForces.size() != matter.getNumBodies())
+        bodyForces.resize(matter.getNumBodies());
+    bodyForces.setToZero();
+    SimTK::Vector& mobilityForces =
+        updCacheVariableValue(s, _jacobianMobilityForcesCV);
+    if (mobilityForces.size() != s.getNU())
+        mobilityForces.resize(s.getNU());
+    mobilityForces.setToZero();
+    if (dLdu.size() != s.getNU())
+        dLdu.resize(s.getNU());
+
+    // The generalized forces of a unit tension are -dL/du (the tension does
+    // positive work as the path shortens).
+    addInEquivalentForces(s, 1.0, bodyForces, mobilityForces);
+    matter.multiplyBySystemJacobianTranspose(s, bodyForces, dLdu);
+    dLdu += mobilityForces;
+    dLdu.negateInPlace();
+}
+
+void GeometryPath::computeMomentArms(const SimTK::State& s,
+        const std::vector<const Coordinate*>& coordinates,
+        SimTK::Vector& momentArms) const
+{
+    SimTK::Vector jacobian;
+    computeLengthJacobian(s, jacobian);
+
+    const SimTK::SimbodyMatterSubsystem& matter =
+                                        getModel().getMatterSubsystem();
+    if (momentArms.size() != int(coordinates.size()))
+        momentArms.resize(int(coordinates.size()));
+    for (int j = 0; j < momentArms.size(); ++j) {
+        const Coordinate& coord = *coordinates[j];
+        const int uIndex = matter.getMobilizedBody(coord.getBodyIndex())
+                .getFirstUIndex(s) + coord.getMobilizerQIndex();
+        momentArms[j] = -jacobian[uIndex];
+    }
+}
+
+void GeometryPath::computeSurrogate(const SimTK::State& s) const
+{
+    if (isCacheVariableValid(s, _surrogateLengthCV))
+        return;
+
+    SimTK::Vector& q = updCacheVariableValue(s, _surrogateQCV);
+    for (size_t j = 0; j < _surrogateCoordinates.size(); ++j)
+        q[int(j)] = _surrogateCoordinates[j]->getValue(s);
 
-    return _maSolver->solve(s, aCoord,  *this);
+    SimTK::Vector& gradient = updCacheVariableValue(s, _surrogateGradientCV);
+    const double length = get_polynomial_surrogate().calcValueAndGradient(q,
+            gradient, updCacheVariableValue(s, _surrogateWorkspaceCV));
+    markCacheVariableValid(s, _surrogateGradientCV);
+    setCacheVariableValue(s, _surrogateLengthCV, length);
+}
+
+PolynomialPathSurrogate GeometryPath::fitPolynomialSurrogate(
+        const SimTK::State& s, const std::vector<std::string>& coordinateNames,
+        int order, int numSamples) const
+{
+    const CoordinateSet& coordSet = getModel().getCoordinateSet();
+    std::vector<const Coordinate*> coords;
+    std::vector<SimTK::Vec2> ranges;
+    for (const auto& name : coordinateNames) {
+        OPENSIM_THROW_IF_FRMOBJ(!coordSet.contains(name), Exception,
+            "Coordinate '" + name + "' was not found in the model.");
+        coords.push_back(&coordSet.get(name));
+        ranges.emplace_back(coords.back()->getRangeMin(),
+                            coords.back()->getRangeMax());
+    }
+    PolynomialPathSurrogate surrogate(coordinateNames, ranges, order);
+    surrogate.setName(getName() + "_surrogate");
+
+    const int n = surrogate.getNumCoordinates();
+    const int numTerms = surrogate.getNumTerms();
+    if (numSamples < 0)
+        numSamples = 10*numTerms;
+    OPENSIM_THROW_IF_FRMOBJ(numSamples*(n + 1) < numTerms, Exception,
+        "Expected at least " + std::to_string(numTerms/(n + 1) + 1) +
+        " samples to fit " + std::to_string(numTerms) + " coefficients.");
+
+    const MomentArmSolver& maSolver = getMomentArmSolver();
+
+    // Sample the length and the moment arms from the path geometry at random
+    // values of the coordinates.
+    SimTK::Random::Uniform random(0.0, 1.0);
+    random.setSeed(0);
+    SimTK::State sample = s;
+    SimTK::Vector q(n);
+    auto takeSample = [&](SimTK::Vector& momentArms) {
+        for (int j = 0; j < n; ++j) {
+            q[j] = ranges[j][0] + random.getValue()*(ranges[j][1] - ranges[j][0]);
+            coords[j]->setValue(sample, q[j], false);
+        }
+        getModel().getMultibodySystem().realize(sample, SimTK::Stage::Position);
+        momentArms.resize(n);
+        for (int j = 0; j < n; ++j)
+            momentArms[j] = maSolver.solve(sample, *coords[j], *this);
+        return calcGeometricLength(sample);
+    };
+
+    // Each sample gives one equation for the length and one per moment arm
+    // (the negative of the partial derivative of the length).
+    SimTK::Matrix A(numSamples*(n + 1), numTerms);
+    SimTK::Vector b(numSamples*(n + 1));
+    SimTK::Vector values, momentArms;
+    SimTK::Matrix gradients;
+    for (int i = 0; i < numSamples; ++i) {
+        const double length = takeSample(momentArms);
+        surrogate.calcTerms(q, values, gradients);
+        const int row = i*(n + 1);
+        A[row] = ~values;
+        b[row] = length;
+        for (int j = 0; j < n; ++j) {
+            A[row + 1 + j] = gradients[j];
+            b[row + 1 + j] = -momentArms[j];
+        }
+    }
+    SimTK::Vector coefficients;
+    SimTK::FactorQTZ(A).solve(b, coefficients);
+    for (int t = 0; t < numTerms; ++t)
+        surrogate.set_coefficients(t, coefficients[t]);
+
+    // Report the errors at as many other samples.
+    SimTK::Vector gradient(n), workspace;
+    double sumSquaredLengthError = 0, maxLengthError = 0, maxMomentArmError = 0;
+    for (int i = 0; i < numSamples; ++i) {
+        const double length = takeSample(momentArms);
+        const double lengthError = std::abs(length -
+                surrogate.calcValueAndGradient(q, gradient, workspace));
+        sumSquaredLengthError += lengthError*lengthError;
+        maxLengthError = std::max(maxLengthError, lengthError);
+        for (int j = 0; j < n; ++j) {
+            maxMomentArmError = std::max(maxMomentArmError,
+                                         std::abs(momentArms[j] + gradient[j]));
+        }
+    }
+    surrogate.set_rms_length_error(std::sqrt(sumSquaredLengthError/numSamples));
+    surrogate.set_max_length_error(maxLengthError);
+    surrogate.set_max_moment_arm_error(maxMomentArmError);
+    return surrogate;
+}
+
+std::vector<std::string> GeometryPath::findSpanningCoordinates(
+        const SimTK::State& s, double tolerance) const
+{
+    const MomentArmSolver& maSolver = getMomentArmSolver();
+
+    const int numValues = 5;
+    std::vector<std::string> names;
+    SimTK::State sample = s;
+    for (const Coordinate& coord : getModel().getComponentList<Coordinate>()) {
+        const double value = coord.getValue(s);
+        bool spans = false;
+        for (int k = 0; k < numValues && !spans; ++k) {
+            coord.setValue(sample, coord.getRangeMin() + k *
+                (coord.getRangeMax() - coord.getRangeMin())/(numValues - 1),
+                false);
+            getModel().getMultibodySystem().realize(sample,
+                                                    SimTK::Stage::Position);
+            spans = std::abs(maSolver.solve(sample, coord, *this)) >
+                    tolerance;
+        }
+        coord.setValue(sample, value, false);
+        if (spans)
+            names.push_back(coord.getName());
+    }
+    return names;
 }
 
 void GeometryPath::extendFinalizeFromProperties()
@@ -1149,6 +1517,23 @@ void GeometryPath::extendFinalizeFromProperties()
         getProperty_PathPointSet().getName(),
         "A valid path requires at least two PathPoints.")
 
+    if (hasPolynomialSurrogate()) {
+        PolynomialPathSurrogate& surrogate = upd_polynomial_surrogate();
+        surrogate.prepareToEvaluate();
+        OPENSIM_THROW_IF_FRMOBJ(surrogate.getProperty_coefficients().size() !=
+                                surrogate.getNumTerms(),
+            InvalidPropertyValue,
+            getProperty_polynomial_surrogate().getName(),
+            "Expected " + std::to_string(surrogate.getNumTerms()) +
+            " coefficients.");
+    }
+
+    _pathPointsAlwaysActive = true;
+    for (int i = 0; i < get_PathPointSet().getSize(); ++i) {
+        if (dynamic_cast<const ConditionalPathPoint*>(&get_PathPointSet()[i]))
+            _pathPointsAlwaysActive = false;
+    }
+
     for (int i = 0; i < get_PathWrapSet().getSize(); ++i) {
         if (upd_PathWrapSet()[i].getName().empty()) {
             std::stringstream label;
@@ -30,6 +30,7 @@
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
+#include "PolynomialPathSurrogate.h"
 
 
 #ifdef SWIG
@@ -79,12 +80,18 @@ private:
     OpenSim_DECLARE_UNNAMED_PROPERTY(PathWrapSet,
         "The wrap objects that are associated with this path");
 
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(polynomial_surrogate,
+        PolynomialPathSurrogate,
+        "If present, a polynomial of the spanned coordinates used in place "
+        "of the path geometry to compute the length, lengthening speed, "
+        "moment arms, and forces of the path.");
+
     // used for scaling tendon and fiber lengths
     double _preScaleLength;
 
     // Solver used to compute moment-arms. The GeometryPath owns this object,
     // but we cannot simply use a unique_ptr because we want the pointer to be
-    // cleared on copy.
+    // cleared on copy. Made on first use; see getMomentArmSolver().
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
     
 //=============================================================================
@@ -159,10 +166,19 @@ public:
     void setLengtheningSpeed( const SimTK::State& s, double speed ) const;
 
     /** get the path as PointForceDirections directions, which can be used
-        to apply tension to bodies the points are connected to.*/
+        to apply tension to bodies the points are connected to. The
+        PointForceDirections are heap allocated, and must be deleted by the
+        caller; prefer the overload below, which reuses its storage. */
     void getPointForceDirections(const SimTK::State& s, 
         OpenSim::Array<PointForceDirection*> *rPFDs) const;
 
+    /** get the path as PointForceDirections directions, replacing the
+        contents of `pfds`. Passing the same vector for every evaluation (e.g.,
+        a member of the caller) reuses its storage, so that nothing is
+        allocated once it has grown to the largest number of path points. */
+    void getPointForceDirections(const SimTK::State& s,
+        std::vector<PointForceDirection>& pfds) const;
+
     /** add in the equivalent body and generalized forces to be applied to the 
         multibody system resulting from a tension along the GeometryPath 
     @param state    state used to evaluate forces
@@ -181,6 +197,77 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    /** Compute the derivative of the length of the path with respect to each
+    mobility (generalized speed), dL/du, from the current path (or from the
+    polynomial surrogate, if the path has one), in a single pass over the
+    path points and the mobilized bodies; the state must be realized to
+    Stage::Position, and nothing else is realized. `dLdu` is resized to the
+    number of mobilities, if needed.
+
+    The lengthening speed of the path is ~dLdu*u, and the moment arm about
+    a coordinate is the negative of the entry of its mobility (see
+    computeMomentArms()). Unlike computeMomentArm(), these moment arms do not
+    account for coordinates being coupled by constraints. */
+    void computeLengthJacobian(const SimTK::State& s, SimTK::Vector& dLdu) const;
+
+    /** Compute the moment arms of the path about each of the coordinates from
+    computeLengthJacobian(), with the same restrictions; `momentArms` is
+    resized to the number of coordinates, if needed. */
+    void computeMomentArms(const SimTK::State& s,
+                           const std::vector<const Coordinate*>& coordinates,
+                           SimTK::Vector& momentArms) const;
+
+    //--------------------------------------------------------------------------
+    // POLYNOMIAL SURROGATE
+    //--------------------------------------------------------------------------
+    /** @name Polynomial surrogate
+    A GeometryPath with a PolynomialPathSurrogate computes its length as the
+    polynomial of the surrogate's coordinates, its moment arms as the negative
+    of the polynomial's partial derivatives (zero for other coordinates), its
+    lengthening speed as the sum of the partial derivatives times the
+    coordinates' speeds, and applies its tension as generalized forces on the
+    surrogate's coordinates; none of these require following the path
+    geometry (path points and wrapping). The path geometry is still used to
+    draw the path.
+
+    The surrogate must be a function of all of the coordinates whose motion
+    changes the length of the path, and these should be independent
+    coordinates whose speed is the derivative of their value (e.g., not a
+    coordinate of a BallJoint). The surrogate should not be used outside of
+    the ranges over which it was fit. Changes to the surrogate take effect
+    once Model::finalizeFromProperties() (e.g., through initSystem()) is
+    called. */
+    /// @{
+    bool hasPolynomialSurrogate() const
+    {   return !getProperty_polynomial_surrogate().empty(); }
+    const PolynomialPathSurrogate& getPolynomialSurrogate() const
+    {   return get_polynomial_surrogate(); }
+    void setPolynomialSurrogate(const PolynomialPathSurrogate& surrogate)
+    {   set_polynomial_surrogate(surrogate); }
+    /** Remove the surrogate, so that the path geometry is used again. */
+    void clearPolynomialSurrogate()
+    {   updProperty_polynomial_surrogate().clear(); }
+
+    /** Fit a polynomial of the named coordinates to the length of the path
+    (computed from its geometry, whether or not it has a surrogate) over the
+    ranges of the coordinates. The length and the moment arms at `numSamples`
+    (by default, 10 per term of the polynomial) random configurations are fit
+    by least squares; the errors reported by the surrogate are those at as
+    many other random configurations. The other coordinates keep their values
+    in `s`, which must be realized to Stage::Position. The sampling is
+    repeatable (it uses a fixed seed).
+    @see findSpanningCoordinates() */
+    PolynomialPathSurrogate fitPolynomialSurrogate(const SimTK::State& s,
+            const std::vector<std::string>& coordinateNames, int order,
+            int numSamples = -1) const;
+
+    /** The names of the coordinates about which the path has a moment arm
+    larger than `tolerance` (in magnitude) somewhere in the coordinate's range
+    (checked at a few values, with the other coordinates as in `s`). */
+    std::vector<std::string> findSpanningCoordinates(const SimTK::State& s,
+            double tolerance = 1e-6) const;
+    /// @}
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -206,6 +293,8 @@ protected:
     void extendConnectToModel(Model& aModel) override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    // Add the surrogate's resolved coordinates.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
 
     // Visual support GeometryPath drawing in SimTK visualizer.
     void generateDecorations(
@@ -218,6 +307,18 @@ protected:
     void extendFinalizeFromProperties() override;
 
 private:
+    // The MomentArmSolver always uses the path geometry.
+    friend class MomentArmSolver;
+    // The moment-arm solver, made (safely, if called from several threads at
+    // once) on first use.
+    const MomentArmSolver& getMomentArmSolver() const;
+    void addInGeometricEquivalentForces(const SimTK::State& state,
+            double tension, SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const;
+    double calcGeometricLength(const SimTK::State& s) const;
+
+    // Evaluate the surrogate (length and gradient) if the cache is invalid.
+    void computeSurrogate(const SimTK::State& s) const;
 
     void computePath(const SimTK::State& s ) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
@@ -238,6 +339,35 @@ private:
     /** Override of the default implementation to account for versioning. */
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber = -1) override;
 
+    // Handles to the cache variables allocated in extendAddToSystem().
+    mutable CacheVariable<double> _lengthCV;
+    mutable CacheVariable<double> _speedCV;
+    mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
+    mutable CacheVariable<SimTK::Vec3> _colorCV;
+
+    // Whether the path has no ConditionalPathPoints, so that every path
+    // point is always active; set in extendFinalizeFromProperties().
+    bool _pathPointsAlwaysActive = false;
+
+    // The surrogate's coordinates, resolved in extendConnectToModel(); its
+    // length, and gradient with respect to its coordinates; and scratch space
+    // for evaluating it.
+    std::vector<SimTK::ReferencePtr<const Coordinate>> _surrogateCoordinates;
+    mutable CacheVariable<double> _surrogateLengthCV;
+    mutable CacheVariable<SimTK::Vector> _surrogateGradientCV;
+    mutable CacheVariable<SimTK::Vector> _surrogateQCV;
+    mutable CacheVariable<SimTK::Vector> _surrogateWorkspaceCV;
+
+    // Scratch space for computeLengthJacobian().
+    mutable CacheVariable<SimTK::Vector_<SimTK::SpatialVec>>
+        _jacobianBodyForcesCV;
+    mutable CacheVariable<SimTK::Vector> _jacobianMobilityForcesCV;
+
+    // The decorations last generated with a State, reused by
+    // generateDecorations() (scratch space, never marked valid).
+    mutable CacheVariable<SimTK::Array_<SimTK::DecorativeGeometry>>
+        _decorationsCV;
+
 //=============================================================================
 };  // END of class GeometryPath
 //=============================================================================
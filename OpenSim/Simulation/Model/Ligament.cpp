@@ -26,7 +26,6 @@
 //=============================================================================
 #include "Ligament.h"
 #include "GeometryPath.h"
-#include "PointForceDirection.h"
 #include <OpenSim/Common/SimmSpline.h>
 
 //=============================================================================
@@ -124,7 +123,8 @@ SimTK::Vec3 Ligament::computePathColor(const SimTK::State& state) const {
 {
     Super::extendAddToSystem(system);
     // Cache the computed tension and strain of the ligament
-    addCacheVariable<double>("tension", 0.0, SimTK::Stage::Velocity);
+    _tensionCV = addCacheVariable<double>("tension", 0.0,
+                                          SimTK::Stage::Velocity);
     addCacheVariable<double>("strain", 0.0, SimTK::Stage::Velocity);
 }
 
@@ -205,7 +205,7 @@ void Ligament::extendPostScale(const SimTK::State& s, const ScaleSet& scaleSet)
 
 const double& Ligament::getTension(const SimTK::State& s) const
 {
-    return getCacheVariableValue<double>(s, "tension"); 
+    return getCacheVariableValue(s, _tensionCV);
 }
 
 
@@ -230,26 +230,18 @@ void Ligament::computeForce(const SimTK::State& s,
     const double& restingLength = get_resting_length();
     const double& pcsaForce = get_pcsa_force();
 
-    double force = 0;
+    const double length = path.getLength(s);
 
-    if (path.getLength(s) <= restingLength){
-        setCacheVariableValue<double>(s, "tension", force);
+    if (length <= restingLength){
+        setCacheVariableValue(s, _tensionCV, 0.0);
         return;
     }
     
     // evaluate normalized tendon force length curve
-    force = getForceLengthCurve().calcValue(
-        SimTK::Vector(1, path.getLength(s)/restingLength))* pcsaForce;
-    setCacheVariableValue<double>(s, "tension", force);
+    const double force =
+        getForceLengthCurve().calcValue(length/restingLength)*pcsaForce;
+    setCacheVariableValue(s, _tensionCV, force);
 
-    OpenSim::Array<PointForceDirection*> PFDs;
-    path.getPointForceDirections(s, &PFDs);
-
-    for (int i=0; i < PFDs.getSize(); i++) {
-        applyForceToPoint(s, PFDs[i]->frame(), PFDs[i]->point(), 
-                          force*PFDs[i]->direction(), bodyForces);
-    }
-    for(int i=0; i < PFDs.getSize(); i++)
-        delete PFDs[i];
+    path.addInEquivalentForces(s, force, bodyForces, generalizedForces);
 }
 
@@ -102,6 +102,8 @@ public:
     void computeForce(const SimTK::State& s, 
                       SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                       SimTK::Vector& generalizedForces) const override;
+    /** Ligaments can be computed concurrently with other forces. */
+    bool shouldBeParallelized() const override { return true; }
 
     //--------------------------------------------------------------------------
     // SCALE
@@ -161,10 +163,19 @@ protected:
         values.append(getTension(state));
         return values;
     }
+#ifndef SWIG
+    /** Copy the tension cached when the system was realized to Dynamics. */
+    void copyRecordValues(const SimTK::State& state,
+                          double* values) const override {
+        values[0] = getTension(state);
+    }
+#endif
 
 private:
     void constructProperties();
 
+    mutable CacheVariable<double> _tensionCV;
+
 //=============================================================================
 };  // END of class Ligament
 //=============================================================================
@@ -27,14 +27,19 @@
 //=============================================================================
 
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
+#include <OpenSim/Common/Parallelism.h>
+#include <OpenSim/Common/ResultCache.h>
 #include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <OpenSim/Simulation/SimbodyEngine/WeldConstraint.h>
 #include <OpenSim/Simulation/SimbodyEngine/PointConstraint.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/SmoothSegmentedFunction.h>
 #include <OpenSim/Simulation/CoordinateReference.h>
 
 #include "SimTKcommon/internal/SystemGuts.h"
@@ -49,12 +54,23 @@
 #include "ControllerSet.h"
 #include "CoordinateSet.h"
 #include "ForceSet.h"
+#include "ForceAdapter.h"
 #include "Ligament.h"
 #include "MarkerSet.h"
 #include "ProbeSet.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 #include <OpenSim/Simulation/AssemblySolver.h>
 
@@ -81,12 +97,91 @@ Model::Model() : ModelComponent(),
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _numForceThreads(1),
+    _precomputePaths(false),
     _allControllersEnabled(true)
 {
     constructProperties();
     setNull();
     finalizeFromProperties();
 }
+namespace {
+    // "OSMB" followed by the version of the precompiled model file layout.
+    const std::uint32_t PRECOMPILED_MAGIC = 0x424D534F;
+    const std::uint32_t PRECOMPILED_VERSION = 1;
+
+    // Size and 64-bit FNV-1a hash of the contents of a file.
+    bool hashFile(const string& fileName,
+                  std::uint64_t& size, std::uint64_t& hash) {
+        std::ifstream in(fileName, std::ios::binary);
+        if (!in) return false;
+        size = 0;
+        hash = 14695981039346656037ULL;
+        char buffer[65536];
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+            const std::streamsize count = in.gcount();
+            for (std::streamsize i = 0; i < count; ++i) {
+                hash ^= static_cast<unsigned char>(buffer[i]);
+                hash *= 1099511628211ULL;
+            }
+            size += count;
+        }
+        return true;
+    }
+
+    bool getModificationTime(const string& fileName, time_t& time) {
+        struct stat info;
+        if (stat(fileName.c_str(), &info) != 0) return false;
+        time = info.st_mtime;
+        return true;
+    }
+
+    // Use the precompiled file of the model file, if it is up to date.
+    void readPrecompiledFile(const string& modelFileName) {
+        const string fileName = Model::getPrecompiledFileName(modelFileName);
+        time_t modelTime, precompiledTime;
+        if (!getModificationTime(fileName, precompiledTime) ||
+                !getModificationTime(modelFileName, modelTime) ||
+                precompiledTime < modelTime)
+            return;
+
+        std::ifstream in(fileName, std::ios::binary);
+        std::uint32_t magic = 0, version = 0;
+        std::uint64_t size = 0, hash = 0, modelSize, modelHash;
+        in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+        if (!in || magic != PRECOMPILED_MAGIC ||
+                version != PRECOMPILED_VERSION ||
+                !hashFile(modelFileName, modelSize, modelHash) ||
+                size != modelSize || hash != modelHash)
+            return;
+
+        if (SmoothSegmentedFunction::readPrecomputedData(in) &&
+                LogManager::shouldLog(LogManager::Level::Info))
+            cout << "Using precompiled model file " << fileName << endl;
+    }
+
+    // The models kept by Model::createFromFile(), by absolute file name,
+    // with the size and hash of the file they were read from.
+    struct CachedModel {
+        std::uint64_t size;
+        std::uint64_t hash;
+        std::unique_ptr<Model> model;
+    };
+    std::mutex modelCacheMutex;
+    bool modelCacheEnabled = false;
+    std::map<string, CachedModel> modelCache;
+
+    string getAbsoluteFileName(const string& fileName) {
+        const bool isAbsolute = !fileName.empty() && (fileName[0] == '/' ||
+                fileName[0] == '\\' ||
+                (fileName.size() > 1 && fileName[1] == ':'));
+        return isAbsolute ? fileName : IO::getCwd() + "/" + fileName;
+    }
+}
+
 //_____________________________________________________________________________
 /*
  * Constructor from an XML file
@@ -98,14 +193,19 @@ Model::Model(const string &aFileName) :
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _numForceThreads(1),
+    _precomputePaths(false),
     _allControllersEnabled(true)
 {   
     constructProperties();
     setNull();
+    readPrecompiledFile(aFileName);
     updateFromXMLDocument();
 
     _fileName = aFileName;
-    cout << "Loaded model " << getName() << " from file " << getInputFileName() << endl;
+    if (LogManager::shouldLog(LogManager::Level::Info))
+        cout << "Loaded model " << getName() << " from file "
+             << getInputFileName() << endl;
 
     try {
         finalizeFromProperties();
@@ -118,6 +218,99 @@ Model::Model(const string &aFileName) :
     }
 }
 
+std::string Model::getPrecompiledFileName(const std::string& filename)
+{
+    const auto sep = filename.find_last_of("/\\");
+    const auto dot = filename.rfind('.');
+    if (dot == string::npos || (sep != string::npos && dot < sep))
+        return filename + ".osimb";
+    return filename.substr(0, dot) + ".osimb";
+}
+
+std::string Model::writePrecompiledFile(const std::string& filename)
+{
+    std::uint64_t size, hash;
+    OPENSIM_THROW_IF(!hashFile(filename, size, hash), Exception,
+            "Could not read model file '" + filename + "'.");
+
+    // Only write the curves of this model.
+    SmoothSegmentedFunction::clearPrecomputedData();
+    Model model(filename);
+    std::ostringstream data(std::ios::binary);
+    SmoothSegmentedFunction::writePrecomputedData(data);
+
+    const string precompiledFileName = getPrecompiledFileName(filename);
+    std::ofstream out(precompiledFileName, std::ios::binary);
+    OPENSIM_THROW_IF(!out, Exception,
+            "Could not open '" + precompiledFileName + "' for writing.");
+    out.write(reinterpret_cast<const char*>(&PRECOMPILED_MAGIC),
+              sizeof(PRECOMPILED_MAGIC));
+    out.write(reinterpret_cast<const char*>(&PRECOMPILED_VERSION),
+              sizeof(PRECOMPILED_VERSION));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    out << data.str();
+    OPENSIM_THROW_IF(!out, Exception,
+            "Could not write '" + precompiledFileName + "'.");
+    return precompiledFileName;
+}
+
+Model* Model::createFromFile(const std::string& filename)
+{
+    std::uint64_t size, hash;
+    if (!getModelCacheEnabled() || !hashFile(filename, size, hash))
+        return new Model(filename);
+
+    const string key = getAbsoluteFileName(filename);
+    {
+        std::lock_guard<std::mutex> lock(modelCacheMutex);
+        auto it = modelCache.find(key);
+        if (it != modelCache.end() && it->second.size == size &&
+                it->second.hash == hash) {
+            Model* model = it->second.model->clone();
+            model->setInputFileName(filename);
+            if (LogManager::shouldLog(LogManager::Level::Info))
+                cout << "Copied model " << model->getName()
+                     << " read before from file " << filename << endl;
+            return model;
+        }
+    }
+
+    // Read the file without holding the lock, so that other files can be
+    // read meanwhile. The cache keeps its own copy, which is never modified.
+    std::unique_ptr<Model> model(new Model(filename));
+    std::lock_guard<std::mutex> lock(modelCacheMutex);
+    CachedModel& cached = modelCache[key];
+    cached.size = size;
+    cached.hash = hash;
+    cached.model.reset(model->clone());
+    return model.release();
+}
+
+void Model::setModelCacheEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(modelCacheMutex);
+    modelCacheEnabled = enabled;
+}
+
+bool Model::getModelCacheEnabled()
+{
+    std::lock_guard<std::mutex> lock(modelCacheMutex);
+    return modelCacheEnabled;
+}
+
+void Model::clearModelCache()
+{
+    std::lock_guard<std::mutex> lock(modelCacheMutex);
+    modelCache.clear();
+}
+
+int Model::getModelCacheSize()
+{
+    std::lock_guard<std::mutex> lock(modelCacheMutex);
+    return int(modelCache.size());
+}
+
 Model* Model::clone() const
 {
     // Invoke default copy constructor.
@@ -311,6 +504,8 @@ void Model::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 void Model::setNull()
 {
     _useVisualizer = false;
+    _numForceThreads = 1;
+    _precomputePaths = false;
     _allControllersEnabled = true;
 
     _validationLog="";
@@ -373,6 +568,8 @@ void Model::constructProperties()
 // Perform some final checks on the Model, wire up all its components, and then
 // build a computational System for it.
 void Model::buildSystem() {
+    OPENSIM_TRACE_SPAN("model", "buildSystem", getName());
+
     // Finish connecting up the Model.
     setup();
 
@@ -391,6 +588,8 @@ void Model::buildSystem() {
 //------------------------------------------------------------------------------
 // Requires that buildSystem() has already been called.
 SimTK::State& Model::initializeState() {
+    OPENSIM_TRACE_SPAN("model", "initializeState", getName());
+
     if (!hasSystem()) 
         throw Exception("Model::initializeState(): call buildSystem() first.");
 
@@ -502,8 +701,9 @@ void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
     }
     catch (const std::exception&)    {
         try{
-            // Otherwise try to do a full-blown assemble
-            _assemblySolver->assemble(s);
+            // Otherwise try to do a full-blown assemble, reusing the goals
+            // of the last one
+            _assemblySolver->reassemble(s);
         }
         catch (const std::exception& ex){
             // Constraints are probably infeasible so try again relaxing constraints
@@ -526,6 +726,47 @@ void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
 
 }
 
+void Model::setCoordinateValues(SimTK::State& s,
+        const std::vector<std::string>& names, const SimTK::Vector& values,
+        bool enforceConstraints)
+{
+    std::vector<int> indices(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        indices[i] = getCoordinateSet().getIndex(names[i]);
+        OPENSIM_THROW_IF_FRMOBJ(indices[i] < 0, Exception,
+            "Coordinate '" + names[i] + "' not found.");
+    }
+    setCoordinateValues(s, indices, values, enforceConstraints);
+}
+
+void Model::setCoordinateValues(SimTK::State& s,
+        const std::vector<int>& indices, const SimTK::Vector& values,
+        bool enforceConstraints)
+{
+    const CoordinateSet& coords = getCoordinateSet();
+    OPENSIM_THROW_IF_FRMOBJ(values.size() != (int)indices.size(), Exception,
+        "Expected " + std::to_string(indices.size()) + " values, but got "
+        + std::to_string(values.size()) + ".");
+    bool constrained = false;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        OPENSIM_THROW_IF_FRMOBJ(indices[i] < 0 ||
+                indices[i] >= coords.getSize(), Exception,
+            "Coordinate index " + std::to_string(indices[i]) +
+            " is out of range.");
+        const Coordinate& coord = coords[indices[i]];
+        coord.setValue(s, values[(int)i], false);
+        constrained = constrained || coord.isConstrained(s);
+    }
+
+    // As Coordinate::setValue() does for a single coordinate.
+    if (enforceConstraints) {
+        if (getConstraintSet().getSize() > 0 || constrained)
+            assemble(s);
+        else
+            getMultibodySystem().realize(s, Stage::Position);
+    }
+}
+
 void Model::invalidateSystem()
 {
     if (_system)
@@ -567,6 +808,7 @@ void Model::createMultibodySystem()
     _gravityForce.reset(new SimTK::Force::Gravity(*_forceSubsystem, *_matter,
                 direction, magnitude));
 
+    OPENSIM_TRACE_SPAN("model", "addToSystem", getName());
     addToSystem(*_system);
 }
 
@@ -616,8 +858,13 @@ std::vector<SimTK::ReferencePtr<const Coordinate>>
 
 void Model::extendFinalizeFromProperties()
 {
+    OPENSIM_TRACE_SPAN("model", "finalizeFromProperties", getName());
+
     Super::extendFinalizeFromProperties();
 
+    _fingerprints[0].clear();
+    _fingerprints[1].clear();
+
     // wipe-out the existing System 
     _matter.reset();
     _forceSubsystem.reset();
@@ -643,6 +890,7 @@ void Model::extendFinalizeFromProperties()
 
 void Model::createMultibodyTree()
 {
+    OPENSIM_TRACE_SPAN("model", "createMultibodyTree", getName());
     // building the system for the first time, need to tell
     // multibodyTree builder what joints are available
     _multibodyTree.clearGraph();
@@ -738,7 +986,10 @@ void Model::extendConnectToModel(Model &model)
 
     // generate the graph of the Multibody tree to determine the order in
     // which subcomponents will be added to the MultibodySystem (in addToSystem)
-    _multibodyTree.generateGraph();
+    {
+        OPENSIM_TRACE_SPAN("model", "generateMultibodyGraph", getName());
+        _multibodyTree.generateGraph();
+    }
     //_multibodyTree.dumpGraph(cout);
     //cout << endl;
 
@@ -927,6 +1178,12 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
     // Reset the vector of all controls' defaults
     mutableThis->_defaultControls.resize(0);
 
+    // The controllers, so that computeControls() need not search for them
+    // (and allocate a ComponentList) every time.
+    mutableThis->_controllers.clear();
+    for (const auto& controller : getComponentList<Controller>())
+        mutableThis->_controllers.emplace_back(&controller);
+
     // Create the shared cache that will hold all model controls
     // This must be created before Actuator.extendAddToSystem() since Actuator
     // will append its "slots" and retain its index by accessing this cached Vector.
@@ -936,9 +1193,21 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    // Forces that can be computed concurrently are computed by a single
+    // SimTK::Force; see Force::extendAddToSystem().
+    if (getComputesForcesInBlocks())
+        SimTK::Force::Custom(updForceSubsystem(),
+                             new ParallelForceAdapter(*this,
+                                                      getNumForceThreads()));
 }
 
 
+bool Model::getComputesForcesInBlocks() const
+{
+    return getNumForceThreads() != 1 || Parallelism::isDeterministic();
+}
+
 // Add any Component derived from ModelComponent to the Model
 void Model::addModelComponent(ModelComponent* component)
 {
@@ -1036,10 +1305,12 @@ void Model::addController(Controller *aController)
  */
 void Model::setup()
 {
+    OPENSIM_TRACE_SPAN("model", "setup", getName());
     // finalize the model and its subcomponents from its properties
     // automatically marks properties that are Components as subcomponents
     finalizeFromProperties();
     //now connect the Model and all its subcomponents all up
+    OPENSIM_TRACE_SPAN("model", "finalizeConnections", getName());
     finalizeConnections(*this);
 }
 
@@ -1096,34 +1367,125 @@ void Model::generateDecorations
 
 void Model::equilibrateMuscles(SimTK::State& state)
 {
-    getMultibodySystem().realize(state, Stage::Velocity);
-
-    bool failed = false;
-    string errorMsg = "";
+    equilibrateMuscles(state, false);
+}
 
-    auto muscles = getComponentList<Muscle>();
+std::vector<int> Model::equilibrateMuscles(SimTK::State& state,
+                                           bool warmStart, int numThreads)
+{
+    getMultibodySystem().realize(state, Stage::Velocity);
 
-    for (auto& muscle : muscles) {
-        if (muscle.appliesForce(state)){
-            try{
-                muscle.computeEquilibrium(state);
+    std::vector<const Muscle*> muscles;
+    for (const auto& muscle : getComponentList<Muscle>())
+        muscles.push_back(&muscle);
+    const int numMuscles = int(muscles.size());
+    std::vector<int> iterations(numMuscles, -1);
+    // The message of the error encountered by each muscle, if any.
+    std::vector<string> errors(numMuscles);
+
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, numMuscles));
+
+    // Each block of muscles other than the first is equilibrated in its own
+    // copy of the State, since a State cannot be modified concurrently.
+    std::vector<SimTK::State> copies(numBlocks - 1, state);
+    auto equilibrateBlock = [&](int block) {
+        SimTK::State& s = block == 0 ? state : copies[block - 1];
+        const int first = numMuscles*block/numBlocks;
+        const int last = numMuscles*(block+1)/numBlocks;
+        for (int i = first; i < last; ++i) {
+            if (!muscles[i]->appliesForce(s)) continue;
+            try {
+                iterations[i] = muscles[i]->computeEquilibrium(s, warmStart);
             }
             catch (const std::exception& e) {
-                if(!failed){ // haven't failed to equilibrate other muscles yet
-                    errorMsg = e.what();
-                    failed = true;
-                }
                 // just because one muscle failed to equilibrate doesn't mean 
                 // it isn't still useful to have remaining muscles equilibrate
                 // in an analysis, for example, we might not be reporting about
                 // all muscles, so continue with the rest.
-                continue;
+                errors[i] = e.what();
             }
         }
+    };
+    std::vector<std::thread> threads;
+    for (int block = 1; block < numBlocks; ++block) {
+        try {
+            threads.emplace_back(equilibrateBlock, block);
+        } catch (const std::system_error&) {
+            // Could not start a thread; equilibrate this block here instead.
+            equilibrateBlock(block);
+        }
+    }
+    equilibrateBlock(0);
+    for (auto& thread : threads) thread.join();
+
+    // Copy the state variables of the muscles equilibrated in the copies.
+    for (int block = 1; block < numBlocks; ++block) {
+        const SimTK::State& s = copies[block - 1];
+        for (int i = numMuscles*block/numBlocks;
+                i < numMuscles*(block+1)/numBlocks; ++i) {
+            const Array<std::string> names = muscles[i]->getStateVariableNames();
+            for (int j = 0; j < names.size(); ++j)
+                muscles[i]->setStateVariableValue(state, names[j],
+                    muscles[i]->getStateVariableValue(s, names[j]));
+        }
     }
 
-    if(failed) // Notify the caller of the failure to equilibrate 
-        throw Exception("Model::equilibrateMuscles() "+errorMsg, __FILE__, __LINE__);
+    for (const auto& errorMsg : errors) {
+        // Notify the caller of the (first) failure to equilibrate.
+        if (!errorMsg.empty())
+            throw Exception("Model::equilibrateMuscles() "+errorMsg,
+                            __FILE__, __LINE__);
+    }
+    return iterations;
+}
+
+void Model::calcMuscleStateDerivativeJacobian(const SimTK::State& state,
+        SimTK::Matrix& dYdotdY, SimTK::Matrix& dYdotdU) const
+{
+    const int ny = state.getNY();
+    dYdotdY.resize(ny, ny);
+    dYdotdY = 0;
+    dYdotdU.resize(ny, getNumControls());
+    dYdotdU = 0;
+
+    for (const auto& muscle : getComponentList<Muscle>()) {
+        const Muscle::StateDerivativeJacobian jac =
+            muscle.calcStateDerivativeJacobian(state);
+        const std::vector<int>& yIndices = jac.stateVariableSystemIndices;
+        for (int i = 0; i < int(yIndices.size()); ++i) {
+            for (int j = 0; j < int(yIndices.size()); ++j)
+                dYdotdY(yIndices[i], yIndices[j]) = jac.dYdotdY(i, j);
+            for (int k = 0; k < jac.dYdotdU.ncol(); ++k)
+                dYdotdU(yIndices[i], jac.controlIndex + k) = jac.dYdotdU(i, k);
+        }
+    }
+}
+
+SimTK::Vector Model::calcImplicitResiduals(const SimTK::State& state,
+        const SimTK::Vector& yDotGuess, const SimTK::Vector& lambdaGuess) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(yDotGuess.size() != state.getNY(), Exception,
+        "Expected yDotGuess to have size " + std::to_string(state.getNY())
+        + ", but it has size " + std::to_string(yDotGuess.size()) + ".");
+    OPENSIM_THROW_IF_FRMOBJ(state.getSystemStage() < Stage::Dynamics,
+        Exception, "The State must be realized to Stage::Dynamics.");
+
+    const int nq = state.getNQ();
+    const int nu = state.getNU();
+    SimTK::Vector residuals(state.getNY(), 0.0);
+    residuals(0, nq) = yDotGuess(0, nq) - state.getQDot();
+
+    SimTK::Vector residualForces;
+    getMatterSubsystem().calcResidualForce(state,
+        getMultibodySystem().getMobilityForces(state, Stage::Dynamics),
+        getMultibodySystem().getRigidBodyForces(state, Stage::Dynamics),
+        yDotGuess(nq, nu), lambdaGuess, residualForces);
+    residuals(nq, nu) = residualForces;
+
+    for (const auto& comp : getComponentList<ModelComponent>())
+        comp.calcImplicitResiduals(state, yDotGuess, residuals);
+    return residuals;
 }
 
 //=============================================================================
@@ -1482,6 +1844,91 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
 //=============================================================================
 // PRINT
 //=============================================================================
+namespace {
+// Hash the object's type and properties, and those of the objects they
+// contain. Sockets and inputs are stored in properties named socket_<name>
+// and input_<name>, which are the object's connections.
+void addToFingerprint(ResultCache::Key& key, const Object& object,
+                      bool topologyOnly)
+{
+    key.add(object.getConcreteClassName());
+    for (int i = 0; i < object.getNumProperties(); ++i) {
+        const AbstractProperty& property = object.getPropertyByIndex(i);
+        if (property.isObjectProperty()) {
+            key.add(property.getName()).add(std::to_string(property.size()));
+            for (int j = 0; j < property.size(); ++j) {
+                const Object& value = property.getValueAsObject(j);
+                key.add(value.getName());
+                addToFingerprint(key, value, topologyOnly);
+            }
+        } else if (!topologyOnly ||
+                   property.getName().compare(0, 7, "socket_") == 0 ||
+                   property.getName().compare(0, 6, "input_") == 0) {
+            key.add(property.getName()).add(property.toString());
+        }
+    }
+}
+}
+
+std::string Model::computeFingerprint(bool topologyOnly) const
+{
+    // An edit to a property of the model or a component marks it as not up
+    // to date with its properties until it is finalized again. Names are not
+    // properties, so a rename anywhere invalidates the cache.
+    const unsigned long long nameGeneration = getNameGeneration();
+    const int variant = topologyOnly ? 1 : 0;
+    bool upToDate = isObjectUpToDateWithProperties();
+    if (upToDate) {
+        for (const auto& component : getComponentList()) {
+            if (!component.isObjectUpToDateWithProperties()) {
+                upToDate = false;
+                break;
+            }
+        }
+    }
+    std::string& cached = _fingerprints[variant];
+    if (upToDate && !cached.empty() &&
+            _fingerprintNameGenerations[variant] == nameGeneration)
+        return cached;
+
+    ResultCache::Key key;
+    addToFingerprint(key, *this, topologyOnly);
+    const std::string fingerprint = key.toString();
+    if (upToDate) {
+        cached = fingerprint;
+        _fingerprintNameGenerations[variant] = nameGeneration;
+    }
+    return fingerprint;
+}
+
+void Model::extendEstimateMemoryUsage(MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage += _analysisSet.estimateMemoryUsage();
+    // The continuous variables and their derivatives, and the errors,
+    // multipliers and event triggers; not the State's cache entries.
+    if (_workingState.getSystemStage() >= SimTK::Stage::Instance) {
+        const int numValues = 2 * _workingState.getNY() +
+                _workingState.getNYErr() + _workingState.getNMultipliers() +
+                _workingState.getNEventTriggers();
+        usage.add(MemoryUsage::States, size_t(numValues) * sizeof(double));
+    }
+}
+
+void Model::printMemoryUsage(std::ostream& out) const
+{
+    const MemoryUsage usage = estimateMemoryUsage();
+    out << "Estimated memory of model " << getName() << ":\n"
+        << usage.toString();
+    for (const auto& component : getImmediateSubcomponents()) {
+        out << "  " << component->getName() << ": "
+            << component->estimateMemoryUsage().getTotal() << " bytes\n";
+    }
+    out << "Memory of this process: "
+        << MemoryUsage::getCurrentProcessMemory() << " bytes (peak "
+        << MemoryUsage::getPeakProcessMemory() << " bytes)" << std::endl;
+}
+
 void Model::printBasicInfo(std::ostream& aOStream) const
 {
     OPENSIM_THROW_IF_FRMOBJ(!isObjectUpToDateWithProperties(), Exception,
@@ -1828,9 +2275,9 @@ const Vector& Model::getControls(const SimTK::State &s) const
 /** Compute the controls the model */
 void Model::computeControls(const SimTK::State& s, SimTK::Vector &controls) const
 {
-    for (auto& controller : getComponentList<Controller>()) {
-        if (controller.isEnabled()) {
-            controller.computeControls(s, controls);
+    for (const auto& controller : _controllers) {
+        if (controller->isEnabled()) {
+            controller->computeOrHoldControls(s, controls);
         }
     }
 }
@@ -1888,44 +2335,14 @@ void Model::formStateStorage(const Storage& originalStorage,
     // when the state value is not found in the storage use its default value in the State
     SimTK::Vector defaultStateValues = getStateVariableValues(getWorkingState());
 
-    // Create a list with entry for each desiredName telling which column in originalStorage has the data
+    // Create a list with entry for each desiredName telling which column in
+    // originalStorage has the data. Storage::getStateIndex() finds the columns
+    // by hashed label and also handles the labels of storages generated by
+    // older versions (e.g., "<coord>_u" for "<coord>/speed").
     Array<int> mapColumns(-1, rStateNames.getSize());
     for(int i=0; i< rStateNames.getSize(); i++){
-        // the index is -1 if not found, >=1 otherwise since time has index 0 by defn.
-        int fix = originalStorage.getColumnLabels().findIndex(rStateNames[i]);
-        if (fix==-1){
-            // try removing the complete path name to identify the state_name in storage
-            string::size_type last = rStateNames[i].rfind("/");
-            string name = rStateNames[i].substr(last+1, rStateNames[i].length()-last);
-            fix = originalStorage.getColumnLabels().findIndex(name);
-            // this whole method is one big hack and needs to be eliminated- aseth
-            // for the time being, allow the new coordinate labeling to be
-            // handled from storages generated by older versions
-            if (fix == -1){
-                if (name == "value"){
-                    // old formats did not have "/value" so remove it if here
-                    name = rStateNames[i].substr(0, last);
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, name.length());
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-                else if (name == "speed"){
-                    // replace "/speed" (the latest labeling for speeds) with "_u"
-                    name = rStateNames[i].substr(0, last);
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, name.length() - last) + "_u";
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-                else {
-                    // try replacing the '/' with '.' in the last connection
-                    name = rStateNames[i];
-                    name.replace(last, 1, ".");
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, rStateNames[i].length() - last);
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-            }
-        }
+        // the index is -1 if not found, >=0 otherwise since time is not a state.
+        const int fix = originalStorage.getStateIndex(rStateNames[i]);
         mapColumns[i] = fix;
         if (fix==-1 && warnUnspecifiedStates){
             cout << "Column "<< rStateNames[i] << 
@@ -1943,7 +2360,7 @@ void Model::formStateStorage(const Storage& originalStorage,
         stateVec.getData().setSize(numStates); 
         for(int column=0; column< numStates; column++) {
             if (mapColumns[column] != -1)
-                originalVec->getDataValue(mapColumns[column] - 1, assignedValue);
+                originalVec->getDataValue(mapColumns[column], assignedValue);
             else
                 assignedValue = defaultStateValues[column];
 
@@ -1968,10 +2385,10 @@ void Model::formQStorage(const Storage& originalStorage, Storage& qStorage) {
     getCoordinateSet().getNames(qNames);
 
 
-    int* mapColumns = new int[qNames.getSize()];
+    std::vector<int> mapColumns(nq);
     for(int i=0; i< nq; i++){
-        // the index is -1 if not found, >=1 otherwise since time has index 0 by defn.
-        mapColumns[i] = originalStorage.getColumnLabels().findIndex(qNames[i]);
+        // the index is -1 if not found, >=0 otherwise since time is not a state.
+        mapColumns[i] = originalStorage.getStateIndex(qNames[i]);
         if (mapColumns[i]==-1)
             cout << "\n Column "<< qNames[i] << " not found in formQStorage, assuming 0.\n" << endl;
     }
@@ -1980,16 +2397,16 @@ void Model::formQStorage(const Storage& originalStorage, Storage& qStorage) {
     // Now cycle through and shuffle each
     for (int row =0; row< originalStorage.getSize(); row++){
         StateVector* originalVec = originalStorage.getStateVector(row);
-        StateVector* stateVec = new StateVector(originalVec->getTime());
-        stateVec->getData().setSize(nq);  // default value 0f 0.
+        StateVector stateVec(originalVec->getTime());
+        stateVec.getData().setSize(nq);  // default value 0f 0.
         for(int column=0; column< nq; column++){
             double valueInOriginalStorage=0.0;
             if (mapColumns[column]!=-1)
-                originalVec->getDataValue(mapColumns[column]-1, valueInOriginalStorage);
+                originalVec->getDataValue(mapColumns[column], valueInOriginalStorage);
 
-            stateVec->setDataValue(column, valueInOriginalStorage);
+            stateVec.setDataValue(column, valueInOriginalStorage);
         }
-        qStorage.append(*stateVec);
+        qStorage.append(stateVec);
     }
     qNames.insert(0, "time");
 
@@ -2048,31 +2465,37 @@ const Object& Model::getObjectByTypeAndName(const std::string& typeString, const
 //------------------------------------------------------------------------------
 void Model::realizeTime(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Time");
     getSystem().realize(state, Stage::Time);
 }
 
 void Model::realizePosition(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Position");
     getSystem().realize(state, Stage::Position);
 }
 
 void Model::realizeVelocity(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Velocity");
     getSystem().realize(state, Stage::Velocity);
 }
 
 void Model::realizeDynamics(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Dynamics");
     getSystem().realize(state, Stage::Dynamics);
 }
 
 void Model::realizeAcceleration(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Acceleration");
     getSystem().realize(state, Stage::Acceleration);
 }
 
 void Model::realizeReport(const SimTK::State& state) const
 {
+    OPENSIM_TRACE_SPAN("realize", "Report");
     getSystem().realize(state, Stage::Report);
 }
 
@@ -124,6 +124,15 @@ related objects are maintained in a runtime section of the Model object. You
 can also ask a Model to provide visualization using the setUseVisualizer()
 method, in which case it will allocate and maintain a ModelVisualizer.
 
+Once initSystem() has been called, an unmodified Model may be evaluated from
+several threads at once, each with its own SimTK::State: realizing the
+states, getting the values of Outputs, and computing path lengths, moment arms
+and controls use only const methods that keep their results in the State. Each
+thread needs its own State (e.g., a copy of the working state); the model
+itself must not be modified (e.g., properties set, components added, or
+initSystem() called) while other threads use it. This avoids a copy of the
+model for each thread.
+
 @authors Frank Anderson, Peter Loan, Ayman Habib, Ajay Seth, Michael Sherman
 @see ModelComponent, ModelVisualizer, SimTK::System
 **/
@@ -240,11 +249,57 @@ public:
     first. Model::initSystem() invokes finalizeFromProperties() on its way to
     creating the System and initializing the State.
 
+    If an up-to-date precompiled model file (see writePrecompiledFile())
+    exists next to the model file, the precomputed muscle curve data it
+    contains is used instead of being recomputed.
+
     @param filename     Name of a file containing an OpenSim model in XML
                         format; suffix is typically ".osim". 
     **/
     explicit Model(const std::string& filename) SWIG_DECLARE_EXCEPTION;
 
+    /** Write the precompiled model file (see getPrecompiledFileName()) for
+    the given model file. The precompiled file holds the data that is
+    expensive to compute while loading the model (currently, the splines of
+    the SmoothSegmentedFunction%s underlying the muscle curves), along with a
+    format version and a hash of the model file's contents. The
+    Model(const std::string&) constructor, and therefore every tool and
+    `opensim-cmd` command that loads this model file, uses the precompiled
+    file automatically if it is newer than the model file, was written by
+    the same format version, and the hash matches; otherwise, it is ignored.
+    The properties of the model are still read from the XML model file.
+    @returns the name of the precompiled file that was written. */
+    static std::string writePrecompiledFile(const std::string& filename)
+        SWIG_DECLARE_EXCEPTION;
+
+    /** The name of the precompiled model file for the given model file: the
+    model file name with its extension replaced by ".osimb" (e.g.,
+    "arm26.osim" -> "arm26.osimb"). */
+    static std::string getPrecompiledFileName(const std::string& filename);
+
+    /** Create a model from a file, as Model(const std::string&) does; the
+    caller owns the new model. The tools load their models with this
+    function.
+
+    If the model cache is enabled (see setModelCacheEnabled()), the first
+    model created from a file is kept, and a later call with the same file
+    returns a copy of it rather than parsing the file again, as long as the
+    contents of the file (compared by size and hash) have not changed. Files
+    are identified by their absolute path, so tools that change the working
+    directory share the cached models. */
+    static Model* createFromFile(const std::string& filename)
+        SWIG_DECLARE_EXCEPTION;
+
+    /** Enable or disable the process-wide model cache used by
+    createFromFile() (disabled by default). Disabling it does not discard
+    the cached models; see clearModelCache(). */
+    static void setModelCacheEnabled(bool enabled);
+    static bool getModelCacheEnabled();
+    /** Discard the models kept by the model cache. */
+    static void clearModelCache();
+    /** The number of model files held by the model cache. */
+    static int getModelCacheSize();
+
     /**
      * Perform some set up functions that happen after the
      * object has been deserialized. TODO: this method is
@@ -304,6 +359,32 @@ public:
     take effect at the next call to initSystem() on this %Model. **/
     bool getUseVisualizer() const {return _useVisualizer;}
 
+    /** %Set the number of threads over which to divide the computation of
+    the forces that can be computed concurrently (see
+    Force::shouldBeParallelized()); 0 for the number of hardware threads. The
+    default, 1, computes all forces serially. This setting takes effect at the
+    next call to initSystem() on this %Model. @see ParallelForceAdapter **/
+    void setNumForceThreads(int numThreads) {_numForceThreads=numThreads;}
+    /** Return the current setting of the number of force threads. **/
+    int getNumForceThreads() const {return _numForceThreads;}
+    /** Whether the forces that can be computed concurrently are computed by
+    a ParallelForceAdapter: if getNumForceThreads() is not 1, or in
+    deterministic mode (see Parallelism), so that these forces are summed in
+    the same blocks for any number of threads. **/
+    bool getComputesForcesInBlocks() const;
+
+    /** Request that the GeometryPaths of the forces that are computed
+    concurrently be computed, also concurrently, when the Position stage is
+    realized, rather than each when it is first needed; e.g., so that
+    computing a muscle's force does not wait on its path. This has an effect
+    only if getNumForceThreads() is not 1, and takes effect at the next call
+    to initSystem() on this %Model. The default is false, since the paths are
+    then computed at every realization of Position (e.g., during assembly),
+    whether or not they are needed. @see ParallelForceAdapter **/
+    void setPrecomputePaths(bool precompute) {_precomputePaths=precompute;}
+    /** Return the current setting of the "precompute paths" flag. **/
+    bool getPrecomputePaths() const {return _precomputePaths;}
+
     /** Test whether a ModelVisualizer has been created for this Model. Even
     if visualization has been requested there will be no visualizer present
     until initSystem() has been successfully invoked. Use this method prior
@@ -421,12 +502,114 @@ public:
      */
     void assemble(SimTK::State& state, const Coordinate *coord = NULL, double weight = 10);
 
+    /**
+     * %Set the values of several coordinates, as Coordinate::setValue() does
+     * (clamped coordinates are pulled into range, and locked coordinates are
+     * left as they are), and then, if enforceConstraints is true, satisfy the
+     * constraints once, rather than once per coordinate. When assembling, the
+     * coordinates that were set are not weighted more heavily than the
+     * others.
+     * @param state    the State whose coordinates are set
+     * @param names    names of coordinates in the model's CoordinateSet
+     * @param values   one value per coordinate
+     * @param enforceConstraints  assemble (or, if the model has no
+     *                            constraints, realize to Position) at the end
+     * @throws Exception if a coordinate is not in the model, or if the number
+     *         of values does not match the number of coordinates.
+     */
+    void setCoordinateValues(SimTK::State& state,
+                             const std::vector<std::string>& names,
+                             const SimTK::Vector& values,
+                             bool enforceConstraints = true);
+    /** Same as above, but with the indices of the coordinates in the model's
+    CoordinateSet, to avoid looking up names (e.g., when posing the model at
+    many frames). */
+    void setCoordinateValues(SimTK::State& state,
+                             const std::vector<int>& indices,
+                             const SimTK::Vector& values,
+                             bool enforceConstraints = true);
+
 
     /**
      * Update the state of all Muscles so they are in equilibrium.
      */
     void equilibrateMuscles(SimTK::State& state);
 
+    /**
+     * Update the state of all Muscles so they are in equilibrium, as
+     * equilibrateMuscles(state) does, with options for re-equilibrating many
+     * similar States.
+     *
+     * @param state      The State to update.
+     * @param warmStart  If true, start each muscle's solver from the fiber
+     *                   state already in `state` (e.g., the equilibrium of a
+     *                   previous State that `state` was copied from) rather
+     *                   than from the muscle's default initial guess.
+     * @param numThreads The number of threads over which to divide the
+     *                   muscles (0 for the number of hardware threads). Each
+     *                   thread works on its own copy of `state`, from which
+     *                   the state variables of its muscles are copied back.
+     * @returns The number of solver iterations taken by each muscle, in the
+     *          order of getComponentList<Muscle>(); -1 for muscles that do
+     *          not apply force, or that do not report it (see
+     *          Muscle::computeEquilibrium(SimTK::State&, bool)).
+     * @throws Exception if any muscle could not be equilibrated (after
+     *         the others have been).
+     */
+    std::vector<int> equilibrateMuscles(SimTK::State& state, bool warmStart,
+                                        int numThreads = 1);
+
+    /**
+     * Assemble the partial derivatives of the time derivatives of the
+     * muscles' state variables with respect to their own state variables
+     * and controls (see Muscle::calcStateDerivativeJacobian()). Since each
+     * muscle's state derivatives depend on its own states only (for a given
+     * multibody state), these form a block-diagonal part of the Jacobian of
+     * the System's state derivatives.
+     *
+     * @param state   The State, realized to Stage::Velocity.
+     * @param dYdotdY Resized to the size of the System's Y vector
+     *                (state.getNY()) squared, where the entries between
+     *                state variables of the same muscle are filled in and all
+     *                others are zero.
+     * @param dYdotdU Resized to state.getNY() by getNumControls(),
+     *                where the entries of the muscles' state variables with
+     *                respect to their own controls are filled in and all
+     *                others are zero.
+     */
+    void calcMuscleStateDerivativeJacobian(const SimTK::State& state,
+                                           SimTK::Matrix& dYdotdY,
+                                           SimTK::Matrix& dYdotdU) const;
+
+    /**
+     * Calculate the residuals of the Model's differential equations in
+     * implicit form, f(y, ydot, lambda) = 0, for guesses of the time
+     * derivatives of the System's state variables (and of the constraint
+     * multipliers), e.g., for a direct collocation method or an implicit
+     * integrator. The residuals are zero for the state derivatives computed
+     * by realizing the State to Stage::Acceleration. Their entries, indexed
+     * like SimTK::State::getY(), are:
+     *   - for the generalized coordinates q, the guess of qdot minus qdot;
+     *   - for the generalized speeds u, the generalized forces that are
+     *     missing for the speeds to have the guessed derivatives, given the
+     *     forces applied by the Model in `state` and the constraint forces
+     *     of `lambdaGuess` (SimbodyMatterSubsystem::calcResidualForce());
+     *   - for the other state variables, those of the components that added
+     *     them (ModelComponent::calcImplicitResiduals()).
+     *
+     * The constraint errors (e.g., SimTK::State::getQErr()) are not
+     * included. The State must be realized to Stage::Dynamics.
+     *
+     * @param state       The State.
+     * @param yDotGuess   Guesses of the derivatives of the state variables,
+     *                    of size state.getNY().
+     * @param lambdaGuess Guesses of the constraint multipliers, of size
+     *                    state.getNMultipliers(), or empty to use zero.
+     */
+    SimTK::Vector calcImplicitResiduals(const SimTK::State& state,
+            const SimTK::Vector& yDotGuess,
+            const SimTK::Vector& lambdaGuess = SimTK::Vector()) const;
+
     //--------------------------------------------------------------------------
     /**@name       Access to the Simbody System and components
 
@@ -963,6 +1146,42 @@ public:
      */
     void printBasicInfo(std::ostream& aOStream = std::cout) const;
 
+    /**
+     * Print the estimated memory held by the model (see
+     * estimateMemoryUsage(), which includes the analyses in the
+     * AnalysisSet and the working State), by category and by immediate
+     * subcomponent, and the memory of this process (see
+     * MemoryUsage::getCurrentProcessMemory()).
+     */
+    void printMemoryUsage(std::ostream& out = std::cout) const;
+
+    /**
+     * A hash (32 hexadecimal digits; see ResultCache::Key) of the model's
+     * property tree, computed by walking the properties of the model and of
+     * the objects they contain, without serializing the model to XML. The
+     * model's own name is left out, so that models with the same properties
+     * have the same fingerprint whatever their names, and a computation that
+     * depends only on the model's properties and its inputs can be cached
+     * under the fingerprint (see ResultCache).
+     *
+     * With topologyOnly, only the types and names of the objects in the tree
+     * and the connections of their sockets and inputs are hashed, so that the
+     * fingerprint changes when components are added, removed, renamed or
+     * reconnected, but not when a parameter (a mass, a location, a muscle's
+     * maximum isometric force) is changed.
+     *
+     * Changes that are not reflected in properties (e.g., values set in a
+     * State, or analyses added to the AnalysisSet through the API) do not
+     * change the fingerprint.
+     *
+     * Once finalizeFromProperties() has been called, the fingerprints are
+     * cached until a property of the model or of one of its components is
+     * edited, an object is renamed, or the model is finalized again; a model with edits that have
+     * not been finalized is hashed on each call. The cache is not locked, so
+     * a model must not be fingerprinted from several threads at once.
+     */
+    std::string computeFingerprint(bool topologyOnly = false) const;
+
     /**
      * Print detailed information about the model.
      *
@@ -1025,6 +1244,8 @@ public:
     void extendFinalizeFromProperties() override;
 
     void extendConnectToModel(Model& model)  override;
+    // Add the analyses and the working State.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
     void extendAddToSystem(SimTK::MultibodySystem& system) const override; 
     void extendInitStateFromProperties(SimTK::State& state) const override;
     /**@}**/
@@ -1123,6 +1344,14 @@ private:
     // a ModelVisualizer for display.
     bool _useVisualizer;
 
+    // The number of threads over which forces are computed; see
+    // setNumForceThreads().
+    int _numForceThreads;
+
+    // Whether the paths of concurrent forces are computed when realizing
+    // Position; see setPrecomputePaths().
+    bool _precomputePaths;
+
     // Global flag used to disable all Controllers.
     bool _allControllersEnabled;
 
@@ -1156,6 +1385,8 @@ private:
     SimTK::MeasureIndex   _modelControlsIndex;
     // Default values pooled from Actuators upon system creation.
     mutable SimTK::Vector _defaultControls;
+    // The Controllers in the Model, as of the creation of the System.
+    std::vector<SimTK::ReferencePtr<const Controller>> _controllers;
 
 
     //                          VISUALIZATION
@@ -1169,6 +1400,13 @@ private:
     // copied.
     SimTK::ResetOnCopy<std::unique_ptr<ModelVisualizer>> _modelViz;
 
+    // Fingerprints computed since the model was last finalized, with all
+    // parameters [0] and of the topology only [1], and the value of
+    // Object::getNameGeneration() when each was computed; see
+    // computeFingerprint().
+    mutable SimTK::ResetOnCopy<std::string> _fingerprints[2];
+    mutable unsigned long long _fingerprintNameGenerations[2]{0, 0};
+
 //==============================================================================
 };  // END of class Model
 //==============================================================================
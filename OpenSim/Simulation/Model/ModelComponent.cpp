@@ -137,6 +137,18 @@ void ModelComponent::scale(const SimTK::State& s, const ScaleSet& scaleSet)
 void ModelComponent::postScale(const SimTK::State& s, const ScaleSet& scaleSet)
 {   extendPostScale(s, scaleSet); }
 
+void ModelComponent::computeImplicitResiduals(const SimTK::State& s,
+                                              const SimTK::Vector& yDotGuess,
+                                              SimTK::Vector& residuals) const
+{
+    const Array<std::string> names = getStateVariablesNamesAddedByComponent();
+    for (int i = 0; i < names.size(); ++i) {
+        const int iy = getStateVariableSystemIndex(names[i]);
+        residuals[iy] = yDotGuess[iy]
+                        - getStateVariableDerivativeValue(s, names[i]);
+    }
+}
+
 // (static) Returned by getScaleFactors() if scale factors not found.
 const SimTK::Vec3 ModelComponent::InvalidScaleFactors = SimTK::Vec3(0);
 
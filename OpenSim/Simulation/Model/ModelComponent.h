@@ -138,6 +138,24 @@ public:
         @see extendPostScale() */
     void postScale(const SimTK::State& s, const ScaleSet& scaleSet);
 
+    /** Calculate the residuals of the differential equations of the state
+    variables added by this component (not by its subcomponents), in
+    implicit form, f(y, ydot) = 0, for guesses of the time derivatives of
+    the System's state variables. The residuals are zero when the guesses
+    are the state derivatives. This calls the virtual
+    computeImplicitResiduals(). The State must be realized to
+    Stage::Dynamics.
+    @param s          The State.
+    @param yDotGuess  Guesses of the derivatives of all the System's state
+                      variables, indexed like SimTK::State::getY().
+    @param residuals  Indexed like yDotGuess; only the entries of this
+                      component's state variables are set.
+    @see Model::calcImplicitResiduals() */
+    void calcImplicitResiduals(const SimTK::State& s,
+                               const SimTK::Vector& yDotGuess,
+                               SimTK::Vector& residuals) const
+    {   computeImplicitResiduals(s, yDotGuess, residuals); }
+
 protected:
     /** Get the scale factors corresponding to the base OpenSim::Body of the
         specified Frame. Returns ModelComponent::InvalidScaleFactors if the
@@ -239,6 +257,18 @@ template <class T> friend class ModelComponentSet;
                             %ModelComponent should be connected. **/
     virtual void extendConnectToModel(Model& model) {};
 
+    /** Compute the residuals of the differential equations of the state
+    variables added by this component; see calcImplicitResiduals(). Override
+    this to provide an implicit form that is cheaper or better conditioned
+    than the explicit one (e.g., one that avoids solving for the state
+    derivatives). The default implementation uses the explicit form: the
+    residual of each state variable is its derivative guess minus its
+    derivative, from computeStateVariableDerivatives(). Implementations do
+    not call the parent class method for the state variables they handle. */
+    virtual void computeImplicitResiduals(const SimTK::State& s,
+                                          const SimTK::Vector& yDotGuess,
+                                          SimTK::Vector& residuals) const;
+
     // End of Model Component Basic Interface (protected virtuals).
     //@} 
 
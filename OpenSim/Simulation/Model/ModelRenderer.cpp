@@ -0,0 +1,566 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ModelRenderer.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelRenderer.h"
+#include "Model.h"
+#include <OpenSim/Common/ModelDisplayHints.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <thread>
+
+using namespace std;
+using namespace SimTK;
+
+namespace OpenSim {
+
+namespace {
+// Triangles and lines to draw, each either in ground or, for the fixed
+// geometry, in the frame of the body it is fixed to.
+struct PrimitiveLists {
+    struct Triangle {
+        Vec3 vertices[3];
+        Vec3 color;
+        int body;
+    };
+    struct Line {
+        Vec3 points[2];
+        Vec3 color;
+        int thickness;
+        int body;
+    };
+    vector<Triangle> triangles;
+    vector<Line> lines;
+};
+
+// The triangles of a PolygonalMesh, with polygons split into fans.
+struct TriangleMesh {
+    vector<Vec3> vertices;
+    vector<std::array<int, 3>> triangles;
+};
+
+TriangleMesh triangulate(const PolygonalMesh& mesh)
+{
+    TriangleMesh out;
+    for (int v = 0; v < mesh.getNumVertices(); ++v)
+        out.vertices.push_back(mesh.getVertexPosition(v));
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        const int first = mesh.getFaceVertex(f, 0);
+        for (int k = 2; k < mesh.getNumVerticesForFace(f); ++k) {
+            out.triangles.push_back({{first, mesh.getFaceVertex(f, k - 1),
+                                      mesh.getFaceVertex(f, k)}});
+        }
+    }
+    return out;
+}
+
+// Meshes of unit size used for the analytic shapes, made once.
+const TriangleMesh& unitSphere()
+{
+    static const TriangleMesh mesh =
+            triangulate(PolygonalMesh::createSphereMesh(1, 1));
+    return mesh;
+}
+const TriangleMesh& unitBrick()
+{
+    static const TriangleMesh mesh =
+            triangulate(PolygonalMesh::createBrickMesh(Vec3(1), 1));
+    return mesh;
+}
+const TriangleMesh& unitCylinder()
+{
+    static const TriangleMesh mesh = triangulate(
+            PolygonalMesh::createCylinderMesh(UnitVec3(YAxis), 1, 1, 1));
+    return mesh;
+}
+
+// Converts DecorativeGeometry into triangles and lines. If a state is given,
+// they are expressed in ground; otherwise, in the frame of their body.
+class PrimitiveCollector : public DecorativeGeometryImplementation {
+public:
+    PrimitiveCollector(PrimitiveLists& out,
+                       const SimbodyMatterSubsystem& matter,
+                       const State* state)
+    :   _out(out), _matter(matter), _state(state) {}
+
+    void collect(const DecorativeGeometry& geometry)
+    {
+        if (geometry.getRepresentation() == DecorativeGeometry::Hide ||
+                geometry.getOpacity() == 0)
+            return;
+        _current = &geometry;
+        const MobilizedBodyIndex body(geometry.getBodyId());
+        _body = _state ? 0 : int(body);
+        _X_FD = geometry.getTransform();
+        if (_state) {
+            _X_FD = _matter.getMobilizedBody(body).getBodyTransform(*_state)
+                    * _X_FD;
+        }
+        _scale = geometry.getScaleFactors();
+        for (int k = 0; k < 3; ++k) if (_scale[k] <= 0) _scale[k] = 1;
+        const Vec3& color = geometry.getColor();
+        _color = color[0] < 0 ? Vec3(0.8) : color;
+        geometry.implementGeometry(*this);
+    }
+
+    void implementPointGeometry(const DecorativePoint& geom) override
+    {   addLine(geom.getPoint(), geom.getPoint(), 3); }
+    void implementLineGeometry(const DecorativeLine& geom) override
+    {   addLine(geom.getPoint1(), geom.getPoint2(),
+                int(geom.getLineThickness())); }
+    void implementBrickGeometry(const DecorativeBrick& geom) override
+    {   addMesh(unitBrick(), geom.getHalfLengths()); }
+    void implementCylinderGeometry(const DecorativeCylinder& geom) override
+    {
+        const Real r = geom.getRadius();
+        addMesh(unitCylinder(), Vec3(r, geom.getHalfHeight(), r));
+    }
+    void implementCircleGeometry(const DecorativeCircle& geom) override
+    {
+        const int n = 24;
+        const Real r = geom.getRadius();
+        for (int i = 0; i < n; ++i) {
+            const Real a0 = 2*Pi*i/n, a1 = 2*Pi*(i + 1)/n;
+            addLine(Vec3(r*std::cos(a0), r*std::sin(a0), 0),
+                    Vec3(r*std::cos(a1), r*std::sin(a1), 0), 1);
+        }
+    }
+    void implementSphereGeometry(const DecorativeSphere& geom) override
+    {   addMesh(unitSphere(), Vec3(geom.getRadius())); }
+    void implementEllipsoidGeometry(const DecorativeEllipsoid& geom) override
+    {   addMesh(unitSphere(), geom.getRadii()); }
+    void implementFrameGeometry(const DecorativeFrame& geom) override
+    {
+        const Real length = geom.getAxisLength();
+        const Vec3 color = _color;
+        for (int k = 0; k < 3; ++k) {
+            Vec3 axis(0);
+            axis[k] = length;
+            _color = Vec3(0);
+            _color[k] = 1;
+            addLine(Vec3(0), axis, 2);
+        }
+        _color = color;
+    }
+    void implementTextGeometry(const DecorativeText&) override {}
+    void implementMeshGeometry(const DecorativeMesh& geom) override
+    {   addMesh(triangulate(geom.getMesh()), Vec3(1)); }
+    void implementMeshFileGeometry(const DecorativeMeshFile& geom) override
+    {   addMesh(triangulate(geom.getMesh()), Vec3(1)); }
+    void implementArrowGeometry(const DecorativeArrow& geom) override
+    {   addLine(geom.getStartPoint(), geom.getEndPoint(), 2); }
+    void implementTorusGeometry(const DecorativeTorus&) override {}
+    void implementConeGeometry(const DecorativeCone&) override {}
+
+private:
+    Vec3 toFrame(const Vec3& p_D) const
+    {   return _X_FD*_scale.elementwiseMultiply(p_D); }
+
+    void addLine(const Vec3& p1, const Vec3& p2, int thickness)
+    {
+        _out.lines.push_back({{toFrame(p1), toFrame(p2)}, _color,
+                              std::max(1, thickness), _body});
+    }
+
+    void addMesh(const TriangleMesh& mesh, const Vec3& size)
+    {
+        const auto representation = _current->getRepresentation();
+        vector<Vec3> vertices;
+        for (const auto& v : mesh.vertices)
+            vertices.push_back(toFrame(size.elementwiseMultiply(v)));
+        for (const auto& t : mesh.triangles) {
+            if (representation == DecorativeGeometry::DrawPoints) {
+                for (int k = 0; k < 3; ++k) {
+                    _out.lines.push_back({{vertices[t[k]], vertices[t[k]]},
+                                          _color, 2, _body});
+                }
+            } else if (representation == DecorativeGeometry::DrawWireframe) {
+                for (int k = 0; k < 3; ++k) {
+                    _out.lines.push_back({{vertices[t[k]],
+                                           vertices[t[(k + 1) % 3]]},
+                                          _color, 1, _body});
+                }
+            } else {
+                _out.triangles.push_back({{vertices[t[0]], vertices[t[1]],
+                                           vertices[t[2]]}, _color, _body});
+            }
+        }
+    }
+
+    PrimitiveLists& _out;
+    const SimbodyMatterSubsystem& _matter;
+    const State* _state;
+    const DecorativeGeometry* _current = nullptr;
+    int _body = 0;
+    Transform _X_FD;
+    Vec3 _scale;
+    Vec3 _color;
+};
+
+unsigned char toByte(double value)
+{
+    return (unsigned char)(255*std::min(1.0, std::max(0.0, value)) + 0.5);
+}
+} // anonymous namespace
+
+struct ModelRenderer::Primitives : PrimitiveLists {};
+
+// An orthographic camera: the point at the center of the image, the height
+// of the scene shown, and the directions of the image axes (and into the
+// image) in ground.
+struct ModelRenderer::View {
+    Vec3 center;
+    double height;
+    Vec3 right, up, forward;
+};
+
+ModelRenderer::ModelRenderer(const Model& model) :
+    _model(model), _fixedPrimitives(new Primitives)
+{
+    // The fixed geometry does not depend on the state, so it is collected
+    // (and meshes are triangulated) once.
+    const State& state = model.getWorkingState();
+    Array_<DecorativeGeometry> fixedGeometry;
+    model.generateDecorations(true, model.getDisplayHints(), state,
+                              fixedGeometry);
+    PrimitiveCollector collector(*_fixedPrimitives, model.getMatterSubsystem(),
+                                 nullptr);
+    for (const auto& geometry : fixedGeometry) collector.collect(geometry);
+}
+
+ModelRenderer::~ModelRenderer() = default;
+
+void ModelRenderer::setImageSize(int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        throw Exception("ModelRenderer: expected a positive image size, but "
+                "got " + to_string(width) + " x " + to_string(height) + ".",
+                __FILE__, __LINE__);
+    }
+    _width = width;
+    _height = height;
+}
+
+void ModelRenderer::setDecimation(int n)
+{
+    if (n <= 0) {
+        throw Exception("ModelRenderer: expected a positive decimation, but "
+                "got " + to_string(n) + ".", __FILE__, __LINE__);
+    }
+    _decimation = n;
+}
+
+void ModelRenderer::setViewDirection(const Vec3& direction, const Vec3& up)
+{
+    if (direction.norm() == 0 || (direction % up).norm() == 0) {
+        throw Exception("ModelRenderer: the view direction must be nonzero "
+                "and not parallel to the up direction.", __FILE__, __LINE__);
+    }
+    _viewDirection = direction;
+    _viewUp = up;
+}
+
+void ModelRenderer::setViewCenterAndHeight(const Vec3& center, double height)
+{
+    _viewCenter = center;
+    _viewHeight = height;
+}
+
+void ModelRenderer::setBackgroundColor(const Vec3& color)
+{
+    _backgroundColor = color;
+}
+
+void ModelRenderer::collectPrimitives(const State& state,
+                                      Primitives& out) const
+{
+    const SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    _model->getMultibodySystem().realize(state, Stage::Position);
+
+    // Place the fixed geometry with the bodies it is fixed to.
+    out.triangles.reserve(_fixedPrimitives->triangles.size());
+    for (auto triangle : _fixedPrimitives->triangles) {
+        const Transform& X_GB = matter.getMobilizedBody(
+                MobilizedBodyIndex(triangle.body)).getBodyTransform(state);
+        for (auto& vertex : triangle.vertices) vertex = X_GB*vertex;
+        out.triangles.push_back(triangle);
+    }
+    for (auto line : _fixedPrimitives->lines) {
+        const Transform& X_GB = matter.getMobilizedBody(
+                MobilizedBodyIndex(line.body)).getBodyTransform(state);
+        for (auto& point : line.points) point = X_GB*point;
+        out.lines.push_back(line);
+    }
+
+    std::lock_guard<std::mutex> lock(_decorationMutex);
+    Array_<DecorativeGeometry> geometry;
+    _model->generateDecorations(false, _model->getDisplayHints(), state,
+                                geometry);
+    PrimitiveCollector collector(out, matter, &state);
+    for (const auto& g : geometry) collector.collect(g);
+}
+
+ModelRenderer::View ModelRenderer::fitView(const Primitives& primitives) const
+{
+    View view;
+    view.forward = _viewDirection.normalize();
+    view.right = (_viewUp % -view.forward).normalize();
+    view.up = -view.forward % view.right;
+    view.center = _viewCenter;
+    view.height = _viewHeight;
+    if (_viewHeight > 0) return view;
+
+    // Fit the bounding box of the geometry (in the image plane), with a
+    // margin.
+    const Real inf = std::numeric_limits<Real>::infinity();
+    Vec2 low(inf), high(-inf);
+    auto extend = [&](const Vec3& p) {
+        const Vec2 q(~p*view.right, ~p*view.up);
+        for (int k = 0; k < 2; ++k) {
+            low[k] = std::min(low[k], q[k]);
+            high[k] = std::max(high[k], q[k]);
+        }
+    };
+    for (const auto& t : primitives.triangles)
+        for (const auto& v : t.vertices) extend(v);
+    for (const auto& l : primitives.lines)
+        for (const auto& p : l.points) extend(p);
+    if (low[0] > high[0]) {
+        view.center = Vec3(0);
+        view.height = 1;
+        return view;
+    }
+    const Vec2 mid = (low + high)/2;
+    view.center = mid[0]*view.right + mid[1]*view.up;
+    view.height = 1.1*std::max(high[1] - low[1],
+                               (high[0] - low[0])*_height/_width);
+    if (view.height <= 0) view.height = 1;
+    return view;
+}
+
+ModelRenderer::Image ModelRenderer::rasterize(const Primitives& primitives,
+                                              const View& view) const
+{
+    Image image;
+    image.width = _width;
+    image.height = _height;
+    image.pixels.resize(3*_width*_height);
+    for (int i = 0; i < _width*_height; ++i)
+        for (int k = 0; k < 3; ++k)
+            image.pixels[3*i + k] = toByte(_backgroundColor[k]);
+    vector<float> depth(_width*_height, std::numeric_limits<float>::max());
+
+    // Pixel coordinates (x right, y down) and depth of a point in ground.
+    const double scale = _height/view.height;
+    auto project = [&](const Vec3& p) {
+        const Vec3 d = p - view.center;
+        return Vec3(0.5*_width + scale*(~d*view.right),
+                    0.5*_height - scale*(~d*view.up),
+                    ~d*view.forward);
+    };
+    auto setPixel = [&](int x, int y, double z, const Vec3& color) {
+        const int i = y*_width + x;
+        if (z >= depth[i]) return;
+        depth[i] = float(z);
+        for (int k = 0; k < 3; ++k)
+            image.pixels[3*i + k] = toByte(color[k]);
+    };
+
+    for (const auto& t : primitives.triangles) {
+        const Vec3 a = project(t.vertices[0]);
+        const Vec3 b = project(t.vertices[1]);
+        const Vec3 c = project(t.vertices[2]);
+        const double area = (b[0] - a[0])*(c[1] - a[1]) -
+                            (b[1] - a[1])*(c[0] - a[0]);
+        if (area == 0) continue;
+        // Flat shading, lit from the camera.
+        const Vec3 normal = (t.vertices[1] - t.vertices[0]) %
+                            (t.vertices[2] - t.vertices[0]);
+        const double norm = normal.norm();
+        const double light = norm == 0 ? 1 :
+                0.3 + 0.7*std::abs(~normal*view.forward)/norm;
+        const Vec3 color = light*t.color;
+
+        const int x0 = std::max(0,
+                int(std::floor(std::min({a[0], b[0], c[0]}))));
+        const int x1 = std::min(_width - 1,
+                int(std::ceil(std::max({a[0], b[0], c[0]}))));
+        const int y0 = std::max(0,
+                int(std::floor(std::min({a[1], b[1], c[1]}))));
+        const int y1 = std::min(_height - 1,
+                int(std::ceil(std::max({a[1], b[1], c[1]}))));
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                const double px = x + 0.5, py = y + 0.5;
+                const double wa = ((b[0] - px)*(c[1] - py) -
+                                   (b[1] - py)*(c[0] - px))/area;
+                const double wb = ((c[0] - px)*(a[1] - py) -
+                                   (c[1] - py)*(a[0] - px))/area;
+                const double wc = 1 - wa - wb;
+                if (wa < 0 || wb < 0 || wc < 0) continue;
+                setPixel(x, y, wa*a[2] + wb*b[2] + wc*c[2], color);
+            }
+        }
+    }
+
+    // Lines are drawn slightly in front of surfaces they lie on.
+    const double bias = 2e-3*view.height;
+    for (const auto& l : primitives.lines) {
+        const Vec3 a = project(l.points[0]);
+        const Vec3 b = project(l.points[1]);
+        const int steps = std::max(1, int(std::ceil(std::max(
+                std::abs(b[0] - a[0]), std::abs(b[1] - a[1])))));
+        const int half = l.thickness/2;
+        for (int s = 0; s <= steps; ++s) {
+            const Vec3 p = a + (b - a)*(double(s)/steps);
+            const int cx = int(std::floor(p[0])), cy = int(std::floor(p[1]));
+            for (int y = cy - half; y <= cy - half + l.thickness - 1; ++y) {
+                if (y < 0 || y >= _height) continue;
+                for (int x = cx - half; x <= cx - half + l.thickness - 1;
+                        ++x) {
+                    if (x < 0 || x >= _width) continue;
+                    setPixel(x, y, p[2] - bias, l.color);
+                }
+            }
+        }
+    }
+    return image;
+}
+
+ModelRenderer::Image ModelRenderer::render(const State& state) const
+{
+    Primitives primitives;
+    collectPrimitives(state, primitives);
+    return rasterize(primitives, fitView(primitives));
+}
+
+template <typename WriteFrame>
+int ModelRenderer::renderTrajectory(const StatesTrajectory& states,
+                                    const WriteFrame& writeFrame) const
+{
+    // The view is fit to the first frame, and kept for the others.
+    View view;
+    int numFrames = 0;
+    for (size_t i = 0; i < states.getSize(); i += _decimation) {
+        Primitives primitives;
+        collectPrimitives(states.get(i), primitives);
+        if (numFrames == 0) view = fitView(primitives);
+        writeFrame(rasterize(primitives, view), numFrames);
+        ++numFrames;
+    }
+    return numFrames;
+}
+
+int ModelRenderer::renderToFiles(const StatesTrajectory& states,
+                                 const string& filePrefix) const
+{
+    return renderTrajectory(states, [&](const Image& image, int frame) {
+        char number[16];
+        std::snprintf(number, sizeof(number), "%05d", frame);
+        writePPM(image, filePrefix + number + ".ppm");
+    });
+}
+
+int ModelRenderer::renderToStream(const StatesTrajectory& states,
+                                  std::ostream& out) const
+{
+    return renderTrajectory(states, [&](const Image& image, int) {
+        writePPM(image, out);
+    });
+}
+
+void ModelRenderer::renderTrialsToFiles(
+        const vector<StatesTrajectory>& trials,
+        const vector<string>& filePrefixes) const
+{
+    if (trials.size() != filePrefixes.size()) {
+        throw Exception("ModelRenderer: expected a file prefix for each of "
+                "the " + to_string(trials.size()) + " trials, but got " +
+                to_string(filePrefixes.size()) + ".", __FILE__, __LINE__);
+    }
+    const int numTrials = int(trials.size());
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, numTrials));
+
+    // Trials are handed out one at a time, so that a thread that finishes
+    // its trial early takes the next one instead of idling.
+    vector<string> errors(numTrials);
+    std::atomic<int> nextTrial(0);
+    auto renderTrials = [&]() {
+        for (int i = nextTrial++; i < numTrials; i = nextTrial++) {
+            try {
+                renderToFiles(trials[i], filePrefixes[i]);
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+    };
+    vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(renderTrials);
+        } catch (const std::system_error&) {
+            // Could not start a thread; the remaining threads take its
+            // trials.
+            break;
+        }
+    }
+    renderTrials();
+    for (auto& thread : threads) thread.join();
+
+    string message;
+    for (int i = 0; i < numTrials; ++i) {
+        if (!errors[i].empty())
+            message += "\n  " + filePrefixes[i] + ": " + errors[i];
+    }
+    if (!message.empty()) {
+        throw Exception("ModelRenderer: could not render trials:" + message,
+                        __FILE__, __LINE__);
+    }
+}
+
+void ModelRenderer::writePPM(const Image& image, std::ostream& out)
+{
+    out << "P6\n" << image.width << " " << image.height << "\n255\n";
+    out.write(reinterpret_cast<const char*>(image.pixels.data()),
+              image.pixels.size());
+}
+
+void ModelRenderer::writePPM(const Image& image, const string& fileName)
+{
+    std::ofstream out(fileName, std::ios::binary);
+    if (out) writePPM(image, out);
+    if (!out) {
+        throw Exception("ModelRenderer: could not write image file '" +
+                        fileName + "'.", __FILE__, __LINE__);
+    }
+}
+
+} // end of namespace OpenSim
@@ -0,0 +1,184 @@
+#ifndef OPENSIM_MODEL_RENDERER_H_
+#define OPENSIM_MODEL_RENDERER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ModelRenderer.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon/internal/ReferencePtr.h>
+#include <SimTKcommon/SmallMatrix.h>
+
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SimTK {
+class State;
+}
+
+namespace OpenSim {
+
+class Model;
+class StatesTrajectory;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Render frames of a Model to images without a window or a graphics device,
+ * e.g., to make review videos of many trials on a machine without a display.
+ *
+ * The geometry drawn is that of the ModelVisualizer: the fixed geometry of
+ * the model's components (collected once, when the renderer is constructed,
+ * so that the meshes loaded by Mesh components are reused for every frame),
+ * and the geometry that depends on the state (e.g., muscle paths), generated
+ * for each frame as directed by the model's ModelDisplayHints. Frames are
+ * drawn with an orthographic camera and flat shading by a software
+ * rasterizer; text, cones and tori are not drawn, and all geometry is drawn
+ * opaque.
+ *
+ * Images are written in the binary PPM format (.ppm), which most image tools
+ * read. A sequence of frames written to a stream (see renderToStream()) can
+ * be piped into a video encoder, e.g.:
+ * @code{.sh}
+ * ffmpeg -f image2pipe -c:v ppm -framerate 30 -i - trial.mp4
+ * @endcode
+ *
+ * @code
+ * ModelRenderer renderer(model);
+ * renderer.setImageSize(1280, 720);
+ * renderer.setDecimation(4); // every 4th state
+ * renderer.renderToFiles(states, "frames/trial01_");
+ * @endcode
+ *
+ * Trials are rendered concurrently with renderTrialsToFiles(). The states of
+ * all trials must belong to the model's System (see Model::initSystem()).
+ */
+class OSIMSIMULATION_API ModelRenderer
+{
+public:
+    /** An RGB image, with 8 bits per channel; the pixels are stored row by
+    row, from the top left. */
+    struct Image {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    /** The model must have been initialized (see Model::initSystem()), and
+    must outlive this renderer. */
+    explicit ModelRenderer(const Model& model);
+    ~ModelRenderer();
+
+    ModelRenderer(const ModelRenderer&) = delete;
+    void operator=(const ModelRenderer&) = delete;
+
+    /** Size of the images, in pixels (default: 640 x 480). */
+    void setImageSize(int width, int height);
+    int getImageWidth() const { return _width; }
+    int getImageHeight() const { return _height; }
+
+    /** Render every n-th state of a trajectory, starting with the first
+    (default: 1, every state). */
+    void setDecimation(int n);
+    int getDecimation() const { return _decimation; }
+
+    /** Look at the model from the given direction, with the given direction
+    up in the image (default: looking along -Z, with +Y up, as the Simbody
+    visualizer does). */
+    void setViewDirection(const SimTK::Vec3& direction,
+                          const SimTK::Vec3& up);
+    /** The point in ground at the center of the images, and the height of
+    the scene (in ground) shown by the images. If the height is not positive
+    (the default), the view is fit to the geometry of the first frame
+    rendered (of each trajectory, for renderToFiles() and renderToStream()).
+    */
+    void setViewCenterAndHeight(const SimTK::Vec3& center, double height);
+
+    void setBackgroundColor(const SimTK::Vec3& color);
+
+    /** Number of trials rendered at once by renderTrialsToFiles(); if not
+    positive (the default), the number of hardware threads is used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Render the model at the given state. */
+    Image render(const SimTK::State& state) const;
+
+    /** Render (every getDecimation()-th state of) a trajectory to files
+    named `<filePrefix>00000.ppm`, `<filePrefix>00001.ppm`, etc., and return
+    the number of files written.
+    @throws Exception If a file cannot be written. */
+    int renderToFiles(const StatesTrajectory& states,
+                      const std::string& filePrefix) const;
+    /** Render (every getDecimation()-th state of) a trajectory to a stream,
+    one PPM image after another, and return the number of images written. */
+    int renderToStream(const StatesTrajectory& states,
+                       std::ostream& out) const;
+    /** Render several trials concurrently, each as renderToFiles() does, with
+    its own file prefix. A trial that fails does not stop the others.
+    @throws Exception After all trials are done, listing the trials that
+            failed, if any. */
+    void renderTrialsToFiles(const std::vector<StatesTrajectory>& trials,
+            const std::vector<std::string>& filePrefixes) const;
+
+    /** Write an image in the binary PPM format. */
+    static void writePPM(const Image& image, std::ostream& out);
+    /** Write an image to a PPM file.
+    @throws Exception If the file cannot be written. */
+    static void writePPM(const Image& image, const std::string& fileName);
+
+private:
+    struct Primitives;
+    struct View;
+
+    // Collect the geometry to draw at a state, in ground.
+    void collectPrimitives(const SimTK::State& state, Primitives& out) const;
+    View fitView(const Primitives& primitives) const;
+    Image rasterize(const Primitives& primitives, const View& view) const;
+    template <typename WriteFrame>
+    int renderTrajectory(const StatesTrajectory& states,
+                         const WriteFrame& writeFrame) const;
+
+    SimTK::ReferencePtr<const Model> _model;
+    int _width = 640;
+    int _height = 480;
+    int _decimation = 1;
+    SimTK::Vec3 _viewDirection{0, 0, -1};
+    SimTK::Vec3 _viewUp{0, 1, 0};
+    SimTK::Vec3 _viewCenter{0};
+    double _viewHeight = 0;
+    SimTK::Vec3 _backgroundColor{0.15, 0.15, 0.2};
+    int _numThreads = -1;
+
+    // The fixed geometry, in the frames of the bodies it is fixed to.
+    std::unique_ptr<Primitives> _fixedPrimitives;
+    // Generating decorations copies (reference-counted) meshes, so it is
+    // done by one thread at a time.
+    mutable std::mutex _decorationMutex;
+
+};  // END of class ModelRenderer
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MODEL_RENDERER_H_
@@ -23,10 +23,17 @@
 
 #include "ModelVisualizer.h"
 #include "Model.h"
+#include "ContactGeometry.h"
 #include <OpenSim/version.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <simbody/internal/Visualizer_InputListener.h>
-#include <simbody/internal/Visualizer_Reporter.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
 
 #include <string>
 using std::string;
@@ -100,6 +107,107 @@ private:
     Model&  _model;
 };
 
+/* This reporter is added to the System so that frames of a simulation are
+shown at regular intervals of simulated time. It goes through
+ModelVisualizer::show() so that the frames are streamed when streaming is
+enabled. */
+class ModelVisualizerReporter : public PeriodicEventReporter {
+public:
+    ModelVisualizerReporter(const ModelVisualizer& viz, Real interval)
+    :   PeriodicEventReporter(interval), _viz(viz) {}
+
+    void handleEvent(const State& state) const override {
+        _viz.show(state);
+    }
+private:
+    const ModelVisualizer&  _viz;
+};
+
+//==============================================================================
+//                              FRAME STREAMER
+//==============================================================================
+/* This class owns the visualization thread used while frames are streamed.
+push() stores a copy of the State in a single slot, replacing any State that
+has not been drawn yet, and returns. The thread takes the State in the slot
+and draws it, no sooner than one frame period after the previous frame. On
+destruction, the State left in the slot, if any, is drawn before the thread
+exits. */
+class ModelVisualizer::FrameStreamer {
+public:
+    FrameStreamer(const ModelVisualizer& viz, double framesPerSecond)
+    :   _viz(viz),
+        _framePeriod(std::chrono::duration<double>(1/framesPerSecond)),
+        _thread(&FrameStreamer::run, this) {}
+
+    ~FrameStreamer() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wakeUp.notify_one();
+        _thread.join();
+    }
+
+    void push(const State& state) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_hasPending) ++_numDropped;
+            _pending = state;
+            _hasPending = true;
+        }
+        _wakeUp.notify_one();
+    }
+
+    int getNumStreamed() const {return _numStreamed;}
+    int getNumDropped() const {return _numDropped;}
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto nextFrame = std::chrono::steady_clock::now();
+        State state;
+        while (true) {
+            _wakeUp.wait(lock, [this] {return _hasPending || _stop;});
+            if (!_hasPending) break;
+            // Wait for the frame period to pass, letting later States
+            // replace this one, unless we are stopping.
+            _wakeUp.wait_until(lock, nextFrame, [this] {return _stop;});
+            state = _pending;
+            _hasPending = false;
+            lock.unlock();
+
+            try {
+                _viz.getModel().getMultibodySystem().realize(state,
+                                                       Stage::Velocity);
+                _viz.getSimbodyVisualizer().report(state);
+            } catch (const std::exception& e) {
+                cerr << "ModelVisualizer: could not draw frame: "
+                     << e.what() << endl;
+            }
+            nextFrame = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<
+                        std::chrono::steady_clock::duration>(_framePeriod);
+            ++_numStreamed;
+            lock.lock();
+        }
+    }
+
+    const ModelVisualizer&                  _viz;
+    const std::chrono::duration<double>     _framePeriod;
+
+    std::mutex                  _mutex;
+    std::condition_variable     _wakeUp;
+    State                       _pending;
+    bool                        _hasPending = false;
+    bool                        _stop = false;
+    std::atomic<int>            _numStreamed{0};
+    std::atomic<int>            _numDropped{0};
+
+    // Declared last, so that the members above are initialized before the
+    // thread starts.
+    std::thread                 _thread;
+};
+
 
 
 
@@ -118,23 +226,89 @@ void DefaultGeometry::drawPathPoint(const MobilizedBodyIndex&             body,
                 .setOpacity(0.8));
 }
 
+DefaultGeometry::~DefaultGeometry() = default;
+
+void DefaultGeometry::updateCache(const State& state)
+{
+    const ModelDisplayHints& hints = _model.getDisplayHints();
+    _cachedHints.reset(hints.clone());
+    _cachedGeometry.clear();
+    _uncachedComponents.clear();
+    for (const auto& comp : _model.getComponentList()) {
+        // ContactGeometry is fixed to its frame, but is generated with the
+        // dynamic geometry so that it can be turned on and off.
+        if (dynamic_cast<const OpenSim::ContactGeometry*>(&comp))
+            comp.generateDecorations(false, hints, state, _cachedGeometry);
+        else
+            _uncachedComponents.push_back(&comp);
+    }
+}
+
 void DefaultGeometry::generateDecorations
    (const State&                         state, 
     Array_<SimTK::DecorativeGeometry>&   geometry) 
 {
-    // Ask all the ModelComponents to generate dynamic geometry.
-    _model.generateDecorations(false, _model.getDisplayHints(),
-                               state, geometry);
+    // Ask all the ModelComponents to generate dynamic geometry, reusing the
+    // geometry that depends only on the display hints.
+    const ModelDisplayHints& hints = _model.getDisplayHints();
+    if (!_cachedHints || !(*_cachedHints == hints))
+        updateCache(state);
+    for (const auto& deco : _cachedGeometry)
+        geometry.push_back(deco);
+    for (const auto* comp : _uncachedComponents)
+        comp->generateDecorations(false, hints, state, geometry);
 }
 
 //==============================================================================
 //                            MODEL VISUALIZER
 //==============================================================================
 
+ModelVisualizer::ModelVisualizer(Model& model) : _model(model), _viz(0) {
+    clear();
+    createVisualizer();
+}
+
+ModelVisualizer::~ModelVisualizer() {clear();}
+
+void ModelVisualizer::clear() {
+    // Stop streaming before the Visualizer goes away.
+    _streamer.reset();
+    delete _viz; _viz = 0;
+    _silo = 0; // Visualizer will have deleted this.
+}
+
 void ModelVisualizer::show(const SimTK::State& state) const {
     // Make sure we're realized at least through Velocity stage.
     _model.getMultibodySystem().realize(state, SimTK::Stage::Velocity);
-    getSimbodyVisualizer().report(state);
+    if (_streamer) _streamer->push(state);
+    else getSimbodyVisualizer().report(state);
+}
+
+void ModelVisualizer::setStreamingFrameRate(double framesPerSecond) {
+    if (framesPerSecond < 0) {
+        throw Exception("ModelVisualizer::setStreamingFrameRate(): expected "
+                "a frame rate of zero or more, but got " +
+                std::to_string(framesPerSecond) + ".");
+    }
+    // The current streamer, if any, draws the last State shown before it
+    // goes away.
+    _streamer.reset();
+    _streamingFrameRate = framesPerSecond;
+    if (framesPerSecond == 0) return;
+    try {
+        _streamer.reset(new FrameStreamer(*this, framesPerSecond));
+    } catch (const std::system_error&) {
+        // Could not start the visualization thread; show() draws the frames
+        // itself.
+    }
+}
+
+int ModelVisualizer::getNumFramesStreamed() const {
+    return _streamer ? _streamer->getNumStreamed() : 0;
+}
+
+int ModelVisualizer::getNumFramesDropped() const {
+    return _streamer ? _streamer->getNumDropped() : 0;
 }
 
 // See if we can find the given file. The rules are
@@ -298,7 +472,7 @@ void ModelVisualizer::createVisualizer() {
     // This is used for regular output of frames during forward dynamics.
     // TODO: allow user control of timing.
     _model.updMultibodySystem().addEventReporter
-        (new SimTK::Visualizer::Reporter(*_viz, 1./30));
+        (new ModelVisualizerReporter(*this, 1./30));
 }
 
 // We also rummage through the model to find fixed geometry that should be part
@@ -29,9 +29,14 @@ that provides some visualization and user interaction when running a program
 that uses the OpenSim API. **/
 
 #include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Common/ModelDisplayHints.h>
 #include <simbody/internal/Visualizer.h>
 
+#include <memory>
+#include <vector>
+
 namespace OpenSim {
+class Component;
 class Model;
 }
 
@@ -43,7 +48,9 @@ namespace SimTK {
 //==============================================================================
 // This class implements a SimTK DecorationGenerator. We'll add one to the
 // Visualizer so it can invoke the generateDecorations() dispatcher to pick up 
-// per-frame geometry.
+// per-frame geometry. The geometry of ContactGeometry components depends only
+// on the display hints, so it is generated once and reused until the hints
+// change; the other components are asked for their geometry every frame.
 class DefaultGeometry : public DecorationGenerator {
 public:
     DefaultGeometry(OpenSim::Model& model) : _model(model) {
@@ -54,6 +61,7 @@ public:
         _dispContactOpacity = 0.75;
         _dispContactResolution = 2.0;
     }
+    ~DefaultGeometry() override;
     void generateDecorations(const SimTK::State& state, 
                              SimTK::Array_<SimTK::DecorativeGeometry>& geometry) override;
     double getDispMarkerRadius() {return _dispMarkerRadius;}
@@ -77,8 +85,17 @@ static void drawPathPoint(const SimTK::MobilizedBodyIndex&             body,
                           SimTK::Array_<SimTK::DecorativeGeometry>&    geometry);
 
 private:
+    // Sort the components into those whose geometry is cached and the rest,
+    // and generate the cached geometry, for the current display hints.
+    void updateCache(const SimTK::State& state);
+
     OpenSim::Model&  _model;
 
+    // The display hints for which the cache was last updated.
+    std::unique_ptr<OpenSim::ModelDisplayHints>  _cachedHints;
+    SimTK::Array_<SimTK::DecorativeGeometry>     _cachedGeometry;
+    std::vector<const OpenSim::Component*>       _uncachedComponents;
+
     // Displayer internal variables
     double _dispMarkerRadius;
     double _dispMarkerOpacity;
@@ -115,13 +132,21 @@ visualizer. The search proceeds in the following order:
   -- Platform specific default locations of binaries. For Linux/MacOS, this may
      be /usr/bin, /usr/local/bin etc. For Windows, this set is empty.
 
+By default, show() draws each frame before it returns, so a simulation that
+is visualized (see Model::setUseVisualizer()) runs no faster than frames can
+be drawn. With setStreamingFrameRate(), show() instead hands a copy of the
+State to a visualization thread and returns; that thread draws at most the
+given number of frames per second, and the States shown while it is busy or
+waiting replace each other, so that only the latest is drawn. The integrator
+never waits for the drawing, and the last State shown is always drawn.
+
 @author Michael Sherman
 
 @see ModelDisplayHints, Model **/
 class OSIMSIMULATION_API ModelVisualizer {
 public:
 
-    ~ModelVisualizer() {clear();}
+    ~ModelVisualizer();
 
     /** @name                Drawing methods
     Currently there is just a single method for generating a frame. **/
@@ -131,6 +156,24 @@ public:
     void show(const SimTK::State& state) const;
     /**@}**/
 
+    /** @name                Streaming frames
+    Draw frames on a visualization thread, at a capped rate, rather than in
+    show(). While frames are streamed, the underlying SimTK::Visualizer
+    should not be used to draw frames directly. **/
+    /**@{**/
+    /** If positive, show() hands its State to a visualization thread that
+    draws at most this many frames per second, dropping the States shown in
+    between; if zero (the default), show() draws the frame itself. Setting
+    this to zero waits for the last State shown to be drawn. **/
+    void setStreamingFrameRate(double framesPerSecond);
+    double getStreamingFrameRate() const {return _streamingFrameRate;}
+    /** The number of frames drawn by the visualization thread, and the number
+    of States shown that were replaced by later ones before they could be
+    drawn, since streaming was enabled (zero if frames are not streamed). **/
+    int getNumFramesStreamed() const;
+    int getNumFramesDropped() const;
+    /**@}**/
+
     /** @name       Access to SimTK::Visualizer features
     These methods provide access to lower-level SimTK::Visualizer objects
     that are used in the implementation of this ModelVisualizer. **/
@@ -224,27 +267,26 @@ private:
     // Only Model is permitted to create one of these. Note that
     // this will cause modifications to System that must occur prior to 
     // realizeTopology().
-    ModelVisualizer(Model& model) : _model(model), _viz(0) {
-        clear();
-        createVisualizer();
-    }
+    ModelVisualizer(Model& model);
 
     // Called from Model's initSystem() method; state must be realized 
     // through Instance stage.
     void collectFixedGeometry(const SimTK::State& state) const;
 
-    void clear() {
-        delete _viz; _viz = 0;
-        _silo = 0; // Visualizer will have deleted this.
-    }
+    void clear();
 
     void createVisualizer();
 
+    class FrameStreamer;
+
 private:
     Model&                       _model;
     SimTK::Visualizer*           _viz;
     SimTK::DefaultGeometry*      _decoGen;
 
+    double                          _streamingFrameRate = 0;
+    std::unique_ptr<FrameStreamer>  _streamer;
+
     // This is just a reference -- it is owned by the Simbody Visualizer so 
     // don't delete it!
     SimTK::Visualizer::InputSilo*   _silo;
@@ -147,6 +147,9 @@ void Muscle::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 void Muscle::constructProperties()
 {
     constructProperty_max_isometric_force(1000.0);
+    // Only read while computing the muscle's force (see
+    // extendParameterChanged()).
+    updProperty_max_isometric_force().setIsParameterOnly(true);
     constructProperty_optimal_fiber_length(0.1);
     constructProperty_tendon_slack_length(0.2);
     constructProperty_pennation_angle_at_optimal(0.0);
@@ -211,6 +214,14 @@ void Muscle::extendConnectToModel(Model& aModel)
     _tendonSlackLength = getTendonSlackLength();
 }
 
+void Muscle::extendParameterChanged(const AbstractProperty& property)
+{
+    Super::extendParameterChanged(property);
+
+    if (property.getName() == "max_isometric_force")
+        _maxIsometricForce = getMaxIsometricForce();
+}
+
 // Add Muscle's contributions to the underlying system
  void Muscle::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
@@ -225,14 +236,16 @@ void Muscle::extendConnectToModel(Model& aModel)
     //              both the position and velocity of the multibody system and
     //              the muscles path before solving for the fiber length and
     //              velocity in the reduced model.
-    addCacheVariable<Muscle::MuscleLengthInfo>
+    _lengthInfoCV = addCacheVariable<Muscle::MuscleLengthInfo>
        ("lengthInfo", MuscleLengthInfo(), SimTK::Stage::Velocity);
-    addCacheVariable<Muscle::FiberVelocityInfo>
+    _velInfoCV = addCacheVariable<Muscle::FiberVelocityInfo>
        ("velInfo", FiberVelocityInfo(), SimTK::Stage::Velocity);
-    addCacheVariable<Muscle::MuscleDynamicsInfo>
+    _dynamicsInfoCV = addCacheVariable<Muscle::MuscleDynamicsInfo>
        ("dynamicsInfo", MuscleDynamicsInfo(), SimTK::Stage::Dynamics);
-    addCacheVariable<Muscle::MusclePotentialEnergyInfo>
+    _potentialEnergyInfoCV = addCacheVariable<Muscle::MusclePotentialEnergyInfo>
        ("potentialEnergyInfo", MusclePotentialEnergyInfo(), SimTK::Stage::Velocity);
+    _realizedStateCV = addCacheVariable<Muscle::RealizedMuscleState>
+       ("realizedMuscleState", RealizedMuscleState(), SimTK::Stage::Dynamics);
  }
 
 void Muscle::extendSetPropertiesFromState(const SimTK::State& state)
@@ -509,82 +522,204 @@ void Muscle::setExcitation(SimTK::State& s, double excitation) const
     setControls(SimTK::Vector(1, excitation), _model->updControls(s));
 }
 
+const Muscle::RealizedMuscleState&
+Muscle::getRealizedMuscleState(const SimTK::State& s) const
+{
+    if(isCacheVariableValid(s, _realizedStateCV) &&
+            isCacheVariableValid(s, _dynamicsInfoCV))
+        return getCacheVariableValue(s, _realizedStateCV);
+
+    const MuscleLengthInfo& mli = getMuscleLengthInfo(s);
+    const FiberVelocityInfo& fvi = getFiberVelocityInfo(s);
+    const MuscleDynamicsInfo& mdi = getMuscleDynamicsInfo(s);
+
+    RealizedMuscleState& rms = updCacheVariableValue(s, _realizedStateCV);
+    rms.fiberLength = mli.fiberLength;
+    rms.normalizedFiberLength = mli.normFiberLength;
+    rms.pennationAngle = mli.pennationAngle;
+    rms.cosPennationAngle = mli.cosPennationAngle;
+    rms.tendonLength = mli.tendonLength;
+    rms.tendonStrain = mli.tendonStrain;
+    rms.activeForceLengthMultiplier = mli.fiberActiveForceLengthMultiplier;
+    rms.passiveForceMultiplier = mli.fiberPassiveForceLengthMultiplier;
+
+    rms.fiberVelocity = fvi.fiberVelocity;
+    rms.normalizedFiberVelocity = fvi.normFiberVelocity;
+    rms.fiberVelocityAlongTendon = fvi.fiberVelocityAlongTendon;
+    rms.tendonVelocity = fvi.tendonVelocity;
+    rms.forceVelocityMultiplier = fvi.fiberForceVelocityMultiplier;
+    rms.pennationAngularVelocity = fvi.pennationAngularVelocity;
+
+    rms.activation = mdi.activation;
+    rms.fiberForce = mdi.fiberForce;
+    rms.fiberForceAlongTendon = mdi.fiberForceAlongTendon;
+    rms.activeFiberForce = mdi.activeFiberForce;
+    rms.passiveFiberForce = mdi.passiveFiberForce;
+    rms.activeFiberForceAlongTendon =
+        mdi.activeFiberForce * mli.cosPennationAngle;
+    rms.passiveFiberForceAlongTendon =
+        mdi.passiveFiberForce * mli.cosPennationAngle;
+    rms.tendonForce = getMaxIsometricForce() * mdi.normTendonForce;
+    rms.fiberStiffness = mdi.fiberStiffness;
+    rms.fiberStiffnessAlongTendon = mdi.fiberStiffnessAlongTendon;
+    rms.tendonStiffness = mdi.tendonStiffness;
+    rms.muscleStiffness = mdi.muscleStiffness;
+    rms.fiberActivePower = mdi.fiberActivePower;
+    rms.fiberPassivePower = mdi.fiberPassivePower;
+    rms.tendonPower = mdi.tendonPower;
+    rms.musclePower = mdi.musclePower;
+    markCacheVariableValid(s, _realizedStateCV);
+    return rms;
+}
+
+Muscle::StateDerivativeJacobian
+Muscle::calcStateDerivativeJacobian(const SimTK::State& s) const
+{
+    StateDerivativeJacobian jac;
+    jac.stateVariableNames = getStateVariableNames();
+    const int n = jac.stateVariableNames.size();
+    for (int i = 0; i < n; ++i)
+        jac.stateVariableSystemIndices.push_back(
+            getStateVariableSystemIndex(jac.stateVariableNames[i]));
+    jac.controlIndex = _controlIndex;
+    jac.dYdotdY.resize(n, n);
+    jac.dYdotdY = 0;
+    jac.dYdotdU.resize(n, numControls());
+    jac.dYdotdU = 0;
+
+    if (n > 0 && appliesForce(s) && !isActuationOverridden(s))
+        computeStateDerivativeJacobian(s, jac.dYdotdY, jac.dYdotdU);
+    return jac;
+}
+
+void Muscle::computeStateDerivativeJacobian(const SimTK::State& s,
+                                            SimTK::Matrix& dYdotdY,
+                                            SimTK::Matrix& dYdotdU) const
+{
+    const Array<std::string> names = getStateVariableNames();
+    const int n = names.size();
+
+    SimTK::State sp = s;
+    SimTK::Vector ydotPlus(n), ydotMinus(n);
+    auto calcStateDerivatives = [&](SimTK::Vector& ydot) {
+        // The muscle's length info depends on its state variables, but is
+        // not invalidated when they change.
+        markCacheVariableInvalid(sp, _lengthInfoCV);
+        markCacheVariableInvalid(sp, _velInfoCV);
+        markCacheVariableInvalid(sp, _dynamicsInfoCV);
+        for (int i = 0; i < n; ++i)
+            ydot[i] = getStateVariableDerivativeValue(sp, names[i]);
+    };
+
+    for (int j = 0; j < n; ++j) {
+        const double y = getStateVariableValue(s, names[j]);
+        const double h = 1e-6*std::max(1.0, std::abs(y));
+        setStateVariableValue(sp, names[j], y + h);
+        calcStateDerivatives(ydotPlus);
+        setStateVariableValue(sp, names[j], y - h);
+        calcStateDerivatives(ydotMinus);
+        setStateVariableValue(sp, names[j], y);
+        dYdotdY.updCol(j) = (ydotPlus - ydotMinus)/(2*h);
+    }
+
+    SimTK::Vector controls = _model->getControls(s);
+    for (int k = 0; k < numControls(); ++k) {
+        const double u = controls[_controlIndex + k];
+        const double h = 1e-6*std::max(1.0, std::abs(u));
+        controls[_controlIndex + k] = u + h;
+        _model->setControls(sp, controls);
+        calcStateDerivatives(ydotPlus);
+        controls[_controlIndex + k] = u - h;
+        _model->setControls(sp, controls);
+        calcStateDerivatives(ydotMinus);
+        controls[_controlIndex + k] = u;
+        _model->setControls(sp, controls);
+        dYdotdU.updCol(k) = (ydotPlus - ydotMinus)/(2*h);
+    }
+}
+
 /* Access to muscle calculation data structures */
 const Muscle::MuscleLengthInfo& Muscle::getMuscleLengthInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"lengthInfo")){
+    if(!isCacheVariableValid(s, _lengthInfoCV)){
         MuscleLengthInfo &umli = updMuscleLengthInfo(s);
         calcMuscleLengthInfo(s, umli);
-        markCacheVariableValid(s,"lengthInfo");
+        markCacheVariableValid(s, _lengthInfoCV);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umli;
     }
-    return getCacheVariableValue<MuscleLengthInfo>(s, "lengthInfo");
+    return getCacheVariableValue(s, _lengthInfoCV);
 }
 
 Muscle::MuscleLengthInfo& Muscle::updMuscleLengthInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MuscleLengthInfo>(s, "lengthInfo");
+    // The info is about to change.
+    markCacheVariableInvalid(s, _realizedStateCV);
+    return updCacheVariableValue(s, _lengthInfoCV);
 }
 
 const Muscle::FiberVelocityInfo& Muscle::
 getFiberVelocityInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"velInfo")){
+    if(!isCacheVariableValid(s, _velInfoCV)){
         FiberVelocityInfo& ufvi = updFiberVelocityInfo(s);
         calcFiberVelocityInfo(s, ufvi);
-        markCacheVariableValid(s,"velInfo");
+        markCacheVariableValid(s, _velInfoCV);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return ufvi;
     }
-    return getCacheVariableValue<FiberVelocityInfo>(s, "velInfo");
+    return getCacheVariableValue(s, _velInfoCV);
 }
 
 Muscle::FiberVelocityInfo& Muscle::
 updFiberVelocityInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<FiberVelocityInfo>(s, "velInfo");
+    // The info is about to change.
+    markCacheVariableInvalid(s, _realizedStateCV);
+    return updCacheVariableValue(s, _velInfoCV);
 }
 
 const Muscle::MuscleDynamicsInfo& Muscle::
 getMuscleDynamicsInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"dynamicsInfo")){
+    if(!isCacheVariableValid(s, _dynamicsInfoCV)){
         MuscleDynamicsInfo& umdi = updMuscleDynamicsInfo(s);
         calcMuscleDynamicsInfo(s, umdi);
-        markCacheVariableValid(s,"dynamicsInfo");
+        markCacheVariableValid(s, _dynamicsInfoCV);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umdi;
     }
-    return getCacheVariableValue<MuscleDynamicsInfo>(s, "dynamicsInfo");
+    return getCacheVariableValue(s, _dynamicsInfoCV);
 }
 Muscle::MuscleDynamicsInfo& Muscle::
 updMuscleDynamicsInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MuscleDynamicsInfo>(s, "dynamicsInfo");
+    // The info is about to change.
+    markCacheVariableInvalid(s, _realizedStateCV);
+    return updCacheVariableValue(s, _dynamicsInfoCV);
 }
 
 const Muscle::MusclePotentialEnergyInfo& Muscle::
 getMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
-    if(!isCacheVariableValid(s,"potentialEnergyInfo")){
+    if(!isCacheVariableValid(s, _potentialEnergyInfoCV)){
         MusclePotentialEnergyInfo& umpei = updMusclePotentialEnergyInfo(s);
         calcMusclePotentialEnergyInfo(s, umpei);
-        markCacheVariableValid(s,"potentialEnergyInfo");
+        markCacheVariableValid(s, _potentialEnergyInfoCV);
         // don't bother fishing it out of the cache since 
         // we just calculated it and still have a handle on it
         return umpei;
     }
-    return getCacheVariableValue<MusclePotentialEnergyInfo>(s, "potentialEnergyInfo");
+    return getCacheVariableValue(s, _potentialEnergyInfoCV);
 }
 
 Muscle::MusclePotentialEnergyInfo& Muscle::
 updMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
-    return updCacheVariableValue<MusclePotentialEnergyInfo>(s, "potentialEnergyInfo");
+    return updCacheVariableValue(s, _potentialEnergyInfoCV);
 }
 
 
@@ -309,6 +309,94 @@ public:
     double getTendonPower(const SimTK::State& s) const;
     /** get the current muscle power (W) */
     double getMusclePower(const SimTK::State& s) const;
+
+    /** The length-, velocity- and dynamics-related quantities of the muscle
+    at a State, gathered in one place for clients that read many of them
+    (e.g., probes and analyses). Each member has the value returned by the
+    accessor of the same name (e.g., fiberLength is getFiberLength()). */
+    struct RealizedMuscleState {
+        double fiberLength{SimTK::NaN};
+        double normalizedFiberLength{SimTK::NaN};
+        double pennationAngle{SimTK::NaN};
+        double cosPennationAngle{SimTK::NaN};
+        double tendonLength{SimTK::NaN};
+        double tendonStrain{SimTK::NaN};
+        double activeForceLengthMultiplier{SimTK::NaN};
+        double passiveForceMultiplier{SimTK::NaN};
+
+        double fiberVelocity{SimTK::NaN};
+        double normalizedFiberVelocity{SimTK::NaN};
+        double fiberVelocityAlongTendon{SimTK::NaN};
+        double tendonVelocity{SimTK::NaN};
+        double forceVelocityMultiplier{SimTK::NaN};
+        double pennationAngularVelocity{SimTK::NaN};
+
+        double activation{SimTK::NaN};
+        double fiberForce{SimTK::NaN};
+        double fiberForceAlongTendon{SimTK::NaN};
+        double activeFiberForce{SimTK::NaN};
+        double passiveFiberForce{SimTK::NaN};
+        double activeFiberForceAlongTendon{SimTK::NaN};
+        double passiveFiberForceAlongTendon{SimTK::NaN};
+        double tendonForce{SimTK::NaN};
+        double fiberStiffness{SimTK::NaN};
+        double fiberStiffnessAlongTendon{SimTK::NaN};
+        double tendonStiffness{SimTK::NaN};
+        double muscleStiffness{SimTK::NaN};
+        double fiberActivePower{SimTK::NaN};
+        double fiberPassivePower{SimTK::NaN};
+        double tendonPower{SimTK::NaN};
+        double musclePower{SimTK::NaN};
+#ifndef SWIG
+        friend std::ostream& operator<<(std::ostream& o,
+            const RealizedMuscleState& rms) {
+            o << "Muscle::RealizedMuscleState should not be serialized!"
+              << std::endl;
+            return o;
+        }
+#endif
+    };
+
+    /** Get all of the quantities in RealizedMuscleState at once. They are
+    gathered from the muscle's length, velocity and dynamics calculations
+    (each of which is done at most once per State, as for the individual
+    accessors) the first time this is called for a State, and cached until
+    the State changes at or below Stage::Dynamics. */
+    const RealizedMuscleState&
+        getRealizedMuscleState(const SimTK::State& s) const;
+
+    /** The partial derivatives of the time derivatives of a muscle's state
+    variables (e.g., activation and fiber length) with respect to its own
+    state variables and controls, with the rest of the State held fixed. */
+    struct StateDerivativeJacobian {
+        /** The muscle's state variables, in the order of the rows of dYdotdY
+        and dYdotdU and of the columns of dYdotdY (that of
+        getStateVariableNames()). */
+        Array<std::string> stateVariableNames;
+        /** The index of each of these state variables in the System's Y
+        vector (SimTK::State::getY()). */
+        std::vector<int> stateVariableSystemIndices;
+        /** The index of the muscle's first control in Model::getControls().
+        The columns of dYdotdU correspond to the muscle's numControls()
+        controls. */
+        int controlIndex{-1};
+        /** dYdotdY(i, j) is the partial derivative of the time derivative of
+        state variable i with respect to state variable j. */
+        SimTK::Matrix dYdotdY;
+        /** dYdotdU(i, k) is the partial derivative of the time derivative of
+        state variable i with respect to control k of the muscle. */
+        SimTK::Matrix dYdotdU;
+    };
+
+    /** Calculate the partial derivatives of the time derivatives of this
+    muscle's state variables with respect to its own state variables and
+    controls (e.g., for the Newton iterations of an implicit integrator). The
+    partial derivatives are zero if the muscle does not apply force or its
+    actuation is overridden, as are the state derivatives. The State must be
+    realized to Stage::Velocity.
+    @see Model::calcMuscleStateDerivativeJacobian() */
+    StateDerivativeJacobian
+        calcStateDerivativeJacobian(const SimTK::State& s) const;
     
     /** get the stress in the muscle (part of the Actuator interface as well) */
     double getStress(const SimTK::State& s) const override;
@@ -339,6 +427,16 @@ public:
     void computeEquilibrium(SimTK::State& s) const override final {
         return computeInitialFiberEquilibrium(s);
     }
+
+    /** Find and set the equilibrium state of the muscle, as
+    computeEquilibrium() does. If warmStart is true, a muscle that solves for
+    its equilibrium iteratively starts from the fiber state already in s
+    (e.g., the equilibrium of a previous, nearby State) rather than from its
+    default initial guess. Returns the number of solver iterations taken, or
+    -1 if the muscle does not report it. */
+    int computeEquilibrium(SimTK::State& s, bool warmStart) const {
+        return solveInitialFiberEquilibrium(s, warmStart);
+    }
     // End of Muscle's State Dependent Accessors.
     //@} 
 
@@ -411,6 +509,27 @@ protected:
     computeFiberEquilibriumAtZeroVelocity(). */
     virtual void computeInitialFiberEquilibrium(SimTK::State& s) const = 0;
 
+    /** Called by computeEquilibrium(s, warmStart). Muscles that solve for
+    their equilibrium iteratively override this to start from the fiber state
+    in s when warmStart is true, and to return the number of iterations. The
+    default implementation ignores warmStart, calls
+    computeInitialFiberEquilibrium() and returns -1. */
+    virtual int solveInitialFiberEquilibrium(SimTK::State& s,
+                                             bool warmStart) const {
+        computeInitialFiberEquilibrium(s);
+        return -1;
+    }
+
+    /** Called by calcStateDerivativeJacobian() to fill in dYdotdY and
+    dYdotdU, which are sized and set to zero, in the order of
+    getStateVariableNames(). Muscles override this with analytic partial
+    derivatives. The default implementation uses central differences of the
+    muscle's state derivatives, perturbing one of its state variables or
+    controls at a time in a copy of the State. */
+    virtual void computeStateDerivativeJacobian(const SimTK::State& s,
+                                                SimTK::Matrix& dYdotdY,
+                                                SimTK::Matrix& dYdotdU) const;
+
     // End of Muscle's State Related Calculations.
     //@} 
 
@@ -439,6 +558,7 @@ protected:
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void extendSetPropertiesFromState(const SimTK::State &s) override;
     void extendInitStateFromProperties(SimTK::State& state) const override;
+    void extendParameterChanged(const AbstractProperty& property) override;
     
     // Update the display geometry attached to the muscle
     virtual void updateGeometry(const SimTK::State& s);
@@ -861,6 +981,19 @@ protected:
     double _pennationAngleAtOptimal;
     double _tendonSlackLength;
 
+    // Handles to the cache variables allocated in extendAddToSystem(), to be
+    // used by concrete muscles to access (e.g., invalidate) these cache
+    // variables without a name lookup.
+    mutable CacheVariable<MuscleLengthInfo> _lengthInfoCV;
+    mutable CacheVariable<FiberVelocityInfo> _velInfoCV;
+    mutable CacheVariable<MuscleDynamicsInfo> _dynamicsInfoCV;
+    mutable CacheVariable<MusclePotentialEnergyInfo> _potentialEnergyInfoCV;
+    // Gathered from the length, velocity and dynamics info. It is
+    // invalidated whenever the info is updated, and is only used while
+    // _dynamicsInfoCV is valid, since concrete muscles invalidate the info
+    // cache variables directly.
+    mutable CacheVariable<RealizedMuscleState> _realizedStateCV;
+
 //=============================================================================
 };  // END of class Muscle
 //=============================================================================
@@ -66,6 +66,7 @@ void MuscleActiveFiberPowerProbe::setNull(void)
 void MuscleActiveFiberPowerProbe::constructProperties(void)
 {
     constructProperty_muscle_names();
+    constructProperty_sum_powers_together(true);
 }
 
 //=============================================================================
@@ -89,6 +90,24 @@ void MuscleActiveFiberPowerProbe::setMuscleNames(const Array<string>& muscleName
     set_muscle_names(muscleNames);
 }
 
+//_____________________________________________________________________________
+/**
+ * Returns whether to report the sum of all muscle powers together.
+ */
+bool MuscleActiveFiberPowerProbe::getSumPowersTogether() const
+{
+    return get_sum_powers_together();
+}
+
+//_____________________________________________________________________________
+/**
+ * Sets whether to report the sum of all muscle powers together.
+ */
+void MuscleActiveFiberPowerProbe::setSumPowersTogether(bool sum_powers_together)
+{
+    set_sum_powers_together(sum_powers_together);
+}
+
 
 
 
@@ -107,6 +126,7 @@ void MuscleActiveFiberPowerProbe::extendConnectToModel(Model& model)
     Super::extendConnectToModel(model);
 
     // check that each Muscle in the actuator_names array exists in the model
+    _muscleIndex.clear();
     int nA = getMuscleNames().size();
     for (int i=0; i<nA; i++) {
         string actName = getMuscleNames()[i];
@@ -116,6 +136,8 @@ void MuscleActiveFiberPowerProbe::extendConnectToModel(Model& model)
             std::cout << "WARNING: " << errorMessage << "Probe will be disabled." << std::endl;
             setEnabled(false);
         }
+        else
+            _muscleIndex.push_back(k);
     }
 }
 
@@ -132,20 +154,21 @@ Compute the muscle fiber power upon which the Probe operation will be based on.
  */
 SimTK::Vector MuscleActiveFiberPowerProbe::computeProbeInputs(const State& s) const
 {
-    int nA = getMuscleNames().size();
-    SimTK::Vector TotalP(1, 0.0);       // Initialize at zero
+    const int nA = int(_muscleIndex.size());
+    SimTK::Vector TotalP(getNumProbeInputs(), 0.0);       // Initialize at zero
+    const Set<Muscle>& muscles = _model->getMuscles();
  
     // Loop through each muscle in the list of actuator_names
     for (int i=0; i<nA; i++)
     {
-        string actName = getMuscleNames()[i];
-        int k = _model->getMuscles().getIndex(actName);
-
         // Get the fiber power from the Actuator object
-        double fiberPower = _model->getMuscles().get(k).getFiberActivePower(s);
+        double fiberPower = muscles.get(_muscleIndex[i]).getFiberActivePower(s);
         
-        // Append to total "Actuator" power
-        TotalP(0) += fiberPower;
+        // Append to total "Actuator" power, or to the output vector
+        if (getSumPowersTogether())
+            TotalP(0) += fiberPower;
+        else
+            TotalP(i) = fiberPower;
     }
 
     return TotalP;
@@ -158,7 +181,10 @@ SimTK::Vector MuscleActiveFiberPowerProbe::computeProbeInputs(const State& s) co
  */
 int MuscleActiveFiberPowerProbe::getNumProbeInputs() const
 {
-    return 1;
+    if (getSumPowersTogether())
+        return 1;
+    else
+        return getMuscleNames().size();
 }
 
 
@@ -169,6 +195,11 @@ int MuscleActiveFiberPowerProbe::getNumProbeInputs() const
 Array<string> MuscleActiveFiberPowerProbe::getProbeOutputLabels() const 
 {
     Array<string> labels;
-    labels.append(getName());
+    if (getSumPowersTogether())
+        labels.append(getName());
+    else {
+        for (int i=0; i<getMuscleNames().size(); ++i)
+            labels.append(getName() + "_" + getMuscleNames()[i]);
+    }
     return labels;
 }
@@ -38,6 +38,11 @@ class Model;
 /**
 MuscleActiveFiberPowerProbe is a ModelComponent probe for computing an 
 operation on the active fiber power of a muscle.  
+
+To probe many muscles individually, list them all in one probe and set
+sum_powers_together to false, rather than adding one probe per muscle: the
+powers of all the muscles are then computed together, and reported in
+consecutive columns.
   
   @author Matt Millard
  */
@@ -52,7 +57,13 @@ public:
     OpenSim_DECLARE_LIST_PROPERTY(muscle_names, std::string,
         "Specify a list of muscles whose work should be calculated. "
         "If multiple muscles are given, the probe value will be the summation"
-        " of all actuator powers.");
+        " of all actuator powers, unless sum_powers_together is false.");
+
+    /** Flag to specify whether to report the sum of all powers,
+    or report each power value separately.  **/
+    OpenSim_DECLARE_PROPERTY(sum_powers_together, bool,
+        "Flag to specify whether to report the sum of all muscle active fiber "
+        "powers (the default), or report each muscle's power separately.");
 
 
 //==============================================================================
@@ -78,6 +89,13 @@ public:
     /** Sets the names of the Actuators being probed. */
     void setMuscleNames(const Array<std::string>& muscleNames);
 
+    /** Returns whether to report the sum of all muscle powers together
+    or report the muscle powers individually. */
+    bool getSumPowersTogether() const;
+    /** Sets whether to report the sum of all muscle powers together
+    or report the muscle powers individually. */
+    void setSumPowersTogether(bool sum_powers_together);
+
     //--------------------------------------------------------------------------
     // Computation
     //--------------------------------------------------------------------------
@@ -97,6 +115,9 @@ public:
 // PRIVATE
 //==============================================================================
 private:
+    // The index inside the model's muscles of each muscle being probed.
+    SimTK::Array_<int> _muscleIndex;
+
     //--------------------------------------------------------------------------
     // ModelComponent Interface
     //--------------------------------------------------------------------------
@@ -64,6 +64,7 @@ void PathActuator::constructProperties()
 {
     constructProperty_GeometryPath(GeometryPath());
     constructProperty_optimal_force(1.0);
+    updProperty_optimal_force().setIsParameterOnly(true);
 }
 
 
@@ -163,6 +164,18 @@ double PathActuator::computeActuation( const SimTK::State& s ) const
 //=============================================================================
 // APPLICATION
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * Add in the forces of a unit tension along the path.
+ */
+bool PathActuator::addInForcesPerUnitActuation(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) const
+{
+    getGeometryPath().addInEquivalentForces(s, 1.0, bodyForces, mobilityForces);
+    return true;
+}
+
 //_____________________________________________________________________________
 /**
  * Apply the actuator force along path wrapping over and connecting rigid bodies
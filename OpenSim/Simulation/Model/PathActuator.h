@@ -103,6 +103,15 @@ public:
                                SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                                SimTK::Vector& mobilityForces) const override;
 
+    /** Path actuators compute their paths and forces from the State and
+    their own cache entries, so they can be computed concurrently. */
+    bool shouldBeParallelized() const override { return true; }
+
+    /** A unit tension along the path. */
+    bool addInForcesPerUnitActuation(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+
     //--------------------------------------------------------------------------
     // COMPUTATIONS
     //--------------------------------------------------------------------------
@@ -26,7 +26,6 @@
 //=============================================================================
 #include "PathSpring.h"
 #include "GeometryPath.h"
-#include "PointForceDirection.h"
 
 //=============================================================================
 // STATICS
@@ -158,7 +157,10 @@ double PathSpring::getTension(const SimTK::State& s) const
     // note tension is positive and produces shortening
     // damping opposes lengthening, which is positive lengthening speed
     // there for stretch and lengthening speed increase tension
-    return getStiffness()*getStretch(s) *                   //elastic force
+    const double stretch = getStretch(s);
+    // a slack spring has no tension, whatever its lengthening speed
+    if (stretch == 0) return 0;
+    return getStiffness()*stretch *                         //elastic force
                 (1+getDissipation()*getLengtheningSpeed(s));   //dissipation 
 }
 
@@ -200,16 +202,8 @@ void PathSpring::computeForce(const SimTK::State& s,
                               SimTK::Vector& generalizedForces) const
 {
     const GeometryPath& path = getGeometryPath();
-    const double& tension = getTension(s);
+    const double tension = getTension(s);
+    if (tension == 0) return;
 
-    OpenSim::Array<PointForceDirection*> PFDs;
-    path.getPointForceDirections(s, &PFDs);
-
-    for (int i=0; i < PFDs.getSize(); i++) {
-        applyForceToPoint(s, PFDs[i]->frame(), PFDs[i]->point(), 
-                          tension*PFDs[i]->direction(), bodyForces);
-    }
-
-    for(int i=0; i < PFDs.getSize(); i++)
-        delete PFDs[i];
+    path.addInEquivalentForces(s, tension, bodyForces, generalizedForces);
 }
@@ -160,6 +160,8 @@ protected:
     void computeForce(const SimTK::State& s, 
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const override; 
+    /** Path springs can be computed concurrently with other forces. */
+    bool shouldBeParallelized() const override { return true; }
 
     /** Implement ModelComponent interface. */
     void extendFinalizeFromProperties() override;
@@ -184,6 +186,13 @@ protected:
         values.append(getTension(state));
         return values;
     }
+#ifndef SWIG
+    /** Copy the tension, without allocating an Array. */
+    void copyRecordValues(const SimTK::State& state,
+                          double* values) const override {
+        values[0] = getTension(state);
+    }
+#endif
 
 private:
     void constructProperties();
@@ -73,13 +73,13 @@ public:
     {}
 
     /** get point of "contact" with on a body defined in the body frame */
-    SimTK::Vec3 point() {return _point; }
+    SimTK::Vec3 point() const {return _point; }
     /** get the body in which the point is defined */
-    const PhysicalFrame& frame() {return _frame; }
+    const PhysicalFrame& frame() const {return _frame; }
     /** get direction of the force at the point defined in ground */
-    SimTK::Vec3 direction() {return _direction; }
+    SimTK::Vec3 direction() const {return _direction; }
     /** get the scale factor on the force */
-    double scale() {return _scale; }
+    double scale() const {return _scale; }
 
     /** replace the current direction with the resultant with a new direction */
     void addToDirection(SimTK::Vec3 newDirection) {_direction+=newDirection;}
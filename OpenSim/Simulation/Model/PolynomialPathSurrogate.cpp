@@ -0,0 +1,210 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  PolynomialPathSurrogate.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//==============================================================================
+// INCLUDES
+//==============================================================================
+#include "PolynomialPathSurrogate.h"
+
+using namespace OpenSim;
+using namespace std;
+
+namespace {
+    // Append the exponents of all monomials of n variables with total degree
+    // `degree`, by decreasing exponent of variable j, then j+1, etc.
+    void appendExponents(int n, int j, int degree, vector<int>& current,
+                         vector<int>& exponents)
+    {
+        if (j == n - 1) {
+            current[j] = degree;
+            exponents.insert(exponents.end(), current.begin(), current.end());
+            return;
+        }
+        for (int e = degree; e >= 0; --e) {
+            current[j] = e;
+            appendExponents(n, j + 1, degree - e, current, exponents);
+        }
+    }
+}
+
+//==============================================================================
+// CONSTRUCTOR
+//==============================================================================
+PolynomialPathSurrogate::PolynomialPathSurrogate()
+{
+    constructProperties();
+}
+
+PolynomialPathSurrogate::PolynomialPathSurrogate(
+        const vector<string>& coordinateNames,
+        const vector<SimTK::Vec2>& coordinateRanges,
+        int order) : PolynomialPathSurrogate()
+{
+    OPENSIM_THROW_IF(coordinateNames.size() != coordinateRanges.size(),
+        Exception, "Expected one range per coordinate.");
+    for (size_t j = 0; j < coordinateNames.size(); ++j) {
+        append_coordinates(coordinateNames[j]);
+        append_coordinate_ranges(coordinateRanges[j][0]);
+        append_coordinate_ranges(coordinateRanges[j][1]);
+    }
+    set_order(order);
+    prepareToEvaluate();
+    for (int t = 0; t < _numTerms; ++t)
+        append_coefficients(0.0);
+}
+
+void PolynomialPathSurrogate::constructProperties()
+{
+    constructProperty_coordinates();
+    constructProperty_coordinate_ranges();
+    constructProperty_order(3);
+    constructProperty_coefficients();
+    constructProperty_rms_length_error(SimTK::NaN);
+    constructProperty_max_length_error(SimTK::NaN);
+    constructProperty_max_moment_arm_error(SimTK::NaN);
+}
+
+void PolynomialPathSurrogate::prepareToEvaluate()
+{
+    const int n = getNumCoordinates();
+    OPENSIM_THROW_IF(n == 0, Exception,
+        "PolynomialPathSurrogate '" + getName() + "' has no coordinates.");
+    OPENSIM_THROW_IF(getProperty_coordinate_ranges().size() != 2*n, Exception,
+        "PolynomialPathSurrogate '" + getName() + "' expected a minimum and "
+        "maximum value per coordinate.");
+    for (int j = 0; j < n; ++j) {
+        OPENSIM_THROW_IF(
+            !(get_coordinate_ranges(2*j + 1) > get_coordinate_ranges(2*j)),
+            Exception,
+            "PolynomialPathSurrogate '" + getName() + "': the range of "
+            "coordinate '" + get_coordinates(j) + "' is empty.");
+    }
+    OPENSIM_THROW_IF(get_order() < 0, Exception,
+        "PolynomialPathSurrogate '" + getName() + "': order must be "
+        "nonnegative, but it is " + to_string(get_order()) + ".");
+
+    _exponents.clear();
+    vector<int> current(n);
+    for (int degree = 0; degree <= get_order(); ++degree)
+        appendExponents(n, 0, degree, current, _exponents);
+    _numTerms = int(_exponents.size())/n;
+
+    // A surrogate being set up has no coefficients yet.
+    const int numCoefficients = getProperty_coefficients().size();
+    OPENSIM_THROW_IF(numCoefficients != 0 && numCoefficients != _numTerms,
+        Exception,
+        "PolynomialPathSurrogate '" + getName() + "' expected " +
+        to_string(_numTerms) + " coefficients, but it has " +
+        to_string(numCoefficients) + ".");
+}
+
+//==============================================================================
+// EVALUATION
+//==============================================================================
+void PolynomialPathSurrogate::extendEstimateMemoryUsage(
+        MemoryUsage& usage) const
+{
+    Super::extendEstimateMemoryUsage(usage);
+    usage.add(MemoryUsage::Paths, _exponents.capacity() * sizeof(int));
+}
+
+void PolynomialPathSurrogate::calcPowers(const SimTK::Vector& q,
+                                         SimTK::Vector& powers) const
+{
+    const int n = getNumCoordinates();
+    const int stride = get_order() + 1;
+    if (powers.size() != n*stride)
+        powers.resize(n*stride);
+    for (int j = 0; j < n; ++j) {
+        const double min = get_coordinate_ranges(2*j);
+        const double max = get_coordinate_ranges(2*j + 1);
+        const double x = (2*q[j] - (max + min))/(max - min);
+        double p = 1;
+        for (int k = 0; k < stride; ++k) {
+            powers[j*stride + k] = p;
+            p *= x;
+        }
+    }
+}
+
+double PolynomialPathSurrogate::calcValueAndGradient(const SimTK::Vector& q,
+        SimTK::Vector& gradient, SimTK::Vector& workspace) const
+{
+    const int n = getNumCoordinates();
+    const int stride = get_order() + 1;
+    calcPowers(q, workspace);
+
+    double value = 0;
+    gradient = 0;
+    for (int t = 0; t < _numTerms; ++t) {
+        const int* e = &_exponents[t*n];
+        const double c = get_coefficients(t);
+        double term = c;
+        for (int j = 0; j < n; ++j)
+            term *= workspace[j*stride + e[j]];
+        value += term;
+
+        for (int k = 0; k < n; ++k) {
+            if (e[k] == 0) continue;
+            double partial = c*e[k]*workspace[k*stride + e[k] - 1];
+            for (int j = 0; j < n; ++j)
+                if (j != k) partial *= workspace[j*stride + e[j]];
+            gradient[k] += partial;
+        }
+    }
+
+    // Chain rule for the mapping of each coordinate onto [-1, 1].
+    for (int k = 0; k < n; ++k) {
+        gradient[k] *= 2.0/(get_coordinate_ranges(2*k + 1) -
+                            get_coordinate_ranges(2*k));
+    }
+    return value;
+}
+
+void PolynomialPathSurrogate::calcTerms(const SimTK::Vector& q,
+        SimTK::Vector& values, SimTK::Matrix& gradients) const
+{
+    const int n = getNumCoordinates();
+    const int stride = get_order() + 1;
+    SimTK::Vector powers;
+    calcPowers(q, powers);
+
+    values.resize(_numTerms);
+    gradients.resize(n, _numTerms);
+    gradients = 0;
+    for (int t = 0; t < _numTerms; ++t) {
+        const int* e = &_exponents[t*n];
+        double term = 1;
+        for (int j = 0; j < n; ++j)
+            term *= powers[j*stride + e[j]];
+        values[t] = term;
+
+        for (int k = 0; k < n; ++k) {
+            if (e[k] == 0) continue;
+            double partial = e[k]*powers[k*stride + e[k] - 1];
+            for (int j = 0; j < n; ++j)
+                if (j != k) partial *= powers[j*stride + e[j]];
+            gradients(k, t) = partial*2.0/(get_coordinate_ranges(2*k + 1) -
+                                            get_coordinate_ranges(2*k));
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef OPENSIM_POLYNOMIAL_PATH_SURROGATE_H_
+#define OPENSIM_POLYNOMIAL_PATH_SURROGATE_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  PolynomialPathSurrogate.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDE
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Common/Object.h>
+
+namespace OpenSim {
+
+//==============================================================================
+//                        POLYNOMIAL PATH SURROGATE
+//==============================================================================
+/**
+ * A multivariate polynomial of the coordinates spanned by a GeometryPath that
+ * approximates the length of the path. Each coordinate q_j is first mapped
+ * from its range [min_j, max_j] onto [-1, 1],
+ *
+ *     x_j = (2 q_j - (max_j + min_j)) / (max_j - min_j),
+ *
+ * and the length is the sum over all monomials of the x_j of total degree up
+ * to `order`, each times its coefficient. The monomials are ordered by total
+ * degree, and within a degree by decreasing exponent of the first coordinate,
+ * then of the second coordinate, and so on; e.g., for two coordinates and
+ * order 2: 1, x_0, x_1, x_0^2, x_0 x_1, x_1^2.
+ *
+ * A surrogate is usually obtained with GeometryPath::fitPolynomialSurrogate(),
+ * which also records the errors of the fit, and is used by the GeometryPath
+ * once it is set as its polynomial_surrogate property.
+ *
+ * Call prepareToEvaluate() after changing the properties and before
+ * evaluating the polynomial (GeometryPath does so when its properties are
+ * finalized).
+ */
+class OSIMSIMULATION_API PolynomialPathSurrogate : public Object {
+OpenSim_DECLARE_CONCRETE_OBJECT(PolynomialPathSurrogate, Object);
+public:
+//==============================================================================
+// PROPERTIES
+//==============================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(coordinates, std::string,
+        "Names of the coordinates (the variables of the polynomial).");
+    OpenSim_DECLARE_LIST_PROPERTY(coordinate_ranges, double,
+        "The minimum and maximum value of each coordinate over which the "
+        "polynomial was fit, in the order of the coordinates.");
+    OpenSim_DECLARE_PROPERTY(order, int,
+        "The maximum total degree of the monomials.");
+    OpenSim_DECLARE_LIST_PROPERTY(coefficients, double,
+        "The coefficient of each monomial, in graded order.");
+    OpenSim_DECLARE_PROPERTY(rms_length_error, double,
+        "Root-mean-square error in the length at the validation samples of "
+        "the fit.");
+    OpenSim_DECLARE_PROPERTY(max_length_error, double,
+        "Maximum absolute error in the length at the validation samples of "
+        "the fit.");
+    OpenSim_DECLARE_PROPERTY(max_moment_arm_error, double,
+        "Maximum absolute error in the moment arms at the validation samples "
+        "of the fit.");
+
+//==============================================================================
+// PUBLIC METHODS
+//==============================================================================
+    PolynomialPathSurrogate();
+
+    /** Set the coordinates and their ranges, and the order of the polynomial;
+    all of the coefficients are set to zero. */
+    PolynomialPathSurrogate(const std::vector<std::string>& coordinateNames,
+                            const std::vector<SimTK::Vec2>& coordinateRanges,
+                            int order);
+
+    int getNumCoordinates() const { return getProperty_coordinates().size(); }
+    /** The number of monomials (and of coefficients) of the polynomial. */
+    int getNumTerms() const { return _numTerms; }
+
+    /** Check the properties and compute the exponents of the monomials. */
+    void prepareToEvaluate();
+
+    /** The value of the polynomial, and its gradient with respect to the
+    coordinates (`gradient` must have the size getNumCoordinates()).
+    `workspace` is resized as needed; reusing it avoids allocations. */
+    double calcValueAndGradient(const SimTK::Vector& q,
+                                SimTK::Vector& gradient,
+                                SimTK::Vector& workspace) const;
+
+    /** The value (in `values`, of size getNumTerms()) of each monomial and its
+    gradient with respect to the coordinates (row j of `gradients`, of size
+    getNumCoordinates() x getNumTerms(), holds the partial derivatives with
+    respect to coordinate j), as used for fitting the coefficients. */
+    void calcTerms(const SimTK::Vector& q, SimTK::Vector& values,
+                   SimTK::Matrix& gradients) const;
+
+protected:
+    // Add the exponents of the monomials.
+    void extendEstimateMemoryUsage(MemoryUsage& usage) const override;
+
+//==============================================================================
+// PRIVATE
+//==============================================================================
+private:
+    void constructProperties();
+
+    // Compute the normalized coordinates and their powers up to the order;
+    // powers(j*(order+1) + k) = x_j^k.
+    void calcPowers(const SimTK::Vector& q, SimTK::Vector& powers) const;
+
+    int _numTerms{0};
+    // The exponent of coordinate j in monomial t is
+    // _exponents[t*numCoordinates + j].
+    std::vector<int> _exponents;
+//==============================================================================
+};  // END of class PolynomialPathSurrogate
+
+} // namespace OpenSim
+
+#endif // OPENSIM_POLYNOMIAL_PATH_SURROGATE_H_
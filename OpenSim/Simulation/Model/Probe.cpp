@@ -28,23 +28,22 @@ using namespace std;
 using namespace SimTK;
 
 
-//This Measure returns a probe value only at the Acceleration stage
-template <class T>
-class ProbeMeasure : public SimTK::Measure_<T> {
+//This Measure returns the probe inputs only at the Acceleration stage. All
+//of a probe's inputs are computed at once, and cached.
+class ProbeMeasure : public SimTK::Measure_<Vector> {
 public:
-    SimTK_MEASURE_HANDLE_PREAMBLE(ProbeMeasure, Measure_<T>);
+    SimTK_MEASURE_HANDLE_PREAMBLE(ProbeMeasure, Measure_<Vector>);
  
-    ProbeMeasure(Subsystem& sub, const OpenSim::Probe& probe, int index)
-    :   SimTK::Measure_<T>(sub, new Implementation(probe, index), AbstractMeasure::SetHandle()) {}
-    SimTK_MEASURE_HANDLE_POSTSCRIPT(ProbeMeasure, Measure_<T>);
+    ProbeMeasure(Subsystem& sub, const OpenSim::Probe& probe)
+    :   SimTK::Measure_<Vector>(sub, new Implementation(probe), AbstractMeasure::SetHandle()) {}
+    SimTK_MEASURE_HANDLE_POSTSCRIPT(ProbeMeasure, Measure_<Vector>);
 };
  
  
-template <class T>
-class ProbeMeasure<T>::Implementation : public SimTK::Measure_<T>::Implementation {
+class ProbeMeasure::Implementation : public SimTK::Measure_<Vector>::Implementation {
 public:
-    Implementation(const OpenSim::Probe& probe, int index)
-    :   SimTK::Measure_<T>::Implementation(1), m_probe(probe), i(index) {}
+    Implementation(const OpenSim::Probe& probe)
+    :   SimTK::Measure_<Vector>::Implementation(1), m_probe(probe) {}
  
     // Default copy constructor, destructor, copy assignment are fine.
  
@@ -61,7 +60,7 @@ public:
         return Stage::Acceleration; 
     }
  
-    void calcCachedValueVirtual(const State& s, int derivOrder, T& value) const
+    void calcCachedValueVirtual(const State& s, int derivOrder, Vector& value) const
         override
     {
         SimTK_ASSERT1_ALWAYS(derivOrder==0,
@@ -74,19 +73,52 @@ public:
     
 private:
     const OpenSim::Probe& m_probe;
-    int i;
 };
 
 
-template <>
-void ProbeMeasure<double>::Implementation::calcCachedValueVirtual(const State& s, int derivOrder, double& value) const
-{
-    SimTK_ASSERT1_ALWAYS(derivOrder==0,
-        "ProbeMeasure::Implementation::calcCachedValueVirtual():"
-        " derivOrder %d seen but only 0 allowed.", derivOrder);
- 
-    value = m_probe.computeProbeInputs(s)(i);
-}
+//This Measure returns one element of the probe inputs computed by a
+//ProbeMeasure, so that the inputs are not recomputed for each element.
+class ProbeInputMeasure : public SimTK::Measure_<double> {
+public:
+    SimTK_MEASURE_HANDLE_PREAMBLE(ProbeInputMeasure, Measure_<double>);
+
+    ProbeInputMeasure(Subsystem& sub, const ProbeMeasure& inputs, int index)
+    :   SimTK::Measure_<double>(sub, new Implementation(inputs, index), AbstractMeasure::SetHandle()) {}
+    SimTK_MEASURE_HANDLE_POSTSCRIPT(ProbeInputMeasure, Measure_<double>);
+};
+
+
+class ProbeInputMeasure::Implementation : public SimTK::Measure_<double>::Implementation {
+public:
+    Implementation(const ProbeMeasure& inputs, int index)
+    :   SimTK::Measure_<double>::Implementation(1), m_inputs(inputs), i(index) {}
+
+    Implementation* cloneVirtual() const override {
+        return new Implementation(*this);
+    }
+
+    int getNumTimeDerivativesVirtual() const override {
+        return 0;
+    }
+
+    Stage getDependsOnStageVirtual(int order) const override {
+        return Stage::Acceleration;
+    }
+
+    void calcCachedValueVirtual(const State& s, int derivOrder, double& value) const
+        override
+    {
+        SimTK_ASSERT1_ALWAYS(derivOrder==0,
+            "ProbeInputMeasure::Implementation::calcCachedValueVirtual():"
+            " derivOrder %d seen but only 0 allowed.", derivOrder);
+
+        value = m_inputs.getValue(s)(i);
+    }
+
+private:
+    ProbeMeasure m_inputs;
+    int i;
+};
 
 
 namespace OpenSim {
@@ -154,18 +186,19 @@ void Probe::extendAddToSystem(MultibodySystem& system) const
 
     // ---------------------------------------------------------------------
     // Create a <double> Measure of the value to be probed (operand).
-    // For now, this is scalarized, i.e. a separate Measure is created
-    // for each probe input element in the Vector.
+    // The operations are scalarized, i.e. a separate Measure is created
+    // for each probe input element in the Vector, but all the elements are
+    // taken from one Measure of the whole Vector, so that the probe inputs
+    // are computed once per evaluation rather than once per element.
     // ---------------------------------------------------------------------
-    // save for when we can directly operate on Vector SimTK::Measures
-    //ProbeMeasure<SimTK::Vector> beforeOperationValueVector(system, *this);
+    ProbeMeasure beforeOperationValueVector(system, *this);
 
     int npi = getNumProbeInputs();
-    SimTK::Array_<ProbeMeasure<double> > beforeOperationValues;
+    SimTK::Array_<ProbeInputMeasure> beforeOperationValues;
     mutableThis->afterOperationValues.resize(npi);
 
     for (int i=0; i<npi; ++i) {
-        ProbeMeasure<double> tmpPM(system, *this, i); 
+        ProbeInputMeasure tmpPM(system, beforeOperationValueVector, i);
         beforeOperationValues.push_back(tmpPM);
     }
 
@@ -413,6 +446,18 @@ void Probe::setGain(double gain)
  * Provide the probe values to be reported that correspond to the probe labels.
  */
 SimTK::Vector Probe::getProbeOutputs(const State& s) const 
+{
+    SimTK::Vector output(getNumProbeInputs());
+    calcProbeOutputs(s, output.updContiguousScalarData());
+    return output;
+}
+
+//_____________________________________________________________________________
+/**
+ * Writes the values of the probe after the operation has been performed to
+ * the given array.
+ */
+void Probe::calcProbeOutputs(const State& s, double* outputs) const
 {
     if (!isEnabled()) {
         stringstream errorMessage;
@@ -422,21 +467,19 @@ SimTK::Vector Probe::getProbeOutputs(const State& s) const
         throw (Exception(errorMessage.str()));
     }
 
-
-    // For now, this is scalarized, i.e. compile the result of the separate
-    // Measure for each scalar element of the probe input into a SimTK::Vector
-    // of outputs.
-    SimTK::Vector output(getNumProbeInputs());
-    for (int i=0; i<getNumProbeInputs(); ++i) {
-        if (getOperation() == "integrate")
-            output[i] = getGain() * (afterOperationValues[i].getValue(s) + getInitialConditions()(i));
-        else
-            output[i] = getGain() * afterOperationValues[i].getValue(s);
+    // This is scalarized, i.e. compile the result of the separate Measure
+    // for each scalar element of the probe input into the outputs.
+    const int npi = getNumProbeInputs();
+    const double gain = getGain();
+    if (getOperation() == "integrate") {
+        for (int i=0; i<npi; ++i)
+            outputs[i] = gain * (afterOperationValues[i].getValue(s) +
+                                 get_initial_conditions_for_integration(i));
+    }
+    else {
+        for (int i=0; i<npi; ++i)
+            outputs[i] = gain * afterOperationValues[i].getValue(s);
     }
-    
-    return output;
-
-    //return afterOperationValueVector.getValue(s);         // save for when we can directly operate on Vector SimTK::Measures
 }
 
 
@@ -216,6 +216,16 @@ public:
     @return         The SimTK::Vector of probe output values.**/
     SimTK::Vector getProbeOutputs(const SimTK::State& state) const;
 
+    /** Like getProbeOutputs(), but write the getNumProbeInputs() values to
+    the given array rather than allocating a Vector, e.g., to fill a row of
+    the values of many probes (see ProbeSet::calcProbeOutputs()). The probe
+    inputs are computed once per realization of the state, however many
+    values the probe has.
+
+    @param  state   System state from which value is computed.
+    @param  outputs Array of (at least) getNumProbeInputs() values. **/
+    void calcProbeOutputs(const SimTK::State& state, double* outputs) const;
+
     void updateFromXMLNode(SimTK::Xml::Element& node,
                            int versionNumber) override;
 
@@ -46,6 +46,30 @@ ProbeSet::ProbeSet(const ProbeSet& aAbsProbeSet):
     *this = aAbsProbeSet;
 }
 
+//_____________________________________________________________________________
+/**
+ * Get the total number of values of the enabled probes.
+ */
+int ProbeSet::getNumProbeOutputs() const
+{
+    int n = 0;
+    for (int i=0; i<getSize(); ++i) {
+        const Probe& probe = get(i);
+        if (probe.isEnabled()) n += probe.getNumProbeInputs();
+    }
+    return n;
+}
 
-
-
+//_____________________________________________________________________________
+/**
+ * Write the values of the enabled probes to one contiguous row.
+ */
+void ProbeSet::calcProbeOutputs(const SimTK::State& s, double* outputs) const
+{
+    for (int i=0; i<getSize(); ++i) {
+        const Probe& probe = get(i);
+        if (!probe.isEnabled()) continue;
+        probe.calcProbeOutputs(s, outputs);
+        outputs += probe.getNumProbeInputs();
+    }
+}
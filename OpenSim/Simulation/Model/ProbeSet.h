@@ -52,6 +52,19 @@ public:
     ProbeSet();
     ProbeSet(const ProbeSet& aAbsProbeSet);
 
+#ifndef SWIG
+    /** The total number of values of the enabled probes. */
+    int getNumProbeOutputs() const;
+
+    /** Write the values of all the enabled probes, in order, to one
+    contiguous row (see Probe::calcProbeOutputs()), e.g., to record them
+    without allocating a Vector per probe. The state must be realized to
+    Stage::Report.
+    @param  state   System state from which the values are computed.
+    @param  outputs Array of (at least) getNumProbeOutputs() values. **/
+    void calcProbeOutputs(const SimTK::State& state, double* outputs) const;
+#endif
+
 
 //=============================================================================
 };  // END of class ProbeSet
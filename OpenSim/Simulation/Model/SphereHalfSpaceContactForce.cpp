@@ -0,0 +1,298 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  SphereHalfSpaceContactForce.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SphereHalfSpaceContactForce.h"
+#include "ContactHalfSpace.h"
+#include "ContactSphere.h"
+#include "Model.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OpenSim {
+
+namespace {
+// The friction coefficient of a contact, from those of its two surfaces, as
+// SimTK::HuntCrossleyForce combines them.
+double combineFriction(double u1, double u2)
+{
+    return (u1 + u2 == 0) ? 0 : 2*u1*u2/(u1 + u2);
+}
+}
+
+//==============================================================================
+//                     SPHERE HALF SPACE CONTACT FORCE
+//==============================================================================
+// Uses default (compiler-generated) destructor, copy constructor, copy
+// assignment operator.
+
+SphereHalfSpaceContactForce::SphereHalfSpaceContactForce()
+{
+    constructProperties();
+}
+
+SphereHalfSpaceContactForce::
+SphereHalfSpaceContactForce(const std::string& halfSpaceName)
+{
+    constructProperties();
+    set_contact_half_space(halfSpaceName);
+}
+
+void SphereHalfSpaceContactForce::constructProperties()
+{
+    constructProperty_contact_half_space("");
+    constructProperty_contact_parameters(
+            HuntCrossleyForce::ContactParametersSet());
+    constructProperty_transition_velocity(0.01);
+}
+
+void SphereHalfSpaceContactForce::
+addContactParameters(HuntCrossleyForce::ContactParameters* params)
+{
+    upd_contact_parameters().adoptAndAppend(params);
+}
+
+void SphereHalfSpaceContactForce::addGeometry(const std::string& name,
+        double stiffness, double dissipation, double staticFriction,
+        double dynamicFriction, double viscousFriction)
+{
+    auto* params = new HuntCrossleyForce::ContactParameters(stiffness,
+            dissipation, staticFriction, dynamicFriction, viscousFriction);
+    params->addGeometry(name);
+    addContactParameters(params);
+}
+
+void SphereHalfSpaceContactForce::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+
+    const std::string& halfSpaceName = get_contact_half_space();
+    const ContactGeometry& halfSpace =
+        model.getComponent<ContactGeometry>(halfSpaceName);
+    OPENSIM_THROW_IF_FRMOBJ(!dynamic_cast<const ContactHalfSpace*>(&halfSpace),
+            Exception, "'" + halfSpaceName + "' is not a ContactHalfSpace.");
+    _halfSpace.reset(&halfSpace);
+
+    const HuntCrossleyForce::ContactParametersSet& paramsSet =
+        get_contact_parameters();
+    const HuntCrossleyForce::ContactParameters* halfSpaceParams = nullptr;
+    for (int i = 0; i < paramsSet.getSize(); ++i) {
+        const auto& params = paramsSet.get(i);
+        for (int j = 0; j < params.getGeometry().size(); ++j) {
+            if (params.getGeometry()[j] != halfSpaceName) continue;
+            OPENSIM_THROW_IF_FRMOBJ(halfSpaceParams, Exception,
+                    "'" + halfSpaceName + "' has more than one set of "
+                    "contact parameters.");
+            halfSpaceParams = &params;
+        }
+    }
+
+    // The parameters of each contact, as SimTK::HuntCrossleyForce combines
+    // those of the sphere and of the half space.
+    _spheres.clear();
+    for (int i = 0; i < paramsSet.getSize(); ++i) {
+        const auto& params = paramsSet.get(i);
+        for (int j = 0; j < params.getGeometry().size(); ++j) {
+            const std::string& name = params.getGeometry()[j];
+            if (name == halfSpaceName) continue;
+            const auto* geometry = dynamic_cast<const ContactSphere*>(
+                    &model.getComponent<ContactGeometry>(name));
+            OPENSIM_THROW_IF_FRMOBJ(!geometry, Exception,
+                    "'" + name + "' is not a ContactSphere.");
+
+            Sphere sphere;
+            sphere.geometry.reset(geometry);
+            sphere.radius = geometry->getRadius();
+            const double k1 = std::pow(params.getStiffness(), 2.0/3.0);
+            if (halfSpaceParams) {
+                const double k2 =
+                    std::pow(halfSpaceParams->getStiffness(), 2.0/3.0);
+                const double s1 = (k1 + k2 > 0) ? k2/(k1 + k2) : 0;
+                sphere.stiffness = k1*s1;
+                sphere.dissipation = params.getDissipation()*s1
+                        + halfSpaceParams->getDissipation()*(1 - s1);
+                sphere.staticFriction = combineFriction(
+                        params.getStaticFriction(),
+                        halfSpaceParams->getStaticFriction());
+                sphere.dynamicFriction = combineFriction(
+                        params.getDynamicFriction(),
+                        halfSpaceParams->getDynamicFriction());
+                sphere.viscousFriction = combineFriction(
+                        params.getViscousFriction(),
+                        halfSpaceParams->getViscousFriction());
+            } else {
+                sphere.stiffness = k1;
+                sphere.dissipation = params.getDissipation();
+                sphere.staticFriction = params.getStaticFriction();
+                sphere.dynamicFriction = params.getDynamicFriction();
+                sphere.viscousFriction = params.getViscousFriction();
+            }
+            _spheres.push_back(sphere);
+        }
+    }
+}
+
+void SphereHalfSpaceContactForce::
+extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    // Beyond the const Component, locate the geometry on the mobilized
+    // bodies, which exist now.
+    SphereHalfSpaceContactForce* mutableThis =
+        const_cast<SphereHalfSpaceContactForce *>(this);
+    const PhysicalFrame& frame = _halfSpace->getFrame();
+    mutableThis->_halfSpaceBody = frame.getMobilizedBodyIndex();
+    mutableThis->_halfSpaceTransform =
+        frame.findTransformInBaseFrame()*_halfSpace->getTransform();
+    for (Sphere& sphere : mutableThis->_spheres) {
+        const PhysicalFrame& sphereFrame = sphere.geometry->getFrame();
+        sphere.body = sphereFrame.getMobilizedBodyIndex();
+        sphere.center = sphereFrame.findTransformInBaseFrame()
+                        *sphere.geometry->getLocation();
+    }
+}
+
+//=============================================================================
+// Computing
+//=============================================================================
+template <typename Visitor>
+double SphereHalfSpaceContactForce::
+forEachContact(const SimTK::State& s, Visitor visit) const
+{
+    using namespace SimTK;
+
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const MobilizedBody& planeBody = matter.getMobilizedBody(_halfSpaceBody);
+    const Transform X_GH = planeBody.getBodyTransform(s)*_halfSpaceTransform;
+    const Vec3& p_GP = planeBody.getBodyOriginLocation(s);
+    const SpatialVec& V_GP = planeBody.getBodyVelocity(s);
+    // Points with x > 0 in the frame of the half space are inside it.
+    const UnitVec3 normal(-X_GH.x());
+    const double transitionVelocity = get_transition_velocity();
+
+    double energy = 0;
+    for (int i = 0; i < int(_spheres.size()); ++i) {
+        const Sphere& sphere = _spheres[i];
+        const MobilizedBody& body = matter.getMobilizedBody(sphere.body);
+        const Transform& X_GB = body.getBodyTransform(s);
+        const Vec3 center = X_GB*sphere.center;
+        const double depth = sphere.radius - dot(center - X_GH.p(), normal);
+        if (depth <= 0) continue;
+
+        // Hertz force; the radius of curvature of the contact is that of
+        // the sphere.
+        const double k = sphere.stiffness;
+        const double fH = (4.0/3.0)*k*depth*std::sqrt(sphere.radius*k*depth);
+        energy += 0.4*fH*depth;
+
+        // The contact point is halfway through the overlap.
+        const Vec3 point = center - (sphere.radius - 0.5*depth)*normal;
+        const SpatialVec& V_GB = body.getBodyVelocity(s);
+        const Vec3 v = (V_GB[1] + V_GB[0] % (point - X_GB.p()))
+                       - (V_GP[1] + V_GP[0] % (point - p_GP));
+        const double vNormal = dot(v, normal); // negative while approaching
+        const double f = fH*(1 - 1.5*sphere.dissipation*vNormal);
+        if (f <= 0) continue;
+        Vec3 force = f*normal;
+
+        const Vec3 vSlip = v - vNormal*normal;
+        const double vSlipMag = vSlip.norm();
+        if (vSlipMag != 0) {
+            const double vRel = vSlipMag/transitionVelocity;
+            const double fFriction = f*(std::min(vRel, 1.0)
+                    *(sphere.dynamicFriction + 2*(sphere.staticFriction
+                      - sphere.dynamicFriction)/(1 + vRel*vRel))
+                    + sphere.viscousFriction*vSlipMag);
+            force -= (fFriction/vSlipMag)*vSlip;
+        }
+        visit(i, point, force);
+    }
+    return energy;
+}
+
+void SphereHalfSpaceContactForce::computeForce(const SimTK::State& s,
+                              SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+                              SimTK::Vector& generalizedForces) const
+{
+    using namespace SimTK;
+
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    const Vec3& p_GP =
+        matter.getMobilizedBody(_halfSpaceBody).getBodyOriginLocation(s);
+    forEachContact(s,
+        [&](int i, const Vec3& point, const Vec3& force) {
+            const MobilizedBodyIndex body = _spheres[i].body;
+            const Vec3& p_GB =
+                matter.getMobilizedBody(body).getBodyOriginLocation(s);
+            bodyForces[body] += SpatialVec((point - p_GB) % force, force);
+            bodyForces[_halfSpaceBody] -=
+                SpatialVec((point - p_GP) % force, force);
+        });
+}
+
+double SphereHalfSpaceContactForce::
+computePotentialEnergy(const SimTK::State& s) const
+{
+    return forEachContact(s,
+        [](int, const SimTK::Vec3&, const SimTK::Vec3&) {});
+}
+
+SimTK::Vector_<SimTK::Vec3> SphereHalfSpaceContactForce::
+calcContactForces(const SimTK::State& s) const
+{
+    SimTK::Vector_<SimTK::Vec3> forces(getNumSpheres(), SimTK::Vec3(0));
+    forEachContact(s,
+        [&](int i, const SimTK::Vec3&, const SimTK::Vec3& force) {
+            forces[i] = force;
+        });
+    return forces;
+}
+
+//=============================================================================
+// Reporting
+//=============================================================================
+OpenSim::Array<std::string> SphereHalfSpaceContactForce::
+getRecordLabels() const
+{
+    OpenSim::Array<std::string> labels("");
+    for (const Sphere& sphere : _spheres) {
+        const std::string prefix =
+            getName() + "." + sphere.geometry->getName() + ".force.";
+        labels.append(prefix + "X");
+        labels.append(prefix + "Y");
+        labels.append(prefix + "Z");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> SphereHalfSpaceContactForce::
+getRecordValues(const SimTK::State& state) const
+{
+    OpenSim::Array<double> values(1);
+    const SimTK::Vector_<SimTK::Vec3> forces = calcContactForces(state);
+    for (int i = 0; i < forces.size(); ++i)
+        values.append(3, &forces[i][0]);
+    return values;
+}
+
+} // end of namespace OpenSim
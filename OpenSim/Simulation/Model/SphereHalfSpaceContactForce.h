@@ -0,0 +1,144 @@
+#ifndef OPENSIM_SPHERE_HALF_SPACE_CONTACT_FORCE_H_
+#define OPENSIM_SPHERE_HALF_SPACE_CONTACT_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  SphereHalfSpaceContactForce.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+// INCLUDE
+#include "HuntCrossleyForce.h"
+
+namespace OpenSim {
+
+//==============================================================================
+//                     SPHERE HALF SPACE CONTACT FORCE
+//==============================================================================
+/** A Hunt-Crossley contact model between many ContactSpheres and a single
+ContactHalfSpace (e.g., the contact spheres of a foot and the floor). It
+computes the same forces as a HuntCrossleyForce with the same parameters, but
+evaluates all the spheres in one loop over precomputed per-sphere parameters,
+without Simbody's general contact tracking, which tests every pair of
+geometries and dispatches each contact separately.
+
+The contact_parameters list the spheres (and, optionally, the half space)
+with their material properties, as for a HuntCrossleyForce, so that the
+contact_parameters of a HuntCrossleyForce between spheres and a half space
+can be used unchanged. If the half space is listed, the parameters of each
+sphere are combined with those of the half space as HuntCrossleyForce does;
+otherwise, each sphere's parameters are those of its contact.
+
+Spheres do not contact each other. */
+class OSIMSIMULATION_API SphereHalfSpaceContactForce : public Force {
+OpenSim_DECLARE_CONCRETE_OBJECT(SphereHalfSpaceContactForce, Force);
+public:
+//==============================================================================
+// PROPERTIES
+//==============================================================================
+    OpenSim_DECLARE_PROPERTY(contact_half_space, std::string,
+        "Name of the ContactHalfSpace that the spheres contact.");
+    OpenSim_DECLARE_PROPERTY(contact_parameters,
+        HuntCrossleyForce::ContactParametersSet,
+        "Material properties of the ContactSpheres (and, optionally, of the "
+        "ContactHalfSpace).");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+        "Slip velocity (creep) at which peak static friction occurs.");
+
+//==============================================================================
+// PUBLIC METHODS
+//==============================================================================
+    SphereHalfSpaceContactForce();
+    /** Add the spheres with addGeometry() or addContactParameters(). */
+    explicit SphereHalfSpaceContactForce(const std::string& halfSpaceName);
+
+#ifndef SWIG
+    /** Takes over ownership of the passed-in object. **/
+    void addContactParameters(HuntCrossleyForce::ContactParameters* params);
+#endif
+    /** Add a sphere (or, if name is that of the half space, the half space)
+    with its own material properties. */
+    void addGeometry(const std::string& name, double stiffness,
+                     double dissipation, double staticFriction,
+                     double dynamicFriction, double viscousFriction);
+
+    /** Number of spheres; available after the force is connected to a
+    Model. */
+    int getNumSpheres() const { return int(_spheres.size()); }
+
+    /** The contact force on each sphere, expressed in Ground, in the order
+    the spheres are listed in the contact_parameters (zero for spheres that
+    are not in contact). The State must be realized to Stage::Velocity. */
+    SimTK::Vector_<SimTK::Vec3> calcContactForces(const SimTK::State& s) const;
+
+    /** The force depends only on the State, and writes only to the force
+    arrays it is given, so it can be computed concurrently with other
+    forces. */
+    bool shouldBeParallelized() const override { return true; }
+
+    //-----------------------------------------------------------------------------
+    // Reporting
+    //-----------------------------------------------------------------------------
+    /** The contact force on each sphere (see calcContactForces()). */
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double>
+    getRecordValues(const SimTK::State& state) const override;
+
+protected:
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& s,
+                      SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+                      SimTK::Vector& generalizedForces) const override;
+    /** The elastic (Hertz) energy of the contacts. */
+    double computePotentialEnergy(const SimTK::State& s) const override;
+
+private:
+    // The geometry and combined material properties of one sphere.
+    struct Sphere {
+        SimTK::ReferencePtr<const ContactGeometry> geometry;
+        SimTK::MobilizedBodyIndex body;
+        SimTK::Vec3 center;  // in body
+        double radius;
+        double stiffness;   // combined stiffness, to the power 2/3
+        double dissipation;
+        double staticFriction;
+        double dynamicFriction;
+        double viscousFriction;
+    };
+
+    void constructProperties();
+
+    // Call visit(i, point, force) for each sphere i in contact, with the
+    // force on the sphere and the point where it is applied, both in Ground;
+    // returns the elastic energy of the contacts.
+    template <typename Visitor>
+    double forEachContact(const SimTK::State& s, Visitor visit) const;
+
+    SimTK::ReferencePtr<const ContactGeometry> _halfSpace;
+    SimTK::MobilizedBodyIndex _halfSpaceBody;
+    SimTK::Transform _halfSpaceTransform;  // in _halfSpaceBody
+    std::vector<Sphere> _spheres;
+
+//==============================================================================
+};  // END of class SphereHalfSpaceContactForce
+//==============================================================================
+//==============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_SPHERE_HALF_SPACE_CONTACT_FORCE_H_
@@ -130,6 +130,27 @@ void Umberger2010MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    updateMuscleParameterArrays();
+}
+
+//_____________________________________________________________________________
+/**
+ * Gather the muscle pointers and the parameters of the metabolic muscles
+ * into contiguous arrays for computeProbeInputs().
+ */
+void Umberger2010MuscleMetabolicsProbe::updateMuscleParameterArrays()
+{
+    const Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet& mms =
+        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet();
+    const int nM = mms.getSize();
+    _muscles.resize(nM);
+    _muscleMass.resize(nM);
+    _ratioSlowTwitchFibers.resize(nM);
+    for (int i=0; i<nM; ++i) {
+        _muscles[i] = mms[i].getMuscle();
+        _muscleMass[i] = mms[i].getMuscleMass();
+        _ratioSlowTwitchFibers[i] = mms[i].get_ratio_slow_twitch_fibers();
+    }
 }
 
 //_____________________________________________________________________________
@@ -256,29 +277,37 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
     
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
-    const int nM = 
-        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
-        .getSize();
+    // The properties of the probe, which are the same for all muscles.
+    const double effortScaling = get_muscle_effort_scaling_factor();
+    const double aerobicFactor = get_aerobic_factor();
+    const bool forbidNegativePower = get_forbid_negative_total_power();
+    const bool activationMaintenanceRateOn =
+        get_activation_maintenance_rate_on();
+    const bool shorteningRateOn = get_shortening_rate_on();
+    const bool mechanicalWorkRateOn = get_mechanical_work_rate_on();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+    const bool useBhargavaRecruitment = get_use_Bhargava_recruitment_model();
+    const bool enforceMinimumHeatRate =
+        get_enforce_minimum_heat_rate_per_muscle();
+    const bool reportTotalOnly = get_report_total_metabolics_only();
+
+    // Loop through the muscles, in the order of the
+    // MetabolicMuscleParameterSet.
+    const int nM = int(_muscles.size());
     for (int i=0; i<nM; ++i)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];
-        const Muscle* m = mm.getMuscle();
+        const Muscle* m = _muscles[i];
+        const double muscleMass = _muscleMass[i];
+        const Muscle::RealizedMuscleState& ms = m->getRealizedMuscleState(s);
 
         // Get some muscle properties at the current time state
         //const double max_isometric_force = m->getMaxIsometricForce();
         const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
-        double fiber_force_active = get_muscle_effort_scaling_factor()
-                                    * m->getActiveFiberForce(s);
-        const double fiber_length_normalized = m->getNormalizedFiberLength(s);
-        const double fiber_velocity = m->getFiberVelocity(s);
+        const double activation = effortScaling * ms.activation;
+        const double excitation = effortScaling * m->getControl(s);
+        double fiber_force_active = effortScaling * ms.activeFiberForce;
+        const double fiber_length_normalized = ms.normalizedFiberLength;
+        const double fiber_velocity = ms.fiberVelocity;
         double A;
 
         // Umberger defines fiber_velocity_normalized as Vm/LoM, not Vm/Vmax (p101, top left, Umberger(2003))
@@ -304,7 +333,7 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
             A = (excitation + activation) / 2;
 
         // Normalized contractile element force-length curve
-        const double F_iso = m->getActiveForceLengthMultiplier(s);   
+        const double F_iso = ms.activeForceLengthMultiplier;   
 
         // Warnings
         if (fiber_length_normalized < 0)
@@ -317,23 +346,22 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // ACTIVATION & MAINTENANCE HEAT RATE for muscle i (W/kg)
         // --> depends on the normalized fiber length of the contractile element
         // -----------------------------------------------------------------------
-        double slowTwitchRatio = mm.get_ratio_slow_twitch_fibers();
-        if (get_use_Bhargava_recruitment_model()) {
+        double slowTwitchRatio = _ratioSlowTwitchFibers[i];
+        if (useBhargavaRecruitment) {
             const double uSlow = slowTwitchRatio * sin(0.5*Pi * excitation);
             const double uFast = (1 - slowTwitchRatio)
                                  * (1 - cos(0.5*Pi * excitation));
             slowTwitchRatio = (excitation == 0) ? 1.0 : uSlow / (uSlow + uFast);
         }
 
-        if (get_forbid_negative_total_power() ||
-            get_activation_maintenance_rate_on())
+        if (forbidNegativePower || activationMaintenanceRateOn)
         {
             const double unscaledAMdot = 128*(1 - slowTwitchRatio) + 25;
 
             if (fiber_length_normalized <= 1.0)
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * unscaledAMdot;
+                AMdot = aerobicFactor * std::pow(A, 0.6) * unscaledAMdot;
             else
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * ((0.4 * unscaledAMdot) + (0.6 * unscaledAMdot * F_iso));
+                AMdot = aerobicFactor * std::pow(A, 0.6) * ((0.4 * unscaledAMdot) + (0.6 * unscaledAMdot * F_iso));
         }
 
 
@@ -342,7 +370,7 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // --> depends on the normalized fiber length of the contractile element
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
         // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
+        if (forbidNegativePower || shorteningRateOn)
         {
             const double Vmax_fasttwitch = max_shortening_velocity;
             const double Vmax_slowtwitch = max_shortening_velocity / 2.5;
@@ -366,15 +394,15 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
 
                 tmp_fastTwitch = alpha_shortening_fasttwitch * fiber_velocity_normalized * (1-slowTwitchRatio);
                 unscaledSdot = (tmp_slowTwitch * slowTwitchRatio) - tmp_fastTwitch;   // unscaled shortening heat rate: muscle shortening
-                Sdot = get_aerobic_factor() * std::pow(A, 2.0) * unscaledSdot;                      // scaled shortening heat rate: muscle shortening
+                Sdot = aerobicFactor * std::pow(A, 2.0) * unscaledSdot;                      // scaled shortening heat rate: muscle shortening
             }
 
             else    // eccentric contraction, Vm>0
             {
                 unscaledSdot =
-                    (get_include_negative_mechanical_work() ? 4.0 : 0.3)
+                    (includeNegativeWork ? 4.0 : 0.3)
                     * alpha_shortening_slowtwitch * fiber_velocity_normalized;  // unscaled shortening heat rate: muscle lengthening
-                Sdot = get_aerobic_factor() * A * unscaledSdot;                                // scaled shortening heat rate: muscle lengthening
+                Sdot = aerobicFactor * A * unscaledSdot;                                // scaled shortening heat rate: muscle lengthening
             }
 
 
@@ -396,20 +424,20 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // MECHANICAL WORK RATE for the contractile element of muscle i (W/kg).
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
         // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
+        if (forbidNegativePower || mechanicalWorkRateOn)
         {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
+            if (includeNegativeWork || fiber_velocity <= 0)
                 Wdot = -fiber_force_active*fiber_velocity;
             else
                 Wdot = 0;
 
-            Wdot /= mm.getMuscleMass();
+            Wdot /= muscleMass;
         }
 
 
         // If necessary, increase the shortening heat rate so that the total
         // power is non-negative.
-        if (get_forbid_negative_total_power()) {
+        if (forbidNegativePower) {
             const double Edot_Wkg_beforeClamp = AMdot + Sdot + Wdot;
             if (Edot_Wkg_beforeClamp < 0)
                 Sdot -= Edot_Wkg_beforeClamp;
@@ -431,9 +459,9 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // -----------------------------------------------------------------------
         double totalHeatRate = AMdot + Sdot;
 
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 
-            && get_activation_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
+        if(enforceMinimumHeatRate && totalHeatRate < 1.0 
+            && activationMaintenanceRateOn 
+            && shorteningRateOn) {
                 //cout << "WARNING: " << getName() 
                 //    << "  (t = " << s.getTime() 
                 //    << "), the muscle '" << mm.getName() 
@@ -447,20 +475,20 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // ------------------------------------------
         double Edot = 0;
 
-        if (get_activation_maintenance_rate_on() && get_shortening_rate_on())
+        if (activationMaintenanceRateOn && shorteningRateOn)
             Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
         else {
-            if (get_activation_maintenance_rate_on())
+            if (activationMaintenanceRateOn)
                 Edot += AMdot;
-            if (get_shortening_rate_on())
+            if (shorteningRateOn)
                 Edot += Sdot;
         }
-        if (get_mechanical_work_rate_on())
+        if (mechanicalWorkRateOn)
             Edot += Wdot;
-        Edot *= mm.getMuscleMass();
+        Edot *= muscleMass;
 
         EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
+        if (!reportTotalOnly) {
             // Metabolic power storage for muscle i
             EdotOutput(i+2) = Edot;  
         }                          
@@ -469,7 +497,7 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
+        cout << "muscle_mass = " << muscleMass << endl;
         cout << "ratio_slow_twitch_fibers = " << slowTwitchRatio << endl;
         cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
         //cout << "max_isometric_force = " << max_isometric_force << endl;
@@ -617,6 +645,7 @@ void Umberger2010MuscleMetabolicsProbe::
     }
     clearConnections();
     upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet().remove(k);
+    updateMuscleParameterArrays();
 }
 
 
@@ -634,6 +663,7 @@ void Umberger2010MuscleMetabolicsProbe::
     mm->set_use_provided_muscle_mass(true);
     mm->set_provided_muscle_mass(providedMass);
     mm->setMuscleMass();      // actual mass used.
+    updateMuscleParameterArrays();
 }
 
 
@@ -650,6 +680,7 @@ void Umberger2010MuscleMetabolicsProbe::
 
     mm->set_use_provided_muscle_mass(false);
     mm->setMuscleMass();       // actual mass used.
+    updateMuscleParameterArrays();
 }
 
 
@@ -696,6 +727,7 @@ void Umberger2010MuscleMetabolicsProbe::
     setRatioSlowTwitchFibers(const std::string& muscleName, const double& ratio) 
 { 
     updMetabolicParameters(muscleName)->set_ratio_slow_twitch_fibers(ratio);
+    updateMuscleParameterArrays();
 }
 
 
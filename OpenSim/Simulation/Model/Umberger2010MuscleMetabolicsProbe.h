@@ -425,6 +425,14 @@ private:
     //--------------------------------------------------------------------------
     MuscleMap _muscleMap;
 
+    // The muscles and the parameters used by computeProbeInputs(), in the
+    // order of the MetabolicMuscleParameterSet, so that they are not looked
+    // up for every evaluation. Updated by extendConnectToModel() and by the
+    // methods above that change these parameters.
+    std::vector<const Muscle*> _muscles;
+    std::vector<double> _muscleMass;
+    std::vector<double> _ratioSlowTwitchFibers;
+
     //--------------------------------------------------------------------------
     // ModelComponent Interface
     //--------------------------------------------------------------------------
@@ -436,6 +444,9 @@ private:
     void setNull();
     void constructProperties();
 
+    // Gather the muscles and parameters into the arrays above.
+    void updateMuscleParameterArrays();
+
 
     //--------------------------------------------------------------------------
     // MetabolicMuscleParameter Private Interface
@@ -25,26 +25,64 @@
 #include "Model/PointForceDirection.h"
 #include "Model/Model.h"
 
+#include <mutex>
+
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+struct MomentArmSolver::Workspace {
+    State state;
+    Vector generalizedForces;
+    Vector_<SpatialVec> bodyForces;
+};
+
+struct MomentArmSolver::WorkspacePool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Workspace>> available;
+};
+
+class MomentArmSolver::WorkspaceLease {
+public:
+    explicit WorkspaceLease(const MomentArmSolver& solver)
+    :   _pool(*solver._workspaces) {
+        {
+            std::lock_guard<std::mutex> lock(_pool.mutex);
+            if (!_pool.available.empty()) {
+                _workspace = std::move(_pool.available.back());
+                _pool.available.pop_back();
+                return;
+            }
+        }
+        // No workspace is available (this is the first call, or other
+        // threads are using the others), so make one.
+        _workspace.reset(new Workspace);
+        _workspace->state = *solver._defaultState;
+        // Get the body forces equivalent of the point forces of the path
+        _workspace->bodyForces = solver.getModel().getSystem()
+            .getRigidBodyForces(_workspace->state, Stage::Instance);
+    }
+    ~WorkspaceLease() {
+        std::lock_guard<std::mutex> lock(_pool.mutex);
+        _pool.available.push_back(std::move(_workspace));
+    }
+    Workspace& get() { return *_workspace; }
+private:
+    WorkspacePool& _pool;
+    std::unique_ptr<Workspace> _workspace;
+};
+
 //______________________________________________________________________________
 /**
  * An implementation of the MomentArmSolver 
  *
  */
-MomentArmSolver::MomentArmSolver(const Model &model) : Solver(model)
+MomentArmSolver::MomentArmSolver(const Model &model) : Solver(model),
+    _defaultState(new State(model.getWorkingState())),
+    _workspaces(new WorkspacePool)
 {
     setAuthors("Ajay Seth");
-    _stateCopy = model.getWorkingState();
-
-    // Get the body forces equivalent of the point forces of the path
-    _bodyForces = getModel().getSystem()
-        .getRigidBodyForces(_stateCopy, Stage::Instance);
-    // get the right size coupling vector
-    _coupling = _stateCopy.getU();
 }
 
 /*********************************************************************************
@@ -61,36 +99,42 @@ Refer to Moment-arm Theory document by Michael Sherman for details.
 double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
                               const GeometryPath &path) const
 {
+    WorkspaceLease lease(*this);
+    Workspace& ws = lease.get();
+
     //Local modifiable copy of the state
-    State& s_ma = _stateCopy;
+    State& s_ma = ws.state;
     s_ma.updQ() = state.getQ();
 
     // compute the coupling between coordinates due to constraints
-    _coupling = computeCouplingVector(s_ma, aCoord);
+    const Vector coupling = computeCouplingVector(s_ma, aCoord);
 
     // set speeds to zero
     s_ma.updU() = 0;
 
     // zero out all the forces
-    _bodyForces *= 0;
-    _generalizedForces = 0;
+    ws.bodyForces *= 0;
+    ws.generalizedForces = 0;
 
-    // apply a tension of unity to the bodies of the path
+    // apply a tension of unity to the bodies of the path, using the path
+    // geometry even if the path has a polynomial surrogate
     Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
-    path.addInEquivalentForces(s_ma, 1.0, _bodyForces, pathDependentMobilityForces);
+    path.addInGeometricEquivalentForces(s_ma, 1.0, ws.bodyForces,
+                                        pathDependentMobilityForces);
 
-    //_bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
+    //ws.bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
 
     // Convert body spatial forces F to equivalent mobility forces f based on 
     // geometry (no dynamics required): f = ~J(q) * F.
     getModel().getMultibodySystem().getMatterSubsystem()
-        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
+        .multiplyBySystemJacobianTranspose(s_ma, ws.bodyForces,
+                                           ws.generalizedForces);
 
-    _generalizedForces += pathDependentMobilityForces;
+    ws.generalizedForces += pathDependentMobilityForces;
     // Moment-arm is the effective torque (since tension is 1) at the 
     // coordinate of interest taking into account the generalized forces also 
     // acting on other coordinates that are coupled via constraint.
-    return ~_coupling*_generalizedForces;
+    return ~coupling*ws.generalizedForces;
 }
 
 
@@ -99,37 +143,97 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
                               const Array<PointForceDirection *> &pfds) const
 {
     //const clock_t start = clock();
+    WorkspaceLease lease(*this);
+    Workspace& ws = lease.get();
 
     //Local modifiable copy of the state
-    State& s_ma = _stateCopy;
+    State& s_ma = ws.state;
     s_ma.updQ() = state.getQ();
 
     // compute the coupling between coordinates due to constraints
-    _coupling = computeCouplingVector(s_ma, aCoord);
+    const Vector coupling = computeCouplingVector(s_ma, aCoord);
 
     // set speeds to zero
     s_ma.updU() = 0;
 
+    // zero out the forces of a previous call
+    ws.bodyForces *= 0;
+
     int n = pfds.getSize();
     // Apply body forces along the geometry described by pfds due to a tension of 1N
     for(int i=0; i<n; i++) {
         getModel().getMatterSubsystem().
             addInStationForce(s_ma, 
                 pfds[i]->frame().getMobilizedBodyIndex(), 
-                pfds[i]->point(), pfds[i]->direction(), _bodyForces);
+                pfds[i]->point(), pfds[i]->direction(), ws.bodyForces);
     }
 
-    //_bodyForces.dump("bodyForces from PointForceDirections");
+    //ws.bodyForces.dump("bodyForces from PointForceDirections");
 
     // Convert body spatial forces F to equivalent mobility forces f based on 
     // geometry (no dynamics required): f = ~J(q) * F.
     getModel().getMultibodySystem().getMatterSubsystem()
-        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
+        .multiplyBySystemJacobianTranspose(s_ma, ws.bodyForces,
+                                           ws.generalizedForces);
 
     // Moment-arm is the effective torque (since tension is 1) at the 
     // coordinate of interest taking into account the generalized forces also 
     // acting on other coordinates that are coupled via constraint.
-    return ~_coupling*_generalizedForces;
+    return ~coupling*ws.generalizedForces;
+}
+
+SimTK::Matrix MomentArmSolver::solveAll(const State& state,
+        const std::vector<const GeometryPath*>& paths,
+        const std::vector<const Coordinate*>& coordinates) const
+{
+    WorkspaceLease lease(*this);
+    Workspace& ws = lease.get();
+
+    //Local modifiable copy of the state
+    State& s_ma = ws.state;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints once per
+    // coordinate, and keep the mobilities it is coupled to (the sparsity of
+    // the coupling vector)
+    const int nc = int(coordinates.size());
+    Matrix coupling(s_ma.getNU(), nc);
+    std::vector<std::vector<int>> coupledMobilities(nc);
+    for (int j = 0; j < nc; ++j) {
+        coupling(j) = computeCouplingVector(s_ma, *coordinates[j]);
+        for (int k = 0; k < coupling.nrow(); ++k) {
+            if (coupling(k, j) != 0)
+                coupledMobilities[j].push_back(k);
+        }
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    const SimbodyMatterSubsystem& matter =
+        getModel().getMultibodySystem().getMatterSubsystem();
+    Matrix momentArms(int(paths.size()), nc, 0.0);
+    Vector pathDependentMobilityForces(s_ma.getNU());
+    for (int i = 0; i < int(paths.size()); ++i) {
+        // apply a tension of unity to the bodies of the path
+        ws.bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+        paths[i]->addInGeometricEquivalentForces(s_ma, 1.0, ws.bodyForces,
+                                                 pathDependentMobilityForces);
+
+        // f = ~J(q) * F, for all coordinates at once.
+        matter.multiplyBySystemJacobianTranspose(s_ma, ws.bodyForces,
+                                                 ws.generalizedForces);
+        ws.generalizedForces += pathDependentMobilityForces;
+
+        for (int j = 0; j < nc; ++j) {
+            double ma = 0;
+            for (int k : coupledMobilities[j])
+                ma += coupling(k, j)*ws.generalizedForces[k];
+            momentArms(i, j) = ma;
+        }
+    }
+    return momentArms;
 }
 
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <memory>
+
 namespace OpenSim {
 
 class GeometryPath;
@@ -41,6 +43,11 @@ class Coordinate;
  * is only concerned with the set of points and unit forces that maps a scalar
  * force value (like tension) to the resulting generalized force.
  *
+ * The solve methods do not modify the solver or the model, and may be called
+ * from several threads at once, each with its own State. Each concurrent call
+ * uses its own copy of the model's working state (as of the construction of
+ * the solver), which is kept and reused by later calls.
+ *
  * @author Ajay Seth
  * @version 1.0
  */
@@ -68,6 +75,7 @@ public:
     @param  coordinate          Coordinate about which we want the moment-arm
     @param  path                GeometryPath for which to calculate a moment-arm
     @return ma                  resulting moment-arm as a double
+    The path geometry is used even if the path has a polynomial surrogate.
     */
     double solve(const SimTK::State& state, const Coordinate &coordinate,
         const GeometryPath &path) const;
@@ -83,18 +91,36 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
-private:
-    // Internal state of the solver initialized as a copy of the default state
-    mutable SimTK::State _stateCopy;
-
-    // Keep preallocated vector of the generalized forces
-    mutable SimTK::Vector _generalizedForces;
+    /** Solve for the moment-arms of each GeometryPath about each coordinate.
+        The moment-arms are the same as those from solve(state, coordinate,
+        path) for each pair, but the constraint coupling of each coordinate
+        is computed once, and the generalized forces of each path are
+        computed with a single evaluation of the system Jacobian transpose.
+        Only the mobilities coupled to a coordinate contribute to its
+        moment-arms, so a path that does not span a coordinate has a
+        moment-arm of exactly zero about it.
+    @param  state               current state of the model
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @return ma                  moment-arms, one row per path and one column
+                                per coordinate
+    */
+    SimTK::Matrix solveAll(const SimTK::State& state,
+        const std::vector<const GeometryPath*>& paths,
+        const std::vector<const Coordinate*>& coordinates) const;
 
-    // Keep preallocated vector of the Body_Forces
-    mutable SimTK::Vector_<SimTK::SpatialVec> _bodyForces;
+private:
+    // Modifiable copy of the state, and preallocated forces, used by one
+    // call at a time.
+    struct Workspace;
+    // The workspaces not in use; shared by copies of this solver.
+    struct WorkspacePool;
+    // Takes a workspace from the pool, and returns it when destroyed.
+    class WorkspaceLease;
 
-    // Keep preallocated vector of the coupling constraint factors
-    mutable SimTK::Vector _coupling;
+    // The state the workspaces are copied from: the model's working state
+    std::shared_ptr<const SimTK::State> _defaultState;
+    std::shared_ptr<WorkspacePool> _workspaces;
 
     // compute vector of constraint coupling factors
     SimTK::Vector computeCouplingVector(SimTK::State &state, 
@@ -0,0 +1,235 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  MuscleTendonKinematics.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MuscleTendonKinematics.h"
+#include "MomentArmSolver.h"
+#include "Model/Model.h"
+#include "Model/Muscle.h"
+
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+namespace OpenSim {
+
+namespace {
+// A copy of the model, and the components of it used to evaluate the frames
+// of one block.
+struct KinematicsWorker {
+    unique_ptr<Model> model;
+    SimTK::State state;
+    vector<const Coordinate*> valueCoordinates;
+    vector<const Coordinate*> speedCoordinates;
+    vector<const GeometryPath*> paths;
+    vector<const Coordinate*> momentArmCoordinates;
+};
+
+// The path of the coordinate a column of the coordinates table refers to, or
+// an empty string if it refers to none. isSpeed is set for speed columns.
+string findCoordinatePath(const Model& model, const string& label,
+                          bool& isSpeed)
+{
+    isSpeed = false;
+    if (model.getCoordinateSet().contains(label))
+        return model.getCoordinateSet().get(label).getAbsolutePathString();
+
+    const auto slash = label.rfind('/');
+    if (slash == string::npos) return "";
+    const string suffix = label.substr(slash + 1);
+    const string path = label.substr(0, slash);
+    if ((suffix != "value" && suffix != "speed") ||
+            !model.hasComponent<Coordinate>(path))
+        return "";
+    isSpeed = suffix == "speed";
+    return model.getComponent<Coordinate>(path).getAbsolutePathString();
+}
+} // anonymous namespace
+
+MuscleTendonKinematics computeMuscleTendonKinematics(const Model& model,
+        const TimeSeriesTable& coordinates,
+        const vector<string>& momentArmCoordinates, int numThreads)
+{
+    const int numFrames = int(coordinates.getNumRows());
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, numFrames));
+
+    // Each block is evaluated on its own copy of the model. Copies are
+    // initialized here, rather than on the worker threads, so that building
+    // the Systems does not need to be thread-safe.
+    vector<KinematicsWorker> workers(numBlocks);
+    for (auto& worker : workers) {
+        worker.model.reset(model.clone());
+        worker.model->setUseVisualizer(false);
+        worker.state = worker.model->initSystem();
+    }
+    const Model& first = *workers[0].model;
+
+    // Resolve the columns of the table, and the coordinates to compute
+    // moment arms about, by path so they can be found in each copy.
+    vector<int> valueColumns, speedColumns;
+    vector<string> valuePaths, speedPaths;
+    const auto& labels = coordinates.getColumnLabels();
+    for (int i = 0; i < int(labels.size()); ++i) {
+        bool isSpeed;
+        const string path = findCoordinatePath(first, labels[i], isSpeed);
+        if (path.empty()) continue;
+        (isSpeed ? speedColumns : valueColumns).push_back(i);
+        (isSpeed ? speedPaths : valuePaths).push_back(path);
+    }
+    vector<string> momentArmPaths;
+    if (momentArmCoordinates.empty()) {
+        for (const auto& coord : first.getComponentList<Coordinate>())
+            momentArmPaths.push_back(coord.getAbsolutePathString());
+    }
+    else {
+        for (const auto& name : momentArmCoordinates)
+            momentArmPaths.push_back(
+                first.getCoordinateSet().get(name).getAbsolutePathString());
+    }
+    const bool hasSpeeds = !speedColumns.empty();
+
+    for (auto& worker : workers) {
+        const Model& m = *worker.model;
+        for (const auto& path : valuePaths)
+            worker.valueCoordinates.push_back(&m.getComponent<Coordinate>(path));
+        for (const auto& path : speedPaths)
+            worker.speedCoordinates.push_back(&m.getComponent<Coordinate>(path));
+        for (const auto& path : momentArmPaths)
+            worker.momentArmCoordinates.push_back(
+                &m.getComponent<Coordinate>(path));
+        for (const auto& muscle : m.getComponentList<Muscle>())
+            worker.paths.push_back(&muscle.getGeometryPath());
+    }
+
+    // Rotational coordinates and speeds are needed in radians.
+    const TimeSeriesTable* table = &coordinates;
+    TimeSeriesTable radians;
+    if (coordinates.hasTableMetaDataKey("inDegrees") &&
+            coordinates.getTableMetaData<string>("inDegrees") == "yes") {
+        radians = coordinates;
+        first.getSimbodyEngine().convertDegreesToRadians(radians);
+        table = &radians;
+    }
+
+    vector<string> muscleNames;
+    for (const auto& muscle : first.getComponentList<Muscle>())
+        muscleNames.push_back(muscle.getName());
+    const int numMuscles = int(muscleNames.size());
+    const int numMomentArmCoords = int(momentArmPaths.size());
+
+    SimTK::Matrix lengths(numFrames, numMuscles);
+    SimTK::Matrix speeds(hasSpeeds ? numFrames : 0, numMuscles);
+    vector<SimTK::Matrix> momentArms(numMomentArmCoords,
+                                     SimTK::Matrix(numFrames, numMuscles));
+    // The message of the error encountered by each block, if any.
+    vector<string> errors(numBlocks);
+
+    auto evaluateBlock = [&](int block) {
+        KinematicsWorker& worker = workers[block];
+        const Model& m = *worker.model;
+        SimTK::State& s = worker.state;
+        const MomentArmSolver solver(m);
+
+        // Paths with a polynomial surrogate compute their own moment arms;
+        // the rest are solved for together.
+        vector<const GeometryPath*> solvedPaths;
+        vector<int> solvedIndices(numMuscles, -1);
+        for (int i = 0; i < numMuscles; ++i) {
+            if (!worker.paths[i]->hasPolynomialSurrogate()) {
+                solvedIndices[i] = int(solvedPaths.size());
+                solvedPaths.push_back(worker.paths[i]);
+            }
+        }
+
+        const int begin = numFrames*block/numBlocks;
+        const int end = numFrames*(block+1)/numBlocks;
+        try {
+            for (int f = begin; f < end; ++f) {
+                s.setTime(table->getIndependentColumn()[f]);
+                const auto row = table->getRowAtIndex(f);
+                for (int k = 0; k < int(valueColumns.size()); ++k)
+                    worker.valueCoordinates[k]->setValue(s,
+                        row[valueColumns[k]], false);
+                for (int k = 0; k < int(speedColumns.size()); ++k)
+                    worker.speedCoordinates[k]->setSpeedValue(s,
+                        row[speedColumns[k]]);
+
+                if (hasSpeeds) m.realizeVelocity(s);
+                else m.realizePosition(s);
+
+                for (int i = 0; i < numMuscles; ++i) {
+                    lengths(f, i) = worker.paths[i]->getLength(s);
+                    if (hasSpeeds)
+                        speeds(f, i) = worker.paths[i]->getLengtheningSpeed(s);
+                }
+
+                SimTK::Matrix solved;
+                if (!solvedPaths.empty() && numMomentArmCoords > 0)
+                    solved = solver.solveAll(s, solvedPaths,
+                                             worker.momentArmCoordinates);
+                for (int j = 0; j < numMomentArmCoords; ++j) {
+                    for (int i = 0; i < numMuscles; ++i) {
+                        momentArms[j](f, i) = solvedIndices[i] < 0 ?
+                            worker.paths[i]->computeMomentArm(s,
+                                *worker.momentArmCoordinates[j]) :
+                            solved(solvedIndices[i], j);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            errors[block] = e.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int block = 1; block < numBlocks; ++block) {
+        try {
+            threads.emplace_back(evaluateBlock, block);
+        } catch (const std::system_error&) {
+            // Could not start a thread; evaluate this block here instead.
+            evaluateBlock(block);
+        }
+    }
+    evaluateBlock(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("computeMuscleTendonKinematics() " + errorMsg,
+                            __FILE__, __LINE__);
+    }
+
+    const vector<double>& times = coordinates.getIndependentColumn();
+    MuscleTendonKinematics result;
+    result.lengths = TimeSeriesTable(times, lengths, muscleNames);
+    if (hasSpeeds)
+        result.lengtheningSpeeds = TimeSeriesTable(times, speeds, muscleNames);
+    for (int j = 0; j < numMomentArmCoords; ++j) {
+        result.momentArms[workers[0].momentArmCoordinates[j]->getName()] =
+            TimeSeriesTable(times, momentArms[j], muscleNames);
+    }
+    return result;
+}
+
+} // end of namespace OpenSim
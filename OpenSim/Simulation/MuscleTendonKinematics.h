@@ -0,0 +1,84 @@
+#ifndef OPENSIM_MUSCLE_TENDON_KINEMATICS_H_
+#define OPENSIM_MUSCLE_TENDON_KINEMATICS_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  MuscleTendonKinematics.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** The muscle-tendon lengths, lengthening speeds and moment arms of the
+muscles of a Model over a kinematic trajectory, as computed by
+computeMuscleTendonKinematics(). Each table has one column per muscle, named
+after the muscle, and one row per row of the coordinates table. */
+struct MuscleTendonKinematics {
+    /** Length of each muscle's GeometryPath. */
+    TimeSeriesTable lengths;
+    /** Lengthening speed of each muscle's GeometryPath. This table is empty
+    if the coordinates table has no speed columns. */
+    TimeSeriesTable lengtheningSpeeds;
+    /** Moment arms of the muscles about each coordinate, keyed by the
+    coordinate's name. */
+    std::map<std::string, TimeSeriesTable> momentArms;
+};
+
+/** Compute the lengths, lengthening speeds and moment arms of all muscles of
+a model over a kinematic trajectory, for post-processing. Unlike
+MuscleAnalysis, this neither integrates nor realizes the model's dynamics:
+each frame is only realized to Position (or Velocity, if speeds are
+provided), no muscle state is touched, and all moment arms of a frame come
+from a single MomentArmSolver::solveAll().
+
+The columns of `coordinates` are named either after a Coordinate (as in
+files written by the InverseKinematicsTool), or by a Coordinate's path
+followed by "/value" or "/speed" (as in states tables). Coordinates without
+a column keep their default values. If the table's "inDegrees" metadata is
+"yes", rotational coordinates and speeds are converted to radians.
+
+The frames are split into contiguous blocks that are evaluated concurrently,
+each on its own copy of the model; the copies are made and initialized on
+the calling thread.
+
+@param model        the model; it is not modified and need not be
+                    initialized
+@param coordinates  coordinate values (and optionally speeds) over time
+@param momentArmCoordinates
+                    names of the coordinates about which to compute moment
+                    arms; if empty, all of the model's coordinates are used
+@param numThreads   number of threads; if not positive, the number of
+                    hardware threads is used */
+OSIMSIMULATION_API MuscleTendonKinematics computeMuscleTendonKinematics(
+        const Model& model, const TimeSeriesTable& coordinates,
+        const std::vector<std::string>& momentArmCoordinates = {},
+        int numThreads = -1);
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MUSCLE_TENDON_KINEMATICS_H_
@@ -0,0 +1,174 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  OrientationsReference.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OrientationsReference.h"
+#include <OpenSim/Common/FileAdapter.h>
+#include <SimTKcommon/internal/State.h>
+
+using namespace std;
+using namespace SimTK;
+
+namespace OpenSim {
+
+OrientationsReference::OrientationsReference() :
+    Reference_<SimTK::Rotation>() {
+    constructProperties();
+}
+
+OrientationsReference::OrientationsReference(
+        const std::string& orientationFile) :
+    OrientationsReference() {
+    loadOrientationsFile(orientationFile);
+}
+
+OrientationsReference::OrientationsReference(
+        const TimeSeriesTable_<SimTK::Quaternion>& orientationData,
+        const Set<OrientationWeight>* orientationWeightSet) :
+    OrientationsReference() {
+    _orientationTable = orientationData;
+    if(orientationWeightSet != nullptr)
+        upd_orientation_weights() = *orientationWeightSet;
+    populateFromOrientationData();
+}
+
+void OrientationsReference::loadOrientationsFile(
+        const std::string orientationFile) {
+    auto fileExt = FileAdapter::findExtension(orientationFile);
+    OPENSIM_THROW_IF(fileExt != "sto", Exception,
+                     "Expected an orientation file of type STO, but got '" +
+                     orientationFile + "'.");
+
+    _orientationTable = TimeSeriesTable_<SimTK::Quaternion>{orientationFile};
+    upd_orientation_file() = orientationFile;
+
+    populateFromOrientationData();
+}
+
+void OrientationsReference::populateFromOrientationData() {
+    // Convert the quaternions once, so that getValues() only copies.
+    const auto& matrix = _orientationTable.getMatrix();
+    const int nrow = matrix.nrow(), ncol = matrix.ncol();
+    _rotations.resize(size_t(nrow) * size_t(ncol));
+    for(int c = 0; c < ncol; ++c) {
+        for(int r = 0; r < nrow; ++r)
+            _rotations[size_t(r) * ncol + c] =
+                    SimTK::Rotation(matrix.getElt(r, c));
+    }
+
+    const auto& names = _orientationTable.getColumnLabels();
+    _orientationNames.assign(static_cast<unsigned>(names.size()), "");
+    for(unsigned i = 0; i < names.size(); ++i)
+        _orientationNames[i] = names[i];
+
+    // Names must be assigned before weights can be updated
+    _weights.assign(_orientationNames.size(), get_default_weight());
+    updateInternalWeights();
+}
+
+SimTK::Vec2 OrientationsReference::getValidTimeRange() const {
+    OPENSIM_THROW_IF(_orientationTable.getNumRows() == 0,
+                     Exception,
+                     "Orientation table is empty.");
+
+    return {_orientationTable.getIndependentColumn().front(),
+            _orientationTable.getIndependentColumn().back()};
+}
+
+void OrientationsReference::constructProperties() {
+    constructProperty_orientation_file("");
+    Set<OrientationWeight> orientationWeights;
+    constructProperty_orientation_weights(orientationWeights);
+    constructProperty_default_weight(1.0);
+}
+
+const SimTK::Array_<std::string>& OrientationsReference::getNames() const {
+    return _orientationNames;
+}
+
+void OrientationsReference::getValues(const SimTK::State& s,
+        SimTK::Array_<SimTK::Rotation>& values) const {
+    // The row index is found in constant time for uniformly sampled data.
+    const size_t row = _orientationTable.getNearestRowIndexForTime(s.getTime());
+    const size_t ncol = _orientationNames.size();
+    values.resize(unsigned(ncol));
+    if(ncol == 0) return;
+    const SimTK::Rotation* frame = &_rotations[row * ncol];
+    for(size_t i = 0; i < ncol; ++i)
+        values[unsigned(i)] = frame[i];
+}
+
+void OrientationsReference::getWeights(const SimTK::State &s,
+                                       SimTK::Array_<double> &weights) const {
+    updateInternalWeights();
+    weights = _weights;
+}
+
+const TimeSeriesTable_<SimTK::Quaternion>&
+OrientationsReference::getOrientationTable() const {
+    return _orientationTable;
+}
+
+void OrientationsReference::setOrientationWeightSet(
+        const Set<OrientationWeight>& weights) {
+    upd_orientation_weights() = weights;
+}
+
+void OrientationsReference::setDefaultWeight(double weight) {
+    set_default_weight(weight);
+}
+
+void OrientationsReference::updateInternalWeights() const {
+    // if weights are not being changed, do not rebuild list of weights.
+    if (isObjectUpToDateWithProperties())
+        return;
+
+    // Frames that do not have a weight specified in the orientation_weights
+    // property use the default weight.
+    _weights.assign(getNumRefs(), get_default_weight());
+    int wix = -1;
+    int ix = 0;
+    for (const std::string &name : _orientationNames) {
+        wix = get_orientation_weights().getIndex(name, wix);
+        if (wix >= 0)
+            _weights[ix] = get_orientation_weights()[wix].getWeight();
+        ++ix;
+    }
+}
+
+int OrientationsReference::getNumRefs() const {
+    return static_cast<int>(_orientationNames.size());
+}
+
+double OrientationsReference::getSamplingFrequency() const {
+    if(_orientationTable.hasTableMetaDataKey("DataRate")) {
+        auto datarate =
+                _orientationTable.getTableMetaData<std::string>("DataRate");
+        return std::stod(datarate);
+    } else
+        return SimTK::NaN;
+}
+
+size_t OrientationsReference::getNumFrames() const {
+    return _orientationTable.getNumRows();
+}
+
+} // end of namespace OpenSim
@@ -0,0 +1,165 @@
+#ifndef OPENSIM_ORIENTATIONS_REFERENCE_H_
+#define OPENSIM_ORIENTATIONS_REFERENCE_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  OrientationsReference.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Reference.h"
+#include <OpenSim/Common/Set.h>
+#include "OpenSim/Common/TimeSeriesTable.h"
+#include "SimTKcommon/internal/Rotation.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+class OSIMSIMULATION_API OrientationWeight : public Object {
+OpenSim_DECLARE_CONCRETE_OBJECT(OrientationWeight, Object);
+private:
+    OpenSim_DECLARE_PROPERTY(weight, double, "Orientation weight.");
+
+public:
+    OrientationWeight() : Object() { constructProperties(); }
+
+    OrientationWeight(std::string name, double weight) : OrientationWeight() {
+        setName(name);
+        upd_weight() = weight;
+    }
+
+    void setWeight(double weight) { upd_weight() = weight; }
+    double getWeight() const {return get_weight(); }
+
+private:
+    void constructProperties() {
+        constructProperty_weight(1.0);
+    }
+
+}; // end of OrientationWeight class
+
+
+//=============================================================================
+//=============================================================================
+/**
+ * Reference values to be achieved for the orientations of frames (e.g., of
+ * the frames to which inertial measurement units, IMUs, are attached) that
+ * will be used via optimization and/or tracking. The orientations are those
+ * of the frames in ground, given as quaternions, one column per frame; a
+ * column is associated with a PhysicalFrame of the model by the frame's path
+ * or name (see InverseKinematicsSolver). Also contains a weighting that
+ * identifies the relative importance of achieving one orientation relative
+ * to another.
+ *
+ * The orientations are converted to rotation matrices once, and kept frame
+ * by frame, so that getValues() copies a frame without converting it; the
+ * frame is found in constant time if the data are uniformly sampled, as
+ * data from IMUs (at 100-400 Hz) are.
+ */
+class OSIMSIMULATION_API OrientationsReference
+        : public Reference_<SimTK::Rotation> {
+    OpenSim_DECLARE_CONCRETE_OBJECT(OrientationsReference,
+                                    Reference_<SimTK::Rotation>);
+//=============================================================================
+// Properties
+//=============================================================================
+public:
+    OpenSim_DECLARE_PROPERTY(orientation_file, std::string,
+        "Orientation file (.sto) containing the time history of observations "
+        "of frame orientations, as quaternions.");
+
+    OpenSim_DECLARE_PROPERTY(orientation_weights, Set<OrientationWeight>,
+        "Set of orientation weights identified by frame name with weight "
+        "being a positive scalar.");
+
+    OpenSim_DECLARE_PROPERTY(default_weight, double,
+        "Default weight for an orientation.");
+//=============================================================================
+// METHODS
+//=============================================================================
+public:
+    //--------------------------------------------------------------------------
+    // CONSTRUCTION
+    //--------------------------------------------------------------------------
+    OrientationsReference();
+
+    /** Convenience load orientations from a file */
+    OrientationsReference(const std::string& orientationFileName);
+    /** Form a Reference from a TimeSeriesTable of quaternions and
+    corresponding orientation weights, which are associated to the columns
+    by name.                                                                  */
+    OrientationsReference(
+            const TimeSeriesTable_<SimTK::Quaternion>& orientationData,
+            const Set<OrientationWeight>* orientationWeightSet = nullptr);
+
+    virtual ~OrientationsReference() {}
+
+    /** load the orientation data for this OrientationsReference from a file */
+    void loadOrientationsFile(const std::string orientationFile);
+
+    //--------------------------------------------------------------------------
+    // Reference Interface
+    //--------------------------------------------------------------------------
+    int getNumRefs() const override;
+    /** get the time range for which the OrientationsReference values are
+        valid, based on the loaded orientation data.*/
+    SimTK::Vec2 getValidTimeRange() const override;
+    /** get the names of the frames whose orientations serve as references */
+    const SimTK::Array_<std::string>& getNames() const override;
+    /** get the value of the OrientationsReference: the orientations of the
+        frame nearest in time */
+    void getValues(const SimTK::State &s,
+        SimTK::Array_<SimTK::Rotation> &values) const override;
+    /** get the weighting (importance) of meeting this OrientationsReference
+        in the same order as names*/
+    void getWeights(const SimTK::State &s,
+                    SimTK::Array_<double> &weights) const override;
+    /** get the orientations in a table*/
+    const TimeSeriesTable_<SimTK::Quaternion>& getOrientationTable() const;
+
+    //--------------------------------------------------------------------------
+    // Convenience Access
+    //--------------------------------------------------------------------------
+    double getSamplingFrequency() const;
+    Set<OrientationWeight>& updOrientationWeightSet()
+    {   return upd_orientation_weights(); }
+    /** %Set the orientation weights from a set of OrientationWeights; a copy
+        of the Set is used internally. */
+    void setOrientationWeightSet(const Set<OrientationWeight>& weights);
+    void setDefaultWeight(double weight);
+    size_t getNumFrames() const;
+
+private:
+    void constructProperties();
+    void populateFromOrientationData();
+    void updateInternalWeights() const;
+
+    TimeSeriesTable_<SimTK::Quaternion> _orientationTable;
+    // The orientations, frame after frame (row-major), as rotations.
+    std::vector<SimTK::Rotation> _rotations;
+    // frame names inside the orientation data
+    SimTK::Array_<std::string> _orientationNames;
+    // List of weights guaranteed to be in the same order as the names.
+    mutable SimTK::Array_<double> _weights;
+//=============================================================================
+};  // END of class OrientationsReference
+//=============================================================================
+} // namespace
+
+#endif // OPENSIM_ORIENTATIONS_REFERENCE_H_
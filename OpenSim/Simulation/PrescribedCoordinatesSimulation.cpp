@@ -0,0 +1,173 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  PrescribedCoordinatesSimulation.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PrescribedCoordinatesSimulation.h"
+#include "Manager/Manager.h"
+#include "Model/Model.h"
+
+#include <map>
+#include <memory>
+
+using namespace std;
+
+namespace OpenSim {
+
+namespace {
+// Prescribes the q's of one mobilizer as functions of time; a q without a
+// function keeps a constant value.
+class TimeFunctionMotion : public SimTK::Motion::Custom::Implementation {
+public:
+    TimeFunctionMotion(const vector<shared_ptr<SimTK::Function>>& functions,
+                       const vector<double>& constants)
+    :   _functions(functions), _constants(constants) {}
+
+    Implementation* clone() const { return new TimeFunctionMotion(*this); }
+
+    SimTK::Motion::Level getLevel(const SimTK::State&) const override
+    {   return SimTK::Motion::Position; }
+
+    void calcPrescribedPosition(const SimTK::State& s, int nq,
+                                SimTK::Real* q) const override
+    {   evaluate(s, nq, q, 0); }
+    void calcPrescribedPositionDot(const SimTK::State& s, int nq,
+                                   SimTK::Real* qdot) const override
+    {   evaluate(s, nq, qdot, 1); }
+    void calcPrescribedPositionDotDot(const SimTK::State& s, int nq,
+                                      SimTK::Real* qdotdot) const override
+    {   evaluate(s, nq, qdotdot, 2); }
+
+private:
+    void evaluate(const SimTK::State& s, int nq, SimTK::Real* values,
+                  int order) const
+    {
+        const SimTK::Vector time(1, s.getTime());
+        const vector<int> derivComponents(order, 0);
+        for (int i = 0; i < nq; ++i) {
+            const SimTK::Function* f =
+                i < int(_functions.size()) ? _functions[i].get() : nullptr;
+            if (!f)
+                values[i] = (order == 0 && i < int(_constants.size()))
+                            ? _constants[i] : 0;
+            else if (order == 0)
+                values[i] = f->calcValue(time);
+            else
+                values[i] = f->calcDerivative(derivComponents, time);
+        }
+    }
+
+    vector<shared_ptr<SimTK::Function>> _functions;
+    vector<double> _constants;
+};
+
+// The coordinate a column of the coordinates table refers to, if any.
+const Coordinate* findCoordinate(const Model& model, const string& label)
+{
+    if (model.getCoordinateSet().contains(label))
+        return &model.getCoordinateSet().get(label);
+    const string suffix = "/value";
+    if (label.size() <= suffix.size() ||
+            label.compare(label.size() - suffix.size(), suffix.size(),
+                          suffix) != 0)
+        return nullptr;
+    const string path = label.substr(0, label.size() - suffix.size());
+    if (!model.hasComponent<Coordinate>(path)) return nullptr;
+    return &model.getComponent<Coordinate>(path);
+}
+} // anonymous namespace
+
+TimeSeriesTable simulateWithPrescribedCoordinates(const Model& model,
+        const TimeSeriesTable& coordinates, bool equilibrateMuscles,
+        double reportInterval)
+{
+    const int numRows = int(coordinates.getNumRows());
+    OPENSIM_THROW_IF(numRows < 6, Exception,
+        "Expected at least 6 rows of coordinate values to fit quintic "
+        "splines, but got " + to_string(numRows) + ".");
+
+    unique_ptr<Model> copy(model.clone());
+    copy->setUseVisualizer(false);
+    copy->buildSystem();
+
+    // Rotational coordinates are needed in radians.
+    const TimeSeriesTable* table = &coordinates;
+    TimeSeriesTable radians;
+    if (coordinates.hasTableMetaDataKey("inDegrees") &&
+            coordinates.getTableMetaData<string>("inDegrees") == "yes") {
+        radians = coordinates;
+        copy->getSimbodyEngine().convertDegreesToRadians(radians);
+        table = &radians;
+    }
+
+    // The functions and constant values of the q's of each mobilizer.
+    struct MobilizerMotion {
+        vector<shared_ptr<SimTK::Function>> functions;
+        vector<double> constants;
+    };
+    map<SimTK::MobilizedBodyIndex, MobilizerMotion> motions;
+    auto qOf = [&](const Coordinate& coord) -> int {
+        MobilizerMotion& motion = motions[coord.getBodyIndex()];
+        const int q = coord.getMobilizerQIndex();
+        if (int(motion.functions.size()) <= q) {
+            motion.functions.resize(q + 1);
+            motion.constants.resize(q + 1, 0.0);
+        }
+        return q;
+    };
+    for (const auto& coord : copy->getComponentList<Coordinate>()) {
+        const int q = qOf(coord);
+        motions[coord.getBodyIndex()].constants[q] = coord.getDefaultValue();
+    }
+    const auto& times = table->getIndependentColumn();
+    const SimTK::Vector timeVector(numRows, times.data());
+    const auto& labels = table->getColumnLabels();
+    for (int j = 0; j < int(labels.size()); ++j) {
+        const Coordinate* coord = findCoordinate(*copy, labels[j]);
+        if (!coord) continue;
+        const SimTK::Vector values(table->getDependentColumnAtIndex(j));
+        motions[coord->getBodyIndex()].functions[qOf(*coord)].reset(
+            new SimTK::Spline(SimTK::SplineFitter<double>::
+                fitFromErrorVariance(5, timeVector, values, 0).getSpline()));
+    }
+
+    // Each mobilizer takes ownership of its Motion.
+    SimTK::SimbodyMatterSubsystem& matter = copy->updMatterSubsystem();
+    for (const auto& entry : motions) {
+        SimTK::Motion::Custom(matter.updMobilizedBody(entry.first),
+            new TimeFunctionMotion(entry.second.functions,
+                                   entry.second.constants));
+    }
+
+    SimTK::State& s = copy->initializeState();
+    for (SimTK::ConstraintIndex c(0); c < matter.getNumConstraints(); ++c)
+        matter.getConstraint(c).disable(s);
+    s.setTime(times.front());
+    if (equilibrateMuscles) copy->equilibrateMuscles(s);
+
+    Manager manager(*copy);
+    manager.setReportInterval(reportInterval);
+    manager.initialize(s);
+    manager.integrate(times.back());
+    return manager.getStatesTable();
+}
+
+} // end of namespace OpenSim
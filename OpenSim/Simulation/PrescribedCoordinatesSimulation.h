@@ -0,0 +1,69 @@
+#ifndef OPENSIM_PRESCRIBED_COORDINATES_SIMULATION_H_
+#define OPENSIM_PRESCRIBED_COORDINATES_SIMULATION_H_
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  PrescribedCoordinatesSimulation.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+namespace OpenSim {
+
+class Model;
+
+/** Simulate the muscle (and other auxiliary) states of a model, e.g., the
+activations and fiber lengths of its muscles driven by its controllers, while
+its coordinates follow a measured motion, e.g., from the
+InverseKinematicsTool. Every mobilizer's motion is prescribed (with a
+SimTK::Motion) by quintic splines fitted to the coordinates table, so the
+multibody dynamics are trivial: no mass matrix is factored and the
+generalized coordinates and speeds are not integrated, which makes computing
+muscle states over long trials much faster than a forward simulation.
+
+The columns of `coordinates` are named either after a Coordinate (as in
+files written by the InverseKinematicsTool), or by a Coordinate's path
+followed by "/value" (as in states tables); other columns are ignored.
+Coordinates without a column keep their default values. If the table's
+"inDegrees" metadata is "yes", rotational coordinates are converted to
+radians. Since the motion is fully prescribed, the model's constraints are
+disabled; the table must satisfy them (e.g., give the values of coupled
+coordinates too, as the InverseKinematicsTool does).
+
+@param model        the model, with the controllers that drive its muscles;
+                    it is not modified and need not be initialized
+@param coordinates  coordinate values over time; at least 6 rows
+@param equilibrateMuscles
+                    whether to equilibrate the muscles at the first time of
+                    the table before integrating
+@param reportInterval
+                    interval at which the states are recorded (see
+                    Manager::setReportInterval()); if not positive, states
+                    are recorded at every integration step
+@returns the states over the time range of the table, as from
+         Manager::getStatesTable(). */
+OSIMSIMULATION_API TimeSeriesTable simulateWithPrescribedCoordinates(
+        const Model& model, const TimeSeriesTable& coordinates,
+        bool equilibrateMuscles = true, double reportInterval = 0);
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_PRESCRIBED_COORDINATES_SIMULATION_H_
@@ -48,6 +48,7 @@
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
+#include "Model/SphereHalfSpaceContactForce.h"
 #include "Model/Ligament.h"
 #include "Model/JointSet.h"
 #include "Model/Marker.h"
@@ -58,6 +59,7 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/PolynomialPathSurrogate.h"
 #include "Model/PrescribedForce.h"
 #include "Model/ExternalForce.h"
 #include "Model/PointToPointSpring.h"
@@ -175,6 +177,7 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( FrameGeometry());
     Object::registerType( Arrow());
     Object::registerType( GeometryPath());
+    Object::registerType( PolynomialPathSurrogate());
 
     Object::registerType( ControlSet() );
     Object::registerType( ControlConstant() );
@@ -225,6 +228,7 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
     Object::registerType( ContactSphere() );
     Object::registerType( CoordinateLimitForce() );
     Object::registerType( HuntCrossleyForce() );
+    Object::registerType( SphereHalfSpaceContactForce() );
     Object::registerType( ElasticFoundationForce() );
     Object::registerType( HuntCrossleyForce::ContactParameters() );
     Object::registerType( HuntCrossleyForce::ContactParametersSet() );
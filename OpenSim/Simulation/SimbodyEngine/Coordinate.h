@@ -240,6 +240,11 @@ protected:
     void extendRealizeInstance(const SimTK::State& state) const override;
     void extendInitStateFromProperties(SimTK::State& s) const override;
     void extendSetPropertiesFromState(const SimTK::State& state) override;
+    // The residuals of the generalized coordinates and speeds are those of
+    // the multibody system, computed by Model::calcImplicitResiduals().
+    void computeImplicitResiduals(const SimTK::State& s,
+                                  const SimTK::Vector& yDotGuess,
+                                  SimTK::Vector& residuals) const override {}
 
     // Only the coordinate or the joint itself can specify the owner
     // of Coordinate
@@ -26,8 +26,13 @@
 //=============================================================================
 #include "CoordinateCouplerConstraint.h"
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Common/PolynomialFunction.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include "simbody/internal/Constraint.h"
 
+#include <atomic>
+
 // Helper class to construct functions when user's specify a dependency as qd = f(qi)
 // this function casts as C(q) = 0 = f(qi) - qd;
 
@@ -39,12 +44,80 @@ private:
     std::unique_ptr<const SimTK::Function> f1;
     const double scale;
 
+    // Common coupling functions are evaluated here, rather than through f1,
+    // with their value and first two derivatives found together:
+    // polynomials (including linear functions), from their coefficients in
+    // decreasing powers, and SimmSplines.
+    SimTK::Vector coefficients;
+    const OpenSim::SimmSpline* spline = nullptr;
+    // Identifies this function in the last evaluation of the thread.
+    const long long id;
+
+    struct Evaluation {
+        long long id = -1;
+        double x = SimTK::NaN;
+        SimTK::Vec3 f;
+    };
+
+    // The value and the first two derivatives of scale*f1 at x. The last
+    // evaluation of each thread is kept, since the derivatives are asked for
+    // one at a time at the same x (e.g., both when the acceleration errors
+    // are found); functions evaluated concurrently with distinct states each
+    // use their own thread's.
+    const SimTK::Vec3& evaluate(double x) const {
+        static thread_local Evaluation last;
+        if (last.id == id && last.x == x) return last.f;
+        SimTK::Vec3 f;
+        if (spline) {
+            f = spline->calcValueAndDerivatives(x);
+        } else {
+            // Horner's method, with the derivatives.
+            f = SimTK::Vec3(0);
+            for (int i = 0; i < coefficients.size(); ++i) {
+                f[2] = f[2]*x + 2*f[1];
+                f[1] = f[1]*x + f[0];
+                f[0] = f[0]*x + coefficients[i];
+            }
+        }
+        last.id = id;
+        last.x = x;
+        last.f = scale*f;
+        return last.f;
+    }
+
+    static long long nextId() {
+        static std::atomic<long long> count{0};
+        return count++;
+    }
+
 public:
     
-    CompoundFunction(const SimTK::Function *cf, double scale) : f1(cf), scale(scale) {
+    CompoundFunction(const SimTK::Function *cf, double scale) : f1(cf), scale(scale), id(nextId()) {
+    }
+
+    /* Evaluate function directly rather than through cf, when it is of one
+    of the common kinds; function must outlive this. */
+    CompoundFunction(const OpenSim::Function& function, double scale) :
+            CompoundFunction(function.createSimTKFunction(), scale) {
+        if (const auto* linear =
+                dynamic_cast<const OpenSim::LinearFunction*>(&function)) {
+            // Only a function of one argument: slope and intercept.
+            if (linear->getCoefficients().getSize() == 2)
+                coefficients = SimTK::Vector(2, &linear->getCoefficients()[0]);
+        } else if (const auto* polynomial =
+                dynamic_cast<const OpenSim::PolynomialFunction*>(&function)) {
+            coefficients = polynomial->get_coefficients();
+        } else {
+            spline = dynamic_cast<const OpenSim::SimmSpline*>(&function);
+        }
+    }
+
+    bool isEvaluatedDirectly() const {
+        return spline || coefficients.size() > 0;
     }
 
     double calcValue(const SimTK::Vector& x) const override {
+        if (isEvaluatedDirectly()) return evaluate(x[0])[0] - x[1];
         SimTK::Vector xf(1);
         xf[0] = x[0];
         return scale*f1->calcValue(xf)-x[1];
@@ -57,6 +130,7 @@ public:
     double calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const override {
         if (derivComponents.size() == 1){
             if (derivComponents[0]==0){
+                if (isEvaluatedDirectly()) return evaluate(x[0])[1];
                 SimTK::Vector x1(1);
                 x1[0] = x[0];
                 return scale*f1->calcDerivative(derivComponents, x1);
@@ -66,6 +140,7 @@ public:
         }
         else if(derivComponents.size() == 2){
             if (derivComponents[0]==0 && derivComponents[1] == 0){
+                if (isEvaluatedDirectly()) return evaluate(x[0])[2];
                 SimTK::Vector x1(1);
                 x1[0] = x[0];
                 return scale*f1->calcDerivative(derivComponents, x1);
@@ -224,7 +299,7 @@ void CoordinateCouplerConstraint::extendAddToSystem(SimTK::MultibodySystem& syst
 
     // Create and set the underlying coupler constraint function;
     const Function& f = get_coupled_coordinates_function();
-    SimTK::Function *simtkCouplerFunction = new CompoundFunction(f.createSimTKFunction(), get_scale_factor());
+    SimTK::Function *simtkCouplerFunction = new CompoundFunction(f, get_scale_factor());
 
 
     // Now create a Simbody Constraint::CoordinateCoupler
@@ -25,6 +25,8 @@
 #include <OpenSim/Common/MultiplierFunction.h>
 #include <OpenSim/Common/LinearFunction.h>
 
+#include <limits>
+
 using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
@@ -157,11 +159,113 @@ std::vector<std::vector<int> > SpatialTransform::getCoordinateIndices() const
     
     return coordIndices;
 }
+
+namespace {
+// Most TransformAxis functions in gait models are constants (locked axes) or
+// identity/affine maps of a single coordinate (pin and gimbal-like axes).
+// The mobilizer calls its axis functions on every realize, so those cases are
+// emitted as final classes whose value and derivatives need no coefficient
+// loop and no dispatch back into an OpenSim::Function.
+
+// f = c
+class ConstantAxisFunction final : public SimTK::Function {
+public:
+    ConstantAxisFunction(double value, int argumentSize)
+        : _value(value), _argumentSize(argumentSize) {}
+    double calcValue(const SimTK::Vector&) const override { return _value; }
+    double calcDerivative(const SimTK::Array_<int>&,
+            const SimTK::Vector&) const override { return 0; }
+    int getArgumentSize() const override { return _argumentSize; }
+    int getMaxDerivativeOrder() const override
+    {   return std::numeric_limits<int>::max(); }
+private:
+    const double _value;
+    const int _argumentSize;
+};
+
+// f = x
+class IdentityAxisFunction final : public SimTK::Function {
+public:
+    double calcValue(const SimTK::Vector& x) const override { return x[0]; }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const SimTK::Vector&) const override
+    {   return derivComponents.size() == 1 ? 1.0 : 0.0; }
+    int getArgumentSize() const override { return 1; }
+    int getMaxDerivativeOrder() const override
+    {   return std::numeric_limits<int>::max(); }
+};
+
+// f = a*x + b
+class AffineAxisFunction final : public SimTK::Function {
+public:
+    AffineAxisFunction(double slope, double intercept)
+        : _slope(slope), _intercept(intercept) {}
+    double calcValue(const SimTK::Vector& x) const override
+    {   return _slope*x[0] + _intercept; }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const SimTK::Vector&) const override
+    {   return derivComponents.size() == 1 ? _slope : 0.0; }
+    int getArgumentSize() const override { return 1; }
+    int getMaxDerivativeOrder() const override
+    {   return std::numeric_limits<int>::max(); }
+private:
+    const double _slope;
+    const double _intercept;
+};
+
+// Reduce a (possibly scaled) Constant or single-argument LinearFunction to
+// its slope and intercept. Returns false for any other function.
+bool getAffineCoefficients(const OpenSim::Function& function,
+        double& slope, double& intercept, bool& isConstant)
+{
+    if (const auto* c = dynamic_cast<const Constant*>(&function)) {
+        slope = 0;
+        intercept = c->getValue();
+        isConstant = true;
+        return true;
+    }
+    if (const auto* lf = dynamic_cast<const LinearFunction*>(&function)) {
+        const Array<double> coefficients = lf->getCoefficients();
+        if (coefficients.getSize() != 2) return false;
+        slope = coefficients[0];
+        intercept = coefficients[1];
+        isConstant = false;
+        return true;
+    }
+    if (const auto* mf = dynamic_cast<const MultiplierFunction*>(&function)) {
+        if (!mf->getFunction() ||
+                !getAffineCoefficients(*mf->getFunction(),
+                                       slope, intercept, isConstant))
+            return false;
+        slope *= mf->getScale();
+        intercept *= mf->getScale();
+        return true;
+    }
+    return false;
+}
+} // anonymous namespace
+
 std::vector<const SimTK::Function*> SpatialTransform::getFunctions() const
 {
     std::vector<const SimTK::Function*> functions(NumTransformAxes);
     for(int i=0; i < NumTransformAxes; i++){
-        functions[i] = getTransformAxis(i).getFunction().createSimTKFunction();
+        const TransformAxis& transform = getTransformAxis(i);
+        const OpenSim::Function& function = transform.getFunction();
+        const int nargs = transform.getCoordinateNames().size();
+
+        double slope = 0, intercept = 0;
+        bool isConstant = false;
+        if (getAffineCoefficients(function, slope, intercept, isConstant)
+                && (isConstant ? nargs <= 1 : nargs == 1)) {
+            if (isConstant || slope == 0)
+                functions[i] = new ConstantAxisFunction(intercept, nargs);
+            else if (slope == 1.0 && intercept == 0.0)
+                functions[i] = new IdentityAxisFunction();
+            else
+                functions[i] = new AffineAxisFunction(slope, intercept);
+        }
+        else
+            functions[i] = function.createSimTKFunction();
     }
     return functions;
 }
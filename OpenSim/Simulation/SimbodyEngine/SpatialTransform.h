@@ -86,7 +86,10 @@ public:
     std::vector<std::vector<int> > getCoordinateIndices() const;
 #endif
     /** Create a new SimTK::Function corresponding to each axis; these are
-    heap allocated and it is up to the caller to delete them. **/
+    heap allocated and it is up to the caller to delete them. Axes whose
+    function is a Constant, or a (possibly scaled) LinearFunction of a single
+    coordinate, get specialized functions that evaluate without a
+    coefficient loop or a call back into the OpenSim::Function. **/
     std::vector<const SimTK::Function*> getFunctions() const;
     /** Get the axis direction associated with each TransformAxis. **/
     std::vector<SimTK::Vec3> getAxes() const;
@@ -44,6 +44,7 @@
 
 #include <OpenSim/Common/FunctionAdapter.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
 #include <OpenSim/Simulation/Model/ModelVisualizer.h>
@@ -55,6 +56,7 @@
 #include <OpenSim/Simulation/SimbodyEngine/PlanarJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/CustomJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SpatialTransform.h>
 
 #include <OpenSim/Simulation/SimbodyEngine/PointConstraint.h>
@@ -136,6 +138,7 @@ void testCoordinateLocking();
 void testWeldConstraint();
 void testPointOnLineConstraint();
 void testCoordinateCouplerConstraint();
+void testCoordinateCouplerFunctions();
 void testPointConstraint();
 void testConstantDistanceConstraint();
 void testSerializeDeserialize();
@@ -151,6 +154,7 @@ int main()
         testPointOnLineConstraint();
         // Compare behavior of CoordinateCouplerConstraint as a custom knee
         testCoordinateCouplerConstraint();
+        testCoordinateCouplerFunctions();
         // test OpenSim roll constraint against a composite of Simbody constraints
         testRollingOnSurfaceConstraint();
         testSerializeDeserialize();
@@ -936,6 +940,80 @@ void testCoordinateCouplerConstraint()
     forceReport->printResults("CouplerModelForces");
 }
 
+void testCoordinateCouplerFunctions()
+{
+    using namespace SimTK;
+
+    cout << endl;
+    cout << "=================================================================" << endl;
+    cout << " OpenSim CoordinateCouplerConstraint coupling functions          " << endl;
+    cout << "=================================================================" << endl;
+
+    // The kinds of functions the constraint evaluates directly, and a
+    // function it evaluates through its SimTK::Function.
+    double knots[] = {-1.0, -0.5, 0.0, 0.5, 1.0};
+    double values[] = {0.1, -0.2, 0.0, 0.3, 0.2};
+    std::vector<std::unique_ptr<Function>> functions;
+    functions.emplace_back(new LinearFunction(0.5, 0.1));
+    functions.emplace_back(new PolynomialFunction(Vector(Vec3(0.3, -0.2, 0.1))));
+    functions.emplace_back(new SimmSpline(5, knots, values));
+    functions.emplace_back(
+            new MultiplierFunction(new SimmSpline(5, knots, values), 1.0));
+
+    const double scale = 2.0;
+    for (const auto& function : functions) {
+        // Two blocks on sliders, the second's coordinate coupled to the
+        // first's: qd = scale*f(qi).
+        Model model;
+        auto* block1 = new OpenSim::Body("block1", 1.0, Vec3(0), Inertia(1));
+        auto* block2 = new OpenSim::Body("block2", 1.0, Vec3(0), Inertia(1));
+        auto* slider1 = new SliderJoint("slider1", model.getGround(), *block1);
+        auto* slider2 = new SliderJoint("slider2", model.getGround(), *block2);
+        model.addBody(block1);
+        model.addBody(block2);
+        model.addJoint(slider1);
+        model.addJoint(slider2);
+        const Coordinate& qi = slider1->getCoordinate();
+        const Coordinate& qd = slider2->getCoordinate();
+
+        auto* coupler = new CoordinateCouplerConstraint();
+        coupler->setIndependentCoordinateNames(Array<string>(qi.getName(), 1));
+        coupler->setDependentCoordinateName(qd.getName());
+        coupler->setFunction(*function);
+        coupler->set_scale_factor(scale);
+        model.addConstraint(coupler);
+        // The first block is pushed so that the second accelerates through
+        // both derivatives of the function.
+        auto* push = new PrescribedForce("push", *block1);
+        push->setForceFunctions(new Constant(3.0), new Constant(0.0),
+                                new Constant(0.0));
+        model.addForce(push);
+
+        State& s = model.initSystem();
+        const double x = 0.3, u = 0.7;
+        const Vector arg(1, x);
+        const double f = scale*function->calcValue(arg);
+        const double df = scale*function->calcDerivative({0}, arg);
+        const double ddf = scale*function->calcDerivative({0, 0}, arg);
+        qi.setValue(s, x, false);
+        qd.setValue(s, f, false);
+        qi.setSpeedValue(s, u);
+        qd.setSpeedValue(s, df*u);
+        model.realizeAcceleration(s);
+
+        const string name = function->getConcreteClassName();
+        ASSERT_EQUAL(0.0, s.getQErr().normInf(), 1e-12, __FILE__, __LINE__,
+                name + ": position error.");
+        ASSERT_EQUAL(0.0, s.getUErr().normInf(), 1e-12, __FILE__, __LINE__,
+                name + ": velocity error.");
+        const double qdd = qi.getAccelerationValue(s);
+        ASSERT(std::abs(qdd) > 1e-3, __FILE__, __LINE__,
+                name + ": the first block did not accelerate.");
+        ASSERT_EQUAL(ddf*u*u + df*qdd, qd.getAccelerationValue(s), 1e-9,
+                __FILE__, __LINE__, name + ": acceleration error.");
+    }
+}
+
 void testRollingOnSurfaceConstraint()
 {
     using namespace SimTK;
@@ -67,6 +67,7 @@
 #include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/LinearFunction.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/MultiplierFunction.h>
 #include <OpenSim/Common/FunctionAdapter.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
@@ -165,6 +166,7 @@ void testGimbalJointAccessors();
 void testUniversalJointAccessors();
 void testMotionTypesForCustomJointCoordinates();
 void testNonzeroInterceptCustomJointVsPin();
+void testSpatialTransformSpecializedFunctions();
 
 // Multibody tree constructions tests
 void testAddedFreeJointForBodyWithoutJoint();
@@ -302,6 +304,14 @@ int main()
         failures.push_back("testNonzeroInterceptCustomJointVsPin");
     }
 
+    // Constant and linear TransformAxis functions are emitted as specialized
+    // SimTK::Functions; they must match the OpenSim::Functions they replace.
+    try { ++itc; testSpatialTransformSpecializedFunctions(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSpatialTransformSpecializedFunctions");
+    }
+
     // Test accessors.
     try { ++itc; testCustomJointAccessors(); }
     catch (const std::exception& e) {
@@ -2704,3 +2714,57 @@ void testNonzeroInterceptCustomJointVsPin()
         "of the coordinate value.");
 
 }
+
+void testSpatialTransformSpecializedFunctions()
+{
+    using namespace SimTK;
+
+    cout << endl;
+    cout << "===========================================================" << endl;
+    cout << " Test SpatialTransform specialized axis functions          " << endl;
+    cout << "===========================================================" << endl;
+
+    Array<std::string> q1; q1.append("q1");
+    Array<std::string> none;
+
+    SimmSpline spline;
+    for (int i = 0; i < 5; ++i)
+        spline.addPoint(-1.0 + 0.5*i, 0.02*i*i);
+
+    SpatialTransform transform;
+    // identity, affine, locked, scaled identity, general, scaled constant
+    transform[0].setCoordinateNames(q1);
+    transform[0].setFunction(new LinearFunction(1.0, 0.0));
+    transform[1].setCoordinateNames(q1);
+    transform[1].setFunction(new LinearFunction(-2.0, 0.3));
+    transform[2].setCoordinateNames(none);
+    transform[2].setFunction(new Constant(0.0));
+    transform[3].setCoordinateNames(q1);
+    transform[3].setFunction(
+        new MultiplierFunction(new LinearFunction(1.0, 0.0), 0.5));
+    transform[4].setCoordinateNames(q1);
+    transform[4].setFunction(spline);
+    transform[5].setCoordinateNames(none);
+    transform[5].setFunction(new MultiplierFunction(new Constant(0.1), 2.0));
+
+    std::vector<const SimTK::Function*> functions = transform.getFunctions();
+    ASSERT(functions.size() == 6);
+
+    const std::vector<int> d1{ 0 };
+    const std::vector<int> d2{ 0, 0 };
+    for (int i = 0; i < 6; ++i) {
+        const OpenSim::Function& f = transform[i].getFunction();
+        const int nargs = transform[i].getCoordinateNames().size();
+        for (double q : { -0.7, 0.0, 0.4 }) {
+            Vector x(nargs, q);
+            ASSERT_EQUAL(f.calcValue(x), functions[i]->calcValue(x),
+                SimTK::Eps);
+            if (nargs == 0) continue;
+            ASSERT_EQUAL(f.calcDerivative(d1, x),
+                functions[i]->calcDerivative(d1, x), SimTK::Eps);
+            ASSERT_EQUAL(f.calcDerivative(d2, x),
+                functions[i]->calcDerivative(d2, x), SimTK::Eps);
+        }
+        delete functions[i];
+    }
+}
@@ -106,6 +106,59 @@ inline SimTK::State simulate(Model& model,
 
 /// @}
 
+/// @name Linear dependence of the accelerations on the actuators
+/// @{
+/** Calculate the generalized accelerations (UDot) per unit of (overridden)
+    actuation of each of the given actuators, at a state realized to at least
+    Stage::Position. At a given state the accelerations are linear in the
+    actuations, so column j of accelerations is M^-1 f_j, where f_j is the
+    generalized force of actuator j per unit actuation (see
+    ScalarActuator::addInForcesPerUnitActuation()), and multiplying by M^-1
+    takes O(n) time without factoring M. The column of
+    a disabled actuator is zero. The column of an actuator that does not
+    provide its forces is not calculated (computed[j] is false), nor is any
+    column if the model has kinematic constraints, since the constraint forces
+    also depend on the actuations; those must be found by realizing the model
+    with perturbed actuations instead.
+    @returns whether any column was calculated. */
+inline bool calcAccelerationsPerUnitActuation(const Model& model,
+        const SimTK::State& s,
+        const std::vector<const ScalarActuator*>& actuators,
+        SimTK::Matrix& accelerations, std::vector<bool>& computed)
+{
+    const int na = int(actuators.size());
+    const int nu = s.getNU();
+    accelerations.resize(nu, na);
+    accelerations.setToZero();
+    computed.assign(na, false);
+    if (s.getNMultipliers() > 0) return false;
+
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    SimTK::Vector mobilityForces(nu), generalizedForces(nu);
+    bool any = false;
+    for (int j = 0; j < na; ++j) {
+        // A disabled actuator does not accelerate the model.
+        if (!actuators[j]->appliesForce(s)) {
+            computed[j] = any = true;
+            continue;
+        }
+        bodyForces.setToZero();
+        mobilityForces.setToZero();
+        if (!actuators[j]->addInForcesPerUnitActuation(s, bodyForces,
+                                                       mobilityForces))
+            continue;
+        matter.multiplyBySystemJacobianTranspose(s, bodyForces,
+                                                 generalizedForces);
+        generalizedForces += mobilityForces;
+        matter.multiplyByMInv(s, generalizedForces, mobilityForces);
+        accelerations(j) = mobilityForces;
+        computed[j] = any = true;
+    }
+    return any;
+}
+/// @}
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_SIMULATION_UTILITIES_H_
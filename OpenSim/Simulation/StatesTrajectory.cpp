@@ -25,6 +25,9 @@
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <cmath>
+#include <thread>
+
 using namespace OpenSim;
 
 size_t StatesTrajectory::getSize() const {
@@ -138,6 +141,13 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             requestedStateVars;
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
+
+    // Resolve the requested state variables once, rather than for each row.
+    std::vector<Component::StateVariableHandle> handles;
+    for (const auto& stateVar : requestedStateVars) {
+        handles.push_back(model.getStateVariableHandle(stateVar));
+    }
+    SimTK::Vector values;
     
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
@@ -149,10 +159,8 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             // This is *much* faster than getting the values one-by-one.
             row = model.getStateVariableValues(state).transpose();
         } else {
-            for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] = 
-                    model.getStateVariableValue(state, stateVars[icol]);
-            }
+            model.getStateVariableValues(state, handles, values);
+            row = values.transpose();
         }
 
         table.appendRow(state.getTime(), row);
@@ -244,40 +252,123 @@ StatesTrajectory StatesTrajectory::createFromStatesStorage(
     // Fill up trajectory.
     // ===================
 
-    // Reserve the memory we'll need to fit all the states.
-    states.m_states.reserve(sto.getSize());
-
-    // Working memory for Storage.
-    SimTK::Vector dependentValues(numDependentColumns);
-
-    // Working memory for state. Initialize so that missing columns end up as
-    // NaN.
-    SimTK::Vector statesValues(modelStateNames.getSize(), SimTK::NaN);
-
     // Initialize so that missing columns end up as NaN.
     state.updY().setToNaN();
 
-    // Loop through all rows of the Storage.
-    for (int itime = 0; itime < sto.getSize(); ++itime) {
-
-        // Extract data from Storage into the working Vector.
-        sto.getData(itime, numDependentColumns, dependentValues);
+    // Find where each state variable lives in Y, by setting all of them to
+    // distinct values in a copy of the state. Most state variables are then
+    // copied from the Storage directly into Y. Those that are not found
+    // (e.g., the values of clamped or locked coordinates, which
+    // Coordinate::setValue() does not simply store) are set through the model
+    // for each row.
+    const int numStates = modelStateNames.getSize();
+    std::vector<int> yIndices(numStates, -1);
+    bool useYIndices = true;
+    {
+        SimTK::State probe(state);
+        SimTK::Vector probeValues(numStates);
+        for (int is = 0; is < numStates; ++is) probeValues[is] = 1e12 + is;
+        localModel.setStateVariableValues(probe, probeValues);
+        const SimTK::Vector& y = probe.getY();
+        int numFound = 0;
+        int numOther = 0;
+        for (int iy = 0; iy < y.size(); ++iy) {
+            if (SimTK::isNaN(y[iy])) continue;
+            const double is = std::round(y[iy] - 1e12);
+            if (is < 0 || is >= numStates || y[iy] != probeValues[(int)is]) {
+                // E.g., a clamped value.
+                ++numOther;
+            } else if (yIndices[(int)is] != -1) {
+                useYIndices = false;
+            } else {
+                yIndices[(int)is] = iy;
+                ++numFound;
+            }
+        }
+        // Each entry of Y that was set must belong to one state variable;
+        // otherwise, keep setting all of them through the model.
+        if (numOther > numStates - numFound) useYIndices = false;
+    }
 
-        // Set the correct time in the state.
-        sto.getTime(itime, state.updTime());
+    // 'first': index for Storage; 'second': index for Y (or, if negative,
+    // -1 - index for Model).
+    std::vector<std::pair<int, int>> direct, indirect;
+    for (const auto& kv : statesToFillUp) {
+        if (useYIndices && yIndices[kv.second] != -1)
+            direct.emplace_back(kv.first, yIndices[kv.second]);
+        else
+            indirect.emplace_back(kv.first, kv.second);
+    }
+    std::vector<Component::StateVariableHandle> indirectHandles;
+    for (const auto& in : indirect) {
+        indirectHandles.push_back(localModel.getStateVariableHandle(
+                modelStateNames[in.second]));
+    }
 
-        // Fill up current State with the data for the current time.
-        for (const auto& kv : statesToFillUp) {
-            // 'first': index for Storage; 'second': index for Model.
-            statesValues[kv.second] = dependentValues[kv.first];
+    // Every state is a copy of the same state, so they are all consistent,
+    // and they are stored without the checks of append().
+    const int numRows = sto.getSize();
+    states.m_states.resize(numRows);
+    auto fillRow = [&](SimTK::State& s, int itime) {
+        const StateVector& row = *sto.getStateVector(itime);
+        const Array<double>& dependentValues = row.getData();
+        s.setTime(row.getTime());
+        SimTK::Vector& y = s.updY();
+        for (const auto& d : direct) y[d.second] = dependentValues[d.first];
+        for (size_t i = 0; i < indirect.size(); ++i) {
+            localModel.setStateVariableValue(s, indirectHandles[i],
+                    dependentValues[indirect[i].first]);
         }
-        localModel.setStateVariableValues(state, statesValues);
         if (enforceConstraints) {
-            localModel.assemble(state);
+            localModel.assemble(s);
+        }
+    };
+
+    // Rows are filled on several threads only if they do not need the model,
+    // which is not safe to use from several threads at once.
+    const int numBlocks = (enforceConstraints || !indirect.empty()) ? 1 :
+            std::max(1, std::min((int)std::thread::hardware_concurrency(),
+                                 numRows / 1000));
+    if (numBlocks == 1) {
+        for (int itime = 0; itime < numRows; ++itime) {
+            fillRow(state, itime);
+            states.m_states[itime] = state;
+        }
+        return states;
+    }
+
+    // The message of the error encountered by each block, if any.
+    std::vector<std::string> errors(numBlocks);
+    auto fillBlock = [&](int b) {
+        try {
+            const int begin = numRows*b/numBlocks;
+            const int end = numRows*(b+1)/numBlocks;
+            for (int itime = begin; itime < end; ++itime) {
+                SimTK::State& s = states.m_states[itime];
+                s = state;
+                fillRow(s, itime);
+            }
+        }
+        catch (const std::exception& e) {
+            errors[b] = e.what();
         }
+    };
+    std::vector<std::thread> threads;
+    for (int b = 1; b < numBlocks; ++b) {
+        try {
+            threads.emplace_back(fillBlock, b);
+        } catch (const std::system_error&) {
+            // Could not start a thread; fill this block here instead.
+            fillBlock(b);
+        }
+    }
+    fillBlock(0);
+    for (auto& thread : threads) thread.join();
 
-        // Make a copy of the edited state and put it in the trajectory.
-        states.append(state);
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("StatesTrajectory::createFromStatesStorage() " +
+                            errorMsg, __FILE__, __LINE__);
     }
 
     return states;
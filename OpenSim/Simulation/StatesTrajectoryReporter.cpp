@@ -28,9 +28,11 @@ using namespace OpenSim;
 
 void StatesTrajectoryReporter::clear() {
     m_states.clear();
+    m_compressor.clear();
 }
 
 const StatesTrajectory& StatesTrajectoryReporter::getStates() const {
+    finishCompression();
     return m_states;
 }
 
@@ -42,6 +44,56 @@ void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state)
 }
 */
 
+void StatesTrajectoryReporter::setOutputFile(const std::string& fileName) {
+    closeOutputFile();
+    m_fileSink.fileName = fileName;
+}
+
+void StatesTrajectoryReporter::flushOutputFile() {
+    if (m_fileSink.writer) m_fileSink.writer->flush();
+}
+
+void StatesTrajectoryReporter::closeOutputFile() {
+    if (m_fileSink.writer) {
+        finishCompression();
+        m_fileSink.writer->close();
+    }
+    m_fileSink.writer.reset();
+    m_fileSink.fileName.clear();
+}
+
+void StatesTrajectoryReporter::setCompressionTolerance(double tolerance) {
+    m_compressor = TrajectoryCompressor(tolerance);
+    clear();
+}
+
+void StatesTrajectoryReporter::finishCompression() const {
+    m_compressor.finish([this](double, const double*) {
+        storeState(m_lastState);
+    });
+}
+
 void StatesTrajectoryReporter::implementReport(const SimTK::State& state) const {
-    m_states.append(state);
+    if (m_compressor.getTolerance() == 0 || state.getNY() == 0) {
+        storeState(state);
+        return;
+    }
+    // The compressor keeps either this state (the first one) or the last.
+    const SimTK::Vector& y = state.getY();
+    m_compressor.append(state.getTime(), &y[0], y.size(),
+        [&](double time, const double*) {
+            storeState(time == state.getTime() ? state : m_lastState);
+        });
+    m_lastState = state;
+}
+
+void StatesTrajectoryReporter::storeState(const SimTK::State& state) const {
+    FileSink& sink = m_fileSink;
+    if (sink.fileName.empty()) {
+        m_states.append(state);
+        return;
+    }
+    if (!sink.writer)
+        sink.writer.reset(new CompactStatesFileWriter(sink.fileName));
+    sink.writer->append(state);
 }
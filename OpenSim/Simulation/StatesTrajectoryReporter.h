@@ -24,7 +24,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/TrajectoryCompressor.h>
 
 #include "osimSimulationDLL.h"
 
@@ -46,6 +48,36 @@ public:
     /** Clear the accumulated states. */ 
     void clear();
 
+    /** Write the states to a file, as they are reported, in the compact
+    format of CompactStatesTrajectory (see CompactStatesFileWriter), instead
+    of accumulating them; use this to keep memory use flat in long
+    simulations. Read the file back with
+    CompactStatesTrajectory::createFromFile(). The file is opened at the next
+    report. While it is open, getStates() is not added to. A copy of this
+    reporter does not write to the file. */
+    void setOutputFile(const std::string& fileName);
+    /** Flush the states reported so far to the output file set with
+    setOutputFile(), without closing it. */
+    void flushOutputFile();
+    /** Close the output file set with setOutputFile(). Later states are
+    accumulated again. This is also done when this reporter is destroyed. */
+    void closeOutputFile();
+
+    /** Keep only the states whose continuous state variables (see
+    SimTK::State::getY()) linear interpolation between the states kept
+    does not reproduce within the given tolerance (see
+    TrajectoryCompressor); the first and last states are always kept. A
+    smooth trajectory then takes a fraction of the states, in getStates()
+    or in the output file. A state is known to be kept only when a later
+    state is reported, so the last state reported is added when
+    getStates() or closeOutputFile() is called. A tolerance of 0 (the
+    default) turns the compression off. This clears the accumulated
+    states.
+    @throws Exception If the tolerance is negative. */
+    void setCompressionTolerance(double tolerance);
+    double getCompressionTolerance() const
+    {   return m_compressor.getTolerance(); }
+
 protected:
     // /** Clears the internal StatesTrajectory in preparation for a (new)
     //  * simulation */
@@ -59,6 +91,23 @@ private:
     // Mutable because we append during reporting. This is OK to do since
     // reporting never occurs for trial states.
     mutable StatesTrajectory m_states;
+
+    // Append the state to the trajectory or write it to the output file.
+    void storeState(const SimTK::State& state) const;
+    // Store the last state reported, if the compressor has held it back.
+    void finishCompression() const;
+
+    // The compression of the states, if setCompressionTolerance(), and the
+    // last state reported, which it may keep when the next one is reported.
+    mutable TrajectoryCompressor m_compressor;
+    mutable SimTK::State m_lastState;
+
+    // The file to which the states are written, if any; see setOutputFile().
+    struct FileSink {
+        std::string fileName;
+        std::shared_ptr<CompactStatesFileWriter> writer;
+    };
+    mutable SimTK::ResetOnCopy<FileSink> m_fileSink;
 };
 
 } // namespace
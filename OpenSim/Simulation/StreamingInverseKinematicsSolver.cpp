@@ -0,0 +1,195 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  StreamingInverseKinematicsSolver.cpp                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingInverseKinematicsSolver.h"
+#include "InverseKinematicsSolver.h"
+#include "MarkersReference.h"
+#include "OrientationsReference.h"
+#include "Model/Model.h"
+
+using namespace std;
+
+namespace OpenSim {
+
+// A MarkersReference whose values are the last frame pushed, rather than
+// the row of a table nearest to the time.
+class StreamingInverseKinematicsSolver::StreamedMarkersReference
+        : public MarkersReference {
+    OpenSim_DECLARE_CONCRETE_OBJECT(StreamedMarkersReference,
+                                    MarkersReference);
+public:
+    StreamedMarkersReference(const TimeSeriesTable_<SimTK::Vec3>& names,
+                             const Set<MarkerWeight>* markerWeights,
+                             const SimTK::Array_<SimTK::Vec3>& frame)
+        : MarkersReference(names, markerWeights), _frame(&frame) {}
+
+    void getValues(const SimTK::State&,
+                   SimTK::Array_<SimTK::Vec3>& values) const override
+    {
+        // Copy element-wise so that values keeps its storage.
+        values.resize(_frame->size());
+        for (unsigned i = 0; i < _frame->size(); ++i)
+            values[i] = (*_frame)[i];
+    }
+
+private:
+    const SimTK::Array_<SimTK::Vec3>* _frame;
+};
+
+// An OrientationsReference whose values are the last frame pushed, rather
+// than the row of a table nearest to the time.
+class StreamingInverseKinematicsSolver::StreamedOrientationsReference
+        : public OrientationsReference {
+    OpenSim_DECLARE_CONCRETE_OBJECT(StreamedOrientationsReference,
+                                    OrientationsReference);
+public:
+    StreamedOrientationsReference(
+            const TimeSeriesTable_<SimTK::Quaternion>& names,
+            const SimTK::Array_<SimTK::Rotation>& frame)
+        : OrientationsReference(names), _frame(&frame) {}
+
+    void getValues(const SimTK::State&,
+                   SimTK::Array_<SimTK::Rotation>& values) const override
+    {
+        values.resize(_frame->size());
+        for (unsigned i = 0; i < _frame->size(); ++i)
+            values[i] = (*_frame)[i];
+    }
+
+private:
+    const SimTK::Array_<SimTK::Rotation>* _frame;
+};
+
+StreamingInverseKinematicsSolver::StreamingInverseKinematicsSolver(
+        const Model& model, const vector<string>& markerNames,
+        const Set<MarkerWeight>* markerWeights,
+        const vector<string>& orientationSensorFrames,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight) :
+    _model(&model),
+    _markers(unsigned(markerNames.size()), SimTK::Vec3(SimTK::NaN)),
+    _coordinateReferences(coordinateReferences)
+{
+    // An unobserved orientation is NaN.
+    SimTK::Rotation unobserved;
+    unobserved.setRotationToNaN();
+    _orientations.resize(unsigned(orientationSensorFrames.size()),
+                         unobserved);
+
+    for (const auto& path : orientationSensorFrames) {
+        OPENSIM_THROW_IF(!model.hasComponent<PhysicalFrame>(path), Exception,
+            "StreamingInverseKinematicsSolver: Model has no PhysicalFrame '"
+            + path + "' for an orientation sensor.");
+    }
+
+    // The reference only needs the table for the names of the markers.
+    TimeSeriesTable_<SimTK::Vec3> names;
+    names.setColumnLabels(markerNames);
+    names.appendRow(0.0, SimTK::RowVector_<SimTK::Vec3>(
+            int(markerNames.size()), SimTK::Vec3(SimTK::NaN)));
+    _markersReference.reset(
+            new StreamedMarkersReference(names, markerWeights, _markers));
+    if (orientationSensorFrames.empty()) {
+        _solver.reset(new InverseKinematicsSolver(model, *_markersReference,
+                _coordinateReferences, constraintWeight));
+    } else {
+        TimeSeriesTable_<SimTK::Quaternion> frames;
+        frames.setColumnLabels(orientationSensorFrames);
+        frames.appendRow(0.0, SimTK::RowVector_<SimTK::Quaternion>(
+                int(orientationSensorFrames.size()), SimTK::Quaternion()));
+        _orientationsReference.reset(
+                new StreamedOrientationsReference(frames, _orientations));
+        _solver.reset(new InverseKinematicsSolver(model, *_markersReference,
+                *_orientationsReference, _coordinateReferences,
+                constraintWeight));
+    }
+    _state = model.getWorkingState();
+}
+
+StreamingInverseKinematicsSolver::~StreamingInverseKinematicsSolver() = default;
+
+void StreamingInverseKinematicsSolver::setAccuracy(double accuracy)
+{
+    _solver->setAccuracy(accuracy);
+    // The Assembler was discarded, so the next frame must be assembled.
+    _numFramesSolved = 0;
+}
+
+void StreamingInverseKinematicsSolver::setOrientationSensorWeight(double weight)
+{
+    if (_orientationsReference) _orientationsReference->setDefaultWeight(weight);
+}
+
+void StreamingInverseKinematicsSolver::setTrackingPredictionOrder(int order)
+{
+    _solver->setTrackingPredictionOrder(order);
+}
+
+const SimTK::Vector& StreamingInverseKinematicsSolver::pushFrame(double time,
+        const SimTK::Array_<SimTK::Vec3>& markers)
+{
+    OPENSIM_THROW_IF(!_orientations.empty(), Exception,
+        "StreamingInverseKinematicsSolver::pushFrame(): Expected "
+        "observations of " + std::to_string(_orientations.size()) +
+        " orientation sensors.");
+    return pushFrame(time, markers, _orientations);
+}
+
+const SimTK::Vector& StreamingInverseKinematicsSolver::pushFrame(double time,
+        const SimTK::Array_<SimTK::Vec3>& markers,
+        const SimTK::Array_<SimTK::Rotation>& orientations)
+{
+    OPENSIM_THROW_IF(markers.size() != _markers.size(), Exception,
+        "StreamingInverseKinematicsSolver::pushFrame(): Expected " +
+        std::to_string(_markers.size()) + " marker locations but got " +
+        std::to_string(markers.size()) + ".");
+    OPENSIM_THROW_IF(orientations.size() != _orientations.size(), Exception,
+        "StreamingInverseKinematicsSolver::pushFrame(): Expected " +
+        std::to_string(_orientations.size()) + " orientations but got " +
+        std::to_string(orientations.size()) + ".");
+
+    for (unsigned i = 0; i < markers.size(); ++i) _markers[i] = markers[i];
+    if (&orientations != &_orientations) {
+        for (unsigned i = 0; i < orientations.size(); ++i)
+            _orientations[i] = orientations[i];
+    }
+
+    _state.updTime() = time;
+    if (_numFramesSolved == 0) _solver->assemble(_state);
+    else _solver->track(_state);
+    ++_numFramesSolved;
+    return _state.getQ();
+}
+
+void StreamingInverseKinematicsSolver::reset()
+{
+    _state = _model->getWorkingState();
+    _numFramesSolved = 0;
+}
+
+InverseKinematicsSolver& StreamingInverseKinematicsSolver::updSolver()
+{
+    return *_solver;
+}
+
+} // end of namespace OpenSim
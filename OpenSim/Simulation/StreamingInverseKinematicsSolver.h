@@ -0,0 +1,158 @@
+#ifndef OPENSIM_STREAMING_INVERSE_KINEMATICS_SOLVER_H_
+#define OPENSIM_STREAMING_INVERSE_KINEMATICS_SOLVER_H_
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  StreamingInverseKinematicsSolver.h                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CoordinateReference.h"
+#include <OpenSim/Common/Set.h>
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon/internal/ReferencePtr.h>
+#include <SimTKcommon/internal/Rotation.h>
+#include <SimTKcommon/internal/State.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class InverseKinematicsSolver;
+class MarkerWeight;
+class Model;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Solve inverse kinematics one frame at a time, as the observations arrive
+ * (e.g., from a live motion capture system), rather than from a complete
+ * MarkersReference. Each frame of marker locations (and, optionally, of
+ * orientation sensor observations, e.g., from IMUs) is pushed with
+ * pushFrame(), which returns the model's coordinates for that frame.
+ *
+ * The same InverseKinematicsSolver and SimTK::Assembler are used for every
+ * frame: the first frame is assembled, and every later frame is tracked from
+ * the previous solution (see AssemblySolver::setTrackingPredictionOrder() to
+ * extrapolate the initial guess instead). The observations are copied into
+ * buffers sized when the solver is constructed.
+ *
+ * A marker or orientation observation that is not available in a frame
+ * should be NaN; its goal is ignored for that frame.
+ *
+ * @code
+ * StreamingInverseKinematicsSolver ik(model, {"R.ASIS", "L.ASIS", ...});
+ * SimTK::Array_<SimTK::Vec3> markers(ik.getNumMarkers());
+ * while (receiveFrame(time, markers)) {
+ *     const SimTK::Vector& q = ik.pushFrame(time, markers);
+ *     // ...
+ * }
+ * @endcode
+ */
+class OSIMSIMULATION_API StreamingInverseKinematicsSolver
+{
+public:
+    /** The model must have been initialized (see Model::initSystem()); its
+    working state is the initial guess for the first frame. The model is not
+    modified, and must outlive this solver.
+    @param model            The model whose coordinates are solved for.
+    @param markerNames      Names of the markers, in the order of the marker
+                            locations passed to pushFrame(). Markers that are
+                            not in the model are ignored, but at least one
+                            must be in the model.
+    @param markerWeights    Weights of the markers, by name (optional).
+    @param orientationSensorFrames  Paths of the PhysicalFrame%s whose
+                            orientations in ground are observed, in the order
+                            of the orientations passed to pushFrame().
+    @param coordinateReferences  Desired coordinate values (optional).
+    @param constraintWeight Weight of the model's constraints; see
+                            AssemblySolver. */
+    StreamingInverseKinematicsSolver(const Model& model,
+        const std::vector<std::string>& markerNames,
+        const Set<MarkerWeight>* markerWeights = nullptr,
+        const std::vector<std::string>& orientationSensorFrames = {},
+        const SimTK::Array_<CoordinateReference>& coordinateReferences = {},
+        double constraintWeight = SimTK::Infinity);
+    ~StreamingInverseKinematicsSolver();
+
+    StreamingInverseKinematicsSolver(
+            const StreamingInverseKinematicsSolver&) = delete;
+    void operator=(const StreamingInverseKinematicsSolver&) = delete;
+
+    int getNumMarkers() const { return int(_markers.size()); }
+    int getNumOrientationSensors() const { return int(_orientations.size()); }
+
+    /** %Set the accuracy of the solution (see AssemblySolver::setAccuracy());
+    the next frame is assembled rather than tracked. */
+    void setAccuracy(double accuracy);
+    /** See AssemblySolver::setTrackingPredictionOrder(). */
+    void setTrackingPredictionOrder(int order);
+    /** Weight of all the orientation sensors (default: 1). Takes effect when
+    the next frame is assembled, i.e., on the first frame or after reset(). */
+    void setOrientationSensorWeight(double weight);
+
+    /** Solve for the coordinates that best match the given marker locations
+    (in ground, in the order of the marker names) at the given time, and
+    return the generalized coordinates (q) of the solution.
+    @throws Exception If the number of markers is not getNumMarkers(), or
+            orientation sensors are observed. */
+    const SimTK::Vector& pushFrame(double time,
+                                   const SimTK::Array_<SimTK::Vec3>& markers);
+    /** Solve for the coordinates that best match the given marker locations
+    and orientation sensor observations (the orientations of the sensors'
+    frames in ground).
+    @throws Exception If the number of markers is not getNumMarkers(), or
+            the number of orientations is not getNumOrientationSensors(). */
+    const SimTK::Vector& pushFrame(double time,
+        const SimTK::Array_<SimTK::Vec3>& markers,
+        const SimTK::Array_<SimTK::Rotation>& orientations);
+
+    /** Assemble the next frame from the model's working state, rather than
+    tracking it from the last solution (e.g., after a gap in the stream). */
+    void reset();
+
+    /** The number of frames solved since construction or the last reset(). */
+    int getNumFramesSolved() const { return _numFramesSolved; }
+    /** The state holding the solution of the last frame. */
+    const SimTK::State& getState() const { return _state; }
+    /** The underlying solver, e.g., to compute the marker errors of the last
+    frame. */
+    InverseKinematicsSolver& updSolver();
+
+private:
+    class StreamedMarkersReference;
+    class StreamedOrientationsReference;
+
+    SimTK::ReferencePtr<const Model> _model;
+    SimTK::Array_<SimTK::Vec3> _markers;
+    SimTK::Array_<SimTK::Rotation> _orientations;
+    SimTK::Array_<CoordinateReference> _coordinateReferences;
+    std::unique_ptr<StreamedMarkersReference> _markersReference;
+    std::unique_ptr<StreamedOrientationsReference> _orientationsReference;
+    std::unique_ptr<InverseKinematicsSolver> _solver;
+    SimTK::State _state;
+    int _numFramesSolved = 0;
+
+};  // END of class StreamingInverseKinematicsSolver
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_STREAMING_INVERSE_KINEMATICS_SOLVER_H_
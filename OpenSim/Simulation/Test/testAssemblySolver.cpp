@@ -38,6 +38,12 @@ using namespace std;
 void instrumentSetStateValues(const string& modelFile);
 void testAssembleModelWithConstraints(string modelFile);
 void testAssemblySatisfiesConstraints(string modelFile);
+// Reassembling with the goals of the last assembly gives the same solution
+// as assembling from scratch.
+void testReassemble(string modelFile);
+// Setting many coordinates at once assembles the model once, at the end.
+void testSetCoordinateValues(const string& modelFile,
+                             const string& constrainedModelFile);
 double calcLigamentLengthError(const SimTK::State &s, const Model &model);
 
 int main()
@@ -50,6 +56,9 @@ int main()
         //       plus explicit Model::assemble() after model.setStateVariableValues()
         instrumentSetStateValues("PushUpToesOnGroundLessPreciseConstraints.osim");
         testAssemblySatisfiesConstraints("knee_patella_ligament.osim");
+        testReassemble("knee_patella_ligament.osim");
+        testSetCoordinateValues("arm26.osim",
+                                "PushUpToesOnGroundExactConstraints.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundExactConstraints.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundLessPreciseConstraints.osim");
         testAssembleModelWithConstraints("PushUpToesOnGroundWithMuscles.osim");
@@ -342,6 +351,47 @@ void testAssemblySatisfiesConstraints(string modelFile)
     }
 }
 
+void testReassemble(string modelFile)
+{
+    Model model(modelFile);
+    model.set_assembly_accuracy(1e-8);
+    SimTK::State& state = model.initSystem();
+    const Coordinate& knee = model.getCoordinateSet()[0];
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coordRefs.push_back(CoordinateReference(knee.getName(),
+                                            Constant(knee.getValue(state))));
+    AssemblySolver full(model, coordRefs);
+    AssemblySolver warm(model, coordRefs);
+    full.setAccuracy(model.get_assembly_accuracy());
+    warm.setAccuracy(model.get_assembly_accuracy());
+
+    const int N = 10;
+    for (int i = 0; i < N; ++i) {
+        const double kneeAngle = -2*SimTK::Pi/3 + i*SimTK::Pi/(2*N);
+        const double weight = (i % 2) ? 1.0 : 10.0;
+        full.updateCoordinateReference(knee.getName(), kneeAngle, weight);
+        warm.updateCoordinateReference(knee.getName(), kneeAngle, weight);
+
+        SimTK::State fullState = state;
+        full.assemble(fullState);
+        SimTK::State warmState = state;
+        if (i == 0) warm.assemble(warmState);
+        else warm.reassemble(warmState);
+
+        for (int j = 0; j < state.getNQ(); ++j) {
+            ASSERT_EQUAL(fullState.getQ()[j], warmState.getQ()[j], 1e-6,
+                __FILE__, __LINE__,
+                "reassemble() differs from assemble() at q" + to_string(j));
+        }
+        model.realizePosition(warmState);
+        ASSERT_EQUAL(0.0, calcLigamentLengthError(warmState, model),
+            model.get_assembly_accuracy(), __FILE__, __LINE__,
+            "Constraints NOT satisfied by reassemble()");
+    }
+    cout << "testReassemble passed" << endl;
+}
+
 double calcLigamentLengthError(const SimTK::State &s, const Model &model)
 {
     using namespace SimTK;
@@ -367,3 +417,61 @@ double calcLigamentLengthError(const SimTK::State &s, const Model &model)
 
     return error;
 }
+
+void testSetCoordinateValues(const string& modelFile,
+                             const string& constrainedModelFile)
+{
+    using namespace SimTK;
+
+    // Without constraints, the values are set as given.
+    {
+        Model model(modelFile);
+        State& s = model.initSystem();
+        const CoordinateSet& coords = model.getCoordinateSet();
+        std::vector<std::string> names;
+        std::vector<int> indices;
+        Vector values(coords.getSize());
+        for (int i = 0; i < coords.getSize(); ++i) {
+            names.push_back(coords[i].getName());
+            indices.push_back(coords.getSize() - 1 - i);
+            values[i] = 0.1 * (i + 1);
+        }
+        model.setCoordinateValues(s, names, values);
+        ASSERT(s.getSystemStage() >= Stage::Position);
+        for (int i = 0; i < coords.getSize(); ++i)
+            ASSERT(coords[i].getValue(s) == values[i]);
+
+        model.setCoordinateValues(s, indices, values, false);
+        for (int i = 0; i < coords.getSize(); ++i)
+            ASSERT(coords[indices[i]].getValue(s) == values[i]);
+
+        ASSERT_THROW(OpenSim::Exception,
+                model.setCoordinateValues(s,
+                        std::vector<std::string>{"not_a_coord"},
+                        Vector(1, 0.0)));
+        ASSERT_THROW(OpenSim::Exception,
+                model.setCoordinateValues(s, names, Vector(1, 0.0)));
+        ASSERT_THROW(OpenSim::Exception,
+                model.setCoordinateValues(s,
+                        std::vector<int>{coords.getSize()},
+                        Vector(1, 0.0)));
+    }
+
+    // With constraints, the pose satisfies them.
+    {
+        Model model(constrainedModelFile);
+        State& s = model.initSystem();
+        const CoordinateSet& coords = model.getCoordinateSet();
+        std::vector<int> indices;
+        Vector values(coords.getSize());
+        for (int i = 0; i < coords.getSize(); ++i) {
+            indices.push_back(i);
+            values[i] = coords[i].getValue(s) + 0.01;
+        }
+        model.setCoordinateValues(s, indices, values);
+        model.getMultibodySystem().realize(s, Stage::Position);
+        ASSERT_EQUAL(0.0, s.getQErr().normInf(), 1e-5,
+            __FILE__, __LINE__, "Constraints NOT satisfied after "
+            "Model::setCoordinateValues()");
+    }
+}
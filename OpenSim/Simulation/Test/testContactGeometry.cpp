@@ -45,6 +45,8 @@
 #include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
 #include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/ModelVisualizer.h>
+#include <OpenSim/Simulation/Model/SphereHalfSpaceContactForce.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
@@ -77,6 +79,8 @@ int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh
 void compareHertzAndMeshContactResults();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
+void testDecorationCache();
+void testSphereHalfSpaceContactForce();
 
 int main()
 {
@@ -97,6 +101,9 @@ int main()
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
+
+        testDecorationCache();
+        testSphereHalfSpaceContactForce();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -598,20 +605,106 @@ void testIntermediateFrames() {
     SimTK_TEST_EQ_TOL(stateWeld.getY(), stateIntermedFrameXY.getY(), 1e-10);
 }
 
+// The decoration generator of the ModelVisualizer generates the same dynamic
+// geometry as the model, reusing the contact geometry until the display hints
+// change.
+void testDecorationCache()
+{
+    Model model("BouncingBall_HuntCrossley.osim");
+    SimTK::State& s = model.initSystem();
+    SimTK::DefaultGeometry decoGen(model);
+
+    for (double height : {1.0, 0.5}) {
+        model.getCoordinateSet().get("ball_ty").setValue(s, height);
+        model.realizeVelocity(s);
+        SimTK::Array_<SimTK::DecorativeGeometry> expected, cached;
+        model.generateDecorations(false, model.getDisplayHints(), s,
+                                  expected);
+        decoGen.generateDecorations(s, cached);
+        ASSERT(cached.size() == expected.size());
+    }
 
+    // The floor and the sphere are no longer drawn.
+    SimTK::Array_<SimTK::DecorativeGeometry> withContact, withoutContact;
+    decoGen.generateDecorations(s, withContact);
+    model.updDisplayHints().set_show_contact_geometry(false);
+    decoGen.generateDecorations(s, withoutContact);
+    ASSERT(withoutContact.size() + 2 == withContact.size());
+}
 
+// A SphereHalfSpaceContactForce applies the same forces as a
+// HuntCrossleyForce with the same parameters, to spheres that slide, spin and
+// sink into the floor.
+void testSphereHalfSpaceContactForce()
+{
+    const double sphereRadius = 0.05;
+    const Vec3 locations[] = {Vec3(0.1, 0, 0), Vec3(-0.1, 0, 0),
+                              Vec3(0, 0, 0.1), Vec3(0, 0.2, 0)};
+    const int numSpheres = 4;
+
+    auto buildModel = [&](bool useSphereHalfSpace) {
+        Model* model = new Model();
+        auto* foot = new OpenSim::Body("foot", mass, Vec3(0), Inertia(0.1));
+        model->addBody(foot);
+        model->addJoint(new FreeJoint("free", model->getGround(), *foot));
+        model->addContactGeometry(new ContactHalfSpace(Vec3(0),
+                Vec3(0, 0, -0.5*SimTK_PI), model->getGround(), "floor"));
+        for (int i = 0; i < numSpheres; ++i) {
+            model->addContactGeometry(new ContactSphere(sphereRadius,
+                    locations[i], *foot, "sphere" + std::to_string(i)));
+        }
 
+        // Parameters per sphere, and for the floor.
+        HuntCrossleyForce::ContactParametersSet parameters;
+        auto* contact = new OpenSim::HuntCrossleyForce::ContactParameters(
+                2e6, 0.5, 0.9, 0.6, 0.2);
+        contact->addGeometry("floor");
+        parameters.adoptAndAppend(contact);
+        for (int i = 0; i < numSpheres; ++i) {
+            contact = new OpenSim::HuntCrossleyForce::ContactParameters(
+                    1e6*(1 + i), 1.0 - 0.2*i, 0.8, 0.5, 0.1*i);
+            contact->addGeometry("sphere" + std::to_string(i));
+            parameters.adoptAndAppend(contact);
+        }
+        if (useSphereHalfSpace) {
+            auto* force = new SphereHalfSpaceContactForce("floor");
+            force->upd_contact_parameters() = parameters;
+            model->addForce(force);
+        } else {
+            auto* force = new OpenSim::HuntCrossleyForce();
+            force->upd_contact_parameters() = parameters;
+            model->addForce(force);
+        }
+        model->setGravity(gravity_vec);
+        return std::unique_ptr<Model>(model);
+    };
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+    auto reference = buildModel(false);
+    auto model = buildModel(true);
+    SimTK::State& sRef = reference->initSystem();
+    SimTK::State& s = model->initSystem();
+    const auto& force = dynamic_cast<const SphereHalfSpaceContactForce&>(
+            model->getForceSet()[0]);
+    ASSERT(force.getNumSpheres() == numSpheres);
+
+    for (const double height : {0.046, 0.049, 0.06}) {
+        for (SimTK::State* state : {&sRef, &s}) {
+            state->updQ() = Vector(6, 0.0);
+            state->updQ()[0] = 0.02;
+            state->updQ()[4] = height;
+            state->updU()[1] = 0.5;
+            state->updU()[3] = 0.3;
+            state->updU()[4] = -0.2;
+        }
+        reference->realizeAcceleration(sRef);
+        model->realizeAcceleration(s);
+        SimTK_TEST_EQ_TOL(sRef.getUDot(), s.getUDot(), 1e-7);
+
+        // Only the spheres that sink into the floor are pushed.
+        const Vector_<Vec3> forces = force.calcContactForces(s);
+        ASSERT(forces.size() == numSpheres);
+        ASSERT(forces[3] == Vec3(0));
+        for (int i = 0; i < 3; ++i)
+            ASSERT((forces[i][1] > 0) == (height < sphereRadius));
+    }
+}
@@ -38,7 +38,10 @@
 //
 //==============================================================================
 #include <ctime>  // clock(), clock_t, CLOCKS_PER_SEC
+#include <map>
 #include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Simulation/Model/CompiledLeptonExpression.h>
+#include <OpenSim/Simulation/Model/PointForceDirection.h>
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "SimTKcommon/internal/Xml.h"
@@ -67,6 +70,11 @@ void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
 void testSerializeDeserialize();
+void testParallelForces();
+void testPrecomputePaths();
+void testPointForceDirections();
+void testForceReporterCachedForces();
+void testConditionalPathPointUpdates();
 
 int main()
 {
@@ -155,6 +163,36 @@ int main()
         failures.push_back("testSerializeDeserialize");
     }
 
+    try { testParallelForces(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testParallelForces");
+    }
+
+    try { testPrecomputePaths(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testPrecomputePaths");
+    }
+
+    try { testPointForceDirections(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testPointForceDirections");
+    }
+
+    try { testForceReporterCachedForces(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testForceReporterCachedForces");
+    }
+
+    try { testConditionalPathPointUpdates(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testConditionalPathPointUpdates");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -263,6 +301,40 @@ void testExpressionBasedCoordinateForce()
 
     ASSERT(*copyOfSpring == spring);
 
+    // A copy of the model evaluates its own copy of the compiled expression.
+    Model copyOfModel(osimModel);
+    SimTK::State& copyState = copyOfModel.initSystem();
+    auto& copiedCoord = copyOfModel.updCoordinateSet().get("ball_h");
+    copiedCoord.setValue(copyState, 0.3);
+    copiedCoord.setSpeedValue(copyState, -0.2);
+    copyOfModel.realizeVelocity(copyState);
+    const auto& copiedSpring =
+        dynamic_cast<const ExpressionBasedCoordinateForce&>(
+            copyOfModel.getForceSet().get(0));
+    ASSERT_EQUAL(-10*0.3 - 5*(-0.2),
+                 copiedSpring.calcExpressionForce(copyState), 1e-15);
+
+    // Expressions may only use the variables of the force.
+    const double vars[] = {2.0, 3.0};
+    ASSERT_EQUAL(-17.0,
+        CompiledLeptonExpression("-4*q-3*qdot", {"q", "qdot"}).evaluate(vars),
+        1e-15);
+    ASSERT_THROW(OpenSim::Exception,
+                 CompiledLeptonExpression("-10*x", {"q", "qdot"}));
+
+    // Sweeping the force over many coordinate values and speeds.
+    SimTK::Vector qs(100), qdots(100);
+    for (int i = 0; i < qs.size(); ++i) {
+        qs[i] = 0.01*i;
+        qdots[i] = 1 - 0.03*i;
+    }
+    const SimTK::Vector forces = copiedSpring.calcExpressionForces(qs, qdots);
+    ASSERT(forces.size() == qs.size());
+    for (int i = 0; i < qs.size(); ++i)
+        ASSERT_EQUAL(-10*qs[i] - 5*qdots[i], forces[i], 1e-12);
+    ASSERT_THROW(OpenSim::Exception,
+                 copiedSpring.calcExpressionForces(qs, SimTK::Vector(3)));
+
     osimModel.print("ExpressionBasedCoordinateForceModel.osim");
 
     osimModel.disownAllComponents();
@@ -1117,6 +1189,34 @@ void testExpressionBasedBushingForceRotational()
     ExpressionBasedBushingForce *copyOfSpring = spring.clone();
 
     ASSERT(*copyOfSpring == spring);
+
+    // calcStiffnessForce() evaluates the six expressions as one program,
+    // which must agree with evaluating them one at a time.
+    const Vec6 deflection = spring.computeDeflection(osim_state);
+    ASSERT_EQUAL(spring.calcStiffnessForces(Vector_<Vec6>(1, deflection))[0],
+                 spring.calcStiffnessForce(osim_state), 1e-12);
+
+    // A fused program evaluates the subexpressions its expressions share
+    // once.
+    const std::vector<std::string> expressions =
+        {"-k*sin(q)", "-k*sin(q)*cos(q)", "2*sin(q)+q^3", "1.5"};
+    const std::vector<std::string> variables = {"q", "k"};
+    FusedLeptonExpression fused(expressions, variables);
+    ASSERT(fused.getNumOutputs() == 4);
+    int numSeparateOperations = 0;
+    for (const auto& expression : expressions)
+        numSeparateOperations += FusedLeptonExpression({expression},
+                                     variables).getNumOperations();
+    ASSERT(fused.getNumOperations() < numSeparateOperations);
+    const double values[] = {0.3, 2.0};
+    double results[4];
+    fused.evaluate(values, results);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQUAL(CompiledLeptonExpression(expressions[i], variables)
+                     .evaluate(values), results[i], 1e-15);
+    }
+    ASSERT_THROW(OpenSim::Exception,
+                 FusedLeptonExpression({"q", "x*q"}, variables));
 }
 
 // Test our wrapping of elastic foundation in OpenSim
@@ -1798,3 +1898,260 @@ void testSerializeDeserialize() {
     std::remove(oldModelFile.c_str());
     std::remove(newModelFile.c_str());
 }
+
+void testParallelForces()
+{
+    using namespace SimTK;
+
+    Model serialModel("arm26.osim");
+    Model parallelModel("arm26.osim");
+    parallelModel.setNumForceThreads(3);
+    ASSERT(parallelModel.getNumForceThreads() == 3);
+    // A disabled muscle must be skipped whether or not computed in parallel.
+    serialModel.updForceSet().get(1).set_appliesForce(false);
+    parallelModel.updForceSet().get(1).set_appliesForce(false);
+
+    Vector udot[2];
+    Model* models[2] = {&serialModel, &parallelModel};
+    for (int m = 0; m < 2; ++m) {
+        Model& model = *models[m];
+        State& s = model.initSystem();
+        model.getCoordinateSet()[1].setValue(s, 0.7);
+        for (int i = 0; i < model.getMuscles().getSize(); ++i)
+            model.getMuscles()[i].setActivation(s, 0.1 + 0.1*i);
+        model.equilibrateMuscles(s);
+        model.realizeVelocity(s);
+        Vector controls(model.getNumControls(), 0.3);
+        model.setControls(s, controls);
+        model.realizeAcceleration(s);
+        udot[m] = s.getUDot();
+    }
+    ASSERT(udot[0].norm() > 0);
+    // The forces are summed in a different order.
+    SimTK_TEST_EQ_TOL(udot[0], udot[1], 1e-10);
+
+    // In deterministic mode, the forces are summed in the same blocks for
+    // any number of threads, including 1.
+    Parallelism::setDeterministic(true);
+    Parallelism::setNumDeterministicBlocks(3);
+    ASSERT(Parallelism::getNumBlocks(10, 1) == 3);
+    ASSERT(Parallelism::getNumBlocks(10, 16, 5) == 2);
+    std::vector<Vector> deterministicUDot;
+    for (int numThreads : {1, 2, 4}) {
+        Model model("arm26.osim");
+        model.setNumForceThreads(numThreads);
+        ASSERT(model.getComputesForcesInBlocks());
+        State& s = model.initSystem();
+        model.getCoordinateSet()[1].setValue(s, 0.7);
+        for (int i = 0; i < model.getMuscles().getSize(); ++i)
+            model.getMuscles()[i].setActivation(s, 0.1 + 0.1*i);
+        model.equilibrateMuscles(s);
+        model.realizeVelocity(s);
+        model.setControls(s, Vector(model.getNumControls(), 0.3));
+        model.realizeAcceleration(s);
+        deterministicUDot.push_back(s.getUDot());
+    }
+    Parallelism::setDeterministic(false);
+    Parallelism::setNumDeterministicBlocks(8);
+    for (const Vector& other : deterministicUDot)
+        for (int i = 0; i < other.size(); ++i)
+            ASSERT(other[i] == deterministicUDot[0][i]);
+    SimTK_TEST_EQ_TOL(udot[0], deterministicUDot[0], 1e-10);
+    ASSERT_THROW(OpenSim::Exception,
+                 Parallelism::setNumDeterministicBlocks(0));
+
+    cout << "testParallelForces passed." << endl;
+}
+
+void testPrecomputePaths()
+{
+    using namespace SimTK;
+
+    Model model("arm26.osim");
+    model.setNumForceThreads(3);
+    model.setPrecomputePaths(true);
+    // The path of a disabled muscle is not precomputed.
+    model.updForceSet().get(1).set_appliesForce(false);
+    State& s = model.initSystem();
+    model.getCoordinateSet()[1].setValue(s, 0.7);
+
+    ComponentProfiler::setEnabled(true);
+    model.realizePosition(s);
+    ComponentProfiler::setEnabled(false);
+    std::map<std::string, unsigned long long> pathComputations;
+    for (const auto& record : ComponentProfiler::getSummary(model))
+        if (record.operation == ComponentProfiler::ComputePath)
+            pathComputations[record.componentPath] = record.count;
+    ComponentProfiler::reset(model);
+
+    Model serialModel("arm26.osim");
+    State& serialState = serialModel.initSystem();
+    serialModel.getCoordinateSet()[1].setValue(serialState, 0.7);
+    for (int i = 0; i < model.getMuscles().getSize(); ++i) {
+        const GeometryPath& path = model.getMuscles()[i].getGeometryPath();
+        const auto it = pathComputations.find(path.getAbsolutePathString());
+        const unsigned long long count =
+            it == pathComputations.end() ? 0 : it->second;
+        ASSERT(count == (model.getMuscles()[i].appliesForce(s) ? 1u : 0u));
+        ASSERT_EQUAL(path.getLength(s), serialModel.getMuscles()[i]
+                .getGeometryPath().getLength(serialState), 1e-14);
+    }
+
+    cout << "testPrecomputePaths passed." << endl;
+}
+
+void testPointForceDirections()
+{
+    using namespace SimTK;
+
+    Model model;
+    auto* block = new OpenSim::Body("block", 1.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *block, Vec3(0), Vec3(0));
+    model.addBody(block);
+    model.addJoint(slider);
+    auto* spring = new PathSpring("spring", 0.5, 10.0, 0.1);
+    GeometryPath& path = spring->updGeometryPath();
+    path.appendNewPathPoint("origin", model.getGround(), Vec3(-1, 0, 0));
+    path.appendNewPathPoint("via", model.getGround(), Vec3(-0.5, 0.2, 0));
+    path.appendNewPathPoint("insertion", *block, Vec3(0.1, 0, 0));
+    model.addForce(spring);
+
+    State& s = model.initSystem();
+    model.realizeVelocity(s);
+
+    Array<PointForceDirection*> heapPFDs;
+    spring->getGeometryPath().getPointForceDirections(s, &heapPFDs);
+    std::vector<PointForceDirection> pfds;
+    spring->getGeometryPath().getPointForceDirections(s, pfds);
+    ASSERT(int(pfds.size()) == heapPFDs.getSize());
+    ASSERT(pfds.size() == 3);
+    for (int i = 0; i < heapPFDs.getSize(); ++i) {
+        ASSERT(&pfds[i].frame() == &heapPFDs[i]->frame());
+        ASSERT_EQUAL(heapPFDs[i]->point(), pfds[i].point(), SimTK::Eps);
+        ASSERT_EQUAL(heapPFDs[i]->direction(), pfds[i].direction(),
+                     SimTK::Eps);
+        delete heapPFDs[i];
+    }
+    // The directions at the ends point along the path.
+    ASSERT_EQUAL(1.0, pfds[0].direction().norm(), SimTK::SqrtEps);
+
+    // The storage of the vector is reused.
+    const PointForceDirection* data = pfds.data();
+    slider->getCoordinate().setValue(s, 0.3);
+    model.realizeVelocity(s);
+    spring->getGeometryPath().getPointForceDirections(s, pfds);
+    ASSERT(pfds.size() == 3);
+    ASSERT(pfds.data() == data);
+
+    cout << "testPointForceDirections passed." << endl;
+}
+
+void testForceReporterCachedForces()
+{
+    using namespace SimTK;
+
+    Model model;
+    model.setGravity(gravity_vec);
+    auto* block = new OpenSim::Body("block", 1.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *block, Vec3(0), Vec3(0));
+    model.addBody(block);
+    model.addJoint(slider);
+    auto* spring = new PathSpring("spring", 0.5, 10.0, 0.1);
+    spring->updGeometryPath().appendNewPathPoint("origin", model.getGround(),
+                                                 Vec3(-1, 0, 0));
+    spring->updGeometryPath().appendNewPathPoint("insertion", *block,
+                                                 Vec3(0.1, 0, 0));
+    model.addForce(spring);
+    model.addForce(new PointToPointSpring(model.getGround(), Vec3(0, 1, 0),
+                                          *block, Vec3(0), 20.0, 0.5));
+    auto* actuator = new PathActuator();
+    actuator->setName("actuator");
+    actuator->addNewPathPoint("origin", model.getGround(), Vec3(1, 0, 0));
+    actuator->addNewPathPoint("insertion", *block, Vec3(0));
+    model.addForce(actuator);
+    auto* controller = new PrescribedController();
+    controller->addActuator(*actuator);
+    controller->prescribeControlForActuator("actuator", new Constant(0.3));
+    model.addController(controller);
+
+    // One reporter reads the cached forces into its row; the other collects
+    // an Array from each force.
+    auto* cached = new ForceReporter(&model);
+    cached->setName("cached");
+    auto* collected = new ForceReporter(&model);
+    collected->setName("collected");
+    collected->setUseCachedForces(false);
+    ASSERT(cached->getUseCachedForces());
+    model.addAnalysis(cached);
+    model.addAnalysis(collected);
+
+    State& s = model.initSystem();
+    RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+    integrator.setAccuracy(1e-6);
+    Manager manager(model, integrator);
+    manager.initialize(s);
+    manager.integrate(0.5);
+
+    const Storage& a = cached->getForceStorage();
+    const Storage& b = collected->getForceStorage();
+    ASSERT(a.getColumnLabels() == b.getColumnLabels());
+    ASSERT(a.getSize() == b.getSize() && a.getSize() > 1);
+    for (int i = 0; i < a.getSize(); ++i) {
+        const StateVector& ra = *a.getStateVector(i);
+        const StateVector& rb = *b.getStateVector(i);
+        ASSERT_EQUAL(rb.getTime(), ra.getTime(), 0.0);
+        ASSERT(ra.getSize() == rb.getSize());
+        for (int j = 0; j < ra.getSize(); ++j)
+            ASSERT_EQUAL(rb.getData()[j], ra.getData()[j], 0.0);
+    }
+
+    cout << "testForceReporterCachedForces passed." << endl;
+}
+
+void testConditionalPathPointUpdates()
+{
+    using namespace SimTK;
+
+    // The via point is in the path only while the block is between 0.1 and
+    // 1; the current path is kept, or rebuilt, as the block moves.
+    Model model;
+    auto* block = new OpenSim::Body("block", 1.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *block, Vec3(0), Vec3(0));
+    model.addBody(block);
+    model.addJoint(slider);
+    auto* spring = new PathSpring("spring", 0.5, 10.0, 0.1);
+    GeometryPath& path = spring->updGeometryPath();
+    path.appendNewPathPoint("origin", model.getGround(), Vec3(-1, 0, 0));
+    auto* via = new ConditionalPathPoint();
+    via->setName("via");
+    via->setParentFrame(model.getGround());
+    via->setLocation(Vec3(-0.5, 0.2, 0));
+    via->setCoordinate(slider->getCoordinate());
+    via->setRangeMin(0.1);
+    via->setRangeMax(1.0);
+    path.updPathPointSet().adoptAndAppend(via);
+    path.appendNewPathPoint("insertion", *block, Vec3(0.1, 0, 0));
+    model.addForce(spring);
+
+    State& s = model.initSystem();
+    const Coordinate& x = slider->getCoordinate();
+    const GeometryPath& p = spring->getGeometryPath();
+    for (double value : { 0.0, 0.05, 0.5, 0.7, 2.0, 0.3 }) {
+        x.setValue(s, value);
+        const bool viaActive = value >= 0.1 && value <= 1.0;
+        const Array<AbstractPathPoint*>& current = p.getCurrentPath(s);
+        ASSERT(current.getSize() == (viaActive ? 3 : 2));
+        ASSERT(current[current.getSize() - 1]->getName() == "insertion");
+        const Vec3 insertion(value + 0.1, 0, 0);
+        const double expected = viaActive
+                ? (Vec3(-0.5, 0.2, 0) - Vec3(-1, 0, 0)).norm() +
+                  (insertion - Vec3(-0.5, 0.2, 0)).norm()
+                : (insertion - Vec3(-1, 0, 0)).norm();
+        ASSERT_EQUAL(expected, p.getLength(s), 1e-12);
+    }
+
+    cout << "testConditionalPathPointUpdates passed." << endl;
+}
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/STOFileAdapter.h>
@@ -65,6 +66,18 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that extrapolating the initial guess of track() from previous
+// solutions, or refining it with Gauss-Newton steps on the marker errors,
+// finds the same solutions in no more iterations.
+void testTrackingPrediction();
+// Verify that solving frames as they are pushed to the streaming solver,
+// from markers with gaps or from orientation sensors, finds the same
+// solutions as tracking a complete MarkersReference.
+void testStreamingInverseKinematics();
+// Verify that the orientations of frames alone, from an OrientationsReference,
+// recover the coordinates that generated them, with or without Gauss-Newton
+// steps, and that columns are matched to frames by path or by name.
+void testOrientationsReference();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
@@ -94,6 +107,21 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
+    try { testTrackingPrediction(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackingPrediction");
+    }
+    try { testStreamingInverseKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStreamingInverseKinematics");
+    }
+    try { testOrientationsReference(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testOrientationsReference");
+    }
 
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
@@ -474,6 +502,227 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testTrackingPrediction()
+{
+    cout << "\ntestInverseKinematicsSolver::testTrackingPrediction()" << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+
+    // a fast swing, sampled coarsely
+    StatesTrajectory states;
+    double dt = 0.02;
+    for (int i = 0; i < 51; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, 1.2*sin(2*SimTK::Pi*i*dt));
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    MarkersReference
+        markersRef(generateMarkerDataFromModelAndStates(*pendulum, states,
+                                                        biases));
+    markersRef.setDefaultWeight(1.0);
+    SimTK::Array_<CoordinateReference> coordRefs;
+
+    // Prediction orders 0, 1 and 2, then Gauss-Newton steps.
+    std::vector<double> values[4];
+    int iterations[4] = { 0, 0, 0, 0 };
+    for (int order = 0; order < 4; ++order) {
+        InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+        ikSolver.setAccuracy(1e-8);
+        if (order < 3) ikSolver.setTrackingPredictionOrder(order);
+        else ikSolver.setUseMarkerJacobianSteps(true);
+        state.updTime() = 0;
+        coord.setValue(state, 0.0);
+        ikSolver.assemble(state);
+        for (unsigned i = 1; i < markersRef.getNumFrames(); ++i) {
+            state.updTime() = i*dt;
+            ikSolver.track(state);
+            values[order].push_back(coord.getValue(state));
+            iterations[order] += ikSolver.getNumIterationsInLastSolve();
+        }
+        cout << (order < 3 ? "prediction order " : "Gauss-Newton steps ")
+             << (order < 3 ? to_string(order) : "") << ": "
+             << iterations[order] << " iterations" << endl;
+    }
+
+    for (int order = 1; order < 4; ++order) {
+        for (size_t i = 0; i < values[0].size(); ++i) {
+            SimTK_ASSERT_ALWAYS(abs(values[order][i] - values[0][i]) <= 1e-6,
+                "Extrapolated guess changed the solution.");
+        }
+        SimTK_ASSERT_ALWAYS(iterations[order] <= iterations[0],
+            "Extrapolated guess took more iterations than the previous "
+            "solution.");
+    }
+
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    SimTK_TEST_MUST_THROW_EXC(ikSolver.setTrackingPredictionOrder(3),
+                              Exception);
+}
+
+void testStreamingInverseKinematics()
+{
+    cout << "\ntestInverseKinematicsSolver::testStreamingInverseKinematics()"
+         << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+    const Body& ball = pendulum->getBodySet().get("ball");
+
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    SimTK::Array_<SimTK::Rotation> orientations;
+    double dt = 0.01;
+    for (int i = 0; i < 51; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, 0.8*sin(2*SimTK::Pi*i*dt));
+        states.append(state);
+        pendulum->realizePosition(state);
+        orientations.push_back(ball.getTransformInGround(state).R());
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    TimeSeriesTable_<SimTK::Vec3> markerData =
+        generateMarkerDataFromModelAndStates(*pendulum, states, biases);
+    MarkersReference markersRef(markerData);
+    markersRef.setDefaultWeight(1.0);
+    SimTK::Array_<CoordinateReference> coordRefs;
+
+    // Solve with the complete reference.
+    std::vector<double> values;
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(1e-8);
+    state = pendulum->getWorkingState();
+    for (unsigned i = 0; i < markersRef.getNumFrames(); ++i) {
+        state.updTime() = i*dt;
+        if (i == 0) ikSolver.assemble(state);
+        else ikSolver.track(state);
+        values.push_back(coord.getValue(state));
+    }
+
+    std::vector<std::string> names(markersRef.getNames().begin(),
+                                   markersRef.getNames().end());
+    // Stream the same markers, with a marker missing from some frames.
+    StreamingInverseKinematicsSolver streaming(*pendulum, names);
+    streaming.setAccuracy(1e-8);
+    SimTK::Array_<SimTK::Vec3> markers(streaming.getNumMarkers());
+    for (int i = 0; i < int(markerData.getNumRows()); ++i) {
+        const auto row = markerData.getRowAtIndex(i);
+        for (int j = 0; j < streaming.getNumMarkers(); ++j)
+            markers[j] = row[j];
+        if (i % 10 == 5) markers[1] = SimTK::Vec3(SimTK::NaN);
+        streaming.pushFrame(i*dt, markers);
+        SimTK_ASSERT_ALWAYS(
+            abs(coord.getValue(streaming.getState()) - values[i]) <= 1e-6,
+            "StreamingInverseKinematicsSolver did not match the solution "
+            "from the complete MarkersReference.");
+    }
+    SimTK_ASSERT_ALWAYS(streaming.getNumFramesSolved() == 51,
+        "StreamingInverseKinematicsSolver miscounted the frames solved.");
+    SimTK_TEST_MUST_THROW_EXC(
+        streaming.pushFrame(1.0, SimTK::Array_<SimTK::Vec3>(1)), Exception);
+
+    // Track the orientation of the ball alone.
+    StreamingInverseKinematicsSolver imuStreaming(*pendulum, names, nullptr,
+        { ball.getAbsolutePathString() });
+    imuStreaming.setAccuracy(1e-8);
+    SimTK::Array_<SimTK::Vec3> unobserved(imuStreaming.getNumMarkers(),
+                                          SimTK::Vec3(SimTK::NaN));
+    for (int i = 0; i < int(orientations.size()); ++i) {
+        imuStreaming.pushFrame(i*dt, unobserved,
+            SimTK::Array_<SimTK::Rotation>(1, orientations[i]));
+        SimTK_ASSERT_ALWAYS(
+            abs(coord.getValue(imuStreaming.getState()) - values[i]) <= 1e-6,
+            "StreamingInverseKinematicsSolver did not track the orientation "
+            "sensor.");
+    }
+    SimTK_TEST_MUST_THROW_EXC(imuStreaming.pushFrame(1.0, unobserved),
+                              Exception);
+}
+
+void testOrientationsReference()
+{
+    cout << "\ntestInverseKinematicsSolver::testOrientationsReference()"
+         << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+    const Body& ball = pendulum->getBodySet().get("ball");
+
+    SimTK::State state = pendulum->initSystem();
+
+    // The ball's orientation, by name, and a frame the model does not have.
+    double dt = 0.005;
+    std::vector<double> times, values;
+    TimeSeriesTable_<SimTK::Quaternion> orientationData;
+    orientationData.setColumnLabels({ "ball", "unknown" });
+    for (int i = 0; i < 101; ++i) {
+        state.updTime() = i*dt;
+        values.push_back(0.8*sin(2*SimTK::Pi*i*dt));
+        coord.setValue(state, values.back());
+        pendulum->realizePosition(state);
+        const SimTK::Quaternion q =
+            ball.getTransformInGround(state).R().convertRotationToQuaternion();
+        orientationData.appendRow(i*dt,
+            SimTK::RowVector_<SimTK::Quaternion>(2, q));
+    }
+
+    OrientationsReference orientationsRef(orientationData);
+    SimTK_TEST(orientationsRef.getNumRefs() == 2);
+    SimTK_TEST(orientationsRef.getNumFrames() == 101);
+
+    // The values are those of the nearest frame.
+    SimTK::Array_<SimTK::Rotation> rotations;
+    state.updTime() = 10.4*dt;
+    orientationsRef.getValues(state, rotations);
+    SimTK_TEST(rotations.size() == 2);
+    SimTK_TEST_EQ_TOL(rotations[0].asMat33(),
+        SimTK::Rotation(orientationData.getRowAtIndex(10)[0]).asMat33(),
+        1e-12);
+
+    MarkersReference noMarkers;
+    SimTK::Array_<CoordinateReference> coordRefs;
+    for (int steps = 0; steps < 2; ++steps) {
+        InverseKinematicsSolver ikSolver(*pendulum, noMarkers,
+                                         orientationsRef, coordRefs);
+        ikSolver.setAccuracy(1e-8);
+        ikSolver.setUseMarkerJacobianSteps(steps == 1);
+        state = pendulum->getWorkingState();
+        for (int i = 0; i < int(values.size()); ++i) {
+            state.updTime() = i*dt;
+            if (i == 0) ikSolver.assemble(state);
+            else ikSolver.track(state);
+            SimTK_TEST_EQ_TOL(coord.getValue(state), values[i], 1e-6);
+        }
+        SimTK_TEST(ikSolver.getNumOrientationSensorsInUse() == 1);
+        SimTK_TEST(ikSolver.getOrientationSensorNameForIndex(0) == "ball");
+        SimTK::Array_<double> errors;
+        ikSolver.computeCurrentOrientationErrors(errors);
+        SimTK_TEST(errors.size() == 1);
+        SimTK_TEST(errors[0] <= 1e-6);
+        SimTK::Array_<SimTK::Rotation> sensed;
+        ikSolver.computeCurrentSensorOrientations(sensed);
+        SimTK_TEST_EQ_TOL(sensed[0].asMat33(),
+            SimTK::Rotation(orientationData.getRowAtIndex(100)[0]).asMat33(),
+            1e-6);
+
+        // Unknown frames have no goal, but may be weighted.
+        ikSolver.updateOrientationWeight("unknown", 2.0);
+        ikSolver.updateOrientationWeights(SimTK::Array_<double>(2, 1.0));
+        SimTK_TEST_MUST_THROW_EXC(
+            ikSolver.updateOrientationWeight(2, 1.0), Exception);
+    }
+
+    // At least one column must be a frame of the model.
+    TimeSeriesTable_<SimTK::Quaternion> unknownData;
+    unknownData.setColumnLabels({ "unknown" });
+    unknownData.appendRow(0.0, SimTK::RowVector_<SimTK::Quaternion>(1));
+    OrientationsReference unknownRef(unknownData);
+    SimTK_TEST_MUST_THROW_EXC(InverseKinematicsSolver(*pendulum, noMarkers,
+                                  unknownRef, coordRefs), Exception);
+}
 
 void testNumberOfMarkersMismatch()
 {
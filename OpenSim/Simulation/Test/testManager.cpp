@@ -36,6 +36,17 @@ Manager Tests:
    arm26 model between subsequent integrations.
 4. testConstructors: Ensure different constructors work as intended.
 5. testSimulate: Ensure the simulate() method works as intended.
+6. testEnsembleManager: Integrate an ensemble of members with different
+   initial states and parameters, some of which fail, in one process and
+   shared by several processes.
+7. testRecordInBackground: Ensure states and Analyses recorded on a background
+   thread are identical to those recorded during integration.
+8. testCheckpointAndRestore: Continue an integration from a checkpoint with a
+   new Manager, and write checkpoints periodically.
+9. testReportInterval: Record uniformly spaced, interpolated States (and
+   Reporter rows) without changing the steps the integrator takes.
+10. testRealTimeStepping: Step in real time, collecting latency statistics
+    and applying the overrun policies.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -43,10 +54,19 @@ Manager Tests:
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/EnsembleManager.h>
+#include <OpenSim/Simulation/Manager/PararealManager.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Analyses/Kinematics.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/PrescribedCoordinatesSimulation.h>
+
+#include <cstdio>
+#include <fstream>
 
 using namespace OpenSim;
 using namespace std;
@@ -55,6 +75,15 @@ void testStateChangesBetweenIntegration();
 void testExcitationUpdatesWithManager();
 void testConstructors();
 void testSimulate();
+void testEnsembleManager();
+void testRecordInBackground();
+void testCheckpointAndRestore();
+void testReportInterval();
+void testRealTimeStepping();
+void testMultirateIntegration();
+void testAutoSelectIntegrator();
+void testPrescribedCoordinates();
+void testPararealManager();
 
 int main()
 {
@@ -90,6 +119,60 @@ int main()
         failures.push_back("testSimulate");
     }
 
+    try { testEnsembleManager(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testEnsembleManager");
+    }
+
+    try { testRecordInBackground(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordInBackground");
+    }
+
+    try { testCheckpointAndRestore(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCheckpointAndRestore");
+    }
+
+    try { testReportInterval(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testReportInterval");
+    }
+
+    try { testRealTimeStepping(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRealTimeStepping");
+    }
+
+    try { testMultirateIntegration(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMultirateIntegration");
+    }
+
+    try { testAutoSelectIntegrator(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testAutoSelectIntegrator");
+    }
+
+    try { testPrescribedCoordinates(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testPrescribedCoordinates");
+    }
+
+    try { testPararealManager(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testPararealManager");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -420,3 +503,564 @@ void testSimulate()
         SimTK_TEST_EQ(s.getTime(), t0);
     }
 }
+
+void testEnsembleManager()
+{
+    cout << "Running testEnsembleManager" << endl;
+
+    using SimTK::Vec3;
+    const double gravity = 9.81;
+    const double mass = 2.;
+
+    // A ball that falls along a slider, pushed up by an actuator whose
+    // (parameter-only) optimal force is varied across the ensemble.
+    Model model;
+    model.setGravity(Vec3(0, -gravity, 0));
+    auto ball = new Body("ball", mass, Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    const Coordinate& ty =
+        freeJoint->getCoordinate(FreeJoint::Coord::TranslationY);
+    auto actu = new CoordinateActuator(ty.getName());
+    actu->setName("lift");
+    actu->setOptimalForce(5.);
+    model.addForce(actu);
+    auto controller = new PrescribedController();
+    controller->addActuator(*actu);
+    controller->prescribeControlForActuator("lift", new Constant(1.));
+    model.addController(controller);
+    model.finalizeConnections();
+    const std::string tyPath = ty.getAbsolutePathString() + "/value";
+
+    const double finalTime = 0.5;
+    std::vector<double> y0s{ 1., 2., 3., 4., 5. };
+    std::vector<double> forces{ 5., 10., 5., 20., 5. };
+
+    EnsembleManager ensemble(model);
+    for (size_t i = 0; i < y0s.size(); ++i) {
+        EnsembleManager::Member member;
+        member.stateVariableValues[tyPath] = y0s[i];
+        if (forces[i] != 5.)
+            member.parameters.push_back({"/forceset/lift", "optimal_force",
+                                         forces[i]});
+        ensemble.addMember(member);
+    }
+    // A state variable that does not exist, and a topology-affecting
+    // property, make their members fail without affecting the others.
+    EnsembleManager::Member badState;
+    badState.stateVariableValues["/jointset/freeJoint/nonexistent"] = 0.;
+    const int badStateIndex = ensemble.addMember(badState);
+    EnsembleManager::Member badParameter;
+    badParameter.parameters.push_back({"/bodyset/ball", "mass", 3.});
+    const int badParameterIndex = ensemble.addMember(badParameter);
+
+    // With one thread, every member runs on the same model copy after the
+    // overrides of the previous members have been undone.
+    for (int numThreads : { 1, 3 }) {
+        ensemble.setNumThreads(numThreads);
+        ensemble.setIntegratorAccuracy(1e-8);
+        const std::vector<TimeSeriesTable> results =
+            ensemble.integrate(0., finalTime);
+        SimTK_TEST(int(results.size()) == ensemble.getNumMembers());
+
+        for (size_t i = 0; i < y0s.size(); ++i) {
+            const TimeSeriesTable& states = results[i];
+            SimTK_TEST(states.getNumRows() > 0);
+            SimTK_TEST_EQ(states.getIndependentColumn().back(), finalTime);
+            const double a = forces[i]/mass - gravity;
+            const double yExpected = y0s[i] + 0.5*a*finalTime*finalTime;
+            SimTK_TEST_EQ_TOL(
+                states.getDependentColumn(tyPath)[states.getNumRows() - 1],
+                yExpected, 1e-6);
+        }
+
+        const std::map<int, std::string>& failures = ensemble.getFailures();
+        SimTK_TEST(failures.size() == 2);
+        SimTK_TEST(failures.count(badStateIndex) == 1);
+        SimTK_TEST(failures.count(badParameterIndex) == 1);
+        SimTK_TEST(results[badStateIndex].getNumRows() == 0);
+        SimTK_TEST(results[badParameterIndex].getNumRows() == 0);
+    }
+
+    // Shared by two processes, each member is written to its own file.
+    const std::string dir = "testManager_ensemble";
+    IO::makeDir(dir);
+    for (int m = 0; m < ensemble.getNumMembers(); ++m)
+        std::remove(EnsembleManager::getMemberFileName(dir, m).c_str());
+    ensemble.setNumThreads(2);
+    // Members 1, 3 and 5 (badState).
+    SimTK_TEST(ensemble.integrateShare(0., finalTime, dir, 1, 2) == 2);
+    SimTK_TEST(ensemble.getFailures().size() == 1);
+    SimTK_TEST(ensemble.getFailures().count(badStateIndex) == 1);
+    // Members 0, 2, 4 and 6 (badParameter).
+    SimTK_TEST(ensemble.integrateShare(0., finalTime, dir, 0, 2) == 3);
+    TimeSeriesTable states(EnsembleManager::getMemberFileName(dir, 3));
+    const double a = forces[3]/mass - gravity;
+    SimTK_TEST_EQ_TOL(
+        states.getDependentColumn(tyPath)[states.getNumRows() - 1],
+        y0s[3] + 0.5*a*finalTime*finalTime, 1e-6);
+    // Submitted again, only the member that failed is integrated.
+    SimTK_TEST(ensemble.integrateShare(0., finalTime, dir, 0, 2) == 0);
+    SimTK_TEST(ensemble.getFailures().size() == 1);
+    SimTK_TEST(ensemble.getFailures().count(badParameterIndex) == 1);
+    SimTK_TEST(!std::ifstream(
+            EnsembleManager::getMemberFileName(dir, badStateIndex)).good());
+    SimTK_TEST_MUST_THROW_EXC(
+            ensemble.integrateShare(0., finalTime, dir, 2, 2), Exception);
+}
+
+void testRecordInBackground()
+{
+    cout << "Running testRecordInBackground" << endl;
+    LoadOpenSimLibrary("osimActuators");
+
+    // Integrate arm26 with states and an Analysis (that realizes the State
+    // to Acceleration) recorded in the foreground, then in the background
+    // with a buffer small enough that integrate() has to wait on it.
+    auto run = [](bool inBackground, Storage& states, Storage& accelerations)
+    {
+        Model arm("arm26.osim");
+        Kinematics* kinematics = new Kinematics(&arm);
+        arm.addAnalysis(kinematics);
+        SimTK::State& state = arm.initSystem();
+        arm.equilibrateMuscles(state);
+
+        Manager manager(arm);
+        manager.setRecordInBackground(inBackground, 4);
+        SimTK_TEST(manager.getRecordInBackground() == inBackground);
+        state.setTime(0);
+        manager.initialize(state);
+        manager.integrate(0.1);
+        // Integrating again continues recording into the same Storage.
+        manager.integrate(0.2);
+        states = manager.getStateStorage();
+        accelerations = *kinematics->getAccelerationStorage();
+    };
+
+    Storage states, accelerations, statesBg, accelerationsBg;
+    run(false, states, accelerations);
+    run(true, statesBg, accelerationsBg);
+
+    auto compare = [](const Storage& expected, const Storage& found) {
+        SimTK_TEST(expected.getSize() == found.getSize());
+        SimTK_TEST(expected.getSize() > 2);
+        for (int i = 0; i < expected.getSize(); ++i) {
+            const StateVector& a = *expected.getStateVector(i);
+            const StateVector& b = *found.getStateVector(i);
+            SimTK_TEST(a.getTime() == b.getTime());
+            SimTK_TEST(a.getSize() == b.getSize());
+            for (int j = 0; j < a.getSize(); ++j)
+                SimTK_TEST(a.getData()[j] == b.getData()[j]);
+        }
+    };
+    compare(states, statesBg);
+    compare(accelerations, accelerationsBg);
+}
+
+void testCheckpointAndRestore()
+{
+    cout << "Running testCheckpointAndRestore" << endl;
+    LoadOpenSimLibrary("osimActuators");
+
+    Model arm("arm26.osim");
+    SimTK::State& state = arm.initSystem();
+    arm.equilibrateMuscles(state);
+    state.setTime(0);
+    const SimTK::State initialState = state;
+
+    // Integrate without interruption, checkpointing half way.
+    SimTK::RungeKuttaMersonIntegrator integ(arm.getMultibodySystem());
+    integ.setAccuracy(1e-9);
+    Manager manager(arm, integ);
+    manager.initialize(initialState);
+    manager.integrate(0.1);
+    manager.checkpoint("testManager_checkpoint.bin");
+    const int numRowsAtCheckpoint = manager.getStateStorage().getSize();
+    const SimTK::Vector finalY = manager.integrate(0.2).getY();
+
+    // Continue from the checkpoint with a new Manager.
+    SimTK::RungeKuttaMersonIntegrator integ2(arm.getMultibodySystem());
+    integ2.setAccuracy(1e-9);
+    Manager restored(arm, integ2);
+    restored.restoreFromCheckpoint("testManager_checkpoint.bin");
+    SimTK_TEST_EQ(restored.getState().getTime(), 0.1);
+    SimTK_TEST(restored.getStateStorage().getSize() == numRowsAtCheckpoint);
+    const SimTK::State& finalState = restored.integrate(0.2);
+    SimTK_TEST_EQ(finalState.getTime(), 0.2);
+    SimTK_TEST_EQ_TOL(finalState.getY(), finalY, 1e-6);
+    SimTK_TEST(restored.getStateStorage().getSize() > numRowsAtCheckpoint);
+
+    // Periodic checkpoints are written while integrating.
+    std::remove("testManager_periodic.bin");
+    {
+        Manager periodic(arm);
+        periodic.setCheckpointInterval(0.05, "testManager_periodic.bin");
+        periodic.initialize(initialState);
+        periodic.integrate(0.2);
+    }
+    Manager fromPeriodic(arm);
+    fromPeriodic.restoreFromCheckpoint("testManager_periodic.bin");
+    SimTK_TEST(fromPeriodic.getState().getTime() >= 0.15);
+    SimTK_TEST(fromPeriodic.getState().getTime() < 0.2);
+
+    // A file that is not a checkpoint is rejected.
+    {
+        std::ofstream bogus("testManager_bogus.bin", std::ios::binary);
+        bogus << "not a checkpoint";
+    }
+    Manager rejected(arm);
+    SimTK_TEST_MUST_THROW_EXC(
+        rejected.restoreFromCheckpoint("testManager_bogus.bin"), Exception);
+}
+
+void testReportInterval()
+{
+    using SimTK::Vec3;
+
+    cout << "Running testReportInterval" << endl;
+
+    Model pendulum;
+    pendulum.setName("pendulum");
+    auto rod = new Body("rod", 1.0, Vec3(0, -0.5, 0),
+        SimTK::Inertia::cylinderAlongY(0.025, 0.5));
+    pendulum.addBody(rod);
+    auto pin = new PinJoint("pin", pendulum.getGround(), Vec3(0), Vec3(0),
+        *rod, Vec3(0), Vec3(0));
+    pendulum.addJoint(pin);
+    const Coordinate& coord = pin->getCoordinate(PinJoint::Coord::RotationZ);
+
+    auto reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->addToReport(coord.getOutput("value"));
+    pendulum.addComponent(reporter);
+
+    SimTK::State state = pendulum.initSystem();
+    coord.setValue(state, 0.5);
+    state.setTime(0.0);
+    const SimTK::State initialState = state;
+
+    // Reference: record every step of the integrator.
+    SimTK::RungeKuttaMersonIntegrator stepInteg(pendulum.getSystem());
+    stepInteg.setAccuracy(1e-8);
+    Manager stepManager(pendulum, stepInteg);
+    stepManager.initialize(initialState);
+    stepManager.integrate(1.0);
+    const int numSteps = stepInteg.getNumStepsTaken();
+
+    reporter->clearTable();
+    SimTK::RungeKuttaMersonIntegrator integ(pendulum.getSystem());
+    integ.setAccuracy(1e-8);
+    Manager manager(pendulum, integ);
+    manager.setReportInterval(0.01);
+    manager.initialize(initialState);
+    const SimTK::State& finalState = manager.integrate(1.0);
+    SimTK_TEST_EQ(finalState.getTime(), 1.0);
+
+    // Interpolating does not change the steps the integrator takes.
+    SimTK_TEST(integ.getNumStepsTaken() == numSteps);
+
+    // The states and the reporter are sampled every 0.01 s.
+    const Storage& states = manager.getStateStorage();
+    SimTK_TEST(states.getSize() >= 101);
+    for (int i = 0; i <= 100; ++i)
+        SimTK_TEST_EQ(states.getStateVector(i)->getTime(), 0.01*i);
+    const auto& table = reporter->getTable();
+    SimTK_TEST(table.getNumRows() >= 100);
+    for (int i = 0; i < 100; ++i)
+        SimTK_TEST_EQ(table.getIndependentColumn()[i], 0.01*(i + 1));
+
+    // The interpolated values match those of an integration that stops at
+    // each report time.
+    SimTK::RungeKuttaMersonIntegrator exactInteg(pendulum.getSystem());
+    exactInteg.setAccuracy(1e-8);
+    Manager exactManager(pendulum, exactInteg);
+    exactManager.initialize(initialState);
+    for (int i = 1; i <= 100; ++i) {
+        const SimTK::State& s = exactManager.integrate(0.01*i);
+        SimTK_TEST_EQ_TOL(coord.getValue(s),
+            table.getRowAtIndex(i - 1)[0], 1e-5);
+    }
+}
+
+void testRealTimeStepping()
+{
+    using SimTK::Vec3;
+
+    cout << "Running testRealTimeStepping" << endl;
+
+    Model pendulum;
+    pendulum.setName("pendulum");
+    auto rod = new Body("rod", 1.0, Vec3(0, -0.5, 0),
+        SimTK::Inertia::cylinderAlongY(0.025, 0.5));
+    pendulum.addBody(rod);
+    auto pin = new PinJoint("pin", pendulum.getGround(), Vec3(0), Vec3(0),
+        *rod, Vec3(0), Vec3(0));
+    pendulum.addJoint(pin);
+    const Coordinate& coord = pin->getCoordinate(PinJoint::Coord::RotationZ);
+
+    SimTK::State state = pendulum.initSystem();
+    coord.setValue(state, 0.5);
+    state.setTime(0.0);
+    const SimTK::State initialState = state;
+
+    SimTK::RungeKuttaMersonIntegrator refInteg(pendulum.getSystem());
+    refInteg.setAccuracy(1e-8);
+    Manager reference(pendulum, refInteg);
+    reference.initialize(initialState);
+    const double refValue = coord.getValue(reference.integrate(1.0));
+
+    // 500 steps of 2 ms, with a deadline that cannot be missed.
+    SimTK::RungeKuttaMersonIntegrator integ(pendulum.getSystem());
+    integ.setAccuracy(1e-8);
+    Manager manager(pendulum, integ);
+    manager.setPerformAnalyses(false);
+    manager.initialize(initialState);
+    manager.setRealTimeDeadline(10.0, Manager::OverrunPolicy::Continue, 100);
+    const SimTK::State* s = nullptr;
+    for (int i = 0; i < 500; ++i) {
+        s = &manager.stepRealTime(0.002);
+        SimTK_TEST_EQ(s->getTime(), 0.002*(i + 1));
+    }
+    SimTK_TEST(s == &manager.getState());
+    SimTK_TEST_EQ_TOL(coord.getValue(*s), refValue, 1e-6);
+
+    auto stats = manager.getRealTimeStatistics();
+    SimTK_TEST(stats.numSteps == 500);
+    SimTK_TEST(stats.numDeadlineMisses == 0);
+    SimTK_TEST(stats.medianLatency > 0);
+    SimTK_TEST(stats.medianLatency <= stats.p99Latency);
+    SimTK_TEST(stats.p99Latency <= stats.maxLatency);
+
+    // With a deadline that is always missed, the accuracy is reduced.
+    const double accuracy = integ.getAccuracyInUse();
+    manager.setRealTimeDeadline(1e-12, Manager::OverrunPolicy::ReduceAccuracy);
+    for (int i = 0; i < 10; ++i) manager.stepRealTime(0.002);
+    stats = manager.getRealTimeStatistics();
+    SimTK_TEST(stats.numSteps == 10);
+    SimTK_TEST(stats.numDeadlineMisses == 10);
+    SimTK_TEST(integ.getAccuracyInUse() > accuracy);
+    SimTK_TEST(integ.getAccuracyInUse() <= 0.1);
+
+    Manager uninitialized(pendulum);
+    SimTK_TEST_MUST_THROW_EXC(uninitialized.stepRealTime(0.002), Exception);
+}
+
+void testMultirateIntegration()
+{
+    cout << "Running testMultirateIntegration" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model arm("arm26.osim");
+
+    const Muscle& muscle = arm.getMuscles().get(0);
+    PrescribedController* controller = new PrescribedController();
+    controller->addActuator(muscle);
+    controller->prescribeControlForActuator(0, new Constant(0.8));
+    arm.addController(controller);
+
+    SimTK::State state = arm.initSystem();
+    state.setTime(0);
+    muscle.setActivation(state, 0.2);
+    arm.equilibrateMuscles(state);
+    const SimTK::State initialState = state;
+    arm.realizeAcceleration(state);
+    const double activationDot =
+        muscle.getStateVariableDerivativeValue(state, "activation");
+
+    // Single-rate reference.
+    Manager reference(arm);
+    reference.initialize(initialState);
+    const SimTK::State& referenceState = reference.integrate(0.1);
+    const double referenceAngle = arm.getCoordinateSet()[1].getValue(
+            referenceState);
+
+    const double macroStep = 0.002;
+    Manager manager(arm);
+    manager.setMultirateMacroStep(macroStep);
+    manager.addSlowStateVariable(
+            muscle.getAbsolutePathString() + "/activation");
+    manager.initialize(initialState);
+
+    // Within the first macro step, the activation advances linearly.
+    SimTK::State s = manager.integrate(macroStep);
+    SimTK_TEST_EQ(muscle.getActivation(s), 0.2 + macroStep*activationDot);
+
+    // The motion follows that of the single-rate reference closely.
+    s = manager.integrate(0.1);
+    SimTK_TEST_EQ(s.getTime(), 0.1);
+    SimTK_TEST_EQ_TOL(muscle.getActivation(s),
+            muscle.getActivation(referenceState), 1e-2);
+    SimTK_TEST_EQ_TOL(arm.getCoordinateSet()[1].getValue(s),
+            referenceAngle, 1e-2);
+
+    // Only state variables added by components can be slow.
+    SimTK_TEST_MUST_THROW_EXC(manager.addSlowStateVariable(
+            arm.getCoordinateSet()[1].getAbsolutePathString() + "/value"),
+            Exception);
+    SimTK_TEST_MUST_THROW_EXC(manager.setMultirateMacroStep(SimTK::NaN),
+            Exception);
+}
+
+void testAutoSelectIntegrator()
+{
+    using SimTK::Vec3;
+
+    cout << "Running testAutoSelectIntegrator" << endl;
+
+    Model pendulum;
+    auto rod = new Body("rod", 1.0, Vec3(0, -0.5, 0),
+        SimTK::Inertia::cylinderAlongY(0.025, 0.5));
+    pendulum.addBody(rod);
+    auto pin = new PinJoint("pin", pendulum.getGround(), Vec3(0), Vec3(0),
+        *rod, Vec3(0), Vec3(0));
+    pendulum.addJoint(pin);
+    const Coordinate& coord = pin->getCoordinate(PinJoint::Coord::RotationZ);
+    SimTK::State state = pendulum.initSystem();
+    coord.setValue(state, 0.5);
+
+    Manager reference(pendulum);
+    reference.getIntegrator().setAccuracy(1e-6);
+    reference.initialize(state);
+    const double referenceAngle = coord.getValue(reference.integrate(1.0));
+    SimTK_TEST(reference.getIntegratorSelectionReport().empty());
+
+    Manager manager(pendulum);
+    manager.getIntegrator().setAccuracy(1e-6);
+    manager.setAutoSelectIntegrator(0.1);
+    manager.initialize(state);
+    // Each candidate is reported, with the choice.
+    const std::string& report = manager.getIntegratorSelectionReport();
+    SimTK_TEST(report.find("RungeKuttaMerson") != std::string::npos);
+    SimTK_TEST(report.find("Selected " +
+            manager.getIntegrator().getMethodName()) != std::string::npos);
+    SimTK_TEST(manager.getIntegrator().getAccuracyInUse() == 1e-6);
+    // The probes do not advance the simulation.
+    SimTK_TEST(manager.getState().getTime() == 0);
+    SimTK_TEST_EQ_TOL(coord.getValue(manager.integrate(1.0)),
+                      referenceAngle, 1e-4);
+
+    // Only the Manager's own integrator is replaced.
+    SimTK::RungeKuttaMersonIntegrator integ(pendulum.getSystem());
+    Manager userIntegrator(pendulum, integ);
+    userIntegrator.setAutoSelectIntegrator(0.1);
+    SimTK_TEST_MUST_THROW_EXC(userIntegrator.initialize(state), Exception);
+}
+
+// Muscle states are integrated while the coordinates follow a motion table.
+void testPrescribedCoordinates()
+{
+    cout << "Running testPrescribedCoordinates" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model arm("arm26.osim");
+    PrescribedController* controller = new PrescribedController();
+    for (int i = 0; i < arm.getMuscles().getSize(); ++i) {
+        controller->addActuator(arm.getMuscles().get(i));
+        controller->prescribeControlForActuator(i, new Constant(0.5));
+    }
+    arm.addController(controller);
+    arm.finalizeConnections();
+
+    // The elbow flexes (in degrees, as from the InverseKinematicsTool) while
+    // the shoulder keeps its default value.
+    const Coordinate& elbow = arm.getCoordinateSet().get("r_elbow_flex");
+    auto elbowAngle = [](double t) { return 30 + 40*std::sin(2*t); };
+    const int numRows = 51;
+    std::vector<double> times;
+    SimTK::Matrix data(numRows, 1);
+    for (int i = 0; i < numRows; ++i) {
+        times.push_back(0.01*i);
+        data(i, 0) = elbowAngle(times.back());
+    }
+    TimeSeriesTable coordinates(times, data, {"r_elbow_flex"});
+    coordinates.addTableMetaData("inDegrees", std::string("yes"));
+
+    const TimeSeriesTable states =
+        simulateWithPrescribedCoordinates(arm, coordinates, true, 0.05);
+    SimTK_TEST(states.getNumRows() == 11);
+    SimTK_TEST_EQ(states.getIndependentColumn().back(), 0.5);
+
+    const std::string elbowPath = elbow.getAbsolutePathString();
+    const auto q = states.getDependentColumn(elbowPath + "/value");
+    const auto u = states.getDependentColumn(elbowPath + "/speed");
+    const auto activation = states.getDependentColumn(
+            arm.getMuscles().get(0).getAbsolutePathString() + "/activation");
+    for (int i = 0; i < int(states.getNumRows()); ++i) {
+        const double t = states.getIndependentColumn()[i];
+        SimTK_TEST_EQ_TOL(q[i], elbowAngle(t)*SimTK_DEGREE_TO_RADIAN, 1e-3);
+        SimTK_TEST_EQ_TOL(u[i], 80*std::cos(2*t)*SimTK_DEGREE_TO_RADIAN,
+                          1e-2);
+        if (i > 0) SimTK_TEST(activation[i] > activation[i-1]);
+    }
+
+    // Quintic splines need at least 6 rows.
+    TimeSeriesTable tooShort(std::vector<double>(times.begin(),
+            times.begin() + 5), SimTK::Matrix(data.block(0, 0, 5, 1)),
+            {"r_elbow_flex"});
+    SimTK_TEST_MUST_THROW_EXC(
+            simulateWithPrescribedCoordinates(arm, tooShort), Exception);
+}
+
+void testPararealManager()
+{
+    cout << "Running testPararealManager" << endl;
+
+    using SimTK::Vec3;
+
+    // A double pendulum, compared with a serial integration at the same
+    // accuracy.
+    Model model;
+    auto link1 = new Body("link1", 1., Vec3(0), SimTK::Inertia(0.1));
+    auto link2 = new Body("link2", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(link1);
+    model.addBody(link2);
+    model.addJoint(new PinJoint("pin1", model.getGround(), Vec3(0), Vec3(0),
+                                *link1, Vec3(0, 0.5, 0), Vec3(0)));
+    model.addJoint(new PinJoint("pin2", *link1, Vec3(0), Vec3(0),
+                                *link2, Vec3(0, 0.5, 0), Vec3(0)));
+    SimTK::State s = model.initSystem();
+    model.getCoordinateSet()[0].setValue(s, 1.);
+    model.getCoordinateSet()[1].setValue(s, -0.5);
+
+    const double finalTime = 2.;
+    const double accuracy = 1e-8;
+    SimTK::RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+    integrator.setAccuracy(accuracy);
+    Manager manager(model, integrator);
+    manager.initialize(s);
+    manager.integrate(finalTime);
+
+    PararealManager parareal(model);
+    parareal.setNumWindows(8);
+    parareal.setNumThreads(4);
+    parareal.setFineAccuracy(accuracy);
+    parareal.setCoarseAccuracy(1e-3);
+    parareal.setTolerance(1e-7);
+    parareal.integrate(s, finalTime);
+    SimTK_TEST(parareal.getConverged());
+    SimTK_TEST(parareal.getNumIterations() >= 1);
+    SimTK_TEST(parareal.getNumIterations() <= 8);
+
+    const TimeSeriesTable states = parareal.getStatesTable();
+    const auto& times = states.getIndependentColumn();
+    SimTK_TEST_EQ(times.front(), 0.);
+    SimTK_TEST_EQ(times.back(), finalTime);
+    for (size_t i = 1; i < times.size(); ++i) SimTK_TEST(times[i] > times[i-1]);
+    const auto lastRow = states.getRowAtIndex(states.getNumRows() - 1);
+    const Array<std::string> names = model.getStateVariableNames();
+    const SimTK::Vector serialValues =
+            model.getStateVariableValues(manager.getState());
+    for (int i = 0; i < names.getSize(); ++i) {
+        SimTK_TEST_EQ_TOL(lastRow[states.getColumnIndex(names[i])],
+                          serialValues[i], 1e-5);
+    }
+
+    // Stopped before it converges, the last windows are inaccurate.
+    parareal.setTolerance(0);
+    parareal.setMaxIterations(2);
+    parareal.integrate(s, finalTime);
+    SimTK_TEST(!parareal.getConverged());
+    SimTK_TEST(parareal.getNumIterations() == 2);
+
+    SimTK_TEST_MUST_THROW_EXC(parareal.integrate(s, 0.), Exception);
+    SimTK_TEST_MUST_THROW_EXC(parareal.setNumWindows(0), Exception);
+}
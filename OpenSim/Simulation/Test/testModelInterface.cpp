@@ -21,7 +21,9 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Simulation/Model/Geometry.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
@@ -127,6 +129,118 @@ int main() {
         // verify the new connection was made
         ASSERT(model.getComponent<Joint>("r_elbow").getParentFrame().getName()
                 == "elbow_in_humerus");
+
+        // Profile the components while realizing the model.
+        state = model.initSystem();
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+        ComponentProfiler::setEnabled(true);
+        model.realizeAcceleration(state);
+        ComponentProfiler::setEnabled(false);
+
+        const Muscle& muscle = model.getMuscles()[0];
+        auto countOf = [&model](const Component& comp,
+                                ComponentProfiler::Operation op) {
+            for (const auto& record : ComponentProfiler::getSummary(model)) {
+                if (record.componentPath == comp.getAbsolutePathString() &&
+                        record.operation == op)
+                    return record.count;
+            }
+            return 0ull;
+        };
+        ASSERT(countOf(muscle, ComponentProfiler::ComputeForce) == 1);
+        ASSERT(countOf(muscle.getGeometryPath(),
+                       ComponentProfiler::ComputePath) == 1);
+        ASSERT(countOf(muscle, ComponentProfiler::RealizeAcceleration) == 1);
+
+        // Nothing is collected while the profiler is disabled.
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+        model.realizeAcceleration(state);
+        ASSERT(countOf(muscle, ComponentProfiler::ComputeForce) == 1);
+
+        ComponentProfiler::reset(model);
+        ASSERT(ComponentProfiler::getSummary(model).empty());
+
+        // Models created from the same file are copies of the cached model
+        // while the cache is enabled.
+        ASSERT(!Model::getModelCacheEnabled());
+        std::unique_ptr<Model> uncached(Model::createFromFile("arm26.osim"));
+        ASSERT(Model::getModelCacheSize() == 0);
+        Model::setModelCacheEnabled(true);
+        std::unique_ptr<Model> first(Model::createFromFile("arm26.osim"));
+        ASSERT(Model::getModelCacheSize() == 1);
+        first->updMuscles()[0].set_max_isometric_force(1.0);
+        std::unique_ptr<Model> second(Model::createFromFile("arm26.osim"));
+        ASSERT(Model::getModelCacheSize() == 1);
+        ASSERT(second->getInputFileName() == "arm26.osim");
+        ASSERT(second->isObjectUpToDateWithProperties());
+        ASSERT(second->countNumComponents() == uncached->countNumComponents());
+        // Changes to a model do not reach the cache.
+        ASSERT(second->getMuscles()[0].get_max_isometric_force() ==
+               uncached->getMuscles()[0].get_max_isometric_force());
+        second->initSystem();
+        Model::clearModelCache();
+        ASSERT(Model::getModelCacheSize() == 0);
+        Model::setModelCacheEnabled(false);
+
+        // Models with the same properties have the same fingerprint, whatever
+        // their names.
+        Model renamed(*uncached);
+        renamed.setName("renamed");
+        ASSERT(uncached->computeFingerprint().size() == 32);
+        ASSERT(renamed.computeFingerprint() == uncached->computeFingerprint());
+        const std::string topology = renamed.computeFingerprint(true);
+        ASSERT(topology != renamed.computeFingerprint());
+        renamed.updMuscles()[0].set_max_isometric_force(1.0);
+        ASSERT(renamed.computeFingerprint() != uncached->computeFingerprint());
+        // Parameters are not part of the topology.
+        ASSERT(renamed.computeFingerprint(true) == topology);
+        renamed.finalizeFromProperties();
+        const std::string edited = renamed.computeFingerprint();
+        renamed.updMuscles()[0].setName("renamed_muscle");
+        ASSERT(renamed.computeFingerprint(true) != topology);
+        ASSERT(renamed.computeFingerprint() != edited);
+
+        // Meshes of all models whose mesh files are the same file share the
+        // loaded mesh, unless mesh loading is disabled.
+        Mesh::clearMeshCache();
+        auto addMesh = [](Model& m) {
+            m.updGround().attachGeometry(new Mesh("sphere_10cm_radius.vtp"));
+            m.finalizeFromProperties();
+        };
+        Model withMesh, withSameMesh;
+        addMesh(withMesh);
+        ASSERT(Mesh::getMeshCacheSize() == 1);
+        addMesh(withSameMesh);
+        ASSERT(Mesh::getMeshCacheSize() == 1);
+        Mesh::clearMeshCache();
+        Mesh::setMeshLoadingEnabled(false);
+        Model headless;
+        addMesh(headless);
+        ASSERT(Mesh::getMeshCacheSize() == 0);
+        Mesh::setMeshLoadingEnabled(true);
+
+        // Memory estimates are aggregated over the component tree.
+        Model measured("arm26.osim");
+        ASSERT(measured.estimateMemoryUsage().get(MemoryUsage::States) == 0);
+        measured.initSystem();
+        const MemoryUsage usage = measured.estimateMemoryUsage();
+        ASSERT(usage.get(MemoryUsage::Properties) > 0);
+        ASSERT(usage.get(MemoryUsage::States) > 0);
+        size_t sumOfCategories = 0;
+        for (int i = 0; i < MemoryUsage::NumCategories; ++i)
+            sumOfCategories += usage.get(MemoryUsage::Category(i));
+        ASSERT(sumOfCategories == usage.getTotal());
+        ASSERT(measured.getMuscles()[0].estimateMemoryUsage().getTotal() > 0);
+        ASSERT(measured.getMuscles()[0].estimateMemoryUsage().getTotal() <
+               usage.getTotal());
+        // A shared block is counted once.
+        const int block = 0;
+        MemoryUsage sharing, alsoSharing;
+        sharing.addShared(MemoryUsage::Meshes, &block, 100);
+        alsoSharing.addShared(MemoryUsage::Meshes, &block, 100);
+        sharing += alsoSharing;
+        ASSERT(sharing.get(MemoryUsage::Meshes) == 100);
+        ASSERT(MemoryUsage::getCurrentProcessMemory() > 0);
     }
     catch (const std::exception& ex) {
         std::cout << ex.what() << std::endl;
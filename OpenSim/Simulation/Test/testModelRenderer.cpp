@@ -0,0 +1,132 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  testModelRenderer.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace OpenSim;
+using namespace SimTK;
+
+// A ball, 0.1 m in radius, that slides along ground's X axis.
+void addSlidingBall(Model& model)
+{
+    auto* ball = new OpenSim::Body("ball", 1, Vec3(0), Inertia(0.01));
+    ball->attachGeometry(new Sphere(0.1));
+    model.addBody(ball);
+    model.addJoint(new SliderJoint("slider", model.getGround(), *ball));
+}
+
+// Whether the pixel at (x, y) has the background color.
+bool isBackground(const ModelRenderer::Image& image, int x, int y)
+{
+    const int i = 3*(y*image.width + x);
+    const unsigned char* p = &image.pixels[i];
+    // The default background color: (0.15, 0.15, 0.2).
+    return p[0] == 38 && p[1] == 38 && p[2] == 51;
+}
+
+void testRender()
+{
+    Model model;
+    addSlidingBall(model);
+    State& state = model.initSystem();
+
+    ModelRenderer renderer(model);
+    renderer.setImageSize(80, 60);
+    ModelRenderer::Image image = renderer.render(state);
+    SimTK_TEST(image.width == 80);
+    SimTK_TEST(image.height == 60);
+    SimTK_TEST(image.pixels.size() == 3*80*60);
+    // The view is fit to the ball.
+    SimTK_TEST(!isBackground(image, 40, 30));
+    SimTK_TEST(isBackground(image, 0, 0));
+    SimTK_TEST(isBackground(image, 79, 59));
+
+    // With a fixed view, the ball leaves the image as it slides away.
+    renderer.setViewCenterAndHeight(Vec3(0), 1);
+    SimTK_TEST(!isBackground(renderer.render(state), 40, 30));
+    model.getCoordinateSet()[0].setValue(state, 2);
+    SimTK_TEST(isBackground(renderer.render(state), 40, 30));
+
+    SimTK_TEST_MUST_THROW_EXC(renderer.setImageSize(0, 10), Exception);
+    SimTK_TEST_MUST_THROW_EXC(renderer.setViewDirection(Vec3(0, 1, 0),
+                                                        Vec3(0, 2, 0)),
+                              Exception);
+}
+
+void testRenderTrajectory()
+{
+    Model model;
+    addSlidingBall(model);
+    State state = model.initSystem();
+    StatesTrajectory states;
+    for (int i = 0; i < 5; ++i) {
+        state.setTime(0.1*i);
+        model.getCoordinateSet()[0].setValue(state, 0.1*i);
+        states.append(state);
+    }
+
+    ModelRenderer renderer(model);
+    renderer.setImageSize(32, 24);
+    renderer.setDecimation(2);
+    SimTK_TEST_MUST_THROW_EXC(renderer.setDecimation(0), Exception);
+
+    // Every other state: 0, 2 and 4.
+    std::ostringstream stream;
+    SimTK_TEST(renderer.renderToStream(states, stream) == 3);
+    const std::string header = "P6\n32 24\n255\n";
+    SimTK_TEST(stream.str().size() == 3*(header.size() + 3*32*24));
+    SimTK_TEST(stream.str().compare(0, header.size(), header) == 0);
+
+    SimTK_TEST(renderer.renderToFiles(states,
+                                      "testModelRenderer_single_") == 3);
+    SimTK_TEST(std::ifstream("testModelRenderer_single_00002.ppm").good());
+    SimTK_TEST(!std::ifstream("testModelRenderer_single_00003.ppm").good());
+
+    // Trials rendered concurrently.
+    renderer.setNumThreads(2);
+    renderer.renderTrialsToFiles({states, states, states},
+            {"testModelRenderer_trial1_", "testModelRenderer_trial2_",
+             "testModelRenderer_trial3_"});
+    for (int trial = 1; trial <= 3; ++trial) {
+        std::ifstream file("testModelRenderer_trial" + std::to_string(trial) +
+                           "_00000.ppm", std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        SimTK_TEST(contents.str() ==
+                   stream.str().substr(0, header.size() + 3*32*24));
+    }
+    SimTK_TEST_MUST_THROW_EXC(renderer.renderTrialsToFiles({states}, {}),
+                              Exception);
+}
+
+int main()
+{
+    SimTK_START_TEST("testModelRenderer");
+        SimTK_SUBTEST(testRender);
+        SimTK_SUBTEST(testRenderTrajectory);
+    SimTK_END_TEST();
+}
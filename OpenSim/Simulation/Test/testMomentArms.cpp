@@ -41,6 +41,8 @@
 
 #include "SimulationComponentsForTesting.h"
 
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -55,6 +57,12 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testPolynomialPathSurrogate();
+void testMomentArmMatrix(const string& filename);
+void testLengthJacobian();
+void testMuscleTendonKinematics();
+void testBatchModelEvaluator();
+void testConcurrentEvaluation();
 
 int main()
 {
@@ -67,6 +75,30 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testPolynomialPathSurrogate();
+        cout << "Polynomial path surrogate: PASSED\n" << endl;
+
+        testMomentArmMatrix("testMomentArmsConstraintB.osim");
+        testMomentArmMatrix("gait2354_simbody.osim");
+        cout << "Moment-arm matrix of all muscles and coordinates: PASSED\n"
+             << endl;
+
+        testLengthJacobian();
+        cout << "Moment arms and lengthening speeds from the path Jacobian: "
+                "PASSED\n" << endl;
+
+        testMuscleTendonKinematics();
+        cout << "Muscle-tendon kinematics over a trajectory: PASSED\n"
+             << endl;
+
+        testBatchModelEvaluator();
+        cout << "Batch evaluation of outputs and moment arms: PASSED\n"
+             << endl;
+
+        testConcurrentEvaluation();
+        cout << "Evaluation of one model from several threads: PASSED\n"
+             << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -166,6 +198,142 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+void testPolynomialPathSurrogate()
+{
+    using SimTK::Vec3;
+
+    Model model;
+    Body* leg = new Body("leg", 10., Vec3(0, -0.5, 0), SimTK::Inertia(1, 1, 1));
+    model.addBody(leg);
+    PinJoint* knee = new PinJoint("knee", model.getGround(), Vec3(0), Vec3(0),
+                                  *leg, Vec3(0), Vec3(0));
+    knee->updCoordinate().setName("knee_angle");
+    knee->updCoordinate().setRangeMin(-1.0);
+    knee->updCoordinate().setRangeMax(1.0);
+    model.addJoint(knee);
+
+    PathSpring* spring = new PathSpring("spring", 0.1, 100.0, 0.5);
+    spring->updGeometryPath().appendNewPathPoint("origin", model.getGround(),
+                                                 Vec3(0.05, 0.1, 0));
+    spring->updGeometryPath().appendNewPathPoint("insertion", *leg,
+                                                 Vec3(0.05, -0.25, 0.01));
+    model.addForce(spring);
+
+    SimTK::State& s = model.initSystem();
+    const GeometryPath& path = spring->getGeometryPath();
+
+    std::vector<std::string> spanned = path.findSpanningCoordinates(s);
+    ASSERT(spanned.size() == 1 && spanned[0] == "knee_angle", __FILE__,
+           __LINE__, "Expected the path to span only the knee.");
+
+    PolynomialPathSurrogate surrogate =
+        path.fitPolynomialSurrogate(s, spanned, 6);
+    cout << "Surrogate errors: rms length " << surrogate.get_rms_length_error()
+         << ", max length " << surrogate.get_max_length_error()
+         << ", max moment arm " << surrogate.get_max_moment_arm_error() << endl;
+    ASSERT(surrogate.get_max_length_error() < 1e-5, __FILE__, __LINE__,
+           "Surrogate length error is too large.");
+    ASSERT(surrogate.get_max_moment_arm_error() < 1e-4, __FILE__, __LINE__,
+           "Surrogate moment arm error is too large.");
+
+    // Evaluate the path with and without the surrogate at the same state.
+    auto evaluate = [](Model& m, SimTK::State& state) {
+        m.updCoordinateSet()[0].setValue(state, 0.3);
+        m.updCoordinateSet()[0].setSpeedValue(state, -2.0);
+        m.realizeAcceleration(state);
+    };
+    evaluate(model, s);
+
+    Model surrogateModel(model);
+    PathSpring& surrogateSpring = dynamic_cast<PathSpring&>(
+            surrogateModel.updForceSet().get("spring"));
+    surrogateSpring.updGeometryPath().setPolynomialSurrogate(surrogate);
+    SimTK::State& s2 = surrogateModel.initSystem();
+    evaluate(surrogateModel, s2);
+    const GeometryPath& surrogatePath = surrogateSpring.getGeometryPath();
+    ASSERT(surrogatePath.hasPolynomialSurrogate());
+
+    ASSERT_EQUAL(path.getLength(s), surrogatePath.getLength(s2), 1e-5);
+    ASSERT_EQUAL(path.computeMomentArm(s, knee->getCoordinate()),
+        surrogatePath.computeMomentArm(s2,
+            surrogateModel.getCoordinateSet()[0]), 1e-4);
+    ASSERT_EQUAL(path.getLengtheningSpeed(s),
+                 surrogatePath.getLengtheningSpeed(s2), 1e-3);
+    ASSERT_EQUAL(s.getUDot()[0], s2.getUDot()[0], 1e-3);
+}
+
+// The moment-arm matrix from MomentArmSolver::solveAll() matches the moment
+// arms solved one muscle and coordinate at a time.
+void testMomentArmMatrix(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    for (int j = 0; j < coordSet.getSize(); ++j) {
+        if (!coordSet[j].getLocked(s))
+            coordSet[j].setValue(s, 0.5*(coordSet[j].getRangeMin() +
+                                         coordSet[j].getRangeMax()), false);
+    }
+    model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+    std::vector<const GeometryPath*> paths;
+    for (const Muscle& muscle : model.getComponentList<Muscle>())
+        paths.push_back(&muscle.getGeometryPath());
+    std::vector<const Coordinate*> coords;
+    for (int j = 0; j < coordSet.getSize(); ++j)
+        coords.push_back(&coordSet[j]);
+
+    MomentArmSolver solver(model);
+    const SimTK::Matrix momentArms = solver.solveAll(s, paths, coords);
+    ASSERT(momentArms.nrow() == int(paths.size()) &&
+           momentArms.ncol() == int(coords.size()));
+    for (int i = 0; i < int(paths.size()); ++i) {
+        for (int j = 0; j < int(coords.size()); ++j) {
+            ASSERT_EQUAL(solver.solve(s, *coords[j], *paths[i]),
+                         momentArms(i, j), 1e-10, __FILE__, __LINE__,
+                         "Moment-arm of " + paths[i]->getOwner().getName() +
+                         " about " + coords[j]->getName() + " differs.");
+        }
+    }
+}
+
+// The moment arms and lengthening speeds from the path Jacobian match those
+// from MomentArmSolver and the path points' velocities (the model has moving
+// path points, and no constraints).
+void testLengthJacobian()
+{
+    Model model("gait2354_simbody.osim");
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    std::vector<const Coordinate*> coords;
+    for (int j = 0; j < coordSet.getSize(); ++j) {
+        coords.push_back(&coordSet[j]);
+        if (!coordSet[j].getLocked(s)) {
+            coordSet[j].setValue(s, 0.4*coordSet[j].getRangeMin() +
+                                    0.6*coordSet[j].getRangeMax(), false);
+            coordSet[j].setSpeedValue(s, 0.1*(j + 1));
+        }
+    }
+    model.realizeVelocity(s);
+
+    SimTK::Vector dLdu, momentArms;
+    for (const Muscle& muscle : model.getComponentList<Muscle>()) {
+        const GeometryPath& path = muscle.getGeometryPath();
+        path.computeLengthJacobian(s, dLdu);
+        ASSERT_EQUAL(path.getLengtheningSpeed(s), ~dLdu*s.getU(), 1e-10,
+                     __FILE__, __LINE__,
+                     "Lengthening speed of " + muscle.getName() + " differs.");
+
+        path.computeMomentArms(s, coords, momentArms);
+        for (int j = 0; j < int(coords.size()); ++j) {
+            ASSERT_EQUAL(path.computeMomentArm(s, *coords[j]), momentArms[j],
+                         1e-10, __FILE__, __LINE__,
+                         "Moment-arm of " + muscle.getName() + " about " +
+                         coords[j]->getName() + " differs.");
+        }
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
@@ -269,6 +437,216 @@ SimTK::Vector computeGenForceScaling(const Model &osimModel, const SimTK::State
 //==========================================================================================================
 // Main test driver can be used on any model so test cases should be very easy to add
 //==========================================================================================================
+// The lengths, lengthening speeds and moment arms computed over a trajectory
+// by computeMuscleTendonKinematics() match those evaluated frame by frame.
+void testMuscleTendonKinematics()
+{
+    Model model("gait2354_simbody.osim");
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+
+    // Sweep the unlocked coordinates through their ranges, in degrees as in
+    // files written by the InverseKinematicsTool, with speeds given by path.
+    const int numFrames = 7;
+    std::vector<double> times;
+    std::vector<std::string> labels;
+    for (int j = 0; j < coordSet.getSize(); ++j) {
+        labels.push_back(coordSet[j].getName());
+        labels.push_back(coordSet[j].getAbsolutePathString() + "/speed");
+    }
+    SimTK::Matrix data(numFrames, int(labels.size()));
+    for (int f = 0; f < numFrames; ++f) {
+        times.push_back(0.01*f);
+        const double t = (f + 0.5)/numFrames;
+        for (int j = 0; j < coordSet.getSize(); ++j) {
+            const Coordinate& c = coordSet[j];
+            const double toDegrees =
+                c.getMotionType() == Coordinate::Rotational ?
+                SimTK_RADIAN_TO_DEGREE : 1.0;
+            double q = c.getDefaultValue(), u = 0;
+            if (!c.getLocked(s)) {
+                q = c.getRangeMin() + t*(c.getRangeMax() - c.getRangeMin());
+                u = 0.3*(j + 1)*std::cos(3*t);
+            }
+            data(f, 2*j) = q*toDegrees;
+            data(f, 2*j+1) = u*toDegrees;
+        }
+    }
+    TimeSeriesTable coordinates(times, data, labels);
+    coordinates.addTableMetaData("inDegrees", std::string("yes"));
+
+    const std::vector<std::string> momentArmCoords{"hip_flexion_r",
+                                                   "knee_angle_r"};
+    const MuscleTendonKinematics kinematics =
+        computeMuscleTendonKinematics(model, coordinates, momentArmCoords, 3);
+    ASSERT(kinematics.lengths.getNumRows() == size_t(numFrames));
+    ASSERT(kinematics.lengtheningSpeeds.getNumRows() == size_t(numFrames));
+    ASSERT(kinematics.momentArms.size() == momentArmCoords.size());
+
+    for (int f = 0; f < numFrames; ++f) {
+        s.setTime(times[f]);
+        for (int j = 0; j < coordSet.getSize(); ++j) {
+            const double toRadians =
+                coordSet[j].getMotionType() == Coordinate::Rotational ?
+                SimTK_DEGREE_TO_RADIAN : 1.0;
+            coordSet[j].setValue(s, data(f, 2*j)*toRadians, false);
+            coordSet[j].setSpeedValue(s, data(f, 2*j+1)*toRadians);
+        }
+        model.realizeVelocity(s);
+        for (const Muscle& muscle : model.getComponentList<Muscle>()) {
+            const std::string& name = muscle.getName();
+            const GeometryPath& path = muscle.getGeometryPath();
+            ASSERT_EQUAL(path.getLength(s),
+                kinematics.lengths.getDependentColumn(name)[f], 1e-12,
+                __FILE__, __LINE__, "Length of " + name + " differs.");
+            ASSERT_EQUAL(path.getLengtheningSpeed(s),
+                kinematics.lengtheningSpeeds.getDependentColumn(name)[f],
+                1e-12, __FILE__, __LINE__,
+                "Lengthening speed of " + name + " differs.");
+            for (const auto& coordName : momentArmCoords) {
+                ASSERT_EQUAL(
+                    path.computeMomentArm(s, coordSet.get(coordName)),
+                    kinematics.momentArms.at(coordName)
+                        .getDependentColumn(name)[f], 1e-10,
+                    __FILE__, __LINE__, "Moment-arm of " + name +
+                    " about " + coordName + " differs.");
+            }
+        }
+    }
+}
+
+// The outputs and moment arms computed for many samples at once by a
+// BatchModelEvaluator match those evaluated one sample at a time.
+void testBatchModelEvaluator()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordSet = model.getCoordinateSet();
+    const Coordinate& shoulder = coordSet.get("r_shoulder_elev");
+    const Coordinate& elbow = coordSet.get("r_elbow_flex");
+    const std::string elbowPath = elbow.getAbsolutePathString();
+    const auto& marker =
+            model.getComponent<Marker>("/markerset/r_radius_styloid");
+    const auto& biceps = model.getComponent<PathActuator>("/forceset/BIClong");
+
+    BatchModelEvaluator evaluator(model);
+    ASSERT(evaluator.getNumInputs() == 2);
+    evaluator.setInputs({elbowPath + "/value", elbowPath + "/speed"});
+    evaluator.addOutput("/markerset/r_radius_styloid|location");
+    ASSERT(evaluator.getRequiredStage() == SimTK::Stage::Position);
+    evaluator.addMomentArm("/forceset/BIClong", elbowPath);
+    evaluator.addOutput("/markerset/r_radius_styloid|velocity");
+    ASSERT(evaluator.getRequiredStage() == SimTK::Stage::Velocity);
+    ASSERT(evaluator.getNumOutputColumns() == 7);
+    const auto labels = evaluator.getOutputLabels();
+    ASSERT(labels[0] == "/markerset/r_radius_styloid|location_1");
+    ASSERT(labels[3] == "/forceset/BIClong|moment_arm:r_elbow_flex");
+    ASSERT_THROW(Exception, evaluator.addOutput("/forceset/BIClong"));
+    ASSERT_THROW(Exception, evaluator.setInputs({"/forceset/nothing"}));
+
+    // The shoulder, which is not an input, keeps its working state value.
+    shoulder.setValue(s, 0.3);
+    const int numSamples = 11;
+    SimTK::Matrix inputs(numSamples, 2);
+    for (int i = 0; i < numSamples; ++i) {
+        inputs(i, 0) = elbow.getRangeMin() + (elbow.getRangeMax() -
+                elbow.getRangeMin())*i/(numSamples - 1);
+        inputs(i, 1) = 0.5*i - 2;
+    }
+    evaluator.setNumThreads(3);
+    const SimTK::Matrix results = evaluator.evaluate(inputs);
+    ASSERT(results.nrow() == numSamples && results.ncol() == 7);
+    ASSERT_THROW(Exception, evaluator.evaluate(SimTK::Matrix(2, 3)));
+
+    for (int i = 0; i < numSamples; ++i) {
+        elbow.setValue(s, inputs(i, 0), false);
+        elbow.setSpeedValue(s, inputs(i, 1));
+        model.realizeVelocity(s);
+        const SimTK::Vec3 location = marker.getLocationInGround(s);
+        const SimTK::Vec3 velocity = marker.getVelocityInGround(s);
+        for (int k = 0; k < 3; ++k) {
+            ASSERT_EQUAL(location[k], results(i, k), 1e-12);
+            ASSERT_EQUAL(velocity[k], results(i, 4 + k), 1e-12);
+        }
+        ASSERT_EQUAL(biceps.computeMomentArm(s,
+                model.updCoordinateSet().get("r_elbow_flex")),
+                results(i, 3), 1e-10);
+    }
+}
+
+// Evaluate one model from several threads at once, each with its own state,
+// and compare to evaluating it from one thread.
+void testConcurrentEvaluation()
+{
+    Model model("arm26.osim");
+    auto* controller = new ControlSetController();
+    controller->setControlSetFileName("arm26_StaticOptimization_controls.xml");
+    model.addController(controller);
+    SimTK::State& s = model.initSystem();
+    model.equilibrateMuscles(s);
+
+    Coordinate& shoulder = model.updCoordinateSet().get("r_shoulder_elev");
+    Coordinate& elbow = model.updCoordinateSet().get("r_elbow_flex");
+    const auto& biceps = model.getComponent<PathActuator>("/forceset/BIClong");
+    const auto& triceps = model.getComponent<PathActuator>("/forceset/TRIlong");
+
+    // Length and moment arms of two muscles, the controls, and the
+    // accelerations, at each sample.
+    auto evaluate = [&](SimTK::State& state, int i) {
+        state.setTime(0.05*i);
+        shoulder.setValue(state, 0.1*(i % 7), false);
+        elbow.setValue(state, 0.2*(i % 11), false);
+        elbow.setSpeedValue(state, 0.3*(i % 5) - 0.6);
+        model.realizeAcceleration(state);
+        const int nc = model.getNumControls();
+        SimTK::Vector values(4 + nc + state.getNU());
+        values[0] = biceps.getLength(state);
+        values[1] = biceps.computeMomentArm(state, elbow);
+        values[2] = triceps.computeMomentArm(state, shoulder);
+        values[3] = triceps.getLength(state);
+        values(4, nc) = model.getControls(state);
+        values(4 + nc, state.getNU()) = state.getUDot();
+        return values;
+    };
+
+    const int numSamples = 40;
+    std::vector<SimTK::Vector> expected;
+    SimTK::State serialState = s;
+    for (int i = 0; i < numSamples; ++i)
+        expected.push_back(evaluate(serialState, i));
+
+    const int numThreads = 4;
+    std::vector<int> numMismatches(numThreads, 0);
+    std::vector<std::string> errors(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            try {
+                SimTK::State state = s;
+                // Each thread visits the samples in a different order.
+                for (int repeat = 0; repeat < 5; ++repeat) {
+                    for (int k = 0; k < numSamples; ++k) {
+                        const int i = (k*(2*t + 1) + repeat) % numSamples;
+                        const SimTK::Vector values = evaluate(state, i);
+                        if (values.size() != expected[i].size() ||
+                                (values - expected[i]).normInf() > 1e-12)
+                            ++numMismatches[t];
+                    }
+                }
+            } catch (const std::exception& e) {
+                errors[t] = e.what();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t = 0; t < numThreads; ++t) {
+        ASSERT(errors[t].empty(), __FILE__, __LINE__, errors[t]);
+        ASSERT(numMismatches[t] == 0, __FILE__, __LINE__,
+               "Thread " + std::to_string(t) + " got " +
+               std::to_string(numMismatches[t]) + " different results.");
+    }
+}
+
 void testMomentArmDefinitionForModel(const string &filename, const string &coordName, 
                                     const string &muscleName, SimTK::Vec2 rom,
                                     double mass, string errorMessage)
@@ -1377,6 +1377,66 @@ void testProbesUsingMillardMuscleSimulation()
 //==============================================================================
 //                                     MAIN
 //==============================================================================
+
+//==============================================================================
+//      TEST CHANGING PROBE PARAMETERS AFTER THE SYSTEM HAS BEEN CREATED
+//==============================================================================
+// The probes gather the parameters of their muscles when they are connected to
+// the model; changing a parameter through the probe's interface afterwards
+// must be reflected in the output, as if the system had been recreated.
+void testParametersChangedAfterInitSystem()
+{
+    Model model;
+    OpenSim::Body* block = new OpenSim::Body("block", 1.0, Vec3(0),
+                                             Inertia(1.0));
+    SliderJoint* slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    Millard2012EquilibriumMuscle* muscle = new Millard2012EquilibriumMuscle(
+        "muscle", 100, 0.1, 0.2, 0);
+    muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+    muscle->addNewPathPoint("insertion", *block, Vec3(0));
+    model.addForce(muscle);
+
+    Umberger2010MuscleMetabolicsProbe* umberger = new
+        Umberger2010MuscleMetabolicsProbe(true, true, false, true);
+    umberger->addMuscle("muscle", 0.5);
+    model.addProbe(umberger);
+    Bhargava2004MuscleMetabolicsProbe* bhargava = new
+        Bhargava2004MuscleMetabolicsProbe(true, true, true, false, true);
+    bhargava->addMuscle("muscle", 0.5, 40, 133, 74, 111);
+    model.addProbe(bhargava);
+
+    auto calcOutputs = [&](bool recreateSystem) {
+        SimTK::State s = recreateSystem ? model.initSystem()
+                                        : model.getWorkingState();
+        slider->updCoordinate().setValue(s, 0.31);
+        slider->updCoordinate().setSpeedValue(s, -0.1);
+        muscle->setActivation(s, 0.5);
+        model.equilibrateMuscles(s);
+        model.realizeDynamics(s);
+        return Vec2(umberger->getProbeOutputs(s)[0],
+                    bhargava->getProbeOutputs(s)[0]);
+    };
+
+    const Vec2 initial = calcOutputs(true);
+    umberger->setRatioSlowTwitchFibers("muscle", 0.9);
+    bhargava->setActivationConstantFastTwitch("muscle", 200);
+    const Vec2 changed = calcOutputs(false);
+    ASSERT(changed[0] != initial[0] && changed[1] != initial[1], __FILE__,
+        __LINE__, "Probe output did not change with the muscle parameters.");
+    ASSERT_EQUAL(calcOutputs(true), changed, 1e-12*(1 + changed.norm()),
+        __FILE__, __LINE__, "Probe output differs after recreating system.");
+
+    umberger->useProvidedMass("muscle", 2.0);
+    bhargava->useProvidedMass("muscle", 2.0);
+    const Vec2 provided = calcOutputs(false);
+    ASSERT(provided[0] != changed[0] && provided[1] != changed[1], __FILE__,
+        __LINE__, "Probe output did not change with the muscle mass.");
+    ASSERT_EQUAL(calcOutputs(true), provided, 1e-12*(1 + provided.norm()),
+        __FILE__, __LINE__, "Probe output differs after recreating system.");
+}
+
 void horizontalRule() { for(int i=0;i<80;++i) cout<<"*"; cout<<endl; }
 int main()
 {
@@ -1402,6 +1462,16 @@ int main()
         failures.push_back("testProbesUsingMillardMuscleSimulation");
     }
 
+    printf("\n"); horizontalRule();
+    cout << "Testing changes to probe parameters after initSystem" << endl;
+    horizontalRule();
+    try { testParametersChangedAfterInitSystem();
+        cout << "\ntestParametersChangedAfterInitSystem test passed\n" << endl;
+    } catch (const OpenSim::Exception& e) {
+        e.print(cerr);
+        failures.push_back("testParametersChangedAfterInitSystem");
+    }
+
     printf("\n"); horizontalRule(); horizontalRule();
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
@@ -618,5 +618,24 @@ void simulateMuscle(
         //    cout << "WARNING: Initial condition[" << i << "] for vector integration is not being correctly applied.\nThis is actually an error, but I have made it into a warning for now so that the test passes..." << endl;
     }
 
+    // The row of the values of all the probes holds each probe's outputs.
+    const ProbeSet& probes = model.getProbeSet();
+    std::vector<double> row(probes.getNumProbeOutputs());
+    probes.calcProbeOutputs(si, row.data());
+    int k = 0;
+    for (int i = 0; i < probes.getSize(); ++i) {
+        if (!probes[i].isEnabled()) continue;
+        const SimTK::Vector values = probes[i].getProbeOutputs(si);
+        for (int j = 0; j < values.size(); ++j, ++k)
+            ASSERT_EQUAL(values[j], row[k], 1e-12, __FILE__, __LINE__,
+                "ProbeSet::calcProbeOutputs() differs from " +
+                probes[i].getName() + ".");
+    }
+    ASSERT(k == int(row.size()), __FILE__, __LINE__,
+        "ProbeSet::getNumProbeOutputs() is not the number of probe outputs.");
+    ASSERT(probeReporter->getProbeStorage().getColumnLabels().getSize() ==
+           k + 1, __FILE__, __LINE__,
+        "ProbeReporter columns do not match the probe outputs.");
+
 
 }
@@ -24,9 +24,12 @@
 
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/StatesTrajectoryReporter.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 
+#include <cstdio>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
@@ -117,9 +120,192 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testReportingToFile() {
+    // Create a model consisting of a falling ball.
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    // Report to a file, in chunks smaller than the number of reports.
+    const std::string reportFile{"testReportersWithModel_report.sto"};
+    const std::string statesFile{"testReportersWithModel_states.sto"};
+    auto* reporter = new TableReporter();
+    reporter->set_report_time_interval(0.01);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"),
+                          "height");
+    reporter->setOutputFile(reportFile, 7, true);
+    model.addComponent(reporter);
+    auto* memoryReporter = new TableReporter();
+    memoryReporter->setName("memory_reporter");
+    memoryReporter->set_report_time_interval(0.01);
+    memoryReporter->addToReport(slider->getCoordinate().getOutput("value"),
+                                "height");
+    model.addComponent(memoryReporter);
+
+    State& state = model.initSystem();
+    Manager manager(model);
+    manager.setStatesFile(statesFile, 5);
+    state.setTime(0.0);
+    manager.initialize(state);
+    manager.integrate(0.5);
+    manager.integrate(1.0);
+    reporter->closeOutputFile();
+
+    // Nothing was kept in memory.
+    SimTK_TEST(reporter->getTable().getNumRows() == 0);
+    SimTK_TEST(manager.getStateStorage().getSize() == 0);
+
+    // The file has the same contents as the table of the other reporter.
+    const auto report = STOFileAdapter::read(reportFile);
+    const auto& expected = memoryReporter->getTable();
+    SimTK_TEST(report.getNumRows() == expected.getNumRows());
+    SimTK_TEST(report.getNumRows() > 50);
+    SimTK_TEST(report.getColumnLabels() ==
+               std::vector<std::string>({"height"}));
+    SimTK_TEST_EQ_TOL(report.getIndependentColumn().back(),
+                      expected.getIndependentColumn().back(), 1e-12);
+    SimTK_TEST_EQ_TOL(report.getMatrix(), expected.getMatrix(), 1e-12);
+
+    // The states file was written at the end of each integrate().
+    const auto states = STOFileAdapter::read(statesFile);
+    SimTK_TEST(states.getNumColumns() == 2);
+    SimTK_TEST_EQ(states.getIndependentColumn().back(), 1.0);
+    for (size_t i = 1; i < states.getNumRows(); ++i)
+        SimTK_TEST(states.getIndependentColumn()[i] >
+                   states.getIndependentColumn()[i - 1]);
+
+    std::remove(reportFile.c_str());
+    std::remove(statesFile.c_str());
+}
+
+void testSinglePrecision() {
+    Model model;
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    auto* reporter = new TableReporter();
+    reporter->set_report_time_interval(0.01);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    reporter->setSinglePrecision(true);
+    model.addComponent(reporter);
+    auto* doubleReporter = new TableReporter();
+    doubleReporter->setName("double_reporter");
+    doubleReporter->set_report_time_interval(0.01);
+    doubleReporter->addToReport(slider->getCoordinate().getOutput("value"));
+    model.addComponent(doubleReporter);
+
+    State& state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(1.0);
+
+    // The values are those of the double-precision report, rounded to
+    // floats.
+    const auto& table = reporter->getTable();
+    const auto& expected = doubleReporter->getTable();
+    SimTK_TEST(reporter->getSinglePrecision());
+    SimTK_TEST(table.getNumRows() == expected.getNumRows());
+    SimTK_TEST(table.getIndependentColumn() ==
+               expected.getIndependentColumn());
+    for (size_t r = 0; r < table.getNumRows(); ++r) {
+        SimTK_TEST(table.getMatrix()(int(r), 0) ==
+                   double(float(expected.getMatrix()(int(r), 0))));
+    }
+
+    // Reports made after getTable() are kept too.
+    manager.integrate(1.5);
+    SimTK_TEST(reporter->getTable().getNumRows() ==
+               doubleReporter->getTable().getNumRows());
+
+    // Vectors are reported as doubles, which cannot be kept as floats.
+    TableReporterVector vectorReporter;
+    SimTK_TEST_MUST_THROW_EXC(vectorReporter.setSinglePrecision(true),
+                              Exception);
+}
+
+void testCompression() {
+    Model model;
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    const double tolerance = 1e-4;
+    auto* reporter = new TableReporter();
+    reporter->set_report_time_interval(0.001);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    reporter->addToReport(slider->getCoordinate().getOutput("speed"));
+    reporter->setCompressionTolerance(tolerance);
+    model.addComponent(reporter);
+    auto* fullReporter = new TableReporter();
+    fullReporter->setName("full_reporter");
+    fullReporter->set_report_time_interval(0.001);
+    fullReporter->addToReport(slider->getCoordinate().getOutput("value"));
+    fullReporter->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(fullReporter);
+    auto* statesReporter = new StatesTrajectoryReporter();
+    statesReporter->setName("states_reporter");
+    statesReporter->set_report_time_interval(0.001);
+    statesReporter->setCompressionTolerance(tolerance);
+    model.addComponent(statesReporter);
+
+    State& state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(1.0);
+
+    // The falling ball's height is quadratic in time, and its speed is
+    // linear: few rows are kept, the first and last among them, and linear
+    // interpolation between them reproduces the full report.
+    const auto& table = reporter->getTable();
+    const auto& full = fullReporter->getTable();
+    const auto& times = table.getIndependentColumn();
+    const auto& fullTimes = full.getIndependentColumn();
+    SimTK_TEST(table.getNumRows() > 2);
+    SimTK_TEST(table.getNumRows() < full.getNumRows() / 4);
+    SimTK_TEST(times.front() == fullTimes.front());
+    SimTK_TEST(times.back() == fullTimes.back());
+    size_t k = 0;
+    for (size_t r = 0; r < full.getNumRows(); ++r) {
+        while (times[k + 1] < fullTimes[r]) ++k;
+        const double s = (fullTimes[r] - times[k]) / (times[k + 1] - times[k]);
+        for (int c = 0; c < 2; ++c) {
+            const double interpolated =
+                (1 - s) * table.getMatrix()(int(k), c) +
+                s * table.getMatrix()(int(k + 1), c);
+            SimTK_TEST_EQ_TOL(interpolated, full.getMatrix()(int(r), c),
+                              1.0001 * tolerance);
+        }
+    }
+
+    const auto& states = statesReporter->getStates();
+    SimTK_TEST(int(states.getSize()) < int(full.getNumRows()) / 4);
+    SimTK_TEST(states.front().getTime() == fullTimes.front());
+    SimTK_TEST(states.back().getTime() == fullTimes.back());
+
+    SimTK_TEST_MUST_THROW_EXC(reporter->setCompressionTolerance(-1.),
+                              Exception);
+    TableReporterVector vectorReporter;
+    SimTK_TEST_MUST_THROW_EXC(vectorReporter.setCompressionTolerance(1e-3),
+                              Exception);
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testReportingToFile);
+        SimTK_SUBTEST(testSinglePrecision);
+        SimTK_SUBTEST(testCompression);
     SimTK_END_TEST();
 };
@@ -531,6 +531,47 @@ void testFromStatesStorageAllRowsHaveSameLength() {
             StatesTrajectory::VaryingNumberOfStatesPerRow);
 }
 
+void testFromStatesStorageManyRows() {
+    // Enough rows for the trajectory to be filled on several threads, unless
+    // the values of some coordinates must be set through the model.
+    for (const bool clamped : {false, true}) {
+        Model model;
+        auto* body = new OpenSim::Body("body", 1, Vec3(0), Inertia(1));
+        model.addBody(body);
+        auto* joint = new SliderJoint("slider", model.getGround(), *body);
+        model.addJoint(joint);
+        auto& coord = joint->updCoordinate();
+        coord.setRangeMin(-1);
+        coord.setRangeMax(1);
+        coord.setDefaultClamped(clamped);
+        model.initSystem();
+
+        Storage sto;
+        Array<std::string> labels("time", 1);
+        labels.append("slider/" + coord.getName() + "/value");
+        labels.append("slider/" + coord.getName() + "/speed");
+        sto.setColumnLabels(labels);
+        const int numRows = 5000;
+        for (int i = 0; i < numRows; ++i) {
+            SimTK::Vector row(2);
+            row[0] = 2 * std::sin(0.001 * i);
+            row[1] = i;
+            sto.append(0.01 * i, row);
+        }
+
+        auto states = StatesTrajectory::createFromStatesStorage(model, sto);
+        SimTK_TEST(states.getSize() == (size_t)numRows);
+        SimTK_TEST(states.isConsistent());
+        for (int i = 0; i < numRows; ++i) {
+            const auto& state = states[i];
+            SimTK_TEST(state.getTime() == 0.01 * i);
+            double value = 2 * std::sin(0.001 * i);
+            if (clamped) value = std::max(-1.0, std::min(1.0, value));
+            SimTK_TEST(coord.getValue(state) == value);
+            SimTK_TEST(coord.getSpeedValue(state) == i);
+        }
+    }
+}
 
 void testCopying() {
     Model model("gait2354_simbody.osim");
@@ -788,6 +829,80 @@ void testExport() {
             OpenSim::Exception);
 }
 
+void testCompactStatesTrajectory() {
+    Model model("arm26.osim");
+    auto* reporter = new StatesTrajectoryReporter();
+    reporter->setName("reporter");
+    model.addComponent(reporter);
+    auto* fileReporter = new StatesTrajectoryReporter();
+    fileReporter->setName("file_reporter");
+    fileReporter->setOutputFile("testStatesTrajectory_compact.ostc");
+    model.addComponent(fileReporter);
+
+    auto& state = model.initSystem();
+    model.equilibrateMuscles(state);
+    SimTK::RungeKuttaMersonIntegrator integrator(model.getSystem());
+    SimTK::TimeStepper ts(model.getSystem(), integrator);
+    ts.initialize(state);
+    integrator.setReturnEveryInternalStep(true);
+    while (ts.getState().getTime() < 0.5) {
+        ts.stepTo(0.5);
+        model.getMultibodySystem().realize(ts.getState(), SimTK::Stage::Report);
+    }
+    fileReporter->closeOutputFile();
+    const StatesTrajectory& states = reporter->getStates();
+    // Enough states for several keyframes.
+    SimTK_TEST(states.getSize() > 2*CompactStatesTrajectory::KeyframeInterval);
+    SimTK_TEST(fileReporter->getStates().getSize() == 0);
+
+    // The compact trajectory reproduces the states exactly.
+    CompactStatesTrajectory compact(states);
+    SimTK_TEST(compact.getSize() == states.getSize());
+    SimTK_TEST(compact.getNumEncodedBytes() <
+               states.getSize()*states[0].getNY()*sizeof(double));
+    size_t i = 0;
+    for (const auto& s : compact) {
+        SimTK_TEST(s.getTime() == states[i].getTime());
+        SimTK_TEST_EQ(s.getY(), states[i].getY());
+        ++i;
+    }
+    SimTK_TEST(i == states.getSize());
+    const size_t mid = states.getSize() - 3;
+    SimTK_TEST_EQ(compact.getState(mid).getY(), states[mid].getY());
+    SimTK_TEST_MUST_THROW_EXC(compact.getState(states.getSize()),
+                              IndexOutOfRange);
+
+    // The rebuilt states can be used with the model.
+    const auto rebuilt = compact.getState(mid);
+    model.realizePosition(rebuilt);
+    model.realizePosition(states[mid]);
+    SimTK_TEST_EQ(model.calcMassCenterPosition(rebuilt),
+                  model.calcMassCenterPosition(states[mid]));
+
+    // Round trip through a file, and through the reporter's file.
+    compact.write("testStatesTrajectory_written.ostc");
+    for (const auto& fileName : {"testStatesTrajectory_written.ostc",
+                                 "testStatesTrajectory_compact.ostc"}) {
+        const auto fromFile =
+                CompactStatesTrajectory::createFromFile(model, fileName);
+        SimTK_TEST(fromFile.getSize() == states.getSize());
+        SimTK::Vector y;
+        for (size_t k = 0; k < states.getSize(); ++k) {
+            SimTK_TEST(fromFile.getTime(k) == states[k].getTime());
+            fromFile.getY(k, y);
+            SimTK_TEST_EQ(y, states[k].getY());
+        }
+    }
+
+    // States with a different number of state variables are rejected.
+    Model gait2354("gait2354_simbody.osim");
+    const auto& gaitState = gait2354.initSystem();
+    SimTK_TEST_MUST_THROW_EXC(compact.append(gaitState),
+                              StatesTrajectory::InconsistentState);
+    SimTK_TEST_MUST_THROW_EXC(CompactStatesTrajectory::createFromFile(
+            gait2354, "testStatesTrajectory_written.ostc"), Exception);
+}
+
 int main() {
     SimTK_START_TEST("testStatesTrajectory");
 
@@ -806,6 +921,7 @@ int main() {
         SimTK_SUBTEST(testIntegrityChecks);
         SimTK_SUBTEST(testAppendTimesAreNonDecreasing);
         SimTK_SUBTEST(testCopying);
+        SimTK_SUBTEST(testCompactStatesTrajectory);
 
         // Test creation of trajectory from a states storage.
         // -------------------------------------------------
@@ -819,6 +935,7 @@ int main() {
         SimTK_SUBTEST1(testFromStatesStorageInconsistentModel, statesStoFname);
         SimTK_SUBTEST(testFromStatesStorageUniqueColumnLabels);
         SimTK_SUBTEST(testFromStatesStorageAllRowsHaveSameLength);
+        SimTK_SUBTEST(testFromStatesStorageManyRows);
 
         // Export to data table.
         SimTK_SUBTEST(testExport);
@@ -0,0 +1,144 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  testSteadyStateAllocations.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//==============================================================================
+//  testSteadyStateAllocations counts the heap allocations made while
+//  evaluating the state derivatives of a model (as an integrator does for
+//  every step), once the model has been evaluated a few times.
+//  Tests Include:
+//      1. No allocations for path springs, ligaments and prescribed
+//         coordinate actuators.
+//      2. The number of allocations per evaluation for a muscle model
+//         (reported, not tested).
+//==============================================================================
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Auxiliary/getAllocationCount.h>
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Common/Constant.h>
+
+using namespace OpenSim;
+using namespace std;
+
+// The average number of allocations made for evaluating the accelerations at
+// numEvals different times and positions, after a few evaluations.
+double countAllocationsPerEvaluation(Model& model, SimTK::State& s,
+                                     int numEvals = 100)
+{
+    const SimTK::Vector q0 = s.getQ();
+    auto evaluate = [&](int i) {
+        s.setTime(0.01*i);
+        for (int j = 0; j < s.getNQ(); ++j)
+            s.updQ()[j] = q0[j] + 0.001*i;
+        model.realizeAcceleration(s);
+    };
+    for (int i = 0; i < 3; ++i) evaluate(i);
+
+    const size_t before = getAllocationCount();
+    for (int i = 3; i < 3 + numEvals; ++i) evaluate(i);
+    return double(getAllocationCount() - before)/numEvals;
+}
+
+void testPathForcesAndPrescribedControls()
+{
+    using SimTK::Vec3;
+
+    Model model;
+    auto* block = new OpenSim::Body("block", 1.0, Vec3(0),
+                                    SimTK::Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *block, Vec3(0), Vec3(0));
+    slider->updCoordinate().setName("x");
+    slider->updCoordinate().setDefaultValue(0.5);
+    model.addBody(block);
+    model.addJoint(slider);
+
+    auto* spring = new PathSpring("spring", 1.0, 10.0, 0.1);
+    spring->updGeometryPath().appendNewPathPoint("origin", model.getGround(),
+                                                 Vec3(-1, 0, 0));
+    spring->updGeometryPath().appendNewPathPoint("insertion", *block, Vec3(0));
+    model.addForce(spring);
+
+    auto* ligament = new Ligament();
+    ligament->setName("ligament");
+    ligament->set_resting_length(1.2);
+    ligament->set_pcsa_force(100.0);
+    ligament->updGeometryPath().appendNewPathPoint("origin",
+            model.getGround(), Vec3(-1, 0.1, 0));
+    ligament->updGeometryPath().appendNewPathPoint("insertion", *block,
+                                                   Vec3(0));
+    model.addForce(ligament);
+
+    auto* actuator = new CoordinateActuator("x");
+    actuator->setName("actuator");
+    model.addForce(actuator);
+    auto* controller = new PrescribedController();
+    controller->addActuator(*actuator);
+    controller->prescribeControlForActuator("actuator", new Constant(0.5));
+    model.addController(controller);
+
+    SimTK::State& s = model.initSystem();
+    const double allocations = countAllocationsPerEvaluation(model, s);
+    cout << "Allocations per evaluation: " << allocations << endl;
+    ASSERT(ligament->getTension(s) > 0);
+    ASSERT(allocations == 0, __FILE__, __LINE__,
+           "Expected no allocations in steady state.");
+}
+
+void reportMuscleModelAllocations()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    model.equilibrateMuscles(s);
+    cout << "arm26: allocations per evaluation: "
+         << countAllocationsPerEvaluation(model, s) << endl;
+}
+
+int main()
+{
+    if (!isAllocationCountingComplete()) {
+        cout << "Allocations in libraries cannot be counted on this "
+                "platform; skipping." << endl;
+        return 0;
+    }
+
+    SimTK::Array_<std::string> failures;
+
+    try { testPathForcesAndPrescribedControls(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testPathForcesAndPrescribedControls");
+    }
+    try { reportMuscleModelAllocations(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("reportMuscleModelAllocations");
+    }
+
+    if (!failures.empty()) {
+        cout << "Done, with failure(s): " << failures << endl;
+        return 1;
+    }
+
+    cout << "Done, testSteadyStateAllocations passed." << endl;
+    return 0;
+}
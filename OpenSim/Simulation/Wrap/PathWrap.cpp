@@ -63,7 +63,6 @@ PathWrap::~PathWrap()
  */
 void PathWrap::setNull()
 {
-    resetPreviousWrap();
 }
 
 //_____________________________________________________________________________
@@ -136,25 +135,41 @@ void PathWrap::setEndPoint( const SimTK::State& s, int aIndex)
     }
 }
 
-void PathWrap::resetPreviousWrap()
+void PathWrap::extendAddToSystem(SimTK::MultibodySystem& system) const
 {
-    _previousWrap.startPoint = -1;
-    _previousWrap.endPoint = -1;
+    Super::extendAddToSystem(system);
 
-    _previousWrap.wrap_pts.setSize(0);
-    _previousWrap.wrap_path_length = 0.0;
+    // A default WrapResult has infinite tangent points (no previous wrap).
+    _previousWrapCV = addCacheVariable("previous_wrap", WrapResult(),
+                                       SimTK::Stage::Topology);
+}
+
+const WrapResult& PathWrap::getPreviousWrap(const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _previousWrapCV);
+}
+
+void PathWrap::resetPreviousWrap(const SimTK::State& s) const
+{
+    WrapResult& previousWrap = updCacheVariableValue(s, _previousWrapCV);
+    previousWrap.startPoint = -1;
+    previousWrap.endPoint = -1;
+
+    previousWrap.wrap_pts.setSize(0);
+    previousWrap.wrap_path_length = 0.0;
 
     int i;
     for (i = 0; i < 3; i++) {
-        _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
     }
 }
 
-void PathWrap::setPreviousWrap(const WrapResult& aWrapResult)
+void PathWrap::setPreviousWrap(const SimTK::State& s,
+                               const WrapResult& aWrapResult) const
 {
-    _previousWrap = aWrapResult;
+    updCacheVariableValue(s, _previousWrapCV) = aWrapResult;
 }
 
 void PathWrap::setWrapObject(WrapObject& aWrapObject)
@@ -111,13 +111,19 @@ public:
     void setMethod(WrapMethod aMethod);
     const std::string& getMethodName() const { return get_method(); }
 
-    const WrapResult& getPreviousWrap() const { return _previousWrap; }
-    void setPreviousWrap(const WrapResult& aWrapResult);
-    void resetPreviousWrap();
+    /** The result of the previous wrapping of the path over the wrap object
+    in this State (or in the State it was copied from), which the wrap object
+    may use as the starting point of the next wrapping; its tangent points
+    are infinite if the path did not wrap. */
+    const WrapResult& getPreviousWrap(const SimTK::State& s) const;
+    void setPreviousWrap(const SimTK::State& s,
+                         const WrapResult& aWrapResult) const;
+    void resetPreviousWrap(const SimTK::State& s) const;
 
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void setNull();
 
 private:
@@ -126,7 +132,10 @@ private:
     const WrapObject* _wrapObject;
     const GeometryPath* _path;
 
-    WrapResult _previousWrap;  // results from previous wrapping
+    // Results from the previous wrapping. The wrapping is computed when
+    // the path is, but the result is kept for the next computation, so the
+    // cache entry is never marked valid (as for scratch space).
+    mutable CacheVariable<WrapResult> _previousWrapCV;
 
     MemberSubcomponentIndex _wrapPoint1Ix{
         constructSubcomponent<PathWrapPoint>("pwpt1") };
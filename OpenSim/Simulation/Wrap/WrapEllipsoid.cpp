@@ -48,6 +48,36 @@ static const char* wrapTypeName = "ellipsoid";
 #define NUM_DISPLAY_SAMPLES   30
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
+#define WARM_START_SEED_TOL   0.05     // max. residuals of a tangent point seed (normalized)
+#define WARM_START_TOL        1e-3     // max. residuals of a warm-started tangent point
+
+namespace {
+    // Whether r (all quantities normalized) is within `tol` of being a point
+    // of the ellipsoid (m, a) in the wrapping plane (vs, vs4) whose tangent
+    // passes through p, on the same side of the line through p and m as c1.
+    bool isNearTangentPoint(const Vec3& r, const Vec3& p, const Vec3& c1,
+                            const Vec3& m, const Vec3& a, const Vec3& vs,
+                            double vs4, double tol)
+    {
+        if (!r.isFinite())
+            return false;
+
+        double onSurface = -1.0;
+        Vec3 normal;
+        for (int i = 0; i < 3; i++) {
+            onSurface += SQR((r[i] - m[i]) / a[i]);
+            normal[i] = (r[i] - m[i]) / SQR(a[i]);
+        }
+        const double inPlane = ~vs*r + vs4;
+        const Vec3 rp = p - r;
+        const double tangency = ~normal*rp / (normal.norm()*rp.norm());
+
+        const double side = ~((r - p) % (m - p))*vs;
+        const double c1Side = ~((c1 - p) % (m - p))*vs;
+        return fabs(onSurface) < tol && fabs(inPlane) < tol &&
+               fabs(tangency) < tol && side*c1Side > 0.0;
+    }
+}
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -231,6 +261,21 @@ WrapEllipsoid& WrapEllipsoid::operator=(const WrapEllipsoid& aWrapEllipsoid)
 //=============================================================================
 // WRAPPING
 //=============================================================================
+//_____________________________________________________________________________
+/**
+ * Find the line segments that may wrap over the ellipsoid: wrapLine() does
+ * not wrap a segment whose endpoints are outside of the ellipsoid unless the
+ * segment crosses the ellipsoid.
+ *
+ * @param segments The line segments, in the frame of the ellipsoid
+ * @param mayWrap 0 for each segment that cannot wrap, 1 otherwise
+ */
+void WrapEllipsoid::findSegmentsThatMayWrap(
+        const WrapMath::SegmentBatch& segments, char* mayWrap) const
+{
+    WrapMath::IntersectLineSegsEllipsoid(segments, getRadii(), mayWrap);
+}
+
 //_____________________________________________________________________________
 /**
  * Calculate the wrapping of one line segment over the ellipsoid.
@@ -256,7 +301,7 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     // In case you need any variables from the previous wrap, copy them from
     // the PathWrap into the WrapResult, re-normalizing the ones that were
     // un-normalized at the end of the previous wrap calculation.
-    const WrapResult& previousWrap = aPathWrap.getPreviousWrap();
+    const WrapResult& previousWrap = aPathWrap.getPreviousWrap(s);
     aWrapResult.factor = previousWrap.factor;
     for (i = 0; i < 3; i++)
     {
@@ -594,9 +639,33 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 
     vs4 = - Mtx::DotProduct(3, vs, aWrapResult.c1);
 
-    // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    // find r1 & r2 by starting at c1 moving toward p1 & p2. The tangent
+    // points move continuously with the path, so if the previous wrap (in
+    // this State) was of the same path segment and its tangent points are
+    // still close to the solution, start from them instead; fall back to
+    // starting at c1 if they are far off or lead elsewhere.
+    {
+        const bool samePathSegment =
+            previousWrap.startPoint == aWrapResult.startPoint &&
+            previousWrap.endPoint == aWrapResult.endPoint;
+        auto findTangentPoint = [&](double pe, Vec3& r, Vec3& p,
+                                    const Vec3& previous) {
+            const Vec3 coldStart = r;
+            const Vec3 seed = previous * aWrapResult.factor;
+            if (samePathSegment && isNearTangentPoint(seed, p,
+                    aWrapResult.c1, m, a, vs, vs4, WARM_START_SEED_TOL)) {
+                r = seed;
+                calcTangentPoint(pe, r, p, m, a, vs, vs4);
+                if (fabs(pe) < 0.0001 || isNearTangentPoint(r, p,
+                        aWrapResult.c1, m, a, vs, vs4, WARM_START_TOL))
+                    return;
+                r = coldStart;
+            }
+            calcTangentPoint(pe, r, p, m, a, vs, vs4);
+        };
+        findTangentPoint(p1e, aWrapResult.r1, p1, previousWrap.r1);
+        findTangentPoint(p2e, aWrapResult.r2, p2, previousWrap.r2);
+    }
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
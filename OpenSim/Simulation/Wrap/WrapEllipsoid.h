@@ -78,6 +78,12 @@ public:
     const char* getWrapTypeName() const override;
     std::string getDimensionsString() const override;
         SimTK::Vec3 getRadii() const;
+    /** The largest radius of the ellipsoid; segments that miss the ellipsoid
+    never wrap. */
+    double getBoundingRadius() const override {
+        const SimTK::Vec3 radii = getRadii();
+        return std::max(radii[0], std::max(radii[1], radii[2]));
+    }
 
     /** Scale the ellipsoid's dimensions. The base class (WrapObject) scales the
         origin of the ellipsoid in the body's reference frame. */
@@ -87,6 +93,11 @@ public:
 protected:
     int wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
         const PathWrap& aPathWrap, WrapResult& aWrapResult, bool& aFlag) const override;
+#ifndef SWIG
+    /** Segments wrap only if they intersect the ellipsoid. */
+    void findSegmentsThatMayWrap(const WrapMath::SegmentBatch& segments,
+                                 char* mayWrap) const override;
+#endif
     /// Implement generateDecorations to draw geometry in visualizer
     void generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
         SimTK::Array_<SimTK::DecorativeGeometry>& appendToThis) const override;
@@ -30,6 +30,7 @@
 //=============================================================================
 #include <math.h>
 #include "WrapMath.h"
+#include <algorithm>
 #include <OpenSim/Common/Mtx.h>
 #include <OpenSim/Common/SimmMacros.h>
 
@@ -343,3 +344,92 @@ RotateMatrixQuaternion(double matrix[][4], const double quat[4])
 
     Mtx::Multiply(4, 4, 4, (double*)matrix, (double*)n, (double*)matrix);
 }
+
+//=============================================================================
+// BATCHED GEOMETRY
+//=============================================================================
+// The loops below avoid branches and calls so that the compiler can process
+// several segments per instruction.
+
+void WrapMath::
+ShiftSegmentsToFrame(const SimTK::Transform& X_BF, SegmentBatch& segments)
+{
+    // p_F = R_FB (p_B - p_BF)
+    const Mat33 R_FB = ~X_BF.R().asMat33();
+    const Vec3& o = X_BF.p();
+    const int n = segments.size();
+    auto shift = [&](double* x, double* y, double* z) {
+        for (int i = 0; i < n; ++i) {
+            const double dx = x[i] - o[0], dy = y[i] - o[1], dz = z[i] - o[2];
+            x[i] = R_FB(0,0)*dx + R_FB(0,1)*dy + R_FB(0,2)*dz;
+            y[i] = R_FB(1,0)*dx + R_FB(1,1)*dy + R_FB(1,2)*dz;
+            z[i] = R_FB(2,0)*dx + R_FB(2,1)*dy + R_FB(2,2)*dz;
+        }
+    };
+    shift(segments.x1.data(), segments.y1.data(), segments.z1.data());
+    shift(segments.x2.data(), segments.y2.data(), segments.z2.data());
+}
+
+void WrapMath::
+CalcDistanceSquaredSegmentsToPoint(const SegmentBatch& segments,
+                                   const SimTK::Vec3& point, double* distSqr)
+{
+    const double* x1 = segments.x1.data();
+    const double* y1 = segments.y1.data();
+    const double* z1 = segments.z1.data();
+    const double* x2 = segments.x2.data();
+    const double* y2 = segments.y2.data();
+    const double* z2 = segments.z2.data();
+    const int n = segments.size();
+    for (int i = 0; i < n; ++i) {
+        const double px = x1[i] - point[0];
+        const double py = y1[i] - point[1];
+        const double pz = z1[i] - point[2];
+        const double dx = x2[i] - x1[i];
+        const double dy = y2[i] - y1[i];
+        const double dz = z2[i] - z1[i];
+        const double lengthSqr = dx*dx + dy*dy + dz*dz;
+        // The closest point is p1 + t (p2 - p1), with t clamped to [0, 1];
+        // t = 0 for a segment of zero length.
+        const double t = std::min(1.0, std::max(0.0,
+                -(px*dx + py*dy + pz*dz)/std::max(lengthSqr, SimTK::TinyReal)));
+        const double cx = px + t*dx, cy = py + t*dy, cz = pz + t*dz;
+        distSqr[i] = cx*cx + cy*cy + cz*cz;
+    }
+}
+
+void WrapMath::
+IntersectLineSegsEllipsoid(const SegmentBatch& segments,
+                           const SimTK::Vec3& radii, char* mayIntersect)
+{
+    // The tolerances are looser than those of WrapEllipsoid::wrapLine(), so
+    // that a segment it would wrap is never rejected here.
+    const double insideTol = 1e-4;
+    const double paramTol = 1e-9;
+    const double ia = 1/radii[0], ib = 1/radii[1], ic = 1/radii[2];
+    const double* x1 = segments.x1.data();
+    const double* y1 = segments.y1.data();
+    const double* z1 = segments.z1.data();
+    const double* x2 = segments.x2.data();
+    const double* y2 = segments.y2.data();
+    const double* z2 = segments.z2.data();
+    const int n = segments.size();
+    for (int i = 0; i < n; ++i) {
+        // In the coordinates of the unit sphere, the line is p1 + l d, and
+        // it crosses the sphere where A l^2 + B l + C = 0.
+        const double px = x1[i]*ia, py = y1[i]*ib, pz = z1[i]*ic;
+        const double qx = x2[i]*ia, qy = y2[i]*ib, qz = z2[i]*ic;
+        const double dx = qx - px, dy = qy - py, dz = qz - pz;
+        const double A = dx*dx + dy*dy + dz*dz;
+        const double B = 2*(px*dx + py*dy + pz*dz);
+        const double C = px*px + py*py + pz*pz - 1;
+        const double C2 = qx*qx + qy*qy + qz*qz - 1;
+        const double disc = B*B - 4*A*C;
+        // With both endpoints outside, both roots are between the endpoints
+        // if and only if the roots are real and their mean is.
+        const double mean = -B/std::max(2*A, SimTK::TinyReal);
+        mayIntersect[i] = char((C < insideTol) | (C2 < insideTol) |
+                ((disc >= -paramTol*B*B) & (mean > -paramTol) &
+                 (mean < 1 + paramTol)));
+    }
+}
@@ -30,6 +30,8 @@
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <SimTKcommon/SmallMatrix.h>
 
+#include <vector>
+
 
 namespace OpenSim { 
 
@@ -74,6 +76,49 @@ public:
     static void
         RotateMatrixQuaternion(double matrix[][4], const double quat[4]); 
 
+//=============================================================================
+// BATCHED METHODS
+//=============================================================================
+    /**
+     * A batch of line segments (p1->p2), stored coordinate by coordinate so
+     * that the batched methods below, whose loops have no branches, can be
+     * vectorized by the compiler.
+     */
+    struct SegmentBatch {
+        void resize(int n) {
+            for (auto* c : {&x1, &y1, &z1, &x2, &y2, &z2}) c->resize(n);
+        }
+        int size() const { return int(x1.size()); }
+        void set(int i, const SimTK::Vec3& p1, const SimTK::Vec3& p2) {
+            x1[i] = p1[0]; y1[i] = p1[1]; z1[i] = p1[2];
+            x2[i] = p2[0]; y2[i] = p2[1]; z2[i] = p2[2];
+        }
+        SimTK::Vec3 getPoint1(int i) const
+        {   return SimTK::Vec3(x1[i], y1[i], z1[i]); }
+        SimTK::Vec3 getPoint2(int i) const
+        {   return SimTK::Vec3(x2[i], y2[i], z2[i]); }
+        std::vector<double> x1, y1, z1, x2, y2, z2;
+    };
+
+    /** Express the points of the segments, given in frame B, in frame F,
+    with X_BF the transform of F in B. */
+    static void
+        ShiftSegmentsToFrame(const SimTK::Transform& X_BF,
+        SegmentBatch& segments);
+    /** The square of the distance from each segment to a point
+    (distSqr must have room for segments.size() values). */
+    static void
+        CalcDistanceSquaredSegmentsToPoint(const SegmentBatch& segments,
+        const SimTK::Vec3& point, double* distSqr);
+    /** Whether each segment may intersect the surface of the ellipsoid
+    centered at the origin with the provided semi-axes: 1 if an endpoint is
+    inside the ellipsoid (or nearly on its surface) or if the line crosses
+    the surface twice between the endpoints, within a small tolerance;
+    0 otherwise. */
+    static void
+        IntersectLineSegsEllipsoid(const SegmentBatch& segments,
+        const SimTK::Vec3& radii, char* mayIntersect);
+
 
 //=============================================================================
 };  // END class WrapMath
@@ -30,6 +30,8 @@
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
 #include <OpenSim/Common/ScaleSet.h>
 
+#include <algorithm>
+
 
 //=============================================================================
 // STATICS
@@ -143,8 +145,6 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
                                 const PathWrap& aPathWrap, 
                                 WrapResult& aWrapResult) const
 {
-   int return_code = noWrap;
-    bool p_flag;
     Vec3 pt1(0.0);
     Vec3 pt2(0.0);
 
@@ -161,7 +161,85 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
     pt1 = _pose.shiftBaseStationToFrame(pt1);
     pt2 = _pose.shiftBaseStationToFrame(pt2);
 
-    return_code = wrapLine(s, pt1, pt2, aPathWrap, aWrapResult, p_flag);
+    // Broad phase: the path segment cannot wrap if it does not come within the
+    // bounding radius of the origin of the wrap object.
+    const double boundingRadius = getBoundingRadius();
+    if (boundingRadius < SimTK::Infinity) {
+        const Vec3 p1p2 = pt2 - pt1;
+        const double lengthSqr = p1p2.normSqr();
+        const double t = lengthSqr > 0
+            ? SimTK::clamp(0.0, -(~pt1*p1p2)/lengthSqr, 1.0) : 0.0;
+        if ((pt1 + t*p1p2).normSqr() > boundingRadius*boundingRadius) {
+            ComponentProfiler::count(aPathWrap,
+                                     ComponentProfiler::CullWrapPathSegment);
+            aWrapResult.wrap_path_length = 0.0;
+            aWrapResult.wrap_pts.setSize(0);
+            return noWrap;
+        }
+    }
+
+    return calcWrapping(s, pt1, pt2, aPathWrap, aWrapResult);
+}
+
+void WrapObject::wrapPathSegments(const SimTK::State& s,
+                                  const WrapMath::SegmentBatch& segments,
+                                  const std::vector<const PathWrap*>& pathWraps,
+                                  std::vector<WrapResult>& wrapResults,
+                                  std::vector<int>& returnCodes) const
+{
+    const int n = segments.size();
+    OPENSIM_THROW_IF_FRMOBJ(int(pathWraps.size()) != n, Exception,
+        "Expected one PathWrap per segment, but there are " +
+        std::to_string(n) + " segments and " +
+        std::to_string(pathWraps.size()) + " PathWraps.");
+
+    WrapMath::SegmentBatch inWrapFrame = segments;
+    WrapMath::ShiftSegmentsToFrame(_pose, inWrapFrame);
+    std::vector<char> mayWrap(n);
+    findSegmentsThatMayWrap(inWrapFrame, mayWrap.data());
+
+    wrapResults.resize(n);
+    returnCodes.assign(n, noWrap);
+    for (int i = 0; i < n; ++i) {
+        WrapResult& wr = wrapResults[i];
+        if (!mayWrap[i]) {
+            ComponentProfiler::count(*pathWraps[i],
+                                     ComponentProfiler::CullWrapPathSegment);
+            wr.wrap_path_length = 0.0;
+            wr.wrap_pts.setSize(0);
+            continue;
+        }
+        Vec3 pt1 = inWrapFrame.getPoint1(i);
+        Vec3 pt2 = inWrapFrame.getPoint2(i);
+        returnCodes[i] = calcWrapping(s, pt1, pt2, *pathWraps[i], wr);
+    }
+}
+
+void WrapObject::findSegmentsThatMayWrap(const WrapMath::SegmentBatch& segments,
+                                         char* mayWrap) const
+{
+    const int n = segments.size();
+    const double boundingRadius = getBoundingRadius();
+    if (boundingRadius == SimTK::Infinity) {
+        std::fill(mayWrap, mayWrap + n, char(1));
+        return;
+    }
+    std::vector<double> distSqr(n);
+    WrapMath::CalcDistanceSquaredSegmentsToPoint(segments, Vec3(0),
+                                                 distSqr.data());
+    const double radiusSqr = boundingRadius*boundingRadius;
+    for (int i = 0; i < n; ++i)
+        mayWrap[i] = char(distSqr[i] <= radiusSqr);
+}
+
+int WrapObject::calcWrapping(const SimTK::State& s, Vec3& pt1, Vec3& pt2,
+                             const PathWrap& aPathWrap,
+                             WrapResult& aWrapResult) const
+{
+    bool p_flag;
+    ComponentProfiler::Scope scope(aPathWrap, ComponentProfiler::WrapLine);
+    const int return_code =
+        wrapLine(s, pt1, pt2, aPathWrap, aWrapResult, p_flag);
 
    if (p_flag == true && return_code > 0) {
         // Convert the tangent points from the frame of the wrap object to the
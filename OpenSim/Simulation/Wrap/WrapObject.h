@@ -26,6 +26,7 @@
 // INCLUDE
 #include <OpenSim/Simulation/Model/ModelComponent.h>
 #include <OpenSim/Simulation/Model/Appearance.h>
+#include "WrapMath.h"
 namespace OpenSim {
 
 class PathWrap;
@@ -114,11 +115,21 @@ public:
     // TODO: total SIMM hack!
     virtual std::string getDimensionsString() const { return ""; }
 
+    /** The radius of a sphere, centered at the origin of the wrap object's
+    frame, such that no path segment that stays outside of the sphere can
+    wrap over the object. wrapPathSegment() skips the wrapping computation
+    for such segments. The default, infinity, disables this test; it is
+    overridden only by wrap objects whose wrapping requires the segment to
+    intersect the object's surface. */
+    virtual double getBoundingRadius() const { return SimTK::Infinity; }
+
 //=============================================================================
 // WRAPPING
 //=============================================================================
 /**
-* Calculate the wrapping of one path segment over one wrap object.
+* Calculate the wrapping of one path segment over one wrap object. Segments
+* that do not come within getBoundingRadius() of the wrap object are not
+* wrapped (noWrap) without computing the wrapping.
 * @param state   The State of the model
 * @param aPoint1 The first path point
 * @param aPoint2 The second path point
@@ -131,7 +142,38 @@ public:
                          const PathWrap& aPathWrap,
                          WrapResult& aWrapResult) const;
 
+#ifndef SWIG
+/**
+* Calculate the wrapping of several path segments (e.g., of several paths)
+* over this wrap object. The segments that cannot wrap are first found for
+* all segments together (see findSegmentsThatMayWrap()), and the wrapping is
+* then calculated for each of the others, as by wrapPathSegment().
+* @param state   The State of the model
+* @param segments The endpoints of the segments, expressed in the frame to
+*                 which the wrap object is attached (getFrame())
+* @param pathWraps The PathWrap of each segment
+* @param wrapResults The result of the wrapping of each segment; resized to
+*                 the number of segments. The startPoint and endPoint of each
+*                 result (if already set) are left unchanged.
+* @param returnCodes The status of each segment, as a WrapAction enum
+*/
+    void wrapPathSegments(const SimTK::State& state,
+                          const WrapMath::SegmentBatch& segments,
+                          const std::vector<const PathWrap*>& pathWraps,
+                          std::vector<WrapResult>& wrapResults,
+                          std::vector<int>& returnCodes) const;
+#endif
+
 protected:
+#ifndef SWIG
+    /** For segments expressed in the frame of the wrap object, set
+    mayWrap[i] to 0 if segment i cannot wrap over the object (wrapLine()
+    would return noWrap), and to 1 otherwise. The default uses
+    getBoundingRadius(). */
+    virtual void findSegmentsThatMayWrap(const WrapMath::SegmentBatch& segments,
+                                         char* mayWrap) const;
+#endif
+
     virtual int wrapLine(const SimTK::State& state,
                          SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
                          const PathWrap& aPathWrap,
@@ -153,6 +195,13 @@ protected:
 private:
     void constructProperties();
 
+    // Calculate the wrapping of a segment expressed in the frame of the
+    // wrap object, and express the results in the frame of its body.
+    int calcWrapping(const SimTK::State& state,
+                     SimTK::Vec3& point1, SimTK::Vec3& point2,
+                     const PathWrap& aPathWrap,
+                     WrapResult& aWrapResult) const;
+
     SimTK::ReferencePtr<const PhysicalFrame> _frame;
 
 protected:
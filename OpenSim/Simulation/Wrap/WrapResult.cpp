@@ -39,7 +39,15 @@ using namespace OpenSim;
 /**
  * Default constructor.
  */
-WrapResult::WrapResult()
+WrapResult::WrapResult() :
+    startPoint(-1),
+    endPoint(-1),
+    wrap_path_length(0.0),
+    r1(-SimTK::Infinity),
+    r2(-SimTK::Infinity),
+    c1(0.0),
+    sv(-SimTK::Infinity),
+    factor(1.0)
 {
 }
 
@@ -61,6 +69,7 @@ void WrapResult::copyData(const WrapResult& aWrapResult)
 {
     wrap_pts = aWrapResult.wrap_pts;
     wrap_path_length = aWrapResult.wrap_path_length;
+    factor = aWrapResult.factor;
 
     startPoint = aWrapResult.startPoint;
     endPoint = aWrapResult.endPoint;
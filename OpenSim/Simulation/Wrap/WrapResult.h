@@ -68,6 +68,14 @@ public:
     void copyData(const WrapResult& aWrapResult);
     WrapResult& operator=(const WrapResult& aWrapResult);
 
+#ifndef SWIG
+    // Required for holding a WrapResult in a cache variable.
+    friend std::ostream& operator<<(std::ostream& o, const WrapResult& wr) {
+        o << "WrapResult r1 = " << wr.r1 << ", r2 = " << wr.r2;
+        return o;
+    }
+#endif
+
 //=============================================================================
 };  // END of class WrapResult
 //=============================================================================
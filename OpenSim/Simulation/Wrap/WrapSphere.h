@@ -69,6 +69,8 @@ public:
     void copyData(const WrapSphere& aWrapSphere);
     const char* getWrapTypeName() const override;
     std::string getDimensionsString() const override;
+    /** The radius of the sphere; segments that miss the sphere never wrap. */
+    double getBoundingRadius() const override { return getRadius(); }
     double getRadius() const;
 
     /** Scale the sphere by the average of the scale factors in each direction.
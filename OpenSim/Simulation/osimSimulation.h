@@ -27,6 +27,7 @@
 #include "Model/Bhargava2004MuscleMetabolicsProbe.h"
 #include "Model/Model.h"
 #include "Model/ModelVisualizer.h"
+#include "Model/ModelRenderer.h"
 #include "Model/ForceSet.h"
 #include "Model/BodyScale.h"
 #include "Model/BodyScaleSet.h"
@@ -40,6 +41,7 @@
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
+#include "Model/SphereHalfSpaceContactForce.h"
 #include "Model/Ligament.h"
 #include "Model/JointSet.h"
 #include "Model/Marker.h"
@@ -50,6 +52,7 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/PolynomialPathSurrogate.h"
 #include "Model/PrescribedForce.h"
 #include "Model/PointToPointSpring.h"
 #include "Model/ExpressionBasedPointToPointForce.h"
@@ -71,6 +74,7 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/EnsembleManager.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
@@ -111,15 +115,21 @@
 #include "SimbodyEngine/SpatialTransform.h"
 
 #include "AssemblySolver.h"
+#include "BatchModelEvaluator.h"
 #include "CoordinateReference.h"
 #include "InverseDynamicsSolver.h"
 #include "InverseKinematicsSolver.h"
 #include "MarkersReference.h"
+#include "OrientationsReference.h"
 #include "MomentArmSolver.h"
+#include "MuscleTendonKinematics.h"
+#include "PrescribedCoordinatesSimulation.h"
 #include "Reference.h"
 #include "Solver.h"
+#include "StreamingInverseKinematicsSolver.h"
 #include "StatesTrajectory.h"
 #include "StatesTrajectoryReporter.h"
+#include "CompactStatesTrajectory.h"
 
 #include "SimulationUtilities.h"
 
@@ -0,0 +1,230 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  testMemoryBudgets.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Runs one standard workload, named on the command line, and fails if the
+// peak resident set size of the process grows by more than the workload's
+// budget while it runs. Each workload runs in its own process (see
+// CMakeLists.txt), since the peak belongs to the process.
+//
+// The budgets have headroom over the peaks of current builds; lower a budget
+// when a change reduces the memory of its workload, so that the reduction is
+// kept. Run without arguments to run all workloads in one process, which only
+// prints their peaks.
+
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Common/MemoryUsage.h>
+#include <OpenSim/Tools/AnalyzeTool.h>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+using namespace OpenSim;
+using namespace std;
+
+namespace {
+const size_t MB = 1024*1024;
+const char* fullBodyModel = "gait10dof18musc_subject01.osim";
+const int NumClones = 10;
+const int NumIKFrames = 10000;
+
+// Load and initialize a full-body model.
+void load()
+{
+    Model model(fullBodyModel);
+    model.initSystem();
+}
+
+// Keep initialized clones of a full-body model, as for parallel work.
+void clone()
+{
+    Model model(fullBodyModel);
+    model.initSystem();
+    vector<unique_ptr<Model>> clones;
+    for (int i = 0; i < NumClones; ++i) {
+        clones.emplace_back(model.clone());
+        clones.back()->initSystem();
+    }
+}
+
+// Simulate arm26 for 10 s, reporting the states and the muscle forces every
+// 10 ms.
+void forward()
+{
+    Model model("arm26.osim");
+    auto* forces = new TableReporter();
+    forces->setName("forces");
+    forces->set_report_time_interval(0.01);
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        forces->addToReport(muscle.getOutput("fiber_force"));
+    model.addComponent(forces);
+    auto* states = new StatesTrajectoryReporter();
+    states->setName("states");
+    states->set_report_time_interval(0.01);
+    model.addComponent(states);
+
+    SimTK::State& s = model.initSystem();
+    model.equilibrateMuscles(s);
+    Manager manager(model);
+    manager.initialize(s);
+    manager.integrate(10.0);
+}
+
+// Track NumIKFrames frames of the markers of a full-body model.
+void ik()
+{
+    Model model(fullBodyModel);
+    SimTK::State s = model.initSystem();
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    const MarkerSet& markerSet = model.getMarkerSet();
+
+    // Markers of a model whose coordinates oscillate about their defaults.
+    vector<string> labels;
+    for (int k = 0; k < markerSet.getSize(); ++k)
+        labels.push_back(markerSet[k].getName());
+    TimeSeriesTable_<SimTK::Vec3> markers;
+    markers.setColumnLabels(labels);
+    SimTK::RowVector_<SimTK::Vec3> row(markerSet.getSize());
+    for (int i = 0; i < NumIKFrames; ++i) {
+        const double time = 0.01*i;
+        for (int j = 0; j < coordinates.getSize(); ++j) {
+            if (coordinates[j].getLocked(s)) continue;
+            coordinates[j].setValue(s, coordinates[j].getDefaultValue() +
+                    0.1*std::sin(2*SimTK::Pi*time + j), false);
+        }
+        model.realizePosition(s);
+        for (int k = 0; k < markerSet.getSize(); ++k)
+            row[k] = markerSet[k].getLocationInGround(s);
+        markers.appendRow(time, row);
+    }
+
+    MarkersReference markersRef(markers);
+    SimTK::Array_<CoordinateReference> coordinateRefs;
+    InverseKinematicsSolver ikSolver(model, markersRef, coordinateRefs);
+    const auto& times = markers.getIndependentColumn();
+    TimeSeriesTable solution;
+    vector<string> coordinateNames;
+    for (int j = 0; j < coordinates.getSize(); ++j)
+        coordinateNames.push_back(coordinates[j].getName());
+    solution.setColumnLabels(coordinateNames);
+    SimTK::RowVector values(coordinates.getSize());
+    for (size_t i = 0; i < times.size(); ++i) {
+        s.updTime() = times[i];
+        if (i == 0) ikSolver.assemble(s);
+        else ikSolver.track(s);
+        for (int j = 0; j < coordinates.getSize(); ++j)
+            values[j] = coordinates[j].getValue(s);
+        solution.appendRow(times[i], values);
+    }
+}
+
+// Solve static optimization for 10 s of arm26 motion.
+void so()
+{
+    Model model("arm26.osim");
+    model.addAnalysis(new StaticOptimization(&model));
+
+    Storage coordinates(1024, "coordinates");
+    Array<string> labels("time", 3);
+    labels[1] = "r_shoulder_elev";
+    labels[2] = "r_elbow_flex";
+    coordinates.setColumnLabels(labels);
+    coordinates.setInDegrees(false);
+    for (int i = 0; i <= 1000; ++i) {
+        const double time = 0.01*i;
+        const double q[2] = {0.2 + 0.1*std::sin(SimTK::Pi*time/5),
+                             0.8 + 0.5*std::sin(SimTK::Pi*time/5)};
+        coordinates.append(time, 2, q);
+    }
+
+    AnalyzeTool tool(model);
+    tool.setName("memoryBudget");
+    tool.setLoadModelAndInput(true);
+    tool.setCoordinateValues(coordinates);
+    tool.setInitialTime(0.0);
+    tool.setFinalTime(10.0);
+    tool.setResultsDir("Results_memoryBudget");
+    tool.setPrintResultFiles(false);
+    tool.run();
+}
+
+struct Workload {
+    const char* name;
+    void (*run)();
+    size_t budget;
+};
+
+const Workload workloads[] = {
+    {"load",    load,    150*MB},
+    {"clone",   clone,   400*MB},
+    {"forward", forward, 150*MB},
+    {"ik",      ik,      250*MB},
+    {"so",      so,      150*MB},
+};
+
+// The growth of the peak resident set size while the workload runs.
+size_t measure(const Workload& workload)
+{
+    const size_t baseline = MemoryUsage::getCurrentProcessMemory();
+    workload.run();
+    const size_t peak = MemoryUsage::getPeakProcessMemory();
+    const size_t growth = peak > baseline ? peak - baseline : 0;
+    cout << workload.name << ": peak grew by " << growth/MB << " MB (budget "
+         << workload.budget/MB << " MB)." << endl;
+    return growth;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 2) {
+            for (const auto& workload : workloads) measure(workload);
+            cout << "Done" << endl;
+            return 0;
+        }
+        for (const auto& workload : workloads) {
+            if (std::strcmp(argv[1], workload.name) != 0) continue;
+            if (MemoryUsage::getPeakProcessMemory() == 0) {
+                cout << "The resident set size is not available on this "
+                        "platform; not checked." << endl;
+                workload.run();
+                return 0;
+            }
+            if (measure(workload) > workload.budget) {
+                cout << "Failed: " << workload.name
+                     << " exceeded its memory budget." << endl;
+                return 1;
+            }
+            cout << "Done" << endl;
+            return 0;
+        }
+        cout << "Unknown workload '" << argv[1] << "'." << endl;
+        return 1;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,218 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  benchMtxKernels.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Compares the matrix routines of Mtx (Multiply(), Transpose() and Invert())
+// with reference implementations: the scalar loops Mtx used before it used
+// Lapack and cache-friendly kernels (for Invert(), InvertByElimination()
+// against InvertWithLapack()). For each size of square matrix, it reports
+// the mean time of a call of each, the speedup of Mtx, and fails if the
+// results differ. Run with --help for the options.
+
+#include <OpenSim/Common/Mtx.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace OpenSim;
+using namespace std;
+
+namespace {
+const char* HELP =
+R"(Usage: benchMtxKernels [options]
+
+Options:
+  --max-size=<n>  Largest matrices, with n rows and columns (default: 256).
+                  The sizes are 3, 4, 8, 16, ..., and <n>.
+  --quick         Run few calls, on matrices of up to 32 rows (for testing).
+)";
+
+bool quick = false;
+
+// The scalar loops of Mtx::Multiply() before it used Lapack: one dot
+// product of a row and a (strided) column per element.
+void referenceMultiply(int nr1, int ncr, int nc2, const double* m1,
+                       const double* m2, double* r)
+{
+    for (int r1 = 0; r1 < nr1; ++r1) {
+        for (int c2 = 0; c2 < nc2; ++c2) {
+            const double* ij1 = m1 + r1*ncr;
+            const double* ij2 = m2 + c2;
+            double result = 0.0;
+            for (int cr = 0; cr < ncr; ++cr, ++ij1, ij2 += nc2)
+                result += (*ij1)*(*ij2);
+            r[r1*nc2 + c2] = result;
+        }
+    }
+}
+
+// The scalar loops of Mtx::Transpose() before it was blocked.
+void referenceTranspose(int nr, int nc, const double* m, double* t)
+{
+    for (int r = 0; r < nr; ++r)
+        for (int c = 0; c < nc; ++c)
+            t[c*nr + r] = m[r*nc + c];
+}
+
+// Mean seconds per call of f, over enough calls to take about 10 ms.
+template <typename F>
+double timeCall(F f, int n)
+{
+    const double work = double(n)*n*n + 100;
+    const int calls = std::max(1, int((quick ? 1e5 : 1e7)/work));
+    const auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < calls; ++k) f();
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count()/calls;
+}
+
+double maxDifference(const vector<double>& a, const vector<double>& b)
+{
+    double difference = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        difference = std::max(difference, std::abs(a[i] - b[i]));
+    return difference;
+}
+
+struct Result {
+    string kernel;
+    int size;
+    double referenceTime;
+    double mtxTime;
+    double difference;
+};
+
+// Time and compare the kernels on n x n matrices.
+void compare(int n, std::mt19937& random, vector<Result>& results)
+{
+    // A well-conditioned matrix (diagonally dominant), and another.
+    std::uniform_real_distribution<double> uniform(-1, 1);
+    vector<double> a(n*n), b(n*n), reference(n*n), mtx(n*n);
+    for (int i = 0; i < n*n; ++i) {
+        a[i] = uniform(random);
+        b[i] = uniform(random);
+    }
+    for (int i = 0; i < n; ++i) a[i*n + i] += n;
+
+    Result multiply{"Multiply", n};
+    multiply.referenceTime = timeCall([&] {
+        referenceMultiply(n, n, n, a.data(), b.data(), reference.data());
+    }, n);
+    multiply.mtxTime = timeCall([&] {
+        Mtx::Multiply(n, n, n, a.data(), b.data(), mtx.data());
+    }, n);
+    multiply.difference = maxDifference(reference, mtx)/n;
+    results.push_back(multiply);
+
+    Result transpose{"Transpose", n};
+    transpose.referenceTime = timeCall([&] {
+        referenceTranspose(n, n, a.data(), reference.data());
+    }, 1);
+    transpose.mtxTime = timeCall([&] {
+        Mtx::Transpose(n, n, a.data(), mtx.data());
+    }, 1);
+    transpose.difference = maxDifference(reference, mtx);
+    results.push_back(transpose);
+
+    Result invert{"Invert", n};
+    invert.referenceTime = timeCall([&] {
+        Mtx::InvertByElimination(n, a.data(), reference.data());
+    }, n);
+    invert.mtxTime = timeCall([&] {
+        Mtx::InvertWithLapack(n, a.data(), mtx.data());
+    }, n);
+    invert.difference = maxDifference(reference, mtx);
+    results.push_back(invert);
+}
+
+const char* optionValue(const char* arg, const char* name)
+{
+    const size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=')
+        return nullptr;
+    return arg + length + 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int maxSize = 256;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value;
+        if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+            cout << HELP;
+            return 0;
+        } else if ((value = optionValue(arg, "--max-size"))) {
+            maxSize = std::atoi(value);
+        } else if (!std::strcmp(arg, "--quick")) {
+            quick = true;
+            maxSize = 32;
+        } else {
+            cout << "Unknown option '" << arg << "'." << endl << HELP;
+            return 1;
+        }
+    }
+    if (maxSize < 1) {
+        cout << "Invalid options." << endl << HELP;
+        return 1;
+    }
+    vector<int> sizes;
+    for (int n : {3, 4}) if (n < maxSize) sizes.push_back(n);
+    for (int n = 8; n < maxSize; n *= 2) sizes.push_back(n);
+    sizes.push_back(maxSize);
+
+    std::mt19937 random(0);
+    vector<Result> results;
+    for (int n : sizes) compare(n, random, results);
+
+    // Relative to the magnitude of the results (of order 1).
+    const double tolerance = 1e-10;
+    int numFailed = 0;
+    cout << left << setw(10) << "kernel" << right << setw(6) << "size"
+         << setw(16) << "reference (us)" << setw(12) << "Mtx (us)"
+         << setw(10) << "speedup" << endl;
+    for (const Result& result : results) {
+        cout << left << setw(10) << result.kernel << right << setw(6)
+             << result.size << fixed << setprecision(3)
+             << setw(16) << 1e6*result.referenceTime
+             << setw(12) << 1e6*result.mtxTime << setprecision(2)
+             << setw(10) << result.referenceTime/result.mtxTime;
+        if (!(result.difference <= tolerance)) {
+            cout << "  differs by " << scientific << result.difference;
+            ++numFailed;
+        }
+        cout << endl;
+    }
+    if (numFailed) {
+        cout << "Failed: " << numFailed << " kernel(s) differ from the "
+                "reference." << endl;
+        return 1;
+    }
+    return 0;
+}
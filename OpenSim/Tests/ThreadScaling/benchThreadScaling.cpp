@@ -0,0 +1,591 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  benchThreadScaling.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Runs each parallel workload of OpenSim on 1, 2, 4, ... threads, up to
+// --max-threads, and reports the mean and standard deviation of its wall
+// time, its speedup over one thread, and its parallel efficiency (speedup
+// divided by the number of threads). With --trace, the spans of the Tracer
+// are recorded, and the spans whose mean duration grows with the number of
+// threads (i.e., threads contend in them, e.g., for a lock, the allocator
+// or memory bandwidth) are reported as hotspots. Run with --help for the
+// options.
+
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Analyses/MuscleAnalysis.h>
+#include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Common/Sine.h>
+#include <OpenSim/Common/TRCFileAdapter.h>
+#include <OpenSim/Tools/AnalyzeTool.h>
+#include <OpenSim/Tools/InverseKinematicsTool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenSim;
+using namespace std;
+
+namespace {
+const char* HELP =
+R"(Usage: benchThreadScaling [options]
+
+Options:
+  --max-threads=<n>  Largest number of threads (default: the number of
+                     hardware threads). Each workload runs on 1, 2, 4, ...
+                     threads, and on <n>.
+  --repeat=<n>       Number of runs at each number of threads (default: 3).
+  --filter=<text>    Only run the workloads whose names contain <text>.
+  --format=<fmt>     table, csv or json (default: table).
+  --output=<file>    Write the results to <file> rather than to the console.
+  --trace            Record the Tracer's spans, and report the spans whose
+                     mean duration grows with the number of threads.
+  --quick            Run small versions of the workloads (for testing).
+
+Workloads:
+  ensemble     EnsembleManager: simulate 32 arm26 members.
+  ik           InverseKinematicsTool: 400 frames of a full-body model.
+  id           InverseDynamicsSolver: 5000 frames of a full-body model.
+  analyze      AnalyzeTool with a MuscleAnalysis: 500 frames, full body.
+  so           AnalyzeTool with StaticOptimization: 1000 frames of arm26.
+  equilibrate  Model::equilibrateMuscles(): 20 times, full body.
+  forces       Model::setNumForceThreads(): simulate a full body for 0.2 s.
+  paths        computeMuscleTendonKinematics(): 2000 frames, full body.
+)";
+
+const char* fullBodyModel = "gait10dof18musc_subject01.osim";
+bool quick = false;
+
+// The number of frames (or members) of a workload; much fewer with --quick.
+int size(int full) { return quick ? std::max(full/50, 6) : full; }
+
+// Discards what the workloads print.
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override
+    {   return n; }
+};
+
+// Time the enclosing scope.
+class Stopwatch {
+public:
+    Stopwatch(double& seconds)
+    :   _seconds(seconds), _start(std::chrono::steady_clock::now()) {}
+    ~Stopwatch() {
+        _seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - _start).count();
+    }
+private:
+    double& _seconds;
+    std::chrono::steady_clock::time_point _start;
+};
+
+// Set the unlocked coordinates of a model to oscillate about their defaults.
+void setPose(const Model& model, SimTK::State& s, double time)
+{
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    for (int j = 0; j < coordinates.getSize(); ++j) {
+        if (coordinates[j].getLocked(s)) continue;
+        coordinates[j].setValue(s, coordinates[j].getDefaultValue() +
+                0.1*std::sin(2*SimTK::Pi*time + j), false);
+    }
+}
+
+// Poses of a model at 100 Hz, as a table of coordinate values (radians).
+TimeSeriesTable makePoses(Model& model, int numFrames)
+{
+    SimTK::State s = model.initSystem();
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    vector<string> labels;
+    for (int j = 0; j < coordinates.getSize(); ++j)
+        labels.push_back(coordinates[j].getName());
+    TimeSeriesTable poses;
+    poses.setColumnLabels(labels);
+    SimTK::RowVector row(coordinates.getSize());
+    for (int i = 0; i < numFrames; ++i) {
+        setPose(model, s, 0.01*i);
+        for (int j = 0; j < coordinates.getSize(); ++j)
+            row[j] = coordinates[j].getValue(s);
+        poses.appendRow(0.01*i, row);
+    }
+    return poses;
+}
+
+// The same poses as a Storage, for the AnalyzeTool.
+Storage makePosesStorage(Model& model, int numFrames)
+{
+    const TimeSeriesTable poses = makePoses(model, numFrames);
+    Storage storage(numFrames, "coordinates");
+    Array<string> labels("time", 1);
+    for (const auto& label : poses.getColumnLabels()) labels.append(label);
+    storage.setColumnLabels(labels);
+    storage.setInDegrees(false);
+    vector<double> values(poses.getNumColumns());
+    for (int i = 0; i < numFrames; ++i) {
+        const auto row = poses.getRowAtIndex(i);
+        for (int j = 0; j < row.size(); ++j) values[j] = row[j];
+        storage.append(poses.getIndependentColumn()[i], int(values.size()),
+                       values.data());
+    }
+    return storage;
+}
+
+double ensemble(int numThreads)
+{
+    Model model("arm26.osim");
+    model.finalizeFromProperties();
+    const string elbow = model.getCoordinateSet().get("r_elbow_flex")
+            .getAbsolutePathString() + "/value";
+    EnsembleManager ensemble(model);
+    ensemble.setNumThreads(numThreads);
+    const int numMembers = quick ? 4 : 32;
+    for (int i = 0; i < numMembers; ++i) {
+        EnsembleManager::Member member;
+        member.stateVariableValues[elbow] = 0.2 + 1.2*i/numMembers;
+        ensemble.addMember(member);
+    }
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        ensemble.integrate(0, quick ? 0.05 : 0.5);
+    }
+    OPENSIM_THROW_IF(!ensemble.getFailures().empty(), Exception,
+            "A member of the ensemble failed: " +
+            ensemble.getFailures().begin()->second);
+    return seconds;
+}
+
+double ik(int numThreads)
+{
+    Model model(fullBodyModel);
+    SimTK::State s = model.initSystem();
+    const MarkerSet& markerSet = model.getMarkerSet();
+
+    // Markers of the model in the poses.
+    vector<string> labels;
+    for (int k = 0; k < markerSet.getSize(); ++k)
+        labels.push_back(markerSet[k].getName());
+    TimeSeriesTable_<SimTK::Vec3> markers;
+    markers.setColumnLabels(labels);
+    markers.addTableMetaData("DataRate", string("100"));
+    markers.addTableMetaData("Units", string("m"));
+    SimTK::RowVector_<SimTK::Vec3> row(markerSet.getSize());
+    const int numFrames = size(400);
+    for (int i = 0; i < numFrames; ++i) {
+        setPose(model, s, 0.01*i);
+        model.realizePosition(s);
+        for (int k = 0; k < markerSet.getSize(); ++k)
+            row[k] = markerSet[k].getLocationInGround(s);
+        markers.appendRow(0.01*i, row);
+    }
+    TRCFileAdapter::write(markers, "threadScaling_markers.trc");
+
+    InverseKinematicsTool tool;
+    tool.setModel(model);
+    tool.setMarkerDataFileName("threadScaling_markers.trc");
+    tool.setStartTime(0);
+    tool.setEndTime(0.01*(numFrames - 1));
+    tool.setOutputMotionFileName("threadScaling_ik.mot");
+    tool.setNumThreads(numThreads);
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        OPENSIM_THROW_IF(!tool.run(), Exception, "IK failed.");
+    }
+    return seconds;
+}
+
+double id(int numThreads)
+{
+    Model model(fullBodyModel);
+    SimTK::State& s = model.initSystem();
+    for (int i = 0; i < model.getForceSet().getSize(); ++i)
+        model.getForceSet()[i].setAppliesForce(s, false);
+    FunctionSet qs;
+    for (int i = 0; i < s.getNQ(); ++i)
+        qs.adoptAndAppend(new Sine(0.1, 2*SimTK::Pi, i));
+    SimTK::Array_<double> times;
+    for (int i = 0; i < size(5000); ++i) times.push_back(0.001*i);
+
+    InverseDynamicsSolver solver(model);
+    solver.setNumThreads(numThreads);
+    SimTK::Array_<SimTK::Vector> forces;
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        solver.solve(s, qs, times, forces);
+    }
+    return seconds;
+}
+
+// Run an analysis over poses of a model with the AnalyzeTool.
+double analyzePoses(Model& model, int numFrames, int numThreads)
+{
+    Model poseModel(model);
+    const Storage poses = makePosesStorage(poseModel, numFrames);
+    AnalyzeTool tool(model);
+    tool.setName("threadScaling");
+    tool.setLoadModelAndInput(true);
+    tool.setCoordinateValues(poses);
+    tool.setInitialTime(0);
+    tool.setFinalTime(0.01*(numFrames - 1));
+    tool.setResultsDir("Results_threadScaling");
+    tool.setPrintResultFiles(false);
+    tool.setNumThreads(numThreads);
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        OPENSIM_THROW_IF(!tool.run(), Exception, "The analysis failed.");
+    }
+    return seconds;
+}
+
+double analyze(int numThreads)
+{
+    Model model(fullBodyModel);
+    model.addAnalysis(new MuscleAnalysis(&model));
+    return analyzePoses(model, size(500), numThreads);
+}
+
+double so(int numThreads)
+{
+    Model model("arm26.osim");
+    model.addAnalysis(new StaticOptimization(&model));
+    return analyzePoses(model, size(1000), numThreads);
+}
+
+double equilibrate(int numThreads)
+{
+    Model model(fullBodyModel);
+    SimTK::State& s = model.initSystem();
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        for (int i = 0; i < (quick ? 1 : 20); ++i)
+            model.equilibrateMuscles(s, false, numThreads);
+    }
+    return seconds;
+}
+
+double forces(int numThreads)
+{
+    Model model(fullBodyModel);
+    model.setNumForceThreads(numThreads);
+    SimTK::State& s = model.initSystem();
+    model.equilibrateMuscles(s);
+    Manager manager(model);
+    manager.initialize(s);
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        manager.integrate(quick ? 0.01 : 0.2);
+    }
+    return seconds;
+}
+
+double paths(int numThreads)
+{
+    Model model(fullBodyModel);
+    Model poseModel(model);
+    const TimeSeriesTable poses = makePoses(poseModel, size(2000));
+    double seconds;
+    {
+        Stopwatch stopwatch(seconds);
+        computeMuscleTendonKinematics(model, poses, {}, numThreads);
+    }
+    return seconds;
+}
+
+struct Workload {
+    const char* name;
+    double (*run)(int numThreads);
+};
+
+const Workload workloads[] = {
+    {"ensemble",    ensemble},
+    {"ik",          ik},
+    {"id",          id},
+    {"analyze",     analyze},
+    {"so",          so},
+    {"equilibrate", equilibrate},
+    {"forces",      forces},
+    {"paths",       paths},
+};
+
+// The runs of a workload on a number of threads.
+struct Result {
+    string workload;
+    int numThreads;
+    vector<double> times;
+    vector<Tracer::SpanTotal> spans;
+    double speedup = 1;
+
+    double mean() const {
+        double sum = 0;
+        for (double t : times) sum += t;
+        return sum/times.size();
+    }
+    double stddev() const {
+        if (times.size() < 2) return 0;
+        const double m = mean();
+        double sum = 0;
+        for (double t : times) sum += (t - m)*(t - m);
+        return std::sqrt(sum/(times.size() - 1));
+    }
+    double min() const { return *std::min_element(times.begin(), times.end()); }
+    double efficiency() const { return speedup/numThreads; }
+};
+
+// A span whose mean duration on several threads is much longer than on one.
+struct Hotspot {
+    string workload;
+    int numThreads;
+    string span;
+    double meanSeconds;
+    double ratio;
+};
+
+// Spans are compared only if they are frequent and long enough to be timed.
+const int HotspotMinCount = 5;
+const double HotspotMinSeconds = 1e-5;
+const double HotspotRatio = 1.5;
+
+vector<Hotspot> findHotspots(const vector<Result>& results)
+{
+    vector<Hotspot> hotspots;
+    for (const Result& result : results) {
+        if (result.numThreads == 1) continue;
+        const auto serial = std::find_if(results.begin(), results.end(),
+            [&](const Result& r) {
+                return r.workload == result.workload && r.numThreads == 1; });
+        if (serial == results.end()) continue;
+        for (const auto& span : result.spans) {
+            if (span.count < HotspotMinCount) continue;
+            for (const auto& serialSpan : serial->spans) {
+                if (serialSpan.category != span.category ||
+                        serialSpan.name != span.name) continue;
+                const double serialMean = serialSpan.seconds/serialSpan.count;
+                const double mean = span.seconds/span.count;
+                if (serialSpan.count < HotspotMinCount ||
+                        serialMean < HotspotMinSeconds ||
+                        mean < HotspotRatio*serialMean) continue;
+                hotspots.push_back({result.workload, result.numThreads,
+                        span.category + "/" + span.name, mean,
+                        mean/serialMean});
+            }
+        }
+    }
+    return hotspots;
+}
+
+void printTable(ostream& out, const vector<Result>& results,
+        const vector<Hotspot>& hotspots, bool traced)
+{
+    out << left << setw(14) << "workload" << right << setw(8) << "threads"
+        << setw(12) << "mean (s)" << setw(12) << "stddev (s)"
+        << setw(10) << "speedup" << setw(12) << "efficiency" << endl;
+    for (const Result& r : results) {
+        out << left << setw(14) << r.workload << right << setw(8)
+            << r.numThreads << fixed << setprecision(4) << setw(12)
+            << r.mean() << setw(12) << r.stddev() << setprecision(2)
+            << setw(10) << r.speedup << setw(12) << r.efficiency() << endl;
+    }
+    if (!traced) return;
+    out << endl << "Contention hotspots (spans at least " << HotspotRatio
+        << " times slower than on 1 thread): " << hotspots.size() << endl;
+    for (const Hotspot& h : hotspots) {
+        out << "  " << h.workload << " on " << h.numThreads << " threads: "
+            << h.span << ", " << setprecision(1) << 1e6*h.meanSeconds
+            << " us per span (" << setprecision(2) << h.ratio << "x)" << endl;
+    }
+}
+
+void printCSV(ostream& out, const vector<Result>& results,
+        const vector<Hotspot>& hotspots, bool traced)
+{
+    out << setprecision(6)
+        << "workload,threads,repeats,mean,stddev,min,speedup,efficiency"
+        << endl;
+    for (const Result& r : results) {
+        out << r.workload << "," << r.numThreads << "," << r.times.size()
+            << "," << r.mean() << "," << r.stddev() << "," << r.min() << ","
+            << r.speedup << "," << r.efficiency() << endl;
+    }
+    if (!traced) return;
+    out << endl << "workload,threads,span,mean_span_time,ratio" << endl;
+    for (const Hotspot& h : hotspots) {
+        out << h.workload << "," << h.numThreads << "," << h.span << ","
+            << h.meanSeconds << "," << h.ratio << endl;
+    }
+}
+
+void printJSON(ostream& out, const vector<Result>& results,
+        const vector<Hotspot>& hotspots, bool traced)
+{
+    out << setprecision(6) << "{\"hardware_threads\": "
+        << std::thread::hardware_concurrency() << ", \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? ",\n" : "\n") << "  {\"workload\": \"" << r.workload
+            << "\", \"threads\": " << r.numThreads << ", \"times\": [";
+        for (size_t k = 0; k < r.times.size(); ++k)
+            out << (k ? ", " : "") << r.times[k];
+        out << "], \"mean\": " << r.mean() << ", \"stddev\": " << r.stddev()
+            << ", \"variance\": " << r.stddev()*r.stddev()
+            << ", \"speedup\": " << r.speedup << ", \"efficiency\": "
+            << r.efficiency() << "}";
+    }
+    out << "\n]";
+    if (traced) {
+        out << ", \"hotspots\": [";
+        for (size_t i = 0; i < hotspots.size(); ++i) {
+            const Hotspot& h = hotspots[i];
+            out << (i ? ",\n" : "\n") << "  {\"workload\": \"" << h.workload
+                << "\", \"threads\": " << h.numThreads << ", \"span\": \""
+                << h.span << "\", \"mean_span_time\": " << h.meanSeconds
+                << ", \"ratio\": " << h.ratio << "}";
+        }
+        out << "\n]";
+    }
+    out << "}" << endl;
+}
+
+// The value of an option of the form --name=value, or nullptr.
+const char* optionValue(const char* arg, const char* name)
+{
+    const size_t n = std::strlen(name);
+    if (std::strncmp(arg, name, n) != 0 || arg[n] != '=') return nullptr;
+    return arg + n + 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 3;
+    string filter, format = "table", output;
+    bool traced = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value;
+        if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+            cout << HELP;
+            return 0;
+        } else if ((value = optionValue(arg, "--max-threads"))) {
+            maxThreads = std::atoi(value);
+        } else if ((value = optionValue(arg, "--repeat"))) {
+            repeat = std::atoi(value);
+        } else if ((value = optionValue(arg, "--filter"))) {
+            filter = value;
+        } else if ((value = optionValue(arg, "--format"))) {
+            format = value;
+        } else if ((value = optionValue(arg, "--output"))) {
+            output = value;
+        } else if (!std::strcmp(arg, "--trace")) {
+            traced = true;
+        } else if (!std::strcmp(arg, "--quick")) {
+            quick = true;
+        } else {
+            cout << "Unknown option '" << arg << "'." << endl << HELP;
+            return 1;
+        }
+    }
+    if (maxThreads < 1 || repeat < 1 ||
+            (format != "table" && format != "csv" && format != "json")) {
+        cout << "Invalid options." << endl << HELP;
+        return 1;
+    }
+    vector<int> threadCounts;
+    for (int n = 1; n < maxThreads; n *= 2) threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    vector<Result> results;
+    int numFailed = 0;
+    NullBuffer nullBuffer;
+    for (const Workload& workload : workloads) {
+        if (string(workload.name).find(filter) == string::npos) continue;
+        for (int numThreads : threadCounts) {
+            cerr << "Running " << workload.name << " on " << numThreads
+                 << " thread(s)." << endl;
+            Result result;
+            result.workload = workload.name;
+            result.numThreads = numThreads;
+            Tracer::clear();
+            Tracer::setEnabled(traced);
+            std::streambuf* coutBuffer = cout.rdbuf(&nullBuffer);
+            try {
+                for (int k = 0; k < repeat; ++k)
+                    result.times.push_back(workload.run(numThreads));
+            } catch (const std::exception& e) {
+                cout.rdbuf(coutBuffer);
+                cerr << workload.name << " failed: " << e.what() << endl;
+                ++numFailed;
+                Tracer::setEnabled(false);
+                break;
+            }
+            cout.rdbuf(coutBuffer);
+            Tracer::setEnabled(false);
+            if (traced) result.spans = Tracer::getSpanTotals();
+            results.push_back(result);
+        }
+    }
+    Tracer::clear();
+
+    // Speedups are relative to the first (1-thread) result of each workload.
+    for (Result& result : results) {
+        for (const Result& serial : results) {
+            if (serial.workload == result.workload &&
+                    serial.numThreads == 1) {
+                result.speedup = serial.mean()/result.mean();
+                break;
+            }
+        }
+    }
+    const vector<Hotspot> hotspots = findHotspots(results);
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            cout << "Could not open '" << output << "'." << endl;
+            return 1;
+        }
+    }
+    ostream& out = output.empty() ? cout : file;
+    if (format == "csv") printCSV(out, results, hotspots, traced);
+    else if (format == "json") printJSON(out, results, hotspots, traced);
+    else printTable(out, results, hotspots, traced);
+
+    if (numFailed) {
+        cout << numFailed << " workload(s) failed." << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
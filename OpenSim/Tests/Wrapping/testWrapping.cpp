@@ -47,6 +47,9 @@ public:
 };
 
 void testWrapCylinder();
+void testWrapEllipsoidWarmStart();
+void testWrapSphereCulling();
+void testWrapPathSegments();
 void testWrapObjectUpdateFromXMLNode30515();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
@@ -67,6 +70,27 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("TestShoulderModel (multiple wrap)"); }
 
+    try{
+        testWrapEllipsoidWarmStart();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapEllipsoidWarmStart");
+    }
+
+    try{
+        testWrapSphereCulling();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapSphereCulling");
+    }
+
+    try{
+        testWrapPathSegments();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapPathSegments");
+    }
+
     try{
         testWrapObjectUpdateFromXMLNode30515();
     } catch (const std::exception& e) {
@@ -405,6 +429,149 @@ void testWrapCylinder()
 }
 
 
+// The lengths of a path wrapping over an ellipsoid, with the tangent points
+// seeded from the previous wrap as the knee flexes, match those from a cold
+// start (with the previous wrap reset).
+void testWrapEllipsoidWarmStart()
+{
+    Model model("test_wrapEllipsoid_vasint.osim");
+    State& s = model.initSystem();
+    const Coordinate& knee = model.getCoordinateSet().get("knee_angle_r");
+    const GeometryPath& path =
+        model.getMuscles().get("vas_int_r").getGeometryPath();
+
+    const int numSteps = 50;
+    for (int i = 0; i <= numSteps; ++i) {
+        knee.setValue(s, knee.getRangeMin() +
+            i*(knee.getRangeMax() - knee.getRangeMin())/numSteps);
+        const double warmLength = path.getLength(s);
+
+        State cold = s;
+        cold.invalidateAllCacheAtOrAbove(Stage::Position);
+        for (int j = 0; j < path.getWrapSet().getSize(); ++j)
+            path.getWrapSet().get(j).resetPreviousWrap(cold);
+        model.realizePosition(cold);
+        ASSERT_EQUAL(path.getLength(cold), warmLength, 1e-6, __FILE__,
+            __LINE__, "Warm-started wrap length differs at knee angle " +
+            std::to_string(knee.getValue(s)) + ".");
+    }
+}
+
+// Path segments far from a wrap sphere are culled without computing the
+// wrapping; segments that cross the sphere are still wrapped.
+void testWrapSphereCulling()
+{
+    const double r = 0.1;
+    Model model;
+    model.setName("testWrapSphereCulling");
+
+    auto& ground = model.updGround();
+    auto body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1));
+    model.addBody(body);
+    auto slider = new SliderJoint("slider", ground, *body);
+    model.addJoint(slider);
+
+    auto sphere = new WrapSphere();
+    sphere->setName("sphere");
+    sphere->set_radius(r);
+    ground.addWrapObject(sphere);
+
+    auto spring = new PathSpring("spring", 1.0, 0.1, 0.01);
+    spring->updGeometryPath().appendNewPathPoint("origin", ground,
+                                                 Vec3(0.05, -0.5, 0));
+    spring->updGeometryPath().appendNewPathPoint("insert", *body,
+                                                 Vec3(0, 0.5, 0));
+    spring->updGeometryPath().addPathWrap(*sphere);
+    model.addForce(spring);
+
+    State& s = model.initSystem();
+    const Coordinate& x = slider->getCoordinate();
+    const GeometryPath& path = spring->getGeometryPath();
+    const PathWrap& pathWrap = path.getWrapSet().get(0);
+    auto countOf = [&](ComponentProfiler::Operation op) {
+        for (const auto& record : ComponentProfiler::getSummary(model)) {
+            if (record.componentPath == pathWrap.getAbsolutePathString() &&
+                    record.operation == op)
+                return record.count;
+        }
+        return 0ull;
+    };
+
+    ComponentProfiler::setEnabled(true);
+
+    // The straight line passes 0.05 from the center of the sphere.
+    x.setValue(s, 0.05);
+    ASSERT(path.getLength(s) > 1.0);
+    ASSERT(countOf(ComponentProfiler::WrapLine) == 1);
+    ASSERT(countOf(ComponentProfiler::CullWrapPathSegment) == 0);
+
+    // The straight line is far from the sphere.
+    x.setValue(s, 1.0);
+    ASSERT_EQUAL(path.getLength(s), (Vec3(1.0, 1.0, 0) -
+            Vec3(0.05, 0, 0)).norm(), 1e-12);
+    ASSERT(countOf(ComponentProfiler::WrapLine) == 1);
+    ASSERT(countOf(ComponentProfiler::CullWrapPathSegment) == 1);
+
+    ComponentProfiler::setEnabled(false);
+    ComponentProfiler::reset(model);
+}
+
+// Wrapping segments in a batch gives the same tangent points as wrapping
+// them one at a time, and a batch only computes the segments that can wrap.
+void testWrapPathSegments()
+{
+    Model model("test_wrapEllipsoid_vasint.osim");
+    State& s = model.initSystem();
+    const Coordinate& knee = model.getCoordinateSet().get("knee_angle_r");
+    const GeometryPath& path =
+        model.getMuscles().get("vas_int_r").getGeometryPath();
+    const PathWrap& pathWrap = path.getWrapSet().get(0);
+    const WrapObject& wrapObject = *pathWrap.getWrapObject();
+    const Frame& frame = wrapObject.getFrame();
+    auto inWrapFrame = [&](const AbstractPathPoint& point) {
+        return point.getParentFrame().findStationLocationInAnotherFrame(s,
+                point.getLocation(s), frame);
+    };
+
+    int numWrapped = 0;
+    const int numSteps = 20;
+    for (int i = 0; i <= numSteps; ++i) {
+        knee.setValue(s, knee.getRangeMin() +
+            i*(knee.getRangeMax() - knee.getRangeMin())/numSteps);
+        const Array<AbstractPathPoint*>& currentPath = path.getCurrentPath(s);
+        int j = 0;
+        while (j < currentPath.getSize() &&
+                currentPath[j] != &pathWrap.getWrapPoint1()) ++j;
+        if (j == currentPath.getSize()) continue;
+        ++numWrapped;
+
+        // The wrapped segment, and the same segment far from the object.
+        const Vec3 p1 = inWrapFrame(*currentPath[j - 1]);
+        const Vec3 p2 = inWrapFrame(*currentPath[j + 2]);
+        const Vec3 offset(10.0, 0, 0);
+        WrapMath::SegmentBatch segments;
+        segments.resize(2);
+        segments.set(0, p1, p2);
+        segments.set(1, p1 + offset, p2 + offset);
+        std::vector<WrapResult> results(2);
+        for (auto& result : results) {
+            result.startPoint = j - 1;
+            result.endPoint = j;
+        }
+        std::vector<int> codes;
+        wrapObject.wrapPathSegments(s, segments, {&pathWrap, &pathWrap},
+                                    results, codes);
+
+        ASSERT(codes[0] == WrapObject::wrapped ||
+               codes[0] == WrapObject::mandatoryWrap);
+        ASSERT(codes[1] == WrapObject::noWrap);
+        ASSERT_EQUAL(results[0].r1, inWrapFrame(*currentPath[j]), 1e-6);
+        ASSERT_EQUAL(results[0].r2, inWrapFrame(*currentPath[j + 1]), 1e-6);
+        ASSERT(results[1].wrap_pts.getSize() == 0);
+    }
+    ASSERT(numWrapped > 0);
+}
+
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation)
 {
     // Create a new OpenSim model
@@ -628,7 +795,7 @@ void simulateModelWithCables(const string &modelFile, double finalTime)
             }
             else { // next two path points should be a wrap point
                 for (int k = 0; k < wrapSet.getSize(); ++k) {
-                    const Vec3& wrapStartPointLoc = wrapSet[k].getPreviousWrap().r1;
+                    const Vec3& wrapStartPointLoc = wrapSet[k].getPreviousWrap(si).r1;
                     if (!wrapStartPointLoc.isInf() && pp->getLocation(si).isNumericallyEqual(wrapStartPointLoc)) {
                         ObstacleInfo* obs = wrapObs[k];
                         obs->isActive = true;
@@ -678,7 +845,7 @@ void simulateModelWithCables(const string &modelFile, double finalTime)
 //            cout << "wrap object " << j << " name = " << wrapSet[j].getName() << endl;
 //            cout << "wrap point 0 = " << wrapSet[j].getWrapPoint(0).getLocation() << endl;
 //            cout << "wrap point 1 = " << wrapSet[j].getWrapPoint(1).getLocation() << endl;
-//            const WrapResult& wr = wrapSet[j].getPreviousWrap();
+//            const WrapResult& wr = wrapSet[j].getPreviousWrap(si);
 //            cout << "wrap result r1 = " << wr.r1 << endl;
 //            cout << "wrap result r2 = " << wr.r2 << endl;
 //            cout << "wrap result startpt = " << wr.startPoint << endl;
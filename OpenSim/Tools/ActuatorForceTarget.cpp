@@ -272,6 +272,7 @@ computePerformanceVectors(SimTK::State& s, const Vector &aF, Vector &rAccelPerfo
 int ActuatorForceTarget::
 objectiveFunc(const Vector &aF, const bool new_coefficients, Real& rP) const
 {
+    ++_numObjectiveEvaluations;
     const CMC_TaskSet& tset=_controller->getTaskSet();
 #ifndef USE_PRECOMPUTED_PERFORMANCE_MATRICES
 
@@ -311,6 +312,7 @@ objectiveFunc(const Vector &aF, const bool new_coefficients, Real& rP) const
 int ActuatorForceTarget::
 gradientFunc(const Vector &x, const bool new_coefficients, Vector &gradient) const
 {
+    ++_numGradientEvaluations;
     int status = 0;
 
 #ifndef USE_PRECOMPUTED_PERFORMANCE_MATRICES
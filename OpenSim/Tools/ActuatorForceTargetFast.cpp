@@ -32,6 +32,7 @@
 #include "CMC_TaskSet.h"
 #include "CMC.h"
 #include "StateTrackingTask.h"
+#include <OpenSim/Simulation/SimulationUtilities.h>
 
 using namespace std;
 using namespace OpenSim;
@@ -131,7 +132,17 @@ prepareToOptimize(SimTK::State& s, double *x)
 
     computeConstraintVector(s, f, _constraintVector);
 
+    // The tasks' accelerations are linear in the generalized accelerations,
+    // so the columns of actuators that provide their forces per unit
+    // actuation are computed directly, if all the tasks provide their
+    // changes in acceleration; the others by realizing the accelerations
+    // with each actuator's force perturbed in turn.
+    std::vector<bool> computed(nf, false);
+    if(_useAccelerationsPerUnitActuation)
+        computeConstraintMatrixColumns(s, computed);
+
     for(int j=0; j<nf; j++) {
+        if(computed[j]) continue;
         f[j] = 1;
         computeConstraintVector(s, f, c);
         _constraintMatrix(j) = (c - _constraintVector);
@@ -194,6 +205,7 @@ prepareToOptimize(SimTK::State& s, double *x)
 int ActuatorForceTargetFast::
 objectiveFunc(const Vector &aF, const bool new_coefficients, Real& rP) const
 {
+    ++_numObjectiveEvaluations;
     const Set<const Actuator>& fSet = _controller->getActuatorSet();
     double p = 0.0;
     const CMC_TaskSet& tset=_controller->getTaskSet();
@@ -235,6 +247,7 @@ objectiveFunc(const Vector &aF, const bool new_coefficients, Real& rP) const
 int ActuatorForceTargetFast::
 gradientFunc(const Vector &x, const bool new_coefficients, Vector &gradient) const
 {
+    ++_numGradientEvaluations;
     const Set<const Actuator>& fSet = _controller->getActuatorSet();
     // double p = 0.0;
     for(int i=0,index=0;i<fSet.getSize();i++) {
@@ -275,6 +288,7 @@ gradientFunc(const Vector &x, const bool new_coefficients, Vector &gradient) con
 int ActuatorForceTargetFast::
 constraintFunc(const SimTK::Vector &x, const bool new_coefficients, SimTK::Vector &constraints) const
 {
+    ++_numConstraintEvaluations;
 #ifndef USE_LINEAR_CONSTRAINT_MATRIX
 
     // Evaluate constraint function for all constraints and pick the appropriate component
@@ -329,6 +343,47 @@ computeConstraintVector(SimTK::State& s, const Vector &x,Vector &c) const
     _controller->getModel().getMultibodySystem().realizeModel(s);
 }
 //______________________________________________________________________________
+/**
+ * Compute the columns of the constraint matrix of the actuators that provide
+ * their forces per unit actuation, from the tasks' Jacobian and the
+ * generalized accelerations per unit actuation.
+ *
+ * @param computed Whether each column was computed; all are false if a task
+ * does not provide its Jacobian.
+ */
+void ActuatorForceTargetFast::
+computeConstraintMatrixColumns(SimTK::State& s, std::vector<bool>& computed)
+{
+    const Model& model = _controller->getModel();
+    model.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+
+    const Set<const Actuator>& fSet = _controller->getActuatorSet();
+    int nf = fSet.getSize();
+    std::vector<const ScalarActuator*> actuators;
+    for(int i=0; i<nf; i++)
+        actuators.push_back(dynamic_cast<const ScalarActuator*>(&fSet[i]));
+    Matrix accelPerActuation;
+    if(!calcAccelerationsPerUnitActuation(model, s, actuators,
+                                          accelPerActuation, computed))
+        return;
+
+    CMC_TaskSet& taskSet = _controller->updTaskSet();
+    Matrix taskJacobian;
+    if(!taskSet.computeAccelerationJacobian(s, taskJacobian)) {
+        computed.assign(nf, false);
+        return;
+    }
+
+    // The tasks' accelerations per unit actuation, for all actuators at once.
+    Matrix taskAccelPerActuation = taskJacobian * accelPerActuation;
+    Array<double> &w = taskSet.getWeights();
+    for(int j=0; j<nf; j++) {
+        if(!computed[j]) continue;
+        for(int c=0; c<taskAccelPerActuation.nrow(); c++)
+            _constraintMatrix(c,j) = -w[c]*taskAccelPerActuation(c,j);
+    }
+}
+//______________________________________________________________________________
 /**
  * Compute the gradient of constraint i given x.
  *
@@ -340,6 +395,7 @@ computeConstraintVector(SimTK::State& s, const Vector &x,Vector &c) const
 int ActuatorForceTargetFast::
 constraintJacobian(const SimTK::Vector &x, const bool new_coefficients, SimTK::Matrix &jac) const
 {
+    ++_numConstraintJacobianEvaluations;
 #ifndef USE_LINEAR_CONSTRAINT_MATRIX
 
     // Compute gradient using callbacks to constraintFunc
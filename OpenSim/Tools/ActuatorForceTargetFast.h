@@ -34,6 +34,7 @@
 //==============================================================================
 #include "osimToolsDLL.h"
 #include <OpenSim/Common/OptimizationTarget.h>
+#include <vector>
 
 namespace OpenSim {
 
@@ -93,6 +94,10 @@ private:
     
     // Save a (copy) of the state for state tracking purposes
     SimTK::State    _saveState;
+
+    /** Whether to compute the columns of the constraint matrix directly from
+    the actuators' forces per unit actuation, when possible. */
+    bool _useAccelerationsPerUnitActuation = true;
 //==============================================================================
 // METHODS
 //==============================================================================
@@ -118,8 +123,25 @@ public:
     int constraintFunc( const SimTK::Vector &x, bool new_coefficients, SimTK::Vector &constraints) const override;
     int constraintJacobian(const SimTK::Vector &x, bool new_coefficients, SimTK::Matrix &jac) const override;
     CMC* getController() {return (_controller); }
+
+    /** The constraints are linear in the actuator forces, and the constraint
+    matrix is built in prepareToOptimize(), once per CMC time window. By
+    default, if every task provides its Jacobian (see
+    CMC_Task::computeAccelerationJacobian(); joint and point tasks do) and the
+    model has no kinematic constraints, the columns of the actuators that
+    provide their forces per unit actuation (e.g., muscles and coordinate
+    actuators) are computed directly from those forces, with the inverse of
+    the mass matrix (see calcAccelerationsPerUnitActuation()), and the
+    constraint Jacobian is this matrix. Otherwise, or
+    if this is false, each column is computed by realizing the model's
+    accelerations with the actuator's force perturbed. */
+    void setUseAccelerationsPerUnitActuation(bool use)
+    {   _useAccelerationsPerUnitActuation = use; }
+    bool getUseAccelerationsPerUnitActuation() const
+    {   return _useAccelerationsPerUnitActuation; }
 private:
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
+    void computeConstraintMatrixColumns(SimTK::State& s, std::vector<bool>& computed);
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 };  // END class ActuatorForceTargetFast
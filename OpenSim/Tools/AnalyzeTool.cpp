@@ -22,6 +22,12 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/BinaryFileAdapter.h>
+#include <OpenSim/Common/Parallelism.h>
+#include <OpenSim/Common/ResultCache.h>
+#include <OpenSim/Common/RunControl.h>
+#include <OpenSim/Common/STOFileReader.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
@@ -35,6 +41,13 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -196,6 +209,10 @@ setNull()
 
     _printResultFiles = true;
     _replaceForceSet = false;
+    _numThreads = 1;
+    _streamBlockSize = 0;
+    _resultCacheDirectory = "";
+    _runControl = NULL;
 }
 //_____________________________________________________________________________
 /**
@@ -261,6 +278,10 @@ operator=(const AnalyzeTool &aTool)
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
+    _numThreads = aTool._numThreads;
+    _streamBlockSize = aTool._streamBlockSize;
+    _resultCacheDirectory = aTool._resultCacheDirectory;
+    _coordinateValues = aTool._coordinateValues;
     return(*this);
 }
 
@@ -373,11 +394,17 @@ loadStatesFromFile(SimTK::State& s)
         _statesStore = new Storage();
         _model->formStateStorage(temp, *_statesStore, true);
     } else {
-        if(!_coordinatesFileNameProp.isValidFileName()) 
+        if(!_coordinatesFileNameProp.isValidFileName() && !_coordinateValues)
             throw Exception("AnalyzeTool.initializeFromFiles: Either a states file or a coordinates file must be specified.",__FILE__,__LINE__);
 
-        cout<<"\nLoading coordinates from file "<<_coordinatesFileName<<"."<<endl;
-        Storage coordinatesStore(_coordinatesFileName);
+        Storage coordinatesStore;
+        if(_coordinateValues) {
+            cout<<"\nUsing the coordinates given to setCoordinateValues()."<<endl;
+            coordinatesStore = *_coordinateValues;
+        } else {
+            cout<<"\nLoading coordinates from file "<<_coordinatesFileName<<"."<<endl;
+            coordinatesStore = Storage(_coordinatesFileName);
+        }
 
         if(_lowpassCutoffFrequency>=0) {
             cout<<"\n\nLow-pass filtering coordinates data with a cutoff frequency of "<<_lowpassCutoffFrequency<<"..."<<endl<<endl;
@@ -518,6 +545,7 @@ bool AnalyzeTool::run()
 }
 bool AnalyzeTool::run(bool plotting)
 {
+    OPENSIM_TRACE_SPAN("tool", "AnalyzeTool", getName());
     //cout<<"Running analyze tool "<<getName()<<"."<<endl;
 
     // CHECK FOR A MODEL
@@ -537,10 +565,38 @@ bool AnalyzeTool::run(bool plotting)
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
 //printf("after AnalyzeTool.run() initSystem \n\n");
 
-    if(_loadModelAndInput) {
+    const bool streaming = _loadModelAndInput && _streamBlockSize > 0 &&
+                           _statesFileNameProp.isValidFileName();
+    if(_loadModelAndInput && !streaming) {
         loadStatesFromFile(s);
     }
 
+    // The cache holds the analyses' storages, so every analysis must keep
+    // all of its results in them.
+    bool useCache = !_resultCacheDirectory.empty();
+    const AnalysisSet& analyses = _model->getAnalysisSet();
+    for(int i=0; useCache && i<analyses.getSize(); ++i) {
+        if(analyses[i].getOn() && !analyses[i].isFrameIndependent()) {
+            cout << "AnalyzeTool: analysis " << analyses[i].getName()
+                 << " does not keep all of its results in its storages; "
+                 << "the result cache is not used." << endl;
+            useCache = false;
+        }
+    }
+    // The external loads and states files are named relative to the current
+    // directory, so hash them before changing it.
+    ResultCache::Key cacheKey;
+    if(useCache) {
+        if(_externalLoadsFileName != "" &&
+                _externalLoadsFileName != "Unassigned") {
+            for(const auto& fileName :
+                    _externalLoads.getInputFileNames(_externalLoadsFileName))
+                cacheKey.addFile(fileName);
+        }
+        if(streaming) cacheKey.addFile(_statesFileName);
+        else if(_statesStore) cacheKey.addStorage(*_statesStore);
+    }
+
 
     // Do the maneuver to change then restore working directory 
     // so that the parsing code behaves properly if called from a different directory.
@@ -553,7 +609,7 @@ bool AnalyzeTool::run(bool plotting)
     try {
 
     // VERIFY THE CONTROL SET, STATES, AND PSEUDO STATES ARE TENABLE
-    verifyControlsStates();
+    if(!streaming) verifyControlsStates();
 
     // SET OUTPUT PRECISION
     IO::SetPrecision(_outputPrecision);
@@ -565,25 +621,52 @@ bool AnalyzeTool::run(bool plotting)
         throw Exception(msg,__FILE__,__LINE__);
     }
 
-    // Call helper function to process analysis
-    /*Array<double> bounds;
-    bounds.append(_ti);
-    bounds.append(_tf);
-    const_cast<Storage &>(aStatesStore).interpolateAt(bounds);*/
-    double ti,tf;
-    int iInitial = _statesStore->findIndex(_ti);
-    int iFinal = _statesStore->findIndex(_tf);
-    _statesStore->getTime(iInitial,ti);
-    _statesStore->getTime(iFinal,tf);
-
-    // It is ridiculous to start before the specified time! So check we aren't doing something stupid.
-    //while(ti < _ti){
-    //  _statesStore->getTime(++iInitial,ti);
-    //}
-
-    cout<<"Executing the analyses from "<<ti<<" to "<<tf<<"..."<<endl;
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    bool restored = false;
+    if(useCache) {
+        cacheKey.add(getConcreteClassName()).add(_model->computeFingerprint())
+                .add(dump());
+        for(int i=0; i<analysisSet.getSize(); ++i) {
+            if(!analysisSet[i].getOn()) continue;
+            for(const auto& fileName : analysisSet[i].getInputFileNames())
+                cacheKey.addFile(fileName);
+        }
+        restored = restoreCachedResults(cacheKey.toString());
+        if(restored) {
+            cout << "AnalyzeTool " << getName() << ": restored the results "
+                 << "from the cache (key " << cacheKey.toString() << ")."
+                 << endl;
+        }
+    }
+
+    if(streaming && !restored) {
+        runStreaming(s);
+    } else if(!restored) {
+        // Call helper function to process analysis
+        /*Array<double> bounds;
+        bounds.append(_ti);
+        bounds.append(_tf);
+        const_cast<Storage &>(aStatesStore).interpolateAt(bounds);*/
+        double ti,tf;
+        int iInitial = _statesStore->findIndex(_ti);
+        int iFinal = _statesStore->findIndex(_tf);
+        _statesStore->getTime(iInitial,ti);
+        _statesStore->getTime(iFinal,tf);
+
+        // It is ridiculous to start before the specified time! So check we aren't doing something stupid.
+        //while(ti < _ti){
+        //  _statesStore->getTime(++iInitial,ti);
+        //}
+
+        cout<<"Executing the analyses from "<<ti<<" to "<<tf<<"..."<<endl;
+        run(s, *_model, iInitial, iFinal, *_statesStore,
+            _solveForEquilibriumForAuxiliaryStates, _numThreads, _runControl);
+    }
+    if(useCache && !restored) storeCachedResults(cacheKey.toString());
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
+    } catch (const RunCancelled&) {
+        cout << "AnalyzeTool " << getName() << " was cancelled." << endl;
+        IO::chDir(saveWorkingDirectory);
+        throw;
     } catch (const Exception& x) {
         x.print(cout);
         completed = false;
@@ -604,81 +687,75 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
-void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
-{
-    AnalysisSet& analysisSet = aModel.updAnalysisSet();
-
-    for(int i=0;i<analysisSet.getSize();i++) {
-        analysisSet.get(i).setStatesStore(aStatesStore);
-    }
-
-
-    // PERFORM THE ANALYSES
-    double /*tPrev=0.0,*/t=0.0/*,dt=0.0*/;
-    int ny = s.getNY();
-    Array<double> dydt(0.0,ny);
-    Array<double> yFromStorage(0.0,ny);
-
-    const Array<string>& labels =  aStatesStore.getColumnLabels();
-    int numOpenSimStates = labels.getSize()-1;
-
-    SimTK::Vector stateData;
-    stateData.resize(numOpenSimStates);
-
-    // There is no guarantee that the order in which a model had written out
-    // its states will be the same order in which the states will be created,
-    // allocated and listed in any future recreation of the model and its
-    // system. Therefore, it is imperative that we ensure that the state
-    // values being read in are reordered according to the model's order.
-    // The model's order is given by its getStateVariableNames() so we can 
-    // compare to the column labels of the storage and construct a dataToModel
-    // mapping.
-    const Array<std::string>& stateNames = aStatesStore.getColumnLabels();
-    Array<std::string> modelStateNames = aModel.getStateVariableNames();
-
-    int nsData = stateNames.size() - 1;  //-1 since time is a column
-    Array<int> dataToModel(-1, nsData);
-    for (int k = 0; k < nsData; ++k) {
-        for (int j = 0; j < modelStateNames.size(); ++j) {
-            if (stateNames[k+1] == modelStateNames[j]) { //+1 skip "time"
-                dataToModel[k] = j;
+namespace {
+// Sets the State from the frames of states whose columns are labeled
+// stateNames (the first being time), and passes it to the analyses of aModel.
+class FrameAnalyzer {
+public:
+    FrameAnalyzer(SimTK::State& s, Model& aModel,
+                  const Array<std::string>& stateNames,
+                  bool aSolveForEquilibrium) :
+            _s(s), _model(aModel),
+            _solveForEquilibrium(aSolveForEquilibrium)
+    {
+        // There is no guarantee that the order in which a model had written
+        // out its states will be the same order in which the states will be
+        // created, allocated and listed in any future recreation of the
+        // model and its system. Therefore, it is imperative that we ensure
+        // that the state values being read in are reordered according to
+        // the model's order. The model's order is given by its
+        // getStateVariableNames() so we can compare to the column labels of
+        // the storage and construct a dataToModel mapping.
+        Array<std::string> modelStateNames = aModel.getStateVariableNames();
+
+        const int nsData = stateNames.size() - 1; //-1 since time is a column
+        _dataToModel = Array<int>(-1, nsData);
+        for (int k = 0; k < nsData; ++k) {
+            for (int j = 0; j < modelStateNames.size(); ++j) {
+                if (stateNames[k+1] == modelStateNames[j]) { //+1 skip "time"
+                    _dataToModel[k] = j;
+                }
             }
         }
-    }
-
-    // It is possible that there are internal states or that future modeling
-    // choices add state variables that are not known to the modeler/user.
-    // In which case we rely on the model to supply reasonable defaults and
-    // assume all the important/necessary state values for running an analysis
-    // are provided by the Storage. Here we initialize the state values to their
-    // model defaults.
-    SimTK::Vector stateValues = aModel.getStateVariableValues(s);
-
-    for(int i=iInitial;i<=iFinal;i++) {
-        // tPrev = t;
-        aStatesStore.getTime(i,s.updTime()); // time
-        t = s.getTime();
-        aModel.setAllControllersEnabled(true);
 
-        aStatesStore.getData(i,numOpenSimStates,&stateData[0]); // states
-        // Get data into local Vector and assign to State using common utility
-        // to handle internal (non-OpenSim) states that may exist
+        // It is possible that there are internal states or that future
+        // modeling choices add state variables that are not known to the
+        // modeler/user. In which case we rely on the model to supply
+        // reasonable defaults and assume all the important/necessary state
+        // values for running an analysis are provided by the Storage. Here
+        // we initialize the state values to their model defaults.
+        _stateValues = aModel.getStateVariableValues(s);
+    }
 
-        for (int k=0; k < nsData; ++k) {
-            stateValues[dataToModel[k]] = stateData[k];
+    int getNumColumns() const { return _dataToModel.size(); }
+
+    // Analyze the frame with index i, at time t, with one state value per
+    // column in data: begin the analyses if begin is true, or else end them
+    // if end is true, or else step them.
+    void analyze(int i, double t, const double* data, bool begin, bool end)
+    {
+        AnalysisSet& analysisSet = _model.updAnalysisSet();
+        _s.updTime() = t;
+        _model.setAllControllersEnabled(true);
+
+        // Assign the data to the State using common utility to handle
+        // internal (non-OpenSim) states that may exist
+        for (int k = 0; k < _dataToModel.size(); ++k) {
+            if (_dataToModel[k] >= 0)
+                _stateValues[_dataToModel[k]] = data[k];
         }
-        aModel.setStateVariableValues(s, stateValues);
-       
+        _model.setStateVariableValues(_s, _stateValues);
+
         // Adjust configuration to match constraints and other goals
-        aModel.assemble(s);
+        _model.assemble(_s);
 
         // equilibrateMuscles before realization as it may affect forces
-        if(aSolveForEquilibrium){
+        if(_solveForEquilibrium){
             try{// might not be able to equilibrate if model is in
-                // a non-physical pose. For example, a pose where the 
+                // a non-physical pose. For example, a pose where the
                 // muscle length is shorter than the tendon slack-length.
                 // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
+                _model.equilibrateMuscles(_s);
             }
             catch (const std::exception& e) {
                 cout << "WARNING- AnalyzeTool::run() unable to equilibrate muscles ";
@@ -687,15 +764,307 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
             }
         }
         // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        _model.getMultibodySystem().realize(_s, SimTK::Stage::Velocity);
 
-        if(i==iInitial) {
-            analysisSet.begin(s);
-        } else if(i==iFinal) {
-            analysisSet.end(s);
+        if(begin) {
+            analysisSet.begin(_s);
+        } else if(end) {
+            analysisSet.end(_s);
         // Step
         } else {
-            analysisSet.step(s,i);
+            analysisSet.step(_s,i);
+        }
+    }
+
+private:
+    SimTK::State& _s;
+    Model& _model;
+    bool _solveForEquilibrium;
+    Array<int> _dataToModel;
+    SimTK::Vector _stateValues;
+};
+
+// Analyze frames iFirst to iLast of the states with the analyses of aModel
+// that are on. The analyses begin at iFirst, and end at iFinal if it is
+// among the frames. Each frame is a step of the control, if any.
+void analyzeFrames(SimTK::State& s, Model &aModel, int iFirst, int iLast,
+                   int iFinal, const Storage &aStatesStore,
+                   bool aSolveForEquilibrium, RunControl* control)
+{
+    FrameAnalyzer analyzer(s, aModel, aStatesStore.getColumnLabels(),
+                           aSolveForEquilibrium);
+    SimTK::Vector stateData(analyzer.getNumColumns());
+
+    double t = 0.0;
+    for(int i=iFirst;i<=iLast;i++) {
+        if(control) control->step();
+        aStatesStore.getTime(i,t); // time
+        aStatesStore.getData(i,stateData.size(),&stateData[0]); // states
+        analyzer.analyze(i, t, &stateData[0], i==iFirst, i==iFinal);
+    }
+}
+} // anonymous namespace
+
+namespace {
+// The storages of the analyses that are on, in order; the result cache holds
+// them in this order.
+std::vector<Storage*> getResultStorages(AnalysisSet& analysisSet)
+{
+    std::vector<Storage*> storages;
+    for(int i=0; i<analysisSet.getSize(); ++i) {
+        if(!analysisSet[i].getOn()) continue;
+        ArrayPtrs<Storage>& list = analysisSet[i].getStorageList();
+        for(int j=0; j<list.getSize(); ++j) storages.push_back(list.get(j));
+    }
+    return storages;
+}
+
+// The binary files through which the storages pass to and from the cache.
+// An empty storage is passed as an empty file.
+std::vector<std::string> getStagingFileNames(const std::string& directory,
+        const std::string& key, size_t numStorages)
+{
+    std::vector<std::string> fileNames;
+    for(size_t i=0; i<numStorages; ++i)
+        fileNames.push_back(directory + "/" + key + "_staging_" +
+                            std::to_string(i) + ".bsto");
+    return fileNames;
+}
+}
+
+bool AnalyzeTool::restoreCachedResults(const std::string& key)
+{
+    std::vector<Storage*> storages =
+            getResultStorages(_model->updAnalysisSet());
+    const std::vector<std::string> fileNames =
+            getStagingFileNames(_resultCacheDirectory, key, storages.size());
+    if(!ResultCache(_resultCacheDirectory).restore(key, fileNames))
+        return false;
+    for(size_t i=0; i<storages.size(); ++i) {
+        const bool empty = std::ifstream(fileNames[i]).peek() ==
+                           std::ifstream::traits_type::eof();
+        if(empty) storages[i]->purge();
+        else *storages[i] = Storage(fileNames[i]);
+        std::remove(fileNames[i].c_str());
+    }
+    return true;
+}
+
+void AnalyzeTool::storeCachedResults(const std::string& key)
+{
+    const std::vector<Storage*> storages =
+            getResultStorages(_model->updAnalysisSet());
+    const std::vector<std::string> fileNames =
+            getStagingFileNames(_resultCacheDirectory, key, storages.size());
+    IO::makeDir(_resultCacheDirectory);
+    for(size_t i=0; i<storages.size(); ++i) {
+        // The results are cached in double precision, whatever
+        // IO::GetBinarySinglePrecision().
+        if(storages[i]->getSize() == 0) std::ofstream(fileNames[i]);
+        else BinaryFileAdapter::write(storages[i]->exportToTable(),
+                                      fileNames[i], false);
+    }
+    ResultCache(_resultCacheDirectory).store(key, fileNames);
+    for(const auto& fileName : fileNames) std::remove(fileName.c_str());
+}
+
+void AnalyzeTool::runStreaming(SimTK::State& s)
+{
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    for (int i = 0; i < analysisSet.getSize(); ++i) {
+        const Analysis& analysis = analysisSet.get(i);
+        OPENSIM_THROW_IF(analysis.getOn() && analysis.usesStatesStore(),
+            Exception, "AnalyzeTool: analysis '" + analysis.getName() +
+            "' uses all of the states, so they cannot be streamed; see "
+            "AnalyzeTool::setStreamBlockSize().");
+    }
+
+    cout<<"\nStreaming states from file "<<_statesFileName<<" in blocks of "
+        <<_streamBlockSize<<" frames."<<endl;
+    STOFileReader reader(_statesFileName, _streamBlockSize);
+    const int numColumns = int(reader.getNumColumns());
+
+    // The frames of the current block, as read and in the model's order.
+    Array<std::string> labels("", 0);
+    labels.append("time");
+    for (const auto& label : reader.getColumnLabels()) labels.append(label);
+    Storage blockStore(_streamBlockSize, "states");
+    blockStore.setColumnLabels(labels);
+    blockStore.setInDegrees(reader.isInDegrees());
+    Storage statesStore(_streamBlockSize, "states");
+    Array<std::string> stateNames = _model->getStateVariableNames();
+    stateNames.insert(0, "time");
+    statesStore.setColumnLabels(stateNames);
+    for (int i = 0; i < analysisSet.getSize(); ++i)
+        analysisSet.get(i).setStatesStore(statesStore);
+    FrameAnalyzer analyzer(s, *_model, statesStore.getColumnLabels(),
+                           _solveForEquilibriumForAuxiliaryStates);
+
+    cout<<"Executing the analyses from "<<_ti<<" to "<<_tf<<"..."<<endl;
+    // As when the states are loaded whole, the analyses begin at the last
+    // frame at or before the initial time, and end at the last frame at or
+    // before the final time, which takes looking one frame ahead.
+    STOFileReader::Block block, next;
+    bool haveBlock = reader.readBlock(block);
+    int frame = 0;
+    bool begun = false;
+    bool ended = false;
+    SimTK::Vector stateData(analyzer.getNumColumns());
+    while (haveBlock && !ended) {
+        const bool haveNext = reader.readBlock(next);
+        const double nextBlockTime =
+                haveNext ? next.times[0] : SimTK::Infinity;
+
+        blockStore.purge();
+        for (size_t r = 0; r < block.getNumRows(); ++r)
+            blockStore.append(block.times[r], numColumns, block.getRow(r));
+        statesStore.purge();
+        _model->formStateStorage(blockStore, statesStore, frame == 0);
+
+        for (int r = 0; r < statesStore.getSize() && !ended; ++r, ++frame) {
+            const double nextTime = r + 1 < statesStore.getSize()
+                                    ? block.times[r + 1] : nextBlockTime;
+            if (!begun && nextTime <= _ti) continue;
+            ended = nextTime > _tf;
+            if (_runControl) {
+                _runControl->checkCancelled();
+                _runControl->setProgress(ended ? 1.0 : std::max(0.0,
+                        (block.times[r] - _ti)/(_tf - _ti)));
+            }
+            statesStore.getData(r, stateData.size(), &stateData[0]);
+            analyzer.analyze(frame, block.times[r], &stateData[0], !begun,
+                             ended);
+            begun = true;
+        }
+        std::swap(block, next);
+        haveBlock = haveNext;
+    }
+}
+
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int numThreads, RunControl* control)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setStatesStore(aStatesStore);
+    }
+
+    // Each chunk has at least two frames, so that its analyses are begun
+    // and then stepped or ended.
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numFrames = iFinal - iInitial + 1;
+    const int numChunks = Parallelism::getNumBlocks(numFrames, numThreads, 2);
+    std::vector<int> chunked;
+    if (numChunks > 1) {
+        for (int i = 0; i < analysisSet.getSize(); ++i) {
+            const Analysis& analysis = analysisSet.get(i);
+            if (analysis.getOn() && analysis.isFrameIndependent())
+                chunked.push_back(i);
+        }
+    }
+    if (chunked.empty()) {
+        if (control) control->setNumSteps(numFrames);
+        analyzeFrames(s, aModel, iInitial, iFinal, iFinal, aStatesStore,
+                      aSolveForEquilibrium, control);
+        return;
+    }
+
+    // Each chunk is analyzed by copies of the chunked analyses on its own
+    // copy of the model. The copies are initialized here, rather than on the
+    // threads, so that building the Systems does not need to be thread-safe.
+    // A Model does not own its analyses, so the copies are owned here (and
+    // outlive the models).
+    std::vector<std::unique_ptr<Analysis>> analyses;
+    std::vector<std::unique_ptr<Model>> models(numChunks);
+    std::vector<SimTK::State> states(numChunks);
+    for (int c = 0; c < numChunks; ++c) {
+        models[c].reset(aModel.clone());
+        models[c]->setUseVisualizer(false);
+        for (int i : chunked) {
+            analyses.emplace_back(analysisSet.get(i).clone());
+            models[c]->addAnalysis(analyses.back().get());
+        }
+        states[c] = models[c]->initSystem();
+        AnalysisSet& copies = models[c]->updAnalysisSet();
+        for (int k = 0; k < copies.getSize(); ++k)
+            copies.get(k).setStatesStore(aStatesStore);
+    }
+
+    // The remaining analyses see every frame, on aModel, meanwhile.
+    for (int i : chunked) analysisSet.get(i).setOn(false);
+    bool anySerial = false;
+    for (int i = 0; i < analysisSet.getSize(); ++i)
+        anySerial = anySerial || analysisSet.get(i).getOn();
+    // The serial analyses see every frame again.
+    if (control) control->setNumSteps(anySerial ? 2*numFrames : numFrames);
+
+    // The message of the error encountered by each chunk, if any.
+    std::vector<std::string> errors(numChunks + 1);
+    auto analyzeChunk = [&](int c) {
+        try {
+            if (c == numChunks) {
+                analyzeFrames(s, aModel, iInitial, iFinal, iFinal,
+                              aStatesStore, aSolveForEquilibrium, control);
+            } else {
+                analyzeFrames(states[c], *models[c],
+                              iInitial + numFrames*c/numChunks,
+                              iInitial + numFrames*(c+1)/numChunks - 1,
+                              iFinal, aStatesStore, aSolveForEquilibrium,
+                              control);
+            }
+        }
+        catch (const std::exception& e) {
+            errors[c] = e.what();
+        }
+    };
+    // In deterministic mode there may be more chunks than threads; chunks
+    // are handed out in order, to up to numThreads threads.
+    std::atomic<int> nextChunk(0);
+    auto analyzeChunks = [&]() {
+        for (int c = nextChunk++; c < numChunks; c = nextChunk++)
+            analyzeChunk(c);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < std::min(numThreads, numChunks); ++t) {
+        try {
+            threads.emplace_back(analyzeChunks);
+        } catch (const std::system_error&) {
+            // Could not start a thread; the remaining threads take its
+            // chunks.
+            break;
+        }
+    }
+    analyzeChunks();
+    if (anySerial) analyzeChunk(numChunks);
+    for (auto& thread : threads) thread.join();
+    for (int i : chunked) analysisSet.get(i).setOn(true);
+
+    if (control) control->checkCancelled();
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("AnalyzeTool::run(): " + errorMsg,
+                            __FILE__, __LINE__);
+    }
+
+    // Concatenate the results of the copies, in time order, into the
+    // storages of the analyses of aModel.
+    for (int k = 0; k < int(chunked.size()); ++k) {
+        Analysis& analysis = analysisSet.get(chunked[k]);
+        ArrayPtrs<Storage>& target = analysis.getStorageList();
+        for (int c = 0; c < numChunks; ++c) {
+            ArrayPtrs<Storage>& source =
+                    models[c]->updAnalysisSet().get(k).getStorageList();
+            OPENSIM_THROW_IF(source.getSize() != target.getSize(), Exception,
+                "AnalyzeTool::run(): the copies of analysis '" +
+                analysis.getName() + "' have different storages.");
+            for (int j = 0; j < target.getSize(); ++j) {
+                if (c == 0) {
+                    *target[j] = *source[j];
+                    continue;
+                }
+                for (int r = 0; r < source[j]->getSize(); ++r)
+                    target[j]->append(*source[j]->getStateVector(r));
+            }
         }
     }
 }
@@ -32,6 +32,8 @@
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include "osimToolsDLL.h"
 
+#include <memory>
+
 #ifdef SWIG
     #ifdef OSIMTOOLS_API
         #undef OSIMTOOLS_API
@@ -41,6 +43,8 @@
 
 namespace OpenSim { 
 
+class RunControl;
+
 //=============================================================================
 //=============================================================================
 /**
@@ -77,6 +81,24 @@ private:
 
     /** Whether the model and states should be loaded from input files */
     bool _loadModelAndInput;
+
+    /** Number of threads over which frames are analyzed; see
+    setNumThreads(). */
+    int _numThreads;
+
+    /** Number of frames read at a time when streaming the states from their
+    file, or 0 to load them whole; see setStreamBlockSize(). */
+    int _streamBlockSize;
+
+    /** Directory of the cache of results; see setResultCacheDirectory(). */
+    std::string _resultCacheDirectory;
+
+    /** Coordinates used instead of the coordinates file; see
+    setCoordinateValues(). */
+    std::shared_ptr<const Storage> _coordinateValues;
+
+    /** Follows the progress of run(); see setRunControl(). Not copied. */
+    RunControl* _runControl;
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -94,6 +116,13 @@ private:
     void setNull();
     void setupProperties();
     void constructCorrectiveSprings();
+    // Analyze the frames of the states file as they are read; see
+    // setStreamBlockSize().
+    void runStreaming(SimTK::State& s);
+    // Replace the storages of the analyses with the entry for key of the
+    // result cache, if there is one; see setResultCacheDirectory().
+    bool restoreCachedResults(const std::string& key);
+    void storeCachedResults(const std::string& key);
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -115,12 +144,75 @@ public:
     void setStatesFileName(const std::string &aFileName) { _statesFileName = aFileName; }
     const std::string &getCoordinatesFileName() const { return _coordinatesFileName; }
     void setCoordinatesFileName(const std::string &aFileName) { _coordinatesFileName = aFileName; }
+    /** Form the states from a copy of these coordinates, rather than from the
+    coordinates file, when run() loads the states (see loadStatesFromFile());
+    a states file still takes precedence. This passes, e.g., the output of
+    an InverseKinematicsTool (see InverseKinematicsTool::getOutputStorage())
+    without writing and reading it back. */
+    void setCoordinateValues(const Storage& coordinates)
+    {   _coordinateValues = std::make_shared<const Storage>(coordinates); }
+    /** Read the coordinates from the coordinates file again. */
+    void clearCoordinateValues() { _coordinateValues.reset(); }
     const std::string &getSpeedsFileName() const { return _speedsFileName; }
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
     const bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
+    /** Analyze the frames of the states in numThreads contiguous chunks
+    concurrently, each on a copy of the model with copies of the analyses,
+    and concatenate the copies' results in time order. Only analyses whose
+    frames are independent (see Analysis::isFrameIndependent()) are analyzed
+    in chunks; the others still see every frame, in order, on the tool's
+    model. Each chunk's analyses begin at the chunk's first frame. The
+    default, 1, analyzes all frames serially; if not positive, the number
+    of hardware threads is used. In deterministic mode (see Parallelism),
+    the frames are analyzed in a fixed number of chunks, whatever the number
+    of threads, so that the results do not depend on it. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+    /** Stream the states from the states file, blockSize frames at a time,
+    rather than loading them all before analyzing them: the next block is
+    read and parsed by a background thread (see STOFileReader) while the
+    current block is analyzed, so that reading overlaps the analyses, and
+    memory for the states is bounded by the block size however long the
+    trial is. The frames are then analyzed serially (see setNumThreads()),
+    and each analysis's states Storage (see Analysis::setStatesStore())
+    holds the current block only, so analyses that use all of the states
+    (see Analysis::usesStatesStore(), e.g., StaticOptimization) cannot be
+    run; run() throws if one is on. This applies only when the states are
+    loaded from a states file by run(); coordinates files are still loaded
+    whole, since their speeds are computed from splines. Pass 0 (the
+    default) to load the states whole. */
+    void setStreamBlockSize(int blockSize) { _streamBlockSize = blockSize; }
+    int getStreamBlockSize() const { return _streamBlockSize; }
+    /** Cache the results of run() in the given directory (see ResultCache),
+    under a key that hashes the model's fingerprint (see
+    Model::computeFingerprint()), the states, the contents of the external loads
+    files (see ExternalLoads::getInputFileNames()) and of the analyses' input
+    files (see Analysis::getInputFileNames()), and this tool's settings,
+    including those of its analyses. A run whose key is in the cache fills
+    the analyses' storages from the cache instead of analyzing the frames,
+    and prints them as usual. The cache holds the storages, so it is used
+    only when every analysis that is on keeps all of its results in them
+    (see Analysis::isFrameIndependent(), e.g., StaticOptimization); run()
+    ignores the directory otherwise. The default, an empty string, turns the
+    cache off. A relative directory is relative to the directory of the
+    setup file, as the results are. */
+    void setResultCacheDirectory(const std::string& directory)
+    {   _resultCacheDirectory = directory; }
+    const std::string& getResultCacheDirectory() const
+    {   return _resultCacheDirectory; }
+#ifndef SWIG
+    /** Report the frames analyzed by run() to the given RunControl, which
+    can also cancel the run: run() then stops at its next frame, restores
+    the working directory, and throws RunCancelled, without printing the
+    results. When the states are streamed (see setStreamBlockSize()), the
+    progress is that of the time of the frames. The RunControl must outlive
+    the runs; pass nullptr (the default) to stop reporting. See ToolJob to
+    run the tool in the background. */
+    void setRunControl(RunControl* control) { _runControl = control; }
+#endif
 
     //--------------------------------------------------------------------------
     // UTILITIES
@@ -140,7 +232,7 @@ public:
     // HELPER
     //--------------------------------------------------------------------------
 #ifndef SWIG
-    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int numThreads = 1, RunControl* control = nullptr);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
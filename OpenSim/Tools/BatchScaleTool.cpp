@@ -0,0 +1,203 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BatchScaleTool.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BatchScaleTool.h"
+#include "GenericModelMaker.h"
+#include "ScaleTool.h"
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+
+using namespace std;
+using namespace OpenSim;
+
+namespace {
+// The log of the subject being scaled on this thread, if any.
+thread_local string* threadLog = nullptr;
+
+// A stream buffer, installed in std::cout while the subjects are scaled, that
+// appends what each thread prints to the log of the subject it is scaling.
+// Output of other threads goes to the original buffer, one write at a time.
+class SubjectLogBuffer : public streambuf {
+public:
+    explicit SubjectLogBuffer(streambuf* original) : _original(original) {}
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        const char ch = traits_type::to_char_type(c);
+        return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+    }
+
+    streamsize xsputn(const char* s, streamsize n) override
+    {
+        if (threadLog) {
+            threadLog->append(s, size_t(n));
+            return n;
+        }
+        lock_guard<mutex> lock(_mutex);
+        return _original->sputn(s, n);
+    }
+
+    int sync() override
+    {
+        if (threadLog) return 0;
+        lock_guard<mutex> lock(_mutex);
+        return _original->pubsync();
+    }
+
+private:
+    streambuf* _original;
+    mutex _mutex;
+};
+
+// Restores the buffer of std::cout, even if scaling throws.
+struct CoutBufferGuard {
+    explicit CoutBufferGuard(streambuf* buffer) : original(cout.rdbuf(buffer))
+    {}
+    ~CoutBufferGuard() { cout.rdbuf(original); }
+    streambuf* original;
+};
+
+// The directory, made absolute, with a trailing separator.
+string absoluteDirectory(const string& path)
+{
+    const bool isAbsolute = !path.empty() && (path[0] == '/' ||
+            path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+    string dir = isAbsolute ? path : IO::getCwd() + "/" + path;
+    if (dir.back() != '/' && dir.back() != '\\') dir += '/';
+    return dir;
+}
+}
+
+BatchScaleTool::BatchScaleTool() = default;
+BatchScaleTool::~BatchScaleTool() = default;
+
+int BatchScaleTool::addSubject(const string& setupFileName)
+{
+    return addSubject(ScaleTool(setupFileName));
+}
+
+int BatchScaleTool::addSubject(const ScaleTool& subject)
+{
+    // Subjects are scaled with absolute paths, so that they do not depend on
+    // the working directory.
+    _subjects.emplace_back(subject.clone());
+    _subjects.back()->setPathToSubject(
+            absoluteDirectory(subject.getPathToSubject()));
+    return getNumSubjects() - 1;
+}
+
+const vector<BatchScaleTool::Result>& BatchScaleTool::run()
+{
+    const int numSubjects = getNumSubjects();
+    _results.assign(numSubjects, Result());
+    if (numSubjects == 0) return _results;
+
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = thread::hardware_concurrency();
+    numThreads = max(1, min(numThreads, numSubjects));
+
+    // Read each generic model file once, here, rather than once per subject.
+    // A model that cannot be read is left to the subjects' own ScaleTool,
+    // which reports the error in their logs.
+    map<string, unique_ptr<Model>> genericModels;
+    auto genericModelFile = [](const ScaleTool& subject) {
+        return subject.getPathToSubject() +
+               subject.getGenericModelMaker().getModelFileName();
+    };
+    for (const auto& subject : _subjects) {
+        if (subject->isDefaultGenericModelMaker()) continue;
+        const string file = genericModelFile(*subject);
+        if (genericModels.count(file)) continue;
+        try {
+            genericModels[file].reset(new Model(file));
+        } catch (const std::exception&) {
+            genericModels[file].reset();
+        }
+    }
+
+    SubjectLogBuffer logBuffer(cout.rdbuf());
+    unique_ptr<CoutBufferGuard> coutGuard;
+    if (_captureLogs) coutGuard.reset(new CoutBufferGuard(&logBuffer));
+
+    // Subjects are handed out one at a time, so that a thread that finishes
+    // its subject early takes the next one instead of idling.
+    atomic<int> nextSubject(0);
+    auto scaleSubjects = [&]() {
+        for (int i = nextSubject++; i < numSubjects; i = nextSubject++) {
+            const ScaleTool& subject = *_subjects[i];
+            Result& result = _results[i];
+            if (_captureLogs) threadLog = &result.log;
+            const auto start = chrono::steady_clock::now();
+            try {
+                auto it = genericModels.end();
+                if (!subject.isDefaultGenericModelMaker())
+                    it = genericModels.find(genericModelFile(subject));
+                result.success = it != genericModels.end() && it->second
+                        ? subject.run(*it->second) : subject.run();
+                if (!result.success)
+                    result.error = "Scaling subject " + subject.getName() +
+                                   " failed.";
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+            result.runTime = chrono::duration<double>(
+                    chrono::steady_clock::now() - start).count();
+            threadLog = nullptr;
+
+            if (_captureLogs && _writeLogFiles) {
+                ofstream logFile(subject.getPathToSubject() +
+                                 subject.getName() + "_scale.log");
+                logFile << result.log;
+                if (!result.error.empty()) logFile << result.error << endl;
+            }
+        }
+    };
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(scaleSubjects);
+        } catch (const system_error&) {
+            // Could not start a thread; the remaining threads take its
+            // subjects.
+            break;
+        }
+    }
+    scaleSubjects();
+    for (auto& thread : threads) thread.join();
+
+    return _results;
+}
@@ -0,0 +1,125 @@
+#ifndef OPENSIM_BATCH_SCALE_TOOL_H_
+#define OPENSIM_BATCH_SCALE_TOOL_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  BatchScaleTool.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ * Author(s): OpenSim Team                                                    *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class ScaleTool;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Scale many subjects (or trials), each described by the setup of a
+ * ScaleTool, concurrently. Each distinct generic model file is read once and
+ * shared by the subjects that scale it (see ScaleTool::run(const Model&));
+ * every subject then works on its own copy, and writes its outputs to its own
+ * directory, as it would if its ScaleTool were run alone.
+ *
+ * What each subject prints to std::cout while it is scaled is captured in
+ * its log (see Result), and optionally written to a file next to its setup,
+ * rather than interleaved with the output of the other subjects.
+ *
+ * @code
+ * BatchScaleTool batch;
+ * for (const auto& setup : {"s01/setup_scale.xml", "s02/setup_scale.xml"})
+ *     batch.addSubject(setup);
+ * const auto& results = batch.run();
+ * for (int i = 0; i < batch.getNumSubjects(); ++i)
+ *     if (!results[i].success) std::cout << results[i].error << std::endl;
+ * @endcode
+ */
+class OSIMTOOLS_API BatchScaleTool
+{
+public:
+    /** The outcome of scaling one subject. */
+    struct Result {
+        /** Whether ScaleTool::run() succeeded. */
+        bool success = false;
+        /** The message of the exception thrown while scaling, if any. */
+        std::string error;
+        /** What was printed to std::cout while scaling (empty if logs are
+        not captured; see setCaptureLogs()). */
+        std::string log;
+        /** Wall-clock time spent scaling the subject, in seconds. */
+        double runTime = 0;
+    };
+
+    BatchScaleTool();
+    ~BatchScaleTool();
+
+    BatchScaleTool(const BatchScaleTool&) = delete;
+    void operator=(const BatchScaleTool&) = delete;
+
+    /** Read the ScaleTool setup file of a subject, and return the index of
+    the subject. Relative paths in the setup are relative to the directory
+    of the setup file, as for the `scale` executable. */
+    int addSubject(const std::string& setupFileName);
+    /** Add a copy of a ScaleTool, whose paths are relative to its
+    getPathToSubject() (itself relative to the current working directory),
+    and return the index of the subject. */
+    int addSubject(const ScaleTool& subject);
+    int getNumSubjects() const { return int(_subjects.size()); }
+    const ScaleTool& getSubject(int index) const
+    {   return *_subjects.at(index); }
+
+    /** Number of subjects scaled at once; if not positive (the default), the
+    number of hardware threads is used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Whether to capture what each subject prints in its Result (default:
+    true). If false, the output of all subjects goes to std::cout. */
+    void setCaptureLogs(bool capture) { _captureLogs = capture; }
+    bool getCaptureLogs() const { return _captureLogs; }
+
+    /** Whether to also write each captured log to the file
+    `<subject name>_scale.log` in the subject's directory (default: false). */
+    void setWriteLogFiles(bool write) { _writeLogFiles = write; }
+    bool getWriteLogFiles() const { return _writeLogFiles; }
+
+    /** Scale every subject, and return the result of each, in the order the
+    subjects were added. A subject that fails does not stop the others. */
+    const std::vector<Result>& run();
+
+    /** The results of the last call to run(). */
+    const std::vector<Result>& getResults() const { return _results; }
+
+private:
+    std::vector<std::unique_ptr<ScaleTool>> _subjects;
+    std::vector<Result> _results;
+    int _numThreads = -1;
+    bool _captureLogs = true;
+    bool _writeLogFiles = false;
+
+};  // END of class BatchScaleTool
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_BATCH_SCALE_TOOL_H_
@@ -31,7 +31,9 @@
 //=============================================================================
 #include "CMC.h"
 #include "VectorFunctionForActuators.h"
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Common/RootSolver.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Simulation/Control/ControlConstant.h>
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Tools/CMC_Joint.h>
@@ -154,6 +156,9 @@ void CMC::copyData( const CMC &aCmc )
    _taskSet               = aCmc._taskSet;
    _paramList             = aCmc._paramList;
    _verbose               = aCmc._verbose;
+   _useCurvatureFilter    = aCmc._useCurvatureFilter;
+   _useLinearizedActuatorForces = aCmc._useLinearizedActuatorForces;
+   _reportSolverStatistics = aCmc._reportSolverStatistics;
    _predictor             = aCmc._predictor;
    _f                     = aCmc._f;
    _taskSet               = aCmc._taskSet;
@@ -202,6 +207,8 @@ setNull()
     _vErrStore.reset();
     _stressTermWeightStore.reset();
     _useCurvatureFilter = false;
+    _useLinearizedActuatorForces = false;
+    _reportSolverStatistics = false;
     _verbose = false;
     _paramList.setSize(0);
     _controlSet.setSize(0);
@@ -696,6 +703,8 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 {
     // CONTROLS SHOULD BE RECOMPUTED- NEED A NEW TARGET TIME
     _tf = s.getTime() + _targetDT;
+    OPENSIM_TRACE_SPAN("cmc", "window");
+    const SolverStatistics::Timer timer;
 
     int i,j;
 
@@ -706,7 +715,8 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     double tiReal = s.getTime(); 
     double tfReal = _tf; 
 
-    cout<<"CMC.computeControls:  t = "<<s.getTime()<<endl;
+    if(LogManager::shouldLog(LogManager::Level::Info))
+        cout<<"CMC.computeControls:  t = "<<s.getTime()<<endl;
     if(_verbose) { 
         cout<<"\n\n----------------------------------\n";
         cout<<"integration step size = "<<_targetDT<<",  target time = "<<_tf<<endl;
@@ -877,8 +887,15 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     _target->setParameterLimits(lowerBounds, upperBounds);
 
     // OPTIMIZER ERROR TRAP
+    // Warm start from the forces of the last window (zeros at the first),
+    // within this window's bounds.
     _f.setSize(N);
+    for(i=0;i<N;i++) {
+        if(SimTK::isNaN(_f[i])) _f[i] = 0;
+        _f[i] = SimTK::clamp(lowerBounds[i], _f[i], upperBounds[i]);
+    }
 
+    _target->resetNumEvaluations();
     if(!_target->prepareToOptimize(newState, &_f[0])) {
         // No direct solution, need to run optimizer
         Vector fVector(N,&_f[0],true);
@@ -887,6 +904,11 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
             _optimizer->optimize(fVector);
         }
         catch (const SimTK::Exception::Base& ex) {
+            if(_reportSolverStatistics) {
+                _solverStatistics.append(tiReal, timer.getElapsedTime(),
+                    _target->getNumGradientEvaluations(),
+                    _target->getNumEvaluations(), false);
+            }
             cout << ex.getMessage() << endl;
             cout << "OPTIMIZATION FAILED..." << endl;
             cout<<endl;
@@ -906,6 +928,10 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     } else {
         // Got a direct solution, don't need to run optimizer
     }
+    const int numIterations = _target->getNumGradientEvaluations();
+    // The evaluations of the actuator forces by the root solver, if used,
+    // are added below.
+    int numEvaluations = _target->getNumEvaluations();
 
     if(_verbose) _target->printPerformance(&_f[0]);
 
@@ -916,12 +942,35 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
 
     // ROOT SOLVE FOR EXCITATIONS
-    _predictor->setTargetForces(&_f[0]);
-    RootSolver rootSolver(_predictor);
-    Array<double> tol(4.0e-3,N);
-    Array<double> fErrors(0.0,N);
     Array<double> controls(0.0,N);
-    controls = rootSolver.solve(s, xmin,xmax,tol);
+    if(_useLinearizedActuatorForces) {
+        // Assume each actuator's force is linear in its control between the
+        // bounds, which is exact for actuators without states.
+        for(i=0;i<N;i++) {
+            range = fmax[i] - fmin[i];
+            if(xmax[i]==xmin[i] || range==0.0) {
+                controls[i] = xmin[i];
+            } else {
+                controls[i] = xmin[i] +
+                    (_f[i]-fmin[i])/range*(xmax[i]-xmin[i]);
+                controls[i] = SimTK::clamp(xmin[i], controls[i], xmax[i]);
+            }
+        }
+    } else {
+        // The actuators are uncoupled, so the force errors at the bounds
+        // follow from the forces computed above, without integrating the
+        // actuators again. Where xmax was set to xmin, so was the error.
+        _predictor->setTargetForces(&_f[0]);
+        RootSolver rootSolver(_predictor);
+        Array<double> tol(4.0e-3,N);
+        Array<double> fErrorsMin(0.0,N),fErrorsMax(0.0,N);
+        for(i=0;i<N;i++) {
+            fErrorsMin[i] = fmin[i] - _f[i];
+            fErrorsMax[i] = (xmax[i]==xmin[i] ? fmin[i] : fmax[i]) - _f[i];
+        }
+        controls = rootSolver.solve(s, xmin,xmax,fErrorsMin,fErrorsMax,tol);
+        numEvaluations += rootSolver.getNumEvaluations();
+    }
     if(_verbose) {
        cout<<"\n\nXXX t=" << _tf << "   Controls:" <<controls<<endl;
     }
@@ -932,6 +981,11 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     // SET EXCITATIONS
     controlSet.setControlValues(_tf,&controls[0]);
 
+    if(_reportSolverStatistics) {
+        _solverStatistics.append(tiReal, timer.getElapsedTime(),
+                                 numIterations, numEvaluations, true);
+    }
+
     _model->updAnalysisSet().setOn(true);
 }
 
@@ -959,6 +1013,70 @@ getUseCurvatureFilter() const
 {
     return(_useCurvatureFilter);
 }
+//_____________________________________________________________________________
+/**
+ * Set whether the controls should be found by interpolating linearly between
+ * the actuator forces at the bounds on the controls, rather than by a root
+ * solver that integrates the actuators over the window at each iteration.
+ * The interpolation is exact for actuators without states (e.g., reserve
+ * actuators), but only approximate for muscles, whose activation dynamics
+ * are nonlinear; it is off by default.
+ *
+ * @param aTrueFalse If true, the controls are interpolated. If false, they
+ * are found by the root solver.
+ */
+void CMC::
+setUseLinearizedActuatorForces(bool aTrueFalse)
+{
+    _useLinearizedActuatorForces = aTrueFalse;
+}
+//_____________________________________________________________________________
+/**
+ * Get whether the controls are found by interpolating linearly between the
+ * actuator forces at the bounds on the controls.
+ *
+ * @return True, if the controls are interpolated; false, if they are found
+ * by the root solver.
+ */
+bool CMC::
+getUseLinearizedActuatorForces() const
+{
+    return(_useLinearizedActuatorForces);
+}
+//_____________________________________________________________________________
+/**
+ * Set whether the wall time, optimizer iterations, function evaluations and
+ * convergence of each time window should be recorded (see
+ * getSolverStatistics()). It is off by default.
+ *
+ * The iterations are the gradient evaluations of the optimization target;
+ * a window solved directly by the target takes none.
+ */
+void CMC::
+setReportSolverStatistics(bool aTrueFalse)
+{
+    _reportSolverStatistics = aTrueFalse;
+}
+//_____________________________________________________________________________
+/**
+ * Get whether the cost of each time window is recorded.
+ */
+bool CMC::
+getReportSolverStatistics() const
+{
+    return(_reportSolverStatistics);
+}
+//_____________________________________________________________________________
+/**
+ * Get the cost of each time window computed so far, at the start time of
+ * the window. The windows computed for the initial states are added to the
+ * first window.
+ */
+const SolverStatistics& CMC::
+getSolverStatistics() const
+{
+    return(_solverStatistics);
+}
 
 const CMC_TaskSet& CMC::getTaskSet() const{
    return( *_taskSet );
@@ -32,6 +32,7 @@
 // INCLUDE
 //============================================================================
 #include "osimToolsDLL.h"
+#include <OpenSim/Common/SolverStatistics.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include <OpenSim/Simulation/Control/TrackingController.h>
 
@@ -127,6 +128,14 @@ protected:
     bool _verbose;
  
     bool _useCurvatureFilter;
+    /** Whether to find the controls by interpolating linearly between the
+    actuator forces at the bounds on the controls, rather than with a root
+    solver. */
+    bool _useLinearizedActuatorForces;
+    /** Whether to record the cost of each time window. */
+    bool _reportSolverStatistics;
+    /** The cost of each time window, if reported. */
+    SolverStatistics _solverStatistics;
     CMC_TaskSet *_taskSet;
 
     /** Vector function for estimating actuator forces over a specified time
@@ -181,6 +190,11 @@ public:
     bool getUseVerbosePrinting() const;
     void setUseCurvatureFilter(bool aTrueFalse);
     bool getUseCurvatureFilter() const;
+    void setUseLinearizedActuatorForces(bool aTrueFalse);
+    bool getUseLinearizedActuatorForces() const;
+    void setReportSolverStatistics(bool aTrueFalse);
+    bool getReportSolverStatistics() const;
+    const SolverStatistics& getSolverStatistics() const;
     const CMC_TaskSet& getTaskSet() const;
     CMC_TaskSet& updTaskSet() const;
 
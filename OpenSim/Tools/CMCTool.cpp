@@ -27,6 +27,7 @@
 #include "ActuatorForceTargetFast.h"
 #include "VectorFunctionForActuators.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -75,7 +76,8 @@ CMCTool::CMCTool() :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
 }
@@ -105,7 +107,8 @@ CMCTool::CMCTool(const string &aFileName, bool aLoadModel) :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     updateFromXMLDocument();
@@ -175,7 +178,8 @@ CMCTool(const CMCTool &aTool) :
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
     _maxIterations(_maxIterationsProp.getValueInt()),
     _printLevel(_printLevelProp.getValueInt()),
-    _verbose(_verboseProp.getValueBool())
+    _verbose(_verboseProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     *this = aTool;
@@ -208,6 +212,7 @@ setNull()
     _maxIterations = 1000;
     _printLevel = 0;
     _verbose = false;
+    _reportSolverStatistics = false;
 
     _replaceForceSet = false;   // default should be false for Forward.
     _solveForEquilibriumForAuxiliaryStates = true;
@@ -327,6 +332,12 @@ void CMCTool::setupProperties()
     _verboseProp.setName("use_verbose_printing");
     _propertySet.append( &_verboseProp );
 
+    comment = "True-false flag indicating whether or not to write the wall time, optimizer iterations, "
+                 "function evaluations and convergence of each time window to a solver_statistics file.";
+    _reportSolverStatisticsProp.setComment(comment);
+    _reportSolverStatisticsProp.setName("report_solver_statistics");
+    _propertySet.append( &_reportSolverStatisticsProp );
+
 }
 
 
@@ -365,6 +376,7 @@ operator=(const CMCTool &aTool)
     _maxIterations = aTool._maxIterations;
     _printLevel = aTool._printLevel;
     _verbose = aTool._verbose;
+    _reportSolverStatistics = aTool._reportSolverStatistics;
 
     return(*this);
 }
@@ -383,6 +395,7 @@ operator=(const CMCTool &aTool)
  */
 bool CMCTool::run()
 {
+    OPENSIM_TRACE_SPAN("tool", "CMCTool", getName());
     cout<<"Running tool "<<getName()<<".\n";
 
     // CHECK FOR A MODEL
@@ -732,6 +745,7 @@ bool CMCTool::run()
     if(_verbose) cout<<"\nSetting cmc controller to use verbose printing."<<endl;
     else cout<<"\nSetting cmc controller to not use verbose printing."<<endl;
     controller->setUseVerbosePrinting(_verbose);
+    controller->setReportSolverStatistics(_reportSolverStatistics);
 
     controller->setCheckTargetTime(true);
 
@@ -874,6 +888,10 @@ bool CMCTool::run()
     statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
     */
     controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
+    if(_reportSolverStatistics) {
+        controller->getSolverStatistics().print(
+                getResultsDir() + "/" + getName() + "_solver_statistics.sto");
+    }
 
     //_model->removeController(controller); // So that if this model is from GUI it doesn't double-delete it.
 
@@ -122,6 +122,10 @@ private:
     /** Flag for turning on and off verbose printing. */
     PropertyBool _verboseProp;
     bool &_verbose;
+    /** Flag for writing the wall time, optimizer iterations, function
+    evaluations and convergence of each time window. */
+    PropertyBool _reportSolverStatisticsProp;
+    bool &_reportSolverStatistics;
 
     ForceSet _originalForceSet;
 
@@ -192,6 +196,12 @@ public:
     bool getUseFastTarget() const { return _useFastTarget;};         
     void setUseFastTarget(bool useFastTarget) const {  _useFastTarget=useFastTarget; };
 
+    /** Whether to write the cost of each time window to
+    `<name>_solver_statistics.sto` in the results directory (default: false);
+    see CMC::setReportSolverStatistics(). */
+    bool getReportSolverStatistics() const { return _reportSolverStatistics; }
+    void setReportSolverStatistics(bool report) { _reportSolverStatistics = report; }
+
 
     //--------------------------------------------------------------------------
     // INTERFACE
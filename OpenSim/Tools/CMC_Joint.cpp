@@ -254,14 +254,8 @@ computeErrors(const SimTK::State& s, double aT)
     //std::cout<<_coordinateName<<std::endl;
     //std::cout<<"_pTrk[0]->calcValue(aT) = "<< _pTrk[0]->calcValue(SimTK::Vector(1, aT)) <<std::endl;
     //std::cout<<"_q->getValue(s) = "<<_q->getValue(s)<<std::endl;
-    _pErr[0] = _pTrk[0]->calcValue(SimTK::Vector(1,aT)) - _q->getValue(s);
-    if(_vTrk[0]==NULL) {
-        std::vector<int> derivComponents(1);
-        derivComponents[0]=0;
-        _vErr[0] = _pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aT)) - _q->getSpeedValue(s);
-    } else {
-        _vErr[0] = _vTrk[0]->calcValue(SimTK::Vector(1,aT)) - _q->getSpeedValue(s);
-    }
+    _pErr[0] = getTaskPosition(0,aT) - _q->getValue(s);
+    _vErr[0] = getTaskVelocity(0,aT) - _q->getSpeedValue(s);
 }
 //_____________________________________________________________________________
 /**
@@ -288,15 +282,7 @@ computeDesiredAccelerations(const SimTK::State& s, double aT)
     // DESIRED ACCELERATION
     double p = (_kp)[0]*_pErr[0];
     double v = (_kv)[0]*_vErr[0];
-    double a;
-    if(_aTrk[0]==NULL) {
-        std::vector<int> derivComponents(2);
-        derivComponents[0]=0;
-        derivComponents[1]=0;
-        a = (_ka)[0]*_pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
-    } else {
-        a = (_ka)[0]*_aTrk[0]->calcValue(SimTK::Vector(1,aT));
-    }
+    double a = (_ka)[0]*getTaskAcceleration(0,aT);
     _aDes[0] = a + v + p;
 
     // PRINT
@@ -317,7 +303,6 @@ computeDesiredAccelerations(const SimTK::State& s, double aT)
 void CMC_Joint::
 computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF)
 {
-    double a;
     _aDes=SimTK::NaN;
 
     // CHECK
@@ -330,15 +315,7 @@ computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF)
     // DESIRED ACCELERATION
     double p = (_kp)[0]*_pErr[0];
     double v = (_kv)[0]*_vErr[0];
-    
-    if(_aTrk[0]==NULL) {
-        std::vector<int> derivComponents(2);
-        derivComponents[0]=0;
-        derivComponents[1]=0;
-        a = (_ka)[0]*_pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aTF));
-    } else {
-        a = (_ka)[0]*_aTrk[0]->calcValue(SimTK::Vector(1,aTF));
-    }
+    double a = (_ka)[0]*getTaskAcceleration(0,aTF);
     _aDes[0] = a + v + p;
 
     // PRINT
@@ -370,6 +347,26 @@ computeAccelerations(const SimTK::State& s )
     // ACCELERATION
     _a[0] = _q->getAccelerationValue(s);
 }
+//_____________________________________________________________________________
+/**
+ * Compute the change in the acceleration of the coordinate due to a change
+ * in the generalized accelerations, which is simply the change in the
+ * coordinate's generalized acceleration.
+ */
+bool CMC_Joint::
+computeAccelerationJacobian(const SimTK::State& s,
+        SimTK::Matrix& rJacobian) const
+{
+    if(_model==NULL || _q==NULL) return false;
+
+    const SimTK::MobilizedBody& mobod =
+        _model->getMatterSubsystem().getMobilizedBody(
+            SimTK::MobilizedBodyIndex(_q->getBodyIndex()));
+    rJacobian.resize(3, s.getNU());
+    rJacobian = 0;
+    rJacobian(0, mobod.getFirstUIndex(s) + _q->getMobilizerQIndex()) = 1;
+    return true;
+}
 
 
 //=============================================================================
@@ -272,14 +272,8 @@ computeErrors(const SimTK::State& s, double aT)
     if(_expressBodyName == "ground") {
 
         for(int i=0;i<3;i++) {
-            _inertialPTrk[i] = _pTrk[i]->calcValue(SimTK::Vector(1,aT));
-            if(_vTrk[i]==NULL) {
-                std::vector<int> derivComponents(1);
-                derivComponents[0]=0;
-                _inertialVTrk[i] = _pTrk[i]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
-            } else {
-                _inertialVTrk[i] = _vTrk[i]->calcValue(SimTK::Vector(1,aT));
-            }
+            _inertialPTrk[i] = getTaskPosition(i,aT);
+            _inertialVTrk[i] = getTaskVelocity(i,aT);
         }
 
     } else {
@@ -289,14 +283,14 @@ computeErrors(const SimTK::State& s, double aT)
         SimTK::Vec3 pVec,vVec,origin;
 
         for(int i=0;i<3;i++) {
-            pVec(i) = _pTrk[i]->calcValue(SimTK::Vector(1,aT));
+            pVec(i) = getTaskPosition(i,aT);
         }
         _inertialPTrk = _expressBody->findStationLocationInGround(s, pVec);
         if(_vTrk[0]==NULL) {
             _inertialVTrk = _expressBody->findStationVelocityInGround(s, pVec);
         } else {
             for(int i=0;i<3;i++) {
-                vVec(i) = _vTrk[i]->calcValue(SimTK::Vector(1,aT));
+                vVec(i) = getTaskVelocity(i,aT);
             }
             _inertialVTrk = _expressBody->findStationVelocityInGround(s, origin); // get velocity of _expressBody origin in inertial frame
             _inertialVTrk += vVec; // _vTrk is velocity in _expressBody, so it is simply added to velocity of _expressBody origin in inertial frame
@@ -347,14 +341,7 @@ computeDesiredAccelerations(const SimTK::State& s, double aT)
     for(int i=0; i<3; i++) {
         p = (_kp)[0]*_pErr[i];
         v = (_kv)[0]*_vErr[i];
-        if(_aTrk[i]==NULL) {
-            std::vector<int> derivComponents(2);
-            derivComponents[0]=0;
-            derivComponents[1]=0;
-            a = (_ka)[0]*_pTrk[i]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
-        } else {
-            a = (_ka)[0]*_aTrk[i]->calcValue(SimTK::Vector(1,aT));
-        }
+        a = (_ka)[0]*getTaskAcceleration(i,aT);
         _aDes[i] = a + v + p;
     }
 
@@ -392,14 +379,7 @@ computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF)
     for(int i=0; i<3; i++) {
         p = (_kp)[0]*_pErr[i];
         v = (_kv)[0]*_vErr[i];
-        if(_aTrk[i]==NULL) {
-            std::vector<int> derivComponents(2);
-            derivComponents[0]=0;
-            derivComponents[1]=0;
-            a = (_ka)[0]*_pTrk[i]->calcDerivative(derivComponents,SimTK::Vector(1,aTF));
-        } else {
-            a = (_ka)[0]*_aTrk[i]->calcValue(SimTK::Vector(1,aTF));
-        }
+        a = (_ka)[0]*getTaskAcceleration(i,aTF);
         _aDes[i] = a + v + p;
     }
 
@@ -457,6 +437,49 @@ computeAccelerations(const SimTK::State& s )
                                             + "' references invalid acceleration components",__FILE__,__LINE__);
     }
 }
+//_____________________________________________________________________________
+/**
+ * Compute the Jacobian of the acceleration of the point (or of the
+ * whole-body center of mass), from the station Jacobian(s).
+ */
+bool CMC_Point::
+computeAccelerationJacobian(const SimTK::State& s,
+        SimTK::Matrix& rJacobian) const
+{
+    if(_model==NULL) return false;
+
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const BodySet& bs = _model->getBodySet();
+    if(_wrtBodyName == "center_of_mass") {
+        // The Jacobians of the bodies' mass centers, in one call.
+        const int nb = bs.getSize();
+        SimTK::Array_<SimTK::MobilizedBodyIndex> mobods(nb);
+        SimTK::Array_<SimTK::Vec3> stations(nb);
+        for(int i=0;i<nb;i++) {
+            mobods[i] = bs.get(i).getMobilizedBodyIndex();
+            stations[i] = bs.get(i).get_mass_center();
+        }
+        SimTK::Matrix stationJacobians;
+        matter.calcStationJacobian(s, mobods, stations, stationJacobians);
+
+        const int nu = stationJacobians.ncol();
+        rJacobian.resize(3, nu);
+        rJacobian = 0;
+        double Mass = 0.0;
+        for(int i=0;i<nb;i++) {
+            const double mass = bs.get(i).get_mass();
+            Mass += mass;
+            rJacobian += mass * stationJacobians(3*i, 0, 3, nu);
+        }
+        rJacobian /= Mass;
+    } else {
+        if(!bs.contains(_wrtBodyName)) return false;
+        const Body& body = bs.get(_wrtBodyName);
+        matter.calcStationJacobian(s, body.getMobilizedBodyIndex(), _point,
+                                   rJacobian);
+    }
+    return true;
+}
 
 //=============================================================================
 // XML
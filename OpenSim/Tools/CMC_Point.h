@@ -101,6 +101,8 @@ public:
     void computeDesiredAccelerations(const SimTK::State& s, double aT) override;
     void computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF) override;
     void computeAccelerations(const SimTK::State& s ) override;
+    bool computeAccelerationJacobian(const SimTK::State& s,
+            SimTK::Matrix& rJacobian) const override;
 
     //--------------------------------------------------------------------------
     // XML
@@ -125,6 +125,8 @@ setNull()
     _a[0] = _a[1] = _a[2] = 0.0;
     _j = NULL;
     _m = NULL;
+    _targetTime = SimTK::NaN;
+    _targetArg.resize(1);
 }
 //_____________________________________________________________________________
 /**
@@ -235,6 +237,7 @@ copyData(const CMC_Task &aTask)
         func = aTask.getTaskFunctionForAcceleration(i);
         if(func!=NULL) _aTrk[i] = func->clone();
     }
+    _targetTime = SimTK::NaN;
 }
 
 
@@ -566,6 +569,20 @@ getDirection_2(SimTK::Vec3& rR) const
 // TRACK FUNCTIONS - POSITION
 //-----------------------------------------------------------------------------
 //_____________________________________________________________________________
+/**
+ * Set the position track functions (see TrackingTask::setTaskFunctions()).
+ *
+ * @param aF0 Function for track goal 0.
+ * @param aF1 Function for track goal 1.
+ * @param aF2 Function for track goal 2.
+ */
+void CMC_Task::
+setTaskFunctions(OpenSim::Function *aF0, OpenSim::Function *aF1, OpenSim::Function *aF2)
+{
+    TrackingTask::setTaskFunctions(aF0,aF1,aF2);
+    _targetTime = SimTK::NaN;
+}
+//_____________________________________________________________________________
 /**
  * Get a specified track function.
  *
@@ -603,6 +620,7 @@ setTaskFunctionsForVelocity(OpenSim::Function *aF0, OpenSim::Function *aF1, Open
     if(aF0!=NULL) _vTrk[0] = aF0->clone();
     if(aF1!=NULL) _vTrk[1] = aF1->clone();
     if(aF2!=NULL) _vTrk[2] = aF2->clone();
+    _targetTime = SimTK::NaN;
 }
 //_____________________________________________________________________________
 /**
@@ -643,6 +661,7 @@ setTaskFunctionsForAcceleration(
     if(aF0!=NULL) _aTrk[0] = aF0->clone();
     if(aF1!=NULL) _aTrk[1] = aF1->clone();
     if(aF2!=NULL) _aTrk[2] = aF2->clone();
+    _targetTime = SimTK::NaN;
 }
 //_____________________________________________________________________________
 /**
@@ -679,8 +698,8 @@ getTaskPosition(int aWhich,double aT) const
         string msg = "CMC_Task: ERR- Invalid task.";
         throw( Exception(msg,__FILE__,__LINE__) );
     }
-    double position = _pTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
-    return(position);
+    evaluateTaskFunctions(aT);
+    return(_pTarget[aWhich]);
 }
 //_____________________________________________________________________________
 /**
@@ -698,17 +717,8 @@ getTaskVelocity(int aWhich,double aT) const
         string msg = "CMC_Task: ERR- Invalid task.";
         throw( Exception(msg,__FILE__,__LINE__) );
     }
-
-    double velocity;
-    if(_vTrk[aWhich]!=NULL) {
-        velocity = _vTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
-    } else {
-        std::vector<int> derivComponents(1);
-        derivComponents[0]=0;
-        velocity = _pTrk[aWhich]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
-    }
-
-    return( velocity );
+    evaluateTaskFunctions(aT);
+    return(_vTarget[aWhich]);
 }//_____________________________________________________________________________
 /**
  * Get the task acceleration.
@@ -725,18 +735,36 @@ getTaskAcceleration(int aWhich,double aT) const
         string msg = "CMC_Task: ERR- Invalid task.";
         throw( Exception(msg,__FILE__,__LINE__) );
     }
-
-    double acceleration;
-    if(_aTrk[aWhich]!=NULL) {
-        acceleration = _aTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
-    } else {
-        std::vector<int> derivComponents(2);
-        derivComponents[0]=0;
-        derivComponents[1]=0;
-        acceleration = _pTrk[aWhich]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
+    evaluateTaskFunctions(aT);
+    return(_aTarget[aWhich]);
+}
+//_____________________________________________________________________________
+/**
+ * Evaluate the task positions, velocities and accelerations of all the task
+ * goals at a time, unless they were last evaluated at that time.  Evaluating
+ * them together lets each spline reuse the lookup of the knot interval of
+ * the time for its derivatives.  A goal without a position function has NaN
+ * values.
+ *
+ * @param aT Time (in real time units).
+ */
+void CMC_Task::
+evaluateTaskFunctions(double aT) const
+{
+    if(aT==_targetTime) return;
+
+    static const std::vector<int> first(1,0), second(2,0);
+    _targetArg[0] = aT;
+    _pTarget = _vTarget = _aTarget = SimTK::NaN;
+    for(int i=0;i<_nTrk;i++) {
+        if(_pTrk[i]==NULL) continue;
+        _pTarget[i] = _pTrk[i]->calcValue(_targetArg);
+        _vTarget[i] = _vTrk[i]!=NULL ? _vTrk[i]->calcValue(_targetArg) :
+                      _pTrk[i]->calcDerivative(first,_targetArg);
+        _aTarget[i] = _aTrk[i]!=NULL ? _aTrk[i]->calcValue(_targetArg) :
+                      _pTrk[i]->calcDerivative(second,_targetArg);
     }
-
-    return( acceleration );
+    _targetTime = aT;
 }
 
 
@@ -891,6 +919,36 @@ getAcceleration(int aWhich) const
 //=============================================================================
 // COMPUTATIONS
 //=============================================================================
+//-----------------------------------------------------------------------------
+// ACCELERATION CHANGE
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Compute the change in the accelerations due to a change in UDot, from the
+ * task Jacobian.
+ */
+bool CMC_Task::
+computeAccelerationChange(const SimTK::State& s,
+        const SimTK::Vector& udotChange, Vec3& aChange) const
+{
+    SimTK::Matrix jacobian;
+    if(!computeAccelerationJacobian(s, jacobian)) return false;
+    const SimTK::Vector change = jacobian*udotChange;
+    aChange = SimTK::Vec3(change[0], change[1], change[2]);
+    return true;
+}
+//_____________________________________________________________________________
+/**
+ * Compute the task Jacobian, which maps UDot to the task accelerations.  This
+ * method should be overridden in derived classes that can provide it.
+ */
+bool CMC_Task::
+computeAccelerationJacobian(const SimTK::State& s,
+        SimTK::Matrix& rJacobian) const
+{
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 // JACOBIAN
 //-----------------------------------------------------------------------------
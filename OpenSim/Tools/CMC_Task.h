@@ -122,6 +122,15 @@ protected:
     /** Effective mass matrix. */
     double *_m;
 
+private:
+    /** Time at which the task functions were last evaluated (NaN if they
+    have not been, or have changed since). */
+    mutable double _targetTime;
+    /** Task positions, velocities and accelerations at _targetTime. */
+    mutable SimTK::Vec3 _pTarget, _vTarget, _aTarget;
+    /** Argument of the task functions, reused from call to call. */
+    mutable SimTK::Vector _targetArg;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -137,6 +146,7 @@ private:
     void setNull();
     void setupProperties();
     void copyData(const CMC_Task &aTaskObject);
+    void evaluateTaskFunctions(double aT) const;
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -181,6 +191,8 @@ public:
     void setDirection_2(const SimTK::Vec3& aR);
     void getDirection_2(SimTK::Vec3& rR) const;
     // TASK FUNCTIONS
+    void setTaskFunctions(Function *aF0,
+        Function *aF1=NULL,Function *aF2=NULL) override;
     Function* getTaskFunction(int aWhich) const;
     void setTaskFunctionsForVelocity(Function *aF0,
         Function *aF1=NULL,Function *aF2=NULL);
@@ -189,6 +201,12 @@ public:
         Function *aF1=NULL,Function *aF2=NULL);
     Function* getTaskFunctionForAcceleration(int aWhich) const;
     // TASK KINEMATICS
+    /** The task positions, velocities and accelerations are evaluated
+    together, for all the task goals, the first time one of them is asked
+    for at a time aT, and kept until they are asked for at another time. The
+    task velocities (accelerations) are the first (second) derivatives of the
+    position functions for the goals that have no velocity (acceleration)
+    function. */
     double getTaskPosition(int aWhich,double aT) const;
     double getTaskVelocity(int aWhich,double aT) const;
     double getTaskAcceleration(int aWhich,double aT) const;
@@ -212,6 +230,25 @@ public:
     virtual void computeDesiredAccelerations(const SimTK::State& s, double aT) = 0;
     virtual void computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF) = 0;
     virtual void computeAccelerations(const SimTK::State& s ) = 0;
+    /** Compute the change in this task's accelerations (see
+    getAcceleration()) due to a change in the generalized accelerations
+    (UDot), at a state realized to at least Stage::Velocity. The task's
+    accelerations are linear in UDot, so the change is the product of the
+    task's Jacobian (see computeAccelerationJacobian()) and the change in
+    UDot.
+    @returns false if the task does not provide its Jacobian. */
+    virtual bool computeAccelerationChange(const SimTK::State& s,
+            const SimTK::Vector& udotChange, SimTK::Vec3& aChange) const;
+    /** Compute this task's Jacobian: the 3 x NU matrix whose row k maps the
+    generalized accelerations (UDot) to the task's acceleration k (see
+    getAcceleration()), at a state realized to at least Stage::Velocity.
+    Only the rows of the active task goals need be valid. The product of
+    the Jacobian and a change in UDot is the change in the task's
+    accelerations.
+    @returns false if the task does not provide its Jacobian (the
+    default). */
+    virtual bool computeAccelerationJacobian(const SimTK::State& s,
+            SimTK::Matrix& rJacobian) const;
     virtual void computeJacobian();
     virtual void computeEffectiveMassMatrix();
 
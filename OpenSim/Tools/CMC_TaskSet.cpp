@@ -934,5 +934,40 @@ computeAccelerations(const SimTK::State& s)
     //printf("CMC_TaskSet.computeAccelerations: %d ",_a.size());
     //printf("track goals are active.\n");
 }
+//_____________________________________________________________________________
+/**
+ * Compute the Jacobian of the accelerations of all the tasks' active goals
+ * with respect to the generalized accelerations.  The state must be realized
+ * to at least Stage::Velocity.
+ *
+ * @param rJacobian Jacobian, with a row per active task goal.
+ * @return Whether all the tasks with active goals provided their Jacobians.
+ */
+bool CMC_TaskSet::
+computeAccelerationJacobian(const SimTK::State& s,
+                            SimTK::Matrix& rJacobian) const
+{
+    int nc = 0;
+    for(int i=0;i<getSize();i++) {
+        const CMC_Task* task = dynamic_cast<const CMC_Task*>(&get(i));
+        if(task==NULL) continue;
+        for(int j=0;j<3;j++) if(task->getActive(j)) nc++;
+    }
+    rJacobian.resize(nc,s.getNU());
+
+    SimTK::Matrix taskJacobian;
+    for(int i=0,c=0;i<getSize();i++) {
+        const CMC_Task* task = dynamic_cast<const CMC_Task*>(&get(i));
+        if(task==NULL) continue;
+        if(!(task->getActive(0) || task->getActive(1) || task->getActive(2)))
+            continue;
+        if(!task->computeAccelerationJacobian(s,taskJacobian)) return false;
+        for(int j=0;j<3;j++) {
+            if(!task->getActive(j)) continue;
+            rJacobian[c++] = taskJacobian[j];
+        }
+    }
+    return true;
+}
 
 
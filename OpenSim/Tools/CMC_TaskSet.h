@@ -153,6 +153,14 @@ public:
     void computeDesiredAccelerations(const SimTK::State& s, double aT);
     void computeDesiredAccelerations(const SimTK::State& s, double aTCurrent,double aTFuture);
     void computeAccelerations(const SimTK::State& s );
+    /** Assemble the Jacobians of the tasks (see
+    CMC_Task::computeAccelerationJacobian()) into one matrix, with a row per
+    active task goal, in the order of getAccelerations(), and a column per
+    generalized speed.
+    @returns false if a task with active goals does not provide its
+    Jacobian. */
+    bool computeAccelerationJacobian(const SimTK::State& s,
+                                     SimTK::Matrix& rJacobian) const;
 
 
 //=============================================================================
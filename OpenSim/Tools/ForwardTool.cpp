@@ -26,9 +26,11 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "ForwardTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Tracer.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/PararealManager.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include "CorrectionController.h"
 
@@ -57,7 +59,8 @@ ForwardTool::~ForwardTool()
 ForwardTool::ForwardTool() :
     AbstractTool(),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _pararealWindows(_pararealWindowsProp.getValueInt())
 {
     setNull();
 }
@@ -73,7 +76,8 @@ ForwardTool::ForwardTool() :
 ForwardTool::ForwardTool(const string &aFileName,bool aUpdateFromXMLNode,bool aLoadModel) :
     AbstractTool(aFileName, false),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _pararealWindows(_pararealWindowsProp.getValueInt())
 {
     setNull();
 
@@ -126,7 +130,8 @@ ForwardTool::
 ForwardTool(const ForwardTool &aTool) :
     AbstractTool(aTool),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _pararealWindows(_pararealWindowsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -143,6 +148,7 @@ void ForwardTool::setNull()
     // BASIC
     _statesFileName = "";
     _useSpecifiedDt = false;
+    _pararealWindows = 0;
     _printResultFiles = true;
 
     _replaceForceSet = false;   // default should be false for Forward.
@@ -188,6 +194,14 @@ void ForwardTool::setupProperties()
     _useSpecifiedDtProp.setName("use_specified_dt");
     _propertySet.append( &_useSpecifiedDtProp );
 
+    comment = "(Experimental) Number of windows into which the simulation is split "
+                 "to be integrated in parallel with the parareal algorithm (see "
+                 "PararealManager). Only the continuous states are passed between "
+                 "windows, and analyses are not run. If 0 (the default), the "
+                 "simulation is integrated serially.";
+    _pararealWindowsProp.setComment(comment);
+    _pararealWindowsProp.setName("parareal_windows");
+    _propertySet.append( &_pararealWindowsProp );
 
 }
 
@@ -211,6 +225,7 @@ operator=(const ForwardTool &aTool)
     // BASIC INPUT
     _statesFileName = aTool._statesFileName;
     _useSpecifiedDt = aTool._useSpecifiedDt;
+    _pararealWindows = aTool._pararealWindows;
 
     return(*this);
 }
@@ -229,6 +244,7 @@ operator=(const ForwardTool &aTool)
  */
 bool ForwardTool::run()
 {
+    OPENSIM_TRACE_SPAN("tool", "ForwardTool", getName());
     cout<<"Running tool "<<getName()<<"."<<endl;
     // CHECK FOR A MODEL
     if(_model==NULL) {
@@ -307,8 +323,18 @@ bool ForwardTool::run()
 
         cout<<"\n\nIntegrating from "<<_ti<<" to "<<_tf<<endl;
         s.setTime(_ti);
-        manager.initialize(s);
-        manager.integrate(_tf);
+        if(_pararealWindows > 0) {
+            cout<<"Integrating in "<<_pararealWindows<<" parareal windows"<<endl;
+            PararealManager parareal(*_model);
+            parareal.setNumWindows(_pararealWindows);
+            parareal.setFineAccuracy(_errorTolerance);
+            parareal.integrate(s, _tf);
+            cout<<"Parareal iterations: "<<parareal.getNumIterations()<<endl;
+            manager.setStateStorage(*new Storage(parareal.getStateStorage()));
+        } else {
+            manager.initialize(s);
+            manager.integrate(_tf);
+        }
     } catch(const std::exception& x) {
         cout << "ForwardTool::run() caught exception \n";
         cout << x.what() << endl;
@@ -71,6 +71,11 @@ protected:
     OpenSim::PropertyBool _useSpecifiedDtProp;
     bool &_useSpecifiedDt;
 
+    /** (Experimental) If positive, the simulation is split into this many
+    windows that are integrated concurrently with PararealManager. */
+    OpenSim::PropertyInt _pararealWindowsProp;
+    int &_pararealWindows;
+
     /** Storage for the input states. */
     Storage *_yStore;
     /** Flag indicating whether or not to write to the results (GUI will set this to false). */
@@ -120,6 +125,9 @@ public:
     bool getUseSpecifiedDt() const { return _useSpecifiedDt; }
     void setUseSpecifiedDt(bool aUseSpecifiedDt) { _useSpecifiedDt = aUseSpecifiedDt; }
 
+    int getPararealWindows() const { return _pararealWindows; }
+    void setPararealWindows(int aNumWindows) { _pararealWindows = aNumWindows; }
+
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
 
     //--------------------------------------------------------------------------
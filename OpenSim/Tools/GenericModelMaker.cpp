@@ -27,6 +27,8 @@
 #include "GenericModelMaker.h"
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <memory>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -159,20 +161,47 @@ Model* GenericModelMaker::processModel(const string& aPathToSubject) const
 
     try
     {
-        model = new Model(aPathToSubject + _fileName);
-        model->initSystem();
-
-        if (!_markerSetFileNameProp.getValueIsDefault() && _markerSetFileName !="Unassigned") {
-            cout << "Loading marker set from '" << aPathToSubject+_markerSetFileName+"'" << endl;
-            MarkerSet *markerSet = new MarkerSet(*model, aPathToSubject + _markerSetFileName);
-            model->updateMarkerSet(*markerSet);
-        }
+        model = Model::createFromFile(aPathToSubject + _fileName);
+        initializeModel(*model, aPathToSubject);
     }
     catch (const Exception& x)
     {
         x.print(cout);
+        delete model;
         return NULL;
     }
 
     return model;
 }
+
+Model* GenericModelMaker::processModel(const Model& aGenericModel,
+                                       const string& aPathToSubject) const
+{
+    cout << endl << "Step 1: Copying generic model " << aGenericModel.getName()
+         << endl;
+
+    std::unique_ptr<Model> model(aGenericModel.clone());
+    try
+    {
+        initializeModel(*model, aPathToSubject);
+    }
+    catch (const Exception& x)
+    {
+        x.print(cout);
+        return NULL;
+    }
+
+    return model.release();
+}
+
+void GenericModelMaker::initializeModel(Model& aModel,
+                                        const string& aPathToSubject) const
+{
+    aModel.initSystem();
+
+    if (!_markerSetFileNameProp.getValueIsDefault() && _markerSetFileName !="Unassigned") {
+        cout << "Loading marker set from '" << aPathToSubject+_markerSetFileName+"'" << endl;
+        MarkerSet *markerSet = new MarkerSet(aModel, aPathToSubject + _markerSetFileName);
+        aModel.updateMarkerSet(*markerSet);
+    }
+}
@@ -81,6 +81,12 @@ public:
     void copyData(const GenericModelMaker &aGenericModelMaker);
 
     Model* processModel(const std::string& aPathToSubject="") const;
+    /** Like processModel(const std::string&), but copy the given generic
+    model rather than loading the model file, e.g., to scale many subjects
+    from a model that is read once (see BatchScaleTool). The marker set file,
+    if any, is still read relative to aPathToSubject. */
+    Model* processModel(const Model& aGenericModel,
+                        const std::string& aPathToSubject="") const;
 
     /* Register types to be used when reading a GenericModelMaker object from xml file. */
     static void registerTypes();
@@ -114,6 +120,10 @@ public:
 private:
     void setNull();
     void setupProperties();
+    // Initialize the model and replace its markers with those of the marker
+    // set file, if any.
+    void initializeModel(Model& aModel,
+                         const std::string& aPathToSubject) const;
 //=============================================================================
 };  // END of class GenericModelMaker
 //=============================================================================
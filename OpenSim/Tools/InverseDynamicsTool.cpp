@@ -29,6 +29,8 @@
 #include <OpenSim/Simulation/InverseDynamicsSolver.h>
 #include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/ResultCache.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Common/FunctionSet.h> 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/Constant.h>
@@ -60,7 +62,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
 }
@@ -79,7 +82,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     updateFromXMLDocument();
@@ -101,7 +105,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     *this = aTool;
@@ -117,6 +122,8 @@ void InverseDynamicsTool::setNull()
     _model = NULL;
     _lowpassCutoffFrequency = -1.0;
     _coordinateValues = NULL;
+    _numThreads = 1;
+    _resultCacheDirectory = "";
 }
 //_____________________________________________________________________________
 /**
@@ -148,6 +155,11 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _reportSolverStatisticsProp.setComment("Flag indicating whether or not to report the wall time of each frame.");
+    _reportSolverStatisticsProp.setName("report_solver_statistics");
+    _reportSolverStatisticsProp.setValue(false);
+    _propertySet.append(&_reportSolverStatisticsProp);
 }
 
 //_____________________________________________________________________________
@@ -179,7 +191,10 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _reportSolverStatistics = aTool._reportSolverStatistics;
     _coordinateValues = NULL;
+    _numThreads = aTool._numThreads;
+    _resultCacheDirectory = aTool._resultCacheDirectory;
 
     return(*this);
 }
@@ -233,6 +248,7 @@ void InverseDynamicsTool::getJointsByName(Model &model, const Array<std::string>
  */
 bool InverseDynamicsTool::run()
 {
+    OPENSIM_TRACE_SPAN("tool", "InverseDynamicsTool", getName());
     bool success = false;
     bool modelFromFile=true;
     try{
@@ -241,7 +257,7 @@ bool InverseDynamicsTool::run()
             OPENSIM_THROW_IF_FRMOBJ(_modelFileName.empty(), Exception,
                 "No model filename was provided.")
 
-            _model = new Model(_modelFileName);
+            _model = Model::createFromFile(_modelFileName);
         }
         else
             modelFromFile = false;
@@ -252,6 +268,15 @@ bool InverseDynamicsTool::run()
         cout<<"Running tool " << getName() <<".\n"<<endl;
 
         /*bool externalLoads = */createExternalLoads(_externalLoadsFileName, *_model, _coordinateValues);
+        // The external loads files are named relative to the current
+        // directory, so hash them before changing it.
+        ResultCache::Key cacheKey;
+        if (!_resultCacheDirectory.empty() && _externalLoadsFileName != "" &&
+                _externalLoadsFileName != "Unassigned") {
+            for (const auto& fileName :
+                    _externalLoads.getInputFileNames(_externalLoadsFileName))
+                cacheKey.addFile(fileName);
+        }
         // Initialize the model's underlying computational system and get its default state.
         SimTK::State& s = _model->initSystem();
 
@@ -266,6 +291,27 @@ bool InverseDynamicsTool::run()
 
         FunctionSet *coordFunctions = NULL;
 
+        bool useCache = false;
+        if (!_resultCacheDirectory.empty() && loadCoordinateValues()) {
+            cacheKey.add(getConcreteClassName()).add(_model->computeFingerprint())
+                    .add(dump()).addStorage(*_coordinateValues);
+            JointSet joints;
+            getJointsByName(*_model, _jointsForReportingBodyForces, joints);
+            if (getResultsDir() != "") IO::makeDir(getResultsDir());
+            if (ResultCache(_resultCacheDirectory).restore(
+                    cacheKey.toString(),
+                    getOutputFileNames(joints.getSize() > 0))) {
+                cout << "InverseDynamicsTool " << getName() << ": restored "
+                     << "the results from the cache (key "
+                     << cacheKey.toString() << ")." << endl;
+                _solverStatistics.clear();
+                IO::chDir(saveWorkingDirectory);
+                if (modelFromFile) delete _model;
+                return true;
+            }
+            useCache = true;
+        }
+
         if (loadCoordinateValues()){
             if(_lowpassCutoffFrequency>=0) {
                 cout << "\n\nLow-pass filtering coordinates data with a cutoff frequency of "
@@ -318,6 +364,7 @@ bool InverseDynamicsTool::run()
 
         // create the solver given the input data
         InverseDynamicsSolver ivdSolver(*_model);
+        ivdSolver.setNumThreads(_numThreads);
 
         const clock_t start = clock();
 
@@ -333,9 +380,19 @@ bool InverseDynamicsTool::run()
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, *coordFunctions, times, genForceTraj);
+        {
+            OPENSIM_TRACE_SPAN("id", "solve");
+            ivdSolver.solve(s, *coordFunctions, times, genForceTraj);
+        }
         success = true;
 
+        _solverStatistics.clear();
+        if (_reportSolverStatistics) {
+            const auto& wallTimes = ivdSolver.getFrameWallTimes();
+            for (int i = 0; i < nt; i++)
+                _solverStatistics.append(times[i], wallTimes[i], 0, 1, true);
+        }
+
         cout << "InverseDynamicsTool: " << nt << " time frames in " 
             << (double)(clock()-start)/CLOCKS_PER_SEC << "s\n" <<endl;
     
@@ -408,7 +465,10 @@ bool InverseDynamicsTool::run()
 
         IO::makeDir(getResultsDir());
         Storage::printResult(&genForceResults, _outputGenForceFileName, getResultsDir(), -1, ".sto");
-        IO::chDir(saveWorkingDirectory);
+        if (_reportSolverStatistics) {
+            _solverStatistics.print(getResultsDir() + "/" + getName() +
+                                    "_id_solver_statistics.sto");
+        }
 
         // if body forces to be reported for specified joints
         if(nj >0){
@@ -417,9 +477,14 @@ bool InverseDynamicsTool::run()
 
             IO::makeDir(getResultsDir());
             Storage::printResult(&bodyForcesResults, _outputBodyForcesAtJointsFileName, getResultsDir(), -1, ".sto");
-            IO::chDir(saveWorkingDirectory);
         }
 
+        if (useCache) {
+            ResultCache(_resultCacheDirectory).store(cacheKey.toString(),
+                                                     getOutputFileNames(nj > 0));
+        }
+        IO::chDir(saveWorkingDirectory);
+
     }
     catch (const OpenSim::Exception& ex) {
         std::cout << "InverseDynamicsTool Failed: " << ex.what() << std::endl;
@@ -442,6 +507,25 @@ bool InverseDynamicsTool::loadCoordinateValues()
     }
     return false;
 }
+std::vector<std::string> InverseDynamicsTool::getOutputFileNames(
+        bool reportBodyForces) const
+{
+    // The names given to Storage::printResult().
+    const std::string directory = getResultsDir() == "" ? "." : getResultsDir();
+    auto resultFileName = [&directory](const std::string& name) {
+        return directory + "/" + name +
+               (name.rfind(".sto") == std::string::npos ? ".sto" : "");
+    };
+    std::vector<std::string> fileNames{resultFileName(_outputGenForceFileName)};
+    if (_reportSolverStatistics) {
+        fileNames.push_back(getResultsDir() + "/" + getName() +
+                            "_id_solver_statistics.sto");
+    }
+    if (reportBodyForces)
+        fileNames.push_back(resultFileName(_outputBodyForcesAtJointsFileName));
+    return fileNames;
+}
+
 /* Handle reading older formats/Versioning */
 void InverseDynamicsTool::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 {
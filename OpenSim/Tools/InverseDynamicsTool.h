@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/Common/SolverStatistics.h>
 #include <OpenSim/Common/Storage.h>
 #include "DynamicsTool.h"
 
@@ -88,6 +89,20 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** flag indicating whether or not to report the cost of each frame */
+    PropertyBool _reportSolverStatisticsProp;
+    bool &_reportSolverStatistics;
+
+    /** The cost of each frame of the last run(), if reported. */
+    SolverStatistics _solverStatistics;
+
+    /** Number of threads over which frames are solved; see
+    setNumThreads(). */
+    int _numThreads;
+
+    /** Directory of the cache of results; see setResultCacheDirectory(). */
+    std::string _resultCacheDirectory;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -115,6 +130,8 @@ private:
     /* If CoordinatesFile property is populated, load data into a live _coordinateValues
     storage object. */
     bool loadCoordinateValues();
+    /* The files that run() writes, in the working directory of the run. */
+    std::vector<std::string> getOutputFileNames(bool reportBodyForces) const;
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -156,6 +173,35 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /** Number of threads over which the frames are solved; see
+    InverseDynamicsSolver::setNumThreads(). The default, 1, solves all
+    frames serially; if not positive, the number of hardware threads is
+    used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+    /** Whether to record the wall time of each frame, written to
+    `<name>_id_solver_statistics.sto` in the results directory (default:
+    false). Inverse dynamics is solved directly, so each frame takes no
+    iterations and one function evaluation. */
+    void setReportSolverStatistics(bool report)
+    {   _reportSolverStatistics = report; }
+    bool getReportSolverStatistics() const { return _reportSolverStatistics; }
+    /** The cost of each frame of the last run(), if reported. */
+    const SolverStatistics& getSolverStatistics() const
+    {   return _solverStatistics; }
+    /** Cache the output files of run() in the given directory (see
+    ResultCache), under a key that hashes the model's fingerprint (see
+    Model::computeFingerprint()), the coordinate values, the contents of the
+    external loads files (see ExternalLoads::getInputFileNames()), and this
+    tool's settings. A run whose key is in the cache copies the stored files
+    to its outputs instead of solving. The default, an empty string, turns
+    the cache off. A relative directory is relative to the directory of the
+    setup file, as the outputs are. The solver statistics of a run served
+    from the cache are empty, though their file is restored. */
+    void setResultCacheDirectory(const std::string& directory)
+    {   _resultCacheDirectory = directory; }
+    const std::string& getResultCacheDirectory() const
+    {   return _resultCacheDirectory; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
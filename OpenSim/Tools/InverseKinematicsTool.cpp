@@ -28,7 +28,13 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
+#include <OpenSim/Common/Parallelism.h>
+#include <OpenSim/Common/ResultCache.h>
+#include <OpenSim/Common/RunControl.h>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/Constant.h>
@@ -40,6 +46,10 @@
 #include "IKCoordinateTask.h"
 #include "IKMarkerTask.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -70,7 +80,8 @@ InverseKinematicsTool::InverseKinematicsTool() : Tool(),
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
 }
@@ -95,7 +106,8 @@ InverseKinematicsTool::InverseKinematicsTool(const string &aFileName, bool aLoad
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     updateFromXMLDocument();
@@ -123,7 +135,8 @@ InverseKinematicsTool::InverseKinematicsTool(const InverseKinematicsTool &aTool)
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _reportSolverStatistics(_reportSolverStatisticsProp.getValueBool())
 {
     setNull();
     *this = aTool;
@@ -137,6 +150,11 @@ void InverseKinematicsTool::setNull()
 {
     setupProperties();
     _model = NULL;
+    _runControl = NULL;
+    _numThreads = 1;
+    _predictionOrder = 0;
+    _loosestAccuracy = 0;
+    _resultCacheDirectory = "";
 }
 //_____________________________________________________________________________
 /**
@@ -216,6 +234,13 @@ void InverseKinematicsTool::setupProperties()
     _reportMarkerLocationsProp.setName("report_marker_locations");
     _reportMarkerLocationsProp.setValue(false);
     _propertySet.append(&_reportMarkerLocationsProp);
+
+    _reportSolverStatisticsProp.setComment(
+        "Flag indicating whether or not to report the wall time, iterations "
+        "and function evaluations of each frame.");
+    _reportSolverStatisticsProp.setName("report_solver_statistics");
+    _reportSolverStatisticsProp.setValue(false);
+    _propertySet.append(&_reportSolverStatisticsProp);
 }
 
 //_____________________________________________________________________________
@@ -252,6 +277,11 @@ operator=(const InverseKinematicsTool &aTool)
     _reportErrors = aTool._reportErrors;
     _outputMotionFileName = aTool._outputMotionFileName;
     _reportMarkerLocations = aTool._reportMarkerLocations;
+    _reportSolverStatistics = aTool._reportSolverStatistics;
+    _numThreads = aTool._numThreads;
+    _predictionOrder = aTool._predictionOrder;
+    _loosestAccuracy = aTool._loosestAccuracy;
+    _resultCacheDirectory = aTool._resultCacheDirectory;
 
     return(*this);
 }
@@ -268,16 +298,162 @@ operator=(const InverseKinematicsTool &aTool)
 /**
  * Run the inverse kinematics tool.
  */
+namespace {
+// The solution of one frame, and the quantities reported for it.
+struct IKFrameSolution {
+    SimTK::Vector q, u;
+    double totalSquaredError = 0;
+    double maxSquaredError = 0;
+    int worst = -1;
+    std::vector<double> markerLocations;
+    // The cost of solving the frame.
+    double wallTime = 0;
+    int iterations = 0;
+    int functionEvaluations = 0;
+    // Whether the frame was assembled rather than tracked, and how it was
+    // tracked with adaptive accuracy.
+    bool assembled = false;
+    double accuracy = 0;
+    bool refined = false;
+};
+
+// Record the solution the solver has just found for the frame in s.
+void recordFrame(InverseKinematicsSolver& ikSolver, const SimTK::State& s,
+                 bool reportErrors, bool reportMarkerLocations,
+                 IKFrameSolution& frame)
+{
+    frame.q = s.getQ();
+    frame.u = s.getU();
+    frame.iterations = ikSolver.getNumIterationsInLastSolve();
+    frame.functionEvaluations =
+            ikSolver.getNumFunctionEvaluationsInLastSolve();
+    frame.accuracy = ikSolver.getAccuracyInLastSolve();
+    frame.refined = ikSolver.getRefinedInLastSolve();
+    const int nm = ikSolver.getNumMarkersInUse();
+    if (reportErrors) {
+        SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
+        ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+        frame.totalSquaredError = 0.0;
+        frame.maxSquaredError = 0.0;
+        frame.worst = -1;
+        for (int j = 0; j < nm; ++j) {
+            frame.totalSquaredError += squaredMarkerErrors[j];
+            if (squaredMarkerErrors[j] > frame.maxSquaredError) {
+                frame.maxSquaredError = squaredMarkerErrors[j];
+                frame.worst = j;
+            }
+        }
+    }
+    if (reportMarkerLocations) {
+        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
+        ikSolver.computeCurrentMarkerLocations(markerLocations);
+        frame.markerLocations.resize(3*nm);
+        for (int j = 0; j < nm; ++j)
+            for (int k = 0; k < 3; ++k)
+                frame.markerLocations[3*j+k] = markerLocations[j][k];
+    }
+}
+
+// Solve frames first to last in numChunks contiguous chunks, on up to
+// numThreads threads, each with a copy of the model; each chunk has its own
+// copy of the references and the solver. The first frame of each chunk is
+// assembled from the model's default state; the rest are tracked. Each
+// frame is a step of the control, if any.
+void solveFramesInChunks(const Model& model,
+        const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight, double accuracy, int predictionOrder,
+        double loosestAccuracy, const std::vector<double>& times, int first, int last, int numChunks,
+        int numThreads, bool reportErrors, bool reportMarkerLocations,
+        RunControl* control, std::vector<IKFrameSolution>& frames)
+{
+    // The copies are initialized here, rather than on the threads, so that
+    // building the Systems does not need to be thread-safe.
+    numThreads = std::max(1, std::min(numThreads, numChunks));
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    std::vector<SimTK::State> defaultStates(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        models[t].reset(model.clone());
+        models[t]->setUseVisualizer(false);
+        defaultStates[t] = models[t]->initSystem();
+    }
+
+    const int numFrames = last - first + 1;
+    // The message of the error encountered by each chunk, if any.
+    std::vector<std::string> errors(numChunks);
+    auto solveChunk = [&](int c, int t) {
+        try {
+            MarkersReference markers(markersReference);
+            SimTK::Array_<CoordinateReference> coordinates(
+                    coordinateReferences);
+            InverseKinematicsSolver ikSolver(*models[t], markers,
+                    coordinates, constraintWeight);
+            ikSolver.setAccuracy(accuracy);
+            ikSolver.setTrackingPredictionOrder(predictionOrder);
+            ikSolver.setAdaptiveAccuracy(loosestAccuracy);
+            SimTK::State s = defaultStates[t];
+            const int begin = numFrames*c/numChunks;
+            const int end = numFrames*(c+1)/numChunks;
+            for (int k = begin; k < end; ++k) {
+                if (control) control->step();
+                s.updTime() = times[first + k];
+                OPENSIM_TRACE_SPAN("ik", "track frame");
+                const SolverStatistics::Timer timer;
+                if (k == begin) ikSolver.assemble(s);
+                else ikSolver.track(s);
+                frames[k].wallTime = timer.getElapsedTime();
+                recordFrame(ikSolver, s, reportErrors, reportMarkerLocations,
+                            frames[k]);
+                frames[k].assembled = k == begin;
+            }
+        }
+        catch (const std::exception& e) {
+            errors[c] = e.what();
+        }
+    };
+    // Chunks are handed out in order, so that a thread that finishes its
+    // chunk early takes the next one.
+    std::atomic<int> nextChunk(0);
+    auto solveChunks = [&](int t) {
+        for (int c = nextChunk++; c < numChunks; c = nextChunk++)
+            solveChunk(c, t);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(solveChunks, t);
+        } catch (const std::system_error&) {
+            // Could not start a thread; the remaining threads take its
+            // chunks.
+            break;
+        }
+    }
+    solveChunks(0);
+    for (auto& thread : threads) thread.join();
+
+    if (control) control->checkCancelled();
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("InverseKinematicsTool: " + errorMsg,
+                            __FILE__, __LINE__);
+    }
+}
+} // anonymous namespace
+
 bool InverseKinematicsTool::run()
 {
+    OPENSIM_TRACE_SPAN("tool", "InverseKinematicsTool", getName());
     bool success = false;
     bool modelFromFile=true;
+    // Do the maneuver to change then restore working directory so that the
+    // parsing code behaves properly if called from a different directory.
+    string saveWorkingDirectory = IO::getCwd();
     try{
         //Load and create the indicated model
         if (!_model) {
             OPENSIM_THROW_IF_FRMOBJ(_modelFileName.empty(), Exception,
                 "No model filename was provided.");
-            _model = new Model(_modelFileName);
+            _model = Model::createFromFile(_modelFileName);
         }
         else
             modelFromFile = false;
@@ -287,17 +463,57 @@ bool InverseKinematicsTool::run()
         _model->finalizeFromProperties();
         _model->printBasicInfo();
 
-        // Do the maneuver to change then restore working directory so that the
-        // parsing code behaves properly if called from a different directory.
-        string saveWorkingDirectory = IO::getCwd();
         string directoryOfSetupFile = IO::getParentDirectory(getDocumentFileName());
         IO::chDir(directoryOfSetupFile);
 
+        std::string cacheKey;
+        if (!_resultCacheDirectory.empty()) {
+            ResultCache::Key key;
+            key.add(getConcreteClassName()).add(_model->computeFingerprint())
+               .add(dump()).add(std::to_string(_predictionOrder))
+               .add(std::to_string(_loosestAccuracy))
+               .addFile(_markerFileName);
+            if (_coordinateFileName != "" &&
+                    _coordinateFileName != "Unassigned")
+                key.addFile(_coordinateFileName);
+            cacheKey = key.toString();
+            if (getResultsDir() != "") IO::makeDir(getResultsDir());
+            if (ResultCache(_resultCacheDirectory).restore(cacheKey,
+                                                    getOutputFileNames())) {
+                cout << "InverseKinematicsTool " << getName() << ": restored "
+                     << "the results from the cache (key " << cacheKey
+                     << ")." << endl;
+                _solverStatistics.clear();
+                _outputStorage = Storage();
+                if (_outputMotionFileName != "" &&
+                        _outputMotionFileName != "Unassigned")
+                    _outputStorage = Storage(_outputMotionFileName);
+                IO::chDir(saveWorkingDirectory);
+                if (modelFromFile) delete _model;
+                return true;
+            }
+        }
+
+        // Without other analyses, the results are written straight into
+        // preallocated tables, rather than through a Kinematics analysis
+        // and Storages.
+        const bool directOutput = _model->getAnalysisSet().getSize() == 0;
+
         // Define reporter for output
         Kinematics kinematicsReporter;
         kinematicsReporter.setRecordAccelerations(false);
         kinematicsReporter.setInDegrees(true);
-        _model->addAnalysis(&kinematicsReporter);
+        if (!directOutput) _model->addAnalysis(&kinematicsReporter);
+        // Remove the analysis we added however run() exits, but don't
+        // delete it as it was allocated on the stack.
+        struct ReporterRemover {
+            Model& model;
+            Analysis* reporter;
+            ~ReporterRemover() {
+                if (reporter) model.removeAnalysis(reporter, false);
+            }
+        } reporterRemover{*_model,
+                          directOutput ? nullptr : &kinematicsReporter};
 
         cout<<"Running tool "<<getName()<<".\n";
 
@@ -339,9 +555,11 @@ bool InverseKinematicsTool::run()
         InverseKinematicsSolver ikSolver(*_model, markersReference,
             coordinateReferences, _constraintWeight);
         ikSolver.setAccuracy(_accuracy);
+        ikSolver.setTrackingPredictionOrder(_predictionOrder);
+        ikSolver.setAdaptiveAccuracy(_loosestAccuracy);
         s.updTime() = times[start_ix];
         ikSolver.assemble(s);
-        kinematicsReporter.begin(s);
+        if (!directOutput) kinematicsReporter.begin(s);
 
         AnalysisSet& analysisSet = _model->updAnalysisSet();
         analysisSet.begin(s);
@@ -349,71 +567,195 @@ bool InverseKinematicsTool::run()
         // can be fewer than the number of references if there isn't a
         // corresponding model marker for each reference.
         int nm = ikSolver.getNumMarkersInUse();
-        SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
-        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
-        
-        Storage *modelMarkerLocations = _reportMarkerLocations ?
-            new Storage(Nframes, "ModelMarkerLocations") : nullptr;
-        Storage *modelMarkerErrors = _reportErrors ? 
+
+        Storage *modelMarkerLocations = _reportMarkerLocations &&
+            !directOutput ? new Storage(Nframes, "ModelMarkerLocations")
+                          : nullptr;
+        Storage *modelMarkerErrors = _reportErrors && !directOutput ?
             new Storage(Nframes, "ModelMarkerErrors") : nullptr;
 
+        // The tables have a row per frame, filled in as the frames are
+        // reported.
+        const CoordinateSet& coordinates = _model->getCoordinateSet();
+        const int nc = coordinates.getSize();
+        TimeSeriesTable coordinateTable, errorTable, locationTable;
+        std::vector<bool> isRotational(nc);
+        if (directOutput) {
+            const std::vector<double> frameTimes(times.begin() + start_ix,
+                                                 times.begin() + final_ix + 1);
+            std::vector<std::string> labels(nc);
+            for (int j = 0; j < nc; ++j) {
+                labels[j] = coordinates[j].getName();
+                isRotational[j] = coordinates[j].getMotionType() ==
+                                  Coordinate::Rotational;
+            }
+            coordinateTable = TimeSeriesTable(frameTimes,
+                    SimTK::Matrix(Nframes, nc), labels);
+            coordinateTable.addTableMetaData<std::string>("header",
+                                                          "Coordinates");
+            coordinateTable.addTableMetaData<std::string>("inDegrees", "yes");
+            if (_reportErrors) {
+                errorTable = TimeSeriesTable(frameTimes,
+                        SimTK::Matrix(Nframes, 3),
+                        {"total_squared_error", "marker_error_RMS",
+                         "marker_error_max"});
+                errorTable.addTableMetaData<std::string>("header",
+                        "Model Marker Errors from IK");
+            }
+            if (_reportMarkerLocations) {
+                const char* XYZ[3] = { "_tx", "_ty", "_tz" };
+                labels.resize(3*nm);
+                for (int j = 0; j < nm; ++j)
+                    for (int k = 0; k < 3; ++k)
+                        labels[3*j+k] = ikSolver.getMarkerNameForIndex(j) +
+                                        XYZ[k];
+                locationTable = TimeSeriesTable(frameTimes,
+                        SimTK::Matrix(Nframes, 3*nm), labels);
+                locationTable.addTableMetaData<std::string>("header",
+                        "Model Marker Locations from IK");
+            }
+        }
+
         const clock_t start = clock();
+        _solverStatistics.clear();
+        if (_runControl) _runControl->setNumSteps(Nframes);
+
+        // The tracked frames, and their iterations, solved at the accuracy
+        // of the tool and started at a relaxed accuracy.
+        int numNominal = 0, numRelaxed = 0, numRefined = 0;
+        long long nominalIterations = 0, relaxedIterations = 0;
+
+        // Report a solved frame; s holds its solution.
+        auto reportFrame = [&](int i, const IKFrameSolution& frame) {
+            const int row = i - start_ix;
+            if (frame.refined || frame.accuracy > _accuracy) {
+                ++numRelaxed;
+                if (frame.refined) ++numRefined;
+                relaxedIterations += frame.iterations;
+            }
+            else if (!frame.assembled) {
+                ++numNominal;
+                nominalIterations += frame.iterations;
+            }
+            if (directOutput) {
+                auto& q = coordinateTable.updMatrix();
+                for (int j = 0; j < nc; ++j) {
+                    q(row, j) = coordinates[j].getValue(s);
+                    if (isRotational[j]) q(row, j) *= SimTK_RADIAN_TO_DEGREE;
+                }
+            }
 
-        for (int i = start_ix; i <= final_ix; ++i) {
-            s.updTime() = times[i];
-            ikSolver.track(s);
-            
             if(_reportErrors){
-                Array<double> markerErrors(0.0, 3);
-                double totalSquaredMarkerError = 0.0;
-                double maxSquaredMarkerError = 0.0;
-                int worst = -1;
-
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
-                for(int j=0; j<nm; ++j){
-                    totalSquaredMarkerError += squaredMarkerErrors[j];
-                    if(squaredMarkerErrors[j] > maxSquaredMarkerError){
-                        maxSquaredMarkerError = squaredMarkerErrors[j];
-                        worst = j;
-                    }
+                double rms = nm > 0 ? sqrt(frame.totalSquaredError / nm) : 0;
+                double markerErrors[3] = { frame.totalSquaredError, rms,
+                                           sqrt(frame.maxSquaredError) };
+                if (directOutput) {
+                    for (int k = 0; k < 3; ++k)
+                        errorTable.updMatrix()(row, k) = markerErrors[k];
+                }
+                else
+                    modelMarkerErrors->append(s.getTime(), 3, markerErrors);
+
+                if (getVerboseLevel() >= Progress &&
+                        LogManager::shouldLog(LogManager::Level::Info)) {
+                    cout << "Frame " << i << " (t=" << s.getTime() << "):\t"
+                        << "total squared error = " << frame.totalSquaredError
+                        << ", marker error: RMS=" << rms << ", max="
+                        << sqrt(frame.maxSquaredError) << " ("
+                        << ikSolver.getMarkerNameForIndex(frame.worst) << ")"
+                        << endl;
                 }
-
-                double rms = nm > 0 ? sqrt(totalSquaredMarkerError / nm) : 0;
-                markerErrors.set(0, totalSquaredMarkerError); 
-                markerErrors.set(1, rms);
-                markerErrors.set(2, sqrt(maxSquaredMarkerError));
-                modelMarkerErrors->append(s.getTime(), 3, &markerErrors[0]);
-
-                cout << "Frame " << i << " (t=" << s.getTime() << "):\t"
-                    << "total squared error = " << totalSquaredMarkerError
-                    << ", marker error: RMS=" << rms << ", max="
-                    << sqrt(maxSquaredMarkerError) << " (" 
-                    << ikSolver.getMarkerNameForIndex(worst) << ")" << endl;
             }
 
             if(_reportMarkerLocations){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
-                Array<double> locations(0.0, 3*nm);
-                for(int j=0; j<nm; ++j){
-                    for(int k=0; k<3; ++k)
-                        locations.set(3*j+k, markerLocations[j][k]);
+                if (directOutput) {
+                    for (int k = 0; k < 3*nm; ++k)
+                        locationTable.updMatrix()(row, k) =
+                                frame.markerLocations[k];
                 }
+                else
+                    modelMarkerLocations->append(s.getTime(), 3*nm,
+                                                 &frame.markerLocations[0]);
+            }
 
-                modelMarkerLocations->append(s.getTime(), 3*nm, &locations[0]);
-
+            if (_reportSolverStatistics) {
+                // The tracking solver throws if it does not converge.
+                _solverStatistics.append(s.getTime(), frame.wallTime,
+                        frame.iterations, frame.functionEvaluations, true);
             }
 
-            kinematicsReporter.step(s, i);
-            analysisSet.step(s, i);
+            if (!directOutput) {
+                kinematicsReporter.step(s, i);
+                analysisSet.step(s, i);
+            }
+        };
+
+        int numThreads = _numThreads;
+        if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+        // Each chunk has at least two frames. In deterministic mode, the
+        // number of chunks does not depend on the number of threads.
+        const int numChunks = Parallelism::getNumBlocks(Nframes, numThreads, 2);
+
+        if (numChunks == 1) {
+            IKFrameSolution frame;
+            for (int i = start_ix; i <= final_ix; ++i) {
+                if (_runControl) _runControl->step();
+                s.updTime() = times[i];
+                OPENSIM_TRACE_SPAN("ik", "track frame");
+                const SolverStatistics::Timer timer;
+                ikSolver.track(s);
+                frame.wallTime = timer.getElapsedTime();
+                recordFrame(ikSolver, s, _reportErrors,
+                            _reportMarkerLocations, frame);
+                reportFrame(i, frame);
+            }
+        }
+        else {
+            std::vector<IKFrameSolution> frames(Nframes);
+            solveFramesInChunks(*_model, markersReference,
+                coordinateReferences, _constraintWeight, _accuracy,
+                _predictionOrder, _loosestAccuracy, times,
+                start_ix, final_ix, numChunks, numThreads, _reportErrors,
+                _reportMarkerLocations, _runControl, frames);
+            for (int i = start_ix; i <= final_ix; ++i) {
+                const IKFrameSolution& frame = frames[i - start_ix];
+                s.updTime() = times[i];
+                s.updQ() = frame.q;
+                s.updU() = frame.u;
+                if (!directOutput)
+                    _model->getMultibodySystem().realize(s,
+                                                    SimTK::Stage::Velocity);
+                reportFrame(i, frame);
+            }
         }
 
         // Do the maneuver to change then restore working directory 
         // so that output files are saved to same folder as setup file.
-        if (_outputMotionFileName!= "" && _outputMotionFileName!="Unassigned"){
-            kinematicsReporter.getPositionStorage()->print(_outputMotionFileName);
+        if (directOutput) {
+            if (_outputMotionFileName != "" &&
+                    _outputMotionFileName != "Unassigned")
+                STOFileAdapter::write(coordinateTable, _outputMotionFileName);
+            _outputStorage = Storage(coordinateTable);
+
+            const std::string dir =
+                    getResultsDir() == "" ? "." : getResultsDir();
+            if (_reportErrors) {
+                IO::makeDir(getResultsDir());
+                STOFileAdapter::write(errorTable,
+                        dir + "/" + trialName + "_ik_marker_errors.sto");
+            }
+            if (_reportMarkerLocations) {
+                IO::makeDir(getResultsDir());
+                STOFileAdapter::write(locationTable, dir + "/" + trialName +
+                                      "_ik_model_marker_locations.sto");
+            }
+        }
+        else {
+            if (_outputMotionFileName!= "" && _outputMotionFileName!="Unassigned"){
+                kinematicsReporter.getPositionStorage()->print(_outputMotionFileName);
+            }
+            _outputStorage = *kinematicsReporter.getPositionStorage();
         }
-        // Remove the analysis we added, don't delete as it was allocated on stack
-        _model->removeAnalysis(&kinematicsReporter, false);
 
         if (modelMarkerErrors) {
             Array<string> labels("", 4);
@@ -454,6 +796,36 @@ bool InverseKinematicsTool::run()
             delete modelMarkerLocations;
         }
 
+        if (_reportSolverStatistics) {
+            IO::makeDir(getResultsDir());
+            _solverStatistics.print(getResultsDir() + "/" + trialName +
+                                    "_ik_solver_statistics.sto");
+        }
+
+        if (!cacheKey.empty()) {
+            ResultCache(_resultCacheDirectory).store(cacheKey,
+                                                     getOutputFileNames());
+        }
+
+        if (_loosestAccuracy > _accuracy) {
+            cout << "InverseKinematicsTool: " << numRelaxed << " of "
+                 << Nframes << " frames were solved at a relaxed accuracy "
+                 << "(at most " << _loosestAccuracy << "), in "
+                 << relaxedIterations << " iterations; " << numRefined
+                 << " of them were solved again at the accuracy "
+                 << _accuracy << "." << endl;
+            if (numNominal > 0 && numRelaxed > 0) {
+                // The relaxed frames are assumed to have cost, at the
+                // accuracy of the tool, as much as the other tracked frames.
+                const double saved = numRelaxed*double(nominalIterations)/
+                                     numNominal - relaxedIterations;
+                cout << "InverseKinematicsTool: adaptive accuracy saved an "
+                     << "estimated " << saved << " of "
+                     << nominalIterations + relaxedIterations + saved
+                     << " assembler iterations." << endl;
+            }
+        }
+
         IO::chDir(saveWorkingDirectory);
 
         success = true;
@@ -461,6 +833,16 @@ bool InverseKinematicsTool::run()
         cout << "InverseKinematicsTool completed " << Nframes << " frames in "
             <<(double)(clock()-start)/CLOCKS_PER_SEC << "s\n" <<endl;
     }
+    catch (const RunCancelled&) {
+        std::cout << "InverseKinematicsTool " << getName() << " was cancelled."
+                  << std::endl;
+        IO::chDir(saveWorkingDirectory);
+        if (modelFromFile) {
+            delete _model;
+            _model = NULL;
+        }
+        throw;
+    }
     catch (const std::exception& ex) {
         std::cout << "InverseKinematicsTool Failed: " << ex.what() << std::endl;
         throw (Exception("InverseKinematicsTool Failed, "
@@ -472,6 +854,23 @@ bool InverseKinematicsTool::run()
     return success;
 }
 
+std::vector<std::string> InverseKinematicsTool::getOutputFileNames() const
+{
+    std::vector<std::string> fileNames;
+    if (_outputMotionFileName!= "" && _outputMotionFileName!="Unassigned")
+        fileNames.push_back(_outputMotionFileName);
+    const std::string prefix =
+        (getResultsDir() == "" ? "." : getResultsDir()) + "/" + getName();
+    if (_reportErrors)
+        fileNames.push_back(prefix + "_ik_marker_errors.sto");
+    if (_reportMarkerLocations)
+        fileNames.push_back(prefix + "_ik_model_marker_locations.sto");
+    if (_reportSolverStatistics)
+        fileNames.push_back(getResultsDir() + "/" + getName() +
+                            "_ik_solver_statistics.sto");
+    return fileNames;
+}
+
 // Handle conversion from older format
 void InverseKinematicsTool::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 {
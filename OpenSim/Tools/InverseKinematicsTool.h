@@ -26,6 +26,8 @@
 #include "osimToolsDLL.h"
 #include <OpenSim/Common/PropertyDbl.h>
 #include <OpenSim/Common/PropertyDblArray.h>
+#include <OpenSim/Common/SolverStatistics.h>
+#include <OpenSim/Common/Storage.h>
 #include "Tool.h"
 
 #ifdef SWIG
@@ -38,6 +40,7 @@
 namespace OpenSim {
 
 class Model;
+class RunControl;
 class IKTaskSet;
 class MarkersReference;
 class CoordinateReference;
@@ -107,6 +110,33 @@ private:
     PropertyBool _reportMarkerLocationsProp;
     bool &_reportMarkerLocations;
 
+    // flag indicating whether or not to report the cost of each frame
+    PropertyBool _reportSolverStatisticsProp;
+    bool &_reportSolverStatistics;
+
+    /** The cost of each frame of the last run(), if reported. */
+    SolverStatistics _solverStatistics;
+
+    /** Number of threads over which frames are solved; see
+    setNumThreads(). */
+    int _numThreads;
+
+    /** Order of the extrapolation of each frame's initial guess; see
+    setTrackingPredictionOrder(). */
+    int _predictionOrder;
+
+    /** Loosest accuracy of the frames, or 0; see setAdaptiveAccuracy(). */
+    double _loosestAccuracy;
+
+    /** Directory of the cache of results; see setResultCacheDirectory(). */
+    std::string _resultCacheDirectory;
+
+    /** The coordinates solved by the last run(); see getOutputStorage(). */
+    Storage _outputStorage;
+
+    /** Follows the progress of run(); see setRunControl(). Not copied. */
+    RunControl* _runControl;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -137,11 +167,87 @@ public:
 
     void setCoordinateFileName(const std::string& coordDataFileName) { _coordinateFileName=coordDataFileName;};
     const std::string& getCoordinateFileName() const { return  _coordinateFileName;};
-    
-    //const OpenSim::Storage& getOutputStorage() const;
+
+    /** Solve the frames in numThreads contiguous chunks concurrently, each
+    with its own copy of the model and its own InverseKinematicsSolver, and
+    then report them in time order as if they had been solved serially.
+    The first frame of each chunk is assembled from the model's default
+    pose, as the first frame of the trial is, rather than tracked from the
+    previous frame, so the solution can differ at the chunk boundaries
+    within the accuracy of the solver. The default, 1, solves all frames
+    serially; if not positive, the number of hardware threads is used. In
+    deterministic mode (see Parallelism), the frames are solved in a fixed
+    number of chunks, whatever the number of threads, so that the solution
+    does not depend on it. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Order of the polynomial through the previous solutions from which the
+    initial guess of each frame is extrapolated (0, the default, starts from
+    the previous frame's solution; 1 is linear and 2 quadratic); see
+    AssemblySolver::setTrackingPredictionOrder(). */
+    void setTrackingPredictionOrder(int order) { _predictionOrder = order; }
+    int getTrackingPredictionOrder() const { return _predictionOrder; }
+
+    /** Let the accuracy of the tracked frames relax, down to
+    loosestAccuracy, while the marker errors and the change of the solution
+    from frame to frame do not grow, and tighten back to the accuracy of the
+    tool where they do; a relaxed frame whose error grew is solved again at
+    the accuracy of the tool. See AssemblySolver::setAdaptiveAccuracy(). At
+    the end of run(), the frames solved at a relaxed accuracy, and the
+    assembler iterations saved (estimated from the mean iterations of the
+    other tracked frames), are reported. The default, 0, solves every frame
+    at the accuracy of the tool. */
+    void setAdaptiveAccuracy(double loosestAccuracy)
+    {   _loosestAccuracy = loosestAccuracy; }
+    double getAdaptiveAccuracy() const { return _loosestAccuracy; }
+
+    /** Whether to record the wall time, assembly iterations and function
+    evaluations of each frame, written to `<name>_ik_solver_statistics.sto`
+    in the results directory (default: false). Frames solved in parallel
+    (see setNumThreads()) report the wall time of their own thread. */
+    void setReportSolverStatistics(bool report)
+    {   _reportSolverStatistics = report; }
+    bool getReportSolverStatistics() const { return _reportSolverStatistics; }
+    /** The cost of each frame of the last run(), if reported. */
+    const SolverStatistics& getSolverStatistics() const
+    {   return _solverStatistics; }
+
+    /** Cache the output files of run() in the given directory (see
+    ResultCache), under a key that hashes the model's fingerprint (see
+    Model::computeFingerprint()), the contents of the marker and coordinate
+    files, and this tool's settings. A run whose key is in the cache copies
+    the stored files to its outputs instead of solving the frames. The
+    default, an empty string, turns the cache off. A relative directory is
+    relative to the directory of the setup file, as the outputs are.
+    The number of threads is not part of the key, though the solution can
+    differ with it within the accuracy of the solver; the solver statistics
+    (see getSolverStatistics()) of a run served from the cache are empty,
+    though their file is restored. */
+    void setResultCacheDirectory(const std::string& directory)
+    {   _resultCacheDirectory = directory; }
+    const std::string& getResultCacheDirectory() const
+    {   return _resultCacheDirectory; }
+
+
+    /** The coordinates (in degrees) solved by the last run(), as written to
+    the output motion file; empty before the first run. A run served from
+    the result cache reads them back from the output motion file. */
+    const Storage& getOutputStorage() const { return _outputStorage; }
+
+#ifndef SWIG
+    /** Report the frames solved by run() to the given RunControl, which can
+    also cancel the run: run() then stops at its next frame, restores the
+    working directory, and throws RunCancelled, without writing its outputs.
+    The RunControl must outlive the runs; pass nullptr (the default) to stop
+    reporting. See ToolJob to run the tool in the background. */
+    void setRunControl(RunControl* control) { _runControl = control; }
+#endif
 private:
     void setNull();
     void setupProperties();
+    // The files that run() writes, in the working directory of the run.
+    std::vector<std::string> getOutputFileNames() const;
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -159,6 +265,9 @@ public:
         _outputMotionFileName = aOutputMotionFileName;
     }
     std::string getOutputMotionFileName() { return _outputMotionFileName;}
+    void setModelFileName(const std::string& modelFileName)
+    {   _modelFileName = modelFileName; }
+    const std::string& getModelFileName() const { return _modelFileName; }
     IKTaskSet& getIKTaskSet() { return _ikTaskSet; }
 
     //--------------------------------------------------------------------------
@@ -392,33 +392,26 @@ bool MarkerPlacer::processModel(Model* aModel,
     //_outputStorage->print("statesReporterOutputWithMarkers.sto");
 
     if(_printResultFiles) {
-        std::string savedCwd = IO::getCwd();
-        IO::chDir(aPathToSubject);
-
-        try { // writing can throw an exception
-            if (_outputModelFileNameProp.isValidFileName()) {
-                aModel->print(aPathToSubject + _outputModelFileName);
-                cout << "Wrote model file " << _outputModelFileName <<
-                    " from model " << aModel->getName() << endl;
-            }
+        // The file names are already relative to the subject's directory, so
+        // the working directory (shared by subjects scaled concurrently; see
+        // BatchScaleTool) is left alone.
+        if (_outputModelFileNameProp.isValidFileName()) {
+            aModel->print(aPathToSubject + _outputModelFileName);
+            cout << "Wrote model file " << _outputModelFileName <<
+                " from model " << aModel->getName() << endl;
+        }
 
-            if (_outputMarkerFileNameProp.isValidFileName()) {
-                aModel->writeMarkerFile(aPathToSubject + _outputMarkerFileName);
-                cout << "Wrote marker file " << _outputMarkerFileName <<
-                    " from model " << aModel->getName() << endl;
-            }
+        if (_outputMarkerFileNameProp.isValidFileName()) {
+            aModel->writeMarkerFile(aPathToSubject + _outputMarkerFileName);
+            cout << "Wrote marker file " << _outputMarkerFileName <<
+                " from model " << aModel->getName() << endl;
+        }
 
-            if (_outputMotionFileNameProp.isValidFileName()) {
-                _outputStorage->print(aPathToSubject + _outputMotionFileName,
-                    "w", "File generated from solving marker data for model "
-                    + aModel->getName());
-            }
-        } // catch the exception so we can reset the working directory
-        catch (std::exception& ex) {
-            IO::chDir(savedCwd);
-            OPENSIM_THROW_FRMOBJ(Exception, ex.what());
+        if (_outputMotionFileNameProp.isValidFileName()) {
+            _outputStorage->print(aPathToSubject + _outputMotionFileName,
+                "w", "File generated from solving marker data for model "
+                + aModel->getName());
         }
-        IO::chDir(savedCwd);
     }
 
     return true;
@@ -0,0 +1,383 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ModelPopulation.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelPopulation.h"
+#include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+#include <OpenSim/Common/ScaleSet.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace OpenSim {
+
+struct ModelPopulation::Subject {
+    string name;
+    unique_ptr<Model> model;
+    SimTK::State state;
+};
+
+struct ModelPopulation::RigidTendonParameters {
+    vector<double> maxIsometricForce;
+    vector<double> optimalFiberLength;
+    vector<double> tendonSlackLength;
+    vector<double> maxFiberVelocity;
+    vector<double> minimumFiberLength;
+    vector<double> parallelogramHeight;
+    vector<double> pennationMinimumFiberLength;
+    vector<double> pennationMinimumFiberLengthAlongTendon;
+    vector<double> maximumSinPennation;
+    vector<double> maximumPennationAngle;
+    vector<double> minimumActivation;
+    vector<double> fiberDamping;
+    vector<char> isPennated;
+};
+
+namespace {
+// The path and type of every component, which subjects must share.
+vector<string> getComponentSignature(const Model& model)
+{
+    vector<string> signature;
+    for (const auto& comp : model.getComponentList<Component>())
+        signature.push_back(comp.getAbsolutePathString() + " " +
+                            comp.getConcreteClassName());
+    return signature;
+}
+
+// The path of the coordinate a column of the coordinates table refers to, or
+// an empty string if it refers to none. isSpeed is set for speed columns.
+string findCoordinatePath(const Model& model, const string& label,
+                          bool& isSpeed)
+{
+    isSpeed = false;
+    if (model.getCoordinateSet().contains(label))
+        return model.getCoordinateSet().get(label).getAbsolutePathString();
+
+    const auto slash = label.rfind('/');
+    if (slash == string::npos) return "";
+    const string suffix = label.substr(slash + 1);
+    const string path = label.substr(0, slash);
+    if ((suffix != "value" && suffix != "speed") ||
+            !model.hasComponent<Coordinate>(path))
+        return "";
+    isSpeed = suffix == "speed";
+    return model.getComponent<Coordinate>(path).getAbsolutePathString();
+}
+} // anonymous namespace
+
+ModelPopulation::ModelPopulation(const Model& genericModel)
+:   _generic(genericModel.clone())
+{
+    _generic->setUseVisualizer(false);
+    _generic->initSystem();
+    _componentSignature = getComponentSignature(*_generic);
+    for (const auto& muscle : _generic->getComponentList<Muscle>())
+        _muscleNames.push_back(muscle.getAbsolutePathString());
+    for (const auto& body : _generic->getComponentList<Body>())
+        _bodyNames.push_back(body.getAbsolutePathString());
+    _muscleParameters.resize(_muscleNames.size());
+    _bodyMasses.resize(_bodyNames.size());
+    for (const auto& name : _muscleNames) {
+        const auto* muscle = dynamic_cast<const Millard2012EquilibriumMuscle*>(
+                &_generic->getComponent<Muscle>(name));
+        _rigidTendon.emplace_back(
+                muscle ? new RigidTendonParameters() : nullptr);
+    }
+}
+
+ModelPopulation::~ModelPopulation() = default;
+
+int ModelPopulation::addSubject(const string& name, const Model& subjectModel)
+{
+    unique_ptr<Subject> subject(new Subject());
+    subject->name = name;
+    subject->model.reset(subjectModel.clone());
+    subject->model->setUseVisualizer(false);
+    subject->state = subject->model->initSystem();
+    const Model& model = *subject->model;
+    OPENSIM_THROW_IF(getComponentSignature(model) != _componentSignature,
+        Exception, "The model of subject '" + name + "' does not have the "
+        "same components as the generic model '" + _generic->getName() +
+        "'.");
+
+    for (int i = 0; i < getNumMuscles(); ++i) {
+        const Muscle& muscle = model.getComponent<Muscle>(_muscleNames[i]);
+        MuscleParameters& params = _muscleParameters[i];
+        params.maxIsometricForce.push_back(muscle.getMaxIsometricForce());
+        params.optimalFiberLength.push_back(muscle.getOptimalFiberLength());
+        params.tendonSlackLength.push_back(muscle.getTendonSlackLength());
+        params.pennationAngleAtOptimalFiberLength.push_back(
+            muscle.getPennationAngleAtOptimalFiberLength());
+        params.maxContractionVelocity.push_back(
+            muscle.getMaxContractionVelocity());
+
+        if (!_rigidTendon[i]) continue;
+        const auto& millard =
+            static_cast<const Millard2012EquilibriumMuscle&>(muscle);
+        const MuscleFixedWidthPennationModel& penMdl =
+            millard.getPennationModel();
+        RigidTendonParameters& rigid = *_rigidTendon[i];
+        rigid.maxIsometricForce.push_back(millard.getMaxIsometricForce());
+        rigid.optimalFiberLength.push_back(millard.getOptimalFiberLength());
+        rigid.tendonSlackLength.push_back(millard.getTendonSlackLength());
+        rigid.maxFiberVelocity.push_back(millard.getOptimalFiberLength()
+                                         * millard.getMaxContractionVelocity());
+        rigid.minimumFiberLength.push_back(millard.getMinimumFiberLength());
+        rigid.parallelogramHeight.push_back(penMdl.getParallelogramHeight());
+        rigid.pennationMinimumFiberLength.push_back(
+            penMdl.getMinimumFiberLength());
+        rigid.pennationMinimumFiberLengthAlongTendon.push_back(
+            penMdl.getMinimumFiberLengthAlongTendon());
+        rigid.maximumSinPennation.push_back(
+            sin(penMdl.get_maximum_pennation_angle()));
+        rigid.maximumPennationAngle.push_back(
+            penMdl.get_maximum_pennation_angle());
+        rigid.minimumActivation.push_back(millard.getMinimumActivation());
+        rigid.fiberDamping.push_back(millard.getFiberDamping());
+        rigid.isPennated.push_back(
+            penMdl.get_pennation_angle_at_optimal() > SimTK::Eps);
+    }
+    for (int i = 0; i < int(_bodyNames.size()); ++i)
+        _bodyMasses[i].push_back(
+            model.getComponent<Body>(_bodyNames[i]).getMass());
+
+    _subjects.push_back(std::move(subject));
+    return getNumSubjects() - 1;
+}
+
+int ModelPopulation::addScaledSubject(const string& name,
+        const ScaleSet& scaleSet, bool preserveMassDist, double finalMass)
+{
+    Model scaled(*_generic);
+    SimTK::State& s = scaled.initSystem();
+    OPENSIM_THROW_IF(!scaled.scale(s, scaleSet, preserveMassDist, finalMass),
+        Exception, "Could not scale the model of subject '" + name + "'.");
+    return addSubject(name, scaled);
+}
+
+const string& ModelPopulation::getSubjectName(int subject) const
+{
+    return _subjects.at(subject)->name;
+}
+
+const Model& ModelPopulation::getSubjectModel(int subject) const
+{
+    return *_subjects.at(subject)->model;
+}
+
+const ModelPopulation::MuscleParameters&
+ModelPopulation::getMuscleParameters(int muscle) const
+{
+    return _muscleParameters.at(muscle);
+}
+
+const vector<double>& ModelPopulation::getBodyMasses(int body) const
+{
+    return _bodyMasses.at(body);
+}
+
+ModelPopulation::PathKinematics ModelPopulation::computePathKinematics(
+        const TimeSeriesTable& coordinates, int numThreads) const
+{
+    const int numSubjects = getNumSubjects();
+    const int numMuscles = getNumMuscles();
+    const int numFrames = int(coordinates.getNumRows());
+
+    // Rotational coordinates and speeds are needed in radians.
+    const TimeSeriesTable* table = &coordinates;
+    TimeSeriesTable radians;
+    if (coordinates.hasTableMetaDataKey("inDegrees") &&
+            coordinates.getTableMetaData<string>("inDegrees") == "yes") {
+        radians = coordinates;
+        _generic->getSimbodyEngine().convertDegreesToRadians(radians);
+        table = &radians;
+    }
+
+    // Resolve the columns by path, so they can be found in each subject.
+    vector<int> valueColumns, speedColumns;
+    vector<string> valuePaths, speedPaths;
+    const auto& labels = table->getColumnLabels();
+    for (int i = 0; i < int(labels.size()); ++i) {
+        bool isSpeed;
+        const string path = findCoordinatePath(*_generic, labels[i], isSpeed);
+        if (path.empty()) continue;
+        (isSpeed ? speedColumns : valueColumns).push_back(i);
+        (isSpeed ? speedPaths : valuePaths).push_back(path);
+    }
+
+    PathKinematics result;
+    result.lengths.assign(numMuscles, SimTK::Matrix(numSubjects, numFrames));
+    result.lengtheningSpeeds = result.lengths;
+
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    const int numBlocks = std::max(1, std::min(numThreads, numSubjects));
+    // The message of the error encountered by each block, if any.
+    vector<string> errors(numBlocks);
+
+    auto evaluateBlock = [&](int block) {
+        const int begin = numSubjects*block/numBlocks;
+        const int end = numSubjects*(block+1)/numBlocks;
+        try {
+            // Each subject has its own model and State.
+            vector<vector<const Coordinate*>> values(end - begin);
+            vector<vector<const Coordinate*>> speeds(end - begin);
+            vector<vector<const GeometryPath*>> paths(end - begin);
+            for (int j = begin; j < end; ++j) {
+                const Model& m = *_subjects[j]->model;
+                for (const auto& path : valuePaths)
+                    values[j-begin].push_back(&m.getComponent<Coordinate>(path));
+                for (const auto& path : speedPaths)
+                    speeds[j-begin].push_back(&m.getComponent<Coordinate>(path));
+                for (const auto& name : _muscleNames)
+                    paths[j-begin].push_back(
+                        &m.getComponent<Muscle>(name).getGeometryPath());
+            }
+
+            for (int f = 0; f < numFrames; ++f) {
+                const auto row = table->getRowAtIndex(f);
+                for (int j = begin; j < end; ++j) {
+                    SimTK::State& s = _subjects[j]->state;
+                    s.setTime(table->getIndependentColumn()[f]);
+                    for (int k = 0; k < int(valueColumns.size()); ++k)
+                        values[j-begin][k]->setValue(s, row[valueColumns[k]],
+                                                     false);
+                    for (int k = 0; k < int(speedColumns.size()); ++k)
+                        speeds[j-begin][k]->setSpeedValue(s,
+                                                          row[speedColumns[k]]);
+                    _subjects[j]->model->realizeVelocity(s);
+                    for (int i = 0; i < numMuscles; ++i) {
+                        result.lengths[i](j, f) =
+                            paths[j-begin][i]->getLength(s);
+                        result.lengtheningSpeeds[i](j, f) =
+                            paths[j-begin][i]->getLengtheningSpeed(s);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            errors[block] = e.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int block = 1; block < numBlocks; ++block) {
+        try {
+            threads.emplace_back(evaluateBlock, block);
+        } catch (const std::system_error&) {
+            // Could not start a thread; evaluate this block here instead.
+            evaluateBlock(block);
+        }
+    }
+    evaluateBlock(0);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& errorMsg : errors) {
+        if (!errorMsg.empty())
+            throw Exception("ModelPopulation::computePathKinematics() " +
+                            errorMsg, __FILE__, __LINE__);
+    }
+    return result;
+}
+
+SimTK::Matrix ModelPopulation::calcRigidTendonForces(int muscle,
+        const SimTK::Matrix& lengths, const SimTK::Matrix& lengtheningSpeeds,
+        const SimTK::Matrix& activations) const
+{
+    OPENSIM_THROW_IF(!_rigidTendon.at(muscle), Exception,
+        "Muscle '" + _muscleNames[muscle] + "' is not a "
+        "Millard2012EquilibriumMuscle.");
+    const int numSubjects = getNumSubjects();
+    const int numFrames = lengths.ncol();
+    OPENSIM_THROW_IF(lengths.nrow() != numSubjects ||
+            lengtheningSpeeds.nrow() != numSubjects ||
+            activations.nrow() != numSubjects ||
+            lengtheningSpeeds.ncol() != numFrames ||
+            activations.ncol() != numFrames, Exception,
+        "Expected matrices with one row per subject (" +
+        to_string(numSubjects) + ") and the same number of columns.");
+
+    const auto& generic = _generic->getComponent<Millard2012EquilibriumMuscle>(
+            _muscleNames[muscle]);
+    const auto& falCurve = generic.get_ActiveForceLengthCurve();
+    const auto& fpeCurve = generic.get_FiberForceLengthCurve();
+    const auto& fvCurve = generic.get_ForceVelocityCurve();
+    const RigidTendonParameters& p = *_rigidTendon[muscle];
+
+    // The computations of Millard2012EquilibriumMuscle with a rigid tendon
+    // (see Millard2012EquilibriumMuscleBatch), for each subject.
+    SimTK::Matrix forces(numSubjects, numFrames);
+    for (int f = 0; f < numFrames; ++f) {
+        for (int j = 0; j < numSubjects; ++j) {
+            const double length = lengths(j, f);
+            const double a = SimTK::clamp(p.minimumActivation[j],
+                                          activations(j, f), 1.0);
+
+            const double lceAT = length - p.tendonSlackLength[j];
+            const double h = p.parallelogramHeight[j];
+            double lce = (lceAT >= p.pennationMinimumFiberLengthAlongTendon[j])
+                         ? sqrt(h*h + lceAT*lceAT)
+                         : p.pennationMinimumFiberLength[j];
+            lce = std::max(lce, p.minimumFiberLength[j]);
+            double phi = 0;
+            if (p.isPennated[j]) {
+                if (lce > p.pennationMinimumFiberLength[j]) {
+                    const double sinPhi = h/lce;
+                    phi = (sinPhi < p.maximumSinPennation[j])
+                          ? asin(sinPhi) : p.maximumPennationAngle[j];
+                } else {
+                    phi = p.maximumPennationAngle[j];
+                }
+            }
+            const double cosPhi = cos(phi);
+            const double tendonLength = length - lce*cosPhi;
+
+            // The fiber cannot shorten while the tendon is buckling.
+            double dlceN = 0;
+            double fv = 1.0;
+            if (tendonLength >= p.tendonSlackLength[j]
+                                - SimTK::SignificantReal) {
+                dlceN = lengtheningSpeeds(j, f)*cosPhi/p.maxFiberVelocity[j];
+                fv = fvCurve.calcValue(dlceN);
+            }
+
+            // A fiber clamped at its minimum length generates no force.
+            const double minLce = p.minimumFiberLength[j];
+            if ((lce <= minLce && dlceN <= 0) || lce < minLce) {
+                forces(j, f) = 0;
+                continue;
+            }
+            const double lceN = lce/p.optimalFiberLength[j];
+            const double fiso = p.maxIsometricForce[j];
+            double fm = fiso*(a*falCurve.calcValue(lceN)*fv
+                              + fpeCurve.calcValue(lceN)
+                              + p.fiberDamping[j]*dlceN);
+            // The rigid-tendon fiber may only generate tensile forces.
+            if (fm < 0) fm = 0;
+            forces(j, f) = fm*cosPhi;
+        }
+    }
+    return forces;
+}
+
+} // end of namespace OpenSim
@@ -0,0 +1,164 @@
+#ifndef OPENSIM_MODEL_POPULATION_H_
+#define OPENSIM_MODEL_POPULATION_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ModelPopulation.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+class ScaleSet;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Many subject-specific versions of one generic model (e.g., as scaled by
+ * the ScaleTool or BatchScaleTool), which share its topology and differ only
+ * in their parameters. The parameters that differ between subjects (body
+ * masses and muscle parameters) are stored in structure-of-arrays form, one
+ * array over the subjects per parameter, and the path lengths and muscle
+ * forces of all subjects are computed together, with the subjects as the
+ * innermost (contiguous) dimension of their results.
+ *
+ * @code
+ * ModelPopulation population(Model("generic.osim"));
+ * for (const auto& file : {"s01_scaled.osim", "s02_scaled.osim"})
+ *     population.addSubject(file, Model(file));
+ * const auto kinematics = population.computePathKinematics(ikResults);
+ * const SimTK::Matrix forces = population.calcRigidTendonForces(0,
+ *     kinematics.lengths[0], kinematics.lengtheningSpeeds[0], activations);
+ * @endcode
+ */
+class OSIMTOOLS_API ModelPopulation
+{
+public:
+    /** The parameters of one muscle, with one element per subject. */
+    struct MuscleParameters {
+        std::vector<double> maxIsometricForce;
+        std::vector<double> optimalFiberLength;
+        std::vector<double> tendonSlackLength;
+        std::vector<double> pennationAngleAtOptimalFiberLength;
+        std::vector<double> maxContractionVelocity;
+    };
+
+    /** The lengths and lengthening speeds of the muscles' paths over a
+    trajectory: one matrix per muscle, with one row per subject and one
+    column per frame. */
+    struct PathKinematics {
+        std::vector<SimTK::Matrix> lengths;
+        std::vector<SimTK::Matrix> lengtheningSpeeds;
+    };
+
+    /** The generic model is copied; it defines the topology of the
+    population. */
+    explicit ModelPopulation(const Model& genericModel);
+    ~ModelPopulation();
+
+    ModelPopulation(const ModelPopulation&) = delete;
+    void operator=(const ModelPopulation&) = delete;
+
+    /** Add a subject, whose model (copied) must have the same components,
+    with the same paths and types, as the generic model.
+    @returns the index of the subject.
+    @throws Exception if the topology of the model differs. */
+    int addSubject(const std::string& name, const Model& subjectModel);
+
+    /** Add a subject whose model is the generic model scaled by scaleSet
+    (e.g., the ScaleSet computed by the ModelScaler), as by Model::scale().
+    @returns the index of the subject. */
+    int addScaledSubject(const std::string& name, const ScaleSet& scaleSet,
+                         bool preserveMassDist = true,
+                         double finalMass = -1.0);
+
+    int getNumSubjects() const { return int(_subjects.size()); }
+    const std::string& getSubjectName(int subject) const;
+    const Model& getSubjectModel(int subject) const;
+
+    int getNumMuscles() const { return int(_muscleNames.size()); }
+    const std::vector<std::string>& getMuscleNames() const
+    {   return _muscleNames; }
+    /** The parameters of a muscle (in the order of getMuscleNames()). */
+    const MuscleParameters& getMuscleParameters(int muscle) const;
+
+    const std::vector<std::string>& getBodyNames() const
+    {   return _bodyNames; }
+    /** The mass of a body (in the order of getBodyNames()) in each
+    subject. */
+    const std::vector<double>& getBodyMasses(int body) const;
+
+    /** Compute the lengths and lengthening speeds of the muscles' paths of
+    all subjects over a kinematic trajectory (e.g., from the
+    InverseKinematicsTool). At each frame, the coordinates of every subject
+    are set from the same row, so the subjects are evaluated in lockstep;
+    blocks of subjects are evaluated concurrently.
+
+    The columns of `coordinates` are named either after a Coordinate, or by
+    a Coordinate's path followed by "/value" or "/speed" (as in states
+    tables). Coordinates without a column keep their default values; speeds
+    without a column are zero. If the table's "inDegrees" metadata is "yes",
+    rotational coordinates and speeds are converted to radians.
+    @param numThreads number of threads; if not positive, the number of
+                      hardware threads is used */
+    PathKinematics computePathKinematics(const TimeSeriesTable& coordinates,
+                                         int numThreads = -1) const;
+
+    /** Compute the tendon force of a Millard2012EquilibriumMuscle of every
+    subject, as the muscle computes it with a rigid tendon
+    (ignore_tendon_compliance), from path lengths, lengthening speeds and
+    activations with one row per subject and one column per frame (e.g.,
+    those from computePathKinematics()). The normalized force curves of the
+    generic muscle are used for all subjects. The loop over the subjects
+    uses the arrays of the muscle's parameters.
+    @returns the tendon forces, with one row per subject and one column per
+             frame.
+    @throws Exception if the muscle is not a Millard2012EquilibriumMuscle or
+            the sizes of the matrices differ. */
+    SimTK::Matrix calcRigidTendonForces(int muscle,
+            const SimTK::Matrix& lengths,
+            const SimTK::Matrix& lengtheningSpeeds,
+            const SimTK::Matrix& activations) const;
+
+private:
+    struct Subject;
+    // Parameters of a Millard2012EquilibriumMuscle needed to compute its
+    // rigid-tendon force, with one element per subject.
+    struct RigidTendonParameters;
+
+    std::unique_ptr<Model> _generic;
+    std::vector<std::string> _componentSignature;
+    std::vector<std::unique_ptr<Subject>> _subjects;
+    std::vector<std::string> _muscleNames;
+    std::vector<std::string> _bodyNames;
+    std::vector<MuscleParameters> _muscleParameters;
+    std::vector<std::vector<double>> _bodyMasses;
+    std::vector<std::unique_ptr<RigidTendonParameters>> _rigidTendon;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_MODEL_POPULATION_H_
@@ -312,26 +312,20 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
 
         if(_printResultFiles) {
-            std::string savedCwd = IO::getCwd();
-            IO::chDir(aPathToSubject);
-            try { // writing can throw an exception
-                if (_outputModelFileNameProp.isValidFileName()) {
-                    if (aModel->print(_outputModelFileName))
-                        cout << "Wrote model file " << _outputModelFileName <<
-                        " from model " << aModel->getName() << endl;
-                }
+            // The files are written relative to the subject's directory
+            // without changing the working directory, which is shared by
+            // subjects scaled concurrently (see BatchScaleTool).
+            if (_outputModelFileNameProp.isValidFileName()) {
+                if (aModel->print(aPathToSubject + _outputModelFileName))
+                    cout << "Wrote model file " << _outputModelFileName <<
+                    " from model " << aModel->getName() << endl;
+            }
 
-                if (_outputScaleFileNameProp.isValidFileName()) {
-                    if (theScaleSet.print(_outputScaleFileName))
-                        cout << "Wrote scale file " << _outputScaleFileName <<
-                        " for model " << aModel->getName() << endl;
-                }
-            } // catch the exception so we can reset the working directory
-            catch (std::exception& ex) {
-                IO::chDir(savedCwd);
-                OPENSIM_THROW_FRMOBJ(Exception, ex.what());
+            if (_outputScaleFileNameProp.isValidFileName()) {
+                if (theScaleSet.print(aPathToSubject + _outputScaleFileName))
+                    cout << "Wrote scale file " << _outputScaleFileName <<
+                    " for model " << aModel->getName() << endl;
             }
-            IO::chDir(savedCwd);
         }
     }
     catch (const Exception& x) {
@@ -36,6 +36,9 @@
 #include <OpenSim/Analyses/Actuation.h>
 #include <OpenSim/Common/DebugUtilities.h>
 
+#include <memory>
+#include <thread>
+
 
 using namespace std;
 using namespace SimTK;
@@ -70,6 +73,9 @@ RRATool::RRATool() :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numCOMAdjustmentIterations(_numCOMAdjustmentIterationsProp.getValueInt()),
+    _comAdjustmentTolerance(_comAdjustmentToleranceProp.getValueDbl()),
+    _numCOMAdjustmentCandidates(_numCOMAdjustmentCandidatesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -95,6 +101,9 @@ RRATool::RRATool(const string &aFileName, bool aLoadModel) :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numCOMAdjustmentIterations(_numCOMAdjustmentIterationsProp.getValueInt()),
+    _comAdjustmentTolerance(_comAdjustmentToleranceProp.getValueDbl()),
+    _numCOMAdjustmentCandidates(_numCOMAdjustmentCandidatesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -160,6 +169,9 @@ RRATool(const RRATool &aTool) :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numCOMAdjustmentIterations(_numCOMAdjustmentIterationsProp.getValueInt()),
+    _comAdjustmentTolerance(_comAdjustmentToleranceProp.getValueDbl()),
+    _numCOMAdjustmentCandidates(_numCOMAdjustmentCandidatesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -190,6 +202,9 @@ setNull()
     _adjustCOMToReduceResiduals = false;
     _initialTimeForCOMAdjustment = -1;
     _finalTimeForCOMAdjustment = -1;
+    _numCOMAdjustmentIterations = 1;
+    _comAdjustmentTolerance = 0.01;
+    _numCOMAdjustmentCandidates = 1;
     _outputModelFile = "";
     _adjustKinematicsToReduceResiduals=true;
     _verbose = false;
@@ -279,6 +294,29 @@ void RRATool::setupProperties()
     _adjustedCOMBodyProp.setName("adjusted_com_body");
     _propertySet.append( &_adjustedCOMBodyProp );
 
+    comment = "Maximum number of times the center of mass is adjusted, each time "
+                 "from the average residuals after the last adjustment. The adjustments "
+                 "stop early once they no longer reduce the average residual moments "
+                 "(MX and MZ) by more than com_adjustment_tolerance. The default is 1.";
+    _numCOMAdjustmentIterationsProp.setComment(comment);
+    _numCOMAdjustmentIterationsProp.setName("com_adjustment_iterations");
+    _propertySet.append( &_numCOMAdjustmentIterationsProp );
+
+    comment = "Relative reduction in the average residual moments (MX and MZ) below "
+                 "which the center of mass adjustments stop. The default is 0.01.";
+    _comAdjustmentToleranceProp.setComment(comment);
+    _comAdjustmentToleranceProp.setName("com_adjustment_tolerance");
+    _propertySet.append( &_comAdjustmentToleranceProp );
+
+    comment = "Number of candidate center of mass adjustments, between 0.5 and 1.5 "
+                 "times the adjustment computed from the average residuals, that are "
+                 "evaluated concurrently (each on a copy of the model) at each adjustment. "
+                 "The candidate with the smallest average residual moments is kept. "
+                 "The default is 1, i.e., only the computed adjustment.";
+    _numCOMAdjustmentCandidatesProp.setComment(comment);
+    _numCOMAdjustmentCandidatesProp.setName("com_adjustment_candidates");
+    _propertySet.append( &_numCOMAdjustmentCandidatesProp );
+
     comment = "Name of the output model file (.osim) containing adjustments to anthropometry "
                  "made to reduce average residuals. This file is written if the property "
                  "adjust_com_to_reduce_residuals is set to true. If a name is not specified, "
@@ -325,6 +363,9 @@ operator=(const RRATool &aTool)
     _adjustCOMToReduceResiduals = aTool._adjustCOMToReduceResiduals;
     _initialTimeForCOMAdjustment = aTool._initialTimeForCOMAdjustment;
     _finalTimeForCOMAdjustment = aTool._finalTimeForCOMAdjustment;
+    _numCOMAdjustmentIterations = aTool._numCOMAdjustmentIterations;
+    _comAdjustmentTolerance = aTool._comAdjustmentTolerance;
+    _numCOMAdjustmentCandidates = aTool._numCOMAdjustmentCandidates;
     _verbose = aTool._verbose;
 
     return(*this);
@@ -1021,24 +1062,161 @@ adjustCOMToReduceResiduals(SimTK::State& s, const Storage &qStore, const Storage
     SimTK::Vector  restoreStates(s.getNY());
     restoreStates = s.getY();
 
-    string massMsg = adjustCOMToReduceResiduals(FAve,MAve);
-    SimTK::State &si = _model->initSystem();
+    // The candidate adjustments are scalings of the adjustment computed from
+    // the residuals.
+    const int numCandidates = std::max(1, _numCOMAdjustmentCandidates);
+    std::vector<double> scales(1, 1.0);
+    if(numCandidates > 1) {
+        scales.resize(numCandidates);
+        for(int c=0;c<numCandidates;c++)
+            scales[c] = 0.5 + double(c)/(numCandidates-1);
+    }
+
+    string massMsg;
+    Body &body = _model->updBodySet().get(_adjustedCOMBody);
+    double moment = sqrt(MAve[0]*MAve[0] + MAve[2]*MAve[2]);
+    const int numIterations = std::max(1, _numCOMAdjustmentIterations);
+    for(int iter=0;iter<numIterations;iter++) {
+        const Vec3 com = body.get_mass_center();
+        const Array<double> FAveBefore = FAve, MAveBefore = MAve;
+        string msg = adjustCOMToReduceResiduals(FAve,MAve);
+        if(iter==0) massMsg = msg;
+        const Vec3 offset = body.get_mass_center() - com;
+
+        const int best = evaluateCOMAdjustments(restoreStates, com, offset,
+                scales, ti, tf, *statesStore, FAve, MAve);
+        const double newMoment = sqrt(MAve[0]*MAve[0] + MAve[2]*MAve[2]);
+
+        // An adjustment that does not reduce the residual moments is undone,
+        // and ends the adjustments.
+        if(iter>0 && newMoment>=moment) {
+            cout<<"\nCOM adjustment "<<iter+1<<" did not reduce the average "
+                <<"residual moments; keeping the previous COM.\n";
+            body.set_mass_center(com);
+            FAve = FAveBefore;
+            MAve = MAveBefore;
+            break;
+        }
+
+        resMsg <<  "* Average residuals after adjusting "<<_adjustedCOMBody<<" COM";
+        if(numIterations>1) resMsg << " (adjustment "<<iter+1<<")";
+        resMsg <<  ":"<<endl;
+        if(numCandidates>1) {
+            resMsg <<  "*  Kept candidate "<<scales[best]<<" x adjustment, COM = "
+                   << body.get_mass_center() <<endl;
+        }
+        resMsg <<  "*  FX="<<FAve[0]<<" FY="<<FAve[1]<<" FZ="<<FAve[2]<<endl;
+        resMsg <<  "*  MX="<<MAve[0]<<" MY="<<MAve[1]<<" MZ="<<MAve[2]<<endl;
+        resMsg <<  "************************************************************\n" << endl;
+
+        const bool converged =
+                moment-newMoment <= _comAdjustmentTolerance*moment;
+        moment = newMoment;
+        if(converged) break;
+    }
 
+    SimTK::State &si = _model->initSystem();
     si.updY() = restoreStates;
     _model->getMultibodySystem().realize(si, Stage::Position );
-    
-    computeAverageResiduals(si, *_model, ti, tf, *statesStore, FAve, MAve);
-
-    resMsg <<  "* Average residuals after adjusting "<<_adjustedCOMBody<<" COM:"<<endl;
-    resMsg <<  "*  FX="<<FAve[0]<<" FY="<<FAve[1]<<" FZ="<<FAve[2]<<endl;
-    resMsg <<  "*  MX="<<MAve[0]<<" MY="<<MAve[1]<<" MZ="<<MAve[2]<<endl;
-    resMsg <<  "************************************************************\n" << endl;
 
     delete statesStore;
 
     return massMsg+resMsg.str();
 }
 
+//_____________________________________________________________________________
+/**
+ * Evaluate candidate adjustments of the center of mass of the adjusted body,
+ * each on its own copy of the model (concurrently, if there is more than
+ * one), and keep the candidate with the smallest average residual moments
+ * (MX and MZ).
+ *
+ * @param aY The states at which the inverse dynamics analysis begins.
+ * @param aCOM The center of mass before the adjustment.
+ * @param aOffset The adjustment computed from the average residuals.
+ * @param aScales The scalings of the adjustment that are the candidates.
+ * @param rFAve The average residual forces of the kept candidate.
+ * @param rMAve The average residual moments of the kept candidate.
+ * @return The index of the kept candidate.
+ */
+int RRATool::
+evaluateCOMAdjustments(const SimTK::Vector &aY, const SimTK::Vec3 &aCOM,
+        const SimTK::Vec3 &aOffset, const std::vector<double> &aScales,
+        double aTi, double aTf, const Storage &aStatesStore,
+        OpenSim::Array<double> &rFAve, OpenSim::Array<double> &rMAve)
+{
+    Body &body = _model->updBodySet().get(_adjustedCOMBody);
+    const int numCandidates = int(aScales.size());
+    if(numCandidates == 1) {
+        body.set_mass_center(aCOM + aScales[0]*aOffset);
+        SimTK::State &si = _model->initSystem();
+        si.updY() = aY;
+        _model->getMultibodySystem().realize(si, Stage::Position );
+        computeAverageResiduals(si, *_model, aTi, aTf, aStatesStore, rFAve, rMAve);
+        return 0;
+    }
+
+    // Each candidate is evaluated on its own copy of the model. The copies
+    // are initialized here, rather than on the threads, so that building the
+    // Systems does not need to be thread-safe.
+    std::vector<std::unique_ptr<Model>> models(numCandidates);
+    std::vector<SimTK::State> states(numCandidates);
+    for(int c=0;c<numCandidates;c++) {
+        models[c].reset(_model->clone());
+        models[c]->setUseVisualizer(false);
+        models[c]->updBodySet().get(_adjustedCOMBody).set_mass_center(
+                aCOM + aScales[c]*aOffset);
+        states[c] = models[c]->initSystem();
+        states[c].updY() = aY;
+        models[c]->getMultibodySystem().realize(states[c], Stage::Position );
+    }
+
+    std::vector<Array<double>> FAve(numCandidates, Array<double>(0.0,3));
+    std::vector<Array<double>> MAve(numCandidates, Array<double>(0.0,3));
+    // The message of the error encountered by each candidate, if any.
+    std::vector<string> errors(numCandidates);
+    auto evaluate = [&](int c) {
+        try {
+            computeAverageResiduals(states[c], *models[c], aTi, aTf,
+                                    aStatesStore, FAve[c], MAve[c]);
+        }
+        catch (const std::exception& e) {
+            errors[c] = e.what();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int c=1;c<numCandidates;c++) {
+        try {
+            threads.emplace_back(evaluate, c);
+        } catch (const std::system_error&) {
+            // Could not start a thread; evaluate this candidate here instead.
+            evaluate(c);
+        }
+    }
+    evaluate(0);
+    for(auto& thread : threads) thread.join();
+
+    for(const auto& errorMsg : errors) {
+        if(!errorMsg.empty())
+            throw Exception("RRATool: ERROR- "+errorMsg,__FILE__,__LINE__);
+    }
+
+    int best = 0;
+    double bestMoment = SimTK::Infinity;
+    for(int c=0;c<numCandidates;c++) {
+        const double moment =
+                sqrt(MAve[c][0]*MAve[c][0] + MAve[c][2]*MAve[c][2]);
+        if(moment < bestMoment) {
+            best = c;
+            bestMoment = moment;
+        }
+    }
+    body.set_mass_center(aCOM + aScales[best]*aOffset);
+    rFAve = FAve[best];
+    rMAve = MAve[best];
+    return best;
+}
+
 // Uses an inverse dynamics analysis to compute average residuals
 void RRATool::
 computeAverageResiduals(SimTK::State& s, Model &aModel,double aTi,double aTf,const Storage &aStatesStore,OpenSim::Array<double>& rFAve,OpenSim::Array<double>& rMAve)
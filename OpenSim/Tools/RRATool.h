@@ -33,6 +33,8 @@
 #include <OpenSim/Simulation/Model/AbstractTool.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
 
+#include <vector>
+
 
 #ifdef SWIG
     #ifdef OSIMTOOLS_API
@@ -106,6 +108,18 @@ private:
     /** Name of the body whose center of mass is adjusted. */
     PropertyStr _adjustedCOMBodyProp;
     std::string &_adjustedCOMBody;
+    /** Maximum number of times the center of mass is adjusted, each time
+    from the average residuals after the last adjustment. */
+    PropertyInt _numCOMAdjustmentIterationsProp;
+    int &_numCOMAdjustmentIterations;
+    /** Relative reduction in the average residual moments below which the
+    center of mass adjustments stop. */
+    PropertyDbl _comAdjustmentToleranceProp;
+    double &_comAdjustmentTolerance;
+    /** Number of candidate center of mass adjustments evaluated
+    concurrently at each adjustment. */
+    PropertyInt _numCOMAdjustmentCandidatesProp;
+    int &_numCOMAdjustmentCandidates;
     /** Name of the output model file containing adjustments to anthropometry
     made to reduce average residuals. This file is written if the property
     adjust_com_to_reduce_residuals is set to true. */
@@ -170,6 +184,15 @@ public:
     const std::string &getAdjustedCOMBody() { return _adjustedCOMBody; }
     void setAdjustedCOMBody(const std::string &aBody) { _adjustedCOMBody = aBody; }
 
+    int getNumCOMAdjustmentIterations() const { return _numCOMAdjustmentIterations; }
+    void setNumCOMAdjustmentIterations(int aNumIterations) { _numCOMAdjustmentIterations = aNumIterations; }
+
+    double getCOMAdjustmentTolerance() const { return _comAdjustmentTolerance; }
+    void setCOMAdjustmentTolerance(double aTolerance) { _comAdjustmentTolerance = aTolerance; }
+
+    int getNumCOMAdjustmentCandidates() const { return _numCOMAdjustmentCandidates; }
+    void setNumCOMAdjustmentCandidates(int aNumCandidates) { _numCOMAdjustmentCandidates = aNumCandidates; }
+
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
 
@@ -195,6 +218,10 @@ public:
     void initializeControlSetUsingConstraints(const ControlSet *aRRAControlSet,const ControlSet *aControlConstraints, ControlSet& rControlSet );
     std::string adjustCOMToReduceResiduals(SimTK::State& s, const Storage &qStore, const Storage &uStore);
     std::string adjustCOMToReduceResiduals(const OpenSim::Array<double> &aFAve,const OpenSim::Array<double> &aMAve);
+    int evaluateCOMAdjustments(const SimTK::Vector &aY, const SimTK::Vec3 &aCOM,
+        const SimTK::Vec3 &aOffset, const std::vector<double> &aScales,
+        double aTi, double aTf, const Storage &aStatesStore,
+        OpenSim::Array<double> &rFAve, OpenSim::Array<double> &rMAve);
     void addNecessaryAnalyses();
     void writeAdjustedModel();
 
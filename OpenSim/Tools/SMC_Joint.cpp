@@ -175,15 +175,7 @@ computeDesiredAccelerations( const SimTK::State& state, double aT)
     computeErrors(state, aT);
 
     // Term 1: Experimental Acceleration
-    double a;
-    if(_aTrk[0]==NULL) {
-        std::vector<int> derivComponents(2);
-        derivComponents[0]=0;
-        derivComponents[1]=0;
-        a = (_ka)[0]*_pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
-    } else {
-        a = (_ka)[0]*_aTrk[0]->calcValue(SimTK::Vector(1,aT));
-    }
+    double a = (_ka)[0]*getTaskAcceleration(0,aT);
 
     // Surface Error
     double s = -_vErr[0] -(_kv)[0]*_pErr[0];
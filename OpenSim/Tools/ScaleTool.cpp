@@ -26,6 +26,7 @@
 //=============================================================================
 #include "ScaleTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Tracer.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
 
@@ -245,9 +246,32 @@ Model* ScaleTool::createModel() const
     return 0;
 }
 
+Model* ScaleTool::createModel(const Model& aGenericModel) const
+{
+    cout << "Processing subject " << getName() << endl;
+
+    Model* model =
+        getGenericModelMaker().processModel(aGenericModel, _pathToSubject);
+    if (!model) {
+        cout << "===ERROR===: Unable to copy generic model." << endl;
+        return 0;
+    }
+    model->setName(getName());
+    return model;
+}
+
 bool ScaleTool::run() const {
     std::unique_ptr<Model> model(createModel());
+    return processModel(model.get());
+}
+
+bool ScaleTool::run(const Model& aGenericModel) const {
+    std::unique_ptr<Model> model(createModel(aGenericModel));
+    return processModel(model.get());
+}
 
+bool ScaleTool::processModel(Model* model) const {
+    OPENSIM_TRACE_SPAN("tool", "ScaleTool", getName());
     if(model == nullptr) { 
         throw Exception("scale: ERROR- No model specified.",__FILE__,__LINE__);
     }
@@ -255,7 +279,7 @@ bool ScaleTool::run() const {
     if (!isDefaultModelScaler() && getModelScaler().getApply())
     {
         const ModelScaler& scaler = getModelScaler();
-        if(!scaler.processModel(model.get(), getPathToSubject(), getSubjectMass())) {
+        if(!scaler.processModel(model, getPathToSubject(), getSubjectMass())) {
             return false;
         }
     }
@@ -267,7 +291,7 @@ bool ScaleTool::run() const {
     if (!isDefaultMarkerPlacer())
     {
         const MarkerPlacer& placer = getMarkerPlacer();
-        if(!placer.processModel(model.get(), getPathToSubject())) {
+        if(!placer.processModel(model, getPathToSubject())) {
             return false;
         }
     }
@@ -99,6 +99,9 @@ public:
     void copyData(const ScaleTool &aSubject);
 
     Model* createModel() const;
+    /** Like createModel(), but copy the given generic model rather than
+     * loading the generic model maker's model file. */
+    Model* createModel(const Model& aGenericModel) const;
     /* Query the subject for different parameters */
     const GenericModelMaker& getGenericModelMaker() const
     { return _genericModelMaker; }
@@ -114,6 +117,11 @@ public:
      * executable. 
      * @returns whether or not the scale procedure was successful. */
     bool run() const;
+    /** Run the scale tool on a copy of the given generic model, rather than
+     * on the model loaded from the generic model maker's model file. The
+     * generic model is not modified, so it can be shared by tools run
+     * concurrently (see BatchScaleTool). */
+    bool run(const Model& aGenericModel) const;
 
     bool isDefaultGenericModelMaker() const
     { return _genericModelMakerProp.getValueIsDefault(); }
@@ -157,6 +165,9 @@ protected:
 private:
     void setNull();
     void setupProperties();
+    // Scale the model and place its markers; the model may be null, if it
+    // could not be created.
+    bool processModel(Model* model) const;
 //=============================================================================
 };  // END of class ScaleTool
 //=============================================================================
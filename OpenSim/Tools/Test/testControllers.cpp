@@ -40,9 +40,12 @@
 using namespace OpenSim;
 using namespace std;
 
+void testControlLinearEvaluationOrder();
 void testControlSetControllerOnBlock();
 void testPrescribedControllerOnBlock(bool enabled);
 void testCorrectionControllerOnBlock();
+void testPrescribedControllerGroupedFunctions();
+void testControllerUpdateRate();
 void testPrescribedControllerFromFile(const std::string& modelFile,
                                       const std::string& actuatorsFile,
                                       const std::string& controlsFile);
@@ -50,11 +53,15 @@ void testPrescribedControllerFromFile(const std::string& modelFile,
 int main()
 {
     try {
+        cout << "Testing ControlLinear evaluation order" << endl;
+        testControlLinearEvaluationOrder();
         cout << "Testing ControlSetController" << endl; 
         testControlSetControllerOnBlock();
         cout << "Testing PrescribedController" << endl; 
         testPrescribedControllerOnBlock(true);
         testPrescribedControllerOnBlock(false);
+        testPrescribedControllerGroupedFunctions();
+        testControllerUpdateRate();
         cout << "Testing CorrectionController" << endl; 
         testCorrectionControllerOnBlock();
         cout << "Testing PrescribedController from File" << endl;
@@ -69,6 +76,41 @@ int main()
     return 0;
 }
 
+//==========================================================================================================
+// ControlLinear reuses the interval of its last evaluation; the value at a
+// time must not depend on the times evaluated before it.
+void testControlLinearEvaluationOrder()
+{
+    for (bool useSteps : {false, true}) {
+        ControlLinear control;
+        control.setUseSteps(useSteps);
+        const double times[] = {0.0, 0.1, 0.25, 0.3, 0.5, 0.8, 1.0};
+        for (int i = 0; i < 7; ++i) {
+            control.setControlValue(times[i], i*i - 3.0*i);
+            control.setControlValueMin(times[i], -i);
+        }
+
+        std::vector<double> evalTimes;
+        for (int i = -10; i <= 110; ++i) evalTimes.push_back(0.01*i);
+        for (double t : times) evalTimes.push_back(t);
+        // Forward, backward, then in an arbitrary order.
+        std::vector<double> order(evalTimes);
+        order.insert(order.end(), evalTimes.rbegin(), evalTimes.rend());
+        for (size_t i = 0; i < evalTimes.size(); ++i)
+            order.push_back(evalTimes[(i*37) % evalTimes.size()]);
+
+        for (double t : order) {
+            ControlLinear fresh(control);
+            const double expected = fresh.getControlValue(t);
+            ASSERT_EQUAL(expected, control.getControlValue(t), 1e-15,
+                __FILE__, __LINE__, "ControlLinear value depends on the "
+                "times evaluated before.");
+            ASSERT_EQUAL(fresh.getControlValueMin(t),
+                control.getControlValueMin(t), 1e-15, __FILE__, __LINE__);
+        }
+    }
+}
+
 //==========================================================================================================
 void testControlSetControllerOnBlock()
 {
@@ -260,6 +302,104 @@ void testPrescribedControllerOnBlock(bool enabled)
 }// end of testPrescribedControllerOnBlock()
 
 
+//==========================================================================================================
+// PiecewiseLinearFunctions with the same X values are evaluated together; the
+// controls must be those of evaluating each function on its own.
+void testPrescribedControllerGroupedFunctions()
+{
+    using namespace SimTK;
+
+    Model model;
+    auto* block = new OpenSim::Body("block", 1.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    const std::string coordName = slider->getCoordinate().getName();
+
+    const double sharedX[] = {0.0, 0.2, 0.5, 0.7, 1.0};
+    const double otherX[] = {0.0, 0.3, 0.6, 0.9, 1.2};
+    std::vector<PiecewiseLinearFunction> functions;
+    for (int i = 0; i < 4; ++i) {
+        double y[5];
+        for (int k = 0; k < 5; ++k) y[k] = (i + 1) * std::sin(k + i);
+        functions.push_back(
+            PiecewiseLinearFunction(5, i < 3 ? sharedX : otherX, y));
+    }
+
+    auto* controller = new PrescribedController();
+    for (int i = 0; i < 4; ++i) {
+        auto* actuator = new CoordinateActuator(coordName);
+        actuator->setName("actuator" + std::to_string(i));
+        model.addForce(actuator);
+    }
+    controller->setActuators(model.updActuators());
+    for (int i = 0; i < 4; ++i)
+        controller->prescribeControlForActuator(i, functions[i].clone());
+    model.addController(controller);
+
+    SimTK::State& s = model.initSystem();
+    for (int i = -5; i <= 130; ++i) {
+        // Forward, then in an arbitrary order.
+        const double t = 0.01 * (i < 60 ? i : (i * 37) % 130 - 5);
+        s.setTime(t);
+        model.realizeVelocity(s);
+        const Vector& controls = model.getControls(s);
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_EQUAL(functions[j].calcValue(Vector(1, t)), controls[j],
+                1e-14, __FILE__, __LINE__,
+                "Grouped prescribed controls differ from their functions.");
+        }
+    }
+}
+
+//==========================================================================================================
+// A controller with an update rate holds the controls computed at the last
+// update (sample-and-hold).
+void testControllerUpdateRate()
+{
+    using namespace SimTK;
+
+    Model model;
+    auto* block = new OpenSim::Body("block", 20.0, Vec3(0), Inertia(1.0));
+    auto* slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addBody(block);
+    model.addJoint(slider);
+    auto* actuator = new CoordinateActuator(slider->getCoordinate().getName());
+    actuator->setName("actuator");
+    model.addForce(actuator);
+
+    // The control ramps up with time.
+    auto* controller = new PrescribedController();
+    controller->setActuators(model.updActuators());
+    controller->prescribeControlForActuator(0, new LinearFunction(100., 0.));
+    model.addController(controller);
+    model.updControllerSet().setUpdateRate(10.);
+    ASSERT_EQUAL(10., controller->getUpdateRate(), 0.);
+
+    SimTK::State& s = model.initSystem();
+    SimTK::RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+    integrator.setAccuracy(1e-6);
+    Manager manager(model, integrator);
+    s.setTime(0.);
+    manager.initialize(s);
+    for (double t : {0.15, 0.35, 0.72, 1.01}) {
+        SimTK::State state = manager.integrate(t);
+        model.realizeVelocity(state);
+        // The controls computed at the last multiple of 0.1 s are held.
+        const double lastUpdate = 0.1*std::floor(10.*t);
+        ASSERT_EQUAL(100.*lastUpdate, model.getControls(state)[0], 1e-6,
+            __FILE__, __LINE__,
+            "Controller did not hold the controls of its last update.");
+    }
+
+    // The update rate is serialized, and must not be negative.
+    Model copy(model);
+    ASSERT_EQUAL(10.,
+        copy.getControllerSet().get(0).getUpdateRate(), 0.);
+    copy.updControllerSet().get(0).setUpdateRate(-1.);
+    ASSERT_THROW(OpenSim::Exception, copy.initSystem());
+}
+
 //==========================================================================================================
 void testCorrectionControllerOnBlock()
 {
@@ -29,11 +29,13 @@ using namespace OpenSim;
 using namespace std;
 
 void testExternalLoad();
+void testSharedExternalLoadData();
 
 int main()
 {
     try {
         testExternalLoad();
+        testSharedExternalLoadData();
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -266,3 +268,55 @@ void testExternalLoad()
     // kinematics should match to within integ accuracy
     ASSERT_EQUAL(0.0, norm_err, integ_accuracy);
 }
+
+// ExternalForces that use the same data, or are copies of one another, share
+// the functions fit to the data; they must apply the forces of the data.
+void testSharedExternalLoadData()
+{
+    using namespace SimTK;
+
+    const int nt = 50;
+    Storage forceStore;
+    Array<string> labels;
+    labels.append("time");
+    for (const string& name : {"force", "point", "torque"})
+        for (const string& axis : {"x", "y", "z"})
+            labels.append(name + "." + axis);
+    forceStore.setColumnLabels(labels);
+    Array<double> time(0.0, nt);
+    Array<double> fx(0.0, nt);
+    for (int i = 0; i < nt; ++i) {
+        time[i] = 0.02*i;
+        Vector row(9);
+        for (int j = 0; j < 9; ++j) row[j] = (j + 1)*std::sin(time[i] + j);
+        fx[i] = row[0];
+        forceStore.append(time[i], row);
+    }
+    forceStore.setName("shared_external_loads.sto");
+
+    Model model("Pendulum.osim");
+    const string bodyName = model.getBodySet().get(0).getName();
+    for (const string& name : {"first", "second"}) {
+        ExternalForce* xf = new ExternalForce(forceStore, "force", "point",
+            "torque", bodyName, "ground", bodyName);
+        xf->setName(name);
+        model.addForce(xf);
+    }
+    std::unique_ptr<Model> copy(model.clone());
+    model.initSystem();
+    copy->initSystem();
+
+    GCVSpline expected(3, nt, &time[0], &fx[0]);
+    for (double t = 0; t < 0.98; t += 0.013) {
+        const double fxExpected = expected.calcValue(Vector(1, t));
+        for (const Model* m : {&model, copy.get()}) {
+            for (const string& name : {"first", "second"}) {
+                const auto& xf = dynamic_cast<const ExternalForce&>(
+                        m->getForceSet().get(name));
+                ASSERT_EQUAL(fxExpected, xf.getForceAtTime(t)[0], 1e-14,
+                    __FILE__, __LINE__,
+                    "ExternalForce sharing fit data applied the wrong force.");
+            }
+        }
+    }
+}
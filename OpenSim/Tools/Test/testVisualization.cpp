@@ -39,6 +39,7 @@ void populate_doublePendulumPrimitives(SimTK::Array_<DecorativeGeometry>&);
 void populate_composedTransformPrimitives(SimTK::Array_<DecorativeGeometry>&);
 void populate_contactModelPrimitives(SimTK::Array_<DecorativeGeometry>&);
 void populate_wrapModelPrimitives(SimTK::Array_<DecorativeGeometry>&, bool includeFrames=true);
+void testReusedPathDecorations(Model& model);
 bool testVisModelAgainstStandard(Model& model, const SimTK::Array_<DecorativeGeometry>& stdPrimitives);
 
 // Implementation of DecorativeGeometryImplementation that prints the representation to 
@@ -154,6 +155,7 @@ int main()
         modelWithWrap.updDisplayHints().set_show_frames(false);
         populate_wrapModelPrimitives(standard, false);
         testVisModelAgainstStandard(modelWithWrap, standard);
+        testReusedPathDecorations(modelWithWrap);
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -207,6 +209,44 @@ void testVisModel(Model& model, const std::string standard_filename)
         + standard_filename + "'.");
 }
 
+// The decorations of a path, which are reused from frame to frame, must be
+// those of a State that has never been drawn.
+void testReusedPathDecorations(Model& model)
+{
+    auto describe = [&](const SimTK::State& s, const ModelDisplayHints& mdh) {
+        SimTK::Array_<SimTK::DecorativeGeometry> geometry;
+        model.generateDecorations(false, mdh, s, geometry);
+        DecorativeGeometryImplementationText text;
+        text.setPrintTransforms(true);
+        for (const auto& deco : geometry) deco.implementGeometry(text);
+        return text.getAsString();
+    };
+    auto pose = [&](SimTK::State& s, double offset) {
+        for (const auto& coord : model.getComponentList<Coordinate>())
+            if (!coord.getLocked(s))
+                coord.setValue(s, coord.getDefaultValue() + offset, false);
+        model.realizePosition(s);
+    };
+
+    // The working State is never drawn; drawn is drawn at every pose, with
+    // and without the path points.
+    model.initSystem();
+    SimTK::State drawn = model.getWorkingState();
+    ModelDisplayHints mdh;
+    double offset = 0;
+    for (bool showPathPoints : {true, true, false, true}) {
+        mdh.set_show_path_points(showPathPoints);
+        offset += 0.1;
+        pose(drawn, offset);
+        const std::string reused = describe(drawn, mdh);
+
+        SimTK::State fresh = model.getWorkingState();
+        pose(fresh, offset);
+        ASSERT(reused == describe(fresh, mdh), __FILE__, __LINE__,
+               "Reused path decorations differ from new ones.");
+    }
+}
+
 Model createModel4AppearanceTest()
 {
     Model modelWithGroundOnly;
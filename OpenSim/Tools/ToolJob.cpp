@@ -0,0 +1,385 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  ToolJob.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ToolJob.h"
+#include "AnalyzeTool.h"
+#include "InverseKinematicsTool.h"
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/RunControl.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace OpenSim;
+
+namespace {
+bool isAssigned(const std::string& fileName)
+{
+    return fileName != "" && fileName != "Unassigned";
+}
+
+// Whether the directory is the working directory, named relative to it.
+bool isWorkingDirectory(const std::string& directory)
+{
+    return directory == "" || directory == "./" || directory == ".\\";
+}
+
+// Whether running the tool changes the working directory; see ToolPipeline.
+bool changesWorkingDirectory(const Object& tool,
+                             const std::string& externalLoadsFileName = "")
+{
+    return !isWorkingDirectory(
+                   IO::getParentDirectory(tool.getDocumentFileName())) ||
+           (isAssigned(externalLoadsFileName) &&
+            !isWorkingDirectory(IO::getParentDirectory(externalLoadsFileName)));
+}
+}
+
+struct ToolJob::Shared {
+    std::function<void(RunControl&)> work;
+    // Whether the job must run while no other job runs.
+    bool exclusive = false;
+    RunControl control;
+
+    // Guards the members below.
+    std::mutex mutex;
+    std::condition_variable done;
+    Status status = Queued;
+    std::exception_ptr error;
+    std::string errorMessage;
+};
+
+// The threads that run the jobs, created as jobs are started, up to the
+// number of jobs run at once.
+class ToolJob::Pool {
+public:
+    static Pool& get()
+    {
+        static Pool pool;
+        return pool;
+    }
+
+    ~Pool()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopping = true;
+        for (auto& job : _queue) cancel(*job);
+        for (auto& job : _running) cancel(*job);
+        _changed.notify_all();
+        lock.unlock();
+        for (auto& thread : _threads) thread.join();
+    }
+
+    void submit(std::shared_ptr<Shared> job)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _queue.push_back(std::move(job));
+        if (int(_threads.size()) < _numThreads &&
+                int(_threads.size()) < int(_running.size() + _queue.size())) {
+            try {
+                _threads.emplace_back(&Pool::work, this, false);
+            } catch (const std::system_error&) {
+                // Could not start a thread; the job waits for one of the
+                // others, or, if there are none, runs here.
+                if (_threads.empty()) {
+                    lock.unlock();
+                    work(true);
+                    return;
+                }
+            }
+        }
+        _changed.notify_one();
+    }
+
+    void setNumThreads(int numThreads)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _numThreads = numThreads;
+        _changed.notify_all();
+    }
+    int getNumThreads()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numThreads;
+    }
+
+    // Cancel the job: a queued job is done, and a running one stops at its
+    // next step.
+    static void cancel(Shared& job)
+    {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.status == Queued) {
+            job.status = Cancelled;
+            job.done.notify_all();
+        } else if (job.status == Running) {
+            job.control.cancel();
+        }
+    }
+
+private:
+    Pool() : _numThreads(std::max(1u, std::thread::hardware_concurrency())) {}
+
+    // Run jobs as they may run, until the pool stops or, if untilEmpty, no
+    // job is queued.
+    void work(bool untilEmpty = false)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            // The first queued job that may run now; cancelled jobs are
+            // dropped.
+            std::shared_ptr<Shared> job;
+            for (auto it = _queue.begin(); it != _queue.end();) {
+                bool cancelled;
+                {
+                    std::lock_guard<std::mutex> jobLock((*it)->mutex);
+                    cancelled = (*it)->status != Queued;
+                }
+                if (cancelled) {
+                    it = _queue.erase(it);
+                    continue;
+                }
+                if (int(_running.size()) < _numThreads && !_exclusiveRunning &&
+                        (!(*it)->exclusive || _running.empty())) {
+                    job = *it;
+                    _queue.erase(it);
+                    break;
+                }
+                ++it;
+            }
+            if (!job) {
+                if (_stopping || (untilEmpty && _queue.empty())) return;
+                _changed.wait(lock);
+                continue;
+            }
+            {
+                // The job may have been cancelled since it was found.
+                std::lock_guard<std::mutex> jobLock(job->mutex);
+                if (job->status != Queued) continue;
+                job->status = Running;
+            }
+            _running.push_back(job);
+            if (job->exclusive) _exclusiveRunning = true;
+            lock.unlock();
+
+            Status status = Succeeded;
+            std::exception_ptr error;
+            std::string errorMessage;
+            try {
+                job->work(job->control);
+            } catch (const std::exception& e) {
+                status = job->control.isCancelled() ? Cancelled : Failed;
+                error = std::current_exception();
+                errorMessage = e.what();
+            } catch (...) {
+                status = job->control.isCancelled() ? Cancelled : Failed;
+                error = std::current_exception();
+                errorMessage = "Unknown exception.";
+            }
+
+            lock.lock();
+            _running.erase(std::find(_running.begin(), _running.end(), job));
+            if (job->exclusive) _exclusiveRunning = false;
+            {
+                std::lock_guard<std::mutex> jobLock(job->mutex);
+                job->status = status;
+                if (status == Failed) {
+                    job->error = error;
+                    job->errorMessage = errorMessage;
+                }
+                job->done.notify_all();
+            }
+            _changed.notify_all();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::deque<std::shared_ptr<Shared>> _queue;
+    std::vector<std::shared_ptr<Shared>> _running;
+    std::vector<std::thread> _threads;
+    int _numThreads;
+    bool _exclusiveRunning = false;
+    bool _stopping = false;
+};
+
+ToolJob::ToolJob(std::shared_ptr<Shared> shared) : _shared(std::move(shared))
+{}
+
+ToolJob ToolJob::start(std::function<void(RunControl&)> work, bool exclusive,
+                       ProgressCallback callback)
+{
+    std::shared_ptr<Shared> shared = std::make_shared<Shared>();
+    shared->work = std::move(work);
+    shared->exclusive = exclusive;
+    if (callback) shared->control.setProgressCallback(std::move(callback));
+    Pool::get().submit(shared);
+    return ToolJob(shared);
+}
+
+ToolJob ToolJob::runAsync(InverseKinematicsTool& tool)
+{
+    return runAsync(tool, nullptr);
+}
+
+ToolJob ToolJob::runAsync(AnalyzeTool& tool)
+{
+    return runAsync(tool, nullptr);
+}
+
+ToolJob ToolJob::integrateAsync(Manager& manager, double finalTime)
+{
+    return integrateAsync(manager, finalTime, nullptr);
+}
+
+ToolJob ToolJob::runAsync(InverseKinematicsTool& tool,
+                          ProgressCallback callback)
+{
+    auto work = [&tool](RunControl& control) {
+        tool.setRunControl(&control);
+        bool success = false;
+        try {
+            success = tool.run();
+        } catch (...) {
+            tool.setRunControl(nullptr);
+            throw;
+        }
+        tool.setRunControl(nullptr);
+        OPENSIM_THROW_IF(!success, Exception,
+            "InverseKinematicsTool " + tool.getName() + " failed.");
+    };
+    return start(work, changesWorkingDirectory(tool), std::move(callback));
+}
+
+ToolJob ToolJob::runAsync(AnalyzeTool& tool, ProgressCallback callback)
+{
+    auto work = [&tool](RunControl& control) {
+        tool.setRunControl(&control);
+        bool success = false;
+        try {
+            success = tool.run();
+        } catch (...) {
+            tool.setRunControl(nullptr);
+            throw;
+        }
+        tool.setRunControl(nullptr);
+        OPENSIM_THROW_IF(!success, Exception,
+            "AnalyzeTool " + tool.getName() + " failed.");
+    };
+    return start(work,
+                 changesWorkingDirectory(tool, tool.getExternalLoadsFileName()),
+                 std::move(callback));
+}
+
+ToolJob ToolJob::integrateAsync(Manager& manager, double finalTime,
+                                ProgressCallback callback)
+{
+    auto work = [&manager, finalTime](RunControl& control) {
+        manager.setRunControl(&control);
+        try {
+            manager.integrate(finalTime);
+        } catch (...) {
+            manager.setRunControl(nullptr);
+            throw;
+        }
+        manager.setRunControl(nullptr);
+        // A cancelled integration is halted rather than interrupted.
+        if (manager.getState().getTime() < finalTime)
+            control.checkCancelled();
+    };
+    return start(work, false, std::move(callback));
+}
+
+ToolJob::Status ToolJob::getStatus() const
+{
+    std::lock_guard<std::mutex> lock(_shared->mutex);
+    return _shared->status;
+}
+
+bool ToolJob::isDone() const
+{
+    const Status status = getStatus();
+    return status != Queued && status != Running;
+}
+
+double ToolJob::getProgress() const
+{
+    if (getStatus() == Succeeded) return 1;
+    return _shared->control.getProgress();
+}
+
+void ToolJob::cancel()
+{
+    Pool::cancel(*_shared);
+}
+
+void ToolJob::wait() const
+{
+    std::unique_lock<std::mutex> lock(_shared->mutex);
+    _shared->done.wait(lock, [this]() {
+        return _shared->status != Queued && _shared->status != Running;
+    });
+}
+
+bool ToolJob::waitFor(double seconds) const
+{
+    std::unique_lock<std::mutex> lock(_shared->mutex);
+    return _shared->done.wait_for(lock,
+            std::chrono::duration<double>(std::max(0.0, seconds)), [this]() {
+        return _shared->status != Queued && _shared->status != Running;
+    });
+}
+
+void ToolJob::get() const
+{
+    wait();
+    std::lock_guard<std::mutex> lock(_shared->mutex);
+    if (_shared->error) std::rethrow_exception(_shared->error);
+    OPENSIM_THROW_IF(_shared->status == Cancelled, RunCancelled,
+                     "The job was cancelled.");
+}
+
+std::string ToolJob::getErrorMessage() const
+{
+    std::lock_guard<std::mutex> lock(_shared->mutex);
+    return _shared->errorMessage;
+}
+
+void ToolJob::setNumThreads(int numThreads)
+{
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+                     "Expected at least one thread, but got " +
+                     std::to_string(numThreads) + ".");
+    Pool::get().setNumThreads(numThreads);
+}
+
+int ToolJob::getNumThreads()
+{
+    return Pool::get().getNumThreads();
+}
@@ -0,0 +1,153 @@
+#ifndef OPENSIM_TOOL_JOB_H_
+#define OPENSIM_TOOL_JOB_H_
+/* -------------------------------------------------------------------------- *
+ *                            OpenSim:  ToolJob.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#ifdef SWIG
+    #ifdef OSIMTOOLS_API
+        #undef OSIMTOOLS_API
+        #define OSIMTOOLS_API
+    #endif
+#endif
+
+namespace OpenSim {
+
+class AnalyzeTool;
+class InverseKinematicsTool;
+class Manager;
+class RunControl;
+
+/** A handle to a run of an InverseKinematicsTool or an AnalyzeTool, or to an
+integration of a Manager, in the background, so that an application (e.g., a
+user interface, or a service) does not block while it runs, and can run
+several at once. The jobs are run by an internal pool of threads, shared by
+the whole process, in the order they are started.
+
+@code{.cpp}
+InverseKinematicsTool ik("subject01_Setup_IK.xml");
+ToolJob job = ToolJob::runAsync(ik);
+while (!job.waitFor(0.5))
+    std::cout << int(100*job.getProgress()) << "%" << std::endl;
+job.get(); // Rethrows the tool's exception, if it failed.
+@endcode
+
+From Python, MATLAB or Java, poll getStatus() and getProgress(), or block
+in waitFor(); a progress callback (called on the job's thread) can be given
+in C++ only.
+
+A job can be cancelled at any time; a queued job is then never run, and a
+running tool stops at its next frame and throws RunCancelled (see
+InverseKinematicsTool::setRunControl() and AnalyzeTool::setRunControl()),
+without writing its outputs. A cancelled integration is halted (see
+Manager::halt()) at the end of its current step; the Manager's State is
+then that of the last step.
+
+The tools and Managers are not copied; each must outlive its job, and must
+not be used, or given to another job, until its job is done. A tool whose
+setup file (or external loads file) is in another directory than the
+working directory changes the process's working directory while it runs
+(see ToolPipeline), so its job runs alone, while no other job runs; start
+the jobs from the directory of the setup files to run them concurrently.
+At exit, the jobs that are not done are cancelled and waited for; wait for
+(or cancel) the jobs before their tools and Managers are destroyed. */
+class OSIMTOOLS_API ToolJob {
+public:
+    enum Status {
+        Queued,     ///< Waiting for a thread of the pool.
+        Running,
+        Succeeded,
+        Failed,     ///< The run threw; see get() and getErrorMessage().
+        Cancelled   ///< Cancelled before it was run, or while it ran.
+    };
+
+    /** Run the tool in the background; see InverseKinematicsTool::run(). */
+    static ToolJob runAsync(InverseKinematicsTool& tool);
+    /** Run the tool in the background; see AnalyzeTool::run(). */
+    static ToolJob runAsync(AnalyzeTool& tool);
+    /** Integrate to finalTime in the background; see Manager::integrate().
+    The Manager must have been initialized. Its RunControl (see
+    Manager::setRunControl()) is replaced during the integration. */
+    static ToolJob integrateAsync(Manager& manager, double finalTime);
+
+#ifndef SWIG
+    typedef std::function<void(double)> ProgressCallback;
+    /** As above, calling callback with the progress of the job (between 0
+    and 1) as it changes, on the job's thread; see RunControl. */
+    static ToolJob runAsync(InverseKinematicsTool& tool,
+                            ProgressCallback callback);
+    static ToolJob runAsync(AnalyzeTool& tool, ProgressCallback callback);
+    static ToolJob integrateAsync(Manager& manager, double finalTime,
+                                  ProgressCallback callback);
+#endif
+
+    Status getStatus() const;
+    /** Whether the job has succeeded, failed or been cancelled. */
+    bool isDone() const;
+    /** The fraction of the job done, between 0 and 1: the frames solved or
+    analyzed, or the time integrated. */
+    double getProgress() const;
+    /** Cancel the job, if it is not done. */
+    void cancel();
+
+    /** Wait until the job is done. */
+    void wait() const;
+    /** Wait until the job is done, for at most the given number of seconds,
+    and return whether it is done. */
+    bool waitFor(double seconds) const;
+    /** Wait until the job is done, and rethrow the exception its run threw,
+    if it failed.
+    @throws RunCancelled If the job was cancelled. */
+    void get() const;
+    /** The message of the exception the run threw, if the job failed, or
+    else an empty string. */
+    std::string getErrorMessage() const;
+
+    /** The number of jobs run at once by the pool (default: the number of
+    hardware threads). A tool that divides its frames among threads (see
+    InverseKinematicsTool::setNumThreads()) uses those threads in addition
+    to its job's. Lowering the number does not stop jobs that are running.
+    @throws Exception If numThreads is not positive. */
+    static void setNumThreads(int numThreads);
+    static int getNumThreads();
+
+private:
+    struct Shared;
+    class Pool;
+
+    explicit ToolJob(std::shared_ptr<Shared> shared);
+#ifndef SWIG
+    static ToolJob start(std::function<void(RunControl&)> work, bool exclusive,
+                         ProgressCallback callback);
+#endif
+
+    std::shared_ptr<Shared> _shared;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_TOOL_JOB_H_
@@ -0,0 +1,402 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ToolPipeline.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ToolPipeline.h"
+#include "AnalyzeTool.h"
+#include "InverseDynamicsTool.h"
+#include "InverseKinematicsTool.h"
+#include "ScaleTool.h"
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/ResultCache.h>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/Tracer.h>
+#include <OpenSim/Simulation/Model/Analysis.h>
+#include <OpenSim/Simulation/Model/AnalysisSet.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+bool isAbsolute(const std::string& fileName)
+{
+    return !fileName.empty() && (fileName[0] == '/' || fileName[0] == '\\' ||
+                                 (fileName.size() > 1 && fileName[1] == ':'));
+}
+
+bool isAssigned(const std::string& fileName)
+{
+    return fileName != "" && fileName != "Unassigned";
+}
+
+// The name of a file named relative to directory, relative to the working
+// directory.
+std::string resolve(const std::string& directory, const std::string& fileName)
+{
+    return isAbsolute(fileName) ? fileName : directory + fileName;
+}
+
+// Whether the directory is the working directory, named relative to it.
+bool isWorkingDirectory(const std::string& directory)
+{
+    return directory == "" || directory == "./" || directory == ".\\";
+}
+}
+
+struct ToolPipeline::Stage {
+    std::string name;
+    Object* tool;
+    // The tool, as its type; the others are null.
+    ScaleTool* scale = nullptr;
+    InverseKinematicsTool* ik = nullptr;
+    InverseDynamicsTool* id = nullptr;
+    AnalyzeTool* analyze = nullptr;
+    std::vector<size_t> dependencies;
+    std::vector<std::string> inputFiles;
+    // Whether the tool changes the working directory; see addStage().
+    bool exclusive = false;
+    // Whether an earlier run passed the coordinates to the tool in memory.
+    bool coordinatesInMemory = false;
+
+    // Set during run().
+    std::string settings;
+    std::string key;
+    // The output passed in memory to the stages that depend on this one,
+    // and the resolved name of the file it was written to.
+    std::shared_ptr<const Storage> output;
+    std::string outputFileName;
+
+    // The directory relative to which the tool names its files.
+    std::string getDirectory() const
+    {
+        if (scale) return scale->getPathToSubject();
+        return IO::getParentDirectory(tool->getDocumentFileName());
+    }
+};
+
+ToolPipeline::ToolPipeline(const std::string& stampDirectory) :
+        _stampDirectory(stampDirectory), _numThreads(1) {}
+
+ToolPipeline::~ToolPipeline() = default;
+
+void ToolPipeline::addStage(const std::string& name, Object& tool,
+        const std::vector<std::string>& dependencies,
+        const std::vector<std::string>& inputFiles)
+{
+    for (const auto& stage : _stages) {
+        OPENSIM_THROW_IF(stage->name == name, Exception,
+            "ToolPipeline: there is already a stage named '" + name + "'.");
+    }
+    std::unique_ptr<Stage> stage(new Stage());
+    stage->name = name;
+    stage->tool = &tool;
+    stage->scale = dynamic_cast<ScaleTool*>(&tool);
+    stage->ik = dynamic_cast<InverseKinematicsTool*>(&tool);
+    stage->id = dynamic_cast<InverseDynamicsTool*>(&tool);
+    stage->analyze = dynamic_cast<AnalyzeTool*>(&tool);
+    OPENSIM_THROW_IF(!stage->scale && !stage->ik && !stage->id &&
+                     !stage->analyze, Exception,
+        "ToolPipeline: stage '" + name + "' has a tool of type " +
+        tool.getConcreteClassName() + "; expected a ScaleTool, "
+        "InverseKinematicsTool, InverseDynamicsTool or AnalyzeTool.");
+    for (const auto& dependency : dependencies) {
+        size_t i = 0;
+        while (i < _stages.size() && _stages[i]->name != dependency) ++i;
+        OPENSIM_THROW_IF(i == _stages.size(), Exception,
+            "ToolPipeline: stage '" + name + "' depends on stage '" +
+            dependency + "', which has not been added.");
+        stage->dependencies.push_back(i);
+    }
+    stage->inputFiles = inputFiles;
+
+    // The tools other than the ScaleTool change to the directory of their
+    // setup file, and of their external loads file.
+    std::string externalLoadsFileName;
+    if (stage->id) externalLoadsFileName = stage->id->getExternalLoadsFileName();
+    if (stage->analyze)
+        externalLoadsFileName = stage->analyze->getExternalLoadsFileName();
+    stage->exclusive = !stage->scale &&
+        (!isWorkingDirectory(stage->getDirectory()) ||
+         (isAssigned(externalLoadsFileName) &&
+          !isWorkingDirectory(IO::getParentDirectory(externalLoadsFileName))));
+    _stages.push_back(std::move(stage));
+}
+
+const ToolPipeline::Stage& ToolPipeline::getStage(
+        const std::string& name) const
+{
+    for (const auto& stage : _stages)
+        if (stage->name == name) return *stage;
+    OPENSIM_THROW(Exception,
+        "ToolPipeline: there is no stage named '" + name + "'.");
+}
+
+std::vector<std::string> ToolPipeline::getInputFileNames(
+        const std::string& name) const
+{
+    const Stage& stage = getStage(name);
+    std::vector<std::string> toolFiles;
+    if (stage.scale) {
+        const ScaleTool& scale = *stage.scale;
+        toolFiles.push_back(scale.getGenericModelMaker().getModelFileName());
+        if (scale.getModelScaler().getApply())
+            toolFiles.push_back(scale.getModelScaler().getMarkerFileName());
+        if (scale.getMarkerPlacer().getApply()) {
+            toolFiles.push_back(scale.getMarkerPlacer().getMarkerFileName());
+            toolFiles.push_back(
+                    scale.getMarkerPlacer().getCoordinateFileName());
+        }
+    } else if (stage.ik) {
+        toolFiles = {stage.ik->getModelFileName(),
+                     stage.ik->getMarkerDataFileName(),
+                     stage.ik->getCoordinateFileName()};
+    } else if (stage.id) {
+        toolFiles = {stage.id->getModelFileName(),
+                     stage.id->getCoordinatesFileName(),
+                     stage.id->getExternalLoadsFileName()};
+    } else {
+        AnalyzeTool& analyze = *stage.analyze;
+        toolFiles = {analyze.getModelFilename(), analyze.getStatesFileName(),
+                     analyze.getCoordinatesFileName(),
+                     analyze.getSpeedsFileName(),
+                     analyze.getExternalLoadsFileName()};
+        const AnalysisSet& analyses = analyze.getAnalysisSet();
+        for (int i = 0; i < analyses.getSize(); ++i) {
+            if (!analyses[i].getOn()) continue;
+            for (const auto& fileName : analyses[i].getInputFileNames())
+                toolFiles.push_back(fileName);
+        }
+    }
+
+    std::vector<std::string> fileNames;
+    const std::string directory = stage.getDirectory();
+    for (const auto& fileName : toolFiles)
+        if (isAssigned(fileName))
+            fileNames.push_back(resolve(directory, fileName));
+    for (const auto& fileName : stage.inputFiles)
+        fileNames.push_back(fileName);
+    return fileNames;
+}
+
+std::string ToolPipeline::computeKey(const Stage& stage,
+                                     const std::string& cwd) const
+{
+    ResultCache::Key key;
+    key.add(stage.tool->getConcreteClassName()).add(stage.settings);
+    for (const auto& fileName : getInputFileNames(stage.name)) {
+        const std::string path = resolve(cwd, fileName);
+        if (std::ifstream(path).good()) key.add(fileName).addFile(path);
+        else key.add(fileName).add("(missing)");
+    }
+    for (size_t dependency : stage.dependencies)
+        key.add(_stages[dependency]->key);
+    return key.toString();
+}
+
+void ToolPipeline::runStage(Stage& stage, const std::string& cwd)
+{
+    OPENSIM_TRACE_SPAN("tool", "pipeline stage", stage.name);
+    const std::string directory = stage.getDirectory();
+
+    // The coordinates, if a stage this one depends on produced them.
+    std::string coordinatesFileName;
+    if (stage.id) coordinatesFileName = stage.id->getCoordinatesFileName();
+    if (stage.analyze)
+        coordinatesFileName = stage.analyze->getCoordinatesFileName();
+    std::shared_ptr<const Storage> coordinates;
+    if (isAssigned(coordinatesFileName)) {
+        const std::string path =
+                resolve(cwd, resolve(directory, coordinatesFileName));
+        for (size_t dependency : stage.dependencies) {
+            const Stage& upstream = *_stages[dependency];
+            if (upstream.output && upstream.outputFileName == path)
+                coordinates = upstream.output;
+        }
+        // The tool keeps coordinates given in memory, so give it those of
+        // the file if they were not produced in this run.
+        if (!coordinates && stage.coordinatesInMemory && stage.id)
+            coordinates = std::make_shared<const Storage>(path);
+    }
+    if (coordinates) {
+        if (stage.id) stage.id->setCoordinateValues(*coordinates);
+        else stage.analyze->setCoordinateValues(*coordinates);
+        stage.coordinatesInMemory = true;
+    } else if (stage.analyze) {
+        stage.analyze->clearCoordinateValues();
+        stage.coordinatesInMemory = false;
+    }
+
+    if (stage.scale) {
+        OPENSIM_THROW_IF(!stage.scale->run(), Exception,
+            "ToolPipeline: stage '" + stage.name + "' failed.");
+    } else {
+        bool success = false;
+        if (stage.ik) success = stage.ik->run();
+        else if (stage.id) success = stage.id->run();
+        else success = stage.analyze->run();
+        OPENSIM_THROW_IF(!success, Exception,
+            "ToolPipeline: stage '" + stage.name + "' failed.");
+    }
+
+    if (stage.ik && isAssigned(stage.ik->getOutputMotionFileName())) {
+        stage.output =
+            std::make_shared<const Storage>(stage.ik->getOutputStorage());
+        stage.outputFileName = resolve(cwd,
+                resolve(directory, stage.ik->getOutputMotionFileName()));
+    }
+}
+
+std::vector<std::string> ToolPipeline::run(bool force)
+{
+    OPENSIM_TRACE_SPAN("tool", "ToolPipeline");
+    // Resolve every path against the working directory of this call, since
+    // the stages that run alone change it.
+    std::string cwd = IO::getCwd();
+    if (!cwd.empty() && cwd.back() != '/' && cwd.back() != '\\') cwd += "/";
+    const std::string stampDirectory = resolve(cwd, _stampDirectory);
+    IO::makeDir(stampDirectory);
+
+    // Serializing an Object is not thread-safe, so the settings are
+    // serialized before any stage runs.
+    for (auto& stage : _stages) {
+        stage->settings = stage->tool->dump();
+        stage->key.clear();
+        stage->output.reset();
+        stage->outputFileName.clear();
+    }
+
+    enum class Status { Pending, Running, Done, Failed };
+    const size_t numStages = _stages.size();
+    std::vector<Status> status(numStages, Status::Pending);
+    std::vector<bool> ran(numStages, false);
+    std::mutex mutex;
+    std::condition_variable changed;
+    int numRunning = 0;
+    bool exclusiveRunning = false;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            // The stages are in an order that respects their dependencies,
+            // so a stage is marked failed after the stages it depends on.
+            size_t next = numStages;
+            bool anyPending = false;
+            for (size_t i = 0; i < numStages; ++i) {
+                if (status[i] != Status::Pending) continue;
+                bool ready = true;
+                bool dependencyFailed = false;
+                for (size_t dependency : _stages[i]->dependencies) {
+                    if (status[dependency] == Status::Failed)
+                        dependencyFailed = true;
+                    else if (status[dependency] != Status::Done)
+                        ready = false;
+                }
+                if (dependencyFailed) {
+                    status[i] = Status::Failed;
+                    continue;
+                }
+                anyPending = true;
+                if (!ready || exclusiveRunning ||
+                        (_stages[i]->exclusive && numRunning > 0))
+                    continue;
+                next = i;
+                break;
+            }
+            if (next == numStages) {
+                if (!anyPending) {
+                    changed.notify_all();
+                    return;
+                }
+                changed.wait(lock);
+                continue;
+            }
+
+            Stage& stage = *_stages[next];
+            status[next] = Status::Running;
+            ++numRunning;
+            if (stage.exclusive) exclusiveRunning = true;
+            lock.unlock();
+
+            bool succeeded = true;
+            bool didRun = false;
+            std::exception_ptr stageError;
+            try {
+                stage.key = computeKey(stage, cwd);
+                const std::string stampFileName =
+                        stampDirectory + "/" + stage.name + ".stamp";
+                std::string stamp;
+                std::ifstream(stampFileName) >> stamp;
+                if (force || stamp != stage.key) {
+                    std::remove(stampFileName.c_str());
+                    runStage(stage, cwd);
+                    didRun = true;
+                    std::ofstream(stampFileName) << stage.key << std::endl;
+                } else {
+                    std::cout << "ToolPipeline: stage '" << stage.name
+                              << "' is up to date." << std::endl;
+                }
+            } catch (...) {
+                succeeded = false;
+                stageError = std::current_exception();
+            }
+
+            lock.lock();
+            --numRunning;
+            if (stage.exclusive) exclusiveRunning = false;
+            status[next] = succeeded ? Status::Done : Status::Failed;
+            ran[next] = didRun;
+            if (stageError && !error) error = stageError;
+            changed.notify_all();
+        }
+    };
+
+    int numThreads = _numThreads;
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::max(1, std::min(numThreads, int(numStages)));
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) {
+        try {
+            threads.emplace_back(work);
+        } catch (const std::system_error&) {
+            // The calling thread runs the remaining stages.
+            break;
+        }
+    }
+    work();
+    for (auto& thread : threads) thread.join();
+
+    for (auto& stage : _stages) stage->output.reset();
+    if (error) std::rethrow_exception(error);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < numStages; ++i)
+        if (ran[i]) names.push_back(_stages[i]->name);
+    return names;
+}
@@ -0,0 +1,140 @@
+#ifndef OPENSIM_TOOL_PIPELINE_H_
+#define OPENSIM_TOOL_PIPELINE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ToolPipeline.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2018 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Object;
+
+/** Runs a workflow of tools (e.g., scale, inverse kinematics, inverse
+dynamics, and an AnalyzeTool with StaticOptimization and JointReaction, for
+each trial of each subject) as a directed acyclic graph of stages, each stage
+running one tool after the stages it depends on.
+
+@code{.cpp}
+ScaleTool scale("subject01_Setup_Scale.xml");
+InverseKinematicsTool ik("subject01_Setup_IK.xml");
+InverseDynamicsTool id("subject01_Setup_ID.xml");
+AnalyzeTool so("subject01_Setup_SO.xml");
+ToolPipeline pipeline("pipeline_stamps");
+pipeline.addStage("scale", scale);
+pipeline.addStage("ik", ik, {"scale"});
+pipeline.addStage("id", id, {"ik"});
+pipeline.addStage("so", so, {"ik"});
+pipeline.setNumThreads(4);
+pipeline.run(); // "id" and "so" run concurrently.
+@endcode
+
+<b>Incremental runs.</b> Each stage's key hashes (see ResultCache::Key) the
+tool's type and settings, the contents of its input files, and the keys of
+the stages it depends on. The input files are those the tool names (see
+getInputFileNames()) and any given to addStage(). run() writes each stage's
+key to `<name>.stamp` in the stamp directory once the stage succeeds, and
+skips a stage whose key matches its stamp, so that only stages whose inputs
+changed (or that depend on one that did) run again. A file named within
+another file (e.g., the data file of an external loads file, or a marker
+set file) must be given to addStage() to be tracked.
+
+<b>Tables in memory.</b> The output of an InverseKinematicsTool stage is
+passed in memory (see InverseKinematicsTool::getOutputStorage()) to the
+InverseDynamicsTool and AnalyzeTool stages whose coordinates file is the
+output motion file of a stage they depend on, rather than read back from the
+file (which is still written). If the InverseKinematicsTool stage was
+skipped, the file is read. Other outputs (scaled models, static
+optimization forces) are passed through their files.
+
+<b>Concurrency.</b> Stages whose dependencies have run are run concurrently,
+up to the number of threads. The tools change the process's working
+directory to the directory of their setup file (and of an external loads
+file), so a stage whose tool names a file in another directory than the
+working directory runs alone, while no other stage runs; run the pipeline
+from the directory of the setup files to run its stages concurrently.
+
+The tools are not copied; they must outlive the pipeline's runs. */
+class OSIMTOOLS_API ToolPipeline {
+public:
+    /** The stamps of the stages are kept in stampDirectory (created as
+    needed); a relative directory is relative to the working directory of
+    each call to run(). */
+    explicit ToolPipeline(const std::string& stampDirectory);
+    ~ToolPipeline();
+
+    ToolPipeline(const ToolPipeline&)            = delete;
+    ToolPipeline& operator=(const ToolPipeline&) = delete;
+
+    /** Add a stage named name, which runs tool after the stages named in
+    dependencies. The tool must be a ScaleTool, InverseKinematicsTool,
+    InverseDynamicsTool or AnalyzeTool. inputFiles are files the stage reads
+    in addition to those its tool names (see getInputFileNames()); a relative
+    path is relative to the working directory of run().
+    @throws Exception If the name is already taken, a dependency has not been
+                      added, or the tool is not supported. Since dependencies
+                      must be added first, the stages cannot form a cycle. */
+    void addStage(const std::string& name, Object& tool,
+                  const std::vector<std::string>& dependencies = {},
+                  const std::vector<std::string>& inputFiles = {});
+
+    int getNumStages() const { return int(_stages.size()); }
+
+    /** The files that the tool of the named stage reads, as paths relative
+    to the working directory (or absolute): its model, data, and other input
+    files, and those given to addStage().
+    @throws Exception If there is no stage with this name. */
+    std::vector<std::string> getInputFileNames(const std::string& name) const;
+
+    /** Number of stages run at once (default: 1); if not positive, the
+    number of hardware threads is used. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Run the stages whose key does not match their stamp (all stages if
+    force is true), in an order that respects their dependencies, and return
+    the names of the stages that ran. If a stage throws, the stages that
+    depend on it are not run, the other stages are finished, and the first
+    exception is rethrown; the stamps of the stages that succeeded are
+    kept. */
+    std::vector<std::string> run(bool force = false);
+
+private:
+    struct Stage;
+
+    const Stage& getStage(const std::string& name) const;
+    // Hash the stage's inputs; file names are resolved against cwd.
+    std::string computeKey(const Stage& stage, const std::string& cwd) const;
+    // Run the stage's tool, passing the outputs of earlier stages in memory.
+    void runStage(Stage& stage, const std::string& cwd);
+
+    std::string _stampDirectory;
+    std::vector<std::unique_ptr<Stage>> _stages;
+    int _numThreads;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_TOOL_PIPELINE_H_
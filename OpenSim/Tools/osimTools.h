@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "ScaleTool.h"
+#include "BatchScaleTool.h"
 #include "RRATool.h"
 #include "CMCTool.h"
 #include "ForwardTool.h"
@@ -49,6 +50,8 @@
 #include "SMC_Joint.h"
 #include "CMC_TaskSet.h"
 #include "CorrectionController.h"
+#include "ToolPipeline.h"
+#include "ToolJob.h"
 #include "RegisterTypes_osimTools.h"    // to expose RegisterTypes_osimTools
 
 #endif // OPENSIM_OSIMTOOLS_H_
@@ -77,6 +77,14 @@ public:
      * Evaluate the expression.  The values of all variables should have been set before calling this.
      */
     double evaluate() const;
+    /**
+     * Evaluate the expression at many points in one call.  For each variable used by this expression, variableValues
+     * must map its name to an array of numPoints values; the result computed from the i'th value of each variable is
+     * stored in results[i].  The points are processed in blocks, one operation at a time, so that the common arithmetic
+     * operations are evaluated by loops over the points of a block that the compiler can vectorize.  This neither uses
+     * nor changes the values set through getVariableReference().
+     */
+    void evaluateBatch(int numPoints, const std::map<std::string, const double*>& variableValues, double* results) const;
 private:
     friend class ParsedExpression;
     CompiledExpression(const ParsedExpression& expression);
@@ -89,6 +97,7 @@ private:
     std::set<std::string> variableNames;
     mutable std::vector<double> workspace;
     mutable std::vector<double> argValues;
+    mutable std::vector<double> batchWorkspace;
     std::map<std::string, double> dummyVariables;
     void* jitCode;
 #ifdef LEPTON_USE_JIT
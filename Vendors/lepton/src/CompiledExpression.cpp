@@ -32,6 +32,7 @@
 #include "lepton/CompiledExpression.h"
 #include "lepton/Operation.h"
 #include "lepton/ParsedExpression.h"
+#include <algorithm>
 #include <utility>
 
 using namespace Lepton;
@@ -163,6 +164,106 @@ double CompiledExpression::evaluate() const {
 #endif
 }
 
+void CompiledExpression::evaluateBatch(int numPoints, const map<string, const double*>& variableValues, double* results) const {
+    // Find the values of each variable once.
+
+    vector<pair<int, const double*> > inputs;
+    for (map<string, int>::const_iterator iter = variableIndices.begin(); iter != variableIndices.end(); ++iter) {
+        map<string, const double*>::const_iterator values = variableValues.find(iter->first);
+        if (values == variableValues.end())
+            throw Exception("evaluateBatch: No values specified for variable '"+iter->first+"'");
+        inputs.push_back(make_pair(iter->second, values->second));
+    }
+    if (numPoints <= 0)
+        return;
+
+    // Each element of the workspace becomes a block of values, one for each point of the block.
+
+    const int blockSize = 64;
+    batchWorkspace.resize(workspace.size()*blockSize);
+    double* block = &batchWorkspace[0];
+    for (int first = 0; first < numPoints; first += blockSize) {
+        const int n = min(blockSize, numPoints-first);
+        for (unsigned i = 0; i < inputs.size(); i++)
+            copy(inputs[i].second+first, inputs[i].second+first+n, block+inputs[i].first*blockSize);
+        for (unsigned step = 0; step < operation.size(); step++) {
+            const vector<int>& args = arguments[step];
+            const Operation& op = *operation[step];
+            double* result = block+target[step]*blockSize;
+            const double* arg0 = block+args[0]*blockSize;
+            const double* arg1 = (op.getNumArguments() < 2 ? arg0 : block+(args.size() == 1 ? args[0]+1 : args[1])*blockSize);
+            switch (op.getId()) {
+                case Operation::CONSTANT: {
+                    double value = dynamic_cast<const Operation::Constant&>(op).getValue();
+                    for (int i = 0; i < n; i++)
+                        result[i] = value;
+                    break;
+                }
+                case Operation::ADD:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]+arg1[i];
+                    break;
+                case Operation::SUBTRACT:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]-arg1[i];
+                    break;
+                case Operation::MULTIPLY:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]*arg1[i];
+                    break;
+                case Operation::DIVIDE:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]/arg1[i];
+                    break;
+                case Operation::NEGATE:
+                    for (int i = 0; i < n; i++)
+                        result[i] = -arg0[i];
+                    break;
+                case Operation::SQUARE:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]*arg0[i];
+                    break;
+                case Operation::CUBE:
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]*arg0[i]*arg0[i];
+                    break;
+                case Operation::RECIPROCAL:
+                    for (int i = 0; i < n; i++)
+                        result[i] = 1.0/arg0[i];
+                    break;
+                case Operation::STEP:
+                    for (int i = 0; i < n; i++)
+                        result[i] = (arg0[i] >= 0.0 ? 1.0 : 0.0);
+                    break;
+                case Operation::ADD_CONSTANT: {
+                    double value = dynamic_cast<const Operation::AddConstant&>(op).getValue();
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]+value;
+                    break;
+                }
+                case Operation::MULTIPLY_CONSTANT: {
+                    double value = dynamic_cast<const Operation::MultiplyConstant&>(op).getValue();
+                    for (int i = 0; i < n; i++)
+                        result[i] = arg0[i]*value;
+                    break;
+                }
+                default: {
+                    // Evaluate any other operation one point at a time.
+
+                    int numArgs = op.getNumArguments();
+                    for (int i = 0; i < n; i++) {
+                        for (int j = 0; j < numArgs; j++)
+                            argValues[j] = block[(args.size() == 1 ? args[0]+j : args[j])*blockSize+i];
+                        result[i] = op.evaluate(&argValues[0], dummyVariables);
+                    }
+                }
+            }
+        }
+        const double* values = block+(workspace.size()-1)*blockSize;
+        copy(values, values+n, results+first);
+    }
+}
+
 #ifdef LEPTON_USE_JIT
 static double evaluateOperation(Operation* op, double* args) {
     map<string, double>* dummyVariables = NULL;
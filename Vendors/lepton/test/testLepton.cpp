@@ -35,6 +35,34 @@ int main() {
         value = Lepton::Parser::parse("sqrt(x)-1").evaluate(variables);
         ASSERT(fabs(value-2.) < 1E-7);
         Lepton::Parser::parse("state.muscle1.activation^2");
+
+        // Evaluating many points at once matches evaluating them one by one.
+        Lepton::CompiledExpression compiled = Lepton::Parser::parse(
+                "-10*q-5*qdot+q^2/(1+qdot*qdot)+sin(q)-step(qdot)+3").optimize().createCompiledExpression();
+        const int numPoints = 150;
+        vector<double> q(numPoints), qdot(numPoints), results(numPoints);
+        for (int i = 0; i < numPoints; i++) {
+            q[i] = 0.01*i-0.5;
+            qdot[i] = 0.5-0.02*i;
+        }
+        map<string, const double*> values;
+        values["q"] = &q[0];
+        values["qdot"] = &qdot[0];
+        compiled.evaluateBatch(numPoints, values, &results[0]);
+        for (int i = 0; i < numPoints; i++) {
+            compiled.getVariableReference("q") = q[i];
+            compiled.getVariableReference("qdot") = qdot[i];
+            ASSERT(results[i] == compiled.evaluate());
+        }
+        values.erase("qdot");
+        bool threw = false;
+        try {
+            compiled.evaluateBatch(numPoints, values, &results[0]);
+        }
+        catch (const Lepton::Exception&) {
+            threw = true;
+        }
+        ASSERT(threw);
     }
     catch (...) {
         //cout << "Failed" << endl;